@@ -0,0 +1,69 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <random>
+#include <string>
+
+#include "column/binary_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+
+namespace starrocks::vectorized {
+
+// The generators of the columns benchmarked, the data is random but the same in every run of a benchmark, so the
+// results of two builds are comparable.
+class BenchmarkData {
+public:
+    explicit BenchmarkData(uint32_t seed = 0) : _rng(seed) {}
+
+    // |num_rows| integers of |cardinality| distinct values.
+    template <typename T>
+    typename FixedLengthColumn<T>::Ptr int_column(size_t num_rows, size_t cardinality) {
+        std::uniform_int_distribution<int64_t> dist(0, std::max<int64_t>(cardinality, 1) - 1);
+        auto column = FixedLengthColumn<T>::create();
+        column->reserve(num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            column->append(static_cast<T>(dist(_rng)));
+        }
+        return column;
+    }
+
+    // |num_rows| strings of |cardinality| distinct values, the lengths are in [min_length, max_length].
+    BinaryColumn::Ptr string_column(size_t num_rows, size_t cardinality, size_t min_length, size_t max_length) {
+        std::uniform_int_distribution<size_t> length_dist(min_length, max_length);
+        std::uniform_int_distribution<int> char_dist('a', 'z');
+        std::vector<std::string> values(std::max<size_t>(cardinality, 1));
+        for (auto& value : values) {
+            value.resize(length_dist(_rng));
+            for (auto& c : value) {
+                c = static_cast<char>(char_dist(_rng));
+            }
+        }
+        std::uniform_int_distribution<size_t> dist(0, values.size() - 1);
+        auto column = BinaryColumn::create();
+        column->reserve(num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            column->append(Slice(values[dist(_rng)]));
+        }
+        return column;
+    }
+
+    // Wrap |data_column| into a nullable column, each row is null by the probability of |null_ratio|.
+    NullableColumn::Ptr nullable(const ColumnPtr& data_column, double null_ratio) {
+        std::bernoulli_distribution dist(null_ratio);
+        auto null_column = NullColumn::create();
+        null_column->reserve(data_column->size());
+        for (size_t i = 0; i < data_column->size(); ++i) {
+            null_column->append(dist(_rng) ? DATUM_NULL : DATUM_NOT_NULL);
+        }
+        auto column = NullableColumn::create(data_column, null_column);
+        column->update_has_null();
+        return column;
+    }
+
+private:
+    std::mt19937 _rng;
+};
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,61 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_data.h"
+#include "simd/simd.h"
+
+namespace starrocks::vectorized {
+
+static constexpr size_t kChunkSize = 4096;
+
+static void serialize_batch(benchmark::State& state, const ColumnPtr& column) {
+    const uint32_t max_one_row_size = column->max_one_element_serialize_size();
+    std::vector<uint8_t> buffer(max_one_row_size * kChunkSize);
+    Buffer<uint32_t> slice_sizes(kChunkSize);
+    for (auto _ : state) {
+        std::fill(slice_sizes.begin(), slice_sizes.end(), 0);
+        column->serialize_batch(buffer.data(), slice_sizes, kChunkSize, max_one_row_size);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kChunkSize);
+}
+
+// Args: null ratio in percent.
+static void BM_serialize_batch_int32(benchmark::State& state) {
+    BenchmarkData data;
+    ColumnPtr column = data.int_column<int32_t>(kChunkSize, kChunkSize);
+    if (state.range(0) > 0) {
+        column = data.nullable(column, state.range(0) / 100.0);
+    }
+    serialize_batch(state, column);
+}
+BENCHMARK(BM_serialize_batch_int32)->Arg(0)->Arg(10)->Arg(50);
+
+// Args: max string length, null ratio in percent.
+static void BM_serialize_batch_string(benchmark::State& state) {
+    BenchmarkData data;
+    ColumnPtr column = data.string_column(kChunkSize, kChunkSize, 1, state.range(0));
+    if (state.range(1) > 0) {
+        column = data.nullable(column, state.range(1) / 100.0);
+    }
+    serialize_batch(state, column);
+}
+BENCHMARK(BM_serialize_batch_string)->Args({16, 0})->Args({16, 10})->Args({128, 0})->Args({128, 10});
+
+// Args: number of bytes, zero ratio in percent.
+static void BM_count_zero(benchmark::State& state) {
+    std::mt19937 rng(0);
+    std::bernoulli_distribution dist(state.range(1) / 100.0);
+    std::vector<uint8_t> bytes(state.range(0));
+    for (auto& byte : bytes) {
+        byte = dist(rng) ? 0 : 1;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SIMD::count_zero(bytes.data(), bytes.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_count_zero)->Args({kChunkSize, 1})->Args({kChunkSize, 50})->Args({1 << 20, 50});
+
+} // namespace starrocks::vectorized
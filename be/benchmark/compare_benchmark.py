@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+# This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+"""Compare the results of starrocks_benchmark of two builds.
+
+Run the benchmarks of both builds with the JSON output, e.g.
+    starrocks_benchmark --benchmark_repetitions=5 --benchmark_report_aggregates_only=true \\
+        --benchmark_out_format=json --benchmark_out=base.json
+then compare them:
+    compare_benchmark.py base.json new.json --threshold 5
+A benchmark regresses if its cpu time grows by more than the threshold percent, the script exits with 1 if any
+benchmark regresses, so it can guard a release.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    with open(path) as f:
+        results = json.load(f)["benchmarks"]
+    times = {}
+    for result in results:
+        # take the median of the repetitions if they're aggregated.
+        if result.get("run_type") == "aggregate" and result.get("aggregate_name") != "median":
+            continue
+        times[result.get("run_name", result["name"])] = result["cpu_time"]
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare the results of starrocks_benchmark of two builds.")
+    parser.add_argument("base", help="the JSON output of the base build")
+    parser.add_argument("new", help="the JSON output of the new build")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="the percent of the cpu time growth that is regarded as a regression")
+    args = parser.parse_args()
+
+    base = load_results(args.base)
+    new = load_results(args.new)
+    regressions = []
+    print("%-60s %14s %14s %9s" % ("benchmark", "base cpu time", "new cpu time", "change"))
+    for name in sorted(base.keys() & new.keys()):
+        change = (new[name] - base[name]) * 100.0 / base[name] if base[name] > 0 else 0.0
+        mark = ""
+        if change > args.threshold:
+            regressions.append(name)
+            mark = " REGRESSION"
+        print("%-60s %14.1f %14.1f %+8.1f%%%s" % (name, base[name], new[name], change, mark))
+    for name in sorted(base.keys() - new.keys()):
+        print("%-60s missing in the new results" % name)
+
+    if regressions:
+        print("\n%d benchmarks regress by more than %.1f%%" % (len(regressions), args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,111 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_data.h"
+#include "exec/vectorized/aggregate/agg_hash_variant.h"
+#include "exec/vectorized/join_hash_map.h"
+
+namespace starrocks::vectorized {
+
+static constexpr size_t kChunkSize = 4096;
+static constexpr size_t kNumChunks = 64;
+
+// Aggregate kNumChunks chunks into a new hash map in each iteration.
+template <typename HashMapWithKey>
+static void aggregate(benchmark::State& state, const std::vector<ColumnPtr>& keys) {
+    MemTracker tracker;
+    MemPool pool(&tracker);
+    int64_t agg_data = 0;
+    auto allocate_func = [&agg_data]() { return reinterpret_cast<AggDataPtr>(&agg_data); };
+    Buffer<AggDataPtr> agg_states(kChunkSize);
+    for (auto _ : state) {
+        HashMapWithKey hash_map;
+        for (const auto& key : keys) {
+            hash_map.compute_agg_states(kChunkSize, Columns{key}, &pool, allocate_func, &agg_states);
+        }
+        benchmark::DoNotOptimize(hash_map.hash_map.size());
+        pool.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * kNumChunks * kChunkSize);
+}
+
+// Args: cardinality of the group by key.
+static void BM_agg_hash_map_int64(benchmark::State& state) {
+    BenchmarkData data;
+    std::vector<ColumnPtr> keys;
+    for (size_t i = 0; i < kNumChunks; ++i) {
+        keys.emplace_back(data.int_column<int64_t>(kChunkSize, state.range(0)));
+    }
+    aggregate<Int64AggHashMapWithOneNumberKey<PhmapSeed1>>(state, keys);
+}
+BENCHMARK(BM_agg_hash_map_int64)->Arg(16)->Arg(1 << 12)->Arg(1 << 18);
+
+// Args: cardinality of the group by key, max string length.
+static void BM_agg_hash_map_string(benchmark::State& state) {
+    BenchmarkData data;
+    std::vector<ColumnPtr> keys;
+    for (size_t i = 0; i < kNumChunks; ++i) {
+        keys.emplace_back(data.string_column(kChunkSize, state.range(0), 1, state.range(1)));
+    }
+    aggregate<OneStringAggHashMap<PhmapSeed1>>(state, keys);
+}
+BENCHMARK(BM_agg_hash_map_string)->Args({16, 16})->Args({1 << 12, 16})->Args({1 << 12, 64});
+
+// Build a join hash table of one int32 key from the rows of |build_column| starting at 1, as HashJoiner does.
+static void build_join_hash_table(const ColumnPtr& build_column, JoinHashTableItems* table_items,
+                                  HashTableProbeState* probe_state) {
+    table_items->key_columns = {build_column};
+    table_items->row_count = build_column->size() - 1;
+    table_items->bucket_size = JoinHashMapHelper::calc_bucket_size(table_items->row_count + 1);
+    table_items->first.assign(table_items->bucket_size, 0);
+    table_items->next.assign(table_items->row_count + 1, 0);
+    JoinBuildFunc<TYPE_INT>::construct_hash_table(table_items, probe_state);
+}
+
+static ColumnPtr join_build_column(BenchmarkData* data, size_t num_rows, size_t cardinality) {
+    auto column = Int32Column::create();
+    column->append_default();
+    column->append(*data->int_column<int32_t>(num_rows, cardinality), 0, num_rows);
+    return column;
+}
+
+// Args: number of the build rows.
+static void BM_join_hash_table_build(benchmark::State& state) {
+    BenchmarkData data;
+    ColumnPtr build_column = join_build_column(&data, state.range(0), state.range(0));
+    for (auto _ : state) {
+        JoinHashTableItems table_items;
+        HashTableProbeState probe_state;
+        build_join_hash_table(build_column, &table_items, &probe_state);
+        benchmark::DoNotOptimize(table_items.first.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_join_hash_table_build)->Arg(1 << 12)->Arg(1 << 20);
+
+// Args: number of the build rows, percent of the probe rows matched.
+static void BM_join_hash_table_probe(benchmark::State& state) {
+    BenchmarkData data;
+    const size_t num_build_rows = state.range(0);
+    ColumnPtr build_column = join_build_column(&data, num_build_rows, num_build_rows);
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+    build_join_hash_table(build_column, &table_items, &probe_state);
+
+    // the keys not matched are out of the range of the build keys.
+    const size_t probe_cardinality = num_build_rows * 100 / std::max<int64_t>(state.range(1), 1);
+    Columns probe_columns{data.int_column<int32_t>(kChunkSize, probe_cardinality)};
+    probe_state.key_columns = &probe_columns;
+    probe_state.probe_row_count = kChunkSize;
+    probe_state.buckets.resize(kChunkSize);
+    probe_state.next.resize(kChunkSize);
+    for (auto _ : state) {
+        JoinProbeFunc<TYPE_INT>::lookup_init(table_items, &probe_state);
+        benchmark::DoNotOptimize(probe_state.next.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kChunkSize);
+}
+BENCHMARK(BM_join_hash_table_probe)->Args({1 << 12, 100})->Args({1 << 20, 100})->Args({1 << 20, 10});
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,59 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_data.h"
+#include "storage/rowset/segment_v2/binary_plain_page.h"
+#include "storage/rowset/segment_v2/bitshuffle_page.h"
+#include "storage/rowset/segment_v2/options.h"
+
+namespace starrocks::vectorized {
+
+using segment_v2::PageBuilderOptions;
+using segment_v2::PageDecoderOptions;
+
+// Decode the whole page into a column in each iteration.
+template <typename Decoder, typename ColumnType>
+static void decode_page(benchmark::State& state, const OwnedSlice& page, size_t num_values) {
+    for (auto _ : state) {
+        Decoder decoder(page.slice(), PageDecoderOptions());
+        CHECK(decoder.init().ok());
+        auto column = ColumnType::create();
+        size_t n = num_values;
+        CHECK(decoder.next_batch(&n, column.get()).ok());
+        benchmark::DoNotOptimize(column);
+    }
+    state.SetItemsProcessed(state.iterations() * num_values);
+}
+
+// Args: cardinality of the values.
+static void BM_bitshuffle_page_decode_int32(benchmark::State& state) {
+    BenchmarkData data;
+    auto values = data.int_column<int32_t>(64 * 1024, state.range(0));
+    PageBuilderOptions options;
+    options.data_page_size = 1024 * 1024;
+    segment_v2::BitshufflePageBuilder<OLAP_FIELD_TYPE_INT> builder(options);
+    size_t num_values = builder.add(reinterpret_cast<const uint8_t*>(values->get_data().data()), values->size());
+    OwnedSlice page = builder.finish()->build();
+    decode_page<segment_v2::BitShufflePageDecoder<OLAP_FIELD_TYPE_INT>, Int32Column>(state, page, num_values);
+}
+BENCHMARK(BM_bitshuffle_page_decode_int32)->Arg(16)->Arg(1 << 30);
+
+// Args: max string length.
+static void BM_binary_plain_page_decode(benchmark::State& state) {
+    BenchmarkData data;
+    auto values = data.string_column(16 * 1024, 16 * 1024, 1, state.range(0));
+    std::vector<Slice> slices;
+    for (size_t i = 0; i < values->size(); ++i) {
+        slices.emplace_back(values->get_slice(i));
+    }
+    PageBuilderOptions options;
+    options.data_page_size = 16 * 1024 * 1024;
+    segment_v2::BinaryPlainPageBuilder builder(options);
+    size_t num_values = builder.add(reinterpret_cast<const uint8_t*>(slices.data()), slices.size());
+    OwnedSlice page = builder.finish()->build();
+    decode_page<segment_v2::BinaryPlainPageDecoder<OLAP_FIELD_TYPE_VARCHAR>, BinaryColumn>(state, page, num_values);
+}
+BENCHMARK(BM_binary_plain_page_decode)->Arg(16)->Arg(128);
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,73 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_data.h"
+#include "column/chunk.h"
+#include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "exprs/expr_context.h"
+#include "exprs/slot_ref.h"
+
+namespace starrocks::vectorized {
+
+static constexpr size_t kChunkSize = 4096;
+
+// Sort the chunks by all the columns, the chunks are sorted by a new sorter in each iteration.
+static void full_sort(benchmark::State& state, const std::vector<ChunkPtr>& chunks,
+                      const std::vector<TypeDescriptor>& types) {
+    std::vector<std::unique_ptr<SlotRef>> slot_refs;
+    std::vector<std::unique_ptr<ExprContext>> expr_ctxs;
+    std::vector<ExprContext*> sort_exprs;
+    for (SlotId i = 0; i < types.size(); ++i) {
+        slot_refs.emplace_back(std::make_unique<SlotRef>(types[i], 0, i));
+        expr_ctxs.emplace_back(std::make_unique<ExprContext>(slot_refs.back().get()));
+        sort_exprs.emplace_back(expr_ctxs.back().get());
+    }
+    std::vector<bool> is_asc(types.size(), true);
+    std::vector<bool> is_null_first(types.size(), true);
+
+    for (auto _ : state) {
+        ChunksSorterFullSort sorter(&sort_exprs, &is_asc, &is_null_first, 1);
+        for (const auto& chunk : chunks) {
+            CHECK(sorter.update(nullptr, chunk).ok());
+        }
+        CHECK(sorter.done(nullptr).ok());
+        ChunkPtr sorted;
+        bool eos = false;
+        while (!eos) {
+            CHECK(sorter.get_next(&sorted, &eos).ok());
+            benchmark::DoNotOptimize(sorted);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * chunks.size() * kChunkSize);
+}
+
+// Args: number of chunks, cardinality of the key.
+static void BM_full_sort_int32(benchmark::State& state) {
+    BenchmarkData data;
+    std::vector<ChunkPtr> chunks;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        auto chunk = std::make_shared<Chunk>();
+        chunk->append_column(data.int_column<int32_t>(kChunkSize, state.range(1)), 0);
+        chunks.emplace_back(std::move(chunk));
+    }
+    full_sort(state, chunks, {TypeDescriptor(TYPE_INT)});
+}
+BENCHMARK(BM_full_sort_int32)->Args({16, 1 << 10})->Args({256, 1 << 20});
+
+// Args: number of chunks, null ratio of the string key in percent.
+static void BM_full_sort_string_int32(benchmark::State& state) {
+    BenchmarkData data;
+    std::vector<ChunkPtr> chunks;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        auto chunk = std::make_shared<Chunk>();
+        chunk->append_column(data.nullable(data.string_column(kChunkSize, 1 << 10, 4, 32), state.range(1) / 100.0),
+                             0);
+        chunk->append_column(data.int_column<int32_t>(kChunkSize, 1 << 20), 1);
+        chunks.emplace_back(std::move(chunk));
+    }
+    full_sort(state, chunks, {TypeDescriptor::create_varchar_type(32), TypeDescriptor(TYPE_INT)});
+}
+BENCHMARK(BM_full_sort_string_int32)->Args({16, 0})->Args({16, 20});
+
+} // namespace starrocks::vectorized
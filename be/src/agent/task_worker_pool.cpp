@@ -32,6 +32,7 @@
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "common/status.h"
 #include "env/env.h"
@@ -55,9 +56,11 @@
 #include "storage/task/engine_storage_migration_task.h"
 #include "storage/utils.h"
 #include "util/file_utils.h"
+#include "util/hash_util.hpp"
 #include "util/monotime.h"
 #include "util/starrocks_metrics.h"
 #include "util/stopwatch.hpp"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -1116,6 +1119,32 @@ void* TaskWorkerPool::_report_disk_state_worker_thread_callback(void* arg_this)
     return (void*)0;
 }
 
+// The digest of the fields of |tablet| reported to FE, to tell whether it has changed since the last report.
+static uint64_t tablet_report_digest(const TTablet& tablet) {
+    uint64_t digest = 0;
+    auto update = [&digest](int64_t value) { digest = HashUtil::hash64(&value, sizeof(value), digest); };
+    for (const TTabletInfo& info : tablet.tablet_infos) {
+        update(info.tablet_id);
+        update(info.schema_hash);
+        update(info.version);
+        update(info.version_hash);
+        update(info.row_count);
+        update(info.data_size);
+        update(info.__isset.storage_medium ? info.storage_medium : -1);
+        update(info.transaction_ids.size());
+        for (int64_t transaction_id : info.transaction_ids) {
+            update(transaction_id);
+        }
+        update(info.__isset.version_count ? info.version_count : -1);
+        update(info.__isset.path_hash ? info.path_hash : -1);
+        update(info.__isset.version_miss ? info.version_miss : -1);
+        update(info.__isset.used ? info.used : -1);
+        update(info.__isset.partition_id ? info.partition_id : -1);
+        update(info.__isset.is_in_memory ? info.is_in_memory : -1);
+    }
+    return digest;
+}
+
 void* TaskWorkerPool::_report_tablet_worker_thread_callback(void* arg_this) {
     TaskWorkerPool* worker_pool_this = (TaskWorkerPool*)arg_this;
 
@@ -1123,6 +1152,10 @@ void* TaskWorkerPool::_report_tablet_worker_thread_callback(void* arg_this) {
     request.__set_backend(worker_pool_this->_backend);
     request.__isset.tablets = true;
     AgentStatus status = STARROCKS_SUCCESS;
+    // tablet_id -> the digest of the tablet in the last report acknowledged by FE
+    std::unordered_map<TTabletId, uint64_t> reported_digests;
+    // 0 if the next report must be a full one
+    int64_t last_full_report_time = 0;
 
 #ifndef BE_TEST
     while (true) {
@@ -1135,6 +1168,8 @@ void* TaskWorkerPool::_report_tablet_worker_thread_callback(void* arg_this) {
         }
 #endif
         request.tablets.clear();
+        request.removed_tablets.clear();
+        request.__isset.removed_tablets = false;
 
         request.__set_report_version(_s_report_version);
         Status st_report = StorageEngine::instance()->tablet_manager()->report_all_tablets_info(&request.tablets);
@@ -1153,6 +1188,37 @@ void* TaskWorkerPool::_report_tablet_worker_thread_callback(void* arg_this) {
                          StarRocksMetrics::instance()->tablet_base_max_compaction_score.value());
         request.__set_tablet_max_compaction_score(max_compaction_score);
 
+        std::unordered_map<TTabletId, uint64_t> digests;
+        digests.reserve(request.tablets.size());
+        for (const auto& [tablet_id, tablet] : request.tablets) {
+            digests.emplace(tablet_id, tablet_report_digest(tablet));
+        }
+        int64_t now = MonotonicSeconds();
+        int32_t full_interval = config::report_tablet_full_interval_seconds;
+        bool incremental = full_interval > 0 && last_full_report_time > 0 &&
+                           now - last_full_report_time < full_interval &&
+                           worker_pool_this->_env->heartbeat_flags()->is_support_incremental_tablet_report();
+        if (incremental) {
+            for (auto iter = request.tablets.begin(); iter != request.tablets.end();) {
+                auto reported = reported_digests.find(iter->first);
+                if (reported != reported_digests.end() && reported->second == digests[iter->first]) {
+                    iter = request.tablets.erase(iter);
+                } else {
+                    ++iter;
+                }
+            }
+            std::vector<TTabletId> removed_tablets;
+            for (const auto& [tablet_id, digest] : reported_digests) {
+                if (digests.count(tablet_id) == 0) {
+                    removed_tablets.push_back(tablet_id);
+                }
+            }
+            request.__set_removed_tablets(removed_tablets);
+            VLOG(1) << "Report " << request.tablets.size() << " changed and " << removed_tablets.size()
+                    << " removed tablets of " << digests.size() << " tablets";
+        }
+        request.__set_is_incremental_tablet_report(incremental);
+
         TMasterResult result;
         status = worker_pool_this->_master_client->report(request, &result);
 
@@ -1162,6 +1228,19 @@ void* TaskWorkerPool::_report_tablet_worker_thread_callback(void* arg_this) {
                          << worker_pool_this->_master_info.network_address.hostname << ":"
                          << worker_pool_this->_master_info.network_address.port << ", err=" << status;
         }
+        if (status == STARROCKS_SUCCESS && result.status.status_code == TStatusCode::OK) {
+            // the next increment is based on this report
+            reported_digests = std::move(digests);
+            if (!incremental) {
+                last_full_report_time = now;
+            }
+        } else {
+            if (status == STARROCKS_SUCCESS) {
+                LOG(WARNING) << "Tablet report is rejected by FE, err=" << Status(result.status).to_string();
+            }
+            // FE may have missed some increments, report all the tablets next time
+            last_full_report_time = 0;
+        }
 
 #ifndef BE_TEST
         // wait for notifying until timeout
@@ -41,6 +41,10 @@ public:
 
     bool is_array() const override { return true; }
 
+    bool capacity_limit_reached_on_append(const Column& src) const override {
+        return _elements->capacity_limit_reached_on_append(src);
+    }
+
     const uint8_t* raw_data() const override;
 
     uint8_t* mutable_raw_data() override;
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <limits>
+
 #include "column/bytes.h"
 #include "column/column.h"
 #include "util/slice.h"
@@ -63,6 +65,11 @@ public:
     bool low_cardinality() const override { return false; }
     bool is_binary() const override { return true; }
 
+    bool capacity_limit_reached_on_append(const Column& src) const override {
+        // the byte size of |src| is no less than the bytes of its strings
+        return _bytes.size() + src.byte_size() > std::numeric_limits<Offset>::max();
+    }
+
     const uint8_t* raw_data() const override {
         if (!_slices_cache) {
             _build_slices();
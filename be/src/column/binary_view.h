@@ -0,0 +1,108 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "util/slice.h"
+
+namespace starrocks::vectorized {
+
+// BinaryView is a 16-byte view of a string, laid out as
+//
+//   | size (4 bytes) | prefix (4 bytes) | the rest of the inlined data (8 bytes) |   if size <= 12
+//   | size (4 bytes) | prefix (4 bytes) | pointer to the whole data (8 bytes)    |   otherwise
+//
+// The unused inlined bytes are zeroed. Two views differing in their sizes or prefixes are compared without
+// dereferencing their data, and the short strings are not dereferenced at all, which makes the views much cheaper
+// to compare than Slices when the keys are short or differ in their first bytes, e.g. codes and ids.
+//
+// A view doesn't own the data of the long strings, which must outlive the view.
+class BinaryView {
+public:
+    static constexpr uint32_t kPrefixSize = 4;
+    static constexpr uint32_t kInlineSize = 12;
+
+    BinaryView() { memset(this, 0, sizeof(BinaryView)); }
+
+    explicit BinaryView(const Slice& s) : _size(s.size) {
+        memset(_prefix, 0, sizeof(_prefix) + sizeof(_rest));
+        if (_size <= kInlineSize) {
+            memcpy(_prefix, s.data, _size);
+        } else {
+            memcpy(_prefix, s.data, kPrefixSize);
+            const char* data = s.data;
+            memcpy(_rest, &data, sizeof(data));
+        }
+    }
+
+    uint32_t size() const { return _size; }
+
+    bool is_inlined() const { return _size <= kInlineSize; }
+
+    const char* data() const {
+        if (is_inlined()) {
+            return _prefix;
+        }
+        const char* data;
+        memcpy(&data, _rest, sizeof(data));
+        return data;
+    }
+
+    Slice to_slice() const { return {data(), _size}; }
+
+    // Same as Slice::compare.
+    int compare(const BinaryView& rhs) const {
+        // the prefixes are compared as big-endian integers, which orders them the same as memcmp.
+        uint32_t l = _prefix_as_ordered_int();
+        uint32_t r = rhs._prefix_as_ordered_int();
+        if (l != r) {
+            return l < r ? -1 : 1;
+        }
+        uint32_t min_size = _size < rhs._size ? _size : rhs._size;
+        if (min_size > kPrefixSize) {
+            int res = memcmp(data() + kPrefixSize, rhs.data() + kPrefixSize, min_size - kPrefixSize);
+            if (res != 0) {
+                return res;
+            }
+        }
+        return _size < rhs._size ? -1 : (_size > rhs._size ? 1 : 0);
+    }
+
+    bool operator==(const BinaryView& rhs) const {
+        // the size and the prefix at once
+        if (_load_u64(this) != _load_u64(&rhs)) {
+            return false;
+        }
+        if (is_inlined()) {
+            return memcmp(_rest, rhs._rest, sizeof(_rest)) == 0;
+        }
+        return memcmp(data() + kPrefixSize, rhs.data() + kPrefixSize, _size - kPrefixSize) == 0;
+    }
+
+    bool operator!=(const BinaryView& rhs) const { return !(*this == rhs); }
+
+    bool operator<(const BinaryView& rhs) const { return compare(rhs) < 0; }
+
+private:
+    static uint64_t _load_u64(const BinaryView* view) {
+        uint64_t v;
+        memcpy(&v, view, sizeof(v));
+        return v;
+    }
+
+    uint32_t _prefix_as_ordered_int() const {
+        uint32_t v;
+        memcpy(&v, _prefix, sizeof(v));
+        return __builtin_bswap32(v);
+    }
+
+    uint32_t _size;
+    char _prefix[kPrefixSize];
+    char _rest[8];
+};
+
+static_assert(sizeof(BinaryView) == 16);
+
+} // namespace starrocks::vectorized
@@ -2,13 +2,17 @@
 
 #include "column/chunk.h"
 
+#include <algorithm>
+
 #include "column/column_helper.h"
 #include "column/datum_tuple.h"
+#include "column/filter_kernels.h"
 #include "column/fixed_length_column.h"
 #include "gen_cpp/data.pb.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/descriptors.h"
 #include "util/coding.h"
+#include "util/hash_util.hpp"
 
 namespace starrocks::vectorized {
 
@@ -45,6 +49,7 @@ void Chunk::reset() {
         c->reset_column();
     }
     _delete_state = DEL_NOT_SATISFIED;
+    _drop_hash_values_cache();
 }
 
 void Chunk::swap_chunk(Chunk& other) {
@@ -53,10 +58,12 @@ void Chunk::swap_chunk(Chunk& other) {
     _cid_to_index.swap(other._cid_to_index);
     _slot_id_to_index.swap(other._slot_id_to_index);
     _tuple_id_to_index.swap(other._tuple_id_to_index);
+    _hash_values_cache.swap(other._hash_values_cache);
     std::swap(_delete_state, other._delete_state);
 }
 
 void Chunk::set_num_rows(size_t count) {
+    _drop_hash_values_cache();
     for (ColumnPtr& c : _columns) {
         c->resize(count);
     }
@@ -152,6 +159,14 @@ void Chunk::serialize(uint8_t* dst) const {
 }
 
 size_t Chunk::serialize_with_meta(starrocks::ChunkPB* chunk) const {
+    serialize_meta(chunk);
+    size_t size = serialize_size();
+    chunk->mutable_data()->resize(size);
+    serialize((uint8_t*)chunk->mutable_data()->data());
+    return size;
+}
+
+void Chunk::serialize_meta(starrocks::ChunkPB* chunk) const {
     chunk->clear_slot_id_map();
     chunk->mutable_slot_id_map()->Reserve(static_cast<int>(_slot_id_to_index.size()) * 2);
     for (const auto& kv : _slot_id_to_index) {
@@ -179,11 +194,6 @@ size_t Chunk::serialize_with_meta(starrocks::ChunkPB* chunk) const {
     }
 
     DCHECK_EQ(_columns.size(), _tuple_id_to_index.size() + _slot_id_to_index.size());
-
-    size_t size = serialize_size();
-    chunk->mutable_data()->resize(size);
-    serialize((uint8_t*)chunk->mutable_data()->data());
-    return size;
 }
 
 Status Chunk::deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta& meta) {
@@ -269,20 +279,94 @@ std::unique_ptr<Chunk> Chunk::clone_empty_with_tuple(size_t size) const {
 }
 
 void Chunk::append_selective(const Chunk& src, const uint32_t* indexes, uint32_t from, uint32_t size) {
+    _drop_hash_values_cache();
     DCHECK_EQ(_columns.size(), src.columns().size());
     for (size_t i = 0; i < _columns.size(); ++i) {
         _columns[i]->append_selective(*src.columns()[i].get(), indexes, from, size);
     }
 }
 
+// Gathering the selected rows is cheaper than compacting all the rows if no more than 1/8 of them are selected.
+static constexpr size_t kSparseSelectionRatio = 8;
+
 size_t Chunk::filter(const Buffer<uint8_t>& selection) {
+    _drop_hash_values_cache();
+    DCHECK(_columns.empty() || num_rows() == selection.size());
+    // count the selected rows once for all the columns
+    const size_t num_selected = selection.size() - count_zero_bytes(selection.data(), selection.size());
+    if (num_selected == selection.size()) {
+        return num_rows();
+    }
+    if (num_selected == 0) {
+        for (auto& column : _columns) {
+            column->resize(0);
+        }
+        return 0;
+    }
+    if (num_selected * kSparseSelectionRatio > selection.size()) {
+        for (auto& column : _columns) {
+            column->filter(selection);
+        }
+        return num_rows();
+    }
+
+    // one more room for the branchless writes
+    Buffer<uint32_t> indexes(num_selected + 1);
+    for (uint32_t i = 0, n = 0; i < selection.size(); ++i) {
+        indexes[n] = i;
+        n += (selection[i] != 0);
+    }
     for (auto& column : _columns) {
-        column->filter(selection);
+        if (column->is_constant()) {
+            column->filter(selection);
+            continue;
+        }
+        auto selected = column->clone_empty();
+        selected->reserve(num_selected);
+        selected->append_selective(*column, indexes.data(), 0, num_selected);
+        column->swap_column(*selected);
     }
     return num_rows();
 }
 
+void Chunk::compute_hash_values(ChunkHashFunction function, const Columns& key_columns,
+                                Buffer<uint32_t>* hash_values) {
+    const size_t rows = num_rows();
+    for (const auto& cached : _hash_values_cache) {
+        if (cached.function == function && cached.hash_values.size() == rows && cached.key_columns == key_columns) {
+            *hash_values = cached.hash_values;
+            return;
+        }
+    }
+
+    if (function == ChunkHashFunction::FNV) {
+        hash_values->assign(rows, HashUtil::FNV_SEED);
+        for (const ColumnPtr& column : key_columns) {
+            column->fvn_hash(hash_values->data(), 0, rows);
+        }
+    } else {
+        hash_values->assign(rows, 0);
+        for (const ColumnPtr& column : key_columns) {
+            column->crc32_hash(hash_values->data(), 0, rows);
+        }
+    }
+
+    // the results of the other exprs are evaluated again for each operator, whose hash values can't be reused.
+    for (const ColumnPtr& column : key_columns) {
+        if (std::find(_columns.begin(), _columns.end(), column) == _columns.end()) {
+            return;
+        }
+    }
+    // a chunk is partitioned by a few ways at most
+    static constexpr size_t kMaxCachedHashValues = 4;
+    if (_hash_values_cache.size() >= kMaxCachedHashValues) {
+        _drop_hash_values_cache();
+    }
+    _hash_values_cache.push_back({function, key_columns, *hash_values});
+}
+
 size_t Chunk::filter_range(const Buffer<uint8_t>& selection, size_t from, size_t to) {
+    _drop_hash_values_cache();
     for (auto& column : _columns) {
         column->filter_range(selection, from, to);
     }
@@ -381,6 +465,7 @@ std::string Chunk::debug_row(uint32_t index) const {
 }
 
 void Chunk::append(const Chunk& src, size_t offset, size_t count) {
+    _drop_hash_values_cache();
     DCHECK_EQ(num_columns(), src.num_columns());
     const size_t n = src.num_columns();
     for (size_t i = 0; i < n; i++) {
@@ -390,6 +475,7 @@ void Chunk::append(const Chunk& src, size_t offset, size_t count) {
 }
 
 void Chunk::append_safe(const Chunk& src, size_t offset, size_t count) {
+    _drop_hash_values_cache();
     DCHECK_EQ(num_columns(), src.num_columns());
     const size_t n = src.num_columns();
     size_t cur_rows = num_rows();
@@ -408,6 +494,16 @@ void Chunk::reserve(size_t cap) {
     }
 }
 
+bool Chunk::capacity_limit_reached_on_append(const Chunk& src) const {
+    DCHECK_EQ(num_columns(), src.num_columns());
+    for (size_t i = 0; i < _columns.size(); i++) {
+        if (_columns[i]->capacity_limit_reached_on_append(*src.get_column_by_index(i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool Chunk::has_const_column() const {
     for (const auto& c : _columns) {
         if (c->is_constant()) {
@@ -15,6 +15,14 @@ namespace vectorized {
 
 class DatumTuple;
 
+// The hash functions partitioning the rows for the shuffles.
+enum class ChunkHashFunction {
+    // Column::fvn_hash seeded by HashUtil::FNV_SEED, for the hash shuffles.
+    FNV,
+    // Column::crc32_hash seeded by 0, the data distribution of the tables, for the bucket shuffles.
+    CRC32,
+};
+
 class Chunk {
 public:
     using ChunkPtr = std::shared_ptr<Chunk>;
@@ -110,6 +118,10 @@ public:
     // The result value is the chunk data serialize size
     size_t serialize_with_meta(starrocks::ChunkPB* chunk) const;
 
+    // Serialize only the chunk meta to ChunkPB, the chunk data could be serialized by serialize() elsewhere,
+    // e.g. to a brpc attachment.
+    void serialize_meta(starrocks::ChunkPB* chunk) const;
+
     // Only serialize chunk data to dst
     // The serialize format:
     //     version(4 byte)
@@ -144,6 +156,9 @@ public:
     // Append |count| rows from |src|, started from |offset|, to the |this| chunk.
     void append(const Chunk& src, size_t offset, size_t count);
 
+    // Whether appending all the rows of |src| may exceed the capacity of any column of |this| chunk.
+    bool capacity_limit_reached_on_append(const Chunk& src) const;
+
     // columns in chunk may have same column ptr
     // append_safe will check size of all columns in dest chunk
     // to ensure same column will not apppend repeatedly
@@ -174,6 +189,12 @@ public:
     // Return the number of rows after filter.
     size_t filter_range(const Buffer<uint8_t>& selection, size_t from, size_t to);
 
+    // Compute the hash values of the rows on |key_columns| by |function| into |hash_values|.
+    // If the key columns are all columns of |this| chunk, the hash values are cached with the chunk, so the
+    // operators partitioning the same chunk on the same columns by the same function don't hash it again. The
+    // cache is dropped once the rows of the chunk change, e.g. filtered or appended.
+    void compute_hash_values(ChunkHashFunction function, const Columns& key_columns, Buffer<uint32_t>* hash_values);
+
     // Return the data of n-th row.
     // This method is relatively slow and mainly used for unit tests now.
     DatumTuple get(size_t n) const;
@@ -237,6 +258,15 @@ public:
 private:
     void rebuild_cid_index();
 
+    void _drop_hash_values_cache() { _hash_values_cache.clear(); }
+
+    struct CachedHashValues {
+        ChunkHashFunction function;
+        // Kept alive, so the columns can't be recycled as other columns with the same addresses.
+        Columns key_columns;
+        Buffer<uint32_t> hash_values;
+    };
+
     Columns _columns;
     std::shared_ptr<Schema> _schema;
     butil::FlatMap<ColumnId, size_t> _cid_to_index;
@@ -244,6 +274,7 @@ private:
     butil::FlatMap<SlotId, size_t> _slot_id_to_index;
     butil::FlatMap<TupleId, size_t> _tuple_id_to_index;
     DelCondSatisfied _delete_state = DEL_NOT_SATISFIED;
+    std::vector<CachedHashValues> _hash_values_cache;
 };
 
 inline const ColumnPtr& Chunk::get_column_by_name(const std::string& column_name) const {
@@ -117,6 +117,10 @@ public:
 
     virtual void append(const Column& src) { append(src, 0, src.size()); }
 
+    // Whether appending all the elements of |src| may exceed the capacity of |this| column, e.g. the 4GB of bytes
+    // addressed by the 32-bit offsets of BinaryColumn. It's conservative, and never gives false negatives.
+    virtual bool capacity_limit_reached_on_append(const Column& src) const { return false; }
+
     // This function will append data from src according to the input indexes. 'indexes' contains
     // the row index of the src.
     // This function will get row index from indexes and append the data to this column.
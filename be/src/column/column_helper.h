@@ -6,6 +6,7 @@
 #include <runtime/types.h>
 
 #include "column/const_column.h"
+#include "column/filter_kernels.h"
 #include "column/type_traits.h"
 #include "common/config.h"
 #include "gutil/bits.h"
@@ -171,6 +172,14 @@ public:
     static size_t compute_bytes_size(ColumnsConstIterator const& begin, ColumnsConstIterator const& end);
     template <typename T>
     static size_t filter_range(const Column::Filter& filter, T* data, size_t from, size_t to) {
+        if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) == 1) {
+            return filter_range_1byte(filter.data(), reinterpret_cast<uint8_t*>(data), from, to);
+        } else if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) == 4) {
+            return filter_range_4bytes(filter.data(), reinterpret_cast<uint32_t*>(data), from, to);
+        } else if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) == 8) {
+            return filter_range_8bytes(filter.data(), reinterpret_cast<uint64_t*>(data), from, to);
+        }
+
         auto start_offset = from;
         auto result_offset = from;
 
@@ -119,7 +119,7 @@ class CACHELINE_ALIGNED ColumnPool {
         static_assert(std::is_base_of<Column, T>::value, "Must_be_derived_of_Column");
 
     public:
-        explicit LocalPool(ColumnPool* pool) : _pool(pool) {
+        explicit LocalPool(ColumnPool* pool) : _pool(pool), _trim_epoch(pool->_trim_epoch.load()) {
             _curr_free.nfree = 0;
             _curr_free.bytes = 0;
         }
@@ -153,6 +153,10 @@ class CACHELINE_ALIGNED ColumnPool {
         }
 
         inline void return_object(T* ptr) {
+            if (UNLIKELY(_trim_epoch != _pool->_trim_epoch.load(std::memory_order_relaxed))) {
+                _trim_epoch = _pool->_trim_epoch.load(std::memory_order_relaxed);
+                release_all_objects();
+            }
             if (UNLIKELY(column_reserved_size(ptr) > config::vector_chunk_size)) {
                 UPDATE_BVAR(g_column_pool_oversized_columns, 1);
                 delete ptr;
@@ -189,11 +193,24 @@ class CACHELINE_ALIGNED ColumnPool {
             UPDATE_BVAR(g_column_pool_total_local_bytes, -freed_bytes);
         }
 
+        // Destroy all the free objects of this thread, instead of pushing them to the central free list.
+        inline void release_all_objects() {
+            for (size_t i = 0; i < _curr_free.nfree; i++) {
+                ASAN_UNPOISON_MEMORY_REGION(_curr_free.ptrs[i], sizeof(T));
+                delete _curr_free.ptrs[i];
+            }
+            UPDATE_BVAR(g_column_pool_total_local_bytes, -_curr_free.bytes);
+            _curr_free.nfree = 0;
+            _curr_free.bytes = 0;
+        }
+
         static inline void delete_local_pool(void* arg) { delete (LocalPool*)arg; }
 
     private:
         ColumnPool* _pool;
         FreeBlock _curr_free;
+        // The local free objects are released once this falls behind |_pool->_trim_epoch|.
+        int64_t _trim_epoch;
     };
 
 public:
@@ -256,6 +273,10 @@ public:
         }
     }
 
+    // Ask all threads to release their local free columns, each thread does so the next time it returns a
+    // column, because a local pool can only be accessed by its own thread.
+    inline void trim_local_columns() { _trim_epoch.fetch_add(1, std::memory_order_relaxed); }
+
     inline void clear_columns() {
         LocalPool* lp = _local_pool;
         if (lp) {
@@ -374,12 +395,13 @@ private:
     mutable std::mutex _free_blocks_lock;
     std::vector<DynamicFreeBlock*> _free_blocks;
     int64_t _first_push_time = 0;
+    std::atomic<int64_t> _trim_epoch{0};
 };
 
 using ColumnPoolList =
         TypeList<ColumnPool<Int8Column>, ColumnPool<UInt8Column>, ColumnPool<Int16Column>, ColumnPool<Int32Column>,
-                 ColumnPool<UInt32Column>, ColumnPool<Int64Column>, ColumnPool<Int128Column>, ColumnPool<FloatColumn>,
-                 ColumnPool<DoubleColumn>, ColumnPool<BinaryColumn>, ColumnPool<DateColumn>,
+                 ColumnPool<UInt32Column>, ColumnPool<Int64Column>, ColumnPool<UInt64Column>, ColumnPool<Int128Column>,
+                 ColumnPool<FloatColumn>, ColumnPool<DoubleColumn>, ColumnPool<BinaryColumn>, ColumnPool<DateColumn>,
                  ColumnPool<TimestampColumn>, ColumnPool<DecimalColumn>, ColumnPool<Decimal32Column>,
                  ColumnPool<Decimal64Column>, ColumnPool<Decimal128Column>>;
 
@@ -423,6 +445,12 @@ inline ColumnPoolInfo describe_column_pool() {
     return ColumnPool<T>::singleton()->describe_column_pool();
 }
 
+template <typename T>
+inline void trim_local_columns() {
+    static_assert(InList<ColumnPool<T>, ColumnPoolList>::value, "Cannot use column pool");
+    ColumnPool<T>::singleton()->trim_local_columns();
+}
+
 // Used in tests.
 template <typename T>
 inline void clear_columns() {
@@ -0,0 +1,225 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/filter_kernels.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "simd/simd.h"
+#include "util/cpu_dispatch.h"
+
+namespace starrocks::vectorized {
+
+template <typename T>
+static size_t filter_range_scalar(const uint8_t* filter, T* data, size_t from, size_t to, size_t result_offset) {
+    for (size_t i = from; i < to; ++i) {
+        if (filter[i]) {
+            data[result_offset++] = data[i];
+        }
+    }
+    return result_offset;
+}
+
+#ifdef __AVX2__
+
+// The bits of the nonzero bytes of filter[offset, offset + 16).
+static inline uint32_t nonzero_mask16(const uint8_t* filter, size_t offset) {
+    const __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i*>(filter + offset));
+    return ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(f, _mm_setzero_si128()))) & 0xffffu;
+}
+
+// The ith entry lists the positions of the set bits of i, which gather the values kept by the mask i.
+template <size_t kLanes, size_t kLaneWidth, typename Index>
+struct ShuffleTable {
+    Index indexes[1 << kLanes][kLanes * kLaneWidth];
+
+    constexpr ShuffleTable() : indexes() {
+        for (size_t mask = 0; mask < (1 << kLanes); ++mask) {
+            size_t n = 0;
+            for (size_t lane = 0; lane < kLanes; ++lane) {
+                if (mask & (1 << lane)) {
+                    for (size_t k = 0; k < kLaneWidth; ++k) {
+                        indexes[mask][n * kLaneWidth + k] = static_cast<Index>(lane * kLaneWidth + k);
+                    }
+                    ++n;
+                }
+            }
+        }
+    }
+};
+
+// 8 bytes selected by pshufb.
+alignas(16) static constexpr ShuffleTable<8, 1, uint8_t> kShuffleTable1Byte;
+
+static size_t filter_range_1byte_avx2(const uint8_t* filter, uint8_t* data, size_t from, size_t to) {
+    size_t src = from;
+    size_t dst = from;
+    // the values kept by the high 8 bits of the mask are from the high half of the values.
+    const __m128i high_half = _mm_set_epi64x(0x0808080808080808, 0);
+    for (; src + 16 <= to; src += 16) {
+        uint32_t mask = nonzero_mask16(filter, src);
+        if (mask == 0) {
+            continue;
+        }
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + src));
+        uint32_t low = mask & 0xff;
+        uint32_t high = mask >> 8;
+        const __m128i index =
+                _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(kShuffleTable1Byte.indexes[low])),
+                                   _mm_loadl_epi64(reinterpret_cast<const __m128i*>(kShuffleTable1Byte.indexes[high])));
+        const __m128i kept = _mm_shuffle_epi8(values, _mm_add_epi8(index, high_half));
+        // both stores are within the 16 values just loaded, since dst <= src.
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(data + dst), kept);
+        dst += __builtin_popcount(low);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(data + dst), _mm_unpackhi_epi64(kept, kept));
+        dst += __builtin_popcount(high);
+    }
+    return filter_range_scalar(filter, data, src, to, dst);
+}
+
+__attribute__((target("avx512f"))) static size_t filter_range_4bytes_avx512(const uint8_t* filter, uint32_t* data,
+                                                                             size_t from, size_t to) {
+    size_t src = from;
+    size_t dst = from;
+    for (; src + 16 <= to; src += 16) {
+        uint32_t mask = nonzero_mask16(filter, src);
+        if (mask == 0) {
+            continue;
+        }
+        const __m512i values = _mm512_loadu_si512(data + src);
+        _mm512_mask_compressstoreu_epi32(data + dst, static_cast<__mmask16>(mask), values);
+        dst += __builtin_popcount(mask);
+    }
+    return filter_range_scalar(filter, data, src, to, dst);
+}
+
+__attribute__((target("avx512f"))) static size_t filter_range_8bytes_avx512(const uint8_t* filter, uint64_t* data,
+                                                                             size_t from, size_t to) {
+    size_t src = from;
+    size_t dst = from;
+    for (; src + 16 <= to; src += 16) {
+        uint32_t mask = nonzero_mask16(filter, src);
+        if (mask == 0) {
+            continue;
+        }
+        const __m512i low_values = _mm512_loadu_si512(data + src);
+        const __m512i high_values = _mm512_loadu_si512(data + src + 8);
+        _mm512_mask_compressstoreu_epi64(data + dst, static_cast<__mmask8>(mask & 0xff), low_values);
+        dst += __builtin_popcount(mask & 0xff);
+        _mm512_mask_compressstoreu_epi64(data + dst, static_cast<__mmask8>(mask >> 8), high_values);
+        dst += __builtin_popcount(mask >> 8);
+    }
+    return filter_range_scalar(filter, data, src, to, dst);
+}
+
+// 8 lanes of 32 bits, and 4 lanes of 64 bits selected as pairs of 32 bits, by vpermd.
+alignas(32) static constexpr ShuffleTable<8, 1, uint32_t> kShuffleTable4Bytes;
+alignas(32) static constexpr ShuffleTable<4, 2, uint32_t> kShuffleTable8Bytes;
+
+static size_t filter_range_4bytes_avx2(const uint8_t* filter, uint32_t* data, size_t from, size_t to) {
+    size_t src = from;
+    size_t dst = from;
+    for (; src + 16 <= to; src += 16) {
+        uint32_t mask = nonzero_mask16(filter, src);
+        if (mask == 0) {
+            continue;
+        }
+        for (size_t k = 0; k < 2; ++k, mask >>= 8) {
+            uint32_t lanes = mask & 0xff;
+            const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + src + k * 8));
+            const auto* index_data = reinterpret_cast<const __m256i*>(kShuffleTable4Bytes.indexes[lanes]);
+            const __m256i index = _mm256_load_si256(index_data);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + dst), _mm256_permutevar8x32_epi32(values, index));
+            dst += __builtin_popcount(lanes);
+        }
+    }
+    return filter_range_scalar(filter, data, src, to, dst);
+}
+
+static size_t filter_range_8bytes_avx2(const uint8_t* filter, uint64_t* data, size_t from, size_t to) {
+    size_t src = from;
+    size_t dst = from;
+    for (; src + 16 <= to; src += 16) {
+        uint32_t mask = nonzero_mask16(filter, src);
+        if (mask == 0) {
+            continue;
+        }
+        for (size_t k = 0; k < 4; ++k, mask >>= 4) {
+            uint32_t lanes = mask & 0xf;
+            const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + src + k * 4));
+            const auto* index_data = reinterpret_cast<const __m256i*>(kShuffleTable8Bytes.indexes[lanes]);
+            const __m256i index = _mm256_load_si256(index_data);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + dst), _mm256_permutevar8x32_epi32(values, index));
+            dst += __builtin_popcount(lanes);
+        }
+    }
+    return filter_range_scalar(filter, data, src, to, dst);
+}
+
+__attribute__((target("avx512f,avx512bw"))) static size_t count_zero_bytes_avx512(const uint8_t* data, size_t size) {
+    size_t count = 0;
+    size_t i = 0;
+    const __m512i zero = _mm512_setzero_si512();
+    for (; i + 64 <= size; i += 64) {
+        count += __builtin_popcountll(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(data + i), zero));
+    }
+    return count + SIMD::count_zero(data + i, size - i);
+}
+
+#endif
+
+static size_t count_zero_bytes_baseline(const uint8_t* data, size_t size) {
+    return SIMD::count_zero(data, size);
+}
+
+// The versions of the kernels chosen for the cpu, which are the baseline ones until CpuDispatch::init().
+struct FilterKernels {
+    size_t (*filter_range_1byte)(const uint8_t* filter, uint8_t* data, size_t from, size_t to);
+    size_t (*filter_range_4bytes)(const uint8_t* filter, uint32_t* data, size_t from, size_t to);
+    size_t (*filter_range_8bytes)(const uint8_t* filter, uint64_t* data, size_t from, size_t to);
+    size_t (*count_zero_bytes)(const uint8_t* data, size_t size);
+};
+
+#ifdef __AVX2__
+static constexpr FilterKernels kBaselineKernels = {&filter_range_1byte_avx2, &filter_range_4bytes_avx2,
+                                                   &filter_range_8bytes_avx2, &count_zero_bytes_baseline};
+static constexpr FilterKernels kAVX512Kernels = {&filter_range_1byte_avx2, &filter_range_4bytes_avx512,
+                                                 &filter_range_8bytes_avx512, &count_zero_bytes_avx512};
+#else
+template <typename T>
+static size_t filter_range_fallback(const uint8_t* filter, T* data, size_t from, size_t to) {
+    return filter_range_scalar(filter, data, from, to, from);
+}
+
+static constexpr FilterKernels kBaselineKernels = {&filter_range_fallback<uint8_t>, &filter_range_fallback<uint32_t>,
+                                                   &filter_range_fallback<uint64_t>, &count_zero_bytes_baseline};
+static constexpr FilterKernels kAVX512Kernels = kBaselineKernels;
+#endif
+
+// constant initialized, so the kernels are usable while the other static variables are initialized.
+static FilterKernels kernels = kBaselineKernels;
+
+static void init_filter_kernels(SimdLevel level) {
+    kernels = level == SimdLevel::AVX512 ? kAVX512Kernels : kBaselineKernels;
+}
+
+[[maybe_unused]] static const bool filter_kernels_registered = CpuDispatch::register_table(&init_filter_kernels);
+
+size_t filter_range_1byte(const uint8_t* filter, uint8_t* data, size_t from, size_t to) {
+    return kernels.filter_range_1byte(filter, data, from, to);
+}
+
+size_t filter_range_4bytes(const uint8_t* filter, uint32_t* data, size_t from, size_t to) {
+    return kernels.filter_range_4bytes(filter, data, from, to);
+}
+
+size_t filter_range_8bytes(const uint8_t* filter, uint64_t* data, size_t from, size_t to) {
+    return kernels.filter_range_8bytes(filter, data, from, to);
+}
+
+size_t count_zero_bytes(const uint8_t* data, size_t size) {
+    return kernels.count_zero_bytes(data, size);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,28 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace starrocks::vectorized {
+
+// The SIMD kernels of filtering, dispatched by CpuDispatch to the best versions for the cpu.
+//
+// The compaction kernels of Column::filter_range for the fixed-width values of 1, 4 and 8 bytes, e.g. the null
+// maps, the integers, the floats and the dates.
+//
+// Each kernel moves the values of |data| in [from, to) whose |filter| byte is nonzero to the front of the range, in
+// order, and returns the end of the kept values. The values before |from| are untouched.
+//
+// The AVX-512 kernels compress 16 values at a time with VPCOMPRESSD/VPCOMPRESSQ. The baseline AVX2 kernels permute
+// the kept values of 8 (or 4) values with a lookup table of the shuffle masks. The 1-byte kernel shuffles 8 values
+// at a time with a lookup table.
+size_t filter_range_1byte(const uint8_t* filter, uint8_t* data, size_t from, size_t to);
+size_t filter_range_4bytes(const uint8_t* filter, uint32_t* data, size_t from, size_t to);
+size_t filter_range_8bytes(const uint8_t* filter, uint64_t* data, size_t from, size_t to);
+
+// The number of the zero bytes of data[0, size), i.e. the rows filtered out.
+size_t count_zero_bytes(const uint8_t* data, size_t size);
+
+} // namespace starrocks::vectorized
@@ -179,9 +179,17 @@ void FixedLengthColumnBase<T>::crc32_hash(uint32_t* hash, uint16_t from, uint16_
 template <typename T>
 void FixedLengthColumnBase<T>::put_mysql_row_buffer(MysqlRowBuffer* buf, size_t idx) const {
     if constexpr (IsDecimal<T>) {
-        buf->push_decimal(_data[idx].to_string());
+        char s[64];
+        int len = _data[idx].to_string(s);
+        buf->push_decimal(Slice(s, len));
     } else if constexpr (std::is_arithmetic_v<T>) {
         buf->push_number(_data[idx]);
+    } else if constexpr (std::is_same_v<T, DateValue> || std::is_same_v<T, TimestampValue>) {
+        // Format into the stack instead of allocating a string for every cell.
+        char s[T::max_string_length()];
+        int len = _data[idx].to_string(s, sizeof(s));
+        DCHECK_GT(len, 0);
+        buf->push_string(s, len);
     } else {
         // date/datetime or something else.
         std::string s = _data[idx].to_string();
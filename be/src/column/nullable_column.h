@@ -63,6 +63,10 @@ public:
 
     bool is_nullable() const override { return true; }
 
+    bool capacity_limit_reached_on_append(const Column& src) const override {
+        return _data_column->capacity_limit_reached_on_append(src);
+    }
+
     bool is_null(size_t index) const override {
         DCHECK_EQ(_null_column->size(), _data_column->size());
         return _has_null && immutable_null_column_data()[index];
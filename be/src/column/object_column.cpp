@@ -5,6 +5,7 @@
 #include "gutil/casts.h"
 #include "storage/hll.h"
 #include "util/bitmap_value.h"
+#include "util/json_value.h"
 #include "util/mysql_row_buffer.h"
 
 namespace starrocks::vectorized {
@@ -292,8 +293,20 @@ std::string ObjectColumn<BitmapValue>::debug_item(uint32_t idx) const {
     return _pool[idx].to_string();
 }
 
+template <>
+void ObjectColumn<JsonValue>::put_mysql_row_buffer(starrocks::MysqlRowBuffer* buf, size_t idx) const {
+    std::string json = _pool[idx].to_string();
+    buf->push_string(json.data(), json.size());
+}
+
+template <>
+std::string ObjectColumn<JsonValue>::debug_item(uint32_t idx) const {
+    return _pool[idx].to_string();
+}
+
 template class ObjectColumn<HyperLogLog>;
 template class ObjectColumn<BitmapValue>;
 template class ObjectColumn<PercentileValue>;
+template class ObjectColumn<JsonValue>;
 
 } // namespace starrocks::vectorized
@@ -110,6 +110,9 @@ CONF_mInt32(report_task_interval_seconds, "10");
 CONF_mInt32(report_disk_state_interval_seconds, "60");
 // the interval time(seconds) for agent report olap table to FE
 CONF_mInt32(report_tablet_interval_seconds, "60");
+// the interval time(seconds) for agent to report all the tablets to FE, only the changed tablets are reported in
+// between if FE supports it. 0 means to report all the tablets every time.
+CONF_mInt32(report_tablet_full_interval_seconds, "600");
 // the interval time(seconds) for agent report plugin status to FE
 // CONF_Int32(report_plugin_interval_seconds, "120");
 // the timeout(seconds) for alter table
@@ -120,6 +123,10 @@ CONF_mInt32(report_tablet_interval_seconds, "60");
 // CONF_Int32(release_snapshot_timeout_seconds, "600");
 // the max download speed(KB/s)
 CONF_mInt32(max_download_speed_kbps, "50000");
+// the max total download speed(KB/s) of all the clone tasks of a node, 0 means no limit.
+CONF_mInt32(clone_max_download_speed_kbps, "153600");
+// the max count of the files of a clone task downloaded in parallel
+CONF_mInt32(clone_download_parallelism, "4");
 // download low speed limit(KB/s)
 CONF_mInt32(download_low_speed_limit_kbps, "50");
 // download low speed time(seconds)
@@ -181,6 +188,8 @@ CONF_String(local_library_dir, "${UDF_RUNTIME_DIR}");
 CONF_Int32(doris_scanner_thread_pool_thread_num, "48");
 // number of olap scanner thread pool size
 CONF_Int32(doris_scanner_thread_pool_queue_size, "102400");
+// number of the threads reading ahead for the hdfs scanners
+CONF_Int32(hdfs_io_thread_pool_thread_num, "32");
 // number of etl thread pool size
 CONF_Int32(etl_thread_pool_size, "8");
 // number of etl thread pool size
@@ -191,6 +200,10 @@ CONF_Int32(port, "20001");
 CONF_Int32(thrift_connect_timeout_seconds, "3");
 // broker write timeout in seconds
 CONF_Int32(broker_write_timeout_seconds, "30");
+// The number of the preads of broker_read_ahead_block_size bytes sent to the broker ahead of the sequential reads
+// of a broker file, in parallel. The broker file is read synchronously, by the sizes of the reads, if it's 0.
+CONF_mInt32(broker_read_ahead_depth, "4");
+CONF_mInt64(broker_read_ahead_block_size, "1048576");
 // default thrift client retry interval (in milliseconds)
 CONF_mInt64(thrift_client_retry_interval_ms, "100");
 // max row count number for single scan range
@@ -223,10 +236,31 @@ CONF_mInt64(column_dictionary_key_size_threshold, "0");
 //CONF_String(module_output, "");
 // memory_limitation_per_thread_for_schema_change unit GB
 CONF_mInt32(memory_limitation_per_thread_for_schema_change, "2");
+// the max number of the rowsets of a tablet converted in parallel by a schema change or a rollup,
+// which share the memory limitation above.
+CONF_mInt32(alter_tablet_rowset_parallelism, "4");
 
 // CONF_Int64(max_unpacked_row_block_size, "104857600");
 
 CONF_mInt32(update_cache_expire_sec, "360");
+// Whether to persist the primary indexes of the primary key tablets as snapshot files, so that an index is
+// loaded from its latest snapshot plus the rowsets applied after it, instead of from all the rowsets.
+CONF_mBool(enable_primary_index_snapshot, "false");
+// A new snapshot of a primary index is written once so many keys have been changed since the last one.
+CONF_mInt64(primary_index_snapshot_min_changed_keys, "10000000");
+// The number of the threads to read the segments concurrently when loading a primary index, and to update the
+// shards of a primary index concurrently.
+CONF_Int32(primary_index_threads, "8");
+// A batch of at least so many primary keys is inserted or upserted into the shards of an index concurrently.
+CONF_mInt64(primary_index_parallel_batch_rows, "65536");
+// Whether to load the upserts and deletes of the next rowset commit of a primary key tablet while the current one
+// is being applied, i.e. while its index is updated and its delete vectors are written.
+CONF_mBool(enable_apply_prefetch, "true");
+// A delete vector of a segment is saved as the delta against its previous version, unless there are so many
+// deltas since its last full version, so at most so many deltas are read to load a delete vector.
+CONF_mInt32(del_vector_max_deltas, "8");
+// The capacity of the cached delete vectors, the unused ones are evicted once exceeded.
+CONF_mInt64(del_vector_cache_capacity, "1073741824");
 CONF_mInt32(file_descriptor_cache_clean_interval, "3600");
 CONF_mInt32(disk_stat_monitor_interval, "5");
 CONF_mInt32(unused_rowset_monitor_interval, "30");
@@ -254,6 +288,9 @@ CONF_Int32(file_descriptor_cache_capacity, "16384");
 // minimum file descriptor number
 // modify them upon necessity
 CONF_Int32(min_file_descriptor_number, "60000");
+// Read the batches of ranges of the local files, i.e. RandomAccessFile::read_at_batch(), with io_uring, which keeps
+// the reads in flight at once. Falls back to preadv if the kernel doesn't support io_uring.
+CONF_mBool(enable_io_uring, "false");
 CONF_Int64(index_stream_cache_capacity, "10737418240");
 // CONF_Int64(max_packed_row_block_size, "20971520");
 
@@ -261,6 +298,49 @@ CONF_Int64(index_stream_cache_capacity, "10737418240");
 CONF_String(storage_page_cache_limit, "0");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "true");
+// The percentage of the page cache for the index pages, which are not evicted by the data pages. 0 to cache
+// the index pages with the data pages.
+CONF_Int32(storage_page_cache_index_percent, "20");
+// The max percentage of the page cache for the pages that are hit more than once, so that a large scan doesn't
+// evict the frequently read pages. 0 to use LRU.
+CONF_Int32(storage_page_cache_protected_percent, "75");
+// Whether to evict the page cache by the CLOCK policy instead of LRU, whose hits only set a reference bit under a
+// shared lock, instead of moving the entry under the shard mutex. storage_page_cache_protected_percent is ignored.
+CONF_Bool(storage_page_cache_use_clock, "false");
+// The cache for the decoded data pages of the in_memory tables, e.g. the small hot dimension tables, whose hits
+// don't pay for decoding. 0 to disable it.
+CONF_String(storage_decoded_page_cache_limit, "0");
+// The max number of the threads to open the segments of a rowset in parallel, which reads their footers on the
+// first read of the rowset. 0 to open the segments one by one.
+CONF_Int32(segment_open_threads, "16");
+// Whether to open the segments of all the tablets and load their indexes in background after the BE starts,
+// so that the first queries after a restart don't wait for the small reads of the footers and indexes.
+CONF_Bool(warm_up_segments_on_start, "false");
+
+// The local directory to cache the blocks of the remote files, e.g. the files of hive tables on HDFS.
+// The block cache is disabled if it's empty.
+CONF_String(block_cache_dir, "");
+// The max bytes of the block cache.
+CONF_Int64(block_cache_capacity, "107374182400");
+// The remote files are cached in the aligned blocks of this size.
+CONF_Int64(block_cache_block_size, "1048576");
+// The max bytes of the metadata of the remote files cached in memory, e.g. the footers of the parquet files,
+// shared by all the queries, counted by their serialized sizes. The cache is disabled if it's 0.
+CONF_Int64(file_meta_cache_capacity, "268435456");
+// The max bytes of the partial aggregation results of the tablets cached in memory, shared by the repeated
+// aggregations over the same versions of the tablets. The cache is disabled if it's 0.
+CONF_Int64(query_cache_capacity, "0");
+// The max bytes of the descriptor tables of the plan fragments cached in memory, shared by the repeated identical
+// fragments, counted by the serialized sizes of their thrift tables. The cache is disabled if it's 0.
+CONF_Int64(descriptor_tbl_cache_capacity, "67108864");
+// The max bytes of the opened segments cached in memory, i.e. their footers and column readers, shared by all the
+// rowsets opening the same segment files. The cache is disabled if it's 0.
+CONF_Int64(segment_cache_capacity, "268435456");
+// The max bytes of the bitmaps of the rows deleted by the delete predicates cached in memory. The delete predicates of
+// a segment are materialized into a bitmap on its first read, if there are at least delete_bitmap_min_predicates
+// of them, and the later reads filter the rows by the bitmap. The cache is disabled if it's 0.
+CONF_Int64(delete_bitmap_cache_capacity, "134217728");
+CONF_mInt32(delete_bitmap_min_predicates, "2");
 
 CONF_mInt32(base_compaction_check_interval_seconds, "60");
 CONF_mInt64(base_compaction_num_cumulative_deltas, "5");
@@ -280,10 +360,23 @@ CONF_mInt64(cumulative_compaction_budgeted_bytes, "104857600");
 // compacting a version that might be queried (in case the query planning phase took some time).
 // the following config set the window size
 CONF_mInt32(cumulative_compaction_skip_window_seconds, "30");
+// The cumulative compaction of duplicate-key tablets merges the consecutive rowsets of similar size, instead of all
+// the rowsets after the cumulative point. The rowsets no larger than size_tiered_compaction_min_level_size are in
+// level 0, the size bound of each level is size_tiered_compaction_level_multiple times that of the level below,
+// and the rowsets of a level are merged once they have min_cumulative_compaction_num_singleton_deltas segments.
+// The rowsets of at least cumulative_compaction_budgeted_bytes are handed over to base compaction.
+CONF_mBool(enable_size_tiered_compaction_for_dup_keys, "true");
+CONF_mInt64(size_tiered_compaction_min_level_size, "1048576");
+CONF_mInt64(size_tiered_compaction_level_multiple, "5");
 
 CONF_mInt32(update_compaction_check_interval_seconds, "60");
 CONF_Int32(update_compaction_num_threads_per_disk, "1");
 CONF_Int32(update_compaction_per_tablet_min_interval_seconds, "120"); // 2min
+// Each rowset of a primary key tablet costs a seek for every read, so the tablets with more rowsets than this are
+// compacted first, e.g. after a burst of small loads, and their rowsets are compacted even if they have no deletes.
+CONF_mInt32(update_compaction_max_rowsets, "64");
+// The bytes of the input rowsets of the update compactions per second of a disk, 0 for unlimited.
+CONF_mInt64(update_compaction_per_disk_bytes_per_second, "0");
 
 // if compaction of a tablet failed, this tablet should not be chosen to
 // compaction until this interval passes.
@@ -296,6 +389,26 @@ CONF_mInt64(min_compaction_failure_interval_sec, "120"); // 2 min
 // This config can be set to 0, which means to forbid any compaction, for some special cases.
 CONF_Int32(max_compaction_concurrency, "-1");
 
+// Merge the key columns of the duplicate and unique key tablets first, then merge the value columns group by group
+// in the order of the merged keys, if the tablet has more columns than vertical_compaction_max_columns_per_group.
+CONF_mBool(enable_vertical_compaction, "true");
+CONF_mInt32(vertical_compaction_max_columns_per_group, "5");
+// The sources of the merged rows of a vertical compaction beyond this are spilled to a temporary file.
+CONF_mInt64(vertical_compaction_max_row_source_memory_bytes, "67108864"); // 64MB
+
+// The max bytes read and written per second by the base, cumulative and update compactions of a disk, 0 for
+// unlimited.
+CONF_mInt64(compaction_io_bytes_per_second_per_hdd, "104857600"); // 100MB
+CONF_mInt64(compaction_io_bytes_per_second_per_ssd, "0");
+// The compaction I/O rate of a disk backs off if the average latency of the scan I/O of the disk exceeds this,
+// 0 to never back off.
+CONF_mInt64(compaction_io_backoff_scan_io_latency_ms, "20");
+// Drop the segment files written by the compactions and the loads from the page cache once they are closed, so that
+// the background writes don't evict the pages read by the queries. The newly loaded data is often queried soon, so
+// it's only dropped for the compactions by default.
+CONF_mBool(drop_page_cache_of_compaction_output, "true");
+CONF_mBool(drop_page_cache_of_load_output, "false");
+
 // Threshold to logging compaction trace, in seconds.
 CONF_mInt32(base_compaction_trace_threshold, "120");
 CONF_mInt32(cumulative_compaction_trace_threshold, "60");
@@ -321,6 +434,27 @@ CONF_Int32(number_tablet_writer_threads, "16");
 CONF_Double(dictionary_encoding_ratio, "0.7");
 // The minimum chunk size for dictionary encoding speculation
 CONF_Int32(dictionary_speculate_min_chunk_size, "10000");
+// Encode the integer and datetime columns with DELTA_BINARY_PACKED and the float and double columns with ALP by
+// default, which are smaller and faster to scan for the time series. The segments written can't be read by the
+// older versions.
+CONF_mBool(enable_lightweight_encodings, "false");
+// Choose the encoding and the compression of the data pages of the numeric columns by trying the candidates on the
+// values of the first pages, and use the smallest ones for the following pages. The segments written can't be read
+// by the older versions.
+CONF_mBool(enable_adaptive_encoding, "false");
+// The number of the data pages sampled by the adaptive encoding of a column.
+CONF_mInt32(adaptive_encoding_sample_pages, "4");
+// The adaptive encoding only chooses the encoding and the compression whose decoding is at most so much slower than
+// the default ones, e.g. 0.2 means 20% slower.
+CONF_mDouble(adaptive_encoding_max_decode_slowdown, "0.2");
+// Compress the pages of the string columns by ZSTD with a dictionary trained from the first pages of the column at
+// the segment write time, which is stored in the segment footer. The short strings, e.g. the urls, are compressed
+// much better than by LZ4 page by page. The segments written can't be read by the older versions.
+CONF_mBool(enable_zstd_dict_compression, "false");
+// The maximum size of the ZSTD dictionary of a column.
+CONF_mInt32(zstd_dict_size, "16384");
+// The ZSTD dictionary of a column is trained from the first pages of about so many bytes.
+CONF_mInt64(zstd_dict_sample_bytes, "1048576");
 
 // The maximum amount of data that can be processed by a stream load
 CONF_mInt64(streaming_load_max_mb, "10240");
@@ -328,6 +462,20 @@ CONF_mInt64(streaming_load_max_mb, "10240");
 // Therefore, it is necessary to limit the maximum number of
 // such data when using stream load to prevent excessive memory consumption.
 CONF_mInt64(streaming_load_max_batch_size_mb, "100");
+// The number of threads to parse the csv data of a stream load, which is split into blocks of
+// streaming_load_parse_block_size bytes at the record boundaries. The data is parsed by one thread if it's 1.
+CONF_mInt32(streaming_load_parse_parallelism, "4");
+CONF_mInt64(streaming_load_parse_block_size, "4194304");
+// The number of the buffers of streaming_load_read_ahead_buffer_size bytes read ahead of the decompression of a
+// compressed load file, and of its parsing. The reads, the decompression and the parsing of the file are pipelined
+// by separate threads if it's positive.
+CONF_mInt32(streaming_load_read_ahead_buffer_num, "4");
+CONF_mInt64(streaming_load_read_ahead_buffer_size, "1048576");
+// The concurrent stream loads with the header `group_commit: true` into the same table with the same properties are
+// merged into one transaction, which is committed once it has been open for this interval, or the bodies of its loads
+// have reached stream_load_group_commit_max_bytes. See StreamLoadGroupCommitMgr.
+CONF_mInt32(stream_load_group_commit_interval_ms, "1000");
+CONF_mInt64(stream_load_group_commit_max_bytes, "67108864");
 // the alive time of a TabletsChannel.
 // If the channel does not receive any data till this time,
 // the channel will be removed.
@@ -335,6 +483,9 @@ CONF_Int32(streaming_load_rpc_max_alive_time_sec, "1200");
 // the timeout of a rpc to open the tablet writer in remote BE.
 // short operation time, can set a short timeout
 CONF_Int32(tablet_writer_open_rpc_timeout_sec, "60");
+// In the replicated storage, the max time for a secondary replica to wait for the rowset of the primary replica,
+// including the time to download the rowset.
+CONF_mInt32(tablet_writer_replicate_rowset_timeout_sec, "600");
 // Deprecated, use query_timeout instread
 // the timeout of a rpc to process one batch in tablet writer.
 // you may need to increase this timeout if using larger 'streaming_load_max_mb',
@@ -385,12 +536,23 @@ CONF_Bool(use_mmap_allocate_chunk, "false");
 // acquire more free memory which can not be used by other modules
 CONF_Int64(chunk_reserved_bytes_limit, "2147483648");
 
+// Whether a free chunk cached by the cores of another NUMA node can be reused. The memory of a chunk is on
+// the NUMA node of the core that allocated it, so reusing it from another node makes every access remote.
+CONF_Bool(chunk_reuse_across_numa_nodes, "false");
+
+// Whether to back the chunks of at least 2MB, e.g. the buffers of the large columns, by the transparent
+// huge pages, which saves the TLB misses of scanning them.
+CONF_Bool(use_huge_page_for_large_chunk, "false");
+
 // The probing algorithm of partitioned hash table.
 // Enable quadratic probing hash table
 CONF_Bool(enable_quadratic_probing, "false");
 
 // for pprof
 CONF_String(pprof_profile_dir, "${STARROCKS_HOME}/log");
+// the number of the cpu samples per second of cpu time taken by the sampler tagging them with the query running,
+// they are available at /pprof/query_cpu. 0 to disable the sampler.
+CONF_Int32(cpu_sample_frequency, "10");
 
 // for partition
 // CONF_Bool(enable_partitioned_hash_join, "false")
@@ -445,6 +607,13 @@ CONF_Int32(memory_max_alignment, "16");
 
 // write buffer size before flush
 CONF_mInt64(write_buffer_size, "104857600");
+// A memtable may grow beyond write_buffer_size up to this size while the load memory is below its soft limit,
+// see load_process_soft_mem_limit_percent.
+CONF_mInt64(write_buffer_size_max, "419430400");
+// A flushed memtable larger than this is split by the sorted keys into several segments written in parallel,
+// at most memtable_flush_max_parallel_segments segments.
+CONF_mInt64(memtable_flush_min_bytes_per_parallel_segment, "268435456"); // 256MB
+CONF_mInt32(memtable_flush_max_parallel_segments, "4");
 
 // following 2 configs limit the memory consumption of load process on a Backend.
 // eg: memory limit to 80% of mem limit config but up to 100GB(default)
@@ -453,6 +622,9 @@ CONF_mInt64(write_buffer_size, "104857600");
 // user should set these configs properly if necessary.
 CONF_Int64(load_process_max_memory_limit_bytes, "107374182400"); // 100GB
 CONF_Int32(load_process_max_memory_limit_percent, "30");         // 30%
+// The soft limit of the load memory, in percent of its limit. Once it's exceeded, the largest memtables of all the
+// loads are flushed asynchronously until the memory not being flushed is below it.
+CONF_mInt32(load_process_soft_mem_limit_percent, "80");
 CONF_Int64(compaction_mem_limit, "2147483648");                  // 2G
 
 // update interval of tablet stat cache
@@ -501,6 +673,13 @@ CONF_String(es_scroll_keepalive, "5m");
 // HTTP connection timeout for es
 CONF_Int32(es_http_timeout_ms, "5000");
 
+// the number of the slices of the sliced scroll by which an es shard is read in parallel
+CONF_mInt32(es_scroll_slices_per_shard, "1");
+
+// the max number of the ranges of the integer primary key by which a mysql table is read in parallel on
+// their own connections, 1 to read it by one connection
+CONF_mInt32(mysql_scan_parallelism, "4");
+
 // the max client cache number per each host
 // There are variety of client cache in BE, but currently we use the
 // same cache size configuration.
@@ -541,6 +720,9 @@ CONF_mInt64(max_runnings_transactions_per_txn_map, "100");
 // tablet_map_lock shard size, the value is 2^n, n=0,1,2,3,4
 // this is a an enhancement for better performance to manage tablet
 CONF_Int32(tablet_map_shard_size, "1");
+// The number of the threads to load the tablet metas of each data dir concurrently at startup, in batches of
+// consecutive tablet ids. The tablets of a data dir are loaded one by one if it's 1.
+CONF_Int32(tablet_meta_load_threads_per_dir, "8");
 
 CONF_String(plugin_path, "${STARROCKS_HOME}/plugin");
 
@@ -560,6 +742,66 @@ CONF_Bool(ignore_rowset_stale_unconsistent_delete, "false");
 
 // The chunk size for vector query engine
 CONF_Int32(vector_chunk_size, "4096");
+// The scans of the tablets read the wide rows in fewer rows a chunk than vector_chunk_size, so the columns of a
+// chunk approximately fit in so many bytes, e.g. the L2 cache, 0 means always vector_chunk_size rows.
+CONF_mInt64(scan_chunk_target_bytes, "2097152");
+
+// Once the memory consumption of the process exceeds this percent of its limit, all the free columns of the
+// column pool are released, including the ones cached by the threads, instead of half of the central ones.
+CONF_mInt32(column_pool_trim_mem_percent, "80");
+
+// Whether the project node extracts the subexpressions repeated in its expressions into the common expressions,
+// which are evaluated once per chunk, in addition to the ones planned by FE.
+CONF_mBool(enable_project_common_sub_expr_elimination, "true");
+
+// Whether a deterministic function of a low cardinality string column, whose other arguments are constants, is
+// evaluated once per distinct string of a chunk, and the results are mapped to the rows by their codes.
+CONF_mBool(enable_low_cardinality_function_evaluation, "true");
+
+// The streaming pre-aggregation in auto mode decides whether to aggregate or pass through the input for each
+// window of so many chunks, by the reduction ratio and the probe cost of the hash map in the last window.
+CONF_mInt32(streaming_agg_window_chunks, "16");
+// The passthrough windows double while the input stays hard to reduce, up to so many windows.
+CONF_mInt32(streaming_agg_max_passthrough_windows, "64");
+// The cost to aggregate a row into an in-cache hash map in nanoseconds, the reduction ratio required to aggregate
+// grows in proportion to the measured cost over this.
+CONF_mInt32(streaming_agg_cheap_probe_ns, "50");
+
+// The hash table of the hash join is built in radix-partitioned mode once the build side has at least
+// so many rows, 0 means never. In this mode, the build rows are clustered by the high bits of their buckets,
+// so that the buckets, the chains and the keys probed by a key lie in a cache-sized region.
+CONF_Int64(join_hash_table_radix_partition_min_rows, "4194304");
+
+// The hash table of the hash join with a single integer key maps the keys to the buckets directly, i.e. the
+// bucket of a key is key - min, if the range of the build keys is within so many times the build row count.
+// The probe computes no hash then. 0 means never.
+CONF_mInt32(join_hash_table_direct_mapping_max_ratio, "4");
+
+// The bloom filters of the join runtime filters are sized by the build row count for this false positive
+// probability. It must be the same on all the BEs, because the filters of a broadcast join built by them are merged.
+CONF_Double(runtime_filter_bloom_filter_fpp, "0.05");
+
+// The vectorized hash join spills the build and probe rows into the scratch dirs and joins them partition by
+// partition (grace hash join), once the memory of the fragment instance, the query or the process exceeds so many
+// percent of the mem limit and its hash table is the largest of the spillable operators of the instance,
+// 0 means never.
+CONF_mInt32(hash_join_spill_mem_limit_percent, "80");
+// The number of partitions that each level of the spilled hash join partitions the rows into.
+CONF_mInt32(hash_join_spill_partitions, "16");
+
+// The vectorized blocking aggregation spills its groups into the scratch dirs and merges them partition by
+// partition, once the memory exceeds so many percent of the mem limit and its hash map is the largest of the
+// spillable operators, like the hash join, 0 means never.
+CONF_mInt32(agg_spill_mem_limit_percent, "80");
+// The number of partitions that each level of the spilled aggregation partitions the groups into.
+CONF_mInt32(agg_spill_partitions, "16");
+
+// The vectorized full sort spills its rows into the scratch dirs as sorted runs, which are merged in order, once
+// the memory exceeds so many percent of the mem limit and its buffered rows are the largest of the spillable
+// operators, like the hash join, 0 means never.
+CONF_mInt32(sort_spill_mem_limit_percent, "80");
+// The spillable operators never spill less memory than so many percent of the mem limit.
+CONF_mInt32(spill_min_mem_limit_percent, "1");
 
 // valid range: [0-1000].
 // `0` will disable late materialization.
@@ -619,6 +861,65 @@ CONF_Int64(pipeline_yield_max_chunks_moved, "100");
 // yield PipelineDriver when maximum time in nano-seconds has spent
 // in current execution round.
 CONF_Int64(pipeline_yield_max_time_spent, "100000000");
+// number of threads of the pipeline driver dispatcher, 0 means the number of
+// hardware threads.
+CONF_Int32(pipeline_exec_thread_pool_thread_num, "3");
+// use the work-stealing driver queue with one local queue per dispatcher thread
+// instead of the driver queue guarded by a global lock.
+CONF_Bool(pipeline_enable_work_stealing_driver_queue, "true");
+// the tablets of DUP_KEYS with more rows are split into morsels of consecutive segments, each of which
+// contains about this number of rows, so that a large tablet could be scanned by multiple drivers.
+// 0 means never splitting a tablet.
+CONF_Int64(pipeline_scan_morsel_split_rows, "4194304");
+// the column chunks of a parquet row group to read are merged into one read if the gap between them is not
+// larger than this number of bytes.
+CONF_mInt64(parquet_coalesce_read_max_gap_bytes, "1048576");
+// the maximum bytes of the merged column chunks read ahead for a parquet row group, the column chunks which
+// don't fit are read by the column readers by themselves. 0 means never reading them ahead.
+CONF_mInt64(parquet_coalesce_read_max_buffer_bytes, "33554432");
+// whether to skip the pages of parquet files which don't match the min/max conjuncts by the page indexes.
+CONF_mBool(parquet_page_index_enable, "true");
+// whether to skip the parquet row groups by the bloom filters of the columns with equal or in conjuncts.
+CONF_mBool(parquet_bloom_filter_enable, "true");
+// whether to read the parquet columns without conjuncts after evaluating the conjuncts, only for the rows
+// selected by them, the pages of which no row is selected are not read.
+CONF_mBool(parquet_late_materialization_enable, "true");
+// the number of rows of a row group of the parquet files exported by SELECT INTO OUTFILE, a row group is encoded and
+// written by a background thread while the rows of the next one are converted.
+CONF_mInt64(export_parquet_row_group_rows, "1000000");
+// the maximum bytes read ahead and not consumed yet by the hdfs scanners of one scan node, the next row groups
+// are read ahead on the hdfs io threads while the current one is decoded. 0 means never reading them ahead.
+CONF_mInt64(hdfs_scan_prefetch_max_bytes, "268435456");
+// the maximum number of the idle handles of the hdfs files kept open for the following scans of the same files,
+// and the seconds after which an idle handle is closed. 0 means the handles are closed once a scan is done.
+CONF_mInt64(hdfs_file_cache_capacity, "1024");
+CONF_mInt64(hdfs_file_cache_idle_seconds, "60");
+// the scan ranges of an orc file are split into the units of this size, which are read by several scanners in
+// parallel, each scanner reads the stripes starting in its unit. 0 means a file is read by one scanner.
+CONF_mInt64(hdfs_orc_scan_unit_size, "268435456");
+// the maximum number of pending requests per destination of the pipeline SinkBuffer,
+// the ExchangeSinkOperators are blocked when the buffer is full.
+CONF_Int64(pipeline_sink_buffer_size, "64");
+// the pending requests of a destination are merged into one rpc, until the merged
+// request exceeds this number of bytes.
+CONF_Int64(pipeline_sink_brpc_max_request_bytes, "1048576");
+// whether the pending requests of the pipeline SinkBuffer to the destinations on the same backend are batched
+// into one rpc. It should be disabled while upgrading from the version which can't receive batched requests.
+CONF_mBool(pipeline_sink_batch_destinations_of_backend, "true");
+// the maximum number of chunks read ahead by one io task of the pipeline scan operator.
+CONF_Int64(pipeline_scan_prefetch_max_chunks, "4");
+// the maximum bytes of the chunks read ahead but not processed by one pipeline scan operator.
+CONF_Int64(pipeline_scan_prefetch_max_bytes, "16777216");
+// the maximum bytes of the chunks buffered by the local exchange per source driver, the sinks of a local
+// exchange are blocked when the buffer of a source fed by them is full.
+CONF_Int64(pipeline_local_exchange_buffer_bytes_per_driver, "134217728");
+// the resource groups of the pipeline engine in the format of "name:cpu_weight:concurrency_limit" separated
+// by ';', e.g. "dashboard:8:0;adhoc:2:16", concurrency_limit 0 means no limit. The queries without a resource
+// group or with an unknown one are put into the "default" group.
+CONF_String(pipeline_resource_groups, "");
+// the plan fragments received through brpc are saved into this directory if it's not empty, one subdirectory
+// per query, so they can be executed again by "starrocks_be query_bench". Only for benchmarking.
+CONF_String(plan_fragment_dump_dir, "");
 } // namespace config
 
 } // namespace starrocks
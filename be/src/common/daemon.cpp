@@ -58,6 +58,7 @@
 #include "runtime/user_function_cache.h"
 #include "runtime/vectorized/time_types.h"
 #include "storage/options.h"
+#include "util/cpu_dispatch.h"
 #include "util/cpu_info.h"
 #include "util/debug_util.h"
 #include "util/disk_info.h"
@@ -75,17 +76,21 @@ bool k_starrocks_exit = false;
 
 class ReleaseColumnPool {
 public:
-    explicit ReleaseColumnPool(double ratio) : _ratio(ratio) {}
+    ReleaseColumnPool(double ratio, bool trim_local) : _ratio(ratio), _trim_local(trim_local) {}
 
     template <typename Pool>
     void operator()() {
         _freed_bytes += Pool::singleton()->release_free_columns(_ratio);
+        if (_trim_local) {
+            Pool::singleton()->trim_local_columns();
+        }
     }
 
     size_t freed_bytes() const { return _freed_bytes; }
 
 private:
     double _ratio;
+    bool _trim_local;
     size_t _freed_bytes = 0;
 };
 
@@ -97,7 +102,12 @@ void* tcmalloc_gc_thread(void* dummy) {
 #if !defined(ADDRESS_SANITIZER) && !defined(LEAK_SANITIZER) && !defined(THREAD_SANITIZER)
         MallocExtension::instance()->MarkThreadBusy();
 #endif
-        ReleaseColumnPool releaser(kFreeRatio);
+        ExecEnv* env = ExecEnv::GetInstance();
+        MemTracker* process_mem_tracker = env->process_mem_tracker();
+        bool trim_all = process_mem_tracker != nullptr && process_mem_tracker->limit() > 0 &&
+                        process_mem_tracker->consumption() >
+                                process_mem_tracker->limit() / 100 * config::column_pool_trim_mem_percent;
+        ReleaseColumnPool releaser(trim_all ? 1.0 : kFreeRatio, trim_all);
         ForEach<ColumnPoolList>(releaser);
         LOG_IF(INFO, releaser.freed_bytes() > 0) << "Released " << releaser.freed_bytes() << " bytes from column pool";
         auto* local_column_pool_mem_tracker = ExecEnv::GetInstance()->local_column_pool_mem_tracker();
@@ -301,6 +311,7 @@ void init_daemon(int argc, char** argv, const std::vector<StorePath>& paths) {
 
     init_thrift_logging();
     CpuInfo::init();
+    CpuDispatch::init();
     DiskInfo::init();
     MemInfo::init();
     UserFunctionCache::instance()->init(config::user_function_dir);
@@ -0,0 +1,347 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "env/block_cache.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+#include "common/logging.h"
+#include "gutil/strings/substitute.h"
+#include "util/coding.h"
+#include "util/hash_util.hpp"
+
+namespace starrocks {
+
+// The header of a block file: the magic number, the size of the key and the key.
+static constexpr uint32_t kMagicNumber = 0x53524243;
+static constexpr size_t kFixedHeaderSize = sizeof(uint32_t) * 2;
+static const std::string kTmpFileInfix = ".tmp."; // NOLINT
+
+BlockCache* BlockCache::_s_instance = nullptr;
+
+Status BlockCache::create_global_cache(const std::string& dir, int64_t capacity, int64_t block_size) {
+    if (dir.empty() || _s_instance != nullptr) {
+        return Status::OK();
+    }
+    if (capacity <= 0 || block_size <= 0) {
+        return Status::InvalidArgument(
+                strings::Substitute("invalid block cache, capacity=$0, block_size=$1", capacity, block_size));
+    }
+    auto cache = std::make_unique<BlockCache>(dir, capacity, block_size);
+    RETURN_IF_ERROR(cache->init());
+    _s_instance = cache.release();
+    return Status::OK();
+}
+
+void BlockCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+BlockCache::BlockCache(std::string dir, int64_t capacity, int64_t block_size)
+        : _dir(std::move(dir)),
+          _capacity(capacity),
+          _block_size(block_size),
+          _env(Env::Default()),
+          _max_candidates(std::max<int64_t>(1, capacity / block_size)) {}
+
+Status BlockCache::init() {
+    RETURN_IF_ERROR(_env->create_dir_if_missing(_dir));
+    std::vector<std::string> children;
+    RETURN_IF_ERROR(_env->get_children(_dir, &children));
+
+    std::vector<std::pair<uint64_t, Entry>> entries;
+    std::vector<std::string> invalid_files;
+    for (const auto& name : children) {
+        if (name == "." || name == "..") {
+            continue;
+        }
+        // the files not renamed are left by a crash.
+        if (name.find(kTmpFileInfix) != std::string::npos) {
+            invalid_files.push_back(_path(name));
+            continue;
+        }
+        Entry entry;
+        uint64_t mtime = 0;
+        Status st = _load_file(name, &entry);
+        if (st.ok()) {
+            st = _env->get_file_modified_time(_path(name), &mtime);
+        }
+        if (!st.ok()) {
+            LOG(WARNING) << "Invalid block cache file " << _path(name) << ": " << st.to_string();
+            invalid_files.push_back(_path(name));
+            continue;
+        }
+        entries.emplace_back(mtime, std::move(entry));
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    {
+        std::lock_guard l(_mutex);
+        for (auto& [mtime, entry] : entries) {
+            _add_entry(std::move(entry), &invalid_files);
+        }
+        LOG(INFO) << "Loaded " << _lru.size() << " blocks of " << _usage << " bytes from block cache " << _dir;
+    }
+    _delete_files(invalid_files);
+    return Status::OK();
+}
+
+Status BlockCache::read(const std::string& key, uint64_t offset, const Slice& result, bool* hit) {
+    *hit = false;
+    const std::string file_name = _file_name(key);
+    size_t header_size = 0;
+    {
+        std::lock_guard l(_mutex);
+        auto iter = _entries.find(file_name);
+        if (iter == _entries.end() || iter->second->key != key) {
+            return Status::OK();
+        }
+        const Entry& entry = *iter->second;
+        if (entry.header_size + offset + result.size > entry.size) {
+            return Status::OK();
+        }
+        header_size = entry.header_size;
+        _lru.splice(_lru.begin(), _lru, iter->second);
+    }
+
+    // The file could be deleted by an eviction after the lock is released, which is just a miss.
+    std::unique_ptr<RandomAccessFile> file;
+    Status st = _env->new_random_access_file(_path(file_name), &file);
+    if (st.ok()) {
+        st = file->read_at(header_size + offset, result);
+    }
+    if (!st.ok()) {
+        VLOG(1) << "Fail to read block cache file " << _path(file_name) << ": " << st.to_string();
+        _remove_entry(file_name);
+        return Status::OK();
+    }
+    *hit = true;
+    return Status::OK();
+}
+
+bool BlockCache::should_admit(const std::string& key) {
+    std::lock_guard l(_mutex);
+    auto iter = _candidate_index.find(key);
+    if (iter != _candidate_index.end()) {
+        _candidates.erase(iter->second);
+        _candidate_index.erase(iter);
+        return true;
+    }
+    _candidates.push_front(key);
+    _candidate_index.emplace(key, _candidates.begin());
+    if (_candidates.size() > _max_candidates) {
+        _candidate_index.erase(_candidates.back());
+        _candidates.pop_back();
+    }
+    return false;
+}
+
+Status BlockCache::insert(const std::string& key, const Slice& data) {
+    const std::string header = _encode_header(key);
+    if (static_cast<int64_t>(header.size() + data.size) > _capacity) {
+        return Status::OK();
+    }
+    const std::string file_name = _file_name(key);
+    std::string tmp_path;
+    {
+        std::lock_guard l(_mutex);
+        tmp_path = _path(file_name + kTmpFileInfix + std::to_string(_next_tmp_id++));
+    }
+
+    // Write to a temporary file first, so that a crash never leaves a partial block file.
+    std::unique_ptr<WritableFile> file;
+    RETURN_IF_ERROR(_env->new_writable_file(tmp_path, &file));
+    Slice slices[2] = {Slice(header), data};
+    Status st = file->appendv(slices, 2);
+    if (st.ok()) {
+        st = file->close();
+    }
+    if (st.ok()) {
+        st = _env->rename_file(tmp_path, _path(file_name));
+    }
+    if (!st.ok()) {
+        _env->delete_file(tmp_path);
+        return st;
+    }
+
+    Entry entry;
+    entry.key = key;
+    entry.file_name = file_name;
+    entry.header_size = header.size();
+    entry.size = header.size() + data.size;
+    std::vector<std::string> deleted_files;
+    {
+        std::lock_guard l(_mutex);
+        _add_entry(std::move(entry), &deleted_files);
+    }
+    _delete_files(deleted_files);
+    return Status::OK();
+}
+
+size_t BlockCache::num_blocks() const {
+    std::lock_guard l(_mutex);
+    return _lru.size();
+}
+
+int64_t BlockCache::usage() const {
+    std::lock_guard l(_mutex);
+    return _usage;
+}
+
+std::string BlockCache::_file_name(const std::string& key) {
+    uint64_t hash1 = HashUtil::murmur_hash64A(key.data(), key.size(), 0);
+    uint64_t hash2 = HashUtil::murmur_hash64A(key.data(), key.size(), HashUtil::MURMUR_SEED);
+    return fmt::format("{:016x}{:016x}", hash1, hash2);
+}
+
+std::string BlockCache::_encode_header(const std::string& key) {
+    std::string header(kFixedHeaderSize, '\0');
+    encode_fixed32_le(reinterpret_cast<uint8_t*>(header.data()), kMagicNumber);
+    encode_fixed32_le(reinterpret_cast<uint8_t*>(header.data()) + sizeof(uint32_t), key.size());
+    header.append(key);
+    return header;
+}
+
+Status BlockCache::_load_file(const std::string& file_name, Entry* entry) {
+    std::unique_ptr<RandomAccessFile> file;
+    RETURN_IF_ERROR(_env->new_random_access_file(_path(file_name), &file));
+    uint64_t size = 0;
+    RETURN_IF_ERROR(file->size(&size));
+    uint8_t fixed_header[kFixedHeaderSize];
+    if (size < kFixedHeaderSize) {
+        return Status::Corruption("block cache file is too small");
+    }
+    RETURN_IF_ERROR(file->read_at(0, Slice(fixed_header, kFixedHeaderSize)));
+    uint32_t key_size = decode_fixed32_le(fixed_header + sizeof(uint32_t));
+    if (decode_fixed32_le(fixed_header) != kMagicNumber || kFixedHeaderSize + key_size > size) {
+        return Status::Corruption("bad block cache file header");
+    }
+    entry->key.resize(key_size);
+    RETURN_IF_ERROR(file->read_at(kFixedHeaderSize, Slice(entry->key.data(), key_size)));
+    if (_file_name(entry->key) != file_name) {
+        return Status::Corruption("block cache file name mismatches its key");
+    }
+    entry->file_name = file_name;
+    entry->header_size = kFixedHeaderSize + key_size;
+    entry->size = size;
+    return Status::OK();
+}
+
+void BlockCache::_add_entry(Entry entry, std::vector<std::string>* deleted_files) {
+    auto iter = _entries.find(entry.file_name);
+    if (iter != _entries.end()) {
+        // the file is already replaced by the new one.
+        _usage -= iter->second->size;
+        _lru.erase(iter->second);
+        _entries.erase(iter);
+    }
+    _usage += entry.size;
+    _lru.push_front(std::move(entry));
+    _entries.emplace(_lru.front().file_name, _lru.begin());
+
+    while (_usage > _capacity && _lru.size() > 1) {
+        const Entry& old = _lru.back();
+        deleted_files->push_back(_path(old.file_name));
+        _usage -= old.size;
+        _entries.erase(old.file_name);
+        _lru.pop_back();
+    }
+}
+
+void BlockCache::_remove_entry(const std::string& file_name) {
+    std::lock_guard l(_mutex);
+    auto iter = _entries.find(file_name);
+    if (iter != _entries.end()) {
+        _usage -= iter->second->size;
+        _lru.erase(iter->second);
+        _entries.erase(iter);
+    }
+}
+
+void BlockCache::_delete_files(const std::vector<std::string>& files) {
+    // A block evicted here could be inserted again concurrently, and its new file is deleted, which is
+    // detected as a miss by the next read of it.
+    for (const auto& file : files) {
+        Status st = _env->delete_file(file);
+        if (!st.ok() && !st.is_not_found()) {
+            LOG(WARNING) << "Fail to delete block cache file " << file << ": " << st.to_string();
+        }
+    }
+}
+
+CachedRandomAccessFile::CachedRandomAccessFile(BlockCache* cache, std::shared_ptr<RandomAccessFile> file,
+                                               int64_t modification_time, uint64_t file_length)
+        : _cache(cache), _file(std::move(file)), _modification_time(modification_time), _file_length(file_length) {}
+
+std::string CachedRandomAccessFile::_block_key(uint64_t block_index) const {
+    std::string key = _file->file_name();
+    key.push_back('\0');
+    key.append(std::to_string(_modification_time));
+    key.push_back('\0');
+    key.append(std::to_string(block_index));
+    return key;
+}
+
+Status CachedRandomAccessFile::read(uint64_t offset, Slice* res) const {
+    if (offset >= _file_length) {
+        res->size = 0;
+        return Status::OK();
+    }
+    res->size = std::min<uint64_t>(res->size, _file_length - offset);
+    return read_at(offset, *res);
+}
+
+Status CachedRandomAccessFile::read_at(uint64_t offset, const Slice& res) const {
+    if (offset + res.size > _file_length) {
+        return _file->read_at(offset, res);
+    }
+    const uint64_t block_size = _cache->block_size();
+    size_t num_read = 0;
+    while (num_read < res.size) {
+        const uint64_t pos = offset + num_read;
+        const uint64_t block_index = pos / block_size;
+        const uint64_t block_offset = block_index * block_size;
+        const size_t block_length = std::min(block_size, _file_length - block_offset);
+        const size_t offset_in_block = pos - block_offset;
+        const size_t length = std::min(res.size - num_read, block_length - offset_in_block);
+        Slice slice(res.data + num_read, length);
+
+        const std::string key = _block_key(block_index);
+        bool hit = false;
+        RETURN_IF_ERROR(_cache->read(key, offset_in_block, slice, &hit));
+        if (hit) {
+            _cached_read_bytes += length;
+        } else if (_cache->should_admit(key)) {
+            // read the whole block to cache it.
+            _buffer.resize(block_length);
+            RETURN_IF_ERROR(_file->read_at(block_offset, Slice(_buffer.data(), block_length)));
+            memcpy(slice.data, _buffer.data() + offset_in_block, length);
+            Status st = _cache->insert(key, Slice(_buffer.data(), block_length));
+            LOG_IF(WARNING, !st.ok()) << "Fail to insert block cache: " << st.to_string();
+        } else {
+            RETURN_IF_ERROR(_file->read_at(pos, slice));
+        }
+        num_read += length;
+    }
+    return Status::OK();
+}
+
+Status CachedRandomAccessFile::readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const {
+    for (size_t i = 0; i < res_cnt; ++i) {
+        RETURN_IF_ERROR(read_at(offset, res[i]));
+        offset += res[i].size;
+    }
+    return Status::OK();
+}
+
+Status CachedRandomAccessFile::size(uint64_t* size) const {
+    *size = _file_length;
+    return Status::OK();
+}
+
+} // namespace starrocks
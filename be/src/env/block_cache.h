@@ -0,0 +1,135 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "env/env.h"
+#include "gutil/macros.h"
+
+namespace starrocks {
+
+// BlockCache caches the blocks of the remote files, e.g. the files of hive tables on HDFS, in a local directory,
+// one file per block. A block is identified by the path and the modification time of the remote file and its
+// index in the file, so a rewritten remote file never hits the stale blocks.
+//
+// A block is admitted only if it's missed again after its first miss, so that the blocks read only once,
+// e.g. by a large scan, don't evict the hot blocks. The least recently used blocks are evicted once the
+// cache exceeds its capacity.
+//
+// The cached blocks survive restarts, they are loaded in the order of their modification time by init().
+//
+// This class is thread-safe.
+class BlockCache {
+public:
+    // Create global instance of this class, do nothing if |dir| is empty.
+    static Status create_global_cache(const std::string& dir, int64_t capacity, int64_t block_size);
+
+    static void release_global_cache();
+
+    // Return global instance, nullptr if the block cache is disabled.
+    static BlockCache* instance() { return _s_instance; }
+
+    BlockCache(std::string dir, int64_t capacity, int64_t block_size);
+
+    // Load the cached blocks in the directory.
+    Status init();
+
+    int64_t block_size() const { return _block_size; }
+
+    // Read |result.size| bytes from |offset| of the cached block of |key| into |result|.
+    // |hit| is set to false if the block isn't cached.
+    Status read(const std::string& key, uint64_t offset, const Slice& result, bool* hit);
+
+    // Return true if the missed block of |key| should be cached, i.e. it was missed recently.
+    bool should_admit(const std::string& key);
+
+    // Cache |data| as the block of |key|.
+    Status insert(const std::string& key, const Slice& data);
+
+    size_t num_blocks() const;
+    int64_t usage() const;
+
+private:
+    struct Entry {
+        std::string key;
+        std::string file_name;
+        // The bytes of the header before the data of the block.
+        size_t header_size = 0;
+        // The bytes of the file.
+        int64_t size = 0;
+    };
+    using EntryList = std::list<Entry>;
+
+    static std::string _file_name(const std::string& key);
+    static std::string _encode_header(const std::string& key);
+
+    std::string _path(const std::string& file_name) const { return _dir + "/" + file_name; }
+    Status _load_file(const std::string& file_name, Entry* entry);
+    // Must be called with |_mutex| held, the files of the evicted blocks are appended to |deleted_files|.
+    void _add_entry(Entry entry, std::vector<std::string>* deleted_files);
+    void _remove_entry(const std::string& file_name);
+    void _delete_files(const std::vector<std::string>& files);
+
+    static BlockCache* _s_instance;
+
+    const std::string _dir;
+    const int64_t _capacity;
+    const int64_t _block_size;
+    Env* const _env;
+
+    mutable std::mutex _mutex;
+    // The most recently used entry is at the front.
+    EntryList _lru;
+    std::unordered_map<std::string, EntryList::iterator> _entries;
+    int64_t _usage = 0;
+    // The keys of the recently missed blocks that are not admitted yet, the most recent one is at the front.
+    std::list<std::string> _candidates;
+    std::unordered_map<std::string, std::list<std::string>::iterator> _candidate_index;
+    size_t _max_candidates = 0;
+    int64_t _next_tmp_id = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(BlockCache);
+};
+
+// CachedRandomAccessFile reads a remote file through the block cache, the blocks fall through to |file|
+// if they are not cached.
+// This is not thread-safe if |file| is not thread-safe.
+class CachedRandomAccessFile final : public RandomAccessFile {
+public:
+    CachedRandomAccessFile(BlockCache* cache, std::shared_ptr<RandomAccessFile> file, int64_t modification_time,
+                           uint64_t file_length);
+    ~CachedRandomAccessFile() override = default;
+
+    Status read(uint64_t offset, Slice* res) const override;
+    Status read_at(uint64_t offset, const Slice& res) const override;
+    Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override;
+
+    Status size(uint64_t* size) const override;
+    const std::string& file_name() const override { return _file->file_name(); }
+
+    RandomAccessFile* underlying_file() const { return _file.get(); }
+
+    // The bytes read from the block cache since the last clear_read_statistics().
+    int64_t cached_read_bytes() const { return _cached_read_bytes; }
+    void clear_read_statistics() { _cached_read_bytes = 0; }
+
+private:
+    std::string _block_key(uint64_t block_index) const;
+
+    BlockCache* const _cache;
+    std::shared_ptr<RandomAccessFile> _file;
+    const int64_t _modification_time;
+    const uint64_t _file_length;
+
+    mutable std::string _buffer;
+    mutable int64_t _cached_read_bytes = 0;
+};
+
+} // namespace starrocks
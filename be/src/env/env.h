@@ -170,6 +170,8 @@ struct RandomAccessFileOptions {
 struct WritableFileOptions {
     // Call Sync() during Close().
     bool sync_on_close = false;
+    // Write back the file and drop it from the page cache during Close(), for the files not expected to be read soon.
+    bool drop_cache_on_close = false;
     // See OpenMode for details.
     Env::OpenMode mode = Env::CREATE_OR_OPEN_WITH_TRUNCATE;
 };
@@ -248,6 +250,23 @@ public:
     // Safe for concurrent use by multiple threads.
     virtual Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const = 0;
 
+    // A range read by read_at_batch().
+    struct ReadRequest {
+        uint64_t offset;
+        Slice result;
+    };
+
+    // Same as read_at() of every request, but lets the implementation keep the reads in flight at once, e.g. the
+    // posix files with io_uring. Returns the first error, the results of the other requests are unspecified then.
+    //
+    // Safe for concurrent use by multiple threads.
+    virtual Status read_at_batch(const ReadRequest* requests, size_t num_requests) const {
+        for (size_t i = 0; i < num_requests; i++) {
+            RETURN_IF_ERROR(read_at(requests[i].offset, requests[i].result));
+        }
+        return Status::OK();
+    }
+
     // Return the size of this file
     virtual Status size(uint64_t* size) const = 0;
 
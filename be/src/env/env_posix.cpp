@@ -16,9 +16,12 @@
 #include <unistd.h>
 
 #include <memory>
+#include <vector>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
+#include "env/io_uring.h"
 #include "gutil/gscoped_ptr.h"
 #include "gutil/macros.h"
 #include "gutil/port.h"
@@ -67,6 +70,22 @@ static Status do_sync(int fd, const string& filename) {
     return Status::OK();
 }
 
+// The pages are only dropped once written back, so the dirty ones are written back first. It's only advice to the
+// kernel, whose failure is not an error of the file.
+static void do_drop_cache(int fd, const string& filename) {
+#if defined(__linux__)
+    if (sync_file_range(fd, 0, 0, SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER) <
+        0) {
+        LOG(WARNING) << "Failed to write back " << filename << ": " << std::strerror(errno);
+        return;
+    }
+    int err = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    if (err != 0) {
+        LOG(WARNING) << "Failed to drop the page cache of " << filename << ": " << std::strerror(err);
+    }
+#endif
+}
+
 static Status do_open(const string& filename, Env::OpenMode mode, int* fd) {
     int flags = O_RDWR;
     switch (mode) {
@@ -276,6 +295,25 @@ public:
     Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override {
         return do_readv_at(_fd, _filename, offset, res, res_cnt, nullptr);
     }
+
+    Status read_at_batch(const ReadRequest* requests, size_t num_requests) const override {
+        IoUring* ring = config::enable_io_uring && num_requests > 1 ? IoUring::local() : nullptr;
+        if (ring == nullptr) {
+            return RandomAccessFile::read_at_batch(requests, num_requests);
+        }
+        std::vector<size_t> bytes_read(num_requests, 0);
+        RETURN_IF_ERROR(ring->read(_fd, requests, num_requests, bytes_read.data()));
+        // The short reads and the reads failed by the kernel are completed by preadv, which reports the errors.
+        for (size_t i = 0; i < num_requests; i++) {
+            const Slice& result = requests[i].result;
+            if (bytes_read[i] < result.size) {
+                Slice rest(result.data + bytes_read[i], result.size - bytes_read[i]);
+                RETURN_IF_ERROR(do_readv_at(_fd, _filename, requests[i].offset + bytes_read[i], &rest, 1, nullptr));
+            }
+        }
+        return Status::OK();
+    }
+
     Status size(uint64_t* size) const override {
         struct stat st;
         auto res = fstat(_fd, &st);
@@ -295,8 +333,12 @@ private:
 
 class PosixWritableFile : public WritableFile {
 public:
-    PosixWritableFile(std::string filename, int fd, uint64_t filesize, bool sync_on_close)
-            : _filename(std::move(filename)), _fd(fd), _sync_on_close(sync_on_close), _filesize(filesize) {}
+    PosixWritableFile(std::string filename, int fd, uint64_t filesize, bool sync_on_close, bool drop_cache_on_close)
+            : _filename(std::move(filename)),
+              _fd(fd),
+              _sync_on_close(sync_on_close),
+              _drop_cache_on_close(drop_cache_on_close),
+              _filesize(filesize) {}
 
     ~PosixWritableFile() override { WARN_IF_ERROR(close(), "Failed to close file, file=" + _filename); }
 
@@ -353,6 +395,10 @@ public:
             }
         }
 
+        if (_drop_cache_on_close) {
+            do_drop_cache(_fd, _filename);
+        }
+
         int ret;
         RETRY_ON_EINTR(ret, ::close(_fd));
         if (ret < 0) {
@@ -398,6 +444,7 @@ private:
     std::string _filename;
     int _fd;
     const bool _sync_on_close = false;
+    const bool _drop_cache_on_close = false;
     bool _pending_sync = false;
     bool _closed = false;
     uint64_t _filesize = 0;
@@ -530,7 +577,7 @@ public:
         if (opts.mode == MUST_EXIST) {
             RETURN_IF_ERROR(get_file_size(fname, &file_size));
         }
-        result->reset(new PosixWritableFile(fname, fd, file_size, opts.sync_on_close));
+        result->reset(new PosixWritableFile(fname, fd, file_size, opts.sync_on_close, opts.drop_cache_on_close));
         return Status::OK();
     }
 
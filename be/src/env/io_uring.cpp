@@ -0,0 +1,179 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "env/io_uring.h"
+
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#define STARROCKS_HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#endif
+
+#include "common/logging.h"
+#include "gutil/strings/substitute.h"
+#include "util/errno.h"
+
+namespace starrocks {
+
+#ifdef STARROCKS_HAVE_IO_URING
+
+// Set once io_uring fails to be set up, e.g. by the old kernels or the seccomp filters of the containers.
+static std::atomic<bool> io_uring_unsupported{false};
+
+IoUring* IoUring::local() {
+    static thread_local std::unique_ptr<IoUring> ring;
+    if (ring != nullptr) {
+        return ring.get();
+    }
+    if (io_uring_unsupported.load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    std::unique_ptr<IoUring> new_ring(new IoUring());
+    Status st = new_ring->_init();
+    if (!st.ok()) {
+        if (!io_uring_unsupported.exchange(true)) {
+            LOG(WARNING) << "io_uring is not supported, fall back to preadv: " << st.to_string();
+        }
+        return nullptr;
+    }
+    ring = std::move(new_ring);
+    return ring.get();
+}
+
+IoUring::~IoUring() {
+    if (_sqes != nullptr) {
+        munmap(_sqes, _sqes_size);
+    }
+    if (_cq_ring != nullptr) {
+        munmap(_cq_ring, _cq_ring_size);
+    }
+    if (_sq_ring != nullptr) {
+        munmap(_sq_ring, _sq_ring_size);
+    }
+    if (_ring_fd >= 0) {
+        close(_ring_fd);
+    }
+}
+
+Status IoUring::_init() {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    _ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, kQueueDepth, &params));
+    if (_ring_fd < 0) {
+        return Status::NotSupported(strings::Substitute("io_uring_setup: $0", errno_to_string(errno)));
+    }
+
+    _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _sq_ring = mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                    IORING_OFF_SQ_RING);
+    if (_sq_ring == MAP_FAILED) {
+        _sq_ring = nullptr;
+        return Status::IOError(strings::Substitute("mmap io_uring sq: $0", errno_to_string(errno)));
+    }
+    _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    _cq_ring = mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                    IORING_OFF_CQ_RING);
+    if (_cq_ring == MAP_FAILED) {
+        _cq_ring = nullptr;
+        return Status::IOError(strings::Substitute("mmap io_uring cq: $0", errno_to_string(errno)));
+    }
+    _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                      IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return Status::IOError(strings::Substitute("mmap io_uring sqes: $0", errno_to_string(errno)));
+    }
+    _sqes = static_cast<io_uring_sqe*>(sqes);
+
+    auto* sq = static_cast<char*>(_sq_ring);
+    _sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    _sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    _sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    auto* cq = static_cast<char*>(_cq_ring);
+    _cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    _cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    _cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return Status::OK();
+}
+
+Status IoUring::read(int fd, const RandomAccessFile::ReadRequest* requests, size_t num_requests,
+                     size_t* bytes_read) {
+    std::vector<iovec> iovs(num_requests);
+    for (size_t start = 0; start < num_requests; start += kQueueDepth) {
+        const size_t batch_size = std::min<size_t>(kQueueDepth, num_requests - start);
+
+        // Only this thread produces the submissions, so the tail is never changed by others.
+        unsigned tail = *_sq_tail;
+        for (size_t i = start; i < start + batch_size; i++) {
+            iovs[i] = {requests[i].result.data, requests[i].result.size};
+            unsigned index = tail & *_sq_mask;
+            io_uring_sqe* sqe = &_sqes[index];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_READV;
+            sqe->fd = fd;
+            sqe->off = requests[i].offset;
+            sqe->addr = reinterpret_cast<uint64_t>(&iovs[i]);
+            sqe->len = 1;
+            sqe->user_data = i;
+            _sq_array[index] = index;
+            tail++;
+        }
+        __atomic_store_n(_sq_tail, tail, __ATOMIC_RELEASE);
+
+        size_t to_submit = batch_size;
+        size_t num_completed = 0;
+        while (num_completed < batch_size) {
+            long ret = syscall(__NR_io_uring_enter, _ring_fd, to_submit, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (ret < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                    continue;
+                }
+                // Never happens with a valid ring and valid submissions.
+                return Status::IOError(strings::Substitute("io_uring_enter: $0", errno_to_string(errno)));
+            }
+            to_submit -= std::min<size_t>(ret, to_submit);
+
+            unsigned head = *_cq_head;
+            const unsigned cq_tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+            for (; head != cq_tail; head++) {
+                const io_uring_cqe* cqe = &_cqes[head & *_cq_mask];
+                bytes_read[cqe->user_data] = cqe->res > 0 ? cqe->res : 0;
+                num_completed++;
+            }
+            __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+        }
+    }
+    return Status::OK();
+}
+
+#else
+
+IoUring* IoUring::local() {
+    return nullptr;
+}
+
+IoUring::~IoUring() = default;
+
+Status IoUring::_init() {
+    return Status::NotSupported("io_uring is not supported by the platform");
+}
+
+Status IoUring::read(int fd, const RandomAccessFile::ReadRequest* requests, size_t num_requests,
+                     size_t* bytes_read) {
+    return Status::NotSupported("io_uring is not supported by the platform");
+}
+
+#endif
+
+} // namespace starrocks
@@ -0,0 +1,59 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/status.h"
+#include "env/env.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace starrocks {
+
+// An io_uring ring of the calling thread, which keeps all the reads of a batch in flight at once rather than one
+// read at a time with preadv. The ring is set up with the raw system calls, so no library is needed, and is only
+// used by the RandomAccessFile::read_at_batch() of the posix files when config::enable_io_uring is set.
+class IoUring {
+public:
+    // At most so many reads are in flight.
+    static constexpr unsigned kQueueDepth = 64;
+
+    // The ring of the calling thread, or nullptr if the kernel doesn't support io_uring.
+    static IoUring* local();
+
+    ~IoUring();
+
+    // Read the |requests| of |fd|, and store the bytes read by each request into |bytes_read|. A request may be
+    // read partially, e.g. at the end of the file, or not at all if the kernel fails it, which is left to the caller
+    // to complete or to report.
+    Status read(int fd, const RandomAccessFile::ReadRequest* requests, size_t num_requests, size_t* bytes_read);
+
+private:
+    IoUring() = default;
+
+    Status _init();
+
+    int _ring_fd = -1;
+
+    // The submission queue.
+    void* _sq_ring = nullptr;
+    size_t _sq_ring_size = 0;
+    unsigned* _sq_tail = nullptr;
+    unsigned* _sq_mask = nullptr;
+    unsigned* _sq_array = nullptr;
+    io_uring_sqe* _sqes = nullptr;
+    size_t _sqes_size = 0;
+
+    // The completion queue.
+    void* _cq_ring = nullptr;
+    size_t _cq_ring_size = 0;
+    unsigned* _cq_head = nullptr;
+    unsigned* _cq_tail = nullptr;
+    unsigned* _cq_mask = nullptr;
+    io_uring_cqe* _cqes = nullptr;
+};
+
+} // namespace starrocks
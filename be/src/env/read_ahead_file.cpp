@@ -0,0 +1,94 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "env/read_ahead_file.h"
+
+#include <algorithm>
+
+#include "gutil/strings/fastmem.h"
+
+namespace starrocks {
+
+ReadAheadSequentialFile::ReadAheadSequentialFile(std::shared_ptr<SequentialFile> input_file, size_t buffer_size,
+                                                 size_t num_buffers)
+        : _input_file(std::move(input_file)),
+          _buffer_size(std::max<size_t>(1, buffer_size)),
+          _num_buffers(std::max<size_t>(1, num_buffers)) {}
+
+ReadAheadSequentialFile::~ReadAheadSequentialFile() {
+    {
+        std::lock_guard l(_mutex);
+        _stopped = true;
+    }
+    _cv.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void ReadAheadSequentialFile::_read_ahead() {
+    while (true) {
+        {
+            std::unique_lock l(_mutex);
+            _cv.wait(l, [this] { return _stopped || _buffers.size() < _num_buffers; });
+            if (_stopped) {
+                return;
+            }
+        }
+        Buffer buffer;
+        buffer.resize(_buffer_size);
+        Slice slice(buffer.data(), buffer.size());
+        Status st = _input_file->read(&slice);
+        std::lock_guard l(_mutex);
+        if (!st.ok()) {
+            _status = st;
+        } else if (slice.size == 0) {
+            _eof = true;
+        } else {
+            buffer.resize(slice.size);
+            _buffers.emplace_back(std::move(buffer));
+        }
+        _cv.notify_all();
+        if (!st.ok() || _eof) {
+            return;
+        }
+    }
+}
+
+Status ReadAheadSequentialFile::read(Slice* result) {
+    if (_offset == _current.size()) {
+        if (!_thread.joinable()) {
+            _thread = std::thread([this] { _read_ahead(); });
+        }
+        std::unique_lock l(_mutex);
+        _cv.wait(l, [this] { return !_buffers.empty() || _eof || !_status.ok(); });
+        if (_buffers.empty()) {
+            result->size = 0;
+            return _status;
+        }
+        _current = std::move(_buffers.front());
+        _buffers.pop_front();
+        _offset = 0;
+        _cv.notify_all();
+    }
+    size_t n = std::min(result->size, _current.size() - _offset);
+    strings::memcpy_inlined(result->data, _current.data() + _offset, n);
+    _offset += n;
+    result->size = n;
+    return Status::OK();
+}
+
+Status ReadAheadSequentialFile::skip(uint64_t n) {
+    raw::RawVector<uint8_t> buff;
+    buff.resize(std::min<uint64_t>(n, _buffer_size));
+    while (n > 0) {
+        Slice s(buff.data(), std::min<uint64_t>(n, buff.size()));
+        RETURN_IF_ERROR(read(&s));
+        if (s.size == 0) {
+            return Status::OK();
+        }
+        n -= s.size;
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
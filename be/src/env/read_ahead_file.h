@@ -0,0 +1,56 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "env/env.h"
+#include "util/raw_container.h"
+
+namespace starrocks {
+
+// ReadAheadSequentialFile reads |input_file| by a background thread into at most |num_buffers| buffers of
+// |buffer_size| bytes ahead of its reader, so that the reads of |input_file|, e.g. the decompression of a
+// CompressedSequentialFile or the reads of a remote file, run in parallel with the processing of the data read.
+//
+// The background thread starts at the first read and stops once |input_file| is exhausted or fails.
+class ReadAheadSequentialFile final : public SequentialFile {
+public:
+    ReadAheadSequentialFile(std::shared_ptr<SequentialFile> input_file, size_t buffer_size, size_t num_buffers);
+
+    ~ReadAheadSequentialFile() override;
+
+    Status read(Slice* result) override;
+
+    Status skip(uint64_t n) override;
+
+    const std::string& filename() const override { return _input_file->filename(); }
+
+private:
+    using Buffer = raw::RawVector<uint8_t>;
+
+    void _read_ahead();
+
+    std::shared_ptr<SequentialFile> _input_file;
+    const size_t _buffer_size;
+    const size_t _num_buffers;
+
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    // the buffers read and not consumed yet.
+    std::deque<Buffer> _buffers;
+    // the error of |_input_file|, returned after the buffers read before it are consumed.
+    Status _status;
+    bool _eof = false;
+    bool _stopped = false;
+
+    // the buffer being consumed, only accessed by the reader.
+    Buffer _current;
+    size_t _offset = 0;
+};
+
+} // namespace starrocks
@@ -21,8 +21,10 @@
 
 #include "exec/broker_reader.h"
 
+#include <algorithm>
 #include <sstream>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "gen_cpp/FileBrokerService_types.h"
 #include "gen_cpp/TFileBrokerService.h"
@@ -46,7 +48,9 @@ BrokerReader::BrokerReader(ExecEnv* env, const std::vector<TNetworkAddress>& bro
           _cur_offset(start_offset),
           _is_fd_valid(false),
           _file_size(file_size),
-          _addr_idx(0) {}
+          _addr_idx(0),
+          _read_ahead_depth(config::broker_read_ahead_depth),
+          _read_ahead_block_size(std::max<int64_t>(1, config::broker_read_ahead_block_size)) {}
 
 BrokerReader::~BrokerReader() {
     close();
@@ -131,6 +135,9 @@ Status BrokerReader::read_one_message(std::unique_ptr<uint8_t[]>* buf, size_t* l
 
 Status BrokerReader::read(uint8_t* buf, size_t* buf_len, bool* eof) {
     DCHECK_NE(*buf_len, 0);
+    if (_read_ahead_depth > 0) {
+        return _read_ahead(buf, buf_len, eof);
+    }
     RETURN_IF_ERROR(readat(_cur_offset, (int64_t)*buf_len, (int64_t*)buf_len, buf));
     if (*buf_len == 0) {
         *eof = true;
@@ -140,7 +147,85 @@ Status BrokerReader::read(uint8_t* buf, size_t* buf_len, bool* eof) {
     return Status::OK();
 }
 
+Status BrokerReader::_read_ahead(uint8_t* buf, size_t* buf_len, bool* eof) {
+    if (_read_ahead_blocks.empty()) {
+        _read_ahead_offset = _cur_offset;
+        _read_ahead_eof = false;
+    }
+    _fill_read_ahead_window();
+    if (_read_ahead_blocks.empty()) {
+        *buf_len = 0;
+        *eof = true;
+        return Status::OK();
+    }
+
+    ReadAheadBlock& block = _read_ahead_blocks.front();
+    if (block.status.valid()) {
+        Status st = block.status.get();
+        if (!st.ok()) {
+            _reset_read_ahead_window();
+            return st;
+        }
+    }
+    size_t n = std::min(*buf_len, block.data.size() - block.consumed);
+    memcpy(buf, block.data.data() + block.consumed, n);
+    block.consumed += n;
+    _cur_offset += n;
+    *buf_len = n;
+    *eof = (n == 0);
+    if (block.consumed == block.data.size()) {
+        if (static_cast<int64_t>(block.data.size()) < block.length) {
+            // The broker returned less than requested, so the following blocks don't start at the
+            // current offset any more.
+            _reset_read_ahead_window();
+        } else {
+            _read_ahead_blocks.pop_front();
+        }
+    }
+    return Status::OK();
+}
+
+void BrokerReader::_fill_read_ahead_window() {
+    while (_read_ahead_blocks.size() < static_cast<size_t>(_read_ahead_depth) && !_read_ahead_eof) {
+        int64_t length = _read_ahead_block_size;
+        if (_file_size > 0) {
+            if (_read_ahead_offset >= _file_size) {
+                _read_ahead_eof = true;
+                break;
+            }
+            length = std::min(length, _file_size - _read_ahead_offset);
+        }
+        ReadAheadBlock& block = _read_ahead_blocks.emplace_back();
+        block.offset = _read_ahead_offset;
+        block.length = length;
+        block.data.resize(length);
+        block.status = std::async(std::launch::async, [this, &block] {
+            int64_t bytes_read = 0;
+            RETURN_IF_ERROR(_pread(block.offset, block.length, &bytes_read, block.data.data()));
+            block.data.resize(bytes_read);
+            return Status::OK();
+        });
+        _read_ahead_offset += length;
+    }
+}
+
+void BrokerReader::_reset_read_ahead_window() {
+    for (auto& block : _read_ahead_blocks) {
+        if (block.status.valid()) {
+            block.status.wait();
+        }
+    }
+    _read_ahead_blocks.clear();
+}
+
 Status BrokerReader::readat(int64_t position, int64_t nbytes, int64_t* bytes_read, void* out) {
+    _reset_read_ahead_window();
+    RETURN_IF_ERROR(_pread(position, nbytes, bytes_read, out));
+    _cur_offset = position + *bytes_read;
+    return Status::OK();
+}
+
+Status BrokerReader::_pread(int64_t position, int64_t nbytes, int64_t* bytes_read, void* out) {
     const TNetworkAddress& broker_addr = _addresses[_addr_idx];
     TBrokerPReadRequest request;
     request.__set_version(TBrokerVersion::VERSION_ONE);
@@ -189,7 +274,6 @@ Status BrokerReader::readat(int64_t position, int64_t nbytes, int64_t* bytes_rea
 
     *bytes_read = response.data.size();
     memcpy(out, response.data.data(), *bytes_read);
-    _cur_offset = position + *bytes_read;
     return Status::OK();
 }
 
@@ -198,6 +282,9 @@ int64_t BrokerReader::size() {
 }
 
 Status BrokerReader::seek(int64_t position) {
+    if (position != _cur_offset) {
+        _reset_read_ahead_window();
+    }
     _cur_offset = position;
     return Status::OK();
 }
@@ -212,6 +299,7 @@ bool BrokerReader::closed() {
 }
 
 void BrokerReader::close() {
+    _reset_read_ahead_window();
     if (!_is_fd_valid) {
         return;
     }
@@ -23,6 +23,8 @@
 
 #include <stdint.h>
 
+#include <deque>
+#include <future>
 #include <map>
 #include <string>
 
@@ -39,6 +41,11 @@ class TNetworkAddress;
 class RuntimeState;
 
 // Reader of broker file
+//
+// The sequential reads are served from a window of config::broker_read_ahead_depth blocks of
+// config::broker_read_ahead_block_size bytes, whose preads are sent to the broker ahead of the reads
+// and in parallel, so that the broker round trips are overlapped with each other and with the processing
+// of the data read. The window is dropped by seek() and readat().
 class BrokerReader : public FileReader {
 public:
     // If the reader need the file size, set it when construct BrokerReader.
@@ -61,6 +68,27 @@ public:
     bool closed() override;
 
 private:
+    // A block of the read-ahead window, whose pread is sent in the background.
+    struct ReadAheadBlock {
+        int64_t offset = 0;
+        int64_t length = 0;
+        std::string data;
+        // the bytes of |data| consumed
+        size_t consumed = 0;
+        std::future<Status> status;
+    };
+
+    // Read |nbytes| at |position| from the broker into |out|, without moving the current offset.
+    Status _pread(int64_t position, int64_t nbytes, int64_t* bytes_read, void* out);
+
+    Status _read_ahead(uint8_t* buf, size_t* buf_len, bool* eof);
+
+    // Send the preads of the blocks following the window, until it's full or the end of the file is reached.
+    void _fill_read_ahead_window();
+
+    // Drop the window, and wait for the preads in flight.
+    void _reset_read_ahead_window();
+
     ExecEnv* _env;
     const std::vector<TNetworkAddress>& _addresses;
     const std::map<std::string, std::string>& _properties;
@@ -73,6 +101,14 @@ private:
 
     int64_t _file_size;
     int _addr_idx;
+
+    const int _read_ahead_depth;
+    const int64_t _read_ahead_block_size;
+    std::deque<ReadAheadBlock> _read_ahead_blocks;
+    // the offset of the block following the window
+    int64_t _read_ahead_offset = 0;
+    // whether a block of the window reaches the end of the file
+    bool _read_ahead_eof = false;
 };
 
 } // namespace starrocks
@@ -62,6 +62,10 @@ public:
 
     virtual Status send_chunk(RuntimeState* state, vectorized::Chunk* chunk);
 
+    // Whether the sink needs no more rows, e.g. all the receivers have reached their limits, then the fragment
+    // could stop producing the rows and close the sink.
+    virtual bool is_finished() const { return false; }
+
     // Releases all resources that were allocated in prepare()/send().
     // Further send() calls are illegal after calling close().
     // It must be okay to call this multiple times. Subsequent calls should
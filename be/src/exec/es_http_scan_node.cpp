@@ -21,9 +21,11 @@
 
 #include "exec/es_http_scan_node.h"
 
+#include <algorithm>
 #include <chrono>
 #include <sstream>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "exec/es/es_predicate.h"
 #include "exec/es/es_query_builder.h"
@@ -157,15 +159,24 @@ Status EsHttpScanNode::open(RuntimeState* state) {
 }
 
 Status EsHttpScanNode::start_scanners() {
+    // A shard is read by the slices of a sliced scroll in parallel, unless the limit is pushed down, with which
+    // every slice would return the limited rows.
+    int num_slices = std::max(1, config::es_scroll_slices_per_shard);
+    if (limit() != -1 && limit() <= _runtime_state->batch_size()) {
+        num_slices = 1;
+    }
+    const size_t num_scanners = _scan_ranges.size() * num_slices;
     {
         std::unique_lock<std::mutex> l(_batch_queue_lock);
-        _num_running_scanners = _scan_ranges.size();
+        _num_running_scanners = num_scanners;
     }
 
-    _scanners_status.resize(_scan_ranges.size());
+    _scanners_status.resize(num_scanners);
     for (int i = 0; i < _scan_ranges.size(); i++) {
-        _scanner_threads.emplace_back(&EsHttpScanNode::scanner_worker, this, i, _scan_ranges.size(),
-                                      std::ref(_scanners_status[i]));
+        for (int slice_id = 0; slice_id < num_slices; slice_id++) {
+            _scanner_threads.emplace_back(&EsHttpScanNode::scanner_worker, this, i, _scan_ranges.size(), slice_id,
+                                          num_slices, std::ref(_scanners_status[i * num_slices + slice_id]));
+        }
     }
     return Status::OK();
 }
@@ -404,7 +415,8 @@ static std::string get_host_port(const std::vector<TNetworkAddress>& es_hosts) {
     return host_port;
 }
 
-void EsHttpScanNode::scanner_worker(int start_idx, int length, std::promise<Status>& p_status) {
+void EsHttpScanNode::scanner_worker(int start_idx, int length, int slice_id, int num_slices,
+                                    std::promise<Status>& p_status) {
     // Clone expr context
     std::vector<ExprContext*> scanner_expr_ctxs;
     DCHECK(start_idx < length);
@@ -429,6 +441,10 @@ void EsHttpScanNode::scanner_worker(int start_idx, int length, std::promise<Stat
     if (limit() != -1 && limit() <= _runtime_state->batch_size()) {
         properties[ESScanReader::KEY_TERMINATE_AFTER] = std::to_string(limit());
     }
+    if (num_slices > 1) {
+        properties[ESScanReader::KEY_SLICE_ID] = std::to_string(slice_id);
+        properties[ESScanReader::KEY_SLICE_MAX] = std::to_string(num_slices);
+    }
 
     bool doc_value_mode = false;
     properties[ESScanReader::KEY_QUERY] =
@@ -439,7 +455,8 @@ void EsHttpScanNode::scanner_worker(int start_idx, int length, std::promise<Stat
                                                              scanner_expr_ctxs, &counter, doc_value_mode));
     status = scanner_scan(std::move(scanner), scanner_expr_ctxs, &counter);
     if (!status.ok()) {
-        LOG(WARNING) << "Scanner[" << start_idx << "] process failed. status=" << status.get_error_msg();
+        LOG(WARNING) << "Scanner[" << start_idx << ", slice " << slice_id
+                     << "] process failed. status=" << status.get_error_msg();
     }
 
     // scanner is going to finish
@@ -244,6 +244,7 @@ Status ExchangeNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
         COUNTER_SET(_rows_returned_counter, _limit);
         *chunk = std::move(_input_chunk);
         _is_finished = true;
+        _stream_recvr->short_circuit();
 
         DCHECK_CHUNK(*chunk);
         return Status::OK();
@@ -355,6 +356,9 @@ Status ExchangeNode::get_next_merging(RuntimeState* state, ChunkPtr* chunk, bool
             }
             _num_rows_returned += size_in_chunk;
             COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+            if (reached_limit()) {
+                _stream_recvr->short_circuit();
+            }
             break;
         }
     } while (!_is_finished);
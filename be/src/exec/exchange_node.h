@@ -60,6 +60,9 @@ public:
     // recorded in TPlanNode, and before calling prepare()
     void set_num_senders(int num_senders) { _num_senders = num_senders; }
 
+    // REQUIRES: prepare() has been called.
+    const std::shared_ptr<DataStreamRecvr>& stream_recvr() const { return _stream_recvr; }
+
     std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
             pipeline::PipelineBuilderContext* context) override;
 
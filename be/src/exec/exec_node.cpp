@@ -24,6 +24,7 @@
 #include <thrift/protocol/TDebugProtocol.h>
 #include <unistd.h>
 
+#include <numeric>
 #include <sstream>
 
 #include "column/column_helper.h"
@@ -65,8 +66,10 @@
 #include "exec/vectorized/hash_join_node.h"
 #include "exec/vectorized/hdfs_scan_node.h"
 #include "exec/vectorized/intersect_node.h"
+#include "exec/vectorized/merge_join_node.h"
 #include "exec/vectorized/mysql_scan_node.h"
 #include "exec/vectorized/olap_scan_node.h"
+#include "exec/vectorized/partition_topn_node.h"
 #include "exec/vectorized/project_node.h"
 #include "exec/vectorized/repeat_node.h"
 #include "exec/vectorized/table_function_node.h"
@@ -85,6 +88,7 @@
 #include "simd/simd.h"
 #include "util/debug_util.h"
 #include "util/runtime_profile.h"
+#include "util/stopwatch.hpp"
 
 namespace starrocks {
 
@@ -503,9 +507,15 @@ Status ExecNode::create_vectorized_node(starrocks::RuntimeState* state, starrock
     case TPlanNodeType::SORT_NODE:
         *node = pool->add(new vectorized::TopNNode(pool, tnode, descs));
         return Status::OK();
+    case TPlanNodeType::PARTITION_TOPN_NODE:
+        *node = pool->add(new vectorized::PartitionTopNNode(pool, tnode, descs));
+        return Status::OK();
     case TPlanNodeType::CROSS_JOIN_NODE:
         *node = pool->add(new vectorized::CrossJoinNode(pool, tnode, descs));
         return Status::OK();
+    case TPlanNodeType::MERGE_JOIN_NODE:
+        *node = pool->add(new vectorized::MergeJoinNode(pool, tnode, descs));
+        return Status::OK();
     case TPlanNodeType::UNION_NODE:
         *node = pool->add(new vectorized::UnionNode(pool, tnode, descs));
         return Status::OK();
@@ -723,6 +733,36 @@ bool ExecNode::eval_conjuncts(ExprContext* const* ctxs, int num_ctxs, TupleRow*
     return true;
 }
 
+// The order to evaluate |ctxs| in, by their measured costs to drop a row. The statistics are only measured if there
+// is more than one conjunct to order.
+static std::vector<uint32_t> order_conjuncts(const std::vector<ExprContext*>& ctxs) {
+    std::vector<uint32_t> order(ctxs.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (ctxs.size() > 1) {
+        sort_conjuncts_by_rank(&order, [&](uint32_t i) -> const ConjunctStats& { return *ctxs[i]->conjunct_stats(); });
+    }
+    return order;
+}
+
+// Evaluate |ctx| on |chunk|, and count the rows it selects into |*true_count| if it's not nullptr.
+static ColumnPtr eval_conjunct(ExprContext* ctx, vectorized::Chunk* chunk, bool measure, size_t* true_count) {
+    MonotonicStopWatch watch;
+    if (measure) {
+        watch.start();
+    }
+    ColumnPtr column = ctx->evaluate(chunk);
+    if (true_count != nullptr || measure) {
+        const size_t count = vectorized::ColumnHelper::count_true_with_notnull(column);
+        if (true_count != nullptr) {
+            *true_count = count;
+        }
+        if (measure) {
+            ctx->conjunct_stats()->update(column->size(), count, watch.elapsed_time());
+        }
+    }
+    return column;
+}
+
 static void eager_prune_eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk) {
     vectorized::Column::Filter filter(chunk->num_rows(), 1);
     vectorized::Column::Filter* raw_filter = &filter;
@@ -741,9 +781,10 @@ static void eager_prune_eval_conjuncts(const std::vector<ExprContext*>& ctxs, ve
     int prune_threshold = std::max(int(chunk->num_rows() * prune_ratio), prune_min_size);
     int zero_count = 0;
 
-    for (auto* ctx : ctxs) {
-        ColumnPtr column = ctx->evaluate(chunk);
-        size_t true_count = vectorized::ColumnHelper::count_true_with_notnull(column);
+    const bool measure = ctxs.size() > 1;
+    for (uint32_t i : order_conjuncts(ctxs)) {
+        size_t true_count = 0;
+        ColumnPtr column = eval_conjunct(ctxs[i], chunk, measure, &true_count);
 
         if (true_count == column->size()) {
             // all hit, skip
@@ -799,9 +840,10 @@ void ExecNode::eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized:
     }
     vectorized::Column::Filter* raw_filter = filter.get();
 
-    for (auto* ctx : ctxs) {
-        ColumnPtr column = ctx->evaluate(chunk);
-        size_t true_count = vectorized::ColumnHelper::count_true_with_notnull(column);
+    const bool measure = ctxs.size() > 1;
+    for (uint32_t i : order_conjuncts(ctxs)) {
+        size_t true_count = 0;
+        ColumnPtr column = eval_conjunct(ctxs[i], chunk, measure, &true_count);
 
         if (true_count == column->size()) {
             // all hit, skip
@@ -827,6 +869,41 @@ void ExecNode::eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized:
     chunk->filter(*raw_filter);
 }
 
+void ExecNode::eval_conjuncts_with_selection(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk,
+                                             vectorized::Column::Filter* selection) {
+    const size_t num_rows = chunk->num_rows();
+    if (num_rows == 0) {
+        return;
+    }
+    DCHECK_EQ(num_rows, selection->size());
+    const size_t true_count = SIMD::count_nonzero(*selection);
+    if (true_count == 0) {
+        chunk->set_num_rows(0);
+        return;
+    }
+    // Evaluating the conjuncts on the rows filtered out costs more than compacting the chunk twice, if more than
+    // half of the rows are filtered out.
+    if (true_count * 2 < num_rows) {
+        chunk->filter(*selection);
+        eval_conjuncts(ctxs, chunk);
+        return;
+    }
+
+    const bool measure = ctxs.size() > 1;
+    for (uint32_t i : order_conjuncts(ctxs)) {
+        ColumnPtr column = eval_conjunct(ctxs[i], chunk, measure, nullptr);
+        bool all_zero = false;
+        vectorized::ColumnHelper::merge_two_filters(column, selection, &all_zero);
+        if (all_zero) {
+            chunk->set_num_rows(0);
+            return;
+        }
+    }
+    if (SIMD::count_zero(*selection) > 0) {
+        chunk->filter(*selection);
+    }
+}
+
 void ExecNode::eval_join_runtime_filters(vectorized::Chunk* chunk) {
     if (chunk == nullptr) return;
     _runtime_filter_collector.evaluate(chunk);
@@ -184,6 +184,12 @@ public:
     static void eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk,
                                vectorized::FilterPtr* filter_ptr = nullptr);
 
+    // Filter |chunk| by both |selection|, which is the result of the earlier predicates, and |ctxs|.
+    // The selection is deferred and merged with the results of the conjuncts, so the chunk is compacted only once,
+    // unless few rows are selected and it's cheaper to compact the chunk before evaluating the conjuncts.
+    static void eval_conjuncts_with_selection(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk,
+                                              vectorized::Column::Filter* selection);
+
     Status init_join_runtime_filters(const TPlanNode& tnode, RuntimeState* state);
     void register_runtime_filter_descriptor(RuntimeState* state, vectorized::RuntimeFilterProbeDescriptor* rf_desc);
     void eval_join_runtime_filters(vectorized::Chunk* chunk);
@@ -40,7 +40,7 @@
 #include "runtime/string_value.h"
 #include "runtime/tuple_row.h"
 #include "util/debug_util.h"
-#include "util/priority_thread_pool.hpp"
+#include "util/work_stealing_priority_thread_pool.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks {
@@ -1054,7 +1054,7 @@ void OlapScanNode::transfer_thread(RuntimeState* state) {
     // 4. periodically increase the priority of residual tasks in the queue to avoid complete
     //    starvation of large queries
 
-    PriorityThreadPool* thread_pool = state->exec_env()->thread_pool();
+    WorkStealingPriorityThreadPool* thread_pool = state->exec_env()->thread_pool();
     _total_assign_num = 0;
     _nice = 18 + std::max(0, 2 - (int)_olap_scanners.size() / 5);
     std::list<OlapScanner*> olap_scanners;
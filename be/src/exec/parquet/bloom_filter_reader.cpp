@@ -0,0 +1,84 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/parquet/bloom_filter_reader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "env/env.h"
+#include "exec/vectorized/hdfs_scanner.h"
+#include "storage/rowset/segment_v2/block_split_bloom_filter.h"
+#include "util/hash_util.hpp"
+#include "util/runtime_profile.h"
+#include "util/thrift_util.h"
+
+namespace starrocks::parquet {
+
+using segment_v2::BlockSplitBloomFilter;
+
+// The header is small, usually some bytes, and read with the bitset if the bitset is small too.
+static constexpr uint32_t kBloomFilterHeaderReadSize = 256;
+static constexpr uint32_t kBloomFilterMaxBytes = 128 * 1024 * 1024;
+
+static Status read_bytes(RandomAccessFile* file, uint64_t offset, const Slice& slice,
+                         vectorized::HdfsScanStats* stats) {
+    SCOPED_RAW_TIMER(&stats->io_ns);
+    stats->io_count += 1;
+    RETURN_IF_ERROR(file->read_at(offset, slice));
+    stats->bytes_read_from_disk += slice.size;
+    return Status::OK();
+}
+
+Status BloomFilterReader::init(RandomAccessFile* file, const tparquet::ColumnMetaData& column_meta,
+                               vectorized::HdfsScanStats* stats) {
+    if (!column_meta.__isset.bloom_filter_offset) {
+        return Status::NotFound("No bloom filter");
+    }
+    uint64_t offset = column_meta.bloom_filter_offset;
+    uint64_t file_size = 0;
+    RETURN_IF_ERROR(file->size(&file_size));
+    if (offset >= file_size) {
+        return Status::Corruption("Invalid parquet bloom filter offset");
+    }
+
+    uint8_t header_buf[kBloomFilterHeaderReadSize];
+    uint32_t header_buf_size = std::min<uint64_t>(kBloomFilterHeaderReadSize, file_size - offset);
+    RETURN_IF_ERROR(read_bytes(file, offset, Slice(header_buf, header_buf_size), stats));
+
+    tparquet::BloomFilterHeader header;
+    uint32_t header_size = header_buf_size;
+    RETURN_IF_ERROR(deserialize_thrift_msg(header_buf, &header_size, true, &header));
+    if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH || !header.compression.__isset.UNCOMPRESSED) {
+        return Status::NotSupported("Not supported parquet bloom filter");
+    }
+    uint32_t num_bytes = header.numBytes;
+    if (num_bytes == 0 || num_bytes % BlockSplitBloomFilter::BYTES_PER_BLOCK != 0 ||
+        num_bytes > kBloomFilterMaxBytes || offset + header_size + num_bytes > file_size) {
+        return Status::Corruption("Invalid parquet bloom filter size");
+    }
+
+    _bitset.resize(num_bytes / sizeof(uint32_t));
+    auto* bitset = reinterpret_cast<uint8_t*>(_bitset.data());
+    uint32_t num_read_bytes = std::min(header_buf_size - header_size, num_bytes);
+    memcpy(bitset, header_buf + header_size, num_read_bytes);
+    if (num_read_bytes < num_bytes) {
+        Slice slice(bitset + num_read_bytes, num_bytes - num_read_bytes);
+        RETURN_IF_ERROR(read_bytes(file, offset + header_size + num_read_bytes, slice, stats));
+    }
+    return Status::OK();
+}
+
+bool BloomFilterReader::test_bytes(const Slice& value) const {
+    return test_hash(HashUtil::xx_hash64(value.data, value.size, 0));
+}
+
+bool BloomFilterReader::test_hash(uint64_t hash) const {
+    constexpr uint32_t kWordsPerBlock = BlockSplitBloomFilter::BYTES_PER_BLOCK / sizeof(uint32_t);
+    uint64_t num_blocks = _bitset.size() / kWordsPerBlock;
+    // The block is chosen by the most significant 32 bits, which may not be a power of 2.
+    uint64_t block_index = ((hash >> 32) * num_blocks) >> 32;
+    return BlockSplitBloomFilter::test_key_in_block(&_bitset[block_index * kWordsPerBlock],
+                                                    static_cast<uint32_t>(hash));
+}
+
+} // namespace starrocks::parquet
@@ -0,0 +1,39 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/parquet_types.h"
+#include "util/slice.h"
+
+namespace starrocks {
+class RandomAccessFile;
+
+namespace vectorized {
+struct HdfsScanStats;
+}
+} // namespace starrocks
+
+namespace starrocks::parquet {
+
+// BloomFilterReader reads the split block Bloom filter of a column chunk, which tests the values by the xxHash64 of
+// their plain encodings, i.e. the little endian bytes of the numbers and the bytes of the strings without lengths.
+class BloomFilterReader {
+public:
+    // Return NotFound if the column chunk has no Bloom filter, and NotSupported if the filter is not a split block
+    // filter of xxHash64 or it's compressed.
+    Status init(RandomAccessFile* file, const tparquet::ColumnMetaData& column_meta, vectorized::HdfsScanStats* stats);
+
+    // Whether the value of the plain encoding |value| may be in the column chunk.
+    bool test_bytes(const Slice& value) const;
+
+    bool test_hash(uint64_t hash) const;
+
+private:
+    std::vector<uint32_t> _bitset;
+};
+
+} // namespace starrocks::parquet
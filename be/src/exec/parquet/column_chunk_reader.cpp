@@ -9,6 +9,7 @@
 #include "exec/parquet/encoding.h"
 #include "exec/parquet/encoding_dict.h"
 #include "exec/parquet/page_reader.h"
+#include "exec/parquet/prefetched_ranges.h"
 #include "exec/parquet/types.h"
 #include "exec/parquet/utils.h"
 #include "gutil/strings/substitute.h"
@@ -18,11 +19,16 @@ namespace starrocks::parquet {
 
 class RandomAccessFileWrapper : public RandomAccessFile {
 public:
-    RandomAccessFileWrapper(RandomAccessFile* file, vectorized::HdfsScanStats* stats) : _file(file), _stats(stats) {}
+    RandomAccessFileWrapper(RandomAccessFile* file, vectorized::HdfsScanStats* stats,
+                            const PrefetchedRanges* prefetched_ranges)
+            : _file(file), _stats(stats), _prefetched_ranges(prefetched_ranges) {}
 
     ~RandomAccessFileWrapper() override {}
 
     Status read(uint64_t offset, Slice* res) const override {
+        if (_read_prefetched(offset, *res)) {
+            return Status::OK();
+        }
         Status st;
         {
             SCOPED_RAW_TIMER(&_stats->io_ns);
@@ -34,6 +40,9 @@ public:
     }
 
     Status read_at(uint64_t offset, const Slice& result) const override {
+        if (_read_prefetched(offset, result)) {
+            return Status::OK();
+        }
         Status st;
         {
             SCOPED_RAW_TIMER(&_stats->io_ns);
@@ -64,8 +73,14 @@ public:
     const std::string& file_name() const override { return _file->file_name(); }
 
 private:
+    bool _read_prefetched(uint64_t offset, const Slice& result) const {
+        return _prefetched_ranges != nullptr &&
+               _prefetched_ranges->read(offset, result.size, reinterpret_cast<uint8_t*>(result.data));
+    }
+
     RandomAccessFile* _file;
     vectorized::HdfsScanStats* _stats;
+    const PrefetchedRanges* _prefetched_ranges;
 };
 
 ColumnChunkReader::ColumnChunkReader(level_t max_def_level, level_t max_rep_level, int32_t type_length,
@@ -76,7 +91,7 @@ ColumnChunkReader::ColumnChunkReader(level_t max_def_level, level_t max_rep_leve
           _type_length(type_length),
           _chunk_metadata(column_chunk),
           _opts(opts),
-          _file(new RandomAccessFileWrapper(file, opts.stats)) {}
+          _file(new RandomAccessFileWrapper(file, opts.stats, opts.prefetched_ranges)) {}
 
 ColumnChunkReader::~ColumnChunkReader() = default;
 
@@ -107,6 +122,29 @@ Status ColumnChunkReader::next_page() {
     return Status::OK();
 }
 
+Status ColumnChunkReader::seek_to_page(uint64_t offset) {
+    _page_reader->seek_to_offset(offset);
+    _page_parse_state = INITIALIZED;
+    return next_page();
+}
+
+Status ColumnChunkReader::skip_pages(size_t* num_values) {
+    while (true) {
+        RETURN_IF_ERROR(_parse_page_header());
+        const auto& header = *_page_reader->current_header();
+        if (header.type != tparquet::PageType::DATA_PAGE || header.data_page_header.num_values > *num_values) {
+            return _parse_page_data();
+        }
+        *num_values -= header.data_page_header.num_values;
+        _page_reader->skip_page_data();
+        _num_values = 0;
+        _page_parse_state = PAGE_DATA_PARSED;
+        if (*num_values == 0) {
+            return Status::OK();
+        }
+    }
+}
+
 Status ColumnChunkReader::_parse_page_header() {
     DCHECK(_page_parse_state == INITIALIZED || _page_parse_state == PAGE_DATA_PARSED);
     RETURN_IF_ERROR(_page_reader->next_header());
@@ -23,8 +23,12 @@ class BlockCompressionCodec;
 
 namespace starrocks::parquet {
 
+class PrefetchedRanges;
+
 struct ColumnChunkReaderOptions {
     vectorized::HdfsScanStats* stats = nullptr;
+    // The ranges of the row group read ahead, the pages in them are not read from the file again.
+    const PrefetchedRanges* prefetched_ranges = nullptr;
 };
 
 class PageReader;
@@ -40,6 +44,15 @@ public:
 
     Status next_page();
 
+    // Parse the data page at |offset| of the file, which must be the start of a data page header in the column
+    // chunk, the dictionary page has been loaded by init().
+    Status seek_to_page(uint64_t offset);
+
+    // Move to the next page like next_page(), but the data pages having no more than |*num_values| values are
+    // skipped without being read, the values of them are subtracted from |*num_values|. Returns when
+    // |*num_values| becomes 0, with num_values() being 0, or when a page having more values is parsed.
+    Status skip_pages(size_t* num_values);
+
     uint32_t num_values() const { return _num_values; }
 
     // Try to decode n definition levels into 'levels'
@@ -82,6 +95,9 @@ public:
         return _cur_decoder->next_batch(n, content_type, dst);
     }
 
+    // Skip n values of current page, the nulls don't have values.
+    Status skip_values(size_t n) { return _cur_decoder->skip(n); }
+
     const tparquet::ColumnMetaData& metadata() const { return _chunk_metadata->meta_data; }
 
     Status get_dict_values(vectorized::Column* column) { return _cur_decoder->get_dict_values(column); }
@@ -325,6 +325,7 @@ public:
                 const TypeDescriptor& col_type) {
         StoredColumnReaderOptions opts;
         opts.stats = _opts.stats;
+        opts.prefetched_ranges = _opts.prefetched_ranges;
         _field = field;
         _col_type = col_type;
 
@@ -359,6 +360,10 @@ public:
         _reader->get_levels(def_levels, rep_levels, num_levels);
     }
 
+    Status seek_to_page(uint64_t offset) override { return _reader->seek_to_page(offset); }
+
+    Status skip_rows(size_t num_records) override { return _reader->skip_records(num_records); }
+
     Status get_dict_values(vectorized::Column* column) override { return _reader->get_dict_values(column); }
 
     Status get_dict_values(const std::vector<int32_t>& dict_codes, vectorized::Column* column) override {
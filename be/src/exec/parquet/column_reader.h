@@ -21,10 +21,12 @@ struct HdfsScanStats;
 namespace starrocks::parquet {
 
 class ParquetField;
+class PrefetchedRanges;
 
 struct ColumnReaderOptions {
     vectorized::HdfsScanStats* stats = nullptr;
     std::string timezone;
+    const PrefetchedRanges* prefetched_ranges = nullptr;
 };
 
 class ColumnReader {
@@ -47,6 +49,14 @@ public:
 
     virtual void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) = 0;
 
+    // Continue reading from the data page at |offset| of the file, only the readers of the scalar columns which
+    // aren't repeated support it.
+    virtual Status seek_to_page(uint64_t offset) { return Status::NotSupported("seek_to_page is not supported"); }
+
+    // Skip the next num_records records without reading them, only the readers of the scalar columns which
+    // aren't repeated support it. Returns EndOfFile if there are not enough records.
+    virtual Status skip_rows(size_t num_records) { return Status::NotSupported("skip_rows is not supported"); }
+
     virtual Status get_dict_values(vectorized::Column* column) {
         return Status::NotSupported("get_dict_values is not supported");
     }
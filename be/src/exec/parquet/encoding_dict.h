@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
 
 #include "column/column.h"
@@ -70,6 +71,26 @@ private:
     faststring _buffer;
 };
 
+// Skip the next count dict codes of decoder, the repeated runs are skipped without decoding them,
+// the literal runs are decoded into indexes.
+inline Status skip_dict_codes(RleBatchDecoder<uint32_t>* decoder, std::vector<uint32_t>* indexes, size_t count) {
+    while (count > 0) {
+        int32_t num_repeats = decoder->NextNumRepeats();
+        if (num_repeats > 0) {
+            int32_t n = static_cast<int32_t>(std::min<size_t>(num_repeats, count));
+            decoder->GetRepeatedValue(n);
+            count -= n;
+            continue;
+        }
+        int32_t n = static_cast<int32_t>(std::min(count, indexes->size()));
+        if (decoder->GetBatch(indexes->data(), n) != n) {
+            return Status::InternalError("going to skip out-of-bounds dict codes");
+        }
+        count -= n;
+    }
+    return Status::OK();
+}
+
 // TODO(zc): support read run later. however should add more interface to Column first
 template <typename T>
 class DictDecoder final : public Decoder {
@@ -125,6 +146,8 @@ public:
         return Status::OK();
     }
 
+    Status skip(size_t count) override { return skip_dict_codes(&_index_batch_decoder, &_indexes, count); }
+
 private:
     enum { SIZE_OF_TYPE = sizeof(T) };
 
@@ -228,6 +251,8 @@ public:
         return Status::OK();
     }
 
+    Status skip(size_t count) override { return skip_dict_codes(&_index_batch_decoder, &_indexes, count); }
+
 private:
     enum { SIZE_OF_DICT_CODE_TYPE = sizeof(int32_t) };
     std::unordered_map<Slice, int32_t, SliceHasher> _dict_code_by_value;
@@ -7,11 +7,15 @@
 #include "column/column_helper.h"
 #include "env/env.h"
 #include "exec/exec_node.h"
+#include "exec/parquet/bloom_filter_reader.h"
 #include "exec/parquet/encoding_plain.h"
 #include "exec/parquet/metadata.h"
+#include "exec/parquet/page_index_reader.h"
+#include "exec/vectorized/file_meta_cache.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
 #include "gen_cpp/parquet_types.h"
+#include "gutil/strings/substitute.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "util/coding.h"
 #include "util/memcmp.h"
@@ -58,6 +62,18 @@ Status FileReader::get_next(vectorized::ChunkPtr* chunk) {
 }
 
 Status FileReader::_parse_footer() {
+    // the footer of a file is cached only if the modification time is known, which identifies its version.
+    auto* cache = vectorized::FileMetaCache::instance();
+    std::string cache_key;
+    if (cache != nullptr && !_param.scan_ranges.empty() && _param.scan_ranges[0]->__isset.modification_time) {
+        cache_key = vectorized::FileMetaCache::make_key("parquet", _file->file_name(), _file_size,
+                                                        _param.scan_ranges[0]->modification_time);
+        _file_metadata = cache->lookup<FileMetaData>(cache_key);
+        if (_file_metadata != nullptr) {
+            return Status::OK();
+        }
+    }
+
     // try
     constexpr uint64_t footer_buf_size = 16 * 1024;
 
@@ -68,21 +84,39 @@ Status FileReader::_parse_footer() {
         SCOPED_RAW_TIMER(&_param.stats->footer_read_ns);
         RETURN_IF_ERROR(_file->read_at(_file_size - to_read, slice));
     }
+    if (to_read < 8) {
+        return Status::Corruption("parquet file is too small");
+    }
     // check magic
     RETURN_IF_ERROR(_check_magic(footer_buf + to_read - 4));
     // deserialize footer
     uint32_t footer_size = decode_fixed32_le(footer_buf + to_read - 8);
-    if (footer_size > to_read) {
-        // TODO(zc): suppport larger footer.
-        return Status::Corruption("");
+    if (footer_size + 8 > _file_size) {
+        return Status::Corruption(strings::Substitute("parquet footer size $0 exceeds file size $1", footer_size,
+                                                      _file_size));
+    }
+    const uint8_t* footer = footer_buf + to_read - 8 - footer_size;
+    std::vector<uint8_t> large_footer_buf;
+    if (footer_size + 8 > to_read) {
+        // the footer is larger than the buffer, read the whole of it
+        large_footer_buf.resize(footer_size);
+        SCOPED_RAW_TIMER(&_param.stats->footer_read_ns);
+        RETURN_IF_ERROR(_file->read_at(_file_size - 8 - footer_size, Slice(large_footer_buf.data(), footer_size)));
+        footer = large_footer_buf.data();
     }
 
     tparquet::FileMetaData t_metadata;
+    uint32_t serialized_size = footer_size;
     // deserialize footer
-    RETURN_IF_ERROR(deserialize_thrift_msg(footer_buf + to_read - 8 - footer_size, &footer_size, true, &t_metadata));
-    _file_metadata.reset(new FileMetaData());
-    RETURN_IF_ERROR(_file_metadata->init(t_metadata));
+    RETURN_IF_ERROR(deserialize_thrift_msg(footer, &serialized_size, true, &t_metadata));
+    auto file_metadata = std::make_shared<FileMetaData>();
+    RETURN_IF_ERROR(file_metadata->init(t_metadata));
+    _file_metadata = std::move(file_metadata);
 
+    if (!cache_key.empty()) {
+        // the parsed footer is charged by its serialized size.
+        cache->insert(cache_key, _file_metadata, footer_size);
+    }
     return Status::OK();
 }
 
@@ -222,14 +256,7 @@ Status FileReader::_read_min_max_chunk(const tparquet::RowGroup& row_group, vect
             *exist = false;
             return Status::OK();
         } else {
-            const ParquetField* field = _file_metadata->schema().resolve_by_name(slot->col_name());
-            const tparquet::ColumnOrder* column_order = nullptr;
-            if (_file_metadata->t_metadata().__isset.column_orders) {
-                const auto& column_orders = _file_metadata->t_metadata().column_orders;
-                int column_idx = field->physical_column_index;
-                column_order = column_idx < column_orders.size() ? &column_orders[column_idx] : nullptr;
-            }
-
+            const tparquet::ColumnOrder* column_order = _get_column_order(slot->col_name());
             Status status = _decode_min_max_column(*column_meta, column_order, &(*min_chunk)->columns()[i],
                                                    &(*max_chunk)->columns()[i]);
             if (!status.ok()) {
@@ -243,6 +270,211 @@ Status FileReader::_read_min_max_chunk(const tparquet::RowGroup& row_group, vect
     return Status::OK();
 }
 
+const tparquet::ColumnOrder* FileReader::_get_column_order(const std::string& col_name) const {
+    if (!_file_metadata->t_metadata().__isset.column_orders) {
+        return nullptr;
+    }
+    const ParquetField* field = _file_metadata->schema().resolve_by_name(col_name);
+    const auto& column_orders = _file_metadata->t_metadata().column_orders;
+    int column_idx = field->physical_column_index;
+    return column_idx < column_orders.size() ? &column_orders[column_idx] : nullptr;
+}
+
+// Get the plain encodings of the values if the conjunct is `slot = value` or `slot in (values)`, the null values
+// are ignored since they never equal.
+static bool get_equal_plain_values(ExprContext* ctx, const TypeDescriptor& type, tparquet::Type::type physical_type,
+                                   std::vector<std::string>* values) {
+    const Expr* root = ctx->root();
+    bool is_eq = root->node_type() == TExprNodeType::BINARY_PRED && root->op() == TExprOpcode::EQ;
+    bool is_in = root->node_type() == TExprNodeType::IN_PRED && root->op() == TExprOpcode::FILTER_IN;
+    if ((!is_eq && !is_in) || root->get_num_children() < 2 || !root->get_child(0)->is_slotref()) {
+        return false;
+    }
+    values->clear();
+    for (int i = 1; i < root->get_num_children(); i++) {
+        Expr* child = root->get_child(i);
+        if (!child->is_constant()) {
+            return false;
+        }
+        vectorized::ColumnPtr column = ctx->evaluate(child, nullptr);
+        vectorized::Datum datum = column->get(0);
+        if (datum.is_null()) {
+            continue;
+        }
+        if (type.type == TYPE_INT && physical_type == tparquet::Type::type::INT32) {
+            int32_t value = datum.get_int32();
+            values->emplace_back(reinterpret_cast<const char*>(&value), sizeof(value));
+        } else if (type.type == TYPE_BIGINT && physical_type == tparquet::Type::type::INT64) {
+            int64_t value = datum.get_int64();
+            values->emplace_back(reinterpret_cast<const char*>(&value), sizeof(value));
+        } else if (type.type == TYPE_VARCHAR && physical_type == tparquet::Type::type::BYTE_ARRAY) {
+            const Slice& value = datum.get_slice();
+            values->emplace_back(value.data, value.size);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status FileReader::_filter_group_by_bloom_filter(const tparquet::RowGroup& row_group, bool* is_filter) {
+    *is_filter = false;
+    if (!config::parquet_bloom_filter_enable) {
+        return Status::OK();
+    }
+    const auto& conjunct_ctxs_by_slot = _param.conjunct_ctxs_by_slot;
+    std::vector<std::string> values;
+    for (const auto& column : _read_cols) {
+        auto iter = conjunct_ctxs_by_slot.find(column.slot_id);
+        if (iter == conjunct_ctxs_by_slot.end()) {
+            continue;
+        }
+        const ParquetField* field = _file_metadata->schema().get_stored_column_by_idx(column.col_idx_in_parquet);
+        if (!field->children.empty()) {
+            continue;
+        }
+        const tparquet::ColumnMetaData& column_meta = row_group.columns[field->physical_column_index].meta_data;
+        if (!column_meta.__isset.bloom_filter_offset) {
+            continue;
+        }
+
+        std::unique_ptr<BloomFilterReader> bloom_filter;
+        for (ExprContext* ctx : iter->second) {
+            if (!get_equal_plain_values(ctx, column.col_type_in_chunk, column_meta.type, &values)) {
+                continue;
+            }
+            if (bloom_filter == nullptr) {
+                bloom_filter = std::make_unique<BloomFilterReader>();
+                if (!bloom_filter->init(_file, column_meta, _param.stats).ok()) {
+                    break;
+                }
+            }
+            bool may_match = false;
+            for (const auto& value : values) {
+                if (bloom_filter->test_bytes(Slice(value))) {
+                    may_match = true;
+                    break;
+                }
+            }
+            if (!may_match) {
+                *is_filter = true;
+                return Status::OK();
+            }
+        }
+    }
+    return Status::OK();
+}
+
+// Whether the row |i| of the result of a conjunct may be true.
+static bool may_be_true(const vectorized::ColumnPtr& column, size_t i) {
+    vectorized::Datum datum = column->get(i);
+    return datum.is_null() || datum.get_int8() != 0;
+}
+
+Status FileReader::_select_rows_by_page_index(const tparquet::RowGroup& row_group, int64_t* first_row,
+                                              int64_t* end_row) {
+    *first_row = 0;
+    *end_row = row_group.num_rows;
+    if (!config::parquet_page_index_enable || _param.min_max_conjunct_ctxs.empty()) {
+        return Status::OK();
+    }
+
+    // the min/max conjuncts of each slot, the ones of more than one slot can't be evaluated by pages.
+    std::unordered_map<SlotId, std::vector<ExprContext*>> conjunct_ctxs_by_slot;
+    for (ExprContext* ctx : _param.min_max_conjunct_ctxs) {
+        std::vector<SlotId> slot_ids;
+        if (ctx->root()->get_slot_ids(&slot_ids) == 1) {
+            conjunct_ctxs_by_slot[slot_ids[0]].emplace_back(ctx);
+        }
+    }
+
+    for (const SlotDescriptor* slot : _param.min_max_tuple_desc->slots()) {
+        auto iter = conjunct_ctxs_by_slot.find(slot->id());
+        if (iter == conjunct_ctxs_by_slot.end()) {
+            continue;
+        }
+        const tparquet::ColumnChunk* column_chunk = _get_column_chunk(row_group, slot->col_name());
+        if (column_chunk == nullptr) {
+            continue;
+        }
+        int64_t column_first_row = 0;
+        int64_t column_end_row = row_group.num_rows;
+        RETURN_IF_ERROR(_select_column_rows_by_page_index(*column_chunk, row_group.num_rows, slot, iter->second,
+                                                          &column_first_row, &column_end_row));
+        *first_row = std::max(*first_row, column_first_row);
+        *end_row = std::min(*end_row, column_end_row);
+        if (*first_row >= *end_row) {
+            return Status::OK();
+        }
+    }
+    return Status::OK();
+}
+
+Status FileReader::_select_column_rows_by_page_index(const tparquet::ColumnChunk& column_chunk, int64_t num_rows,
+                                                     const SlotDescriptor* slot,
+                                                     const std::vector<ExprContext*>& conjunct_ctxs,
+                                                     int64_t* first_row, int64_t* end_row) {
+    const tparquet::ColumnMetaData& column_meta = column_chunk.meta_data;
+    if (!_can_use_stats(column_meta.type, _get_column_order(slot->col_name()))) {
+        return Status::OK();
+    }
+    tparquet::ColumnIndex column_index;
+    tparquet::OffsetIndex offset_index;
+    if (!PageIndexReader::read_column_index(_file, column_chunk, _param.stats, &column_index).ok() ||
+        !PageIndexReader::read_offset_index(_file, column_chunk, _param.stats, &offset_index).ok()) {
+        return Status::OK();
+    }
+    const auto& pages = offset_index.page_locations;
+    size_t num_pages = pages.size();
+    if (num_pages == 0 || column_index.null_pages.size() != num_pages ||
+        column_index.min_values.size() != num_pages || column_index.max_values.size() != num_pages) {
+        return Status::OK();
+    }
+
+    // The conjuncts are not evaluated on the pages of only nulls, they are kept.
+    vectorized::ColumnPtr min_column = vectorized::ColumnHelper::create_column(slot->type(), true);
+    vectorized::ColumnPtr max_column = vectorized::ColumnHelper::create_column(slot->type(), true);
+    for (size_t i = 0; i < num_pages; i++) {
+        if (column_index.null_pages[i]) {
+            min_column->append_nulls(1);
+            max_column->append_nulls(1);
+        } else if (!_decode_min_max_value(column_meta.type, column_index.min_values[i], column_index.max_values[i],
+                                          &min_column, &max_column)
+                            .ok()) {
+            return Status::OK();
+        }
+    }
+    auto min_chunk = std::make_shared<vectorized::Chunk>();
+    auto max_chunk = std::make_shared<vectorized::Chunk>();
+    min_chunk->append_column(min_column, slot->id());
+    max_chunk->append_column(max_column, slot->id());
+
+    std::vector<uint8_t> selected(num_pages, 1);
+    {
+        SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
+        for (ExprContext* ctx : conjunct_ctxs) {
+            vectorized::ColumnPtr min_result = ctx->evaluate(min_chunk.get());
+            vectorized::ColumnPtr max_result = ctx->evaluate(max_chunk.get());
+            for (size_t i = 0; i < num_pages; i++) {
+                if (!column_index.null_pages[i] && !may_be_true(min_result, i) && !may_be_true(max_result, i)) {
+                    selected[i] = 0;
+                }
+            }
+        }
+    }
+
+    auto first = std::find(selected.begin(), selected.end(), 1);
+    if (first == selected.end()) {
+        *first_row = *end_row = 0;
+        return Status::OK();
+    }
+    size_t first_page = first - selected.begin();
+    size_t last_page = selected.rend() - std::find(selected.rbegin(), selected.rend(), 1) - 1;
+    *first_row = pages[first_page].first_row_index;
+    *end_row = last_page + 1 < num_pages ? pages[last_page + 1].first_row_index : num_rows;
+    return Status::OK();
+}
+
 int FileReader::_get_partition_column_idx(const std::string& col_name) const {
     for (size_t i = 0; i < _param.partition_columns.size(); i++) {
         if (_param.partition_columns[i].col_name == col_name) {
@@ -259,45 +491,42 @@ Status FileReader::_decode_min_max_column(const tparquet::ColumnMetaData& column
         return Status::NotSupported("min max statistics not supported");
     }
 
-    switch (column_meta.type) {
+    const tparquet::Statistics& statistics = column_meta.statistics;
+    if (statistics.__isset.min_value) {
+        return _decode_min_max_value(column_meta.type, statistics.min_value, statistics.max_value, min_column,
+                                     max_column);
+    } else {
+        return _decode_min_max_value(column_meta.type, statistics.min, statistics.max, min_column, max_column);
+    }
+}
+
+Status FileReader::_decode_min_max_value(tparquet::Type::type type, const std::string& min_value,
+                                         const std::string& max_value, vectorized::ColumnPtr* min_column,
+                                         vectorized::ColumnPtr* max_column) {
+    switch (type) {
     case tparquet::Type::type::INT32: {
-        int32_t min_value = 0;
-        int32_t max_value = 0;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.min_value, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.max_value, &max_value));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.min, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.max, &max_value));
-        }
-        (*min_column)->append_numbers(&min_value, sizeof(int32_t));
-        (*max_column)->append_numbers(&max_value, sizeof(int32_t));
+        int32_t min = 0;
+        int32_t max = 0;
+        RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(min_value, &min));
+        RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(max_value, &max));
+        (*min_column)->append_numbers(&min, sizeof(int32_t));
+        (*max_column)->append_numbers(&max, sizeof(int32_t));
         return Status::OK();
     }
     case tparquet::Type::type::INT64: {
-        int64_t min_value = 0;
-        int64_t max_value = 0;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.min_value, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.max_value, &max_value));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.max, &max_value));
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.min, &min_value));
-        }
-        (*min_column)->append_numbers(&min_value, sizeof(int64_t));
-        (*max_column)->append_numbers(&max_value, sizeof(int64_t));
+        int64_t min = 0;
+        int64_t max = 0;
+        RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(min_value, &min));
+        RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(max_value, &max));
+        (*min_column)->append_numbers(&min, sizeof(int64_t));
+        (*max_column)->append_numbers(&max, sizeof(int64_t));
         return Status::OK();
     }
     case tparquet::Type::type::BYTE_ARRAY: {
         Slice min_slice;
         Slice max_slice;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.min_value, &min_slice));
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.max_value, &max_slice));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.min, &min_slice));
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.max, &max_slice));
-        }
+        RETURN_IF_ERROR(PlainDecoder<Slice>::decode(min_value, &min_slice));
+        RETURN_IF_ERROR(PlainDecoder<Slice>::decode(max_value, &max_slice));
         (*min_column)->append_strings(std::vector<Slice>{min_slice});
         (*max_column)->append_strings(std::vector<Slice>{max_slice});
         return Status::OK();
@@ -343,7 +572,7 @@ bool FileReader::_is_integer_type(const tparquet::Type::type& type) {
            type == tparquet::Type::type::INT96;
 }
 
-Status FileReader::_create_and_init_group_reader(int row_group_number) {
+void FileReader::_create_group_reader(int row_group_number, int64_t first_row, int64_t end_row) {
     auto row_group_reader = _row_group(row_group_number);
 
     GroupReaderParam param;
@@ -352,12 +581,32 @@ Status FileReader::_create_and_init_group_reader(int row_group_number) {
     param.read_cols = _read_cols;
     param.timezone = _param.timezone;
     param.stats = _param.stats;
+    param.first_row = first_row;
+    param.end_row = end_row;
 
-    RETURN_IF_ERROR(row_group_reader->init(param));
     _row_group_readers.emplace_back(row_group_reader);
+    _row_group_params.emplace_back(std::move(param));
+}
+
+Status FileReader::_init_cur_group_reader() {
+    RETURN_IF_ERROR(_row_group_readers[_cur_row_group_idx]->init(_row_group_params[_cur_row_group_idx]));
+    _cur_row_group_inited = true;
+    _prefetch_group_readers();
     return Status::OK();
 }
 
+void FileReader::_prefetch_group_readers() {
+    if (_param.io_controller == nullptr) {
+        return;
+    }
+    _next_prefetch_idx = std::max(_next_prefetch_idx, _cur_row_group_idx + 1);
+    while (_next_prefetch_idx < _row_group_size &&
+           _row_group_readers[_next_prefetch_idx]->prefetch_async(_row_group_params[_next_prefetch_idx],
+                                                                  _param.io_controller)) {
+        _next_prefetch_idx++;
+    }
+}
+
 bool FileReader::_select_row_group(const tparquet::RowGroup& row_group) {
     size_t row_group_start = _get_row_group_start_offset(row_group);
 
@@ -378,22 +627,40 @@ Status FileReader::_init_group_reader() {
         bool selected = _select_row_group(_file_metadata->t_metadata().row_groups[i]);
 
         if (selected) {
+            const tparquet::RowGroup& row_group = _file_metadata->t_metadata().row_groups[i];
             bool is_filter = false;
-            RETURN_IF_ERROR(_filter_group(_file_metadata->t_metadata().row_groups[i], &is_filter));
+            RETURN_IF_ERROR(_filter_group(row_group, &is_filter));
             if (is_filter) {
                 LOG(INFO) << "row group " << i << " of file has been filtered by min/max conjunct";
                 continue;
             }
 
-            RETURN_IF_ERROR(_create_and_init_group_reader(i));
+            RETURN_IF_ERROR(_filter_group_by_bloom_filter(row_group, &is_filter));
+            if (is_filter) {
+                VLOG_FILE << "row group " << i << " of file has been filtered by bloom filter";
+                continue;
+            }
+
+            int64_t first_row = 0;
+            int64_t end_row = row_group.num_rows;
+            RETURN_IF_ERROR(_select_rows_by_page_index(row_group, &first_row, &end_row));
+            if (first_row >= end_row) {
+                VLOG_FILE << "row group " << i << " of file has been filtered by page index";
+                continue;
+            }
+
+            _create_group_reader(i, first_row, end_row);
 
-            _total_row_count += _file_metadata->t_metadata().row_groups[i].num_rows;
+            _total_row_count += end_row - first_row;
         } else {
             continue;
         }
     }
 
     _row_group_size = _row_group_readers.size();
+    if (_row_group_size > 0) {
+        RETURN_IF_ERROR(_init_cur_group_reader());
+    }
     return Status::OK();
 }
 
@@ -404,6 +671,12 @@ Status FileReader::_get_next_internal(vectorized::ChunkPtr* chunk) {
     }
 
     if (_cur_row_group_idx < _row_group_size) {
+        if (!_cur_row_group_inited) {
+            RETURN_IF_ERROR(_init_cur_group_reader());
+        } else {
+            // the reads ahead finished may leave room for more
+            _prefetch_group_readers();
+        }
         size_t row_count = config::vector_chunk_size;
         Status status = _row_group_readers[_cur_row_group_idx]->get_next(chunk, &row_count);
         if (status.ok() || status.is_end_of_file()) {
@@ -414,7 +687,10 @@ Status FileReader::_get_next_internal(vectorized::ChunkPtr* chunk) {
                 _scan_row_count += (*chunk)->num_rows();
             }
             if (status.is_end_of_file()) {
+                // release the column chunks read
+                _row_group_readers[_cur_row_group_idx].reset();
                 _cur_row_group_idx++;
+                _cur_row_group_inited = false;
                 return Status::OK();
             }
         }
@@ -465,10 +741,16 @@ void FileReader::_append_partition_column_to_chunk(vectorized::ChunkPtr* chunk,
 
 const tparquet::ColumnMetaData* FileReader::_get_column_meta(const tparquet::RowGroup& row_group,
                                                              const std::string& col_name) {
+    const tparquet::ColumnChunk* column_chunk = _get_column_chunk(row_group, col_name);
+    return column_chunk != nullptr ? &column_chunk->meta_data : nullptr;
+}
+
+const tparquet::ColumnChunk* FileReader::_get_column_chunk(const tparquet::RowGroup& row_group,
+                                                           const std::string& col_name) {
     for (const auto& column : row_group.columns) {
         // TODO: support not scalar type
         if (column.meta_data.path_in_schema[0] == col_name) {
-            return &column.meta_data;
+            return &column;
         }
     }
     return nullptr;
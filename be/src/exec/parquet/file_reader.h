@@ -50,8 +50,12 @@ private:
     // filter file using not exist column conjuncts
     void _filter_file();
 
-    // create and inti group reader
-    Status _create_and_init_group_reader(int row_group_number);
+    // create group reader, which reads the rows [first_row, end_row) of the row group
+    void _create_group_reader(int row_group_number, int64_t first_row, int64_t end_row);
+
+    // init the current group reader, and read the next row groups ahead if the scan node allows it
+    Status _init_cur_group_reader();
+    void _prefetch_group_readers();
 
     // create row group reader
     std::shared_ptr<GroupReader> _row_group(int i);
@@ -62,6 +66,17 @@ private:
     // filter row group by min/max conjuncts
     Status _filter_group(const tparquet::RowGroup& group, bool* is_filter);
 
+    // filter row group by the bloom filters of the columns with equal or in conjuncts
+    Status _filter_group_by_bloom_filter(const tparquet::RowGroup& row_group, bool* is_filter);
+
+    // select the rows [first_row, end_row) of the row group, out of which all the pages of some column don't match
+    // the min/max conjuncts by the column indexes, the range is empty if no row matches.
+    Status _select_rows_by_page_index(const tparquet::RowGroup& row_group, int64_t* first_row, int64_t* end_row);
+    Status _select_column_rows_by_page_index(const tparquet::ColumnChunk& column_chunk, int64_t num_rows,
+                                             const SlotDescriptor* slot,
+                                             const std::vector<ExprContext*>& conjunct_ctxs, int64_t* first_row,
+                                             int64_t* end_row);
+
     // get row group to read
     // if scan range conatain the first byte in the row group, will be read
     // TODO: later modify the larger block should be read
@@ -94,6 +109,10 @@ private:
     static Status _decode_min_max_column(const tparquet::ColumnMetaData& column_meta,
                                          const tparquet::ColumnOrder* column_order, vectorized::ColumnPtr* min_column,
                                          vectorized::ColumnPtr* max_column);
+    // decode the plain encoded min/max value of the physical type
+    static Status _decode_min_max_value(tparquet::Type::type type, const std::string& min_value,
+                                        const std::string& max_value, vectorized::ColumnPtr* min_column,
+                                        vectorized::ColumnPtr* max_column);
     static bool _can_use_min_max_stats(const tparquet::ColumnMetaData& column_meta,
                                        const tparquet::ColumnOrder* column_order);
     // statistics.min_value max_value
@@ -105,6 +124,11 @@ private:
     // find column meta according column name
     static const tparquet::ColumnMetaData* _get_column_meta(const tparquet::RowGroup& row_group,
                                                             const std::string& col_name);
+    static const tparquet::ColumnChunk* _get_column_chunk(const tparquet::RowGroup& row_group,
+                                                          const std::string& col_name);
+
+    // the column order of the column, nullptr if it's not set
+    const tparquet::ColumnOrder* _get_column_order(const std::string& col_name) const;
 
     // get the data page start offset in parquet file
     static int64_t _get_row_group_start_offset(const tparquet::RowGroup& row_group);
@@ -113,9 +137,15 @@ private:
     uint64_t _file_size;
 
     starrocks::vectorized::HdfsFileReaderParam _param;
-    std::shared_ptr<FileMetaData> _file_metadata;
+    // shared with the other readers of the file by the file meta cache, which must not be modified
+    std::shared_ptr<const FileMetaData> _file_metadata;
+    // the group readers are inited one by one when they are read, and reset after being read
     vector<std::shared_ptr<GroupReader>> _row_group_readers;
+    vector<GroupReaderParam> _row_group_params;
     size_t _cur_row_group_idx = 0;
+    bool _cur_row_group_inited = false;
+    // the next row group to read ahead
+    size_t _next_prefetch_idx = 0;
     size_t _row_group_size = 0;
     vectorized::Schema _schema;
 
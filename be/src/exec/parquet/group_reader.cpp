@@ -3,8 +3,13 @@
 
 #include "exec/parquet/group_reader.h"
 
+#include <algorithm>
+
 #include "column/column_helper.h"
+#include "common/config.h"
 #include "exec/exec_node.h"
+#include "exec/parquet/page_index_reader.h"
+#include "exec/vectorized/hdfs_io_controller.h"
 #include "exprs/expr.h"
 #include "runtime/types.h"
 #include "simd/simd.h"
@@ -15,19 +20,59 @@ namespace starrocks::parquet {
 constexpr static const PrimitiveType kDictCodePrimitiveType = TYPE_INT;
 constexpr static const FieldType kDictCodeFieldType = OLAP_FIELD_TYPE_INT;
 
-GroupReader::GroupReader(RandomAccessFile* file, FileMetaData* file_metadata, int row_group_number)
+GroupReader::GroupReader(RandomAccessFile* file, const FileMetaData* file_metadata, int row_group_number)
         : _file(file), _file_metadata(file_metadata), _row_group_number(row_group_number) {
     _row_group_metadata =
             std::make_shared<tparquet::RowGroup>(_file_metadata->t_metadata().row_groups[row_group_number]);
 }
 
+GroupReader::~GroupReader() {
+    if (_prefetch_future.valid()) {
+        _prefetch_future.wait();
+    }
+    if (_io_controller != nullptr) {
+        _io_controller->release(_prefetch_bytes);
+    }
+}
+
+bool GroupReader::prefetch_async(const GroupReaderParam& param, vectorized::HdfsIOController* io_controller) {
+    if (config::parquet_coalesce_read_max_buffer_bytes <= 0) {
+        return false;
+    }
+    std::vector<PrefetchedRanges::Range> ranges = _column_chunk_ranges(param.read_cols);
+    int64_t bytes = 0;
+    for (const auto& range : ranges) {
+        bytes += range.size;
+    }
+    bytes = std::min(bytes, config::parquet_coalesce_read_max_buffer_bytes);
+
+    auto promise = std::make_shared<std::promise<Status>>();
+    auto read = [this, ranges = std::move(ranges), promise]() mutable {
+        promise->set_value(_prefetched_ranges.prefetch(_file, std::move(ranges),
+                                                       config::parquet_coalesce_read_max_gap_bytes,
+                                                       config::parquet_coalesce_read_max_buffer_bytes,
+                                                       &_prefetch_stats));
+    };
+    if (!io_controller->try_submit(bytes, std::move(read))) {
+        return false;
+    }
+    _prefetch_future = promise->get_future();
+    _io_controller = io_controller;
+    _prefetch_bytes = bytes;
+    return true;
+}
+
 Status GroupReader::init(const GroupReaderParam& param) {
     _param = param;
+    if (_param.end_row < 0 || _param.end_row > _row_group_metadata->num_rows) {
+        _param.end_row = _row_group_metadata->num_rows;
+    }
     // the calling order matters, do not change unless you know why.
     RETURN_IF_ERROR(_init_column_readers());
     _pre_process_columns_and_conjunct_ctxs();
     RETURN_IF_ERROR(_rewrite_dict_column_predicates());
     _init_read_chunk();
+    RETURN_IF_ERROR(_seek_to_first_row());
     return Status::OK();
 }
 
@@ -37,8 +82,13 @@ Status GroupReader::get_next(vectorized::ChunkPtr* chunk, size_t* row_count) {
         return Status::EndOfFile("");
     }
 
+    if (_next_row >= _param.end_row) {
+        *row_count = 0;
+        return Status::EndOfFile("");
+    }
+
     _read_chunk->reset();
-    size_t count = *row_count;
+    size_t count = std::min<int64_t>(*row_count, _param.end_row - _next_row);
     bool has_dict_filter = !_dict_filter_preds.empty();
     bool has_more_filter = !_left_conjunct_ctxs.empty();
     Status status;
@@ -51,6 +101,19 @@ Status GroupReader::get_next(vectorized::ChunkPtr* chunk, size_t* row_count) {
         if (!status.ok() && !status.is_end_of_file()) {
             return status;
         }
+        _next_row += count;
+        if (status.ok() && _next_row >= _param.end_row) {
+            status = Status::EndOfFile("");
+        }
+    }
+
+    if (!_lazy_columns.empty()) {
+        RETURN_IF_ERROR(_filter_and_read_lazy_columns(count));
+        *row_count = _read_chunk->num_rows();
+
+        SCOPED_RAW_TIMER(&_param.stats->group_dict_decode_ns);
+        RETURN_IF_ERROR(_dict_decode(chunk));
+        return status;
     }
 
     // dict filter
@@ -77,7 +140,55 @@ Status GroupReader::get_next(vectorized::ChunkPtr* chunk, size_t* row_count) {
     return status;
 }
 
+// Append the ranges of the column chunks of all the leaves of |field|.
+static void append_column_chunk_ranges(const ParquetField* field, const tparquet::RowGroup& row_group,
+                                       std::vector<PrefetchedRanges::Range>* ranges) {
+    if (!field->children.empty()) {
+        for (const auto& child : field->children) {
+            append_column_chunk_ranges(&child, row_group, ranges);
+        }
+        return;
+    }
+    const tparquet::ColumnMetaData& metadata = row_group.columns[field->physical_column_index].meta_data;
+    PrefetchedRanges::Range range;
+    range.offset = metadata.__isset.dictionary_page_offset ? metadata.dictionary_page_offset
+                                                           : metadata.data_page_offset;
+    range.size = metadata.total_compressed_size;
+    ranges->push_back(range);
+}
+
+std::vector<PrefetchedRanges::Range> GroupReader::_column_chunk_ranges(
+        const std::vector<GroupReaderParam::Column>& read_cols) {
+    std::vector<PrefetchedRanges::Range> ranges;
+    for (const auto& column : read_cols) {
+        const auto* schema_node = _file_metadata->schema().get_stored_column_by_idx(column.col_idx_in_parquet);
+        append_column_chunk_ranges(schema_node, *_row_group_metadata, &ranges);
+    }
+    return ranges;
+}
+
+Status GroupReader::_prefetch_column_chunks() {
+    return _prefetched_ranges.prefetch(_file, _column_chunk_ranges(_param.read_cols),
+                                       config::parquet_coalesce_read_max_gap_bytes,
+                                       config::parquet_coalesce_read_max_buffer_bytes, _param.stats);
+}
+
+Status GroupReader::_wait_prefetch() {
+    Status st = _prefetch_future.get();
+    _param.stats->io_ns += _prefetch_stats.io_ns;
+    _param.stats->io_count += _prefetch_stats.io_count;
+    _param.stats->bytes_read_from_disk += _prefetch_stats.bytes_read_from_disk;
+    return st;
+}
+
 Status GroupReader::_init_column_readers() {
+    if (_prefetch_future.valid()) {
+        SCOPED_RAW_TIMER(&_param.stats->column_reader_init_ns);
+        RETURN_IF_ERROR(_wait_prefetch());
+    } else if (config::parquet_coalesce_read_max_buffer_bytes > 0) {
+        SCOPED_RAW_TIMER(&_param.stats->column_reader_init_ns);
+        RETURN_IF_ERROR(_prefetch_column_chunks());
+    }
     for (const auto& column : _param.read_cols) {
         RETURN_IF_ERROR(_create_column_reader(column));
     }
@@ -91,6 +202,7 @@ Status GroupReader::_create_column_reader(const GroupReaderParam::Column& column
     ColumnReaderOptions opts;
     opts.stats = _param.stats;
     opts.timezone = _param.timezone;
+    opts.prefetched_ranges = &_prefetched_ranges;
     {
         SCOPED_RAW_TIMER(&_param.stats->column_reader_init_ns);
         RETURN_IF_ERROR(ColumnReader::create(_file, schema_node, *_row_group_metadata, column.col_type_in_chunk, opts,
@@ -103,6 +215,7 @@ Status GroupReader::_create_column_reader(const GroupReaderParam::Column& column
 void GroupReader::_pre_process_columns_and_conjunct_ctxs() {
     const auto& conjunct_ctxs_by_slot = _param.conjunct_ctxs_by_slot;
     const auto& slots = _param.tuple_desc->slots();
+    std::vector<GroupReaderParam::Column> lazy_columns;
     for (const auto& column : _param.read_cols) {
         int chunk_index = column.col_idx_in_chunk;
         SlotId slot_id = column.slot_id;
@@ -117,9 +230,25 @@ void GroupReader::_pre_process_columns_and_conjunct_ctxs() {
                 for (ExprContext* ctx : conjunct_ctxs_by_slot.at(slot_id)) {
                     _left_conjunct_ctxs.emplace_back(ctx);
                 }
+                _active_columns.emplace_back(column);
+                continue;
+            }
+            // only the readers of the flat scalar columns can skip rows
+            const auto* schema_node = _file_metadata->schema().get_stored_column_by_idx(column.col_idx_in_parquet);
+            if (schema_node->children.empty() && schema_node->max_rep_level() == 0) {
+                lazy_columns.emplace_back(column);
+            } else {
+                _active_columns.emplace_back(column);
             }
         }
     }
+
+    bool has_conjuncts = !_dict_filter_columns.empty() || !_left_conjunct_ctxs.empty();
+    if (config::parquet_late_materialization_enable && has_conjuncts) {
+        _lazy_columns = std::move(lazy_columns);
+    } else {
+        _active_columns.insert(_active_columns.end(), lazy_columns.begin(), lazy_columns.end());
+    }
 }
 
 bool GroupReader::_can_using_dict_filter(const SlotDescriptor* slot, const SlotIdExprContextsMap& conjunct_ctxs_by_slot,
@@ -274,6 +403,69 @@ void GroupReader::_init_read_chunk() {
         dict_code_column->reserve(chunk_size);
         _read_chunk->update_column(dict_code_column, slot_id);
     }
+
+    if (!_lazy_columns.empty()) {
+        _active_chunk = std::make_shared<vectorized::Chunk>();
+        for (const auto& column : _dict_filter_columns) {
+            _active_chunk->append_column(_read_chunk->get_column_by_slot_id(column.slot_id), column.slot_id);
+        }
+        for (const auto& column : _active_columns) {
+            _active_chunk->append_column(_read_chunk->get_column_by_slot_id(column.slot_id), column.slot_id);
+        }
+        for (const auto& column : _lazy_columns) {
+            _lazy_read_columns[column.slot_id] = _read_chunk->get_column_by_slot_id(column.slot_id)->clone_empty();
+        }
+    }
+}
+
+Status GroupReader::_seek_to_first_row() {
+    _next_row = _param.first_row;
+    if (_param.first_row <= 0 || _is_group_filtered) {
+        return Status::OK();
+    }
+    for (const auto& column : _param.read_cols) {
+        ColumnContentType content_type = _dict_filter_preds.count(column.slot_id) > 0 ? ColumnContentType::DICT_CODE
+                                                                                       : ColumnContentType::VALUE;
+        const auto& column_chunk = _row_group_metadata->columns[column.col_idx_in_parquet];
+        tparquet::OffsetIndex offset_index;
+        int64_t page_first_row = 0;
+        if (PageIndexReader::read_offset_index(_file, column_chunk, _param.stats, &offset_index).ok()) {
+            // the last page starting before or at first_row
+            const auto& pages = offset_index.page_locations;
+            auto iter = std::upper_bound(pages.begin(), pages.end(), _param.first_row,
+                                         [](int64_t row, const tparquet::PageLocation& page) {
+                                             return row < page.first_row_index;
+                                         });
+            if (iter != pages.begin() && (--iter)->first_row_index > 0) {
+                Status st = _column_readers[column.slot_id]->seek_to_page(iter->offset);
+                if (st.ok()) {
+                    page_first_row = iter->first_row_index;
+                } else if (!st.is_not_supported()) {
+                    return st;
+                }
+            }
+        }
+        RETURN_IF_ERROR(_skip_rows(column, content_type, _param.first_row - page_first_row));
+    }
+    return Status::OK();
+}
+
+Status GroupReader::_skip_rows(const GroupReaderParam::Column& column, ColumnContentType content_type,
+                               size_t num_rows) {
+    vectorized::Column* dst = _read_chunk->get_column_by_slot_id(column.slot_id).get();
+    while (num_rows > 0) {
+        size_t count = std::min<size_t>(num_rows, config::vector_chunk_size);
+        Status st = _column_readers[column.slot_id]->next_batch(&count, content_type, dst);
+        dst->resize(0);
+        if (!st.ok() && !st.is_end_of_file()) {
+            return st;
+        }
+        if (count == 0) {
+            return Status::Corruption("Skip rows beyond the end of the parquet column chunk");
+        }
+        num_rows -= count;
+    }
+    return Status::OK();
 }
 
 Status GroupReader::_read(size_t* row_count) {
@@ -289,7 +481,7 @@ Status GroupReader::_read(size_t* row_count) {
         }
     }
 
-    for (const auto& column : _direct_read_columns) {
+    for (const auto& column : _active_columns) {
         SlotId slot_id = column.slot_id;
         count = *row_count;
         Status status = _column_readers[slot_id]->next_batch(&count, ColumnContentType::VALUE,
@@ -330,6 +522,89 @@ void GroupReader::_dict_filter() {
     }
 }
 
+Status GroupReader::_filter_and_read_lazy_columns(size_t row_count) {
+    size_t hit_count = 0;
+    {
+        SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
+        _selection.assign(row_count, 1);
+        if (!_dict_filter_preds.empty()) {
+            SCOPED_RAW_TIMER(&_param.stats->group_dict_filter_ns);
+            for (const auto& [slot_id, pred] : _dict_filter_preds) {
+                pred->evaluate_and(_active_chunk->get_column_by_slot_id(slot_id).get(), _selection.data());
+            }
+        }
+        if (row_count > 0 && SIMD::count_nonzero(_selection.data(), row_count) > 0) {
+            for (ExprContext* ctx : _left_conjunct_ctxs) {
+                vectorized::ColumnPtr column = ctx->evaluate(_active_chunk.get());
+                vectorized::ColumnHelper::merge_two_filters(column, &_selection, nullptr);
+            }
+        }
+        hit_count = SIMD::count_nonzero(_selection.data(), row_count);
+        if (hit_count == 0) {
+            _active_chunk->set_num_rows(0);
+        } else if (hit_count != row_count) {
+            _active_chunk->filter_range(_selection, 0, row_count);
+        }
+    }
+
+    {
+        SCOPED_RAW_TIMER(&_param.stats->group_chunk_read_ns);
+        for (const auto& column : _lazy_columns) {
+            RETURN_IF_ERROR(_read_lazy_column(column, row_count, hit_count));
+        }
+    }
+    _read_chunk->check_or_die();
+    return Status::OK();
+}
+
+Status GroupReader::_read_lazy_column(const GroupReaderParam::Column& column, size_t row_count, size_t hit_count) {
+    // the selected rows are read by runs if the runs are this number of rows long on average, otherwise all the
+    // rows are read and filtered.
+    constexpr size_t kMinAvgRunLength = 64;
+
+    ColumnReader* reader = _column_readers[column.slot_id].get();
+    vectorized::Column* dst = _read_chunk->get_column_by_slot_id(column.slot_id).get();
+    auto ignore_eof = [](const Status& st) { return st.is_end_of_file() ? Status::OK() : st; };
+    if (hit_count == 0) {
+        return ignore_eof(reader->skip_rows(row_count));
+    }
+
+    size_t num_runs = 1;
+    for (size_t i = 1; i < row_count; ++i) {
+        num_runs += _selection[i] != _selection[i - 1];
+    }
+    if (hit_count == row_count || num_runs * kMinAvgRunLength > row_count) {
+        size_t count = row_count;
+        RETURN_IF_ERROR(ignore_eof(reader->next_batch(&count, ColumnContentType::VALUE, dst)));
+        if (hit_count != row_count) {
+            dst->filter_range(_selection, 0, row_count);
+        }
+        return Status::OK();
+    }
+
+    // The column converters overwrite the column read into, so only the first run is read into dst directly.
+    vectorized::Column* buffer = _lazy_read_columns[column.slot_id].get();
+    size_t i = 0;
+    while (i < row_count) {
+        size_t j = i + 1;
+        while (j < row_count && _selection[j] == _selection[i]) {
+            j++;
+        }
+        size_t count = j - i;
+        if (!_selection[i]) {
+            RETURN_IF_ERROR(ignore_eof(reader->skip_rows(count)));
+        } else if (dst->empty()) {
+            RETURN_IF_ERROR(ignore_eof(reader->next_batch(&count, ColumnContentType::VALUE, dst)));
+        } else {
+            RETURN_IF_ERROR(ignore_eof(reader->next_batch(&count, ColumnContentType::VALUE, buffer)));
+            dst->append(*buffer);
+            buffer->resize(0);
+        }
+        i = j;
+    }
+    return Status::OK();
+}
+
 Status GroupReader::_dict_decode(vectorized::ChunkPtr* chunk) {
     const auto& slots = _param.tuple_desc->slots();
 
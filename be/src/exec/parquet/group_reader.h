@@ -2,10 +2,13 @@
 
 #pragma once
 
+#include <future>
+
 #include "column/chunk.h"
 #include "column/vectorized_fwd.h"
 #include "exec/parquet/column_reader.h"
 #include "exec/parquet/metadata.h"
+#include "exec/parquet/prefetched_ranges.h"
 #include "exec/vectorized/hdfs_scanner.h"
 #include "gen_cpp/parquet_types.h"
 #include "runtime/descriptors.h"
@@ -17,7 +20,8 @@ class RandomAccessFile;
 
 namespace vectorized {
 struct HdfsScanStats;
-}
+class HdfsIOController;
+} // namespace vectorized
 } // namespace starrocks
 
 namespace starrocks::parquet {
@@ -49,12 +53,21 @@ struct GroupReaderParam {
     std::string timezone;
 
     vectorized::HdfsScanStats* stats = nullptr;
+
+    // Only the rows [first_row, end_row) of the row group are read, the others are known not to match the
+    // conjuncts by the page index. A negative end_row is the end of the row group.
+    int64_t first_row = 0;
+    int64_t end_row = -1;
 };
 
 class GroupReader {
 public:
-    GroupReader(RandomAccessFile* file, FileMetaData* file_metadata, int row_group_number);
-    ~GroupReader() = default;
+    GroupReader(RandomAccessFile* file, const FileMetaData* file_metadata, int row_group_number);
+    ~GroupReader();
+
+    // Read the column chunks of |param| ahead on the io threads of |io_controller|, |param| must be the one
+    // passed to init later. Returns false if they can't be read ahead now, then they are read by init.
+    bool prefetch_async(const GroupReaderParam& param, vectorized::HdfsIOController* io_controller);
 
     Status init(const GroupReaderParam& _param);
     Status get_next(vectorized::ChunkPtr* chunk, size_t* row_count);
@@ -62,6 +75,12 @@ public:
 private:
     using SlotIdExprContextsMap = std::unordered_map<int, std::vector<ExprContext*>>;
 
+    // The ranges of the column chunks of |read_cols|.
+    std::vector<PrefetchedRanges::Range> _column_chunk_ranges(const std::vector<GroupReaderParam::Column>& read_cols);
+    // Read the column chunks of the columns to read by a few large reads, if they are small.
+    Status _prefetch_column_chunks();
+    // Wait for the column chunks read ahead by prefetch_async.
+    Status _wait_prefetch();
     Status _init_column_readers();
     Status _create_column_reader(const GroupReaderParam::Column& column);
     // Extract dict filter columns and conjuncts
@@ -72,15 +91,22 @@ private:
     bool _column_all_pages_dict_encoded(const tparquet::ColumnMetaData& column_metadata);
     Status _rewrite_dict_column_predicates();
     void _init_read_chunk();
+    // Skip the rows before first_row, the column readers start from the pages of first_row if they can.
+    Status _seek_to_first_row();
+    Status _skip_rows(const GroupReaderParam::Column& column, ColumnContentType content_type, size_t num_rows);
 
     Status _read(size_t* row_count);
     void _dict_filter();
+    // Evaluate all the conjuncts on the columns read by _read, and read the lazy columns only for the rows
+    // selected by the conjuncts.
+    Status _filter_and_read_lazy_columns(size_t row_count);
+    Status _read_lazy_column(const GroupReaderParam::Column& column, size_t row_count, size_t hit_count);
     Status _dict_decode(vectorized::ChunkPtr* chunk);
 
     RandomAccessFile* _file;
 
     // parquet file meta
-    FileMetaData* _file_metadata;
+    const FileMetaData* _file_metadata;
 
     // row group number in parquet file
     int _row_group_number;
@@ -88,6 +114,14 @@ private:
     // row group meta
     std::shared_ptr<tparquet::RowGroup> _row_group_metadata;
 
+    // the column chunks read ahead, which must outlive the column readers.
+    PrefetchedRanges _prefetched_ranges;
+    // the result of reading the column chunks ahead on the io threads, invalid if they aren't
+    std::future<Status> _prefetch_future;
+    vectorized::HdfsIOController* _io_controller = nullptr;
+    int64_t _prefetch_bytes = 0;
+    // the stats of reading ahead, merged into the stats of the scanner after that is done
+    vectorized::HdfsScanStats _prefetch_stats;
     // column readers for column chunk in row group
     std::unordered_map<SlotId, std::unique_ptr<ColumnReader>> _column_readers;
     // conjunct ctxs for each dict filter column
@@ -101,12 +135,24 @@ private:
     std::vector<GroupReaderParam::Column> _dict_filter_columns;
     // direct read conlumns
     std::vector<GroupReaderParam::Column> _direct_read_columns;
+    // direct read columns which are read before the conjuncts are evaluated
+    std::vector<GroupReaderParam::Column> _active_columns;
+    // direct read columns without conjuncts which are read after the conjuncts are evaluated, only for the
+    // selected rows. They are the flat scalar columns, empty if late materialization is disabled.
+    std::vector<GroupReaderParam::Column> _lazy_columns;
 
     // dict value is empty after conjunct eval, file group can be skipped
     bool _is_group_filtered = false;
 
+    // the next row of the row group to read
+    int64_t _next_row = 0;
+
     vectorized::ChunkPtr _read_chunk;
     vectorized::Buffer<uint8_t> _selection;
+    // the columns of _read_chunk except the lazy columns, sharing the columns with _read_chunk
+    vectorized::ChunkPtr _active_chunk;
+    // the buffers to read the runs of the selected rows of the lazy columns into
+    std::unordered_map<SlotId, vectorized::ColumnPtr> _lazy_read_columns;
 
     // param for read row group
     GroupReaderParam _param;
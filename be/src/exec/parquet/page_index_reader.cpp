@@ -0,0 +1,49 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/parquet/page_index_reader.h"
+
+#include <memory>
+
+#include "env/env.h"
+#include "exec/vectorized/hdfs_scanner.h"
+#include "util/runtime_profile.h"
+#include "util/thrift_util.h"
+
+namespace starrocks::parquet {
+
+template <typename T>
+static Status read_thrift(RandomAccessFile* file, int64_t offset, int32_t length, vectorized::HdfsScanStats* stats,
+                          T* msg) {
+    if (offset < 0 || length <= 0) {
+        return Status::Corruption("Invalid parquet page index location");
+    }
+    std::unique_ptr<uint8_t[]> buf(new uint8_t[length]);
+    {
+        SCOPED_RAW_TIMER(&stats->io_ns);
+        stats->io_count += 1;
+        RETURN_IF_ERROR(file->read_at(offset, Slice(buf.get(), length)));
+        stats->bytes_read_from_disk += length;
+    }
+    uint32_t len = length;
+    return deserialize_thrift_msg(buf.get(), &len, true, msg);
+}
+
+Status PageIndexReader::read_column_index(RandomAccessFile* file, const tparquet::ColumnChunk& column_chunk,
+                                          vectorized::HdfsScanStats* stats, tparquet::ColumnIndex* column_index) {
+    if (!column_chunk.__isset.column_index_offset || !column_chunk.__isset.column_index_length) {
+        return Status::NotFound("No column index");
+    }
+    return read_thrift(file, column_chunk.column_index_offset, column_chunk.column_index_length, stats,
+                       column_index);
+}
+
+Status PageIndexReader::read_offset_index(RandomAccessFile* file, const tparquet::ColumnChunk& column_chunk,
+                                          vectorized::HdfsScanStats* stats, tparquet::OffsetIndex* offset_index) {
+    if (!column_chunk.__isset.offset_index_offset || !column_chunk.__isset.offset_index_length) {
+        return Status::NotFound("No offset index");
+    }
+    return read_thrift(file, column_chunk.offset_index_offset, column_chunk.offset_index_length, stats,
+                       offset_index);
+}
+
+} // namespace starrocks::parquet
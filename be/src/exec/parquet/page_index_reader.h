@@ -0,0 +1,34 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+
+#include "common/status.h"
+#include "gen_cpp/parquet_types.h"
+
+namespace starrocks {
+class RandomAccessFile;
+
+namespace vectorized {
+struct HdfsScanStats;
+}
+} // namespace starrocks
+
+namespace starrocks::parquet {
+
+// PageIndexReader reads the page index of a column chunk, which is written between the row groups and the footer.
+// The column index has the min/max values of the pages in the column chunk, and the offset index has the offsets
+// and the first rows of them.
+class PageIndexReader {
+public:
+    // Return NotFound if the column chunk has no column index.
+    static Status read_column_index(RandomAccessFile* file, const tparquet::ColumnChunk& column_chunk,
+                                    vectorized::HdfsScanStats* stats, tparquet::ColumnIndex* column_index);
+
+    // Return NotFound if the column chunk has no offset index.
+    static Status read_offset_index(RandomAccessFile* file, const tparquet::ColumnChunk& column_chunk,
+                                    vectorized::HdfsScanStats* stats, tparquet::OffsetIndex* offset_index);
+};
+
+} // namespace starrocks::parquet
@@ -0,0 +1,69 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/parquet/prefetched_ranges.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "env/env.h"
+#include "exec/vectorized/hdfs_scanner.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::parquet {
+
+Status PrefetchedRanges::prefetch(RandomAccessFile* file, std::vector<Range> ranges, uint64_t max_gap_bytes,
+                                  uint64_t max_buffer_bytes, vectorized::HdfsScanStats* stats) {
+    std::sort(ranges.begin(), ranges.end(), [](const Range& l, const Range& r) { return l.offset < r.offset; });
+    std::vector<Range> merged_ranges;
+    for (const Range& range : ranges) {
+        if (range.size == 0) {
+            continue;
+        }
+        if (!merged_ranges.empty()) {
+            Range& last = merged_ranges.back();
+            uint64_t last_end = last.offset + last.size;
+            if (last_end + max_gap_bytes >= range.offset) {
+                last.size = std::max(last_end, range.offset + range.size) - last.offset;
+                continue;
+            }
+        }
+        merged_ranges.push_back(range);
+    }
+
+    uint64_t buffer_bytes = 0;
+    for (const Range& range : merged_ranges) {
+        if (buffer_bytes + range.size > max_buffer_bytes) {
+            continue;
+        }
+        Buffer buffer;
+        buffer.offset = range.offset;
+        buffer.size = range.size;
+        buffer.data.reset(new uint8_t[range.size]);
+        {
+            SCOPED_RAW_TIMER(&stats->io_ns);
+            stats->io_count += 1;
+            RETURN_IF_ERROR(file->read_at(range.offset, Slice(buffer.data.get(), range.size)));
+            stats->bytes_read_from_disk += range.size;
+        }
+        buffer_bytes += range.size;
+        _buffers.emplace_back(std::move(buffer));
+    }
+    return Status::OK();
+}
+
+bool PrefetchedRanges::read(uint64_t offset, uint64_t size, uint8_t* data) const {
+    // The last buffer starting before or at |offset|.
+    auto iter = std::upper_bound(_buffers.begin(), _buffers.end(), offset,
+                                 [](uint64_t offset, const Buffer& buffer) { return offset < buffer.offset; });
+    if (iter == _buffers.begin()) {
+        return false;
+    }
+    --iter;
+    if (offset + size > iter->offset + iter->size) {
+        return false;
+    }
+    memcpy(data, iter->data.get() + (offset - iter->offset), size);
+    return true;
+}
+
+} // namespace starrocks::parquet
@@ -0,0 +1,48 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/status.h"
+
+namespace starrocks {
+class RandomAccessFile;
+
+namespace vectorized {
+struct HdfsScanStats;
+}
+} // namespace starrocks
+
+namespace starrocks::parquet {
+
+// PrefetchedRanges reads the byte ranges of the column chunks in a row group by a few large reads before they
+// are decoded. The ranges are sorted and merged if the gaps between them are not larger than |max_gap_bytes|,
+// then the merged ranges are read in order until |max_buffer_bytes| are buffered, the rest of them are read by
+// the column chunk readers from the file as usual.
+class PrefetchedRanges {
+public:
+    struct Range {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    Status prefetch(RandomAccessFile* file, std::vector<Range> ranges, uint64_t max_gap_bytes,
+                    uint64_t max_buffer_bytes, vectorized::HdfsScanStats* stats);
+
+    // Copy the bytes [offset, offset + size) to |data| and return true, if all of them are prefetched.
+    bool read(uint64_t offset, uint64_t size, uint8_t* data) const;
+
+private:
+    struct Buffer {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        std::unique_ptr<uint8_t[]> data;
+    };
+    // Sorted by the offsets, and not overlapped.
+    std::vector<Buffer> _buffers;
+};
+
+} // namespace starrocks::parquet
@@ -20,6 +20,7 @@ public:
 
         ColumnChunkReaderOptions opts;
         opts.stats = _opts.stats;
+        opts.prefetched_ranges = _opts.prefetched_ranges;
         _reader.reset(new ColumnChunkReader(_field->max_def_level(), _field->max_rep_level(), _field->type_length,
                                             chunk_metadata, file, opts));
         RETURN_IF_ERROR(_reader->init());
@@ -75,6 +76,7 @@ public:
 
         ColumnChunkReaderOptions opts;
         opts.stats = _opts.stats;
+        opts.prefetched_ranges = _opts.prefetched_ranges;
         _reader.reset(new ColumnChunkReader(_field->max_def_level(), _field->max_rep_level(), _field->type_length,
                                             chunk_metadata, file, opts));
         RETURN_IF_ERROR(_reader->init());
@@ -95,6 +97,16 @@ public:
 
     void set_needs_levels(bool needs_levels) { _needs_levels = needs_levels; }
 
+    Status skip_records(size_t num_records) override;
+
+    Status seek_to_page(uint64_t offset) override {
+        RETURN_IF_ERROR(_reader->seek_to_page(offset));
+        _eof = false;
+        _levels_parsed = _levels_decoded = 0;
+        _num_values_left_in_cur_page = _reader->num_values();
+        return Status::OK();
+    }
+
     void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) override {
         // _needs_levels must be true
         DCHECK(_needs_levels);
@@ -106,6 +118,7 @@ public:
 
 private:
     Status _next_page();
+    Status _skip_pages(size_t* num_records);
 
     void _decode_levels(size_t num_levels);
     Status _read_records_only(size_t* num_records, ColumnContentType content_type, vectorized::Column* dst);
@@ -140,6 +153,7 @@ public:
 
         ColumnChunkReaderOptions opts;
         opts.stats = _opts.stats;
+        opts.prefetched_ranges = _opts.prefetched_ranges;
         _reader.reset(new ColumnChunkReader(_field->max_def_level(), _field->max_rep_level(), _field->type_length,
                                             chunk_metadata, file, opts));
         RETURN_IF_ERROR(_reader->init());
@@ -150,14 +164,23 @@ public:
 
     Status read_records(size_t* num_rows, ColumnContentType content_type, vectorized::Column* dst) override;
 
+    Status skip_records(size_t num_records) override;
+
     void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) {
         *def_levels = nullptr;
         *rep_levels = nullptr;
         *num_levels = 0;
     }
 
+    Status seek_to_page(uint64_t offset) override {
+        RETURN_IF_ERROR(_reader->seek_to_page(offset));
+        _num_values_left_in_cur_page = _reader->num_values();
+        return Status::OK();
+    }
+
 private:
     Status _next_page();
+    Status _skip_pages(size_t* num_records);
 
     RandomAccessFile* _file = nullptr;
     // TODO(zc): No need copy
@@ -430,6 +453,64 @@ Status OptionalStoredColumnReader::_read_records_only(size_t* num_records, Colum
     return Status::OK();
 }
 
+Status OptionalStoredColumnReader::skip_records(size_t num_records) {
+    SCOPED_RAW_TIMER(&_opts.stats->column_read_ns);
+    if (_needs_levels) {
+        return Status::NotSupported("skip_records is not supported when levels are needed");
+    }
+    while (num_records > 0) {
+        if (_num_values_left_in_cur_page == 0) {
+            if (_eof) {
+                return Status::EndOfFile("");
+            }
+            SCOPED_RAW_TIMER(&_opts.stats->page_read_ns);
+            auto st = _skip_pages(&num_records);
+            if (!st.ok()) {
+                _eof = st.is_end_of_file();
+                return st;
+            }
+            continue;
+        }
+
+        size_t records_to_skip = std::min(num_records, _num_values_left_in_cur_page);
+        size_t repeated_count = _reader->def_level_decoder().next_repeated_count();
+        if (repeated_count > 0) {
+            records_to_skip = std::min(records_to_skip, repeated_count);
+            level_t def_level = _reader->def_level_decoder().get_repeated_value(records_to_skip);
+            if (def_level >= _field->max_def_level()) {
+                RETURN_IF_ERROR(_reader->skip_values(records_to_skip));
+            }
+        } else {
+            size_t new_capacity = records_to_skip;
+            if (new_capacity > _levels_capacity) {
+                new_capacity = BitUtil::next_power_of_two(new_capacity);
+                _def_levels.resize(new_capacity);
+
+                _levels_capacity = new_capacity;
+            }
+            _reader->decode_def_levels(records_to_skip, &_def_levels[0]);
+
+            size_t num_values = 0;
+            for (size_t i = 0; i < records_to_skip; ++i) {
+                num_values += _def_levels[i] >= _field->max_def_level();
+            }
+            RETURN_IF_ERROR(_reader->skip_values(num_values));
+        }
+
+        _num_values_left_in_cur_page -= records_to_skip;
+        num_records -= records_to_skip;
+    }
+    return Status::OK();
+}
+
+Status OptionalStoredColumnReader::_skip_pages(size_t* num_records) {
+    do {
+        RETURN_IF_ERROR(_reader->skip_pages(num_records));
+        _num_values_left_in_cur_page = _reader->num_values();
+    } while (_num_values_left_in_cur_page == 0 && *num_records > 0);
+    return Status::OK();
+}
+
 Status OptionalStoredColumnReader::_next_page() {
     do {
         RETURN_IF_ERROR(_reader->next_page());
@@ -483,6 +564,28 @@ Status RequiredStoredColumnReader::read_records(size_t* num_records, ColumnConte
     return Status::OK();
 }
 
+Status RequiredStoredColumnReader::skip_records(size_t num_records) {
+    while (num_records > 0) {
+        if (_num_values_left_in_cur_page == 0) {
+            RETURN_IF_ERROR(_skip_pages(&num_records));
+            continue;
+        }
+        size_t records_to_skip = std::min(num_records, _num_values_left_in_cur_page);
+        RETURN_IF_ERROR(_reader->skip_values(records_to_skip));
+        num_records -= records_to_skip;
+        _num_values_left_in_cur_page -= records_to_skip;
+    }
+    return Status::OK();
+}
+
+Status RequiredStoredColumnReader::_skip_pages(size_t* num_records) {
+    do {
+        RETURN_IF_ERROR(_reader->skip_pages(num_records));
+        _num_values_left_in_cur_page = _reader->num_values();
+    } while (_num_values_left_in_cur_page == 0 && *num_records > 0);
+    return Status::OK();
+}
+
 Status RequiredStoredColumnReader::_next_page() {
     do {
         RETURN_IF_ERROR(_reader->next_page());
@@ -23,9 +23,11 @@ class HdfsScanStats;
 namespace starrocks::parquet {
 
 class ColumnChunkReader;
+class PrefetchedRanges;
 
 struct StoredColumnReaderOptions {
     vectorized::HdfsScanStats* stats = nullptr;
+    const PrefetchedRanges* prefetched_ranges = nullptr;
 };
 
 class StoredColumnReader {
@@ -50,10 +52,17 @@ public:
     // this function will fill (1, 2, 3, 4, 5, 6) into 'dst'.
     virtual Status read_records(size_t* num_rows, ColumnContentType content_type, vectorized::Column* dst) = 0;
 
+    // Skip num_rows rows without reading them into a column, the pages of which all the rows are skipped
+    // are not read from the file. Returns EndOfFile if there are not enough rows.
+    virtual Status skip_records(size_t num_rows) { return Status::NotSupported("skip_records is not supported"); }
+
     // This function can only be called after calling read_values. This function returns the
     // levels for last read_values.
     virtual void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) = 0;
 
+    // Continue reading from the data page at |offset| of the file, see ColumnChunkReader::seek_to_page.
+    virtual Status seek_to_page(uint64_t offset) { return Status::NotSupported("seek_to_page is not supported"); }
+
     virtual Status get_dict_values(vectorized::Column* column) { return _reader->get_dict_values(column); }
 
     virtual Status get_dict_values(const std::vector<int32_t>& dict_codes, vectorized::Column* column) {
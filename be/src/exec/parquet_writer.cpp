@@ -25,6 +25,7 @@
 #include <arrow/status.h>
 #include <time.h>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "exec/file_writer.h"
 #include "gen_cpp/FileBrokerService_types.h"
@@ -35,6 +36,8 @@
 #include "runtime/exec_env.h"
 #include "runtime/mem_pool.h"
 #include "runtime/tuple.h"
+#include "runtime/vectorized/chunk_to_arrow.h"
+#include "util/arrow/utils.h"
 #include "util/thrift_util.h"
 
 namespace starrocks {
@@ -64,6 +67,9 @@ arrow::Status ParquetOutputStream::Tell(int64_t* position) const {
 }
 
 arrow::Status ParquetOutputStream::Close() {
+    if (_is_closed) {
+        return arrow::Status::OK();
+    }
     Status st = _file_writer->close();
     if (!st.ok()) {
         return arrow::Status::IOError(st.get_error_msg());
@@ -74,9 +80,14 @@ arrow::Status ParquetOutputStream::Close() {
 
 /// ParquetWriterWrapper
 ParquetWriterWrapper::ParquetWriterWrapper(FileWriter* file_writer, const std::vector<ExprContext*>& output_expr_ctxs)
-        : _output_expr_ctxs(output_expr_ctxs) {
-    // TODO(cmy): implement
-    _outstream = new ParquetOutputStream(file_writer);
+        : _file_writer(file_writer),
+          _outstream(std::make_shared<ParquetOutputStream>(file_writer)),
+          _output_expr_ctxs(output_expr_ctxs) {}
+
+Status ParquetWriterWrapper::init() {
+    RETURN_IF_ERROR(vectorized::convert_to_arrow_schema(_output_expr_ctxs, &_schema));
+    return to_status(parquet::arrow::FileWriter::Open(*_schema, arrow::default_memory_pool(), _outstream,
+                                                      parquet::default_writer_properties(), &_writer));
 }
 
 Status ParquetWriterWrapper::write(const RowBatch& row_batch) {
@@ -84,8 +95,67 @@ Status ParquetWriterWrapper::write(const RowBatch& row_batch) {
     return Status::OK();
 }
 
-void ParquetWriterWrapper::close() {
-    // TODO(cmy): implement
+Status ParquetWriterWrapper::write(vectorized::Chunk* chunk) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    RETURN_IF_ERROR(vectorized::convert_chunk_to_arrow(_output_expr_ctxs, _schema, chunk,
+                                                       arrow::default_memory_pool(), &batch));
+    _buffered_rows += batch->num_rows();
+    _batches.emplace_back(std::move(batch));
+    if (_buffered_rows >= config::export_parquet_row_group_rows) {
+        return _flush_row_group();
+    }
+    return Status::OK();
+}
+
+Status ParquetWriterWrapper::_wait_row_group() {
+    if (_flush_thread.joinable()) {
+        _flush_thread.join();
+    }
+    return _flush_status;
+}
+
+Status ParquetWriterWrapper::_flush_row_group() {
+    RETURN_IF_ERROR(_wait_row_group());
+    if (_batches.empty()) {
+        return Status::OK();
+    }
+    std::shared_ptr<arrow::Table> table;
+    RETURN_IF_ERROR(to_status(arrow::Table::FromRecordBatches(_batches, &table)));
+    _batches.clear();
+    const int64_t num_rows = _buffered_rows;
+    _buffered_rows = 0;
+    _flush_thread = std::thread([this, table = std::move(table), num_rows] {
+        _flush_status = to_status(_writer->WriteTable(*table, num_rows));
+    });
+    return Status::OK();
+}
+
+int64_t ParquetWriterWrapper::written_len() const {
+    int64_t position = 0;
+    (void)_outstream->Tell(&position);
+    return position;
+}
+
+Status ParquetWriterWrapper::close() {
+    if (_closed) {
+        return _flush_status;
+    }
+    _closed = true;
+    Status st = _writer != nullptr ? _flush_row_group() : Status::OK();
+    if (st.ok()) {
+        st = _wait_row_group();
+    } else {
+        _wait_row_group();
+    }
+    if (st.ok() && _writer != nullptr) {
+        st = to_status(_writer->Close());
+    }
+    Status close_st = to_status(_outstream->Close());
+    if (st.ok()) {
+        st = close_st;
+    }
+    _flush_status = st;
+    return st;
 }
 
 ParquetWriterWrapper::~ParquetWriterWrapper() {
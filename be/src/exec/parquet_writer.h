@@ -33,8 +33,11 @@
 #include <parquet/exception.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <map>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/FileBrokerService_types.h"
@@ -47,6 +50,10 @@ class ExprContext;
 class FileWriter;
 class RowBatch;
 
+namespace vectorized {
+class Chunk;
+} // namespace vectorized
+
 class ParquetOutputStream : public arrow::io::OutputStream {
 public:
     ParquetOutputStream(FileWriter* file_writer);
@@ -60,24 +67,54 @@ public:
     bool closed() const override { return _is_closed; }
 
 private:
-    FileWriter* _file_writer; // not owned
-    int64_t _cur_pos = 0;     // current write position
+    FileWriter* _file_writer;          // not owned
+    std::atomic<int64_t> _cur_pos = 0; // current write position
     bool _is_closed = false;
 };
 
 // a wrapper of parquet output stream
+//
+// The chunks are converted into arrow record batches by the caller, and every row group of
+// config::export_parquet_row_group_rows rows is encoded and written into the file by a background thread,
+// in parallel with the conversion of the chunks of the next row group.
 class ParquetWriterWrapper {
 public:
+    // |file_writer| is owned by the ParquetWriterWrapper, and closed by close().
     ParquetWriterWrapper(FileWriter* file_writer, const std::vector<ExprContext*>& output_expr_ctxs);
     virtual ~ParquetWriterWrapper();
 
+    Status init();
+
     Status write(const RowBatch& row_batch);
 
-    void close();
+    Status write(vectorized::Chunk* chunk);
+
+    // the bytes written into the file, except the row group being written in the background.
+    int64_t written_len() const;
+
+    // Write the buffered rows and the footer, and close the file.
+    Status close();
 
 private:
-    ParquetOutputStream* _outstream;
+    // Write the buffered rows as a row group in the background, after the previous one is written.
+    Status _flush_row_group();
+
+    Status _wait_row_group();
+
+    std::unique_ptr<FileWriter> _file_writer;
+    std::shared_ptr<ParquetOutputStream> _outstream;
     const std::vector<ExprContext*>& _output_expr_ctxs;
+    std::shared_ptr<arrow::Schema> _schema;
+    std::unique_ptr<parquet::arrow::FileWriter> _writer;
+
+    // the record batches of the row group not written yet
+    std::vector<std::shared_ptr<arrow::RecordBatch>> _batches;
+    int64_t _buffered_rows = 0;
+
+    // the thread writing the last row group, and its result
+    std::thread _flush_thread;
+    Status _flush_status;
+    bool _closed = false;
 };
 
 } // namespace starrocks
@@ -0,0 +1,70 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "exec/pipeline/observable.h"
+
+namespace starrocks::pipeline {
+
+class AggregateBlockingContext;
+using AggregateBlockingContextPtr = std::shared_ptr<AggregateBlockingContext>;
+
+// AggregateBlockingContext is shared by all the sink and source drivers of one blocking aggregation.
+// Every sink driver aggregates its input into a private partial hash map, and when its input is
+// finished, serializes the hash map into chunks which are hash partitioned by the group by keys,
+// one partition per source driver. After all the sink drivers are finished, the i-th source driver
+// merges and finalizes the i-th partition independently.
+class AggregateBlockingContext {
+public:
+    using Partition = std::vector<vectorized::ChunkPtr>;
+
+    AggregateBlockingContext() = default;
+    ~AggregateBlockingContext() = default;
+
+    // Called by the operator factories when the drivers are created, before any driver runs.
+    void set_num_sinkers(size_t num_sinkers) { _num_sinkers = num_sinkers; }
+    void set_num_partitions(size_t num_partitions) {
+        if (_partitions.size() < num_partitions) {
+            _partitions.resize(num_partitions);
+        }
+    }
+    size_t num_partitions() const { return _partitions.size(); }
+
+    // Called by each sink driver exactly once, partitioned_chunks[i] belongs to the i-th source driver.
+    void finish_sinker(std::vector<Partition>&& partitioned_chunks) {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            for (size_t i = 0; i < partitioned_chunks.size(); ++i) {
+                auto& partition = _partitions[i];
+                partition.insert(partition.end(), std::make_move_iterator(partitioned_chunks[i].begin()),
+                                 std::make_move_iterator(partitioned_chunks[i].end()));
+            }
+        }
+        if (_num_finished_sinkers.fetch_add(1) + 1 == _num_sinkers) {
+            _observable.notify_observers();
+        }
+    }
+
+    bool is_sink_complete() const { return _num_finished_sinkers.load() == _num_sinkers; }
+
+    // Only valid after is_sink_complete() returns true.
+    Partition& partition(size_t i) { return _partitions[i]; }
+
+    void add_observer(const ReadyObserver& observer) { _observable.add_observer(observer); }
+
+private:
+    size_t _num_sinkers = 0;
+    std::atomic<size_t> _num_finished_sinkers{0};
+
+    std::mutex _mutex;
+    std::vector<Partition> _partitions;
+
+    Observable _observable;
+};
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,118 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+#include "util/hash_util.hpp"
+
+namespace starrocks::pipeline {
+
+Status AggregateBlockingSinkOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    RowDescriptor row_desc;
+    RETURN_IF_ERROR(_aggregator->prepare(state, state->obj_pool(), _runtime_profile.get(), get_memtracker(),
+                                         get_memtracker(), row_desc));
+    return _aggregator->open(state);
+}
+
+Status AggregateBlockingSinkOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_aggregator->close(state));
+    return Operator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> AggregateBlockingSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from aggregate blocking sink.");
+}
+
+Status AggregateBlockingSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    size_t chunk_size = chunk->num_rows();
+    DCHECK_LE(chunk_size, config::vector_chunk_size);
+
+    _aggregator->evaluate_exprs(chunk.get());
+
+    SCOPED_TIMER(_aggregator->agg_compute_timer());
+    if (!_aggregator->is_none_group_by_exprs()) {
+        _aggregator->build_hash_map(chunk_size);
+
+        RETURN_IF_ERROR(_aggregator->check_hash_map_memory_usage(state));
+        _aggregator->try_convert_to_two_level_map();
+    }
+    _aggregator->compute_agg_states(chunk_size);
+
+    _aggregator->update_num_input_rows(chunk_size);
+    return Status::OK();
+}
+
+void AggregateBlockingSinkOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+
+    size_t num_partitions = _agg_context->num_partitions();
+    DCHECK_GT(num_partitions, 0);
+    std::vector<AggregateBlockingContext::Partition> partitions(num_partitions);
+    // The partial results are useless once the fragment is cancelled, but the sources still
+    // need to be woken up to exit.
+    if (!state->is_cancelled()) {
+        if (_aggregator->is_none_group_by_exprs()) {
+            // Empty input contributes nothing, so that the merging aggregator could tell whether
+            // the whole input is empty, e.g. sum over empty table is null.
+            if (_aggregator->num_input_rows() > 0) {
+                vectorized::ChunkPtr chunk;
+                _aggregator->convert_to_chunk_no_groupby(&chunk);
+                partitions[0].emplace_back(std::move(chunk));
+            }
+        } else if (_aggregator->hash_map_variant().size() > 0) {
+            COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+            _aggregator->init_hash_map_iterator();
+            while (!_aggregator->is_finished()) {
+                vectorized::ChunkPtr chunk;
+                _aggregator->convert_hash_map_to_chunk(config::vector_chunk_size, &chunk);
+                _partition_chunk(chunk, &partitions);
+            }
+        }
+    }
+    COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
+    _agg_context->finish_sinker(std::move(partitions));
+}
+
+void AggregateBlockingSinkOperator::_partition_chunk(const vectorized::ChunkPtr& chunk,
+                                                     std::vector<AggregateBlockingContext::Partition>* partitions) {
+    uint16_t num_rows = chunk->num_rows();
+    if (num_rows == 0) {
+        return;
+    }
+    size_t num_partitions = partitions->size();
+    if (num_partitions == 1) {
+        (*partitions)[0].emplace_back(chunk);
+        return;
+    }
+
+    const auto& slots = _aggregator->intermediate_tuple_desc()->slots();
+    _hash_values.assign(num_rows, HashUtil::FNV_SEED);
+    for (size_t i = 0; i < _aggregator->group_by_expr_ctxs().size(); ++i) {
+        chunk->get_column_by_slot_id(slots[i]->id())->fvn_hash(&_hash_values[0], 0, num_rows);
+    }
+
+    _partition_row_indexes.resize(num_partitions);
+    for (auto& row_indexes : _partition_row_indexes) {
+        row_indexes.clear();
+    }
+    for (uint32_t i = 0; i < num_rows; ++i) {
+        _partition_row_indexes[_hash_values[i] % num_partitions].emplace_back(i);
+    }
+
+    for (size_t i = 0; i < num_partitions; ++i) {
+        const auto& row_indexes = _partition_row_indexes[i];
+        if (row_indexes.empty()) {
+            continue;
+        }
+        vectorized::ChunkPtr partition_chunk = chunk->clone_empty_with_slot(row_indexes.size());
+        partition_chunk->append_selective(*chunk, row_indexes.data(), 0, row_indexes.size());
+        (*partitions)[i].emplace_back(std::move(partition_chunk));
+    }
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,74 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/aggregate/aggregate_blocking_context.h"
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/aggregate/aggregator.h"
+
+namespace starrocks::pipeline {
+
+// AggregateBlockingSinkOperator consumes all the input of its driver into a partial hash map,
+// and hands over the serialized partial results to AggregateBlockingContext when the input is finished.
+class AggregateBlockingSinkOperator final : public Operator {
+public:
+    AggregateBlockingSinkOperator(int32_t id, int32_t plan_node_id, const TPlanNode& tnode,
+                                  AggregateBlockingContextPtr agg_context)
+            : Operator(id, "aggregate_blocking_sink", plan_node_id),
+              _aggregator(std::make_shared<vectorized::Aggregator>(tnode)),
+              _agg_context(std::move(agg_context)) {
+        _aggregator->set_aggr_phase(vectorized::AggrPhase2);
+        // The partial states are always serialized, the source operators finalize them after merging.
+        _aggregator->set_needs_finalize(false);
+    }
+
+    ~AggregateBlockingSinkOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return false; }
+
+    bool need_input() override { return !is_finished(); }
+
+    bool is_finished() const override { return _is_finished; }
+
+    void finish(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    // Hash partition the serialized chunk by the group by columns, one partition per source driver.
+    void _partition_chunk(const vectorized::ChunkPtr& chunk,
+                          std::vector<AggregateBlockingContext::Partition>* partitions);
+
+    vectorized::AggregatorPtr _aggregator;
+    AggregateBlockingContextPtr _agg_context;
+    bool _is_finished = false;
+
+    std::vector<uint32_t> _hash_values;
+    std::vector<std::vector<uint32_t>> _partition_row_indexes;
+};
+
+class AggregateBlockingSinkOperatorFactory final : public OperatorFactory {
+public:
+    AggregateBlockingSinkOperatorFactory(int32_t id, int32_t plan_node_id, const TPlanNode& tnode,
+                                         AggregateBlockingContextPtr agg_context)
+            : OperatorFactory(id, plan_node_id), _tnode(tnode), _agg_context(std::move(agg_context)) {}
+
+    ~AggregateBlockingSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        _agg_context->set_num_sinkers(driver_instance_count);
+        return std::make_shared<AggregateBlockingSinkOperator>(_id, _plan_node_id, _tnode, _agg_context);
+    }
+
+private:
+    const TPlanNode _tnode;
+    AggregateBlockingContextPtr _agg_context;
+};
+
+} // namespace starrocks::pipeline
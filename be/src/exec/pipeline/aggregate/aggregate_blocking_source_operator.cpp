@@ -0,0 +1,98 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
+
+#include "column/chunk.h"
+#include "exec/exec_node.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status AggregateBlockingSourceOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(SourceOperator::prepare(state));
+    RowDescriptor row_desc;
+    RETURN_IF_ERROR(_aggregator->prepare(state, state->obj_pool(), _runtime_profile.get(), get_memtracker(),
+                                         get_memtracker(), row_desc));
+    RETURN_IF_ERROR(_aggregator->open(state));
+
+    RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), _aggregator->tnode().conjuncts, &_conjunct_ctxs));
+    RETURN_IF_ERROR(Expr::prepare(_conjunct_ctxs, state, row_desc, get_memtracker()));
+    RETURN_IF_ERROR(Expr::open(_conjunct_ctxs, state));
+    return Status::OK();
+}
+
+Status AggregateBlockingSourceOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_aggregator->close(state));
+    Expr::close(_conjunct_ctxs, state);
+    return SourceOperator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> AggregateBlockingSourceOperator::pull_chunk(RuntimeState* state) {
+    if (!_is_merged) {
+        RETURN_IF_ERROR(_merge_partition(state));
+        _is_merged = true;
+        if (_aggregator->is_finished()) {
+            return std::make_shared<vectorized::Chunk>();
+        }
+    }
+
+    vectorized::ChunkPtr chunk;
+    if (_aggregator->is_none_group_by_exprs()) {
+        SCOPED_TIMER(_aggregator->get_results_timer());
+        _aggregator->convert_to_chunk_no_groupby(&chunk);
+    } else {
+        _aggregator->convert_hash_map_to_chunk(config::vector_chunk_size, &chunk);
+    }
+
+    // For having
+    size_t old_size = chunk->num_rows();
+    ExecNode::eval_conjuncts(_conjunct_ctxs, chunk.get());
+    _aggregator->update_num_rows_returned(-static_cast<int64_t>(old_size - chunk->num_rows()));
+
+    _aggregator->process_limit(&chunk);
+
+    DCHECK_CHUNK(chunk);
+    return std::move(chunk);
+}
+
+Status AggregateBlockingSourceOperator::_merge_partition(RuntimeState* state) {
+    auto& partition = _agg_context->partition(_partition_index);
+    for (auto& chunk : partition) {
+        RETURN_IF_CANCELLED(state);
+        size_t chunk_size = chunk->num_rows();
+        _aggregator->evaluate_intermediate_columns(chunk.get());
+
+        SCOPED_TIMER(_aggregator->agg_compute_timer());
+        if (!_aggregator->is_none_group_by_exprs()) {
+            _aggregator->build_hash_map(chunk_size);
+
+            RETURN_IF_ERROR(_aggregator->check_hash_map_memory_usage(state));
+            _aggregator->try_convert_to_two_level_map();
+        }
+        _aggregator->compute_agg_states(chunk_size);
+
+        _aggregator->update_num_input_rows(chunk_size);
+        // Release the partial results as soon as they are merged
+        chunk.reset();
+    }
+    partition.clear();
+
+    if (!_aggregator->is_none_group_by_exprs()) {
+        COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+        // If hash map is empty, we don't need to return value
+        if (_aggregator->hash_map_variant().size() == 0) {
+            _aggregator->set_finished();
+        }
+        _aggregator->init_hash_map_iterator();
+    } else {
+        // The partial results of aggregate without group by all go to the first partition,
+        // the first source driver outputs the only row even if the input is empty.
+        if (_partition_index != 0 || (_aggregator->num_input_rows() == 0 && !_aggregator->needs_finalize())) {
+            _aggregator->set_finished();
+        }
+    }
+    COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
+    return Status::OK();
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,78 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/aggregate/aggregate_blocking_context.h"
+#include "exec/pipeline/source_operator.h"
+#include "exec/vectorized/aggregate/aggregator.h"
+
+namespace starrocks::pipeline {
+
+// AggregateBlockingSourceOperator waits for all the sink drivers to be finished, then merges the
+// serialized partial results of its own partition and outputs the final results.
+class AggregateBlockingSourceOperator final : public SourceOperator {
+public:
+    AggregateBlockingSourceOperator(int32_t id, int32_t plan_node_id, const TPlanNode& tnode,
+                                    AggregateBlockingContextPtr agg_context, size_t partition_index)
+            : SourceOperator(id, "aggregate_blocking_source", plan_node_id),
+              _aggregator(std::make_shared<vectorized::Aggregator>(tnode)),
+              _agg_context(std::move(agg_context)),
+              _partition_index(partition_index) {
+        _aggregator->set_aggr_phase(vectorized::AggrPhase2);
+        _aggregator->set_intermediate_input();
+    }
+
+    ~AggregateBlockingSourceOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return _agg_context->is_sink_complete() && !is_finished(); }
+
+    bool is_finished() const override { return _is_finished || (_is_merged && _aggregator->is_finished()); }
+
+    void finish(RuntimeState* state) override { _is_finished = true; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    bool add_ready_observer(const ReadyObserver& observer) override {
+        _agg_context->add_observer(observer);
+        return true;
+    }
+
+private:
+    // Merge the partial results of the partition into the hash map of this driver.
+    Status _merge_partition(RuntimeState* state);
+
+    vectorized::AggregatorPtr _aggregator;
+    AggregateBlockingContextPtr _agg_context;
+    const size_t _partition_index;
+
+    // Used for having
+    std::vector<ExprContext*> _conjunct_ctxs;
+
+    bool _is_merged = false;
+    bool _is_finished = false;
+};
+
+class AggregateBlockingSourceOperatorFactory final : public OperatorFactory {
+public:
+    AggregateBlockingSourceOperatorFactory(int32_t id, int32_t plan_node_id, const TPlanNode& tnode,
+                                           AggregateBlockingContextPtr agg_context)
+            : OperatorFactory(id, plan_node_id), _tnode(tnode), _agg_context(std::move(agg_context)) {}
+
+    ~AggregateBlockingSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        _agg_context->set_num_partitions(driver_instance_count);
+        return std::make_shared<AggregateBlockingSourceOperator>(_id, _plan_node_id, _tnode, _agg_context,
+                                                                 driver_sequence);
+    }
+
+private:
+    const TPlanNode _tnode;
+    AggregateBlockingContextPtr _agg_context;
+};
+
+} // namespace starrocks::pipeline
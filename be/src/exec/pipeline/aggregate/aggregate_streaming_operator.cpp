@@ -0,0 +1,141 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/aggregate/aggregate_streaming_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+#include "simd/simd.h"
+#include "util/stopwatch.hpp"
+
+namespace starrocks::pipeline {
+
+Status AggregateStreamingOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    RowDescriptor row_desc;
+    RETURN_IF_ERROR(_aggregator->prepare(state, state->obj_pool(), _runtime_profile.get(), get_memtracker(),
+                                         get_memtracker(), row_desc));
+    return _aggregator->open(state);
+}
+
+Status AggregateStreamingOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_aggregator->close(state));
+    return Operator::close(state);
+}
+
+bool AggregateStreamingOperator::has_output() {
+    if (_cur_chunk != nullptr) {
+        return true;
+    }
+    // The hash map is output after all the input is consumed
+    return _is_input_finished && !_aggregator->is_finished() && _aggregator->hash_map_variant().size() > 0;
+}
+
+bool AggregateStreamingOperator::is_finished() const {
+    if (_cur_chunk != nullptr) {
+        return false;
+    }
+    return _aggregator->is_finished() || (_is_input_finished && _aggregator->hash_map_variant().size() == 0);
+}
+
+Status AggregateStreamingOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    size_t chunk_size = chunk->num_rows();
+    _aggregator->update_num_input_rows(chunk_size);
+    COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
+    RETURN_IF_ERROR(_aggregator->check_hash_map_memory_usage(state));
+    _aggregator->evaluate_exprs(chunk.get());
+
+    if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::FORCE_STREAMING) {
+        // force execute streaming
+        SCOPED_TIMER(_aggregator->streaming_timer());
+        _aggregator->output_chunk_by_streaming(&_cur_chunk);
+    } else if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::FORCE_PREAGGREGATION) {
+        _build_hash_map(chunk_size);
+    } else if (_aggregator->is_streaming_passthrough()) {
+        {
+            SCOPED_TIMER(_aggregator->streaming_timer());
+            _aggregator->output_chunk_by_streaming(&_cur_chunk);
+        }
+        _aggregator->update_streaming_passthrough_chunk();
+    } else {
+        const size_t ht_size_before = _aggregator->hash_map_variant().size();
+        size_t num_passed_rows = 0;
+        MonotonicStopWatch watch;
+        watch.start();
+        // TODO: calc the real capacity of hashtable, will add one interface in the class of habletable
+        size_t real_capacity =
+                _aggregator->hash_map_variant().capacity() - _aggregator->hash_map_variant().capacity() / 8;
+        size_t remain_size = real_capacity - _aggregator->hash_map_variant().size();
+        bool ht_needs_expansion = remain_size < chunk_size;
+        if (!ht_needs_expansion ||
+            _aggregator->should_expand_preagg_hash_tables(chunk_size, _aggregator->mem_pool()->total_allocated_bytes(),
+                                                          _aggregator->hash_map_variant().size())) {
+            // hash table is not full or allow expand the hash table according reduction rate
+            _build_hash_map(chunk_size);
+        } else {
+            {
+                SCOPED_TIMER(_aggregator->agg_compute_timer());
+                _aggregator->build_hash_map_with_selection(chunk_size);
+            }
+
+            size_t zero_count = SIMD::count_zero(_aggregator->streaming_selection());
+            num_passed_rows = _aggregator->streaming_selection().size() - zero_count;
+            if (zero_count == 0) {
+                SCOPED_TIMER(_aggregator->streaming_timer());
+                _aggregator->output_chunk_by_streaming(&_cur_chunk);
+            } else if (zero_count == _aggregator->streaming_selection().size()) {
+                SCOPED_TIMER(_aggregator->agg_compute_timer());
+                _aggregator->compute_batch_agg_states(chunk_size);
+            } else {
+                {
+                    SCOPED_TIMER(_aggregator->agg_compute_timer());
+                    _aggregator->compute_batch_agg_states(chunk_size, _aggregator->streaming_selection());
+                }
+                {
+                    SCOPED_TIMER(_aggregator->streaming_timer());
+                    _aggregator->output_chunk_by_streaming(&_cur_chunk, _aggregator->streaming_selection());
+                }
+            }
+            COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+        }
+        const size_t num_new_groups = _aggregator->hash_map_variant().size() - ht_size_before;
+        _aggregator->update_streaming_aggregated_chunk(chunk_size, num_new_groups + num_passed_rows,
+                                                       watch.elapsed_time());
+    }
+
+    if (_cur_chunk != nullptr && _cur_chunk->num_rows() == 0) {
+        _cur_chunk = nullptr;
+    }
+    return Status::OK();
+}
+
+StatusOr<vectorized::ChunkPtr> AggregateStreamingOperator::pull_chunk(RuntimeState* state) {
+    vectorized::ChunkPtr chunk;
+    if (_cur_chunk != nullptr) {
+        chunk = std::move(_cur_chunk);
+        _cur_chunk = nullptr;
+    } else {
+        // The input is finished, and the hash map has data
+        if (!_aggregator->it_hash().has_value()) {
+            _aggregator->init_hash_map_iterator();
+            COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+        }
+        _aggregator->convert_hash_map_to_chunk(config::vector_chunk_size, &chunk);
+    }
+
+    _aggregator->process_limit(&chunk);
+    COUNTER_SET(_aggregator->pass_through_row_count(), _aggregator->num_pass_through_rows());
+
+    DCHECK_CHUNK(chunk);
+    return std::move(chunk);
+}
+
+void AggregateStreamingOperator::_build_hash_map(size_t chunk_size) {
+    SCOPED_TIMER(_aggregator->agg_compute_timer());
+    _aggregator->build_hash_map(chunk_size);
+    _aggregator->compute_agg_states(chunk_size);
+
+    _aggregator->try_convert_to_two_level_map();
+    COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,66 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/aggregate/aggregator.h"
+
+namespace starrocks::pipeline {
+
+// AggregateStreamingOperator is the pre-aggregation of the first phase. Every driver aggregates its
+// own input into a private hash map, and passes through the input chunks directly once the hash map
+// doesn't reduce the rows effectively. The outputs are always serialized partial results, which are
+// merged by the second phase, so the drivers don't need any coordination.
+class AggregateStreamingOperator final : public Operator {
+public:
+    AggregateStreamingOperator(int32_t id, int32_t plan_node_id, const TPlanNode& tnode)
+            : Operator(id, "aggregate_streaming", plan_node_id),
+              _aggregator(std::make_shared<vectorized::Aggregator>(tnode)) {
+        _aggregator->set_aggr_phase(vectorized::AggrPhase1);
+    }
+
+    ~AggregateStreamingOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override;
+
+    bool need_input() override {
+        return !_is_input_finished && _cur_chunk == nullptr && !_aggregator->is_finished();
+    }
+
+    bool is_finished() const override;
+
+    void finish(RuntimeState* state) override { _is_input_finished = true; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    void _build_hash_map(size_t chunk_size);
+
+    vectorized::AggregatorPtr _aggregator;
+    bool _is_input_finished = false;
+    // The chunk passed through by streaming
+    vectorized::ChunkPtr _cur_chunk = nullptr;
+};
+
+class AggregateStreamingOperatorFactory final : public OperatorFactory {
+public:
+    AggregateStreamingOperatorFactory(int32_t id, int32_t plan_node_id, const TPlanNode& tnode)
+            : OperatorFactory(id, plan_node_id), _tnode(tnode) {}
+
+    ~AggregateStreamingOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<AggregateStreamingOperator>(_id, _plan_node_id, _tnode);
+    }
+
+private:
+    const TPlanNode _tnode;
+};
+
+} // namespace starrocks::pipeline
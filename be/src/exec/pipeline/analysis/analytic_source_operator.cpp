@@ -0,0 +1,43 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/analysis/analytic_source_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status AnalyticSourceOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(SourceOperator::prepare(state));
+    // The sorter is only read after all the sink drivers are finished.
+    auto fetcher = [this](RuntimeState* /*state*/, vectorized::ChunkPtr* chunk, bool* eos) -> Status {
+        return _sort_context->chunks_sorters()[_driver_sequence]->get_next(chunk, eos);
+    };
+    _analytor = std::make_shared<vectorized::Analytor>(_tnode, std::move(fetcher));
+    RETURN_IF_ERROR(_analytor->prepare(state, state->obj_pool(), _runtime_profile.get(), get_memtracker(),
+                                       get_memtracker(), _child_row_desc));
+    return _analytor->open(state);
+}
+
+Status AnalyticSourceOperator::close(RuntimeState* state) {
+    if (_analytor != nullptr) {
+        RETURN_IF_ERROR(_analytor->close(state));
+    }
+    _sort_context->unref();
+    return SourceOperator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> AnalyticSourceOperator::pull_chunk(RuntimeState* state) {
+    RETURN_IF_ERROR(_sort_context->status());
+
+    vectorized::ChunkPtr chunk;
+    bool eos = false;
+    RETURN_IF_ERROR(_analytor->get_next(state, &chunk, &eos));
+    if (eos) {
+        _is_finished = true;
+        return std::make_shared<vectorized::Chunk>();
+    }
+    return chunk;
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,78 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/sort/sort_context.h"
+#include "exec/pipeline/source_operator.h"
+#include "exec/vectorized/analytor.h"
+
+namespace starrocks::pipeline {
+
+// AnalyticSourceOperator waits for all the sink drivers of the sort to be finished, and then evaluates the
+// window functions over the rows sorted by the sink driver of the same sequence. The input of the sort is
+// shuffled among the sink drivers by the partition by exprs, so every driver evaluates whole partitions with
+// its own Analytor, see AnalyticNode::decompose_to_pipeline.
+class AnalyticSourceOperator final : public SourceOperator {
+public:
+    AnalyticSourceOperator(int32_t id, int32_t plan_node_id, const TPlanNode& tnode,
+                           const RowDescriptor& child_row_desc, SortContextPtr sort_context, int32_t driver_sequence)
+            : SourceOperator(id, "analytic_source", plan_node_id),
+              _tnode(tnode),
+              _child_row_desc(child_row_desc),
+              _sort_context(std::move(sort_context)),
+              _driver_sequence(driver_sequence) {}
+
+    ~AnalyticSourceOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return !_is_finished && _sort_context->is_partition_sort_finished(); }
+
+    bool is_finished() const override { return _is_finished; }
+
+    void finish(RuntimeState* state) override { _is_finished = true; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    bool add_ready_observer(const ReadyObserver& observer) override {
+        _sort_context->add_observer(observer);
+        return true;
+    }
+
+private:
+    const TPlanNode& _tnode;
+    const RowDescriptor& _child_row_desc;
+    SortContextPtr _sort_context;
+    const int32_t _driver_sequence;
+
+    vectorized::AnalytorPtr _analytor;
+
+    bool _is_finished = false;
+};
+
+class AnalyticSourceOperatorFactory final : public OperatorFactory {
+public:
+    AnalyticSourceOperatorFactory(int32_t id, int32_t plan_node_id, const TPlanNode& tnode,
+                                  const RowDescriptor& child_row_desc, SortContextPtr sort_context)
+            : OperatorFactory(id, plan_node_id),
+              _tnode(tnode),
+              _child_row_desc(child_row_desc),
+              _sort_context(std::move(sort_context)) {}
+
+    ~AnalyticSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        _sort_context->set_num_sources(driver_instance_count);
+        return std::make_shared<AnalyticSourceOperator>(_id, _plan_node_id, _tnode, _child_row_desc, _sort_context,
+                                                        driver_sequence);
+    }
+
+private:
+    const TPlanNode _tnode;
+    const RowDescriptor& _child_row_desc;
+    SortContextPtr _sort_context;
+};
+
+} // namespace starrocks::pipeline
@@ -10,6 +10,7 @@
 #include "util/exclusive_ptr.h"
 
 namespace starrocks {
+class MemTracker;
 class RuntimeState;
 namespace pipeline {
 
@@ -26,8 +27,14 @@ public:
     virtual bool has_next_chunk() = 0;
 
     virtual StatusOr<vectorized::ChunkUniquePtr> get_next_chunk() = 0;
-    virtual void cache_next_chunk_blocking() = 0;
-    virtual StatusOr<vectorized::ChunkUniquePtr> get_next_chunk_nonblocking() = 0;
+
+    // Called by the asynchronous io task, read at most |max_chunks| chunks ahead, and stop earlier once
+    // the read chunks reach |max_bytes| or the memory limit of |mem_tracker| is exceeded, at least one
+    // chunk is read if there are more chunks.
+    virtual void cache_next_chunks_blocking(size_t max_chunks, int64_t max_bytes, MemTracker* mem_tracker) = 0;
+    // Move out the chunks cached by cache_next_chunks_blocking(), and return the status of the chunk source,
+    // which is EndOfFile after all the chunks are read.
+    virtual Status take_cached_chunks(std::vector<vectorized::ChunkPtr>* chunks) = 0;
 
 protected:
     // The morsel will own by pipeline driver
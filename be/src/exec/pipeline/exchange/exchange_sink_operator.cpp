@@ -163,31 +163,34 @@ Status ExchangeSinkOperator::Channel::send_one_chunk(const vectorized::Chunk* ch
         TransmitChunkInfo info = {std::move(request), _brpc_stub};
         _parent->_buffer->add_request(info);
         _current_request_bytes = 0;
-        // The original design is bad, we must release_finst_id here!
-        info.params.release_finst_id();
     }
 
     return Status::OK();
 }
 
 Status ExchangeSinkOperator::Channel::send_chunk_request(PTransmitChunkParams* params, const butil::IOBuf& attachment) {
-    params->set_allocated_finst_id(&_finst_id);
-    params->set_node_id(_dest_node_id);
-    params->set_sender_id(_parent->_sender_id);
-    params->set_be_number(_parent->_be_number);
-
-    params->set_eos(false);
-    TransmitChunkInfo info = {std::move(*params), _brpc_stub};
+    // The chunk data is shared by all the channels through the attachment, so only the meta of
+    // the chunks is copied here.
+    TransmitChunkInfo info = {*params, _brpc_stub, attachment};
+    info.params.set_allocated_finst_id(&_finst_id);
+    info.params.set_node_id(_dest_node_id);
+    info.params.set_sender_id(_parent->_sender_id);
+    info.params.set_be_number(_parent->_be_number);
+    info.params.set_eos(false);
     _parent->_buffer->add_request(info);
-
-    // The original design is bad, we must release_finst_id here!
-    info.params.release_finst_id();
-
     return Status::OK();
 }
 
 Status ExchangeSinkOperator::Channel::_close_internal() {
-    RETURN_IF_ERROR(send_one_chunk(nullptr, true));
+    // For bucket shuffle, the dest is unreachable, there is no need to send eos.
+    if (_fragment_instance_id.lo == -1) {
+        return Status::OK();
+    }
+    if (_chunk != nullptr && _chunk->num_rows() > 0) {
+        RETURN_IF_ERROR(send_one_chunk(_chunk.get(), true));
+    } else {
+        RETURN_IF_ERROR(send_one_chunk(nullptr, true));
+    }
     return Status::OK();
 }
 
@@ -213,6 +216,7 @@ ExchangeSinkOperator::ExchangeSinkOperator(int32_t id, int32_t plan_node_id, con
         if (fragment_id_to_channel_index.find(fragment_instance_id.lo) == fragment_id_to_channel_index.end()) {
             _channels.emplace_back(new Channel(this, destinations[i].brpc_server, fragment_instance_id, dest_node_id));
             fragment_id_to_channel_index.insert({fragment_instance_id.lo, _channels.size() - 1});
+            _buffer->add_sinker(fragment_instance_id);
         } else {
             _channels.emplace_back(_channels[fragment_id_to_channel_index[fragment_instance_id.lo]]);
         }
@@ -292,6 +296,11 @@ bool ExchangeSinkOperator::need_input() {
     return !_is_finished && !_buffer->is_full();
 }
 
+bool ExchangeSinkOperator::add_ready_observer(const ReadyObserver& observer) {
+    _buffer->add_observer(observer);
+    return true;
+}
+
 StatusOr<vectorized::ChunkPtr> ExchangeSinkOperator::pull_chunk(RuntimeState* state) {
     return Status::InternalError("Shouldn't call pull_chunk from exchange sink.");
 }
@@ -314,19 +323,11 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::C
                 DCHECK(_partitions_columns[i] != nullptr);
             }
 
-            if (_part_type == TPartitionType::HASH_PARTITIONED) {
-                _hash_values.assign(num_rows, HashUtil::FNV_SEED);
-                for (const vectorized::ColumnPtr& column : _partitions_columns) {
-                    column->fvn_hash(&_hash_values[0], 0, num_rows);
-                }
-            } else {
-                // The data distribution was calculated using CRC32_HASH,
-                // and bucket shuffle need to use the same hash function when sending data
-                _hash_values.assign(num_rows, 0);
-                for (const vectorized::ColumnPtr& column : _partitions_columns) {
-                    column->crc32_hash(&_hash_values[0], 0, num_rows);
-                }
-            }
+            // The data distribution was calculated using CRC32_HASH,
+            // and bucket shuffle need to use the same hash function when sending data
+            auto function = _part_type == TPartitionType::HASH_PARTITIONED ? vectorized::ChunkHashFunction::FNV
+                                                                           : vectorized::ChunkHashFunction::CRC32;
+            chunk->compute_hash_values(function, _partitions_columns, &_hash_values);
 
             // Compute row indexes for each channel
             _channel_row_idx_start_points.assign(num_channels + 1, 0);
@@ -371,7 +372,7 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::C
         // 3. if request bytes exceede the threshold, send current request
         if (_current_request_bytes > _request_bytes_threshold) {
             butil::IOBuf attachment;
-            // construct_brpc_attachment(&_chunk_request, &attachment);
+            construct_brpc_attachment(&_chunk_request, &attachment);
             for (auto channel : _channels) {
                 RETURN_IF_ERROR(channel->send_chunk_request(&_chunk_request, attachment));
             }
@@ -429,7 +430,7 @@ Status ExchangeSinkOperator::serialize_chunk(const vectorized::Chunk* src, Chunk
 
     dst->set_uncompressed_size(uncompressed_size);
     // try compress the ChunkPB data
-    if (_compress_codec != nullptr && uncompressed_size > 0) {
+    if (_compress_codec != nullptr && uncompressed_size > 0 && _compression_sampler.should_compress()) {
         SCOPED_TIMER(_compress_timer);
 
         // Try compressing data to _compression_scratch, swap if compressed data is smaller
@@ -442,11 +443,13 @@ Status ExchangeSinkOperator::serialize_chunk(const vectorized::Chunk* src, Chunk
         Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
         _compress_codec->compress(dst->data(), &compressed_slice);
         double compress_ratio = (static_cast<double>(uncompressed_size)) / compressed_slice.size;
-        if (LIKELY(compress_ratio > config::rpc_compress_ratio_threshold)) {
+        bool compressible = compress_ratio > config::rpc_compress_ratio_threshold;
+        if (LIKELY(compressible)) {
             _compression_scratch.resize(compressed_slice.size);
             dst->mutable_data()->swap(reinterpret_cast<std::string&>(_compression_scratch));
             dst->set_compress_type(_compress_type);
         }
+        _compression_sampler.update(compressible);
 
         VLOG_ROW << "uncompressed size: " << uncompressed_size << ", compressed size: " << compressed_slice.size;
     }
@@ -468,7 +471,6 @@ void ExchangeSinkOperator::construct_brpc_attachment(PTransmitChunkParams* param
 }
 
 OperatorPtr ExchangeSinkOperatorFactory::create(int32_t driver_instance_count, int32_t driver_sequence) {
-    _buffer->set_sinker_number(driver_instance_count);
     if (_part_type == TPartitionType::UNPARTITIONED || _destinations.size() == 1) {
         return std::make_shared<ExchangeSinkOperator>(_id, _plan_node_id, _buffer, _part_type, _destinations,
                                                       _sender_id, _dest_node_id, _partition_expr_ctxs);
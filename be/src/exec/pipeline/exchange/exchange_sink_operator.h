@@ -10,6 +10,7 @@
 #include "exec/pipeline/operator.h"
 #include "gen_cpp/data.pb.h"
 #include "gen_cpp/internal_service.pb.h"
+#include "util/compression_sampler.h"
 #include "util/raw_container.h"
 #include "util/runtime_profile.h"
 
@@ -48,6 +49,8 @@ public:
 
     Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
 
+    bool add_ready_observer(const ReadyObserver& observer) override;
+
     // For the first chunk , serialize the chunk data and meta to ChunkPB both.
     // For other chunk, only serialize the chunk data to ChunkPB.
     Status serialize_chunk(const vectorized::Chunk* chunk, ChunkPB* dst, bool* is_first_chunk, int num_receivers = 1);
@@ -88,6 +91,8 @@ private:
     // to (we don't compress directly into the ChunkPB in case the compressed data is
     // longer than the uncompressed data).
     raw::RawString _compression_scratch;
+    // Skip compressing the chunks for a while if the latest ones are not compressible.
+    CompressionSampler _compression_sampler;
 
     CompressionTypePB _compress_type = CompressionTypePB::NO_COMPRESSION;
     const BlockCompressionCodec* _compress_codec = nullptr;
@@ -38,6 +38,11 @@ void ExchangeSourceOperator::finish(RuntimeState* state) {
     return _stream_recvr->close();
 }
 
+bool ExchangeSourceOperator::add_ready_observer(const ReadyObserver& observer) {
+    _stream_recvr->add_observer(observer);
+    return true;
+}
+
 StatusOr<vectorized::ChunkPtr> ExchangeSourceOperator::pull_chunk(RuntimeState* state) {
     std::unique_ptr<vectorized::Chunk> chunk = std::make_unique<vectorized::Chunk>();
     RETURN_IF_ERROR(_stream_recvr->get_chunk(&chunk));
@@ -29,6 +29,8 @@ public:
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
 
+    bool add_ready_observer(const ReadyObserver& observer) override;
+
 private:
     int32_t _num_sender;
     const RowDescriptor& _row_desc;
@@ -3,73 +3,92 @@
 #include "exec/pipeline/exchange/local_exchange.h"
 
 #include "column/chunk.h"
+#include "exprs/expr.h"
 #include "exprs/expr_context.h"
+#include "runtime/runtime_state.h"
 
 namespace starrocks::pipeline {
 
 PartitionExchanger::PartitionExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
                                        LocalExchangeSourceOperatorFactory* source, bool is_shuffle,
-                                       const std::vector<ExprContext*>& partition_expr_ctxs)
+                                       const std::vector<ExprContext*>& partition_expr_ctxs,
+                                       const RowDescriptor& row_desc)
         : LocalExchanger(memory_manager),
           _source(source),
           _is_shuffle(is_shuffle),
-          _partition_expr_ctxs(partition_expr_ctxs) {
-    _partitions_columns.resize(partition_expr_ctxs.size());
+          _partition_expr_ctxs(partition_expr_ctxs),
+          _row_desc(row_desc) {}
+
+Status PartitionExchanger::prepare(RuntimeState* state) {
+    // All the sinks are prepared before any driver runs.
+    if (_num_prepared_sinks.fetch_add(1) == 0) {
+        RETURN_IF_ERROR(Expr::prepare(_partition_expr_ctxs, state, _row_desc, state->instance_mem_tracker()));
+        RETURN_IF_ERROR(Expr::open(_partition_expr_ctxs, state));
+    }
+    return Status::OK();
+}
+
+void PartitionExchanger::close(RuntimeState* state) {
+    if (_num_prepared_sinks.fetch_sub(1) == 1) {
+        Expr::close(_partition_expr_ctxs, state);
+    }
 }
 
 Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk) {
-    uint16_t num_rows = chunk->num_rows();
+    size_t num_rows = chunk->num_rows();
     if (num_rows == 0) {
         return Status::OK();
     }
 
-    _memory_manager->update_row_count(chunk->num_rows());
-
     // hash-partition batch's rows across channels
-    int num_channels = _source->get_sources().size();
+    size_t num_channels = _source->get_sources().size();
+    std::vector<uint32_t> hash_values;
+    // This array record the channel start point in row_indexes
+    // And the last item is the number of rows of the current shuffle chunk.
+    // It will easy to get number of rows belong to one channel by doing
+    // channel_row_idx_start_points[i + 1] - channel_row_idx_start_points[i]
+    std::vector<uint32_t> channel_row_idx_start_points;
+    // Record the row indexes for the current shuffle index. Sender will arrange the row indexes
+    // according to channels. For example, if there are 3 channels, this row_indexes will put
+    // channel 0's row first, then channel 1's row indexes, then put channel 2's row indexes in
+    // the last.
+    std::vector<uint32_t> row_indexes(num_rows);
     {
         // SCOPED_TIMER(_shuffle_hash_timer);
-        for (size_t i = 0; i < _partitions_columns.size(); ++i) {
-            _partitions_columns[i] = _partition_expr_ctxs[i]->evaluate(chunk.get());
-            DCHECK(_partitions_columns[i] != nullptr);
+        vectorized::Columns partitions_columns(_partition_expr_ctxs.size());
+        for (size_t i = 0; i < partitions_columns.size(); ++i) {
+            partitions_columns[i] = _partition_expr_ctxs[i]->evaluate(chunk.get());
+            DCHECK(partitions_columns[i] != nullptr);
         }
 
-        if (_is_shuffle) {
-            _hash_values.assign(num_rows, HashUtil::FNV_SEED);
-            for (const vectorized::ColumnPtr& column : _partitions_columns) {
-                column->fvn_hash(&_hash_values[0], 0, num_rows);
-            }
-        } else {
-            // The data distribution was calculated using CRC32_HASH,
-            // and bucket shuffle need to use the same hash function when sending data
-            _hash_values.assign(num_rows, 0);
-            for (const vectorized::ColumnPtr& column : _partitions_columns) {
-                column->crc32_hash(&_hash_values[0], 0, num_rows);
-            }
-        }
+        // The data distribution was calculated using CRC32_HASH,
+        // and bucket shuffle need to use the same hash function when sending data
+        auto function = _is_shuffle ? vectorized::ChunkHashFunction::FNV : vectorized::ChunkHashFunction::CRC32;
+        chunk->compute_hash_values(function, partitions_columns, &hash_values);
 
         // compute row indexes for each channel
-        _channel_row_idx_start_points.assign(num_channels + 1, 0);
-        for (uint16_t i = 0; i < num_rows; ++i) {
-            uint16_t channel_index = _hash_values[i] % num_channels;
-            _channel_row_idx_start_points[channel_index]++;
-            _hash_values[i] = channel_index;
+        channel_row_idx_start_points.assign(num_channels + 1, 0);
+        for (size_t i = 0; i < num_rows; ++i) {
+            uint32_t channel_index = hash_values[i] % num_channels;
+            channel_row_idx_start_points[channel_index]++;
+            hash_values[i] = channel_index;
         }
         // NOTE:
         // we make the last item equal with number of rows of this chunk
-        for (int i = 1; i <= num_channels; ++i) {
-            _channel_row_idx_start_points[i] += _channel_row_idx_start_points[i - 1];
+        for (size_t i = 1; i <= num_channels; ++i) {
+            channel_row_idx_start_points[i] += channel_row_idx_start_points[i - 1];
         }
 
         for (int i = num_rows - 1; i >= 0; --i) {
-            _row_indexes[_channel_row_idx_start_points[_hash_values[i]] - 1] = i;
-            _channel_row_idx_start_points[_hash_values[i]]--;
+            row_indexes[channel_row_idx_start_points[hash_values[i]] - 1] = i;
+            channel_row_idx_start_points[hash_values[i]]--;
         }
     }
 
-    for (int i = 0; i < num_channels; ++i) {
-        size_t from = _channel_row_idx_start_points[i];
-        size_t size = _channel_row_idx_start_points[i + 1] - from;
+    // The rows of each channel are appended into its partial chunk by one append_selective.
+    for (size_t i = 0; i < num_channels; ++i) {
+        size_t from = channel_row_idx_start_points[i];
+        size_t size = channel_row_idx_start_points[i + 1] - from;
         if (size == 0) {
             // no data for this channel continue;
             continue;
@@ -79,26 +98,44 @@ Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk) {
         //     // dest bucket is no used, continue
         //     continue;
         // }
-        RETURN_IF_ERROR(_source->get_sources()[i]->add_chunk(chunk.get(), _row_indexes.data(), from, size));
+        RETURN_IF_ERROR(_source->get_sources()[i]->add_chunk(chunk.get(), row_indexes.data(), from, size));
     }
     return Status::OK();
 }
 
 Status BroadcastExchanger::accept(const vectorized::ChunkPtr& chunk) {
-    _memory_manager->update_row_count(chunk->num_rows());
-    for (auto* buffer : _source->get_sources()) {
-        buffer->add_chunk(chunk);
+    if (chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    for (auto* source : _source->get_sources()) {
+        RETURN_IF_ERROR(source->add_chunk(chunk));
     }
     return Status::OK();
 }
 
 Status PassthroughExchanger::accept(const vectorized::ChunkPtr& chunk) {
-    _memory_manager->update_row_count(chunk->num_rows());
-    _source->get_sources()[0]->add_chunk(chunk);
-    return Status::OK();
+    if (chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    const auto& sources = _source->get_sources();
+    const size_t num_sources = sources.size();
+    // Prefer the next source that isn't full, fall back to the next one if all of them are full.
+    size_t idx = _next_source.fetch_add(1) % num_sources;
+    for (size_t i = 0; i < num_sources; ++i) {
+        size_t candidate = (idx + i) % num_sources;
+        if (!_memory_manager->is_full(sources[candidate]->consumer_index())) {
+            idx = candidate;
+            break;
+        }
+    }
+    return sources[idx]->add_chunk(chunk);
+}
+
+bool PassthroughExchanger::need_input() const {
+    return !_memory_manager->is_all_full();
 }
 
 bool LocalExchanger::need_input() const {
-    return !_memory_manager->is_full();
+    return !_memory_manager->is_any_full();
 }
-} // namespace starrocks::pipeline
\ No newline at end of file
+} // namespace starrocks::pipeline
@@ -8,6 +8,7 @@
 
 namespace starrocks {
 class ExprContext;
+class RowDescriptor;
 class RuntimeState;
 namespace pipeline {
 // Inspire from com.facebook.presto.operator.exchange.LocalExchanger
@@ -17,11 +18,20 @@ public:
     LocalExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager)
             : _memory_manager(memory_manager) {}
 
+    virtual ~LocalExchanger() = default;
+
+    // Called by each sink when it's prepared and closed.
+    virtual Status prepare(RuntimeState* state) { return Status::OK(); }
+    virtual void close(RuntimeState* state) {}
+
     virtual Status accept(const vectorized::ChunkPtr& chunk) = 0;
 
     virtual void finish(RuntimeState* state) = 0;
 
-    bool need_input() const;
+    // Whether the sinks could push more chunks, i.e. none of the sources fed by the next chunk is full.
+    virtual bool need_input() const;
+
+    void add_observer(ReadyObserver observer) { _memory_manager->add_observer(std::move(observer)); }
 
     void increment_sink_number() { _sink_number++; }
 
@@ -37,7 +47,11 @@ class PartitionExchanger final : public LocalExchanger {
 public:
     PartitionExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
                        LocalExchangeSourceOperatorFactory* source, bool is_shuffle,
-                       const std::vector<ExprContext*>& _partition_expr_ctxs);
+                       const std::vector<ExprContext*>& _partition_expr_ctxs, const RowDescriptor& row_desc);
+
+    // The partition exprs are shared by all the sinks, they are prepared by the first sink and closed by the last one.
+    Status prepare(RuntimeState* state) override;
+    void close(RuntimeState* state) override;
 
     Status accept(const vectorized::ChunkPtr& chunk) override;
 
@@ -52,20 +66,11 @@ public:
 private:
     LocalExchangeSourceOperatorFactory* _source;
     bool _is_shuffle = true;
-    std::vector<ExprContext*> _partition_expr_ctxs; // compute per-row partition values
-
-    vectorized::Columns _partitions_columns;
-    std::vector<uint32_t> _hash_values;
-    // This array record the channel start point in _row_indexes
-    // And the last item is the number of rows of the current shuffle chunk.
-    // It will easy to get number of rows belong to one channel by doing
-    // _channel_row_idx_start_points[i + 1] - _channel_row_idx_start_points[i]
-    std::vector<uint16_t> _channel_row_idx_start_points;
-    // Record the row indexes for the current shuffle index. Sender will arrange the row indexes
-    // according to channels. For example, if there are 3 channels, this _row_indexes will put
-    // channel 0's row first, then channel 1's row indexes, then put channel 2's row indexes in
-    // the last.
-    std::vector<uint32_t> _row_indexes;
+    // compute per-row partition values. The sinks call accept() concurrently, so the
+    // per-chunk partition state is kept on the stack of accept() instead of the members.
+    std::vector<ExprContext*> _partition_expr_ctxs;
+    const RowDescriptor& _row_desc;
+    std::atomic<int32_t> _num_prepared_sinks{0};
 };
 
 // Exchange the local data for broadcast
@@ -89,7 +94,8 @@ private:
     LocalExchangeSourceOperatorFactory* _source;
 };
 
-// Exchange the local data for one local source operation
+// Exchange the local data without partitioning, each chunk is passed to one of the sources that isn't full,
+// in a round-robin manner.
 class PassthroughExchanger final : public LocalExchanger {
 public:
     PassthroughExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
@@ -97,14 +103,20 @@ public:
             : LocalExchanger(memory_manager), _source(source) {}
     Status accept(const vectorized::ChunkPtr& chunk) override;
 
+    // Only blocked when all the sources are full.
+    bool need_input() const override;
+
     void finish(RuntimeState* state) override {
         if (decrement_sink_number() == 1) {
-            _source->get_sources()[0]->finish(state);
+            for (auto* source : _source->get_sources()) {
+                source->finish(state);
+            }
         }
     }
 
 private:
     LocalExchangeSourceOperatorFactory* _source;
+    std::atomic<size_t> _next_source{0};
 };
 } // namespace pipeline
 } // namespace starrocks
@@ -3,19 +3,70 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
+
+#include "exec/pipeline/observable.h"
 
 namespace starrocks::pipeline {
-// Manage the memory usage for local exchange
-// TODO(KKS): Should use the real chunk memory usage, not chunk row number
-// Use row number because it's hard to control very big bitmap column memory usage
+// Manage the memory usage for local exchange.
+// Each consumer, i.e. LocalExchangeSourceOperator, accounts the bytes of the chunks buffered in its own
+// queue, and the total budget is divided evenly among the consumers, so a slow consumer only blocks the
+// sinks feeding it, and the peak memory of a wide shuffle is bounded by the total budget.
 class LocalExchangeMemoryManager {
 public:
-    LocalExchangeMemoryManager(int32_t max_row_count) : _max_row_count(max_row_count) {}
-    void update_row_count(int32_t row_count) { _row_count += row_count; }
-    bool is_full() const { return _row_count >= _max_row_count; }
+    explicit LocalExchangeMemoryManager(int64_t max_bytes) : _max_bytes(max_bytes) {}
+
+    // Called when the consumers are created, before any driver runs. Return the index of the new consumer.
+    size_t add_consumer() {
+        _consumers.emplace_back();
+        return _consumers.size() - 1;
+    }
+    size_t num_consumers() const { return _consumers.size(); }
+
+    void update_memory_usage(size_t consumer, int64_t delta) {
+        int64_t old_bytes = _consumers[consumer].bytes.fetch_add(delta);
+        // the sinks blocked on the full consumer are woken up once it's not full any more.
+        const int64_t max_bytes = _max_bytes_per_consumer();
+        if (old_bytes >= max_bytes && old_bytes + delta < max_bytes) {
+            _observable.notify_observers();
+        }
+    }
+
+    int64_t memory_usage(size_t consumer) const { return _consumers[consumer].bytes; }
+    bool is_full(size_t consumer) const { return _consumers[consumer].bytes >= _max_bytes_per_consumer(); }
+
+    bool is_any_full() const {
+        for (size_t i = 0; i < _consumers.size(); ++i) {
+            if (is_full(i)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool is_all_full() const {
+        for (size_t i = 0; i < _consumers.size(); ++i) {
+            if (!is_full(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void add_observer(ReadyObserver observer) { _observable.add_observer(std::move(observer)); }
 
 private:
-    int32_t _max_row_count;
-    std::atomic<int32_t> _row_count{0};
+    struct Consumer {
+        std::atomic<int64_t> bytes{0};
+    };
+
+    int64_t _max_bytes_per_consumer() const {
+        return _consumers.empty() ? _max_bytes : _max_bytes / static_cast<int64_t>(_consumers.size());
+    }
+
+    const int64_t _max_bytes;
+    // std::deque keeps the references of the elements valid on emplace_back.
+    std::deque<Consumer> _consumers;
+    Observable _observable;
 };
-} // namespace starrocks::pipeline
\ No newline at end of file
+} // namespace starrocks::pipeline
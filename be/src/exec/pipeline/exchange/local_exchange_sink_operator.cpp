@@ -8,8 +8,13 @@
 namespace starrocks::pipeline {
 Status LocalExchangeSinkOperator::prepare(RuntimeState* state) {
     _exchanger->increment_sink_number();
-    Operator::prepare(state);
-    return Status::OK();
+    RETURN_IF_ERROR(Operator::prepare(state));
+    return _exchanger->prepare(state);
+}
+
+Status LocalExchangeSinkOperator::close(RuntimeState* state) {
+    _exchanger->close(state);
+    return Operator::close(state);
 }
 
 bool LocalExchangeSinkOperator::need_input() {
@@ -26,8 +31,7 @@ void LocalExchangeSinkOperator::finish(RuntimeState* state) {
 }
 
 Status LocalExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
-    _exchanger->accept(std::move(chunk));
-    return Status::OK();
+    return _exchanger->accept(chunk);
 }
 
 } // namespace starrocks::pipeline
@@ -15,6 +15,8 @@ public:
 
     Status prepare(RuntimeState* state) override;
 
+    Status close(RuntimeState* state) override;
+
     bool has_output() override { return false; }
 
     bool need_input() override;
@@ -27,6 +29,11 @@ public:
 
     Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
 
+    bool add_ready_observer(const ReadyObserver& observer) override {
+        _exchanger->add_observer(observer);
+        return true;
+    }
+
 private:
     bool _is_finished = false;
     const std::shared_ptr<LocalExchanger>& _exchanger;
@@ -8,49 +8,72 @@
 namespace starrocks::pipeline {
 
 Status LocalExchangeSourceOperator::add_chunk(vectorized::ChunkPtr chunk) {
-    std::lock_guard<std::mutex> l(_chunk_lock);
-    if (_full_chunk == nullptr) {
-        _full_chunk = std::move(chunk);
-    } else {
-        vectorized::Columns& dest_columns = _full_chunk->columns();
-        vectorized::Columns& src_columns = chunk->columns();
-        size_t num_rows = chunk->num_rows();
-        for (size_t i = 0; i < dest_columns.size(); i++) {
-            dest_columns[i]->append(*src_columns[i], 0, num_rows);
-        }
+    _memory_manager->update_memory_usage(_consumer_index, static_cast<int64_t>(chunk->memory_usage()));
+    {
+        std::lock_guard<std::mutex> l(_chunk_lock);
+        _full_chunks.emplace(std::move(chunk));
     }
+    _observable.notify_observers();
     return Status::OK();
 }
 
 Status LocalExchangeSourceOperator::add_chunk(vectorized::Chunk* chunk, const uint32_t* indexes, uint32_t from,
                                               uint32_t size) {
-    std::lock_guard<std::mutex> l(_chunk_lock);
-    if (_partial_chunk == nullptr) {
-        _partial_chunk = chunk->clone_empty_with_slot();
-    }
+    bool has_full_chunk = false;
+    {
+        std::lock_guard<std::mutex> l(_chunk_lock);
+        if (_partial_chunk == nullptr) {
+            _partial_chunk = chunk->clone_empty_with_slot();
+        }
 
-    if (_partial_chunk->num_rows() + size > config::vector_chunk_size) {
-        _full_chunk = std::move(_partial_chunk);
-    }
+        const auto old_memory_usage = static_cast<int64_t>(_partial_chunk->memory_usage());
+        _partial_chunk->append_selective(*chunk, indexes, from, size);
+        const auto new_memory_usage = static_cast<int64_t>(_partial_chunk->memory_usage());
+        _memory_manager->update_memory_usage(_consumer_index, new_memory_usage - old_memory_usage);
 
-    _partial_chunk->append_selective(*chunk, indexes, from, size);
+        if (_partial_chunk->num_rows() >= config::vector_chunk_size) {
+            _full_chunks.emplace(std::move(_partial_chunk));
+            has_full_chunk = true;
+        }
+    }
+    if (has_full_chunk) {
+        _observable.notify_observers();
+    }
     return Status::OK();
 }
 
+void LocalExchangeSourceOperator::finish(RuntimeState* state) {
+    {
+        std::lock_guard<std::mutex> l(_chunk_lock);
+        if (_partial_chunk != nullptr && _partial_chunk->num_rows() > 0) {
+            _full_chunks.emplace(std::move(_partial_chunk));
+        }
+        _partial_chunk = nullptr;
+        _is_finished = true;
+    }
+    _observable.notify_observers();
+}
+
 bool LocalExchangeSourceOperator::is_finished() const {
     std::lock_guard<std::mutex> l(_chunk_lock);
-    return _is_finished && _full_chunk == nullptr;
+    return _is_finished && _full_chunks.empty();
 }
 
 bool LocalExchangeSourceOperator::has_output() {
     std::lock_guard<std::mutex> l(_chunk_lock);
-    return _full_chunk != nullptr;
+    return !_full_chunks.empty();
 }
 
 StatusOr<vectorized::ChunkPtr> LocalExchangeSourceOperator::pull_chunk(RuntimeState* state) {
-    std::lock_guard<std::mutex> l(_chunk_lock);
-    _memory_manager->update_row_count(-_full_chunk->num_rows());
-    return std::move(_full_chunk);
+    vectorized::ChunkPtr chunk;
+    {
+        std::lock_guard<std::mutex> l(_chunk_lock);
+        DCHECK(!_full_chunks.empty());
+        chunk = std::move(_full_chunks.front());
+        _full_chunks.pop();
+    }
+    _memory_manager->update_memory_usage(_consumer_index, -static_cast<int64_t>(chunk->memory_usage()));
+    return std::move(chunk);
 }
 
 } // namespace starrocks::pipeline
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <mutex>
+#include <queue>
 
 #include "exec/pipeline/exchange/local_exchange_memory_manager.h"
 #include "exec/pipeline/source_operator.h"
@@ -10,28 +11,43 @@
 namespace starrocks::pipeline {
 class LocalExchangeSourceOperator final : public SourceOperator {
 public:
-    LocalExchangeSourceOperator(int32_t id, const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager)
-            : SourceOperator(id, "local_exchange_source", -1), _memory_manager(memory_manager) {}
+    LocalExchangeSourceOperator(int32_t id, const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
+                                size_t consumer_index)
+            : SourceOperator(id, "local_exchange_source", -1),
+              _memory_manager(memory_manager),
+              _consumer_index(consumer_index) {}
 
+    // The chunk may be shared by multiple sources, e.g. broadcast, so it's never modified.
     Status add_chunk(vectorized::ChunkPtr chunk);
 
+    // Append the selected rows of |chunk| into the partial chunk, which is moved into the queue once full.
     Status add_chunk(vectorized::Chunk* chunk, const uint32_t* indexes, uint32_t from, uint32_t size);
 
     bool has_output() override;
 
     bool is_finished() const override;
 
-    void finish(RuntimeState* state) override { _is_finished = true; }
+    // Called by the exchanger after all the sinks are finished.
+    void finish(RuntimeState* state) override;
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
 
+    bool add_ready_observer(const ReadyObserver& observer) override {
+        _observable.add_observer(observer);
+        return true;
+    }
+
+    size_t consumer_index() const { return _consumer_index; }
+
 private:
     std::atomic<bool> _is_finished{false};
-    vectorized::ChunkPtr _full_chunk = nullptr;
+    std::queue<vectorized::ChunkPtr> _full_chunks;
     vectorized::ChunkUniquePtr _partial_chunk = nullptr;
     // TODO(KKS): make it lock free
     mutable std::mutex _chunk_lock;
     const std::shared_ptr<LocalExchangeMemoryManager>& _memory_manager;
+    const size_t _consumer_index;
+    Observable _observable;
 };
 
 class LocalExchangeSourceOperatorFactory final : public OperatorFactory {
@@ -43,7 +59,7 @@ public:
 
     OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
         std::shared_ptr<LocalExchangeSourceOperator> source =
-                std::make_shared<LocalExchangeSourceOperator>(_id, _memory_manager);
+                std::make_shared<LocalExchangeSourceOperator>(_id, _memory_manager, _memory_manager->add_consumer());
         _sources.emplace_back(source.get());
         return source;
     }
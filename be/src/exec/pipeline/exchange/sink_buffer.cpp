@@ -0,0 +1,183 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/exchange/sink_buffer.h"
+
+#include "common/config.h"
+
+namespace starrocks::pipeline {
+
+SinkBuffer::SinkBuffer(const std::vector<TPlanFragmentDestination>& destinations, int32_t brpc_timeout_ms)
+        : _brpc_timeout_ms(brpc_timeout_ms) {
+    for (const auto& destination : destinations) {
+        const auto& fragment_instance_id = destination.fragment_instance_id;
+        // For bucket shuffle, the dest is unreachable.
+        if (fragment_instance_id.lo == -1 || _destinations.count(fragment_instance_id.lo) > 0) {
+            continue;
+        }
+        auto dest = std::make_unique<DestinationContext>();
+        dest->finst_id.set_hi(fragment_instance_id.hi);
+        dest->finst_id.set_lo(fragment_instance_id.lo);
+        _destinations.emplace(fragment_instance_id.lo, std::move(dest));
+    }
+    _max_pending_requests = std::max<int64_t>(1, _destinations.size()) * config::pipeline_sink_buffer_size;
+}
+
+void SinkBuffer::add_sinker(const TUniqueId& fragment_instance_id) {
+    auto iter = _destinations.find(fragment_instance_id.lo);
+    if (iter == _destinations.end()) {
+        return;
+    }
+    std::lock_guard<std::mutex> l(_mutex);
+    iter->second->num_sinkers++;
+}
+
+void SinkBuffer::add_request(TransmitChunkInfo& request) {
+    DCHECK(request.params.has_finst_id());
+    auto iter = _destinations.find(request.params.finst_id().lo());
+    request.params.release_finst_id();
+    DCHECK(iter != _destinations.end());
+    if (iter == _destinations.end() || _is_cancelled) {
+        return;
+    }
+
+    // Move the chunk data to the attachment, so that the requests could be merged without copying the data.
+    if (request.attachment.empty()) {
+        for (auto& chunk : *request.params.mutable_chunks()) {
+            chunk.set_data_size(chunk.data().size());
+            request.attachment.append(chunk.data());
+            chunk.clear_data();
+        }
+    }
+
+    DestinationContext* dest = iter->second.get();
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (dest->brpc_stub == nullptr) {
+            _destinations_by_stub[request.brpc_stub].push_back(dest);
+        }
+        dest->brpc_stub = request.brpc_stub;
+        // Only send eos for the last finished sinker, because the receiver could only receive eos once.
+        if (request.params.eos() && ++dest->num_finished_sinkers < dest->num_sinkers) {
+            if (request.params.chunks_size() == 0) {
+                return;
+            }
+            request.params.set_eos(false);
+        }
+        dest->pending_requests.emplace_back(std::move(request));
+        _num_pending_requests++;
+    }
+    _try_send_rpc(dest);
+}
+
+size_t SinkBuffer::_merge_pending_requests(DestinationContext* dest, PTransmitChunkParams* params,
+                                           butil::IOBuf* attachment) {
+    const int64_t max_request_bytes =
+            std::min<int64_t>(config::pipeline_sink_brpc_max_request_bytes, dest->credit_bytes);
+    size_t num_merged = 0;
+    do {
+        auto& request = dest->pending_requests.front();
+        if (num_merged == 0) {
+            params->Swap(&request.params);
+        } else {
+            for (auto& chunk : *request.params.mutable_chunks()) {
+                params->add_chunks()->Swap(&chunk);
+            }
+            params->set_eos(request.params.eos());
+        }
+        attachment->append(request.attachment);
+        dest->pending_requests.pop_front();
+        num_merged++;
+    } while (!params->eos() && !dest->pending_requests.empty() &&
+             static_cast<int64_t>(attachment->size() + dest->pending_requests.front().attachment.size()) <=
+                     max_request_bytes);
+
+    params->mutable_finst_id()->CopyFrom(dest->finst_id);
+    params->set_sequence(dest->sequence++);
+    dest->has_in_flight_rpc = true;
+    return num_merged;
+}
+
+void SinkBuffer::_try_send_rpc(DestinationContext* dest) {
+    std::unique_lock<std::mutex> l(_mutex);
+    if (dest->has_in_flight_rpc || dest->pending_requests.empty()) {
+        return;
+    }
+    if (_is_cancelled) {
+        _num_pending_requests -= dest->pending_requests.size();
+        dest->pending_requests.clear();
+        return;
+    }
+
+    PTransmitChunkParams& params = dest->in_flight_params;
+    butil::IOBuf attachment;
+    size_t num_merged = _merge_pending_requests(dest, &params, &attachment);
+
+    // Batch the pending requests of the idle destinations on the same backend, within the byte budget.
+    params.clear_batched_requests();
+    dest->batched_destinations.clear();
+    if (config::pipeline_sink_batch_destinations_of_backend) {
+        for (DestinationContext* other : _destinations_by_stub[dest->brpc_stub]) {
+            if (other == dest || other->has_in_flight_rpc || other->pending_requests.empty()) {
+                continue;
+            }
+            if (attachment.size() + other->pending_requests.front().attachment.size() >
+                config::pipeline_sink_brpc_max_request_bytes) {
+                continue;
+            }
+            num_merged += _merge_pending_requests(other, params.add_batched_requests(), &attachment);
+            dest->batched_destinations.push_back(other);
+        }
+    }
+
+    _num_pending_requests -= num_merged;
+    _num_in_flight_rpcs++;
+
+    auto* closure = new CallBackClosure<PTransmitChunkResult>();
+    closure->ref();
+    closure->addFailedHandler(
+            [this, dest]() { _on_rpc_finished(dest, Status::InternalError("transmit chunk rpc failed"), -1); });
+    closure->addSuccessHandler([this, dest](const PTransmitChunkResult& result) {
+        _on_rpc_finished(dest, Status(result.status()), result.has_credit_bytes() ? result.credit_bytes() : -1);
+    });
+    closure->cntl.set_timeout_ms(_brpc_timeout_ms);
+    closure->cntl.request_attachment().swap(attachment);
+    auto* brpc_stub = dest->brpc_stub;
+    // The closure may be run in the calling thread, so the lock must be released before sending.
+    l.unlock();
+    brpc_stub->transmit_chunk(&closure->cntl, &params, &closure->result, closure);
+}
+
+void SinkBuffer::_on_rpc_finished(DestinationContext* dest, const Status& status, int64_t credit_bytes) {
+    if (!status.ok()) {
+        _is_cancelled = true;
+        LOG(WARNING) << "transmit chunk rpc failed, " << status.to_string();
+    }
+    std::vector<DestinationContext*> batched_destinations;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        dest->has_in_flight_rpc = false;
+        if (credit_bytes >= 0) {
+            dest->credit_bytes = credit_bytes;
+        }
+        // The response of the batched requests carries the least credit of their receivers.
+        for (DestinationContext* other : dest->batched_destinations) {
+            other->has_in_flight_rpc = false;
+            if (credit_bytes >= 0) {
+                other->credit_bytes = credit_bytes;
+            }
+        }
+        batched_destinations.swap(dest->batched_destinations);
+    }
+    _try_send_rpc(dest);
+    for (DestinationContext* other : batched_destinations) {
+        _try_send_rpc(other);
+    }
+
+    // The buffer may be destroyed once the in-flight rpcs drops to zero, so nothing of it
+    // could be touched after the decrement, except the shared observable.
+    auto observable = _observable;
+    _num_in_flight_rpcs--;
+    observable->notify_observers();
+}
+
+} // namespace starrocks::pipeline
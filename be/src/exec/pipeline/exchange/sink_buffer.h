@@ -2,9 +2,15 @@
 
 #pragma once
 
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "column/chunk.h"
+#include "exec/pipeline/observable.h"
 #include "gen_cpp/BackendService.h"
-#include "util/blocking_queue.hpp"
 #include "util/brpc_stub_cache.h"
 #include "util/callback_closure.h"
 
@@ -13,107 +19,83 @@ namespace starrocks::pipeline {
 struct TransmitChunkInfo {
     PTransmitChunkParams params;
     PBackendService_Stub* brpc_stub;
+    // The data of the chunks in |params|, the chunks only keep their meta and data_size.
+    butil::IOBuf attachment;
 };
 
+// SinkBuffer is shared by all the ExchangeSinkOperators of a fragment instance, it sends the requests
+// to the destinations without any dedicated thread. Each destination has at most one in-flight rpc,
+// so the requests of a destination are received in order. The requests pending on a destination are
+// merged into one rpc up to a byte budget, when the in-flight rpc completes, the next one is sent by the
+// brpc completion callback. The pending requests of the idle destinations on the same backend are batched
+// into the rpc too, so a backend with many destination instances receives few rpcs. An rpc of a destination
+// carries no more bytes than the credit granted by its receiver in the last response, see PTransmitChunkResult,
+// the rest waits in the buffer, which blocks the sinkers once it's full.
 class SinkBuffer {
 public:
-    SinkBuffer(size_t channel_number) : _closure_size(channel_number) {
-        for (size_t i = 0; i < channel_number; ++i) {
-            auto _chunk_closure = new CallBackClosure<PTransmitChunkResult>();
-            _chunk_closure->ref();
-            _chunk_closure->addFailedHandler([this]() {
-                _in_flight_rpc_num--;
-                _is_cancelled = true;
-                LOG(WARNING) << " transmit chunk rpc failed, ";
-            });
-
-            _chunk_closure->addSuccessHandler([this](const PTransmitChunkResult& result) {
-                _in_flight_rpc_num--;
-                Status status(result.status());
-                if (!status.ok()) {
-                    _is_cancelled = true;
-                    LOG(WARNING) << " transmit chunk rpc failed, ";
-                }
-            });
-            _closures.push_back(_chunk_closure);
-        }
-
-        _thread = std::thread{&SinkBuffer::process, this};
-    }
-
-    ~SinkBuffer() {
-        _pending_chunks.shutdown();
-        _thread.join();
-        for (auto* closure : _closures) {
-            if (closure->unref()) {
-                delete closure;
-            }
-        }
-    }
-
-    void add_request(TransmitChunkInfo request) {
-        _in_flight_rpc_num++;
-        _pending_chunks.put(request);
-    }
-
-    void process() {
-        while (true) {
-            // If the head closure has flight rpc, means all closures are busy
-            if (_closures.front()->has_in_flight_rpc()) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                continue;
-            }
-
-            TransmitChunkInfo info;
-            if (!_pending_chunks.blocking_get(&info)) {
-                break;
-            }
-            _send_rpc(info);
-
-            // The original design is bad, we must release_finst_id here!
-            info.params.release_finst_id();
-        }
-    }
-
-    bool is_full() const { return _in_flight_rpc_num >= _closure_size; }
-
-    bool is_finished() const { return _in_flight_rpc_num == 0 || _is_cancelled; }
+    SinkBuffer(const std::vector<TPlanFragmentDestination>& destinations, int32_t brpc_timeout_ms);
+    ~SinkBuffer() = default;
+
+    // Called by ExchangeSinkOperatorFactory for each destination of each created sinker, only the eos of the
+    // last finished sinker of a destination is sent to it.
+    void add_sinker(const TUniqueId& fragment_instance_id);
+
+    // The finst_id of |request| is borrowed from the channel, it's released here.
+    void add_request(TransmitChunkInfo& request);
+
+    bool is_full() const { return _num_pending_requests >= _max_pending_requests; }
+
+    // All the requests have been sent and responded, or the buffer is cancelled by any failed rpc.
+    bool is_finished() const { return _num_in_flight_rpcs == 0 && (_num_pending_requests == 0 || _is_cancelled); }
 
     bool is_cancelled() const { return _is_cancelled; }
 
-    void set_sinker_number(int64_t sinker_number) { _sinker_number = sinker_number; }
+    // The observers are notified whenever an in-flight rpc completes, so that
+    // ExchangeSinkOperators blocked on the full buffer are woken up.
+    void add_observer(ReadyObserver observer) { _observable->add_observer(std::move(observer)); }
 
 private:
-    void _send_rpc(TransmitChunkInfo& request) {
-        if (request.params.eos()) {
-            // Only send eos for last sinker, because we could only send eos once
-            if (--_sinker_number > 0) {
-                _in_flight_rpc_num--;
-                return;
-            }
-        }
-        request.params.set_sequence(_request_seq);
-        auto* closure = _closures.front();
-        DCHECK(!closure->has_in_flight_rpc());
-        // Move the closure has flight rpc to tail
-        _closures.pop_front();
-        _closures.push_back(closure);
-        closure->ref();
-        closure->cntl.Reset();
-        closure->cntl.set_timeout_ms(500);
-        request.brpc_stub->transmit_chunk(&closure->cntl, &request.params, &closure->result, closure);
-        _request_seq++;
-    }
-
-    // To avoid lock
-    const int32_t _closure_size;
-    int64_t _request_seq = 0;
-    int64_t _sinker_number = 0;
-    std::atomic<int32_t> _in_flight_rpc_num = 0;
+    struct DestinationContext {
+        PUniqueId finst_id;
+        PBackendService_Stub* brpc_stub = nullptr;
+        std::deque<TransmitChunkInfo> pending_requests;
+        bool has_in_flight_rpc = false;
+        int64_t sequence = 0;
+        int32_t num_sinkers = 0;
+        int32_t num_finished_sinkers = 0;
+        // The bytes the next rpc could carry, granted by the receiver.
+        int64_t credit_bytes = std::numeric_limits<int64_t>::max();
+        // The request of the in-flight rpc, which must live until the rpc completes.
+        PTransmitChunkParams in_flight_params;
+        // The other destinations whose requests are batched into the in-flight rpc of this destination.
+        std::vector<DestinationContext*> batched_destinations;
+    };
+
+    // Move the pending requests of |dest| in order to |params| and |attachment|, until the eos or the byte budget
+    // is reached, and mark |dest| in flight. Return the number of the moved requests.
+    size_t _merge_pending_requests(DestinationContext* dest, PTransmitChunkParams* params, butil::IOBuf* attachment);
+
+    // Send the pending requests of |dest| if it has no in-flight rpc.
+    void _try_send_rpc(DestinationContext* dest);
+    // |credit_bytes| is the credit granted by the response, negative if it's not granted.
+    void _on_rpc_finished(DestinationContext* dest, const Status& status, int64_t credit_bytes);
+
+    const int32_t _brpc_timeout_ms;
+    int64_t _max_pending_requests = 0;
+
+    std::mutex _mutex;
+    // fragment_instance_id.lo -> DestinationContext, it's immutable after the construction.
+    std::unordered_map<int64_t, std::unique_ptr<DestinationContext>> _destinations;
+    // The destinations on the same backend, grouped once their brpc stubs are known.
+    std::unordered_map<PBackendService_Stub*, std::vector<DestinationContext*>> _destinations_by_stub;
+
+    // The requests added but not sent yet.
+    std::atomic<int64_t> _num_pending_requests{0};
+    std::atomic<int64_t> _num_in_flight_rpcs{0};
     std::atomic<bool> _is_cancelled{false};
-    std::deque<CallBackClosure<PTransmitChunkResult>*> _closures;
-    std::thread _thread;
-    UnboundedBlockingQueue<TransmitChunkInfo> _pending_chunks;
+    // shared with the completion callbacks, because the buffer may be destroyed once
+    // the number of in-flight rpcs drops to zero, before the observers are notified.
+    std::shared_ptr<Observable> _observable = std::make_shared<Observable>();
 };
 
-} // namespace starrocks::pipeline
\ No newline at end of file
+} // namespace starrocks::pipeline
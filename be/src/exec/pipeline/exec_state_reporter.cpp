@@ -1,6 +1,7 @@
 // This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
 #include "exec/pipeline/exec_state_reporter.h"
 
+#include <thrift/TApplicationException.h>
 #include <thrift/Thrift.h>
 #include <thrift/protocol/TDebugProtocol.h>
 
@@ -54,7 +55,7 @@ TReportExecStatusParams ExecStateReporter::create_report_exec_status_params(Frag
         if (runtime_state->query_options().query_type == TQueryType::LOAD) {
             params.__set_loaded_rows(runtime_state->num_rows_load_total());
         }
-        profile->to_thrift(&params.profile);
+        profile->to_thrift_changed(&params.profile);
         params.__isset.profile = true;
 
         if (!runtime_state->output_files().empty()) {
@@ -102,6 +103,7 @@ TReportExecStatusParams ExecStateReporter::create_report_exec_status_params(Frag
     return params;
 }
 
+using apache::thrift::TApplicationException;
 using apache::thrift::TException;
 using apache::thrift::TProcessor;
 using apache::thrift::transport::TTransportException;
@@ -144,6 +146,104 @@ Status ExecStateReporter::report_exec_status(const TReportExecStatusParams& para
     return rpc_status;
 }
 
+std::vector<Status> ExecStateReporter::batch_report_exec_status(const TBatchReportExecStatusParams& params,
+                                                                ExecEnv* exec_env, const TNetworkAddress& fe_addr) {
+    const auto& params_list = params.params_list;
+    if (params_list.size() > 1) {
+        Status fe_status;
+        FrontendServiceConnection coord(exec_env->frontend_client_cache(), fe_addr, &fe_status);
+        if (!fe_status.ok()) {
+            return std::vector<Status>(params_list.size(), fe_status);
+        }
+
+        TBatchReportExecStatusResult res;
+        Status rpc_status;
+        bool supported = true;
+        try {
+            try {
+                coord->batchReportExecStatus(res, params);
+            } catch (TTransportException& e) {
+                LOG(WARNING) << "Retrying BatchReportExecStatus: " << e.what();
+                rpc_status = coord.reopen();
+                if (!rpc_status.ok()) {
+                    return std::vector<Status>(params_list.size(), rpc_status);
+                }
+                coord->batchReportExecStatus(res, params);
+            }
+        } catch (TApplicationException& e) {
+            if (e.getType() != TApplicationException::UNKNOWN_METHOD) {
+                std::stringstream msg;
+                msg << "BatchReportExecStatus() to " << fe_addr << " failed:\n" << e.what();
+                LOG(WARNING) << msg.str();
+                return std::vector<Status>(params_list.size(), Status::InternalError(msg.str()));
+            }
+            // sent by a FE of an older version.
+            supported = false;
+        } catch (TException& e) {
+            std::stringstream msg;
+            msg << "BatchReportExecStatus() to " << fe_addr << " failed:\n" << e.what();
+            LOG(WARNING) << msg.str();
+            return std::vector<Status>(params_list.size(), Status::InternalError(msg.str()));
+        }
+        if (supported) {
+            std::vector<Status> statuses;
+            statuses.reserve(params_list.size());
+            for (size_t i = 0; i < params_list.size(); ++i) {
+                if (i < res.status_list.size()) {
+                    statuses.emplace_back(res.status_list[i]);
+                } else {
+                    statuses.emplace_back(Status::InternalError("missing the status of the report"));
+                }
+            }
+            return statuses;
+        }
+    }
+
+    std::vector<Status> statuses;
+    statuses.reserve(params_list.size());
+    for (const auto& report_params : params_list) {
+        statuses.emplace_back(report_exec_status(report_params, exec_env, fe_addr));
+    }
+    return statuses;
+}
+
+void ExecStateReporter::_report(ExecEnv* exec_env, const TNetworkAddress& fe_addr, Report report) {
+    {
+        std::lock_guard<std::mutex> l(_pending_lock);
+        auto& pending = _pending_reports[fe_addr];
+        pending.reports.emplace_back(std::move(report));
+        if (pending.sending) {
+            // sent by the thread sending the previous ones.
+            return;
+        }
+        pending.sending = true;
+    }
+
+    while (true) {
+        std::vector<Report> reports;
+        {
+            std::lock_guard<std::mutex> l(_pending_lock);
+            auto& pending = _pending_reports[fe_addr];
+            if (pending.reports.empty()) {
+                pending.sending = false;
+                return;
+            }
+            reports.swap(pending.reports);
+        }
+
+        TBatchReportExecStatusParams params;
+        params.params_list.reserve(reports.size());
+        for (auto& r : reports) {
+            params.params_list.emplace_back(std::move(r.params));
+        }
+        params.__isset.params_list = true;
+        auto statuses = batch_report_exec_status(params, exec_env, fe_addr);
+        for (size_t i = 0; i < reports.size(); ++i) {
+            reports[i].callback(statuses[i]);
+        }
+    }
+}
+
 ExecStateReporter::ExecStateReporter() {
     auto status = ThreadPoolBuilder("exec_state_reporter_thread")
                           .set_min_threads(1)
@@ -159,23 +259,26 @@ ExecStateReporter::ExecStateReporter() {
 void ExecStateReporter::submit(FragmentContext* fragment_ctx, const Status& status, bool done, bool clean) {
     auto report_func = [=]() {
         auto params = create_report_exec_status_params(fragment_ctx, status, done);
-        auto status = report_exec_status(params, fragment_ctx->runtime_state()->exec_env(), fragment_ctx->fe_addr());
-        if (!status.ok()) {
-            LOG(WARNING) << "[Driver] Fail to report exec state: fragment_instance_id="
-                         << fragment_ctx->fragment_instance_id();
-        } else {
-            LOG(INFO) << "[Driver] Succeed to report exec state: fragment_instance_id="
-                      << fragment_ctx->fragment_instance_id();
-        }
-        if (clean) {
-            auto query_id = fragment_ctx->query_id();
-            FragmentContextManager::instance()->unregister(fragment_ctx->fragment_instance_id());
-            auto* query_ctx = QueryContextManager::instance()->get_raw(query_id);
-            DCHECK(query_ctx != nullptr);
-            if (query_ctx->count_down_fragment()) {
-                QueryContextManager::instance()->unregister(query_id);
+        auto callback = [=](const Status& status) {
+            if (!status.ok()) {
+                LOG(WARNING) << "[Driver] Fail to report exec state: fragment_instance_id="
+                             << fragment_ctx->fragment_instance_id();
+            } else {
+                LOG(INFO) << "[Driver] Succeed to report exec state: fragment_instance_id="
+                          << fragment_ctx->fragment_instance_id();
             }
-        }
+            if (clean) {
+                auto query_id = fragment_ctx->query_id();
+                FragmentContextManager::instance()->unregister(fragment_ctx->fragment_instance_id());
+                auto* query_ctx = QueryContextManager::instance()->get_raw(query_id);
+                DCHECK(query_ctx != nullptr);
+                if (query_ctx->count_down_fragment()) {
+                    QueryContextManager::instance()->unregister(query_id);
+                }
+            }
+        };
+        _report(fragment_ctx->runtime_state()->exec_env(), fragment_ctx->fe_addr(),
+                {std::move(params), std::move(callback)});
     };
     _thread_pool->submit_func(report_func);
 }
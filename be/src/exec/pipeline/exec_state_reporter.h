@@ -2,7 +2,11 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/pipeline_fwd.h"
@@ -12,6 +16,7 @@
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
 #include "service/backend_options.h"
+#include "util/hash_util.hpp"
 #include "util/threadpool.h"
 
 namespace starrocks {
@@ -21,11 +26,35 @@ public:
     static TReportExecStatusParams create_report_exec_status_params(FragmentContext* fragment_ctx, const Status& status,
                                                                     bool done);
     static Status report_exec_status(const TReportExecStatusParams& params, ExecEnv* exec_env, TNetworkAddress fe_addr);
+    // Send the reports in one RPC, and return the status of each of them. The reports are sent one by one if the
+    // FE doesn't support the batched ones.
+    static std::vector<Status> batch_report_exec_status(const TBatchReportExecStatusParams& params,
+                                                        ExecEnv* exec_env, const TNetworkAddress& fe_addr);
     ExecStateReporter();
     void submit(FragmentContext* fragment_ctx, const Status& status, bool done, bool clean);
 
 private:
+    struct Report {
+        TReportExecStatusParams params;
+        // called with the status of the report once it's sent.
+        std::function<void(const Status&)> callback;
+    };
+
+    struct PendingReports {
+        std::vector<Report> reports;
+        // whether a thread is sending the reports to the FE.
+        bool sending = false;
+    };
+
+    // Queue |report| to |fe_addr|. The reports to a FE are sent in order by one thread at a time, which sends all
+    // the ones queued while it's sending the previous ones in one RPC, so the reports of the many fragment
+    // instances at a high QPS don't take one RPC each.
+    void _report(ExecEnv* exec_env, const TNetworkAddress& fe_addr, Report report);
+
     std::unique_ptr<ThreadPool> _thread_pool;
+
+    std::mutex _pending_lock;
+    std::unordered_map<TNetworkAddress, PendingReports> _pending_reports;
 };
 } // namespace pipeline
 } // namespace starrocks
\ No newline at end of file
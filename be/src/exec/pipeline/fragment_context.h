@@ -84,6 +84,14 @@ public:
 
     MorselQueueMap& morsel_queues() { return _morsel_queues; }
 
+    // Whether the state transitions of the drivers are recorded by DriverTracer.
+    bool enable_trace() const { return _enable_trace; }
+    void set_enable_trace(bool enable_trace) { _enable_trace = enable_trace; }
+
+    // Whether the hardware events of the operators are counted in their profiles, see PipelineDriver.
+    bool enable_hardware_counters() const { return _enable_hardware_counters; }
+    void set_enable_hardware_counters(bool enable) { _enable_hardware_counters = enable; }
+
 private:
     // Id of this query
     TUniqueId _query_id;
@@ -110,6 +118,8 @@ private:
     std::atomic<size_t> _num_drivers;
     std::atomic<Status*> _final_status;
     std::atomic<bool> _cancel_flag;
+    bool _enable_trace = false;
+    bool _enable_hardware_counters = false;
 };
 class FragmentContextManager {
     DECLARE_SINGLETON(FragmentContextManager);
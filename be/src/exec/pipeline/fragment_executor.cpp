@@ -10,6 +10,7 @@
 #include "exec/pipeline/exchange/sink_buffer.h"
 #include "exec/pipeline/morsel.h"
 #include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/resource_group.h"
 #include "exec/pipeline/result_sink_operator.h"
 #include "exec/pipeline/scan_operator.h"
 #include "exec/scan_node.h"
@@ -17,6 +18,7 @@
 #include "gutil/casts.h"
 #include "gutil/map_util.h"
 #include "runtime/data_stream_sender.h"
+#include "runtime/descriptor_tbl_cache.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/result_sink.h"
@@ -25,12 +27,13 @@
 
 namespace starrocks::pipeline {
 
-Morsels convert_scan_range_to_morsel(const std::vector<TScanRangeParams>& scan_ranges, int node_id) {
-    Morsels morsels;
-    for (auto scan_range : scan_ranges) {
-        morsels.emplace_back(std::make_unique<OlapMorsel>(node_id, scan_range));
+std::vector<Morsels> convert_scan_range_to_morsel(const std::vector<TScanRangeParams>& scan_ranges, int node_id) {
+    std::vector<Morsels> morsel_groups;
+    morsel_groups.reserve(scan_ranges.size());
+    for (const auto& scan_range : scan_ranges) {
+        morsel_groups.emplace_back(OlapMorsel::split(node_id, scan_range, config::pipeline_scan_morsel_split_rows));
     }
-    return morsels;
+    return morsel_groups;
 }
 
 Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParams& request) {
@@ -41,10 +44,20 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
     if (params.__isset.instances_number) {
         _query_ctx->set_num_fragments(params.instances_number);
     }
+    if (request.query_options.__isset.pipeline_resource_group) {
+        _query_ctx->set_resource_group(
+                ResourceGroupManager::instance()->get(request.query_options.pipeline_resource_group));
+    }
     _fragment_ctx = FragmentContextManager::instance()->get_or_register(fragment_id);
     _fragment_ctx->set_query_id(query_id);
     _fragment_ctx->set_fragment_instance_id(fragment_id);
     _fragment_ctx->set_fe_addr(request.coord);
+    if (request.query_options.__isset.enable_pipeline_trace) {
+        _fragment_ctx->set_enable_trace(request.query_options.enable_pipeline_trace);
+    }
+    if (request.query_options.__isset.enable_hardware_counters) {
+        _fragment_ctx->set_enable_hardware_counters(request.query_options.enable_hardware_counters);
+    }
 
     LOG(INFO) << "Prepare(): query_id=" << print_id(query_id)
               << " fragment_instance_id=" << print_id(params.fragment_instance_id)
@@ -71,8 +84,7 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
     auto* obj_pool = runtime_state->obj_pool();
     DescriptorTbl* desc_tbl = NULL;
     DCHECK(request.__isset.desc_tbl);
-    RETURN_IF_ERROR(DescriptorTbl::create(obj_pool, request.desc_tbl, &desc_tbl));
-    runtime_state->set_desc_tbl(desc_tbl);
+    RETURN_IF_ERROR(DescriptorTblCache::create(runtime_state, request.desc_tbl, &desc_tbl));
     // Set up plan
     ExecNode* plan = nullptr;
     DCHECK(request.__isset.fragment);
@@ -126,8 +138,8 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
         ScanNode* scan_node = down_cast<ScanNode*>(scan_nodes[i]);
         const std::vector<TScanRangeParams>& scan_ranges =
                 FindWithDefault(params.per_node_scan_ranges, scan_node->id(), no_scan_ranges);
-        Morsels morsels = convert_scan_range_to_morsel(scan_ranges, scan_node->id());
-        morsel_queues.emplace(scan_node->id(), std::make_unique<MorselQueue>(std::move(morsels)));
+        std::vector<Morsels> morsel_groups = convert_scan_range_to_morsel(scan_ranges, scan_node->id());
+        morsel_queues.emplace(scan_node->id(), std::make_unique<MorselQueue>(std::move(morsel_groups)));
     }
 
     Drivers drivers;
@@ -202,7 +214,9 @@ void FragmentExecutor::_convert_data_sink_to_operator(const TPlanFragmentExecPar
         _fragment_ctx->pipelines().back()->add_op_factory(op);
     } else if (typeid(*datasink) == typeid(starrocks::DataStreamSender)) {
         starrocks::DataStreamSender* sender = down_cast<starrocks::DataStreamSender*>(datasink);
-        std::shared_ptr<SinkBuffer> sink_buffer = std::make_shared<SinkBuffer>(sender->get_destinations_size());
+        const auto& query_options = _fragment_ctx->runtime_state()->query_options();
+        const int32_t brpc_timeout_ms = std::min(3600, query_options.query_timeout) * 1000;
+        std::shared_ptr<SinkBuffer> sink_buffer = std::make_shared<SinkBuffer>(params.destinations, brpc_timeout_ms);
 
         OpFactoryPtr exchange_sink = std::make_shared<ExchangeSinkOperatorFactory>(
                 context->next_operator_id(), -1, sink_buffer, sender->get_partition_type(), params.destinations,
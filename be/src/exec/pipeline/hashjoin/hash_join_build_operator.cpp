@@ -0,0 +1,44 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/hashjoin/hash_join_build_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status HashJoinBuildOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    return _join_context->prepare_builder(state, _runtime_profile.get(), get_memtracker());
+}
+
+Status HashJoinBuildOperator::close(RuntimeState* state) {
+    _join_context->unref(state);
+    return Operator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> HashJoinBuildOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from hash join build.");
+}
+
+Status HashJoinBuildOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    return _join_context->append_chunk_to_ht(state, chunk);
+}
+
+void HashJoinBuildOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+
+    if (_join_context->finish_builder()) {
+        // The probe drivers still need to be woken up to exit once the fragment is cancelled.
+        if (state->is_cancelled()) {
+            _join_context->set_build_status(Status::Cancelled("Cancelled before building hash table"));
+        } else {
+            _join_context->build_hash_table(state);
+        }
+    }
+}
+
+} // namespace starrocks::pipeline
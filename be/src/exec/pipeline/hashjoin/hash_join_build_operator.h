@@ -0,0 +1,56 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/hashjoin/hash_join_context.h"
+#include "exec/pipeline/operator.h"
+
+namespace starrocks::pipeline {
+
+// HashJoinBuildOperator appends the build input of its driver into the shared hash table,
+// and the last finished one builds the hash table for all the probe drivers.
+class HashJoinBuildOperator final : public Operator {
+public:
+    HashJoinBuildOperator(int32_t id, int32_t plan_node_id, HashJoinContextPtr join_context)
+            : Operator(id, "hash_join_build", plan_node_id), _join_context(std::move(join_context)) {}
+
+    ~HashJoinBuildOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return false; }
+
+    bool need_input() override { return !is_finished(); }
+
+    bool is_finished() const override { return _is_finished; }
+
+    void finish(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    HashJoinContextPtr _join_context;
+    bool _is_finished = false;
+};
+
+class HashJoinBuildOperatorFactory final : public OperatorFactory {
+public:
+    HashJoinBuildOperatorFactory(int32_t id, int32_t plan_node_id, HashJoinContextPtr join_context)
+            : OperatorFactory(id, plan_node_id), _join_context(std::move(join_context)) {}
+
+    ~HashJoinBuildOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        _join_context->set_num_builders(driver_instance_count);
+        return std::make_shared<HashJoinBuildOperator>(_id, _plan_node_id, _join_context);
+    }
+
+private:
+    HashJoinContextPtr _join_context;
+};
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,80 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/hashjoin/hash_join_context.h"
+
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status HashJoinContext::prepare_builder(RuntimeState* state, RuntimeProfile* runtime_profile,
+                                        MemTracker* mem_tracker) {
+    std::lock_guard<std::mutex> l(_mutex);
+    if (_is_builder_prepared) {
+        return Status::OK();
+    }
+    _is_builder_prepared = true;
+    return _builder->prepare(state, runtime_profile, mem_tracker);
+}
+
+Status HashJoinContext::append_chunk_to_ht(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    std::lock_guard<std::mutex> l(_mutex);
+    return _builder->append_chunk_to_ht(state, chunk);
+}
+
+void HashJoinContext::build_hash_table(RuntimeState* state) {
+    Status status = _builder->build_ht(state);
+    // it's quite critical to publish runtime filters even if the hash table is empty, because the
+    // merge node of global runtime filters is waiting for all the partitioned runtime filters.
+    if (status.ok()) {
+        status = _builder->publish_runtime_filters(state);
+    }
+    _is_probe_short_circuited = status.ok() && _builder->is_probe_short_circuited();
+    set_build_status(status);
+}
+
+void HashJoinContext::build_empty_hash_table(RuntimeState* state, RuntimeProfile* runtime_profile,
+                                             MemTracker* mem_tracker) {
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_is_builder_prepared) {
+            return;
+        }
+        _is_builder_prepared = true;
+        Status status = _builder->prepare(state, runtime_profile, mem_tracker);
+        if (!status.ok()) {
+            _build_status = status;
+            _is_build_ready.store(true, std::memory_order_release);
+            return;
+        }
+    }
+    build_hash_table(state);
+}
+
+void HashJoinContext::set_build_status(const Status& status) {
+    _build_status = status;
+    _is_build_ready.store(true, std::memory_order_release);
+    _observable.notify_observers();
+}
+
+bool HashJoinContext::finish_prober(const Buffer<uint8_t>& build_match_index) {
+    std::lock_guard<std::mutex> l(_mutex);
+    if (_build_match_index.empty()) {
+        _build_match_index = build_match_index;
+    } else {
+        DCHECK_EQ(_build_match_index.size(), build_match_index.size());
+        for (size_t i = 0; i < build_match_index.size(); ++i) {
+            _build_match_index[i] |= build_match_index[i];
+        }
+    }
+    return ++_num_finished_probers == _num_probers;
+}
+
+void HashJoinContext::unref(RuntimeState* state) {
+    if (_num_closed.fetch_add(1) + 1 == _num_builders + _num_probers) {
+        _builder->close(state);
+        // release the memory of the hash table before the mem trackers of the operators are destroyed.
+        _builder.reset();
+    }
+}
+
+} // namespace starrocks::pipeline
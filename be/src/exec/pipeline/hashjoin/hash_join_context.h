@@ -0,0 +1,82 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "exec/pipeline/observable.h"
+#include "exec/vectorized/hash_joiner.h"
+
+namespace starrocks::pipeline {
+
+class HashJoinContext;
+using HashJoinContextPtr = std::shared_ptr<HashJoinContext>;
+
+// HashJoinContext is shared by all the build and probe drivers of one hash join.
+// The build drivers append their input into the hash table of one shared HashJoiner, and the last
+// finished build driver builds the hash table and publishes the runtime filters. Then every probe
+// driver probes the hash table read-only with the probe state of its own HashJoiner. For right
+// outer/semi/anti and full outer join, the last finished probe driver outputs the build rows
+// according to the matched build rows of all the probe drivers.
+class HashJoinContext {
+public:
+    explicit HashJoinContext(vectorized::HashJoinerPtr builder) : _builder(std::move(builder)) {}
+    ~HashJoinContext() = default;
+
+    // Called by the operator factories when the drivers are created, before any driver runs.
+    void set_num_builders(size_t num_builders) { _num_builders = num_builders; }
+    void set_num_probers(size_t num_probers) { _num_probers = num_probers; }
+    size_t num_builders() const { return _num_builders; }
+
+    // For the build drivers, prepare_builder() could be called multiple times, only the first one takes effect.
+    Status prepare_builder(RuntimeState* state, RuntimeProfile* runtime_profile, MemTracker* mem_tracker);
+    Status append_chunk_to_ht(RuntimeState* state, const vectorized::ChunkPtr& chunk);
+    // Return true if it's the last finished build driver, which should call build_hash_table() then.
+    bool finish_builder() { return _num_finished_builders.fetch_add(1) + 1 == _num_builders; }
+    // Build the hash table and wake up the probe drivers, the probe drivers fail with the status if it's not ok.
+    void build_hash_table(RuntimeState* state);
+    // Used when there is no build driver at all, e.g. the build side scans nothing. It builds an empty
+    // hash table, only the first call takes effect.
+    void build_empty_hash_table(RuntimeState* state, RuntimeProfile* runtime_profile, MemTracker* mem_tracker);
+    void set_build_status(const Status& status);
+
+    // For the probe drivers.
+    bool is_build_ready() const { return _is_build_ready.load(std::memory_order_acquire); }
+    // Only valid after is_build_ready() returns true.
+    const Status& build_status() const { return _build_status; }
+    // Whether the probe drivers output nothing, see HashJoiner::is_probe_short_circuited().
+    bool is_probe_short_circuited() const { return _is_probe_short_circuited; }
+    vectorized::HashJoiner* builder() const { return _builder.get(); }
+    void add_observer(const ReadyObserver& observer) { _observable.add_observer(observer); }
+    // Called by each probe driver exactly once with the build rows matched by it, return true
+    // if it's the last finished probe driver, which should output the remaining build rows.
+    bool finish_prober(const Buffer<uint8_t>& build_match_index);
+    // The build rows matched by all the probe drivers, only valid for the last finished probe driver.
+    const Buffer<uint8_t>& build_match_index() const { return _build_match_index; }
+
+    // Called by each build and probe driver when it's closed, the shared hash table is released
+    // after all of them are closed.
+    void unref(RuntimeState* state);
+
+private:
+    vectorized::HashJoinerPtr _builder;
+
+    size_t _num_builders = 0;
+    size_t _num_probers = 0;
+    std::atomic<size_t> _num_finished_builders{0};
+    std::atomic<size_t> _num_closed{0};
+
+    std::mutex _mutex;
+    bool _is_builder_prepared = false;
+    Status _build_status;
+    bool _is_probe_short_circuited = false;
+    std::atomic<bool> _is_build_ready{false};
+
+    size_t _num_finished_probers = 0;
+    Buffer<uint8_t> _build_match_index;
+
+    Observable _observable;
+};
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,100 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/hashjoin/hash_join_probe_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status HashJoinProbeOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    RETURN_IF_ERROR(_joiner->prepare(state, _runtime_profile.get(), get_memtracker()));
+    // All the drivers of one fragment are created before any of them is prepared, so the hash table
+    // will never be built if there is no build driver at all.
+    if (_join_context->num_builders() == 0) {
+        _join_context->build_empty_hash_table(state, _runtime_profile.get(), get_memtracker());
+    }
+    return Status::OK();
+}
+
+Status HashJoinProbeOperator::close(RuntimeState* state) {
+    _joiner->close(state);
+    _join_context->unref(state);
+    return Operator::close(state);
+}
+
+bool HashJoinProbeOperator::has_output() {
+    // report the error of the build side by pull_chunk().
+    if (!_join_context->build_status().ok()) {
+        return true;
+    }
+    if (_joiner->has_pending_probe_chunk()) {
+        return true;
+    }
+    return _is_remain_owner && _joiner->has_remain_output();
+}
+
+bool HashJoinProbeOperator::is_finished() const {
+    if (_join_context->is_build_ready() && _join_context->is_probe_short_circuited()) {
+        return true;
+    }
+    return _is_probe_finished && !(_is_remain_owner && _joiner->has_remain_output());
+}
+
+void HashJoinProbeOperator::finish(RuntimeState* state) {
+    if (_is_input_finished) {
+        return;
+    }
+    _is_input_finished = true;
+
+    // finish() is called without the hash table being built only if the fragment is cancelled.
+    if (!_join_context->is_build_ready() || !_join_context->build_status().ok()) {
+        return;
+    }
+    _reference_hash_table();
+    if (!_joiner->has_pending_probe_chunk()) {
+        _finish_probe();
+    }
+}
+
+StatusOr<vectorized::ChunkPtr> HashJoinProbeOperator::pull_chunk(RuntimeState* state) {
+    RETURN_IF_ERROR(_join_context->build_status());
+
+    if (_joiner->has_pending_probe_chunk()) {
+        auto chunk = _joiner->pull_probe_chunk(state);
+        if (chunk.ok() && _is_input_finished && !_joiner->has_pending_probe_chunk()) {
+            _finish_probe();
+        }
+        return chunk;
+    }
+    return _joiner->pull_remain_chunk(state);
+}
+
+Status HashJoinProbeOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    RETURN_IF_ERROR(_join_context->build_status());
+    _reference_hash_table();
+    return _joiner->push_probe_chunk(state, chunk);
+}
+
+void HashJoinProbeOperator::_reference_hash_table() {
+    if (_is_referenced) {
+        return;
+    }
+    _is_referenced = true;
+    _joiner->reference_hash_table(_join_context->builder());
+}
+
+void HashJoinProbeOperator::_finish_probe() {
+    if (_is_probe_finished) {
+        return;
+    }
+    _is_probe_finished = true;
+
+    if (_joiner->need_output_remain() && _join_context->finish_prober(_joiner->build_match_index())) {
+        _is_remain_owner = true;
+        _joiner->prepare_remain_output(_join_context->build_match_index());
+    }
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,89 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/hashjoin/hash_join_context.h"
+#include "exec/pipeline/operator.h"
+
+namespace starrocks::pipeline {
+
+// HashJoinProbeOperator probes the hash table shared by all the probe drivers of one hash join,
+// it's not ready until the hash table is built by the build drivers.
+class HashJoinProbeOperator final : public Operator {
+public:
+    HashJoinProbeOperator(int32_t id, int32_t plan_node_id, const TPlanNode& tnode, const RowDescriptor& row_desc,
+                          const RowDescriptor& build_row_desc, const RowDescriptor& probe_row_desc,
+                          HashJoinContextPtr join_context)
+            : Operator(id, "hash_join_probe", plan_node_id),
+              _joiner(std::make_shared<vectorized::HashJoiner>(tnode, row_desc, build_row_desc, probe_row_desc)),
+              _join_context(std::move(join_context)) {}
+
+    ~HashJoinProbeOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override;
+
+    bool need_input() override { return !_is_input_finished && !_joiner->has_pending_probe_chunk(); }
+
+    bool is_finished() const override;
+
+    void finish(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+    bool is_precondition_ready() const override { return _join_context->is_build_ready(); }
+
+    bool add_ready_observer(const ReadyObserver& observer) override {
+        _join_context->add_observer(observer);
+        return true;
+    }
+
+private:
+    void _reference_hash_table();
+    // Called once the input is finished and the pending probe chunk is consumed, the last finished
+    // probe driver takes over the output of the remaining build rows.
+    void _finish_probe();
+
+    vectorized::HashJoinerPtr _joiner;
+    HashJoinContextPtr _join_context;
+
+    bool _is_referenced = false;
+    bool _is_input_finished = false;
+    bool _is_probe_finished = false;
+    bool _is_remain_owner = false;
+};
+
+class HashJoinProbeOperatorFactory final : public OperatorFactory {
+public:
+    HashJoinProbeOperatorFactory(int32_t id, int32_t plan_node_id, const TPlanNode& tnode,
+                                 const RowDescriptor& row_desc, const RowDescriptor& build_row_desc,
+                                 const RowDescriptor& probe_row_desc, HashJoinContextPtr join_context)
+            : OperatorFactory(id, plan_node_id),
+              _tnode(tnode),
+              _row_descriptor(row_desc),
+              _build_row_descriptor(build_row_desc),
+              _probe_row_descriptor(probe_row_desc),
+              _join_context(std::move(join_context)) {}
+
+    ~HashJoinProbeOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        _join_context->set_num_probers(driver_instance_count);
+        return std::make_shared<HashJoinProbeOperator>(_id, _plan_node_id, _tnode, _row_descriptor,
+                                                       _build_row_descriptor, _probe_row_descriptor, _join_context);
+    }
+
+private:
+    const TPlanNode _tnode;
+    const RowDescriptor& _row_descriptor;
+    const RowDescriptor& _build_row_descriptor;
+    const RowDescriptor& _probe_row_descriptor;
+    HashJoinContextPtr _join_context;
+};
+
+} // namespace starrocks::pipeline
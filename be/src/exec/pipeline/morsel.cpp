@@ -0,0 +1,159 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/morsel.h"
+
+#include <shared_mutex>
+
+#include "storage/storage_engine.h"
+#include "storage/tablet_manager.h"
+
+namespace starrocks::pipeline {
+
+Morsels OlapMorsel::split(int32_t plan_node_id, const TScanRangeParams& scan_range, int64_t split_rows) {
+    Morsels morsels;
+    const TInternalScanRange& internal_scan_range = scan_range.scan_range.internal_scan_range;
+    TTabletId tablet_id = internal_scan_range.tablet_id;
+    SchemaHash schema_hash = strtoul(internal_scan_range.schema_hash.c_str(), nullptr, 10);
+    int64_t version = strtoul(internal_scan_range.version.c_str(), nullptr, 10);
+
+    std::string err;
+    TabletSharedPtr tablet =
+            StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id, schema_hash, true, &err);
+    // The rows of the other keys types must be merged across the rowsets, and the primary keys tablets
+    // are read by TabletUpdates, so only the tablets of DUP_KEYS could be split.
+    if (split_rows <= 0 || tablet == nullptr || tablet->keys_type() != DUP_KEYS || tablet->updates() != nullptr) {
+        morsels.emplace_back(std::make_unique<OlapMorsel>(plan_node_id, scan_range));
+        return morsels;
+    }
+
+    std::vector<RowsetSharedPtr> rowsets;
+    {
+        std::shared_lock rdlock(tablet->get_header_lock());
+        if (tablet->capture_consistent_rowsets(Version(0, version), &rowsets) != OLAP_SUCCESS) {
+            // Let the OlapChunkSource report the error.
+            morsels.emplace_back(std::make_unique<OlapMorsel>(plan_node_id, scan_range));
+            return morsels;
+        }
+    }
+
+    int64_t num_rows = 0;
+    for (const auto& rowset : rowsets) {
+        num_rows += rowset->num_rows();
+    }
+    if (num_rows < 2 * split_rows) {
+        morsels.emplace_back(std::make_unique<OlapMorsel>(plan_node_id, scan_range));
+        return morsels;
+    }
+
+    // The row count of each segment isn't in the rowset metadata, so the rows are assumed to be
+    // distributed evenly among the segments of a rowset.
+    std::vector<vectorized::RowsetSegmentRange> ranges;
+    int64_t range_rows = 0;
+    for (const auto& rowset : rowsets) {
+        if (rowset->empty()) {
+            continue;
+        }
+        const auto num_segments = static_cast<uint32_t>(rowset->num_segments());
+        const int64_t rows_per_segment = std::max<int64_t>(1, rowset->num_rows() / num_segments);
+        uint32_t begin_segment = 0;
+        for (uint32_t i = 0; i < num_segments; ++i) {
+            range_rows += rows_per_segment;
+            if (range_rows >= split_rows) {
+                ranges.push_back({rowset, begin_segment, i + 1});
+                morsels.emplace_back(std::make_unique<OlapMorsel>(plan_node_id, scan_range, std::move(ranges)));
+                ranges.clear();
+                range_rows = 0;
+                begin_segment = i + 1;
+            }
+        }
+        if (begin_segment < num_segments) {
+            ranges.push_back({rowset, begin_segment, num_segments});
+        }
+    }
+    if (!ranges.empty()) {
+        morsels.emplace_back(std::make_unique<OlapMorsel>(plan_node_id, scan_range, std::move(ranges)));
+    }
+    if (morsels.empty()) {
+        morsels.emplace_back(std::make_unique<OlapMorsel>(plan_node_id, scan_range));
+    }
+    return morsels;
+}
+
+MorselQueue::MorselQueue(Morsels&& morsels) : _num_morsels(morsels.size()) {
+    _groups.reserve(morsels.size());
+    for (auto& morsel : morsels) {
+        MorselGroup group;
+        group.morsels.emplace_back(std::move(morsel));
+        group.end = 1;
+        _groups.emplace_back(std::move(group));
+    }
+}
+
+static size_t count_morsels(const std::vector<Morsels>& morsel_groups) {
+    size_t num_morsels = 0;
+    for (const auto& morsels : morsel_groups) {
+        num_morsels += morsels.size();
+    }
+    return num_morsels;
+}
+
+MorselQueue::MorselQueue(std::vector<Morsels>&& morsel_groups) : _num_morsels(count_morsels(morsel_groups)) {
+    _groups.reserve(morsel_groups.size());
+    for (auto& morsels : morsel_groups) {
+        if (morsels.empty()) {
+            continue;
+        }
+        MorselGroup group;
+        group.end = morsels.size();
+        group.morsels = std::move(morsels);
+        _groups.emplace_back(std::move(group));
+    }
+}
+
+std::optional<MorselPtr> MorselQueue::try_get(int32_t driver_sequence) {
+    std::lock_guard<std::mutex> l(_mutex);
+    auto it = _owned_groups.find(driver_sequence);
+    int group_idx = -1;
+    if (it != _owned_groups.end() && _groups[it->second].num_remain() > 0) {
+        group_idx = it->second;
+    } else if (_next_group < _groups.size()) {
+        group_idx = _next_group++;
+    } else {
+        group_idx = _steal_group();
+    }
+    if (group_idx < 0) {
+        return {};
+    }
+    _owned_groups[driver_sequence] = group_idx;
+    auto& group = _groups[group_idx];
+    DCHECK_GT(group.num_remain(), 0);
+    return std::move(group.morsels[group.begin++]);
+}
+
+int MorselQueue::_steal_group() {
+    size_t victim_idx = 0;
+    size_t max_num_remain = 0;
+    for (size_t i = 0; i < _groups.size(); ++i) {
+        if (_groups[i].num_remain() > max_num_remain) {
+            max_num_remain = _groups[i].num_remain();
+            victim_idx = i;
+        }
+    }
+    if (max_num_remain == 0) {
+        return -1;
+    }
+
+    // The owner of the victim keeps scanning the front half, and the thief takes the back half.
+    const size_t num_stolen = (max_num_remain + 1) / 2;
+    MorselGroup stolen;
+    auto& victim = _groups[victim_idx];
+    for (size_t i = victim.end - num_stolen; i < victim.end; ++i) {
+        stolen.morsels.emplace_back(std::move(victim.morsels[i]));
+    }
+    victim.end -= num_stolen;
+    stolen.end = num_stolen;
+    _groups.emplace_back(std::move(stolen));
+    return _groups.size() - 1;
+}
+
+} // namespace starrocks::pipeline
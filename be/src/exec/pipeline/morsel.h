@@ -2,10 +2,13 @@
 
 #pragma once
 
+#include <mutex>
 #include <optional>
+#include <unordered_map>
 
 #include "gen_cpp/InternalService_types.h"
 #include "storage/olap_common.h"
+#include "storage/vectorized/reader_params.h"
 
 namespace starrocks {
 namespace pipeline {
@@ -32,36 +35,59 @@ public:
         _scan_range = std::make_unique<TInternalScanRange>(scan_range.scan_range.internal_scan_range);
     }
 
+    OlapMorsel(int32_t plan_node_id, const TScanRangeParams& scan_range,
+               std::vector<vectorized::RowsetSegmentRange>&& rowset_segment_ranges)
+            : OlapMorsel(plan_node_id, scan_range) {
+        _rowset_segment_ranges = std::move(rowset_segment_ranges);
+    }
+
     TInternalScanRange* get_scan_range() { return _scan_range.get(); }
 
+    // Empty means reading the whole tablet.
+    const std::vector<vectorized::RowsetSegmentRange>& rowset_segment_ranges() const { return _rowset_segment_ranges; }
+
+    // Split the tablet of |scan_range| into the morsels of consecutive segments, each of which contains about
+    // |split_rows| rows according to the rowset metadata. Only the tablets of DUP_KEYS are split, otherwise
+    // or on failure, the morsel of the whole tablet is returned.
+    static Morsels split(int32_t plan_node_id, const TScanRangeParams& scan_range, int64_t split_rows);
+
 private:
     std::unique_ptr<TInternalScanRange> _scan_range;
+    std::vector<vectorized::RowsetSegmentRange> _rowset_segment_ranges;
 };
 
+// MorselQueue is shared by all the drivers of a scan pipeline. The morsels are organized in groups, e.g. the
+// morsels split from the same tablet. A driver owns one group at a time and takes the morsels from its front,
+// after all the groups are owned, an idle driver steals the back half of the largest remaining group, so the
+// unscanned tail of a large tablet is shared by the idle drivers instead of being scanned by a single driver.
 class MorselQueue {
 public:
-    MorselQueue(Morsels&& morsels) : _morsels(std::move(morsels)), _num_morsels(_morsels.size()), _pop_index(0) {}
+    // Each morsel is a group.
+    MorselQueue(Morsels&& morsels);
+    MorselQueue(std::vector<Morsels>&& morsel_groups);
 
     size_t num_morsels() const { return _num_morsels; }
-    std::optional<MorselPtr> try_get() {
-        auto idx = _pop_index.load();
-        // prevent _num_morsels from superfluous addition
-        if (idx >= _num_morsels) {
-            return {};
-        }
-        idx = _pop_index.fetch_add(1);
-        if (idx < _num_morsels) {
-            return std::move(_morsels[idx]);
-        } else {
-            return {};
-        }
-    }
+    std::optional<MorselPtr> try_get(int32_t driver_sequence);
 
 private:
-    Morsels _morsels;
+    struct MorselGroup {
+        Morsels morsels;
+        // The morsels in [begin, end) aren't taken.
+        size_t begin = 0;
+        size_t end = 0;
+        size_t num_remain() const { return end - begin; }
+    };
+
+    // Return the index of the stolen group, or -1 if all morsels are taken.
+    int _steal_group();
+
+    std::mutex _mutex;
+    std::vector<MorselGroup> _groups;
     const size_t _num_morsels;
-    std::atomic<size_t> _pop_index;
+    size_t _next_group = 0;
+    // driver_sequence -> the index of the group owned by the driver.
+    std::unordered_map<int32_t, size_t> _owned_groups;
 };
 
 } // namespace pipeline
-} // namespace starrocks
\ No newline at end of file
+} // namespace starrocks
@@ -0,0 +1,49 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace starrocks::pipeline {
+
+// An observer is invoked when the state of a resource that drivers may be blocked on changes,
+// e.g. a chunk arrives at the receiver of an exchange, or an in-flight rpc of SinkBuffer completes.
+// The observer must be cheap and must not block, it just tells PipelineDriverPoller which blocked
+// driver deserves to be re-checked.
+using ReadyObserver = std::function<void()>;
+
+// Observable is embedded into the resources shared between drivers and asynchronous events,
+// so that drivers blocked on them are woken up explicitly instead of being scanned repeatedly.
+class Observable {
+public:
+    Observable() = default;
+    ~Observable() = default;
+
+    void add_observer(ReadyObserver observer) {
+        std::lock_guard<std::mutex> l(_mutex);
+        _observers.emplace_back(std::move(observer));
+    }
+
+    void notify_observers() const {
+        std::lock_guard<std::mutex> l(_mutex);
+        for (const auto& observer : _observers) {
+            observer();
+        }
+    }
+
+    bool has_observers() const {
+        std::lock_guard<std::mutex> l(_mutex);
+        return !_observers.empty();
+    }
+
+private:
+    Observable(const Observable&) = delete;
+    Observable& operator=(const Observable&) = delete;
+
+    mutable std::mutex _mutex;
+    std::vector<ReadyObserver> _observers;
+};
+
+} // namespace starrocks::pipeline
@@ -11,6 +11,7 @@
 #include "runtime/current_thread.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
 #include "storage/storage_engine.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/predicate_parser.h"
@@ -19,6 +20,15 @@
 namespace starrocks::pipeline {
 using namespace vectorized;
 Status OlapChunkSource::prepare(RuntimeState* state) {
+    Status status = _prepare(state);
+    // Keep the failure, so that it's returned when reading from the chunk source.
+    if (!status.ok()) {
+        _status = status;
+    }
+    return status;
+}
+
+Status OlapChunkSource::_prepare(RuntimeState* state) {
     _runtime_state = state;
 
     for (const auto& ctx_iter : _conjunct_ctxs) {
@@ -116,6 +126,7 @@ Status OlapChunkSource::_init_reader_params(const std::vector<OlapScanRange*>& k
     params->reader_type = READER_QUERY;
     params->skip_aggregation = _skip_aggregation;
     params->version = Version(0, _version);
+    params->rowset_segment_ranges = *_rowset_segment_ranges;
     params->profile = _scan_profile;
     params->runtime_state = _runtime_state;
     params->use_page_cache = !config::disable_storage_page_cache;
@@ -136,6 +147,7 @@ Status OlapChunkSource::_init_reader_params(const std::vector<OlapScanRange*>& k
     }
     for (auto& is_null_str : _is_null_vector) {
         vectorized::ColumnPredicate* p = parser.parse(is_null_str);
+        p->set_index_filter_only(is_null_str.is_index_filter_only);
         _predicate_free_pool.emplace_back(p);
         if (parser.can_pushdown(p)) {
             params->predicates.push_back(p);
@@ -173,6 +185,8 @@ Status OlapChunkSource::_init_reader_params(const std::vector<OlapScanRange*>& k
     // Actually only the key columns need to be sorted by id, here we check all
     // for simplicity.
     DCHECK(std::is_sorted(reader_columns.begin(), reader_columns.end()));
+    params->chunk_size = vectorized::ChunkHelper::adaptive_chunk_size(
+            _tablet->tablet_schema(), reader_columns, config::scan_chunk_target_bytes, params->chunk_size);
     return Status::OK();
 }
 
@@ -252,12 +266,27 @@ StatusOr<vectorized::ChunkUniquePtr> OlapChunkSource::get_next_chunk() {
     return std::move(chunk);
 }
 
-void OlapChunkSource::cache_next_chunk_blocking() {
-    _chunk = get_next_chunk();
+void OlapChunkSource::cache_next_chunks_blocking(size_t max_chunks, int64_t max_bytes, MemTracker* mem_tracker) {
+    int64_t cached_bytes = 0;
+    while (_status.ok() && _cached_chunks.size() < max_chunks) {
+        auto chunk = get_next_chunk();
+        if (!chunk.ok()) {
+            break;
+        }
+        cached_bytes += chunk.value()->memory_usage();
+        _cached_chunks.emplace_back(std::move(chunk).value());
+        // The pages read ahead are put into StoragePageCache as usual, so only the decoded chunks
+        // are charged here.
+        if (cached_bytes >= max_bytes || (mem_tracker != nullptr && mem_tracker->any_limit_exceeded())) {
+            break;
+        }
+    }
 }
 
-StatusOr<vectorized::ChunkUniquePtr> OlapChunkSource::get_next_chunk_nonblocking() {
-    return std::move(_chunk);
+Status OlapChunkSource::take_cached_chunks(std::vector<vectorized::ChunkPtr>* chunks) {
+    chunks->swap(_cached_chunks);
+    _cached_chunks.clear();
+    return _status;
 }
 
 Status OlapChunkSource::_read_chunk_from_storage(RuntimeState* state, vectorized::Chunk* chunk) {
@@ -281,11 +310,15 @@ Status OlapChunkSource::_read_chunk_from_storage(RuntimeState* state, vectorized
             size_t nrows = chunk->num_rows();
             _selection.resize(nrows);
             _un_push_down_predicates.evaluate(chunk, _selection.data(), 0, nrows);
-            chunk->filter(_selection);
+            // the selection is applied along with the conjuncts
+            if (!_un_push_down_conjuncts.empty()) {
+                ExecNode::eval_conjuncts_with_selection(_un_push_down_conjuncts, chunk, &_selection);
+            } else {
+                chunk->filter(_selection);
+            }
             CurrentMemTracker::consume((int64_t)chunk->memory_usage() - old_mem_usage);
             DCHECK_CHUNK(chunk);
-        }
-        if (!_un_push_down_conjuncts.empty()) {
+        } else if (!_un_push_down_conjuncts.empty()) {
             int64_t old_mem_usage = chunk->memory_usage();
             SCOPED_TIMER(_expr_filter_timer);
             ExecNode::eval_conjuncts(_un_push_down_conjuncts, chunk);
@@ -297,7 +330,10 @@ Status OlapChunkSource::_read_chunk_from_storage(RuntimeState* state, vectorized
 }
 
 Status OlapChunkSource::close(RuntimeState* state) {
-    _prj_iter->close();
+    // _prj_iter is null if the prepare failed.
+    if (_prj_iter != nullptr) {
+        _prj_iter->close();
+    }
     _reader.reset();
     return Status::OK();
 }
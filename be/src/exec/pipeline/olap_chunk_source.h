@@ -33,6 +33,7 @@ public:
               _skip_aggregation(skip_aggregation) {
         OlapMorsel* olap_morsel = (OlapMorsel*)_morsel.get();
         _scan_range = olap_morsel->get_scan_range();
+        _rowset_segment_ranges = &olap_morsel->rowset_segment_ranges();
     }
 
     ~OlapChunkSource() override = default;
@@ -44,10 +45,12 @@ public:
     bool has_next_chunk() override;
 
     StatusOr<vectorized::ChunkUniquePtr> get_next_chunk() override;
-    void cache_next_chunk_blocking() override;
-    StatusOr<vectorized::ChunkUniquePtr> get_next_chunk_nonblocking() override;
+
+    void cache_next_chunks_blocking(size_t max_chunks, int64_t max_bytes, MemTracker* mem_tracker) override;
+    Status take_cached_chunks(std::vector<vectorized::ChunkPtr>* chunks) override;
 
 private:
+    Status _prepare(RuntimeState* state);
     Status _get_tablet(const TInternalScanRange* scan_range);
     Status _init_reader_params(const std::vector<OlapScanRange*>& key_ranges,
                                const std::vector<uint32_t>& scanner_columns, std::vector<uint32_t>& reader_columns,
@@ -64,9 +67,11 @@ private:
     std::vector<std::string> _key_column_names;
     bool _skip_aggregation;
     TInternalScanRange* _scan_range;
+    const std::vector<vectorized::RowsetSegmentRange>* _rowset_segment_ranges;
 
     Status _status = Status::OK();
-    StatusOr<vectorized::ChunkUniquePtr> _chunk;
+    // The chunks read ahead by the io task.
+    std::vector<vectorized::ChunkPtr> _cached_chunks;
     // Same size with |_conjunct_ctxs|, indicate which element has been normalized.
     std::vector<bool> _normalized_conjuncts;
     // The conjuncts couldn't push down to storage engine
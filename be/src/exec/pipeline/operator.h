@@ -4,6 +4,7 @@
 
 #include "column/vectorized_fwd.h"
 #include "common/statusor.h"
+#include "exec/pipeline/observable.h"
 
 namespace starrocks {
 class Expr;
@@ -47,12 +48,26 @@ public:
     // Push chunk to this operator
     virtual Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) = 0;
 
+    // Register an observer invoked when the operator may turn from blocked to unblocked, i.e.
+    // has_output() or is_finished() of a source operator, need_input() or is_finished() of a sink
+    // operator may become true. Return false if the operator doesn't support it, the drivers blocked
+    // on such operators are polled by PipelineDriverPoller.
+    virtual bool add_ready_observer(const ReadyObserver& observer) { return false; }
+
+    // Whether the operator could be driven by its driver, e.g. the hash join probe operator
+    // is not ready until the hash table is built. The driver runs none of its operators until all
+    // of them are ready, and for the operators not ready, add_ready_observer() should notify the
+    // observer when this may become true. It never turns from true to false.
+    virtual bool is_precondition_ready() const { return true; }
+
     int32_t get_id() const { return _id; }
 
     int32_t get_plan_node_id() const { return _plan_node_id; }
 
     MemTracker* get_memtracker() const { return _mem_tracker.get(); }
 
+    RuntimeProfile* get_runtime_profile() const { return _runtime_profile.get(); }
+
     std::string get_name() const { return _name + "_" + std::to_string(_id); }
 
 protected:
@@ -3,8 +3,12 @@
 
 #include "exec/pipeline/pipeline_driver.h"
 
+#include <algorithm>
+
 #include "column/chunk.h"
 #include "exec/pipeline/source_operator.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
 namespace starrocks {
@@ -15,12 +19,29 @@ Status PipelineDriver::prepare(RuntimeState* runtime_state) {
         for (auto& op : _operators) {
             RETURN_IF_ERROR(op->prepare(runtime_state));
         }
+        if (_fragment_ctx->enable_hardware_counters()) {
+            _prepare_hw_counters(runtime_state);
+        }
         _state = DriverState::READY;
     }
     return Status::OK();
 }
+bool PipelineDriver::_check_precondition_ready() {
+    if (!_is_precondition_ready) {
+        _is_precondition_ready = std::all_of(_operators.begin(), _operators.end(),
+                                             [](const auto& op) { return op->is_precondition_ready(); });
+    }
+    return _is_precondition_ready;
+}
+
 StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
+    if (!_check_precondition_ready()) {
+        _state = DriverState::PRECONDITION_BLOCK;
+        return _state;
+    }
     _state = DriverState::RUNNING;
+    const ThreadPerfCounters* perf_counters = _hw_counters.empty() ? nullptr : ThreadPerfCounters::current();
+    ThreadPerfCounters::Values hw_begin;
     size_t total_chunks_moved = 0;
     int64_t time_spent = 0;
     while (true) {
@@ -57,7 +78,13 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
 
                 // pull chunk from current operator and push the chunk onto next
                 // operator
+                CurrentThread::set_operator(curr_op->get_id(), curr_op->get_plan_node_id());
+                bool hw_counting = perf_counters != nullptr && perf_counters->read(&hw_begin);
                 auto pulled_chunk = curr_op->pull_chunk(runtime_state);
+                if (hw_counting) {
+                    size_t num_rows = pulled_chunk.ok() && pulled_chunk.value() ? pulled_chunk.value()->num_rows() : 0;
+                    _update_hw_counters(i, perf_counters, hw_begin, num_rows);
+                }
                 auto status = pulled_chunk.status();
                 if (!status.ok() && !status.is_end_of_file()) {
                     LOG(WARNING) << " status " << status.to_string();
@@ -72,7 +99,17 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
                 if (status.ok()) {
                     DCHECK(pulled_chunk.value());
                     if (pulled_chunk.value() && pulled_chunk.value()->num_rows() > 0) {
-                        next_op->push_chunk(runtime_state, std::move(pulled_chunk.value()));
+                        CurrentThread::set_operator(next_op->get_id(), next_op->get_plan_node_id());
+                        size_t num_rows = pulled_chunk.value()->num_rows();
+                        hw_counting = perf_counters != nullptr && perf_counters->read(&hw_begin);
+                        status = next_op->push_chunk(runtime_state, std::move(pulled_chunk.value()));
+                        if (hw_counting) {
+                            _update_hw_counters(i + 1, perf_counters, hw_begin, num_rows);
+                        }
+                        if (!status.ok()) {
+                            LOG(WARNING) << " status " << status.to_string();
+                            return status;
+                        }
                     }
                     num_chunk_moved += 1;
                     total_chunks_moved += 1;
@@ -131,6 +168,9 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
 }
 
 void PipelineDriver::finalize(RuntimeState* runtime_state, DriverState state) {
+    if (!_hw_counters.empty()) {
+        _finalize_hw_counters();
+    }
     if (state == DriverState::FINISH || state == DriverState::CANCELED || state == DriverState::INTERNAL_ERROR) {
         auto num_operators = _operators.size();
         for (auto i = _first_unfinished; i < num_operators; ++i) {
@@ -163,5 +203,58 @@ void PipelineDriver::finalize(RuntimeState* runtime_state, DriverState state) {
                                                                                            true);
     }
 }
+void PipelineDriver::_prepare_hw_counters(RuntimeState* runtime_state) {
+    if (ThreadPerfCounters::current() == nullptr) {
+        LOG(WARNING) << "the hardware counters are unavailable, check perf_event_paranoid";
+        return;
+    }
+    // The profiles of the operators are shown under the driver in the profile of the fragment instance.
+    _runtime_profile = std::make_shared<RuntimeProfile>("PipelineDriver (id=" + std::to_string(_driver_id) + ")");
+    runtime_state->runtime_profile()->add_child(_runtime_profile.get(), true, nullptr);
+    static const char* names[ThreadPerfCounters::NUM_COUNTERS] = {"HwCpuCycles", "HwInstructions", "HwLLCMisses",
+                                                                  "HwBranchMisses"};
+    for (auto& op : _operators) {
+        auto* profile = op->get_runtime_profile();
+        _runtime_profile->add_child(profile, true, nullptr);
+        OperatorHwCounters hw_counters;
+        for (int i = 0; i < ThreadPerfCounters::NUM_COUNTERS; ++i) {
+            hw_counters.counters[i] = ADD_COUNTER(profile, names[i], TUnit::UNIT);
+        }
+        hw_counters.rows = ADD_COUNTER(profile, "HwCountedRows", TUnit::UNIT);
+        _hw_counters.emplace_back(hw_counters);
+    }
+}
+
+void PipelineDriver::_update_hw_counters(size_t op_index, const ThreadPerfCounters* perf_counters,
+                                         const ThreadPerfCounters::Values& begin, size_t num_rows) {
+    ThreadPerfCounters::Values end;
+    if (!perf_counters->read(&end)) {
+        return;
+    }
+    auto& hw_counters = _hw_counters[op_index];
+    for (int i = 0; i < ThreadPerfCounters::NUM_COUNTERS; ++i) {
+        COUNTER_UPDATE(hw_counters.counters[i], end.values[i] - begin.values[i]);
+    }
+    COUNTER_UPDATE(hw_counters.rows, num_rows);
+}
+
+void PipelineDriver::_finalize_hw_counters() {
+    for (size_t i = 0; i < _operators.size(); ++i) {
+        const auto& hw_counters = _hw_counters[i];
+        int64_t cycles = hw_counters.counters[ThreadPerfCounters::CPU_CYCLES]->value();
+        int64_t instructions = hw_counters.counters[ThreadPerfCounters::INSTRUCTIONS]->value();
+        int64_t llc_misses = hw_counters.counters[ThreadPerfCounters::LLC_MISSES]->value();
+        int64_t rows = hw_counters.rows->value();
+        auto* profile = _operators[i]->get_runtime_profile();
+        if (cycles > 0) {
+            profile->add_info_string("IPC", strings::Substitute("$0", static_cast<double>(instructions) / cycles));
+        }
+        if (rows > 0) {
+            profile->add_info_string("LLCMissesPerRow",
+                                     strings::Substitute("$0", static_cast<double>(llc_misses) / rows));
+        }
+    }
+}
+
 } // namespace pipeline
 } // namespace starrocks
@@ -14,6 +14,8 @@
 #include "exec/pipeline/query_context.h"
 #include "exec/pipeline/source_operator.h"
 #include "runtime/mem_tracker.h"
+#include "util/perf_counters.h"
+#include "util/runtime_profile.h"
 
 namespace starrocks {
 class MemTracker;
@@ -36,6 +38,9 @@ enum DriverState : uint32_t {
     // io task executed by io threads synchronously, a driver turns to FINISH from PENDING_FINISH after the
     // pending io task's completion.
     PENDING_FINISH = 8,
+    // PRECONDITION_BLOCK means some operator of a driver is not ready for running, e.g. the hash table
+    // to probe is not built yet, see Operator::is_precondition_ready().
+    PRECONDITION_BLOCK = 9,
 };
 
 static inline std::string ds_to_string(DriverState ds) {
@@ -58,6 +63,8 @@ static inline std::string ds_to_string(DriverState ds) {
         return "INTERNAL_ERROR";
     case PENDING_FINISH:
         return "PENDING_FINISH";
+    case PRECONDITION_BLOCK:
+        return "PRECONDITION_BLOCK";
     }
     DCHECK(false);
     return "UNKNOWN_STATE";
@@ -92,12 +99,23 @@ public:
     }
     void increment_schedule_times() { this->schedule_times += 1; }
 
+    // Record the time the driver is put into DriverQueue, and return how long it has waited for
+    // a worker thread when it's taken out.
+    void mark_queued(int64_t now_ns) { this->last_queued_time = now_ns; }
+    int64_t update_queue_wait_time(int64_t now_ns) {
+        int64_t wait_time = std::max<int64_t>(0, now_ns - last_queued_time);
+        this->accumulated_queue_wait_time += wait_time;
+        return wait_time;
+    }
+
 private:
     int64_t schedule_times;
     int64_t last_time_spent;
     int64_t last_chunks_moved;
     int64_t accumulated_time_spent;
     int64_t accumulated_chunk_moved;
+    int64_t last_queued_time = 0;
+    int64_t accumulated_queue_wait_time = 0;
 };
 
 class PipelineDriver {
@@ -144,13 +162,61 @@ public:
             return sink_operator()->need_input() || sink_operator()->is_finished();
         } else if (_state == DriverState::INPUT_EMPTY) {
             return source_operator()->has_output() || source_operator()->is_finished();
+        } else if (_state == DriverState::PRECONDITION_BLOCK) {
+            return _check_precondition_ready();
         }
         return true;
     }
 
     bool is_root() const { return _is_root; }
 
+    // Register the observer on the source and sink operators, it's invoked only once
+    // by PipelineDriverPoller when the driver is blocked for the first time.
+    void observe_ready(const ReadyObserver& observer) {
+        _is_source_observable = source_operator()->add_ready_observer(observer);
+        _is_sink_observable = sink_operator()->add_ready_observer(observer);
+        _is_precondition_observable = true;
+        for (auto& op : _operators) {
+            if (!op->is_precondition_ready() && op != _operators.front() && op != _operators.back()) {
+                _is_precondition_observable &= op->add_ready_observer(observer);
+            }
+        }
+        _is_ready_observed = true;
+    }
+    bool is_ready_observed() const { return _is_ready_observed; }
+
+    // Whether the driver in the current blocked state is woken up by the operator it's blocked on,
+    // the driver is parked without polling in that case.
+    bool is_blocked_observable() const {
+        switch (_state) {
+        case DriverState::INPUT_EMPTY:
+        case DriverState::PENDING_FINISH:
+            return _is_source_observable;
+        case DriverState::OUTPUT_FULL:
+            return _is_sink_observable;
+        case DriverState::PRECONDITION_BLOCK:
+            return _is_precondition_observable;
+        default:
+            return false;
+        }
+    }
+
 private:
+    // Check whether all the operators are ready, the result is cached once it's true.
+    bool _check_precondition_ready();
+
+    // The hardware events of an operator counted while the driver calls it, and the rows of the chunks pulled
+    // from it or pushed to it by the calls.
+    struct OperatorHwCounters {
+        RuntimeProfile::Counter* counters[ThreadPerfCounters::NUM_COUNTERS];
+        RuntimeProfile::Counter* rows;
+    };
+    void _prepare_hw_counters(RuntimeState* runtime_state);
+    void _update_hw_counters(size_t op_index, const ThreadPerfCounters* perf_counters,
+                             const ThreadPerfCounters::Values& begin, size_t num_rows);
+    // Add IPC and LLCMissesPerRow of the operators to their profiles.
+    void _finalize_hw_counters();
+
     Operators _operators;
     size_t _first_unfinished;
     QueryContext* _query_ctx;
@@ -167,6 +233,14 @@ private:
     std::shared_ptr<MemTracker> _mem_tracker = nullptr;
     const size_t _yield_max_chunks_moved;
     const int64_t _yield_max_time_spent;
+    // Only accessed by PipelineDriverPoller.
+    bool _is_ready_observed = false;
+    bool _is_source_observable = false;
+    bool _is_sink_observable = false;
+    bool _is_precondition_observable = false;
+    bool _is_precondition_ready = false;
+    // Empty unless the query option enable_hardware_counters is set.
+    std::vector<OperatorHwCounters> _hw_counters;
 };
 
 } // namespace pipeline
@@ -2,20 +2,34 @@
 
 #include "exec/pipeline/pipeline_driver_dispatcher.h"
 
+#include "common/config.h"
+#include "exec/pipeline/pipeline_driver_tracer.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/current_thread.h"
 namespace starrocks {
 namespace pipeline {
-GlobalDriverDispatcher::GlobalDriverDispatcher(std::unique_ptr<ThreadPool> thread_pool)
-        : _driver_queue(new QuerySharedDriverQueue()),
+GlobalDriverDispatcher::GlobalDriverDispatcher(std::unique_ptr<ThreadPool> thread_pool, int32_t max_num_threads)
+        : _driver_queue(_create_driver_queue(max_num_threads)),
           _thread_pool(std::move(thread_pool)),
           _blocked_driver_poller(new PipelineDriverPoller(_driver_queue.get())),
           _exec_state_reporter(new ExecStateReporter()) {}
 
+DriverQueue* GlobalDriverDispatcher::_create_driver_queue(int32_t max_num_threads) {
+    // the workloads are isolated by resource groups only if any group is defined.
+    if (ResourceGroupManager::instance()->is_enabled()) {
+        return new ResourceGroupDriverQueue(ResourceGroupManager::instance()->groups());
+    }
+    if (config::pipeline_enable_work_stealing_driver_queue) {
+        return new WorkStealingDriverQueue(max_num_threads);
+    }
+    return new QuerySharedDriverQueue();
+}
+
 void GlobalDriverDispatcher::initialize(int num_threads) {
     _blocked_driver_poller->start();
     _num_threads_setter.set_actual_num(num_threads);
     for (auto i = 0; i < num_threads; ++i) {
-        _thread_pool->submit_func([this]() { this->run(); });
+        _thread_pool->submit_func([this, i]() { this->run(i); });
     }
 }
 
@@ -25,54 +39,68 @@ void GlobalDriverDispatcher::change_num_threads(int32_t num_threads) {
         return;
     }
     for (int i = old_num_threads; i < num_threads; ++i) {
-        _thread_pool->submit_func([this]() { this->run(); });
+        _thread_pool->submit_func([this, i]() { this->run(i); });
     }
 }
 
-void GlobalDriverDispatcher::run() {
+void GlobalDriverDispatcher::run(int worker_id) {
     while (true) {
         if (_num_threads_setter.should_shrink()) {
             break;
         }
 
         size_t queue_index;
-        auto driver = this->_driver_queue->take(&queue_index);
+        auto driver = this->_driver_queue->take_for_worker(worker_id, &queue_index);
         DCHECK(driver != nullptr);
         auto* fragment_ctx = driver->fragment_ctx();
         auto* runtime_state = fragment_ctx->runtime_state();
+        auto* tracer = DriverTracer::instance();
 
         if (fragment_ctx->is_canceled()) {
             VLOG_ROW << "[Driver] Canceled: error=" << fragment_ctx->final_status().to_string();
+            this->_driver_queue->release(driver, queue_index, false);
             if (driver->source_operator()->pending_finish()) {
                 driver->set_driver_state(DriverState::PENDING_FINISH);
+                tracer->record(driver.get(), DriverState::PENDING_FINISH);
                 _blocked_driver_poller->add_blocked_driver(driver);
             } else {
+                tracer->record(driver.get(), DriverState::CANCELED);
                 driver->finalize(runtime_state, DriverState::CANCELED);
             }
             continue;
         }
 
+        // tag the cpu samples taken while the driver runs
+        CurrentThread::set_query_id(fragment_ctx->query_id());
+        CurrentThread::set_fragment_instance_id(fragment_ctx->fragment_instance_id());
+        tracer->record(driver.get(), DriverState::RUNNING);
         auto status = driver->process(runtime_state);
-        this->_driver_queue->get_sub_queue(queue_index)->update_accu_time(driver);
+        CurrentThread::set_operator(-1, -1);
+        CurrentThread::set_fragment_instance_id(TUniqueId());
+        CurrentThread::set_query_id(TUniqueId());
+        this->_driver_queue->release(driver, queue_index, true);
 
         if (!status.ok()) {
             VLOG_ROW << "[Driver] Process error: error=" << status.status().to_string();
             fragment_ctx->cancel(status.status());
             if (driver->source_operator()->pending_finish()) {
                 driver->set_driver_state(DriverState::PENDING_FINISH);
+                tracer->record(driver.get(), DriverState::PENDING_FINISH);
                 _blocked_driver_poller->add_blocked_driver(driver);
             } else {
+                tracer->record(driver.get(), DriverState::INTERNAL_ERROR);
                 driver->finalize(runtime_state, DriverState::INTERNAL_ERROR);
             }
             continue;
         }
         auto driver_state = status.value();
+        tracer->record(driver.get(), driver_state);
         switch (driver_state) {
         case READY:
         case RUNNING: {
             VLOG_ROW << strings::Substitute("[Driver] Push back again, source=$0, state=$1",
                                             driver->source_operator()->get_name(), ds_to_string(driver_state));
-            this->_driver_queue->put_back(driver);
+            this->_driver_queue->put_back_from_worker(driver, worker_id);
             break;
         }
         case FINISH:
@@ -86,6 +114,7 @@ void GlobalDriverDispatcher::run() {
         }
         case INPUT_EMPTY:
         case OUTPUT_FULL:
+        case PRECONDITION_BLOCK:
         case PENDING_FINISH: {
             VLOG_ROW << strings::Substitute("[Driver] Blocked, source=$0, state=$1",
                                             driver->source_operator()->get_name(), ds_to_string(driver_state));
@@ -99,6 +128,7 @@ void GlobalDriverDispatcher::run() {
 }
 
 void GlobalDriverDispatcher::dispatch(DriverPtr driver) {
+    DriverTracer::instance()->record(driver.get(), DriverState::READY);
     this->_driver_queue->put_back(driver);
 }
 
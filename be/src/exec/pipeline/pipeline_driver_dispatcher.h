@@ -11,6 +11,7 @@
 #include "exec/pipeline/pipeline_driver_queue.h"
 #include "exec/pipeline/pipeline_fwd.h"
 #include "exec/pipeline/query_context.h"
+#include "exec/pipeline/resource_group.h"
 #include "runtime/runtime_state.h"
 #include "util/factory_method.h"
 #include "util/limit_setter.h"
@@ -44,7 +45,7 @@ public:
 
 class GlobalDriverDispatcher final : public FactoryMethod<DriverDispatcher, GlobalDriverDispatcher> {
 public:
-    explicit GlobalDriverDispatcher(std::unique_ptr<ThreadPool> thread_pool);
+    GlobalDriverDispatcher(std::unique_ptr<ThreadPool> thread_pool, int32_t max_num_threads);
     ~GlobalDriverDispatcher() override {}
     void initialize(int32_t num_threads) override;
     void change_num_threads(int32_t num_threads) override;
@@ -52,7 +53,9 @@ public:
     void report_exec_state(FragmentContext* fragment_ctx, const Status& status, bool done, bool clean) override;
 
 private:
-    void run();
+    // worker_id identifies the local queue of WorkStealingDriverQueue used by this thread.
+    void run(int worker_id);
+    static DriverQueue* _create_driver_queue(int32_t max_num_threads);
 
 private:
     LimitSetter _num_threads_setter;
@@ -5,6 +5,8 @@
 #include <emmintrin.h>
 
 #include <chrono>
+
+#include "exec/pipeline/pipeline_driver_tracer.h"
 namespace starrocks {
 namespace pipeline {
 
@@ -20,47 +22,115 @@ void PipelineDriverPoller::start() {
     }
 }
 void PipelineDriverPoller::shutdown() {
-    this->_is_shutdown.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_is_shutdown.store(true, std::memory_order_release);
+        this->_cond.notify_one();
+    }
     this->_polling_thread->join();
 }
 
+bool PipelineDriverPoller::_check_blocked_driver(const DriverPtr& driver) {
+    // driver->pending_finish() return true means that when a driver's sink operator is finished,
+    // but its source operator still has pending io task that executed in io threads and has
+    // reference to object outside(such as desc_tbl) owned by FragmentContext. So an driver in
+    // PENDING_FINISH state should should wait for pending io task's completion, then turn into
+    // FINISH state, otherwise, pending tasks shall reference to destructed objects in
+    // FragmentContext since FragmentContext is unregistered prematurely.
+    if (driver->pending_finish() && !driver->source_operator()->pending_finish()) {
+        driver->set_driver_state(DriverState::FINISH);
+        DriverTracer::instance()->record(driver.get(), DriverState::FINISH);
+        _dispatch_queue->put_back(driver);
+        return true;
+    } else if (driver->is_finished()) {
+        return true;
+    } else if (driver->fragment_ctx()->is_canceled() || driver->is_not_blocked()) {
+        DriverTracer::instance()->record(driver.get(), DriverState::READY);
+        _dispatch_queue->put_back(driver);
+        return true;
+    }
+    return false;
+}
+
+bool PipelineDriverPoller::_try_park(const DriverPtr& driver) {
+    if (!driver->is_ready_observed()) {
+        auto* raw_driver = driver.get();
+        driver->observe_ready([this, raw_driver]() { this->notify_ready(raw_driver); });
+    }
+    if (!driver->is_blocked_observable()) {
+        return false;
+    }
+    // the driver is parked before being checked, an event arrives after the check
+    // always finds the driver parked.
+    _parked_drivers[driver.get()] = driver;
+    if (_check_blocked_driver(driver)) {
+        _parked_drivers.erase(driver.get());
+    }
+    return true;
+}
+
 void PipelineDriverPoller::run_internal() {
     this->_polling_thread = Thread::current_thread();
     this->_is_polling_thread_initialized.store(true, std::memory_order_release);
     typeof(this->_blocked_drivers) local_blocked_drivers;
+    typeof(this->_blocked_drivers) new_blocked_drivers;
+    std::vector<PipelineDriver*> local_ready_drivers;
+    auto last_check_parked_time = std::chrono::steady_clock::now();
     int spin_count = 0;
     while (!_is_shutdown.load(std::memory_order_acquire)) {
         {
             std::unique_lock<std::mutex> lock(this->_mutex);
-            local_blocked_drivers.splice(local_blocked_drivers.end(), _blocked_drivers);
-            if (local_blocked_drivers.empty() && _blocked_drivers.empty()) {
-                _cond.wait(lock, [this]() {
-                    return !this->_is_shutdown.load(std::memory_order_acquire) && !this->_blocked_drivers.empty();
-                });
+            if (local_blocked_drivers.empty() && _blocked_drivers.empty() && _ready_drivers.empty()) {
+                auto wake_up = [this]() {
+                    return this->_is_shutdown.load(std::memory_order_acquire) || !this->_blocked_drivers.empty() ||
+                           !this->_ready_drivers.empty();
+                };
+                if (_parked_drivers.empty()) {
+                    _cond.wait(lock, wake_up);
+                } else {
+                    _cond.wait_for(lock, std::chrono::milliseconds(PARKED_DRIVERS_CHECK_INTERVAL_MS), wake_up);
+                }
                 if (_is_shutdown.load(std::memory_order_acquire)) {
                     break;
                 }
-                local_blocked_drivers.splice(local_blocked_drivers.end(), _blocked_drivers);
+            }
+            new_blocked_drivers.splice(new_blocked_drivers.end(), _blocked_drivers);
+            local_ready_drivers.swap(_ready_drivers);
+        }
+
+        // newly blocked drivers are parked if possible, otherwise polled.
+        for (auto& driver : new_blocked_drivers) {
+            if (!_try_park(driver)) {
+                local_blocked_drivers.push_back(driver);
+            }
+        }
+        new_blocked_drivers.clear();
+
+        // only the parked drivers that have been notified are checked.
+        for (auto* raw_driver : local_ready_drivers) {
+            auto it = _parked_drivers.find(raw_driver);
+            if (it != _parked_drivers.end() && _check_blocked_driver(it->second)) {
+                _parked_drivers.erase(it);
+            }
+        }
+        local_ready_drivers.clear();
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_check_parked_time >= std::chrono::milliseconds(PARKED_DRIVERS_CHECK_INTERVAL_MS)) {
+            last_check_parked_time = now;
+            for (auto it = _parked_drivers.begin(); it != _parked_drivers.end();) {
+                if (_check_blocked_driver(it->second)) {
+                    it = _parked_drivers.erase(it);
+                } else {
+                    ++it;
+                }
             }
         }
+
         size_t previous_num_blocked_drivers = local_blocked_drivers.size();
         auto driver_it = local_blocked_drivers.begin();
         while (driver_it != local_blocked_drivers.end()) {
-            auto& driver = *driver_it;
-            // driver->pending_finish() return true means that when a driver's sink operator is finished,
-            // but its source operator still has pending io task that executed in io threads and has
-            // reference to object outside(such as desc_tbl) owned by FragmentContext. So an driver in
-            // PENDING_FINISH state should should wait for pending io task's completion, then turn into
-            // FINISH state, otherwise, pending tasks shall reference to destructed objects in
-            // FragmentContext since FragmentContext is unregistered prematurely.
-            if (driver->pending_finish() && !driver->source_operator()->pending_finish()) {
-                driver->set_driver_state(DriverState::FINISH);
-                _dispatch_queue->put_back(*driver_it);
-                local_blocked_drivers.erase(driver_it++);
-            } else if (driver->is_finished()) {
-                local_blocked_drivers.erase(driver_it++);
-            } else if (driver->fragment_ctx()->is_canceled() || driver->is_not_blocked()) {
-                _dispatch_queue->put_back(*driver_it);
+            if (_check_blocked_driver(*driver_it)) {
                 local_blocked_drivers.erase(driver_it++);
             } else {
                 ++driver_it;
@@ -88,5 +158,11 @@ void PipelineDriverPoller::add_blocked_driver(DriverPtr driver) {
     this->_cond.notify_one();
 }
 
+void PipelineDriverPoller::notify_ready(PipelineDriver* driver) {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    this->_ready_drivers.push_back(driver);
+    this->_cond.notify_one();
+}
+
 } // namespace pipeline
 } // namespace starrocks
@@ -7,6 +7,8 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "pipeline_driver.h"
 #include "pipeline_driver_queue.h"
@@ -31,9 +33,22 @@ public:
     void shutdown();
     // add blocked driver to poller
     void add_blocked_driver(DriverPtr driver);
+    // invoked by the observers registered on operators when the driver may be unblocked,
+    // the driver is only a key to find the parked driver and never dereferenced here, because
+    // the observer may be invoked after the driver is finished.
+    void notify_ready(PipelineDriver* driver);
+
+    // interval to re-check all the parked drivers, for the sake of the cancellation of fragments
+    // that is not observable.
+    static constexpr int64_t PARKED_DRIVERS_CHECK_INTERVAL_MS = 10;
 
 private:
     void run_internal();
+    // park the driver if it can be woken up by the operator it's blocked on.
+    bool _try_park(const DriverPtr& driver);
+    // return true if the driver leaves the blocked state, i.e. has been put back into
+    // _dispatch_queue or finished.
+    bool _check_blocked_driver(const DriverPtr& driver);
     PipelineDriverPoller(const PipelineDriverPoller&) = delete;
     PipelineDriverPoller& operator=(const PipelineDriverPoller&) = delete;
 
@@ -41,6 +56,9 @@ private:
     std::mutex _mutex;
     std::condition_variable _cond;
     DriverList _blocked_drivers;
+    std::vector<PipelineDriver*> _ready_drivers;
+    // drivers blocked on observable operators, owned by polling thread.
+    std::unordered_map<PipelineDriver*, DriverPtr> _parked_drivers;
     DriverQueue* _dispatch_queue;
     Thread* _polling_thread;
     std::atomic<bool> _is_polling_thread_initialized;
@@ -3,6 +3,7 @@
 #include "exec/pipeline/pipeline_driver_queue.h"
 
 #include "gutil/strings/substitute.h"
+#include "util/time.h"
 namespace starrocks {
 namespace pipeline {
 void QuerySharedDriverQueue::put_back(const DriverPtr& driver) {
@@ -60,5 +61,223 @@ SubQuerySharedDriverQueue* QuerySharedDriverQueue::get_sub_queue(size_t index) {
     return _queues + index;
 }
 
+WorkStealingDriverQueue::WorkStealingDriverQueue(size_t num_local_queues)
+        : _num_local_queues(std::max<size_t>(1, num_local_queues)),
+          _local_queues(new LocalQueue[_num_local_queues]) {
+    double factor = 1;
+    for (int i = QUEUE_SIZE - 1; i >= 0; --i) {
+        _levels[i].factor_for_normal = factor;
+        factor *= RATIO_OF_ADJACENT_QUEUE;
+    }
+}
+
+void WorkStealingDriverQueue::put_back(const DriverPtr& driver) {
+    _put_back(driver, _next_local_index.fetch_add(1, std::memory_order_relaxed) % _num_local_queues);
+}
+
+void WorkStealingDriverQueue::put_back_from_worker(const DriverPtr& driver, int worker_id) {
+    if (worker_id < 0) {
+        put_back(driver);
+        return;
+    }
+    _put_back(driver, worker_id % _num_local_queues);
+}
+
+void WorkStealingDriverQueue::_put_back(const DriverPtr& driver, size_t local_index) {
+    int level = driver->driver_acct().get_level();
+    auto& local_queue = _local_queues[local_index];
+    {
+        std::lock_guard<std::mutex> lock(local_queue.mutex);
+        local_queue.levels[level % QUEUE_SIZE].emplace_back(driver);
+        local_queue.num_drivers.fetch_add(1);
+    }
+    // Pair with the check of _num_drivers in take_for_worker: either the parking worker sees the new
+    // driver, or this thread sees the parked worker and wakes it up.
+    _num_drivers.fetch_add(1);
+    if (_num_parked_workers.load() > 0) {
+        std::lock_guard<std::mutex> lock(_park_mutex);
+        _park_cv.notify_one();
+    }
+}
+
+DriverPtr WorkStealingDriverQueue::_try_take_from(size_t local_index, bool try_lock, size_t* queue_index) {
+    auto& local_queue = _local_queues[local_index];
+    if (local_queue.num_drivers.load() == 0) {
+        return nullptr;
+    }
+    std::unique_lock<std::mutex> lock(local_queue.mutex, std::defer_lock);
+    if (try_lock) {
+        if (!lock.try_lock()) {
+            return nullptr;
+        }
+    } else {
+        lock.lock();
+    }
+
+    int queue_idx = -1;
+    double target_accu_time = 0;
+    for (int i = 0; i < QUEUE_SIZE; ++i) {
+        if (!local_queue.levels[i].empty()) {
+            double local_target_time = _levels[i].accu_time_after_divisor();
+            if (queue_idx < 0 || local_target_time < target_accu_time) {
+                target_accu_time = local_target_time;
+                queue_idx = i;
+            }
+        }
+    }
+    if (queue_idx < 0) {
+        return nullptr;
+    }
+
+    DriverPtr driver_ptr = std::move(local_queue.levels[queue_idx].front());
+    local_queue.levels[queue_idx].pop_front();
+    local_queue.num_drivers.fetch_sub(1);
+    _num_drivers.fetch_sub(1);
+    *queue_index = queue_idx;
+    return driver_ptr;
+}
+
+DriverPtr WorkStealingDriverQueue::take(size_t* queue_index) {
+    return take_for_worker(_next_local_index.fetch_add(1, std::memory_order_relaxed) % _num_local_queues,
+                           queue_index);
+}
+
+DriverPtr WorkStealingDriverQueue::take_for_worker(int worker_id, size_t* queue_index) {
+    const size_t local_index = worker_id < 0 ? 0 : worker_id % _num_local_queues;
+    while (true) {
+        // local queue first
+        if (auto driver = _try_take_from(local_index, false, queue_index); driver != nullptr) {
+            return driver;
+        }
+
+        // steal from the peers, skip the peers that are holding their own locks.
+        for (size_t i = 1; i < _num_local_queues; ++i) {
+            if (auto driver = _try_take_from((local_index + i) % _num_local_queues, true, queue_index);
+                driver != nullptr) {
+                return driver;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(_park_mutex);
+        _num_parked_workers.fetch_add(1);
+        if (_num_drivers.load() == 0) {
+            _park_cv.wait(lock);
+        }
+        _num_parked_workers.fetch_sub(1);
+    }
+}
+
+SubQuerySharedDriverQueue* WorkStealingDriverQueue::get_sub_queue(size_t index) {
+    return _levels + index;
+}
+
+ResourceGroupDriverQueue::ResourceGroupDriverQueue(const std::vector<ResourceGroup*>& groups) : _groups(groups.size()) {
+    DCHECK(!groups.empty());
+    for (size_t i = 0; i < groups.size(); ++i) {
+        DCHECK_EQ(i, groups[i]->id());
+        _groups[i].group = groups[i];
+        double factor = 1;
+        for (int level = QUEUE_SIZE - 1; level >= 0; --level) {
+            _groups[i].levels[level].factor_for_normal = factor;
+            factor *= RATIO_OF_ADJACENT_QUEUE;
+        }
+    }
+}
+
+ResourceGroupDriverQueue::GroupQueue& ResourceGroupDriverQueue::_group_queue_of(const DriverPtr& driver) {
+    ResourceGroup* group = driver->query_ctx() != nullptr ? driver->query_ctx()->resource_group() : nullptr;
+    if (group == nullptr || group->id() >= _groups.size()) {
+        return _groups[0];
+    }
+    return _groups[group->id()];
+}
+
+void ResourceGroupDriverQueue::put_back(const DriverPtr& driver) {
+    int level = driver->driver_acct().get_level();
+    std::lock_guard<std::mutex> lock(_global_mutex);
+    auto& group_queue = _group_queue_of(driver);
+    if (group_queue.num_drivers == 0 && group_queue.num_running_drivers == 0) {
+        group_queue.vruntime = std::max(group_queue.vruntime, _min_vruntime);
+    }
+    group_queue.levels[level % QUEUE_SIZE].queue.emplace(driver);
+    group_queue.num_drivers++;
+    driver->driver_acct().mark_queued(MonotonicNanos());
+    _cv.notify_one();
+}
+
+DriverPtr ResourceGroupDriverQueue::take(size_t* queue_index) {
+    DriverPtr driver_ptr;
+    ResourceGroup* group = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(_global_mutex);
+        int group_idx = -1;
+        while (true) {
+            for (int i = 0; i < _groups.size(); ++i) {
+                if (!_groups[i].is_schedulable()) {
+                    continue;
+                }
+                if (group_idx < 0 || _groups[i].vruntime < _groups[group_idx].vruntime) {
+                    group_idx = i;
+                }
+            }
+            if (group_idx >= 0) {
+                break;
+            }
+            // woken up by put_back or release.
+            _cv.wait(lock);
+        }
+
+        auto& group_queue = _groups[group_idx];
+        int level_idx = -1;
+        double target_accu_time = 0;
+        for (int i = 0; i < QUEUE_SIZE; ++i) {
+            if (!group_queue.levels[i].queue.empty()) {
+                double local_target_time = group_queue.levels[i].accu_time_after_divisor();
+                if (level_idx < 0 || local_target_time < target_accu_time) {
+                    target_accu_time = local_target_time;
+                    level_idx = i;
+                }
+            }
+        }
+        DCHECK_GE(level_idx, 0);
+        driver_ptr = group_queue.levels[level_idx].queue.front();
+        group_queue.levels[level_idx].queue.pop();
+        group_queue.num_drivers--;
+        group_queue.num_running_drivers++;
+        _min_vruntime = group_queue.vruntime;
+        group = group_queue.group;
+        *queue_index = group_idx * QUEUE_SIZE + level_idx;
+    }
+
+    group->incr_queue_wait_time(driver_ptr->driver_acct().update_queue_wait_time(MonotonicNanos()));
+    return driver_ptr;
+}
+
+SubQuerySharedDriverQueue* ResourceGroupDriverQueue::get_sub_queue(size_t index) {
+    return _groups[index / QUEUE_SIZE].levels + index % QUEUE_SIZE;
+}
+
+void ResourceGroupDriverQueue::release(const DriverPtr& driver, size_t queue_index, bool is_processed) {
+    auto& group_queue = _groups[queue_index / QUEUE_SIZE];
+    const int64_t time_spent = is_processed ? driver->driver_acct().get_last_time_spent() : 0;
+    if (is_processed) {
+        group_queue.levels[queue_index % QUEUE_SIZE].update_accu_time(driver);
+        group_queue.group->incr_cpu_time(time_spent);
+    }
+
+    std::lock_guard<std::mutex> lock(_global_mutex);
+    group_queue.num_running_drivers--;
+    group_queue.vruntime += static_cast<double>(time_spent) / group_queue.group->cpu_weight();
+    // the drivers of the group may be blocked by the concurrency limit.
+    if (group_queue.num_drivers > 0) {
+        _cv.notify_one();
+    }
+}
+
+size_t ResourceGroupDriverQueue::num_running_drivers(size_t group_id) {
+    std::lock_guard<std::mutex> lock(_global_mutex);
+    return _groups[group_id].num_running_drivers;
+}
+
 } // namespace pipeline
-} // namespace starrocks
\ No newline at end of file
+} // namespace starrocks
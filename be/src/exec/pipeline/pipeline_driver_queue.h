@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include <deque>
 #include <queue>
 
 #include "exec/pipeline/pipeline_driver.h"
+#include "exec/pipeline/resource_group.h"
 #include "util/factory_method.h"
 namespace starrocks {
 namespace pipeline {
@@ -33,6 +35,20 @@ public:
     virtual DriverPtr take(size_t* queue_index) = 0;
     virtual ~DriverQueue(){};
     virtual SubQuerySharedDriverQueue* get_sub_queue(size_t) = 0;
+
+    // put_back_from_worker and take_for_worker are invoked by the dispatcher thread identified by
+    // worker_id, implementations that keep per-worker state use worker_id to pick the local queue,
+    // the others just ignore it.
+    virtual void put_back_from_worker(const DriverPtr& driver, int worker_id) { put_back(driver); }
+    virtual DriverPtr take_for_worker(int worker_id, size_t* queue_index) { return take(queue_index); }
+
+    // Invoked by the dispatcher once it's done with the driver taken from the queue, before the driver is
+    // put back or blocked. is_processed is false if the driver is finalized without being processed.
+    virtual void release(const DriverPtr& driver, size_t queue_index, bool is_processed) {
+        if (is_processed) {
+            get_sub_queue(queue_index)->update_accu_time(driver);
+        }
+    }
 };
 
 class QuerySharedDriverQueue : public FactoryMethod<DriverQueue, QuerySharedDriverQueue> {
@@ -65,5 +81,103 @@ private:
     std::atomic<bool> _is_empty;
 };
 
+// WorkStealingDriverQueue keeps one local multi-level queue per dispatcher worker, so a worker only
+// contends with the others when its local queue runs dry and it has to steal drivers from its peers.
+// The accumulated time of each level is shared by all the local queues, so the multi-level feedback
+// priority is identical to the one of QuerySharedDriverQueue.
+class WorkStealingDriverQueue : public FactoryMethod<DriverQueue, WorkStealingDriverQueue> {
+    friend class FactoryMethod<DriverQueue, WorkStealingDriverQueue>;
+
+public:
+    explicit WorkStealingDriverQueue(size_t num_local_queues);
+    ~WorkStealingDriverQueue() override = default;
+
+    static const size_t QUEUE_SIZE = QuerySharedDriverQueue::QUEUE_SIZE;
+    static constexpr double RATIO_OF_ADJACENT_QUEUE = QuerySharedDriverQueue::RATIO_OF_ADJACENT_QUEUE;
+
+    // put_back is invoked by the threads except dispatcher workers, such as PipelineDriverPoller,
+    // the drivers are distributed among local queues in round-robin fashion.
+    void put_back(const DriverPtr& driver) override;
+    void put_back_from_worker(const DriverPtr& driver, int worker_id) override;
+    DriverPtr take(size_t* queue_index) override;
+    DriverPtr take_for_worker(int worker_id, size_t* queue_index) override;
+    // The returned SubQuerySharedDriverQueue is only used to accumulate time of the level,
+    // its queue is always empty.
+    SubQuerySharedDriverQueue* get_sub_queue(size_t index) override;
+
+    size_t num_local_queues() const { return _num_local_queues; }
+
+private:
+    struct LocalQueue {
+        std::mutex mutex;
+        std::deque<DriverPtr> levels[QUEUE_SIZE];
+        std::atomic<size_t> num_drivers{0};
+    };
+
+    void _put_back(const DriverPtr& driver, size_t local_index);
+    // Pop a driver from the level with the least normalized accumulated time, when try_lock is true,
+    // give up immediately if the local queue is locked by another thread.
+    DriverPtr _try_take_from(size_t local_index, bool try_lock, size_t* queue_index);
+
+    const size_t _num_local_queues;
+    std::unique_ptr<LocalQueue[]> _local_queues;
+    SubQuerySharedDriverQueue _levels[QUEUE_SIZE];
+    std::atomic<size_t> _next_local_index{0};
+
+    // number of drivers in all local queues, workers only park when it drops to zero.
+    std::atomic<size_t> _num_drivers{0};
+    std::atomic<size_t> _num_parked_workers{0};
+    std::mutex _park_mutex;
+    std::condition_variable _park_cv;
+};
+
+// ResourceGroupDriverQueue shares the worker threads among the resource groups. Each group has its own
+// multi-level queue, a worker takes a driver from the group with the least cpu time normalized by its
+// cpu weight among the groups below their concurrency limits, then from the level of the group just
+// like QuerySharedDriverQueue.
+class ResourceGroupDriverQueue : public FactoryMethod<DriverQueue, ResourceGroupDriverQueue> {
+    friend class FactoryMethod<DriverQueue, ResourceGroupDriverQueue>;
+
+public:
+    // groups[i]->id() must be i, and groups[0] is the default group.
+    explicit ResourceGroupDriverQueue(const std::vector<ResourceGroup*>& groups);
+    ~ResourceGroupDriverQueue() override = default;
+
+    static const size_t QUEUE_SIZE = QuerySharedDriverQueue::QUEUE_SIZE;
+    static constexpr double RATIO_OF_ADJACENT_QUEUE = QuerySharedDriverQueue::RATIO_OF_ADJACENT_QUEUE;
+
+    void put_back(const DriverPtr& driver) override;
+    // queue_index is group_id * QUEUE_SIZE + level.
+    DriverPtr take(size_t* queue_index) override;
+    SubQuerySharedDriverQueue* get_sub_queue(size_t index) override;
+    void release(const DriverPtr& driver, size_t queue_index, bool is_processed) override;
+
+    size_t num_running_drivers(size_t group_id);
+
+private:
+    struct GroupQueue {
+        ResourceGroup* group = nullptr;
+        SubQuerySharedDriverQueue levels[QUEUE_SIZE];
+        size_t num_drivers = 0;
+        int64_t num_running_drivers = 0;
+        // the cpu time of the group normalized by its cpu weight.
+        double vruntime = 0;
+
+        bool is_schedulable() const {
+            const int64_t limit = group->concurrency_limit();
+            return num_drivers > 0 && (limit <= 0 || num_running_drivers < limit);
+        }
+    };
+
+    GroupQueue& _group_queue_of(const DriverPtr& driver);
+
+    std::mutex _global_mutex;
+    std::condition_variable _cv;
+    std::vector<GroupQueue> _groups;
+    // the vruntime of the group scheduled last time, the group becoming active inherits it,
+    // so that an idle group can't monopolize the workers by its historical low cpu time.
+    double _min_vruntime = 0;
+};
+
 } // namespace pipeline
 } // namespace starrocks
\ No newline at end of file
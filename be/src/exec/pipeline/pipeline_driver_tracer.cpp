@@ -0,0 +1,175 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/pipeline_driver_tracer.h"
+
+#include <algorithm>
+#include <map>
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+#include "util/thread.h"
+#include "util/time.h"
+#include "util/uid_util.h"
+
+namespace starrocks::pipeline {
+
+DriverTracer* DriverTracer::instance() {
+    static DriverTracer tracer;
+    return &tracer;
+}
+
+void DriverTracer::ThreadBuffer::copy_events(std::vector<Event>* events) const {
+    uint64_t end = num_events.load(std::memory_order_acquire);
+    uint64_t begin = end > kEventsPerThread ? end - kEventsPerThread : 0;
+    size_t old_size = events->size();
+    for (uint64_t i = begin; i < end; ++i) {
+        events->emplace_back(this->events[i % kEventsPerThread]);
+    }
+    // The events overwritten by the owner while being copied are dropped, including the one being written.
+    uint64_t new_end = num_events.load(std::memory_order_acquire) + 1;
+    uint64_t num_overwritten = new_end > begin + kEventsPerThread ? new_end - begin - kEventsPerThread : 0;
+    num_overwritten = std::min<uint64_t>(num_overwritten, end - begin);
+    events->erase(events->begin() + old_size, events->begin() + old_size + num_overwritten);
+}
+
+DriverTracer::ThreadBuffer* DriverTracer::_thread_buffer() {
+    // The buffers are owned by the tracer and kept after their threads exit, so the events are still available.
+    static thread_local ThreadBuffer* tls_buffer = nullptr;
+    if (tls_buffer == nullptr) {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        buffer->thread_id = Thread::current_thread_id();
+        std::lock_guard<std::mutex> l(_mutex);
+        _buffers.emplace_back(buffer);
+        tls_buffer = buffer.get();
+    }
+    return tls_buffer;
+}
+
+void DriverTracer::_record(PipelineDriver* driver, DriverState state) {
+    ThreadBuffer* buffer = _thread_buffer();
+    uint64_t index = buffer->num_events.load(std::memory_order_relaxed);
+    Event& event = buffer->events[index % kEventsPerThread];
+    auto* fragment_ctx = driver->fragment_ctx();
+    event.time_ns = MonotonicNanos();
+    event.query_id_hi = fragment_ctx->query_id().hi;
+    event.query_id_lo = fragment_ctx->query_id().lo;
+    event.fragment_instance_id_hi = fragment_ctx->fragment_instance_id().hi;
+    event.fragment_instance_id_lo = fragment_ctx->fragment_instance_id().lo;
+    event.driver = driver;
+    event.driver_id = driver->driver_id();
+    event.source_node_id = driver->source_node_id();
+    event.state = state;
+    buffer->num_events.store(index + 1, std::memory_order_release);
+}
+
+static std::string print_id_of(int64_t hi, int64_t lo) {
+    TUniqueId id;
+    id.__set_hi(hi);
+    id.__set_lo(lo);
+    return print_id(id);
+}
+
+std::string DriverTracer::chrome_trace(const std::string& query_id) const {
+    // the events of each driver ordered by time, with the threads recording them
+    std::map<const void*, std::vector<std::pair<Event, int64_t>>> driver_events;
+    {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            buffers = _buffers;
+        }
+        std::vector<Event> events;
+        for (const auto& buffer : buffers) {
+            events.clear();
+            buffer->copy_events(&events);
+            for (const auto& event : events) {
+                if (print_id_of(event.query_id_hi, event.query_id_lo) == query_id) {
+                    driver_events[event.driver].emplace_back(event, buffer->thread_id);
+                }
+            }
+        }
+    }
+
+    rapidjson::StringBuffer json;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(json);
+    auto write_metadata = [&writer](const char* name, int64_t pid, int64_t tid, const std::string& value) {
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(name);
+        writer.Key("ph");
+        writer.String("M");
+        writer.Key("pid");
+        writer.Int64(pid);
+        writer.Key("tid");
+        writer.Int64(tid);
+        writer.Key("args");
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(value.c_str());
+        writer.EndObject();
+        writer.EndObject();
+    };
+    auto write_span = [&writer](const std::string& name, int64_t pid, int64_t tid, int64_t begin_ns, int64_t end_ns) {
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(name.c_str());
+        writer.Key("ph");
+        writer.String("X");
+        writer.Key("pid");
+        writer.Int64(pid);
+        writer.Key("tid");
+        writer.Int64(tid);
+        writer.Key("ts");
+        writer.Double(begin_ns / 1000.0);
+        writer.Key("dur");
+        writer.Double((end_ns - begin_ns) / 1000.0);
+        writer.EndObject();
+    };
+
+    writer.StartObject();
+    writer.Key("traceEvents");
+    writer.StartArray();
+    // pid 0 is the workers, and the fragment instances are numbered from 1.
+    write_metadata("process_name", 0, 0, "workers");
+    std::map<std::string, int64_t> instance_pids;
+    std::map<int64_t, bool> worker_tids;
+    int64_t driver_tid = 0;
+    for (auto& [driver, events] : driver_events) {
+        std::stable_sort(events.begin(), events.end(),
+                         [](const auto& lhs, const auto& rhs) { return lhs.first.time_ns < rhs.first.time_ns; });
+        const Event& first = events.front().first;
+        std::string instance_id = print_id_of(first.fragment_instance_id_hi, first.fragment_instance_id_lo);
+        auto iter = instance_pids.find(instance_id);
+        if (iter == instance_pids.end()) {
+            iter = instance_pids.emplace(instance_id, instance_pids.size() + 1).first;
+            write_metadata("process_name", iter->second, 0, "instance " + instance_id);
+        }
+        int64_t pid = iter->second;
+        std::string driver_name = "driver_" + std::to_string(first.driver_id) + "_node_" +
+                                  std::to_string(first.source_node_id);
+        write_metadata("thread_name", pid, ++driver_tid, driver_name);
+
+        for (size_t i = 0; i + 1 < events.size(); ++i) {
+            const auto& [event, thread_id] = events[i];
+            int64_t end_ns = events[i + 1].first.time_ns;
+            write_span(ds_to_string(event.state), pid, driver_tid, event.time_ns, end_ns);
+            if (event.state == DriverState::RUNNING) {
+                if (!worker_tids[thread_id]) {
+                    worker_tids[thread_id] = true;
+                    write_metadata("thread_name", 0, thread_id, "worker " + std::to_string(thread_id));
+                }
+                write_span(driver_name + " of " + instance_id, 0, thread_id, event.time_ns, end_ns);
+            }
+        }
+        // the last state lasts no time, e.g. FINISH.
+        const Event& last = events.back().first;
+        write_span(ds_to_string(last.state), pid, driver_tid, last.time_ns, last.time_ns);
+    }
+    writer.EndArray();
+    writer.Key("displayTimeUnit");
+    writer.String("ns");
+    writer.EndObject();
+    return json.GetString();
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,71 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "exec/pipeline/pipeline_driver.h"
+
+namespace starrocks::pipeline {
+
+// DriverTracer records the state transitions of the drivers of the queries with the query option
+// enable_pipeline_trace, and renders them in the trace event format of Chrome (chrome://tracing or Perfetto),
+// so the time the drivers wait in the queue, run on the workers and stay blocked can be seen on a timeline.
+//
+// Each thread writes the events into its own ring buffer without any lock, the latest kEventsPerThread events of
+// a thread are kept. The buffer of a thread is created when it records an event for the first time.
+class DriverTracer {
+public:
+    static constexpr int kEventsPerThread = 16384;
+
+    static DriverTracer* instance();
+
+    // Record that |driver| turns into |state| on this thread, if its query is traced.
+    void record(PipelineDriver* driver, DriverState state) {
+        if (driver->fragment_ctx()->enable_trace()) {
+            _record(driver, state);
+        }
+    }
+
+    // Return the events of the query printed as |query_id| as the JSON of the trace event format. The running
+    // spans are on the tracks of the worker threads under the process "workers", and the states of each driver
+    // are on its own track under the process of its fragment instance.
+    std::string chrome_trace(const std::string& query_id) const;
+
+private:
+    struct Event {
+        int64_t time_ns;
+        int64_t query_id_hi;
+        int64_t query_id_lo;
+        int64_t fragment_instance_id_hi;
+        int64_t fragment_instance_id_lo;
+        const void* driver;
+        int32_t driver_id;
+        int32_t source_node_id;
+        DriverState state;
+    };
+
+    // The events of one thread. Only the owner thread writes, readers copy the events and drop the ones it may
+    // have overwritten meanwhile.
+    struct ThreadBuffer {
+        int64_t thread_id = 0;
+        std::atomic<uint64_t> num_events{0};
+        Event events[kEventsPerThread];
+
+        void copy_events(std::vector<Event>* events) const;
+    };
+
+    DriverTracer() = default;
+
+    void _record(PipelineDriver* driver, DriverState state);
+    ThreadBuffer* _thread_buffer();
+
+    mutable std::mutex _mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+};
+
+} // namespace starrocks::pipeline
@@ -16,6 +16,7 @@
 namespace starrocks {
 class MemTracker;
 namespace pipeline {
+class ResourceGroup;
 
 // The context for all fragment of one query in one BE
 class QueryContext {
@@ -30,6 +31,14 @@ public:
     }
     bool count_down_fragment() { return _num_fragments.fetch_sub(1) == 1; }
 
+    // Set by the first prepared fragment, the drivers of the query are scheduled in this group.
+    void set_resource_group(ResourceGroup* resource_group) {
+        ResourceGroup* old_value = nullptr;
+        _resource_group.compare_exchange_strong(old_value, resource_group);
+    }
+    // nullptr means the default group.
+    ResourceGroup* resource_group() const { return _resource_group.load(); }
+
 private:
     std::unique_ptr<RuntimeState> _runtime_state;
     std::shared_ptr<RuntimeProfile> _runtime_profile;
@@ -38,6 +47,7 @@ private:
     TUniqueId _query_id;
     std::atomic<bool> _num_fragments_initialized;
     std::atomic<size_t> _num_fragments;
+    std::atomic<ResourceGroup*> _resource_group{nullptr};
 };
 
 class QueryContextManager {
@@ -0,0 +1,91 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/resource_group.h"
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gutil/strings/numbers.h"
+#include "gutil/strings/split.h"
+#include "gutil/strings/strip.h"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks::pipeline {
+
+void ResourceGroup::register_metrics(MetricRegistry* registry) {
+    MetricLabels labels = MetricLabels().add("name", _name);
+    registry->register_metric("pipeline_resource_group_cpu_time_ns", labels, &_cpu_time_ns);
+    registry->register_metric("pipeline_resource_group_queue_wait_time_ns", labels, &_queue_wait_time_ns);
+}
+
+ResourceGroupManager::ResourceGroupManager() {
+    _groups = parse(config::pipeline_resource_groups);
+    for (auto& group : _groups) {
+        _groups_by_name.emplace(group->name(), group.get());
+        group->register_metrics(StarRocksMetrics::instance()->metrics());
+    }
+}
+
+ResourceGroupManager::~ResourceGroupManager() {}
+
+ResourceGroup* ResourceGroupManager::get(const std::string& name) const {
+    auto it = _groups_by_name.find(name);
+    if (it == _groups_by_name.end()) {
+        return default_group();
+    }
+    return it->second;
+}
+
+std::vector<ResourceGroup*> ResourceGroupManager::groups() const {
+    std::vector<ResourceGroup*> groups;
+    groups.reserve(_groups.size());
+    for (const auto& group : _groups) {
+        groups.emplace_back(group.get());
+    }
+    return groups;
+}
+
+std::vector<ResourceGroupPtr> ResourceGroupManager::parse(const std::string& groups_conf) {
+    std::vector<ResourceGroupPtr> groups;
+    groups.emplace_back(std::make_unique<ResourceGroup>(0, DEFAULT_GROUP_NAME, 1, 0));
+    std::vector<std::string> group_confs = strings::Split(groups_conf, ";", strings::SkipWhitespace());
+    for (auto& group_conf : group_confs) {
+        std::vector<std::string> fields = strings::Split(group_conf, ":");
+        int64_t cpu_weight = 0;
+        int64_t concurrency_limit = 0;
+        if (fields.size() != 3) {
+            LOG(WARNING) << "Skip the invalid pipeline resource group: " << group_conf;
+            continue;
+        }
+        for (auto& field : fields) {
+            StripWhiteSpace(&field);
+        }
+        if (fields[0].empty() || !safe_strto64(fields[1], &cpu_weight) ||
+            !safe_strto64(fields[2], &concurrency_limit) || cpu_weight <= 0 || concurrency_limit < 0) {
+            LOG(WARNING) << "Skip the invalid pipeline resource group: " << group_conf;
+            continue;
+        }
+
+        size_t id = groups.size();
+        if (fields[0] == DEFAULT_GROUP_NAME) {
+            id = 0;
+        } else {
+            bool is_duplicated = false;
+            for (const auto& group : groups) {
+                is_duplicated |= group->name() == fields[0];
+            }
+            if (is_duplicated) {
+                LOG(WARNING) << "Skip the duplicated pipeline resource group: " << group_conf;
+                continue;
+            }
+        }
+        auto group = std::make_unique<ResourceGroup>(id, fields[0], cpu_weight, concurrency_limit);
+        if (id == 0) {
+            groups[0] = std::move(group);
+        } else {
+            groups.emplace_back(std::move(group));
+        }
+    }
+    return groups;
+}
+
+} // namespace starrocks::pipeline
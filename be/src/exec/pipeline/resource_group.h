@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "storage/olap_define.h"
+#include "util/metrics.h"
+
+namespace starrocks::pipeline {
+class ResourceGroup;
+using ResourceGroupPtr = std::unique_ptr<ResourceGroup>;
+
+// ResourceGroup isolates the workloads of the queries in the pipeline engine. The worker threads of
+// the dispatcher are shared by the groups in proportion to their cpu weights, and at most
+// |concurrency_limit| drivers of a group are running at the same time, 0 means no limit.
+class ResourceGroup {
+public:
+    ResourceGroup(size_t id, std::string name, int64_t cpu_weight, int64_t concurrency_limit)
+            : _id(id), _name(std::move(name)), _cpu_weight(cpu_weight), _concurrency_limit(concurrency_limit) {}
+
+    // The index of the group in ResourceGroupManager, the default group is 0.
+    size_t id() const { return _id; }
+    const std::string& name() const { return _name; }
+    int64_t cpu_weight() const { return _cpu_weight; }
+    int64_t concurrency_limit() const { return _concurrency_limit; }
+
+    void incr_cpu_time(int64_t time_ns) { _cpu_time_ns.increment(time_ns); }
+    void incr_queue_wait_time(int64_t time_ns) { _queue_wait_time_ns.increment(time_ns); }
+    int64_t cpu_time_ns() const { return _cpu_time_ns.value(); }
+    int64_t queue_wait_time_ns() const { return _queue_wait_time_ns.value(); }
+
+    void register_metrics(MetricRegistry* registry);
+
+private:
+    const size_t _id;
+    const std::string _name;
+    const int64_t _cpu_weight;
+    const int64_t _concurrency_limit;
+
+    // the time spent by the drivers of the group on the worker threads.
+    IntCounter _cpu_time_ns{MetricUnit::NANOSECONDS};
+    // the time the ready drivers of the group wait in the DriverQueue for a worker thread.
+    IntCounter _queue_wait_time_ns{MetricUnit::NANOSECONDS};
+};
+
+// ResourceGroupManager keeps the resource groups defined by config::pipeline_resource_groups,
+// the groups are immutable after the construction.
+class ResourceGroupManager {
+    DECLARE_SINGLETON(ResourceGroupManager);
+
+public:
+    static constexpr const char* DEFAULT_GROUP_NAME = "default";
+
+    // Return the default group if |name| is empty or unknown.
+    ResourceGroup* get(const std::string& name) const;
+    ResourceGroup* default_group() const { return _groups[0].get(); }
+    std::vector<ResourceGroup*> groups() const;
+    // Whether any resource group is defined besides the default one.
+    bool is_enabled() const { return _groups.size() > 1; }
+
+    // Parse the groups in the format of "name:cpu_weight:concurrency_limit" separated by ';',
+    // the invalid ones are skipped. The default group, with cpu weight 1 and no concurrency limit
+    // unless it's defined, is always the first one.
+    static std::vector<ResourceGroupPtr> parse(const std::string& groups_conf);
+
+private:
+    std::vector<ResourceGroupPtr> _groups;
+    std::unordered_map<std::string, ResourceGroup*> _groups_by_name;
+};
+
+} // namespace starrocks::pipeline
@@ -3,6 +3,7 @@
 #include "exec/pipeline/scan_operator.h"
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "exec/pipeline/olap_chunk_source.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
@@ -13,7 +14,7 @@ void ScanOperator::_pickup_morsel(RuntimeState* state) {
     if (_chunk_source) {
         _chunk_source->close(state);
     }
-    auto maybe_morsel = _morsel_queue->try_get();
+    auto maybe_morsel = _morsel_queue->try_get(_driver_sequence);
     if (!maybe_morsel.has_value()) {
         // release _chunk_source before _curr_morsel, because _chunk_source depends on _curr_morsel.
         _chunk_source = nullptr;
@@ -24,11 +25,17 @@ void ScanOperator::_pickup_morsel(RuntimeState* state) {
         _chunk_source = starrocks::make_exclusive<OlapChunkSource>(
                 std::move(morsel), _olap_scan_node.tuple_id, _conjunct_ctxs, _runtime_filters,
                 _olap_scan_node.key_column_name, _olap_scan_node.is_preaggregation);
-        _chunk_source->prepare(state);
-        _trigger_read_chunk();
+        if (_io_threads == nullptr) {
+            // the failure is kept by the chunk source and returned by get_next_chunk().
+            _chunk_source->prepare(state);
+        } else {
+            // initializing the storage reader also does io, so it's done by the io task too.
+            _trigger_read_chunk(state, true);
+        }
     }
 }
-void ScanOperator::_trigger_read_chunk() {
+
+void ScanOperator::_trigger_read_chunk(RuntimeState* state, bool need_prepare) {
     if (_io_threads == nullptr) {
         return;
     }
@@ -40,9 +47,18 @@ void ScanOperator::_trigger_read_chunk() {
     _pending_chunk_source_future = chunk_source_promise->get_future();
     PriorityThreadPool::Task task;
 
-    task.work_function = [chunk_source, chunk_source_promise]() {
-        chunk_source->cache_next_chunk_blocking();
+    auto observable = _observable;
+    const size_t max_chunks = std::max<int64_t>(1, config::pipeline_scan_prefetch_max_chunks);
+    const int64_t max_bytes = std::max<int64_t>(1, config::pipeline_scan_prefetch_max_bytes - _prefetched_bytes);
+    MemTracker* mem_tracker = get_memtracker();
+    task.work_function = [chunk_source, chunk_source_promise, observable, state, need_prepare, max_chunks,
+                          max_bytes, mem_tracker]() {
+        if (need_prepare) {
+            chunk_source->prepare(state);
+        }
+        chunk_source->cache_next_chunks_blocking(max_chunks, max_bytes, mem_tracker);
         chunk_source_promise->set_value(chunk_source);
+        observable->notify_observers();
     };
     // TODO(by satanson): set a proper priority
     task.priority = 20;
@@ -51,8 +67,45 @@ void ScanOperator::_trigger_read_chunk() {
     // io task is pending
     DCHECK(_pending_chunk_source_future.has_value());
 }
+
+void ScanOperator::_try_read_ahead(RuntimeState* state) {
+    if (_is_finished || _pending_chunk_source_future.has_value() || !_chunk_source || !_io_status.ok()) {
+        return;
+    }
+    if (_prefetched_bytes < config::pipeline_scan_prefetch_max_bytes) {
+        _trigger_read_chunk(state, false);
+    }
+}
+
+void ScanOperator::_try_take_io_result(RuntimeState* state) {
+    if (!_pending_chunk_source_future.has_value() ||
+        _pending_chunk_source_future.value().wait_for(std::chrono::seconds::zero()) != std::future_status::ready) {
+        return;
+    }
+    _chunk_source = _pending_chunk_source_future.value().get();
+    _pending_chunk_source_future = {};
+
+    std::vector<vectorized::ChunkPtr> chunks;
+    Status status = _chunk_source->take_cached_chunks(&chunks);
+    for (auto& chunk : chunks) {
+        _prefetched_bytes += chunk->memory_usage();
+        _prefetched_chunks.emplace(std::move(chunk));
+    }
+    if (status.ok()) {
+        // read ahead again at once, so that the io of the next chunks overlaps with the processing
+        // of the prefetched chunks.
+        _try_read_ahead(state);
+    } else if (status.is_end_of_file()) {
+        // the next morsel is prefetched while the remaining chunks of this morsel are processed.
+        _pickup_morsel(state);
+    } else {
+        _io_status = status;
+    }
+}
+
 Status ScanOperator::prepare(RuntimeState* state) {
     Operator::prepare(state);
+    _runtime_state = state;
     RowDescriptor row_desc;
     RETURN_IF_ERROR(Expr::prepare(_conjunct_ctxs, state, row_desc, get_memtracker()));
     RETURN_IF_ERROR(Expr::open(_conjunct_ctxs, state));
@@ -88,17 +141,8 @@ bool ScanOperator::_has_output_blocking() {
 
 bool ScanOperator::_has_output_nonblocking() {
     DCHECK(_io_threads != nullptr);
-    // EOS has arrived
-    if (_is_finished) {
-        return false;
-    }
-    DCHECK(_pending_chunk_source_future.has_value());
-    // submitted io task has not completed yet
-    if (_pending_chunk_source_future.value().wait_for(std::chrono::seconds::zero()) != std::future_status::ready) {
-        return false;
-    }
-    // submitted io task has already completed
-    return true;
+    _try_take_io_result(_runtime_state);
+    return !_prefetched_chunks.empty() || !_io_status.ok();
 }
 
 bool ScanOperator::has_output() {
@@ -129,12 +173,22 @@ bool ScanOperator::pending_finish() {
     return false;
 }
 
+bool ScanOperator::add_ready_observer(const ReadyObserver& observer) {
+    if (_io_threads == nullptr) {
+        return false;
+    }
+    _observable->add_observer(observer);
+    return true;
+}
+
 bool ScanOperator::is_finished() const {
-    return _is_finished;
+    return _is_finished && _prefetched_chunks.empty();
 }
 
 void ScanOperator::finish(RuntimeState* state) {
     _is_finished = true;
+    _prefetched_chunks = {};
+    _prefetched_bytes = 0;
     if (_chunk_source) {
         _chunk_source->close(state);
     }
@@ -156,26 +210,23 @@ StatusOr<vectorized::ChunkPtr> ScanOperator::_pull_chunk_blocking(RuntimeState*
 
 StatusOr<vectorized::ChunkPtr> ScanOperator::_pull_chunk_nonblocking(RuntimeState* state) {
     DCHECK(_io_threads != nullptr);
-    if (_is_finished) {
-        return Status::EndOfFile("End-Of-Stream");
-    }
-
-    _chunk_source = _pending_chunk_source_future.value().get();
-    _pending_chunk_source_future = {};
-    auto chunk = _chunk_source->get_next_chunk_nonblocking();
-    if (chunk.ok()) {
-        _trigger_read_chunk();
-        return chunk;
+    _try_take_io_result(state);
+    if (!_io_status.ok()) {
+        return _io_status;
     }
-    if (!chunk.status().is_end_of_file()) {
-        return chunk;
+    if (_prefetched_chunks.empty()) {
+        if (_is_finished) {
+            return Status::EndOfFile("End-Of-Stream");
+        }
+        // the pending io task has not completed yet.
+        return nullptr;
     }
-    // Now ScanOperator can process multiple morsels, when the non-last morsel is
-    // processed and the EndOfFile is encountered, then ScanOperator has no chunk
-    // to output and should pick up next morsel. so here return nullptr instead of
-    // empty chunk.
-    _pickup_morsel(state);
-    return nullptr;
+
+    vectorized::ChunkPtr chunk = std::move(_prefetched_chunks.front());
+    _prefetched_chunks.pop();
+    _prefetched_bytes -= chunk->memory_usage();
+    _try_read_ahead(state);
+    return std::move(chunk);
 }
 
 StatusOr<vectorized::ChunkPtr> ScanOperator::pull_chunk(RuntimeState* state) {
@@ -3,10 +3,11 @@
 #pragma once
 
 #include <optional>
+#include <queue>
 
 #include "exec/pipeline/source_operator.h"
 #include "exprs/vectorized/runtime_filter_bank.h"
-#include "util/priority_thread_pool.hpp"
+#include "util/work_stealing_priority_thread_pool.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -15,10 +16,11 @@ class RuntimeFilterProbeCollector;
 namespace pipeline {
 class ScanOperator final : public SourceOperator {
 public:
-    ScanOperator(int32_t id, int32_t plan_node_id, const TOlapScanNode& olap_scan_node,
+    ScanOperator(int32_t id, int32_t plan_node_id, int32_t driver_sequence, const TOlapScanNode& olap_scan_node,
                  const std::vector<ExprContext*>& conjunct_ctxs,
                  const vectorized::RuntimeFilterProbeCollector& runtime_filters)
             : SourceOperator(id, "olap_scan", plan_node_id),
+              _driver_sequence(driver_sequence),
               _olap_scan_node(olap_scan_node),
               _conjunct_ctxs(conjunct_ctxs),
               _runtime_filters(runtime_filters) {}
@@ -38,11 +40,17 @@ public:
     void finish(RuntimeState* state) override;
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
-    void set_io_threads(PriorityThreadPool* io_threads) { _io_threads = io_threads; }
+    void set_io_threads(WorkStealingPriorityThreadPool* io_threads) { _io_threads = io_threads; }
+
+    // Only the asynchronous io task is observable, it notifies the observers on completion.
+    bool add_ready_observer(const ReadyObserver& observer) override;
 
 private:
     void _pickup_morsel(RuntimeState* state);
-    void _trigger_read_chunk();
+    // Submit an io task to read the next chunks ahead, and prepare the chunk source first if |need_prepare|.
+    void _trigger_read_chunk(RuntimeState* state, bool need_prepare);
+    void _try_read_ahead(RuntimeState* state);
+    void _try_take_io_result(RuntimeState* state);
     bool _has_output_blocking();
     bool _has_output_nonblocking();
     StatusOr<vectorized::ChunkPtr> _pull_chunk_blocking(RuntimeState* state);
@@ -50,11 +58,21 @@ private:
 
 private:
     bool _is_finished = false;
+    // identify the driver when picking up morsels from the MorselQueue.
+    const int32_t _driver_sequence;
     const TOlapScanNode& _olap_scan_node;
     const std::vector<ExprContext*>& _conjunct_ctxs;
     const vectorized::RuntimeFilterProbeCollector& _runtime_filters;
-    PriorityThreadPool* _io_threads = nullptr;
+    WorkStealingPriorityThreadPool* _io_threads = nullptr;
     OptionalChunkSourceFuture _pending_chunk_source_future;
+    RuntimeState* _runtime_state = nullptr;
+    // The chunks read ahead by the io tasks, at most pipeline_scan_prefetch_max_bytes are prefetched.
+    std::queue<vectorized::ChunkPtr> _prefetched_chunks;
+    int64_t _prefetched_bytes = 0;
+    // The failure of the io task, returned after it's encountered.
+    Status _io_status;
+    // shared with the pending io task, which may complete after the operator is closed.
+    std::shared_ptr<Observable> _observable = std::make_shared<Observable>();
 };
 
 class ScanOperatorFactory final : public OperatorFactory {
@@ -70,7 +88,8 @@ public:
     ~ScanOperatorFactory() override = default;
 
     OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
-        return std::make_shared<ScanOperator>(_id, _plan_node_id, _olap_scan_node, _conjunct_ctxs, _runtime_filters);
+        return std::make_shared<ScanOperator>(_id, _plan_node_id, driver_sequence, _olap_scan_node, _conjunct_ctxs,
+                                              _runtime_filters);
     }
 
     bool is_source() const override { return true; }
@@ -0,0 +1,47 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/except_build_sink_operator.h"
+
+#include "column/chunk.h"
+#include "exprs/expr.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status ExceptBuildSinkOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), _t_exprs, &_exprs));
+    RETURN_IF_ERROR(Expr::prepare(_exprs, state, _child_row_desc, get_memtracker()));
+    RETURN_IF_ERROR(Expr::open(_exprs, state));
+    _except_context->prepare_partition(_partition, get_memtracker());
+    return Status::OK();
+}
+
+Status ExceptBuildSinkOperator::close(RuntimeState* state) {
+    Expr::close(_exprs, state);
+    _except_context->unref(_partition);
+    return Operator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> ExceptBuildSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from except build sink.");
+}
+
+Status ExceptBuildSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    if (chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    return _except_context->build(state, _partition, chunk, _exprs);
+}
+
+void ExceptBuildSinkOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+    // The drivers of the next stages still need to be woken up to exit once the fragment is cancelled.
+    Status status = state->is_cancelled() ? Status::Cancelled("Cancelled before building") : Status::OK();
+    _except_context->finish_stage(_partition, status);
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/pipeline/set/except_context.h"
+
+namespace starrocks::pipeline {
+
+// ExceptBuildSinkOperator builds the hash set of the partition of its driver by the first child,
+// see ExceptContext.
+class ExceptBuildSinkOperator final : public Operator {
+public:
+    ExceptBuildSinkOperator(int32_t id, int32_t plan_node_id, ExceptContextPtr except_context,
+                            const std::vector<TExpr>& t_exprs, const RowDescriptor& child_row_desc, int32_t partition)
+            : Operator(id, "except_build_sink", plan_node_id),
+              _except_context(std::move(except_context)),
+              _t_exprs(t_exprs),
+              _child_row_desc(child_row_desc),
+              _partition(partition) {}
+
+    ~ExceptBuildSinkOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return false; }
+
+    bool need_input() override { return !is_finished(); }
+
+    bool is_finished() const override { return _is_finished; }
+
+    void finish(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    ExceptContextPtr _except_context;
+    const std::vector<TExpr>& _t_exprs;
+    const RowDescriptor& _child_row_desc;
+    const int32_t _partition;
+    std::vector<ExprContext*> _exprs;
+    bool _is_finished = false;
+};
+
+class ExceptBuildSinkOperatorFactory final : public OperatorFactory {
+public:
+    ExceptBuildSinkOperatorFactory(int32_t id, int32_t plan_node_id, ExceptContextPtr except_context,
+                                   const std::vector<TExpr>& t_exprs, const RowDescriptor& child_row_desc)
+            : OperatorFactory(id, plan_node_id),
+              _except_context(std::move(except_context)),
+              _t_exprs(t_exprs),
+              _child_row_desc(child_row_desc) {}
+
+    ~ExceptBuildSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        DCHECK_EQ(driver_instance_count, _except_context->num_partitions());
+        return std::make_shared<ExceptBuildSinkOperator>(_id, _plan_node_id, _except_context, _t_exprs, _child_row_desc,
+                                                         driver_sequence);
+    }
+
+private:
+    ExceptContextPtr _except_context;
+    const std::vector<TExpr> _t_exprs;
+    const RowDescriptor& _child_row_desc;
+};
+
+} // namespace starrocks::pipeline
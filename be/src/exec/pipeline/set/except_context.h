@@ -0,0 +1,81 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "exec/pipeline/observable.h"
+#include "exec/vectorized/except_node.h"
+
+namespace starrocks::pipeline {
+
+class ExceptContext;
+using ExceptContextPtr = std::shared_ptr<ExceptContext>;
+
+// ExceptContext is shared by all the drivers of one except node, whose rows are partitioned and processed in stages
+// as the ones of IntersectContext:
+//  - stage 0, ExceptBuildSinkOperator builds the hash set by the keys of the first child.
+//  - stage i, ExceptProbeSinkOperator marks the keys of the i-th child deleted from the hash set.
+//  - stage N, i.e. the number of children, ExceptOutputSourceOperator outputs the keys not deleted.
+// The probes of the children don't depend on each other, they are ordered only to share the hash set without lock.
+class ExceptContext {
+public:
+    using HashSerializeSet = vectorized::ExceptNode::HashSerializeSet;
+
+    ExceptContext(size_t num_partitions, size_t num_children);
+    ~ExceptContext() = default;
+
+    size_t num_partitions() const { return _partitions.size(); }
+    size_t num_children() const { return _num_children; }
+
+    // Called by the build driver of |partition| when it's prepared, the memory of the keys is tracked by
+    // |mem_tracker|.
+    void prepare_partition(int32_t partition, MemTracker* mem_tracker);
+
+    // Stage 0, build the hash set of |partition| by the keys of |chunk| evaluated by |exprs|.
+    Status build(RuntimeState* state, int32_t partition, const vectorized::ChunkPtr& chunk,
+                 const std::vector<ExprContext*>& exprs);
+    // Stage 1 ~ N - 1, mark the keys of |chunk| deleted.
+    Status erase(RuntimeState* state, int32_t partition, const vectorized::ChunkPtr& chunk,
+                 const std::vector<ExprContext*>& exprs);
+
+    // Called by the operator of each stage exactly once, the later stages fail with the status if it's not ok.
+    void finish_stage(int32_t partition, const Status& status);
+    bool is_stage_ready(int32_t partition, int32_t stage) const {
+        return _partitions[partition]->num_finished_stages.load(std::memory_order_acquire) >= stage;
+    }
+    // Only valid after the stage is ready.
+    const Status& status(int32_t partition) const { return _partitions[partition]->status; }
+
+    // The last stage, output the keys not deleted into a chunk of the slots of |tuple_desc|.
+    bool has_more_output(int32_t partition) const;
+    StatusOr<vectorized::ChunkPtr> pull_output(int32_t partition, const TupleDescriptor* tuple_desc);
+
+    void add_observer(const ReadyObserver& observer) { _observable.add_observer(observer); }
+
+    // Called by each operator of |partition| when it's closed, the hash set of the partition is released after
+    // all of them are closed, before the mem trackers of the operators are destroyed.
+    void unref(int32_t partition);
+
+private:
+    struct Partition {
+        std::unique_ptr<HashSerializeSet> hash_set;
+        // pool for allocate key.
+        std::unique_ptr<MemPool> build_pool;
+        // whether the keys are nullable, decided by the first chunk of the first child.
+        std::vector<bool> is_nullable;
+
+        std::atomic<int32_t> num_finished_stages{0};
+        Status status;
+        HashSerializeSet::Iterator iterator;
+        std::atomic<size_t> num_closed{0};
+    };
+
+    const size_t _num_children;
+    std::vector<std::unique_ptr<Partition>> _partitions;
+    Observable _observable;
+};
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,85 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/pipeline/set/except_context.h"
+
+namespace starrocks::pipeline {
+
+// ExceptProbeSinkOperator deletes the keys of the |stage|-th child from the hash set of the partition of its driver,
+// it's not ready until the previous stage of the partition is finished, see ExceptContext.
+class ExceptProbeSinkOperator final : public Operator {
+public:
+    ExceptProbeSinkOperator(int32_t id, int32_t plan_node_id, ExceptContextPtr except_context,
+                            const std::vector<TExpr>& t_exprs, const RowDescriptor& child_row_desc, int32_t partition,
+                            int32_t stage)
+            : Operator(id, "except_probe_sink", plan_node_id),
+              _except_context(std::move(except_context)),
+              _t_exprs(t_exprs),
+              _child_row_desc(child_row_desc),
+              _partition(partition),
+              _stage(stage) {}
+
+    ~ExceptProbeSinkOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return false; }
+
+    bool need_input() override { return !is_finished(); }
+
+    bool is_finished() const override { return _is_finished; }
+
+    void finish(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+    bool is_precondition_ready() const override { return _except_context->is_stage_ready(_partition, _stage); }
+
+    bool add_ready_observer(const ReadyObserver& observer) override {
+        _except_context->add_observer(observer);
+        return true;
+    }
+
+private:
+    ExceptContextPtr _except_context;
+    const std::vector<TExpr>& _t_exprs;
+    const RowDescriptor& _child_row_desc;
+    const int32_t _partition;
+    const int32_t _stage;
+    std::vector<ExprContext*> _exprs;
+    bool _is_finished = false;
+};
+
+class ExceptProbeSinkOperatorFactory final : public OperatorFactory {
+public:
+    ExceptProbeSinkOperatorFactory(int32_t id, int32_t plan_node_id, ExceptContextPtr except_context,
+                                   const std::vector<TExpr>& t_exprs, const RowDescriptor& child_row_desc,
+                                   int32_t stage)
+            : OperatorFactory(id, plan_node_id),
+              _except_context(std::move(except_context)),
+              _t_exprs(t_exprs),
+              _child_row_desc(child_row_desc),
+              _stage(stage) {}
+
+    ~ExceptProbeSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        DCHECK_EQ(driver_instance_count, _except_context->num_partitions());
+        return std::make_shared<ExceptProbeSinkOperator>(_id, _plan_node_id, _except_context, _t_exprs, _child_row_desc,
+                                                         driver_sequence, _stage);
+    }
+
+private:
+    ExceptContextPtr _except_context;
+    const std::vector<TExpr> _t_exprs;
+    const RowDescriptor& _child_row_desc;
+    const int32_t _stage;
+};
+
+} // namespace starrocks::pipeline
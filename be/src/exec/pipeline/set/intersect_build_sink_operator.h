@@ -0,0 +1,73 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/pipeline/set/intersect_context.h"
+
+namespace starrocks::pipeline {
+
+// IntersectBuildSinkOperator builds the hash set of the partition of its driver by the first child,
+// see IntersectContext.
+class IntersectBuildSinkOperator final : public Operator {
+public:
+    IntersectBuildSinkOperator(int32_t id, int32_t plan_node_id, IntersectContextPtr intersect_context,
+                               const std::vector<TExpr>& t_exprs, const RowDescriptor& child_row_desc,
+                               int32_t partition)
+            : Operator(id, "intersect_build_sink", plan_node_id),
+              _intersect_context(std::move(intersect_context)),
+              _t_exprs(t_exprs),
+              _child_row_desc(child_row_desc),
+              _partition(partition) {}
+
+    ~IntersectBuildSinkOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return false; }
+
+    bool need_input() override { return !is_finished(); }
+
+    bool is_finished() const override { return _is_finished; }
+
+    void finish(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    IntersectContextPtr _intersect_context;
+    const std::vector<TExpr>& _t_exprs;
+    const RowDescriptor& _child_row_desc;
+    const int32_t _partition;
+    std::vector<ExprContext*> _exprs;
+    bool _is_finished = false;
+};
+
+class IntersectBuildSinkOperatorFactory final : public OperatorFactory {
+public:
+    IntersectBuildSinkOperatorFactory(int32_t id, int32_t plan_node_id, IntersectContextPtr intersect_context,
+                                      const std::vector<TExpr>& t_exprs, const RowDescriptor& child_row_desc)
+            : OperatorFactory(id, plan_node_id),
+              _intersect_context(std::move(intersect_context)),
+              _t_exprs(t_exprs),
+              _child_row_desc(child_row_desc) {}
+
+    ~IntersectBuildSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        DCHECK_EQ(driver_instance_count, _intersect_context->num_partitions());
+        return std::make_shared<IntersectBuildSinkOperator>(_id, _plan_node_id, _intersect_context, _t_exprs,
+                                                            _child_row_desc, driver_sequence);
+    }
+
+private:
+    IntersectContextPtr _intersect_context;
+    const std::vector<TExpr> _t_exprs;
+    const RowDescriptor& _child_row_desc;
+};
+
+} // namespace starrocks::pipeline
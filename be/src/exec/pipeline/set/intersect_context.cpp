@@ -0,0 +1,112 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/intersect_context.h"
+
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+IntersectContext::IntersectContext(size_t num_partitions, size_t num_children) : _num_children(num_children) {
+    _partitions.reserve(num_partitions);
+    for (size_t i = 0; i < num_partitions; ++i) {
+        _partitions.emplace_back(std::make_unique<Partition>());
+    }
+}
+
+void IntersectContext::prepare_partition(int32_t partition, MemTracker* mem_tracker) {
+    Partition& p = *_partitions[partition];
+    p.hash_set = std::make_unique<HashSerializeSet>();
+    p.build_pool = std::make_unique<MemPool>(mem_tracker);
+}
+
+Status IntersectContext::build(RuntimeState* state, int32_t partition, const vectorized::ChunkPtr& chunk,
+                               const std::vector<ExprContext*>& exprs) {
+    Partition& p = *_partitions[partition];
+    if (p.is_nullable.empty()) {
+        p.is_nullable.resize(exprs.size());
+        std::vector<bool>* is_nullable = &p.is_nullable;
+        RETURN_IF_ERROR(p.hash_set->build_set(
+                state, chunk, exprs, p.build_pool.get(),
+                [=](const vectorized::ColumnPtr& column, int i) { (*is_nullable)[i] = column->is_nullable(); }));
+    } else {
+        RETURN_IF_ERROR(p.hash_set->build_set(state, chunk, exprs, p.build_pool.get(),
+                                              [](const vectorized::ColumnPtr& column, int i) {}));
+    }
+    p.is_empty = p.hash_set->hash_set->empty();
+    return Status::OK();
+}
+
+Status IntersectContext::refine(RuntimeState* state, int32_t partition, int32_t stage,
+                                const vectorized::ChunkPtr& chunk, const std::vector<ExprContext*>& exprs) {
+    Partition& p = *_partitions[partition];
+    // if a table is empty, the result must be empty
+    if (p.is_empty) {
+        return Status::OK();
+    }
+    return p.hash_set->refine_intersect_row(state, chunk, exprs, stage);
+}
+
+void IntersectContext::finish_stage(int32_t partition, const Status& status) {
+    Partition& p = *_partitions[partition];
+    if (!status.ok() && p.status.ok()) {
+        p.status = status;
+    }
+    const int32_t stage = p.num_finished_stages.load(std::memory_order_relaxed);
+    if (stage + 1 == static_cast<int32_t>(_num_children) && p.hash_set != nullptr) {
+        p.iterator = p.hash_set->begin();
+    }
+    p.num_finished_stages.store(stage + 1, std::memory_order_release);
+    _observable.notify_observers();
+}
+
+bool IntersectContext::has_more_output(int32_t partition) const {
+    const Partition& p = *_partitions[partition];
+    return !p.is_empty && p.iterator != p.hash_set->end();
+}
+
+StatusOr<vectorized::ChunkPtr> IntersectContext::pull_output(int32_t partition, const TupleDescriptor* tuple_desc) {
+    Partition& p = *_partitions[partition];
+    RETURN_IF_ERROR(p.status);
+    const uint16_t intersect_times = _num_children - 1;
+
+    int32_t read_index = 0;
+    p.hash_set->_results.resize(config::vector_chunk_size);
+    while (p.iterator != p.hash_set->end() && read_index < config::vector_chunk_size) {
+        if (p.iterator->hit_times == intersect_times) {
+            p.hash_set->_results[read_index] = p.iterator->slice;
+            ++read_index;
+        }
+        ++p.iterator;
+    }
+
+    auto result_chunk = std::make_shared<vectorized::Chunk>();
+    if (read_index == 0) {
+        return result_chunk;
+    }
+    const auto& slots = tuple_desc->slots();
+    vectorized::Columns result_columns(slots.size());
+    for (size_t i = 0; i < slots.size(); ++i) {
+        result_columns[i] = vectorized::ColumnHelper::create_column(slots[i]->type(), p.is_nullable[i]);
+        result_columns[i]->reserve(read_index);
+    }
+    p.hash_set->insert_keys_to_columns(p.hash_set->_results, result_columns, read_index);
+    for (size_t i = 0; i < result_columns.size(); i++) {
+        result_chunk->append_column(std::move(result_columns[i]), slots[i]->id());
+    }
+    return result_chunk;
+}
+
+void IntersectContext::unref(int32_t partition) {
+    Partition& p = *_partitions[partition];
+    // the build, the probe of each of the other children and the output.
+    if (p.num_closed.fetch_add(1) + 1 == _num_children + 1) {
+        p.hash_set.reset();
+        if (p.build_pool != nullptr) {
+            p.build_pool->free_all();
+            p.build_pool.reset();
+        }
+    }
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,87 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "exec/pipeline/observable.h"
+#include "exec/vectorized/intersect_node.h"
+
+namespace starrocks::pipeline {
+
+class IntersectContext;
+using IntersectContextPtr = std::shared_ptr<IntersectContext>;
+
+// IntersectContext is shared by all the drivers of one intersect node.
+// The rows of every child are shuffled among the partitions by the hash of their keys, so the keys of one partition
+// never appear in another one, and the drivers of the same sequence of all the pipelines share one partition,
+// its hash set is built and probed without any lock. The stages of a partition run in order, each one by the driver
+// of another pipeline:
+//  - stage 0, IntersectBuildSinkOperator builds the hash set by the keys of the first child.
+//  - stage i, IntersectProbeSinkOperator refines the hash set by the keys of the i-th child, the keys hit by all
+//    the children so far are marked with i.
+//  - stage N, i.e. the number of children, IntersectOutputSourceOperator outputs the keys hit by all the children.
+// The operator of stage i isn't ready until stage i - 1 of its partition is finished, so all the partitions are
+// built and probed in parallel, with only the drivers of the ready stages taking the cores.
+class IntersectContext {
+public:
+    using HashSerializeSet = vectorized::IntersectNode::HashSerializeSet;
+
+    IntersectContext(size_t num_partitions, size_t num_children);
+    ~IntersectContext() = default;
+
+    size_t num_partitions() const { return _partitions.size(); }
+    size_t num_children() const { return _num_children; }
+
+    // Called by the build driver of |partition| when it's prepared, the memory of the keys is tracked by
+    // |mem_tracker|.
+    void prepare_partition(int32_t partition, MemTracker* mem_tracker);
+
+    // Stage 0, build the hash set of |partition| by the keys of |chunk| evaluated by |exprs|.
+    Status build(RuntimeState* state, int32_t partition, const vectorized::ChunkPtr& chunk,
+                 const std::vector<ExprContext*>& exprs);
+    // Stage |stage|, mark the keys of |chunk| hit by all the previous stages.
+    Status refine(RuntimeState* state, int32_t partition, int32_t stage, const vectorized::ChunkPtr& chunk,
+                  const std::vector<ExprContext*>& exprs);
+
+    // Called by the operator of each stage exactly once, the later stages fail with the status if it's not ok.
+    void finish_stage(int32_t partition, const Status& status);
+    bool is_stage_ready(int32_t partition, int32_t stage) const {
+        return _partitions[partition]->num_finished_stages.load(std::memory_order_acquire) >= stage;
+    }
+    // Only valid after the stage is ready.
+    const Status& status(int32_t partition) const { return _partitions[partition]->status; }
+
+    // The last stage, output the keys hit by all the children into a chunk of the slots of |tuple_desc|.
+    bool has_more_output(int32_t partition) const;
+    StatusOr<vectorized::ChunkPtr> pull_output(int32_t partition, const TupleDescriptor* tuple_desc);
+
+    void add_observer(const ReadyObserver& observer) { _observable.add_observer(observer); }
+
+    // Called by each operator of |partition| when it's closed, the hash set of the partition is released after
+    // all of them are closed, before the mem trackers of the operators are destroyed.
+    void unref(int32_t partition);
+
+private:
+    struct Partition {
+        std::unique_ptr<HashSerializeSet> hash_set;
+        // pool for allocate key.
+        std::unique_ptr<MemPool> build_pool;
+        // whether the keys are nullable, decided by the first chunk of the first child.
+        std::vector<bool> is_nullable;
+        bool is_empty = true;
+
+        std::atomic<int32_t> num_finished_stages{0};
+        Status status;
+        HashSerializeSet::Iterator iterator;
+        std::atomic<size_t> num_closed{0};
+    };
+
+    const size_t _num_children;
+    std::vector<std::unique_ptr<Partition>> _partitions;
+    Observable _observable;
+};
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,41 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/intersect_output_source_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status IntersectOutputSourceOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(SourceOperator::prepare(state));
+    _tuple_desc = state->desc_tbl().get_tuple_descriptor(_tuple_id);
+    DCHECK(_tuple_desc != nullptr);
+    return Status::OK();
+}
+
+Status IntersectOutputSourceOperator::close(RuntimeState* state) {
+    _intersect_context->unref(_partition);
+    return SourceOperator::close(state);
+}
+
+bool IntersectOutputSourceOperator::has_output() {
+    // report the error of the previous stages by pull_chunk().
+    return !_is_finished && (!_intersect_context->status(_partition).ok() ||
+                             _intersect_context->has_more_output(_partition));
+}
+
+bool IntersectOutputSourceOperator::is_finished() const {
+    if (_is_finished) {
+        return true;
+    }
+    return _intersect_context->is_stage_ready(_partition, _stage) && _intersect_context->status(_partition).ok() &&
+           !_intersect_context->has_more_output(_partition);
+}
+
+StatusOr<vectorized::ChunkPtr> IntersectOutputSourceOperator::pull_chunk(RuntimeState* state) {
+    return _intersect_context->pull_output(_partition, _tuple_desc);
+}
+
+} // namespace starrocks::pipeline
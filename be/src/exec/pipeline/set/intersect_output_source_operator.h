@@ -0,0 +1,73 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/set/intersect_context.h"
+#include "exec/pipeline/source_operator.h"
+
+namespace starrocks::pipeline {
+
+// IntersectOutputSourceOperator outputs the keys of the partition of its driver hit by all the children,
+// it's not ready until all the children of the partition are probed, see IntersectContext.
+class IntersectOutputSourceOperator final : public SourceOperator {
+public:
+    IntersectOutputSourceOperator(int32_t id, int32_t plan_node_id, IntersectContextPtr intersect_context,
+                                  int32_t tuple_id, int32_t partition)
+            : SourceOperator(id, "intersect_output_source", plan_node_id),
+              _intersect_context(std::move(intersect_context)),
+              _tuple_id(tuple_id),
+              _partition(partition),
+              _stage(_intersect_context->num_children()) {}
+
+    ~IntersectOutputSourceOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override;
+
+    bool is_finished() const override;
+
+    void finish(RuntimeState* state) override { _is_finished = true; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    bool is_precondition_ready() const override { return _intersect_context->is_stage_ready(_partition, _stage); }
+
+    bool add_ready_observer(const ReadyObserver& observer) override {
+        _intersect_context->add_observer(observer);
+        return true;
+    }
+
+private:
+    IntersectContextPtr _intersect_context;
+    const int32_t _tuple_id;
+    const TupleDescriptor* _tuple_desc = nullptr;
+    const int32_t _partition;
+    const int32_t _stage;
+    bool _is_finished = false;
+};
+
+class IntersectOutputSourceOperatorFactory final : public OperatorFactory {
+public:
+    IntersectOutputSourceOperatorFactory(int32_t id, int32_t plan_node_id, IntersectContextPtr intersect_context,
+                                         int32_t tuple_id)
+            : OperatorFactory(id, plan_node_id),
+              _intersect_context(std::move(intersect_context)),
+              _tuple_id(tuple_id) {}
+
+    ~IntersectOutputSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        DCHECK_EQ(driver_instance_count, _intersect_context->num_partitions());
+        return std::make_shared<IntersectOutputSourceOperator>(_id, _plan_node_id, _intersect_context, _tuple_id,
+                                                               driver_sequence);
+    }
+
+private:
+    IntersectContextPtr _intersect_context;
+    const int32_t _tuple_id;
+};
+
+} // namespace starrocks::pipeline
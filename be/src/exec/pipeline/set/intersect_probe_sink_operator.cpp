@@ -0,0 +1,50 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/intersect_probe_sink_operator.h"
+
+#include "column/chunk.h"
+#include "exprs/expr.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status IntersectProbeSinkOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), _t_exprs, &_exprs));
+    RETURN_IF_ERROR(Expr::prepare(_exprs, state, _child_row_desc, get_memtracker()));
+    return Expr::open(_exprs, state);
+}
+
+Status IntersectProbeSinkOperator::close(RuntimeState* state) {
+    Expr::close(_exprs, state);
+    _intersect_context->unref(_partition);
+    return Operator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> IntersectProbeSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from intersect probe sink.");
+}
+
+Status IntersectProbeSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    RETURN_IF_ERROR(_intersect_context->status(_partition));
+    if (chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    return _intersect_context->refine(state, _partition, _stage, chunk, _exprs);
+}
+
+void IntersectProbeSinkOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+    // finish() is called before the previous stage is finished only if the fragment is cancelled, and the stages
+    // must be finished in order.
+    if (!_intersect_context->is_stage_ready(_partition, _stage)) {
+        return;
+    }
+    Status status = state->is_cancelled() ? Status::Cancelled("Cancelled before probing") : Status::OK();
+    _intersect_context->finish_stage(_partition, status);
+}
+
+} // namespace starrocks::pipeline
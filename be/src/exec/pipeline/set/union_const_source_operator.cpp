@@ -0,0 +1,57 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/union_const_source_operator.h"
+
+#include "column/chunk.h"
+#include "exec/vectorized/union_node.h"
+#include "exprs/expr.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status UnionConstSourceOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(SourceOperator::prepare(state));
+    // the constant rows are output once by all the fragment instances.
+    if (!_is_output_driver || state->per_fragment_instance_idx() != 0) {
+        _is_finished = true;
+        return Status::OK();
+    }
+    _tuple_desc = state->desc_tbl().get_tuple_descriptor(_tuple_id);
+    DCHECK(_tuple_desc != nullptr);
+    for (const auto& t_exprs : _t_const_expr_lists) {
+        std::vector<ExprContext*> ctxs;
+        RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), t_exprs, &ctxs));
+        _const_expr_lists.emplace_back(std::move(ctxs));
+        RETURN_IF_ERROR(Expr::prepare(_const_expr_lists.back(), state, _row_desc, get_memtracker()));
+        RETURN_IF_ERROR(Expr::open(_const_expr_lists.back(), state));
+    }
+    return Status::OK();
+}
+
+Status UnionConstSourceOperator::close(RuntimeState* state) {
+    for (auto& exprs : _const_expr_lists) {
+        Expr::close(exprs, state);
+    }
+    return SourceOperator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> UnionConstSourceOperator::pull_chunk(RuntimeState* state) {
+    // Unlike UnionNode, all the constant rows are output in chunks of the batch size rather than one row per chunk.
+    vectorized::ChunkPtr result;
+    while (_next_list < _const_expr_lists.size() && (result == nullptr || result->num_rows() < state->batch_size())) {
+        const auto& exprs = _const_expr_lists[_next_list++];
+        auto row = std::make_shared<vectorized::Chunk>();
+        for (size_t i = 0; i < exprs.size(); i++) {
+            vectorized::ColumnPtr column = exprs[i]->evaluate(nullptr);
+            vectorized::UnionNode::move_column(row, column, _tuple_desc->slots()[i], 1);
+        }
+        // the columns of the row may be shared by the exprs, so they are appended into new columns.
+        if (result == nullptr) {
+            result = row->clone_empty_with_slot();
+        }
+        result->append(*row);
+    }
+    return result;
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,74 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/source_operator.h"
+#include "gen_cpp/Exprs_types.h"
+#include "runtime/descriptors.h"
+
+namespace starrocks::pipeline {
+
+// UnionConstSourceOperator outputs the rows of the constant exprs of a union node, e.g. the ones of
+// UNION ALL SELECT 1, 2. Only the first driver of the first fragment instance outputs them, the others
+// are finished at once.
+class UnionConstSourceOperator final : public SourceOperator {
+public:
+    UnionConstSourceOperator(int32_t id, int32_t plan_node_id, int32_t tuple_id,
+                             const std::vector<std::vector<TExpr>>& t_const_expr_lists, const RowDescriptor& row_desc,
+                             bool is_output_driver)
+            : SourceOperator(id, "union_const_source", plan_node_id),
+              _tuple_id(tuple_id),
+              _t_const_expr_lists(t_const_expr_lists),
+              _row_desc(row_desc),
+              _is_output_driver(is_output_driver) {}
+
+    ~UnionConstSourceOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return !is_finished(); }
+
+    bool is_finished() const override { return _is_finished || _next_list >= _const_expr_lists.size(); }
+
+    void finish(RuntimeState* state) override { _is_finished = true; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+private:
+    const int32_t _tuple_id;
+    const TupleDescriptor* _tuple_desc = nullptr;
+    const std::vector<std::vector<TExpr>>& _t_const_expr_lists;
+    const RowDescriptor& _row_desc;
+    const bool _is_output_driver;
+    std::vector<std::vector<ExprContext*>> _const_expr_lists;
+
+    size_t _next_list = 0;
+    bool _is_finished = false;
+};
+
+class UnionConstSourceOperatorFactory final : public OperatorFactory {
+public:
+    UnionConstSourceOperatorFactory(int32_t id, int32_t plan_node_id, int32_t tuple_id,
+                                    const std::vector<std::vector<TExpr>>& t_const_expr_lists,
+                                    const RowDescriptor& row_desc)
+            : OperatorFactory(id, plan_node_id),
+              _tuple_id(tuple_id),
+              _t_const_expr_lists(t_const_expr_lists),
+              _row_desc(row_desc) {}
+
+    ~UnionConstSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<UnionConstSourceOperator>(_id, _plan_node_id, _tuple_id, _t_const_expr_lists,
+                                                          _row_desc, driver_sequence == 0);
+    }
+
+private:
+    const int32_t _tuple_id;
+    const std::vector<std::vector<TExpr>> _t_const_expr_lists;
+    const RowDescriptor& _row_desc;
+};
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,58 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/union_passthrough_operator.h"
+
+#include "column/chunk.h"
+#include "exprs/expr.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status UnionPassthroughOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    _tuple_desc = state->desc_tbl().get_tuple_descriptor(_tuple_id);
+    DCHECK(_tuple_desc != nullptr);
+    RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), _t_exprs, &_exprs));
+    RETURN_IF_ERROR(Expr::prepare(_exprs, state, _child_row_desc, get_memtracker()));
+    return Expr::open(_exprs, state);
+}
+
+Status UnionPassthroughOperator::close(RuntimeState* state) {
+    Expr::close(_exprs, state);
+    return Operator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> UnionPassthroughOperator::pull_chunk(RuntimeState* state) {
+    return std::move(_cur_chunk);
+}
+
+Status UnionPassthroughOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    using vectorized::UnionNode;
+    if (chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    const size_t num_rows = chunk->num_rows();
+    auto dest_chunk = std::make_shared<vectorized::Chunk>();
+    if (!_slot_map.empty()) {
+        for (auto* dest_slot : _tuple_desc->slots()) {
+            const auto& slot_item = _slot_map.at(dest_slot->id());
+            vectorized::ColumnPtr& column = chunk->get_column_by_slot_id(slot_item.slot_id);
+            // There may be multiple DestSlotId mapped to the same SrcSlotId,
+            // so here we have to decide whether you can MoveColumn according to this situation
+            if (slot_item.ref_count <= 1) {
+                UnionNode::move_column(dest_chunk, column, dest_slot, num_rows);
+            } else {
+                UnionNode::clone_column(dest_chunk, column, dest_slot, num_rows);
+            }
+        }
+    } else {
+        for (size_t i = 0; i < _exprs.size(); i++) {
+            vectorized::ColumnPtr column = _exprs[i]->evaluate(chunk.get());
+            UnionNode::move_column(dest_chunk, column, _tuple_desc->slots()[i], num_rows);
+        }
+    }
+    _cur_chunk = std::move(dest_chunk);
+    return Status::OK();
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,82 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/union_node.h"
+
+namespace starrocks::pipeline {
+
+// UnionPassthroughOperator converts the chunks of one child of a union node into the ones of the output tuple,
+// which are merged with the ones of the other children by a passthrough local exchange. The columns of a
+// passthrough child are moved into the output chunk without copying, and the ones of a materialized child are
+// evaluated by its result exprs.
+class UnionPassthroughOperator final : public Operator {
+public:
+    using SlotMap = std::map<SlotId, vectorized::UnionNode::SlotItem>;
+
+    // Either |slot_map| or |t_exprs| is used, |slot_map| is empty for a materialized child.
+    UnionPassthroughOperator(int32_t id, int32_t plan_node_id, int32_t tuple_id, const SlotMap& slot_map,
+                             const std::vector<TExpr>& t_exprs, const RowDescriptor& child_row_desc)
+            : Operator(id, "union_passthrough", plan_node_id),
+              _tuple_id(tuple_id),
+              _slot_map(slot_map),
+              _t_exprs(t_exprs),
+              _child_row_desc(child_row_desc) {}
+
+    ~UnionPassthroughOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return _cur_chunk != nullptr; }
+
+    bool need_input() override { return !_is_finished && _cur_chunk == nullptr; }
+
+    bool is_finished() const override { return _is_finished && _cur_chunk == nullptr; }
+
+    void finish(RuntimeState* state) override { _is_finished = true; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    const int32_t _tuple_id;
+    const TupleDescriptor* _tuple_desc = nullptr;
+    const SlotMap& _slot_map;
+    const std::vector<TExpr>& _t_exprs;
+    const RowDescriptor& _child_row_desc;
+    std::vector<ExprContext*> _exprs;
+
+    bool _is_finished = false;
+    vectorized::ChunkPtr _cur_chunk = nullptr;
+};
+
+class UnionPassthroughOperatorFactory final : public OperatorFactory {
+public:
+    UnionPassthroughOperatorFactory(int32_t id, int32_t plan_node_id, int32_t tuple_id,
+                                    UnionPassthroughOperator::SlotMap slot_map, std::vector<TExpr> t_exprs,
+                                    const RowDescriptor& child_row_desc)
+            : OperatorFactory(id, plan_node_id),
+              _tuple_id(tuple_id),
+              _slot_map(std::move(slot_map)),
+              _t_exprs(std::move(t_exprs)),
+              _child_row_desc(child_row_desc) {}
+
+    ~UnionPassthroughOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<UnionPassthroughOperator>(_id, _plan_node_id, _tuple_id, _slot_map, _t_exprs,
+                                                          _child_row_desc);
+    }
+
+private:
+    const int32_t _tuple_id;
+    const UnionPassthroughOperator::SlotMap _slot_map;
+    const std::vector<TExpr> _t_exprs;
+    const RowDescriptor& _child_row_desc;
+};
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,75 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/sort/local_merge_sort_source_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status LocalMergeSortSourceOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(SourceOperator::prepare(state));
+    RETURN_IF_ERROR(_sort_exec_exprs.init(_tnode.sort_node.sort_info, state->obj_pool()));
+    RETURN_IF_ERROR(_sort_exec_exprs.prepare(state, _child_row_desc, _row_desc, get_memtracker()));
+    RETURN_IF_ERROR(_sort_exec_exprs.open(state));
+    _is_asc_order = _tnode.sort_node.sort_info.is_asc_order;
+    _is_null_first = _tnode.sort_node.sort_info.nulls_first;
+    return Status::OK();
+}
+
+Status LocalMergeSortSourceOperator::close(RuntimeState* state) {
+    _merger.reset();
+    _sort_context->unref();
+    _sort_exec_exprs.close(state);
+    return SourceOperator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> LocalMergeSortSourceOperator::pull_chunk(RuntimeState* state) {
+    RETURN_IF_ERROR(_sort_context->status());
+    if (_merger == nullptr) {
+        RETURN_IF_ERROR(_init_merger());
+    }
+
+    vectorized::ChunkPtr chunk;
+    bool eos = false;
+    RETURN_IF_ERROR(_merger->get_next(&chunk, &eos));
+    if (eos) {
+        _is_finished = true;
+        return std::make_shared<vectorized::Chunk>();
+    }
+
+    // skip the top OFFSET rows, which are kept by every ChunksSorter.
+    if (_num_rows_skipped < _offset) {
+        size_t num_rows = chunk->num_rows();
+        size_t num_rows_to_skip = std::min<size_t>(_offset - _num_rows_skipped, num_rows);
+        _num_rows_skipped += num_rows_to_skip;
+        if (num_rows_to_skip == num_rows) {
+            return std::make_shared<vectorized::Chunk>();
+        }
+        vectorized::ChunkPtr remain_chunk = chunk->clone_empty_with_slot(num_rows - num_rows_to_skip);
+        remain_chunk->append(*chunk, num_rows_to_skip, num_rows - num_rows_to_skip);
+        return remain_chunk;
+    }
+    return chunk;
+}
+
+Status LocalMergeSortSourceOperator::_init_merger() {
+    vectorized::ChunkSuppliers suppliers;
+    for (const auto& chunks_sorter : _sort_context->chunks_sorters()) {
+        auto* sorter = chunks_sorter.get();
+        suppliers.emplace_back([sorter](vectorized::Chunk** chunk) -> Status {
+            vectorized::ChunkPtr sorted_chunk;
+            bool eos = false;
+            RETURN_IF_ERROR(sorter->get_next(&sorted_chunk, &eos));
+            // the merger takes the ownership of the chunk.
+            *chunk = eos ? nullptr : new vectorized::Chunk(std::move(*sorted_chunk));
+            return Status::OK();
+        });
+    }
+
+    _merger = std::make_unique<vectorized::SortedChunksMerger>();
+    _merger->set_profile(_runtime_profile.get());
+    return _merger->init(suppliers, &(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order, &_is_null_first);
+}
+
+} // namespace starrocks::pipeline
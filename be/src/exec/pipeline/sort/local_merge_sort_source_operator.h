@@ -0,0 +1,94 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/sort/sort_context.h"
+#include "exec/pipeline/source_operator.h"
+#include "exec/sort_exec_exprs.h"
+#include "runtime/vectorized/sorted_chunks_merger.h"
+
+namespace starrocks::pipeline {
+
+// LocalMergeSortSourceOperator waits for all the sink drivers to be finished, and then merges the
+// sorted rows of all the ChunksSorters in order. Only the first source driver does the merging,
+// the others are finished at once.
+class LocalMergeSortSourceOperator final : public SourceOperator {
+public:
+    LocalMergeSortSourceOperator(int32_t id, int32_t plan_node_id, const TPlanNode& tnode,
+                                 const RowDescriptor& child_row_desc, const RowDescriptor& row_desc,
+                                 int64_t offset, SortContextPtr sort_context, bool is_merging_driver)
+            : SourceOperator(id, "local_merge_sort_source", plan_node_id),
+              _tnode(tnode),
+              _child_row_desc(child_row_desc),
+              _row_desc(row_desc),
+              _offset(offset),
+              _sort_context(std::move(sort_context)),
+              _is_finished(!is_merging_driver) {}
+
+    ~LocalMergeSortSourceOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return !_is_finished && _sort_context->is_partition_sort_finished(); }
+
+    bool is_finished() const override { return _is_finished; }
+
+    void finish(RuntimeState* state) override { _is_finished = true; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    bool add_ready_observer(const ReadyObserver& observer) override {
+        _sort_context->add_observer(observer);
+        return true;
+    }
+
+private:
+    Status _init_merger();
+
+    const TPlanNode& _tnode;
+    const RowDescriptor& _child_row_desc;
+    const RowDescriptor& _row_desc;
+    const int64_t _offset;
+    SortContextPtr _sort_context;
+
+    SortExecExprs _sort_exec_exprs;
+    std::vector<bool> _is_asc_order;
+    std::vector<bool> _is_null_first;
+
+    std::unique_ptr<vectorized::SortedChunksMerger> _merger;
+    int64_t _num_rows_skipped = 0;
+
+    bool _is_finished = false;
+};
+
+class LocalMergeSortSourceOperatorFactory final : public OperatorFactory {
+public:
+    LocalMergeSortSourceOperatorFactory(int32_t id, int32_t plan_node_id, const TPlanNode& tnode,
+                                        const RowDescriptor& child_row_desc, const RowDescriptor& row_desc,
+                                        int64_t offset, SortContextPtr sort_context)
+            : OperatorFactory(id, plan_node_id),
+              _tnode(tnode),
+              _child_row_desc(child_row_desc),
+              _row_desc(row_desc),
+              _offset(offset),
+              _sort_context(std::move(sort_context)) {}
+
+    ~LocalMergeSortSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        _sort_context->set_num_sources(driver_instance_count);
+        return std::make_shared<LocalMergeSortSourceOperator>(_id, _plan_node_id, _tnode, _child_row_desc,
+                                                              _row_desc, _offset, _sort_context, driver_sequence == 0);
+    }
+
+private:
+    const TPlanNode _tnode;
+    const RowDescriptor& _child_row_desc;
+    const RowDescriptor& _row_desc;
+    const int64_t _offset;
+    SortContextPtr _sort_context;
+};
+
+} // namespace starrocks::pipeline
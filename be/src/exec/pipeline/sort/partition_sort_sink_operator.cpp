@@ -0,0 +1,83 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/sort/partition_sort_sink_operator.h"
+
+#include "column/chunk.h"
+#include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "exec/vectorized/chunks_sorter_topn.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+// Same as the batch sizes used by TopNNode.
+static const size_t SIZE_OF_CHUNK_FOR_TOPN = 3000;
+static const size_t SIZE_OF_CHUNK_FOR_FULL_SORT = 5000;
+
+Status PartitionSortSinkOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    RETURN_IF_ERROR(_sort_exec_exprs.init(_tnode.sort_node.sort_info, state->obj_pool()));
+    RETURN_IF_ERROR(_sort_exec_exprs.prepare(state, _child_row_desc, _row_desc, get_memtracker()));
+    RETURN_IF_ERROR(_sort_exec_exprs.open(state));
+    _is_asc_order = _tnode.sort_node.sort_info.is_asc_order;
+    _is_null_first = _tnode.sort_node.sort_info.nulls_first;
+    _abort_on_default_limit_exceeded = _tnode.sort_node.is_default_limit && state->abort_on_default_limit_exceeded();
+
+    // Every driver keeps the top OFFSET + LIMIT rows of its own input, the offset is skipped
+    // after merging.
+    if (_limit > 0) {
+        _chunks_sorter = std::make_shared<vectorized::ChunksSorterTopn>(
+                &(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order, &_is_null_first, 0, _offset + _limit,
+                SIZE_OF_CHUNK_FOR_TOPN);
+    } else {
+        _chunks_sorter = std::make_shared<vectorized::ChunksSorterFullSort>(
+                &(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order, &_is_null_first,
+                SIZE_OF_CHUNK_FOR_FULL_SORT);
+    }
+    _sort_timer = ADD_TIMER(_runtime_profile, "ChunksSorter");
+    _chunks_sorter->setup_runtime(get_memtracker(), _runtime_profile.get(), "ChunksSorter");
+    _sort_context->add_partition_chunks_sorter(_driver_sequence, _chunks_sorter);
+    return Status::OK();
+}
+
+Status PartitionSortSinkOperator::close(RuntimeState* state) {
+    _chunks_sorter.reset();
+    _sort_context->unref();
+    _sort_exec_exprs.close(state);
+    return Operator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> PartitionSortSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from partition sort sink.");
+}
+
+Status PartitionSortSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    int64_t num_input_rows = _sort_context->add_num_input_rows(chunk->num_rows());
+    if (_abort_on_default_limit_exceeded && _limit > 0 && num_input_rows > _limit) {
+        return Status::InternalError("DEFAULT_ORDER_BY_LIMIT has been exceeded.");
+    }
+
+    SCOPED_TIMER(_sort_timer);
+    vectorized::ChunkPtr materialize_chunk = vectorized::ChunksSorter::materialize_chunk_before_sort(
+            chunk.get(), _materialized_tuple_desc, _sort_exec_exprs, _order_by_types);
+    return _chunks_sorter->update(state, materialize_chunk);
+}
+
+void PartitionSortSinkOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+
+    // The sorted data is useless once the fragment is cancelled, but the source still needs
+    // to be woken up to exit.
+    Status status;
+    if (state->is_cancelled()) {
+        status = Status::Cancelled("Cancelled before sorting finished");
+    } else {
+        SCOPED_TIMER(_sort_timer);
+        status = _chunks_sorter->done(state);
+    }
+    _sort_context->finish_partition(status);
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,109 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/pipeline/sort/sort_context.h"
+#include "exec/sort_exec_exprs.h"
+
+namespace starrocks::pipeline {
+
+// PartitionSortSinkOperator sorts the input of its driver with a private ChunksSorter, keeping
+// only the top OFFSET + LIMIT rows for ORDER BY ... LIMIT, the sorted rows are merged by
+// LocalMergeSortSourceOperator.
+class PartitionSortSinkOperator final : public Operator {
+public:
+    PartitionSortSinkOperator(int32_t id, int32_t plan_node_id, const TPlanNode& tnode,
+                              TupleDescriptor* materialized_tuple_desc,
+                              const std::vector<vectorized::OrderByType>& order_by_types,
+                              const RowDescriptor& child_row_desc, const RowDescriptor& row_desc, int64_t offset,
+                              int64_t limit, SortContextPtr sort_context, int32_t driver_sequence)
+            : Operator(id, "partition_sort_sink", plan_node_id),
+              _tnode(tnode),
+              _materialized_tuple_desc(materialized_tuple_desc),
+              _order_by_types(order_by_types),
+              _child_row_desc(child_row_desc),
+              _row_desc(row_desc),
+              _offset(offset),
+              _limit(limit),
+              _sort_context(std::move(sort_context)),
+              _driver_sequence(driver_sequence) {}
+
+    ~PartitionSortSinkOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return false; }
+
+    bool need_input() override { return !is_finished(); }
+
+    bool is_finished() const override { return _is_finished; }
+
+    void finish(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    const TPlanNode& _tnode;
+    TupleDescriptor* _materialized_tuple_desc;
+    const std::vector<vectorized::OrderByType>& _order_by_types;
+    const RowDescriptor& _child_row_desc;
+    const RowDescriptor& _row_desc;
+    const int64_t _offset;
+    const int64_t _limit;
+    SortContextPtr _sort_context;
+    const int32_t _driver_sequence;
+
+    SortExecExprs _sort_exec_exprs;
+    std::vector<bool> _is_asc_order;
+    std::vector<bool> _is_null_first;
+    bool _abort_on_default_limit_exceeded = false;
+
+    std::shared_ptr<vectorized::ChunksSorter> _chunks_sorter;
+    RuntimeProfile::Counter* _sort_timer = nullptr;
+
+    bool _is_finished = false;
+};
+
+class PartitionSortSinkOperatorFactory final : public OperatorFactory {
+public:
+    PartitionSortSinkOperatorFactory(int32_t id, int32_t plan_node_id, const TPlanNode& tnode,
+                                     TupleDescriptor* materialized_tuple_desc,
+                                     const std::vector<vectorized::OrderByType>& order_by_types,
+                                     const RowDescriptor& child_row_desc, const RowDescriptor& row_desc,
+                                     int64_t offset, int64_t limit, SortContextPtr sort_context)
+            : OperatorFactory(id, plan_node_id),
+              _tnode(tnode),
+              _materialized_tuple_desc(materialized_tuple_desc),
+              _order_by_types(order_by_types),
+              _child_row_desc(child_row_desc),
+              _row_desc(row_desc),
+              _offset(offset),
+              _limit(limit),
+              _sort_context(std::move(sort_context)) {}
+
+    ~PartitionSortSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        _sort_context->set_num_sinkers(driver_instance_count);
+        return std::make_shared<PartitionSortSinkOperator>(_id, _plan_node_id, _tnode, _materialized_tuple_desc,
+                                                           _order_by_types, _child_row_desc, _row_desc, _offset,
+                                                           _limit, _sort_context, driver_sequence);
+    }
+
+private:
+    const TPlanNode _tnode;
+    TupleDescriptor* _materialized_tuple_desc;
+    const std::vector<vectorized::OrderByType> _order_by_types;
+    const RowDescriptor& _child_row_desc;
+    const RowDescriptor& _row_desc;
+    const int64_t _offset;
+    const int64_t _limit;
+    SortContextPtr _sort_context;
+};
+
+} // namespace starrocks::pipeline
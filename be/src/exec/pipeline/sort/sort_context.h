@@ -0,0 +1,85 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "exec/pipeline/observable.h"
+#include "exec/vectorized/chunks_sorter.h"
+
+namespace starrocks::pipeline {
+
+class SortContext;
+using SortContextPtr = std::shared_ptr<SortContext>;
+
+// SortContext is shared by all the sink and source drivers of one sort node.
+// Every sink driver sorts its own input with a private ChunksSorter, and after all the sink drivers
+// are finished, the source driver merges the sorted runs of all the sorters in order, or each source
+// driver reads the sorted rows of the sink driver of the same sequence, see AnalyticSourceOperator.
+class SortContext {
+public:
+    SortContext() = default;
+    ~SortContext() = default;
+
+    // Called by the operator factories when the drivers are created, before any driver runs.
+    void set_num_sinkers(size_t num_sinkers) {
+        _num_sinkers = num_sinkers;
+        _chunks_sorters.resize(num_sinkers);
+    }
+    void set_num_sources(size_t num_sources) { _num_sources = num_sources; }
+
+    // Called by each sink driver when it's prepared, the sorters are indexed by the sequences of the drivers.
+    void add_partition_chunks_sorter(int32_t driver_sequence, std::shared_ptr<vectorized::ChunksSorter> chunks_sorter) {
+        std::lock_guard<std::mutex> l(_mutex);
+        DCHECK_LT(driver_sequence, _chunks_sorters.size());
+        _chunks_sorters[driver_sequence] = std::move(chunks_sorter);
+    }
+
+    // Called by each sink driver exactly once after ChunksSorter::done(), the source driver fails with
+    // the status if it's not ok.
+    void finish_partition(const Status& status) {
+        if (!status.ok()) {
+            std::lock_guard<std::mutex> l(_mutex);
+            _status = status;
+        }
+        if (_num_finished_sinkers.fetch_add(1) + 1 == _num_sinkers) {
+            _observable.notify_observers();
+        }
+    }
+
+    bool is_partition_sort_finished() const { return _num_finished_sinkers.load() == _num_sinkers; }
+
+    // Only valid after is_partition_sort_finished() returns true.
+    const Status& status() const { return _status; }
+    const std::vector<std::shared_ptr<vectorized::ChunksSorter>>& chunks_sorters() const { return _chunks_sorters; }
+
+    // Return the number of input rows of all the sink drivers so far.
+    int64_t add_num_input_rows(int64_t num_rows) { return _num_input_rows.fetch_add(num_rows) + num_rows; }
+
+    void add_observer(const ReadyObserver& observer) { _observable.add_observer(observer); }
+
+    // Called by each sink and source driver when it's closed, the sorted data is released after
+    // all of them are closed, before the mem trackers of the operators are destroyed.
+    void unref() {
+        if (_num_closed.fetch_add(1) + 1 == _num_sinkers + _num_sources) {
+            _chunks_sorters.clear();
+        }
+    }
+
+private:
+    size_t _num_sinkers = 0;
+    size_t _num_sources = 0;
+    std::atomic<size_t> _num_finished_sinkers{0};
+    std::atomic<size_t> _num_closed{0};
+    std::atomic<int64_t> _num_input_rows{0};
+
+    std::mutex _mutex;
+    Status _status;
+    std::vector<std::shared_ptr<vectorized::ChunksSorter>> _chunks_sorters;
+
+    Observable _observable;
+};
+
+} // namespace starrocks::pipeline
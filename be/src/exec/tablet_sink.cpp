@@ -39,6 +39,7 @@
 #include "simd/simd.h"
 #include "storage/hll.h"
 #include "util/brpc_stub_cache.h"
+#include "util/coding.h"
 #include "util/monotime.h"
 #include "util/uid_util.h"
 
@@ -130,6 +131,9 @@ void NodeChannel::open() {
         auto ptablet = request.add_tablets();
         ptablet->set_partition_id(tablet.partition_id);
         ptablet->set_tablet_id(tablet.tablet_id);
+        if (_parent->_enable_replicated_storage) {
+            _set_replicas(tablet.tablet_id, ptablet);
+        }
     }
     request.set_num_senders(_parent->_num_senders);
     request.set_need_gen_rollup(_parent->_need_gen_rollup);
@@ -151,6 +155,25 @@ void NodeChannel::open() {
     request.release_schema();
 }
 
+void NodeChannel::_set_replicas(int64_t tablet_id, PTabletWithPartition* ptablet) {
+    // the first replica of the tablet location is the primary replica.
+    const auto& node_ids = _parent->_location->find_tablet(tablet_id)->node_ids;
+    if (node_ids[0] != _node_id) {
+        ptablet->set_is_secondary_replica(true);
+        return;
+    }
+    for (size_t i = 1; i < node_ids.size(); ++i) {
+        const NodeInfo* node_info = _parent->_nodes_info->find_node(node_ids[i]);
+        if (node_info == nullptr) {
+            LOG(WARNING) << "unknown node id " << node_ids[i] << " of tablet " << tablet_id;
+            continue;
+        }
+        auto* replica = ptablet->add_secondary_replicas();
+        replica->set_host(node_info->host);
+        replica->set_port(node_info->brpc_port);
+    }
+}
+
 Status NodeChannel::open_wait() {
     _open_closure->join();
     if (_open_closure->cntl.Failed()) {
@@ -160,6 +183,7 @@ Status NodeChannel::open_wait() {
         return Status::InternalError("failed to open tablet writer");
     }
     Status status(_open_closure->result.status());
+    _use_chunk_attachment = _is_vectorized && _open_closure->result.support_chunk_attachment();
     if (_open_closure->unref()) {
         delete _open_closure;
     }
@@ -281,18 +305,49 @@ Status NodeChannel::add_chunk(vectorized::Chunk* chunk, const int64_t* tablet_id
         _cur_chunk = chunk->clone_empty_with_slot();
         _mem_tracker->consume(_cur_chunk->memory_usage());
         _cur_add_chunk_request.clear_tablet_ids();
+        _cur_add_chunk_request.clear_tablet_id_dict();
+        _cur_add_chunk_request.clear_tablet_indexes();
+        _tablet_id_dict_indexes.clear();
     }
 
     int64_t chunk_memory_usage = _cur_chunk->memory_usage();
     _cur_chunk->append_selective(*chunk, indexes, from, size);
     chunk_memory_usage = static_cast<int64_t>(_cur_chunk->memory_usage()) - chunk_memory_usage;
     _mem_tracker->consume(chunk_memory_usage);
-    for (size_t i = 0; i < size; ++i) {
-        _cur_add_chunk_request.add_tablet_ids(tablet_ids[indexes[from + i]]);
+    if (_use_chunk_attachment) {
+        _append_tablet_indexes(tablet_ids, indexes, from, size);
+    } else {
+        for (size_t i = 0; i < size; ++i) {
+            _cur_add_chunk_request.add_tablet_ids(tablet_ids[indexes[from + i]]);
+        }
     }
     return Status::OK();
 }
 
+void NodeChannel::_append_tablet_indexes(const int64_t* tablet_ids, const uint32_t* indexes, uint32_t from,
+                                         uint32_t size) {
+    std::string* tablet_indexes = _cur_add_chunk_request.mutable_tablet_indexes();
+    size_t offset = tablet_indexes->size();
+    tablet_indexes->resize(offset + size * sizeof(uint32_t));
+    auto* dst = reinterpret_cast<uint8_t*>(tablet_indexes->data()) + offset;
+    // the rows of the same tablet are often adjacent, e.g. the rows of a bucket column with few values.
+    int64_t last_tablet_id = -1;
+    uint32_t last_index = 0;
+    for (uint32_t i = 0; i < size; ++i) {
+        int64_t tablet_id = tablet_ids[indexes[from + i]];
+        if (tablet_id != last_tablet_id) {
+            auto [iter, inserted] =
+                    _tablet_id_dict_indexes.emplace(tablet_id, _cur_add_chunk_request.tablet_id_dict_size());
+            if (inserted) {
+                _cur_add_chunk_request.add_tablet_id_dict(tablet_id);
+            }
+            last_tablet_id = tablet_id;
+            last_index = iter->second;
+        }
+        encode_fixed32_le(dst + i * sizeof(uint32_t), last_index);
+    }
+}
+
 Status NodeChannel::mark_close() {
     auto st = none_of({_cancelled, _eos_is_produced});
     if (!st.ok()) {
@@ -445,13 +500,25 @@ int NodeChannel::try_send_chunk_and_fetch_status() {
 
         // tablet_ids has already set when add row
         request.set_packet_seq(_next_packet_seq);
+        butil::IOBuf attachment;
         if (chunk->num_rows() > 0) {
             SCOPED_RAW_TIMER(&_serialize_batch_ns);
-            chunk->serialize_with_meta(request.mutable_chunk());
+            if (_use_chunk_attachment) {
+                // serialize the data to a buffer owned by the attachment, so it's not copied by protobuf.
+                chunk->serialize_meta(request.mutable_chunk());
+                size_t size = chunk->serialize_size();
+                auto* data = new uint8_t[size];
+                chunk->serialize(data);
+                request.mutable_chunk()->set_data_size(size);
+                attachment.append_user_data(data, size, [](void* buf) { delete[] static_cast<uint8_t*>(buf); });
+            } else {
+                chunk->serialize_with_meta(request.mutable_chunk());
+            }
         }
 
         _add_batch_closure->reset();
         _add_batch_closure->cntl.set_timeout_ms(_rpc_timeout_ms);
+        _add_batch_closure->cntl.request_attachment().swap(attachment);
 
         if (request.eos()) {
             for (auto pid : _parent->_partition_ids) {
@@ -531,7 +598,13 @@ Status IndexChannel::init(RuntimeState* state, const std::vector<TTabletWithPart
             }
             channel->add_tablet(tablet);
             channels.push_back(channel);
-            bes.emplace_back(node_id);
+            // in the replicated storage, the rows are only sent to the primary replica, see NodeChannel::open().
+            if (bes.empty() || !_parent->_enable_replicated_storage) {
+                bes.emplace_back(node_id);
+            }
+        }
+        if (_parent->_enable_replicated_storage && !bes.empty()) {
+            _primary_nodes.insert(bes[0]);
         }
         _channels_by_tablet.emplace(tablet.tablet_id, std::move(channels));
         _tablet_to_be.emplace(tablet.tablet_id, std::move(bes));
@@ -561,6 +634,12 @@ Status IndexChannel::add_row(Tuple* tuple, int64_t tablet_id) {
 }
 
 bool IndexChannel::has_intolerable_failure() {
+    // the rows of the tablets are lost if their primary replica fails.
+    for (auto node_id : _failed_channels) {
+        if (_primary_nodes.count(node_id) > 0) {
+            return true;
+        }
+    }
     return _failed_channels.size() >= ((_parent->_num_repicas + 1) / 2);
 }
 
@@ -605,6 +684,9 @@ Status OlapTableSink::init(const TDataSink& t_sink) {
     } else {
         _load_channel_timeout_s = config::streaming_load_rpc_max_alive_time_sec;
     }
+    // the rowset replication is only supported by the vectorized load channel.
+    _enable_replicated_storage =
+            _is_vectorized && table_sink.__isset.enable_replicated_storage && table_sink.enable_replicated_storage;
 
     return Status::OK();
 }
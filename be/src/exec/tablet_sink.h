@@ -197,6 +197,12 @@ public:
     void clear_all_batches();
 
 private:
+    // Append the indexes of the tablets of the rows to |_cur_add_chunk_request|, used if |_use_chunk_attachment|.
+    void _append_tablet_indexes(const int64_t* tablet_ids, const uint32_t* indexes, uint32_t from, uint32_t size);
+
+    // Set the replica role of this node for the tablet in the replicated storage.
+    void _set_replicas(int64_t tablet_id, PTabletWithPartition* ptablet);
+
     std::unique_ptr<MemTracker> _mem_tracker = nullptr;
 
     OlapTableSink* _parent = nullptr;
@@ -251,6 +257,11 @@ private:
     using AddChunkReq = std::pair<std::unique_ptr<vectorized::Chunk>, PTabletWriterAddChunkRequest>;
     std::queue<AddChunkReq> _pending_chunks;
     PTabletWriterAddChunkRequest _cur_add_chunk_request;
+    // Whether the receiver accepts the chunk data in the attachment and the rows given by the tablet indexes, which
+    // saves a copy of the data by protobuf, and the per-row tablet ids.
+    bool _use_chunk_attachment = false;
+    // tablet id -> index in the tablet_id_dict of |_cur_add_chunk_request|.
+    std::unordered_map<int64_t, uint32_t> _tablet_id_dict_indexes;
 
     int64_t _mem_exceeded_block_ns = 0;
     int64_t _queue_push_lock_ns = 0;
@@ -286,10 +297,12 @@ private:
     std::unordered_map<int64_t, std::unique_ptr<NodeChannel>> _node_channels;
     // map tablet_id to backend channel
     std::unordered_map<int64_t, std::vector<NodeChannel*>> _channels_by_tablet;
-    // map tablet_id to backend id
+    // map tablet_id to backend id, only the primary replica in the replicated storage
     std::unordered_map<int64_t, std::vector<int64_t>> _tablet_to_be;
     // BeId
     std::set<int64_t> _failed_channels;
+    // BeId of the primary replicas in the replicated storage
+    std::set<int64_t> _primary_nodes;
 };
 
 // Write data to Olap Table.
@@ -449,6 +462,9 @@ private:
 
     // the timeout of load channels opened by this tablet sink. in second
     int64_t _load_channel_timeout_s = 0;
+
+    // Send the rows only to the primary replica of each tablet, which sends the rowset to the secondary replicas.
+    bool _enable_replicated_storage = false;
 };
 
 } // namespace stream_load
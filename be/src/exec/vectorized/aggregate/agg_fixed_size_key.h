@@ -0,0 +1,193 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include "column/column.h"
+#include "column/column_hash.h"
+#include "column/nullable_column.h"
+#include "column/vectorized_fwd.h"
+#include "gutil/casts.h"
+#include "runtime/primitive_type.h"
+
+namespace starrocks::vectorized {
+
+// The layout of the group by keys packed into a fixed size integer. The null bits of the nullable keys come
+// first, one bit per nullable key, then the values of the keys at their fixed offsets. The value of a null
+// key is zero, so that all the nulls of a key are equal.
+struct FixedSizeKeyLayout {
+    static constexpr size_t MAX_SIZE = 16;
+
+    struct Key {
+        uint8_t offset = 0;
+        uint8_t size = 0;
+        // -1 if the key is not nullable.
+        int8_t null_bit = -1;
+    };
+
+    std::vector<Key> keys;
+    // The number of the bytes of the packed keys.
+    size_t size = 0;
+
+    // Return false if any key isn't a narrow fixed-width type, or the packed keys are larger than MAX_SIZE.
+    // The floating point keys are not packed, because the equal values of them could differ in bytes.
+    bool init(const std::vector<PrimitiveType>& types, const std::vector<bool>& nullables) {
+        DCHECK_EQ(types.size(), nullables.size());
+        size_t num_nullables = 0;
+        for (bool nullable : nullables) {
+            num_nullables += nullable;
+        }
+        keys.resize(types.size());
+        size = (num_nullables + 7) / 8;
+        int8_t null_bit = 0;
+        for (size_t i = 0; i < types.size(); ++i) {
+            const size_t key_size = _type_size(types[i]);
+            if (key_size == 0 || size + key_size > MAX_SIZE) {
+                return false;
+            }
+            keys[i].offset = size;
+            keys[i].size = key_size;
+            keys[i].null_bit = nullables[i] ? null_bit++ : -1;
+            size += key_size;
+        }
+        return true;
+    }
+
+private:
+    static size_t _type_size(PrimitiveType type) {
+        switch (type) {
+        case TYPE_BOOLEAN:
+        case TYPE_TINYINT:
+            return 1;
+        case TYPE_SMALLINT:
+            return 2;
+        case TYPE_INT:
+        case TYPE_DATE:
+            return 4;
+        case TYPE_BIGINT:
+        case TYPE_DATETIME:
+            return 8;
+        default:
+            return 0;
+        }
+    }
+};
+
+template <typename KeyType>
+void set_null_of_fixed_size_key(const FixedSizeKeyLayout::Key& key, KeyType* packed_key) {
+    auto* bytes = reinterpret_cast<uint8_t*>(packed_key);
+    bytes[key.null_bit / 8] |= static_cast<uint8_t>(1u << (key.null_bit % 8));
+    memset(bytes + key.offset, 0, key.size);
+}
+
+template <typename KeyType, size_t KeySize>
+void pack_one_fixed_size_key(const uint8_t* data, size_t offset, size_t num_rows, KeyType* packed_keys) {
+    for (size_t i = 0; i < num_rows; ++i) {
+        memcpy(reinterpret_cast<uint8_t*>(packed_keys + i) + offset, data + i * KeySize, KeySize);
+    }
+}
+
+// Pack the first |num_rows| rows of |key_columns| into |packed_keys|.
+template <typename KeyType>
+void pack_fixed_size_keys(const FixedSizeKeyLayout& layout, const Columns& key_columns, size_t num_rows,
+                          KeyType* packed_keys) {
+    DCHECK_LE(layout.size, sizeof(KeyType));
+    memset(packed_keys, 0, sizeof(KeyType) * num_rows);
+    for (size_t i = 0; i < key_columns.size(); ++i) {
+        const FixedSizeKeyLayout::Key& key = layout.keys[i];
+        const Column* column = key_columns[i].get();
+        if (column->only_null()) {
+            DCHECK_GE(key.null_bit, 0);
+            for (size_t j = 0; j < num_rows; ++j) {
+                set_null_of_fixed_size_key(key, packed_keys + j);
+            }
+            continue;
+        }
+
+        const NullableColumn* nullable_column = nullptr;
+        if (column->is_nullable()) {
+            DCHECK_GE(key.null_bit, 0);
+            nullable_column = down_cast<const NullableColumn*>(column);
+            column = nullable_column->data_column().get();
+        }
+        DCHECK_EQ(key.size, column->type_size());
+        const uint8_t* data = column->raw_data();
+        switch (key.size) {
+        case 1:
+            pack_one_fixed_size_key<KeyType, 1>(data, key.offset, num_rows, packed_keys);
+            break;
+        case 2:
+            pack_one_fixed_size_key<KeyType, 2>(data, key.offset, num_rows, packed_keys);
+            break;
+        case 4:
+            pack_one_fixed_size_key<KeyType, 4>(data, key.offset, num_rows, packed_keys);
+            break;
+        case 8:
+            pack_one_fixed_size_key<KeyType, 8>(data, key.offset, num_rows, packed_keys);
+            break;
+        default:
+            DCHECK(false) << "unsupported fixed size key of " << static_cast<int>(key.size) << " bytes";
+        }
+
+        if (nullable_column != nullptr && nullable_column->has_null()) {
+            const auto& nulls = nullable_column->immutable_null_column_data();
+            for (size_t j = 0; j < num_rows; ++j) {
+                if (nulls[j]) {
+                    set_null_of_fixed_size_key(key, packed_keys + j);
+                }
+            }
+        }
+    }
+}
+
+// Append the keys packed in the first |num_rows| of |packed_keys| to |key_columns|.
+template <typename KeyType>
+void unpack_fixed_size_keys(const FixedSizeKeyLayout& layout, const KeyType* packed_keys, size_t num_rows,
+                            const Columns& key_columns) {
+    for (size_t i = 0; i < key_columns.size(); ++i) {
+        const FixedSizeKeyLayout::Key& key = layout.keys[i];
+        Column* column = key_columns[i].get();
+        if (column->is_nullable()) {
+            DCHECK_GE(key.null_bit, 0);
+            auto* nullable_column = down_cast<NullableColumn*>(column);
+            auto& nulls = nullable_column->null_column_data();
+            const size_t null_byte = key.null_bit / 8;
+            const uint8_t null_mask = 1u << (key.null_bit % 8);
+            bool has_null = false;
+            size_t old_size = nulls.size();
+            nulls.resize(old_size + num_rows);
+            for (size_t j = 0; j < num_rows; ++j) {
+                nulls[old_size + j] = (reinterpret_cast<const uint8_t*>(packed_keys + j)[null_byte] & null_mask) != 0;
+                has_null |= nulls[old_size + j];
+            }
+            nullable_column->set_has_null(has_null);
+            column = nullable_column->mutable_data_column();
+        }
+
+        size_t old_size = column->size();
+        column->resize_uninitialized(old_size + num_rows);
+        uint8_t* data = column->mutable_raw_data() + old_size * key.size;
+        for (size_t j = 0; j < num_rows; ++j) {
+            memcpy(data + j * key.size, reinterpret_cast<const uint8_t*>(packed_keys + j) + key.offset, key.size);
+        }
+    }
+}
+
+template <typename KeyType, PhmapSeed seed>
+class FixedSizeKeyHashWithSeed {
+public:
+    std::size_t operator()(KeyType value) const { return StdHashWithSeed<KeyType, seed>()(value); }
+};
+
+template <PhmapSeed seed>
+class FixedSizeKeyHashWithSeed<uint128_t, seed> {
+public:
+    std::size_t operator()(uint128_t value) const {
+        phmap_mix_with_seed<sizeof(size_t), seed> mix;
+        return mix(static_cast<uint64_t>(value) ^ mix(static_cast<uint64_t>(value >> 64)));
+    }
+};
+
+} // namespace starrocks::vectorized
@@ -6,6 +6,8 @@
 #include "column/column_hash.h"
 #include "column/column_helper.h"
 #include "column/type_traits.h"
+#include "common/compiler_util.h"
+#include "exec/vectorized/aggregate/agg_fixed_size_key.h"
 #include "gutil/casts.h"
 #include "gutil/strings/fastmem.h"
 #include "runtime/mem_pool.h"
@@ -17,10 +19,89 @@
 namespace starrocks::vectorized {
 
 using AggDataPtr = uint8_t*;
+
+// SmallIntAggHashMap maps the 8-bit or 16-bit integer keys to the agg states by a dense array indexed by the keys,
+// with the interface of the phmap hash maps used by the aggregator. It needs no hashing and no probing, and the
+// keys are iterated in the order of their unsigned bits. The array is allocated by the first key.
+template <typename KeyType>
+class SmallIntAggHashMap {
+public:
+    static_assert(sizeof(KeyType) <= 2, "the keys must be 8-bit or 16-bit integers");
+    using key_type = KeyType;
+    using mapped_type = AggDataPtr;
+    using value_type = std::pair<KeyType, AggDataPtr>;
+    static constexpr size_t kNumKeys = size_t(1) << (8 * sizeof(KeyType));
+
+    class iterator {
+    public:
+        iterator() = default;
+        iterator(const SmallIntAggHashMap* map, size_t index) : _map(map), _index(index) {}
+
+        const value_type& operator*() const { return _map->_slots[_index]; }
+        const value_type* operator->() const { return &_map->_slots[_index]; }
+
+        iterator& operator++() {
+            _index = _map->_next_used(_index + 1);
+            return *this;
+        }
+
+        bool operator==(const iterator& rhs) const { return _index == rhs._index; }
+        bool operator!=(const iterator& rhs) const { return _index != rhs._index; }
+
+    private:
+        const SmallIntAggHashMap* _map = nullptr;
+        size_t _index = kNumKeys;
+    };
+    using const_iterator = iterator;
+
+    iterator begin() const { return iterator(this, _next_used(0)); }
+    iterator end() const { return iterator(this, kNumKeys); }
+
+    iterator find(const KeyType& key) const {
+        size_t index = _index_of(key);
+        return (!_used.empty() && _used[index]) ? iterator(this, index) : end();
+    }
+
+    // |f| is called with a constructor of the key and the agg state if the key doesn't exist, like phmap.
+    template <typename F>
+    iterator lazy_emplace(const KeyType& key, F&& f) {
+        if (UNLIKELY(_used.empty())) {
+            _slots.resize(kNumKeys);
+            _used.resize(kNumKeys, 0);
+        }
+        size_t index = _index_of(key);
+        if (!_used[index]) {
+            f([&](const KeyType& k, AggDataPtr state) { _slots[index] = value_type(k, state); });
+            _used[index] = 1;
+            _size++;
+        }
+        return iterator(this, index);
+    }
+
+    size_t size() const { return _size; }
+    size_t capacity() const { return _slots.size(); }
+    size_t dump_bound() const { return _slots.size() * sizeof(value_type) + _used.size(); }
+
+private:
+    static size_t _index_of(const KeyType& key) { return static_cast<std::make_unsigned_t<KeyType>>(key); }
+
+    size_t _next_used(size_t index) const {
+        while (index < _used.size() && !_used[index]) {
+            index++;
+        }
+        return _used.empty() ? kNumKeys : index;
+    }
+
+    std::vector<value_type> _slots;
+    std::vector<uint8_t> _used;
+    size_t _size = 0;
+};
+
+// The phases of the aggregation use the same dense map of the small integer keys, which has no collision.
 template <PhmapSeed seed>
-using Int8AggHashMap = phmap::flat_hash_map<int8_t, AggDataPtr, StdHashWithSeed<int8_t, seed>>;
+using Int8AggHashMap = SmallIntAggHashMap<int8_t>;
 template <PhmapSeed seed>
-using Int16AggHashMap = phmap::flat_hash_map<int16_t, AggDataPtr, StdHashWithSeed<int16_t, seed>>;
+using Int16AggHashMap = SmallIntAggHashMap<int16_t>;
 template <PhmapSeed seed>
 using Int32AggHashMap = phmap::flat_hash_map<int32_t, AggDataPtr, StdHashWithSeed<int32_t, seed>>;
 template <PhmapSeed seed>
@@ -32,6 +113,10 @@ using TimeStampAggHashMap = phmap::flat_hash_map<TimestampValue, AggDataPtr, Std
 template <PhmapSeed seed>
 using SliceAggHashMap = phmap::flat_hash_map<Slice, AggDataPtr, SliceHashWithSeed<seed>, SliceEqual>;
 
+// The group by keys packed into a fixed size integer, see FixedSizeKeyLayout.
+template <typename KeyType, PhmapSeed seed>
+using FixedSizeKeyAggHashMap = phmap::flat_hash_map<KeyType, AggDataPtr, FixedSizeKeyHashWithSeed<KeyType, seed>>;
+
 template <PhmapSeed seed>
 using Int32AggTwoLevelHashMap = phmap::parallel_flat_hash_map<int32_t, AggDataPtr, StdHashWithSeed<int32_t, seed>>;
 
@@ -502,4 +587,57 @@ struct AggHashMapWithSerializedKey {
     uint8_t* buffer;
     ResultVector results;
 };
+
+// Handle multiple narrow fixed-width group by keys, which are packed into one integer with their null bits,
+// so that they are hashed and compared as an integer rather than a serialized slice.
+template <typename HashMap>
+struct AggHashMapWithSerializedKeyFixedSize {
+    using KeyType = typename HashMap::key_type;
+    using Iterator = typename HashMap::iterator;
+    using ResultVector = typename std::vector<KeyType>;
+    HashMap hash_map;
+    // Set by the aggregator after the hash map is created.
+    FixedSizeKeyLayout layout;
+
+    template <typename Func>
+    void compute_agg_states(size_t chunk_size, const Columns& key_columns, MemPool* pool, Func&& allocate_func,
+                            Buffer<AggDataPtr>* agg_states) {
+        packed_keys.resize(chunk_size);
+        pack_fixed_size_keys(layout, key_columns, chunk_size, packed_keys.data());
+
+        for (size_t i = 0; i < chunk_size; ++i) {
+            KeyType key = packed_keys[i];
+            auto iter = hash_map.lazy_emplace(key, [&](const auto& ctor) { ctor(key, allocate_func()); });
+            (*agg_states)[i] = iter->second;
+        }
+    }
+
+    // Elements queried in HashMap will be added to HashMap,
+    // elements that cannot be queried are not processed,
+    // and are mainly used in the first stage of two-stage aggregation when aggr reduction is low
+    template <typename Func>
+    void compute_agg_states(size_t chunk_size, const Columns& key_columns, Func&& allocate_func,
+                            Buffer<AggDataPtr>* agg_states, std::vector<uint8_t>* not_founds) {
+        packed_keys.resize(chunk_size);
+        pack_fixed_size_keys(layout, key_columns, chunk_size, packed_keys.data());
+
+        not_founds->assign(chunk_size, 0);
+        for (size_t i = 0; i < chunk_size; ++i) {
+            if (auto iter = hash_map.find(packed_keys[i]); iter != hash_map.end()) {
+                (*agg_states)[i] = iter->second;
+            } else {
+                (*not_founds)[i] = 1;
+            }
+        }
+    }
+
+    void insert_keys_to_columns(ResultVector& keys, const Columns& key_columns, int32_t batch_size) {
+        unpack_fixed_size_keys(layout, keys.data(), batch_size, key_columns);
+    }
+
+    static constexpr bool has_single_null_key = false;
+
+    Buffer<KeyType> packed_keys;
+    ResultVector results;
+};
 } // namespace starrocks::vectorized
@@ -4,6 +4,7 @@
 
 #include "column/column_hash.h"
 #include "column/type_traits.h"
+#include "exec/vectorized/aggregate/agg_fixed_size_key.h"
 #include "gutil/casts.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
@@ -24,6 +25,9 @@ template <PhmapSeed seed>
 using DateAggHashSet = phmap::flat_hash_set<DateValue, StdHashWithSeed<DateValue, seed>>;
 template <PhmapSeed seed>
 using TimeStampAggHashSet = phmap::flat_hash_set<TimestampValue, StdHashWithSeed<TimestampValue, seed>>;
+// The group by keys packed into a fixed size integer, see FixedSizeKeyLayout.
+template <typename KeyType, PhmapSeed seed>
+using FixedSizeKeyAggHashSet = phmap::flat_hash_set<KeyType, FixedSizeKeyHashWithSeed<KeyType, seed>>;
 
 // By storing hash value in slice, we can save the cost of
 // 1. re-calculate hash value of the slice
@@ -430,4 +434,46 @@ struct AggHashSetOfSerializedKey {
     ResultVector results;
 };
 
+// Handle multiple narrow fixed-width group by keys, which are packed into one integer with their null bits.
+template <typename HashSet>
+struct AggHashSetOfSerializedKeyFixedSize {
+    using Iterator = typename HashSet::iterator;
+    using KeyType = typename HashSet::key_type;
+    using ResultVector = typename std::vector<KeyType>;
+    HashSet hash_set;
+    // Set by the aggregator after the hash set is created.
+    FixedSizeKeyLayout layout;
+
+    void build_set(size_t chunk_size, const Columns& key_columns, MemPool* pool) {
+        packed_keys.resize(chunk_size);
+        pack_fixed_size_keys(layout, key_columns, chunk_size, packed_keys.data());
+
+        for (size_t i = 0; i < chunk_size; ++i) {
+            hash_set.emplace(packed_keys[i]);
+        }
+    }
+
+    // Elements queried in HashSet will be added to HashSet
+    // elements that cannot be queried are not processed,
+    // and are mainly used in the first stage of two-stage aggregation when aggr reduction is low
+    void build_set(size_t chunk_size, const Columns& key_columns, std::vector<uint8_t>* not_founds) {
+        packed_keys.resize(chunk_size);
+        pack_fixed_size_keys(layout, key_columns, chunk_size, packed_keys.data());
+
+        not_founds->assign(chunk_size, 0);
+        for (size_t i = 0; i < chunk_size; ++i) {
+            (*not_founds)[i] = !hash_set.contains(packed_keys[i]);
+        }
+    }
+
+    void insert_keys_to_columns(ResultVector& keys, const Columns& key_columns, int32_t batch_size) {
+        unpack_fixed_size_keys(layout, keys.data(), batch_size, key_columns);
+    }
+
+    static constexpr bool has_single_null_key = false;
+
+    Buffer<KeyType> packed_keys;
+    ResultVector results;
+};
+
 } // namespace starrocks::vectorized
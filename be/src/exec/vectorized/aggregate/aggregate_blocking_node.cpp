@@ -2,28 +2,56 @@
 
 #include "exec/vectorized/aggregate/aggregate_blocking_node.h"
 
+#include <algorithm>
+#include <set>
+
+#include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "exec/vectorized/olap_scan_node.h"
+#include "exec/vectorized/query_cache.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/exec_env.h"
+#include "util/md5.h"
+#include "util/thrift_util.h"
+
 namespace starrocks::vectorized {
 
+Status AggregateBlockingNode::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(AggregateBaseNode::prepare(state));
+    _spill_timer = ADD_TIMER(_runtime_profile, "SpillTime");
+    _spill_bytes_counter = ADD_COUNTER(_runtime_profile, "SpillBytes", TUnit::BYTES);
+    _spill_partitions_counter = ADD_COUNTER(_runtime_profile, "SpillPartitions", TUnit::UNIT);
+    _query_cache_hit_counter = ADD_COUNTER(_runtime_profile, "QueryCacheHitTablets", TUnit::UNIT);
+    _query_cache_miss_counter = ADD_COUNTER(_runtime_profile, "QueryCacheMissTablets", TUnit::UNIT);
+    return Status::OK();
+}
+
 Status AggregateBlockingNode::open(RuntimeState* state) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::OPEN));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(ExecNode::open(state));
-    RETURN_IF_ERROR(Expr::open(_group_by_expr_ctxs, state));
-    for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
-        RETURN_IF_ERROR(Expr::open(_agg_expr_ctxs[i], state));
-    }
+    RETURN_IF_ERROR(_aggregator->open(state));
+    RETURN_IF_ERROR(_children[0]->open(state));
 
-    // Initial for FunctionContext of every aggregate functions
-    for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
-        // initial const columns for i'th FunctionContext.
-        _evaluate_const_columns(i);
+    if (auto* scan_node = _query_cache_scan_node(); scan_node != nullptr) {
+        return _open_with_query_cache(state, scan_node);
     }
 
-    RETURN_IF_ERROR(_children[0]->open(state));
+    // The groups are spilled with their serialized agg states, so the aggregation without group by, which has
+    // only one group, and the distinct aggregation, which has no agg states, never spill.
+    SpillManager* spill_manager = state->spill_manager();
+    if (config::agg_spill_mem_limit_percent > 0 && !_aggregator->is_none_group_by_exprs() &&
+        !_aggregator->is_only_group_by_columns() && spill_manager != nullptr && spill_manager->spill_enabled()) {
+        _spill_manager = spill_manager;
+        _spill_manager->register_spillable(this);
+    }
 
     ChunkPtr chunk;
 
-    VLOG_ROW << "_group_by_expr_ctxs size " << _group_by_expr_ctxs.size() << " _needs_finalize " << _needs_finalize;
+    VLOG_ROW << "group_by_expr_ctxs size " << _aggregator->group_by_expr_ctxs().size() << " needs_finalize "
+             << _aggregator->needs_finalize();
     while (true) {
         bool eos = false;
         RETURN_IF_CANCELLED(state);
@@ -39,51 +67,58 @@ Status AggregateBlockingNode::open(RuntimeState* state) {
 
         DCHECK_LE(chunk->num_rows(), config::vector_chunk_size);
 
-        _evaluate_exprs(chunk.get());
+        _aggregator->evaluate_exprs(chunk.get());
 
         {
-            SCOPED_TIMER(_agg_compute_timer);
-            if (!_group_by_expr_ctxs.empty()) {
-                if (false) {
-                }
-#define HASH_MAP_METHOD(NAME)                                                                        \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                                   \
-            _build_hash_map<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME, \
-                                                                            chunk->num_rows());
-                APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-
-                RETURN_IF_ERROR(_check_hash_map_memory_usage(state));
-                _try_convert_to_two_level_map();
+            SCOPED_TIMER(_aggregator->agg_compute_timer());
+            if (!_aggregator->is_none_group_by_exprs()) {
+                _aggregator->build_hash_map(chunk->num_rows());
+
+                RETURN_IF_ERROR(_aggregator->check_hash_map_memory_usage(state));
+                _aggregator->try_convert_to_two_level_map();
             }
-            (this->*_compute_agg_states)(chunk->num_rows());
+            _aggregator->compute_agg_states(chunk->num_rows());
 
-            _num_input_rows += chunk->num_rows();
+            _aggregator->update_num_input_rows(chunk->num_rows());
         }
-    }
 
-    if (!_group_by_expr_ctxs.empty()) {
-        COUNTER_SET(_hash_table_size, (int64_t)_hash_map_variant.size());
-        // If hash map is empty, we don't need to return value
-        if (_hash_map_variant.size() == 0) {
-            _is_finished = true;
+        if (_should_spill()) {
+            if (_spill_writer == nullptr) {
+                _spill_writer = std::make_unique<SpillPartitionWriter>(
+                        state->exec_env()->tmp_file_mgr(), state->query_id(),
+                        std::max(config::agg_spill_partitions, 2), 0);
+            }
+            RETURN_IF_ERROR(_spill_hash_map(_aggregator.get(), _spill_writer.get()));
         }
+    }
 
-        if (false) {
+    if (_spill_writer != nullptr) {
+        // All the groups are merged partition by partition, including the ones still in memory.
+        RETURN_IF_ERROR(_spill_hash_map(_aggregator.get(), _spill_writer.get()));
+        RETURN_IF_ERROR(_finish_spilling(_spill_writer.get()));
+        _spill_writer.reset();
+        RETURN_IF_ERROR(_prepare_merge_aggregator(state, "MergeSpilledPartitions"));
+        RETURN_IF_ERROR(_merge_next_spilled_partition(state));
+        COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
+        return Status::OK();
+    }
+
+    if (!_aggregator->is_none_group_by_exprs()) {
+        COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+        // If hash map is empty, we don't need to return value
+        if (_aggregator->hash_map_variant().size() == 0) {
+            _aggregator->set_finished();
         }
-#define HASH_MAP_METHOD(NAME) \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME) _it_hash = _hash_map_variant.NAME->hash_map.begin();
-        APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-    } else if (_group_by_expr_ctxs.empty()) {
+        _aggregator->init_hash_map_iterator();
+    } else {
         // for aggregate no group by, if _num_input_rows is 0,
         // In update phase, we directly return empty chunk.
         // In merge phase, we will handle it.
-        if (_num_input_rows == 0 && !_needs_finalize) {
-            _is_finished = true;
+        if (_aggregator->num_input_rows() == 0 && !_aggregator->needs_finalize()) {
+            _aggregator->set_finished();
         }
     }
-    COUNTER_SET(_input_row_count, _num_input_rows);
+    COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
     return Status::OK();
 }
 
@@ -93,25 +128,22 @@ Status AggregateBlockingNode::get_next(RuntimeState* state, ChunkPtr* chunk, boo
     RETURN_IF_CANCELLED(state);
     *eos = false;
 
-    if (_is_finished) {
+    if (_merge_aggregator != nullptr) {
+        return _get_next_spilled(state, chunk, eos);
+    }
+
+    if (_aggregator->is_finished()) {
         COUNTER_SET(_rows_returned_counter, _num_rows_returned);
         *eos = true;
         return Status::OK();
     }
     int32_t chunk_size = config::vector_chunk_size;
 
-    if (_group_by_expr_ctxs.empty()) {
-        SCOPED_TIMER(_get_results_timer);
-        _convert_to_chunk_no_groupby(chunk);
+    if (_aggregator->is_none_group_by_exprs()) {
+        SCOPED_TIMER(_aggregator->get_results_timer());
+        _aggregator->convert_to_chunk_no_groupby(chunk);
     } else {
-        if (false) {
-        }
-#define HASH_MAP_METHOD(NAME)                                                                                   \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                                              \
-            _convert_hash_map_to_chunk<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME, \
-                                                                                       chunk_size, chunk);
-        APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
+        _aggregator->convert_hash_map_to_chunk(chunk_size, chunk);
     }
 
     eval_join_runtime_filters(chunk->get());
@@ -119,7 +151,7 @@ Status AggregateBlockingNode::get_next(RuntimeState* state, ChunkPtr* chunk, boo
     // For having
     size_t old_size = (*chunk)->num_rows();
     ExecNode::eval_conjuncts(_conjunct_ctxs, (*chunk).get());
-    _num_rows_returned -= (old_size - (*chunk)->num_rows());
+    _aggregator->update_num_rows_returned(-static_cast<int64_t>(old_size - (*chunk)->num_rows()));
 
     _process_limit(chunk);
 
@@ -127,4 +159,284 @@ Status AggregateBlockingNode::get_next(RuntimeState* state, ChunkPtr* chunk, boo
     return Status::OK();
 }
 
-} // namespace starrocks::vectorized
\ No newline at end of file
+Status AggregateBlockingNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    if (_merge_aggregator != nullptr) {
+        _merge_aggregator->close(state);
+    }
+    for (auto& [tablet_id, aggregator] : _tablet_aggregators) {
+        aggregator->close(state);
+    }
+    _tablet_aggregators.clear();
+    if (_spill_manager != nullptr) {
+        _spill_manager->unregister_spillable(this);
+        _spill_manager = nullptr;
+    }
+    _spill_writer.reset();
+    _spilled_partitions.clear();
+    return AggregateBaseNode::close(state);
+}
+
+Status AggregateBlockingNode::_spill_hash_map(Aggregator* aggregator, SpillPartitionWriter* writer) {
+    SCOPED_TIMER(_spill_timer);
+    const auto& slots = aggregator->intermediate_tuple_desc()->slots();
+    const size_t num_keys = aggregator->group_by_expr_ctxs().size();
+    Columns key_columns(num_keys);
+    return aggregator->spill_hash_map([&](const ChunkPtr& chunk) {
+        for (size_t i = 0; i < num_keys; ++i) {
+            key_columns[i] = chunk->get_column_by_slot_id(slots[i]->id());
+        }
+        return writer->add_chunk(chunk, key_columns);
+    });
+}
+
+Status AggregateBlockingNode::_finish_spilling(SpillPartitionWriter* writer) {
+    SCOPED_TIMER(_spill_timer);
+    RETURN_IF_ERROR(writer->finish());
+    for (auto& file : writer->files()) {
+        if (file == nullptr) {
+            continue;
+        }
+        COUNTER_UPDATE(_spill_bytes_counter, file->num_bytes());
+        COUNTER_UPDATE(_spill_partitions_counter, 1);
+        _spilled_partitions.push_back({writer->level(), std::move(file)});
+    }
+    return Status::OK();
+}
+
+Status AggregateBlockingNode::_prepare_merge_aggregator(RuntimeState* state, const std::string& profile_name) {
+    _merge_aggregator = std::make_shared<Aggregator>(_aggregator->tnode());
+    _merge_aggregator->set_aggr_phase(AggrPhase2);
+    _merge_aggregator->set_intermediate_input();
+    RowDescriptor row_desc;
+    RETURN_IF_ERROR(_merge_aggregator->prepare(state, _pool, _runtime_profile->create_child(profile_name),
+                                               mem_tracker(), expr_mem_tracker(), row_desc));
+    return _merge_aggregator->open(state);
+}
+
+Status AggregateBlockingNode::_merge_next_spilled_partition(RuntimeState* state) {
+    while (!_spilled_partitions.empty()) {
+        SpilledPartition partition = std::move(_spilled_partitions.back());
+        _spilled_partitions.pop_back();
+        _merge_aggregator->reset_hash_map();
+
+        std::unique_ptr<SpillPartitionWriter> writer;
+        while (true) {
+            RETURN_IF_CANCELLED(state);
+            ChunkPtr chunk;
+            {
+                SCOPED_TIMER(_spill_timer);
+                RETURN_IF_ERROR(partition.file->read_next(&chunk));
+            }
+            if (chunk == nullptr) {
+                break;
+            }
+            const size_t chunk_size = chunk->num_rows();
+            _merge_aggregator->evaluate_intermediate_columns(chunk.get());
+            {
+                SCOPED_TIMER(_merge_aggregator->agg_compute_timer());
+                _merge_aggregator->build_hash_map(chunk_size);
+                RETURN_IF_ERROR(_merge_aggregator->check_hash_map_memory_usage(state));
+                _merge_aggregator->try_convert_to_two_level_map();
+                _merge_aggregator->compute_agg_states(chunk_size);
+            }
+
+            if (partition.level + 1 < MAX_SPILL_LEVELS && _should_spill()) {
+                if (writer == nullptr) {
+                    writer = std::make_unique<SpillPartitionWriter>(state->exec_env()->tmp_file_mgr(),
+                                                                    state->query_id(),
+                                                                    std::max(config::agg_spill_partitions, 2),
+                                                                    partition.level + 1);
+                }
+                RETURN_IF_ERROR(_spill_hash_map(_merge_aggregator.get(), writer.get()));
+            }
+        }
+
+        if (writer != nullptr) {
+            RETURN_IF_ERROR(_spill_hash_map(_merge_aggregator.get(), writer.get()));
+            RETURN_IF_ERROR(_finish_spilling(writer.get()));
+            continue;
+        }
+        if (_merge_aggregator->hash_map_variant().size() > 0) {
+            COUNTER_UPDATE(_aggregator->hash_table_size(), (int64_t)_merge_aggregator->hash_map_variant().size());
+            _merge_aggregator->init_hash_map_iterator();
+            return Status::OK();
+        }
+    }
+    _merge_aggregator->set_finished();
+    return Status::OK();
+}
+
+Status AggregateBlockingNode::_get_next_spilled(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    // The merge aggregator is finished once the groups of the current partition are all output.
+    while (_merge_aggregator->is_finished()) {
+        if (_merge_aggregator->reached_limit() || _spilled_partitions.empty()) {
+            COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+            *eos = true;
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(_merge_next_spilled_partition(state));
+    }
+
+    _merge_aggregator->convert_hash_map_to_chunk(config::vector_chunk_size, chunk);
+
+    eval_join_runtime_filters(chunk->get());
+
+    // For having
+    size_t old_size = (*chunk)->num_rows();
+    ExecNode::eval_conjuncts(_conjunct_ctxs, (*chunk).get());
+    _merge_aggregator->update_num_rows_returned(-static_cast<int64_t>(old_size - (*chunk)->num_rows()));
+
+    _process_limit(_merge_aggregator.get(), chunk);
+
+    DCHECK_CHUNK(*chunk);
+    return Status::OK();
+}
+
+OlapScanNode* AggregateBlockingNode::_query_cache_scan_node() const {
+    // The groups are merged by their hash map, and the distinct aggregation has no agg states to serialize.
+    if (QueryCache::instance() == nullptr || _aggregator->is_none_group_by_exprs() ||
+        _aggregator->is_only_group_by_columns()) {
+        return nullptr;
+    }
+    auto* scan_node = dynamic_cast<OlapScanNode*>(_children[0]);
+    // The rows filtered by the runtime filters of the joins or cut by the limit differ from query to query.
+    if (scan_node == nullptr || scan_node->limit() != -1 ||
+        !scan_node->runtime_filter_collector().descriptors().empty()) {
+        return nullptr;
+    }
+    std::set<int64_t> tablet_ids;
+    for (const auto& range : scan_node->scan_ranges()) {
+        if (!tablet_ids.insert(range->tablet_id).second) {
+            return nullptr;
+        }
+    }
+    return scan_node;
+}
+
+Status AggregateBlockingNode::_open_with_query_cache(RuntimeState* state, OlapScanNode* scan_node) {
+    QueryCache* cache = QueryCache::instance();
+    // The results depend on the plans of this node and the scan, and on the time zone of the exprs.
+    TPlanNode plan_node = _aggregator->tnode();
+    ThriftSerializer serializer(false, 1024);
+    uint8_t* buf = nullptr;
+    uint32_t len = 0;
+    RETURN_IF_ERROR(serializer.serialize(&plan_node, &len, &buf));
+    Md5Digest digest;
+    digest.update(buf, len);
+    digest.update(scan_node->plan_digest().data(), scan_node->plan_digest().size());
+    digest.update(state->timezone().data(), state->timezone().size());
+    digest.digest();
+
+    std::vector<std::shared_ptr<const QueryCache::Result>> results;
+    std::map<int64_t, std::string> missed_keys;
+    std::set<int64_t> missed_tablets;
+    for (const auto& range : scan_node->scan_ranges()) {
+        std::string key = QueryCache::make_key(digest.hex(), range->tablet_id, range->version);
+        if (auto result = cache->lookup(key); result != nullptr) {
+            results.emplace_back(std::move(result));
+        } else {
+            missed_tablets.insert(range->tablet_id);
+            missed_keys.emplace(range->tablet_id, std::move(key));
+        }
+    }
+    COUNTER_UPDATE(_query_cache_hit_counter, results.size());
+    COUNTER_UPDATE(_query_cache_miss_counter, missed_keys.size());
+    scan_node->retain_scan_ranges(missed_tablets);
+
+    // The chunks of the tablets are interleaved, so every tablet is aggregated by an aggregator of its own.
+    if (!missed_tablets.empty()) {
+        // the counters of the aggregators of the tablets are added up in one profile.
+        RuntimeProfile* profile = _runtime_profile->create_child("AggregateTablets");
+        for (int64_t tablet_id : missed_tablets) {
+            auto aggregator = std::make_shared<Aggregator>(_aggregator->tnode());
+            aggregator->set_aggr_phase(AggrPhase2);
+            _tablet_aggregators.emplace(tablet_id, aggregator);
+            RETURN_IF_ERROR(aggregator->prepare(state, _pool, profile, mem_tracker(), expr_mem_tracker(),
+                                                child(0)->row_desc()));
+            RETURN_IF_ERROR(aggregator->open(state));
+        }
+        while (true) {
+            RETURN_IF_CANCELLED(state);
+            ChunkPtr chunk;
+            int64_t tablet_id = 0;
+            bool eos = false;
+            RETURN_IF_ERROR(scan_node->get_next(state, &chunk, &tablet_id, &eos));
+            if (eos) {
+                break;
+            }
+            if (chunk->is_empty()) {
+                continue;
+            }
+            auto iter = _tablet_aggregators.find(tablet_id);
+            if (iter == _tablet_aggregators.end()) {
+                return Status::InternalError(strings::Substitute("unexpected chunk of tablet $0", tablet_id));
+            }
+            Aggregator* aggregator = iter->second.get();
+            aggregator->evaluate_exprs(chunk.get());
+            SCOPED_TIMER(_aggregator->agg_compute_timer());
+            aggregator->build_hash_map(chunk->num_rows());
+            RETURN_IF_ERROR(aggregator->check_hash_map_memory_usage(state));
+            aggregator->try_convert_to_two_level_map();
+            aggregator->compute_agg_states(chunk->num_rows());
+            _aggregator->update_num_input_rows(chunk->num_rows());
+        }
+        for (auto& [tablet_id, aggregator] : _tablet_aggregators) {
+            auto result = std::make_shared<QueryCache::Result>();
+            size_t charge = 0;
+            RETURN_IF_ERROR(aggregator->spill_hash_map([&](const ChunkPtr& chunk) {
+                charge += chunk->memory_usage();
+                result->emplace_back(chunk);
+                return Status::OK();
+            }));
+            cache->insert(missed_keys[tablet_id], result, charge);
+            results.emplace_back(std::move(result));
+        }
+    }
+    COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
+
+    RETURN_IF_ERROR(_prepare_merge_aggregator(state, "MergeQueryCacheResults"));
+    for (const auto& result : results) {
+        for (const auto& chunk : *result) {
+            RETURN_IF_CANCELLED(state);
+            const size_t chunk_size = chunk->num_rows();
+            _merge_aggregator->evaluate_intermediate_columns(chunk.get());
+            SCOPED_TIMER(_merge_aggregator->agg_compute_timer());
+            _merge_aggregator->build_hash_map(chunk_size);
+            RETURN_IF_ERROR(_merge_aggregator->check_hash_map_memory_usage(state));
+            _merge_aggregator->try_convert_to_two_level_map();
+            _merge_aggregator->compute_agg_states(chunk_size);
+        }
+    }
+    if (_merge_aggregator->hash_map_variant().size() > 0) {
+        COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_merge_aggregator->hash_map_variant().size());
+        _merge_aggregator->init_hash_map_iterator();
+    } else {
+        _merge_aggregator->set_finished();
+    }
+    return Status::OK();
+}
+
+pipeline::OpFactories AggregateBlockingNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    OpFactories operators_with_sink = _children[0]->decompose_to_pipeline(context);
+    // The sink and source operators of all the drivers share one context, the partial hash maps
+    // built by the sink drivers are partitioned by the group by keys and merged by the source drivers.
+    auto agg_context = std::make_shared<AggregateBlockingContext>();
+    operators_with_sink.emplace_back(std::make_shared<AggregateBlockingSinkOperatorFactory>(
+            context->next_operator_id(), id(), _aggregator->tnode(), agg_context));
+    context->add_pipeline(operators_with_sink);
+
+    OpFactories operators_with_source;
+    operators_with_source.emplace_back(std::make_shared<AggregateBlockingSourceOperatorFactory>(
+            context->next_operator_id(), id(), _aggregator->tnode(), agg_context));
+    if (limit() != -1) {
+        operators_with_source.emplace_back(
+                std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return operators_with_source;
+}
+
+} // namespace starrocks::vectorized
@@ -2,18 +2,83 @@
 
 #pragma once
 
+#include <map>
+
+#include "common/config.h"
 #include "exec/vectorized/aggregate/aggregate_base_node.h"
+#include "exec/vectorized/chunk_spiller.h"
+#include "exec/vectorized/spill_manager.h"
 
 // Aggregate means this node handle query with aggregate functions.
 // Blocking means this node will consume all input and build hash map in open phase.
 namespace starrocks::vectorized {
-class AggregateBlockingNode final : public AggregateBaseNode {
+class OlapScanNode;
+
+class AggregateBlockingNode final : public AggregateBaseNode, public Spillable {
 public:
     AggregateBlockingNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
             : AggregateBaseNode(pool, tnode, descs) {
-        _aggr_phase = AggrPhase2;
+        _aggregator->set_aggr_phase(AggrPhase2);
     };
+    Status prepare(RuntimeState* state) override;
     Status open(RuntimeState* state) override;
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
+    Status close(RuntimeState* state) override;
+
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
+
+    // The hash map being built, i.e. the one merging a spilled partition once the input is spilled.
+    int64_t spillable_bytes() const override {
+        return (_merge_aggregator != nullptr ? _merge_aggregator : _aggregator)->hash_map_memory_usage();
+    }
+
+private:
+    // The groups of a spilled partition have the same hash values of the group by keys at each level of
+    // partitioning. The partitions of the last level are always merged in memory, because the groups
+    // whose keys have the same hash values can't be partitioned further.
+    static constexpr int MAX_SPILL_LEVELS = 4;
+
+    struct SpilledPartition {
+        int level = 0;
+        std::unique_ptr<SpilledChunkFile> file;
+    };
+
+    bool _should_spill() {
+        return _spill_manager != nullptr && _spill_manager->should_spill(this, config::agg_spill_mem_limit_percent);
+    }
+    // Move the groups of |aggregator| into the partitions of |writer| by the group by keys.
+    Status _spill_hash_map(Aggregator* aggregator, SpillPartitionWriter* writer);
+    Status _finish_spilling(SpillPartitionWriter* writer);
+
+    // Create |_merge_aggregator|, which merges the groups of the intermediate chunks.
+    Status _prepare_merge_aggregator(RuntimeState* state, const std::string& profile_name);
+    // Merge the spilled partitions one by one until one of them fits in memory, whose groups are output next.
+    // The partition that doesn't fit in memory is partitioned again by the next level.
+    Status _merge_next_spilled_partition(RuntimeState* state);
+    Status _get_next_spilled(RuntimeState* state, ChunkPtr* chunk, bool* eos);
+
+    // The child whose results could be cached by the tablets, nullptr if the query cache doesn't apply.
+    OlapScanNode* _query_cache_scan_node() const;
+    // Aggregate the rows of every tablet whose result isn't cached by an aggregator of its own, cache the results,
+    // and merge them with the cached ones by |_merge_aggregator|, whose groups are output then.
+    Status _open_with_query_cache(RuntimeState* state, OlapScanNode* scan_node);
+
+    // Decides when the hash map is spilled, nullptr if it never spills.
+    SpillManager* _spill_manager = nullptr;
+    // The writer of the first level, which partitions the groups of the input.
+    std::unique_ptr<SpillPartitionWriter> _spill_writer;
+    // The partitions of a deeper level are merged first, which bounds the disk usage.
+    std::vector<SpilledPartition> _spilled_partitions;
+    // Merges the serialized agg states of the spilled partitions, only created if the node spills.
+    AggregatorPtr _merge_aggregator;
+    // The aggregators of the tablets whose results aren't cached, only created if the query cache applies.
+    std::map<int64_t, AggregatorPtr> _tablet_aggregators;
+
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _spill_partitions_counter = nullptr;
+    RuntimeProfile::Counter* _query_cache_hit_counter = nullptr;
+    RuntimeProfile::Counter* _query_cache_miss_counter = nullptr;
 };
 } // namespace starrocks::vectorized
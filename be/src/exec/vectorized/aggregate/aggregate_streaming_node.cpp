@@ -2,7 +2,11 @@
 
 #include "exec/vectorized/aggregate/aggregate_streaming_node.h"
 
+#include "exec/pipeline/aggregate/aggregate_streaming_operator.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/pipeline_builder.h"
 #include "simd/simd.h"
+#include "util/stopwatch.hpp"
 
 namespace starrocks::vectorized {
 
@@ -10,18 +14,7 @@ Status AggregateStreamingNode::open(RuntimeState* state) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::OPEN));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(ExecNode::open(state));
-    RETURN_IF_ERROR(Expr::open(_group_by_expr_ctxs, state));
-
-    for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
-        RETURN_IF_ERROR(Expr::open(_agg_expr_ctxs[i], state));
-    }
-
-    // Initial for FunctionContext of every aggregate functions
-    for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
-        // initial const columns for i'th FunctionContext.
-        _evaluate_const_columns(i);
-    }
-
+    RETURN_IF_ERROR(_aggregator->open(state));
     RETURN_IF_ERROR(_children[0]->open(state));
     return Status::OK();
 }
@@ -32,9 +25,9 @@ Status AggregateStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bo
     RETURN_IF_CANCELLED(state);
     *eos = false;
 
-    if (_is_finished) {
+    if (_aggregator->is_finished()) {
         COUNTER_SET(_rows_returned_counter, _num_rows_returned);
-        COUNTER_SET(_pass_through_row_count, _num_pass_through_rows);
+        COUNTER_SET(_aggregator->pass_through_row_count(), _aggregator->num_pass_through_rows());
         *eos = true;
         return Status::OK();
     }
@@ -48,105 +41,88 @@ Status AggregateStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bo
                 continue;
             }
             size_t input_chunk_size = input_chunk->num_rows();
-            _num_input_rows += input_chunk_size;
-            COUNTER_SET(_input_row_count, _num_input_rows);
-            RETURN_IF_ERROR(_check_hash_map_memory_usage(state));
-            _evaluate_exprs(input_chunk.get());
+            _aggregator->update_num_input_rows(input_chunk_size);
+            COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
+            RETURN_IF_ERROR(_aggregator->check_hash_map_memory_usage(state));
+            _aggregator->evaluate_exprs(input_chunk.get());
 
-            if (_streaming_preaggregation_mode == TStreamingPreaggregationMode::FORCE_STREAMING) {
+            if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::FORCE_STREAMING) {
                 // force execute streaming
-                SCOPED_TIMER(_streaming_timer);
-                _output_chunk_by_streaming(chunk);
+                SCOPED_TIMER(_aggregator->streaming_timer());
+                _aggregator->output_chunk_by_streaming(chunk);
                 break;
-            } else if (_streaming_preaggregation_mode == TStreamingPreaggregationMode::FORCE_PREAGGREGATION) {
-                SCOPED_TIMER(_agg_compute_timer);
-                if (false) {
-                }
-#define HASH_MAP_METHOD(NAME)                                                                        \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                                   \
-            _build_hash_map<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME, \
-                                                                            input_chunk_size);
-                APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-                else {
-                    DCHECK(false);
-                }
-
-                (this->*_compute_agg_states)(input_chunk_size);
+            } else if (_aggregator->streaming_preaggregation_mode() ==
+                       TStreamingPreaggregationMode::FORCE_PREAGGREGATION) {
+                SCOPED_TIMER(_aggregator->agg_compute_timer());
+                _aggregator->build_hash_map(input_chunk_size);
+                _aggregator->compute_agg_states(input_chunk_size);
 
-                _try_convert_to_two_level_map();
-                COUNTER_SET(_hash_table_size, (int64_t)_hash_map_variant.size());
+                _aggregator->try_convert_to_two_level_map();
+                COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
 
                 continue;
+            } else if (_aggregator->is_streaming_passthrough()) {
+                {
+                    SCOPED_TIMER(_aggregator->streaming_timer());
+                    _aggregator->output_chunk_by_streaming(chunk);
+                }
+                _aggregator->update_streaming_passthrough_chunk();
+                break;
             } else {
+                const size_t ht_size_before = _aggregator->hash_map_variant().size();
+                size_t num_passed_rows = 0;
+                MonotonicStopWatch watch;
+                watch.start();
                 // TODO: calc the real capacity of hashtable, will add one interface in the class of habletable
-                size_t real_capacity = _hash_map_variant.capacity() - _hash_map_variant.capacity() / 8;
-                size_t remain_size = real_capacity - _hash_map_variant.size();
+                size_t real_capacity = _aggregator->hash_map_variant().capacity() -
+                                       _aggregator->hash_map_variant().capacity() / 8;
+                size_t remain_size = real_capacity - _aggregator->hash_map_variant().size();
                 bool ht_needs_expansion = remain_size < input_chunk_size;
                 if (!ht_needs_expansion ||
-                    _should_expand_preagg_hash_tables(input_chunk_size, _mem_pool->total_allocated_bytes(),
-                                                      _hash_map_variant.size())) {
+                    _aggregator->should_expand_preagg_hash_tables(input_chunk_size,
+                                                                  _aggregator->mem_pool()->total_allocated_bytes(),
+                                                                  _aggregator->hash_map_variant().size())) {
                     // hash table is not full or allow expand the hash table according reduction rate
-                    SCOPED_TIMER(_agg_compute_timer);
-                    if (false) {
-                    }
-#define HASH_MAP_METHOD(NAME)                                                                        \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                                   \
-            _build_hash_map<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME, \
-                                                                            input_chunk_size);
-                    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-                    else {
-                        DCHECK(false);
-                    }
+                    SCOPED_TIMER(_aggregator->agg_compute_timer());
+                    _aggregator->build_hash_map(input_chunk_size);
+                    _aggregator->compute_agg_states(input_chunk_size);
 
-                    (this->*_compute_agg_states)(input_chunk_size);
-
-                    _try_convert_to_two_level_map();
-                    COUNTER_SET(_hash_table_size, (int64_t)_hash_map_variant.size());
-
-                    continue;
+                    _aggregator->try_convert_to_two_level_map();
+                    COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
                 } else {
                     // TODO: direct call the function may affect the performance of some aggregated cases
                     {
-                        SCOPED_TIMER(_agg_compute_timer);
-                        if (false) {
-                        }
-#define HASH_MAP_METHOD(NAME)                                                         \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                    \
-            _build_hash_map<typename decltype(_hash_map_variant.NAME)::element_type>( \
-                    *_hash_map_variant.NAME, input_chunk_size, &_streaming_selection);
-                        APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-                        else {
-                            DCHECK(false);
-                        }
+                        SCOPED_TIMER(_aggregator->agg_compute_timer());
+                        _aggregator->build_hash_map_with_selection(input_chunk_size);
                     }
 
-                    size_t zero_count = SIMD::count_zero(_streaming_selection);
+                    size_t zero_count = SIMD::count_zero(_aggregator->streaming_selection());
+                    num_passed_rows = _aggregator->streaming_selection().size() - zero_count;
                     if (zero_count == 0) {
-                        SCOPED_TIMER(_streaming_timer);
-                        _output_chunk_by_streaming(chunk);
-                    } else if (zero_count == _streaming_selection.size()) {
-                        SCOPED_TIMER(_agg_compute_timer);
-                        _compute_batch_agg_states(input_chunk_size);
+                        SCOPED_TIMER(_aggregator->streaming_timer());
+                        _aggregator->output_chunk_by_streaming(chunk);
+                    } else if (zero_count == _aggregator->streaming_selection().size()) {
+                        SCOPED_TIMER(_aggregator->agg_compute_timer());
+                        _aggregator->compute_batch_agg_states(input_chunk_size);
                     } else {
                         {
-                            SCOPED_TIMER(_agg_compute_timer);
-                            _compute_batch_agg_states(input_chunk_size, _streaming_selection);
+                            SCOPED_TIMER(_aggregator->agg_compute_timer());
+                            _aggregator->compute_batch_agg_states(input_chunk_size,
+                                                                  _aggregator->streaming_selection());
                         }
                         {
-                            SCOPED_TIMER(_streaming_timer);
-                            _output_chunk_by_streaming(chunk, _streaming_selection);
+                            SCOPED_TIMER(_aggregator->streaming_timer());
+                            _aggregator->output_chunk_by_streaming(chunk, _aggregator->streaming_selection());
                         }
                     }
 
-                    COUNTER_SET(_hash_table_size, (int64_t)_hash_map_variant.size());
-                    if ((*chunk)->num_rows() > 0) {
-                        break;
-                    } else {
-                        continue;
-                    }
+                    COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+                }
+                const size_t num_new_groups = _aggregator->hash_map_variant().size() - ht_size_before;
+                _aggregator->update_streaming_aggregated_chunk(input_chunk_size, num_new_groups + num_passed_rows,
+                                                               watch.elapsed_time());
+                if (*chunk != nullptr && (*chunk)->num_rows() > 0) {
+                    break;
                 }
             }
         }
@@ -155,13 +131,13 @@ Status AggregateStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bo
     eval_join_runtime_filters(chunk->get());
 
     if (_child_eos) {
-        if (_hash_table_eos) {
+        if (_aggregator->is_ht_eos()) {
             COUNTER_SET(_rows_returned_counter, _num_rows_returned);
             *eos = true;
             return Status::OK();
         }
 
-        if (_hash_map_variant.size() > 0) {
+        if (_aggregator->hash_map_variant().size() > 0) {
             // child has iterator over, and the hashtable has data
             _output_chunk_from_hash_map(chunk);
             *eos = false;
@@ -182,30 +158,24 @@ Status AggregateStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bo
 }
 
 void AggregateStreamingNode::_output_chunk_from_hash_map(ChunkPtr* chunk) {
-    if (!_it_hash.has_value()) {
-        if (false) {
-        }
-#define HASH_MAP_METHOD(NAME) \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME) _it_hash = _hash_map_variant.NAME->hash_map.begin();
-        APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-        else {
-            DCHECK(false);
-        }
-        COUNTER_SET(_hash_table_size, (int64_t)_hash_map_variant.size());
+    if (!_aggregator->it_hash().has_value()) {
+        _aggregator->init_hash_map_iterator();
+        COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
     }
 
-    if (false) {
-    }
-#define HASH_MAP_METHOD(NAME)                                                           \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                      \
-            _convert_hash_map_to_chunk<decltype(_hash_map_variant.NAME)::element_type>( \
-                    *_hash_map_variant.NAME, config::vector_chunk_size, chunk);
-    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-    else {
-        DCHECK(false);
+    _aggregator->convert_hash_map_to_chunk(config::vector_chunk_size, chunk);
+}
+
+pipeline::OpFactories AggregateStreamingNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    OpFactories operators = _children[0]->decompose_to_pipeline(context);
+    // Pre-aggregation is partial by nature, every driver aggregates its own input independently.
+    operators.emplace_back(std::make_shared<AggregateStreamingOperatorFactory>(context->next_operator_id(), id(),
+                                                                               _aggregator->tnode()));
+    if (limit() != -1) {
+        operators.emplace_back(std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
     }
+    return operators;
 }
 
 } // namespace starrocks::vectorized
@@ -0,0 +1,579 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <any>
+#include <functional>
+
+#include "column/column_helper.h"
+#include "column/type_traits.h"
+#include "exec/vectorized/aggregate/agg_hash_variant.h"
+#include "exprs/agg/aggregate_factory.h"
+#include "exprs/expr.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::vectorized {
+
+struct AggFunctionTypes {
+    TypeDescriptor result_type;
+    TypeDescriptor serde_type; // for serialize
+    std::vector<FunctionContext::TypeDesc> arg_typedescs;
+    bool has_nullable_child;
+    bool is_nullable; // agg function result whether is nullable
+};
+
+struct GroupByColumnTypes {
+    TypeDescriptor result_type;
+    bool is_nullable;
+};
+
+enum AggrPhase { AggrPhase1, AggrPhase2 };
+
+struct StreamingHtMinReductionEntry {
+    int min_ht_mem;
+    double streaming_ht_min_reduction;
+};
+
+static const StreamingHtMinReductionEntry STREAMING_HT_MIN_REDUCTION[] = {
+        {0, 0.0},
+        {256 * 1024, 1.1},
+        {2 * 1024 * 1024, 2.0},
+};
+
+static const int STREAMING_HT_MIN_REDUCTION_SIZE =
+        sizeof(STREAMING_HT_MIN_REDUCTION) / sizeof(STREAMING_HT_MIN_REDUCTION[0]);
+
+class Aggregator;
+using AggregatorPtr = std::shared_ptr<Aggregator>;
+
+// Aggregator holds the hash table, the aggregate states and the expressions of one aggregation
+// instance. It is shared by the aggregate ExecNodes and the pipeline aggregate operators, every
+// pipeline driver owns its own Aggregator so that the drivers never contend on the hash table.
+class Aggregator {
+public:
+    Aggregator(const TPlanNode& tnode);
+    ~Aggregator() = default;
+
+    Status prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile* runtime_profile, MemTracker* mem_tracker,
+                   MemTracker* expr_mem_tracker, const RowDescriptor& child_row_desc);
+    Status open(RuntimeState* state);
+    Status close(RuntimeState* state);
+
+    // Must be called before prepare.
+    void set_aggr_phase(AggrPhase aggr_phase) { _aggr_phase = aggr_phase; }
+    AggrPhase get_aggr_phase() const { return _aggr_phase; }
+
+    // Must be called before prepare. The partial aggregators of the pipeline blocking aggregation
+    // always serialize their states, the final step is left to the merging aggregator.
+    void set_needs_finalize(bool needs_finalize) { _needs_finalize = needs_finalize; }
+    bool needs_finalize() const { return _needs_finalize; }
+
+    // Must be called before prepare. The input chunks consist of the group by columns and the
+    // serialized aggregate states of the intermediate tuple, which are merged by merge functions.
+    void set_intermediate_input() { _is_intermediate_input = true; }
+
+    const TPlanNode& tnode() const { return _tnode; }
+    int64_t limit() const { return _limit; }
+    bool reached_limit() const { return _limit != -1 && _num_rows_returned >= _limit; }
+
+    bool is_none_group_by_exprs() const { return _group_by_expr_ctxs.empty(); }
+    bool is_only_group_by_columns() const { return _is_only_group_by_columns; }
+    const std::vector<ExprContext*>& group_by_expr_ctxs() const { return _group_by_expr_ctxs; }
+    const std::vector<starrocks_udf::FunctionContext*>& agg_fn_ctxs() const { return _agg_fn_ctxs; }
+    const std::vector<std::vector<ExprContext*>>& agg_expr_ctxs() const { return _agg_expr_ctxs; }
+    TupleDescriptor* intermediate_tuple_desc() const { return _intermediate_tuple_desc; }
+    TupleDescriptor* output_tuple_desc() const { return _output_tuple_desc; }
+
+    bool is_finished() const { return _is_finished; }
+    void set_finished() { _is_finished = true; }
+    bool is_ht_eos() const { return _hash_table_eos; }
+
+    int64_t num_input_rows() const { return _num_input_rows; }
+    void update_num_input_rows(int64_t increment) { _num_input_rows += increment; }
+    int64_t num_rows_returned() const { return _num_rows_returned; }
+    void update_num_rows_returned(int64_t increment) { _num_rows_returned += increment; }
+    int64_t num_pass_through_rows() const { return _num_pass_through_rows; }
+
+    TStreamingPreaggregationMode::type streaming_preaggregation_mode() const {
+        return _streaming_preaggregation_mode;
+    }
+    HashMapVariant& hash_map_variant() { return _hash_map_variant; }
+    HashSetVariant& hash_set_variant() { return _hash_set_variant; }
+    std::any& it_hash() { return _it_hash; }
+    std::vector<uint8_t>& streaming_selection() { return _streaming_selection; }
+    MemPool* mem_pool() { return _mem_pool.get(); }
+
+    RuntimeProfile::Counter* get_results_timer() { return _get_results_timer; }
+    RuntimeProfile::Counter* agg_compute_timer() { return _agg_compute_timer; }
+    RuntimeProfile::Counter* streaming_timer() { return _streaming_timer; }
+    RuntimeProfile::Counter* input_row_count() { return _input_row_count; }
+    RuntimeProfile::Counter* hash_table_size() { return _hash_table_size; }
+    RuntimeProfile::Counter* pass_through_row_count() { return _pass_through_row_count; }
+
+    // Truncate the chunk and mark the aggregator finished if the limit is reached.
+    void process_limit(ChunkPtr* chunk);
+
+    bool should_expand_preagg_hash_tables(size_t input_chunk_size, int64_t ht_mem, int64_t ht_rows) const;
+
+    // The streaming pre-aggregation in auto mode either aggregates or passes through the chunks of a window.
+    // The window is passed through if the reduction ratio measured in the last aggregating window is too low
+    // for the probe cost of the hash map, and the passthrough windows get longer while the input stays hard
+    // to reduce, so that the low and the high cardinality stretches of the input each get the right strategy.
+    bool is_streaming_passthrough() const { return _is_streaming_passthrough; }
+    // Called for each chunk aggregated, |num_output_rows| are the new groups plus the rows passed through.
+    void update_streaming_aggregated_chunk(size_t num_input_rows, size_t num_output_rows, int64_t probe_ns);
+    // Called for each chunk passed through.
+    void update_streaming_passthrough_chunk();
+
+    // For aggregate without group by
+    void compute_single_agg_state(size_t chunk_size);
+
+    // For aggregate with group by
+    void compute_batch_agg_states(size_t chunk_size);
+
+    void compute_batch_agg_states(size_t chunk_size, const std::vector<uint8_t>& selection);
+
+    // Compute the agg states of the current evaluated columns, dispatch to single or batch by group by exprs.
+    void compute_agg_states(size_t chunk_size) { (this->*_compute_agg_states)(chunk_size); }
+
+    void evaluate_exprs(Chunk* chunk);
+
+    // Take the group by columns and the serialized agg state columns of an intermediate chunk
+    // as the input columns, used by the aggregator which is set_intermediate_input.
+    void evaluate_intermediate_columns(Chunk* chunk);
+
+    void output_chunk_by_streaming(ChunkPtr* chunk);
+
+    // Elements queried in HashTable will be added to HashTable,
+    // elements that cannot be queried are not processed,
+    // and are mainly used in the first stage of two-stage aggregation when aggr reduction is low
+    // selection[i] = 0: found in hash table
+    // selection[1] = 1: not found in hash table
+    void output_chunk_by_streaming(ChunkPtr* chunk, const std::vector<uint8_t>& filter);
+
+    // Convert one row agg states to chunk
+    void convert_to_chunk_no_groupby(ChunkPtr* chunk);
+
+    Status check_hash_map_memory_usage(RuntimeState* state);
+
+    Status check_hash_set_memory_usage(RuntimeState* state);
+
+    // At first, we use single hash map, if hash map is too big,
+    // we convert the single hash map to two level hash map.
+    // two level hash map is better in large data set.
+    void try_convert_to_two_level_map();
+
+    // Dispatch the current hash map or hash set variant to the templates below.
+    void build_hash_map(size_t chunk_size);
+    void build_hash_map_with_selection(size_t chunk_size);
+    void build_hash_set(size_t chunk_size);
+    void build_hash_set_with_selection(size_t chunk_size);
+    void convert_hash_map_to_chunk(int32_t chunk_size, ChunkPtr* chunk);
+    void convert_hash_set_to_chunk(int32_t chunk_size, ChunkPtr* chunk);
+    void init_hash_map_iterator();
+    void init_hash_set_iterator();
+
+    // The memory of the hash map, its keys and its agg states.
+    int64_t hash_map_memory_usage() const {
+        return static_cast<int64_t>(_hash_map_variant.memory_usage()) + _last_agg_func_memory_usage +
+               _mem_pool->total_reserved_bytes();
+    }
+
+    // Pass all the groups of the hash map to |consumer| as intermediate chunks, i.e. the agg states are
+    // serialized whether needs_finalize or not, then reset the hash map. Used to spill the hash map which
+    // doesn't fit in memory, the spilled chunks are merged later by an aggregator of intermediate input.
+    Status spill_hash_map(const std::function<Status(const ChunkPtr&)>& consumer);
+
+    // Destroy all the groups of the hash map and free their memory, the hash map is built again from empty.
+    void reset_hash_map();
+
+#ifdef NDEBUG
+    static constexpr size_t two_level_memory_threshold = 33554432; // 32M, L3 Cache
+#else
+    static constexpr size_t two_level_memory_threshold = 64;
+#endif
+
+#ifdef NDEBUG
+    static constexpr size_t streaming_hash_table_size_threshold = 10000000;
+#else
+    static constexpr size_t streaming_hash_table_size_threshold = 4;
+#endif
+
+private:
+    Status _init_agg_functions(ObjectPool* pool);
+
+    // initial const columns for i'th FunctionContext.
+    void _evaluate_const_columns(int i);
+
+    // Choose different agg hash map/set by different group by column's count, type, nullable
+    template <typename HashVariantType>
+    void _init_agg_hash_variant(HashVariantType& hash_variant);
+
+    template <typename HashMapWithKey>
+    void _build_hash_map(HashMapWithKey& hash_map_with_key, size_t chunk_size) {
+        hash_map_with_key.compute_agg_states(
+                chunk_size, _group_by_columns, _mem_pool.get(),
+                [this]() { return _create_agg_state(); },
+                &_tmp_agg_states);
+    }
+
+    template <typename HashMapWithKey>
+    void _build_hash_map(HashMapWithKey& hash_map_with_key, size_t chunk_size, std::vector<uint8_t>* selection) {
+        hash_map_with_key.compute_agg_states(
+                chunk_size, _group_by_columns,
+                [this]() { return _create_agg_state(); },
+                &_tmp_agg_states, selection);
+    }
+
+    template <typename HashMapWithKey>
+    void _release_agg_memory(HashMapWithKey& hash_map_with_key) {
+        _agg_states_block = nullptr;
+        _agg_states_block_remaining = 0;
+        _agg_states_block_capacity = 0;
+        // The trivially destructible states are freed with _mem_pool, without walking the hash map.
+        if (_non_trivial_agg_functions.empty()) {
+            return;
+        }
+        auto it = hash_map_with_key.hash_map.begin();
+        auto end = hash_map_with_key.hash_map.end();
+        while (it != end) {
+            for (size_t i : _non_trivial_agg_functions) {
+                _agg_functions[i]->destroy(it->second + _agg_states_offsets[i]);
+            }
+            ++it;
+        }
+        if constexpr (HashMapWithKey::has_single_null_key) {
+            if (hash_map_with_key.null_key_data != nullptr) {
+                for (size_t i : _non_trivial_agg_functions) {
+                    _agg_functions[i]->destroy(hash_map_with_key.null_key_data + _agg_states_offsets[i]);
+                }
+            }
+        }
+    }
+
+    // Create the states of all the aggregate functions of a new group. The rows of the states are carved out of
+    // blocks allocated from _mem_pool, which grow from kMinAggStatesBlockSize to kMaxAggStatesBlockSize rows, so
+    // the high cardinality aggregations don't pay for one MemPool allocation per group.
+    AggDataPtr _create_agg_state() {
+        if (_agg_states_block_remaining == 0) {
+            _agg_states_block_capacity = _agg_states_block_capacity == 0
+                                                 ? kMinAggStatesBlockSize
+                                                 : std::min(_agg_states_block_capacity * 2, kMaxAggStatesBlockSize);
+            _agg_states_block = _mem_pool->allocate_aligned(_agg_states_block_capacity * _agg_states_row_stride,
+                                                            _max_agg_state_align_size);
+            _agg_states_block_remaining = _agg_states_block_capacity;
+        }
+        AggDataPtr agg_state = _agg_states_block;
+        _agg_states_block += _agg_states_row_stride;
+        _agg_states_block_remaining--;
+        for (int i = 0; i < _agg_functions.size(); i++) {
+            _agg_functions[i]->create(agg_state + _agg_states_offsets[i]);
+        }
+        return agg_state;
+    }
+
+    template <typename HashSetWithKey>
+    void _build_hash_set(HashSetWithKey& hash_set, size_t chunk_size) {
+        hash_set.build_set(chunk_size, _group_by_columns, _mem_pool.get());
+    }
+
+    template <typename HashSetWithKey>
+    void _build_hash_set(HashSetWithKey& hash_set, size_t chunk_size, std::vector<uint8_t>* selection) {
+        hash_set.build_set(chunk_size, _group_by_columns, selection);
+    }
+
+    // Create new aggregate function result column by type
+    Columns _create_agg_result_columns();
+    Columns _create_group_by_columns();
+
+    template <typename HashMapWithKey>
+    void _convert_hash_map_to_chunk(HashMapWithKey& hash_map_with_key, int32_t chunk_size, ChunkPtr* chunk) {
+        SCOPED_TIMER(_get_results_timer);
+        using Iterator = typename HashMapWithKey::Iterator;
+        auto it = std::any_cast<Iterator>(_it_hash);
+        auto end = hash_map_with_key.hash_map.end();
+
+        Columns group_by_columns = _create_group_by_columns();
+        Columns agg_result_column = _create_agg_result_columns();
+
+        int32_t read_index = 0;
+        {
+            SCOPED_TIMER(_iter_timer);
+            hash_map_with_key.results.resize(chunk_size);
+            while ((it != end) & (read_index < chunk_size)) {
+                hash_map_with_key.results[read_index] = it->first;
+                _tmp_agg_states[read_index] = it->second;
+                ++read_index;
+                ++it;
+            }
+        }
+
+        {
+            SCOPED_TIMER(_group_by_append_timer);
+            hash_map_with_key.insert_keys_to_columns(hash_map_with_key.results, group_by_columns, read_index);
+        }
+
+        {
+            SCOPED_TIMER(_agg_append_timer);
+            if (_needs_finalize) {
+                for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+                    _agg_functions[i]->batch_finalize(_agg_fn_ctxs[i], read_index, _tmp_agg_states,
+                                                      _agg_states_offsets[i], agg_result_column[i].get());
+                }
+            } else {
+                for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+                    _agg_functions[i]->batch_serialize(read_index, _tmp_agg_states, _agg_states_offsets[i],
+                                                       agg_result_column[i].get());
+                }
+            }
+        }
+
+        _is_finished = (it == end);
+        _hash_table_eos = _is_finished;
+
+        // If there is null key, output it last
+        if constexpr (HashMapWithKey::has_single_null_key) {
+            if (_is_finished && hash_map_with_key.null_key_data != nullptr) {
+                // The output chunk size couldn't larger than config::vector_chunk_size
+                if (read_index < config::vector_chunk_size) {
+                    // For multi group by key, we don't need to special handle null key
+                    DCHECK(group_by_columns.size() == 1);
+                    DCHECK(group_by_columns[0]->is_nullable());
+                    group_by_columns[0]->append_default();
+                    (this->*_serialize_or_finalize)(hash_map_with_key.null_key_data, agg_result_column);
+                    ++read_index;
+                } else {
+                    // Output null key in next round
+                    _hash_table_eos = false;
+                    _is_finished = false;
+                }
+            }
+        }
+
+        _it_hash = it;
+
+        ChunkPtr _result_chunk = std::make_shared<Chunk>();
+        // For different agg phase, we should use different TupleDescriptor
+        if (_needs_finalize) {
+            for (size_t i = 0; i < group_by_columns.size(); i++) {
+                _result_chunk->append_column(group_by_columns[i], _output_tuple_desc->slots()[i]->id());
+            }
+            for (size_t i = 0; i < agg_result_column.size(); i++) {
+                size_t id = group_by_columns.size() + i;
+                _result_chunk->append_column(agg_result_column[i], _output_tuple_desc->slots()[id]->id());
+            }
+        } else {
+            for (size_t i = 0; i < group_by_columns.size(); i++) {
+                _result_chunk->append_column(group_by_columns[i], _intermediate_tuple_desc->slots()[i]->id());
+            }
+            for (size_t i = 0; i < agg_result_column.size(); i++) {
+                size_t id = group_by_columns.size() + i;
+                _result_chunk->append_column(agg_result_column[i], _intermediate_tuple_desc->slots()[id]->id());
+            }
+        }
+        _num_rows_returned += read_index;
+        *chunk = std::move(_result_chunk);
+    }
+
+    template <typename HashSetWithKey>
+    void _convert_hash_set_to_chunk(HashSetWithKey& hash_set, int32_t chunk_size, ChunkPtr* chunk) {
+        SCOPED_TIMER(_get_results_timer);
+        using Iterator = typename HashSetWithKey::Iterator;
+        auto it = std::any_cast<Iterator>(_it_hash);
+        auto end = hash_set.hash_set.end();
+
+        Columns group_by_columns = _create_group_by_columns();
+
+        // Computer group by columns and aggregate result column
+        int32_t read_index = 0;
+        hash_set.results.resize(chunk_size);
+        while (it != end && read_index < chunk_size) {
+            // hash_set.insert_key_to_columns(*it, group_by_columns);
+            hash_set.results[read_index] = *it;
+            ++read_index;
+            ++it;
+        }
+
+        {
+            SCOPED_TIMER(_group_by_append_timer);
+            hash_set.insert_keys_to_columns(hash_set.results, group_by_columns, read_index);
+        }
+
+        _is_finished = (it == end);
+
+        // IF there is null key, output it last
+        if constexpr (HashSetWithKey::has_single_null_key) {
+            if (_is_finished && hash_set.has_null_key) {
+                // The output chunk size couldn't larger than config::vector_chunk_size
+                if (read_index < config::vector_chunk_size) {
+                    // For multi group by key, we don't need to special handle null key
+                    DCHECK(group_by_columns.size() == 1);
+                    DCHECK(group_by_columns[0]->is_nullable());
+                    group_by_columns[0]->append_default();
+                    ++read_index;
+                } else {
+                    // Output null key in next round
+                    _is_finished = false;
+                }
+            }
+        }
+
+        _it_hash = it;
+
+        ChunkPtr result_chunk = std::make_shared<Chunk>();
+        // For different agg phase, we should use different TupleDescriptor
+        if (_needs_finalize) {
+            for (size_t i = 0; i < group_by_columns.size(); i++) {
+                result_chunk->append_column(group_by_columns[i], _output_tuple_desc->slots()[i]->id());
+            }
+        } else {
+            for (size_t i = 0; i < group_by_columns.size(); i++) {
+                result_chunk->append_column(group_by_columns[i], _intermediate_tuple_desc->slots()[i]->id());
+            }
+        }
+        _num_rows_returned += read_index;
+        *chunk = std::move(result_chunk);
+    }
+
+    // When convert to chunk, we serialize the aggregate state
+    void _serialize_to_chunk(ConstAggDataPtr state, const Columns& agg_result_columns);
+
+    // When convert to chunk, we finalize the aggregate state
+    void _finalize_to_chunk(ConstAggDataPtr state, const Columns& agg_result_columns);
+
+    void (Aggregator::*_serialize_or_finalize)(ConstAggDataPtr state, const Columns& agg_result_columns) = nullptr;
+
+    void (Aggregator::*_compute_agg_states)(size_t chunk_size) = nullptr;
+
+    const TPlanNode _tnode;
+
+    ObjectPool* _pool = nullptr;
+    MemTracker* _mem_tracker = nullptr;
+
+    int64_t _limit = -1;
+    int64_t _num_rows_returned = 0;
+
+    // Certain aggregates require a finalize step, which is the final step of the
+    // aggregate after consuming all input rows. The finalize step converts the aggregate
+    // value into its final form. This is true if this node contains aggregate that requires
+    // a finalize step.
+    bool _needs_finalize;
+
+    bool _is_intermediate_input = false;
+
+    bool _is_finished = false;
+
+    bool _is_only_group_by_columns = false;
+
+    // At least one group by column is nullable
+    bool _has_nullable_key = false;
+
+    int64_t _num_input_rows = 0;
+
+    // memory used for hashmap or hashset
+    int64_t _last_ht_memory_usage = 0;
+
+    // memory used for agg function
+    int64_t _last_agg_func_memory_usage = 0;
+
+    // The function contexts keep counting the memory of the agg states destroyed by reset_hash_map.
+    int64_t _agg_func_memory_usage_base = 0;
+
+    int64_t _num_pass_through_rows = 0;
+    bool _hash_table_eos = false;
+
+    TStreamingPreaggregationMode::type _streaming_preaggregation_mode;
+    // The key is all group by column, the value is all agg function column
+    HashMapVariant _hash_map_variant;
+    HashSetVariant _hash_set_variant;
+    // The Iterator for hash table
+    std::any _it_hash;
+
+    std::unique_ptr<MemPool> _mem_pool;
+
+#ifdef NDEBUG
+    static constexpr size_t memory_check_batch_size = 65535;
+#else
+    static constexpr size_t memory_check_batch_size = 1;
+#endif
+
+    // The offset of the n-th aggregate function in a row of aggregate functions.
+    std::vector<size_t> _agg_states_offsets;
+    // The total size of the row for the aggregate function state.
+    size_t _agg_states_total_size = 0;
+    // The max align size for all aggregate state
+    size_t _max_agg_state_align_size = 1;
+    // The distance of the adjacent rows of the aggregate states in a block, which keeps every row aligned.
+    size_t _agg_states_row_stride = 0;
+    // The indexes of the aggregate functions whose states must be destroyed one by one.
+    std::vector<size_t> _non_trivial_agg_functions;
+
+    static constexpr size_t kMinAggStatesBlockSize = 16;
+    static constexpr size_t kMaxAggStatesBlockSize = 4096;
+    // The rows of the aggregate states not handed out yet, see _create_agg_state().
+    AggDataPtr _agg_states_block = nullptr;
+    size_t _agg_states_block_remaining = 0;
+    size_t _agg_states_block_capacity = 0;
+    // The followings are aggregate function information:
+    std::vector<starrocks_udf::FunctionContext*> _agg_fn_ctxs;
+    std::vector<const AggregateFunction*> _agg_functions;
+    // agg state when no group by columns
+    AggDataPtr _single_agg_state = nullptr;
+    // The expr used to evaluate agg input columns
+    // one agg function could have multi input exprs
+    std::vector<std::vector<ExprContext*>> _agg_expr_ctxs;
+    std::vector<std::vector<ColumnPtr>> _agg_intput_columns;
+    //raw pointers in order to get multi-column values
+    std::vector<std::vector<const Column*>> _agg_input_raw_columns;
+    // Indicates we should use update or merge method to process aggregate column data
+    std::vector<bool> _is_merge_funcs;
+    // In order batch update agg states
+    Buffer<AggDataPtr> _tmp_agg_states;
+    std::vector<AggFunctionTypes> _agg_fn_types;
+
+    // Exprs used to evaluate group by column
+    std::vector<ExprContext*> _group_by_expr_ctxs;
+    Columns _group_by_columns;
+    std::vector<GroupByColumnTypes> _group_by_types;
+
+    RuntimeProfile::Counter* _get_results_timer{};
+    RuntimeProfile::Counter* _iter_timer{};
+    RuntimeProfile::Counter* _agg_append_timer{};
+    RuntimeProfile::Counter* _group_by_append_timer{};
+    RuntimeProfile::Counter* _agg_compute_timer{};
+    RuntimeProfile::Counter* _streaming_timer{};
+    RuntimeProfile::Counter* _input_row_count{};
+    RuntimeProfile::Counter* _hash_table_size{};
+    RuntimeProfile::Counter* _pass_through_row_count{};
+    RuntimeProfile::Counter* _expr_compute_timer{};
+    RuntimeProfile::Counter* _expr_release_timer{};
+
+    // Tuple into which Update()/Merge()/Serialize() results are stored.
+    TupleId _intermediate_tuple_id;
+    TupleDescriptor* _intermediate_tuple_desc = nullptr;
+
+    // Tuple into which Finalize() results are stored. Possibly the same as
+    // the intermediate tuple.
+    TupleId _output_tuple_id;
+    TupleDescriptor* _output_tuple_desc = nullptr;
+
+    AggrPhase _aggr_phase = AggrPhase1;
+    std::vector<uint8_t> _streaming_selection;
+
+    // The statistics of the current window of the streaming pre-aggregation in auto mode.
+    bool _is_streaming_passthrough = false;
+    size_t _streaming_window_chunks = 0;
+    size_t _streaming_window_input_rows = 0;
+    size_t _streaming_window_output_rows = 0;
+    int64_t _streaming_window_probe_ns = 0;
+    // The number of the windows of the next passthrough.
+    size_t _streaming_passthrough_windows = 1;
+    RuntimeProfile::Counter* _streaming_passthrough_window_count{};
+};
+
+} // namespace starrocks::vectorized
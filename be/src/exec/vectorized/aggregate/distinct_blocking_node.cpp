@@ -8,12 +8,12 @@ Status DistinctBlockingNode::open(RuntimeState* state) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::OPEN));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(ExecNode::open(state));
-    RETURN_IF_ERROR(Expr::open(_group_by_expr_ctxs, state));
+    RETURN_IF_ERROR(_aggregator->open(state));
     RETURN_IF_ERROR(_children[0]->open(state));
 
     ChunkPtr chunk;
-    bool limit_with_no_agg = limit() != -1;
-    VLOG_ROW << "_group_by_expr_ctxs size " << _group_by_expr_ctxs.size() << " _needs_finalize " << _needs_finalize;
+    VLOG_ROW << "group_by_expr_ctxs size " << _aggregator->group_by_expr_ctxs().size() << " needs_finalize "
+             << _aggregator->needs_finalize();
 
     while (true) {
         bool eos = false;
@@ -28,46 +28,33 @@ Status DistinctBlockingNode::open(RuntimeState* state) {
         }
         DCHECK_LE(chunk->num_rows(), config::vector_chunk_size);
 
-        _evaluate_exprs(chunk.get());
+        _aggregator->evaluate_exprs(chunk.get());
 
         {
-            SCOPED_TIMER(_agg_compute_timer);
-            if (false) {
-            }
-#define HASH_SET_METHOD(NAME)                                                                        \
-    else if (_hash_set_variant.type == HashSetVariant::Type::NAME)                                   \
-            _build_hash_set<decltype(_hash_set_variant.NAME)::element_type>(*_hash_set_variant.NAME, \
-                                                                            chunk->num_rows());
-            APPLY_FOR_VARIANT_ALL(HASH_SET_METHOD)
-#undef HASH_SET_METHOD
-
-            _num_input_rows += chunk->num_rows();
-            if (limit_with_no_agg) {
-                auto size = _hash_set_variant.size();
-                if (size >= limit()) {
-                    break;
-                }
+            SCOPED_TIMER(_aggregator->agg_compute_timer());
+            _aggregator->build_hash_set(chunk->num_rows());
+
+            _aggregator->update_num_input_rows(chunk->num_rows());
+            if (_hash_set_reached_limit()) {
+                // Close the child at once, so that it stops producing the rows, e.g. the scanners stop.
+                _children[0]->close(state);
+                break;
             }
 
-            RETURN_IF_ERROR(_check_hash_set_memory_usage(state));
+            RETURN_IF_ERROR(_aggregator->check_hash_set_memory_usage(state));
         }
     }
 
-    COUNTER_SET(_hash_table_size, (int64_t)_hash_set_variant.size());
+    COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_set_variant().size());
 
     // If hash set is empty, we don't need to return value
-    if (_hash_set_variant.size() == 0) {
-        _is_finished = true;
+    if (_aggregator->hash_set_variant().size() == 0) {
+        _aggregator->set_finished();
     }
 
-    if (false) {
-    }
-#define HASH_SET_METHOD(NAME) \
-    else if (_hash_set_variant.type == HashSetVariant::Type::NAME) _it_hash = _hash_set_variant.NAME->hash_set.begin();
-    APPLY_FOR_VARIANT_ALL(HASH_SET_METHOD)
-#undef HASH_SET_METHOD
+    _aggregator->init_hash_set_iterator();
 
-    COUNTER_SET(_input_row_count, _num_input_rows);
+    COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
     return Status::OK();
 }
 
@@ -77,28 +64,21 @@ Status DistinctBlockingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool
     RETURN_IF_CANCELLED(state);
     *eos = false;
 
-    if (_is_finished) {
+    if (_aggregator->is_finished()) {
         COUNTER_SET(_rows_returned_counter, _num_rows_returned);
         *eos = true;
         return Status::OK();
     }
     int32_t chunk_size = config::vector_chunk_size;
 
-    if (false) {
-    }
-#define HASH_SET_METHOD(NAME)                                                                                   \
-    else if (_hash_set_variant.type == HashSetVariant::Type::NAME)                                              \
-            _convert_hash_set_to_chunk<decltype(_hash_set_variant.NAME)::element_type>(*_hash_set_variant.NAME, \
-                                                                                       chunk_size, chunk);
-    APPLY_FOR_VARIANT_ALL(HASH_SET_METHOD)
-#undef HASH_SET_METHOD
+    _aggregator->convert_hash_set_to_chunk(chunk_size, chunk);
 
     eval_join_runtime_filters(chunk->get());
 
     // For having
     size_t old_size = (*chunk)->num_rows();
     ExecNode::eval_conjuncts(_conjunct_ctxs, (*chunk).get());
-    _num_rows_returned -= (old_size - (*chunk)->num_rows());
+    _aggregator->update_num_rows_returned(-static_cast<int64_t>(old_size - (*chunk)->num_rows()));
 
     _process_limit(chunk);
 
@@ -106,4 +86,4 @@ Status DistinctBlockingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool
     return Status::OK();
 }
 
-} // namespace starrocks::vectorized
\ No newline at end of file
+} // namespace starrocks::vectorized
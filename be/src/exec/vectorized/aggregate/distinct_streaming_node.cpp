@@ -10,7 +10,7 @@ Status DistinctStreamingNode::open(RuntimeState* state) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::OPEN));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(ExecNode::open(state));
-    RETURN_IF_ERROR(Expr::open(_group_by_expr_ctxs, state));
+    RETURN_IF_ERROR(_aggregator->open(state));
     RETURN_IF_ERROR(_children[0]->open(state));
     return Status::OK();
 }
@@ -21,9 +21,9 @@ Status DistinctStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, boo
     RETURN_IF_CANCELLED(state);
     *eos = false;
 
-    if (_is_finished) {
+    if (_aggregator->is_finished()) {
         COUNTER_SET(_rows_returned_counter, _num_rows_returned);
-        COUNTER_SET(_pass_through_row_count, _num_pass_through_rows);
+        COUNTER_SET(_aggregator->pass_through_row_count(), _aggregator->num_pass_through_rows());
         *eos = true;
         return Status::OK();
     }
@@ -38,89 +38,66 @@ Status DistinctStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, boo
             }
 
             size_t input_chunk_size = input_chunk->num_rows();
-            _num_input_rows += input_chunk_size;
-            COUNTER_SET(_input_row_count, _num_input_rows);
-            RETURN_IF_ERROR(_check_hash_set_memory_usage(state));
-            _evaluate_exprs(input_chunk.get());
+            _aggregator->update_num_input_rows(input_chunk_size);
+            COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
+            RETURN_IF_ERROR(_aggregator->check_hash_set_memory_usage(state));
+            _aggregator->evaluate_exprs(input_chunk.get());
 
-            if (_streaming_preaggregation_mode == TStreamingPreaggregationMode::FORCE_STREAMING) {
+            if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::FORCE_STREAMING) {
                 // force execute streaming
-                SCOPED_TIMER(_streaming_timer);
-                _output_chunk_by_streaming(chunk);
+                SCOPED_TIMER(_aggregator->streaming_timer());
+                _aggregator->output_chunk_by_streaming(chunk);
                 break;
-            } else if (_streaming_preaggregation_mode == TStreamingPreaggregationMode::FORCE_PREAGGREGATION) {
-                SCOPED_TIMER(_agg_compute_timer);
-
-                if (false) {
-                }
-#define HASH_MAP_METHOD(NAME)                                                                        \
-    else if (_hash_set_variant.type == HashSetVariant::Type::NAME)                                   \
-            _build_hash_set<decltype(_hash_set_variant.NAME)::element_type>(*_hash_set_variant.NAME, \
-                                                                            input_chunk_size);
-                APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-                else {
-                    DCHECK(false);
+            } else if (_aggregator->streaming_preaggregation_mode() ==
+                       TStreamingPreaggregationMode::FORCE_PREAGGREGATION) {
+                SCOPED_TIMER(_aggregator->agg_compute_timer());
+                _aggregator->build_hash_set(input_chunk_size);
+                _aggregator->compute_agg_states(input_chunk_size);
+
+                COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_set_variant().size());
+                if (_hash_set_reached_limit()) {
+                    _stop_child(state);
                 }
-
-                (this->*_compute_agg_states)(input_chunk_size);
-                COUNTER_SET(_hash_table_size, (int64_t)_hash_set_variant.size());
                 continue;
             } else {
                 // TODO: calc the real capacity of hashtable, will add one interface in the class of habletable
-                size_t real_capacity = _hash_set_variant.capacity() - _hash_set_variant.capacity() / 8;
-                size_t remain_size = real_capacity - _hash_set_variant.size();
+                size_t real_capacity = _aggregator->hash_set_variant().capacity() -
+                                       _aggregator->hash_set_variant().capacity() / 8;
+                size_t remain_size = real_capacity - _aggregator->hash_set_variant().size();
                 bool ht_needs_expansion = remain_size < input_chunk_size;
                 if (!ht_needs_expansion ||
-                    _should_expand_preagg_hash_tables(input_chunk_size, _mem_pool->total_allocated_bytes(),
-                                                      _hash_set_variant.size())) {
+                    _aggregator->should_expand_preagg_hash_tables(input_chunk_size,
+                                                                  _aggregator->mem_pool()->total_allocated_bytes(),
+                                                                  _aggregator->hash_set_variant().size())) {
                     // hash table is not full or allow expand the hash table according reduction rate
-                    SCOPED_TIMER(_agg_compute_timer);
+                    SCOPED_TIMER(_aggregator->agg_compute_timer());
+                    _aggregator->build_hash_set(input_chunk_size);
+                    _aggregator->compute_agg_states(input_chunk_size);
 
-                    if (false) {
-                    }
-#define HASH_MAP_METHOD(NAME)                                                                        \
-    else if (_hash_set_variant.type == HashSetVariant::Type::NAME)                                   \
-            _build_hash_set<decltype(_hash_set_variant.NAME)::element_type>(*_hash_set_variant.NAME, \
-                                                                            input_chunk_size);
-                    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-                    else {
-                        DCHECK(false);
+                    COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_set_variant().size());
+                    if (_hash_set_reached_limit()) {
+                        _stop_child(state);
                     }
-
-                    (this->*_compute_agg_states)(input_chunk_size);
-                    COUNTER_SET(_hash_table_size, (int64_t)_hash_set_variant.size());
                     continue;
                 } else {
                     {
-                        SCOPED_TIMER(_agg_compute_timer);
-                        if (false) {
-                        }
-#define HASH_MAP_METHOD(NAME)                                                         \
-    else if (_hash_set_variant.type == HashSetVariant::Type::NAME)                    \
-            _build_hash_set<typename decltype(_hash_set_variant.NAME)::element_type>( \
-                    *_hash_set_variant.NAME, input_chunk_size, &_streaming_selection);
-                        APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-                        else {
-                            DCHECK(false);
-                        }
+                        SCOPED_TIMER(_aggregator->agg_compute_timer());
+                        _aggregator->build_hash_set_with_selection(input_chunk_size);
                     }
 
                     {
-                        SCOPED_TIMER(_streaming_timer);
-                        size_t zero_count = SIMD::count_zero(_streaming_selection);
+                        SCOPED_TIMER(_aggregator->streaming_timer());
+                        size_t zero_count = SIMD::count_zero(_aggregator->streaming_selection());
                         if (zero_count == 0) {
-                            _output_chunk_by_streaming(chunk);
-                        } else if (zero_count != _streaming_selection.size()) {
-                            _output_chunk_by_streaming(chunk, _streaming_selection);
+                            _aggregator->output_chunk_by_streaming(chunk);
+                        } else if (zero_count != _aggregator->streaming_selection().size()) {
+                            _aggregator->output_chunk_by_streaming(chunk, _aggregator->streaming_selection());
                         } else {
                             // do nothing
                         }
                     }
 
-                    COUNTER_SET(_hash_table_size, (int64_t)_hash_set_variant.size());
+                    COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_set_variant().size());
                     if ((*chunk)->num_rows() > 0) {
                         break;
                     } else {
@@ -134,16 +111,16 @@ Status DistinctStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, boo
     eval_join_runtime_filters(chunk->get());
 
     if (_child_eos) {
-        if (!_hash_table_eos && _hash_set_variant.size() > 0) {
+        if (!_aggregator->is_ht_eos() && _aggregator->hash_set_variant().size() > 0) {
             _output_chunk_from_hash_set(chunk);
             *eos = false;
             _process_limit(chunk);
 
             DCHECK_CHUNK(*chunk);
             return Status::OK();
-        } else if (_hash_set_variant.size() == 0) {
+        } else if (_aggregator->hash_set_variant().size() == 0) {
             COUNTER_SET(_rows_returned_counter, _num_rows_returned);
-            COUNTER_SET(_pass_through_row_count, _num_pass_through_rows);
+            COUNTER_SET(_aggregator->pass_through_row_count(), _aggregator->num_pass_through_rows());
             *eos = true;
             return Status::OK();
         }
@@ -154,31 +131,20 @@ Status DistinctStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, boo
     return Status::OK();
 }
 
+void DistinctStreamingNode::_stop_child(RuntimeState* state) {
+    // The keys of the hash set are output as if the child has reached its end, and the child is closed at once, so
+    // that it stops producing the rows, e.g. the scanners stop.
+    _child_eos = true;
+    _children[0]->close(state);
+}
+
 void DistinctStreamingNode::_output_chunk_from_hash_set(ChunkPtr* chunk) {
-    if (!_it_hash.has_value()) {
-        if (false) {
-        }
-#define HASH_MAP_METHOD(NAME) \
-    else if (_hash_set_variant.type == HashSetVariant::Type::NAME) _it_hash = _hash_set_variant.NAME->hash_set.begin();
-        APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-        else {
-            DCHECK(false);
-        }
-        COUNTER_SET(_hash_table_size, (int64_t)_hash_set_variant.size());
+    if (!_aggregator->it_hash().has_value()) {
+        _aggregator->init_hash_set_iterator();
+        COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_set_variant().size());
     }
 
-    if (false) {
-    }
-#define HASH_MAP_METHOD(NAME)                                                           \
-    else if (_hash_set_variant.type == HashSetVariant::Type::NAME)                      \
-            _convert_hash_set_to_chunk<decltype(_hash_set_variant.NAME)::element_type>( \
-                    *_hash_set_variant.NAME, config::vector_chunk_size, chunk);
-    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-    else {
-        DCHECK(false);
-    }
+    _aggregator->convert_hash_set_to_chunk(config::vector_chunk_size, chunk);
 }
 
-} // namespace starrocks::vectorized
\ No newline at end of file
+} // namespace starrocks::vectorized
@@ -12,12 +12,14 @@ class DistinctStreamingNode final : public AggregateBaseNode {
 public:
     DistinctStreamingNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
             : AggregateBaseNode(pool, tnode, descs) {
-        _aggr_phase = AggrPhase1;
+        _aggregator->set_aggr_phase(AggrPhase1);
     };
     Status open(RuntimeState* state) override;
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
 
 private:
+    // Stop reading the child once the hash set has reached the limit.
+    void _stop_child(RuntimeState* state);
     void _output_chunk_from_hash_set(ChunkPtr* chunk);
 };
 } // namespace starrocks::vectorized
\ No newline at end of file
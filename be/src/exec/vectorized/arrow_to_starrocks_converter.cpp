@@ -4,6 +4,8 @@
 
 #include <arrow/array.h>
 
+#include <cstring>
+
 #include "column/array_column.h"
 #include "column/nullable_column.h"
 #include "column/type_traits.h"
@@ -114,27 +116,62 @@ IS_ASSIGNABLE(ArrowTypeId::UINT64, TYPE_LARGEINT)
 IS_ASSIGNABLE(ArrowTypeId::HALF_FLOAT, TYPE_FLOAT, TYPE_DOUBLE)
 IS_ASSIGNABLE(ArrowTypeId::FLOAT, TYPE_DOUBLE)
 
+// Unpack |num_bits| bits from the bit |bit_offset| of |bitmap| into the bytes of 0 or 1 in |dst|, the bytes are
+// flipped if |flip| is true. Returns the number of the bytes of 1. The whole bytes of the bitmap are unpacked 8 bits
+// at a time by a few 64-bit operations, instead of testing the bits one by one.
+static size_t unpack_bits(const uint8_t* bitmap, size_t bit_offset, size_t num_bits, uint8_t* dst, bool flip) {
+    static constexpr uint64_t kLowBits = 0x0101010101010101ULL;
+    const uint8_t flip_bit = flip ? 1 : 0;
+    size_t num_set_bits = 0;
+    size_t i = 0;
+    auto unpack_one_bit = [&](size_t idx) {
+        uint8_t bit = (bitmap[(bit_offset + idx) >> 3] >> ((bit_offset + idx) & 7)) & 1;
+        dst[idx] = bit ^ flip_bit;
+        num_set_bits += bit;
+    };
+    for (; i < num_bits && ((bit_offset + i) & 7) != 0; ++i) {
+        unpack_one_bit(i);
+    }
+    const uint8_t* src = bitmap + ((bit_offset + i) >> 3);
+    for (; i + 8 <= num_bits; i += 8, ++src) {
+        // broadcast the byte, keep the bit k in the byte k, then turn each non-zero byte into 1.
+        uint64_t bytes = (*src * kLowBits) & 0x8040201008040201ULL;
+        bytes = (((bytes + 0x7F7F7F7F7F7F7F7FULL) >> 7) & kLowBits) ^ (flip ? kLowBits : 0);
+        memcpy(dst + i, &bytes, sizeof(bytes));
+        num_set_bits += __builtin_popcount(*src);
+    }
+    for (; i < num_bits; ++i) {
+        unpack_one_bit(i);
+    }
+    return flip ? num_bits - num_set_bits : num_set_bits;
+}
+
 size_t fill_null_column(const arrow::Array* array, size_t array_start_idx, size_t num_elements, NullColumn* null_column,
                         size_t column_start_idx) {
     null_column->resize(null_column->size() + num_elements);
     auto* null_data = (&null_column->get_data().front()) + column_start_idx;
-    size_t null_count = 0;
-    for (size_t i = 0; i < num_elements; ++i) {
-        auto is_null = array->IsNull(array_start_idx + i);
-        null_data[i] = is_null;
-        null_count += is_null;
-    }
-    return null_count;
+    const uint8_t* bitmap = array->null_bitmap_data();
+    if (bitmap == nullptr) {
+        // no validity bitmap, all the values are valid, except for the arrays of NullType.
+        bool all_null = array->null_count() != 0;
+        memset(null_data, all_null ? DATUM_NULL : DATUM_NOT_NULL, num_elements);
+        return all_null ? num_elements : 0;
+    }
+    return unpack_bits(bitmap, array->offset() + array_start_idx, num_elements, null_data, true);
 }
 
 void fill_filter(const arrow::Array* array, size_t array_start_idx, size_t num_elements, Column::Filter* filter,
                  size_t column_start_idx) {
     DCHECK_EQ(filter->size(), column_start_idx + num_elements);
     auto* filter_data = (&filter->front()) + column_start_idx;
-    for (size_t i = 0; i < num_elements; ++i) {
-        filter_data[i] = array->IsValid(array_start_idx + i);
+    const uint8_t* bitmap = array->null_bitmap_data();
+    if (bitmap == nullptr) {
+        memset(filter_data, array->null_count() == 0 ? 1 : 0, num_elements);
+        return;
     }
+    unpack_bits(bitmap, array->offset() + array_start_idx, num_elements, filter_data, false);
 }
+
 // A general arrow converter for fixed length type
 //
 // case#1: is_directly_copy(AT, PT>==true
@@ -172,9 +209,15 @@ struct ArrowConverter {
             static_assert(sizeof(CppType) == sizeof(ArrowCppType));
             const ArrowCppType* array_data = concrete_array->raw_values() + array_start_idx;
             strings::memcpy_inlined(data, array_data, num_elements * sizeof(CppType));
+        } else if constexpr (AT == ArrowTypeId::BOOL) {
+            static_assert(sizeof(CppType) == sizeof(uint8_t));
+            unpack_bits(concrete_array->values()->data(), concrete_array->offset() + array_start_idx, num_elements,
+                        reinterpret_cast<uint8_t*>(data), false);
         } else if constexpr (is_assignable<AT, PT>) {
+            // a plain loop on the raw values, which is vectorized by the compiler.
+            const ArrowCppType* array_data = concrete_array->raw_values() + array_start_idx;
             for (size_t i = 0; i < num_elements; ++i) {
-                data[i] = static_cast<CppType>(concrete_array->Value(array_start_idx + i));
+                data[i] = static_cast<CppType>(array_data[i]);
             }
         } else {
             static_assert(is_directly_copyable<AT, PT> || is_assignable<AT, PT>);
@@ -369,23 +412,33 @@ struct ArrowConverter<AT, PT, is_nullable, is_strict, BinaryATGuard<AT>, BinaryP
             bool exceed_max_length = false;
             bool repeated = false;
 
-            for (auto i = array_start_idx; i < array_start_idx + num_elements; ++i) {
-                // Binary length exceeds maximum length of varchar/char.
-                if (concrete_array->value_length(i) > max_length) {
-                    exceed_max_length = true;
-                    if constexpr (is_nullable && !is_strict) {
-                        null_data[i - array_start_idx] = DATUM_NULL;
-                    } else {
-                        filter_data[i - array_start_idx] = 0;
-
-                        if (ctx != nullptr && !repeated) {
-                            repeated = true;
-                            ArrowOffsetType s_size = 0;
-                            const char* s_data = reinterpret_cast<const char*>(concrete_array->GetValue(i, &s_size));
-                            std::string raw_data = std::string(s_data, s_size);
-                            std::string reason =
-                                    strings::Substitute("string length $0 exeeds max length $1", s_size, max_length);
-                            ctx->report_error_message(reason, raw_data);
+            // find the longest value by the offsets without branches first, the values are checked one by one
+            // only if some value is too long.
+            const ArrowOffsetType* value_offsets = concrete_array->raw_value_offsets() + array_start_idx;
+            ArrowOffsetType max_value_length = 0;
+            for (size_t i = 0; i < num_elements; ++i) {
+                max_value_length = std::max(max_value_length, value_offsets[i + 1] - value_offsets[i]);
+            }
+            if (static_cast<size_t>(max_value_length) > max_length) {
+                for (auto i = array_start_idx; i < array_start_idx + num_elements; ++i) {
+                    // Binary length exceeds maximum length of varchar/char.
+                    if (concrete_array->value_length(i) > max_length) {
+                        exceed_max_length = true;
+                        if constexpr (is_nullable && !is_strict) {
+                            null_data[i - array_start_idx] = DATUM_NULL;
+                        } else {
+                            filter_data[i - array_start_idx] = 0;
+
+                            if (ctx != nullptr && !repeated) {
+                                repeated = true;
+                                ArrowOffsetType s_size = 0;
+                                const char* s_data =
+                                        reinterpret_cast<const char*>(concrete_array->GetValue(i, &s_size));
+                                std::string raw_data = std::string(s_data, s_size);
+                                std::string reason = strings::Substitute("string length $0 exeeds max length $1",
+                                                                         s_size, max_length);
+                                ctx->report_error_message(reason, raw_data);
+                            }
                         }
                     }
                 }
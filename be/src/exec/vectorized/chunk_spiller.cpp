@@ -0,0 +1,253 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/chunk_spiller.h"
+
+#include <algorithm>
+
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "gutil/strings/substitute.h"
+#include "util/coding.h"
+#include "util/hash_util.hpp"
+
+namespace starrocks::vectorized {
+
+SpilledChunkFile::~SpilledChunkFile() {
+    if (_rw_file != nullptr) {
+        WARN_IF_ERROR(_rw_file->close(), "failed to close spilled chunk file " + _file->path());
+    }
+    WARN_IF_ERROR(_file->remove(), "failed to remove spilled chunk file " + _file->path());
+}
+
+Status SpilledChunkFile::append(const Chunk& chunk) {
+    Block block;
+    block.size = chunk.serialize_size();
+    _buffer.resize(block.size);
+    chunk.serialize(_buffer.data());
+    Slice data(_buffer.data(), block.size);
+    if (_codec != nullptr && !_codec->exceed_max_input_size(block.size)) {
+        _compressed_buffer.resize(_codec->max_compressed_len(block.size));
+        Slice compressed(_compressed_buffer.data(), _compressed_buffer.size());
+        RETURN_IF_ERROR(_codec->compress(data, &compressed));
+        block.uncompressed_size = block.size;
+        block.size = compressed.size;
+        data = compressed;
+    }
+
+    RETURN_IF_ERROR(_file->allocate_space(block.size, &block.offset));
+    if (_rw_file == nullptr) {
+        // the file is created by the first allocate_space().
+        RandomRWFileOptions opts;
+        opts.mode = Env::MUST_EXIST;
+        RETURN_IF_ERROR(Env::Default()->new_random_rw_file(opts, _file->path(), &_rw_file));
+    }
+    RETURN_IF_ERROR(_rw_file->write_at(block.offset, data));
+
+    const Columns& columns = chunk.columns();
+    block.is_nulls.reserve(columns.size());
+    for (const auto& column : columns) {
+        DCHECK(!column->is_constant());
+        block.is_nulls.push_back(column->is_nullable());
+    }
+    if (_schema == nullptr) {
+        _schema = chunk.clone_empty_with_tuple(0);
+    } else {
+        DCHECK_EQ(_schema->num_columns(), columns.size());
+        for (size_t i = 0; i < columns.size(); ++i) {
+            ColumnPtr& schema_column = _schema->columns()[i];
+            if (columns[i]->is_nullable() && !schema_column->is_nullable()) {
+                schema_column = NullableColumn::create(schema_column, NullColumn::create());
+            }
+        }
+    }
+
+    _blocks.emplace_back(std::move(block));
+    _num_rows += chunk.num_rows();
+    _num_bytes += _blocks.back().size;
+    return Status::OK();
+}
+
+Status SpilledChunkFile::read_next(ChunkPtr* chunk) {
+    if (_next_block >= _blocks.size()) {
+        *chunk = nullptr;
+        return Status::OK();
+    }
+    const Block& block = _blocks[_next_block++];
+    size_t size = block.size;
+    if (block.uncompressed_size == 0) {
+        _buffer.resize(size);
+        RETURN_IF_ERROR(_rw_file->read_at(block.offset, Slice(_buffer.data(), size)));
+    } else {
+        _compressed_buffer.resize(size);
+        RETURN_IF_ERROR(_rw_file->read_at(block.offset, Slice(_compressed_buffer.data(), size)));
+        size = block.uncompressed_size;
+        _buffer.resize(size);
+        Slice uncompressed(_buffer.data(), size);
+        RETURN_IF_ERROR(_codec->decompress(Slice(_compressed_buffer.data(), block.size), &uncompressed));
+        if (UNLIKELY(uncompressed.size != size)) {
+            return Status::InternalError("corrupted spilled chunk file " + _file->path());
+        }
+    }
+
+    // skip the version.
+    const uint8_t* src = _buffer.data() + sizeof(uint32_t);
+    const uint32_t num_rows = decode_fixed32_le(src);
+    src += sizeof(uint32_t);
+
+    const Columns& schema_columns = _schema->columns();
+    Columns columns(schema_columns.size());
+    for (size_t i = 0; i < schema_columns.size(); ++i) {
+        if (block.is_nulls[i] == schema_columns[i]->is_nullable()) {
+            columns[i] = schema_columns[i]->clone_empty();
+        } else {
+            columns[i] = down_cast<const NullableColumn*>(schema_columns[i].get())->data_column()->clone_empty();
+        }
+        src = columns[i]->deserialize_column(src);
+    }
+    *chunk = std::make_shared<Chunk>(std::move(columns), _schema->get_slot_id_to_index_map(),
+                                     _schema->get_tuple_id_to_index_map());
+
+    if (UNLIKELY((*chunk)->num_rows() != num_rows || src != _buffer.data() + size)) {
+        return Status::InternalError("corrupted spilled chunk file " + _file->path());
+    }
+    return Status::OK();
+}
+
+SpillPartitionWriter::SpillPartitionWriter(TmpFileMgr* tmp_file_mgr, const TUniqueId& query_id,
+                                           size_t num_partitions, int level)
+        : _tmp_file_mgr(tmp_file_mgr),
+          _query_id(query_id),
+          _level(level),
+          _seed(static_cast<uint32_t>(level + 1) * 0x9E3779B9U),
+          _buffers(num_partitions),
+          _files(num_partitions) {}
+
+Status SpillPartitionWriter::add_chunk(const ChunkPtr& chunk, const Columns& key_columns,
+                                       const std::vector<uint8_t>& discarded_partitions) {
+    const size_t num_rows = chunk->num_rows();
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    DCHECK_LE(num_rows, UINT16_MAX);
+    ChunkPtr normalized;
+    RETURN_IF_ERROR(_normalize(chunk, &normalized));
+
+    // The hash function differs from the one of the exchange below, by which the rows of the keys have been
+    // shuffled, and from the one of the hash table, otherwise the rows are skewed.
+    _partitions.assign(num_rows, HashUtil::FNV_SEED);
+    for (const auto& key_column : key_columns) {
+        key_column->fvn_hash(_partitions.data(), 0, num_rows);
+    }
+    const size_t num_partitions = _buffers.size();
+    _partition_begins.assign(num_partitions + 1, 0);
+    for (size_t i = 0; i < num_rows; ++i) {
+        _partitions[i] = HashUtil::fmix32(_partitions[i] ^ _seed) % num_partitions;
+        ++_partition_begins[_partitions[i] + 1];
+    }
+    for (size_t i = 0; i < num_partitions; ++i) {
+        _partition_begins[i + 1] += _partition_begins[i];
+    }
+    _partition_cursors.assign(_partition_begins.begin(), _partition_begins.end() - 1);
+    _partition_rows.resize(num_rows);
+    for (uint32_t i = 0; i < num_rows; ++i) {
+        _partition_rows[_partition_cursors[_partitions[i]]++] = i;
+    }
+
+    const size_t chunk_size = config::vector_chunk_size;
+    for (size_t i = 0; i < num_partitions; ++i) {
+        if (!discarded_partitions.empty() && discarded_partitions[i]) {
+            continue;
+        }
+        uint32_t from = _partition_begins[i];
+        while (from < _partition_begins[i + 1]) {
+            if (_buffers[i] == nullptr) {
+                _buffers[i] = _layout->clone_empty_with_tuple(chunk_size);
+            }
+            const uint32_t size = std::min<uint32_t>(_partition_begins[i + 1] - from,
+                                                     chunk_size - _buffers[i]->num_rows());
+            _buffers[i]->append_selective(*normalized, _partition_rows.data(), from, size);
+            from += size;
+            if (_buffers[i]->num_rows() >= chunk_size) {
+                RETURN_IF_ERROR(_flush(i));
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status SpillPartitionWriter::finish() {
+    for (size_t i = 0; i < _buffers.size(); ++i) {
+        if (_buffers[i] != nullptr && _buffers[i]->num_rows() > 0) {
+            RETURN_IF_ERROR(_flush(i));
+        }
+    }
+    return Status::OK();
+}
+
+Status SpillPartitionWriter::_normalize(const ChunkPtr& chunk, ChunkPtr* result) {
+    const size_t num_rows = chunk->num_rows();
+    if (_layout == nullptr) {
+        Columns columns;
+        columns.reserve(chunk->num_columns());
+        for (const auto& column : chunk->columns()) {
+            columns.emplace_back(ColumnHelper::unpack_and_duplicate_const_column(num_rows, column));
+        }
+        *result = std::make_shared<Chunk>(std::move(columns), chunk->get_slot_id_to_index_map(),
+                                          chunk->get_tuple_id_to_index_map());
+        _layout = (*result)->clone_empty_with_tuple(0);
+        return Status::OK();
+    }
+
+    Columns columns(_layout->num_columns());
+    for (const auto& kv : _layout->get_slot_id_to_index_map()) {
+        if (!chunk->is_slot_exist(kv.first)) {
+            return Status::InternalError(strings::Substitute("slot $0 is missing in the spilled chunk", kv.first));
+        }
+        columns[kv.second] = _normalize_column(chunk->get_column_by_slot_id(kv.first), kv.second, num_rows);
+    }
+    for (const auto& kv : _layout->get_tuple_id_to_index_map()) {
+        if (!chunk->is_tuple_exist(kv.first)) {
+            return Status::InternalError(strings::Substitute("tuple $0 is missing in the spilled chunk", kv.first));
+        }
+        columns[kv.second] = _normalize_column(chunk->get_tuple_column_by_id(kv.first), kv.second, num_rows);
+    }
+    *result = std::make_shared<Chunk>(std::move(columns), _layout->get_slot_id_to_index_map(),
+                                      _layout->get_tuple_id_to_index_map());
+    return Status::OK();
+}
+
+ColumnPtr SpillPartitionWriter::_normalize_column(const ColumnPtr& column, size_t index, size_t num_rows) {
+    ColumnPtr result = ColumnHelper::unpack_and_duplicate_const_column(num_rows, column);
+    ColumnPtr& layout_column = _layout->columns()[index];
+    if (result->is_nullable() && !layout_column->is_nullable()) {
+        // upgrade the column of the layout and the buffered chunks to nullable.
+        layout_column = NullableColumn::create(layout_column, NullColumn::create());
+        for (auto& buffer : _buffers) {
+            if (buffer != nullptr) {
+                ColumnPtr& buffer_column = buffer->columns()[index];
+                buffer_column = NullableColumn::create(buffer_column, NullColumn::create(buffer_column->size(), 0));
+            }
+        }
+    } else if (!result->is_nullable() && layout_column->is_nullable()) {
+        result = NullableColumn::create(result, NullColumn::create(num_rows, 0));
+    }
+    return result;
+}
+
+Status SpillPartitionWriter::_flush(size_t partition) {
+    if (_files[partition] == nullptr) {
+        std::vector<TmpFileMgr::DeviceId> devices = _tmp_file_mgr->active_tmp_devices();
+        if (devices.empty()) {
+            return Status::InternalError("no available tmp dir to spill");
+        }
+        TmpFileMgr::File* tmp_file = nullptr;
+        RETURN_IF_ERROR(_tmp_file_mgr->get_file(devices[partition % devices.size()], _query_id, &tmp_file));
+        _files[partition] = std::make_unique<SpilledChunkFile>(tmp_file);
+    }
+    RETURN_IF_ERROR(_files[partition]->append(*_buffers[partition]));
+    _buffers[partition] = nullptr;
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,102 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "column/chunk.h"
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "env/env.h"
+#include "runtime/tmp_file_mgr.h"
+#include "util/block_compression.h"
+
+namespace starrocks::vectorized {
+
+// A temporary file of chunks, the chunks are read back in the order they are appended.
+// The columns of the appended chunks must be in the same order, but their nullability could differ,
+// the chunks read back have the nullability as they were appended.
+// The serialized chunks are compressed by |codec| unless it's nullptr.
+class SpilledChunkFile {
+public:
+    // Take the ownership of |file|.
+    explicit SpilledChunkFile(TmpFileMgr::File* file, const BlockCompressionCodec* codec = nullptr)
+            : _file(file), _codec(codec) {}
+    ~SpilledChunkFile();
+
+    // |chunk| must not have const columns.
+    Status append(const Chunk& chunk);
+
+    // Read the next chunk into |chunk|, which is set to nullptr after all the chunks are read.
+    Status read_next(ChunkPtr* chunk);
+
+    size_t num_rows() const { return _num_rows; }
+    int64_t num_bytes() const { return _num_bytes; }
+
+private:
+    struct Block {
+        int64_t offset = 0;
+        int64_t size = 0;
+        // The size of the serialized chunk if the block is compressed, otherwise 0.
+        int64_t uncompressed_size = 0;
+        std::vector<uint8_t> is_nulls;
+    };
+
+    std::unique_ptr<TmpFileMgr::File> _file;
+    const BlockCompressionCodec* const _codec;
+    std::unique_ptr<RandomRWFile> _rw_file;
+    // An empty chunk whose columns are nullable if they are nullable in any appended chunk,
+    // which creates the columns of the chunks read back.
+    ChunkPtr _schema;
+    std::vector<Block> _blocks;
+    size_t _next_block = 0;
+    std::vector<uint8_t> _buffer;
+    std::vector<uint8_t> _compressed_buffer;
+    size_t _num_rows = 0;
+    int64_t _num_bytes = 0;
+};
+
+// SpillPartitionWriter partitions the rows of the chunks by the hash values of their keys into the temporary
+// files, one file per partition. The rows of each partition are buffered into chunks of
+// config::vector_chunk_size rows before they are appended to the file, which is created lazily.
+// The partitions of |level| are partitioned again with the hash function of level + 1.
+class SpillPartitionWriter {
+public:
+    SpillPartitionWriter(TmpFileMgr* tmp_file_mgr, const TUniqueId& query_id, size_t num_partitions, int level);
+
+    // |key_columns| are the keys of |chunk| without const columns. The chunks could have more columns than
+    // the first added chunk, which are discarded. The rows of the partitions marked in |discarded_partitions|
+    // are dropped, it's empty if none.
+    Status add_chunk(const ChunkPtr& chunk, const Columns& key_columns,
+                     const std::vector<uint8_t>& discarded_partitions = {});
+    // Flush the buffered rows, the files are complete after this.
+    Status finish();
+
+    int level() const { return _level; }
+    size_t num_partitions() const { return _buffers.size(); }
+    // The file of a partition is nullptr if it has no rows.
+    std::vector<std::unique_ptr<SpilledChunkFile>>& files() { return _files; }
+
+private:
+    // Make the columns of |chunk| the same as the layout, i.e. the first added chunk.
+    Status _normalize(const ChunkPtr& chunk, ChunkPtr* result);
+    ColumnPtr _normalize_column(const ColumnPtr& column, size_t index, size_t num_rows);
+    Status _flush(size_t partition);
+
+    TmpFileMgr* const _tmp_file_mgr;
+    const TUniqueId _query_id;
+    const int _level;
+    const uint32_t _seed;
+    ChunkPtr _layout;
+    std::vector<ChunkPtr> _buffers;
+    std::vector<std::unique_ptr<SpilledChunkFile>> _files;
+
+    std::vector<uint32_t> _partitions;
+    // The indexes of the rows of partition i are in [_partition_begins[i], _partition_begins[i + 1]).
+    std::vector<uint32_t> _partition_begins;
+    std::vector<uint32_t> _partition_cursors;
+    std::vector<uint32_t> _partition_rows;
+};
+
+} // namespace starrocks::vectorized
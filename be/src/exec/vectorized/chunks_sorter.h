@@ -4,8 +4,14 @@
 
 #include "column/vectorized_fwd.h"
 #include "exprs/expr_context.h"
+#include "runtime/types.h"
 #include "util/runtime_profile.h"
 
+namespace starrocks {
+class SortExecExprs;
+class TupleDescriptor;
+} // namespace starrocks
+
 namespace starrocks::vectorized {
 struct PermutationItem {
     uint32_t chunk_index;
@@ -259,6 +265,11 @@ struct DataSegment {
 };
 using DataSegments = std::vector<DataSegment>;
 
+struct OrderByType {
+    TypeDescriptor type_desc;
+    bool is_nullable;
+};
+
 // Sort Chunks in memory with specified order by rules.
 class ChunksSorter {
 public:
@@ -280,7 +291,13 @@ public:
     // Finish seeding Chunk, and get sorted data with top OFFSET rows have been skipped.
     virtual Status done(RuntimeState* state) = 0;
     // get_next only works after done().
-    virtual void get_next(ChunkPtr* chunk, bool* eos) = 0;
+    virtual Status get_next(ChunkPtr* chunk, bool* eos) = 0;
+
+    // Evaluate the sort tuple slot exprs on the input chunk, the result chunk contains only the
+    // materialized sorting columns, and which are non-constant.
+    static ChunkPtr materialize_chunk_before_sort(Chunk* chunk, TupleDescriptor* materialized_tuple_desc,
+                                                  const SortExecExprs& sort_exec_exprs,
+                                                  const std::vector<OrderByType>& order_by_types);
 
 protected:
     inline size_t _get_number_of_order_by_columns() const { return _sort_exprs->size(); }
@@ -2,11 +2,14 @@
 
 #include "chunks_sorter_full_sort.h"
 
+#include "column/binary_view.h"
+#include "column/nullable_column.h"
 #include "column/type_traits.h"
 #include "exprs/expr.h"
 #include "gutil/casts.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/runtime_state.h"
+#include "util/block_compression.h"
 #include "util/orlp/pdqsort.h"
 #include "util/stopwatch.hpp"
 
@@ -140,11 +143,11 @@ private:
         const size_t row_num = (count == 0 || offset + count > perm.size()) ? (perm.size() - offset) : count;
         auto* binary_column = reinterpret_cast<BinaryColumn*>(column);
         auto& data = binary_column->get_data();
-        std::vector<SortItem<Slice>> sort_items(row_num);
+        std::vector<SortItem<BinaryView>> sort_items(row_num);
         for (uint32_t i = 0; i < row_num; ++i) {
-            sort_items[i] = {data[perm[i + offset].index_in_chunk], perm[i + offset].index_in_chunk, i};
+            sort_items[i] = {BinaryView(data[perm[i + offset].index_in_chunk]), perm[i + offset].index_in_chunk, i};
         }
-        auto less_fn = [](const SortItem<Slice>& l, const SortItem<Slice>& r) -> bool {
+        auto less_fn = [](const SortItem<BinaryView>& l, const SortItem<BinaryView>& r) -> bool {
             if constexpr (stable) {
                 int res = l.value.compare(r.value);
                 if (res == 0) {
@@ -157,7 +160,7 @@ private:
                 return res < 0;
             }
         };
-        auto greater_fn = [](const SortItem<Slice>& l, const SortItem<Slice>& r) -> bool {
+        auto greater_fn = [](const SortItem<BinaryView>& l, const SortItem<BinaryView>& r) -> bool {
             if constexpr (stable) {
                 int res = l.value.compare(r.value);
                 if (res == 0) {
@@ -228,13 +231,138 @@ private:
     }
 };
 
+// The normalized key of a row is a byte string which compares by memcmp in the same order as the row compares
+// by the order by columns, so the rows are sorted without calling the virtual Column::compare_at for every column.
+// Like PrimaryKeyEncoder, an integral value is encoded as its big-endian bytes with the sign bit flipped, a value
+// of a nullable column is led by a byte ordering the NULLs, and the bytes of a descending column are inverted.
+// Only the first kNormalizedStringPrefixBytes bytes of a string are encoded, padded with zeros, so a key ends with
+// the first string column, and the rows tied on their keys are compared from that column on.
+static constexpr size_t kNormalizedStringPrefixBytes = 16;
+
+// The width of the normalized value of |type|, 0 if it can't be normalized.
+static size_t normalized_value_width(PrimitiveType type) {
+    switch (type) {
+    case TYPE_BOOLEAN:
+    case TYPE_TINYINT:
+        return 1;
+    case TYPE_SMALLINT:
+        return 2;
+    case TYPE_INT:
+    case TYPE_DECIMAL32:
+    case TYPE_DATE:
+        return 4;
+    case TYPE_BIGINT:
+    case TYPE_DECIMAL64:
+    case TYPE_DATETIME:
+        return 8;
+    case TYPE_LARGEINT:
+    case TYPE_DECIMAL128:
+        return 16;
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        return kNormalizedStringPrefixBytes;
+    default:
+        return 0;
+    }
+}
+
+template <typename T>
+static void encode_normalized_integral(T value, uint8_t* dst) {
+    using UT = typename std::make_unsigned<T>::type;
+    UT uv = value;
+    if constexpr (std::is_signed<T>::value) {
+        uv ^= static_cast<UT>(1) << (sizeof(UT) * 8 - 1);
+    }
+    for (size_t i = 0; i < sizeof(UT); i++) {
+        dst[i] = static_cast<uint8_t>(uv >> ((sizeof(UT) - 1 - i) * 8));
+    }
+}
+
+// Encode the non-null values of |data_column| at |offset| of the keys.
+template <typename T, typename ToIntegral>
+static void encode_normalized_fixed_values(const Column* data_column, const NullData* nulls, ToIntegral to_integral,
+                                           uint8_t* keys, size_t key_width, size_t num_rows) {
+    const T* data = reinterpret_cast<const T*>(data_column->raw_data());
+    for (size_t i = 0; i < num_rows; i++) {
+        if (nulls == nullptr || !(*nulls)[i]) {
+            encode_normalized_integral(to_integral(data[i]), keys + i * key_width);
+        }
+    }
+}
+
+static void encode_normalized_values(PrimitiveType type, const Column* data_column, const NullData* nulls,
+                                     uint8_t* keys, size_t key_width, size_t num_rows) {
+    auto identity = [](auto v) { return v; };
+    switch (type) {
+    case TYPE_BOOLEAN:
+        encode_normalized_fixed_values<uint8_t>(data_column, nulls, identity, keys, key_width, num_rows);
+        break;
+    case TYPE_TINYINT:
+        encode_normalized_fixed_values<int8_t>(data_column, nulls, identity, keys, key_width, num_rows);
+        break;
+    case TYPE_SMALLINT:
+        encode_normalized_fixed_values<int16_t>(data_column, nulls, identity, keys, key_width, num_rows);
+        break;
+    case TYPE_INT:
+    case TYPE_DECIMAL32:
+        encode_normalized_fixed_values<int32_t>(data_column, nulls, identity, keys, key_width, num_rows);
+        break;
+    case TYPE_BIGINT:
+    case TYPE_DECIMAL64:
+        encode_normalized_fixed_values<int64_t>(data_column, nulls, identity, keys, key_width, num_rows);
+        break;
+    case TYPE_LARGEINT:
+    case TYPE_DECIMAL128:
+        encode_normalized_fixed_values<int128_t>(data_column, nulls, identity, keys, key_width, num_rows);
+        break;
+    case TYPE_DATE:
+        encode_normalized_fixed_values<DateValue>(
+                data_column, nulls, [](const DateValue& v) { return v.julian(); }, keys, key_width, num_rows);
+        break;
+    case TYPE_DATETIME:
+        encode_normalized_fixed_values<TimestampValue>(
+                data_column, nulls, [](const TimestampValue& v) { return v.timestamp(); }, keys, key_width,
+                num_rows);
+        break;
+    case TYPE_CHAR:
+    case TYPE_VARCHAR: {
+        const auto& data = down_cast<const BinaryColumn*>(data_column)->get_data();
+        for (size_t i = 0; i < num_rows; i++) {
+            if (nulls == nullptr || !(*nulls)[i]) {
+                memcpy(keys + i * key_width, data[i].data, std::min(data[i].size, kNormalizedStringPrefixBytes));
+            }
+        }
+        break;
+    }
+    default:
+        DCHECK(false) << "unsupported normalized type " << type;
+    }
+}
+
 ChunksSorterFullSort::ChunksSorterFullSort(const std::vector<ExprContext*>* sort_exprs, const std::vector<bool>* is_asc,
                                            const std::vector<bool>* is_null_first, size_t size_of_chunk_batch)
-        : ChunksSorter(sort_exprs, is_asc, is_null_first, size_of_chunk_batch) {
+        : ChunksSorter(sort_exprs, is_asc, is_null_first, size_of_chunk_batch),
+          _is_asc(is_asc),
+          _is_null_first(is_null_first) {
     _selective_values.resize(config::vector_chunk_size);
 }
 
-ChunksSorterFullSort::~ChunksSorterFullSort() = default;
+ChunksSorterFullSort::~ChunksSorterFullSort() {
+    if (_spill_manager != nullptr) {
+        _spill_manager->unregister_spillable(this);
+    }
+}
+
+void ChunksSorterFullSort::set_spill(SpillManager* spill_manager, const TUniqueId& query_id, int mem_limit_percent,
+                                     RuntimeProfile* profile) {
+    _spill_manager = spill_manager;
+    _spill_manager->register_spillable(this);
+    _query_id = query_id;
+    _spill_mem_limit_percent = mem_limit_percent;
+    _spill_timer = ADD_TIMER(profile, "SpillTime");
+    _spill_bytes_counter = ADD_COUNTER(profile, "SpillBytes", TUnit::BYTES);
+    _spill_runs_counter = ADD_COUNTER(profile, "SpillRuns", TUnit::UNIT);
+}
 
 Status ChunksSorterFullSort::update(RuntimeState* state, const ChunkPtr& chunk) {
     // Calculate the memory of BigChunk, but every time the mem_usage() of BigChunk is called,
@@ -242,7 +370,8 @@ Status ChunksSorterFullSort::update(RuntimeState* state, const ChunkPtr& chunk)
     // So accumulate the memory of each small Chunk to estimate the total memory.
     // But in some scenarios, Chunk will reserve 4096 rows, but only used 1.
     // So use the shrink_memory_usage() to estimate memory usage
-    RETURN_IF_ERROR(_consume_and_check_memory_limit(state, chunk->shrink_memory_usage()));
+    const int64_t chunk_bytes = chunk->shrink_memory_usage();
+    RETURN_IF_ERROR(_consume_and_check_memory_limit(state, chunk_bytes));
 
     if (UNLIKELY(_big_chunk == nullptr)) {
         _big_chunk = chunk->clone_empty();
@@ -253,9 +382,24 @@ Status ChunksSorterFullSort::update(RuntimeState* state, const ChunkPtr& chunk)
         return Status::InternalError("Full sort in single query instance only support at most 4294967295 rows");
     }
 
+    // The columns of the big chunk can't hold more than 4GB of strings, sort the rows buffered so far as a run,
+    // and merge the runs in the end.
+    if (_big_chunk->num_rows() > 0 && _big_chunk->capacity_limit_reached_on_append(*chunk)) {
+        if (_spill_manager != nullptr) {
+            RETURN_IF_ERROR(_spill_sorted_run(state));
+        } else {
+            RETURN_IF_ERROR(_keep_sorted_run_in_memory(state));
+        }
+        _big_chunk = chunk->clone_empty();
+    }
+
     _big_chunk->append(*chunk);
+    _buffered_bytes += chunk_bytes;
 
     DCHECK(!_big_chunk->has_const_column());
+    if (_spill_manager != nullptr && _spill_manager->should_spill(this, _spill_mem_limit_percent)) {
+        RETURN_IF_ERROR(_spill_sorted_run(state));
+    }
     return Status::OK();
 }
 
@@ -263,13 +407,25 @@ Status ChunksSorterFullSort::done(RuntimeState* state) {
     if (_big_chunk != nullptr && _big_chunk->num_rows() > 0) {
         RETURN_IF_ERROR(_sort_chunks(state));
     }
+    if (!_spilled_runs.empty() || !_memory_runs.empty()) {
+        RETURN_IF_ERROR(_init_spilled_runs_merger());
+    }
 
     DCHECK_EQ(_next_output_row, 0);
     return Status::OK();
 }
 
-void ChunksSorterFullSort::get_next(ChunkPtr* chunk, bool* eos) {
+Status ChunksSorterFullSort::get_next(ChunkPtr* chunk, bool* eos) {
     SCOPED_TIMER(_output_timer);
+    if (_spilled_runs_merger != nullptr) {
+        RETURN_IF_ERROR(_spilled_runs_merger->get_next(chunk, eos));
+        return _spill_status;
+    }
+    _get_next_sorted(chunk, eos);
+    return Status::OK();
+}
+
+void ChunksSorterFullSort::_get_next_sorted(ChunkPtr* chunk, bool* eos) {
     if (_next_output_row >= _sorted_permutation.size()) {
         *chunk = nullptr;
         *eos = true;
@@ -282,13 +438,123 @@ void ChunksSorterFullSort::get_next(ChunkPtr* chunk, bool* eos) {
     _next_output_row += count;
 }
 
+// Sort the buffered rows and write them into a new temporary file, the file is compressed as the runs are
+// mostly read back once, and the memory of the rows is released.
+Status ChunksSorterFullSort::_spill_sorted_run(RuntimeState* state) {
+    RETURN_IF_ERROR(_sort_chunks(state));
+
+    SCOPED_TIMER(_spill_timer);
+    TmpFileMgr* tmp_file_mgr = _spill_manager->tmp_file_mgr();
+    std::vector<TmpFileMgr::DeviceId> devices = tmp_file_mgr->active_tmp_devices();
+    if (devices.empty()) {
+        return Status::InternalError("no available tmp dir to spill");
+    }
+    const BlockCompressionCodec* codec = nullptr;
+    RETURN_IF_ERROR(get_block_compression_codec(CompressionTypePB::LZ4, &codec));
+    TmpFileMgr::File* tmp_file = nullptr;
+    RETURN_IF_ERROR(tmp_file_mgr->get_file(devices[_spilled_runs.size() % devices.size()], _query_id, &tmp_file));
+    auto run = std::make_unique<SpilledChunkFile>(tmp_file, codec);
+
+    const size_t num_rows = _sorted_permutation.size();
+    for (size_t offset = 0; offset < num_rows; offset += config::vector_chunk_size) {
+        size_t count = std::min(size_t(config::vector_chunk_size), num_rows - offset);
+        ChunkPtr chunk = _sorted_segment->chunk->clone_empty(count);
+        _append_rows_to_chunk(chunk.get(), _sorted_segment->chunk.get(), _sorted_permutation, offset, count);
+        RETURN_IF_ERROR(run->append(*chunk));
+    }
+    COUNTER_UPDATE(_spill_bytes_counter, run->num_bytes());
+    COUNTER_UPDATE(_spill_runs_counter, 1);
+    _spilled_runs.emplace_back(std::move(run));
+
+    _sorted_segment.reset();
+    Permutation().swap(_sorted_permutation);
+    _buffered_bytes = 0;
+    if (_mem_tracker != nullptr) {
+        _mem_tracker->release(_last_memory_usage);
+        _last_memory_usage = 0;
+    }
+    return Status::OK();
+}
+
+Status ChunksSorterFullSort::_keep_sorted_run_in_memory(RuntimeState* state) {
+    RETURN_IF_ERROR(_sort_chunks(state));
+
+    std::vector<ChunkPtr> run;
+    const size_t num_rows = _sorted_permutation.size();
+    for (size_t offset = 0; offset < num_rows; offset += config::vector_chunk_size) {
+        size_t count = std::min(size_t(config::vector_chunk_size), num_rows - offset);
+        ChunkPtr chunk = _sorted_segment->chunk->clone_empty(count);
+        _append_rows_to_chunk(chunk.get(), _sorted_segment->chunk.get(), _sorted_permutation, offset, count);
+        run.emplace_back(std::move(chunk));
+    }
+    _memory_runs.emplace_back(std::move(run));
+    _memory_run_positions.emplace_back(0);
+
+    _sorted_segment.reset();
+    Permutation().swap(_sorted_permutation);
+    return Status::OK();
+}
+
+Status ChunksSorterFullSort::_init_spilled_runs_merger() {
+    ChunkSuppliers suppliers;
+    for (size_t i = 0; i < _memory_runs.size(); ++i) {
+        suppliers.emplace_back([this, i](Chunk** chunk) -> Status {
+            size_t& position = _memory_run_positions[i];
+            *chunk = nullptr;
+            if (position < _memory_runs[i].size()) {
+                // the merger takes the ownership of the chunk.
+                *chunk = new Chunk(std::move(*_memory_runs[i][position]));
+                _memory_runs[i][position++].reset();
+            }
+            return Status::OK();
+        });
+    }
+    for (auto& run : _spilled_runs) {
+        SpilledChunkFile* file = run.get();
+        suppliers.emplace_back([this, file](Chunk** chunk) -> Status {
+            *chunk = nullptr;
+            ChunkPtr next;
+            Status status = file->read_next(&next);
+            if (!status.ok()) {
+                if (_spill_status.ok()) {
+                    _spill_status = status;
+                }
+                return status;
+            }
+            // the merger takes the ownership of the chunk.
+            if (next != nullptr) {
+                *chunk = new Chunk(std::move(*next));
+            }
+            return Status::OK();
+        });
+    }
+    if (_sorted_segment != nullptr) {
+        suppliers.emplace_back([this](Chunk** chunk) -> Status {
+            ChunkPtr next;
+            bool eos = false;
+            _get_next_sorted(&next, &eos);
+            *chunk = eos ? nullptr : new Chunk(std::move(*next));
+            return Status::OK();
+        });
+    }
+    _spilled_runs_merger = std::make_unique<SortedChunksMerger>();
+    return _spilled_runs_merger->init(suppliers, _sort_exprs, _is_asc, _is_null_first);
+}
+
 Status ChunksSorterFullSort::_sort_chunks(RuntimeState* state) {
     // Step1: construct permutation
     RETURN_IF_ERROR(_build_sorting_data(state));
 
-    // Step2: sort by columns or row
+    // Step2: sort by normalized keys, columns or row
     // For no more than three order-by columns, sorting by columns can benefit from reducing
     // the cost of calling virtual functions of Column::compare_at.
+    if (_get_number_of_order_by_columns() > 1) {
+        bool sorted = false;
+        RETURN_IF_ERROR(_sort_by_normalized_keys(state, &sorted));
+        if (sorted) {
+            return Status::OK();
+        }
+    }
     if (_get_number_of_order_by_columns() <= 3) {
         _sort_by_columns();
     } else {
@@ -314,6 +580,125 @@ Status ChunksSorterFullSort::_build_sorting_data(RuntimeState* state) {
     return Status::OK();
 }
 
+// Sort by the normalized keys of the rows, |*sorted| is false if no leading order-by column can be
+// normalized.
+Status ChunksSorterFullSort::_sort_by_normalized_keys(RuntimeState* state, bool* sorted) {
+    const Columns& columns = _sorted_segment->order_by_columns;
+    const size_t num_columns = _get_number_of_order_by_columns();
+
+    // The rows tied on their keys are compared from the column |tie_begin| on.
+    size_t tie_begin = num_columns;
+    size_t key_width = 0;
+    std::vector<size_t> offsets(num_columns, 0);
+    for (size_t i = 0; i < num_columns; i++) {
+        offsets[i] = key_width;
+        if (columns[i]->is_constant()) {
+            continue;
+        }
+        PrimitiveType type = (*_sort_exprs)[i]->root()->type().type;
+        size_t width = normalized_value_width(type);
+        if (width == 0) {
+            tie_begin = i;
+            break;
+        }
+        key_width += columns[i]->is_nullable() + width;
+        if (type == TYPE_CHAR || type == TYPE_VARCHAR) {
+            tie_begin = i;
+            break;
+        }
+    }
+    *sorted = key_width > 0;
+    if (!*sorted) {
+        return Status::OK();
+    }
+
+    SCOPED_TIMER(_sort_timer);
+    const size_t num_rows = _sorted_permutation.size();
+    RETURN_IF_ERROR(_consume_and_check_memory_limit(state, num_rows * (key_width + sizeof(uint64_t) * 2)));
+    std::vector<uint8_t> keys(num_rows * key_width, 0);
+    const size_t num_key_columns = tie_begin < num_columns ? tie_begin + 1 : num_columns;
+    for (size_t i = 0; i < num_key_columns; i++) {
+        if (columns[i]->is_constant()) {
+            continue;
+        }
+        const Column* data_column = columns[i].get();
+        const NullData* nulls = nullptr;
+        uint8_t* base = keys.data() + offsets[i];
+        if (data_column->is_nullable()) {
+            const auto* nullable_column = down_cast<const NullableColumn*>(data_column);
+            nulls = &nullable_column->immutable_null_column_data();
+            data_column = nullable_column->data_column().get();
+            // NULL is greater than the others if the flag is 1, see NullableColumn::compare_at.
+            const uint8_t null_byte = _null_first_flag[i] == 1 ? 1 : 0;
+            for (size_t row = 0; row < num_rows; row++) {
+                base[row * key_width] = (*nulls)[row] ? null_byte : 1 - null_byte;
+            }
+            base++;
+        }
+        PrimitiveType type = (*_sort_exprs)[i]->root()->type().type;
+        encode_normalized_values(type, data_column, nulls, base, key_width, num_rows);
+        if (_sort_order_flag[i] == -1) {
+            const size_t width = columns[i]->is_nullable() + normalized_value_width(type);
+            uint8_t* begin = keys.data() + offsets[i];
+            for (size_t row = 0; row < num_rows; row++) {
+                uint8_t* value = begin + row * key_width;
+                for (size_t k = 0; k < width; k++) {
+                    value[k] = ~value[k];
+                }
+            }
+        }
+    }
+
+    // The first 8 bytes of the keys are kept with the indices as big-endian integers for the seek of a better
+    // cache, the rest bytes are compared by memcmp only when the heads are equal.
+    struct SortItem {
+        uint64_t head;
+        uint32_t index;
+    };
+    const size_t head_width = std::min(key_width, sizeof(uint64_t));
+    std::vector<SortItem> items(num_rows);
+    for (uint32_t row = 0; row < num_rows; row++) {
+        const uint8_t* key = keys.data() + row * key_width;
+        uint64_t head = 0;
+        for (size_t k = 0; k < head_width; k++) {
+            head = (head << 8) | key[k];
+        }
+        items[row] = {head, row};
+    }
+
+    const uint8_t* key_data = keys.data();
+    const std::vector<int>& sort_order_flag = _sort_order_flag;
+    const std::vector<int>& null_first_flag = _null_first_flag;
+    auto cmp_fn = [&](const SortItem& l, const SortItem& r) {
+        if (l.head != r.head) {
+            return l.head < r.head;
+        }
+        if (key_width > head_width) {
+            int c = memcmp(key_data + l.index * key_width + head_width, key_data + r.index * key_width + head_width,
+                           key_width - head_width);
+            if (c != 0) {
+                return c < 0;
+            }
+        }
+        for (size_t i = tie_begin; i < num_columns; i++) {
+            if (columns[i]->is_constant()) {
+                continue;
+            }
+            int c = columns[i]->compare_at(l.index, r.index, *columns[i], null_first_flag[i]);
+            if (c != 0) {
+                return c * sort_order_flag[i] < 0;
+            }
+        }
+        return l.index < r.index;
+    };
+    pdqsort(items.begin(), items.end(), cmp_fn);
+
+    for (size_t i = 0; i < num_rows; ++i) {
+        _sorted_permutation[i].index_in_chunk = _sorted_permutation[i].permutation_index = items[i].index;
+    }
+    return Status::OK();
+}
+
 // Sort in row style with simplified Permutation struct for the seek of a better cache.
 void ChunksSorterFullSort::_sort_by_row_cmp() {
     SCOPED_TIMER(_sort_timer);
@@ -3,12 +3,15 @@
 #pragma once
 
 #include "column/vectorized_fwd.h"
+#include "exec/vectorized/chunk_spiller.h"
 #include "exec/vectorized/chunks_sorter.h"
+#include "exec/vectorized/spill_manager.h"
 #include "exprs/expr_context.h"
+#include "runtime/vectorized/sorted_chunks_merger.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks::vectorized {
-class ChunksSorterFullSort : public ChunksSorter {
+class ChunksSorterFullSort : public ChunksSorter, public Spillable {
 public:
     /**
      * Constructor.
@@ -21,10 +24,17 @@ public:
                          const std::vector<bool>* is_null_first, size_t size_of_chunk_batch);
     ~ChunksSorterFullSort() override;
 
+    // Sort the buffered rows and spill them into a temporary file as a sorted run once |spill_manager| decides so
+    // with the budget of |mem_limit_percent| percent of the limit, the runs are merged in order by get_next().
+    void set_spill(SpillManager* spill_manager, const TUniqueId& query_id, int mem_limit_percent,
+                   RuntimeProfile* profile);
+
+    int64_t spillable_bytes() const override { return _buffered_bytes; }
+
     // Append a Chunk for sort.
     Status update(RuntimeState* state, const ChunkPtr& chunk) override;
     Status done(RuntimeState* state) override;
-    void get_next(ChunkPtr* chunk, bool* eos) override;
+    Status get_next(ChunkPtr* chunk, bool* eos) override;
 
     friend class SortHelper;
 
@@ -32,15 +42,44 @@ private:
     Status _sort_chunks(RuntimeState* state);
     Status _build_sorting_data(RuntimeState* state);
 
+    Status _sort_by_normalized_keys(RuntimeState* state, bool* sorted);
     void _sort_by_row_cmp();
     void _sort_by_columns();
 
     void _append_rows_to_chunk(Chunk* dest, Chunk* src, const Permutation& permutation, size_t offset, size_t count);
 
+    // Output the sorted rows in memory.
+    void _get_next_sorted(ChunkPtr* chunk, bool* eos);
+
+    Status _spill_sorted_run(RuntimeState* state);
+    // Merge the spilled runs and the sorted rows in memory.
+    Status _keep_sorted_run_in_memory(RuntimeState* state);
+    Status _init_spilled_runs_merger();
+
+    const std::vector<bool>* _is_asc;
+    const std::vector<bool>* _is_null_first;
+
     ChunkUniquePtr _big_chunk;
     std::unique_ptr<DataSegment> _sorted_segment;
     Permutation _sorted_permutation;
     std::vector<uint32_t> _selective_values; // for appending selective values to sorted rows
+
+    // Decides when the buffered rows are spilled, nullptr if they are never spilled.
+    SpillManager* _spill_manager = nullptr;
+    TUniqueId _query_id;
+    int _spill_mem_limit_percent = 0;
+    int64_t _buffered_bytes = 0;
+    std::vector<std::unique_ptr<SpilledChunkFile>> _spilled_runs;
+    // The sorted runs kept in memory, since the big chunk can't hold more than 4GB of strings in a column.
+    std::vector<std::vector<ChunkPtr>> _memory_runs;
+    std::vector<size_t> _memory_run_positions;
+    std::unique_ptr<SortedChunksMerger> _spilled_runs_merger;
+    // The first error of reading the spilled runs, which the merger doesn't return.
+    Status _spill_status;
+
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _spill_runs_counter = nullptr;
 };
 
 } // namespace starrocks::vectorized
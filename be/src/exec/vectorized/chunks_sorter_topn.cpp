@@ -2,6 +2,7 @@
 
 #include "chunks_sorter_topn.h"
 
+#include "column/nullable_column.h"
 #include "column/type_traits.h"
 #include "exprs/expr.h"
 #include "gutil/casts.h"
@@ -25,8 +26,120 @@ ChunksSorterTopn::ChunksSorterTopn(const std::vector<ExprContext*>* sort_exprs,
 
 ChunksSorterTopn::~ChunksSorterTopn() = default;
 
+// Select the rows whose values of |column| are not after |threshold| in |threshold_column|, by a plain loop
+// which is vectorized by the compiler.
+template <PrimitiveType PT>
+static bool select_rows_not_after_threshold(const Column* column, const Column* threshold_column, size_t threshold,
+                                            bool is_asc, uint8_t* selection) {
+    using CppType = RunTimeCppType<PT>;
+    if constexpr (pt_is_fixedlength<PT>) {
+        const CppType& value = down_cast<const RunTimeColumnType<PT>*>(threshold_column)->get_data()[threshold];
+        const CppType* data = down_cast<const RunTimeColumnType<PT>*>(column)->get_data().data();
+        const size_t num_rows = column->size();
+        if (is_asc) {
+            for (size_t i = 0; i < num_rows; ++i) {
+                selection[i] = data[i] <= value;
+            }
+        } else {
+            for (size_t i = 0; i < num_rows; ++i) {
+                selection[i] = value <= data[i];
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+// Once the top rows are kept in _merged_segment, the rows of |chunk| after the last of them in the first
+// order-by column can't be in the top rows, drop them before buffering the chunk. Returns the rows left.
+ChunkPtr ChunksSorterTopn::_filter_by_threshold(const ChunkPtr& chunk) {
+    const size_t num_rows = chunk->num_rows();
+    const size_t threshold = _get_number_of_rows_to_sort() - 1;
+    ColumnPtr column = (*_sort_exprs)[0]->evaluate(chunk.get());
+    const Column* threshold_column = _merged_segment.order_by_columns[0].get();
+    if (column->is_constant() || threshold_column->is_constant()) {
+        return chunk;
+    }
+
+    _selection.resize(num_rows);
+    uint8_t* selection = _selection.data();
+    const int sort_order_flag = _sort_order_flag[0];
+    const int null_first_flag = _null_first_flag[0];
+    bool selected = false;
+    if (!threshold_column->is_null(threshold)) {
+        const Column* data_column = column.get();
+        if (column->is_nullable()) {
+            data_column = down_cast<const NullableColumn*>(column.get())->data_column().get();
+        }
+        const Column* threshold_data_column = threshold_column;
+        if (threshold_column->is_nullable()) {
+            threshold_data_column = down_cast<const NullableColumn*>(threshold_column)->data_column().get();
+        }
+        bool is_asc = sort_order_flag == 1;
+        switch ((*_sort_exprs)[0]->root()->type().type) {
+#define CASE_FOR_THRESHOLD_FILTER(PT)                                                                                 \
+    case PT:                                                                                                          \
+        selected = select_rows_not_after_threshold<PT>(data_column, threshold_data_column, threshold, is_asc,         \
+                                                       selection);                                                    \
+        break;
+            CASE_FOR_THRESHOLD_FILTER(TYPE_BOOLEAN)
+            CASE_FOR_THRESHOLD_FILTER(TYPE_TINYINT)
+            CASE_FOR_THRESHOLD_FILTER(TYPE_SMALLINT)
+            CASE_FOR_THRESHOLD_FILTER(TYPE_INT)
+            CASE_FOR_THRESHOLD_FILTER(TYPE_BIGINT)
+            CASE_FOR_THRESHOLD_FILTER(TYPE_LARGEINT)
+            CASE_FOR_THRESHOLD_FILTER(TYPE_DECIMAL32)
+            CASE_FOR_THRESHOLD_FILTER(TYPE_DECIMAL64)
+            CASE_FOR_THRESHOLD_FILTER(TYPE_DECIMAL128)
+            CASE_FOR_THRESHOLD_FILTER(TYPE_DATE)
+            CASE_FOR_THRESHOLD_FILTER(TYPE_DATETIME)
+#undef CASE_FOR_THRESHOLD_FILTER
+        default:
+            break;
+        }
+        // NULL is compared with the others by null_first_flag, see NullableColumn::compare_at.
+        if (selected && column->has_null()) {
+            const uint8_t null_selected = null_first_flag * sort_order_flag < 0;
+            const auto& nulls = down_cast<const NullableColumn*>(column.get())->immutable_null_column_data();
+            for (size_t i = 0; i < num_rows; ++i) {
+                selection[i] = nulls[i] ? null_selected : selection[i];
+            }
+        }
+    }
+    if (!selected) {
+        for (size_t i = 0; i < num_rows; ++i) {
+            int c = column->compare_at(i, threshold, *threshold_column, null_first_flag) * sort_order_flag;
+            selection[i] = c <= 0;
+        }
+    }
+
+    _selected_indexes.clear();
+    for (uint32_t i = 0; i < num_rows; ++i) {
+        if (selection[i]) {
+            _selected_indexes.push_back(i);
+        }
+    }
+    if (_selected_indexes.size() == num_rows) {
+        return chunk;
+    }
+    if (_selected_indexes.empty()) {
+        return nullptr;
+    }
+    ChunkPtr filtered_chunk = chunk->clone_empty_with_slot(_selected_indexes.size());
+    filtered_chunk->append_selective(*chunk, _selected_indexes.data(), 0, _selected_indexes.size());
+    return filtered_chunk;
+}
+
 // Cumulative chunks into _raw_chunks for sorting.
-Status ChunksSorterTopn::update(RuntimeState* state, const ChunkPtr& chunk) {
+Status ChunksSorterTopn::update(RuntimeState* state, const ChunkPtr& input_chunk) {
+    ChunkPtr chunk = input_chunk;
+    if (_limit > 0 && _init_merged_segment && _merged_segment.chunk->num_rows() >= _get_number_of_rows_to_sort()) {
+        chunk = _filter_by_threshold(input_chunk);
+        if (chunk == nullptr) {
+            return Status::OK();
+        }
+    }
+
     auto& raw_chunks = _raw_chunks.chunks;
     size_t chunk_number = raw_chunks.size();
     if (chunk_number <= 0) {
@@ -83,18 +196,19 @@ Status ChunksSorterTopn::done(RuntimeState* state) {
     return Status::OK();
 }
 
-void ChunksSorterTopn::get_next(ChunkPtr* chunk, bool* eos) {
+Status ChunksSorterTopn::get_next(ChunkPtr* chunk, bool* eos) {
     ScopedTimer<MonotonicStopWatch> timer(_output_timer);
     if (_next_output_row >= _merged_segment.chunk->num_rows()) {
         *chunk = nullptr;
         *eos = true;
-        return;
+        return Status::OK();
     }
     *eos = false;
     size_t count = std::min(size_t(config::vector_chunk_size), _merged_segment.chunk->num_rows() - _next_output_row);
     chunk->reset(_merged_segment.chunk->clone_empty(count).release());
     (*chunk)->append_safe(*_merged_segment.chunk, _next_output_row, count);
     _next_output_row += count;
+    return Status::OK();
 }
 
 Status ChunksSorterTopn::_sort_chunks(RuntimeState* state) {
@@ -30,11 +30,13 @@ public:
     // Finish seeding Chunk, and get sorted data with top OFFSET rows have been skipped.
     Status done(RuntimeState* state) override;
     // get_next only works after done().
-    void get_next(ChunkPtr* chunk, bool* eos) override;
+    Status get_next(ChunkPtr* chunk, bool* eos) override;
 
 private:
     inline size_t _get_number_of_rows_to_sort() const { return _offset + _limit; }
 
+    ChunkPtr _filter_by_threshold(const ChunkPtr& chunk);
+
     Status _sort_chunks(RuntimeState* state);
 
     // build data for top-n
@@ -82,6 +84,9 @@ private:
 
     bool _init_merged_segment;
     DataSegment _merged_segment;
+
+    std::vector<uint8_t> _selection;
+    std::vector<uint32_t> _selected_indexes;
 };
 
 } // namespace starrocks::vectorized
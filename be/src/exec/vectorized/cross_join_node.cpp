@@ -2,12 +2,135 @@
 
 #include "exec/vectorized/cross_join_node.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "column/chunk.h"
 #include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
 #include "exprs/expr_context.h"
+#include "exprs/vectorized/column_ref.h"
+#include "gutil/casts.h"
 #include "runtime/runtime_state.h"
 
 namespace starrocks::vectorized {
+
+// The types of the slots of a range conjunct, whose values are totally ordered.
+#define APPLY_FOR_RANGE_JOIN_TYPES(M) \
+    M(TYPE_TINYINT)                   \
+    M(TYPE_SMALLINT)                  \
+    M(TYPE_INT)                       \
+    M(TYPE_BIGINT)                    \
+    M(TYPE_LARGEINT)                  \
+    M(TYPE_DATE)                      \
+    M(TYPE_DATETIME)
+
+static bool is_range_join_type(PrimitiveType type) {
+    switch (type) {
+#define M(PT) case PT:
+        APPLY_FOR_RANGE_JOIN_TYPES(M)
+#undef M
+        return true;
+    default:
+        return false;
+    }
+}
+
+// The values of a non-constant column of |PT|, and its nulls if it has null.
+template <PrimitiveType PT>
+static const RunTimeCppType<PT>* range_join_data(const Column* column, const uint8_t** nulls) {
+    *nulls = nullptr;
+    if (column->is_nullable()) {
+        const auto* nullable = down_cast<const NullableColumn*>(column);
+        if (nullable->has_null()) {
+            *nulls = nullable->immutable_null_column_data().data();
+        }
+        column = nullable->data_column().get();
+    }
+    return down_cast<const RunTimeColumnType<PT>*>(column)->get_data().data();
+}
+
+// Sort the rows of |column| by their values, the null rows are left out.
+template <PrimitiveType PT>
+static void sort_range_join_rows(const Column* column, Buffer<uint32_t>* order) {
+    const uint8_t* nulls = nullptr;
+    const auto* data = range_join_data<PT>(column, &nulls);
+    order->clear();
+    order->reserve(column->size());
+    for (uint32_t row = 0; row < column->size(); row++) {
+        if (nulls == nullptr || nulls[row] == 0) {
+            order->push_back(row);
+        }
+    }
+    std::stable_sort(order->begin(), order->end(),
+                     [data](uint32_t lhs, uint32_t rhs) { return data[lhs] < data[rhs]; });
+}
+
+// For every row of |probe_column|, the range of |order| whose build values pass "probe_value op build_value".
+template <PrimitiveType PT>
+static void compute_range_join_ranges(const Column* build_column, const Buffer<uint32_t>& order,
+                                      const Column* probe_column, TExprOpcode::type op,
+                                      std::vector<std::pair<uint32_t, uint32_t>>* ranges) {
+    using CppType = RunTimeCppType<PT>;
+    const uint8_t* build_nulls = nullptr;
+    const auto* build_data = range_join_data<PT>(build_column, &build_nulls);
+    const uint8_t* probe_nulls = nullptr;
+    const auto* probe_data = range_join_data<PT>(probe_column, &probe_nulls);
+
+    // the first position whose build value is not less than, or greater than |value|
+    auto lower_bound = [&](const CppType& value) -> uint32_t {
+        return std::lower_bound(order.begin(), order.end(), value,
+                                [build_data](uint32_t row, const CppType& v) { return build_data[row] < v; }) -
+               order.begin();
+    };
+    auto upper_bound = [&](const CppType& value) -> uint32_t {
+        return std::upper_bound(order.begin(), order.end(), value,
+                                [build_data](const CppType& v, uint32_t row) { return v < build_data[row]; }) -
+               order.begin();
+    };
+
+    const uint32_t num_build_rows = order.size();
+    ranges->resize(probe_column->size());
+    for (size_t i = 0; i < probe_column->size(); i++) {
+        if (probe_nulls != nullptr && probe_nulls[i] != 0) {
+            (*ranges)[i] = {0, 0};
+            continue;
+        }
+        const CppType& value = probe_data[i];
+        switch (op) {
+        case TExprOpcode::LT:
+            (*ranges)[i] = {upper_bound(value), num_build_rows};
+            break;
+        case TExprOpcode::LE:
+            (*ranges)[i] = {lower_bound(value), num_build_rows};
+            break;
+        case TExprOpcode::GT:
+            (*ranges)[i] = {0, lower_bound(value)};
+            break;
+        default:
+            DCHECK_EQ(TExprOpcode::GE, op);
+            (*ranges)[i] = {0, upper_bound(value)};
+            break;
+        }
+    }
+}
+
+// Append the rows |rows| of |src_col| into |dest_col|.
+static void copy_selective_rows(ColumnPtr& dest_col, const ColumnPtr& src_col, const Buffer<uint32_t>& rows) {
+    if (src_col->is_constant()) {
+        // current can't reach here
+        if (src_col->is_nullable()) {
+            dest_col->append_nulls(rows.size());
+        } else {
+            auto* const_col = ColumnHelper::as_raw_column<ConstColumn>(src_col);
+            dest_col->append_value_multiple_times(*const_col->data_column(), 0, rows.size());
+        }
+    } else {
+        dest_col->append_selective(*src_col, rows.data(), 0, rows.size());
+    }
+}
+
 CrossJoinNode::CrossJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
         : ExecNode(pool, tnode, descs) {}
 
@@ -25,6 +148,7 @@ Status CrossJoinNode::prepare(RuntimeState* state) {
     _probe_rows_counter = ADD_COUNTER(runtime_profile(), "ProbeRows", TUnit::UNIT);
 
     _init_row_desc();
+    _init_tiled_join();
     return Status::OK();
 }
 
@@ -273,6 +397,10 @@ Status CrossJoinNode::get_next_internal(RuntimeState* state, ChunkPtr* chunk, bo
         return Status::OK();
     }
 
+    if (_use_tiled_join) {
+        return _get_next_tiled(state, chunk, eos, probe_timer);
+    }
+
     for (;;) {
         // need to get probe_chunk
         if (_probe_chunk == nullptr || _probe_chunk->num_rows() == 0) {
@@ -391,6 +519,12 @@ Status CrossJoinNode::get_next_internal(RuntimeState* state, ChunkPtr* chunk, bo
         break;
     }
 
+    _update_rows_returned(chunk);
+    *eos = false;
+    return Status::OK();
+}
+
+void CrossJoinNode::_update_rows_returned(ChunkPtr* chunk) {
     _num_rows_returned += (*chunk)->num_rows();
     if (reached_limit()) {
         (*chunk)->set_num_rows((*chunk)->num_rows() - (_num_rows_returned - _limit));
@@ -402,10 +536,174 @@ Status CrossJoinNode::get_next_internal(RuntimeState* state, ChunkPtr* chunk, bo
 
     DCHECK(!(*chunk)->has_const_column());
     DCHECK_CHUNK(*chunk);
+}
+
+Status CrossJoinNode::_get_next_tiled(RuntimeState* state, ChunkPtr* chunk, bool* eos,
+                                      ScopedTimer<MonotonicStopWatch>& probe_timer) {
+    for (;;) {
+        RETURN_IF_CANCELLED(state);
+        if (_probe_chunk == nullptr) {
+            probe_timer.stop();
+            RETURN_IF_ERROR(_get_next_probe_chunk(state));
+            probe_timer.start();
+            if (_eos) {
+                *eos = true;
+                return Status::OK();
+            }
+            _init_probe_ranges();
+        }
+
+        _next_tile();
+        if (_tile_probe_rows.empty()) {
+            // _probe_chunk is done with _build_chunk.
+            _probe_chunk = nullptr;
+            continue;
+        }
+        ChunkPtr tile = _filter_tile();
+        if (_tile_probe_rows.empty()) {
+            continue;
+        }
+        _init_chunk(chunk);
+        _copy_tile_rows(tile, *chunk);
+        break;
+    }
+
+    _update_rows_returned(chunk);
     *eos = false;
     return Status::OK();
 }
 
+void CrossJoinNode::_init_probe_ranges() {
+    const size_t num_probe_rows = _probe_chunk->num_rows();
+    const uint32_t num_build_rows = _build_order.size();
+    const Column* probe_column = nullptr;
+    if (_range_type != INVALID_TYPE) {
+        probe_column = _probe_chunk->get_column_by_slot_id(_range_probe_slot).get();
+    }
+    // A constant probe column is joined with all the build rows, the ranges only skip the pairs which can't pass.
+    if (probe_column != nullptr && !probe_column->is_constant()) {
+        const Column* build_column = _build_chunk->get_column_by_slot_id(_range_build_slot).get();
+        switch (_range_type) {
+#define M(PT)                                                                                                 \
+    case PT:                                                                                                  \
+        compute_range_join_ranges<PT>(build_column, _build_order, probe_column, _range_op, &_probe_ranges); \
+        break;
+            APPLY_FOR_RANGE_JOIN_TYPES(M)
+#undef M
+        default:
+            DCHECK(false) << "unexpected type of range join: " << _range_type;
+            _probe_ranges.assign(num_probe_rows, {0, num_build_rows});
+            break;
+        }
+    } else {
+        _probe_ranges.assign(num_probe_rows, {0, num_build_rows});
+    }
+
+    _tile_block_start = 0;
+    _tile_probe_row = 0;
+    _tile_build_pos = 0;
+}
+
+void CrossJoinNode::_next_tile() {
+    _tile_probe_rows.clear();
+    _tile_build_rows.clear();
+    const size_t capacity = config::vector_chunk_size;
+    const size_t num_probe_rows = _probe_ranges.size();
+    while (_tile_block_start < _build_order.size() && _tile_probe_rows.size() < capacity) {
+        const size_t block_end = std::min<size_t>(_tile_block_start + config::vector_chunk_size, _build_order.size());
+        while (_tile_probe_row < num_probe_rows && _tile_probe_rows.size() < capacity) {
+            const auto& range = _probe_ranges[_tile_probe_row];
+            size_t begin = std::max<size_t>({range.first, _tile_block_start, _tile_build_pos});
+            size_t end = std::min<size_t>(range.second, block_end);
+            if (begin < end) {
+                size_t count = std::min(end - begin, capacity - _tile_probe_rows.size());
+                _tile_probe_rows.insert(_tile_probe_rows.end(), count, _tile_probe_row);
+                _tile_build_rows.insert(_tile_build_rows.end(), _build_order.begin() + begin,
+                                        _build_order.begin() + begin + count);
+                begin += count;
+            }
+            if (begin < end) {
+                // the tile is full, resume from |begin| for the current probe row.
+                _tile_build_pos = begin;
+            } else {
+                ++_tile_probe_row;
+                _tile_build_pos = 0;
+            }
+        }
+        if (_tile_probe_row == num_probe_rows) {
+            // all the probe rows are done with the current block, so go to the next block.
+            _tile_block_start = block_end;
+            _tile_probe_row = 0;
+        }
+    }
+}
+
+ChunkPtr CrossJoinNode::_filter_tile() {
+    const size_t num_pairs = _tile_probe_rows.size();
+    ChunkPtr tile = std::make_shared<Chunk>();
+    for (size_t i = 0; i < _col_types.size(); i++) {
+        SlotDescriptor* slot = _col_types[i];
+        if (_conjunct_slots.count(slot->id()) == 0) {
+            continue;
+        }
+        const bool is_probe = i < _probe_column_count;
+        const ColumnPtr& src_col = is_probe ? _probe_chunk->get_column_by_slot_id(slot->id())
+                                            : _build_chunk->get_column_by_slot_id(slot->id());
+        ColumnPtr dest_col = ColumnHelper::create_column(slot->type(), src_col->is_nullable());
+        copy_selective_rows(dest_col, src_col, is_probe ? _tile_probe_rows : _tile_build_rows);
+        tile->append_column(std::move(dest_col), slot->id());
+    }
+
+    FilterPtr filter;
+    ExecNode::eval_conjuncts(_conjunct_ctxs, tile.get(), &filter);
+    const size_t num_passed = tile->num_rows();
+    if (num_passed == 0) {
+        _tile_probe_rows.clear();
+        _tile_build_rows.clear();
+    } else if (num_passed < num_pairs) {
+        size_t j = 0;
+        for (size_t i = 0; i < num_pairs; i++) {
+            _tile_probe_rows[j] = _tile_probe_rows[i];
+            _tile_build_rows[j] = _tile_build_rows[i];
+            j += (*filter)[i];
+        }
+        DCHECK_EQ(num_passed, j);
+        _tile_probe_rows.resize(j);
+        _tile_build_rows.resize(j);
+    }
+    return tile;
+}
+
+void CrossJoinNode::_copy_tile_rows(const ChunkPtr& tile, ChunkPtr& chunk) {
+    for (size_t i = 0; i < _col_types.size(); i++) {
+        SlotDescriptor* slot = _col_types[i];
+        ColumnPtr& dest_col = chunk->get_column_by_slot_id(slot->id());
+        if (_conjunct_slots.count(slot->id()) > 0) {
+            // the column has been filtered with the tile.
+            dest_col = tile->get_column_by_slot_id(slot->id());
+            continue;
+        }
+        if (i < _probe_column_count) {
+            copy_selective_rows(dest_col, _probe_chunk->get_column_by_slot_id(slot->id()), _tile_probe_rows);
+        } else {
+            copy_selective_rows(dest_col, _build_chunk->get_column_by_slot_id(slot->id()), _tile_build_rows);
+        }
+    }
+
+    for (int tuple_id : _output_probe_tuple_ids) {
+        if (_probe_chunk->is_tuple_exist(tuple_id)) {
+            ColumnPtr& dest_col = chunk->get_tuple_column_by_id(tuple_id);
+            copy_selective_rows(dest_col, _probe_chunk->get_tuple_column_by_id(tuple_id), _tile_probe_rows);
+        }
+    }
+    for (int tuple_id : _output_build_tuple_ids) {
+        if (_build_chunk->is_tuple_exist(tuple_id)) {
+            ColumnPtr& dest_col = chunk->get_tuple_column_by_id(tuple_id);
+            copy_selective_rows(dest_col, _build_chunk->get_tuple_column_by_id(tuple_id), _tile_build_rows);
+        }
+    }
+}
+
 Status CrossJoinNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     ScopedTimer<MonotonicStopWatch> probe_timer(_probe_timer);
@@ -446,6 +744,82 @@ void CrossJoinNode::_init_row_desc() {
     }
 }
 
+void CrossJoinNode::_init_tiled_join() {
+    std::vector<SlotId> slot_ids;
+    for (ExprContext* ctx : _conjunct_ctxs) {
+        ctx->root()->get_slot_ids(&slot_ids);
+    }
+    // The conjuncts without slots are evaluated on the output chunks.
+    if (slot_ids.empty()) {
+        return;
+    }
+    _use_tiled_join = true;
+    _conjunct_slots.insert(slot_ids.begin(), slot_ids.end());
+
+    std::unordered_set<SlotId> probe_slots;
+    for (size_t i = 0; i < _probe_column_count; i++) {
+        probe_slots.insert(_col_types[i]->id());
+    }
+    for (ExprContext* ctx : _conjunct_ctxs) {
+        Expr* root = ctx->root();
+        if (root->node_type() != TExprNodeType::BINARY_PRED || root->get_num_children() != 2) {
+            continue;
+        }
+        TExprOpcode::type op = root->op();
+        if (op != TExprOpcode::LT && op != TExprOpcode::LE && op != TExprOpcode::GT && op != TExprOpcode::GE) {
+            continue;
+        }
+        Expr* left = root->get_child(0);
+        Expr* right = root->get_child(1);
+        if (!left->is_slotref() || !right->is_slotref() || left->type().type != right->type().type ||
+            !is_range_join_type(left->type().type)) {
+            continue;
+        }
+        SlotId left_slot = down_cast<ColumnRef*>(left)->slot_id();
+        SlotId right_slot = down_cast<ColumnRef*>(right)->slot_id();
+        const bool left_is_probe = probe_slots.count(left_slot) > 0;
+        if (left_is_probe == (probe_slots.count(right_slot) > 0)) {
+            continue;
+        }
+        _range_type = left->type().type;
+        if (left_is_probe) {
+            _range_probe_slot = left_slot;
+            _range_build_slot = right_slot;
+            _range_op = op;
+        } else {
+            // "build_slot op probe_slot" is "probe_slot reversed_op build_slot".
+            _range_probe_slot = right_slot;
+            _range_build_slot = left_slot;
+            _range_op = op == TExprOpcode::LT   ? TExprOpcode::GT
+                        : op == TExprOpcode::LE ? TExprOpcode::GE
+                        : op == TExprOpcode::GT ? TExprOpcode::LT
+                                                : TExprOpcode::LE;
+        }
+        break;
+    }
+}
+
+void CrossJoinNode::_sort_build_rows() {
+    if (_range_type != INVALID_TYPE) {
+        const Column* build_column = _build_chunk->get_column_by_slot_id(_range_build_slot).get();
+        if (!build_column->is_constant()) {
+            switch (_range_type) {
+#define M(PT)                                                  \
+    case PT:                                                   \
+        sort_range_join_rows<PT>(build_column, &_build_order); \
+        return;
+                APPLY_FOR_RANGE_JOIN_TYPES(M)
+#undef M
+            default:
+                break;
+            }
+        }
+        _range_type = INVALID_TYPE;
+    }
+    _build_order.resize(_number_of_build_rows);
+    std::iota(_build_order.begin(), _build_order.end(), 0);
+}
+
 Status CrossJoinNode::_build(RuntimeState* state) {
     ScopedTimer<MonotonicStopWatch> build_timer(_build_timer);
     RETURN_IF_ERROR(child(1)->open(state));
@@ -484,6 +858,9 @@ Status CrossJoinNode::_build(RuntimeState* state) {
     if (_build_chunk != nullptr) {
         _number_of_build_rows = _build_chunk->num_rows();
         _build_chunks_size = (_number_of_build_rows / config::vector_chunk_size) * config::vector_chunk_size;
+        if (_use_tiled_join) {
+            _sort_build_rows();
+        }
     }
 
     RETURN_IF_ERROR(child(1)->close(state));
@@ -2,8 +2,12 @@
 
 #pragma once
 
+#include <unordered_set>
+#include <utility>
+
 #include "column/chunk.h"
 #include "exec/exec_node.h"
+#include "gen_cpp/Opcodes_types.h"
 
 namespace starrocks::vectorized {
 class CrossJoinNode : public ExecNode {
@@ -44,6 +48,25 @@ private:
 
     void _init_row_desc();
     void _init_chunk(ChunkPtr* chunk);
+    void _update_rows_returned(ChunkPtr* chunk);
+
+    // The tiled nested loop is used when there are conjuncts on the joined rows. A tile is up to chunk_size pairs of
+    // a probe row and a build row, the build rows are visited by the blocks of chunk_size rows, so that a block is
+    // joined with all the rows of the probe chunk while it's in cache. The conjuncts are evaluated on the tile with
+    // only the columns they reference, and only the pairs passing them are copied into the output chunk.
+    void _init_tiled_join();
+    // Sort the build rows by the build column of the range conjunct, see _range_probe_slot.
+    void _sort_build_rows();
+    Status _get_next_tiled(RuntimeState* state, ChunkPtr* chunk, bool* eos,
+                           ScopedTimer<MonotonicStopWatch>& probe_timer);
+    // Compute the range of |_build_order| which may be joined with every row of the new probe chunk.
+    void _init_probe_ranges();
+    // Fill |_tile_probe_rows| and |_tile_build_rows| with the next pairs, they are empty if the probe chunk is done.
+    void _next_tile();
+    // Evaluate the conjuncts on the tile and keep the passed pairs only. The returned chunk holds the conjunct columns
+    // of the passed pairs, which are moved into the output chunk by _copy_tile_rows.
+    ChunkPtr _filter_tile();
+    void _copy_tile_rows(const ChunkPtr& tile, ChunkPtr& chunk);
 
     // previsou saved chunk.
     ChunkPtr _pre_output_chunk = nullptr;
@@ -84,5 +107,28 @@ private:
     RuntimeProfile::Counter* _probe_rows_counter = nullptr;
 
     std::vector<uint32_t> _buf_selective;
+
+    bool _use_tiled_join = false;
+    // the slots referenced by the conjuncts
+    std::unordered_set<SlotId> _conjunct_slots;
+    // The range conjunct is the first conjunct comparing a probe slot and a build slot of the same ordered type by
+    // <, <=, > or >=, which is normalized to "probe_slot op build_slot". The build rows are sorted by the build slot,
+    // so the rows which may pass it are a range of the sorted rows for every probe row, and the other pairs are never
+    // visited. The null build values never pass it and are left out of the sorted rows.
+    SlotId _range_probe_slot = -1;
+    SlotId _range_build_slot = -1;
+    PrimitiveType _range_type = INVALID_TYPE;
+    TExprOpcode::type _range_op = TExprOpcode::INVALID_OPCODE;
+    // the build rows to join, in the order of the range conjunct slot, or all the rows in order without it
+    Buffer<uint32_t> _build_order;
+    // the range of |_build_order| for every row of |_probe_chunk|
+    std::vector<std::pair<uint32_t, uint32_t>> _probe_ranges;
+    // the start of the current build block in |_build_order|, the current probe row and the next position of
+    // |_build_order| for it
+    size_t _tile_block_start = 0;
+    size_t _tile_probe_row = 0;
+    size_t _tile_build_pos = 0;
+    Buffer<uint32_t> _tile_probe_rows;
+    Buffer<uint32_t> _tile_build_rows;
 };
 } // namespace starrocks::vectorized
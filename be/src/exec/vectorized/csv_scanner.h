@@ -35,6 +35,14 @@ public:
 
     void close() override{};
 
+    // Parse the records in |file| as the first range of the scan range, instead of opening the range. It's used
+    // to parse the blocks of a stream split at the record boundaries by several scanners, see FileScanNode.
+    void reset_input(std::shared_ptr<SequentialFile> file) {
+        _input = std::move(file);
+        _curr_reader = nullptr;
+        _curr_file_index = -1;
+    }
+
 private:
     class Buffer {
     public:
@@ -106,14 +114,25 @@ private:
         void set_counter(ScannerCounter* counter) { _counter = counter; }
 
     private:
+        // The max number of the record delimiters found by a scan of the buffer.
+        constexpr static size_t kMaxRecordEnds = 1024;
+
         Status _expand_buffer();
         Status _fill_buffer();
+        // Find the record delimiters after |_scan_end|, or refill the buffer if all of it is scanned.
+        Status _find_record_ends();
 
         std::shared_ptr<SequentialFile> _file;
         char _record_delimiter;
         char _field_delimiter;
         raw::RawVector<char> _storage;
         Buffer _buff;
+        // The record delimiters found in the buffer and not consumed yet from |_next_record_end|, the buffer is
+        // scanned up to |_scan_end|. They are valid until the buffer is compacted, which happens only after they
+        // are all consumed.
+        std::vector<char*> _record_ends;
+        size_t _next_record_end = 0;
+        char* _scan_end = nullptr;
         size_t _parsed_bytes = 0;
         size_t _limit = 0;
         ScannerCounter* _counter = nullptr;
@@ -135,6 +154,7 @@ private:
     int _num_fields_in_csv = 0;
     int _curr_file_index = -1;
     CSVReaderPtr _curr_reader;
+    std::shared_ptr<SequentialFile> _input;
     std::vector<ConverterPtr> _converters;
 };
 
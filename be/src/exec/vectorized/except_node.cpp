@@ -3,13 +3,26 @@
 #include "exec/vectorized/except_node.h"
 
 #include "column/column_helper.h"
+#include "common/config.h"
+#include "exec/pipeline/exchange/local_exchange.h"
+#include "exec/pipeline/exchange/local_exchange_sink_operator.h"
+#include "exec/pipeline/exchange/local_exchange_source_operator.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/set/except_build_sink_operator.h"
+#include "exec/pipeline/set/except_context.h"
+#include "exec/pipeline/set/except_output_source_operator.h"
+#include "exec/pipeline/set/except_probe_sink_operator.h"
 #include "exprs/expr.h"
 #include "runtime/runtime_state.h"
 
 namespace starrocks::vectorized {
 
 ExceptNode::ExceptNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
-        : ExecNode(pool, tnode, descs), _tuple_id(tnode.except_node.tuple_id), _tuple_desc(nullptr) {}
+        : ExecNode(pool, tnode, descs),
+          _tuple_id(tnode.except_node.tuple_id),
+          _tuple_desc(nullptr),
+          _tnode(tnode) {}
 
 Status ExceptNode::init(const TPlanNode& tnode, RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::init(tnode, state));
@@ -208,4 +221,45 @@ Status ExceptNode::close(RuntimeState* state) {
     return ExecNode::close(state);
 }
 
+pipeline::OpFactories ExceptNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    // The rows of every child are shuffled by the hash of their keys, so the equal keys of all the children meet in
+    // the same partition, and the partitions are excepted in parallel, one per driver.
+    const auto& result_texpr_lists = _tnode.except_node.result_expr_lists;
+    auto except_context = std::make_shared<ExceptContext>(context->driver_instance_count(), _children.size());
+    for (size_t i = 0; i < _children.size(); i++) {
+        OpFactories operators_with_shuffle = child(i)->decompose_to_pipeline(context);
+        auto memory_manager = std::make_shared<LocalExchangeMemoryManager>(
+                config::pipeline_local_exchange_buffer_bytes_per_driver * context->driver_instance_count());
+        auto local_shuffle_source =
+                std::make_shared<LocalExchangeSourceOperatorFactory>(context->next_operator_id(), memory_manager);
+        auto local_shuffle = std::make_shared<PartitionExchanger>(memory_manager, local_shuffle_source.get(), true,
+                                                                  _child_expr_lists[i], child(i)->row_desc());
+        operators_with_shuffle.emplace_back(
+                std::make_shared<LocalExchangeSinkOperatorFactory>(context->next_operator_id(), local_shuffle));
+        context->add_pipeline(operators_with_shuffle);
+
+        OpFactories operators_with_except;
+        operators_with_except.emplace_back(std::move(local_shuffle_source));
+        if (i == 0) {
+            operators_with_except.emplace_back(std::make_shared<ExceptBuildSinkOperatorFactory>(
+                    context->next_operator_id(), id(), except_context, result_texpr_lists[i], child(i)->row_desc()));
+        } else {
+            operators_with_except.emplace_back(std::make_shared<ExceptProbeSinkOperatorFactory>(
+                    context->next_operator_id(), id(), except_context, result_texpr_lists[i], child(i)->row_desc(),
+                    static_cast<int32_t>(i)));
+        }
+        context->add_pipeline(operators_with_except);
+    }
+
+    OpFactories operators_source_with_except;
+    operators_source_with_except.emplace_back(std::make_shared<ExceptOutputSourceOperatorFactory>(
+            context->next_operator_id(), id(), std::move(except_context), _tuple_id));
+    if (limit() != -1) {
+        operators_source_with_except.emplace_back(
+                std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return operators_source_with_except;
+}
+
 } // namespace starrocks::vectorized
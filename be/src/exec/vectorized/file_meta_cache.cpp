@@ -0,0 +1,59 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/file_meta_cache.h"
+
+namespace starrocks::vectorized {
+
+FileMetaCache* FileMetaCache::_s_instance = nullptr;
+
+void FileMetaCache::create_global_cache(size_t capacity) {
+    if (_s_instance == nullptr && capacity > 0) {
+        _s_instance = new FileMetaCache(capacity);
+    }
+}
+
+void FileMetaCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+FileMetaCache::FileMetaCache(size_t capacity) : _cache(new_lru_cache(capacity)) {}
+
+std::string FileMetaCache::make_key(const std::string& format, const std::string& path, int64_t file_size,
+                                    int64_t modification_time) {
+    std::string key = format;
+    key.push_back('\0');
+    key.append(path);
+    key.push_back('\0');
+    key.append(std::to_string(file_size));
+    key.push_back('\0');
+    key.append(std::to_string(modification_time));
+    return key;
+}
+
+std::shared_ptr<const void> FileMetaCache::_lookup(const std::string& key) {
+    auto* handle = _cache->lookup(key);
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    // the metadata is kept alive by the returned pointer, so the cache entry could be released at once.
+    auto meta = *reinterpret_cast<std::shared_ptr<const void>*>(_cache->value(handle));
+    _cache->release(handle);
+    return meta;
+}
+
+void FileMetaCache::insert(const std::string& key, std::shared_ptr<const void> meta, size_t charge) {
+    auto deleter = [](const starrocks::CacheKey& key, void* value) {
+        delete reinterpret_cast<std::shared_ptr<const void>*>(value);
+    };
+    auto* value = new std::shared_ptr<const void>(std::move(meta));
+    _cache->release(_cache->insert(key, value, charge, deleter));
+}
+
+size_t FileMetaCache::memory_usage() {
+    return _cache->get_memory_usage();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,54 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "storage/lru_cache.h"
+
+namespace starrocks::vectorized {
+
+// FileMetaCache caches the parsed metadata of the remote files, e.g. the footers of the parquet files and the
+// tails of the orc files, shared by all the queries, so the scans of a hot file don't read and deserialize its
+// footer again. The metadata is identified by the path, the size and the modification time of the file, so a
+// rewritten file never hits the stale metadata. The least recently used entries are evicted once their charges
+// exceed the capacity.
+//
+// This class is thread-safe.
+class FileMetaCache {
+public:
+    // Create global instance of this class, do nothing if |capacity| is 0.
+    static void create_global_cache(size_t capacity);
+
+    static void release_global_cache();
+
+    // Return global instance, nullptr if the cache is disabled.
+    static FileMetaCache* instance() { return _s_instance; }
+
+    explicit FileMetaCache(size_t capacity);
+
+    // The key of the metadata of |format|, e.g. "parquet", of the file.
+    static std::string make_key(const std::string& format, const std::string& path, int64_t file_size,
+                                int64_t modification_time);
+
+    // Return nullptr if the metadata of |key| isn't cached, the caller must know its type.
+    template <typename T>
+    std::shared_ptr<const T> lookup(const std::string& key) {
+        return std::static_pointer_cast<const T>(_lookup(key));
+    }
+
+    // Cache |meta| as the metadata of |key|, |charge| is the memory it takes.
+    void insert(const std::string& key, std::shared_ptr<const void> meta, size_t charge);
+
+    size_t memory_usage();
+
+private:
+    std::shared_ptr<const void> _lookup(const std::string& key);
+
+    static FileMetaCache* _s_instance;
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace starrocks::vectorized
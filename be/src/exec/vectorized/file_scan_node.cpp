@@ -3,6 +3,7 @@
 #include "exec/vectorized/file_scan_node.h"
 
 #include <chrono>
+#include <cstring>
 #include <sstream>
 
 #include "column/chunk.h"
@@ -11,6 +12,7 @@
 #include "env/env.h"
 #include "env/env_broker.h"
 #include "env/env_stream_pipe.h"
+#include "env/env_memory.h"
 #include "env/env_util.h"
 #include "exec/vectorized/csv_scanner.h"
 #include "exec/vectorized/json_scanner.h"
@@ -84,8 +86,18 @@ Status FileScanNode::start_scanners() {
     {
         std::unique_lock<std::mutex> l(_chunk_queue_lock);
 
-        _num_running_scanners = 1;
-        _scanner_threads.emplace_back(&FileScanNode::scanner_worker, this, 0, _scan_ranges.size());
+        int parallelism = config::streaming_load_parse_parallelism;
+        if (parallelism > 1 && _can_parse_in_parallel()) {
+            _num_parsers = parallelism;
+            _num_running_scanners = 1 + _num_parsers;
+            _scanner_threads.emplace_back(&FileScanNode::_split_worker, this);
+            for (int i = 0; i < _num_parsers; ++i) {
+                _scanner_threads.emplace_back(&FileScanNode::_parse_worker, this);
+            }
+        } else {
+            _num_running_scanners = 1;
+            _scanner_threads.emplace_back(&FileScanNode::scanner_worker, this, 0, _scan_ranges.size());
+        }
     }
     return Status::OK();
 }
@@ -176,6 +188,7 @@ Status FileScanNode::close(RuntimeState* state) {
     _scan_finished.store(true);
     _queue_writer_cond.notify_all();
     _queue_reader_cond.notify_all();
+    _block_cond.notify_all();
     for (int i = 0; i < _scanner_threads.size(); ++i) {
         _scanner_threads[i].join();
     }
@@ -242,39 +255,44 @@ Status FileScanNode::scanner_scan(const TBrokerScanRange& scan_range, const std:
 
         // Row batch has been filled, push this to the queue
         if (temp_chunk->num_rows() > 0) {
-            std::unique_lock<std::mutex> l(_chunk_queue_lock);
-            while (_process_status.ok() && !_scan_finished.load() && !_runtime_state->is_cancelled() &&
-                   // stop pushing more batch if
-                   // 1. too many batches in queue, or
-                   // 2. at least one batch in queue and memory exceed limit.
-                   (_chunk_queue.size() >= _max_queue_size ||
-                    (mem_tracker()->any_limit_exceeded() && !_chunk_queue.empty()))) {
-                _queue_writer_cond.wait_for(l, std::chrono::seconds(1));
-            }
-            // Process already set failed, so we just return OK
-            if (!_process_status.ok()) {
+            bool stop = false;
+            RETURN_IF_ERROR(_push_chunk(std::move(temp_chunk), &stop));
+            if (stop) {
                 return Status::OK();
             }
-            // Scan already finished, just return
-            if (_scan_finished.load()) {
-                return Status::OK();
-            }
-            // Runtime state is canceled, just return cancel
-            if (_runtime_state->is_cancelled()) {
-                return Status::Cancelled("Cancelled FileScanNode::scanner_scan");
-            }
-            // Queue size Must be smaller than _max_queue_size
-            _chunk_queue.push_back(std::move(temp_chunk));
-            mem_tracker()->consume(_chunk_queue.back()->memory_usage());
-
-            // Notify reader to
-            _queue_reader_cond.notify_one();
         }
     }
 
     return Status::OK();
 }
 
+Status FileScanNode::_push_chunk(ChunkPtr chunk, bool* stop) {
+    std::unique_lock<std::mutex> l(_chunk_queue_lock);
+    while (_process_status.ok() && !_scan_finished.load() && !_runtime_state->is_cancelled() &&
+           // stop pushing more batch if
+           // 1. too many batches in queue, or
+           // 2. at least one batch in queue and memory exceed limit.
+           (_chunk_queue.size() >= _max_queue_size || (mem_tracker()->any_limit_exceeded() && !_chunk_queue.empty()))) {
+        _queue_writer_cond.wait_for(l, std::chrono::seconds(1));
+    }
+    // Process already set failed, or scan already finished, so we just return OK
+    if (!_process_status.ok() || _scan_finished.load()) {
+        *stop = true;
+        return Status::OK();
+    }
+    // Runtime state is canceled, just return cancel
+    if (_runtime_state->is_cancelled()) {
+        return Status::Cancelled("Cancelled FileScanNode::scanner_scan");
+    }
+    // Queue size Must be smaller than _max_queue_size
+    _chunk_queue.push_back(std::move(chunk));
+    mem_tracker()->consume(_chunk_queue.back()->memory_usage());
+
+    // Notify reader to
+    _queue_reader_cond.notify_one();
+    return Status::OK();
+}
+
 void FileScanNode::scanner_worker(int start_idx, int length) {
     // Clone expr context
     std::vector<ExprContext*> scanner_expr_ctxs;
@@ -307,20 +325,14 @@ void FileScanNode::scanner_worker(int start_idx, int length) {
             }
         }
 
-        // Update stats
-        _runtime_state->update_num_rows_load_filtered(counter.num_rows_filtered);
-        _runtime_state->update_num_rows_load_unselected(counter.num_rows_unselected);
-
-        COUNTER_UPDATE(_scanner_total_timer, counter.total_ns);
-        COUNTER_UPDATE(_scanner_fill_timer, counter.fill_ns);
-        COUNTER_UPDATE(_scanner_read_timer, counter.read_batch_ns);
-        COUNTER_UPDATE(_scanner_cast_chunk_timer, counter.cast_chunk_ns);
-        COUNTER_UPDATE(_scanner_materialize_timer, counter.materialize_ns);
-        COUNTER_UPDATE(_scanner_init_chunk_timer, counter.init_chunk_ns);
-
-        COUNTER_UPDATE(_scanner_file_reader_timer, counter.file_read_ns);
+        _update_counters(counter);
     }
 
+    _finish_scanner(status);
+    Expr::close(scanner_expr_ctxs, _runtime_state);
+}
+
+void FileScanNode::_finish_scanner(const Status& status) {
     // scanner is going to finish
     {
         std::lock_guard<std::mutex> l(_chunk_queue_lock);
@@ -334,8 +346,215 @@ void FileScanNode::scanner_worker(int start_idx, int length) {
     // If one scanner failed, others don't need scan any more
     if (!status.ok() && !status.is_end_of_file()) {
         _queue_writer_cond.notify_all();
+        _block_cond.notify_all();
+    }
+}
+
+void FileScanNode::_update_counters(const ScannerCounter& counter) {
+    _runtime_state->update_num_rows_load_filtered(counter.num_rows_filtered);
+    _runtime_state->update_num_rows_load_unselected(counter.num_rows_unselected);
+
+    COUNTER_UPDATE(_scanner_total_timer, counter.total_ns);
+    COUNTER_UPDATE(_scanner_fill_timer, counter.fill_ns);
+    COUNTER_UPDATE(_scanner_read_timer, counter.read_batch_ns);
+    COUNTER_UPDATE(_scanner_cast_chunk_timer, counter.cast_chunk_ns);
+    COUNTER_UPDATE(_scanner_materialize_timer, counter.materialize_ns);
+    COUNTER_UPDATE(_scanner_init_chunk_timer, counter.init_chunk_ns);
+
+    COUNTER_UPDATE(_scanner_file_reader_timer, counter.file_read_ns);
+}
+
+bool FileScanNode::_can_parse_in_parallel() const {
+    if (_scan_ranges.size() != 1) {
+        return false;
+    }
+    const TBrokerScanRange& scan_range = _scan_ranges[0].scan_range.broker_scan_range;
+    if (scan_range.ranges.size() != 1) {
+        return false;
+    }
+    // only the records of csv are split by the record delimiter.
+    const TBrokerRangeDesc& range_desc = scan_range.ranges[0];
+    auto format = range_desc.format_type;
+    return range_desc.file_type == TFileType::FILE_STREAM && range_desc.start_offset == 0 &&
+           format != TFileFormatType::FORMAT_ORC && format != TFileFormatType::FORMAT_PARQUET &&
+           format != TFileFormatType::FORMAT_JSON;
+}
+
+void FileScanNode::_split_worker() {
+    Status status = _split_stream();
+    {
+        std::lock_guard<std::mutex> l(_block_lock);
+        _split_finished = true;
     }
+    _block_cond.notify_all();
+    _finish_scanner(status);
+}
+
+Status FileScanNode::_split_stream() {
+    const TBrokerScanRange& scan_range = _scan_ranges[0].scan_range.broker_scan_range;
+    ScannerCounter counter;
+    std::shared_ptr<SequentialFile> file;
+    {
+        // the scanner is only used to open the stream, which is decompressed if it's compressed.
+        CSVScanner scanner(_runtime_state, runtime_profile(), scan_range, &counter);
+        RETURN_IF_ERROR(scanner.create_sequential_file(scan_range.ranges[0], scan_range.broker_addresses[0],
+                                                       scan_range.params, &file));
+    }
+
+    const char record_delimiter = scan_range.params.row_delimiter;
+    const size_t block_size = std::max<int64_t>(config::streaming_load_parse_block_size, 64 * 1024);
+    int64_t seq = 0;
+    std::string tail;
+    bool eof = false;
+    while (!eof) {
+        // read until a record delimiter is read, the bytes after the last one are moved to the next block.
+        std::string block = std::move(tail);
+        tail.clear();
+        while (true) {
+            size_t old_size = block.size();
+            block.resize(old_size + block_size);
+            Slice slice(block.data() + old_size, block_size);
+            Status st;
+            {
+                SCOPED_RAW_TIMER(&counter.file_read_ns);
+                st = file->read(&slice);
+            }
+            if (st.is_end_of_file()) {
+                slice.size = 0;
+            } else if (!st.ok()) {
+                return st;
+            }
+            block.resize(old_size + slice.size);
+            if (slice.size == 0) {
+                // the last record may not be ended with the record delimiter, which is added by the reader.
+                eof = true;
+                break;
+            }
+            const auto* d = static_cast<const char*>(memrchr(block.data() + old_size, record_delimiter, slice.size));
+            if (d != nullptr) {
+                size_t end = d - block.data() + 1;
+                tail.assign(block, end, std::string::npos);
+                block.resize(end);
+                break;
+            }
+        }
+        if (!block.empty()) {
+            RETURN_IF_ERROR(_push_block(seq++, std::move(block)));
+        }
+        if (_parsing_stopped()) {
+            break;
+        }
+    }
+    _update_counters(counter);
+    return Status::OK();
+}
+
+Status FileScanNode::_push_block(int64_t seq, std::string block) {
+    {
+        std::unique_lock<std::mutex> l(_block_lock);
+        // at most two blocks for each parser are buffered.
+        while (_blocks.size() >= static_cast<size_t>(2 * _num_parsers) && !_parsing_stopped()) {
+            _block_cond.wait_for(l, std::chrono::seconds(1));
+        }
+        if (_runtime_state->is_cancelled()) {
+            return Status::Cancelled("Cancelled FileScanNode::_split_stream");
+        }
+        _blocks.emplace_back(seq, std::move(block));
+    }
+    _block_cond.notify_all();
+    return Status::OK();
+}
+
+void FileScanNode::_parse_worker() {
+    // Clone expr context
+    std::vector<ExprContext*> scanner_expr_ctxs;
+    auto status = Expr::clone_if_not_exists(_conjunct_ctxs, _runtime_state, &scanner_expr_ctxs);
+    if (!status.ok()) {
+        LOG(WARNING) << "Clone conjuncts failed.";
+    } else {
+        ScannerCounter counter;
+        status = _parse_blocks(scanner_expr_ctxs, &counter);
+        if (!status.ok()) {
+            LOG(WARNING) << "FileScanner parse blocks failed. status=" << status.get_error_msg();
+        }
+        _update_counters(counter);
+    }
+    _finish_scanner(status);
     Expr::close(scanner_expr_ctxs, _runtime_state);
 }
 
+Status FileScanNode::_parse_blocks(const std::vector<ExprContext*>& conjunct_ctxs, ScannerCounter* counter) {
+    const TBrokerScanRange& scan_range = _scan_ranges[0].scan_range.broker_scan_range;
+    CSVScanner scanner(_runtime_state, runtime_profile(), scan_range, counter);
+    RETURN_IF_ERROR(scanner.open());
+
+    std::vector<ChunkPtr> chunks;
+    while (true) {
+        int64_t seq;
+        std::string block;
+        {
+            std::unique_lock<std::mutex> l(_block_lock);
+            while (_blocks.empty() && !_split_finished && !_parsing_stopped()) {
+                _block_cond.wait_for(l, std::chrono::seconds(1));
+            }
+            if (_blocks.empty() || _parsing_stopped()) {
+                return Status::OK();
+            }
+            seq = _blocks.front().first;
+            block = std::move(_blocks.front().second);
+            _blocks.pop_front();
+        }
+        _block_cond.notify_all();
+
+        scanner.reset_input(std::make_shared<StringSequentialFile>(std::move(block)));
+        chunks.clear();
+        while (true) {
+            RETURN_IF_CANCELLED(_runtime_state);
+            auto res = scanner.get_next();
+            if (res.status().is_end_of_file()) {
+                break;
+            } else if (!res.ok()) {
+                return res.status();
+            }
+            ChunkPtr chunk = std::move(res.value());
+
+            // eval conjuncts
+            size_t before = chunk->num_rows();
+            eval_conjuncts(conjunct_ctxs, chunk.get());
+            counter->num_rows_unselected += (before - chunk->num_rows());
+            if (chunk->num_rows() > 0) {
+                chunks.emplace_back(std::move(chunk));
+            }
+        }
+
+        // wait for the chunks of the previous blocks to be output first.
+        {
+            std::unique_lock<std::mutex> l(_block_lock);
+            while (_next_output_block != seq && !_parsing_stopped()) {
+                _block_cond.wait_for(l, std::chrono::seconds(1));
+            }
+            if (_next_output_block != seq) {
+                return Status::OK();
+            }
+        }
+        for (auto& chunk : chunks) {
+            bool stop = false;
+            RETURN_IF_ERROR(_push_chunk(std::move(chunk), &stop));
+            if (stop) {
+                return Status::OK();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> l(_block_lock);
+            _next_output_block++;
+        }
+        _block_cond.notify_all();
+    }
+}
+
+bool FileScanNode::_parsing_stopped() {
+    std::lock_guard<std::mutex> l(_chunk_queue_lock);
+    return !_process_status.ok() || _scan_finished.load() || _runtime_state->is_cancelled();
+}
+
 } // namespace starrocks::vectorized
@@ -4,6 +4,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <map>
 #include <mutex>
 #include <string>
@@ -81,6 +82,27 @@ private:
 
     std::unique_ptr<FileScanner> create_scanner(const TBrokerScanRange& scan_range, ScannerCounter* counter);
 
+    // Push |chunk| into the chunk queue, waiting while the queue is full.
+    // |*stop| is set to true if the scan finished or failed, then |chunk| is dropped.
+    Status _push_chunk(ChunkPtr chunk, bool* stop);
+
+    // Record the status of a scanner thread which is going to finish.
+    void _finish_scanner(const Status& status);
+
+    void _update_counters(const ScannerCounter& counter);
+
+    // Whether the only csv stream of a stream load could be parsed by several threads: one thread splits
+    // the stream into blocks at the record boundaries and the others parse the blocks, the chunks of the
+    // blocks are output in the order of the stream.
+    bool _can_parse_in_parallel() const;
+    void _split_worker();
+    Status _split_stream();
+    // Add the block to be parsed, waiting while there are too many blocks not parsed.
+    Status _push_block(int64_t seq, std::string block);
+    void _parse_worker();
+    Status _parse_blocks(const std::vector<ExprContext*>& conjunct_ctxs, ScannerCounter* counter);
+    bool _parsing_stopped();
+
 private:
     TupleId _tuple_id;
     RuntimeState* _runtime_state;
@@ -103,6 +125,16 @@ private:
 
     std::vector<std::thread> _scanner_threads;
 
+    // The blocks of the stream split at the record boundaries with their sequence numbers, used when the stream
+    // is parsed by several threads. _block_lock is locked before _chunk_queue_lock if both are locked.
+    std::mutex _block_lock;
+    std::condition_variable _block_cond;
+    std::deque<std::pair<int64_t, std::string>> _blocks;
+    int _num_parsers = 0;
+    bool _split_finished = false;
+    // the block whose chunks are output next
+    int64_t _next_output_block = 0;
+
     // Profile information
     RuntimeProfile::Counter* _wait_scanner_timer = nullptr;
     RuntimeProfile::Counter* _scanner_total_timer = nullptr;
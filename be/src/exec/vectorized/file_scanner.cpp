@@ -4,11 +4,13 @@
 
 #include "column/column_helper.h"
 #include "column/hash_set.h"
+#include "common/config.h"
 #include "env/compressed_file.h"
 #include "env/env.h"
 #include "env/env_broker.h"
 #include "env/env_stream_pipe.h"
 #include "env/env_util.h"
+#include "env/read_ahead_file.h"
 #include "exec/decompressor.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/descriptors.h"
@@ -279,7 +281,16 @@ Status FileScanner::create_sequential_file(const TBrokerRangeDesc& range_desc, c
     using DecompressorPtr = std::shared_ptr<Decompressor>;
     Decompressor* dec = nullptr;
     RETURN_IF_ERROR(Decompressor::create_decompressor(compression, &dec));
-    *file = std::make_shared<CompressedSequentialFile>(std::move(src_file), DecompressorPtr(dec));
+    const int num_buffers = config::streaming_load_read_ahead_buffer_num;
+    if (num_buffers <= 0) {
+        *file = std::make_shared<CompressedSequentialFile>(std::move(src_file), DecompressorPtr(dec));
+        return Status::OK();
+    }
+    // The compressed data is read ahead of the decompression, which is in turn run ahead of the parsing.
+    const size_t buffer_size = config::streaming_load_read_ahead_buffer_size;
+    src_file = std::make_shared<ReadAheadSequentialFile>(std::move(src_file), buffer_size, num_buffers);
+    auto compressed_file = std::make_shared<CompressedSequentialFile>(std::move(src_file), DecompressorPtr(dec));
+    *file = std::make_shared<ReadAheadSequentialFile>(std::move(compressed_file), buffer_size, num_buffers);
     return Status::OK();
 }
 
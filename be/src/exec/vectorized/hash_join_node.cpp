@@ -9,11 +9,18 @@
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
 #include "column/vectorized_fwd.h"
+#include "exec/exchange_node.h"
+#include "exec/pipeline/hashjoin/hash_join_build_operator.h"
+#include "exec/pipeline/hashjoin/hash_join_probe_operator.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "exec/vectorized/hash_joiner.h"
 #include "exprs/expr.h"
 #include "exprs/in_predicate.h"
 #include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
 #include "exprs/vectorized/runtime_filter_bank.h"
+#include "gutil/casts.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/runtime_filter_worker.h"
 #include "simd/simd.h"
@@ -21,7 +28,7 @@
 namespace starrocks::vectorized {
 
 HashJoinNode::HashJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
-        : ExecNode(pool, tnode, descs), _join_type(tnode.hash_join_node.join_op) {
+        : ExecNode(pool, tnode, descs), _tnode(tnode), _join_type(tnode.hash_join_node.join_op) {
     _is_push_down = tnode.hash_join_node.is_push_down;
     if (_join_type == TJoinOp::LEFT_ANTI_JOIN && tnode.hash_join_node.is_rewritten_from_not_in) {
         _join_type = TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN;
@@ -30,6 +37,7 @@ HashJoinNode::HashJoinNode(ObjectPool* pool, const TPlanNode& tnode, const Descr
     if (tnode.hash_join_node.__isset.build_runtime_filters_from_planner) {
         _build_runtime_filters_from_planner = tnode.hash_join_node.build_runtime_filters_from_planner;
     }
+    _adaptive_broadcast = tnode.hash_join_node.__isset.adaptive_broadcast && tnode.hash_join_node.adaptive_broadcast;
 }
 
 Status HashJoinNode::init(const TPlanNode& tnode, RuntimeState* state) {
@@ -96,6 +104,9 @@ Status HashJoinNode::prepare(RuntimeState* state) {
     _push_down_expr_num = ADD_COUNTER(_runtime_profile, "PushDownExprNum", TUnit::UNIT);
     _avg_input_probe_chunk_size = ADD_COUNTER(_runtime_profile, "AvgInputProbeChunkSize", TUnit::UNIT);
     _avg_output_chunk_size = ADD_COUNTER(_runtime_profile, "AvgOutputChunkSize", TUnit::UNIT);
+    _spill_timer = ADD_TIMER(_runtime_profile, "SpillTime");
+    _spill_bytes_counter = ADD_COUNTER(_runtime_profile, "SpillBytes", TUnit::BYTES);
+    _spill_partitions_counter = ADD_COUNTER(_runtime_profile, "SpillPartitions", TUnit::UNIT);
     _runtime_profile->add_info_string("JoinType", _get_join_type_str(_join_type));
 
     RETURN_IF_ERROR(Expr::prepare(_build_expr_ctxs, state, child(1)->row_desc(), expr_mem_tracker()));
@@ -145,6 +156,15 @@ Status HashJoinNode::open(RuntimeState* state) {
         build_timer.start();
     }
 
+    // The null-aware left anti join depends on whether there is any null in all the build rows, so it can't be
+    // joined partition by partition.
+    SpillManager* spill_manager = state->spill_manager();
+    if (config::hash_join_spill_mem_limit_percent > 0 && _join_type != TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN &&
+        spill_manager != nullptr && spill_manager->spill_enabled()) {
+        _spill_manager = spill_manager;
+        _spill_manager->register_spillable(this);
+    }
+
     while (true) {
         ChunkPtr chunk = nullptr;
         bool eos = false;
@@ -163,6 +183,18 @@ Status HashJoinNode::open(RuntimeState* state) {
             }
         }
 
+        if (_spiller == nullptr && _should_spill(chunk)) {
+            _spiller = std::make_unique<HashJoinSpiller>(state->exec_env()->tmp_file_mgr(), state->query_id(),
+                                                         config::hash_join_spill_partitions,
+                                                         _keep_probe_rows_of_empty_build());
+            _spiller->start_partitioning(0);
+            RETURN_IF_ERROR(_spill_hash_table());
+        }
+        if (_spiller != nullptr) {
+            RETURN_IF_ERROR(_spill_build_chunk(chunk));
+            continue;
+        }
+
         if (_ht.get_row_count() + chunk->num_rows() >= UINT32_MAX) {
             return Status::NotSupported(strings::Substitute("row count of right table in hash join > $0", UINT32_MAX));
         }
@@ -173,6 +205,18 @@ Status HashJoinNode::open(RuntimeState* state) {
             RETURN_IF_ERROR(_ht.append_chunk(state, chunk));
         }
     }
+    _relax_probe_partitioning();
+
+    if (_spiller != nullptr) {
+        // The runtime filters need all the build rows, so they aren't published by the spilled join. The merge
+        // nodes of the global runtime filters time out, and the probe side is scanned without the filters.
+        build_timer.stop();
+        RETURN_IF_ERROR(_spill_probe_side(state));
+        bool has_partition = false;
+        RETURN_IF_ERROR(_open_next_spilled_partition(state, &has_partition));
+        _eos = !has_partition;
+        return Status::OK();
+    }
 
     {
         // build hash table: compute key columns, and then build the hash table.
@@ -234,6 +278,21 @@ Status HashJoinNode::open(RuntimeState* state) {
     return Status::OK();
 }
 
+void HashJoinNode::_relax_probe_partitioning() {
+    if (!_adaptive_broadcast || child(0)->type() != TPlanNodeType::EXCHANGE_NODE ||
+        child(1)->type() != TPlanNodeType::EXCHANGE_NODE) {
+        return;
+    }
+    const auto& build_recvr = down_cast<ExchangeNode*>(child(1))->stream_recvr();
+    const auto& probe_recvr = down_cast<ExchangeNode*>(child(0))->stream_recvr();
+    // Every instance of this join receives the same broadcast rows, so the probe rows could be joined by any
+    // of them. The probe rows already sent are still joined correctly.
+    if (build_recvr != nullptr && probe_recvr != nullptr && build_recvr->all_senders_broadcast()) {
+        probe_recvr->set_unpartitioned();
+        _runtime_profile->add_info_string("AdaptiveBroadcast", "true");
+    }
+}
+
 Status HashJoinNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
     return Status::NotSupported("get_next for row_batch is not supported");
 }
@@ -256,48 +315,21 @@ Status HashJoinNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
         return Status::OK();
     }
 
-    *chunk = std::make_shared<Chunk>();
-
-    bool tmp_eos = false;
-    if (!_probe_eos || _ht_has_remain) {
-        RETURN_IF_ERROR(_probe(state, probe_timer, chunk, tmp_eos));
-        if (tmp_eos) {
-            if (_join_type == TJoinOp::RIGHT_OUTER_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
-                _join_type == TJoinOp::FULL_OUTER_JOIN) {
-                // fetch the remain data of hash table
-                RETURN_IF_ERROR(_probe_remain(chunk, tmp_eos));
-                if (tmp_eos) {
-                    _eos = true;
-                    *eos = true;
-                    _final_update_profile();
-                    return Status::OK();
-                }
-            } else {
-                _eos = true;
-                *eos = true;
-                _final_update_profile();
-                return Status::OK();
-            }
+    while (true) {
+        *chunk = std::make_shared<Chunk>();
+        bool join_eos = false;
+        RETURN_IF_ERROR(_join_next_chunk(state, probe_timer, chunk, &join_eos));
+        if (!join_eos) {
+            break;
         }
-    } else {
-        if (!_build_eos) {
-            if (_join_type == TJoinOp::RIGHT_OUTER_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
-                _join_type == TJoinOp::FULL_OUTER_JOIN) {
-                // fetch the remain data of hash table
-                RETURN_IF_ERROR(_probe_remain(chunk, tmp_eos));
-                if (tmp_eos) {
-                    _eos = true;
-                    *eos = true;
-                    _final_update_profile();
-                    return Status::OK();
-                }
-            } else {
-                _eos = true;
-                *eos = true;
-                _final_update_profile();
-                return Status::OK();
-            }
-        } else {
+        // the spilled partitions are joined one by one.
+        bool has_partition = false;
+        if (_spiller != nullptr) {
+            probe_timer.stop();
+            RETURN_IF_ERROR(_open_next_spilled_partition(state, &has_partition));
+            probe_timer.start();
+        }
+        if (!has_partition) {
             _eos = true;
             *eos = true;
             _final_update_profile();
@@ -333,11 +365,40 @@ Status HashJoinNode::close(RuntimeState* state) {
     Expr::close(_probe_expr_ctxs, state);
     Expr::close(_other_join_conjunct_ctxs, state);
 
+    if (_spill_manager != nullptr) {
+        _spill_manager->unregister_spillable(this);
+        _spill_manager = nullptr;
+    }
     _ht.close();
+    _spilled_probe_file.reset();
+    _spiller.reset();
 
     return ExecNode::close(state);
 }
 
+pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    // The build and probe drivers share one hash table, which is built by the build pipeline and
+    // probed by the probe drivers concurrently, each of them with its own probe state.
+    auto builder = std::make_shared<HashJoiner>(_tnode, _row_descriptor, child(1)->row_desc(), child(0)->row_desc());
+    auto join_context = std::make_shared<HashJoinContext>(std::move(builder));
+
+    OpFactories build_operators = child(1)->decompose_to_pipeline(context);
+    build_operators.emplace_back(
+            std::make_shared<HashJoinBuildOperatorFactory>(context->next_operator_id(), id(), join_context));
+    context->add_pipeline(build_operators);
+
+    OpFactories probe_operators = child(0)->decompose_to_pipeline(context);
+    probe_operators.emplace_back(std::make_shared<HashJoinProbeOperatorFactory>(
+            context->next_operator_id(), id(), _tnode, _row_descriptor, child(1)->row_desc(), child(0)->row_desc(),
+            join_context));
+    if (limit() != -1) {
+        probe_operators.emplace_back(
+                std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return probe_operators;
+}
+
 bool HashJoinNode::_has_null(const ColumnPtr& column) {
     if (column->is_nullable()) {
         const auto& null_column = ColumnHelper::as_raw_column<NullableColumn>(column)->null_column();
@@ -375,6 +436,28 @@ Status HashJoinNode::_build(RuntimeState* state) {
     return Status::OK();
 }
 
+Status HashJoinNode::_join_next_chunk(RuntimeState* state, ScopedTimer<MonotonicStopWatch>& probe_timer,
+                                      ChunkPtr* chunk, bool* eos) {
+    const bool output_remain_build_rows = _join_type == TJoinOp::RIGHT_OUTER_JOIN ||
+                                          _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
+                                          _join_type == TJoinOp::FULL_OUTER_JOIN;
+    bool tmp_eos = false;
+    if (!_probe_eos || _ht_has_remain) {
+        RETURN_IF_ERROR(_probe(state, probe_timer, chunk, tmp_eos));
+        if (tmp_eos && output_remain_build_rows) {
+            // fetch the remain data of hash table
+            RETURN_IF_ERROR(_probe_remain(chunk, tmp_eos));
+        }
+    } else if (!_build_eos && output_remain_build_rows) {
+        // fetch the remain data of hash table
+        RETURN_IF_ERROR(_probe_remain(chunk, tmp_eos));
+    } else {
+        tmp_eos = true;
+    }
+    *eos = tmp_eos;
+    return Status::OK();
+}
+
 Status HashJoinNode::_probe(RuntimeState* state, ScopedTimer<MonotonicStopWatch>& probe_timer, ChunkPtr* chunk,
                             bool& eos) {
     while (true) {
@@ -385,7 +468,7 @@ Status HashJoinNode::_probe(RuntimeState* state, ScopedTimer<MonotonicStopWatch>
                     // if current chunk size < vector_chunk_size and pre chunk size + cur chunk size <= 1024, merge the two chunk
                     // if current chunk size < vector_chunk_size and pre chunk size + cur chunk size > 1024, return pre chunk
                     probe_timer.stop();
-                    RETURN_IF_ERROR(child(0)->get_next(state, &_cur_left_input_chunk, &_probe_eos));
+                    RETURN_IF_ERROR(_fetch_probe_chunk(state, &_cur_left_input_chunk, &_probe_eos));
                     probe_timer.start();
                     {
                         SCOPED_TIMER(_merge_input_chunk_timer);
@@ -537,6 +620,187 @@ Status HashJoinNode::_probe_remain(ChunkPtr* chunk, bool& eos) {
     return Status::OK();
 }
 
+Status HashJoinNode::_fetch_probe_chunk(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    if (_spiller == nullptr) {
+        return child(0)->get_next(state, chunk, eos);
+    }
+    *chunk = nullptr;
+    if (_spilled_probe_file != nullptr) {
+        SCOPED_TIMER(_spill_timer);
+        RETURN_IF_ERROR(_spilled_probe_file->read_next(chunk));
+    }
+    *eos = *chunk == nullptr;
+    return Status::OK();
+}
+
+bool HashJoinNode::_should_spill(const ChunkPtr& chunk) {
+    return _spill_manager != nullptr && _spill_manager->should_spill(this, config::hash_join_spill_mem_limit_percent,
+                                                                     chunk->memory_usage());
+}
+
+bool HashJoinNode::_keep_probe_rows_of_empty_build() const {
+    return _join_type == TJoinOp::LEFT_OUTER_JOIN || _join_type == TJoinOp::LEFT_ANTI_JOIN ||
+           _join_type == TJoinOp::FULL_OUTER_JOIN;
+}
+
+void HashJoinNode::_evaluate_join_keys(const std::vector<ExprContext*>& expr_ctxs, Chunk* chunk,
+                                       Columns* key_columns) {
+    key_columns->clear();
+    for (auto* expr_ctx : expr_ctxs) {
+        ColumnPtr column = expr_ctx->evaluate(chunk);
+        key_columns->emplace_back(ColumnHelper::unpack_and_duplicate_const_column(chunk->num_rows(), column));
+    }
+}
+
+Status HashJoinNode::_spill_build_chunk(const ChunkPtr& chunk) {
+    SCOPED_TIMER(_spill_timer);
+    Columns key_columns;
+    _evaluate_join_keys(_build_expr_ctxs, chunk.get(), &key_columns);
+    return _spiller->add_build_chunk(chunk, key_columns);
+}
+
+Status HashJoinNode::_spill_probe_chunk(const ChunkPtr& chunk) {
+    SCOPED_TIMER(_spill_timer);
+    Columns key_columns;
+    _evaluate_join_keys(_probe_expr_ctxs, chunk.get(), &key_columns);
+    return _spiller->add_probe_chunk(chunk, key_columns);
+}
+
+Status HashJoinNode::_spill_hash_table() {
+    const ChunkPtr& build_chunk = _ht.get_build_chunk();
+    const size_t row_count = _ht.get_row_count();
+    // the first row of the build chunk is reserved by the hash table.
+    for (size_t from = 1; from <= row_count; from += config::vector_chunk_size) {
+        const size_t size = std::min<size_t>(config::vector_chunk_size, row_count + 1 - from);
+        ChunkPtr chunk = build_chunk->clone_empty_with_tuple(size);
+        chunk->append(*build_chunk, from, size);
+        RETURN_IF_ERROR(_spill_build_chunk(chunk));
+    }
+    _reset_hash_table();
+    return Status::OK();
+}
+
+Status HashJoinNode::_spill_probe_side(RuntimeState* state) {
+    RETURN_IF_ERROR(_spiller->finish_build());
+    RETURN_IF_ERROR(child(0)->open(state));
+    while (true) {
+        RETURN_IF_CANCELLED(state);
+        ChunkPtr chunk = nullptr;
+        bool eos = false;
+        RETURN_IF_ERROR(child(0)->get_next(state, &chunk, &eos));
+        if (eos) {
+            break;
+        }
+        if (chunk->num_rows() > 0) {
+            RETURN_IF_ERROR(_spill_probe_chunk(chunk));
+        }
+    }
+    return _spiller->finish_probe();
+}
+
+Status HashJoinNode::_load_spilled_build_rows(RuntimeState* state, SpilledJoinPartition* partition,
+                                              bool* repartitioned) {
+    *repartitioned = false;
+    if (partition->build_file == nullptr) {
+        return Status::OK();
+    }
+
+    ChunkPtr chunk = nullptr;
+    while (true) {
+        {
+            SCOPED_TIMER(_spill_timer);
+            RETURN_IF_ERROR(partition->build_file->read_next(&chunk));
+        }
+        if (chunk == nullptr) {
+            return Status::OK();
+        }
+        if (partition->level + 1 < HashJoinSpiller::MAX_LEVELS && _should_spill(chunk)) {
+            break;
+        }
+        if (_ht.get_row_count() + chunk->num_rows() >= UINT32_MAX) {
+            return Status::NotSupported(strings::Substitute("row count of right table in hash join > $0", UINT32_MAX));
+        }
+        SCOPED_TIMER(_copy_right_table_chunk_timer);
+        RETURN_IF_ERROR(_ht.append_chunk(state, chunk));
+    }
+
+    // The partition doesn't fit in memory, partition its rows again.
+    *repartitioned = true;
+    _spiller->start_partitioning(partition->level + 1);
+    RETURN_IF_ERROR(_spill_hash_table());
+    while (chunk != nullptr) {
+        RETURN_IF_ERROR(_spill_build_chunk(chunk));
+        SCOPED_TIMER(_spill_timer);
+        RETURN_IF_ERROR(partition->build_file->read_next(&chunk));
+    }
+    RETURN_IF_ERROR(_spiller->finish_build());
+    if (partition->probe_file != nullptr) {
+        while (true) {
+            {
+                SCOPED_TIMER(_spill_timer);
+                RETURN_IF_ERROR(partition->probe_file->read_next(&chunk));
+            }
+            if (chunk == nullptr) {
+                break;
+            }
+            RETURN_IF_ERROR(_spill_probe_chunk(chunk));
+        }
+    }
+    return _spiller->finish_probe();
+}
+
+Status HashJoinNode::_open_next_spilled_partition(RuntimeState* state, bool* has_partition) {
+    *has_partition = false;
+    _spilled_probe_file.reset();
+    while (_spiller->has_next_partition()) {
+        RETURN_IF_CANCELLED(state);
+        SpilledJoinPartition partition = _spiller->next_partition();
+        // skip the partitions that output nothing.
+        if (partition.probe_file == nullptr && _join_type != TJoinOp::RIGHT_OUTER_JOIN &&
+            _join_type != TJoinOp::RIGHT_ANTI_JOIN && _join_type != TJoinOp::FULL_OUTER_JOIN) {
+            continue;
+        }
+        _reset_hash_table();
+        bool repartitioned = false;
+        RETURN_IF_ERROR(_load_spilled_build_rows(state, &partition, &repartitioned));
+        COUNTER_SET(_spill_bytes_counter, _spiller->spilled_bytes());
+        COUNTER_SET(_spill_partitions_counter, static_cast<int64_t>(_spiller->num_spilled_partitions()));
+        if (repartitioned || (_ht.get_row_count() == 0 && !_keep_probe_rows_of_empty_build())) {
+            continue;
+        }
+
+        {
+            SCOPED_TIMER(_build_timer);
+            RETURN_IF_ERROR(_build(state));
+        }
+        COUNTER_UPDATE(_build_rows_counter, static_cast<int64_t>(_ht.get_row_count()));
+        COUNTER_UPDATE(_build_buckets_counter, static_cast<int64_t>(_ht.get_bucket_size()));
+
+        _spilled_probe_file = std::move(partition.probe_file);
+        _cur_left_input_chunk = nullptr;
+        _pre_left_input_chunk = nullptr;
+        _probing_chunk = nullptr;
+        _ht_has_remain = false;
+        _right_table_has_remain = false;
+        _build_eos = false;
+        _probe_eos = false;
+        *has_partition = true;
+        return Status::OK();
+    }
+    return Status::OK();
+}
+
+void HashJoinNode::_reset_hash_table() {
+    _ht.close();
+    {
+        // the memory of the old hash table is released by its destructor.
+        JoinHashTable old_ht = std::move(_ht);
+    }
+    HashTableParam param;
+    _init_hash_table_param(&param);
+    _ht.create(param);
+}
+
 void HashJoinNode::_calc_filter_for_other_conjunct(ChunkPtr* chunk, Column::Filter& filter, bool& filter_all,
                                                    bool& hit_all) {
     filter_all = false;
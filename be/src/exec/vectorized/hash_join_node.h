@@ -5,6 +5,8 @@
 #include "column/chunk.h"
 #include "column/fixed_length_column.h"
 #include "exec/exec_node.h"
+#include "exec/vectorized/hash_join_spiller.h"
+#include "exec/vectorized/spill_manager.h"
 #include "exec/vectorized/join_hash_map.h"
 #include "util/phmap/phmap.h"
 
@@ -20,7 +22,7 @@ namespace vectorized {
 class ColumnRef;
 class RuntimeFilterBuildDescriptor;
 
-class HashJoinNode : public ExecNode {
+class HashJoinNode : public ExecNode, public Spillable {
 public:
     HashJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
     ~HashJoinNode() override = default;
@@ -32,12 +34,20 @@ public:
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
     Status close(RuntimeState* state) override;
 
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
+
+    int64_t spillable_bytes() const override { return static_cast<int64_t>(_ht.get_memory_usage()); }
+
 private:
     static bool _has_null(const ColumnPtr& column);
 
     void _init_hash_table_param(HashTableParam* param);
     // local join includes: broadcast join and colocate join.
     Status _create_implicit_local_join_runtime_filters(RuntimeState* state);
+    // If all the senders of the build side broadcast their rows, tell the senders of the probe side that
+    // the probe rows needn't be hash partitioned, see THashJoinNode.adaptive_broadcast.
+    void _relax_probe_partitioning();
     void _final_update_profile() {
         if (_probe_chunk_count > 0) {
             COUNTER_SET(_avg_input_probe_chunk_size, int64_t(_probe_rows_counter->value() / _probe_chunk_count));
@@ -51,8 +61,29 @@ private:
         }
     }
     Status _build(RuntimeState* state);
+    // Output the next joined chunk of the hash table, |eos| is set after all of them are output.
+    Status _join_next_chunk(RuntimeState* state, ScopedTimer<MonotonicStopWatch>& probe_timer, ChunkPtr* chunk,
+                            bool* eos);
     Status _probe(RuntimeState* state, ScopedTimer<MonotonicStopWatch>& probe_timer, ChunkPtr* chunk, bool& eos);
     Status _probe_remain(ChunkPtr* chunk, bool& eos);
+    // Read the probe input from the child, or from the spilled partition being joined.
+    Status _fetch_probe_chunk(RuntimeState* state, ChunkPtr* chunk, bool* eos);
+
+    // The grace hash join, see HashJoinSpiller.
+    bool _should_spill(const ChunkPtr& chunk);
+    bool _keep_probe_rows_of_empty_build() const;
+    static void _evaluate_join_keys(const std::vector<ExprContext*>& expr_ctxs, Chunk* chunk, Columns* key_columns);
+    Status _spill_build_chunk(const ChunkPtr& chunk);
+    Status _spill_probe_chunk(const ChunkPtr& chunk);
+    // Move the build rows of the hash table into the partitions of the spiller, and then reset the hash table.
+    Status _spill_hash_table();
+    Status _spill_probe_side(RuntimeState* state);
+    // Load the build rows of |partition| into the hash table, or partition the rows of |partition| again
+    // with the next level if they don't fit in memory.
+    Status _load_spilled_build_rows(RuntimeState* state, SpilledJoinPartition* partition, bool* repartitioned);
+    // Build the hash table of the next spilled partition to join, |has_partition| is false if there is none.
+    Status _open_next_spilled_partition(RuntimeState* state, bool* has_partition);
+    void _reset_hash_table();
 
     void _calc_filter_for_other_conjunct(ChunkPtr* chunk, Column::Filter& filter, bool& filter_all, bool& hit_all);
     static void _process_row_for_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count,
@@ -79,9 +110,11 @@ private:
     std::list<RuntimeFilterBuildDescriptor*> _build_runtime_filters;
     bool _build_runtime_filters_from_planner;
 
+    const TPlanNode _tnode;
     TJoinOp::type _join_type = TJoinOp::INNER_JOIN;
 
     bool _is_push_down = false;
+    bool _adaptive_broadcast = false;
 
     JoinHashTable _ht;
 
@@ -103,6 +136,12 @@ private:
     bool _build_eos = false;
     bool _probe_eos = false; // probe table scan finished;
 
+    // Decides when the hash table is spilled, nullptr if it never spills.
+    SpillManager* _spill_manager = nullptr;
+    std::unique_ptr<HashJoinSpiller> _spiller;
+    // The probe rows of the spilled partition being joined.
+    std::unique_ptr<SpilledChunkFile> _spilled_probe_file;
+
     RuntimeProfile::Counter* _build_timer = nullptr;
     RuntimeProfile::Counter* _build_ht_timer = nullptr;
     RuntimeProfile::Counter* _copy_right_table_chunk_timer = nullptr;
@@ -123,6 +162,9 @@ private:
     RuntimeProfile::Counter* _probe_conjunct_evaluate_timer = nullptr;
     RuntimeProfile::Counter* _other_join_conjunct_evaluate_timer = nullptr;
     RuntimeProfile::Counter* _where_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _spill_partitions_counter = nullptr;
 };
 
 } // namespace vectorized
@@ -0,0 +1,79 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/hash_join_spiller.h"
+
+#include <algorithm>
+
+namespace starrocks::vectorized {
+
+HashJoinSpiller::HashJoinSpiller(TmpFileMgr* tmp_file_mgr, const TUniqueId& query_id, size_t num_partitions,
+                                 bool keep_probe_rows_of_empty_build)
+        : _tmp_file_mgr(tmp_file_mgr),
+          _query_id(query_id),
+          _num_partitions(std::max<size_t>(num_partitions, 2)),
+          _keep_probe_rows_of_empty_build(keep_probe_rows_of_empty_build) {}
+
+HashJoinSpiller::~HashJoinSpiller() = default;
+
+void HashJoinSpiller::start_partitioning(int level) {
+    DCHECK_LT(level, MAX_LEVELS);
+    _level = level;
+    _build_writer = std::make_unique<SpillPartitionWriter>(_tmp_file_mgr, _query_id, _num_partitions, level);
+    _probe_writer = std::make_unique<SpillPartitionWriter>(_tmp_file_mgr, _query_id, _num_partitions, level);
+    _discarded_partitions.clear();
+}
+
+Status HashJoinSpiller::add_build_chunk(const ChunkPtr& chunk, const Columns& key_columns) {
+    return _build_writer->add_chunk(chunk, key_columns, _discarded_partitions);
+}
+
+Status HashJoinSpiller::finish_build() {
+    RETURN_IF_ERROR(_build_writer->finish());
+    if (!_keep_probe_rows_of_empty_build) {
+        const auto& build_files = _build_writer->files();
+        _discarded_partitions.resize(_num_partitions);
+        for (size_t i = 0; i < _num_partitions; ++i) {
+            _discarded_partitions[i] = build_files[i] == nullptr;
+        }
+    }
+    return Status::OK();
+}
+
+Status HashJoinSpiller::add_probe_chunk(const ChunkPtr& chunk, const Columns& key_columns) {
+    return _probe_writer->add_chunk(chunk, key_columns, _discarded_partitions);
+}
+
+Status HashJoinSpiller::finish_probe() {
+    RETURN_IF_ERROR(_probe_writer->finish());
+    auto& build_files = _build_writer->files();
+    auto& probe_files = _probe_writer->files();
+    for (size_t i = 0; i < _num_partitions; ++i) {
+        if (build_files[i] == nullptr && probe_files[i] == nullptr) {
+            continue;
+        }
+        SpilledJoinPartition partition;
+        partition.level = _level;
+        partition.build_file = std::move(build_files[i]);
+        partition.probe_file = std::move(probe_files[i]);
+        if (partition.build_file != nullptr) {
+            _spilled_bytes += partition.build_file->num_bytes();
+        }
+        if (partition.probe_file != nullptr) {
+            _spilled_bytes += partition.probe_file->num_bytes();
+        }
+        ++_num_spilled_partitions;
+        _partitions.emplace_back(std::move(partition));
+    }
+    _build_writer.reset();
+    _probe_writer.reset();
+    return Status::OK();
+}
+
+SpilledJoinPartition HashJoinSpiller::next_partition() {
+    DCHECK(!_partitions.empty());
+    SpilledJoinPartition partition = std::move(_partitions.back());
+    _partitions.pop_back();
+    return partition;
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,73 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "exec/vectorized/chunk_spiller.h"
+#include "runtime/tmp_file_mgr.h"
+
+namespace starrocks::vectorized {
+
+// A partition of the rows of a spilled hash join, whose build rows and probe rows have the same hash values
+// of the join keys at each level of partitioning. The file is nullptr if the side has no rows.
+struct SpilledJoinPartition {
+    int level = 0;
+    std::unique_ptr<SpilledChunkFile> build_file;
+    std::unique_ptr<SpilledChunkFile> probe_file;
+};
+
+// HashJoinSpiller partitions the build rows and the probe rows of a hash join whose hash table doesn't fit in
+// memory into the temporary files, so that the partitions are joined one by one (grace hash join).
+// Level 0 partitions all the input rows of the join, level n partitions again the rows of a partition of
+// level n - 1 whose build rows still don't fit in memory, with another hash function.
+class HashJoinSpiller {
+public:
+    // The rows whose keys have the same hash value can't be partitioned further, so the partition of the last
+    // level is always joined in memory.
+    static constexpr int MAX_LEVELS = 4;
+
+    // If |keep_probe_rows_of_empty_build| is false, the probe rows of the partitions without build rows are
+    // discarded, which is only valid if the join outputs nothing for the unmatched probe rows.
+    HashJoinSpiller(TmpFileMgr* tmp_file_mgr, const TUniqueId& query_id, size_t num_partitions,
+                    bool keep_probe_rows_of_empty_build);
+    ~HashJoinSpiller();
+
+    // Start to partition the rows of |level|, all the build rows must be added before the probe rows.
+    // The chunks could have more columns than the first added chunk of the same side, which are discarded.
+    void start_partitioning(int level);
+    // |key_columns| are the join keys of |chunk| without const columns.
+    Status add_build_chunk(const ChunkPtr& chunk, const Columns& key_columns);
+    Status finish_build();
+    Status add_probe_chunk(const ChunkPtr& chunk, const Columns& key_columns);
+    // The partitions of the level are ready to join after this.
+    Status finish_probe();
+
+    bool has_next_partition() const { return !_partitions.empty(); }
+    // The partitions of a deeper level are joined first, which bounds the disk usage.
+    SpilledJoinPartition next_partition();
+
+    int64_t spilled_bytes() const { return _spilled_bytes; }
+    size_t num_spilled_partitions() const { return _num_spilled_partitions; }
+
+private:
+    TmpFileMgr* const _tmp_file_mgr;
+    const TUniqueId _query_id;
+    const size_t _num_partitions;
+    const bool _keep_probe_rows_of_empty_build;
+
+    int _level = 0;
+    std::unique_ptr<SpillPartitionWriter> _build_writer;
+    std::unique_ptr<SpillPartitionWriter> _probe_writer;
+    // The partitions of the level whose probe rows are discarded, empty if none.
+    std::vector<uint8_t> _discarded_partitions;
+    std::vector<SpilledJoinPartition> _partitions;
+
+    int64_t _spilled_bytes = 0;
+    size_t _num_spilled_partitions = 0;
+};
+
+} // namespace starrocks::vectorized
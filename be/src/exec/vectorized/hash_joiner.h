@@ -0,0 +1,131 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <list>
+
+#include "column/chunk.h"
+#include "common/statusor.h"
+#include "exec/vectorized/join_hash_map.h"
+#include "exprs/expr.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::vectorized {
+
+class RuntimeFilterBuildDescriptor;
+
+class HashJoiner;
+using HashJoinerPtr = std::shared_ptr<HashJoiner>;
+
+// HashJoiner holds the hash table and the expressions of one hash join instance, it's used by the
+// pipeline hash join operators. The hash table is built by one HashJoiner, and the HashJoiners
+// of the probe drivers reference it read-only, each of them keeps its own probe state.
+class HashJoiner {
+public:
+    HashJoiner(const TPlanNode& tnode, const RowDescriptor& row_desc, const RowDescriptor& build_row_desc,
+               const RowDescriptor& probe_row_desc);
+    ~HashJoiner() = default;
+
+    Status prepare(RuntimeState* state, RuntimeProfile* runtime_profile, MemTracker* mem_tracker);
+    void close(RuntimeState* state);
+
+    TJoinOp::type join_type() const { return _join_type; }
+
+    // For the build side.
+    Status append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk);
+    // Evaluate the build keys and build the hash table after all the build chunks are appended.
+    Status build_ht(RuntimeState* state);
+    // Build and publish the runtime filters of the planner, even if the hash table is empty.
+    Status publish_runtime_filters(RuntimeState* state);
+    // Whether the probe side outputs nothing whatever its input is, e.g. inner join with an empty right table.
+    // Only valid after build_ht().
+    bool is_probe_short_circuited() const { return _is_probe_short_circuited; }
+
+    // For the probe side.
+    // Probe the hash table built by the builder, the builder must outlive this HashJoiner.
+    void reference_hash_table(HashJoiner* builder);
+    bool has_pending_probe_chunk() const { return _probing_chunk != nullptr; }
+    Status push_probe_chunk(RuntimeState* state, const ChunkPtr& chunk);
+    // Return an empty chunk if the pending probe chunk produces nothing.
+    StatusOr<ChunkPtr> pull_probe_chunk(RuntimeState* state);
+
+    // Right outer/semi/anti and full outer join output the build rows according to whether they are
+    // matched, after all the probe drivers are finished.
+    bool need_output_remain() const {
+        return _join_type == TJoinOp::RIGHT_OUTER_JOIN || _join_type == TJoinOp::RIGHT_SEMI_JOIN ||
+               _join_type == TJoinOp::RIGHT_ANTI_JOIN || _join_type == TJoinOp::FULL_OUTER_JOIN;
+    }
+    const Buffer<uint8_t>& build_match_index() const { return _ht.get_build_match_index(); }
+    // Called by the last finished probe driver with the build rows matched by all the probe drivers,
+    // then the remaining build rows are output by pull_remain_chunk().
+    void prepare_remain_output(const Buffer<uint8_t>& build_match_index);
+    bool has_remain_output() const { return !_build_eos; }
+    StatusOr<ChunkPtr> pull_remain_chunk(RuntimeState* state);
+
+private:
+    static bool _has_null(const ColumnPtr& column);
+
+    void _init_hash_table_param(HashTableParam* param);
+
+    void _calc_filter_for_other_conjunct(ChunkPtr* chunk, Column::Filter& filter, bool& filter_all, bool& hit_all);
+    static void _process_row_for_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count,
+                                                bool filter_all, bool hit_all, const Column::Filter& filter);
+
+    void _process_outer_join_with_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count);
+    void _process_semi_join_with_other_conjunct(ChunkPtr* chunk);
+    void _process_right_anti_join_with_other_conjunct(ChunkPtr* chunk);
+    void _process_other_conjunct(ChunkPtr* chunk);
+
+    const TPlanNode _tnode;
+    const RowDescriptor& _row_descriptor;
+    const RowDescriptor& _build_row_descriptor;
+    const RowDescriptor& _probe_row_descriptor;
+
+    TJoinOp::type _join_type = TJoinOp::INNER_JOIN;
+    MemTracker* _mem_tracker = nullptr;
+
+    std::vector<ExprContext*> _probe_expr_ctxs;
+    std::vector<ExprContext*> _build_expr_ctxs;
+    std::vector<ExprContext*> _other_join_conjunct_ctxs;
+    std::vector<ExprContext*> _conjunct_ctxs;
+    std::vector<bool> _is_null_safes;
+
+    std::list<RuntimeFilterBuildDescriptor*> _build_runtime_filters;
+
+    JoinHashTable _ht;
+    bool _is_probe_short_circuited = false;
+
+    ChunkPtr _probing_chunk = nullptr;
+    Columns _key_columns;
+    size_t _probe_column_count = 0;
+    size_t _build_column_count = 0;
+
+    // hash table doesn't have reserved data
+    bool _ht_has_remain = false;
+    // right table have not output data for right outer join/right semi join/right anti join/full outer join
+    bool _right_table_has_remain = true;
+    bool _build_eos = false;
+
+    RuntimeProfile::Counter* _build_timer = nullptr;
+    RuntimeProfile::Counter* _build_ht_timer = nullptr;
+    RuntimeProfile::Counter* _copy_right_table_chunk_timer = nullptr;
+    RuntimeProfile::Counter* _build_push_down_expr_timer = nullptr;
+    RuntimeProfile::Counter* _build_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _probe_timer = nullptr;
+    RuntimeProfile::Counter* _search_ht_timer = nullptr;
+    RuntimeProfile::Counter* _output_build_column_timer = nullptr;
+    RuntimeProfile::Counter* _output_probe_column_timer = nullptr;
+    RuntimeProfile::Counter* _output_tuple_column_timer = nullptr;
+    RuntimeProfile::Counter* _probe_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _other_join_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _where_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _build_rows_counter = nullptr;
+    RuntimeProfile::Counter* _probe_rows_counter = nullptr;
+    RuntimeProfile::Counter* _build_buckets_counter = nullptr;
+    RuntimeProfile::Counter* _push_down_expr_num = nullptr;
+};
+
+} // namespace starrocks::vectorized
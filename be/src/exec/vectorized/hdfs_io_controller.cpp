@@ -0,0 +1,81 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/hdfs_io_controller.h"
+
+#include <algorithm>
+
+#include "util/priority_thread_pool.hpp"
+#include "util/stopwatch.hpp"
+
+namespace starrocks::vectorized {
+
+HdfsIOController::HdfsIOController(PriorityThreadPool* thread_pool, int64_t max_buffered_bytes, int max_concurrency)
+        : _thread_pool(thread_pool),
+          _max_buffered_bytes(max_buffered_bytes),
+          _max_concurrency(std::max(max_concurrency, 1)) {
+    _concurrency = std::min(_concurrency, _max_concurrency);
+}
+
+bool HdfsIOController::try_submit(int64_t bytes, std::function<void()> read) {
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_running_reads >= _concurrency || _buffered_bytes + bytes > _max_buffered_bytes) {
+            return false;
+        }
+        _running_reads++;
+        _buffered_bytes += bytes;
+    }
+
+    PriorityThreadPool::Task task;
+    task.work_function = [self = shared_from_this(), bytes, read = std::move(read)] {
+        MonotonicStopWatch watch;
+        watch.start();
+        read();
+        {
+            std::lock_guard<std::mutex> l(self->_mutex);
+            self->_running_reads--;
+        }
+        self->update_concurrency(bytes, watch.elapsed_time());
+    };
+    if (_thread_pool->try_offer(task)) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> l(_mutex);
+    _running_reads--;
+    _buffered_bytes -= bytes;
+    return false;
+}
+
+void HdfsIOController::release(int64_t bytes) {
+    std::lock_guard<std::mutex> l(_mutex);
+    _buffered_bytes -= bytes;
+}
+
+int HdfsIOController::concurrency() const {
+    std::lock_guard<std::mutex> l(_mutex);
+    return _concurrency;
+}
+
+int64_t HdfsIOController::buffered_bytes() const {
+    std::lock_guard<std::mutex> l(_mutex);
+    return _buffered_bytes;
+}
+
+void HdfsIOController::update_concurrency(int64_t bytes, int64_t latency_ns) {
+    std::lock_guard<std::mutex> l(_mutex);
+    double latency_per_byte = static_cast<double>(latency_ns) / std::max<int64_t>(bytes, 1);
+    if (_min_latency_per_byte == 0 || latency_per_byte < _min_latency_per_byte) {
+        _min_latency_per_byte = latency_per_byte;
+    } else {
+        _min_latency_per_byte *= 1 + kMinLatencyDecay;
+    }
+
+    if (latency_per_byte <= _min_latency_per_byte * kGrowRatio) {
+        _concurrency = std::min(_concurrency + 1, _max_concurrency);
+    } else if (latency_per_byte > _min_latency_per_byte * kShrinkRatio) {
+        _concurrency = std::max(_concurrency / 2, 1);
+    }
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,61 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace starrocks {
+class PriorityThreadPool;
+}
+
+namespace starrocks::vectorized {
+
+// HdfsIOController runs the reads ahead of the hdfs scanners of one scan node on the hdfs io thread pool, so the
+// scanner threads decode the current data while the next data is read, instead of blocking on the remote reads.
+// The bytes read ahead and not consumed yet are bounded, and the number of the reads running at the same time
+// adapts to their latency: it grows while the latency per byte stays near the lowest one seen recently, and it
+// halves when the latency rises far above it, which means the storage is saturated.
+// It must be created by std::make_shared, the reads running hold it until they finish.
+class HdfsIOController : public std::enable_shared_from_this<HdfsIOController> {
+public:
+    static constexpr int kInitialConcurrency = 2;
+
+    HdfsIOController(PriorityThreadPool* thread_pool, int64_t max_buffered_bytes, int max_concurrency);
+
+    // Run |read| on the thread pool if there are fewer reads running than the concurrency and |bytes| more bytes
+    // fit in the buffer, the bytes are held until release is called. Returns false if |read| isn't submitted.
+    bool try_submit(int64_t bytes, std::function<void()> read);
+
+    // Release the bytes of a submitted read after the data read is consumed.
+    void release(int64_t bytes);
+
+    int concurrency() const;
+    int64_t buffered_bytes() const;
+
+    // Update the concurrency by the latency of a read finished, it's public for test.
+    void update_concurrency(int64_t bytes, int64_t latency_ns);
+
+private:
+    // The concurrency grows if the latency per byte is at most kGrowRatio times the lowest one, and halves
+    // if it's more than kShrinkRatio times the lowest one.
+    static constexpr double kGrowRatio = 2;
+    static constexpr double kShrinkRatio = 4;
+    // The lowest latency per byte increases by this ratio on each read, so it follows the storage when it
+    // becomes slower.
+    static constexpr double kMinLatencyDecay = 1.0 / 64;
+
+    PriorityThreadPool* _thread_pool;
+    const int64_t _max_buffered_bytes;
+    const int _max_concurrency;
+
+    mutable std::mutex _mutex;
+    int64_t _buffered_bytes = 0;
+    int _running_reads = 0;
+    int _concurrency = kInitialConcurrency;
+    double _min_latency_per_byte = 0;
+};
+
+} // namespace starrocks::vectorized
@@ -4,16 +4,19 @@
 
 #include <memory>
 
+#include "env/block_cache.h"
 #include "env/env_hdfs.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
 #include "exprs/vectorized/runtime_filter.h"
 #include "runtime/exec_env.h"
+#include "runtime/hdfs/hdfs_file_cache.h"
 #include "runtime/hdfs/hdfs_fs_cache.h"
 #include "runtime/raw_value.h"
 #include "runtime/runtime_state.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "util/priority_thread_pool.hpp"
+#include "util/work_stealing_priority_thread_pool.h"
 
 namespace starrocks::vectorized {
 HdfsScanNode::HdfsScanNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
@@ -77,6 +80,12 @@ Status HdfsScanNode::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(Expr::prepare(_partition_conjunct_ctxs, state, row_desc(), expr_mem_tracker()));
     _init_counter(state);
 
+    if (config::hdfs_scan_prefetch_max_bytes > 0) {
+        _io_controller = std::make_shared<HdfsIOController>(state->exec_env()->hdfs_io_thread_pool(),
+                                                            config::hdfs_scan_prefetch_max_bytes,
+                                                            config::hdfs_io_thread_pool_thread_num);
+    }
+
     _runtime_state = state;
     return Status::OK();
 }
@@ -140,7 +149,16 @@ Status HdfsScanNode::_start_scan_thread(RuntimeState* state) {
         if (hdfs_file->file_length == 0) {
             continue;
         }
-        RETURN_IF_ERROR(_create_and_init_scanner(state, *hdfs_file));
+        int64_t unit_size = config::hdfs_orc_scan_unit_size;
+        if (hdfs_file->hdfs_file_format == THdfsFileFormat::ORC && unit_size > 0) {
+            // the stripes of a large orc file are read by several scanners in parallel, each of them reads the
+            // stripes starting in its range, and the file tail is shared by the file meta cache.
+            for (const auto* scan_range : _split_scan_ranges(hdfs_file->splits, unit_size)) {
+                RETURN_IF_ERROR(_create_and_init_scanner(state, *hdfs_file, {scan_range}));
+            }
+        } else {
+            RETURN_IF_ERROR(_create_and_init_scanner(state, *hdfs_file, hdfs_file->splits));
+        }
     }
 
     // init chunk pool
@@ -162,10 +180,29 @@ Status HdfsScanNode::_start_scan_thread(RuntimeState* state) {
     return Status::OK();
 }
 
-Status HdfsScanNode::_create_and_init_scanner(RuntimeState* state, const HdfsFileDesc& hdfs_file_desc) {
+std::vector<const THdfsScanRange*> HdfsScanNode::_split_scan_ranges(
+        const std::vector<const THdfsScanRange*>& scan_ranges, int64_t unit_size) {
+    std::vector<const THdfsScanRange*> units;
+    for (const auto* scan_range : scan_ranges) {
+        if (scan_range->length <= unit_size) {
+            units.emplace_back(scan_range);
+            continue;
+        }
+        for (int64_t offset = 0; offset < scan_range->length; offset += unit_size) {
+            auto* unit = _pool->add(new THdfsScanRange(*scan_range));
+            unit->__set_offset(scan_range->offset + offset);
+            unit->__set_length(std::min(unit_size, scan_range->length - offset));
+            units.emplace_back(unit);
+        }
+    }
+    return units;
+}
+
+Status HdfsScanNode::_create_and_init_scanner(RuntimeState* state, const HdfsFileDesc& hdfs_file_desc,
+                                              const std::vector<const THdfsScanRange*>& scan_ranges) {
     HdfsScannerParams scanner_params;
     scanner_params.runtime_filter_collector = &_runtime_filter_collector;
-    scanner_params.scan_ranges = hdfs_file_desc.splits;
+    scanner_params.scan_ranges = scan_ranges;
     scanner_params.fs = hdfs_file_desc.fs;
     scanner_params.tuple_desc = _tuple_desc;
     scanner_params.materialize_slots = _materialize_slots;
@@ -179,6 +216,7 @@ Status HdfsScanNode::_create_and_init_scanner(RuntimeState* state, const HdfsFil
     scanner_params.min_max_conjunct_ctxs = _min_max_conjunct_ctxs;
     scanner_params.min_max_tuple_desc = _min_max_tuple_desc;
     scanner_params.hive_column_names = &_hive_column_names;
+    scanner_params.io_controller = _io_controller.get();
     scanner_params.parent = this;
 
     HdfsScanner* scanner = nullptr;
@@ -347,7 +385,7 @@ void HdfsScanNode::_fill_chunk_pool(int count) {
     std::lock_guard<std::mutex> l(_mtx);
 
     for (int i = 0; i < count; i++) {
-        auto chunk = ChunkHelper::new_chunk(*_tuple_desc, config::vector_chunk_size);
+        ChunkPtr chunk(ChunkHelper::new_chunk_pooled(_tuple_desc->slots(), config::vector_chunk_size, true));
         _chunk_pool.push(std::move(chunk));
     }
 }
@@ -425,14 +463,16 @@ Status HdfsScanNode::close(RuntimeState* state) {
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 
+    // the pending scanners may be reading ahead, close them before the files.
+    _close_pending_scanners();
+
     for (auto* hdfsFile : _hdfs_files) {
         if (hdfsFile->hdfs_fs != nullptr && hdfsFile->hdfs_file != nullptr) {
-            hdfsCloseFile(hdfsFile->hdfs_fs, hdfsFile->hdfs_file);
+            HdfsFileCache::instance()->release(hdfsFile->hdfs_fs, hdfsFile->native_path, hdfsFile->modification_time,
+                                               hdfsFile->hdfs_file);
         }
     }
 
-    _close_pending_scanners();
-
     Expr::close(_min_max_conjunct_ctxs, state);
     Expr::close(_partition_conjunct_ctxs, state);
 
@@ -545,15 +585,21 @@ Status HdfsScanNode::_find_and_insert_hdfs_file(const THdfsScanRange& scan_range
     } else {
         hdfsFS hdfs;
         RETURN_IF_ERROR(HdfsFsCache::instance()->get_connection(namenode, &hdfs));
-        auto* file = hdfsOpenFile(hdfs, native_file_path.c_str(), O_RDONLY, 0, 0, 0);
-        if (file == nullptr) {
-            return Status::InternalError(strings::Substitute("open file failed, file=$0", native_file_path));
-        }
+        const int64_t mtime = scan_range.__isset.modification_time ? scan_range.modification_time : -1;
+        hdfsFile file;
+        RETURN_IF_ERROR(HdfsFileCache::instance()->open(hdfs, native_file_path, mtime, &file));
 
         auto* hdfs_file_desc = _pool->add(new HdfsFileDesc());
         hdfs_file_desc->hdfs_fs = hdfs;
         hdfs_file_desc->hdfs_file = file;
+        hdfs_file_desc->native_path = native_file_path;
+        hdfs_file_desc->modification_time = mtime;
         hdfs_file_desc->fs = std::make_shared<HdfsRandomAccessFile>(hdfs, file, native_file_path);
+        // the blocks are cached only if the version of the file is known.
+        if (BlockCache::instance() != nullptr && scan_range.__isset.modification_time) {
+            hdfs_file_desc->fs = std::make_shared<CachedRandomAccessFile>(
+                    BlockCache::instance(), hdfs_file_desc->fs, scan_range.modification_time, scan_range.file_length);
+        }
         hdfs_file_desc->partition_id = scan_range.partition_id;
         hdfs_file_desc->path = scan_range.relative_path;
         hdfs_file_desc->file_length = scan_range.file_length;
@@ -620,6 +666,7 @@ void HdfsScanNode::_init_counter(RuntimeState* state) {
     _bytes_read_short_circuit = ADD_COUNTER(_runtime_profile, "BytesReadShortCircuit", TUnit::BYTES);
     _bytes_read_dn_cache = ADD_COUNTER(_runtime_profile, "BytesReadDataNodeCache", TUnit::BYTES);
     _bytes_read_remote = ADD_COUNTER(_runtime_profile, "BytesReadRemote", TUnit::BYTES);
+    _bytes_read_block_cache = ADD_COUNTER(_runtime_profile, "BytesReadBlockCache", TUnit::BYTES);
 
     // reader init
     _footer_read_timer = ADD_TIMER(_runtime_profile, "ReaderInitFooterRead");
@@ -6,6 +6,7 @@
 
 #include "env/env.h"
 #include "exec/scan_node.h"
+#include "exec/vectorized/hdfs_io_controller.h"
 #include "exec/vectorized/hdfs_scanner.h"
 #include "exec/vectorized/hdfs_scanner_orc.h"
 #include "hdfs/hdfs.h"
@@ -15,7 +16,10 @@ namespace starrocks::vectorized {
 
 struct HdfsFileDesc {
     hdfsFS hdfs_fs;
+    // taken from HdfsFileCache, and given back once the scan node is closed.
     hdfsFile hdfs_file;
+    std::string native_path;
+    int64_t modification_time = -1;
     THdfsFileFormat::type hdfs_file_format;
     std::shared_ptr<RandomAccessFile> fs = nullptr;
 
@@ -78,7 +82,11 @@ private:
     void _init_partition_expr_map();
     bool _filter_partition(const std::vector<ExprContext*>& partition_exprs);
     Status _find_and_insert_hdfs_file(const THdfsScanRange& scan_range);
-    Status _create_and_init_scanner(RuntimeState* state, const HdfsFileDesc& hdfs_file_desc);
+    Status _create_and_init_scanner(RuntimeState* state, const HdfsFileDesc& hdfs_file_desc,
+                                    const std::vector<const THdfsScanRange*>& scan_ranges);
+    // Split the scan ranges longer than |unit_size| into the ranges of |unit_size|.
+    std::vector<const THdfsScanRange*> _split_scan_ranges(const std::vector<const THdfsScanRange*>& scan_ranges,
+                                                          int64_t unit_size);
 
     bool _submit_scanner(HdfsScanner* scanner, bool blockable);
     void _scanner_thread(HdfsScanner* scanner);
@@ -151,6 +159,9 @@ private:
 
     UnboundedBlockingQueue<ChunkPtr> _result_chunks;
 
+    // reads the next row groups ahead for the scanners, null if disabled.
+    std::shared_ptr<HdfsIOController> _io_controller;
+
     RuntimeProfile::Counter* _scan_timer = nullptr;
     RuntimeProfile::Counter* _reader_init_timer = nullptr;
     RuntimeProfile::Counter* _open_file_timer = nullptr;
@@ -171,6 +182,7 @@ private:
     RuntimeProfile::Counter* _bytes_read_short_circuit = nullptr;
     RuntimeProfile::Counter* _bytes_read_dn_cache = nullptr;
     RuntimeProfile::Counter* _bytes_read_remote = nullptr;
+    RuntimeProfile::Counter* _bytes_read_block_cache = nullptr;
 
     // reader init
     RuntimeProfile::Counter* _footer_read_timer = nullptr;
@@ -6,6 +6,7 @@
 
 #include <memory>
 
+#include "env/block_cache.h"
 #include "env/env_hdfs.h"
 #include "exec/exec_node.h"
 #include "exec/parquet/file_reader.h"
@@ -92,6 +93,7 @@ void HdfsScanner::_build_file_read_param() {
     param.min_max_tuple_desc = _scanner_params.min_max_tuple_desc;
     param.timezone = _runtime_state->timezone();
     param.stats = &_stats;
+    param.io_controller = _scanner_params.io_controller;
 }
 
 Status HdfsScanner::get_next(RuntimeState* runtime_state, ChunkPtr* chunk) {
@@ -169,7 +171,13 @@ static void get_hdfs_statistics(hdfsFile file, HdfsReadStats* stats) {
 void HdfsScanner::update_counter() {
 #ifndef BE_TEST
     HdfsReadStats hdfs_stats;
-    auto hdfs_file = down_cast<HdfsRandomAccessFile*>(_scanner_params.fs.get())->hdfs_file();
+    RandomAccessFile* file = _scanner_params.fs.get();
+    if (auto* cached_file = dynamic_cast<CachedRandomAccessFile*>(file); cached_file != nullptr) {
+        COUNTER_UPDATE(_scanner_params.parent->_bytes_read_block_cache, cached_file->cached_read_bytes());
+        cached_file->clear_read_statistics();
+        file = cached_file->underlying_file();
+    }
+    auto hdfs_file = down_cast<HdfsRandomAccessFile*>(file)->hdfs_file();
     get_hdfs_statistics(hdfs_file, &hdfs_stats);
 
     COUNTER_UPDATE(_scanner_params.parent->_bytes_total_read, hdfs_stats.bytes_total_read);
@@ -14,6 +14,7 @@ class FileReader;
 }
 namespace starrocks::vectorized {
 
+class HdfsIOController;
 class HdfsScanNode;
 class RuntimeFilterProbeCollector;
 
@@ -76,6 +77,9 @@ struct HdfsScannerParams {
 
     std::vector<std::string>* hive_column_names;
 
+    // reads ahead for the scanners of the scan node, null if they don't read ahead.
+    HdfsIOController* io_controller = nullptr;
+
     HdfsScanNode* parent = nullptr;
 };
 
@@ -113,6 +117,8 @@ struct HdfsFileReaderParam {
 
     vectorized::HdfsScanStats* stats = nullptr;
 
+    HdfsIOController* io_controller = nullptr;
+
     // set column names from file.
     // and to update not_existed slots and conjuncts.
     // and to update `conjunct_ctxs_by_slot` field.
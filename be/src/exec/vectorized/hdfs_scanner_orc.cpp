@@ -3,6 +3,7 @@
 #include "exec/vectorized/hdfs_scanner_orc.h"
 
 #include "env/env.h"
+#include "exec/vectorized/file_meta_cache.h"
 #include "exec/vectorized/hdfs_scan_node.h"
 #include "gen_cpp/orc_proto.pb.h"
 #include "storage/vectorized/chunk_helper.h"
@@ -300,17 +301,37 @@ void HdfsOrcScanner::update_counter() {
 }
 
 Status HdfsParquetScanner::do_close(RuntimeState* runtime_state) {
+    // wait for the reads ahead, which may use the file closed after the scanner.
+    _reader.reset();
     update_counter();
     return Status::OK();
 }
 
 Status HdfsOrcScanner::do_open(RuntimeState* runtime_state) {
-    auto input_stream = std::make_unique<ORCHdfsFileStream>(_scanner_params.fs,
-                                                            _scanner_params.scan_ranges[0]->file_length, &_stats);
+    const THdfsScanRange* scan_range = _scanner_params.scan_ranges[0];
+    auto input_stream = std::make_unique<ORCHdfsFileStream>(_scanner_params.fs, scan_range->file_length, &_stats);
+    // the serialized file tail is cached only if the modification time is known, which identifies the file version.
+    auto* cache = FileMetaCache::instance();
+    std::string cache_key;
+    std::shared_ptr<const std::string> file_tail;
+    if (cache != nullptr && scan_range->__isset.modification_time) {
+        cache_key = FileMetaCache::make_key("orc", input_stream->getName(), scan_range->file_length,
+                                            scan_range->modification_time);
+        file_tail = cache->lookup<std::string>(cache_key);
+    }
     std::unique_ptr<orc::Reader> reader;
     try {
         orc::ReaderOptions options;
+        if (file_tail != nullptr) {
+            // the tail isn't read from the file again.
+            options.setSerializedFileTail(*file_tail);
+        }
         reader = orc::createReader(std::move(input_stream), options);
+        if (file_tail == nullptr && !cache_key.empty()) {
+            auto tail = std::make_shared<const std::string>(reader->getSerializedFileTail());
+            size_t charge = tail->size();
+            cache->insert(cache_key, std::move(tail), charge);
+        }
     } catch (std::exception& e) {
         auto s = strings::Substitute("HdfsOrcScanner::do_open failed. reason = $0", e.what());
         LOG(WARNING) << s;
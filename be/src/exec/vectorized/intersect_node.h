@@ -24,6 +24,9 @@ class TupleDescriptor;
 
 namespace starrocks::vectorized {
 class IntersectNode : public ExecNode {
+public:
+    // The hash set of the serialized keys, which is also built and probed by the pipeline operators, see
+    // pipeline::IntersectContext.
     class SliceFlag {
     public:
         SliceFlag(const uint8_t* d, size_t n) : slice(d, n), hit_times(0) {}
@@ -181,7 +184,8 @@ class IntersectNode : public ExecNode {
         ResultVector _results;
     };
 
-public:
+    using HashSerializeSet = HashSetFromExprs<phmap::flat_hash_set<SliceFlag, SliceFlagHash, SliceFlagEqual>>;
+
     IntersectNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
 
     Status init(const TPlanNode& tnode, RuntimeState* state) override;
@@ -191,11 +195,16 @@ public:
     Status get_next(RuntimeState* state, ChunkPtr* row_batch, bool* eos) override;
     Status close(RuntimeState* state) override;
 
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
+
 private:
     /// Tuple id resolved in Prepare() to set tuple_desc_;
     const int _tuple_id;
     /// Descriptor for tuples this union node constructs.
     const TupleDescriptor* _tuple_desc;
+    // The result expr lists of the children are created again by the pipeline operators.
+    const TPlanNode _tnode;
     // Exprs materialized by this node. The i-th result expr list refers to the i-th child.
     std::vector<std::vector<ExprContext*>> _child_expr_lists;
 
@@ -207,7 +216,6 @@ private:
     std::vector<IntersectColumnTypes> _types;
     size_t _intersect_times = 0;
 
-    using HashSerializeSet = HashSetFromExprs<phmap::flat_hash_set<SliceFlag, SliceFlagHash, SliceFlagEqual>>;
     std::unique_ptr<HashSerializeSet> _hash_set;
     HashSerializeSet::Iterator _hash_set_iterator;
 
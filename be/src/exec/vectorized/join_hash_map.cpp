@@ -6,6 +6,11 @@
 #include <gen_cpp/PlanNodes_types.h>
 #include <runtime/descriptors.h>
 
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "exec/vectorized/hash_join_node.h"
 #include "simd/simd.h"
 
@@ -91,8 +96,7 @@ void SerializedJoinBuildFunc::_build_columns(JoinHashTableItems* table_items, Ha
     }
 
     for (size_t i = 0; i < count; i++) {
-        table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-        table_items->first[probe_state->buckets[i]] = start + i;
+        JoinHashMapHelper::insert_build_row(table_items, probe_state->buckets[i], start + i);
     }
 }
 
@@ -119,8 +123,7 @@ void SerializedJoinBuildFunc::_build_nullable_columns(JoinHashTableItems* table_
 
     for (size_t i = 0; i < count; i++) {
         if (probe_state->is_nulls[i] == 0) {
-            table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-            table_items->first[probe_state->buckets[i]] = start + i;
+            JoinHashMapHelper::insert_build_row(table_items, probe_state->buckets[i], start + i);
         }
     }
 }
@@ -149,7 +152,7 @@ Status SerializedJoinProbeFunc::lookup_init(const JoinHashTableItems& table_item
     for (const auto& data_column : data_columns) {
         serialize_size += data_column->serialize_size();
     }
-    uint8_t* ptr = table_items.probe_pool->allocate(serialize_size);
+    uint8_t* ptr = probe_state->probe_pool->allocate(serialize_size);
     if (UNLIKELY(ptr == nullptr)) {
         return Status::InternalError("Mem usage has exceed the limit of BE");
     }
@@ -174,9 +177,7 @@ void SerializedJoinProbeFunc::_probe_column(const JoinHashTableItems& table_item
         ptr += probe_state->probe_slice[i].size;
     }
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_chain_heads(table_items, probe_state, row_count, nullptr);
 }
 
 void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& table_items,
@@ -204,64 +205,75 @@ void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& t
         if (probe_state->is_nulls[i] == 0) {
             probe_state->buckets[i] =
                     JoinHashMapHelper::calc_bucket_num<Slice>(probe_state->probe_slice[i], table_items.bucket_size);
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
         } else {
-            probe_state->next[i] = 0;
+            // keep the bucket valid to be prefetched.
+            probe_state->buckets[i] = 0;
         }
     }
+    JoinHashMapHelper::lookup_chain_heads(table_items, probe_state, row_count, probe_state->is_nulls.data());
 }
 
 JoinHashTable::~JoinHashTable() {
-    _table_items.mem_tracker->release(_table_items.last_memory_usage);
+    if (_table_items != nullptr && !_is_readable_clone) {
+        _table_items->mem_tracker->release(_table_items->last_memory_usage);
+    }
 }
 
 void JoinHashTable::close() {
-    _table_items.build_pool.reset();
-    _table_items.probe_pool.reset();
+    if (_table_items == nullptr) {
+        return;
+    }
+    if (!_is_readable_clone) {
+        _table_items->build_pool.reset();
+    }
+    _probe_state->probe_pool.reset();
 }
 
 void JoinHashTable::create(const HashTableParam& param) {
-    _table_items.row_count = 0;
-    _table_items.bucket_size = 0;
-    _table_items.build_chunk = std::make_shared<Chunk>();
-    _table_items.mem_tracker = param.mem_tracker;
-    _table_items.build_pool = std::make_unique<MemPool>(_table_items.mem_tracker);
-    _table_items.probe_pool = std::make_unique<MemPool>(_table_items.mem_tracker);
-    _table_items.with_other_conjunct = param.with_other_conjunct;
-    _table_items.join_type = param.join_type;
-    _table_items.row_desc = param.row_desc;
-    if (_table_items.join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items.join_type == TJoinOp::RIGHT_ANTI_JOIN ||
-        _table_items.join_type == TJoinOp::RIGHT_OUTER_JOIN) {
-        _table_items.left_to_nullable = true;
-    } else if (_table_items.join_type == TJoinOp::LEFT_SEMI_JOIN || _table_items.join_type == TJoinOp::LEFT_ANTI_JOIN ||
-               _table_items.join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN ||
-               _table_items.join_type == TJoinOp::LEFT_OUTER_JOIN) {
-        _table_items.right_to_nullable = true;
-    } else if (_table_items.join_type == TJoinOp::FULL_OUTER_JOIN) {
-        _table_items.left_to_nullable = true;
-        _table_items.right_to_nullable = true;
-    }
-    _table_items.search_ht_timer = param.search_ht_timer;
-    _table_items.output_build_column_timer = param.output_build_column_timer;
-    _table_items.output_probe_column_timer = param.output_probe_column_timer;
-    _table_items.output_tuple_column_timer = param.output_tuple_column_timer;
-    _table_items.join_keys = param.join_keys;
+    _table_items = std::make_shared<JoinHashTableItems>();
+    _probe_state = std::make_unique<HashTableProbeState>();
+    _table_items->row_count = 0;
+    _table_items->bucket_size = 0;
+    _table_items->build_chunk = std::make_shared<Chunk>();
+    _table_items->mem_tracker = param.mem_tracker;
+    _table_items->build_pool = std::make_unique<MemPool>(_table_items->mem_tracker);
+    _probe_state->probe_pool = std::make_unique<MemPool>(_table_items->mem_tracker);
+    _table_items->with_other_conjunct = param.with_other_conjunct;
+    _table_items->join_type = param.join_type;
+    _table_items->row_desc = param.row_desc;
+    if (_table_items->join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items->join_type == TJoinOp::RIGHT_ANTI_JOIN ||
+        _table_items->join_type == TJoinOp::RIGHT_OUTER_JOIN) {
+        _table_items->left_to_nullable = true;
+    } else if (_table_items->join_type == TJoinOp::LEFT_SEMI_JOIN ||
+               _table_items->join_type == TJoinOp::LEFT_ANTI_JOIN ||
+               _table_items->join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN ||
+               _table_items->join_type == TJoinOp::LEFT_OUTER_JOIN) {
+        _table_items->right_to_nullable = true;
+    } else if (_table_items->join_type == TJoinOp::FULL_OUTER_JOIN) {
+        _table_items->left_to_nullable = true;
+        _table_items->right_to_nullable = true;
+    }
+    _table_items->search_ht_timer = param.search_ht_timer;
+    _table_items->output_build_column_timer = param.output_build_column_timer;
+    _table_items->output_probe_column_timer = param.output_probe_column_timer;
+    _table_items->output_tuple_column_timer = param.output_tuple_column_timer;
+    _table_items->join_keys = param.join_keys;
 
     const auto& probe_desc = *param.probe_row_desc;
     for (const auto& tuple_desc : probe_desc.tuple_descriptors()) {
         for (const auto& slot : tuple_desc->slots()) {
-            _table_items.probe_slots.emplace_back(slot);
-            _table_items.probe_column_count++;
+            _table_items->probe_slots.emplace_back(slot);
+            _table_items->probe_column_count++;
         }
-        if (_table_items.row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
-            _table_items.output_probe_tuple_ids.emplace_back(tuple_desc->id());
+        if (_table_items->row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+            _table_items->output_probe_tuple_ids.emplace_back(tuple_desc->id());
         }
     }
 
     const auto& build_desc = *param.build_row_desc;
     for (const auto& tuple_desc : build_desc.tuple_descriptors()) {
         for (const auto& slot : tuple_desc->slots()) {
-            _table_items.build_slots.emplace_back(slot);
+            _table_items->build_slots.emplace_back(slot);
             ColumnPtr column = ColumnHelper::create_column(slot->type(), slot->is_nullable());
             if (slot->is_nullable()) {
                 auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(column);
@@ -269,39 +281,111 @@ void JoinHashTable::create(const HashTableParam& param) {
             } else {
                 column->append_default();
             }
-            _table_items.build_chunk->append_column(std::move(column), slot->id());
-            _table_items.build_column_count++;
+            _table_items->build_chunk->append_column(std::move(column), slot->id());
+            _table_items->build_column_count++;
+        }
+        if (_table_items->row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+            _table_items->output_build_tuple_ids.emplace_back(tuple_desc->id());
+        }
+    }
+}
+
+Status JoinHashMapHelper::radix_partition_build_rows(RuntimeState* state, JoinHashTableItems* table_items) {
+    const uint32_t row_count = table_items->row_count;
+    const uint32_t num_partitions = table_items->num_radix_partitions;
+    const uint32_t partition_shift = __builtin_ctz(table_items->bucket_size) - __builtin_ctz(num_partitions);
+    const auto& buckets = table_items->build_buckets;
+
+    // Counting sort of the build rows by partitions, the rows with null keys are put at the end. The sort is
+    // stable, so the chains are in the same order as the ones built without partitions.
+    std::vector<uint32_t> offsets(num_partitions + 2, 0);
+    for (uint32_t i = 1; i < row_count + 1; i++) {
+        uint32_t partition = buckets[i] == NULL_BUCKET ? num_partitions : buckets[i] >> partition_shift;
+        offsets[partition + 1]++;
+    }
+    for (uint32_t i = 1; i < offsets.size(); i++) {
+        offsets[i] += offsets[i - 1];
+    }
+    // order[new_row] = old_row, and the reserved row 0 stays.
+    Buffer<uint32_t> order(row_count + 1);
+    order[0] = 0;
+    for (uint32_t i = 1; i < row_count + 1; i++) {
+        uint32_t partition = buckets[i] == NULL_BUCKET ? num_partitions : buckets[i] >> partition_shift;
+        order[1 + offsets[partition]++] = i;
+    }
+    RETURN_IF_ERROR(check_and_add_memory_usage(state, table_items, order.size() * sizeof(uint32_t)));
+
+    // Reorder the build columns and the keys. A key column may be a column of the build chunk, so the
+    // reordered columns are shared in the same way.
+    std::unordered_map<const Column*, ColumnPtr> reordered_columns;
+    auto reorder_column = [&](ColumnPtr* column) {
+        auto it = reordered_columns.find(column->get());
+        if (it == reordered_columns.end()) {
+            ColumnPtr new_column = (*column)->clone_empty();
+            new_column->append_selective(**column, order.data(), 0, order.size());
+            it = reordered_columns.emplace(column->get(), std::move(new_column)).first;
+        }
+        *column = it->second;
+    };
+    for (auto& column : table_items->build_chunk->columns()) {
+        reorder_column(&column);
+    }
+    for (auto& column : table_items->key_columns) {
+        reorder_column(&column);
+    }
+    if (table_items->build_key_column != nullptr) {
+        reorder_column(&table_items->build_key_column);
+    }
+    if (!table_items->build_slice.empty()) {
+        Buffer<Slice> build_slice(table_items->build_slice.size());
+        for (uint32_t i = 0; i < order.size(); i++) {
+            build_slice[i] = table_items->build_slice[order[i]];
         }
-        if (_table_items.row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
-            _table_items.output_build_tuple_ids.emplace_back(tuple_desc->id());
+        table_items->build_slice.swap(build_slice);
+    }
+
+    // The rows are inserted partition by partition, so the buckets written at a time are in a cache-sized region.
+    for (uint32_t i = 1; i < row_count + 1; i++) {
+        uint32_t bucket_num = buckets[order[i]];
+        if (bucket_num != NULL_BUCKET) {
+            table_items->next[i] = table_items->first[bucket_num];
+            table_items->first[bucket_num] = i;
         }
     }
+    Buffer<uint32_t>().swap(table_items->build_buckets);
+    return Status::OK();
 }
 
 Status JoinHashTable::build(RuntimeState* state) {
     _hash_map_type = _choose_join_hash_map();
-    _table_items.bucket_size = JoinHashMapHelper::calc_bucket_size(_table_items.row_count + 1);
-    _table_items.first.resize(_table_items.bucket_size, 0);
-    _table_items.next.resize(_table_items.row_count + 1, 0);
-    if (_table_items.join_type == TJoinOp::RIGHT_OUTER_JOIN || _table_items.join_type == TJoinOp::FULL_OUTER_JOIN ||
-        _table_items.join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items.join_type == TJoinOp::RIGHT_ANTI_JOIN) {
-        _probe_state.build_match_index.resize(_table_items.row_count + 1, 0);
-        _probe_state.build_match_index[0] = 1;
+    if (_hash_map_type == JoinHashMapType::direct_mapping32 || _hash_map_type == JoinHashMapType::direct_mapping64) {
+        // the bucket size is decided by the range of the keys, and the buckets are dense already.
+        _table_items->num_radix_partitions = 1;
+    } else {
+        _table_items->bucket_size = JoinHashMapHelper::calc_bucket_size(_table_items->row_count + 1);
+        _table_items->num_radix_partitions =
+                JoinHashMapHelper::calc_num_radix_partitions(_table_items->row_count, _table_items->bucket_size);
     }
-
-    JoinHashMapHelper::prepare_map_index(&_probe_state);
+    _table_items->first.resize(_table_items->bucket_size, 0);
+    _table_items->next.resize(_table_items->row_count + 1, 0);
+    if (_table_items->num_radix_partitions > 1) {
+        _table_items->build_buckets.resize(_table_items->row_count + 1, JoinHashMapHelper::NULL_BUCKET);
+    }
+    _prepare_probe_state();
 
     // size of hashtable index
     RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(
-            state, &_table_items, (_table_items.first.size() + _table_items.row_count + 1) * sizeof(uint32_t)));
+            state, _table_items.get(),
+            (_table_items->first.size() + _table_items->row_count + 1 + _table_items->build_buckets.size()) *
+                    sizeof(uint32_t)));
 
     switch (_hash_map_type) {
     case JoinHashMapType::empty:
         break;
-#define M(NAME)                                                                                             \
-    case JoinHashMapType::NAME:                                                                             \
-        _##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(&_table_items, &_probe_state); \
-        RETURN_IF_ERROR(_##NAME->build(state));                                                             \
+#define M(NAME)                                                                                                    \
+    case JoinHashMapType::NAME:                                                                                    \
+        _##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(_table_items.get(), _probe_state.get()); \
+        RETURN_IF_ERROR(_##NAME->build(state));                                                                    \
         break;
         APPLY_FOR_JOIN_VARIANTS(M)
 #undef M
@@ -309,9 +393,85 @@ Status JoinHashTable::build(RuntimeState* state) {
         return Status::InternalError("not supported");
     }
 
+    if (JoinHashMapHelper::is_key_only_build(*_table_items)) {
+        _release_build_payload_columns();
+    }
     return Status::OK();
 }
 
+void JoinHashTable::_release_build_payload_columns() {
+    // The build columns of the slot refs are the key columns too, which are kept.
+    std::unordered_set<const Column*> key_columns;
+    for (const auto& key_column : _table_items->key_columns) {
+        key_columns.insert(key_column.get());
+    }
+    size_t released = 0;
+    Columns& columns = _table_items->build_chunk->columns();
+    for (size_t i = 0; i < _table_items->build_column_count; i++) {
+        if (key_columns.count(columns[i].get()) == 0) {
+            released += columns[i]->memory_usage();
+            columns[i] = columns[i]->clone_empty();
+        }
+    }
+    released = std::min<size_t>(released, _table_items->last_memory_usage);
+    _table_items->mem_tracker->release(released);
+    _table_items->last_memory_usage -= released;
+}
+
+void JoinHashTable::_prepare_probe_state() {
+    if (_table_items->join_type == TJoinOp::RIGHT_OUTER_JOIN || _table_items->join_type == TJoinOp::FULL_OUTER_JOIN ||
+        _table_items->join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items->join_type == TJoinOp::RIGHT_ANTI_JOIN) {
+        _probe_state->build_match_index.resize(_table_items->row_count + 1, 0);
+        _probe_state->build_match_index[0] = 1;
+    }
+
+    JoinHashMapHelper::prepare_map_index(_probe_state.get());
+}
+
+JoinHashTable JoinHashTable::clone_readable_table() {
+    JoinHashTable ht;
+    ht._hash_map_type = _hash_map_type;
+    ht._table_items = _table_items;
+    ht._is_readable_clone = true;
+
+    ht._probe_state = std::make_unique<HashTableProbeState>();
+    ht._probe_state->probe_pool = std::make_unique<MemPool>(_table_items->mem_tracker);
+    // buckets and is_nulls are allocated by build() for the original hash table.
+    ht._probe_state->buckets.resize(config::vector_chunk_size);
+    ht._probe_state->is_nulls.resize(config::vector_chunk_size);
+    ht._prepare_probe_state();
+
+    switch (_hash_map_type) {
+    case JoinHashMapType::empty:
+        break;
+#define M(NAME)                                                                                            \
+    case JoinHashMapType::NAME:                                                                            \
+        ht._##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(ht._table_items.get(),     \
+                                                                                  ht._probe_state.get()); \
+        break;
+        APPLY_FOR_JOIN_VARIANTS(M)
+#undef M
+    }
+
+    return ht;
+}
+
+void JoinHashTable::merge_build_match_index(const Buffer<uint8_t>& build_match_index) {
+    auto& dest = _probe_state->build_match_index;
+    DCHECK_EQ(dest.size(), build_match_index.size());
+    for (size_t i = 0; i < dest.size(); i++) {
+        dest[i] |= build_match_index[i];
+    }
+}
+
+void JoinHashTable::flip_build_match_index() {
+    auto& build_match_index = _probe_state->build_match_index;
+    // the first row is reserved, keep it as matched.
+    for (size_t i = 1; i < build_match_index.size(); i++) {
+        build_match_index[i] = !build_match_index[i];
+    }
+}
+
 Status JoinHashTable::probe(const Columns& key_columns, ChunkPtr* probe_chunk, ChunkPtr* chunk, bool* eos) {
     switch (_hash_map_type) {
     case JoinHashMapType::empty:
@@ -345,14 +505,20 @@ Status JoinHashTable::probe_remain(ChunkPtr* chunk, bool* eos) {
 }
 
 Status JoinHashTable::append_chunk(RuntimeState* state, const ChunkPtr& chunk) {
-    Columns& columns = _table_items.build_chunk->columns();
+    Columns& columns = _table_items->build_chunk->columns();
     size_t chunk_memory_size = 0;
 
-    for (size_t i = 0; i < _table_items.build_column_count; i++) {
-        SlotDescriptor* slot = _table_items.build_slots[i];
+    for (size_t i = 0; i < _table_items->build_column_count; i++) {
+        SlotDescriptor* slot = _table_items->build_slots[i];
         ColumnPtr& column = chunk->get_column_by_slot_id(slot->id());
         chunk_memory_size += column->memory_usage();
 
+        // all the build rows are kept in one chunk, whose string columns are limited to 4GB of bytes.
+        if (UNLIKELY(columns[i]->capacity_limit_reached_on_append(*column))) {
+            return Status::NotSupported("The build side of hash join has more than 4GB of data in column " +
+                                        slot->col_name());
+        }
+
         if (columns[i]->is_nullable()) {
             columns[i]->append(*column, 0, chunk->num_rows());
         } else if (column->is_nullable()) {
@@ -366,30 +532,30 @@ Status JoinHashTable::append_chunk(RuntimeState* state, const ChunkPtr& chunk) {
 
     const auto& tuple_id_map = chunk->get_tuple_id_to_index_map();
     for (auto iter = tuple_id_map.begin(); iter != tuple_id_map.end(); iter++) {
-        if (_table_items.row_desc->get_tuple_idx(iter->first) != RowDescriptor::INVALID_IDX) {
-            if (_table_items.build_chunk->is_tuple_exist(iter->first)) {
+        if (_table_items->row_desc->get_tuple_idx(iter->first) != RowDescriptor::INVALID_IDX) {
+            if (_table_items->build_chunk->is_tuple_exist(iter->first)) {
                 ColumnPtr& src_column = chunk->get_tuple_column_by_id(iter->first);
-                ColumnPtr& dest_column = _table_items.build_chunk->get_tuple_column_by_id(iter->first);
+                ColumnPtr& dest_column = _table_items->build_chunk->get_tuple_column_by_id(iter->first);
                 dest_column->append(*src_column, 0, src_column->size());
                 chunk_memory_size += src_column->memory_usage();
             } else {
                 ColumnPtr& src_column = chunk->get_tuple_column_by_id(iter->first);
-                ColumnPtr dest_column = BooleanColumn::create(_table_items.row_count + 1, 1);
+                ColumnPtr dest_column = BooleanColumn::create(_table_items->row_count + 1, 1);
                 dest_column->append(*src_column, 0, src_column->size());
-                _table_items.build_chunk->append_tuple_column(dest_column, iter->first);
+                _table_items->build_chunk->append_tuple_column(dest_column, iter->first);
                 chunk_memory_size += src_column->memory_usage();
             }
         }
     }
 
-    RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(state, &_table_items, chunk_memory_size));
+    RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(state, _table_items.get(), chunk_memory_size));
 
-    _table_items.row_count += chunk->num_rows();
+    _table_items->row_count += chunk->num_rows();
     return Status::OK();
 }
 
 void JoinHashTable::remove_duplicate_index(Column::Filter* filter) {
-    switch (_table_items.join_type) {
+    switch (_table_items->join_type) {
     case TJoinOp::LEFT_OUTER_JOIN:
         _remove_duplicate_index_for_left_outer_join(filter);
         break;
@@ -417,18 +583,54 @@ void JoinHashTable::remove_duplicate_index(Column::Filter* filter) {
     }
 }
 
+template <PrimitiveType PT>
+bool JoinHashTable::_try_direct_mapping() {
+    const uint32_t row_count = _table_items->row_count;
+    if (config::join_hash_table_direct_mapping_max_ratio <= 0 || row_count == 0) {
+        return false;
+    }
+    const auto& data = JoinBuildFunc<PT>::get_key_data(*_table_items);
+    const ColumnPtr& key_column = _table_items->key_columns[0];
+    const uint8_t* is_null = nullptr;
+    if (key_column->is_nullable() && key_column->has_null()) {
+        is_null = ColumnHelper::as_raw_column<NullableColumn>(key_column)->null_column()->get_data().data();
+    }
+    // the row 0 is reserved.
+    int64_t min = std::numeric_limits<int64_t>::max();
+    int64_t max = std::numeric_limits<int64_t>::min();
+    for (uint32_t i = 1; i < row_count + 1; i++) {
+        if (is_null == nullptr || is_null[i] == 0) {
+            min = std::min<int64_t>(min, data[i]);
+            max = std::max<int64_t>(max, data[i]);
+        }
+    }
+    if (min > max) {
+        // all the keys are null.
+        return false;
+    }
+    // max - min may overflow int64_t.
+    uint64_t range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+    uint64_t limit = static_cast<uint64_t>(config::join_hash_table_direct_mapping_max_ratio) * row_count;
+    if (range >= limit || range + 2 > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+    _table_items->direct_mapping_min = min;
+    _table_items->bucket_size = static_cast<uint32_t>(range + 2);
+    return true;
+}
+
 JoinHashMapType JoinHashTable::_choose_join_hash_map() {
-    size_t size = _table_items.join_keys.size();
+    size_t size = _table_items->join_keys.size();
     DCHECK_GT(size, 0);
 
-    for (size_t i = 0; i < _table_items.join_keys.size(); i++) {
-        if (!_table_items.key_columns[i]->has_null()) {
-            _table_items.join_keys[i].is_null_safe_equal = false;
+    for (size_t i = 0; i < _table_items->join_keys.size(); i++) {
+        if (!_table_items->key_columns[i]->has_null()) {
+            _table_items->join_keys[i].is_null_safe_equal = false;
         }
     }
 
-    if (size == 1 && !_table_items.join_keys[0].is_null_safe_equal) {
-        switch (_table_items.join_keys[0].type) {
+    if (size == 1 && !_table_items->join_keys[0].is_null_safe_equal) {
+        switch (_table_items->join_keys[0].type) {
         case PrimitiveType::TYPE_BOOLEAN:
             return JoinHashMapType::keyboolean;
         case PrimitiveType::TYPE_TINYINT:
@@ -436,9 +638,9 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
         case PrimitiveType::TYPE_SMALLINT:
             return JoinHashMapType::key16;
         case PrimitiveType::TYPE_INT:
-            return JoinHashMapType::key32;
+            return _try_direct_mapping<TYPE_INT>() ? JoinHashMapType::direct_mapping32 : JoinHashMapType::key32;
         case PrimitiveType::TYPE_BIGINT:
-            return JoinHashMapType::key64;
+            return _try_direct_mapping<TYPE_BIGINT>() ? JoinHashMapType::direct_mapping64 : JoinHashMapType::key64;
         case PrimitiveType::TYPE_LARGEINT:
             return JoinHashMapType::key128;
         case PrimitiveType::TYPE_FLOAT:
@@ -469,7 +671,7 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
 
     size_t total_size_in_byte = 0;
 
-    for (auto& join_key : _table_items.join_keys) {
+    for (auto& join_key : _table_items->join_keys) {
         if (join_key.is_null_safe_equal) {
             total_size_in_byte += 1;
         }
@@ -525,12 +727,12 @@ void JoinHashTable::_remove_duplicate_index_for_left_outer_join(Column::Filter*
     size_t row_count = filter->size();
 
     for (size_t i = 0; i < row_count; i++) {
-        if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 0) {
+        if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 0) {
             (*filter)[i] = 1;
             continue;
         }
 
-        if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 1) {
+        if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 1) {
             if ((*filter)[i] == 0) {
                 (*filter)[i] = 1;
             }
@@ -538,7 +740,7 @@ void JoinHashTable::_remove_duplicate_index_for_left_outer_join(Column::Filter*
         }
 
         if ((*filter)[i] == 0) {
-            _probe_state.probe_match_index[_probe_state.probe_index[i]]--;
+            _probe_state->probe_match_index[_probe_state->probe_index[i]]--;
         }
     }
 }
@@ -547,8 +749,8 @@ void JoinHashTable::_remove_duplicate_index_for_left_semi_join(Column::Filter* f
     size_t row_count = filter->size();
     for (size_t i = 0; i < row_count; i++) {
         if ((*filter)[i] == 1) {
-            if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 0) {
-                _probe_state.probe_match_index[_probe_state.probe_index[i]] = 1;
+            if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 0) {
+                _probe_state->probe_match_index[_probe_state->probe_index[i]] = 1;
             } else {
                 (*filter)[i] = 0;
             }
@@ -559,13 +761,13 @@ void JoinHashTable::_remove_duplicate_index_for_left_semi_join(Column::Filter* f
 void JoinHashTable::_remove_duplicate_index_for_left_anti_join(Column::Filter* filter) {
     size_t row_count = filter->size();
     for (size_t i = 0; i < row_count; i++) {
-        if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 0) {
+        if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 0) {
             (*filter)[i] = 1;
-        } else if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 1) {
-            _probe_state.probe_match_index[_probe_state.probe_index[i]]--;
+        } else if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 1) {
+            _probe_state->probe_match_index[_probe_state->probe_index[i]]--;
             (*filter)[i] = !(*filter)[i];
         } else if ((*filter)[i] == 0) {
-            _probe_state.probe_match_index[_probe_state.probe_index[i]]--;
+            _probe_state->probe_match_index[_probe_state->probe_index[i]]--;
         } else {
             (*filter)[i] = 0;
         }
@@ -576,7 +778,7 @@ void JoinHashTable::_remove_duplicate_index_for_right_outer_join(Column::Filter*
     size_t row_count = filter->size();
     for (size_t i = 0; i < row_count; i++) {
         if ((*filter)[i] == 1) {
-            _probe_state.build_match_index[_probe_state.build_index[i]] = 1;
+            _probe_state->build_match_index[_probe_state->build_index[i]] = 1;
         }
     }
 }
@@ -585,8 +787,8 @@ void JoinHashTable::_remove_duplicate_index_for_right_semi_join(Column::Filter*
     size_t row_count = filter->size();
     for (size_t i = 0; i < row_count; i++) {
         if ((*filter)[i] == 1) {
-            if (_probe_state.build_match_index[_probe_state.build_index[i]] == 0) {
-                _probe_state.build_match_index[_probe_state.build_index[i]] = 1;
+            if (_probe_state->build_match_index[_probe_state->build_index[i]] == 0) {
+                _probe_state->build_match_index[_probe_state->build_index[i]] = 1;
             } else {
                 (*filter)[i] = 0;
             }
@@ -598,7 +800,7 @@ void JoinHashTable::_remove_duplicate_index_for_right_anti_join(Column::Filter*
     size_t row_count = filter->size();
     for (size_t i = 0; i < row_count; i++) {
         if ((*filter)[i] == 1) {
-            _probe_state.build_match_index[_probe_state.build_index[i]] = 1;
+            _probe_state->build_match_index[_probe_state->build_index[i]] = 1;
         }
     }
 }
@@ -606,24 +808,24 @@ void JoinHashTable::_remove_duplicate_index_for_right_anti_join(Column::Filter*
 void JoinHashTable::_remove_duplicate_index_for_full_outer_join(Column::Filter* filter) {
     size_t row_count = filter->size();
     for (size_t i = 0; i < row_count; i++) {
-        if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 0) {
+        if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 0) {
             (*filter)[i] = 1;
             continue;
         }
 
-        if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 1) {
+        if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 1) {
             if ((*filter)[i] == 0) {
                 (*filter)[i] = 1;
             } else {
-                _probe_state.build_match_index[_probe_state.build_index[i]] = 1;
+                _probe_state->build_match_index[_probe_state->build_index[i]] = 1;
             }
             continue;
         }
 
         if ((*filter)[i] == 0) {
-            _probe_state.probe_match_index[_probe_state.probe_index[i]]--;
+            _probe_state->probe_match_index[_probe_state->probe_index[i]]--;
         } else {
-            _probe_state.build_match_index[_probe_state.build_index[i]] = 1;
+            _probe_state->build_match_index[_probe_state->build_index[i]] = 1;
         }
     }
 }
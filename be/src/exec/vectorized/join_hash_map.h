@@ -9,6 +9,7 @@
 #include "column/chunk.h"
 #include "column/column_hash.h"
 #include "column/column_helper.h"
+#include "common/compiler_util.h"
 #include "runtime/mem_tracker.h"
 #include "util/phmap/phmap.h"
 
@@ -33,7 +34,9 @@ namespace starrocks::vectorized {
     M(slice)                       \
     M(fixed32)                     \
     M(fixed64)                     \
-    M(fixed128)
+    M(fixed128)                    \
+    M(direct_mapping32)            \
+    M(direct_mapping64)
 
 enum class JoinHashMapType {
     empty,
@@ -54,8 +57,10 @@ enum class JoinHashMapType {
     keydecimal128,
     slice,
     fixed32, // 4 bytes
-    fixed64, // 8 bytes
-    fixed128 // 16 bytes
+    fixed64,          // 8 bytes
+    fixed128,         // 16 bytes
+    direct_mapping32, // int, dense
+    direct_mapping64  // bigint, dense
 };
 
 enum class JoinMatchFlag { NORMAL, ALL_NOT_MATCH, ALL_MATCH_ONE, MOST_MATCH_ONE };
@@ -83,9 +88,18 @@ struct JoinHashTableItems {
     // about the bucket-chained hash table of this kind.
     Buffer<uint32_t> first;
     Buffer<uint32_t> next;
+    // In the radix-partitioned build, the buckets are divided into num_radix_partitions partitions by their
+    // high bits, the build rows are reordered by the partitions of their buckets before they're inserted
+    // into the bucket chains, so all the rows of a partition are contiguous. build_buckets saves the bucket
+    // of each build row until the rows are inserted, NULL_BUCKET for the rows with null keys.
+    uint32_t num_radix_partitions = 1;
+    Buffer<uint32_t> build_buckets;
     Buffer<Slice> build_slice;
     ColumnPtr build_key_column;
     uint32_t bucket_size = 0;
+    // In the direct-mapped hash table, the bucket of a key is key - direct_mapping_min + 1, and bucket 0 is
+    // the empty bucket of the probe keys out of the range of the build keys.
+    int64_t direct_mapping_min = 0;
     uint32_t row_count = 0; // real row count
     size_t build_column_count = 0;
     size_t probe_column_count = 0;
@@ -97,7 +111,6 @@ struct JoinHashTableItems {
 
     MemTracker* mem_tracker = nullptr;
     std::unique_ptr<MemPool> build_pool = nullptr;
-    std::unique_ptr<MemPool> probe_pool = nullptr;
     uint64_t last_memory_usage = 0;
     std::vector<JoinKeyDesc> join_keys;
 
@@ -143,6 +156,10 @@ struct HashTableProbeState {
     // cur_probe_index records the position of the last probe
     uint32_t cur_probe_index = 0;
     uint32_t cur_row_match_count = 0;
+
+    // holds the serialized probe keys, it's owned by the probe state so that
+    // the readable clones of one hash table could be probed concurrently.
+    std::unique_ptr<MemPool> probe_pool = nullptr;
 };
 
 struct HashTableParam {
@@ -222,6 +239,88 @@ public:
         }
     }
 
+    // The bucket of a key in the direct-mapped hash table, whose buckets are [1, bucket_size) for the keys in
+    // [min, min + bucket_size - 1).
+    template <typename CppType>
+    static uint32_t calc_direct_mapping_bucket_num(const CppType& value, int64_t min, uint32_t bucket_size) {
+        // wraps around for the keys less than min.
+        uint64_t offset = static_cast<uint64_t>(static_cast<int64_t>(value)) - static_cast<uint64_t>(min);
+        return offset < bucket_size - 1 ? static_cast<uint32_t>(offset) + 1 : 0;
+    }
+
+    static constexpr uint32_t NULL_BUCKET = UINT32_MAX;
+    // The number of buckets of a radix partition, whose buckets, chains and keys fit in L2 cache.
+    static constexpr uint32_t RADIX_PARTITION_BUCKETS = 8192;
+
+    static uint32_t calc_num_radix_partitions(uint32_t row_count, uint32_t bucket_size) {
+        if (config::join_hash_table_radix_partition_min_rows <= 0 ||
+            row_count < config::join_hash_table_radix_partition_min_rows || bucket_size <= RADIX_PARTITION_BUCKETS) {
+            return 1;
+        }
+        // both are powers of 2.
+        return bucket_size / RADIX_PARTITION_BUCKETS;
+    }
+
+    // Insert the build row into the chain of the bucket, or save the bucket in the radix-partitioned build.
+    static void insert_build_row(JoinHashTableItems* table_items, uint32_t bucket_num, uint32_t row) {
+        if (table_items->num_radix_partitions > 1) {
+            table_items->build_buckets[row] = bucket_num;
+            return;
+        }
+        table_items->next[row] = table_items->first[bucket_num];
+        table_items->first[bucket_num] = row;
+    }
+
+    // Reorder the build rows by the partitions of their buckets, and insert them into the bucket chains.
+    static Status radix_partition_build_rows(RuntimeState* state, JoinHashTableItems* table_items);
+
+    // The left semi and anti joins without other join conjuncts only test whether a probe key exists in the build
+    // keys, so the chains keep one row of every distinct key, and the build columns which aren't keys are dropped.
+    static bool is_key_only_build(const JoinHashTableItems& table_items) {
+        return (table_items.join_type == TJoinOp::LEFT_SEMI_JOIN || table_items.join_type == TJoinOp::LEFT_ANTI_JOIN) &&
+               !table_items.with_other_conjunct;
+    }
+
+    // The distance of the software prefetch of the buckets when the chains of a probe chunk are looked up.
+    static constexpr uint32_t PREFETCH_DISTANCE = 16;
+    // The buckets and the build keys aren't prefetched for a small hash table, which is likely in cache.
+    static constexpr uint32_t PREFETCH_MIN_BUCKETS = 65536;
+
+    // Gather the heads of the bucket chains of the probe rows whose buckets are calculated, the rows with
+    // is_nulls[i] != 0 have no chains if is_nulls isn't nullptr.
+    static void lookup_chain_heads(const JoinHashTableItems& table_items, HashTableProbeState* probe_state,
+                                   uint32_t row_count, const uint8_t* is_nulls) {
+        const uint32_t* first = table_items.first.data();
+        const uint32_t* buckets = probe_state->buckets.data();
+        uint32_t* heads = probe_state->next.data();
+        if (table_items.bucket_size < PREFETCH_MIN_BUCKETS) {
+            for (uint32_t i = 0; i < row_count; i++) {
+                heads[i] = (is_nulls != nullptr && is_nulls[i] != 0) ? 0 : first[buckets[i]];
+            }
+            return;
+        }
+        for (uint32_t i = 0; i < row_count; i++) {
+            if (i + PREFETCH_DISTANCE < row_count) {
+                PREFETCH(first + buckets[i + PREFETCH_DISTANCE]);
+            }
+            heads[i] = (is_nulls != nullptr && is_nulls[i] != 0) ? 0 : first[buckets[i]];
+        }
+    }
+
+    // Prefetch the build keys at the heads of the chains, so that the first comparison of each chain
+    // doesn't stall when the chains are walked.
+    template <typename CppType>
+    static void prefetch_build_keys(const JoinHashTableItems& table_items, const Buffer<CppType>& build_data,
+                                    const HashTableProbeState& probe_state) {
+        if (table_items.bucket_size < PREFETCH_MIN_BUCKETS) {
+            return;
+        }
+        const CppType* keys = build_data.data();
+        for (uint32_t i = 0; i < probe_state.probe_row_count; i++) {
+            PREFETCH(keys + probe_state.next[i]);
+        }
+    }
+
     static void prepare_map_index(HashTableProbeState* probe_state) {
         probe_state->build_index.resize(config::vector_chunk_size + 8);
         probe_state->probe_index.resize(config::vector_chunk_size + 8);
@@ -280,6 +379,15 @@ public:
     static Status construct_hash_table(JoinHashTableItems* table_items, HashTableProbeState* probe_state);
 };
 
+// The build of the direct-mapped hash table of a single integer key, see JoinHashTableItems::direct_mapping_min.
+template <PrimitiveType PT>
+class DirectMappingJoinBuildFunc : public JoinBuildFunc<PT> {
+public:
+    using CppType = typename RunTimeTypeTraits<PT>::CppType;
+
+    static Status construct_hash_table(JoinHashTableItems* table_items, HashTableProbeState* probe_state);
+};
+
 template <PrimitiveType PT>
 class FixedSizeJoinBuildFunc {
 public:
@@ -328,6 +436,18 @@ public:
     static Status lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
 
     static const Buffer<CppType>& get_key_data(const HashTableProbeState& probe_state);
+
+    // Look up the chains of the probe rows whose buckets are calculated, skipping the rows with null keys.
+    static void lookup_chain_heads(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
+};
+
+template <PrimitiveType PT>
+class DirectMappingJoinProbeFunc : public JoinProbeFunc<PT> {
+public:
+    using CppType = typename RunTimeTypeTraits<PT>::CppType;
+
+    // the buckets are the offsets of the keys, no hash is calculated.
+    static Status lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
 };
 
 template <PrimitiveType PT>
@@ -361,7 +481,7 @@ public:
     static const Buffer<Slice>& get_key_data(const HashTableProbeState& probe_state) { return probe_state.probe_slice; }
 
     static void prepare(JoinHashTableItems* table_items, HashTableProbeState* probe_state) {
-        table_items->probe_pool->clear();
+        probe_state->probe_pool->clear();
         probe_state->probe_slice.resize(probe_state->probe_row_count);
         probe_state->is_nulls.resize(config::vector_chunk_size);
     }
@@ -404,6 +524,9 @@ private:
 
     void _copy_build_nullable_column(const ColumnPtr& src_column, ChunkPtr* chunk, const SlotDescriptor* slot);
 
+    // Unlink the rows whose keys are in their chains already, see JoinHashMapHelper::is_key_only_build.
+    void _remove_duplicate_build_keys();
+
     Status _search_ht(ChunkPtr* probe_chunk);
     void _search_ht_remain();
 
@@ -484,11 +607,16 @@ private:
 #define JoinHashMapForOneKey(PT) JoinHashMap<PT, JoinBuildFunc<PT>, JoinProbeFunc<PT>>
 #define JoinHashMapForFixedSizeKey(PT) JoinHashMap<PT, FixedSizeJoinBuildFunc<PT>, FixedSizeJoinProbeFunc<PT>>
 #define JoinHashMapForSerializedKey(PT) JoinHashMap<PT, SerializedJoinBuildFunc, SerializedJoinProbeFunc>
+#define JoinHashMapForDirectMapping(PT) JoinHashMap<PT, DirectMappingJoinBuildFunc<PT>, DirectMappingJoinProbeFunc<PT>>
 
 class JoinHashTable {
 public:
+    JoinHashTable() = default;
     ~JoinHashTable();
 
+    JoinHashTable(JoinHashTable&&) = default;
+    JoinHashTable& operator=(JoinHashTable&&) = default;
+
     void create(const HashTableParam& param);
     void close();
 
@@ -498,17 +626,38 @@ public:
 
     Status append_chunk(RuntimeState* state, const ChunkPtr& chunk);
 
-    const ChunkPtr& get_build_chunk() const { return _table_items.build_chunk; }
-    Columns& get_key_columns() { return _table_items.key_columns; }
-    uint32_t get_row_count() const { return _table_items.row_count; }
-    size_t get_probe_column_count() const { return _table_items.probe_column_count; }
-    size_t get_build_column_count() const { return _table_items.build_column_count; }
-    size_t get_bucket_size() const { return _table_items.bucket_size; }
+    // Create a hash table that shares the built items of this one read-only, with its own probe state,
+    // so that multiple threads could probe the same hash table concurrently without copying it.
+    // Must be called after build(), and this hash table must outlive the clones.
+    JoinHashTable clone_readable_table();
+
+    // The build rows matched by the probe, only used by right outer/semi/anti and full outer join.
+    const Buffer<uint8_t>& get_build_match_index() const { return _probe_state->build_match_index; }
+    // Mark the build rows matched by the probe of another clone as matched in this hash table.
+    void merge_build_match_index(const Buffer<uint8_t>& build_match_index);
+    // Flip the matched and unmatched build rows, so that probe_remain() outputs the matched rows.
+    // It's used by right semi join probed by multiple clones, whose matched rows are output only once at last.
+    void flip_build_match_index();
+
+    const ChunkPtr& get_build_chunk() const { return _table_items->build_chunk; }
+    Columns& get_key_columns() { return _table_items->key_columns; }
+    uint32_t get_row_count() const { return _table_items->row_count; }
+    size_t get_probe_column_count() const { return _table_items->probe_column_count; }
+    size_t get_build_column_count() const { return _table_items->build_column_count; }
+    size_t get_bucket_size() const { return _table_items->bucket_size; }
+    // The memory consumed by the build rows and the hash table index.
+    uint64_t get_memory_usage() const { return _table_items->last_memory_usage; }
 
     void remove_duplicate_index(Column::Filter* filter);
 
 private:
+    void _prepare_probe_state();
+    // Release the build columns which aren't keys, see JoinHashMapHelper::is_key_only_build.
+    void _release_build_payload_columns();
     JoinHashMapType _choose_join_hash_map();
+    // Choose the direct-mapped hash table if the build keys are dense, and set the bucket size for it.
+    template <PrimitiveType PT>
+    bool _try_direct_mapping();
     static size_t _get_size_of_fixed_and_contiguous_type(PrimitiveType data_type);
 
     void _remove_duplicate_index_for_left_outer_join(Column::Filter* filter);
@@ -538,11 +687,15 @@ private:
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_INT)> _fixed32 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_BIGINT)> _fixed64 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_LARGEINT)> _fixed128 = nullptr;
+    std::unique_ptr<JoinHashMapForDirectMapping(TYPE_INT)> _direct_mapping32 = nullptr;
+    std::unique_ptr<JoinHashMapForDirectMapping(TYPE_BIGINT)> _direct_mapping64 = nullptr;
 
     JoinHashMapType _hash_map_type = JoinHashMapType::empty;
 
-    JoinHashTableItems _table_items;
-    HashTableProbeState _probe_state;
+    std::shared_ptr<JoinHashTableItems> _table_items = nullptr;
+    std::unique_ptr<HashTableProbeState> _probe_state = nullptr;
+    // The readable clones don't own the memory of the shared items.
+    bool _is_readable_clone = false;
 };
 } // namespace starrocks::vectorized
 
@@ -18,7 +18,8 @@ template <PrimitiveType PT>
 Status JoinBuildFunc<PT>::construct_hash_table(JoinHashTableItems* table_items,
                                                HashTableProbeState* probe_state) {
     auto& data = get_key_data(*table_items);
-    if (table_items->key_columns[0]->is_nullable()) {
+    // the null flags are checked only if the nullable keys have any null.
+    if (table_items->key_columns[0]->is_nullable() && table_items->key_columns[0]->has_null()) {
         auto* nullable_column =
                 ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[0]);
         auto& null_array = nullable_column->null_column()->get_data();
@@ -26,14 +27,36 @@ Status JoinBuildFunc<PT>::construct_hash_table(JoinHashTableItems* table_items,
             if (null_array[i] == 0) {
                 uint32_t bucket_num = JoinHashMapHelper::calc_bucket_num<CppType>(
                         data[i], table_items->bucket_size);
-                table_items->next[i] = table_items->first[bucket_num];
-                table_items->first[bucket_num] = i;
+                JoinHashMapHelper::insert_build_row(table_items, bucket_num, i);
             }
         }
     } else {
         for (size_t i = 1; i < table_items->row_count + 1; i++) {
             uint32_t bucket_num =
                     JoinHashMapHelper::calc_bucket_num<CppType>(data[i], table_items->bucket_size);
+            JoinHashMapHelper::insert_build_row(table_items, bucket_num, i);
+        }
+    }
+    return Status::OK();
+}
+
+template <PrimitiveType PT>
+Status DirectMappingJoinBuildFunc<PT>::construct_hash_table(JoinHashTableItems* table_items,
+                                                            HashTableProbeState* probe_state) {
+    auto& data = JoinBuildFunc<PT>::get_key_data(*table_items);
+    const uint8_t* is_null = nullptr;
+    if (table_items->key_columns[0]->is_nullable() && table_items->key_columns[0]->has_null()) {
+        is_null = ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[0])
+                          ->null_column()
+                          ->get_data()
+                          .data();
+    }
+    // the direct-mapped hash table is never radix-partitioned.
+    DCHECK_EQ(1, table_items->num_radix_partitions);
+    for (size_t i = 1; i < table_items->row_count + 1; i++) {
+        if (is_null == nullptr || is_null[i] == 0) {
+            uint32_t bucket_num = JoinHashMapHelper::calc_direct_mapping_bucket_num<CppType>(
+                    data[i], table_items->direct_mapping_min, table_items->bucket_size);
             table_items->next[i] = table_items->first[bucket_num];
             table_items->first[bucket_num] = i;
         }
@@ -116,8 +139,7 @@ void FixedSizeJoinBuildFunc<PT>::_build_columns(JoinHashTableItems* table_items,
                                                  &probe_state->buckets, start, count);
 
     for (uint32_t i = 0; i < count; i++) {
-        table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-        table_items->first[probe_state->buckets[i]] = start + i;
+        JoinHashMapHelper::insert_build_row(table_items, probe_state->buckets[i], start + i);
     }
 }
 
@@ -144,8 +166,7 @@ void FixedSizeJoinBuildFunc<PT>::_build_nullable_columns(JoinHashTableItems* tab
 
     for (size_t i = 0; i < count; i++) {
         if (probe_state->is_nulls[i] == 0) {
-            table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-            table_items->first[probe_state->buckets[i]] = start + i;
+            JoinHashMapHelper::insert_build_row(table_items, probe_state->buckets[i], start + i);
         }
     }
 }
@@ -153,38 +174,45 @@ void FixedSizeJoinBuildFunc<PT>::_build_nullable_columns(JoinHashTableItems* tab
 template <PrimitiveType PT>
 Status JoinProbeFunc<PT>::lookup_init(const JoinHashTableItems& table_items,
                                       HashTableProbeState* probe_state) {
-    size_t probe_row_count = probe_state->probe_row_count;
     auto& data = get_key_data(*probe_state);
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size,
                                                  &probe_state->buckets, 0, data.size());
+    lookup_chain_heads(table_items, probe_state);
+    return Status::OK();
+}
 
+template <PrimitiveType PT>
+void JoinProbeFunc<PT>::lookup_chain_heads(const JoinHashTableItems& table_items,
+                                           HashTableProbeState* probe_state) {
+    size_t probe_row_count = probe_state->probe_row_count;
     if ((*probe_state->key_columns)[0]->is_nullable()) {
         auto* nullable_column =
                 ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[0]);
 
         if (nullable_column->has_null()) {
             auto& null_array = nullable_column->null_column()->get_data();
-            for (size_t i = 0; i < probe_row_count; i++) {
-                if (null_array[i] == 0) {
-                    probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-                } else {
-                    probe_state->next[i] = 0;
-                }
-            }
+            JoinHashMapHelper::lookup_chain_heads(table_items, probe_state, probe_row_count, null_array.data());
             probe_state->null_array = &nullable_column->null_column()->get_data();
         } else {
-            for (size_t i = 0; i < probe_row_count; i++) {
-                probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-            }
+            JoinHashMapHelper::lookup_chain_heads(table_items, probe_state, probe_row_count, nullptr);
             probe_state->null_array = nullptr;
         }
-        return Status::OK();
+        return;
     }
 
-    for (size_t i = 0; i < probe_row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_chain_heads(table_items, probe_state, probe_row_count, nullptr);
     probe_state->null_array = nullptr;
+}
+
+template <PrimitiveType PT>
+Status DirectMappingJoinProbeFunc<PT>::lookup_init(const JoinHashTableItems& table_items,
+                                                   HashTableProbeState* probe_state) {
+    auto& data = JoinProbeFunc<PT>::get_key_data(*probe_state);
+    for (size_t i = 0; i < data.size(); i++) {
+        probe_state->buckets[i] = JoinHashMapHelper::calc_direct_mapping_bucket_num<CppType>(
+                data[i], table_items.direct_mapping_min, table_items.bucket_size);
+    }
+    JoinProbeFunc<PT>::lookup_chain_heads(table_items, probe_state);
     return Status::OK();
 }
 
@@ -250,9 +278,7 @@ void FixedSizeJoinProbeFunc<PT>::_probe_column(const JoinHashTableItems& table_i
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size,
                                                  &probe_state->buckets, 0, row_count);
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_chain_heads(table_items, probe_state, row_count, nullptr);
 }
 
 template <PrimitiveType PT>
@@ -277,13 +303,7 @@ void FixedSizeJoinProbeFunc<PT>::_probe_nullable_column(const JoinHashTableItems
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size,
                                                  &probe_state->buckets, 0, row_count);
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        if (probe_state->is_nulls[i] == 0) {
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-        } else {
-            probe_state->next[i] = 0;
-        }
-    }
+    JoinHashMapHelper::lookup_chain_heads(table_items, probe_state, row_count, probe_state->is_nulls.data());
 }
 
 template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
@@ -293,10 +313,50 @@ Status JoinHashMap<PT, BuildFunc, ProbeFunc>::build(RuntimeState* state) {
 
     // construct hash table
     RETURN_IF_ERROR(BuildFunc().construct_hash_table(_table_items, _probe_state));
+    if (_table_items->num_radix_partitions > 1) {
+        RETURN_IF_ERROR(JoinHashMapHelper::radix_partition_build_rows(state, _table_items));
+    }
+    if (JoinHashMapHelper::is_key_only_build(*_table_items)) {
+        _remove_duplicate_build_keys();
+    }
 
     return Status::OK();
 }
 
+template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
+void JoinHashMap<PT, BuildFunc, ProbeFunc>::_remove_duplicate_build_keys() {
+    const auto& build_data = BuildFunc().get_key_data(*_table_items);
+    auto& first = _table_items->first;
+    auto& next = _table_items->next;
+    // Every row is compared with the distinct keys kept in its chain, whose order is preserved.
+    for (uint32_t bucket = 0; bucket < _table_items->bucket_size; bucket++) {
+        uint32_t head = 0;
+        uint32_t tail = 0;
+        uint32_t row = first[bucket];
+        while (row != 0) {
+            uint32_t next_row = next[row];
+            bool duplicate = false;
+            for (uint32_t kept = head; kept != 0; kept = next[kept]) {
+                if (JoinKeyEqual<CppType>()(build_data[kept], build_data[row])) {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if (!duplicate) {
+                next[row] = 0;
+                if (tail == 0) {
+                    head = row;
+                } else {
+                    next[tail] = row;
+                }
+                tail = row;
+            }
+            row = next_row;
+        }
+        first[bucket] = head;
+    }
+}
+
 template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
 Status JoinHashMap<PT, BuildFunc, ProbeFunc>::probe(const Columns& key_columns,
                                                     ChunkPtr* probe_chunk, ChunkPtr* chunk,
@@ -656,10 +716,13 @@ Status JoinHashMap<PT, BuildFunc, ProbeFunc>::_search_ht(ChunkPtr* probe_chunk)
     if (!_probe_state->has_remain) {
         _probe_state->probe_row_count = (*probe_chunk)->num_rows();
         ProbeFunc().prepare(_table_items, _probe_state);
+        // The probe is staged over the chunk: hash all the probe keys and gather the heads of their chains
+        // with the buckets prefetched, prefetch the build keys at the heads, then walk the chains.
         RETURN_IF_ERROR(ProbeFunc().lookup_init(*_table_items, _probe_state));
 
         auto& build_data = BuildFunc().get_key_data(*_table_items);
         auto& probe_data = ProbeFunc().get_key_data(*_probe_state);
+        JoinHashMapHelper::prefetch_build_keys<CppType>(*_table_items, build_data, *_probe_state);
         _search_ht_impl<true>(build_data, probe_data);
     } else {
         auto& build_data = BuildFunc().get_key_data(*_table_items);
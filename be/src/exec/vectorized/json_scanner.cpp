@@ -285,16 +285,18 @@ Status JsonReader::read_chunk(Chunk* chunk, int32_t rows_to_read, const std::vec
                 objectValue = &(*_json_doc)[_next_line];
             }
             if (_scanner->_json_paths.empty()) {
-                for (SlotDescriptor* slot_desc : slot_descs) {
+                _member_hints.resize(slot_descs.size(), 0);
+                for (size_t i = 0; i < slot_descs.size(); i++) {
+                    SlotDescriptor* slot_desc = slot_descs[i];
                     if (slot_desc == nullptr) {
                         continue;
                     }
                     ColumnPtr& column = chunk->get_column_by_slot_id(slot_desc->id());
-                    const char* column_name = slot_desc->col_name().c_str();
-                    if (!objectValue->IsObject() || !objectValue->HasMember(column_name)) {
+                    const rapidjson::Value* value = _find_member(*objectValue, slot_desc->col_name(), i);
+                    if (value == nullptr) {
                         column->append_nulls(1);
                     } else {
-                        _construct_column((*objectValue)[column_name], column.get(), slot_desc->type());
+                        _construct_column(*value, column.get(), slot_desc->type());
                     }
                 }
             } else {
@@ -329,12 +331,12 @@ Status JsonReader::read_chunk(Chunk* chunk, int32_t rows_to_read, const std::vec
 Status JsonReader::_read_and_parse_json() {
 #ifdef BE_TEST
     [[maybe_unused]] size_t message_size = 0;
-    Slice result(_buf.data(), _buf_size);
+    Slice result(_buf.data(), _buf_size - 1);
     RETURN_IF_ERROR(_file->read(&result));
     if (result.size == 0) {
         return Status::EndOfFile("EOF of reading file");
     }
-    _origin_json_doc.Parse(result.data, result.size);
+    _buf[result.size] = '\0';
 #else
     std::unique_ptr<uint8_t[]> json_binary = nullptr;
     size_t length = 0;
@@ -343,8 +345,16 @@ Status JsonReader::_read_and_parse_json() {
     if (length == 0) {
         return Status::EndOfFile("EOF of reading file");
     }
-    _origin_json_doc.Parse((char*)json_binary.get(), length);
+    if (_buf.size() < length + 1) {
+        _buf.resize(length + 1);
+    }
+    memcpy(_buf.data(), json_binary.get(), length);
+    _buf[length] = '\0';
+    json_binary.reset();
 #endif
+    // The json is parsed in place, so the strings of the document point into |_buf| instead of being copied into
+    // the memory pool of the document, and |_buf| must be kept until the next parse.
+    _origin_json_doc.ParseInsitu(_buf.data());
 
     if (_origin_json_doc.HasParseError()) {
         std::string err_msg = strings::Substitute("Failed to parse string to json. code=$0, error=$1",
@@ -384,6 +394,34 @@ Status JsonReader::_read_and_parse_json() {
     return Status::OK();
 }
 
+// The members of the rows are mostly in the same order, so the member found for the slot in the last row is tried
+// before looking up all the members.
+const rapidjson::Value* JsonReader::_find_member(const rapidjson::Value& object, const std::string& name,
+                                                 size_t slot_index) {
+    if (!object.IsObject()) {
+        return nullptr;
+    }
+    uint32_t& hint = _member_hints[slot_index];
+    if (hint < object.MemberCount()) {
+        const auto& member = object.MemberBegin()[hint];
+        if (member.name.GetStringLength() == name.size() &&
+            memcmp(member.name.GetString(), name.data(), name.size()) == 0) {
+            return &member.value;
+        }
+    }
+    auto it = object.FindMember(rapidjson::StringRef(name.data(), name.size()));
+    if (it == object.MemberEnd()) {
+        return nullptr;
+    }
+    hint = static_cast<uint32_t>(it - object.MemberBegin());
+    return &it->value;
+}
+
+void JsonReader::_append_string(Column* column, const Slice& value) {
+    _slices[0] = value;
+    column->append_strings(_slices);
+}
+
 void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column* column,
                                    const TypeDescriptor& type_desc) {
     if (objectValue.GetType() != rapidjson::kArrayType && type_desc.type == TYPE_ARRAY) {
@@ -398,35 +436,35 @@ void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column*
         break;
     }
     case rapidjson::Type::kFalseType: {
-        column->append_strings(std::vector<Slice>{Slice("0")});
+        _append_string(column, Slice("0"));
         break;
     }
     case rapidjson::Type::kTrueType: {
-        column->append_strings(std::vector<Slice>{Slice("1")});
+        _append_string(column, Slice("1"));
         break;
     }
     case rapidjson::Type::kNumberType: {
         if (objectValue.IsUint()) {
             auto f = fmt::format_int(objectValue.GetUint());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            _append_string(column, Slice(f.data(), f.size()));
         } else if (objectValue.IsInt()) {
             auto f = fmt::format_int(objectValue.GetInt());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            _append_string(column, Slice(f.data(), f.size()));
         } else if (objectValue.IsUint64()) {
             auto f = fmt::format_int(objectValue.GetUint64());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            _append_string(column, Slice(f.data(), f.size()));
         } else if (objectValue.IsInt64()) {
             auto f = fmt::format_int(objectValue.GetInt64());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            _append_string(column, Slice(f.data(), f.size()));
         } else {
             int len = d2s_buffered_n(objectValue.GetDouble(), buf);
-            column->append_strings(std::vector<Slice>{Slice(buf, len)});
+            _append_string(column, Slice(buf, len));
         }
         break;
     }
     case rapidjson::Type::kStringType: {
         const char* str_value = objectValue.GetString();
-        column->append_strings(std::vector<Slice>{Slice(str_value, objectValue.GetStringLength())});
+        _append_string(column, Slice(str_value, objectValue.GetStringLength()));
         break;
     }
     case rapidjson::Type::kArrayType: {
@@ -445,13 +483,13 @@ void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column*
             offsets->append_numbers(&size, 4);
         } else {
             std::string json_str = JsonFunctions::get_raw_json_string(objectValue);
-            column->append_strings(std::vector<Slice>{Slice(json_str.c_str(), json_str.length())});
+            _append_string(column, Slice(json_str.c_str(), json_str.length()));
         }
         break;
     }
     case rapidjson::Type::kObjectType: {
         std::string json_str = JsonFunctions::get_raw_json_string(objectValue);
-        column->append_strings(std::vector<Slice>{Slice(json_str.c_str(), json_str.length())});
+        _append_string(column, Slice(json_str.c_str(), json_str.length()));
         break;
     }
     }
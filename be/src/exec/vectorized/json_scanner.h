@@ -83,6 +83,9 @@ public:
 
 private:
     Status _read_and_parse_json();
+    const rapidjson::Value* _find_member(const rapidjson::Value& object, const std::string& name, size_t slot_index);
+    // Append |value| by |_slices|, so that no vector is allocated for each value.
+    void _append_string(Column* column, const Slice& value);
     void _construct_column(const rapidjson::Value& objectValue, Column* column, const TypeDescriptor& type_desc);
 
 private:
@@ -99,6 +102,10 @@ private:
     std::vector<std::vector<JsonPath>> _json_paths;
     std::vector<JsonPath> _root_paths;
 
+    // The index of the member found for each slot in the last row.
+    std::vector<uint32_t> _member_hints;
+    std::vector<Slice> _slices = std::vector<Slice>(1);
+
     rapidjson::Document _origin_json_doc;  // origin json document object from parsed json string
     rapidjson::Value* _json_doc = nullptr; // _json_doc equals _final_json_doc iff not set `json_root`
 
@@ -0,0 +1,509 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/merge_join_node.h"
+
+#include <algorithm>
+
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "gutil/casts.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::vectorized {
+
+// Compare the row |l| of |lhs| with the row |r| of |rhs| in ascending order with nulls first.
+static int compare_key_rows(const Columns& lhs, size_t l, const Columns& rhs, size_t r) {
+    DCHECK_EQ(lhs.size(), rhs.size());
+    for (size_t i = 0; i < lhs.size(); i++) {
+        const Column* left = lhs[i].get();
+        const Column* right = rhs[i].get();
+        const bool left_is_null = left->is_null(l);
+        const bool right_is_null = right->is_null(r);
+        if (left_is_null || right_is_null) {
+            if (left_is_null != right_is_null) {
+                return left_is_null ? -1 : 1;
+            }
+            continue;
+        }
+        // The keys of the two sides may differ in nullability only.
+        if (left->is_nullable()) {
+            left = down_cast<const NullableColumn*>(left)->data_column().get();
+        }
+        if (right->is_nullable()) {
+            right = down_cast<const NullableColumn*>(right)->data_column().get();
+        }
+        int cmp = left->compare_at(l, r, *right, -1);
+        if (cmp != 0) {
+            return cmp;
+        }
+    }
+    return 0;
+}
+
+// The first row in [from, to) of the sorted |keys| which is not less than the row |target| of |target_keys|, or
+// greater than it if |upper|. The target is usually close to |from|, so the range is found by galloping from |from|
+// before the binary search.
+static size_t search_sorted_rows(const Columns& keys, size_t from, size_t to, const Columns& target_keys,
+                                 size_t target, bool upper) {
+    auto is_before = [&](size_t row) {
+        int cmp = compare_key_rows(keys, row, target_keys, target);
+        return upper ? cmp <= 0 : cmp < 0;
+    };
+    // All the rows before |lo| are before the target, and |hi| is not or is |to|.
+    size_t lo = from;
+    size_t hi = from;
+    size_t step = 1;
+    while (hi < to && is_before(hi)) {
+        lo = hi + 1;
+        hi = std::min(lo + step, to);
+        step *= 2;
+    }
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (is_before(mid)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static bool has_null_key(const Columns& keys, size_t row) {
+    for (const auto& key : keys) {
+        if (key->is_null(row)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+MergeJoinNode::MergeJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
+        : ExecNode(pool, tnode, descs) {}
+
+Status MergeJoinNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    DCHECK(tnode.__isset.merge_join_node);
+    RETURN_IF_ERROR(ExecNode::init(tnode, state));
+    const TMergeJoinNode& merge_join_node = tnode.merge_join_node;
+
+    if (merge_join_node.__isset.join_op) {
+        _join_type = merge_join_node.join_op;
+    }
+    if (_join_type != TJoinOp::INNER_JOIN && _join_type != TJoinOp::LEFT_OUTER_JOIN &&
+        _join_type != TJoinOp::LEFT_SEMI_JOIN) {
+        return Status::NotSupported(strings::Substitute("merge join does not support the join type $0", _join_type));
+    }
+
+    for (const auto& cmp_conjunct : merge_join_node.cmp_conjuncts) {
+        ExprContext* ctx = nullptr;
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, cmp_conjunct.left, &ctx));
+        _left_expr_ctxs.push_back(ctx);
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, cmp_conjunct.right, &ctx));
+        _right_expr_ctxs.push_back(ctx);
+    }
+    if (_left_expr_ctxs.empty()) {
+        return Status::InvalidArgument("merge join requires the equi-join conjuncts");
+    }
+
+    RETURN_IF_ERROR(Expr::create_expr_trees(_pool, merge_join_node.other_join_conjuncts, &_other_join_conjunct_ctxs));
+    // The other join conjuncts of the outer and semi joins decide whether a left row is matched, which is not known
+    // until all the pairs of the left row are evaluated.
+    if (!_other_join_conjunct_ctxs.empty() && _join_type != TJoinOp::INNER_JOIN) {
+        return Status::NotSupported("merge join only supports the other join conjuncts of the inner join");
+    }
+    return Status::OK();
+}
+
+Status MergeJoinNode::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+
+    _merge_timer = ADD_TIMER(_runtime_profile, "MergeTime");
+    _left_rows_counter = ADD_COUNTER(_runtime_profile, "LeftRows", TUnit::UNIT);
+    _right_rows_counter = ADD_COUNTER(_runtime_profile, "RightRows", TUnit::UNIT);
+
+    RETURN_IF_ERROR(Expr::prepare(_left_expr_ctxs, state, child(0)->row_desc(), expr_mem_tracker()));
+    RETURN_IF_ERROR(Expr::prepare(_right_expr_ctxs, state, child(1)->row_desc(), expr_mem_tracker()));
+    RETURN_IF_ERROR(Expr::prepare(_other_join_conjunct_ctxs, state, _row_descriptor, expr_mem_tracker()));
+
+    _output_build_columns = _join_type != TJoinOp::LEFT_SEMI_JOIN;
+    for (const auto& tuple_desc : child(0)->row_desc().tuple_descriptors()) {
+        for (const auto& slot : tuple_desc->slots()) {
+            _probe_slots.emplace_back(slot);
+        }
+        if (_row_descriptor.get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+            _output_probe_tuple_ids.emplace_back(tuple_desc->id());
+        }
+    }
+    if (_output_build_columns) {
+        for (const auto& tuple_desc : child(1)->row_desc().tuple_descriptors()) {
+            for (const auto& slot : tuple_desc->slots()) {
+                _build_slots.emplace_back(slot);
+            }
+            if (_row_descriptor.get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+                _output_build_tuple_ids.emplace_back(tuple_desc->id());
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status MergeJoinNode::open(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(ExecNode::open(state));
+    RETURN_IF_ERROR(Expr::open(_left_expr_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_right_expr_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_other_join_conjunct_ctxs, state));
+
+    RETURN_IF_ERROR(child(0)->open(state));
+    RETURN_IF_ERROR(child(1)->open(state));
+    return Status::OK();
+}
+
+Status MergeJoinNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
+    return Status::NotSupported("get_next for row_batch is not supported");
+}
+
+Status MergeJoinNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    return ExecNode::get_next_big_chunk(state, chunk, eos, _pre_output_chunk,
+                                        [this](RuntimeState* inner_state, ChunkPtr* inner_chunk, bool* inner_eos) {
+                                            return this->_get_next_internal(inner_state, inner_chunk, inner_eos);
+                                        });
+}
+
+Status MergeJoinNode::_get_next_internal(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    *chunk = nullptr;
+    ChunkPtr output = nullptr;
+    const size_t capacity = config::vector_chunk_size;
+    while (!_eos && (output == nullptr || output->num_rows() < capacity)) {
+        RETURN_IF_CANCELLED(state);
+        if (_left_chunk == nullptr || _left_pos >= _left_chunk->num_rows()) {
+            RETURN_IF_ERROR(_get_next_left_chunk(state));
+            continue;
+        }
+        if (output == nullptr) {
+            _init_output_chunk(&output);
+        }
+
+        SCOPED_TIMER(_merge_timer);
+        const size_t num_left_rows = _left_chunk->num_rows();
+        const size_t remain = capacity - output->num_rows();
+        if (_left_pos < _run_end) {
+            _append_run(output.get(), remain);
+            continue;
+        }
+        if (_group == nullptr) {
+            RETURN_IF_ERROR(_seek_right_group(state));
+            continue;
+        }
+        if (_group_size == 0) {
+            // There are no more right rows, the rest left rows are unmatched.
+            if (_join_type != TJoinOp::LEFT_OUTER_JOIN) {
+                _eos = true;
+                break;
+            }
+            size_t count = std::min(remain, num_left_rows - _left_pos);
+            _append_left_rows(output.get(), _left_pos, count);
+            _left_pos += count;
+            continue;
+        }
+
+        int cmp = compare_key_rows(_left_keys, _left_pos, _group_keys, _group_begin);
+        if (cmp < 0) {
+            // The left rows before the group are unmatched.
+            size_t end = search_sorted_rows(_left_keys, _left_pos, num_left_rows, _group_keys, _group_begin, false);
+            if (_join_type == TJoinOp::LEFT_OUTER_JOIN) {
+                end = std::min(end, _left_pos + remain);
+                _append_left_rows(output.get(), _left_pos, end - _left_pos);
+            }
+            _left_pos = end;
+        } else if (cmp == 0) {
+            _run_end = search_sorted_rows(_left_keys, _left_pos, num_left_rows, _group_keys, _group_begin, true);
+            _group_pos = 0;
+        } else {
+            RETURN_IF_ERROR(_seek_right_group(state));
+        }
+    }
+
+    if (output == nullptr || output->num_rows() == 0) {
+        DCHECK(_eos);
+        *eos = true;
+        return Status::OK();
+    }
+    if (!_other_join_conjunct_ctxs.empty()) {
+        ExecNode::eval_conjuncts(_other_join_conjunct_ctxs, output.get());
+    }
+    ExecNode::eval_conjuncts(_conjunct_ctxs, output.get());
+
+    _num_rows_returned += output->num_rows();
+    if (reached_limit()) {
+        output->set_num_rows(output->num_rows() - (_num_rows_returned - _limit));
+        _num_rows_returned = _limit;
+        _eos = true;
+    }
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+
+    DCHECK_CHUNK(output);
+    *chunk = std::move(output);
+    *eos = false;
+    return Status::OK();
+}
+
+Status MergeJoinNode::_get_next_left_chunk(RuntimeState* state) {
+    _left_chunk = nullptr;
+    _left_pos = 0;
+    _run_end = 0;
+    _group_pos = 0;
+    while (true) {
+        bool eos = false;
+        RETURN_IF_ERROR(child(0)->get_next(state, &_left_chunk, &eos));
+        if (eos) {
+            _left_chunk = nullptr;
+            _eos = true;
+            return Status::OK();
+        }
+        if (_left_chunk != nullptr && _left_chunk->num_rows() > 0) {
+            break;
+        }
+    }
+    COUNTER_UPDATE(_left_rows_counter, _left_chunk->num_rows());
+    _evaluate_keys(_left_expr_ctxs, _left_chunk.get(), &_left_keys);
+    return Status::OK();
+}
+
+Status MergeJoinNode::_get_next_right_chunk(RuntimeState* state) {
+    _right_chunk = nullptr;
+    _right_pos = 0;
+    while (!_right_eos) {
+        RETURN_IF_ERROR(child(1)->get_next(state, &_right_chunk, &_right_eos));
+        if (_right_eos) {
+            _right_chunk = nullptr;
+            break;
+        }
+        if (_right_chunk != nullptr && _right_chunk->num_rows() > 0) {
+            COUNTER_UPDATE(_right_rows_counter, _right_chunk->num_rows());
+            _evaluate_keys(_right_expr_ctxs, _right_chunk.get(), &_right_keys);
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+Status MergeJoinNode::_seek_right_group(RuntimeState* state) {
+    _group = nullptr;
+    _group_keys.clear();
+    _group_begin = 0;
+    _group_size = 0;
+    while (true) {
+        if (_right_chunk == nullptr || _right_pos >= _right_chunk->num_rows()) {
+            RETURN_IF_ERROR(_get_next_right_chunk(state));
+            if (_right_chunk == nullptr) {
+                // an empty group for the end of the right rows
+                _group = std::make_shared<Chunk>();
+                return Status::OK();
+            }
+            continue;
+        }
+
+        // Skip the right rows less than the current left row, they are unmatched.
+        const size_t num_right_rows = _right_chunk->num_rows();
+        _right_pos = search_sorted_rows(_right_keys, _right_pos, num_right_rows, _left_keys, _left_pos, false);
+        if (_right_pos == num_right_rows) {
+            continue;
+        }
+        size_t end = search_sorted_rows(_right_keys, _right_pos, num_right_rows, _right_keys, _right_pos, true);
+        if (has_null_key(_right_keys, _right_pos)) {
+            _right_pos = end;
+            continue;
+        }
+        if (end < num_right_rows) {
+            // The group is in the right chunk, which is referenced without a copy.
+            _group = _right_chunk;
+            _group_keys = _right_keys;
+            _group_begin = _right_pos;
+            _group_size = end - _right_pos;
+            _right_pos = end;
+            return Status::OK();
+        }
+
+        // The group may continue in the next right chunks, so its rows are copied.
+        _group = _right_chunk->clone_empty_with_tuple(end - _right_pos);
+        _group->append(*_right_chunk, _right_pos, end - _right_pos);
+        for (const auto& key : _right_keys) {
+            ColumnPtr group_key = key->clone_empty();
+            group_key->append(*key, _right_pos, end - _right_pos);
+            _group_keys.emplace_back(std::move(group_key));
+        }
+        _right_pos = end;
+        while (true) {
+            RETURN_IF_ERROR(_get_next_right_chunk(state));
+            if (_right_chunk == nullptr) {
+                break;
+            }
+            end = search_sorted_rows(_right_keys, 0, _right_chunk->num_rows(), _group_keys, 0, true);
+            if (end > 0) {
+                _group->append(*_right_chunk, 0, end);
+                for (size_t i = 0; i < _right_keys.size(); i++) {
+                    _group_keys[i]->append(*_right_keys[i], 0, end);
+                }
+            }
+            _right_pos = end;
+            if (end < _right_chunk->num_rows()) {
+                break;
+            }
+        }
+        _group_size = _group->num_rows();
+        return Status::OK();
+    }
+}
+
+void MergeJoinNode::_evaluate_keys(const std::vector<ExprContext*>& ctxs, Chunk* chunk, Columns* keys) {
+    keys->clear();
+    for (ExprContext* ctx : ctxs) {
+        ColumnPtr key = ctx->evaluate(chunk);
+        if (key->is_constant()) {
+            key = ColumnHelper::unpack_and_duplicate_const_column(chunk->num_rows(), key);
+        }
+        keys->emplace_back(std::move(key));
+    }
+}
+
+void MergeJoinNode::_init_output_chunk(ChunkPtr* chunk) {
+    ChunkPtr new_chunk = std::make_shared<Chunk>();
+    for (SlotDescriptor* slot : _probe_slots) {
+        ColumnPtr column = ColumnHelper::create_column(slot->type(), slot->is_nullable());
+        new_chunk->append_column(std::move(column), slot->id());
+    }
+    // The right columns of the left outer join are null for the unmatched left rows.
+    const bool build_to_nullable = _join_type == TJoinOp::LEFT_OUTER_JOIN;
+    for (SlotDescriptor* slot : _build_slots) {
+        ColumnPtr column = ColumnHelper::create_column(slot->type(), slot->is_nullable() || build_to_nullable);
+        new_chunk->append_column(std::move(column), slot->id());
+    }
+    for (TupleId tuple_id : _output_probe_tuple_ids) {
+        if (_left_chunk->is_tuple_exist(tuple_id)) {
+            new_chunk->append_tuple_column(BooleanColumn::create(), tuple_id);
+        }
+    }
+    // Whether the right tuple of a row is not null, which is 1 for the matched rows without the tuple column.
+    for (TupleId tuple_id : _output_build_tuple_ids) {
+        new_chunk->append_tuple_column(BooleanColumn::create(), tuple_id);
+    }
+    new_chunk->reserve(config::vector_chunk_size);
+    *chunk = std::move(new_chunk);
+}
+
+void MergeJoinNode::_append_left_rows(Chunk* chunk, size_t from, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    for (SlotDescriptor* slot : _probe_slots) {
+        chunk->get_column_by_slot_id(slot->id())->append(*_left_chunk->get_column_by_slot_id(slot->id()), from, count);
+    }
+    for (TupleId tuple_id : _output_probe_tuple_ids) {
+        if (chunk->is_tuple_exist(tuple_id)) {
+            chunk->get_tuple_column_by_id(tuple_id)->append(*_left_chunk->get_tuple_column_by_id(tuple_id), from,
+                                                            count);
+        }
+    }
+    for (SlotDescriptor* slot : _build_slots) {
+        chunk->get_column_by_slot_id(slot->id())->append_nulls(count);
+    }
+    for (TupleId tuple_id : _output_build_tuple_ids) {
+        chunk->get_tuple_column_by_id(tuple_id)->append_default(count);
+    }
+}
+
+void MergeJoinNode::_append_matched_rows(Chunk* chunk, size_t from, size_t count, size_t group_from,
+                                         size_t group_count) {
+    // Every left row is repeated for the group rows, or every group row is repeated for the left rows, whichever
+    // makes fewer but bigger copies.
+    const bool by_left_row = count <= group_count;
+    auto append_left = [&](Column* dest, const Column& src) {
+        if (by_left_row) {
+            for (size_t i = from; i < from + count; i++) {
+                dest->append_value_multiple_times(src, i, group_count);
+            }
+        } else {
+            for (size_t j = 0; j < group_count; j++) {
+                dest->append(src, from, count);
+            }
+        }
+    };
+    auto append_right = [&](Column* dest, const Column& src) {
+        if (by_left_row) {
+            for (size_t i = 0; i < count; i++) {
+                dest->append(src, group_from, group_count);
+            }
+        } else {
+            for (size_t j = group_from; j < group_from + group_count; j++) {
+                dest->append_value_multiple_times(src, j, count);
+            }
+        }
+    };
+
+    for (SlotDescriptor* slot : _probe_slots) {
+        append_left(chunk->get_column_by_slot_id(slot->id()).get(), *_left_chunk->get_column_by_slot_id(slot->id()));
+    }
+    for (TupleId tuple_id : _output_probe_tuple_ids) {
+        if (chunk->is_tuple_exist(tuple_id)) {
+            append_left(chunk->get_tuple_column_by_id(tuple_id).get(), *_left_chunk->get_tuple_column_by_id(tuple_id));
+        }
+    }
+    for (SlotDescriptor* slot : _build_slots) {
+        append_right(chunk->get_column_by_slot_id(slot->id()).get(), *_group->get_column_by_slot_id(slot->id()));
+    }
+    for (TupleId tuple_id : _output_build_tuple_ids) {
+        Column* dest = chunk->get_tuple_column_by_id(tuple_id).get();
+        if (_group->is_tuple_exist(tuple_id)) {
+            append_right(dest, *_group->get_tuple_column_by_id(tuple_id));
+        } else {
+            const uint8_t not_null = 1;
+            dest->append_value_multiple_times(&not_null, count * group_count);
+        }
+    }
+}
+
+void MergeJoinNode::_append_run(Chunk* chunk, size_t capacity) {
+    DCHECK_GT(capacity, 0);
+    if (_join_type == TJoinOp::LEFT_SEMI_JOIN) {
+        size_t count = std::min(capacity, _run_end - _left_pos);
+        _append_left_rows(chunk, _left_pos, count);
+        _left_pos += count;
+        return;
+    }
+    if (_group_pos == 0 && _group_size <= capacity) {
+        size_t count = std::min(_run_end - _left_pos, capacity / _group_size);
+        _append_matched_rows(chunk, _left_pos, count, _group_begin, _group_size);
+        _left_pos += count;
+    } else {
+        // The group is joined with a left row by parts, if it's bigger than the rest of the chunk, or the left row
+        // has been joined with a part of the group.
+        size_t count = std::min(capacity, _group_size - _group_pos);
+        _append_matched_rows(chunk, _left_pos, 1, _group_begin + _group_pos, count);
+        _group_pos += count;
+        if (_group_pos == _group_size) {
+            ++_left_pos;
+            _group_pos = 0;
+        }
+    }
+}
+
+Status MergeJoinNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    Expr::close(_left_expr_ctxs, state);
+    Expr::close(_right_expr_ctxs, state);
+    Expr::close(_other_join_conjunct_ctxs, state);
+
+    _left_chunk.reset();
+    _right_chunk.reset();
+    _group.reset();
+    return ExecNode::close(state);
+}
+
+} // namespace starrocks::vectorized
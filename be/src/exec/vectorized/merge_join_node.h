@@ -0,0 +1,90 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "column/chunk.h"
+#include "exec/exec_node.h"
+#include "gen_cpp/PlanNodes_types.h"
+
+namespace starrocks::vectorized {
+
+// MergeJoinNode joins two children which are both sorted by the join keys, in ascending order with nulls first,
+// e.g. the colocated tables whose sort keys are the join keys. It streams both sides instead of building a hash
+// table of the right side, and supports the inner, left outer and left semi joins.
+//
+// The right rows of the current join key are buffered in |_group|. The equal-key runs of a chunk are detected by a
+// galloping search on the key columns, so the rows of a run, or the rows between two runs, are compared and copied
+// as a whole instead of one by one. The rows with a null key never match.
+class MergeJoinNode final : public ExecNode {
+public:
+    MergeJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    ~MergeJoinNode() override = default;
+
+    Status init(const TPlanNode& tnode, RuntimeState* state) override;
+    Status prepare(RuntimeState* state) override;
+    Status open(RuntimeState* state) override;
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override;
+    Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
+    Status close(RuntimeState* state) override;
+
+private:
+    Status _get_next_internal(RuntimeState* state, ChunkPtr* chunk, bool* eos);
+    Status _get_next_left_chunk(RuntimeState* state);
+    Status _get_next_right_chunk(RuntimeState* state);
+    // Drop the current group, and buffer the first group of the right rows not less than the current left row.
+    Status _seek_right_group(RuntimeState* state);
+    void _evaluate_keys(const std::vector<ExprContext*>& ctxs, Chunk* chunk, Columns* keys);
+
+    void _init_output_chunk(ChunkPtr* chunk);
+    // Append the left rows [from, from + count), with the null right rows if the right columns are output.
+    void _append_left_rows(Chunk* chunk, size_t from, size_t count);
+    // Append the joined rows of the left rows [from, from + count) and the group rows [group_from, group_from +
+    // group_count), a row of them is either the left rows or the group rows.
+    void _append_matched_rows(Chunk* chunk, size_t from, size_t count, size_t group_from, size_t group_count);
+    // Append the matched rows of the current run as many as |capacity|, and advance |_left_pos| and |_group_pos|.
+    void _append_run(Chunk* chunk, size_t capacity);
+
+    TJoinOp::type _join_type = TJoinOp::INNER_JOIN;
+    std::vector<ExprContext*> _left_expr_ctxs;
+    std::vector<ExprContext*> _right_expr_ctxs;
+    // only for the inner join
+    std::vector<ExprContext*> _other_join_conjunct_ctxs;
+
+    std::vector<SlotDescriptor*> _probe_slots;
+    std::vector<SlotDescriptor*> _build_slots;
+    std::vector<TupleId> _output_probe_tuple_ids;
+    std::vector<TupleId> _output_build_tuple_ids;
+    bool _output_build_columns = true;
+
+    ChunkPtr _pre_output_chunk = nullptr;
+
+    // the current left chunk and its key columns, the rows before |_left_pos| are done
+    ChunkPtr _left_chunk = nullptr;
+    Columns _left_keys;
+    size_t _left_pos = 0;
+    // the left rows [_left_pos, _run_end) have the key of |_group|
+    size_t _run_end = 0;
+    // the next group row to join with the left row |_left_pos| of the run
+    size_t _group_pos = 0;
+
+    // the unread right rows are the ones of |_right_chunk| from |_right_pos|
+    ChunkPtr _right_chunk = nullptr;
+    Columns _right_keys;
+    size_t _right_pos = 0;
+    bool _right_eos = false;
+
+    // The right rows [_group_begin, _group_begin + _group_size) of |_group| have the same non-null key, there are no
+    // more right rows if the group is empty, and the group is to be sought if |_group| is null.
+    ChunkPtr _group = nullptr;
+    Columns _group_keys;
+    size_t _group_begin = 0;
+    size_t _group_size = 0;
+
+    bool _eos = false;
+
+    RuntimeProfile::Counter* _merge_timer = nullptr;
+    RuntimeProfile::Counter* _left_rows_counter = nullptr;
+    RuntimeProfile::Counter* _right_rows_counter = nullptr;
+};
+
+} // namespace starrocks::vectorized
@@ -12,6 +12,7 @@
 #include "exec/text_converter.hpp"
 #include "exprs/slot_ref.h"
 #include "gen_cpp/PlanNodes_types.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/date_value.h"
 #include "runtime/decimalv2_value.h"
 #include "runtime/decimalv3.h"
@@ -94,9 +95,161 @@ Status MysqlScanNode::open(RuntimeState* state) {
         return Status::InternalError("input and output not equal.");
     }
 
+    std::vector<std::string> range_filters;
+    // a small limit is read by one connection.
+    if (config::mysql_scan_parallelism > 1 && _limit == -1) {
+        RETURN_IF_ERROR(_split_ranges(&range_filters));
+    }
+    if (!range_filters.empty()) {
+        _range_chunks = std::make_unique<BlockingQueue<ChunkPtr>>(range_filters.size() * 2);
+        _running_threads = range_filters.size();
+        for (const auto& range_filter : range_filters) {
+            _range_threads.emplace_back([this, state, range_filter] { _scan_range(state, range_filter); });
+        }
+    }
+
+    return Status::OK();
+}
+
+static std::string quote_string(const std::string& value) {
+    std::string result = "'";
+    for (char c : value) {
+        if (c == '\'' || c == '\\') {
+            result.push_back(c);
+        }
+        result.push_back(c);
+    }
+    result.push_back('\'');
+    return result;
+}
+
+Status MysqlScanNode::_split_ranges(std::vector<std::string>* range_filters) {
+    // the result of mysql_use_result must be read to the end before the next query.
+    auto read_all = [this](std::vector<std::vector<std::string>>* rows) -> Status {
+        char** data = nullptr;
+        unsigned long* length = nullptr;
+        bool eos = false;
+        while (true) {
+            RETURN_IF_ERROR(_mysql_scanner->get_next_row(&data, &length, &eos));
+            if (eos) {
+                return Status::OK();
+            }
+            auto& row = rows->emplace_back();
+            for (int i = 0; i < _mysql_scanner->field_num(); i++) {
+                // NULL is read as empty
+                row.emplace_back(data[i] == nullptr ? "" : std::string(data[i], length[i]));
+            }
+        }
+    };
+
+    // the table name is `table` or `db`.`table`
+    std::string db = _my_param.db;
+    std::string table;
+    for (char c : _table_name) {
+        if (c != '`') {
+            table.push_back(c);
+        }
+    }
+    if (size_t dot = table.find('.'); dot != std::string::npos) {
+        db = table.substr(0, dot);
+        table = table.substr(dot + 1);
+    }
+    RETURN_IF_ERROR(_mysql_scanner->query(strings::Substitute(
+            "SELECT k.COLUMN_NAME FROM information_schema.KEY_COLUMN_USAGE k JOIN information_schema.COLUMNS c "
+            "ON c.TABLE_SCHEMA = k.TABLE_SCHEMA AND c.TABLE_NAME = k.TABLE_NAME AND c.COLUMN_NAME = k.COLUMN_NAME "
+            "WHERE k.TABLE_SCHEMA = $0 AND k.TABLE_NAME = $1 AND k.CONSTRAINT_NAME = 'PRIMARY' "
+            "AND k.ORDINAL_POSITION = 1 AND c.DATA_TYPE IN ('tinyint', 'smallint', 'mediumint', 'int', 'bigint')",
+            quote_string(db), quote_string(table))));
+    std::vector<std::vector<std::string>> rows;
+    RETURN_IF_ERROR(read_all(&rows));
+    if (rows.size() != 1 || rows[0][0].empty()) {
+        // no integer primary key
+        return Status::OK();
+    }
+    const std::string key = "`" + rows[0][0] + "`";
+
+    rows.clear();
+    RETURN_IF_ERROR(_mysql_scanner->query(_table_name, {"MIN(" + key + ")", "MAX(" + key + ")"}, _filters));
+    RETURN_IF_ERROR(read_all(&rows));
+    if (rows.size() != 1) {
+        return Status::OK();
+    }
+    StringParser::ParseResult min_result = StringParser::PARSE_SUCCESS;
+    StringParser::ParseResult max_result = StringParser::PARSE_SUCCESS;
+    auto min_key = StringParser::string_to_int<int64_t>(rows[0][0].data(), rows[0][0].size(), &min_result);
+    auto max_key = StringParser::string_to_int<int64_t>(rows[0][1].data(), rows[0][1].size(), &max_result);
+    if (min_result != StringParser::PARSE_SUCCESS || max_result != StringParser::PARSE_SUCCESS) {
+        // no rows, or an unsigned bigint key out of the range of int64
+        return Status::OK();
+    }
+
+    const int128_t span = static_cast<int128_t>(max_key) - min_key + 1;
+    const int64_t num_ranges = std::min<int128_t>(config::mysql_scan_parallelism, span);
+    if (num_ranges < 2) {
+        return Status::OK();
+    }
+    const int128_t step = (span + num_ranges - 1) / num_ranges;
+    for (int64_t i = 0; i < num_ranges; i++) {
+        // the first and the last ranges are open, so that no row is missed.
+        auto lower = static_cast<int64_t>(min_key + step * i);
+        const int128_t upper = min_key + step * (i + 1);
+        if (i == 0) {
+            range_filters->emplace_back(strings::Substitute("$0 < $1", key, static_cast<int64_t>(upper)));
+        } else if (i == num_ranges - 1 || upper > max_key) {
+            range_filters->emplace_back(strings::Substitute("$0 >= $1", key, lower));
+            break;
+        } else {
+            range_filters->emplace_back(
+                    strings::Substitute("$0 >= $1 AND $0 < $2", key, lower, static_cast<int64_t>(upper)));
+        }
+    }
+    LOG(INFO) << "split the scan of mysql table " << _table_name << " into " << range_filters->size()
+              << " ranges of " << key;
     return Status::OK();
 }
 
+void MysqlScanNode::_scan_range(RuntimeState* state, const std::string& range_filter) {
+    MysqlScanner scanner(_my_param);
+    std::vector<std::string> filters = _filters;
+    filters.emplace_back(range_filter);
+    Status status = scanner.open();
+    if (status.ok()) {
+        status = scanner.query(_table_name, _columns, filters);
+    }
+    bool eos = false;
+    while (status.ok() && !eos) {
+        if (state->is_cancelled()) {
+            status = Status::Cancelled("Cancelled");
+            break;
+        }
+        ChunkPtr chunk;
+        status = _fill_chunk(&scanner, config::vector_chunk_size, &chunk, &eos);
+        if (status.ok() && chunk->num_rows() > 0 && !_range_chunks->blocking_put(std::move(chunk))) {
+            // the scan node is closed
+            break;
+        }
+    }
+    if (!status.ok()) {
+        _update_status(status);
+        _range_chunks->shutdown();
+    }
+    if (_running_threads.fetch_sub(1) == 1) {
+        _range_chunks->shutdown();
+    }
+}
+
+void MysqlScanNode::_update_status(const Status& status) {
+    std::lock_guard l(_status_mutex);
+    if (_status.ok()) {
+        _status = status;
+    }
+}
+
+Status MysqlScanNode::_get_status() {
+    std::lock_guard l(_status_mutex);
+    return _status;
+}
+
 Status MysqlScanNode::append_text_to_column(const char* data, const int& len, const SlotDescriptor* slot_desc,
                                             Column* column) {
     // only \N will be treated as NULL
@@ -300,51 +453,61 @@ Status MysqlScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos)
         return Status::OK();
     }
 
-    *chunk = std::make_shared<Chunk>();
-    std::vector<SlotDescriptor*> slot_descs = _tuple_desc->slots();
-    // init column information
-    for (auto& slot_desc : slot_descs) {
-        ColumnPtr column = ColumnHelper::create_column(slot_desc->type(), slot_desc->is_nullable());
-        (*chunk)->append_column(std::move(column), slot_desc->id());
-    }
-
-    // indicates whether there are more rows to process. Set in _hbase_scanner.next().
-    bool mysql_eos = false;
-    int row_num = 0;
-
-    while (true) {
-        RETURN_IF_CANCELLED(state);
-
-        if (reached_limit()) {
+    *eos = false;
+    if (_range_chunks != nullptr) {
+        ChunkPtr range_chunk;
+        if (!_range_chunks->blocking_get(&range_chunk)) {
             _is_finished = true;
-            // if row_num is greater than 0, in this call, eos = false, and eos will be set to true
+            RETURN_IF_ERROR(_get_status());
+            *eos = true;
+            return Status::OK();
+        }
+        *chunk = std::move(range_chunk);
+        if (_limit != -1 && _num_rows_returned + static_cast<int64_t>((*chunk)->num_rows()) > _limit) {
+            (*chunk)->set_num_rows(_limit - _num_rows_returned);
+        }
+    } else {
+        size_t max_rows = config::vector_chunk_size;
+        if (_limit != -1) {
+            max_rows = std::min<size_t>(max_rows, _limit - _num_rows_returned);
+        }
+        bool mysql_eos = false;
+        RETURN_IF_ERROR(_fill_chunk(_mysql_scanner.get(), max_rows, chunk, &mysql_eos));
+        if (mysql_eos) {
+            _is_finished = true;
+            // if the chunk isn't empty, in this call, eos = false, and eos will be set to true
             // in the next call
-            if (row_num == 0) {
+            if ((*chunk)->num_rows() == 0) {
                 *eos = true;
+                return Status::OK();
             }
-            return Status::OK();
         }
+    }
 
-        if (row_num >= config::vector_chunk_size) {
-            return Status::OK();
-        }
+    _num_rows_returned += (*chunk)->num_rows();
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    return Status::OK();
+}
+
+Status MysqlScanNode::_fill_chunk(MysqlScanner* scanner, size_t max_rows, ChunkPtr* chunk, bool* eos) {
+    *chunk = std::make_shared<Chunk>();
+    const std::vector<SlotDescriptor*>& slot_descs = _tuple_desc->slots();
+    // init column information
+    for (auto& slot_desc : slot_descs) {
+        ColumnPtr column = ColumnHelper::create_column(slot_desc->type(), slot_desc->is_nullable());
+        (*chunk)->append_column(std::move(column), slot_desc->id());
+    }
 
+    *eos = false;
+    for (size_t row_num = 0; row_num < max_rows; ++row_num) {
         // read mysql
         char** data = nullptr;
         size_t* length = nullptr;
-        RETURN_IF_ERROR(_mysql_scanner->get_next_row(&data, &length, &mysql_eos));
-        if (mysql_eos) {
-            _is_finished = true;
-            // if row_num is greater than 0, in this call, eos = false, and eos will be set to true
-            // in the next call
-            if (row_num == 0) {
-                *eos = true;
-            }
+        RETURN_IF_ERROR(scanner->get_next_row(&data, &length, eos));
+        if (*eos) {
             return Status::OK();
         }
 
-        ++row_num;
-
         int materialized_col_idx = -1;
         for (size_t col_idx = 0; col_idx < _slot_num; ++col_idx) {
             SlotDescriptor* slot_desc = slot_descs[col_idx];
@@ -370,10 +533,8 @@ Status MysqlScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos)
                                                       slot_desc, column.get()));
             }
         }
-
-        ++_num_rows_returned;
-        COUNTER_SET(_rows_returned_counter, _num_rows_returned);
     }
+    return Status::OK();
 }
 
 Status MysqlScanNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
@@ -387,6 +548,13 @@ Status MysqlScanNode::close(RuntimeState* state) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::CLOSE));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
 
+    if (_range_chunks != nullptr) {
+        _range_chunks->shutdown();
+    }
+    for (auto& thread : _range_threads) {
+        thread.join();
+    }
+
     _tuple_pool.reset();
 
     return ScanNode::close(state);
@@ -2,7 +2,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include "column/chunk.h"
 #include "column/vectorized_fwd.h"
@@ -10,6 +13,7 @@
 #include "exec/mysql_scanner.h"
 #include "exec/scan_node.h"
 #include "runtime/descriptors.h"
+#include "util/blocking_queue.hpp"
 
 namespace starrocks {
 
@@ -58,6 +62,19 @@ private:
     template <PrimitiveType PT, typename CppType = RunTimeCppType<PT>>
     void append_value_to_column(Column* column, CppType& value);
 
+    // Read at most |max_rows| rows by |scanner| into a new |chunk|, |eos| is set if the result is exhausted.
+    Status _fill_chunk(MysqlScanner* scanner, size_t max_rows, ChunkPtr* chunk, bool* eos);
+
+    // Split the scan into at most config::mysql_scan_parallelism ranges of the integer primary key of the table,
+    // by its minimum and maximum. |range_filters| is empty if the table can't be split.
+    Status _split_ranges(std::vector<std::string>* range_filters);
+
+    // Read the rows of |range_filter| on a new connection into _range_chunks.
+    void _scan_range(RuntimeState* state, const std::string& range_filter);
+
+    void _update_status(const Status& status);
+    Status _get_status();
+
     bool _is_init;
     bool _is_finished = false;
 
@@ -83,6 +100,14 @@ private:
     std::unique_ptr<MysqlScanner> _mysql_scanner;
     // Current tuple.
     Tuple* _tuple = nullptr;
+
+    // The chunks of the ranges of the table read in parallel, nullptr if the table is read by _mysql_scanner.
+    std::unique_ptr<BlockingQueue<ChunkPtr>> _range_chunks;
+    std::vector<std::thread> _range_threads;
+    std::atomic<int> _running_threads = 0;
+    std::mutex _status_mutex;
+    // the first error of the range scans
+    Status _status;
 };
 } // namespace vectorized
 } // namespace starrocks
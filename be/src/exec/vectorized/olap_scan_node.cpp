@@ -2,6 +2,7 @@
 
 #include "exec/vectorized/olap_scan_node.h"
 
+#include <algorithm>
 #include <chrono>
 #include <limits>
 #include <thread>
@@ -24,7 +25,9 @@
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "storage/vectorized/chunk_helper.h"
-#include "util/priority_thread_pool.hpp"
+#include "util/md5.h"
+#include "util/thrift_util.h"
+#include "util/work_stealing_priority_thread_pool.h"
 
 namespace starrocks::vectorized {
 
@@ -42,6 +45,23 @@ Status OlapScanNode::init(const TPlanNode& tnode, RuntimeState* state) {
         _max_scan_key_num = config::doris_max_scan_key_num;
     }
 
+    TPlanNode plan_node = tnode;
+    ThriftSerializer serializer(false, 1024);
+    uint8_t* buf = nullptr;
+    uint32_t len = 0;
+    RETURN_IF_ERROR(serializer.serialize(&plan_node, &len, &buf));
+    Md5Digest digest;
+    digest.update(buf, len);
+    // the slot ids in the plan refer to the columns of the tuple.
+    if (const auto* tuple_desc = state->desc_tbl().get_tuple_descriptor(tnode.olap_scan_node.tuple_id)) {
+        for (const auto* slot : tuple_desc->slots()) {
+            std::string slot_desc = slot->debug_string();
+            digest.update(slot_desc.data(), slot_desc.size());
+        }
+    }
+    digest.digest();
+    _plan_digest = digest.hex();
+
     return Status::OK();
 }
 
@@ -93,6 +113,11 @@ Status OlapScanNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eo
 // Current get_next the chunk is nullptr when eos==true
 // TODO: return the last chunk with eos=true, reduce one function call?
 Status OlapScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    int64_t tablet_id = 0;
+    return get_next(state, chunk, &tablet_id, eos);
+}
+
+Status OlapScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, int64_t* tablet_id, bool* eos) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::GETNEXT));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
 
@@ -121,7 +146,7 @@ Status OlapScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
         const int32_t num_closed = _closed_scanners.load(std::memory_order_acquire);
         const int32_t num_pending = _pending_scanners.size();
         const int32_t num_running = _num_scanners - num_pending - num_closed;
-        if ((num_pending > 0) && (num_running < kMaxConcurrency)) {
+        if ((num_pending > 0) && (num_running < kMaxConcurrency) && !_scanners_reached_limit()) {
             // before we submit a new scanner to run, check whether it can fetch
             // at least _chunks_per_scanner chunks from _chunk_pool.
             if (_chunk_pool.size() >= (num_running + 1) * _chunks_per_scanner) {
@@ -132,8 +157,10 @@ Status OlapScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
         }
     }
 
-    Chunk* ptr = nullptr;
-    if (_result_chunks.blocking_get(&ptr)) {
+    ScannedChunk scanned;
+    if (_result_chunks.blocking_get(&scanned)) {
+        Chunk* ptr = scanned.chunk;
+        *tablet_id = scanned.tablet_id;
         // If the second argument of `_fill_chunk_pool` is false *AND* the column pool is empty,
         // the column object in the chunk will be destroyed and its memory will be deallocated
         // when the last remaining shared_ptr owning it is destroyed, otherwise the column object
@@ -183,6 +210,12 @@ Status OlapScanNode::close(RuntimeState* state) {
     }
 
     _close_pending_scanners();
+    Expr::close(_disjunct_ctxs, state);
+
+    // add the bytes cached by this thread to the tracker, before it's gone.
+    if (CurrentThread::mem_tracker() == mem_tracker()) {
+        CurrentThread::set_mem_tracker(nullptr);
+    }
 
     // free chunks in _chunk_pool.
     while (!_chunk_pool.empty()) {
@@ -192,10 +225,10 @@ Status OlapScanNode::close(RuntimeState* state) {
     }
 
     // free chunks in _result_chunks and release memory tracker.
-    Chunk* chunk = nullptr;
-    while (_result_chunks.blocking_get(&chunk)) {
-        mem_tracker()->release(chunk->memory_usage());
-        delete chunk;
+    ScannedChunk scanned;
+    while (_result_chunks.blocking_get(&scanned)) {
+        mem_tracker()->release(scanned.chunk->memory_usage());
+        delete scanned.chunk;
     }
 
     // Reduce the memory usage if the the average string size is greater than 512.
@@ -221,6 +254,8 @@ void OlapScanNode::_fill_chunk_pool(int count, bool force_column_pool) {
 
 void OlapScanNode::_scanner_thread(OlapScanner* scanner) {
     CurrentThread::set_query_id(scanner->runtime_state()->query_id());
+    CurrentThread::set_fragment_instance_id(scanner->runtime_state()->fragment_instance_id());
+    CurrentThread::set_operator(-1, id());
     CurrentThread::set_mem_tracker(mem_tracker());
 
     Status status = scanner->open(_runtime_state);
@@ -251,6 +286,12 @@ void OlapScanNode::_scanner_thread(OlapScanner* scanner) {
             chunk = _chunk_pool.pop();
         }
         DCHECK_EQ(chunk->num_rows(), 0);
+        if (_scanners_reached_limit()) {
+            std::lock_guard<std::mutex> l(_mtx);
+            _chunk_pool.push(chunk);
+            status = Status::EndOfFile("OlapScanNode has reached limit");
+            break;
+        }
         status = scanner->get_chunk(_runtime_state, chunk);
         if (!status.ok()) {
             QUERY_LOG(ERROR) << status;
@@ -259,8 +300,9 @@ void OlapScanNode::_scanner_thread(OlapScanner* scanner) {
             break;
         }
         DCHECK_CHUNK(chunk);
+        _num_scanner_rows.fetch_add(chunk->num_rows(), std::memory_order_relaxed);
         // _result_chunks will be shutdown if error happened or has reached limit.
-        if (!_result_chunks.put(chunk)) {
+        if (!_result_chunks.put({chunk, scanner->tablet_id()})) {
             mem_tracker()->release(chunk->memory_usage());
             status = Status::Aborted("_result_chunks has been shutdown");
             delete chunk;
@@ -285,11 +327,15 @@ void OlapScanNode::_scanner_thread(OlapScanner* scanner) {
         } else if (status.is_end_of_file()) {
             scanner->close(_runtime_state);
             _closed_scanners.fetch_add(1, std::memory_order_release);
-            // pick next scanner to run.
-            std::lock_guard<std::mutex> l(_mtx);
-            scanner = _pending_scanners.empty() ? nullptr : _pending_scanners.pop();
-            if (scanner != nullptr && !_submit_scanner(scanner, false)) {
-                _pending_scanners.push(scanner);
+            if (_scanners_reached_limit()) {
+                _close_pending_scanners();
+            } else {
+                // pick next scanner to run.
+                std::lock_guard<std::mutex> l(_mtx);
+                scanner = _pending_scanners.empty() ? nullptr : _pending_scanners.pop();
+                if (scanner != nullptr && !_submit_scanner(scanner, false)) {
+                    _pending_scanners.push(scanner);
+                }
             }
         } else {
             _update_status(status);
@@ -312,6 +358,8 @@ void OlapScanNode::_scanner_thread(OlapScanner* scanner) {
     }
     _running_threads.fetch_sub(1, std::memory_order_release);
     CurrentThread::set_query_id(TUniqueId());
+    CurrentThread::set_fragment_instance_id(TUniqueId());
+    CurrentThread::set_operator(-1, -1);
     CurrentThread::set_mem_tracker(nullptr);
     // DO NOT touch any shared variables since here, as they may have been destructed.
 }
@@ -347,10 +395,18 @@ Status OlapScanNode::_start_scan(RuntimeState* state) {
     if (!status.ok()) {
         _update_status(status);
     }
+    for (const auto& [filter_id, desc] : _runtime_filter_collector.descriptors()) {
+        if (desc->runtime_filter() != nullptr) {
+            _normalized_runtime_filters.insert(filter_id);
+        }
+    }
 
     // 2. Using ColumnValueRange to Build StorageEngine filters
     RETURN_IF_ERROR(details::build_olap_filters(_column_value_ranges, _olap_filter));
 
+    // 3. Convert the disjunctions of the predicates that could be normalized to StorageEngine filters
+    RETURN_IF_ERROR(_build_disjunctive_filters(state));
+
     // 4. Using `Key Column`'s ColumnValueRange to split ScanRange to sererval `Sub ScanRange`
     RETURN_IF_ERROR(details::build_scan_key(_olap_scan_node.key_column_name, _column_value_ranges, _scan_keys,
                                             limit() == -1, _max_scan_key_num));
@@ -360,6 +416,95 @@ Status OlapScanNode::_start_scan(RuntimeState* state) {
     return Status::OK();
 }
 
+Status OlapScanNode::_build_late_runtime_filters(std::set<int32_t>* pushed_filters,
+                                                 std::vector<TCondition>* olap_filters) const {
+    RuntimeFilterProbeCollector late_runtime_filters;
+    for (const auto& [filter_id, desc] : _runtime_filter_collector.descriptors()) {
+        if (desc->runtime_filter() != nullptr && pushed_filters->count(filter_id) == 0) {
+            late_runtime_filters.add_descriptor(desc);
+            pushed_filters->insert(filter_id);
+        }
+    }
+    if (late_runtime_filters.empty()) {
+        return Status::OK();
+    }
+
+    // Only the runtime filters are normalized, the ranges of them are index filters only.
+    ObjectPool obj_pool;
+    std::vector<ExprContext*> conjunct_ctxs;
+    std::vector<bool> normalized_conjuncts;
+    std::vector<TCondition> is_null_vector;
+    std::map<std::string, ColumnValueRangeType> column_value_ranges;
+    Status status;
+    RETURN_IF_ERROR(details::normalize_conjuncts(_tuple_desc->slots(), obj_pool, conjunct_ctxs, normalized_conjuncts,
+                                                 late_runtime_filters, is_null_vector, column_value_ranges, &status));
+    RETURN_IF_ERROR(status);
+    return details::build_olap_filters(column_value_ranges, *olap_filters);
+}
+
+Status OlapScanNode::_build_disjunctive_filters(RuntimeState* state) {
+    DCHECK_EQ(_conjunct_ctxs.size(), _normalized_conjuncts.size());
+    RuntimeFilterProbeCollector no_runtime_filters;
+    for (size_t i = 0; i < _conjunct_ctxs.size(); i++) {
+        ExprContext* ctx = _conjunct_ctxs[i];
+        Expr* root = ctx->root();
+        if (_normalized_conjuncts[i] || root->node_type() != TExprNodeType::COMPOUND_PRED ||
+            root->op() != TExprOpcode::COMPOUND_OR) {
+            continue;
+        }
+        std::vector<Expr*> disjuncts;
+        details::flatten_compound_predicate(root, TExprOpcode::COMPOUND_OR, &disjuncts);
+
+        DisjunctiveFilter filter;
+        filter.conjunct = ctx;
+        bool prunable = true;
+        for (Expr* disjunct : disjuncts) {
+            std::vector<Expr*> operands;
+            details::flatten_compound_predicate(disjunct, TExprOpcode::COMPOUND_AND, &operands);
+            // The operands are normalized as the conjuncts, so each of them needs a context of its own.
+            std::vector<ExprContext*> operand_ctxs;
+            for (Expr* operand : operands) {
+                ExprContext* operand_ctx = nullptr;
+                RETURN_IF_ERROR(ctx->clone(state, &operand_ctx, operand));
+                _disjunct_ctxs.push_back(operand_ctx);
+                operand_ctxs.push_back(operand_ctx);
+            }
+
+            std::vector<bool> normalized_operands;
+            std::vector<TCondition> is_null_vector;
+            std::map<std::string, ColumnValueRangeType> column_value_ranges;
+            Status status;
+            RETURN_IF_ERROR(details::normalize_conjuncts(_tuple_desc->slots(), _obj_pool, operand_ctxs,
+                                                         normalized_operands, no_runtime_filters, is_null_vector,
+                                                         column_value_ranges, &status));
+            if (status.is_end_of_file()) {
+                // The disjunct is always false.
+                continue;
+            }
+            std::vector<TCondition> olap_filters;
+            RETURN_IF_ERROR(details::build_olap_filters(column_value_ranges, olap_filters));
+            for (auto& cond : is_null_vector) {
+                // The index filters are only approximate, and not evaluated on the rows in the storage.
+                if (!cond.is_index_filter_only) {
+                    olap_filters.emplace_back(std::move(cond));
+                }
+            }
+            // Nothing is pruned if any disjunct could be always true.
+            if (!status.ok() || olap_filters.empty()) {
+                prunable = false;
+                break;
+            }
+            filter.exact &= std::all_of(normalized_operands.begin(), normalized_operands.end(),
+                                        [](bool normalized) { return normalized; });
+            filter.disjuncts.emplace_back(std::move(olap_filters));
+        }
+        if (prunable && !filter.disjuncts.empty()) {
+            _disjunctive_filters.emplace_back(std::move(filter));
+        }
+    }
+    return Status::OK();
+}
+
 void OlapScanNode::_init_counter(RuntimeState* state) {
     _scan_timer = ADD_TIMER(_runtime_profile, "ScanTime");
 
@@ -374,7 +519,9 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
     _raw_rows_counter = ADD_COUNTER(_scan_profile, "RawRowsRead", TUnit::UNIT);
     _total_pages_num_counter = ADD_COUNTER(_scan_profile, "TotalPagesNum", TUnit::UNIT);
     _cached_pages_num_counter = ADD_COUNTER(_scan_profile, "CachedPagesNum", TUnit::UNIT);
+    _decoded_cached_pages_num_counter = ADD_COUNTER(_scan_profile, "DecodedCachedPagesNum", TUnit::UNIT);
     _pushdown_predicates_counter = ADD_COUNTER(_scan_profile, "PushdownPredicates", TUnit::UNIT);
+    _late_runtime_filters_counter = ADD_COUNTER(_scan_profile, "LateRuntimeFilterPredicates", TUnit::UNIT);
 
     /// SegmentInit
     _seg_init_timer = ADD_TIMER(_scan_profile, "SegmentInit");
@@ -393,6 +540,8 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
     _pred_filter_timer = ADD_CHILD_TIMER(_scan_profile, "PredFilter", "SegmentRead");
     _pred_filter_counter = ADD_CHILD_COUNTER(_scan_profile, "PredFilterRows", TUnit::UNIT, "SegmentRead");
     _del_vec_filter_counter = ADD_CHILD_COUNTER(_scan_profile, "DelVecFilterRows", TUnit::UNIT, "SegmentRead");
+    _encoded_filter_counter = ADD_CHILD_COUNTER(_scan_profile, "EncodedFilterRows", TUnit::UNIT, "SegmentRead");
+    _metadata_agg_counter = ADD_CHILD_COUNTER(_scan_profile, "MetadataAggRows", TUnit::UNIT, "SegmentRead");
     _chunk_copy_timer = ADD_CHILD_TIMER(_scan_profile, "ChunkCopy", "SegmentRead");
     _decompress_timer = ADD_CHILD_TIMER(_scan_profile, "DecompressT", "SegmentRead");
     _index_load_timer = ADD_CHILD_TIMER(_scan_profile, "IndexLoad", "SegmentRead");
@@ -432,7 +581,7 @@ int OlapScanNode::_compute_priority(int32_t num_submitted_tasks) {
 }
 
 bool OlapScanNode::_submit_scanner(OlapScanner* scanner, bool blockable) {
-    PriorityThreadPool* thread_pool = _runtime_state->exec_env()->thread_pool();
+    WorkStealingPriorityThreadPool* thread_pool = _runtime_state->exec_env()->thread_pool();
     int delta = !scanner->keep_priority();
     int32_t num_submit = _scanner_submit_count.fetch_add(delta, std::memory_order_relaxed);
     PriorityThreadPool::Task task;
@@ -474,6 +623,12 @@ Status OlapScanNode::_start_scan_thread(RuntimeState* state) {
         }
     }
 
+    // The join runtime filters are evaluated on the chunks of the scanners, otherwise all the conjuncts are evaluated
+    // by the scanners, so the scanners could stop once they have returned enough rows together.
+    if (_limit != -1 && _runtime_filter_collector.descriptors().empty()) {
+        _scanner_limit = _limit;
+    }
+
     int scanners_per_tablet = std::max(1, 64 / (int)_scan_ranges.size());
     for (auto& scan_range : _scan_ranges) {
         int num_ranges = cond_ranges.size();
@@ -494,6 +649,11 @@ Status OlapScanNode::_start_scan_thread(RuntimeState* state) {
             scanner_params.conjunct_ctxs = &predicates;
             scanner_params.skip_aggregation = _olap_scan_node.is_preaggregation;
             scanner_params.need_agg_finalize = true;
+            // The join runtime filters are evaluated on the chunks of the scanners.
+            scanner_params.aggregate_by_metadata = _olap_scan_node.__isset.aggregate_by_metadata &&
+                                                   _olap_scan_node.aggregate_by_metadata && _limit == -1 &&
+                                                   _runtime_filter_collector.descriptors().empty();
+            scanner_params.limit = _scanner_limit;
             auto* scanner = _obj_pool.add(new OlapScanner(this));
             RETURN_IF_ERROR(scanner->init(state, scanner_params));
             // Assume all scanners have the same schema.
@@ -527,6 +687,13 @@ Status OlapScanNode::set_scan_range(const TInternalScanRange& range) {
     return set_scan_ranges({range});
 }
 
+void OlapScanNode::retain_scan_ranges(const std::set<int64_t>& tablet_ids) {
+    DCHECK(!_start);
+    auto removed = std::remove_if(_scan_ranges.begin(), _scan_ranges.end(),
+                                  [&](const auto& range) { return tablet_ids.count(range->tablet_id) == 0; });
+    _scan_ranges.erase(removed, _scan_ranges.end());
+}
+
 void OlapScanNode::_update_status(const Status& status) {
     std::lock_guard<SpinLock> lck(_status_mutex);
     if (_status.ok()) {
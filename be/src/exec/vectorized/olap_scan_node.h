@@ -5,6 +5,7 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <vector>
 
 #include "column/chunk.h"
@@ -56,6 +57,18 @@ public:
 
     Status set_scan_range(const TInternalScanRange& range);
 
+    // Same as get_next(RuntimeState*, ChunkPtr*, bool*), and |tablet_id| is set to the tablet of the rows of |chunk|.
+    Status get_next(RuntimeState* state, ChunkPtr* chunk, int64_t* tablet_id, bool* eos);
+
+    const std::vector<std::unique_ptr<TInternalScanRange>>& scan_ranges() const { return _scan_ranges; }
+
+    // Only scan the tablets of |tablet_ids|. REQUIRES: the scan hasn't started, i.e. get_next is never called.
+    void retain_scan_ranges(const std::set<int64_t>& tablet_ids);
+
+    // The digest of the plan of this node and the columns it scans, which identify the rows it returns from a
+    // version of a tablet, so the results computed from them could be cached by the tablets, see QueryCache.
+    const std::string& plan_digest() const { return _plan_digest; }
+
     std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
             pipeline::PipelineBuilderContext* context) override;
 
@@ -92,6 +105,12 @@ private:
     };
 
     Status _start_scan(RuntimeState* state);
+    // Build the olap filters of the runtime filters arrived after the scan started and not in |pushed_filters|,
+    // so that the scanners could still skip the segments and the pages by the zone maps. The ids of the built
+    // runtime filters are added into |pushed_filters|. Called by scanner threads.
+    Status _build_late_runtime_filters(std::set<int32_t>* pushed_filters, std::vector<TCondition>* olap_filters) const;
+    // Build |_disjunctive_filters| of the conjuncts not normalized.
+    Status _build_disjunctive_filters(RuntimeState* state);
     Status _start_scan_thread(RuntimeState* state);
     void _scanner_thread(OlapScanner* scanner);
 
@@ -103,11 +122,28 @@ private:
     void _fill_chunk_pool(int count, bool force_column_pool);
     bool _submit_scanner(OlapScanner* scanner, bool blockable);
     void _close_pending_scanners();
+    // Whether the scanners have returned |_scanner_limit| rows all together, then the others needn't run.
+    bool _scanners_reached_limit() const {
+        return _scanner_limit != -1 && _num_scanner_rows.load(std::memory_order_relaxed) >= _scanner_limit;
+    }
     int _compute_priority(int32_t num_submitted_tasks);
 
+    // A conjunct not normalized which is a disjunction of the conjunctions of the predicates that could be
+    // normalized, e.g. `(c1 = 1 AND c2 > 3) OR c3 IS NULL`. The scanners push it down into the storage, which skips
+    // the pages and the rows by the union of the rows selected by the indexes of every disjunct.
+    struct DisjunctiveFilter {
+        ExprContext* conjunct = nullptr;
+        // the olap filters of every disjunct
+        std::vector<std::vector<TCondition>> disjuncts;
+        // Whether the filters of the disjuncts are equivalent to the conjunct, then the scanners needn't evaluate the
+        // conjunct if they push down the filters.
+        bool exact = true;
+    };
+
     // params
     TOlapScanNode _olap_scan_node;
     std::vector<std::unique_ptr<TInternalScanRange>> _scan_ranges;
+    std::string _plan_digest;
     RuntimeState* _runtime_state = nullptr;
 
     // constructed from params
@@ -116,6 +152,11 @@ private:
     OlapScanKeys _scan_keys;                                          // from _column_value_ranges
     std::vector<TCondition> _olap_filter;                             // from _column_value_ranges
     std::vector<TCondition> _is_null_vector;                          // from expr
+    std::vector<DisjunctiveFilter> _disjunctive_filters;              // from expr
+    // the contexts of the disjuncts of |_disjunctive_filters|, cloned from the conjuncts.
+    std::vector<ExprContext*> _disjunct_ctxs;
+    // the runtime filters already arrived and normalized into |_column_value_ranges| when the scan started.
+    std::set<int32_t> _normalized_runtime_filters;
 
     ObjectPool _obj_pool;
 
@@ -135,12 +176,20 @@ private:
     Stack<Chunk*> _chunk_pool;
     Stack<OlapScanner*> _pending_scanners;
 
-    UnboundedBlockingQueue<Chunk*> _result_chunks;
+    struct ScannedChunk {
+        Chunk* chunk = nullptr;
+        int64_t tablet_id = 0;
+    };
+    UnboundedBlockingQueue<ScannedChunk> _result_chunks;
 
     // used to compute task priority.
     std::atomic<int32_t> _scanner_submit_count{0};
     std::atomic<int32_t> _running_threads{0};
     std::atomic<int32_t> _closed_scanners{0};
+    // The limit of the rows returned by the scanners, -1 if the rows may be filtered after the scanners. The rows
+    // returned by all the scanners are counted in |_num_scanner_rows|.
+    int64_t _scanner_limit = -1;
+    std::atomic<int64_t> _num_scanner_rows{0};
 
     // profile
     RuntimeProfile* _scan_profile = nullptr;
@@ -156,6 +205,8 @@ private:
     RuntimeProfile::Counter* _raw_rows_counter = nullptr;
     RuntimeProfile::Counter* _pred_filter_counter = nullptr;
     RuntimeProfile::Counter* _del_vec_filter_counter = nullptr;
+    RuntimeProfile::Counter* _encoded_filter_counter = nullptr;
+    RuntimeProfile::Counter* _metadata_agg_counter = nullptr;
     RuntimeProfile::Counter* _pred_filter_timer = nullptr;
     RuntimeProfile::Counter* _chunk_copy_timer = nullptr;
     RuntimeProfile::Counter* _seg_init_timer = nullptr;
@@ -170,9 +221,11 @@ private:
     RuntimeProfile::Counter* _index_load_timer = nullptr;
     RuntimeProfile::Counter* _total_pages_num_counter = nullptr;
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _decoded_cached_pages_num_counter = nullptr;
     RuntimeProfile::Counter* _bi_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bi_filter_timer = nullptr;
     RuntimeProfile::Counter* _pushdown_predicates_counter = nullptr;
+    RuntimeProfile::Counter* _late_runtime_filters_counter = nullptr;
 };
 
 } // namespace starrocks::vectorized
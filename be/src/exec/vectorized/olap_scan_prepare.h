@@ -10,6 +10,7 @@
 #include "exprs/expr_context.h"
 #include "exprs/slot_ref.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
+#include "exprs/vectorized/like_predicate.h"
 #include "exprs/vectorized/runtime_filter_bank.h"
 #include "gutil/map_util.h"
 
@@ -441,6 +442,57 @@ static void normalize_is_null_predicate(const SlotDescriptor& slot, const std::v
     }
 }
 
+// Every value matched by `LIKE` contains the longest literal of the pattern, which is pushed down as a `contains`
+// condition to skip the pages and the rows by the text indexes of the column. The condition only filters the
+// indexes, and the conjunct is not normalized, so it is still evaluated on the rows.
+static void normalize_like_predicate(const SlotDescriptor& slot, const std::vector<ExprContext*>& conjunct_ctxs,
+                                     std::vector<bool>& normalized_conjuncts,
+                                     std::vector<TCondition>& is_null_vector) {
+    for (size_t i = 0; i < conjunct_ctxs.size(); i++) {
+        if (normalized_conjuncts[i]) {
+            continue;
+        }
+        Expr* root_expr = conjunct_ctxs[i]->root();
+        if (TExprNodeType::FUNCTION_CALL != root_expr->node_type() || root_expr->get_num_children() != 2 ||
+            root_expr->fn().name.function_name != "like") {
+            continue;
+        }
+        Expr* l = root_expr->get_child(0);
+        Expr* r = root_expr->get_child(1);
+        if (l->node_type() != TExprNodeType::SLOT_REF || !r->is_constant()) {
+            continue;
+        }
+        std::vector<SlotId> slot_ids;
+        if (1 != l->get_slot_ids(&slot_ids) || slot_ids[0] != slot.id()) {
+            continue;
+        }
+        ColumnPtr column_ptr = conjunct_ctxs[i]->evaluate(r, nullptr);
+        if (column_ptr == nullptr || column_ptr->only_null() || column_ptr->is_null(0)) {
+            continue;
+        }
+        ColumnPtr data = column_ptr;
+        if (column_ptr->is_nullable()) {
+            data = down_cast<NullableColumn*>(column_ptr.get())->data_column();
+        } else if (column_ptr->is_constant()) {
+            data = down_cast<ConstColumn*>(column_ptr.get())->data_column();
+        }
+        if (!data->is_binary()) {
+            continue;
+        }
+        Slice pattern = down_cast<BinaryColumn*>(data.get())->get_slice(0);
+        std::string literal = LikePredicate::extract_like_literal(pattern, '\\');
+        if (literal.empty()) {
+            continue;
+        }
+        TCondition contains;
+        contains.column_name = slot.col_name();
+        contains.condition_op = "contains";
+        contains.condition_values.push_back(std::move(literal));
+        contains.__set_is_index_filter_only(true);
+        is_null_vector.push_back(contains);
+    }
+}
+
 template <PrimitiveType SlotType, typename RangeType>
 static void normalize_predicate(const SlotDescriptor& slot, ObjectPool& obj_pool,
                                 const std::vector<ExprContext*>& conjunct_ctxs, std::vector<bool>& normalized_conjuncts,
@@ -551,6 +603,7 @@ static Status normalize_conjuncts(const std::vector<SlotDescriptor*>& slots, Obj
             RangeType& range = boost::get<ColumnValueRange<Slice>>(v);
             normalize_predicate<TYPE_VARCHAR, Slice>(*slot, obj_pool, conjunct_ctxs, normalized_conjuncts,
                                                      runtime_filters, is_null_vector, &range, status);
+            normalize_like_predicate(*slot, conjunct_ctxs, normalized_conjuncts, is_null_vector);
             break;
         }
         case TYPE_DATE: {
@@ -690,6 +743,18 @@ static Status build_olap_filters(const std::map<std::string, ColumnValueRangeTyp
     return Status::OK();
 }
 
+// Append the operands of |expr| to |exprs|, e.g. `a`, `b` and `c` of `(a OR b) OR c` for COMPOUND_OR, or |expr|
+// itself if it's not such a compound predicate.
+static void flatten_compound_predicate(Expr* expr, TExprOpcode::type op, std::vector<Expr*>* exprs) {
+    if (expr->node_type() == TExprNodeType::COMPOUND_PRED && expr->op() == op) {
+        for (Expr* child : expr->children()) {
+            flatten_compound_predicate(child, op, exprs);
+        }
+    } else {
+        exprs->push_back(expr);
+    }
+}
+
 // Try to convert the ranges predicates applied on key columns to in predicates to increase
 // the scan concurrency, i.e, the number of OlapScanners.
 // For example, if the original query is `select * from t where c0 between 1 and 3 and c1 between 12 and 13`,
@@ -2,6 +2,7 @@
 
 #include "exec/vectorized/olap_scanner.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "column/column_helper.h"
@@ -22,11 +23,13 @@ Status OlapScanner::init(RuntimeState* runtime_state, const OlapScannerParams& p
     _runtime_state = runtime_state;
     _skip_aggregation = params.skip_aggregation;
     _need_agg_finalize = params.need_agg_finalize;
+    _aggregate_by_metadata = params.aggregate_by_metadata;
+    _limit = params.limit;
 
     RETURN_IF_ERROR(Expr::clone_if_not_exists(*params.conjunct_ctxs, runtime_state, &_conjunct_ctxs));
     RETURN_IF_ERROR(_get_tablet(params.scan_range));
     RETURN_IF_ERROR(_init_return_columns());
-    RETURN_IF_ERROR(_init_reader_params(params.key_ranges));
+    RETURN_IF_ERROR(_init_reader_params(params.key_ranges, *params.conjunct_ctxs));
     const TabletSchema& tablet_schema = _tablet->tablet_schema();
     Schema child_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, _reader_columns);
     _reader = std::make_shared<Reader>(std::move(child_schema));
@@ -50,6 +53,7 @@ Status OlapScanner::open([[maybe_unused]] RuntimeState* runtime_state) {
 
     SCOPED_TIMER(_parent->_reader_init_timer);
 
+    RETURN_IF_ERROR(_init_late_runtime_filters());
     Status res = _reader->init(_params);
     if (!res.ok()) {
         std::stringstream ss;
@@ -70,6 +74,7 @@ Status OlapScanner::close(RuntimeState* state) {
     update_counter();
     _reader.reset();
     Expr::close(_conjunct_ctxs, state);
+    Expr::close(_pushed_conjunct_ctxs, state);
     // Reduce the memory usage if the the average string size is greater than 512.
     release_large_columns<BinaryColumn>(config::vector_chunk_size * 512);
     _is_closed = true;
@@ -93,7 +98,8 @@ Status OlapScanner::_get_tablet(const TInternalScanRange* scan_range) {
     return Status::OK();
 }
 
-Status OlapScanner::_init_reader_params(const std::vector<OlapScanRange*>* key_ranges) {
+Status OlapScanner::_init_reader_params(const std::vector<OlapScanRange*>* key_ranges,
+                                        const std::vector<ExprContext*>& conjunct_ctxs) {
     _params.tablet = _tablet;
     _params.reader_type = READER_QUERY;
     _params.skip_aggregation = _skip_aggregation;
@@ -122,6 +128,7 @@ Status OlapScanner::_init_reader_params(const std::vector<OlapScanRange*>* key_r
     }
     for (auto& is_null_str : _parent->_is_null_vector) {
         ColumnPredicate* p = parser.parse(is_null_str);
+        p->set_index_filter_only(is_null_str.is_index_filter_only);
         _predicate_free_pool.emplace_back(p);
         if (parser.can_pushdown(p)) {
             _params.predicates.push_back(p);
@@ -129,6 +136,17 @@ Status OlapScanner::_init_reader_params(const std::vector<OlapScanRange*>* key_r
             _predicates.add(p);
         }
     }
+    RETURN_IF_ERROR(_init_or_predicates(parser, conjunct_ctxs));
+
+    // The synthesized rows of the segments answered by the zone maps must not be filtered after the storage,
+    // and only the rows of DUP_KEYS are never merged.
+    _params.aggregate_by_metadata = _aggregate_by_metadata && _conjunct_ctxs.empty() && _predicates.empty() &&
+                                    _params.or_predicates.empty() && _tablet->keys_type() == DUP_KEYS;
+    // Every row read is returned if nothing is filtered, so the reader needn't read more rows than the limit.
+    if (_limit != -1 && _params.predicates.empty() && _params.or_predicates.empty() && _predicates.empty() &&
+        _conjunct_ctxs.empty()) {
+        _params.chunk_size = std::max<int64_t>(1, std::min<int64_t>(_params.chunk_size, _limit));
+    }
 
     // Range
     for (auto key_range : *key_ranges) {
@@ -160,10 +178,108 @@ Status OlapScanner::_init_reader_params(const std::vector<OlapScanRange*>* key_r
     // Actually only the key columns need to be sorted by id, here we check all
     // for simplicity.
     DCHECK(std::is_sorted(_reader_columns.begin(), _reader_columns.end()));
+    _params.chunk_size = ChunkHelper::adaptive_chunk_size(_tablet->tablet_schema(), _reader_columns,
+                                                          config::scan_chunk_target_bytes, _params.chunk_size);
 
     return Status::OK();
 }
 
+Status OlapScanner::_init_or_predicates(const PredicateParser& parser,
+                                        const std::vector<ExprContext*>& conjunct_ctxs) {
+    DCHECK_EQ(conjunct_ctxs.size(), _conjunct_ctxs.size());
+    std::vector<bool> pushed_conjuncts(conjunct_ctxs.size(), false);
+    for (const auto& filter : _parent->_disjunctive_filters) {
+        // The rows of the tablets not of DUP_KEYS are filtered after being merged, unless all the predicates are on
+        // the key columns.
+        DisjunctivePredicates or_predicate;
+        bool can_pushdown = true;
+        for (const auto& disjunct : filter.disjuncts) {
+            ConjunctivePredicates conjunction;
+            for (const TCondition& cond : disjunct) {
+                ColumnPredicate* p = parser.parse(cond);
+                if (p == nullptr) {
+                    can_pushdown = false;
+                    break;
+                }
+                _predicate_free_pool.emplace_back(p);
+                if (!parser.can_pushdown(p)) {
+                    can_pushdown = false;
+                    break;
+                }
+                conjunction.add(p);
+            }
+            if (!can_pushdown) {
+                break;
+            }
+            or_predicate.add(std::move(conjunction));
+        }
+        if (!can_pushdown) {
+            continue;
+        }
+        _params.or_predicates.emplace_back(std::move(or_predicate));
+        auto iter = std::find(conjunct_ctxs.begin(), conjunct_ctxs.end(), filter.conjunct);
+        if (filter.exact && iter != conjunct_ctxs.end()) {
+            pushed_conjuncts[iter - conjunct_ctxs.begin()] = true;
+        }
+    }
+
+    std::vector<ExprContext*> conjuncts;
+    for (size_t i = 0; i < _conjunct_ctxs.size(); i++) {
+        if (pushed_conjuncts[i]) {
+            _pushed_conjunct_ctxs.push_back(_conjunct_ctxs[i]);
+        } else {
+            conjuncts.push_back(_conjunct_ctxs[i]);
+        }
+    }
+    _conjunct_ctxs = std::move(conjuncts);
+    return Status::OK();
+}
+
+Status OlapScanner::_init_late_runtime_filters() {
+    _pushed_runtime_filters = _parent->_normalized_runtime_filters;
+    RETURN_IF_ERROR(_parse_late_runtime_filters(&_params.predicates, &_params.predicates));
+    // The runtime filters arrived after this are pushed down into the segment iterators by polling.
+    _params.late_predicates = &_late_predicates;
+    return Status::OK();
+}
+
+Status OlapScanner::_parse_late_runtime_filters(std::vector<const ColumnPredicate*>* index_predicates,
+                                                std::vector<const ColumnPredicate*>* predicates) {
+    std::vector<TCondition> late_filters;
+    RETURN_IF_ERROR(_parent->_build_late_runtime_filters(&_pushed_runtime_filters, &late_filters));
+    if (late_filters.empty()) {
+        return Status::OK();
+    }
+
+    PredicateParser parser(_tablet->tablet_schema());
+    for (auto& filter : late_filters) {
+        ColumnPredicate* p = parser.parse(filter);
+        p->set_index_filter_only(filter.is_index_filter_only);
+        _predicate_free_pool.emplace_back(p);
+        // The runtime filters still filter the chunks in the scan node, so a filter that can't be pushed down
+        // is just dropped.
+        if (!parser.can_pushdown(p)) {
+            continue;
+        }
+        if (p->is_index_filter_only()) {
+            index_predicates->push_back(p);
+        } else if (predicates != nullptr) {
+            predicates->push_back(p);
+        } else {
+            continue;
+        }
+        COUNTER_UPDATE(_parent->_late_runtime_filters_counter, 1);
+    }
+    return Status::OK();
+}
+
+const std::vector<const ColumnPredicate*>& OlapScanner::LateRuntimeFilterPredicates::poll() {
+    // A failure only loses the chance to skip some pages, the rows are still filtered by the runtime filters.
+    Status st = _scanner->_parse_late_runtime_filters(&_predicates, nullptr);
+    LOG_IF(WARNING, !st.ok()) << "failed to push down late runtime filters: " << st;
+    return _predicates;
+}
+
 Status OlapScanner::_init_return_columns() {
     for (auto slot : _parent->_tuple_desc->slots()) {
         if (!slot->is_materialized()) {
@@ -192,6 +308,9 @@ Status OlapScanner::get_chunk(RuntimeState* state, Chunk* chunk) {
     if (state->is_cancelled()) {
         return Status::Cancelled("canceled state");
     }
+    if (_limit != -1 && _num_rows_returned >= _limit) {
+        return Status::EndOfFile("OlapScanner has reached limit");
+    }
     SCOPED_TIMER(_parent->_scan_timer);
     do {
         if (Status status = _prj_iter->get_next(chunk); !status.ok()) {
@@ -208,11 +327,15 @@ Status OlapScanner::get_chunk(RuntimeState* state, Chunk* chunk) {
             size_t nrows = chunk->num_rows();
             _selection.resize(nrows);
             _predicates.evaluate(chunk, _selection.data(), 0, nrows);
-            chunk->filter(_selection);
+            // the selection is applied along with the conjuncts
+            if (!_conjunct_ctxs.empty()) {
+                ExecNode::eval_conjuncts_with_selection(_conjunct_ctxs, chunk, &_selection);
+            } else {
+                chunk->filter(_selection);
+            }
             CurrentMemTracker::consume((int64_t)chunk->memory_usage() - old_mem_usage);
             DCHECK_CHUNK(chunk);
-        }
-        if (!_conjunct_ctxs.empty()) {
+        } else if (!_conjunct_ctxs.empty()) {
             int64_t old_mem_usage = chunk->memory_usage();
             SCOPED_TIMER(_expr_filter_timer);
             ExecNode::eval_conjuncts(_conjunct_ctxs, chunk);
@@ -220,6 +343,7 @@ Status OlapScanner::get_chunk(RuntimeState* state, Chunk* chunk) {
             DCHECK_CHUNK(chunk);
         }
     } while (chunk->num_rows() == 0);
+    _num_rows_returned += chunk->num_rows();
     _update_realtime_counter();
     return Status::OK();
 }
@@ -232,6 +356,15 @@ void OlapScanner::_update_realtime_counter() {
     COUNTER_UPDATE(_parent->_raw_rows_counter, _reader->stats().raw_rows_read);
     _raw_rows_read += _reader->stats().raw_rows_read;
     _reader->mutable_stats()->raw_rows_read = 0;
+
+    // the compactions of the disk back off if the scan I/O is slow.
+    int64_t io_count = _reader->stats().io_count - _reported_io_count;
+    if (io_count > 0) {
+        int64_t io_ns = _reader->stats().io_ns - _reported_io_ns;
+        _tablet->data_dir()->compaction_io_limiter()->add_scan_io(io_ns, io_count);
+        _reported_io_ns += io_ns;
+        _reported_io_count += io_count;
+    }
 }
 
 void OlapScanner::update_counter() {
@@ -262,6 +395,8 @@ void OlapScanner::update_counter() {
     COUNTER_UPDATE(_parent->_pred_filter_timer, _reader->stats().vec_cond_evaluate_ns);
     COUNTER_UPDATE(_parent->_pred_filter_counter, _reader->stats().rows_vec_cond_filtered);
     COUNTER_UPDATE(_parent->_del_vec_filter_counter, _reader->stats().rows_del_vec_filtered);
+    COUNTER_UPDATE(_parent->_encoded_filter_counter, _reader->stats().rows_encoded_filtered);
+    COUNTER_UPDATE(_parent->_metadata_agg_counter, _reader->stats().rows_metadata_aggregated);
 
     COUNTER_UPDATE(_parent->_zm_filtered_counter, _reader->stats().rows_stats_filtered);
     COUNTER_UPDATE(_parent->_bf_filtered_counter, _reader->stats().rows_bf_filtered);
@@ -270,6 +405,7 @@ void OlapScanner::update_counter() {
 
     COUNTER_UPDATE(_parent->_total_pages_num_counter, _reader->stats().total_pages_num);
     COUNTER_UPDATE(_parent->_cached_pages_num_counter, _reader->stats().cached_pages_num);
+    COUNTER_UPDATE(_parent->_decoded_cached_pages_num_counter, _reader->stats().decoded_cached_pages_num);
 
     COUNTER_UPDATE(_parent->_bi_filtered_counter, _reader->stats().rows_bitmap_index_filtered);
     COUNTER_UPDATE(_parent->_bi_filter_timer, _reader->stats().bitmap_index_filter_timer);
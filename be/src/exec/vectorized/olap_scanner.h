@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <set>
 #include <vector>
 
 #include "column/chunk.h"
@@ -12,12 +13,14 @@
 #include "gen_cpp/InternalService_types.h"
 #include "runtime/runtime_state.h"
 #include "storage/vectorized/conjunctive_predicates.h"
+#include "storage/vectorized/late_predicates.h"
 #include "storage/vectorized/reader.h"
 #include "storage/vectorized/reader_params.h"
 
 namespace starrocks::vectorized {
 
 class OlapScanNode;
+class PredicateParser;
 
 struct OlapScannerParams {
     const TInternalScanRange* scan_range = nullptr;
@@ -26,6 +29,11 @@ struct OlapScannerParams {
 
     bool skip_aggregation = false;
     bool need_agg_finalize = true;
+    // Whether the segments fully covered by the predicates can be answered by their zone maps, see
+    // `ReaderParams::aggregate_by_metadata`.
+    bool aggregate_by_metadata = false;
+    // If not -1, the scanner returns at most |limit| rows, which must have been filtered by all the conjuncts.
+    int64_t limit = -1;
 };
 
 class OlapScanner {
@@ -46,6 +54,9 @@ public:
     RuntimeState* runtime_state() { return _runtime_state; }
     int64_t raw_rows_read() const { return _raw_rows_read; }
 
+    // REQUIRES: `init(RuntimeState*, const OlapScannerParams&)` has been called.
+    int64_t tablet_id() const { return _tablet->tablet_id(); }
+
     // REQUIRES: `init(RuntimeState*, const OlapScannerParams&)` has been called.
     const Schema& chunk_schema() const { return _prj_iter->schema(); }
 
@@ -53,9 +64,32 @@ public:
     bool keep_priority() const { return _keep_priority; }
 
 private:
+    // Provides the segment iterators of the reader with the predicates of the runtime filters arrived after
+    // the reader was initialized, which prune the rows not read yet by the zone maps.
+    class LateRuntimeFilterPredicates final : public LatePredicates {
+    public:
+        explicit LateRuntimeFilterPredicates(OlapScanner* scanner) : _scanner(scanner) {}
+        const std::vector<const ColumnPredicate*>& poll() override;
+
+    private:
+        OlapScanner* _scanner;
+        std::vector<const ColumnPredicate*> _predicates;
+    };
+
     Status _get_tablet(const TInternalScanRange* scan_range);
-    Status _init_reader_params(const std::vector<OlapScanRange*>* key_ranges);
+    Status _init_reader_params(const std::vector<OlapScanRange*>* key_ranges,
+                               const std::vector<ExprContext*>& conjunct_ctxs);
+    // Push down the disjunctive filters of the parent, and stop evaluating the conjuncts of the exact ones, which are
+    // the elements of |conjunct_ctxs|, the conjuncts cloned into |_conjunct_ctxs|.
+    Status _init_or_predicates(const PredicateParser& parser, const std::vector<ExprContext*>& conjunct_ctxs);
     Status _init_return_columns();
+    // Push down the runtime filters arrived after the scanner was initialized.
+    Status _init_late_runtime_filters();
+    // Parse the olap filters of the runtime filters not pushed down yet, the index filters that could be pushed
+    // down are appended to |index_predicates|, the others that could be pushed down are appended to
+    // |predicates| if it's not nullptr.
+    Status _parse_late_runtime_filters(std::vector<const ColumnPredicate*>* index_predicates,
+                                       std::vector<const ColumnPredicate*>* predicates);
     void _update_realtime_counter();
     void update_counter();
 
@@ -65,16 +99,23 @@ private:
     using PredicatePtr = std::unique_ptr<ColumnPredicate>;
 
     std::vector<ExprContext*> _conjunct_ctxs;
+    // the conjuncts evaluated by the storage as |_params.or_predicates|.
+    std::vector<ExprContext*> _pushed_conjunct_ctxs;
     ConjunctivePredicates _predicates;
     std::vector<uint8_t> _selection;
 
     // for release memory.
     std::vector<PredicatePtr> _predicate_free_pool;
 
+    // The ids of the runtime filters already pushed down into the reader.
+    std::set<int32_t> _pushed_runtime_filters;
+    LateRuntimeFilterPredicates _late_predicates{this};
+
     bool _is_open = false;
     bool _is_closed = false;
     bool _skip_aggregation = false;
     bool _need_agg_finalize = false;
+    bool _aggregate_by_metadata = false;
     bool _has_update_counter = false;
 
     ReaderParams _params;
@@ -92,9 +133,15 @@ private:
     // slot descriptors for each one of |_scanner_columns|.
     std::vector<SlotDescriptor*> _query_slots;
 
+    int64_t _limit = -1;
+    int64_t _num_rows_returned = 0;
+
     int64_t _num_rows_read = 0;
     int64_t _raw_rows_read = 0;
     int64_t _compressed_bytes_read = 0;
+    // the scan I/O already reported to the compaction I/O limiter of the disk.
+    int64_t _reported_io_ns = 0;
+    int64_t _reported_io_count = 0;
 
     // non-pushed-down predicates filter time.
     RuntimeProfile::Counter* _expr_filter_timer = nullptr;
@@ -4,9 +4,11 @@
 
 #include <glog/logging.h>
 
+#include <cstring>
 #include <exception>
 #include <limits>
 #include <set>
+#include <type_traits>
 #include <unordered_map>
 
 #include "cctz/civil_time.h"
@@ -91,6 +93,19 @@ static void fill_boolean_column_with_null(orc::ColumnVectorBatch* cvb, ColumnPtr
     c->update_has_null();
 }
 
+// Copy the fixed-width values by memcpy if the orc type is the same as the native type, e.g. BIGINT and DOUBLE,
+// otherwise they're converted by a simple loop, which is vectorized by the compiler.
+template <typename T, typename OrcT>
+static inline void copy_fixed_values(T* dst, const OrcT* src, size_t size) {
+    if constexpr (std::is_same_v<T, OrcT>) {
+        memcpy(dst, src, size * sizeof(T));
+    } else {
+        for (size_t i = 0; i < size; ++i) {
+            dst[i] = src[i];
+        }
+    }
+}
+
 template <PrimitiveType Type, typename OrcColumnVectorBatch>
 static void fill_int_column_from_cvb(OrcColumnVectorBatch* data, ColumnPtr& col, int from, int size,
                                      const TypeDescriptor& type_desc, void* ctx) {
@@ -103,10 +118,7 @@ static void fill_int_column_from_cvb(OrcColumnVectorBatch* data, ColumnPtr& col,
 
     auto* cvbd = data->data.data();
 
-    auto pos = from;
-    for (int i = col_start; i < col_start + size; ++i, ++pos) {
-        values[i] = cvbd[pos];
-    }
+    copy_fixed_values(values + col_start, cvbd + from, size);
 
     // col_start == 0 and from == 0 means it's at top level of fill chunk, not in the middle of array
     // otherwise `broker_load_filter` does not work.
@@ -153,10 +165,7 @@ static void fill_int_column_with_null_from_cvb(OrcColumnVectorBatch* data, Colum
             nulls[i] = !cvbn[pos];
         }
     }
-    pos = from;
-    for (int i = col_start; i < col_start + size; ++i, ++pos) {
-        values[i] = cvbd[pos];
-    }
+    copy_fixed_values(values + col_start, cvbd + from, size);
 
     // col_start == 0 and from == 0 means it's at top level of fill chunk, not in the middle of array
     // otherwise `broker_load_filter` does not work.
@@ -249,9 +258,7 @@ static void fill_float_column(orc::ColumnVectorBatch* cvb, ColumnPtr& col, int f
     auto* values = ColumnHelper::cast_to_raw<Type>(col)->get_data().data();
 
     auto* cvbd = data->data.data();
-    for (int i = col_start; i < col_start + size; ++i, ++from) {
-        values[i] = cvbd[from];
-    }
+    copy_fixed_values(values + col_start, cvbd + from, size);
 }
 
 template <PrimitiveType Type>
@@ -273,10 +280,7 @@ static void fill_float_column_with_null(orc::ColumnVectorBatch* cvb, ColumnPtr&
             nulls[i] = !cvbn[pos];
         }
     }
-    pos = from;
-    for (int i = col_start; i < col_start + size; ++i, ++pos) {
-        values[i] = cvbd[pos];
-    }
+    copy_fixed_values(values + col_start, cvbd + from, size);
     c->update_has_null();
 }
 
@@ -0,0 +1,263 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/partition_topn_node.h"
+
+#include <algorithm>
+
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::vectorized {
+
+PartitionTopNNode::PartitionTopNNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
+        : ExecNode(pool, tnode, descs) {}
+
+Status PartitionTopNNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    DCHECK(tnode.__isset.partition_topn_node);
+    RETURN_IF_ERROR(ExecNode::init(tnode, state));
+    const TPartitionTopNNode& topn_node = tnode.partition_topn_node;
+    const TSortInfo& sort_info = topn_node.sort_info;
+
+    RETURN_IF_ERROR(Expr::create_expr_trees(_pool, sort_info.ordering_exprs, &_sort_expr_ctxs));
+    RETURN_IF_ERROR(Expr::create_expr_trees(_pool, topn_node.partition_exprs, &_partition_expr_ctxs));
+    if (sort_info.is_asc_order.size() != _sort_expr_ctxs.size() ||
+        sort_info.nulls_first.size() != _sort_expr_ctxs.size()) {
+        return Status::InvalidArgument("the sort orders do not match the ordering exprs of partition top-n");
+    }
+    // The same flags as the ones of ChunksSorter.
+    for (size_t i = 0; i < _sort_expr_ctxs.size(); i++) {
+        const bool is_asc = sort_info.is_asc_order[i];
+        const bool is_null_first = sort_info.nulls_first[i];
+        _sort_order_flags.push_back(is_asc ? 1 : -1);
+        if (is_asc) {
+            _null_first_flags.push_back(is_null_first ? -1 : 1);
+        } else {
+            _null_first_flags.push_back(is_null_first ? 1 : -1);
+        }
+    }
+
+    if (topn_node.partition_limit <= 0) {
+        return Status::InvalidArgument("the partition limit of partition top-n must be positive");
+    }
+    _partition_limit = topn_node.partition_limit;
+    if (topn_node.__isset.topn_type) {
+        _topn_type = topn_node.topn_type;
+    }
+    return Status::OK();
+}
+
+Status PartitionTopNNode::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+
+    _topn_timer = ADD_TIMER(_runtime_profile, "PartitionTopNTime");
+    _partition_counter = ADD_COUNTER(_runtime_profile, "PartitionNum", TUnit::UNIT);
+    _kept_rows_counter = ADD_COUNTER(_runtime_profile, "KeptRows", TUnit::UNIT);
+
+    RETURN_IF_ERROR(Expr::prepare(_sort_expr_ctxs, state, child(0)->row_desc(), expr_mem_tracker()));
+    RETURN_IF_ERROR(Expr::prepare(_partition_expr_ctxs, state, child(0)->row_desc(), expr_mem_tracker()));
+    return Status::OK();
+}
+
+Status PartitionTopNNode::open(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(ExecNode::open(state));
+    RETURN_IF_ERROR(Expr::open(_sort_expr_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_partition_expr_ctxs, state));
+
+    ExecNode* data_source = child(0);
+    RETURN_IF_ERROR(data_source->open(state));
+    bool eos = false;
+    while (!eos) {
+        RETURN_IF_CANCELLED(state);
+        ChunkPtr chunk;
+        RETURN_IF_ERROR(data_source->get_next(state, &chunk, &eos));
+        if (!eos && chunk != nullptr && chunk->num_rows() > 0) {
+            SCOPED_TIMER(_topn_timer);
+            RETURN_IF_ERROR(_consume_chunk(chunk));
+        }
+    }
+    data_source->close(state);
+
+    SCOPED_TIMER(_topn_timer);
+    _compact_segments();
+    _partitions.clear();
+    _partition_rows.clear();
+    return Status::OK();
+}
+
+Status PartitionTopNNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
+    return Status::NotSupported("get_next for row_batch is not supported");
+}
+
+Status PartitionTopNNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_CANCELLED(state);
+    *chunk = nullptr;
+    while (!reached_limit() && !_segments.empty()) {
+        const Chunk& segment_chunk = *_segments[0].chunk;
+        const size_t count = std::min<size_t>(config::vector_chunk_size, segment_chunk.num_rows() - _output_pos);
+        if (count == 0) {
+            break;
+        }
+        ChunkPtr output = segment_chunk.clone_empty_with_tuple(count);
+        output->append(segment_chunk, _output_pos, count);
+        _output_pos += count;
+        ExecNode::eval_conjuncts(_conjunct_ctxs, output.get());
+        if (output->num_rows() == 0) {
+            continue;
+        }
+        _num_rows_returned += output->num_rows();
+        if (reached_limit()) {
+            output->set_num_rows(output->num_rows() - (_num_rows_returned - _limit));
+            _num_rows_returned = _limit;
+        }
+        COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+        *chunk = std::move(output);
+        *eos = false;
+        DCHECK_CHUNK(*chunk);
+        return Status::OK();
+    }
+    _segments.clear();
+    *eos = true;
+    return Status::OK();
+}
+
+Status PartitionTopNNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    Expr::close(_sort_expr_ctxs, state);
+    Expr::close(_partition_expr_ctxs, state);
+
+    _segments.clear();
+    _partitions.clear();
+    _partition_rows.clear();
+    return ExecNode::close(state);
+}
+
+Status PartitionTopNNode::_consume_chunk(const ChunkPtr& chunk) {
+    const auto segment_index = static_cast<uint32_t>(_segments.size());
+    DataSegment& segment = _segments.emplace_back();
+    segment.chunk = chunk;
+    _evaluate_columns(_sort_expr_ctxs, chunk.get(), &segment.order_by_columns);
+    Columns partition_columns;
+    _evaluate_columns(_partition_expr_ctxs, chunk.get(), &partition_columns);
+
+    const size_t num_rows = chunk->num_rows();
+    for (size_t row = 0; row < num_rows; row++) {
+        size_t key_size = 0;
+        for (const auto& column : partition_columns) {
+            key_size += column->serialize_size(row);
+        }
+        _key_buffer.resize(key_size);
+        auto* pos = reinterpret_cast<uint8_t*>(_key_buffer.data());
+        for (const auto& column : partition_columns) {
+            pos += column->serialize(row, pos);
+        }
+        auto [iter, inserted] = _partitions.try_emplace(_key_buffer, _partition_rows.size());
+        if (inserted) {
+            _partition_rows.emplace_back();
+        }
+        _offer(iter->second, RowRef{segment_index, static_cast<uint32_t>(row)});
+    }
+    _num_buffered_rows += num_rows;
+    COUNTER_SET(_partition_counter, static_cast<int64_t>(_partition_rows.size()));
+
+    // The rows dropped from the partitions are still referenced by their segments, so the kept rows are copied out
+    // once they are fewer than half of the buffered rows.
+    const auto chunk_size = static_cast<size_t>(config::vector_chunk_size);
+    if (_num_buffered_rows > chunk_size && _num_buffered_rows > 2 * _num_kept_rows) {
+        _compact_segments();
+    }
+    return Status::OK();
+}
+
+void PartitionTopNNode::_offer(uint32_t partition, RowRef ref) {
+    std::vector<RowRef>& rows = _partition_rows[partition];
+    if (rows.size() >= _partition_limit) {
+        // The rows tied with the last kept row have its rank.
+        int cmp = _compare(ref, rows[_partition_limit - 1]);
+        if (cmp > 0 || (cmp == 0 && _topn_type == TPartitionTopNType::ROW_NUMBER)) {
+            return;
+        }
+    }
+    auto pos = std::upper_bound(rows.begin(), rows.end(), ref,
+                                [this](RowRef lhs, RowRef rhs) { return _compare(lhs, rhs) < 0; });
+    rows.insert(pos, ref);
+    _num_kept_rows++;
+    if (rows.size() <= _partition_limit) {
+        return;
+    }
+    if (_topn_type == TPartitionTopNType::ROW_NUMBER) {
+        rows.pop_back();
+        _num_kept_rows--;
+        return;
+    }
+    // The new row ranks before the last kept row, whose ties are dropped together unless they are tied with the
+    // row |_partition_limit| now.
+    while (rows.size() > _partition_limit && _compare(rows.back(), rows[_partition_limit - 1]) > 0) {
+        rows.pop_back();
+        _num_kept_rows--;
+    }
+}
+
+void PartitionTopNNode::_compact_segments() {
+    if (_segments.empty()) {
+        return;
+    }
+    // The kept rows of every segment, in the order of the rows.
+    std::vector<std::vector<uint32_t>> segment_rows(_segments.size());
+    for (const auto& rows : _partition_rows) {
+        for (const RowRef& ref : rows) {
+            segment_rows[ref.segment].push_back(ref.row);
+        }
+    }
+    std::vector<uint32_t> segment_offsets(_segments.size());
+    ChunkPtr chunk = _segments[0].chunk->clone_empty_with_tuple(_num_kept_rows);
+    for (size_t i = 0; i < _segments.size(); i++) {
+        auto& rows = segment_rows[i];
+        segment_offsets[i] = static_cast<uint32_t>(chunk->num_rows());
+        if (rows.empty()) {
+            continue;
+        }
+        std::sort(rows.begin(), rows.end());
+        chunk->append_selective(*_segments[i].chunk, rows.data(), 0, static_cast<uint32_t>(rows.size()));
+    }
+    for (auto& rows : _partition_rows) {
+        for (RowRef& ref : rows) {
+            const auto& kept = segment_rows[ref.segment];
+            auto index = std::lower_bound(kept.begin(), kept.end(), ref.row) - kept.begin();
+            ref.row = segment_offsets[ref.segment] + static_cast<uint32_t>(index);
+            ref.segment = 0;
+        }
+    }
+
+    _segments.clear();
+    DataSegment& segment = _segments.emplace_back();
+    segment.chunk = chunk;
+    _evaluate_columns(_sort_expr_ctxs, chunk.get(), &segment.order_by_columns);
+    _num_buffered_rows = chunk->num_rows();
+    COUNTER_SET(_kept_rows_counter, static_cast<int64_t>(_num_kept_rows));
+}
+
+void PartitionTopNNode::_evaluate_columns(const std::vector<ExprContext*>& ctxs, Chunk* chunk, Columns* columns) {
+    columns->clear();
+    for (ExprContext* ctx : ctxs) {
+        ColumnPtr column = ctx->evaluate(chunk);
+        if (column->is_constant()) {
+            column = ColumnHelper::unpack_and_duplicate_const_column(chunk->num_rows(), column);
+        }
+        // The rows of the different chunks are compared and serialized together, so the columns of an expr must
+        // agree in nullability.
+        if (ctx->root()->is_nullable() && !column->is_nullable()) {
+            column = NullableColumn::create(column, NullColumn::create(column->size(), 0));
+        }
+        columns->emplace_back(std::move(column));
+    }
+}
+
+} // namespace starrocks::vectorized
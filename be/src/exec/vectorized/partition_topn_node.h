@@ -0,0 +1,77 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "exec/exec_node.h"
+#include "exec/vectorized/chunks_sorter.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "util/phmap/phmap.h"
+
+namespace starrocks::vectorized {
+
+// PartitionTopNNode keeps the top |partition_limit| rows of every partition of its input, in the order of the
+// ordering exprs, and outputs them unsorted. It is planned below the sort and the analytic node of a window function
+// which is filtered by its rank, e.g. `row_number() over (partition by u order by ts desc) <= 3`, so that the rows
+// which can never pass the filter are neither shuffled nor sorted.
+//
+// The input chunks are buffered as DataSegments, and every partition keeps the references of its top rows sorted
+// by DataSegment::compare_at, as the sorters do. A row which is not before the last kept row of a full partition is
+// dropped at once. For the RANK type, the rows tied with the last kept row are kept as well.
+class PartitionTopNNode final : public ExecNode {
+public:
+    PartitionTopNNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    ~PartitionTopNNode() override = default;
+
+    Status init(const TPlanNode& tnode, RuntimeState* state) override;
+    Status prepare(RuntimeState* state) override;
+    Status open(RuntimeState* state) override;
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override;
+    Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
+    Status close(RuntimeState* state) override;
+
+private:
+    // The row |row| of the segment |segment| of |_segments|.
+    struct RowRef {
+        uint32_t segment;
+        uint32_t row;
+    };
+
+    Status _consume_chunk(const ChunkPtr& chunk);
+    // Offer |ref| to the kept rows of |partition|.
+    void _offer(uint32_t partition, RowRef ref);
+    int _compare(RowRef lhs, RowRef rhs) const {
+        return _segments[lhs.segment].compare_at(lhs.row, _segments[rhs.segment], rhs.row, _sort_order_flags,
+                                                 _null_first_flags);
+    }
+    // Copy the kept rows into a single segment and release the others.
+    void _compact_segments();
+    void _evaluate_columns(const std::vector<ExprContext*>& ctxs, Chunk* chunk, Columns* columns);
+
+    std::vector<ExprContext*> _sort_expr_ctxs;
+    std::vector<ExprContext*> _partition_expr_ctxs;
+    std::vector<int> _sort_order_flags;
+    std::vector<int> _null_first_flags;
+    size_t _partition_limit = 0;
+    TPartitionTopNType::type _topn_type = TPartitionTopNType::ROW_NUMBER;
+
+    DataSegments _segments;
+    size_t _num_buffered_rows = 0;
+    size_t _num_kept_rows = 0;
+    // the serialized partition keys to the indexes of |_partition_rows|
+    phmap::flat_hash_map<std::string, uint32_t> _partitions;
+    // the kept rows of every partition, in order
+    std::vector<std::vector<RowRef>> _partition_rows;
+    std::string _key_buffer;
+
+    // the rows of the segment to output from
+    size_t _output_pos = 0;
+
+    RuntimeProfile::Counter* _topn_timer = nullptr;
+    RuntimeProfile::Counter* _partition_counter = nullptr;
+    RuntimeProfile::Counter* _kept_rows_counter = nullptr;
+};
+
+} // namespace starrocks::vectorized
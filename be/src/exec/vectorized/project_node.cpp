@@ -2,17 +2,20 @@
 
 #include "exec/vectorized/project_node.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
 #include "exec/pipeline/project_operator.h"
 #include "exprs/expr.h"
 #include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/common_sub_expr_eliminator.h"
 #include "exprs/vectorized/runtime_filter.h"
 #include "runtime/runtime_state.h"
 
@@ -36,19 +39,29 @@ Status ProjectNode::init(const TPlanNode& tnode, RuntimeState* state) {
         slot_null_mapping[slot->id()] = slot->is_nullable();
     }
 
+    std::vector<TExpr> exprs;
+    exprs.reserve(column_size);
     for (auto const& [key, val] : tnode.project_node.slot_map) {
         _slot_ids.emplace_back(key);
-        ExprContext* context;
-        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, val, &context));
-        _expr_ctxs.emplace_back(context);
+        exprs.emplace_back(val);
         _type_is_nullable.emplace_back(slot_null_mapping[key]);
     }
+    CommonSubExprEliminator::CommonExprs common_exprs(tnode.project_node.common_slot_map.begin(),
+                                                      tnode.project_node.common_slot_map.end());
+    if (config::enable_project_common_sub_expr_elimination) {
+        RETURN_IF_ERROR(CommonSubExprEliminator::eliminate(&exprs, &common_exprs, _next_slot_id(state, tnode),
+                                                           row_desc().tuple_descriptors()[0]->id()));
+    }
 
-    size_t common_sub_column_size = tnode.project_node.common_slot_map.size();
-    _common_sub_expr_ctxs.reserve(common_sub_column_size);
-    _common_sub_slot_ids.reserve(common_sub_column_size);
+    for (auto const& expr : exprs) {
+        ExprContext* context;
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, expr, &context));
+        _expr_ctxs.emplace_back(context);
+    }
 
-    for (auto const& [key, val] : tnode.project_node.common_slot_map) {
+    _common_sub_expr_ctxs.reserve(common_exprs.size());
+    _common_sub_slot_ids.reserve(common_exprs.size());
+    for (auto const& [key, val] : common_exprs) {
         ExprContext* context;
         RETURN_IF_ERROR(Expr::create_expr_tree(_pool, val, &context));
         _common_sub_slot_ids.emplace_back(key);
@@ -58,6 +71,25 @@ Status ProjectNode::init(const TPlanNode& tnode, RuntimeState* state) {
     return Status::OK();
 }
 
+// The slots of the chunk are the slots of the tuples and the common slots planned by FE.
+SlotId ProjectNode::_next_slot_id(RuntimeState* state, const TPlanNode& tnode) {
+    SlotId max_slot_id = 0;
+    std::vector<TupleDescriptor*> tuple_descs;
+    state->desc_tbl().get_tuple_descs(&tuple_descs);
+    for (const auto* tuple_desc : tuple_descs) {
+        for (const auto* slot : tuple_desc->slots()) {
+            max_slot_id = std::max(max_slot_id, slot->id());
+        }
+    }
+    for (auto const& [key, val] : tnode.project_node.slot_map) {
+        max_slot_id = std::max(max_slot_id, key);
+    }
+    for (auto const& [key, val] : tnode.project_node.common_slot_map) {
+        max_slot_id = std::max(max_slot_id, key);
+    }
+    return max_slot_id + 1;
+}
+
 Status ProjectNode::prepare(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(ExecNode::prepare(state));
@@ -224,7 +256,7 @@ void ProjectNode::push_down_join_runtime_filter(RuntimeState* state,
         }
         bool match = false;
         for (int i = 0; i < _slot_ids.size(); i++) {
-            if (_slot_ids[i] == slot_id) {
+            if (_slot_ids[i] == slot_id && !_refers_common_slots(_expr_ctxs[i])) {
                 // replace with new probe expr
                 ExprContext* new_probe_expr_ctx = _expr_ctxs[i];
                 rf_desc->replace_probe_expr_ctx(state, row_desc(), expr_mem_tracker(), new_probe_expr_ctx);
@@ -247,6 +279,20 @@ void ProjectNode::push_down_join_runtime_filter(RuntimeState* state,
     }
 }
 
+// The children can't evaluate the expressions referring to the common slots, which are put into the chunks
+// by this node.
+bool ProjectNode::_refers_common_slots(ExprContext* expr_ctx) const {
+    std::vector<SlotId> slot_ids;
+    expr_ctx->root()->get_slot_ids(&slot_ids);
+    for (SlotId slot_id : slot_ids) {
+        if (std::find(_common_sub_slot_ids.begin(), _common_sub_slot_ids.end(), slot_id) !=
+            _common_sub_slot_ids.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 pipeline::OpFactories ProjectNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
     OpFactories operators = _children[0]->decompose_to_pipeline(context);
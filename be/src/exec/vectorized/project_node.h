@@ -31,6 +31,9 @@ public:
             pipeline::PipelineBuilderContext* context) override;
 
 private:
+    static SlotId _next_slot_id(RuntimeState* state, const TPlanNode& tnode);
+    bool _refers_common_slots(ExprContext* expr_ctx) const;
+
     std::vector<SlotId> _slot_ids;
     std::vector<ExprContext*> _expr_ctxs;
     std::vector<bool> _type_is_nullable;
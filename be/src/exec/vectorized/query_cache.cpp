@@ -0,0 +1,56 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/query_cache.h"
+
+namespace starrocks::vectorized {
+
+QueryCache* QueryCache::_s_instance = nullptr;
+
+void QueryCache::create_global_cache(size_t capacity) {
+    if (_s_instance == nullptr && capacity > 0) {
+        _s_instance = new QueryCache(capacity);
+    }
+}
+
+void QueryCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+QueryCache::QueryCache(size_t capacity) : _cache(new_lru_cache(capacity)) {}
+
+std::string QueryCache::make_key(const std::string& plan_digest, int64_t tablet_id, const std::string& version) {
+    std::string key = plan_digest;
+    key.push_back('\0');
+    key.append(std::to_string(tablet_id));
+    key.push_back('\0');
+    key.append(version);
+    return key;
+}
+
+std::shared_ptr<const QueryCache::Result> QueryCache::lookup(const std::string& key) {
+    auto* handle = _cache->lookup(key);
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    // the result is kept alive by the returned pointer, so the cache entry could be released at once.
+    auto result = *reinterpret_cast<std::shared_ptr<const Result>*>(_cache->value(handle));
+    _cache->release(handle);
+    return result;
+}
+
+void QueryCache::insert(const std::string& key, std::shared_ptr<const Result> result, size_t charge) {
+    auto deleter = [](const starrocks::CacheKey& key, void* value) {
+        delete reinterpret_cast<std::shared_ptr<const Result>*>(value);
+    };
+    auto* value = new std::shared_ptr<const Result>(std::move(result));
+    _cache->release(_cache->insert(key, value, charge, deleter));
+}
+
+size_t QueryCache::memory_usage() {
+    return _cache->get_memory_usage();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,54 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "storage/lru_cache.h"
+
+namespace starrocks::vectorized {
+
+// QueryCache caches the partial aggregation results of the tablets, shared by all the queries, so the repeated
+// aggregations over the tablets not changed since the last run, e.g. the ones of the dashboards, only aggregate
+// the rows of the changed tablets and merge the cached results of the others.
+//
+// A result is identified by the digest of the plan of the aggregation and the scan, the tablet and its version,
+// so a new version of the tablet never hits the stale result. The result of a tablet is the intermediate chunks of
+// its groups, i.e. the group by columns and the serialized agg states, which are merged by an aggregator of
+// intermediate input. The least recently used results are evicted once their charges exceed the capacity.
+//
+// This class is thread-safe.
+class QueryCache {
+public:
+    using Result = std::vector<ChunkPtr>;
+
+    // Create global instance of this class, do nothing if |capacity| is 0.
+    static void create_global_cache(size_t capacity);
+
+    static void release_global_cache();
+
+    // Return global instance, nullptr if the cache is disabled.
+    static QueryCache* instance() { return _s_instance; }
+
+    explicit QueryCache(size_t capacity);
+
+    static std::string make_key(const std::string& plan_digest, int64_t tablet_id, const std::string& version);
+
+    // Return nullptr if the result of |key| isn't cached. The chunks of the result must not be modified.
+    std::shared_ptr<const Result> lookup(const std::string& key);
+
+    // Cache |result| as the one of |key|, |charge| is the memory it takes.
+    void insert(const std::string& key, std::shared_ptr<const Result> result, size_t charge);
+
+    size_t memory_usage();
+
+private:
+    static QueryCache* _s_instance;
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace starrocks::vectorized
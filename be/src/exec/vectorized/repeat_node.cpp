@@ -13,7 +13,6 @@ RepeatNode::RepeatNode(ObjectPool* pool, const TPlanNode& tnode, const Descripto
           _repeat_id_list(tnode.repeat_node.repeat_id_list),
           _repeat_times_required(_repeat_id_list.size()),
           _repeat_times_last(_repeat_times_required),
-          _curr_columns(_all_slot_ids.size()),
           _grouping_list(tnode.repeat_node.grouping_list),
           _output_tuple_id(tnode.repeat_node.output_tuple_id),
           _tuple_desc(descs.get_tuple_descriptor(_output_tuple_id)) {
@@ -72,133 +71,56 @@ Status RepeatNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos)
     return Status::NotSupported("get_next for row_batch is not supported");
 }
 
-// for new chunk A.
-// step 1:
-// Extend columns of A, with virtual columns
-// for gourping_id and grouping()/grouping_id() columns.
-//
-// step 2:
-// save current chunk of A.
-//
-// step 3:
-// set null columns of A for unneed columns
-// and return reulst chunk to parent.
-//
-// step 4:
-// for every rest of the group by
-// obtain original chunk from step 2, and
-// do step 1 with update columns instead of append columns.
-// do step 3.
+// For every input chunk, output one chunk per grouping set, which shares the columns of the input chunk, with the
+// rolled-up columns replaced by constant nulls and the virtual columns for grouping_id and grouping()/grouping_id()
+// appended as constants. None of the columns is copied, and the input chunk is never changed, so the chunks output
+// before are kept unchanged by the following ones.
 Status RepeatNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     DCHECK_EQ(_children.size(), 1);
 
-    for (;;) {
-        // if _repeat_times_last < _repeat_times_required
-        // continue access old chunk.
-        if (_repeat_times_last < _repeat_times_required) {
-            {
-                SCOPED_TIMER(_copy_column_timer);
-                Columns columns = _curr_columns;
-                // get a suitable chunk.
-                _curr_chunk->set_columns(columns);
-            }
-
-            {
-                SCOPED_TIMER(_update_column_timer);
-                // unneed to extend, because columns has been extended at first access.
-                // update virtual columns for gourping_id and grouping()/grouping_id() columns.
-                for (int i = 0; i < _grouping_list.size(); ++i) {
-                    auto grouping_column = (_curr_chunk->num_rows() == config::vector_chunk_size)
-                                                   ? _grouping_columns[i][_repeat_times_last]
-                                                   : generate_repeat_column(_grouping_list[i][_repeat_times_last],
-                                                                            _curr_chunk->num_rows());
-
-                    _curr_chunk->update_column(grouping_column, _tuple_desc->slots()[i]->id());
-                }
-            }
-
-            {
-                SCOPED_TIMER(_update_column_timer);
-                // update columns for unneed columns.
-                std::vector<SlotId>& null_slot_ids = _null_slot_ids[_repeat_times_last];
-                for (auto slot_id : null_slot_ids) {
-                    auto null_column = (_curr_chunk->num_rows() == config::vector_chunk_size)
-                                               ? _column_null
-                                               : generate_null_column(_curr_chunk->num_rows());
-
-                    _curr_chunk->update_column(null_column, slot_id);
-                }
-            }
+    while (_repeat_times_last >= _repeat_times_required) {
+        // get a new chunk.
+        RETURN_IF_ERROR(_children[0]->get_next(state, chunk, eos));
+        if (*eos || (*chunk) == nullptr) {
+            return Status::OK();
+        }
+        if ((*chunk)->num_rows() > 0) {
+            _repeat_times_last = 0;
+            _curr_chunk = std::move(*chunk);
+        }
+    }
 
-            {
-                SCOPED_TIMER(_copy_column_timer);
-                *chunk = _curr_chunk;
-            }
+    const size_t num_rows = _curr_chunk->num_rows();
+    ChunkPtr repeat_chunk;
+    {
+        SCOPED_TIMER(_copy_column_timer);
+        repeat_chunk = std::make_shared<Chunk>(_curr_chunk->columns(), _curr_chunk->get_slot_id_to_index_map());
+    }
 
-            ++_repeat_times_last;
-            break;
-        } else {
-            // get a new chunk.
-            RETURN_IF_ERROR(_children[0]->get_next(state, chunk, eos));
-
-            // check for over.
-            if (*eos || (*chunk) == nullptr) {
-                break;
-            } else if ((*chunk)->num_rows() == 0) {
-                continue;
-            } else {
-                // got a new chunk.
-                _repeat_times_last = 0;
-                _curr_chunk = std::move(*chunk);
-
-                {
-                    SCOPED_TIMER(_extend_column_timer);
-                    // extend virtual columns for gourping_id and grouping()/grouping_id() columns.
-                    for (int i = 0; i < _grouping_list.size(); ++i) {
-                        auto grouping_column = (_curr_chunk->num_rows() == config::vector_chunk_size)
-                                                       ? _grouping_columns[i][_repeat_times_last]
-                                                       : generate_repeat_column(_grouping_list[i][_repeat_times_last],
-                                                                                _curr_chunk->num_rows());
-
-                        _curr_chunk->append_column(grouping_column, _tuple_desc->slots()[i]->id());
-                    }
-                }
-
-                {
-                    SCOPED_TIMER(_copy_column_timer);
-                    // save original exgtended columns.
-                    _curr_columns = _curr_chunk->columns();
-                }
-
-                {
-                    SCOPED_TIMER(_update_column_timer);
-                    // update columns for unneed columns.
-                    std::vector<SlotId>& null_slot_ids = _null_slot_ids[_repeat_times_last];
-                    for (auto slot_id : null_slot_ids) {
-                        auto null_column = (_curr_chunk->num_rows() == config::vector_chunk_size)
-                                                   ? _column_null
-                                                   : generate_null_column(_curr_chunk->num_rows());
-
-                        _curr_chunk->update_column(null_column, slot_id);
-                    }
-                }
-
-                {
-                    SCOPED_TIMER(_copy_column_timer);
-                    // get result chunk.
-                    *chunk = _curr_chunk;
-                }
-
-                ++_repeat_times_last;
-                break;
-            }
+    {
+        SCOPED_TIMER(_extend_column_timer);
+        // extend virtual columns for gourping_id and grouping()/grouping_id() columns.
+        for (int i = 0; i < _grouping_list.size(); ++i) {
+            auto grouping_column = (num_rows == config::vector_chunk_size)
+                                           ? _grouping_columns[i][_repeat_times_last]
+                                           : generate_repeat_column(_grouping_list[i][_repeat_times_last], num_rows);
+            repeat_chunk->append_column(std::move(grouping_column), _tuple_desc->slots()[i]->id());
         }
     }
 
-    if ((*chunk) != nullptr) {
-        _num_rows_returned += (*chunk)->num_rows();
+    {
+        SCOPED_TIMER(_update_column_timer);
+        // update columns for unneed columns.
+        for (auto slot_id : _null_slot_ids[_repeat_times_last]) {
+            auto null_column = (num_rows == config::vector_chunk_size) ? _column_null : generate_null_column(num_rows);
+            repeat_chunk->update_column(std::move(null_column), slot_id);
+        }
     }
+
+    ++_repeat_times_last;
+    _num_rows_returned += num_rows;
+    *chunk = std::move(repeat_chunk);
     DCHECK_CHUNK(*chunk);
     return Status::OK();
 }
@@ -49,12 +49,9 @@ private:
     // repeat timer for chunk. 0 <=  _repeat_times_last < _repeat_times_required.
     uint64_t _repeat_times_last;
 
-    // accessing chunk.
+    // accessing chunk, shared by the output chunks of all the grouping sets and never changed.
     ChunkPtr _curr_chunk;
 
-    // original columns for accessing chunk.
-    Columns _curr_columns;
-
     // only null columns for reusing, It has config::vector_chunk_size rows.
     ColumnPtr _column_null;
 
@@ -78,7 +75,7 @@ private:
     // time to append columns for grouping_id column and grouping()/grouping_id()'s virtual columns.
     RuntimeProfile::Counter* _extend_column_timer = nullptr;
 
-    // time to copy/assign/move columns between chunk and columns.
+    // time to create the output chunks sharing the columns of the input chunk.
     RuntimeProfile::Counter* _copy_column_timer = nullptr;
 
     // time to update columns for grouping_id column and grouping()/grouping_id()'s virtual columns.
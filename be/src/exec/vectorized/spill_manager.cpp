@@ -0,0 +1,59 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/spill_manager.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/tmp_file_mgr.h"
+
+namespace starrocks::vectorized {
+
+SpillManager::SpillManager(MemTracker* mem_tracker, TmpFileMgr* tmp_file_mgr)
+        : _mem_tracker(mem_tracker), _tmp_file_mgr(tmp_file_mgr) {}
+
+bool SpillManager::spill_enabled() const {
+    return _mem_tracker != nullptr && _mem_tracker->lowest_limit() > 0 && _tmp_file_mgr != nullptr &&
+           _tmp_file_mgr->num_active_tmp_devices() > 0;
+}
+
+void SpillManager::register_spillable(Spillable* spillable) {
+    std::lock_guard<std::mutex> l(_mutex);
+    _spillables.emplace_back(spillable, 0);
+}
+
+void SpillManager::unregister_spillable(Spillable* spillable) {
+    std::lock_guard<std::mutex> l(_mutex);
+    _spillables.erase(std::remove_if(_spillables.begin(), _spillables.end(),
+                                     [spillable](const auto& entry) { return entry.first == spillable; }),
+                      _spillables.end());
+}
+
+bool SpillManager::should_spill(const Spillable* spillable, int mem_limit_percent, int64_t extra_bytes) {
+    if (mem_limit_percent <= 0 || _mem_tracker == nullptr) {
+        return false;
+    }
+    const int64_t bytes = spillable->spillable_bytes() + extra_bytes;
+    const int64_t mem_limit = _mem_tracker->lowest_limit();
+    const int64_t reserved = mem_limit / 100 * (100 - std::min(mem_limit_percent, 100));
+    // Spilling a little memory releases nothing but costs the IOs.
+    bool spill = mem_limit > 0 && _mem_tracker->spare_capacity() - extra_bytes < reserved &&
+                 bytes >= mem_limit / 100 * config::spill_min_mem_limit_percent;
+
+    std::lock_guard<std::mutex> l(_mutex);
+    auto self = _spillables.end();
+    for (auto it = _spillables.begin(); it != _spillables.end(); ++it) {
+        if (it->first == spillable) {
+            self = it;
+        } else if (it->second > bytes) {
+            spill = false;
+        }
+    }
+    if (self != _spillables.end()) {
+        self->second = spill ? 0 : bytes;
+    }
+    return spill;
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,64 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace starrocks {
+
+class MemTracker;
+class TmpFileMgr;
+
+namespace vectorized {
+
+// An operator which could release its memory by spilling it into the temporary files, e.g. a hash table.
+class Spillable {
+public:
+    virtual ~Spillable() = default;
+
+    // The memory that spilling would release, only called by the thread running the operator.
+    virtual int64_t spillable_bytes() const = 0;
+};
+
+// SpillManager decides which operators of a fragment instance spill, so the sort, the aggregation and the hash join
+// share one memory budget instead of each one spilling once its own memory exceeds a percent of the limit, which
+// never spills while several of them together exceed it.
+//
+// The budget is a percent of the lowest limit of |mem_tracker|, and is exceeded once the spare capacity of any of
+// its limits, e.g. the one of the query shared by the instances or the process one, drops below the rest. Then
+// only the registered operator holding the most memory, as of its last check, spills, since it releases the most.
+//
+// This class is thread-safe.
+class SpillManager {
+public:
+    SpillManager(MemTracker* mem_tracker, TmpFileMgr* tmp_file_mgr);
+
+    // Whether the operators could spill, i.e. the memory is limited and there are temporary devices.
+    bool spill_enabled() const;
+
+    TmpFileMgr* tmp_file_mgr() const { return _tmp_file_mgr; }
+
+    // |spillable| must be unregistered before it's destroyed, or once it no longer holds the memory it reported,
+    // e.g. once it spills all of its input.
+    void register_spillable(Spillable* spillable);
+    void unregister_spillable(Spillable* spillable);
+
+    // Whether |spillable| should spill before it consumes |extra_bytes| more, given the budget of
+    // |mem_limit_percent| percent of the limit, 0 means never. If so, |spillable| is expected to spill its memory,
+    // and is taken to hold none until its next check.
+    bool should_spill(const Spillable* spillable, int mem_limit_percent, int64_t extra_bytes = 0);
+
+private:
+    MemTracker* _mem_tracker;
+    TmpFileMgr* _tmp_file_mgr;
+
+    std::mutex _mutex;
+    // The registered operators and their memory as of their last check.
+    std::vector<std::pair<const Spillable*, int64_t>> _spillables;
+};
+
+} // namespace vectorized
+} // namespace starrocks
@@ -110,27 +110,18 @@ Status TableFunctionNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* e
         output_columns.emplace_back(_table_function_result.first[result_idx]->clone_empty());
     }
 
+    // The rows taken from the current input chunk: the outer rows are replicated by _outer_indexes, and the rows of
+    // the table function result are always the contiguous range [tvf_offset, tvf_offset + tvf_count).
+    _outer_indexes.clear();
+    uint32_t tvf_offset = 0;
+    uint32_t tvf_count = 0;
+
     //If _outer_column_remain_repeat_times > 0, first use the remaining data of the previous chunk to construct this data
     if (_outer_column_remain_repeat_times > 0) {
         size_t repeat_times = std::min(_outer_column_remain_repeat_times, chunk_size);
-        //Build outer data, repeat multiple times
-        for (int outer_idx = 0; outer_idx < _outer_slots.size(); ++outer_idx) {
-            ColumnPtr& input_column_ptr = _input_chunk_ptr->get_column_by_slot_id(_outer_slots[outer_idx]);
-            Datum value = input_column_ptr->get(_input_chunk_seek_rows);
-            if (value.is_null()) {
-                //The output_columns[outer_idx] is must Nullable, if value has null
-                down_cast<NullableColumn*>(output_columns[outer_idx].get())->append_nulls(repeat_times);
-            } else {
-                output_columns[outer_idx]->append_value_multiple_times(&value, repeat_times);
-            }
-        }
-        //Build table function result
-        for (int result_idx = 0; result_idx < _fn_result_slots.size(); ++result_idx) {
-            int tvf_offset_start = _table_function_result.second->get(_input_chunk_seek_rows + 1).get_int32() -
-                                   _outer_column_remain_repeat_times;
-            output_columns[_outer_slots.size() + result_idx]->append(*(_table_function_result.first[result_idx]),
-                                                                     tvf_offset_start, repeat_times);
-        }
+        tvf_offset = _tvf_offsets()[_input_chunk_seek_rows + 1] - _outer_column_remain_repeat_times;
+        tvf_count = repeat_times;
+        _outer_indexes.insert(_outer_indexes.end(), repeat_times, _input_chunk_seek_rows);
 
         reserve_chunk_size -= repeat_times;
         _outer_column_remain_repeat_times -= repeat_times;
@@ -139,12 +130,18 @@ Status TableFunctionNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* e
         }
 
         if (reserve_chunk_size == 0) {
+            _append_output(&output_columns, tvf_offset, tvf_count, true);
             return build_chunk(chunk, output_columns);
         }
     }
 
     while (true) {
         if (_input_chunk_ptr == nullptr || !_table_function_result_eos) {
+            if (_input_chunk_ptr != nullptr) {
+                _append_output(&output_columns, tvf_offset, tvf_count, false);
+                _outer_indexes.clear();
+                tvf_count = 0;
+            }
             RETURN_IF_ERROR(get_next_input_chunk(state, eos));
             if (*eos) {
                 (*eos) = false;
@@ -153,31 +150,20 @@ Status TableFunctionNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* e
             }
         }
 
+        const auto& tvf_offsets = _tvf_offsets();
         while (_input_chunk_seek_rows < _input_chunk_ptr->num_rows()) {
-            int tvf_result_size = _table_function_result.second->get(_input_chunk_seek_rows + 1).get_int32() -
-                                  _table_function_result.second->get(_input_chunk_seek_rows).get_int32();
+            int tvf_result_size = tvf_offsets[_input_chunk_seek_rows + 1] - tvf_offsets[_input_chunk_seek_rows];
             int repeat_times = std::min(tvf_result_size, reserve_chunk_size);
             if (repeat_times == 0) {
                 ++_input_chunk_seek_rows;
                 continue;
             }
-            //Build outer data, repeat multiple times
-            for (int outer_idx = 0; outer_idx < _outer_slots.size(); ++outer_idx) {
-                ColumnPtr& input_column_ptr = _input_chunk_ptr->get_column_by_slot_id(_outer_slots[outer_idx]);
-                Datum value = input_column_ptr->get(_input_chunk_seek_rows);
-                if (value.is_null()) {
-                    //The output_columns[outer_idx] is must Nullable, if value has null
-                    down_cast<NullableColumn*>(output_columns[outer_idx].get())->append_nulls(repeat_times);
-                } else {
-                    output_columns[outer_idx]->append_value_multiple_times(&value, repeat_times);
-                }
-            }
-            //Build table function result
-            for (int result_idx = 0; result_idx < _fn_result_slots.size(); ++result_idx) {
-                output_columns[_outer_slots.size() + result_idx]->append(
-                        *(_table_function_result.first[result_idx]),
-                        _table_function_result.second->get(_input_chunk_seek_rows).get_int32(), repeat_times);
+            if (tvf_count == 0) {
+                tvf_offset = tvf_offsets[_input_chunk_seek_rows];
             }
+            DCHECK_EQ(tvf_offset + tvf_count, tvf_offsets[_input_chunk_seek_rows]);
+            tvf_count += repeat_times;
+            _outer_indexes.insert(_outer_indexes.end(), repeat_times, _input_chunk_seek_rows);
 
             reserve_chunk_size -= repeat_times;
 
@@ -187,11 +173,49 @@ Status TableFunctionNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* e
             }
 
             if (reserve_chunk_size == 0) {
+                _append_output(&output_columns, tvf_offset, tvf_count, true);
                 return build_chunk(chunk, output_columns);
             }
         }
 
+        // An output chunk made of the whole result of the input chunk shares the result columns, and is returned
+        // at once.
+        bool take_whole_result = reserve_chunk_size + tvf_count == chunk_size;
+        _append_output(&output_columns, tvf_offset, tvf_count, take_whole_result);
         _input_chunk_ptr = nullptr;
+        if (take_whole_result && tvf_count > 0) {
+            return build_chunk(chunk, output_columns);
+        }
+        _outer_indexes.clear();
+        tvf_count = 0;
+    }
+}
+
+const Buffer<uint32_t>& TableFunctionNode::_tvf_offsets() const {
+    return down_cast<const UInt32Column*>(_table_function_result.second.get())->get_data();
+}
+
+void TableFunctionNode::_append_output(std::vector<ColumnPtr>* output_columns, uint32_t tvf_offset,
+                                       uint32_t tvf_count, bool is_last_append) {
+    if (tvf_count == 0) {
+        return;
+    }
+    DCHECK_EQ(tvf_count, _outer_indexes.size());
+    for (int outer_idx = 0; outer_idx < _outer_slots.size(); ++outer_idx) {
+        const ColumnPtr& input_column = _input_chunk_ptr->get_column_by_slot_id(_outer_slots[outer_idx]);
+        (*output_columns)[outer_idx]->append_selective(*input_column, _outer_indexes.data(), 0, tvf_count);
+    }
+    for (int result_idx = 0; result_idx < _fn_result_slots.size(); ++result_idx) {
+        ColumnPtr& output_column = (*output_columns)[_outer_slots.size() + result_idx];
+        const ColumnPtr& tvf_column = _table_function_result.first[result_idx];
+        // The output made of the whole result of the table function, e.g. the elements of the arrays unnested,
+        // takes the result column without copying it. Only the last rows appended to an output chunk may share the
+        // column, which must never be appended to once it is shared.
+        if (is_last_append && output_column->empty() && tvf_offset == 0 && tvf_count == tvf_column->size()) {
+            output_column = tvf_column;
+        } else {
+            output_column->append(*tvf_column, tvf_offset, tvf_count);
+        }
     }
 }
 
@@ -33,6 +33,15 @@ public:
     Status get_next_input_chunk(RuntimeState* state, bool* eos);
 
 private:
+    // The offsets of the rows of the table function result of every input row.
+    const Buffer<uint32_t>& _tvf_offsets() const;
+
+    // Append the rows of the input chunk in _outer_indexes to the outer columns, and the rows of the table function
+    // result in [tvf_offset, tvf_offset + tvf_count) to the result columns. |is_last_append| tells the output
+    // chunk is built right after, so the result columns may be shared with it.
+    void _append_output(std::vector<ColumnPtr>* output_columns, uint32_t tvf_offset, uint32_t tvf_count,
+                        bool is_last_append);
+
     const TableFunction* _table_function;
 
     //Slots of output by table function
@@ -50,6 +59,8 @@ private:
     int _input_chunk_seek_rows;
     //The current outer line needs to be repeated several times
     int _outer_column_remain_repeat_times;
+    //The rows of the input chunk replicated to the outer columns of the output chunk
+    std::vector<uint32_t> _outer_indexes;
     //table function result
     std::pair<Columns, ColumnPtr> _table_function_result;
     //table function return result end ?
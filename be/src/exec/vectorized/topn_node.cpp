@@ -2,19 +2,30 @@
 
 #include "exec/vectorized/topn_node.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "column/column_helper.h"
+#include "common/config.h"
+#include "exec/pipeline/exchange/local_exchange.h"
+#include "exec/pipeline/exchange/local_exchange_sink_operator.h"
+#include "exec/pipeline/exchange/local_exchange_source_operator.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/sort/local_merge_sort_source_operator.h"
+#include "exec/pipeline/sort/partition_sort_sink_operator.h"
 #include "exec/vectorized/chunks_sorter.h"
 #include "exec/vectorized/chunks_sorter_full_sort.h"
 #include "exec/vectorized/chunks_sorter_topn.h"
 #include "gutil/casts.h"
+#include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
 
 namespace starrocks::vectorized {
 
 TopNNode::TopNNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
-        : ExecNode(pool, tnode, descs) {
+        : ExecNode(pool, tnode, descs), _tnode(tnode) {
     _offset = tnode.sort_node.__isset.offset ? tnode.sort_node.offset : 0;
     _materialized_tuple_desc = nullptr;
     _sort_timer = nullptr;
@@ -98,7 +109,7 @@ Status TopNNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
 
     {
         SCOPED_TIMER(_sort_timer);
-        _chunks_sorter->get_next(chunk, eos);
+        RETURN_IF_ERROR(_chunks_sorter->get_next(chunk, eos));
     }
     if (*eos) {
         _chunks_sorter = nullptr;
@@ -141,6 +152,12 @@ Status TopNNode::_consume_chunks(RuntimeState* state, ExecNode* child) {
 
     bool eos = false;
     _chunks_sorter->setup_runtime(mem_tracker(), runtime_profile(), "ChunksSorter");
+    SpillManager* spill_manager = state->spill_manager();
+    if (_limit <= 0 && config::sort_spill_mem_limit_percent > 0 && spill_manager != nullptr &&
+        spill_manager->spill_enabled()) {
+        down_cast<ChunksSorterFullSort*>(_chunks_sorter.get())
+                ->set_spill(spill_manager, state->query_id(), config::sort_spill_mem_limit_percent, runtime_profile());
+    }
     do {
         RETURN_IF_CANCELLED(state);
         ChunkPtr chunk;
@@ -151,7 +168,8 @@ Status TopNNode::_consume_chunks(RuntimeState* state, ExecNode* child) {
         }
         timer.start();
         if (chunk != nullptr && chunk->num_rows() > 0) {
-            ChunkPtr materialize_chunk = _materialize_chunk_before_sort(chunk.get());
+            ChunkPtr materialize_chunk = ChunksSorter::materialize_chunk_before_sort(
+                    chunk.get(), _materialized_tuple_desc, _sort_exec_exprs, _order_by_types);
             RETURN_IF_ERROR(_chunks_sorter->update(state, materialize_chunk));
         }
     } while (!eos);
@@ -159,56 +177,85 @@ Status TopNNode::_consume_chunks(RuntimeState* state, ExecNode* child) {
     return Status::OK();
 }
 
-ChunkPtr TopNNode::_materialize_chunk_before_sort(Chunk* chunk) {
-    ChunkPtr materialize_chunk = std::make_shared<Chunk>();
-
-    // materialize all sorting columns: replace old columns with evaluated columns
-    const size_t row_num = chunk->num_rows();
-    const auto& slots_in_row_descriptor = _materialized_tuple_desc->slots();
-    const auto& slots_in_sort_exprs = _sort_exec_exprs.sort_tuple_slot_expr_ctxs();
-
-    DCHECK_EQ(slots_in_row_descriptor.size(), slots_in_sort_exprs.size());
-
-    for (size_t i = 0; i < slots_in_sort_exprs.size(); ++i) {
-        ExprContext* expr_ctx = slots_in_sort_exprs[i];
-        ColumnPtr col = expr_ctx->evaluate(chunk);
-        if (col->is_constant()) {
-            if (col->is_nullable()) {
-                // Constant null column doesn't have original column data type information,
-                // so replace it by a nullable column of original data type filled with all NULLs.
-                ColumnPtr new_col = ColumnHelper::create_column(_order_by_types[i].type_desc, true);
-                new_col->append_nulls(row_num);
-                materialize_chunk->append_column(new_col, slots_in_row_descriptor[i]->id());
-            } else {
-                // Case 1: an expression may generate a constant column which will be reused by
-                // another call of evaluate(). We clone its data column to resize it as same as
-                // the size of the chunk, so that Chunk::num_rows() can return the right number
-                // if this ConstColumn is the first column of the chunk.
-                // Case 2: an expression may generate a constant column for one Chunk, but a
-                // non-constant one for another Chunk, we replace them all by non-constant columns.
-                auto* const_col = down_cast<ConstColumn*>(col.get());
-                const auto& data_col = const_col->data_column();
-                auto new_col = data_col->clone_empty();
-                new_col->append(*data_col, 0, 1);
-                new_col->assign(row_num, 0);
-                if (_order_by_types[i].is_nullable) {
-                    ColumnPtr null_col =
-                            NullableColumn::create(ColumnPtr(new_col.release()), NullColumn::create(row_num, 0));
-                    materialize_chunk->append_column(null_col, slots_in_row_descriptor[i]->id());
-                } else {
-                    materialize_chunk->append_column(ColumnPtr(new_col.release()), slots_in_row_descriptor[i]->id());
-                }
-            }
-        } else {
-            // When get a non-null column, but it should be nullable, we wrap it with a NullableColumn.
-            if (!col->is_nullable() && _order_by_types[i].is_nullable) {
-                col = NullableColumn::create(col, NullColumn::create(col->size(), 0));
-            }
-            materialize_chunk->append_column(col, slots_in_row_descriptor[i]->id());
+pipeline::OpFactories TopNNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    OpFactories operators_sink_with_sort = _children[0]->decompose_to_pipeline(context);
+    // Every sink driver sorts its own input in parallel, and the sorted rows of all the sink drivers
+    // are merged in order by the source.
+    auto sort_context = std::make_shared<SortContext>();
+    operators_sink_with_sort.emplace_back(std::make_shared<PartitionSortSinkOperatorFactory>(
+            context->next_operator_id(), id(), _tnode, _materialized_tuple_desc, _order_by_types,
+            child(0)->row_desc(), _row_descriptor, _offset, _limit, sort_context));
+    context->add_pipeline(operators_sink_with_sort);
+
+    OpFactories operators_source_with_sort;
+    operators_source_with_sort.emplace_back(std::make_shared<LocalMergeSortSourceOperatorFactory>(
+            context->next_operator_id(), id(), _tnode, child(0)->row_desc(), _row_descriptor, _offset, sort_context));
+    if (limit() != -1) {
+        operators_source_with_sort.emplace_back(
+                std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return operators_source_with_sort;
+}
+
+void TopNNode::decompose_to_partitioned_sort_pipeline(pipeline::PipelineBuilderContext* context,
+                                                      const std::vector<TExpr>& partition_exprs,
+                                                      const pipeline::SortContextPtr& sort_context) {
+    using namespace pipeline;
+    // The shuffle is before the materialization of the sort, so the partition exprs are evaluated over the input.
+    std::vector<TExpr> input_partition_exprs;
+    std::vector<ExprContext*> partition_expr_ctxs;
+    if (_rewrite_to_input_exprs(partition_exprs, &input_partition_exprs)) {
+        Status status = Expr::create_expr_trees(_pool, input_partition_exprs, &partition_expr_ctxs);
+        if (!status.ok()) {
+            LOG(WARNING) << "Failed to create the partition exprs of the sort: " << status.to_string();
+            partition_expr_ctxs.clear();
         }
     }
 
-    return materialize_chunk;
+    OpFactories operators_with_shuffle = _children[0]->decompose_to_pipeline(context);
+    auto memory_manager = std::make_shared<LocalExchangeMemoryManager>(
+            config::pipeline_local_exchange_buffer_bytes_per_driver * context->driver_instance_count());
+    auto local_shuffle_source =
+            std::make_shared<LocalExchangeSourceOperatorFactory>(context->next_operator_id(), memory_manager);
+    auto local_shuffle = std::make_shared<PartitionExchanger>(memory_manager, local_shuffle_source.get(), true,
+                                                              partition_expr_ctxs, child(0)->row_desc());
+    operators_with_shuffle.emplace_back(
+            std::make_shared<LocalExchangeSinkOperatorFactory>(context->next_operator_id(), local_shuffle));
+    context->add_pipeline(operators_with_shuffle);
+
+    OpFactories operators_sink_with_sort;
+    operators_sink_with_sort.emplace_back(std::move(local_shuffle_source));
+    operators_sink_with_sort.emplace_back(std::make_shared<PartitionSortSinkOperatorFactory>(
+            context->next_operator_id(), id(), _tnode, _materialized_tuple_desc, _order_by_types,
+            child(0)->row_desc(), _row_descriptor, _offset, _limit, sort_context));
+    context->add_pipeline(operators_sink_with_sort);
+}
+
+bool TopNNode::_rewrite_to_input_exprs(const std::vector<TExpr>& exprs, std::vector<TExpr>* input_exprs) const {
+    const TSortInfo& sort_info = _tnode.sort_node.sort_info;
+    if (!sort_info.__isset.sort_tuple_slot_exprs) {
+        *input_exprs = exprs;
+        return true;
+    }
+
+    // The i-th slot of the materialized tuple is evaluated by the i-th sort tuple slot expr.
+    const auto& slots = _materialized_tuple_desc->slots();
+    DCHECK_EQ(slots.size(), sort_info.sort_tuple_slot_exprs.size());
+    for (const TExpr& expr : exprs) {
+        if (expr.nodes.size() != 1 || expr.nodes[0].node_type != TExprNodeType::SLOT_REF ||
+            expr.nodes[0].slot_ref.tuple_id != _materialized_tuple_desc->id()) {
+            return false;
+        }
+        const TExprNode& root = expr.nodes[0];
+        auto iter = std::find_if(slots.begin(), slots.end(),
+                                 [&root](const SlotDescriptor* slot) { return slot->id() == root.slot_ref.slot_id; });
+        if (iter == slots.end()) {
+            return false;
+        }
+        input_exprs->emplace_back(sort_info.sort_tuple_slot_exprs[iter - slots.begin()]);
+    }
+    return true;
 }
 
 } // namespace starrocks::vectorized
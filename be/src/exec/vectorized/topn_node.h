@@ -3,12 +3,12 @@
 #pragma once
 
 #include "exec/exec_node.h"
+#include "exec/pipeline/sort/sort_context.h"
 #include "exec/sort_exec_exprs.h"
+#include "exec/vectorized/chunks_sorter.h"
 
 namespace starrocks::vectorized {
 
-class ChunksSorter;
-
 // Node for in-memory TopN (ORDER BY ... LIMIT).
 //
 // It sorts rows in a batch of chunks in turn at the open stage,
@@ -27,10 +27,25 @@ public:
 
     Status close(RuntimeState* state) override;
 
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
+
+    // Add the pipeline which shuffles the input by the hash of |partition_exprs| among the drivers and sorts
+    // the rows of each driver into its own ChunksSorter of |sort_context|, so all the rows of a partition are
+    // sorted by one driver, e.g. for the window functions. |partition_exprs| are bound to the output of this
+    // node, all the rows are sorted by one driver if any of them can't be evaluated before sorting.
+    void decompose_to_partitioned_sort_pipeline(pipeline::PipelineBuilderContext* context,
+                                                const std::vector<TExpr>& partition_exprs,
+                                                const pipeline::SortContextPtr& sort_context);
+
 private:
+    // Rewrite |exprs| bound to the output of this node to the exprs over the input, return false if any of them
+    // isn't a slot of the materialized tuple.
+    bool _rewrite_to_input_exprs(const std::vector<TExpr>& exprs, std::vector<TExpr>* input_exprs) const;
+
     Status _consume_chunks(RuntimeState* state, ExecNode* child);
-    ChunkPtr _materialize_chunk_before_sort(Chunk* chunk);
 
+    const TPlanNode _tnode;
     int64_t _offset;
 
     // _sort_exec_exprs contains the ordering expressions
@@ -38,10 +53,6 @@ private:
     std::vector<bool> _is_asc_order;
     std::vector<bool> _is_null_first;
 
-    struct OrderByType {
-        TypeDescriptor type_desc;
-        bool is_nullable;
-    };
     std::vector<OrderByType> _order_by_types;
 
     // Cached descriptor for the materialized tuple. Assigned in Prepare().
@@ -4,6 +4,14 @@
 
 #include "column/column_helper.h"
 #include "column/nullable_column.h"
+#include "common/config.h"
+#include "exec/pipeline/exchange/local_exchange.h"
+#include "exec/pipeline/exchange/local_exchange_sink_operator.h"
+#include "exec/pipeline/exchange/local_exchange_source_operator.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/set/union_const_source_operator.h"
+#include "exec/pipeline/set/union_passthrough_operator.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
 
@@ -11,7 +19,8 @@ namespace starrocks::vectorized {
 UnionNode::UnionNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
         : ExecNode(pool, tnode, descs),
           _first_materialized_child_idx(tnode.union_node.first_materialized_child_idx),
-          _tuple_id(tnode.union_node.tuple_id) {}
+          _tuple_id(tnode.union_node.tuple_id),
+          _tnode(tnode) {}
 
 Status UnionNode::init(const TPlanNode& tnode, RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::init(tnode, state));
@@ -222,9 +231,9 @@ void UnionNode::_move_passthrough_chunk(ChunkPtr& src_chunk, ChunkPtr& dest_chun
             // There may be multiple DestSlotId mapped to the same SrcSlotId,
             // so here we have to decide whether you can MoveColumn according to this situation
             if (slot_item.ref_count <= 1) {
-                _move_column(dest_chunk, column, dest_slot, src_chunk->num_rows());
+                move_column(dest_chunk, column, dest_slot, src_chunk->num_rows());
             } else {
-                _clone_column(dest_chunk, column, dest_slot, src_chunk->num_rows());
+                clone_column(dest_chunk, column, dest_slot, src_chunk->num_rows());
             }
         }
     } else {
@@ -235,7 +244,7 @@ void UnionNode::_move_passthrough_chunk(ChunkPtr& src_chunk, ChunkPtr& dest_chun
         for (auto* src_slot : tuple_descs[0]->slots()) {
             auto* dest_slot = _tuple_desc->slots()[index++];
             ColumnPtr& column = src_chunk->get_column_by_slot_id(src_slot->id());
-            _move_column(dest_chunk, column, dest_slot, src_chunk->num_rows());
+            move_column(dest_chunk, column, dest_slot, src_chunk->num_rows());
         }
     }
 }
@@ -245,7 +254,7 @@ void UnionNode::_move_materialize_chunk(ChunkPtr& src_chunk, ChunkPtr& dest_chun
         auto* dest_slot = _tuple_desc->slots()[i];
         ColumnPtr column = _child_expr_lists[_child_idx][i]->evaluate(src_chunk.get());
 
-        _move_column(dest_chunk, column, dest_slot, src_chunk->num_rows());
+        move_column(dest_chunk, column, dest_slot, src_chunk->num_rows());
     }
 }
 
@@ -254,14 +263,14 @@ Status UnionNode::_move_const_chunk(ChunkPtr& dest_chunk) {
         ColumnPtr column = _const_expr_lists[_const_expr_list_idx][i]->evaluate(nullptr);
         auto* dest_slot = _tuple_desc->slots()[i];
 
-        _move_column(dest_chunk, column, dest_slot, 1);
+        move_column(dest_chunk, column, dest_slot, 1);
     }
 
     return Status::OK();
 }
 
-void UnionNode::_clone_column(ChunkPtr& dest_chunk, const ColumnPtr& src_column, const SlotDescriptor* dest_slot,
-                              size_t row_count) {
+void UnionNode::clone_column(ChunkPtr& dest_chunk, const ColumnPtr& src_column, const SlotDescriptor* dest_slot,
+                             size_t row_count) {
     if (src_column->is_nullable() || !dest_slot->is_nullable()) {
         dest_chunk->append_column(src_column->clone_shared(), dest_slot->id());
     } else {
@@ -271,8 +280,8 @@ void UnionNode::_clone_column(ChunkPtr& dest_chunk, const ColumnPtr& src_column,
     }
 }
 
-void UnionNode::_move_column(ChunkPtr& dest_chunk, ColumnPtr& src_column, const SlotDescriptor* dest_slot,
-                             size_t row_count) {
+void UnionNode::move_column(ChunkPtr& dest_chunk, ColumnPtr& src_column, const SlotDescriptor* dest_slot,
+                            size_t row_count) {
     if (src_column->is_nullable()) {
         if (src_column->is_constant()) {
             auto nullable_column = ColumnHelper::create_column(dest_slot->type(), true);
@@ -302,4 +311,57 @@ void UnionNode::_move_column(ChunkPtr& dest_chunk, ColumnPtr& src_column, const
     }
 }
 
+pipeline::OpFactories UnionNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    // The children run in parallel, each of them converts its chunks into the ones of the output tuple and passes
+    // them to a shared passthrough local exchange, which feeds the operators after the union without copying.
+    auto memory_manager = std::make_shared<LocalExchangeMemoryManager>(
+            config::pipeline_local_exchange_buffer_bytes_per_driver * context->driver_instance_count());
+    auto union_source =
+            std::make_shared<LocalExchangeSourceOperatorFactory>(context->next_operator_id(), memory_manager);
+    auto passthrough = std::make_shared<PassthroughExchanger>(memory_manager, union_source.get());
+
+    const auto& output_slots = row_desc().tuple_descriptors()[0]->slots();
+    for (size_t i = 0; i < _children.size(); i++) {
+        UnionPassthroughOperator::SlotMap slot_map;
+        std::vector<TExpr> t_exprs;
+        if (i >= static_cast<size_t>(_first_materialized_child_idx)) {
+            t_exprs = _tnode.union_node.result_expr_lists[i];
+        } else if (!_pass_through_slot_maps.empty()) {
+            slot_map = _pass_through_slot_maps[i];
+        } else {
+            // For backward compatibility, the i-th slot of the child is the one of the i-th output slot.
+            const auto& child_slots = child(i)->row_desc().tuple_descriptors()[0]->slots();
+            for (size_t j = 0; j < child_slots.size(); j++) {
+                slot_map[output_slots[j]->id()] = {child_slots[j]->id(), 1};
+            }
+        }
+
+        OpFactories operators_with_union = child(i)->decompose_to_pipeline(context);
+        operators_with_union.emplace_back(std::make_shared<UnionPassthroughOperatorFactory>(
+                context->next_operator_id(), id(), _tuple_id, std::move(slot_map), std::move(t_exprs),
+                child(i)->row_desc()));
+        operators_with_union.emplace_back(
+                std::make_shared<LocalExchangeSinkOperatorFactory>(context->next_operator_id(), passthrough));
+        context->add_pipeline(operators_with_union);
+    }
+
+    if (!_tnode.union_node.const_expr_lists.empty()) {
+        OpFactories operators_with_const;
+        operators_with_const.emplace_back(std::make_shared<UnionConstSourceOperatorFactory>(
+                context->next_operator_id(), id(), _tuple_id, _tnode.union_node.const_expr_lists, row_desc()));
+        operators_with_const.emplace_back(
+                std::make_shared<LocalExchangeSinkOperatorFactory>(context->next_operator_id(), passthrough));
+        context->add_pipeline(operators_with_const);
+    }
+
+    OpFactories operators_source_with_union;
+    operators_source_with_union.emplace_back(std::move(union_source));
+    if (limit() != -1) {
+        operators_source_with_union.emplace_back(
+                std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return operators_source_with_union;
+}
+
 } // namespace starrocks::vectorized
@@ -19,12 +19,25 @@ public:
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
     Status close(RuntimeState* state) override;
 
-private:
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
+
+    // The source slot of a slot of the output tuple, and the number of the output slots sharing the source slot.
     struct SlotItem {
         SlotId slot_id;
         size_t ref_count;
     };
 
+    // Append |src_column| of |row_count| rows into |dest_chunk| as the column of |dest_slot|, it's wrapped into a
+    // nullable column if |dest_slot| is nullable. move_column() shares |src_column| and expands it if it's constant,
+    // clone_column() copies it, which is shared by the other output slots.
+    static void clone_column(ChunkPtr& dest_chunk, const ColumnPtr& src_column, const SlotDescriptor* dest_slot,
+                             size_t row_count);
+
+    static void move_column(ChunkPtr& dest_chunk, ColumnPtr& src_column, const SlotDescriptor* dest_slot,
+                            size_t row_count);
+
+private:
     void _convert_pass_through_slot_map(const std::map<SlotId, SlotId>& slot_map);
 
     Status _get_next_passthrough(RuntimeState* state, ChunkPtr* chunk);
@@ -35,12 +48,6 @@ private:
     void _move_materialize_chunk(ChunkPtr& src_chunk, ChunkPtr& dest_chunk);
     Status _move_const_chunk(ChunkPtr& dest_chunk);
 
-    static void _clone_column(ChunkPtr& dest_chunk, const ColumnPtr& src_column, const SlotDescriptor* dest_slot,
-                              size_t row_count);
-
-    static void _move_column(ChunkPtr& dest_chunk, ColumnPtr& src_column, const SlotDescriptor* dest_slot,
-                             size_t row_count);
-
     bool _has_more_passthrough() const { return _child_idx < _first_materialized_child_idx; }
 
     bool _has_more_materialized() const {
@@ -66,6 +73,8 @@ private:
     bool _child_eos = false;
     const int _tuple_id = 0;
     const TupleDescriptor* _tuple_desc = nullptr;
+    // The const and result expr lists are created again by the pipeline operators.
+    const TPlanNode _tnode;
 };
 
 } // namespace starrocks::vectorized
\ No newline at end of file
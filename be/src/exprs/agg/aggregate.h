@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "column/column.h"
 
 namespace starrocks_udf {
@@ -87,6 +89,8 @@ public:
     virtual size_t alignof_size() const = 0;
     virtual void create(AggDataPtr ptr) const = 0;
     virtual void destroy(AggDataPtr ptr) const = 0;
+    // Whether destroy() is a no-op, so the states of the function are freed in bulk with their MemPool.
+    virtual bool is_trivially_destructible() const = 0;
 
     // Contains a loop with calls to "update" function.
     // You can collect arguments into array "states"
@@ -110,6 +114,16 @@ public:
                                            int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                            int64_t frame_end) const {}
 
+    // For sliding window functions
+    // Whether the rows updated into a state could be removed from it by remove_batch_single_state, so the
+    // state of a sliding frame is updated by the rows leaving and entering the frame, instead of all of its rows.
+    virtual bool is_removable() const { return false; }
+
+    // Remove the rows [remove_start, remove_end), which have been updated into |state|, from |state|.
+    // The rows [remove_end, frame_end) remain in the frame.
+    virtual void remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
+                                           int64_t remove_start, int64_t remove_end, int64_t frame_end) const {}
+
     // Contains a loop with calls to "merge" function.
     // You can collect arguments into array "states"
     // and do a single call to "merge_batch" for devirtualization and inlining.
@@ -132,6 +146,8 @@ public:
 
     void destroy(AggDataPtr ptr) const final { data(ptr).~State(); }
 
+    bool is_trivially_destructible() const final { return std::is_trivially_destructible_v<State>; }
+
     size_t size() const final { return sizeof(State); }
 
     size_t alignof_size() const final { return alignof(State); }
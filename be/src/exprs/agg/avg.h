@@ -94,6 +94,24 @@ public:
         this->data(state).count++;
     }
 
+    // Like sum, the float averages are not removable.
+    bool is_removable() const override { return !pt_is_float<PT> && !pt_is_binary<PT>; }
+
+    void remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
+                                   int64_t remove_start, int64_t remove_end, int64_t frame_end) const override {
+        [[maybe_unused]] const InputColumnType* column = down_cast<const InputColumnType*>(columns[0]);
+        for (size_t i = remove_start; i < remove_end; ++i) {
+            if constexpr (pt_is_datetime<PT>) {
+                this->data(state).sum -= column->get_data()[i].to_unix_second();
+            } else if constexpr (pt_is_date<PT>) {
+                this->data(state).sum -= column->get_data()[i].julian();
+            } else if constexpr (pt_is_decimalv2<PT> || pt_is_arithmetic<PT> || pt_is_decimal<PT>) {
+                this->data(state).sum -= column->get_data()[i];
+            }
+        }
+        this->data(state).count -= (remove_end - remove_start);
+    }
+
     void update_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
                                    int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                    int64_t frame_end) const override {
@@ -21,6 +21,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include "column/object_column.h"
 #include "column/vectorized_fwd.h"
 #include "exprs/agg/aggregate.h"
@@ -29,20 +32,41 @@
 
 namespace starrocks::vectorized {
 
-class BitmapUnionAggregateFunction final
-        : public AggregateFunctionBatchHelper<BitmapValue, BitmapUnionAggregateFunction> {
+// The union of the bitmaps of a chunk, the bitmaps of each state are unioned by one BitmapValue::fast_union.
+template <typename Derived>
+class BitmapUnionAggregateFunctionBase : public AggregateFunctionBatchHelper<BitmapValue, Derived> {
 public:
     void update(FunctionContext* ctx, const Column** columns, AggDataPtr state, size_t row_num) const override {
         const BitmapColumn* col = down_cast<const BitmapColumn*>(columns[0]);
         this->data(state) |= *(col->get_object(row_num));
     }
 
+    void update_batch(FunctionContext* ctx, size_t batch_size, size_t state_offset, const Column** columns,
+                      AggDataPtr* states) const override {
+        union_batch(batch_size, state_offset, columns[0], states);
+    }
+
+    void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
+                                   AggDataPtr state) const override {
+        union_batch_single_state(batch_size, columns[0], state);
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
         const BitmapColumn* col = down_cast<const BitmapColumn*>(column);
         DCHECK(col->is_object());
         this->data(state) |= *(col->get_object(row_num));
     }
 
+    void merge_batch(FunctionContext* ctx, size_t batch_size, size_t state_offset, const Column* column,
+                     AggDataPtr* states) const override {
+        union_batch(batch_size, state_offset, column, states);
+    }
+
+    void merge_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column* column,
+                                  AggDataPtr state) const override {
+        union_batch_single_state(batch_size, column, state);
+    }
+
     void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const override {
         BitmapColumn* col = down_cast<BitmapColumn*>(to);
         col->append(&(this->data(state)));
@@ -52,6 +76,43 @@ public:
         *dst = std::move(src[0]);
     }
 
+private:
+    void union_batch_single_state(size_t batch_size, const Column* column, AggDataPtr state) const {
+        const BitmapColumn* col = down_cast<const BitmapColumn*>(column);
+        std::vector<const BitmapValue*> values(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            values[i] = col->get_object(i);
+        }
+        this->data(state).fast_union(values);
+    }
+
+    // The rows are grouped by their states, then each group is unioned at once.
+    void union_batch(size_t batch_size, size_t state_offset, const Column* column, AggDataPtr* states) const {
+        const BitmapColumn* col = down_cast<const BitmapColumn*>(column);
+        std::vector<std::pair<AggDataPtr, size_t>> rows(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            rows[i] = {states[i] + state_offset, i};
+        }
+        std::sort(rows.begin(), rows.end());
+
+        std::vector<const BitmapValue*> values;
+        for (size_t begin = 0, end = 0; begin < batch_size; begin = end) {
+            AggDataPtr state = rows[begin].first;
+            values.clear();
+            for (end = begin; end < batch_size && rows[end].first == state; ++end) {
+                values.push_back(col->get_object(rows[end].second));
+            }
+            if (values.size() == 1) {
+                this->data(state) |= *values[0];
+            } else {
+                this->data(state).fast_union(values);
+            }
+        }
+    }
+};
+
+class BitmapUnionAggregateFunction final : public BitmapUnionAggregateFunctionBase<BitmapUnionAggregateFunction> {
+public:
     void finalize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const override {
         BitmapColumn* col = down_cast<BitmapColumn*>(to);
         col->append(&this->data(state));
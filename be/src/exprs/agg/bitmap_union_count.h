@@ -24,33 +24,15 @@
 #include "column/object_column.h"
 #include "column/vectorized_fwd.h"
 #include "exprs/agg/aggregate.h"
+#include "exprs/agg/bitmap_union.h"
 #include "gutil/casts.h"
 #include "util/bitmap_value.h"
 
 namespace starrocks::vectorized {
 
 class BitmapUnionCountAggregateFunction final
-        : public AggregateFunctionBatchHelper<BitmapValue, BitmapUnionCountAggregateFunction> {
+        : public BitmapUnionAggregateFunctionBase<BitmapUnionCountAggregateFunction> {
 public:
-    void update(FunctionContext* ctx, const Column** columns, AggDataPtr state, size_t row_num) const override {
-        const BitmapColumn* col = down_cast<const BitmapColumn*>(columns[0]);
-        this->data(state) |= *(col->get_object(row_num));
-    }
-
-    void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
-        const BitmapColumn* col = down_cast<const BitmapColumn*>(column);
-        this->data(state) |= *(col->get_object(row_num));
-    }
-
-    void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const override {
-        BitmapColumn* col = down_cast<BitmapColumn*>(to);
-        col->append(&(this->data(state)));
-    }
-
-    void convert_to_serialize_format(const Columns& src, size_t chunk_size, ColumnPtr* dst) const override {
-        *dst = std::move(src[0]);
-    }
-
     void finalize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const override {
         DCHECK(to->is_numeric());
         down_cast<Int64Column*>(to)->append(this->data(state).cardinality());
@@ -23,6 +23,8 @@
 
 #include <limits>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "column/fixed_length_column.h"
 #include "column/hash_set.h"
@@ -33,6 +35,7 @@
 #include "runtime/mem_tracker.h"
 #include "udf/udf_internal.h"
 #include "util/phmap/phmap_dump.h"
+#include "util/unaligned_access.h"
 
 namespace starrocks::vectorized {
 
@@ -41,38 +44,149 @@ enum AggDistinctType { COUNT = 0, SUM = 1 };
 template <PrimitiveType PT, typename = guard::Guard>
 struct DistinctAggregateState {};
 
+// The values of a distinct state are kept in one hash set while there are few of them. Once there are more than
+// kPartitionThreshold values, they are split into kNumPartitions sets by the hashes of the values. The partitions
+// are disjoint, so a big state is rehashed, serialized and merged one partition at a time, every step works on a
+// table a kNumPartitions-th the size, and the distinct count is the sum of the sizes of the partitions.
+template <typename Set>
+class PartitionedHashSet {
+public:
+    static constexpr size_t kNumPartitionBits = 4;
+    static constexpr size_t kNumPartitions = 1 << kNumPartitionBits;
+    static constexpr size_t kPartitionThreshold = 1 << 16;
+
+    bool is_partitioned() const { return !_partitions.empty(); }
+
+    size_t num_sets() const { return is_partitioned() ? kNumPartitions : 1; }
+    Set& set(size_t i) { return is_partitioned() ? _partitions[i] : _set; }
+    const Set& set(size_t i) const { return is_partitioned() ? _partitions[i] : _set; }
+
+    size_t size() const {
+        size_t size = _set.size();
+        for (const auto& partition : _partitions) {
+            size += partition.size();
+        }
+        return size;
+    }
+
+    // Call |f| with the constructor of the slot if |key| is new, see raw_hash_set::lazy_emplace.
+    template <typename K, typename F>
+    void lazy_emplace(const K& key, F&& f) {
+        if (!is_partitioned()) {
+            _set.lazy_emplace(key, std::forward<F>(f));
+            return;
+        }
+        size_t hash = _set.hash_function()(key);
+        _partitions[partition_of(hash)].lazy_emplace_with_hash(key, hash, std::forward<F>(f));
+    }
+
+    template <typename F>
+    void for_each(F&& f) const {
+        for (size_t i = 0; i < num_sets(); i++) {
+            for (const auto& key : set(i)) {
+                f(key);
+            }
+        }
+    }
+
+    void try_partition() {
+        if (!is_partitioned() && _set.size() > kPartitionThreshold) {
+            partition();
+        }
+    }
+
+    void partition() {
+        if (is_partitioned()) {
+            return;
+        }
+        _partitions.resize(kNumPartitions);
+        for (auto& partition : _partitions) {
+            partition.reserve(_set.size() / kNumPartitions);
+        }
+        const auto& hasher = _set.hash_function();
+        for (const auto& key : _set) {
+            _partitions[partition_of(hasher(key))].insert(key);
+        }
+        Set().swap(_set);
+    }
+
+private:
+    // The sets use the low bits of the hashes, which may be all the bits of them, e.g. the 32-bit crc hashes
+    // of the slices, so the partitions are chosen by the high bits of the remixed hashes.
+    static size_t partition_of(size_t hash) { return phmap_mix<8>()(hash) >> (64 - kNumPartitionBits); }
+
+    Set _set;
+    std::vector<Set> _partitions;
+};
+
 template <PrimitiveType PT>
 struct DistinctAggregateState<PT, FixedLengthPTGuard<PT>> {
     using T = RunTimeCppType<PT>;
     using SumType = RunTimeCppType<SumResultPT<PT>>;
 
+    // The first 8 bytes of a serialized partitioned state, which are the size of the set otherwise.
+    static constexpr uint64_t kPartitionedMagic = ~0ULL;
+
     size_t update(T key) {
-        auto pair = set.insert(key);
-        return pair.second * phmap::item_serialize_size<HashSet<T>>::value;
+        bool inserted = false;
+        set.lazy_emplace(key, [&](const auto& ctor) {
+            ctor(key);
+            inserted = true;
+        });
+        set.try_partition();
+        return inserted * phmap::item_serialize_size<HashSet<T>>::value;
     }
 
     int64_t disctint_count() const { return set.size(); }
 
-    size_t serialize_size() const { return set.dump_bound(); }
+    // A partitioned state is serialized as the magic, the number of the partitions and the dumps of them.
+    size_t serialize_size() const {
+        if (!set.is_partitioned()) {
+            return set.set(0).dump_bound();
+        }
+        size_t size = sizeof(uint64_t) * 2;
+        for (size_t i = 0; i < set.num_sets(); i++) {
+            size += set.set(i).dump_bound();
+        }
+        return size;
+    }
 
     void serialize(uint8_t* dst) const {
         phmap::InMemoryOutput output(reinterpret_cast<char*>(dst));
-        set.dump(output);
-        DCHECK(output.length() == set.dump_bound());
+        if (set.is_partitioned()) {
+            output.dump(kPartitionedMagic);
+            output.dump(static_cast<uint64_t>(set.num_sets()));
+        }
+        for (size_t i = 0; i < set.num_sets(); i++) {
+            set.set(i).dump(output);
+        }
+        DCHECK(output.length() <= serialize_size());
     }
 
     size_t deserialize_and_merge(const uint8_t* src, size_t len) {
-        phmap::InMemoryInput input(reinterpret_cast<const char*>(src));
         auto old_size = set.size();
-        if (old_size == 0) {
-            set.load(input);
-            return set.size() * phmap::item_serialize_size<HashSet<T>>::value;
+        if (len >= sizeof(uint64_t) && unaligned_load<uint64_t>(src) == kPartitionedMagic) {
+            phmap::InMemoryInput input(reinterpret_cast<const char*>(src + sizeof(uint64_t)));
+            uint64_t num_partitions = 0;
+            input.load(&num_partitions);
+            set.partition();
+            for (size_t i = 0; i < num_partitions; i++) {
+                if (num_partitions == set.num_sets()) {
+                    _load_and_merge(&set.set(i), input);
+                } else {
+                    _load_and_insert(input);
+                }
+            }
         } else {
-            HashSet<T> set_src;
-            set_src.load(input);
-            set.merge(set_src);
-            return (set.size() - old_size) * phmap::item_serialize_size<HashSet<T>>::value;
+            phmap::InMemoryInput input(reinterpret_cast<const char*>(src));
+            if (!set.is_partitioned()) {
+                _load_and_merge(&set.set(0), input);
+                set.try_partition();
+            } else {
+                _load_and_insert(input);
+            }
         }
+        return (set.size() - old_size) * phmap::item_serialize_size<HashSet<T>>::value;
     }
 
     SumType sum_distinct() const {
@@ -82,13 +196,32 @@ struct DistinctAggregateState<PT, FixedLengthPTGuard<PT>> {
             return sum;
         }
 
-        for (auto& key : set) {
-            sum += key;
-        }
+        set.for_each([&](const T& key) { sum += key; });
         return sum;
     }
 
-    HashSet<T> set;
+    PartitionedHashSet<HashSet<T>> set;
+
+private:
+    // Merge the next dump of |input| into |dst|, which holds the same values or the same partition of them.
+    static void _load_and_merge(HashSet<T>* dst, phmap::InMemoryInput& input) {
+        if (dst->empty()) {
+            dst->load(input);
+        } else {
+            HashSet<T> src;
+            src.load(input);
+            dst->merge(src);
+        }
+    }
+
+    void _load_and_insert(phmap::InMemoryInput& input) {
+        HashSet<T> src;
+        src.load(input);
+        for (const auto& key : src) {
+            set.lazy_emplace(key, [&](const auto& ctor) { ctor(key); });
+        }
+        set.try_partition();
+    }
 };
 
 template <PrimitiveType PT>
@@ -99,12 +232,13 @@ struct DistinctAggregateState<PT, BinaryPTGuard<PT>> {
     size_t update(MemPool* mem_pool, Slice raw_key) {
         size_t ret = 0;
         KeyType key(raw_key);
-        set.template lazy_emplace(key, [&](const auto& ctor) {
+        set.lazy_emplace(key, [&](const auto& ctor) {
             uint8_t* pos = mem_pool->allocate(key.size);
             memcpy(pos, key.data, key.size);
             ctor(pos, key.size, key.hash);
             ret = phmap::item_serialize_size<SliceHashSet>::value;
         });
+        set.try_partition();
         return ret;
     }
 
@@ -112,22 +246,21 @@ struct DistinctAggregateState<PT, BinaryPTGuard<PT>> {
 
     size_t serialize_size() const {
         size_t size = 0;
-        for (auto& key : set) {
-            size += key.size + sizeof(uint32_t);
-        }
+        set.for_each([&](const KeyType& key) { size += key.size + sizeof(uint32_t); });
         return size;
     }
 
+    // The partitions are serialized one after another in the same format as a single set.
     // TODO(kks): If we put all string key to one continue memory,
     // then we could only one memcpy.
     void serialize(uint8_t* dst) const {
-        for (auto& key : set) {
+        set.for_each([&](const KeyType& key) {
             uint32_t size = (uint32_t)key.size;
             memcpy(dst, &size, sizeof(uint32_t));
             dst += sizeof(uint32_t);
             memcpy(dst, key.data, key.size);
             dst += key.size;
-        }
+        });
     }
 
     size_t deserialize_and_merge(MemPool* mem_pool, const uint8_t* src, size_t len) {
@@ -140,7 +273,7 @@ struct DistinctAggregateState<PT, BinaryPTGuard<PT>> {
             Slice raw_key(src, size);
             KeyType key(raw_key);
             // we only memcpy when the key is new
-            set.template lazy_emplace(key, [&](const auto& ctor) {
+            set.lazy_emplace(key, [&](const auto& ctor) {
                 uint8_t* pos = mem_pool->allocate(key.size);
                 memcpy(pos, key.data, key.size);
                 ctor(pos, key.size, key.hash);
@@ -149,10 +282,11 @@ struct DistinctAggregateState<PT, BinaryPTGuard<PT>> {
             src += size;
         }
         DCHECK(src == end);
+        set.try_partition();
         return mem_usage;
     }
 
-    SliceHashSet set;
+    PartitionedHashSet<SliceHashSet> set;
 };
 
 template <PrimitiveType PT, AggDistinctType DistinctType, typename T = RunTimeCppType<PT>>
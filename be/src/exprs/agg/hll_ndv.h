@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "column/binary_column.h"
 #include "column/object_column.h"
 #include "column/type_traits.h"
@@ -42,32 +44,15 @@ public:
         }
     }
 
+    void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
+                                   AggDataPtr state) const override {
+        update_rows(columns[0], 0, batch_size, state);
+    }
+
     void update_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
                                    int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                    int64_t frame_end) const override {
-        const ColumnType* column = down_cast<const ColumnType*>(columns[0]);
-
-        if constexpr (pt_is_binary<PT>) {
-            uint64_t value = 0;
-            for (size_t i = frame_start; i < frame_end; ++i) {
-                Slice s = column->get_slice(i);
-                value = HashUtil::murmur_hash64A(s.data, s.size, HashUtil::MURMUR_SEED);
-
-                if (value != 0) {
-                    this->data(state).update(value);
-                }
-            }
-        } else {
-            uint64_t value = 0;
-            const auto& v = column->get_data();
-            for (size_t i = frame_start; i < frame_end; ++i) {
-                value = HashUtil::murmur_hash64A(&v[i], sizeof(v[i]), HashUtil::MURMUR_SEED);
-
-                if (value != 0) {
-                    this->data(state).update(value);
-                }
-            }
-        }
+        update_rows(columns[0], frame_start, frame_end, state);
     }
 
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
@@ -141,6 +126,27 @@ public:
     }
 
     std::string get_name() const override { return "ndv"; }
+
+private:
+    // Hash the rows [start, end) of |column| at first, then update the non-zero hash values into |state| at once.
+    void update_rows(const Column* column, size_t start, size_t end, AggDataPtr state) const {
+        const ColumnType* data_column = down_cast<const ColumnType*>(column);
+        std::vector<uint64_t> hash_values(end - start);
+        size_t num_values = 0;
+        for (size_t i = start; i < end; ++i) {
+            uint64_t value = 0;
+            if constexpr (pt_is_binary<PT>) {
+                Slice s = data_column->get_slice(i);
+                value = HashUtil::murmur_hash64A(s.data, s.size, HashUtil::MURMUR_SEED);
+            } else {
+                const auto& v = data_column->get_data();
+                value = HashUtil::murmur_hash64A(&v[i], sizeof(v[i]), HashUtil::MURMUR_SEED);
+            }
+            hash_values[num_values] = value;
+            num_values += (value != 0);
+        }
+        this->data(state).update_batch(hash_values.data(), num_values);
+    }
 };
 
 } // namespace starrocks::vectorized
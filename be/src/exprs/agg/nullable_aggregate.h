@@ -23,6 +23,7 @@
 
 #include <immintrin.h>
 
+#include <algorithm>
 #include <utility>
 
 #include "column/column_helper.h"
@@ -220,7 +221,8 @@ public:
                       AggDataPtr* states) const override {
         // Scalar function compute will return non-nullable column
         // for nullable column when the real whole chunk data all not-null.
-        if (columns[0]->is_nullable()) {
+        // The nullable columns without nulls, e.g. the most columns read from storage, skip the null flags.
+        if (columns[0]->is_nullable() && columns[0]->has_null()) {
             const auto* column = down_cast<const NullableColumn*>(columns[0]);
             const Column* data_column = &column->data_column_ref();
             const uint8_t* f_data = column->null_column()->raw_data();
@@ -262,10 +264,13 @@ public:
                 }
             }
         } else {
+            const Column* data_column = columns[0]->is_nullable()
+                                                ? &down_cast<const NullableColumn*>(columns[0])->data_column_ref()
+                                                : columns[0];
             for (size_t i = 0; i < batch_size; ++i) {
                 this->data(states[i] + state_offset).is_null = false;
-                this->nested_function->update(ctx, columns, this->data(states[i] + state_offset).mutable_nest_state(),
-                                              i);
+                this->nested_function->update(ctx, &data_column,
+                                              this->data(states[i] + state_offset).mutable_nest_state(), i);
             }
         }
     }
@@ -274,7 +279,7 @@ public:
                                   AggDataPtr* states, const std::vector<uint8_t>& selection) const override {
         // Scalar function compute will return non-nullable column
         // for nullable column when the real whole chunk data all not-null.
-        if (columns[0]->is_nullable()) {
+        if (columns[0]->is_nullable() && columns[0]->has_null()) {
             const auto* column = down_cast<const NullableColumn*>(columns[0]);
             const Column* data_column = &column->data_column_ref();
             const uint8_t* f_data = column->null_column()->raw_data();
@@ -321,10 +326,13 @@ public:
                 }
             }
         } else {
+            const Column* data_column = columns[0]->is_nullable()
+                                                ? &down_cast<const NullableColumn*>(columns[0])->data_column_ref()
+                                                : columns[0];
             for (size_t i = 0; i < batch_size; ++i) {
                 if (!selection[i]) {
                     this->data(states[i] + state_offset).is_null = false;
-                    this->nested_function->update(ctx, columns,
+                    this->nested_function->update(ctx, &data_column,
                                                   this->data(states[i] + state_offset).mutable_nest_state(), i);
                 }
             }
@@ -393,7 +401,7 @@ public:
                                    int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                    int64_t frame_end) const override {
         // For cases like: rows between 2 preceding and 1 preceding
-        // Please refer to AnalyticNode::_update_window_batch_normal
+        // Please refer to Analytor::_update_window_batch_normal
         // If frame_start ge frame_end, means the frame is empty,
         // we could directly return.
         if (frame_start >= frame_end) {
@@ -428,6 +436,36 @@ public:
                                                              peer_group_start, peer_group_end, frame_start, frame_end);
         }
     }
+
+    bool is_removable() const override { return this->nested_function->is_removable(); }
+
+    void remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
+                                   int64_t remove_start, int64_t remove_end, int64_t frame_end) const override {
+        if (remove_start >= remove_end || this->data(state).is_null) {
+            return;
+        }
+
+        if (columns[0]->is_nullable() && down_cast<const NullableColumn*>(columns[0])->has_null()) {
+            const auto* column = down_cast<const NullableColumn*>(columns[0]);
+            const Column* data_column = &column->data_column_ref();
+            const uint8_t* f_data = column->null_column()->raw_data();
+            for (size_t i = remove_start; i < remove_end; ++i) {
+                if (f_data[i] == 0) {
+                    this->nested_function->remove_batch_single_state(ctx, this->data(state).mutable_nest_state(),
+                                                                     &data_column, i, i + 1, frame_end);
+                }
+            }
+            // The state is null again if all the remaining rows are null, the first one not null is usually close.
+            this->data(state).is_null = std::find(f_data + remove_end, f_data + frame_end, 0) == f_data + frame_end;
+        } else {
+            const Column* data_column =
+                    columns[0]->is_nullable() ? &down_cast<const NullableColumn*>(columns[0])->data_column_ref()
+                                              : columns[0];
+            this->nested_function->remove_batch_single_state(ctx, this->data(state).mutable_nest_state(),
+                                                             &data_column, remove_start, remove_end, frame_end);
+            this->data(state).is_null = remove_end >= frame_end;
+        }
+    }
 };
 
 template <typename State>
@@ -461,8 +499,46 @@ public:
 
     void update_batch(FunctionContext* ctx, size_t batch_size, size_t state_offset, const Column** columns,
                       AggDataPtr* states) const override {
-        for (size_t i = 0; i < batch_size; ++i) {
-            update(ctx, columns, states[i] + state_offset, i);
+        auto column_size = ctx->get_num_args();
+        // The nullable columns are unwrapped once for the batch, instead of once for every row.
+        std::vector<const Column*> data_columns;
+        data_columns.resize(column_size);
+
+        std::vector<uint8_t> null_data_result;
+        bool has_null = false;
+        for (size_t i = 0; i < column_size; i++) {
+            if (!columns[i]->is_nullable()) {
+                data_columns[i] = columns[i];
+                continue;
+            }
+            const auto* column = down_cast<const NullableColumn*>(columns[i]);
+            data_columns[i] = &column->data_column_ref();
+            if (column->has_null()) {
+                if (!has_null) {
+                    null_data_result.resize(batch_size);
+                    has_null = true;
+                }
+                auto null_data = column->null_column()->raw_data();
+                for (size_t j = 0; j < batch_size; ++j) {
+                    null_data_result[j] |= null_data[j];
+                }
+            }
+        }
+
+        if (has_null) {
+            for (size_t i = 0; i < batch_size; ++i) {
+                if (!null_data_result[i]) {
+                    this->data(states[i] + state_offset).is_null = false;
+                    this->nested_function->update(ctx, data_columns.data(),
+                                                  this->data(states[i] + state_offset).mutable_nest_state(), i);
+                }
+            }
+        } else {
+            for (size_t i = 0; i < batch_size; ++i) {
+                this->data(states[i] + state_offset).is_null = false;
+                this->nested_function->update(ctx, data_columns.data(),
+                                              this->data(states[i] + state_offset).mutable_nest_state(), i);
+            }
         }
     }
 
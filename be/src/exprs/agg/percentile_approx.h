@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "column/column_helper.h"
 #include "column/object_column.h"
 #include "column/vectorized_fwd.h"
@@ -43,6 +45,41 @@ public:
         data(state).is_null = false;
     }
 
+    void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
+                                   AggDataPtr state) const override {
+        const DoubleColumn* data_column = nullptr;
+        const uint8_t* nulls = nullptr;
+        if (columns[0]->is_nullable()) {
+            const auto* nullable_column = down_cast<const NullableColumn*>(columns[0]);
+            data_column = down_cast<const DoubleColumn*>(nullable_column->data_column().get());
+            if (nullable_column->has_null()) {
+                nulls = nullable_column->immutable_null_column_data().data();
+            }
+        } else {
+            data_column = down_cast<const DoubleColumn*>(columns[0]);
+        }
+
+        // Add the values of the batch to the digest at once.
+        const auto& input = data_column->get_data();
+        std::vector<float> values;
+        values.reserve(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            if (nulls == nullptr || !nulls[i]) {
+                values.push_back(implicit_cast<float>(input[i]));
+            }
+        }
+        if (values.empty()) {
+            return;
+        }
+
+        DCHECK(!columns[1]->only_null());
+        DCHECK(!columns[1]->is_null(0));
+
+        data(state).percentile->add(values.data(), values.size());
+        data(state).targetQuantile = columns[1]->get(0).get_double();
+        data(state).is_null = false;
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
         Slice src;
         if (column->is_nullable()) {
@@ -68,6 +105,8 @@ public:
     }
 
     void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const override {
+        // The buffered values are not serialized, only the centroids compressed from them are.
+        data(state).percentile->compress();
         size_t size = data(state).percentile->serialize_size();
         uint8_t result[size + sizeof(double)];
         memcpy(result, &(data(state).targetQuantile), sizeof(double));
@@ -87,6 +87,18 @@ public:
         }
     }
 
+    // The float sums are not removable, subtracting the values may lose the precision of the small ones.
+    bool is_removable() const override { return !pt_is_float<PT>; }
+
+    void remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
+                                   int64_t remove_start, int64_t remove_end, int64_t frame_end) const override {
+        const auto* column = down_cast<const InputColumnType*>(columns[0]);
+        const auto* data = column->get_data().data();
+        for (size_t i = remove_start; i < remove_end; ++i) {
+            this->data(state).sum -= data[i];
+        }
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
         DCHECK(column->is_numeric() || column->is_decimal());
         const auto* input_column = down_cast<const ResultColumnType*>(column);
@@ -30,6 +30,7 @@
 #include "exprs/expr_value.h"
 #include "udf/udf.h"
 #include "udf/udf_internal.h" // for ArrayVal
+#include "util/conjunct_stats.h"
 
 #undef USING_STARROCKS_UDF
 #define USING_STARROCKS_UDF using namespace starrocks_udf
@@ -182,6 +183,9 @@ public:
 
     ColumnPtr evaluate(Expr* expr, vectorized::Chunk* chunk);
 
+    // The statistics of this expr evaluated as a conjunct, see ExecNode::eval_conjuncts.
+    ConjunctStats* conjunct_stats() { return &_conjunct_stats; }
+
 private:
     friend class Expr;
     friend class ScalarFnCall;
@@ -219,6 +223,8 @@ private:
     // In operator, the ExprContext::close method will be called concurrently
     std::atomic<bool> _closed;
 
+    ConjunctStats _conjunct_stats;
+
     /// Calls the appropriate Get*Val() function on 'e' and stores the result in result_.
     /// This is used by Exprs to call GetValue() on a child expr, rather than root_.
     void* get_value(Expr* e, TupleRow* row);
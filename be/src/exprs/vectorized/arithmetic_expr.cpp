@@ -21,11 +21,190 @@ namespace vectorized {
                                                                                                       \
     virtual bool is_vectorized() const override { return true; };
 
+template <PrimitiveType Type, typename OP>
+class VectorizedArithmeticExpr;
+
+TYPE_GUARD(FusableOpGuard, is_fusable_op, AddOp, SubOp, MulOp)
+
+// A chain of +, - and * over the same integer or floating-point type, e.g. a * b + c - d, evaluated by its root
+// without materializing a column for every intermediate result. The operators are applied block by block on
+// buffers of kBlockSize rows, which stay in the L1 cache, so only the operands of the chain are read from memory
+// and only its result is written.
+template <PrimitiveType Type>
+class ArithmeticChain {
+public:
+    using CppType = RunTimeCppType<Type>;
+    using ColumnType = RunTimeColumnType<Type>;
+
+    static constexpr bool is_fusable_type = pt_is_integer<Type> || pt_is_float<Type>;
+    static constexpr size_t kBlockSize = 256;
+
+    // Flatten the chain rooted at |root| in postfix order. Return false if the chain has a single operator, which
+    // gains nothing from the fusion.
+    bool build(Expr* root) {
+        _flatten(root);
+        return _num_ops > 1 && _is_valid;
+    }
+
+    ColumnPtr evaluate(ExprContext* context, Chunk* chunk) const {
+        // The operands, in the order evaluated by the unfused expressions.
+        std::vector<ColumnPtr> columns;
+        columns.reserve(_steps.size() - _num_ops);
+        size_t num_rows = 0;
+        bool all_const = true;
+        bool has_null = false;
+        for (const Step& step : _steps) {
+            if (step.kind != StepKind::OPERAND) {
+                continue;
+            }
+            ColumnPtr column = step.operand->evaluate(context, chunk);
+            if (column->only_null()) {
+                return ColumnHelper::create_const_null_column(column->size());
+            }
+            if (!column->is_constant()) {
+                all_const = false;
+                num_rows = column->size();
+            }
+            has_null |= column->has_null();
+            columns.emplace_back(std::move(column));
+        }
+        size_t result_size = num_rows;
+        if (all_const) {
+            result_size = columns[0]->size();
+            num_rows = 1;
+        }
+
+        // The data of the operands, where a constant is broadcast to a block.
+        std::vector<const CppType*> operands(columns.size());
+        std::vector<Buffer<CppType>> broadcast_values;
+        broadcast_values.reserve(columns.size());
+        NullColumnPtr null_column = has_null ? NullColumn::create(num_rows, 0) : nullptr;
+        for (size_t i = 0; i < columns.size(); i++) {
+            const ColumnPtr& column = columns[i];
+            if (column->is_constant()) {
+                // the data of a constant may be a nullable column without null.
+                const ColumnPtr& const_data = down_cast<const ConstColumn*>(column.get())->data_column();
+                const Column* data_column = ColumnHelper::get_data_column(const_data.get());
+                CppType value = down_cast<const ColumnType*>(data_column)->get_data()[0];
+                broadcast_values.emplace_back(kBlockSize, value);
+                operands[i] = broadcast_values.back().data();
+                continue;
+            }
+            const Column* data_column = ColumnHelper::get_data_column(column.get());
+            operands[i] = down_cast<const ColumnType*>(data_column)->get_data().data();
+            if (column->has_null()) {
+                const auto& nulls = down_cast<const NullableColumn*>(column.get())->immutable_null_column_data();
+                auto& result_nulls = null_column->get_data();
+                for (size_t j = 0; j < num_rows; j++) {
+                    result_nulls[j] |= nulls[j];
+                }
+            }
+        }
+
+        auto result = ColumnType::create();
+        result->resize(num_rows);
+        CppType* result_data = result->get_data().data();
+        // The results of the operators but the root, which writes to the result column.
+        Buffer<CppType> intermediates((_num_ops - 1) * kBlockSize);
+        std::vector<const CppType*> stack;
+        stack.reserve(columns.size());
+        for (size_t start = 0; start < num_rows; start += kBlockSize) {
+            size_t size = std::min(kBlockSize, num_rows - start);
+            size_t operand_idx = 0;
+            size_t op_idx = 0;
+            for (const Step& step : _steps) {
+                if (step.kind == StepKind::OPERAND) {
+                    const CppType* data = operands[operand_idx];
+                    stack.push_back(columns[operand_idx]->is_constant() ? data : data + start);
+                    operand_idx++;
+                    continue;
+                }
+                const CppType* r = stack.back();
+                stack.pop_back();
+                const CppType* l = stack.back();
+                stack.pop_back();
+                CppType* dst =
+                        op_idx + 1 == _num_ops ? result_data + start : intermediates.data() + op_idx * kBlockSize;
+                op_idx++;
+                switch (step.kind) {
+                case StepKind::ADD:
+                    _apply<AddOp>(l, r, dst, size);
+                    break;
+                case StepKind::SUB:
+                    _apply<SubOp>(l, r, dst, size);
+                    break;
+                default:
+                    _apply<MulOp>(l, r, dst, size);
+                    break;
+                }
+                stack.push_back(dst);
+            }
+            stack.clear();
+        }
+
+        if (all_const) {
+            return ConstColumn::create(std::move(result), result_size);
+        }
+        if (has_null) {
+            return NullableColumn::create(std::move(result), std::move(null_column));
+        }
+        return result;
+    }
+
+private:
+    enum class StepKind : uint8_t { OPERAND, ADD, SUB, MUL };
+
+    struct Step {
+        StepKind kind;
+        Expr* operand;
+    };
+
+    template <typename Op>
+    static void _apply(const CppType* l, const CppType* r, CppType* dst, size_t size) {
+        using ArithmeticOp = ArithmeticBinaryOperator<Op, Type>;
+        for (size_t i = 0; i < size; i++) {
+            dst[i] = ArithmeticOp::template apply<CppType, CppType, CppType>(l[i], r[i]);
+        }
+    }
+
+    void _flatten(Expr* expr) {
+        StepKind kind = StepKind::OPERAND;
+        if (dynamic_cast<VectorizedArithmeticExpr<Type, AddOp>*>(expr) != nullptr) {
+            kind = StepKind::ADD;
+        } else if (dynamic_cast<VectorizedArithmeticExpr<Type, SubOp>*>(expr) != nullptr) {
+            kind = StepKind::SUB;
+        } else if (dynamic_cast<VectorizedArithmeticExpr<Type, MulOp>*>(expr) != nullptr) {
+            kind = StepKind::MUL;
+        }
+        if (kind == StepKind::OPERAND) {
+            // the unfused operators read the data of their operands as the type of the result.
+            _is_valid &= expr->type().type == Type;
+            _steps.push_back({kind, expr});
+            return;
+        }
+        _flatten(expr->get_child(0));
+        _flatten(expr->get_child(1));
+        _steps.push_back({kind, nullptr});
+        _num_ops++;
+    }
+
+    std::vector<Step> _steps;
+    size_t _num_ops = 0;
+    bool _is_valid = true;
+};
+
 template <PrimitiveType Type, typename OP>
 class VectorizedArithmeticExpr final : public Expr {
 public:
     DEFINE_CLASS_CONSTRUCTOR(VectorizedArithmeticExpr);
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override {
+        if constexpr (ArithmeticChain<Type>::is_fusable_type && is_fusable_op<OP>) {
+            // the root of a chain evaluates the whole chain, the operators inside are never evaluated by themselves.
+            ArithmeticChain<Type> chain;
+            if (chain.build(this)) {
+                return chain.evaluate(context, ptr);
+            }
+        }
         auto l = _children[0]->evaluate(context, ptr);
         auto r = _children[1]->evaluate(context, ptr);
         if constexpr (pt_is_decimal<Type>) {
@@ -2,6 +2,8 @@
 
 #include "exprs/vectorized/array_functions.h"
 
+#include <cstring>
+
 #include "column/array_column.h"
 #include "util/raw_container.h"
 
@@ -137,6 +139,22 @@ private:
             return (*null_map)[idx] != 0;
         };
 
+        if constexpr (!NullableElement && !NullableTarget && ConstTarget && std::is_arithmetic_v<ValueType> &&
+                      !std::is_same_v<ArrayColumn, ElementColumn>) {
+            // Compare the whole element buffer with the target in one pass, which the compiler vectorizes, then
+            // look for a match in the range of every array.
+            const size_t num_elements = offsets_ptr[num_array];
+            Buffer<uint8_t> matches(num_elements);
+            for (size_t j = 0; j < num_elements; j++) {
+                matches[j] = (elements_ptr[j] == first_target);
+            }
+            for (size_t i = 0; i < num_array; i++) {
+                size_t array_size = offsets_ptr[i + 1] - offsets_ptr[i];
+                result_ptr[i] = memchr(matches.data() + offsets_ptr[i], 1, array_size) != nullptr;
+            }
+            return result;
+        }
+
         for (size_t i = 0; i < num_array; i++) {
             size_t offset = offsets_ptr[i];
             size_t array_size = offsets_ptr[i + 1] - offsets_ptr[i];
@@ -343,21 +361,30 @@ public:
             ResultType sum{};
 
             bool has_data = false;
-            for (size_t j = 0; j < array_size; j++) {
-                if constexpr (has_null) {
-                    if ((*null_elements)[offset + j] != 0) {
-                        continue;
-                    }
+            if constexpr (!has_null && std::is_arithmetic_v<ValueType>) {
+                // a plain reduction of the range of the array, which the compiler vectorizes.
+                has_data = array_size > 0;
+                const ValueType* values = elements_ptr + offset;
+                for (size_t j = 0; j < array_size; j++) {
+                    sum += values[j];
                 }
+            } else {
+                for (size_t j = 0; j < array_size; j++) {
+                    if constexpr (has_null) {
+                        if ((*null_elements)[offset + j] != 0) {
+                            continue;
+                        }
+                    }
 
-                has_data = true;
-                auto& value = elements_ptr[offset + j];
-                if constexpr (pt_is_datetime<value_type>) {
-                    sum += value.to_unix_second();
-                } else if constexpr (pt_is_date<value_type>) {
-                    sum += value.julian();
-                } else {
-                    sum += value;
+                    has_data = true;
+                    auto& value = elements_ptr[offset + j];
+                    if constexpr (pt_is_datetime<value_type>) {
+                        sum += value.to_unix_second();
+                    } else if constexpr (pt_is_date<value_type>) {
+                        sum += value.julian();
+                    } else {
+                        sum += value;
+                    }
                 }
             }
 
@@ -480,19 +507,32 @@ public:
                 }
 
                 bool has_data = false;
-                for (; index < array_size; index++) {
-                    if constexpr (has_null) {
-                        if ((*null_elements)[offset + index] != 0) {
-                            continue;
+                if constexpr (!has_null && std::is_arithmetic_v<ValueType>) {
+                    // a plain reduction of the range of the array, which the compiler vectorizes.
+                    has_data = index < array_size;
+                    const ValueType* values = elements_ptr + offset;
+                    for (; index < array_size; index++) {
+                        if constexpr (is_min) {
+                            result = result < values[index] ? result : values[index];
+                        } else {
+                            result = result < values[index] ? values[index] : result;
                         }
                     }
+                } else {
+                    for (; index < array_size; index++) {
+                        if constexpr (has_null) {
+                            if ((*null_elements)[offset + index] != 0) {
+                                continue;
+                            }
+                        }
 
-                    has_data = true;
-                    auto& value = elements_ptr[offset + index];
-                    if constexpr (is_min) {
-                        result = result < value ? result : value;
-                    } else {
-                        result = result < value ? value : result;
+                        has_data = true;
+                        auto& value = elements_ptr[offset + index];
+                        if constexpr (is_min) {
+                            result = result < value ? result : value;
+                        } else {
+                            result = result < value ? value : result;
+                        }
                     }
                 }
 
@@ -2,6 +2,9 @@
 
 #include "exprs/vectorized/case_expr.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
@@ -41,13 +44,39 @@ public:
 
         // children size check
         if ((_has_case_expr ^ _has_else_expr) == 0) {
-            return _children.size() % 2 == 0 ? Status::OK() : Status::InvalidArgument("case when children is error!");
+            if (_children.size() % 2 != 0) {
+                return Status::InvalidArgument("case when children is error!");
+            }
+        } else if (_children.size() % 2 != 1) {
+            return Status::InvalidArgument("case when children is error!");
         }
 
-        return _children.size() % 2 == 1 ? Status::OK() : Status::InvalidArgument("case when children is error!");
+        _slot_ids.clear();
+        get_slot_ids(&_slot_ids);
+        std::sort(_slot_ids.begin(), _slot_ids.end());
+        _slot_ids.erase(std::unique(_slot_ids.begin(), _slot_ids.end()), _slot_ids.end());
+        return Status::OK();
     }
 
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* chunk) override {
+        // The branches are evaluated only on the rows which need them if the chunk has the columns they refer.
+        if (chunk != nullptr && chunk->num_rows() > 0 &&
+            std::any_of(_slot_ids.begin(), _slot_ids.end(), [&](SlotId id) { return chunk->is_slot_exist(id); })) {
+            if (_has_case_expr) {
+                ColumnPtr case_column = _children[0]->evaluate(context, chunk);
+                ColumnViewer<WhenType> case_viewer(case_column);
+                return evaluate_lazily<WhenType>(
+                        context, chunk, 1, [&](const ColumnViewer<WhenType>& when_viewer, size_t pos, size_t row) {
+                            return !case_viewer.is_null(row) && !when_viewer.is_null(pos) &&
+                                   when_viewer.value(pos) == case_viewer.value(row);
+                        });
+            } else {
+                return evaluate_lazily<TYPE_BOOLEAN>(
+                        context, chunk, 0, [](const ColumnViewer<TYPE_BOOLEAN>& when_viewer, size_t pos, size_t row) {
+                            return !when_viewer.is_null(pos) && when_viewer.value(pos);
+                        });
+            }
+        }
         if (_has_case_expr) {
             return evaluate_case(context, chunk);
         } else {
@@ -280,9 +309,138 @@ private:
         return builder.build(ColumnHelper::is_all_const(when_columns) && ColumnHelper::is_all_const(then_columns));
     }
 
+    // Evaluate the WHENs and the THENs from |first_when| only on the rows which need them, |matcher|
+    // tells whether the row |row| of |chunk| matches the WHEN at |pos| of the rows it is evaluated on.
+    //
+    // Each WHEN is evaluated on the rows not matched by the WHENs before it, and each THEN and the ELSE
+    // on the rows which select it, so a CASE of many branches evaluates each row about as many times as
+    // the branches it goes through, not all the branches. The rows are selected into a new chunk of the
+    // referred columns when no more than half of the rows of the chunk evaluated before are left,
+    // otherwise the expression is evaluated on that chunk and the other rows are ignored.
+    template <PrimitiveType MatchType, typename Matcher>
+    ColumnPtr evaluate_lazily(ExprContext* context, vectorized::Chunk* chunk, int first_when,
+                              const Matcher& matcher) {
+        const size_t num_rows = chunk->num_rows();
+        const int loop_end = _children.size() - 1;
+        const size_t num_branches = (loop_end - first_when + 1) / 2;
+
+        // The branch selected by each row, |num_branches| for ELSE.
+        std::vector<uint32_t> row_branches(num_rows, num_branches);
+
+        // The rows not matched yet, and the rows of the chunk the last WHEN is evaluated on.
+        std::vector<uint32_t> remaining(num_rows);
+        std::iota(remaining.begin(), remaining.end(), 0);
+        std::vector<uint32_t> evaluated_rows = remaining;
+        ChunkPtr selected_chunk;
+        Chunk* when_chunk = chunk;
+
+        std::vector<uint32_t> next_remaining;
+        for (int i = first_when, branch = 0; i < loop_end && !remaining.empty(); i += 2, branch++) {
+            if (remaining.size() <= evaluated_rows.size() / 2) {
+                selected_chunk = FunctionHelper::select_rows(*chunk, _slot_ids, remaining);
+                when_chunk = selected_chunk.get();
+                evaluated_rows = remaining;
+            }
+            ColumnPtr when_column = _children[i]->evaluate(context, when_chunk);
+            ColumnViewer<MatchType> when_viewer(when_column);
+
+            next_remaining.clear();
+            size_t pos = 0;
+            for (uint32_t row : remaining) {
+                while (evaluated_rows[pos] != row) {
+                    pos++;
+                }
+                if (matcher(when_viewer, pos, row)) {
+                    row_branches[row] = branch;
+                } else {
+                    next_remaining.push_back(row);
+                }
+            }
+            remaining.swap(next_remaining);
+        }
+
+        // The rows of each branch, in their order in the chunk.
+        std::vector<std::vector<uint32_t>> branch_rows(num_branches + 1);
+        for (uint32_t row = 0; row < num_rows; row++) {
+            branch_rows[row_branches[row]].push_back(row);
+        }
+
+        // The result of each branch, on all the rows or only on the rows of the branch.
+        Columns then_columns(num_branches + 1);
+        std::vector<uint8_t> on_all_rows(num_branches + 1, 1);
+        for (size_t branch = 0; branch <= num_branches; branch++) {
+            const auto& rows = branch_rows[branch];
+            Expr* then_expr = nullptr;
+            if (branch < num_branches) {
+                then_expr = _children[first_when + 2 * branch + 1];
+            } else if (_has_else_expr) {
+                then_expr = _children[_children.size() - 1];
+            }
+
+            if (then_expr == nullptr || rows.empty()) {
+                then_columns[branch] = ColumnHelper::create_const_null_column(1);
+            } else if (rows.size() > num_rows / 2 || then_expr->is_constant()) {
+                then_columns[branch] = then_expr->evaluate(context, chunk);
+            } else {
+                ChunkPtr then_chunk = FunctionHelper::select_rows(*chunk, _slot_ids, rows);
+                then_columns[branch] = then_expr->evaluate(context, then_chunk.get());
+                on_all_rows[branch] = 0;
+            }
+
+            if (rows.size() == num_rows) {
+                if (then_expr == nullptr) {
+                    return ColumnHelper::create_const_null_column(num_rows);
+                }
+                return then_columns[branch]->clone();
+            }
+        }
+
+        std::vector<ColumnViewer<ResultType>> then_viewers;
+        then_viewers.reserve(num_branches + 1);
+        for (const auto& column : then_columns) {
+            then_viewers.emplace_back(column);
+        }
+        // The position of the next row of each branch evaluated only on its rows.
+        std::vector<uint32_t> positions(num_branches + 1, 0);
+
+        ColumnBuilder<ResultType> builder(this->type().precision, this->type().scale);
+        if constexpr (pt_is_fixedlength<ResultType>) {
+            // The fixed length values are selected without branches on the nulls.
+            auto data_column = builder.data_column();
+            auto null_column = builder.get_null_column();
+            auto& data = data_column->get_data();
+            auto& nulls = null_column->get_data();
+            data.resize(num_rows);
+            nulls.resize(num_rows);
+            uint8_t has_null = 0;
+            for (uint32_t row = 0; row < num_rows; row++) {
+                uint32_t branch = row_branches[row];
+                uint32_t pos = on_all_rows[branch] ? row : positions[branch]++;
+                data[row] = then_viewers[branch].value(pos);
+                nulls[row] = then_viewers[branch].is_null(pos);
+                has_null |= nulls[row];
+            }
+            return ColumnBuilder<ResultType>(data_column, null_column, has_null).build(false);
+        } else {
+            builder.reserve(num_rows);
+            for (uint32_t row = 0; row < num_rows; row++) {
+                uint32_t branch = row_branches[row];
+                uint32_t pos = on_all_rows[branch] ? row : positions[branch]++;
+                if (then_viewers[branch].is_null(pos)) {
+                    builder.append_null();
+                } else {
+                    builder.append(then_viewers[branch].value(pos));
+                }
+            }
+            return builder.build(false);
+        }
+    }
+
 private:
     const bool _has_case_expr;
     const bool _has_else_expr;
+    // The slots referred by the children, the columns selected to evaluate a branch on part of the rows.
+    std::vector<SlotId> _slot_ids;
 };
 
 #define CASE_WHEN_RESULT_TYPE(WHEN_TYPE, RESULT_TYPE)                \
@@ -0,0 +1,141 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/columnar_udf.h"
+
+#include <limits>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "gutil/strings/substitute.h"
+#include "simd/simd.h"
+
+namespace starrocks::vectorized {
+
+static const char* arrow_format(PrimitiveType type) {
+    switch (type) {
+    case TYPE_TINYINT:
+        return "c";
+    case TYPE_SMALLINT:
+        return "s";
+    case TYPE_INT:
+        return "i";
+    case TYPE_BIGINT:
+        return "l";
+    case TYPE_FLOAT:
+        return "f";
+    case TYPE_DOUBLE:
+        return "g";
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        return "u";
+    default:
+        return nullptr;
+    }
+}
+
+// The arrays are owned by the caller, so there is nothing to release but marking them released.
+static void release_borrowed_array(ArrowArray* array) {
+    array->release = nullptr;
+}
+
+// The Arrow array of an argument or the result, and the buffers it refers to.
+struct ColumnarUdfArray {
+    ArrowArray array{};
+    const void* buffers[3] = {nullptr, nullptr, nullptr};
+    // the validity bitmap, bit i is set if row i isn't null.
+    std::vector<uint8_t> validity;
+
+    void init(size_t num_rows, int64_t n_buffers) {
+        array.length = num_rows;
+        array.n_buffers = n_buffers;
+        array.buffers = buffers;
+        array.release = release_borrowed_array;
+    }
+};
+
+static void to_validity(const NullColumn& nulls, std::vector<uint8_t>* validity) {
+    const uint8_t* null_data = nulls.get_data().data();
+    const size_t num_rows = nulls.size();
+    validity->assign((num_rows + 7) / 8, 0);
+    for (size_t i = 0; i < num_rows; i++) {
+        (*validity)[i / 8] |= static_cast<uint8_t>(!null_data[i]) << (i % 8);
+    }
+}
+
+Status ColumnarUdfCall::check_types(const TypeDescriptor& return_type, const std::vector<TypeDescriptor>& arg_types) {
+    const char* format = arrow_format(return_type.type);
+    if (format == nullptr || format[0] == 'u') {
+        return Status::NotSupported("Columnar UDF doesn't support return type " + return_type.debug_string());
+    }
+    for (const auto& type : arg_types) {
+        if (arrow_format(type.type) == nullptr) {
+            return Status::NotSupported("Columnar UDF doesn't support argument type " + type.debug_string());
+        }
+    }
+    return Status::OK();
+}
+
+ColumnPtr ColumnarUdfCall::call(starrocks_udf::ColumnarUdf fn, FunctionContext* context,
+                                const TypeDescriptor& return_type, const std::vector<TypeDescriptor>& arg_types,
+                                const Columns& args, size_t num_rows) {
+    DCHECK_EQ(args.size(), arg_types.size());
+    Columns data_columns;
+    std::vector<ColumnarUdfArray> arrays(args.size());
+    std::vector<const ArrowArray*> arg_arrays(args.size());
+    for (size_t i = 0; i < args.size(); i++) {
+        ColumnPtr column = ColumnHelper::unfold_const_column(arg_types[i], num_rows, args[i]);
+        ColumnarUdfArray& arg = arrays[i];
+        const Column* data_column = column.get();
+        if (column->is_nullable()) {
+            const auto* nullable = down_cast<const NullableColumn*>(column.get());
+            data_column = nullable->data_column().get();
+            if (nullable->has_null()) {
+                to_validity(*nullable->null_column(), &arg.validity);
+                arg.buffers[0] = arg.validity.data();
+                arg.array.null_count = SIMD::count_nonzero(nullable->null_column()->get_data());
+            }
+        }
+        if (data_column->is_binary()) {
+            const auto* binary = down_cast<const BinaryColumn*>(data_column);
+            if (binary->get_bytes().size() > std::numeric_limits<int32_t>::max()) {
+                context->set_error("The strings of a columnar UDF argument exceed 2GB");
+                return ColumnHelper::create_const_null_column(num_rows);
+            }
+            arg.init(num_rows, 3);
+            arg.buffers[1] = binary->get_offset().data();
+            arg.buffers[2] = binary->get_bytes().data();
+        } else {
+            arg.init(num_rows, 2);
+            arg.buffers[1] = data_column->raw_data();
+        }
+        arg_arrays[i] = &arg.array;
+        // the arguments unfolded must be alive during the call.
+        data_columns.emplace_back(std::move(column));
+    }
+
+    ColumnPtr data_column = ColumnHelper::create_column(return_type, false);
+    data_column->resize(num_rows);
+    ColumnarUdfArray result;
+    result.init(num_rows, 2);
+    result.validity.assign((num_rows + 7) / 8, 0xFF);
+    result.buffers[0] = result.validity.data();
+    result.buffers[1] = data_column->mutable_raw_data();
+
+    int32_t ret = fn(context, static_cast<int32_t>(args.size()), arg_arrays.data(), &result.array);
+    if (ret != 0 || context->has_error()) {
+        if (!context->has_error()) {
+            context->set_error(strings::Substitute("Columnar UDF returns error code $0", ret).c_str());
+        }
+        return ColumnHelper::create_const_null_column(num_rows);
+    }
+
+    auto nulls = NullColumn::create(num_rows, 0);
+    uint8_t* null_data = nulls->get_data().data();
+    for (size_t i = 0; i < num_rows; i++) {
+        null_data[i] = !((result.validity[i / 8] >> (i % 8)) & 1);
+    }
+    return NullableColumn::create(std::move(data_column), std::move(nulls));
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,26 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "runtime/types.h"
+#include "udf/udf_columnar.h"
+
+namespace starrocks::vectorized {
+
+// Call the columnar UDFs of udf/udf_columnar.h on the columns of a chunk.
+class ColumnarUdfCall {
+public:
+    // Return an error if a columnar UDF can't take the arguments of |arg_types| or return |return_type|.
+    static Status check_types(const TypeDescriptor& return_type, const std::vector<TypeDescriptor>& arg_types);
+
+    // Call |fn| on |args| of |num_rows| rows and return the column of the results, or set the error to |context|
+    // and return the column of nulls if the call fails.
+    static ColumnPtr call(starrocks_udf::ColumnarUdf fn, FunctionContext* context, const TypeDescriptor& return_type,
+                          const std::vector<TypeDescriptor>& arg_types, const Columns& args, size_t num_rows);
+};
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,228 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/common_sub_expr_eliminator.h"
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "util/thrift_util.h"
+
+namespace starrocks::vectorized {
+
+// The expressions with more nodes are left as they are, the subtrees of them are compared by their bytes.
+static constexpr size_t kMaxExprNodes = 1024;
+
+static bool is_nondeterministic(const TExprNode& node) {
+    if (node.node_type != TExprNodeType::FUNCTION_CALL || !node.__isset.fn) {
+        return false;
+    }
+    const std::string& name = node.fn.name.function_name;
+    return name == "rand" || name == "random" || name == "uuid" || name == "uuid_numeric" || name == "sleep";
+}
+
+// The end of the subtree starting from |begin|, the nodes are in pre-order.
+static size_t subtree_end(const std::vector<TExprNode>& nodes, size_t begin) {
+    size_t end = begin + 1;
+    for (int i = 0; i < nodes[begin].num_children && end < nodes.size(); i++) {
+        end = subtree_end(nodes, end);
+    }
+    return end;
+}
+
+namespace {
+
+// The subtrees of an expression, keyed by their serialized nodes.
+class ExprSubtrees {
+public:
+    Status init(ThriftSerializer* serializer, const TExpr& expr) {
+        const auto& nodes = expr.nodes;
+        _ends.resize(nodes.size());
+        _node_keys.resize(nodes.size());
+        for (size_t i = 0; i < nodes.size(); i++) {
+            _ends[i] = subtree_end(nodes, i);
+            uint32_t len = 0;
+            uint8_t* buf = nullptr;
+            RETURN_IF_ERROR(serializer->serialize(const_cast<TExprNode*>(&nodes[i]), &len, &buf));
+            _node_keys[i].assign(reinterpret_cast<const char*>(buf), len);
+        }
+        // The subtrees which may be extracted, the roots are never extracted.
+        _extractable.assign(nodes.size(), false);
+        for (size_t i = 1; i < nodes.size(); i++) {
+            if (nodes[i].node_type == TExprNodeType::SLOT_REF) {
+                continue;
+            }
+            bool has_slot = false;
+            bool deterministic = true;
+            for (size_t j = i; j < _ends[i]; j++) {
+                has_slot |= nodes[j].node_type == TExprNodeType::SLOT_REF;
+                deterministic &= !is_nondeterministic(nodes[j]);
+            }
+            _extractable[i] = has_slot && deterministic;
+        }
+        return Status::OK();
+    }
+
+    size_t size() const { return _ends.size(); }
+    size_t end(size_t begin) const { return _ends[begin]; }
+    bool extractable(size_t begin) const { return _extractable[begin]; }
+
+    std::string key(size_t begin) const {
+        std::string key;
+        for (size_t i = begin; i < _ends[begin]; i++) {
+            key.append(_node_keys[i]);
+        }
+        return key;
+    }
+
+private:
+    std::vector<size_t> _ends;
+    std::vector<std::string> _node_keys;
+    std::vector<bool> _extractable;
+};
+
+struct Candidate {
+    size_t count = 0;
+    size_t num_nodes = 0;
+    // The first occurrence.
+    const TExpr* expr = nullptr;
+    size_t begin = 0;
+};
+
+} // namespace
+
+// Replace the subtrees of |expr| whose key is |key| by |slot_ref|.
+static void replace_subtrees(const ExprSubtrees& subtrees, const std::string& key, const TExprNode& slot_ref,
+                             TExpr* expr) {
+    std::vector<TExprNode> nodes;
+    nodes.reserve(expr->nodes.size());
+    size_t i = 0;
+    while (i < expr->nodes.size()) {
+        if (subtrees.extractable(i) && subtrees.key(i) == key) {
+            nodes.push_back(slot_ref);
+            i = subtrees.end(i);
+        } else {
+            nodes.push_back(std::move(expr->nodes[i]));
+            i++;
+        }
+    }
+    expr->nodes = std::move(nodes);
+}
+
+// Sort |common_exprs| in the order of their dependencies, the others keep their order.
+static void sort_common_exprs(CommonSubExprEliminator::CommonExprs* common_exprs) {
+    std::unordered_map<SlotId, size_t> slot_to_index;
+    for (size_t i = 0; i < common_exprs->size(); i++) {
+        slot_to_index[(*common_exprs)[i].first] = i;
+    }
+
+    CommonSubExprEliminator::CommonExprs sorted;
+    sorted.reserve(common_exprs->size());
+    // 0: not visited, 1: visiting, 2: visited.
+    std::vector<int> states(common_exprs->size(), 0);
+    std::function<void(size_t)> visit = [&](size_t idx) {
+        if (states[idx] != 0) {
+            return;
+        }
+        states[idx] = 1;
+        for (const auto& node : (*common_exprs)[idx].second.nodes) {
+            if (node.node_type != TExprNodeType::SLOT_REF) {
+                continue;
+            }
+            auto iter = slot_to_index.find(node.slot_ref.slot_id);
+            if (iter != slot_to_index.end()) {
+                visit(iter->second);
+            }
+        }
+        states[idx] = 2;
+        sorted.emplace_back(std::move((*common_exprs)[idx]));
+    };
+    for (size_t i = 0; i < common_exprs->size(); i++) {
+        visit(i);
+    }
+    common_exprs->swap(sorted);
+}
+
+Status CommonSubExprEliminator::eliminate(std::vector<TExpr>* exprs, CommonExprs* common_exprs, SlotId next_slot_id,
+                                          TupleId tuple_id) {
+    ThriftSerializer serializer(false, 1024);
+    std::vector<TExpr*> trees;
+    while (true) {
+        trees.clear();
+        for (auto& expr : *exprs) {
+            if (expr.nodes.size() <= kMaxExprNodes) {
+                trees.push_back(&expr);
+            }
+        }
+        for (auto& [slot_id, expr] : *common_exprs) {
+            if (expr.nodes.size() <= kMaxExprNodes) {
+                trees.push_back(&expr);
+            }
+        }
+
+        std::vector<ExprSubtrees> subtrees(trees.size());
+        std::unordered_map<std::string, Candidate> candidates;
+        for (size_t t = 0; t < trees.size(); t++) {
+            RETURN_IF_ERROR(subtrees[t].init(&serializer, *trees[t]));
+            for (size_t i = 0; i < subtrees[t].size(); i++) {
+                if (!subtrees[t].extractable(i)) {
+                    continue;
+                }
+                Candidate& candidate = candidates[subtrees[t].key(i)];
+                if (candidate.count++ == 0) {
+                    candidate.num_nodes = subtrees[t].end(i) - i;
+                    candidate.expr = trees[t];
+                    candidate.begin = i;
+                }
+            }
+        }
+
+        const std::string* best_key = nullptr;
+        const Candidate* best = nullptr;
+        for (const auto& [key, candidate] : candidates) {
+            if (candidate.count < 2) {
+                continue;
+            }
+            if (best == nullptr || candidate.num_nodes > best->num_nodes ||
+                (candidate.num_nodes == best->num_nodes && key < *best_key)) {
+                best_key = &key;
+                best = &candidate;
+            }
+        }
+        if (best == nullptr) {
+            break;
+        }
+
+        const TExprNode& root = best->expr->nodes[best->begin];
+        SlotId slot_id = next_slot_id++;
+        TExpr common_expr;
+        common_expr.nodes.assign(best->expr->nodes.begin() + best->begin,
+                                 best->expr->nodes.begin() + best->begin + best->num_nodes);
+
+        TExprNode slot_ref;
+        slot_ref.node_type = TExprNodeType::SLOT_REF;
+        slot_ref.type = root.type;
+        slot_ref.num_children = 0;
+        slot_ref.output_scale = root.output_scale;
+        slot_ref.__set_slot_ref(TSlotRef());
+        slot_ref.slot_ref.slot_id = slot_id;
+        slot_ref.slot_ref.tuple_id = tuple_id;
+        if (root.__isset.is_nullable) {
+            slot_ref.__set_is_nullable(root.is_nullable);
+        }
+        if (root.__isset.use_vectorized) {
+            slot_ref.__set_use_vectorized(root.use_vectorized);
+        }
+
+        std::string key = *best_key;
+        for (size_t t = 0; t < trees.size(); t++) {
+            replace_subtrees(subtrees[t], key, slot_ref, trees[t]);
+        }
+        common_exprs->emplace_back(slot_id, std::move(common_expr));
+    }
+
+    sort_common_exprs(common_exprs);
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
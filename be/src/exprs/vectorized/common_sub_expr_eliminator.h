@@ -0,0 +1,33 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "common/global_types.h"
+#include "common/status.h"
+#include "gen_cpp/Exprs_types.h"
+
+namespace starrocks::vectorized {
+
+// CommonSubExprEliminator extracts the subexpressions which appear more than once in the expressions of a
+// node, e.g. the `cast(ts as date)` of several output columns, into the common expressions. The common
+// expressions are evaluated once per chunk and their results are appended to the chunk, like the
+// common_slot_map of TProjectNode planned by FE, and the occurrences are replaced by the slot refs to them.
+//
+// A subexpression is extracted if it refers to some slots and is deterministic, and the largest ones are
+// extracted first. The roots of the expressions are never replaced.
+class CommonSubExprEliminator {
+public:
+    using CommonExprs = std::vector<std::pair<SlotId, TExpr>>;
+
+    // Rewrite |exprs| and |common_exprs|, and append the new common expressions to |common_exprs|. Their
+    // slots are allocated from |next_slot_id|, which must be larger than the ids of all the slots of the
+    // chunk, and belong to |tuple_id|.
+    // |common_exprs| are then sorted, so that each of them comes after the common expressions it refers to.
+    static Status eliminate(std::vector<TExpr>* exprs, CommonExprs* common_exprs, SlotId next_slot_id,
+                            TupleId tuple_id);
+};
+
+} // namespace starrocks::vectorized
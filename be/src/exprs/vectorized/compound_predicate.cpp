@@ -2,10 +2,16 @@
 
 #include "exprs/vectorized/compound_predicate.h"
 
+#include <boost/algorithm/string/predicate.hpp>
+#include <mutex>
+
 #include "common/object_pool.h"
 #include "exprs/predicate.h"
 #include "exprs/vectorized/binary_function.h"
+#include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/like_predicate.h"
 #include "exprs/vectorized/unary_function.h"
+#include "gutil/casts.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -61,10 +67,25 @@ DEFINE_BINARY_FUNCTION_WITH_IMPL(OrImpl, l_value, r_value) {
     return l_value | r_value;
 }
 
+// The ORs of at least this number of LIKE or REGEXP predicates are matched by one pattern set.
+static const size_t kMinPatternSetSize = 3;
+static const size_t kMaxPatternSetSize = 256;
+
 class VectorizedOrCompoundPredicate final : public Predicate {
 public:
-    DEFINE_COMPOUND_CONSTRUCT(VectorizedOrCompoundPredicate);
+    VectorizedOrCompoundPredicate(const TExprNode& node) : Predicate(node) {}
+    // the pattern set is rebuilt for the clone, whose children are cloned too.
+    VectorizedOrCompoundPredicate(const VectorizedOrCompoundPredicate& other) : Predicate(other) {}
+    ~VectorizedOrCompoundPredicate() override = default;
+    Expr* clone(ObjectPool* pool) const override { return pool->add(new VectorizedOrCompoundPredicate(*this)); }
+
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override {
+        // built by the first evaluation, so only the root of nested ORs builds it.
+        std::call_once(_pattern_set_once, [this, context] { _build_pattern_set(context); });
+        if (_pattern_set != nullptr) {
+            return _pattern_set->match(_pattern_set_value->evaluate(context, ptr));
+        }
+
         auto l = _children[0]->evaluate(context, ptr);
 
         int l_trues = ColumnHelper::count_true_with_notnull(l);
@@ -77,6 +98,66 @@ public:
 
         return VectorizedLogicPredicateBinaryFunction<OrNullImpl, OrImpl>::template evaluate<TYPE_BOOLEAN>(l, r);
     }
+
+private:
+    static void _collect_or_leaves(Expr* expr, std::vector<Expr*>* leaves) {
+        if (expr->node_type() == TExprNodeType::COMPOUND_PRED && expr->op() == TExprOpcode::COMPOUND_OR) {
+            for (Expr* child : expr->children()) {
+                _collect_or_leaves(child, leaves);
+            }
+        } else {
+            leaves->push_back(expr);
+        }
+    }
+
+    // Build the pattern set if all the leaves of the ORs are LIKE predicates, or all are REGEXP predicates, of the
+    // same column and the constant patterns.
+    void _build_pattern_set(ExprContext* context) {
+        std::vector<Expr*> leaves;
+        _collect_or_leaves(this, &leaves);
+        if (leaves.size() < kMinPatternSetSize || leaves.size() > kMaxPatternSetSize) {
+            return;
+        }
+        bool is_like = false;
+        Expr* value = nullptr;
+        std::vector<std::string> patterns;
+        for (Expr* leaf : leaves) {
+            if (leaf->node_type() != TExprNodeType::FUNCTION_CALL || leaf->get_num_children() != 2) {
+                return;
+            }
+            const std::string& fn_name = leaf->fn().name.function_name;
+            bool leaf_is_like = boost::iequals(fn_name, "like");
+            if (!leaf_is_like && !boost::iequals(fn_name, "regexp")) {
+                return;
+            }
+            Expr* leaf_value = leaf->get_child(0);
+            if (value == nullptr) {
+                is_like = leaf_is_like;
+                value = leaf_value;
+            }
+            if (is_like != leaf_is_like || !leaf_value->is_slotref() ||
+                down_cast<ColumnRef*>(leaf_value)->slot_id() != down_cast<ColumnRef*>(value)->slot_id()) {
+                return;
+            }
+            ColumnPtr pattern = leaf->get_child(1)->evaluate_const(context);
+            if (pattern == nullptr || pattern->only_null() || pattern->is_null(0)) {
+                return;
+            }
+            patterns.emplace_back(ColumnHelper::get_const_value<TYPE_VARCHAR>(pattern).to_string());
+        }
+        auto st = LikePatternSet::create(patterns, is_like, &_pattern_set);
+        if (!st.ok()) {
+            // evaluated by the predicates then.
+            LOG(WARNING) << "Fail to build the pattern set of " << patterns.size() << " patterns: " << st.to_string();
+            _pattern_set.reset();
+            return;
+        }
+        _pattern_set_value = value;
+    }
+
+    std::once_flag _pattern_set_once;
+    std::unique_ptr<LikePatternSet> _pattern_set;
+    Expr* _pattern_set_value = nullptr;
 };
 
 DEFINE_UNARY_FN_WITH_IMPL(CompoundPredNot, l) {
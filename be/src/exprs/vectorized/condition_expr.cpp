@@ -2,6 +2,8 @@
 
 #include "exprs/vectorized/condition_expr.h"
 
+#include <algorithm>
+
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
@@ -102,65 +104,118 @@ class VectorizedIfExpr : public Expr {
 public:
     DEFINE_CLASS_CONSTRUCT_FN(VectorizedIfExpr);
 
+    Status open(RuntimeState* state, ExprContext* context, FunctionContext::FunctionStateScope scope) override {
+        RETURN_IF_ERROR(Expr::open(state, context, scope));
+        _slot_ids.clear();
+        get_slot_ids(&_slot_ids);
+        std::sort(_slot_ids.begin(), _slot_ids.end());
+        _slot_ids.erase(std::unique(_slot_ids.begin(), _slot_ids.end()), _slot_ids.end());
+        return Status::OK();
+    }
+
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override {
         auto bhs = _children[0]->evaluate(context, ptr);
-        int true_count = ColumnHelper::count_true_with_notnull(bhs);
+        size_t true_count = ColumnHelper::count_true_with_notnull(bhs);
+        size_t size = bhs->size();
 
-        auto lhs = _children[1]->evaluate(context, ptr);
-        if (true_count == bhs->size()) {
-            return lhs->clone();
+        if (true_count == size) {
+            return _children[1]->evaluate(context, ptr)->clone();
         }
-
-        auto rhs = _children[2]->evaluate(context, ptr);
         if (true_count == 0) {
-            return rhs->clone();
+            return _children[2]->evaluate(context, ptr)->clone();
         }
 
+        ColumnViewer<TYPE_BOOLEAN> bhs_viewer(bhs);
+        bool lhs_on_all_rows = true;
+        bool rhs_on_all_rows = true;
+        auto lhs = evaluate_branch(context, ptr, 1, bhs_viewer, size, true_count, &lhs_on_all_rows);
+        auto rhs = evaluate_branch(context, ptr, 2, bhs_viewer, size, size - true_count, &rhs_on_all_rows);
+
         if (lhs->only_null() && rhs->only_null()) {
-            return lhs->clone();
+            return ColumnHelper::create_const_null_column(size);
         }
 
-        Columns list = {bhs, lhs, rhs};
         ColumnBuilder<Type> result(this->type().precision, this->type().scale);
-
-        auto bhs_nulls = ColumnHelper::count_nulls(bhs);
-        auto lhs_nulls = ColumnHelper::count_nulls(lhs);
-        auto rhs_nulls = ColumnHelper::count_nulls(rhs);
-
-        ColumnViewer<TYPE_BOOLEAN> bhs_viewer(bhs);
         ColumnViewer<Type> lhs_viewer(lhs);
         ColumnViewer<Type> rhs_viewer(rhs);
-        size_t size = list[0]->size();
 
-        // optimization for 3 columns all not null.
-        if (bhs_nulls == 0 && lhs_nulls == 0 && rhs_nulls == 0) {
-            for (int row = 0; row < size; ++row) {
-                if (!bhs_viewer.value(row)) {
-                    result.append(rhs_viewer.value(row));
-                } else {
-                    result.append(lhs_viewer.value(row));
+        if (lhs_on_all_rows && rhs_on_all_rows) {
+            if constexpr (pt_is_fixedlength<Type>) {
+                // select the fixed length values without branches.
+                auto data_column = result.data_column();
+                auto null_column = result.get_null_column();
+                auto& data = data_column->get_data();
+                auto& nulls = null_column->get_data();
+                data.resize(size);
+                nulls.resize(size);
+                uint8_t has_null = 0;
+                for (size_t row = 0; row < size; ++row) {
+                    bool selected = !bhs_viewer.is_null(row) & bhs_viewer.value(row);
+                    data[row] = selected ? lhs_viewer.value(row) : rhs_viewer.value(row);
+                    nulls[row] = selected ? lhs_viewer.is_null(row) : rhs_viewer.is_null(row);
+                    has_null |= nulls[row];
                 }
+                return ColumnBuilder<Type>(data_column, null_column, has_null).build(false);
             }
-        } else {
-            for (int row = 0; row < size; ++row) {
-                if (bhs_viewer.is_null(row) || !bhs_viewer.value(row)) {
-                    if (rhs_viewer.is_null(row)) {
-                        result.append_null();
-                    } else {
-                        result.append(rhs_viewer.value(row));
-                    }
+        }
+
+        // The positions of the next rows of the branches evaluated only on their rows.
+        size_t lhs_pos = 0;
+        size_t rhs_pos = 0;
+        result.reserve(size);
+        for (size_t row = 0; row < size; ++row) {
+            if (!bhs_viewer.is_null(row) && bhs_viewer.value(row)) {
+                size_t pos = lhs_on_all_rows ? row : lhs_pos++;
+                if (lhs_viewer.is_null(pos)) {
+                    result.append_null();
                 } else {
-                    if (lhs_viewer.is_null(row)) {
-                        result.append_null();
-                    } else {
-                        result.append(lhs_viewer.value(row));
-                    }
+                    result.append(lhs_viewer.value(pos));
+                }
+            } else {
+                size_t pos = rhs_on_all_rows ? row : rhs_pos++;
+                if (rhs_viewer.is_null(pos)) {
+                    result.append_null();
+                } else {
+                    result.append(rhs_viewer.value(pos));
                 }
             }
         }
 
-        return result.build(ColumnHelper::is_all_const(list));
+        return result.build(false);
+    }
+
+private:
+    // Evaluate the |child|-th child, which is selected by |count| rows of the |size| rows. It is evaluated only
+    // on these rows if they are no more than half of the rows, and |on_all_rows| is set to false.
+    ColumnPtr evaluate_branch(ExprContext* context, vectorized::Chunk* ptr, int child,
+                              const ColumnViewer<TYPE_BOOLEAN>& bhs_viewer, size_t size, size_t count,
+                              bool* on_all_rows) {
+        Expr* expr = _children[child];
+        *on_all_rows = true;
+        if (ptr == nullptr || ptr->num_rows() != size || count > size / 2 || expr->is_constant()) {
+            return expr->evaluate(context, ptr);
+        }
+
+        // the first child selects the rows which are true, the second one the others.
+        const bool expected = child == 1;
+        std::vector<uint32_t> rows;
+        rows.reserve(count);
+        for (uint32_t row = 0; row < size; ++row) {
+            bool selected = !bhs_viewer.is_null(row) && bhs_viewer.value(row);
+            if (selected == expected) {
+                rows.push_back(row);
+            }
+        }
+        ChunkPtr selected_chunk = FunctionHelper::select_rows(*ptr, _slot_ids, rows);
+        if (selected_chunk == nullptr) {
+            return expr->evaluate(context, ptr);
+        }
+        *on_all_rows = false;
+        return expr->evaluate(context, selected_chunk.get());
     }
+
+    // The slots referred by the children, the columns selected to evaluate a branch on part of the rows.
+    std::vector<SlotId> _slot_ids;
 };
 
 template <PrimitiveType Type>
@@ -2,14 +2,80 @@
 
 #pragma once
 
+#include <limits>
+#include <type_traits>
+#include <vector>
+
 #include "column/column_builder.h"
 #include "exprs/vectorized/arithmetic_operation.h"
 #include "exprs/vectorized/binary_function.h"
 #include "runtime/primitive_type.h"
+#include "simd/simd.h"
 
 namespace starrocks::vectorized {
 template <bool check_overflow, typename Op>
 struct DecimalBinaryFunction {
+    // Whether the result of |Op| may overflow ResultCppType, according to the precisions and scales of the
+    // operands. The integral digits of add/sub grow by one digit at most, and the digits of mul are the sum of the
+    // digits of the operands. div and mod are always checked, because of the divisors of zero.
+    template <typename BinaryOp, typename ResultCppType>
+    static inline bool may_overflow(int lhs_precision, int lhs_scale, int rhs_precision, int rhs_scale) {
+        constexpr int max_precision = decimal_precision_limit<ResultCppType>;
+        if constexpr (is_add_op<BinaryOp> || is_sub_op<BinaryOp>) {
+            int integral_digits = std::max(lhs_precision - lhs_scale, rhs_precision - rhs_scale) + 1;
+            return integral_digits + std::max(lhs_scale, rhs_scale) > max_precision;
+        } else if constexpr (is_mul_op<BinaryOp>) {
+            return lhs_precision + rhs_precision > max_precision;
+        } else {
+            return true;
+        }
+    }
+
+    // Whether all the |num_rows| values of |data| are in [-max_abs, max_abs], with one OR-reduction.
+    static inline bool all_in_range(const int128_t* data, size_t num_rows, int64_t max_abs) {
+        bool out_of_range = false;
+        for (size_t i = 0; i < num_rows; ++i) {
+            out_of_range |= (data[i] > max_abs) | (data[i] < -max_abs);
+        }
+        return !out_of_range;
+    }
+
+    // The 128-bit division is much slower than the 64-bit one. If the scaled dividends and the divisors all fit in
+    // int64, i.e. the values of the decimal128 columns are small, which is usual for decimal(38, x) columns,
+    // divide them in int64 and return true. Return false if any of them does not.
+    template <bool check, bool lhs_is_const, bool rhs_is_const, typename BinaryOperator>
+    static inline bool div_in_int64(size_t num_rows, const int128_t* lhs_data, const int128_t* rhs_data,
+                                    int128_t* result_data, NullColumn::ValueType* nulls, bool* has_null,
+                                    int adjust_scale) {
+        static constexpr int64_t int64_max = std::numeric_limits<int64_t>::max();
+        if (adjust_scale > decimal_precision_limit<int64_t>) {
+            return false;
+        }
+        const size_t lhs_rows = lhs_is_const ? 1 : num_rows;
+        const size_t rhs_rows = rhs_is_const ? 1 : num_rows;
+        if (!all_in_range(lhs_data, lhs_rows, int64_max / get_scale_factor<int64_t>(adjust_scale)) ||
+            !all_in_range(rhs_data, rhs_rows, int64_max)) {
+            return false;
+        }
+
+        std::vector<int64_t> lhs64(lhs_data, lhs_data + lhs_rows);
+        std::vector<int64_t> rhs64(rhs_data, rhs_data + rhs_rows);
+        std::vector<int64_t> result64(num_rows);
+        if (adjust_scale == 0) {
+            adjust_evaluate<check, lhs_is_const, rhs_is_const, false, BinaryOperator>(
+                    num_rows, lhs64.data(), rhs64.data(), result64.data(), nulls, has_null, adjust_scale);
+        } else {
+            adjust_evaluate<check, lhs_is_const, rhs_is_const, true, BinaryOperator>(
+                    num_rows, lhs64.data(), rhs64.data(), result64.data(), nulls, has_null, adjust_scale);
+        }
+        // the quotient of a zero divisor is the maximum of the result type, like the 128-bit division.
+        static constexpr int128_t max_result = get_max<int128_t>();
+        for (size_t i = 0; i < num_rows; ++i) {
+            result_data[i] = rhs64[rhs_is_const ? 0 : i] == 0 ? max_result : result64[i];
+        }
+        return true;
+    }
+
     // Adjust the scale of lhs operand, then evaluate binary operation, the rules about operand
     // scaling is defined in function: compute_result_type.  each operations are depicted as
     // following:
@@ -30,8 +96,12 @@ struct DecimalBinaryFunction {
     // 3. MulOp: in any cases, S(result) = S(lhs)+ S(rhs), no need to scale lhs operand.
     //
     // 4. DivOp: always scale lhs by max(S(lhs),7) + S(rhs) - S(lhs)
-    template <bool lhs_is_const, bool rhs_is_const, bool adjust_left, typename BinaryOperator, typename LhsCppType,
-              typename RhsCppType, typename ResultCppType>
+    //
+    // |check| is whether the overflows are checked in this evaluation, it's false if check_overflow is true but the
+    // precisions of the operands make overflows impossible. The overflows of the rows are stored into |nulls|
+    // without branches, and |has_null| is found from |nulls| after the loop.
+    template <bool check, bool lhs_is_const, bool rhs_is_const, bool adjust_left, typename BinaryOperator,
+              typename LhsCppType, typename RhsCppType, typename ResultCppType>
     static inline bool adjust_evaluate(size_t num_rows, const LhsCppType* lhs_data, const RhsCppType* rhs_data,
                                        ResultCppType* result_data, NullColumn::ValueType* nulls, bool* has_null,
                                        int adjust_scale) {
@@ -45,10 +115,9 @@ struct DecimalBinaryFunction {
             lhs_datum = lhs_data[0];
             // adjust left operand
             if constexpr (adjust_left) {
-                overflow = DecimalV3Cast::scale_up<LhsCppType, LhsCppType, check_overflow>(lhs_datum, scale_factor,
-                                                                                           &lhs_datum);
+                overflow = DecimalV3Cast::scale_up<LhsCppType, LhsCppType, check>(lhs_datum, scale_factor, &lhs_datum);
                 // adjusting operand generates decimal overflow
-                if constexpr (check_overflow) {
+                if constexpr (check) {
                     if (overflow) {
                         return true;
                     }
@@ -62,27 +131,27 @@ struct DecimalBinaryFunction {
 
         for (auto i = 0; i < num_rows; ++i) {
             if constexpr (lhs_is_const && rhs_is_const) {
-                overflow = BinaryOperator::template apply<check_overflow, false, LhsCppType, RhsCppType, ResultCppType>(
+                overflow = BinaryOperator::template apply<check, false, LhsCppType, RhsCppType, ResultCppType>(
                         lhs_datum, rhs_datum, &result_data[i], scale_factor);
             } else if constexpr (lhs_is_const) {
-                overflow = BinaryOperator::template apply<check_overflow, false, LhsCppType, RhsCppType, ResultCppType>(
+                overflow = BinaryOperator::template apply<check, false, LhsCppType, RhsCppType, ResultCppType>(
                         lhs_datum, rhs_data[i], &result_data[i], scale_factor);
             } else if constexpr (rhs_is_const) {
-                overflow = BinaryOperator::template apply<check_overflow, adjust_left, LhsCppType, RhsCppType,
+                overflow = BinaryOperator::template apply<check, adjust_left, LhsCppType, RhsCppType,
                                                           ResultCppType>(lhs_data[i], rhs_datum, &result_data[i],
                                                                          scale_factor);
             } else {
-                overflow = BinaryOperator::template apply<check_overflow, adjust_left, LhsCppType, RhsCppType,
+                overflow = BinaryOperator::template apply<check, adjust_left, LhsCppType, RhsCppType,
                                                           ResultCppType>(lhs_data[i], rhs_data[i], &result_data[i],
                                                                          scale_factor);
             }
-            if constexpr (check_overflow) {
-                if (overflow) {
-                    *has_null = true;
-                    nulls[i] = DATUM_NULL;
-                }
+            if constexpr (check) {
+                nulls[i] = overflow;
             }
         }
+        if constexpr (check) {
+            *has_null = SIMD::count_nonzero(nulls, num_rows) > 0;
+        }
         return false;
     }
 
@@ -117,49 +186,69 @@ struct DecimalBinaryFunction {
 
         using BinaryOperator = ArithmeticBinaryOperator<Op, ResultType>;
 
-        if constexpr (is_add_op<Op> || is_sub_op<Op> || is_mod_op<Op>) {
-            // add/sub operation
-            if (adjust_scale == 0) {
-                // S(lhs)==S(rhs) no need to adjust
-                all_null = adjust_evaluate<lhs_is_const, rhs_is_const, false, BinaryOperator>(
-                        num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
-            } else if (lhs_scale < rhs_scale) {
-                // S(lhs) < S(rhs), scale lhs up by S(rhs)-S(lhs)
-                all_null = adjust_evaluate<lhs_is_const, rhs_is_const, true, BinaryOperator>(
+        auto compute = [&](auto check_tag) {
+            constexpr bool check = decltype(check_tag)::value;
+            if constexpr (is_add_op<Op> || is_sub_op<Op> || is_mod_op<Op>) {
+                // add/sub operation
+                if (adjust_scale == 0) {
+                    // S(lhs)==S(rhs) no need to adjust
+                    return adjust_evaluate<check, lhs_is_const, rhs_is_const, false, BinaryOperator>(
+                            num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
+                } else if (lhs_scale < rhs_scale) {
+                    // S(lhs) < S(rhs), scale lhs up by S(rhs)-S(lhs)
+                    return adjust_evaluate<check, lhs_is_const, rhs_is_const, true, BinaryOperator>(
+                            num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
+                } else {
+                    // S(lhs) > S(rhs), scale rhs up by S(lhs)-S(rhs)
+                    if constexpr (is_add_op<Op>) {
+                        // add: just swap two operands
+                        return adjust_evaluate<check, rhs_is_const, lhs_is_const, true, BinaryOperator>(
+                                num_rows, rhs_data, lhs_data, result_data, nulls, &has_null, adjust_scale);
+                    } else if constexpr (is_sub_op<Op>) {
+                        // sub: just swap two operand and then rhs - lhs
+                        using ReverseSubOperator = ArithmeticBinaryOperator<ReverseSubOp, ResultType>;
+                        return adjust_evaluate<check, rhs_is_const, lhs_is_const, true, ReverseSubOperator>(
+                                num_rows, rhs_data, lhs_data, result_data, nulls, &has_null, adjust_scale);
+                    } else {
+                        // mod: just swap two operand and then rhs - lhs
+                        using ReverseModOperator = ArithmeticBinaryOperator<ReverseModOp, ResultType>;
+                        return adjust_evaluate<check, rhs_is_const, lhs_is_const, true, ReverseModOperator>(
+                                num_rows, rhs_data, lhs_data, result_data, nulls, &has_null, adjust_scale);
+                    }
+                }
+            } else if constexpr (is_mul_op<Op>) {
+                // mul operation, no need to adjust scale
+                return adjust_evaluate<check, lhs_is_const, rhs_is_const, false, BinaryOperator>(
                         num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
             } else {
-                // S(lhs) > S(rhs), scale rhs up by S(lhs)-S(rhs)
-                if constexpr (is_add_op<Op>) {
-                    // add: just swap two operands
-                    all_null = adjust_evaluate<rhs_is_const, lhs_is_const, true, BinaryOperator>(
-                            num_rows, rhs_data, lhs_data, result_data, nulls, &has_null, adjust_scale);
-                } else if constexpr (is_sub_op<Op>) {
-                    // sub: just swap two operand and then rhs - lhs
-                    using ReverseSubOperator = ArithmeticBinaryOperator<ReverseSubOp, ResultType>;
-                    all_null = adjust_evaluate<rhs_is_const, lhs_is_const, true, ReverseSubOperator>(
-                            num_rows, rhs_data, lhs_data, result_data, nulls, &has_null, adjust_scale);
-                } else if constexpr (is_mod_op<Op>) {
-                    // mod: just swap two operand and then rhs - lhs
-                    using ReverseModOperator = ArithmeticBinaryOperator<ReverseModOp, ResultType>;
-                    all_null = adjust_evaluate<rhs_is_const, lhs_is_const, true, ReverseModOperator>(
-                            num_rows, rhs_data, lhs_data, result_data, nulls, &has_null, adjust_scale);
+                static_assert(is_div_op<Op>, "Invalid Op");
+                // div operation, scale lhs up by S(rhs)
+                if constexpr (std::is_same_v<LhsCppType, int128_t> && std::is_same_v<RhsCppType, int128_t> &&
+                              std::is_same_v<ResultCppType, int128_t>) {
+                    if (div_in_int64<check, lhs_is_const, rhs_is_const, BinaryOperator>(
+                                num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale)) {
+                        return false;
+                    }
+                }
+                if (adjust_scale == 0) {
+                    return adjust_evaluate<check, lhs_is_const, rhs_is_const, false, BinaryOperator>(
+                            num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
                 } else {
-                    static_assert(is_add_op<Op> || is_sub_op<Op>, "Invalid Op");
+                    return adjust_evaluate<check, lhs_is_const, rhs_is_const, true, BinaryOperator>(
+                            num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
                 }
             }
-        } else if constexpr (is_mul_op<Op>) {
-            // mul operation, no need to adjust scale
-            all_null = adjust_evaluate<lhs_is_const, rhs_is_const, false, BinaryOperator>(
-                    num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
-        } else if constexpr (is_div_op<Op>) {
-            // div operation, scale lhs up by S(rhs)
-            if (adjust_scale == 0) {
-                all_null = adjust_evaluate<lhs_is_const, rhs_is_const, false, BinaryOperator>(
-                        num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
+        };
+
+        if constexpr (check_overflow) {
+            if (may_overflow<Op, ResultCppType>(lhs_column->precision(), lhs_scale, rhs_column->precision(),
+                                                rhs_scale)) {
+                all_null = compute(std::true_type());
             } else {
-                all_null = adjust_evaluate<lhs_is_const, rhs_is_const, true, BinaryOperator>(
-                        num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
+                compute(std::false_type());
             }
+        } else {
+            compute(std::false_type());
         }
 
         if constexpr (check_overflow) {
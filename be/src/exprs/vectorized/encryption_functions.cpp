@@ -17,12 +17,52 @@
 namespace starrocks {
 namespace vectorized {
 
+// The cipher of a thread, which is initialized by the key of the last value, so the key is expanded only once
+// if the key column is constant.
+struct AesFunctionState {
+    AesCipher cipher;
+    bool initialized = false;
+    std::string key;
+
+    bool init(bool is_encrypt, const Slice& key_value) {
+        if (initialized && key == key_value) {
+            return true;
+        }
+        key.assign(key_value.data, key_value.size);
+        initialized = cipher.init(AES_128_ECB, is_encrypt, (unsigned char*)key_value.data, key_value.size, nullptr,
+                                  true);
+        return initialized;
+    }
+};
+
+Status EncryptionFunctions::aes_prepare(FunctionContext* context, FunctionContext::FunctionStateScope scope) {
+    if (scope == FunctionContext::THREAD_LOCAL) {
+        context->set_function_state(scope, new AesFunctionState());
+    }
+    return Status::OK();
+}
+
+Status EncryptionFunctions::aes_close(FunctionContext* context, FunctionContext::FunctionStateScope scope) {
+    if (scope == FunctionContext::THREAD_LOCAL) {
+        auto* state = reinterpret_cast<AesFunctionState*>(context->get_function_state(scope));
+        delete state;
+    }
+    return Status::OK();
+}
+
 ColumnPtr EncryptionFunctions::aes_encrypt(FunctionContext* ctx, const Columns& columns) {
     auto src_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
     auto key_viewer = ColumnViewer<TYPE_VARCHAR>(columns[1]);
 
+    AesFunctionState local_state;
+    auto* state = reinterpret_cast<AesFunctionState*>(ctx->get_function_state(FunctionContext::THREAD_LOCAL));
+    if (state == nullptr) {
+        state = &local_state;
+    }
+
     const int size = columns[0]->size();
     ColumnBuilder<TYPE_VARCHAR> result;
+    std::vector<unsigned char> buffer;
     for (int row = 0; row < size; ++row) {
         if (src_viewer.is_null(row)) {
             result.append_null();
@@ -35,18 +75,20 @@ ColumnPtr EncryptionFunctions::aes_encrypt(FunctionContext* ctx, const Columns&
             continue;
         }
 
-        int cipher_len = src_value.size + 16;
-        char p[cipher_len];
-
         auto key_value = key_viewer.value(row);
-        int len = AesUtil::encrypt(AES_128_ECB, (unsigned char*)src_value.data, src_value.size,
-                                   (unsigned char*)key_value.data, key_value.size, NULL, true, (unsigned char*)p);
+        if (!state->init(true, key_value)) {
+            result.append_null();
+            continue;
+        }
+
+        buffer.resize(src_value.size + 16);
+        int len = state->cipher.update((unsigned char*)src_value.data, src_value.size, buffer.data());
         if (len < 0) {
             result.append_null();
             continue;
         }
 
-        result.append(Slice(p, len));
+        result.append(Slice(buffer.data(), len));
     }
 
     return result.build(ColumnHelper::is_all_const(columns));
@@ -56,8 +98,15 @@ ColumnPtr EncryptionFunctions::aes_decrypt(FunctionContext* ctx, const Columns&
     auto src_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
     auto key_viewer = ColumnViewer<TYPE_VARCHAR>(columns[1]);
 
+    AesFunctionState local_state;
+    auto* state = reinterpret_cast<AesFunctionState*>(ctx->get_function_state(FunctionContext::THREAD_LOCAL));
+    if (state == nullptr) {
+        state = &local_state;
+    }
+
     const int size = columns[0]->size();
     ColumnBuilder<TYPE_VARCHAR> result;
+    std::vector<unsigned char> buffer;
     for (int row = 0; row < size; ++row) {
         if (src_viewer.is_null(row) || key_viewer.is_null(row)) {
             result.append_null();
@@ -71,18 +120,20 @@ ColumnPtr EncryptionFunctions::aes_decrypt(FunctionContext* ctx, const Columns&
             continue;
         }
 
-        int cipher_len = src_value.size;
-        char p[cipher_len];
-
-        int len = AesUtil::decrypt(AES_128_ECB, (unsigned char*)src_value.data, src_value.size,
-                                   (unsigned char*)key_value.data, key_value.size, NULL, true, (unsigned char*)p);
+        if (!state->init(false, key_value)) {
+            result.append_null();
+            continue;
+        }
 
+        // the decrypted value is no longer than the encrypted one, plus a block for the final of openssl.
+        buffer.resize(src_value.size + 16);
+        int len = state->cipher.update((unsigned char*)src_value.data, src_value.size, buffer.data());
         if (len < 0) {
             result.append_null();
             continue;
         }
 
-        result.append(Slice(p, len));
+        result.append(Slice(buffer.data(), len));
     }
 
     return result.build(ColumnHelper::is_all_const(columns));
@@ -181,6 +232,12 @@ ColumnPtr EncryptionFunctions::md5sum(FunctionContext* ctx, const Columns& colum
 ColumnPtr EncryptionFunctions::md5(FunctionContext* ctx, const Columns& columns) {
     auto src_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
 
+    // the digest of each value is computed in one shot and encoded into a buffer on the stack,
+    // without the context and the string of Md5Digest.
+    static const char dig_vec_lower[] = "0123456789abcdef";
+    unsigned char digest[MD5_DIGEST_LENGTH];
+    char hex[2 * MD5_DIGEST_LENGTH];
+
     ColumnBuilder<TYPE_VARCHAR> result;
     auto size = columns[0]->size();
     for (int row = 0; row < size; row++) {
@@ -190,11 +247,13 @@ ColumnPtr EncryptionFunctions::md5(FunctionContext* ctx, const Columns& columns)
         }
 
         auto src_value = src_viewer.value(row);
-        Md5Digest digest;
-        digest.update(src_value.data, src_value.size);
-        digest.digest();
+        MD5((const unsigned char*)src_value.data, src_value.size, digest);
+        for (int i = 0; i < MD5_DIGEST_LENGTH; ++i) {
+            hex[2 * i] = dig_vec_lower[digest[i] >> 4];
+            hex[2 * i + 1] = dig_vec_lower[digest[i] & 0x0F];
+        }
 
-        result.append(Slice(digest.hex().c_str(), digest.hex().size()));
+        result.append(Slice(hex, sizeof(hex)));
     }
 
     return result.build(ColumnHelper::is_all_const(columns));
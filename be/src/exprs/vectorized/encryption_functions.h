@@ -26,6 +26,12 @@ public:
      */
     DEFINE_VECTORIZED_FN(aes_decrypt);
 
+    // aes_encrypt and aes_decrypt's auxiliary method, which creates the cipher of a thread.
+    static Status aes_prepare(starrocks_udf::FunctionContext* context,
+                              starrocks_udf::FunctionContext::FunctionStateScope scope);
+    static Status aes_close(starrocks_udf::FunctionContext* context,
+                            starrocks_udf::FunctionContext::FunctionStateScope scope);
+
     /**
      * @param: [json_string, tagged_value]
      * @paramType: [BinaryColumn, BinaryColumn]
@@ -2,36 +2,51 @@
 
 #include "exprs/vectorized/function_call_expr.h"
 
+#include "column/binary_column.h"
+#include "column/column_hash.h"
 #include "column/column_helper.h"
 #include "column/const_column.h"
 #include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
 #include "exprs/anyval_util.h"
 #include "exprs/vectorized/builtin_functions.h"
+#include "exprs/vectorized/columnar_udf.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/user_function_cache.h"
+#include "util/phmap/phmap.h"
 
 namespace starrocks::vectorized {
 
+// A chunk is evaluated by its distinct strings only if it has at least so many rows, and each distinct string is
+// shared by so many rows on average.
+static constexpr size_t kDictMinRows = 64;
+static constexpr size_t kDictMinRowsPerWord = 8;
+// The distinct strings are counted on the first rows first, so a high cardinality column is given up early.
+static constexpr size_t kDictSampleRows = 256;
+
 VectorizedFunctionCallExpr::VectorizedFunctionCallExpr(const TExprNode& node) : Expr(node), _fn_desc(nullptr) {}
 
 Status VectorizedFunctionCallExpr::prepare(starrocks::RuntimeState* state, const starrocks::RowDescriptor& row_desc,
                                            starrocks::ExprContext* context) {
     RETURN_IF_ERROR(Expr::prepare(state, row_desc, context));
 
-    if (!_fn.__isset.fid) {
+    if (_fn.binary_type == TFunctionBinaryType::COLUMNAR) {
+        RETURN_IF_ERROR(_prepare_columnar_udf());
+    } else if (!_fn.__isset.fid) {
         return Status::InternalError("Vectorized engine doesn't implement function " + _fn.name.function_name);
-    }
-
-    _fn_desc = BuiltinFunctions::find_builtin_function(_fn.fid);
+    } else {
+        _fn_desc = BuiltinFunctions::find_builtin_function(_fn.fid);
 
-    if (_fn_desc == nullptr || _fn_desc->scalar_function == nullptr) {
-        return Status::InternalError("Vectorized engine doesn't implement function " + _fn.name.function_name);
-    }
+        if (_fn_desc == nullptr || _fn_desc->scalar_function == nullptr) {
+            return Status::InternalError("Vectorized engine doesn't implement function " + _fn.name.function_name);
+        }
 
-    if (_fn_desc->args_nums > _children.size()) {
-        return Status::InternalError(strings::Substitute("Vectorized function $0 requires $1 arguments but given $2",
-                                                         _fn.name.function_name, _fn_desc->args_nums,
-                                                         _children.size()));
+        if (_fn_desc->args_nums > _children.size()) {
+            return Status::InternalError(strings::Substitute(
+                    "Vectorized function $0 requires $1 arguments but given $2", _fn.name.function_name,
+                    _fn_desc->args_nums, _children.size()));
+        }
     }
 
     FunctionContext::TypeDesc return_type = AnyValUtil::column_type_to_type_desc(_type);
@@ -48,6 +63,31 @@ Status VectorizedFunctionCallExpr::prepare(starrocks::RuntimeState* state, const
     return Status::OK();
 }
 
+Status VectorizedFunctionCallExpr::_prepare_columnar_udf() {
+    std::vector<TypeDescriptor> arg_types;
+    for (Expr* child : _children) {
+        arg_types.push_back(child->type());
+    }
+    RETURN_IF_ERROR(ColumnarUdfCall::check_types(_type, arg_types));
+    _columnar_udf_arg_types = std::move(arg_types);
+
+    // the columnar UDFs are extern "C" functions, whose symbols are never mangled.
+    auto* cache = UserFunctionCache::instance();
+    RETURN_IF_ERROR(cache->get_function_ptr(_fn.id, _fn.scalar_fn.symbol, _fn.hdfs_location, _fn.checksum,
+                                            reinterpret_cast<void**>(&_columnar_udf), &_cache_entry));
+    if (_fn.scalar_fn.__isset.prepare_fn_symbol) {
+        RETURN_IF_ERROR(cache->get_function_ptr(_fn.id, _fn.scalar_fn.prepare_fn_symbol, _fn.hdfs_location,
+                                                _fn.checksum, reinterpret_cast<void**>(&_udf_prepare_fn),
+                                                &_cache_entry));
+    }
+    if (_fn.scalar_fn.__isset.close_fn_symbol) {
+        RETURN_IF_ERROR(cache->get_function_ptr(_fn.id, _fn.scalar_fn.close_fn_symbol, _fn.hdfs_location,
+                                                _fn.checksum, reinterpret_cast<void**>(&_udf_close_fn),
+                                                &_cache_entry));
+    }
+    return Status::OK();
+}
+
 Status VectorizedFunctionCallExpr::open(starrocks::RuntimeState* state, starrocks::ExprContext* context,
                                         FunctionContext::FunctionStateScope scope) {
     RETURN_IF_ERROR(Expr::open(state, context, scope));
@@ -63,7 +103,17 @@ Status VectorizedFunctionCallExpr::open(starrocks::RuntimeState* state, starrock
         fn_ctx->impl()->set_constant_columns(std::move(const_columns));
     }
 
-    if (_fn_desc->prepare_function != nullptr) {
+    if (_udf_prepare_fn != nullptr) {
+        if (scope == FunctionContext::FRAGMENT_LOCAL) {
+            _udf_prepare_fn(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+        }
+        _udf_prepare_fn(fn_ctx, FunctionContext::THREAD_LOCAL);
+        if (fn_ctx->has_error()) {
+            return Status::InternalError(fn_ctx->error_msg());
+        }
+    }
+
+    if (_fn_desc != nullptr && _fn_desc->prepare_function != nullptr) {
         if (scope == FunctionContext::FRAGMENT_LOCAL) {
             RETURN_IF_ERROR(_fn_desc->prepare_function(fn_ctx, FunctionContext::FRAGMENT_LOCAL));
         }
@@ -88,6 +138,8 @@ Status VectorizedFunctionCallExpr::open(starrocks::RuntimeState* state, starrock
     } else {
         _is_rand_function = false;
     }
+    const std::string& name = _fn.name.function_name;
+    _is_deterministic = !_is_rand_function && name != "uuid" && name != "uuid_numeric" && name != "sleep";
 
     return Status::OK();
 }
@@ -103,6 +155,15 @@ void VectorizedFunctionCallExpr::close(starrocks::RuntimeState* state, starrocks
         }
     }
 
+    if (_udf_close_fn != nullptr) {
+        FunctionContext* fn_ctx = context->fn_context(_fn_context_index);
+        _udf_close_fn(fn_ctx, FunctionContext::THREAD_LOCAL);
+
+        if (scope == FunctionContext::FRAGMENT_LOCAL) {
+            _udf_close_fn(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+        }
+    }
+
     Expr::close(state, context, scope);
 }
 
@@ -142,6 +203,30 @@ ColumnPtr VectorizedFunctionCallExpr::evaluate(starrocks::ExprContext* context,
     }
 #endif
 
+    if (_columnar_udf != nullptr) {
+        size_t num_rows = ptr != nullptr ? ptr->num_rows() : 1;
+        return ColumnarUdfCall::call(_columnar_udf, fn_ctx, _type, _columnar_udf_arg_types, args, num_rows);
+    }
+
+    if (ptr != nullptr && _is_deterministic && config::enable_low_cardinality_function_evaluation) {
+        // the only argument which is not a constant.
+        size_t idx = args.size();
+        size_t num_non_const = 0;
+        for (size_t i = 0; i < args.size(); i++) {
+            if (!args[i]->is_constant()) {
+                idx = i;
+                num_non_const++;
+            }
+        }
+        if (num_non_const == 1 && (_children[idx]->type().type == TYPE_VARCHAR ||
+                                   _children[idx]->type().type == TYPE_CHAR)) {
+            ColumnPtr result = evaluate_by_dict(fn_ctx, args, idx);
+            if (result != nullptr) {
+                return result;
+            }
+        }
+    }
+
     ColumnPtr result = _fn_desc->scalar_function(fn_ctx, args);
     // For no args function call (pi, e)
     if (result->is_constant() && ptr != nullptr) {
@@ -150,4 +235,69 @@ ColumnPtr VectorizedFunctionCallExpr::evaluate(starrocks::ExprContext* context,
     return result;
 }
 
+ColumnPtr VectorizedFunctionCallExpr::evaluate_by_dict(FunctionContext* fn_ctx, const Columns& args, size_t idx) {
+    const ColumnPtr& column = args[idx];
+    if (column->has_null()) {
+        return nullptr;
+    }
+    const Column* data_column = column.get();
+    if (column->is_nullable()) {
+        data_column = down_cast<const NullableColumn*>(column.get())->data_column().get();
+    }
+    if (!data_column->is_binary()) {
+        return nullptr;
+    }
+    const auto* binary = down_cast<const BinaryColumn*>(data_column);
+    const size_t num_rows = binary->size();
+    if (num_rows < kDictMinRows) {
+        return nullptr;
+    }
+
+    // the distinct strings, in the order they first appear, and the code of each row.
+    phmap::flat_hash_map<Slice, uint32_t, SliceHash, SliceEqual> word_codes;
+    auto words = BinaryColumn::create();
+    std::vector<uint32_t> codes(num_rows);
+    const size_t sample_rows = std::min(num_rows, kDictSampleRows);
+    size_t max_words = sample_rows / kDictMinRowsPerWord;
+    for (size_t row = 0; row < num_rows; row++) {
+        if (row == sample_rows) {
+            max_words = num_rows / kDictMinRowsPerWord;
+        }
+        Slice word = binary->get_slice(row);
+        auto [iter, inserted] = word_codes.emplace(word, static_cast<uint32_t>(word_codes.size()));
+        if (inserted) {
+            if (word_codes.size() > max_words) {
+                return nullptr;
+            }
+            words->append(word);
+        }
+        codes[row] = iter->second;
+    }
+
+    const size_t num_words = words->size();
+    Columns dict_args;
+    dict_args.reserve(args.size());
+    for (size_t i = 0; i < args.size(); i++) {
+        if (i == idx) {
+            if (column->is_nullable()) {
+                dict_args.emplace_back(NullableColumn::create(words, NullColumn::create(num_words, 0)));
+            } else {
+                dict_args.emplace_back(words);
+            }
+        } else {
+            const auto* const_column = down_cast<const ConstColumn*>(args[i].get());
+            dict_args.emplace_back(ConstColumn::create(const_column->data_column(), num_words));
+        }
+    }
+
+    ColumnPtr dict_result = _fn_desc->scalar_function(fn_ctx, dict_args);
+    if (dict_result->is_constant()) {
+        dict_result->resize(num_rows);
+        return dict_result;
+    }
+    ColumnPtr result = dict_result->clone_empty();
+    result->append_selective(*dict_result, codes.data(), 0, num_rows);
+    return result;
+}
+
 } // namespace starrocks::vectorized
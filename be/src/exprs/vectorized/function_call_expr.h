@@ -5,8 +5,12 @@
 #include "common/object_pool.h"
 #include "exprs/expr.h"
 #include "exprs/vectorized/builtin_functions.h"
+#include "udf/udf_columnar.h"
 
 namespace starrocks {
+
+struct UserFunctionCacheEntry;
+
 namespace vectorized {
 
 class VectorizedFunctionCallExpr final : public Expr {
@@ -29,10 +33,27 @@ protected:
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override;
 
 private:
+    // Resolve the functions of the columnar UDF, see udf/udf_columnar.h.
+    Status _prepare_columnar_udf();
+
+    // Evaluate the function on the distinct strings of |args[idx]|, the only argument which is not a constant,
+    // and map the results to the rows. Return nullptr if the column has nulls or too many distinct strings.
+    ColumnPtr evaluate_by_dict(FunctionContext* fn_ctx, const Columns& args, size_t idx);
+
     const FunctionDescriptor* _fn_desc;
 
+    // the functions of a columnar UDF, which has no _fn_desc.
+    starrocks_udf::ColumnarUdf _columnar_udf = nullptr;
+    starrocks_udf::UdfPrepare _udf_prepare_fn = nullptr;
+    starrocks_udf::UdfClose _udf_close_fn = nullptr;
+    UserFunctionCacheEntry* _cache_entry = nullptr;
+    std::vector<TypeDescriptor> _columnar_udf_arg_types;
+
     // is rand/random function.
     bool _is_rand_function = false;
+
+    // whether the result of a row depends only on the arguments of the row, without side effects.
+    bool _is_deterministic = true;
 };
 
 } // namespace vectorized
@@ -94,5 +94,23 @@ NullColumnPtr FunctionHelper::union_null_column(const NullColumnPtr& v1, const N
     return null_result;
 }
 
+ChunkPtr FunctionHelper::select_rows(const Chunk& chunk, const std::vector<SlotId>& slot_ids,
+                                     const std::vector<uint32_t>& rows) {
+    ChunkPtr result;
+    for (SlotId slot_id : slot_ids) {
+        if (!chunk.is_slot_exist(slot_id)) {
+            continue;
+        }
+        if (result == nullptr) {
+            result = std::make_shared<Chunk>();
+        }
+        const ColumnPtr& column = chunk.get_column_by_slot_id(slot_id);
+        ColumnPtr selected = column->clone_empty();
+        selected->append_selective(*column, rows.data(), 0, rows.size());
+        result->append_column(std::move(selected), slot_id);
+    }
+    return result;
+}
+
 } // namespace vectorized
 } // namespace starrocks
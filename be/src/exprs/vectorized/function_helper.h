@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/const_column.h"
 #include "column/type_traits.h"
@@ -39,6 +40,14 @@ public:
                                               NullColumnPtr* produce_null_column);
 
     static NullColumnPtr union_null_column(const NullColumnPtr& v1, const NullColumnPtr& v2);
+
+    /**
+     * The chunk of the rows |rows| of |chunk|, with only the columns of the slots |slot_ids| which exist in
+     * |chunk|, e.g. to evaluate a branch of a conditional expression only on the rows which select it.
+     * Return nullptr if none of |slot_ids| exists in |chunk|.
+     */
+    static ChunkPtr select_rows(const Chunk& chunk, const std::vector<SlotId>& slot_ids,
+                                const std::vector<uint32_t>& rows);
 };
 
 #define DEFINE_VECTORIZED_FN(NAME) static ColumnPtr NAME(FunctionContext* context, const Columns& columns)
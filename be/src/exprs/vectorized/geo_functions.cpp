@@ -354,9 +354,17 @@ ColumnPtr GeoFunctions::st_contains(FunctionContext* context, const Columns& col
             continue;
         }
 
-        GeoShape* shapes[2] = {nullptr, nullptr};
         auto lhs_value = lhs_viewer.value(row);
         auto rhs_value = rhs_viewer.value(row);
+        // the points are tested against the prepared constant shape without being created.
+        bool contained = false;
+        if (state != nullptr && state->shapes[0] != nullptr && state->shapes[1] == nullptr &&
+            state->shapes[0]->contains_encoded(rhs_value.data, rhs_value.size, &contained)) {
+            result.append(contained);
+            continue;
+        }
+
+        GeoShape* shapes[2] = {nullptr, nullptr};
         const Slice* strs[2] = {&lhs_value, &rhs_value};
         // use this to delete new
         StContainsState local_state;
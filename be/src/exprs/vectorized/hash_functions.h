@@ -19,32 +19,51 @@ public:
 
 inline ColumnPtr HashFunctions::murmur_hash3_32(FunctionContext* context,
                                                 const starrocks::vectorized::Columns& columns) {
-    std::vector<ColumnViewer<TYPE_VARCHAR>> viewers;
+    // the hashes of all the rows are updated column by column, over the bytes of the binary columns,
+    // and a row is null if any of its values is null.
+    const bool is_const = ColumnHelper::is_all_const(columns);
+    const size_t size = is_const ? 1 : columns[0]->size();
+    auto result = Int32Column::create(size, HashUtil::MURMUR3_32_SEED);
+    auto* hashes = reinterpret_cast<uint32_t*>(result->get_data().data());
+    NullColumnPtr null_column;
 
-    for (int i = 0; i < columns.size(); ++i) {
-        viewers.emplace_back(columns[i]);
-    }
-
-    ColumnBuilder<TYPE_INT> builder;
+    for (const auto& column : columns) {
+        if (column->only_null()) {
+            return ColumnHelper::create_const_null_column(columns[0]->size());
+        }
 
-    size_t size = columns[0]->size();
-    for (int row = 0; row < size; ++row) {
-        uint32_t seed = HashUtil::MURMUR3_32_SEED;
-        bool has_null = false;
-        for (const auto& viewer : viewers) {
-            if (viewer.is_null(row)) {
-                has_null = true;
-                break;
+        if (column->is_constant()) {
+            auto value = ColumnViewer<TYPE_VARCHAR>(column).value(0);
+            for (size_t row = 0; row < size; ++row) {
+                hashes[row] = HashUtil::murmur_hash3_32(value.data, value.size, hashes[row]);
             }
+            continue;
+        }
 
-            auto slice = viewer.value(row);
-            seed = HashUtil::murmur_hash3_32(slice.data, slice.size, seed);
+        const auto* binary_column = down_cast<const BinaryColumn*>(ColumnHelper::get_data_column(column.get()));
+        const auto& offsets = binary_column->get_offset();
+        const uint8_t* bytes = binary_column->get_bytes().data();
+        for (size_t row = 0; row < size; ++row) {
+            hashes[row] = HashUtil::murmur_hash3_32(bytes + offsets[row], offsets[row + 1] - offsets[row], hashes[row]);
         }
 
-        builder.append(seed, has_null);
+        if (column->has_null()) {
+            const auto& column_nulls = down_cast<const NullableColumn*>(column.get())->null_column();
+            if (null_column == nullptr) {
+                null_column = ColumnHelper::as_column<NullColumn>(column_nulls->clone_shared());
+            } else {
+                null_column = FunctionHelper::union_null_column(null_column, column_nulls);
+            }
+        }
     }
 
-    return builder.build(ColumnHelper::is_all_const(columns));
+    if (is_const) {
+        return ConstColumn::create(result, columns[0]->size());
+    }
+    if (null_column != nullptr) {
+        return NullableColumn::create(result, null_column);
+    }
+    return result;
 }
 
 } // namespace vectorized
@@ -2,6 +2,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
@@ -32,6 +36,11 @@ using PHashSetType = typename PHashSet<Type>::PType;
  *
  *  Not support:
  *  a in (column1, 'a', column3), a in (select * from ....)...
+ *
+ * Once the values are all inserted, the integer values in a small range are looked up in a range set, i.e. a
+ * flag per value of the range, and the few numeric values in a small list by comparing with each of them,
+ * which are both cheaper than probing the hash set. The hash set is kept for the others and for the users of
+ * hash_set().
  */
 template <PrimitiveType Type>
 class VectorizedInConstPredicate final : public Predicate {
@@ -47,6 +56,9 @@ public:
 
     ~VectorizedInConstPredicate() {}
 
+    // The way to look the values up.
+    enum class LookupMode { HASH_SET, RANGE_SET, SMALL_LIST };
+
     virtual Expr* clone(ObjectPool* pool) const override {
         return pool->add(new VectorizedInConstPredicate(*this));
     }
@@ -121,9 +133,13 @@ public:
             }
         }
 
+        if (!_lookup_built) {
+            _build_lookup();
+        }
         return Status::OK();
     }
 
+    template <LookupMode mode>
     ColumnPtr eval_on_chunk_both_column_and_set_not_has_null(const ColumnPtr& lhs) {
         DCHECK(!_null_in_set);
 
@@ -145,7 +161,7 @@ public:
 
         if (!lhs->is_constant()) {
             for (int row = 0; row < size; ++row) {
-                if (_hash_set.contains(data[row])) {
+                if (_contains<mode>(data[row])) {
                     data3[row] = yes_value;
                 } else {
                     data3[row] = no_value;
@@ -153,7 +169,7 @@ public:
             }
         } else {
             if (size > 0) {
-                bool value = _hash_set.contains(data[0]) ? yes_value : no_value;
+                bool value = _contains<mode>(data[0]) ? yes_value : no_value;
                 data3[0] = value;
                 for (int row = 1; row < size; ++row) {
                     data3[row] = value;
@@ -166,7 +182,7 @@ public:
 
     // null_in_set: true means null is a value of _hash_set.
     // equal_null: true means that 'null' in column and 'null' in set is equal.
-    template <bool null_in_set, bool equal_null>
+    template <LookupMode mode, bool null_in_set, bool equal_null>
     ColumnPtr eval_on_chunk(const ColumnPtr& lhs) {
         ColumnBuilder<TYPE_BOOLEAN> builder;
         ColumnViewer<Type> viewer(lhs);
@@ -183,7 +199,7 @@ public:
                 continue;
             }
             // find value
-            if (_hash_set.contains(viewer.value(row))) {
+            if (_contains<mode>(viewer.value(row))) {
                 builder.append(yes_value);
                 continue;
             }
@@ -203,24 +219,24 @@ public:
             return ColumnHelper::create_const_null_column(lhs->size());
         }
 
-        if (_null_in_set) {
-            if (_eq_null) {
-                return this->template eval_on_chunk<true, true>(lhs);
-            } else {
-                return this->template eval_on_chunk<true, false>(lhs);
-            }
-        } else if (lhs->is_nullable()) {
-            return this->template eval_on_chunk<false, false>(lhs);
-        } else {
-            return eval_on_chunk_both_column_and_set_not_has_null(lhs);
+        switch (_lookup_mode) {
+        case LookupMode::RANGE_SET:
+            return _evaluate<LookupMode::RANGE_SET>(lhs);
+        case LookupMode::SMALL_LIST:
+            return _evaluate<LookupMode::SMALL_LIST>(lhs);
+        default:
+            return _evaluate<LookupMode::HASH_SET>(lhs);
         }
     }
 
+    // The values must be inserted before open(), which chooses the way to look them up.
     void insert(typename RunTimeTypeTraits<Type>::CppType* value) {
         if (value == nullptr) {
             _null_in_set = true;
         } else {
             _hash_set.emplace(*value);
+            _lookup_built = false;
+            _lookup_mode = LookupMode::HASH_SET;
         }
     }
 
@@ -236,7 +252,78 @@ public:
 
     void set_eq_null(bool value) { _eq_null = value; }
 
+    LookupMode lookup_mode() const { return _lookup_mode; }
+
 private:
+    using CppType = RunTimeCppType<Type>;
+
+    // A range set takes a byte per value of the range.
+    static constexpr size_t kMaxRangeSetSize = 64 * 1024;
+    static constexpr size_t kMaxSmallListSize = 16;
+
+    // the integers, but the 128-bit ones, whose offsets in the range could be computed in 64 bits.
+    static constexpr bool kSupportRangeSet = std::is_integral_v<CppType> && sizeof(CppType) <= sizeof(int64_t);
+    static constexpr bool kSupportSmallList = isArithmeticPT<Type>;
+
+    template <LookupMode mode>
+    ColumnPtr _evaluate(const ColumnPtr& lhs) {
+        if (_null_in_set) {
+            if (_eq_null) {
+                return this->template eval_on_chunk<mode, true, true>(lhs);
+            } else {
+                return this->template eval_on_chunk<mode, true, false>(lhs);
+            }
+        } else if (lhs->is_nullable()) {
+            return this->template eval_on_chunk<mode, false, false>(lhs);
+        } else {
+            return this->template eval_on_chunk_both_column_and_set_not_has_null<mode>(lhs);
+        }
+    }
+
+    template <LookupMode mode>
+    bool _contains(const CppType& value) const {
+        if constexpr (mode == LookupMode::RANGE_SET && kSupportRangeSet) {
+            uint64_t offset = static_cast<uint64_t>(value) - static_cast<uint64_t>(_range_min);
+            return offset < _range_set.size() && _range_set[offset];
+        } else if constexpr (mode == LookupMode::SMALL_LIST && kSupportSmallList) {
+            // compare with all the values without branches, could be vectorized.
+            bool found = false;
+            for (const auto& v : _small_list) {
+                found |= (v == value);
+            }
+            return found;
+        } else {
+            return _hash_set.contains(value);
+        }
+    }
+
+    void _build_lookup() {
+        _lookup_built = true;
+        _lookup_mode = LookupMode::HASH_SET;
+        if (_hash_set.empty()) {
+            return;
+        }
+        if constexpr (kSupportRangeSet) {
+            auto [min_iter, max_iter] = std::minmax_element(_hash_set.begin(), _hash_set.end());
+            uint64_t range = static_cast<uint64_t>(*max_iter) - static_cast<uint64_t>(*min_iter);
+            if (range < kMaxRangeSetSize) {
+                _range_min = *min_iter;
+                _range_set.assign(range + 1, 0);
+                for (const auto& v : _hash_set) {
+                    _range_set[static_cast<uint64_t>(v) - static_cast<uint64_t>(_range_min)] = 1;
+                }
+                _lookup_mode = LookupMode::RANGE_SET;
+                return;
+            }
+        }
+        if constexpr (kSupportSmallList) {
+            if (_hash_set.size() <= kMaxSmallListSize) {
+                _small_list.assign(_hash_set.begin(), _hash_set.end());
+                _lookup_mode = LookupMode::SMALL_LIST;
+            }
+        }
+    }
+
     const bool _is_not_in;
     bool _is_prepare;
     bool _null_in_set;
@@ -246,6 +333,14 @@ private:
     PHashSetType<Type> _hash_set;
     // Ensure the string memory don't early free
     std::vector<ColumnPtr> _string_values;
+
+    bool _lookup_built = false;
+    LookupMode _lookup_mode = LookupMode::HASH_SET;
+    // Whether the value - _range_min is in the set, for LookupMode::RANGE_SET.
+    CppType _range_min{};
+    std::vector<uint8_t> _range_set;
+    // The values of the set, for LookupMode::SMALL_LIST.
+    std::vector<CppType> _small_list;
 };
 
 } // namespace vectorized
@@ -9,11 +9,15 @@
 #include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <boost/tokenizer.hpp>
+#include <limits>
 
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
+#include "column/object_column.h"
 #include "common/status.h"
 #include "rapidjson/error/en.h"
+#include "util/json_value.h"
+#include "util/raw_container.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -22,6 +26,10 @@ namespace vectorized {
 // json path cannot contains: ", [, ]
 static const re2::RE2 JSON_PATTERN("^([^\\\"\\[\\]]*)(?:\\[([0-9]+|\\*)\\])?");
 
+// The memory pool of the values parsed by the get_json_* functions starts from a buffer of this size, which is
+// reused by the rows, so the small documents needn't allocate any memory.
+static constexpr size_t kJsonMemoryPoolBufferSize = 64 * 1024;
+
 void JsonFunctions::get_parsed_paths(const std::vector<std::string>& path_exprs, std::vector<JsonPath>* parsed_paths) {
     if (path_exprs[0] != "$") {
         parsed_paths->emplace_back("", -1, false);
@@ -247,67 +255,199 @@ void JsonFunctions::parse_json_paths(const std::string& path_string, std::vector
     get_parsed_paths(paths, parsed_paths);
 }
 
-rapidjson::Value* JsonFunctions::get_json_object(FunctionContext* context, const std::string& json_string,
-                                                 const std::string& path_string, const JsonFunctionType& fntype,
-                                                 rapidjson::Document* document) {
-    // split path by ".", and escape quota by "\"
-    // eg:
-    //    '$.text#abc.xyz'  ->  [$, text#abc, xyz]
-    //    '$."text.abc".xyz'  ->  [$, text.abc, xyz]
-    //    '$."text.abc"[1].xyz'  ->  [$, text.abc[1], xyz]
-    std::vector<JsonPath>* parsed_paths;
-    std::vector<JsonPath> tmp_parsed_paths;
-#ifndef BE_TEST
-    parsed_paths =
-            reinterpret_cast<std::vector<JsonPath>*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
-    if (parsed_paths == nullptr) {
-        boost::tokenizer<boost::escaped_list_separator<char> > tok(
-                path_string, boost::escaped_list_separator<char>("\\", ".", "\""));
-        std::vector<std::string> paths(tok.begin(), tok.end());
-        get_parsed_paths(paths, &tmp_parsed_paths);
-        parsed_paths = &tmp_parsed_paths;
-    }
-#else
-    boost::tokenizer<boost::escaped_list_separator<char> > tok(path_string,
-                                                               boost::escaped_list_separator<char>("\\", ".", "\""));
-    std::vector<std::string> paths(tok.begin(), tok.end());
-    get_parsed_paths(paths, &tmp_parsed_paths);
-    parsed_paths = &tmp_parsed_paths;
-#endif
+rapidjson::Value* JsonFunctions::get_json_object(const Slice& json_value, const std::vector<JsonPath>& parsed_paths,
+                                                 const JsonFunctionType& fntype, rapidjson::Document* document) {
+    // The values of the last row are dropped at once, they are never freed one by one by the memory pool.
+    document->SetNull();
+    document->GetAllocator().Clear();
 
-    VLOG(10) << "first parsed path: " << (*parsed_paths)[0].debug_string();
+    VLOG(10) << "first parsed path: " << parsed_paths[0].debug_string();
 
-    if (!(*parsed_paths)[0].is_valid) {
+    if (!parsed_paths[0].is_valid) {
         return document;
     }
 
-    if (UNLIKELY((*parsed_paths).size() == 1)) {
+    if (UNLIKELY(parsed_paths.size() == 1)) {
         if (fntype == JSON_FUN_STRING) {
-            document->SetString(json_string.c_str(), document->GetAllocator());
+            document->SetString(json_value.data, json_value.size, document->GetAllocator());
         } else {
             return document;
         }
     }
 
-    //rapidjson::Document document;
-    document->Parse(json_string.c_str());
+    document->Parse(json_value.data, json_value.size);
     if (UNLIKELY(document->HasParseError())) {
         VLOG(1) << "Error at offset " << document->GetErrorOffset() << ": "
                 << GetParseError_En(document->GetParseError());
         document->SetNull();
         return document;
     }
-    return match_value(*parsed_paths, document, document->GetAllocator());
+    return match_value(parsed_paths, document, document->GetAllocator());
 }
 
 JsonFunctionType JsonTypeTraits<TYPE_INT>::JsonType = JSON_FUN_INT;
 JsonFunctionType JsonTypeTraits<TYPE_DOUBLE>::JsonType = JSON_FUN_DOUBLE;
 JsonFunctionType JsonTypeTraits<TYPE_VARCHAR>::JsonType = JSON_FUN_STRING;
 
+// The parsed paths of the rows. The constant path is parsed once by json_path_prepare, the others are parsed
+// when they differ from the path of the last row.
+class RowJsonPaths {
+public:
+    explicit RowJsonPaths(FunctionContext* context)
+            : _prepared_paths(reinterpret_cast<std::vector<JsonPath>*>(
+                      context->get_function_state(FunctionContext::FRAGMENT_LOCAL))) {}
+
+    // Return nullptr if the path is empty.
+    const std::vector<JsonPath>* get(const Slice& path) {
+        if (_prepared_paths != nullptr) {
+            return _prepared_paths;
+        }
+        if (!_has_last_path || path != Slice(_last_path)) {
+            _has_last_path = true;
+            _last_path.assign(path.data, path.size);
+            _last_parsed_paths.clear();
+            std::string path_string = _last_path;
+            // Must remove or replace the escape sequence.
+            path_string.erase(std::remove(path_string.begin(), path_string.end(), '\\'), path_string.end());
+            if (!path_string.empty()) {
+                JsonFunctions::parse_json_paths(path_string, &_last_parsed_paths);
+            }
+        }
+        return _last_parsed_paths.empty() ? nullptr : &_last_parsed_paths;
+    }
+
+private:
+    const std::vector<JsonPath>* _prepared_paths;
+    bool _has_last_path = false;
+    std::string _last_path;
+    std::vector<JsonPath> _last_parsed_paths;
+};
+
+// Find the value matching |parsed_paths| in the binary json |root|, it's invalid if not found.
+// Return false if the paths collect the values of an array, which is left to match_value.
+static bool match_json_view(const std::vector<JsonPath>& parsed_paths, JsonView root, JsonView* value) {
+    *value = JsonView();
+    for (int i = 1; i < parsed_paths.size(); i++) {
+        if (root.type() == JsonType::JSON_NULL || UNLIKELY(!parsed_paths[i].is_valid)) {
+            return true;
+        }
+
+        const std::string& col = parsed_paths[i].key;
+        int index = parsed_paths[i].idx;
+        if (LIKELY(!col.empty())) {
+            if (root.type() == JsonType::JSON_ARRAY) {
+                return false;
+            } else if (root.type() != JsonType::JSON_OBJECT) {
+                return true;
+            }
+            root = root.find(Slice(col));
+            if (!root.is_valid()) {
+                return true;
+            }
+        }
+
+        if (UNLIKELY(index != -1)) {
+            if (root.type() != JsonType::JSON_ARRAY) {
+                return true;
+            } else if (index == -2) {
+                return false;
+            } else if (index >= root.count()) {
+                return true;
+            }
+            root = root.element(index);
+        }
+    }
+    *value = root;
+    return true;
+}
+
+template <PrimitiveType primitive_type>
+static void append_json_value(rapidjson::Value* root, rapidjson::StringBuffer* buf,
+                              rapidjson::Writer<rapidjson::StringBuffer>* writer,
+                              ColumnBuilder<primitive_type>* result) {
+    if constexpr (primitive_type == TYPE_INT) {
+        if (root != nullptr && root->IsInt()) {
+            result->append(root->GetInt());
+        } else {
+            result->append_null();
+        }
+    } else if constexpr (primitive_type == TYPE_DOUBLE) {
+        if (root == nullptr || root->IsNull()) {
+            result->append_null();
+        } else if (root->IsInt()) {
+            result->append(static_cast<double>(root->GetInt()));
+        } else if (root->IsDouble()) {
+            result->append(root->GetDouble());
+        } else {
+            result->append_null();
+        }
+    } else if constexpr (primitive_type == TYPE_VARCHAR) {
+        if (root == nullptr || root->IsNull()) {
+            result->append_null();
+        } else if (root->IsString()) {
+            result->append(Slice(root->GetString(), root->GetStringLength()));
+        } else {
+            buf->Clear();
+            writer->Reset(*buf);
+            root->Accept(*writer);
+            result->append(Slice(buf->GetString(), buf->GetSize()));
+        }
+    }
+}
+
+// Same as the rapidjson value above.
+template <PrimitiveType primitive_type>
+static void append_json_value(const JsonView& value, ColumnBuilder<primitive_type>* result) {
+    if (!value.is_valid() || value.type() == JsonType::JSON_NULL) {
+        result->append_null();
+        return;
+    }
+    if constexpr (primitive_type == TYPE_INT) {
+        if (value.type() == JsonType::JSON_INT && value.get_int() >= std::numeric_limits<int32_t>::min() &&
+            value.get_int() <= std::numeric_limits<int32_t>::max()) {
+            result->append(static_cast<int32_t>(value.get_int()));
+        } else {
+            result->append_null();
+        }
+    } else if constexpr (primitive_type == TYPE_DOUBLE) {
+        if (value.type() == JsonType::JSON_INT && value.get_int() >= std::numeric_limits<int32_t>::min() &&
+            value.get_int() <= std::numeric_limits<int32_t>::max()) {
+            result->append(static_cast<double>(value.get_int()));
+        } else if (value.type() == JsonType::JSON_DOUBLE) {
+            result->append(value.get_double());
+        } else {
+            result->append_null();
+        }
+    } else if constexpr (primitive_type == TYPE_VARCHAR) {
+        if (value.type() == JsonType::JSON_STRING) {
+            result->append(value.get_string());
+        } else {
+            result->append(Slice(value.to_string()));
+        }
+    }
+}
+
+// The data column of a column, which may be a constant of a nullable column.
+static const Column* json_data_column(const Column* column) {
+    return ColumnHelper::get_data_column(ColumnHelper::get_data_column(column));
+}
+
 template <PrimitiveType primitive_type>
 ColumnPtr JsonFunctions::iterate_rows(FunctionContext* context, const Columns& columns) {
+    if (json_data_column(columns[0].get())->is_object()) {
+        return iterate_json_rows<primitive_type>(context, columns);
+    }
+
     auto json_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
     auto path_viewer = ColumnViewer<TYPE_VARCHAR>(columns[1]);
+    RowJsonPaths row_paths(context);
+
+    // The document, the memory pool of its values and the string buffer are reused by all the rows.
+    raw::RawVector<char> pool_buffer(kJsonMemoryPoolBufferSize);
+    rapidjson::MemoryPoolAllocator<> allocator(pool_buffer.data(), pool_buffer.size());
+    rapidjson::Document document(&allocator);
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
 
     ColumnBuilder<primitive_type> result;
     auto size = columns[0]->size();
@@ -322,48 +462,61 @@ ColumnPtr JsonFunctions::iterate_rows(FunctionContext* context, const Columns& c
             result.append_null();
             continue;
         }
-        std::string json_string(json_value.data, json_value.size);
 
-        auto path_value = path_viewer.value(row);
-        std::string path_string(path_value.data, path_value.size);
-        // Must remove or replace the escape sequence.
-        path_string.erase(std::remove(path_string.begin(), path_string.end(), '\\'), path_string.end());
-        if (path_string.empty()) {
+        const std::vector<JsonPath>* parsed_paths = row_paths.get(path_viewer.value(row));
+        if (parsed_paths == nullptr) {
             result.append_null();
             continue;
         }
 
-        rapidjson::Document document;
-        rapidjson::Value* root = JsonFunctions::get_json_object(context, json_string, path_string,
+        rapidjson::Value* root = JsonFunctions::get_json_object(json_value, *parsed_paths,
                                                                 JsonTypeTraits<primitive_type>::JsonType, &document);
+        append_json_value<primitive_type>(root, &buf, &writer, &result);
+    }
 
-        if constexpr (primitive_type == TYPE_INT) {
-            if (root != nullptr && root->IsInt()) {
-                result.append(root->GetInt());
-            } else {
-                result.append_null();
-            }
-        } else if constexpr (primitive_type == TYPE_DOUBLE) {
-            if (root == nullptr || root->IsNull()) {
-                result.append_null();
-            } else if (root->IsInt()) {
-                result.append(static_cast<double>(root->GetInt()));
-            } else if (root->IsDouble()) {
-                result.append(root->GetDouble());
-            } else {
-                result.append_null();
-            }
-        } else if constexpr (primitive_type == TYPE_VARCHAR) {
-            if (root == nullptr || root->IsNull()) {
-                result.append_null();
-            } else if (root->IsString()) {
-                result.append(Slice(root->GetString()));
-            } else {
-                rapidjson::StringBuffer buf;
-                rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
-                root->Accept(writer);
-                result.append(Slice(buf.GetString()));
-            }
+    return result.build(ColumnHelper::is_all_const(columns));
+}
+
+template <PrimitiveType primitive_type>
+ColumnPtr JsonFunctions::iterate_json_rows(FunctionContext* context, const Columns& columns) {
+    const auto* json_column = down_cast<const JsonColumn*>(json_data_column(columns[0].get()));
+    bool json_is_const = columns[0]->is_constant();
+    auto path_viewer = ColumnViewer<TYPE_VARCHAR>(columns[1]);
+    RowJsonPaths row_paths(context);
+
+    // Only for the paths collecting the values of the arrays.
+    rapidjson::Document document;
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+
+    ColumnBuilder<primitive_type> result;
+    auto size = columns[0]->size();
+    for (int row = 0; row < size; ++row) {
+        if (columns[0]->is_null(row) || path_viewer.is_null(row)) {
+            result.append_null();
+            continue;
+        }
+
+        const std::vector<JsonPath>* parsed_paths = row_paths.get(path_viewer.value(row));
+        if (parsed_paths == nullptr || !(*parsed_paths)[0].is_valid) {
+            result.append_null();
+            continue;
+        }
+        // like get_json_object, only get_json_string returns the whole document.
+        if (parsed_paths->size() == 1 && JsonTypeTraits<primitive_type>::JsonType != JSON_FUN_STRING) {
+            result.append_null();
+            continue;
+        }
+
+        const JsonValue* json = json_column->get_object(json_is_const ? 0 : row);
+        JsonView value;
+        if (match_json_view(*parsed_paths, json->view(), &value)) {
+            append_json_value<primitive_type>(value, &result);
+        } else {
+            std::string json_string = json->to_string();
+            rapidjson::Value* root = JsonFunctions::get_json_object(
+                    Slice(json_string), *parsed_paths, JsonTypeTraits<primitive_type>::JsonType, &document);
+            append_json_value<primitive_type>(root, &buf, &writer, &result);
         }
     }
 
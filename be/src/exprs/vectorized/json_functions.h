@@ -123,9 +123,14 @@ private:
     template <PrimitiveType primitive_type>
     static ColumnPtr iterate_rows(FunctionContext* context, const Columns& columns);
 
-    static rapidjson::Value* get_json_object(FunctionContext* context, const std::string& json_string,
-                                             const std::string& path_string, const JsonFunctionType& fntype,
-                                             rapidjson::Document* document);
+    // The rows of a JsonColumn are read from their binary form without parsing.
+    template <PrimitiveType primitive_type>
+    static ColumnPtr iterate_json_rows(FunctionContext* context, const Columns& columns);
+
+    // Parse |json_value| into |document| and return the value matching |parsed_paths|.
+    // |document| may be reused across the rows.
+    static rapidjson::Value* get_json_object(const Slice& json_value, const std::vector<JsonPath>& parsed_paths,
+                                             const JsonFunctionType& fntype, rapidjson::Document* document);
 
     static rapidjson::Value* match_value(const std::vector<JsonPath>& parsed_paths, rapidjson::Value* document,
                                          rapidjson::Document::AllocatorType& mem_allocator,
@@ -34,6 +34,11 @@ static const re2::RE2 LIKE_ENDS_WITH_RE(R"((?:%+)(((\\%)|(\\_)|([^%_]))+))");
 static const re2::RE2 LIKE_STARTS_WITH_RE(R"((((\\%)|(\\_)|([^%_]))+)(?:%+))");
 static const re2::RE2 LIKE_EQUALS_RE(R"((((\\%)|(\\_)|([^%_]))+))");
 
+static const size_t kMinRequiredLiteralSize = 3;
+
+// The DFA memory budget of a pattern set, RE2::Set::Match() returns false if it's exhausted.
+static const int64_t kPatternSetMaxMem = 64L << 20;
+
 // like predicate
 Status LikePredicate::like_prepare(starrocks_udf::FunctionContext* context,
                                    starrocks_udf::FunctionContext::FunctionStateScope scope) {
@@ -89,6 +94,11 @@ Status LikePredicate::like_prepare(starrocks_udf::FunctionContext* context,
             context->set_error(strings::Substitute("Invalid regex: $0", re_pattern).c_str());
             return Status::InvalidArgument("Invalid regex: " + pattern.to_string());
         }
+        // a short literal filters out few values, and isn't worth the extra pass.
+        state->required_literal = extract_like_literal(pattern, state->escape_char);
+        if (state->required_literal.size() < kMinRequiredLiteralSize) {
+            state->required_literal.clear();
+        }
     }
     return Status::OK();
 }
@@ -274,50 +284,47 @@ ColumnPtr LikePredicate::constant_substring_fn(FunctionContext* context,
         haystack = ColumnHelper::as_raw_column<BinaryColumn>(columns[0]);
     }
 
+    res->resize(haystack->size());
+    contains_substring(*haystack, needle, res->get_data().data());
+
+    if (columns[0]->has_null()) {
+        return NullableColumn::create(res, res_null);
+    }
+    return res;
+}
+
+void LikePredicate::contains_substring(const BinaryColumn& haystack, const Slice& needle, uint8_t* marks) {
     if (needle.size == 0) {
         // if needle is empty string, every haystack can be matched.
-        res->resize(haystack->size());
-        size_t type_size = res->type_size();
-        memset(res->mutable_raw_data(), 1, res->size() * type_size);
-    } else {
-        const std::vector<uint32_t>& offsets = haystack->get_offset();
-        res->resize(haystack->size());
-
-        const char* begin = haystack->get_slice(0).data;
-        const char* pos = begin;
-        const char* end = pos + haystack->get_bytes().size();
-
-        /// Current index in the array of strings.
-        size_t i = 0;
-
-        auto searcher = VolnitskyUTF8(needle.data, needle.size, end - pos);
-        /// We will search for the next occurrence in all strings at once.
-        while (pos < end && end != (pos = searcher.search(pos, end - pos))) {
-            /// Determine which index it refers to.
-            while (begin + offsets[i + 1] <= pos) {
-                res->get_data()[i] = false;
-                ++i;
-            }
-            /// We check that the entry does not pass through the boundaries of strings.
-            if (pos + needle.size > begin + offsets[i + 1]) {
-                res->get_data()[i] = false;
-            } else {
-                res->get_data()[i] = true;
-            }
-            pos = begin + offsets[i + 1];
-            ++i;
-        }
+        memset(marks, 1, haystack.size());
+        return;
+    }
+
+    const std::vector<uint32_t>& offsets = haystack.get_offset();
+    const char* begin = reinterpret_cast<const char*>(haystack.get_bytes().data());
+    const char* pos = begin;
+    const char* end = pos + haystack.get_bytes().size();
+
+    /// Current index in the array of strings.
+    size_t i = 0;
 
-        if (i < res->size()) {
-            size_t type_size = res->type_size();
-            memset(res->mutable_raw_data() + i * type_size, 0, (res->size() - i) * type_size);
+    auto searcher = VolnitskyUTF8(needle.data, needle.size, end - pos);
+    /// We will search for the next occurrence in all strings at once.
+    while (pos < end && end != (pos = searcher.search(pos, end - pos))) {
+        /// Determine which index it refers to.
+        while (begin + offsets[i + 1] <= pos) {
+            marks[i] = false;
+            ++i;
         }
+        /// We check that the entry does not pass through the boundaries of strings.
+        marks[i] = pos + needle.size <= begin + offsets[i + 1];
+        pos = begin + offsets[i + 1];
+        ++i;
     }
 
-    if (columns[0]->has_null()) {
-        return NullableColumn::create(res, res_null);
+    if (i < haystack.size()) {
+        memset(marks + i, 0, haystack.size() - i);
     }
-    return res;
 }
 
 // regex_match
@@ -341,6 +348,9 @@ ColumnPtr LikePredicate::regex_match_full(FunctionContext* context, const starro
     // pattern is constant value, use context's regex
     if (context->is_constant_column(1)) {
         auto state = reinterpret_cast<LikePredicateState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
+        if (!state->required_literal.empty() && !value_column->is_constant()) {
+            return regex_match_full_with_literal(context, value_column);
+        }
 
         for (int row = 0; row < value_viewer.size(); ++row) {
             auto v = RE2::FullMatch(re2::StringPiece(value_viewer.value(row).data, value_viewer.value(row).size),
@@ -381,6 +391,36 @@ ColumnPtr LikePredicate::regex_match_full(FunctionContext* context, const starro
     return result.build(ColumnHelper::is_all_const(columns));
 }
 
+ColumnPtr LikePredicate::regex_match_full_with_literal(FunctionContext* context, const ColumnPtr& value_column) {
+    auto state = reinterpret_cast<LikePredicateState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
+
+    BinaryColumn* haystack = nullptr;
+    NullColumnPtr res_null = nullptr;
+    if (value_column->is_nullable()) {
+        auto haystack_null = ColumnHelper::as_column<NullableColumn>(value_column);
+        haystack = ColumnHelper::as_raw_column<BinaryColumn>(haystack_null->data_column());
+        res_null = haystack_null->null_column();
+    } else {
+        haystack = ColumnHelper::as_raw_column<BinaryColumn>(value_column);
+    }
+
+    auto res = RunTimeColumnType<TYPE_BOOLEAN>::create();
+    res->resize(haystack->size());
+    auto& matches = res->get_data();
+    contains_substring(*haystack, Slice(state->required_literal), matches.data());
+    for (size_t row = 0; row < haystack->size(); ++row) {
+        if (matches[row]) {
+            Slice value = haystack->get_slice(row);
+            matches[row] = RE2::FullMatch(re2::StringPiece(value.data, value.size), *(state->regex));
+        }
+    }
+
+    if (value_column->has_null()) {
+        return NullableColumn::create(res, res_null);
+    }
+    return res;
+}
+
 ColumnPtr LikePredicate::regex_match_partial(FunctionContext* context, const starrocks::vectorized::Columns& columns) {
     auto value_column = VECTORIZED_FN_ARGS(0);
 
@@ -431,10 +471,12 @@ ColumnPtr LikePredicate::regex_match_partial(FunctionContext* context, const sta
 }
 
 std::string LikePredicate::convert_like_pattern(FunctionContext* context, const Slice& pattern) {
-    std::string re_pattern;
-    re_pattern.clear();
-
     auto state = reinterpret_cast<LikePredicateState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
+    return convert_like_pattern(pattern, state->escape_char);
+}
+
+std::string LikePredicate::convert_like_pattern(const Slice& pattern, char escape_char) {
+    std::string re_pattern;
     bool is_escaped = false;
 
     for (int i = 0; i < pattern.size; ++i) {
@@ -443,7 +485,7 @@ std::string LikePredicate::convert_like_pattern(FunctionContext* context, const
         } else if (!is_escaped && pattern.data[i] == '_') {
             re_pattern.append(".");
             // check for escape char before checking for regex special chars, they might overlap
-        } else if (!is_escaped && pattern.data[i] == state->escape_char) {
+        } else if (!is_escaped && pattern.data[i] == escape_char) {
             is_escaped = true;
         } else if (pattern.data[i] == '.' || pattern.data[i] == '[' || pattern.data[i] == ']' ||
                    pattern.data[i] == '{' || pattern.data[i] == '}' || pattern.data[i] == '(' ||
@@ -464,6 +506,30 @@ std::string LikePredicate::convert_like_pattern(FunctionContext* context, const
     return re_pattern;
 }
 
+std::string LikePredicate::extract_like_literal(const Slice& pattern, char escape_char) {
+    std::string longest;
+    std::string current;
+    bool is_escaped = false;
+    for (size_t i = 0; i < pattern.size; ++i) {
+        char c = pattern.data[i];
+        if (!is_escaped && (c == '%' || c == '_')) {
+            if (current.size() > longest.size()) {
+                longest.swap(current);
+            }
+            current.clear();
+        } else if (!is_escaped && c == escape_char) {
+            is_escaped = true;
+        } else {
+            current.push_back(c);
+            is_escaped = false;
+        }
+    }
+    if (current.size() > longest.size()) {
+        longest.swap(current);
+    }
+    return longest;
+}
+
 void LikePredicate::remove_escape_character(std::string* search_string) {
     std::string tmp_search_string;
     tmp_search_string.swap(*search_string);
@@ -480,5 +546,59 @@ void LikePredicate::remove_escape_character(std::string* search_string) {
     }
 }
 
+Status LikePatternSet::create(const std::vector<std::string>& patterns, bool is_like,
+                              std::unique_ptr<LikePatternSet>* pattern_set) {
+    RE2::Options opts;
+    opts.set_never_nl(false);
+    opts.set_dot_nl(true);
+    opts.set_max_mem(kPatternSetMaxMem);
+    auto set = std::make_unique<RE2::Set>(opts, is_like ? RE2::ANCHOR_BOTH : RE2::UNANCHORED);
+    for (const auto& pattern : patterns) {
+        std::string re_pattern = is_like ? LikePredicate::convert_like_pattern(Slice(pattern), '\\') : pattern;
+        std::string error;
+        if (set->Add(re_pattern, &error) < 0) {
+            return Status::InvalidArgument(strings::Substitute("Invalid regex: $0, $1", re_pattern, error));
+        }
+    }
+    if (!set->Compile()) {
+        return Status::InternalError("Fail to compile the regex set");
+    }
+    pattern_set->reset(new LikePatternSet(std::move(set)));
+    return Status::OK();
+}
+
+ColumnPtr LikePatternSet::match(const ColumnPtr& column) const {
+    if (column->only_null()) {
+        return ColumnHelper::create_const_null_column(column->size());
+    }
+    if (column->is_constant()) {
+        auto res = RunTimeColumnType<TYPE_BOOLEAN>::create();
+        res->append(_match(ColumnHelper::get_const_value<TYPE_VARCHAR>(column)));
+        return ConstColumn::create(res, column->size());
+    }
+
+    const BinaryColumn* values = nullptr;
+    NullColumnPtr res_null = nullptr;
+    if (column->is_nullable()) {
+        auto nullable = ColumnHelper::as_column<NullableColumn>(column);
+        values = ColumnHelper::as_raw_column<BinaryColumn>(nullable->data_column());
+        res_null = nullable->null_column();
+    } else {
+        values = ColumnHelper::as_raw_column<BinaryColumn>(column);
+    }
+
+    auto res = RunTimeColumnType<TYPE_BOOLEAN>::create();
+    res->resize(values->size());
+    auto& matches = res->get_data();
+    for (size_t row = 0; row < values->size(); ++row) {
+        matches[row] = _match(values->get_slice(row));
+    }
+
+    if (column->has_null()) {
+        return NullableColumn::create(res, res_null);
+    }
+    return res;
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -3,9 +3,11 @@
 #pragma once
 
 #include <re2/re2.h>
+#include <re2/set.h>
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "exprs/vectorized/builtin_functions.h"
 #include "exprs/vectorized/function_helper.h"
@@ -47,6 +49,16 @@ public:
      */
     DEFINE_VECTORIZED_FN(regex);
 
+    /// Convert a LIKE pattern with the escape char |escape_char| into the regular expression pattern.
+    static std::string convert_like_pattern(const Slice& pattern, char escape_char);
+
+    /// The longest substring without wildcards of a LIKE pattern, which every matched value contains.
+    static std::string extract_like_literal(const Slice& pattern, char escape_char);
+
+    /// Set marks[i] to whether the i-th value of |haystack| contains |needle|, by searching the bytes of all the
+    /// values at once instead of each value.
+    static void contains_substring(const BinaryColumn& haystack, const Slice& needle, uint8_t* marks);
+
 private:
     /**
      * use for:
@@ -130,6 +142,9 @@ private:
 
     static ColumnPtr regex_match_partial(FunctionContext* context, const Columns& columns);
 
+    /// Full match a constant LIKE regex only on the values containing its longest literal.
+    static ColumnPtr regex_match_full_with_literal(FunctionContext* context, const ColumnPtr& value_column);
+
     /// Convert a LIKE pattern (with embedded % and _) into the corresponding
     /// regular expression pattern. Escaped chars are copied verbatim.
     static std::string convert_like_pattern(starrocks_udf::FunctionContext* context, const Slice& pattern);
@@ -163,6 +178,9 @@ private:
         /// Used for RLIKE and REGEXP predicates if the pattern is a constant argument.
         std::unique_ptr<re2::RE2> regex;
 
+        /// Used for LIKE predicates matched by |regex|, the values without it don't match the pattern.
+        std::string required_literal;
+
         LikePredicateState() : escape_char('\\') {}
 
         void set_search_string(const std::string& search_string_arg) {
@@ -172,5 +190,26 @@ private:
         }
     };
 };
+
+/// LikePatternSet matches the values against many LIKE or REGEXP patterns at once by one RE2::Set automaton,
+/// so the OR of the LIKE or REGEXP predicates on the same column scans each value once instead of once per pattern.
+/// It's thread-safe after created.
+class LikePatternSet {
+public:
+    /// |is_like| for LIKE patterns, otherwise REGEXP patterns.
+    static Status create(const std::vector<std::string>& patterns, bool is_like,
+                         std::unique_ptr<LikePatternSet>* pattern_set);
+
+    /// Whether each value of |column| matches any of the patterns, null if the value is null.
+    ColumnPtr match(const ColumnPtr& column) const;
+
+private:
+    explicit LikePatternSet(std::unique_ptr<re2::RE2::Set> set) : _set(std::move(set)) {}
+
+    bool _match(const Slice& value) const { return _set->Match(re2::StringPiece(value.data, value.size), nullptr); }
+
+    std::unique_ptr<re2::RE2::Set> _set;
+};
+
 } // namespace vectorized
 } // namespace starrocks
@@ -2,6 +2,10 @@
 
 #include "exprs/vectorized/runtime_filter.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "common/config.h"
 #include "exec/decompressor.h"
 #include "gen_cpp/types.pb.h"
 #include "util/block_compression.h"
@@ -9,7 +13,12 @@ namespace starrocks::vectorized {
 
 void SimdBlockFilter::init(size_t nums) {
     nums = std::max(1UL, nums);
-    int log_heap_space = std::ceil(std::log2(nums));
+    // Every key sets BITS_SET_PER_BLOCK bits of a block, so the false positive probability of m bits for n keys
+    // is about (1 - e^(-k * n / m))^k, with k = BITS_SET_PER_BLOCK, which gives the bits needed for the fpp.
+    const double fpp = std::clamp(config::runtime_filter_bloom_filter_fpp, 1e-6, 0.5);
+    const double k = BITS_SET_PER_BLOCK;
+    const double num_bits = -k * static_cast<double>(nums) / std::log(1 - std::pow(fpp, 1.0 / k));
+    int log_heap_space = std::ceil(std::log2(std::max(1.0, num_bits / 8)));
     _log_num_buckets = std::max(1, log_heap_space - LOG_BUCKET_BYTE_SIZE);
     _directory_mask = (1ull << std::min(63, _log_num_buckets)) - 1;
     const size_t alloc_size = get_alloc_size();
@@ -204,9 +204,17 @@ public:
         _has_null |= rf->_has_null;
         _bf.merge(rf->_bf);
     }
+    // Append the partitions of |rf|, which is either a partition or the concatenation of the partitions from
+    // an intermediate merge node.
     virtual void concat(JoinRuntimeFilter* rf) {
         _has_null |= rf->_has_null;
-        _hash_partition_bf.emplace_back(std::move(rf->_bf));
+        if (rf->_hash_partition_number == 0) {
+            _hash_partition_bf.emplace_back(std::move(rf->_bf));
+        } else {
+            for (auto& bf : rf->_hash_partition_bf) {
+                _hash_partition_bf.emplace_back(std::move(bf));
+            }
+        }
         _hash_partition_number = _hash_partition_bf.size();
         _join_mode = rf->_join_mode;
         _size += rf->_size;
@@ -2,9 +2,11 @@
 
 #include "exprs/vectorized/runtime_filter_bank.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "column/column.h"
+#include "column/column_helper.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
 #include "gutil/strings/substitute.h"
 #include "simd/simd.h"
@@ -337,6 +339,8 @@ RuntimeFilterProbeCollector::RuntimeFilterProbeCollector(RuntimeFilterProbeColle
         : _descriptors(std::move(that._descriptors)),
           _selectivity(std::move(that._selectivity)),
           _input_chunk_nums(that._input_chunk_nums),
+          _next_sample_chunk(that._next_sample_chunk),
+          _sample_interval(that._sample_interval),
           _wait_timeout_ms(that._wait_timeout_ms) {}
 
 Status RuntimeFilterProbeCollector::prepare(RuntimeState* state, const RowDescriptor& row_desc, MemTracker* tracker,
@@ -363,11 +367,16 @@ void RuntimeFilterProbeCollector::close(RuntimeState* state) {
 }
 
 void RuntimeFilterProbeCollector::do_evaluate(vectorized::Chunk* chunk) {
-    if ((_input_chunk_nums++ & 31) == 0) {
+    if (_input_chunk_nums++ == _next_sample_chunk) {
         update_selectivity(chunk);
+        _next_sample_chunk += _sample_interval;
         return;
     }
     if (!_selectivity.empty()) {
+        // The selections of the filters are merged, and the chunk is compacted once in the end, unless more than
+        // half of the rows are filtered out, then the next filters are evaluated on the compacted chunk.
+        vectorized::Column::Filter merged;
+        size_t true_count = 0;
         for (auto& kv : _selectivity) {
             RuntimeFilterProbeDescriptor* rf_desc = kv.second;
             const JoinRuntimeFilter* filter = rf_desc->runtime_filter();
@@ -375,15 +384,24 @@ void RuntimeFilterProbeCollector::do_evaluate(vectorized::Chunk* chunk) {
             ColumnPtr column = rf_desc->probe_expr_ctx()->evaluate(chunk);
             vectorized::Column::Filter& selection = filter->evaluate(column.get(), rf_desc->runtime_filter_ctx());
             _run_filter_nums += 1;
-            size_t true_count = SIMD::count_nonzero(selection);
+            if (merged.empty()) {
+                merged = selection;
+            } else {
+                vectorized::ColumnHelper::merge_two_filters(&merged, selection.data());
+            }
+            true_count = SIMD::count_nonzero(merged);
 
             if (true_count == 0) {
                 chunk->set_num_rows(0);
                 return;
-            } else {
-                chunk->filter(selection);
+            } else if (true_count * 2 < merged.size()) {
+                chunk->filter(merged);
+                merged.clear();
             }
         }
+        if (!merged.empty() && true_count < merged.size()) {
+            chunk->filter(merged);
+        }
     }
 }
 
@@ -410,10 +428,14 @@ void RuntimeFilterProbeCollector::update_selectivity(vectorized::Chunk* chunk) {
     _selectivity.clear();
     size_t chunk_size = chunk->num_rows();
     vectorized::Column::Filter* selection = nullptr;
+    bool all_arrived = true;
     for (auto& it : _descriptors) {
         RuntimeFilterProbeDescriptor* rf_desc = it.second;
         const JoinRuntimeFilter* filter = rf_desc->runtime_filter();
-        if (filter == nullptr) continue;
+        if (filter == nullptr) {
+            all_arrived = false;
+            continue;
+        }
         ColumnPtr column = rf_desc->probe_expr_ctx()->evaluate(chunk);
         vectorized::Column::Filter& new_selection = filter->evaluate(column.get(), rf_desc->runtime_filter_ctx());
         _run_filter_nums += 1;
@@ -423,6 +445,7 @@ void RuntimeFilterProbeCollector::update_selectivity(vectorized::Chunk* chunk) {
             if (selectivity < 0.05) { // very useful filter, could early return
                 _selectivity.clear();
                 _selectivity.emplace(selectivity, rf_desc);
+                _sample_interval = kMinSampleInterval;
                 chunk->filter(new_selection);
                 return;
             }
@@ -452,7 +475,13 @@ void RuntimeFilterProbeCollector::update_selectivity(vectorized::Chunk* chunk) {
         }
     }
     if (!_selectivity.empty()) {
+        _sample_interval = kMinSampleInterval;
         chunk->filter(*selection);
+    } else if (all_arrived) {
+        // None of the filters rejects enough rows to pay for its evaluation, so they are sampled less and less
+        // often, and the chunks in between don't evaluate any of them. The interval is reset once a filter is
+        // selective again.
+        _sample_interval = std::min(_sample_interval * 2, kMaxSampleInterval);
     }
 }
 
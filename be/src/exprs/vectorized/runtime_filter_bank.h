@@ -148,7 +148,13 @@ private:
     // mapping from filter id to runtime filter descriptor.
     std::map<int32_t, RuntimeFilterProbeDescriptor*> _descriptors;
     std::map<double, RuntimeFilterProbeDescriptor*> _selectivity;
+    // The selectivities of all the filters are sampled on the chunk _next_sample_chunk, i.e. the first one and once
+    // every _sample_interval chunks, which grows if none of the filters is selective.
+    static constexpr size_t kMinSampleInterval = 32;
+    static constexpr size_t kMaxSampleInterval = 1024;
     size_t _input_chunk_nums = 0;
+    size_t _next_sample_chunk = 0;
+    size_t _sample_interval = kMinSampleInterval;
     int _run_filter_nums = 0;
     int _wait_timeout_ms = 0;
 
@@ -196,6 +196,8 @@ ColumnPtr TimeFunctions::convert_tz_general(FunctionContext* context, const Colu
 ColumnPtr TimeFunctions::convert_tz_const(FunctionContext* context, const Columns& columns, const cctz::time_zone& from,
                                           const cctz::time_zone& to) {
     auto time_viewer = ColumnViewer<TYPE_DATETIME>(columns[0]);
+    TimezoneOffsetCache from_cache(from);
+    TimezoneOffsetCache to_cache(to);
 
     ColumnBuilder<TYPE_DATETIME> result;
     auto size = columns[0]->size();
@@ -205,28 +207,10 @@ ColumnPtr TimeFunctions::convert_tz_const(FunctionContext* context, const Column
             continue;
         }
 
-        auto datetime_value = time_viewer.value(row);
-
-        int year, month, day, hour, minute, second, usec;
-        datetime_value.to_timestamp(&year, &month, &day, &hour, &minute, &second, &usec);
-        DateTimeValue ts_value(TIME_DATETIME, year, month, day, hour, minute, second, usec);
-
-        int64_t timestamp;
-        // TODO find a better approach to replace datetime_value.unix_timestamp
-        if (!ts_value.unix_timestamp(&timestamp, from)) {
-            result.append_null();
-            continue;
-        }
-        DateTimeValue ts_value2;
-        // TODO find a better approach to replace datetime_value.from_unixtime
-        if (!ts_value2.from_unixtime(timestamp, to)) {
-            result.append_null();
-            continue;
-        }
-
+        // the microseconds are dropped, like DateTimeValue::from_unixtime.
+        int64_t timestamp = from_cache.local_to_utc(time_viewer.value(row).to_unix_second());
         TimestampValue ts;
-        ts.from_timestamp(ts_value2.year(), ts_value2.month(), ts_value2.day(), ts_value2.hour(), ts_value2.minute(),
-                          ts_value2.second(), 0);
+        ts.from_unix_second(to_cache.utc_to_local(timestamp));
         result.append(ts);
     }
 
@@ -561,6 +545,7 @@ ColumnPtr TimeFunctions::to_unix_from_datetime(FunctionContext* context, const C
     DCHECK_EQ(columns.size(), 1);
 
     auto date_viewer = ColumnViewer<TYPE_DATETIME>(columns[0]);
+    TimezoneOffsetCache cache(context->impl()->state()->timezone_obj());
 
     ColumnBuilder<TYPE_INT> result;
     auto size = columns[0]->size();
@@ -570,20 +555,10 @@ ColumnPtr TimeFunctions::to_unix_from_datetime(FunctionContext* context, const C
             continue;
         }
 
-        auto date = date_viewer.value(row);
-
-        int year, month, day, hour, minute, second, usec;
-        date.to_timestamp(&year, &month, &day, &hour, &minute, &second, &usec);
-        DateTimeValue tv(TIME_DATETIME, year, month, day, hour, minute, second, usec);
-
-        int64_t timestamp;
-        if (!tv.unix_timestamp(&timestamp, context->impl()->state()->timezone_obj())) {
-            result.append_null();
-        } else {
-            timestamp = timestamp < 0 ? 0 : timestamp;
-            timestamp = timestamp > INT_MAX ? 0 : timestamp;
-            result.append(timestamp);
-        }
+        int64_t timestamp = cache.local_to_utc(date_viewer.value(row).to_unix_second());
+        timestamp = timestamp < 0 ? 0 : timestamp;
+        timestamp = timestamp > INT_MAX ? 0 : timestamp;
+        result.append(timestamp);
     }
 
     return result.build(ColumnHelper::is_all_const(columns));
@@ -596,6 +571,7 @@ ColumnPtr TimeFunctions::to_unix_from_date(FunctionContext* context, const Colum
     DCHECK_EQ(columns.size(), 1);
 
     auto date_viewer = ColumnViewer<TYPE_DATE>(columns[0]);
+    TimezoneOffsetCache cache(context->impl()->state()->timezone_obj());
 
     ColumnBuilder<TYPE_INT> result;
     auto size = columns[0]->size();
@@ -605,20 +581,11 @@ ColumnPtr TimeFunctions::to_unix_from_date(FunctionContext* context, const Colum
             continue;
         }
 
-        auto date = date_viewer.value(row);
-
-        int year, month, day;
-        date.to_date(&year, &month, &day);
-        DateTimeValue tv(TIME_DATE, year, month, day, 0, 0, 0, 0);
-
-        int64_t timestamp;
-        if (!tv.unix_timestamp(&timestamp, context->impl()->state()->timezone_obj())) {
-            result.append_null();
-        } else {
-            timestamp = timestamp < 0 ? 0 : timestamp;
-            timestamp = timestamp > INT_MAX ? 0 : timestamp;
-            result.append(timestamp);
-        }
+        TimestampValue ts = (TimestampValue)date_viewer.value(row);
+        int64_t timestamp = cache.local_to_utc(ts.to_unix_second());
+        timestamp = timestamp < 0 ? 0 : timestamp;
+        timestamp = timestamp > INT_MAX ? 0 : timestamp;
+        result.append(timestamp);
     }
 
     return result.build(ColumnHelper::is_all_const(columns));
@@ -683,6 +650,7 @@ ColumnPtr TimeFunctions::from_unix_to_datetime(FunctionContext* context, const C
     RETURN_IF_COLUMNS_ONLY_NULL(columns);
 
     ColumnViewer<TYPE_INT> data_column(columns[0]);
+    TimezoneOffsetCache cache(context->impl()->state()->timezone_obj());
 
     ColumnBuilder<TYPE_VARCHAR> result;
     auto size = columns[0]->size();
@@ -698,14 +666,11 @@ ColumnPtr TimeFunctions::from_unix_to_datetime(FunctionContext* context, const C
             continue;
         }
 
-        DateTimeValue dtv;
-        if (!dtv.from_unixtime(date, context->impl()->state()->timezone_obj())) {
-            result.append_null();
-            continue;
-        }
-        char buf[64];
-        dtv.to_string(buf);
-        result.append(Slice(buf));
+        TimestampValue ts;
+        ts.from_unix_second(cache.utc_to_local(date));
+        char buf[TimestampValue::max_string_length()];
+        int len = ts.to_string(buf, sizeof(buf));
+        result.append(Slice(buf, len));
     }
 
     return result.build(ColumnHelper::is_all_const(columns));
@@ -1188,128 +1153,130 @@ Status TimeFunctions::format_close(starrocks_udf::FunctionContext* context,
     return Status::OK();
 }
 
-template <typename OP, PrimitiveType Type>
-ColumnPtr date_format_func(const Columns& cols, size_t patten_size) {
-    ColumnBuilder<TYPE_VARCHAR> builder;
+static inline void format_2_digits(int v, char* to) {
+    to[0] = v / 10 + '0';
+    to[1] = v % 10 + '0';
+}
+
+static inline void format_year(int year, char* to) {
+    format_2_digits(year / 100, to);
+    format_2_digits(year % 100, to + 2);
+}
+
+// The common formats, each of them writes kLength chars of a value.
+struct yyyyMMddFormat {
+    static constexpr size_t kLength = 8;
+    static void format(const DateValue& date_value, char* to) {
+        int y, m, d;
+        date_value.to_date(&y, &m, &d);
+        format_year(y, to);
+        format_2_digits(m, to + 4);
+        format_2_digits(d, to + 6);
+    }
+};
+
+struct yyyy_MM_ddFormat {
+    static constexpr size_t kLength = 10;
+    static void format(const DateValue& date_value, char* to) {
+        int y, m, d;
+        date_value.to_date(&y, &m, &d);
+        format_year(y, to);
+        to[4] = '-';
+        format_2_digits(m, to + 5);
+        to[7] = '-';
+        format_2_digits(d, to + 8);
+    }
+};
+
+struct yyyy_MM_dd_HH_mm_ssFormat {
+    static constexpr size_t kLength = 19;
+    static void format(const TimestampValue& timestamp_value, char* to) {
+        int y, m, d, hour, minute, second, usec;
+        timestamp_value.to_timestamp(&y, &m, &d, &hour, &minute, &second, &usec);
+        format_year(y, to);
+        to[4] = '-';
+        format_2_digits(m, to + 5);
+        to[7] = '-';
+        format_2_digits(d, to + 8);
+        to[10] = ' ';
+        format_2_digits(hour, to + 11);
+        to[13] = ':';
+        format_2_digits(minute, to + 14);
+        to[16] = ':';
+        format_2_digits(second, to + 17);
+    }
+};
+
+struct yyyy_MMFormat {
+    static constexpr size_t kLength = 7;
+    static void format(const DateValue& date_value, char* to) {
+        int y, m, d;
+        date_value.to_date(&y, &m, &d);
+        format_year(y, to);
+        to[4] = '-';
+        format_2_digits(m, to + 5);
+    }
+};
+
+struct yyyyMMFormat {
+    static constexpr size_t kLength = 6;
+    static void format(const DateValue& date_value, char* to) {
+        int y, m, d;
+        date_value.to_date(&y, &m, &d);
+        format_year(y, to);
+        format_2_digits(m, to + 4);
+    }
+};
+
+struct yyyyFormat {
+    static constexpr size_t kLength = 4;
+    static void format(const DateValue& date_value, char* to) {
+        int y, m, d;
+        date_value.to_date(&y, &m, &d);
+        format_year(y, to);
+    }
+};
+
+template <typename Format, typename T>
+std::string format_one_row(const T& value) {
+    std::string s(Format::kLength, ' ');
+    Format::format(value, s.data());
+    return s;
+}
+
+// All the results have the same length, so they are written into the bytes of the result column directly.
+template <typename Format, PrimitiveType Type>
+ColumnPtr date_format_func(const Columns& cols) {
     ColumnViewer<Type> viewer(cols[0]);
-
-    builder.data_column()->reserve(viewer.size(), viewer.size() * patten_size);
-
-    for (int i = 0; i < viewer.size(); ++i) {
+    const size_t size = viewer.size();
+
+    auto data = BinaryColumn::create();
+    auto nulls = NullColumn::create(size, DATUM_NOT_NULL);
+    auto& bytes = data->get_bytes();
+    auto& offsets = data->get_offset();
+    auto& null_data = nulls->get_data();
+    bytes.resize(size * Format::kLength);
+    offsets.resize(size + 1);
+
+    char* to = reinterpret_cast<char*>(bytes.data());
+    size_t pos = 0;
+    bool has_null = false;
+    for (size_t i = 0; i < size; ++i) {
         if (viewer.is_null(i)) {
-            builder.append_null();
-            continue;
+            null_data[i] = DATUM_NULL;
+            has_null = true;
+        } else {
+            Format::format(viewer.value(i), to + pos);
+            pos += Format::kLength;
         }
-
-        builder.append(OP::template apply<RunTimeCppType<Type>, RunTimeCppType<TYPE_VARCHAR>>(viewer.value(i)));
+        offsets[i + 1] = pos;
     }
+    bytes.resize(pos);
 
+    ColumnBuilder<TYPE_VARCHAR> builder(data, nulls, has_null);
     return builder.build(cols[0]->is_constant());
 }
 
-std::string format_for_yyyyMMdd(const DateValue& date_value) {
-    int y, m, d, t;
-    date_value.to_date(&y, &m, &d);
-    char to[8];
-
-    t = y / 100;
-    to[0] = t / 10 + '0';
-    to[1] = t % 10 + '0';
-
-    t = y % 100;
-    to[2] = t / 10 + '0';
-    to[3] = t % 10 + '0';
-
-    to[4] = m / 10 + '0';
-    to[5] = m % 10 + '0';
-    to[6] = d / 10 + '0';
-    to[7] = d % 10 + '0';
-    return std::string(to, 8);
-}
-
-DEFINE_STRING_UNARY_FN_WITH_IMPL(yyyyMMddImpl, v) {
-    return format_for_yyyyMMdd((DateValue)v);
-}
-
-std::string format_for_yyyy_MM_dd_Impl(const DateValue& date_value) {
-    return date_value.to_string();
-}
-
-DEFINE_STRING_UNARY_FN_WITH_IMPL(yyyy_MM_dd_Impl, v) {
-    DateValue d = (DateValue)v;
-    return d.to_string();
-    return format_for_yyyy_MM_dd_Impl((DateValue)v);
-}
-
-std::string format_for_yyyyMMddHHmmssImpl(const TimestampValue& date_value) {
-    return date_value.to_string();
-}
-
-DEFINE_STRING_UNARY_FN_WITH_IMPL(yyyyMMddHHmmssImpl, v) {
-    return format_for_yyyyMMddHHmmssImpl((TimestampValue)v);
-}
-
-std::string format_for_yyyy_MMImpl(const DateValue& date_value) {
-    int y, m, d, t;
-    date_value.to_date(&y, &m, &d);
-    char to[7];
-    t = y / 100;
-    to[0] = t / 10 + '0';
-    to[1] = t % 10 + '0';
-
-    t = y % 100;
-    to[2] = t / 10 + '0';
-    to[3] = t % 10 + '0';
-
-    to[4] = '-';
-    to[5] = m / 10 + '0';
-    to[6] = m % 10 + '0';
-    return std::string(to, 7);
-}
-
-DEFINE_STRING_UNARY_FN_WITH_IMPL(yyyy_MMImpl, v) {
-    return format_for_yyyy_MMImpl((DateValue)v);
-}
-
-std::string format_for_yyyyMMImpl(const DateValue& date_value) {
-    int y, m, d, t;
-    date_value.to_date(&y, &m, &d);
-    char to[6];
-    t = y / 100;
-    to[0] = t / 10 + '0';
-    to[1] = t % 10 + '0';
-
-    t = y % 100;
-    to[2] = t / 10 + '0';
-    to[3] = t % 10 + '0';
-
-    to[4] = m / 10 + '0';
-    to[5] = m % 10 + '0';
-    return std::string(to, 6);
-}
-
-DEFINE_STRING_UNARY_FN_WITH_IMPL(yyyyMMImpl, v) {
-    return format_for_yyyyMMImpl((DateValue)v);
-}
-
-std::string format_for_yyyyImpl(const DateValue& date_value) {
-    int y, m, d, t;
-    date_value.to_date(&y, &m, &d);
-    char to[4];
-    t = y / 100;
-    to[0] = t / 10 + '0';
-    to[1] = t % 10 + '0';
-
-    t = y % 100;
-    to[2] = t / 10 + '0';
-    to[3] = t % 10 + '0';
-    return std::string(to, 4);
-}
-
-DEFINE_STRING_UNARY_FN_WITH_IMPL(yyyyImpl, v) {
-    return format_for_yyyyImpl((DateValue)v);
-}
-
 bool standard_format_one_row(const TimestampValue& timestamp_value, char* buf, const std::string& fmt) {
     int year, month, day, hour, minute, second, microsecond;
     timestamp_value.to_timestamp(&year, &month, &day, &hour, &minute, &second, &microsecond);
@@ -1341,17 +1308,17 @@ ColumnPtr standard_format(const std::string& fmt, int len, const starrocks::vect
 template <PrimitiveType Type>
 ColumnPtr do_format(const TimeFunctions::FormatCtx* ctx, const Columns& cols) {
     if (ctx->fmt_type == TimeFunctions::yyyyMMdd) {
-        return date_format_func<yyyyMMddImpl, Type>(cols, 8);
+        return date_format_func<yyyyMMddFormat, Type>(cols);
     } else if (ctx->fmt_type == TimeFunctions::yyyy_MM_dd) {
-        return date_format_func<yyyy_MM_dd_Impl, Type>(cols, 10);
+        return date_format_func<yyyy_MM_ddFormat, Type>(cols);
     } else if (ctx->fmt_type == TimeFunctions::yyyy_MM_dd_HH_mm_ss) {
-        return date_format_func<yyyyMMddHHmmssImpl, Type>(cols, 28);
+        return date_format_func<yyyy_MM_dd_HH_mm_ssFormat, Type>(cols);
     } else if (ctx->fmt_type == TimeFunctions::yyyy_MM) {
-        return date_format_func<yyyy_MMImpl, Type>(cols, 7);
+        return date_format_func<yyyy_MMFormat, Type>(cols);
     } else if (ctx->fmt_type == TimeFunctions::yyyyMM) {
-        return date_format_func<yyyyMMImpl, Type>(cols, 6);
+        return date_format_func<yyyyMMFormat, Type>(cols);
     } else if (ctx->fmt_type == TimeFunctions::yyyy) {
-        return date_format_func<yyyyImpl, Type>(cols, 4);
+        return date_format_func<yyyyFormat, Type>(cols);
     } else {
         return standard_format<Type>(ctx->fmt, 128, cols);
     }
@@ -1367,17 +1334,17 @@ void common_format_process(ColumnViewer<Type>* viewer_date, ColumnViewer<TYPE_VA
 
     auto format = viewer_format->value(i).to_string();
     if (format == "%Y%m%d" || format == "yyyyMMdd") {
-        builder->append(format_for_yyyyMMdd(viewer_date->value(i)));
+        builder->append(format_one_row<yyyyMMddFormat>((DateValue)viewer_date->value(i)));
     } else if (format == "%Y-%m-%d" || format == "yyyy-MM-dd") {
-        builder->append(format_for_yyyy_MM_dd_Impl(viewer_date->value(i)));
+        builder->append(format_one_row<yyyy_MM_ddFormat>((DateValue)viewer_date->value(i)));
     } else if (format == "%Y-%m-%d %H:%i:%s" || format == "yyyy-MM-dd HH:mm:ss") {
-        builder->append(format_for_yyyyMMddHHmmssImpl(viewer_date->value(i)));
+        builder->append(format_one_row<yyyy_MM_dd_HH_mm_ssFormat>((TimestampValue)viewer_date->value(i)));
     } else if (format == "%Y-%m") {
-        builder->append(format_for_yyyy_MMImpl(viewer_date->value(i)));
+        builder->append(format_one_row<yyyy_MMFormat>((DateValue)viewer_date->value(i)));
     } else if (format == "%Y%m") {
-        builder->append(format_for_yyyyMMImpl(viewer_date->value(i)));
+        builder->append(format_one_row<yyyyMMFormat>((DateValue)viewer_date->value(i)));
     } else if (format == "%Y") {
-        builder->append(format_for_yyyyImpl(viewer_date->value(i)));
+        builder->append(format_one_row<yyyyFormat>((DateValue)viewer_date->value(i)));
     } else {
         char buf[128];
         TimestampValue ts = (TimestampValue)viewer_date->value(i);
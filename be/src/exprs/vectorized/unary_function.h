@@ -160,6 +160,12 @@ public:
         if (v1->is_nullable()) {
             auto col = ColumnHelper::as_raw_column<NullableColumn>(v1);
 
+            // no null to merge into the result, the data column is evaluated directly.
+            if (!col->has_null()) {
+                return FN::template evaluate<Type, ResultType, Args...>(col->data_column(),
+                                                                        std::forward<Args>(args)...);
+            }
+
             if (v1->size() == ColumnHelper::count_nulls(v1)) {
                 auto data = RunTimeColumnType<ResultType>::create(std::forward<Args>(args)...);
                 data->resize(v1->size());
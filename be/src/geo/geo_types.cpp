@@ -171,6 +171,16 @@ bool GeoShape::decode_from(const void* data, size_t size) {
     return decode((const char*)data + 2, size - 2);
 }
 
+bool GeoShape::contains_encoded(const void* data, size_t size, bool* contained) const {
+    const char* ptr = (const char*)data;
+    if (size < 2 + sizeof(S2Point) || ptr[0] != 0X00 || ptr[1] != GEO_SHAPE_POINT) {
+        return false;
+    }
+    S2Point point;
+    memcpy(&point, ptr + 2, sizeof(point));
+    return contains_point(point, contained);
+}
+
 void GeoShape::encode_to(std::string* buf) {
     // reserve a byte for future use
     buf->push_back(0X00);
@@ -349,6 +359,11 @@ std::string GeoPolygon::as_wkt() const {
     return ss.str();
 }
 
+bool GeoPolygon::contains_point(const S2Point& point, bool* contained) const {
+    *contained = _polygon->Contains(point);
+    return true;
+}
+
 bool GeoPolygon::contains(const GeoShape* rhs) const {
     switch (rhs->type()) {
     case GEO_SHAPE_POINT: {
@@ -420,6 +435,11 @@ GeoParseStatus GeoCircle::init(double lng, double lat, double radius_meter) {
     return GEO_PARSE_OK;
 }
 
+bool GeoCircle::contains_point(const S2Point& point, bool* contained) const {
+    *contained = _cap->Contains(point);
+    return true;
+}
+
 bool GeoCircle::contains(const GeoShape* rhs) const {
     switch (rhs->type()) {
     case GEO_SHAPE_POINT: {
@@ -60,9 +60,17 @@ public:
     virtual bool contains(const GeoShape* rhs) const { return false; }
     virtual std::string to_string() const { return ""; };
 
+    // Same as contains() with the shape encoded in |data|, but tests an encoded point without creating a
+    // GeoPoint, i.e. no allocation per row. Return false if it isn't an encoded point or this shape doesn't
+    // support it, in which case the caller should decode the shape and call contains().
+    bool contains_encoded(const void* data, size_t size, bool* contained) const;
+
 protected:
     virtual void encode(std::string* buf) = 0;
     virtual bool decode(const void* data, size_t size) = 0;
+
+    // Set whether this shape contains |point|, return false if it's not supported.
+    virtual bool contains_point(const S2Point& point, bool* contained) const { return false; }
 };
 
 class GeoPoint : public GeoShape {
@@ -129,6 +137,7 @@ public:
 protected:
     void encode(std::string* buf) override;
     bool decode(const void* data, size_t size) override;
+    bool contains_point(const S2Point& point, bool* contained) const override;
 
 private:
     std::unique_ptr<S2Polygon> _polygon;
@@ -149,6 +158,7 @@ public:
 protected:
     void encode(std::string* buf) override;
     bool decode(const void* data, size_t size) override;
+    bool contains_point(const S2Point& point, bool* contained) const override;
 
 private:
     std::unique_ptr<S2Cap> _cap;
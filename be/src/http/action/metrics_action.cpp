@@ -32,6 +32,7 @@
 #include "http/http_headers.h"
 #include "http/http_request.h"
 #include "http/http_response.h"
+#include "gutil/casts.h"
 #include "runtime/exec_env.h"
 #include "util/metrics.h"
 
@@ -45,6 +46,8 @@ public:
 
 private:
     void _visit_simple_metric(const std::string& name, const MetricLabels& labels, Metric* metric);
+    void _visit_histogram_metric(const std::string& name, const MetricLabels& labels, CoreLocalHistogram* metric);
+    void _write_labels(const MetricLabels& labels, const char* quantile);
 
 private:
     std::stringstream _ss;
@@ -97,6 +100,12 @@ void PrometheusMetricsVisitor::visit(const std::string& prefix, const std::strin
             _visit_simple_metric(metric_name, it.first, (Metric*)it.second);
         }
         break;
+    case MetricType::SUMMARY:
+        // all the summaries are histograms.
+        for (auto& it : collector->metrics()) {
+            _visit_histogram_metric(metric_name, it.first, down_cast<CoreLocalHistogram*>(it.second));
+        }
+        break;
     default:
         break;
     }
@@ -105,19 +114,51 @@ void PrometheusMetricsVisitor::visit(const std::string& prefix, const std::strin
 void PrometheusMetricsVisitor::_visit_simple_metric(const std::string& name, const MetricLabels& labels,
                                                     Metric* metric) {
     _ss << name;
-    // labels
-    if (!labels.empty()) {
-        _ss << "{";
-        int i = 0;
-        for (auto& label : labels.labels) {
-            if (i++ > 0) {
-                _ss << ",";
-            }
-            _ss << label.name << "=\"" << label.value << "\"";
+    _write_labels(labels, nullptr);
+    _ss << " " << metric->to_string() << "\n";
+}
+
+// eg:
+// starrocks_be_page_read_latency_us{quantile="0.5"} 127
+// starrocks_be_page_read_latency_us_sum 1634
+// starrocks_be_page_read_latency_us_count 10
+void PrometheusMetricsVisitor::_visit_histogram_metric(const std::string& name, const MetricLabels& labels,
+                                                       CoreLocalHistogram* metric) {
+    CoreLocalHistogram::Snapshot snapshot = metric->snapshot();
+    for (const auto& percentile : CoreLocalHistogram::kPercentiles) {
+        std::stringstream quantile;
+        quantile << percentile.quantile;
+        _ss << name;
+        _write_labels(labels, quantile.str().c_str());
+        _ss << " " << snapshot.percentile(percentile.quantile) << "\n";
+    }
+    _ss << name << "_sum";
+    _write_labels(labels, nullptr);
+    _ss << " " << snapshot.sum << "\n";
+    _ss << name << "_count";
+    _write_labels(labels, nullptr);
+    _ss << " " << snapshot.count << "\n";
+}
+
+void PrometheusMetricsVisitor::_write_labels(const MetricLabels& labels, const char* quantile) {
+    if (labels.empty() && quantile == nullptr) {
+        return;
+    }
+    _ss << "{";
+    int i = 0;
+    for (auto& label : labels.labels) {
+        if (i++ > 0) {
+            _ss << ",";
         }
-        _ss << "}";
+        _ss << label.name << "=\"" << label.value << "\"";
     }
-    _ss << " " << metric->to_string() << "\n";
+    if (quantile != nullptr) {
+        if (i > 0) {
+            _ss << ",";
+        }
+        _ss << "quantile=\"" << quantile << "\"";
+    }
+    _ss << "}";
 }
 
 void SimpleCoreMetricsVisitor::visit(const std::string& prefix, const std::string& name, MetricCollector* collector) {
@@ -168,6 +209,7 @@ void JsonMetricsVisitor::visit(const std::string& prefix, const std::string& nam
     switch (collector->type()) {
     case MetricType::COUNTER:
     case MetricType::GAUGE:
+    case MetricType::SUMMARY:
         for (auto& it : collector->metrics()) {
             const MetricLabels& labels = it.first;
             Metric* metric = reinterpret_cast<Metric*>(it.second);
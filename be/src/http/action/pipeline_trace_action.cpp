@@ -0,0 +1,28 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "http/action/pipeline_trace_action.h"
+
+#include <string>
+
+#include "exec/pipeline/pipeline_driver_tracer.h"
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+
+namespace starrocks {
+
+const static std::string HEADER_JSON = "application/json";
+
+void PipelineTraceAction::handle(HttpRequest* req) {
+    const std::string& query_id = req->param("query_id");
+    if (query_id.empty()) {
+        HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST, "parameter query_id is required");
+        return;
+    }
+    std::string result = pipeline::DriverTracer::instance()->chrome_trace(query_id);
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    HttpChannel::send_reply(req, HttpStatus::OK, result);
+}
+
+} // namespace starrocks
@@ -0,0 +1,20 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "http/http_handler.h"
+
+namespace starrocks {
+
+// Download the state transitions of the pipeline drivers of a query as the JSON of the trace event format of
+// Chrome, e.g. /api/pipeline_trace?query_id=<id>. The query must run with the session variable
+// enable_pipeline_trace.
+class PipelineTraceAction : public HttpHandler {
+public:
+    PipelineTraceAction() = default;
+    ~PipelineTraceAction() override = default;
+
+    void handle(HttpRequest* req) override;
+};
+
+} // namespace starrocks
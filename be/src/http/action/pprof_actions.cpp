@@ -37,9 +37,11 @@
 #include "http/http_headers.h"
 #include "http/http_request.h"
 #include "http/http_response.h"
+#include "runtime/cpu_sampler.h"
 #include "runtime/exec_env.h"
 #include "util/bfd_parser.h"
 #include "util/file_utils.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -136,9 +138,16 @@ void ProfileAction::handle(HttpRequest* req) {
     std::ostringstream tmp_prof_file_name;
     // Build a temporary file name that is hopefully unique.
     tmp_prof_file_name << config::pprof_profile_dir << "/starrocks_profile." << getpid() << "." << rand();
+    // The cpu profiler of gperftools uses SIGPROF too.
+    bool sampler_running = CpuSampler::instance()->is_running();
+    CpuSampler::instance()->stop();
     ProfilerStart(tmp_prof_file_name.str().c_str());
     sleep(seconds);
     ProfilerStop();
+    if (sampler_running) {
+        LOG_IF(WARNING, !CpuSampler::instance()->start(config::cpu_sample_frequency).ok())
+                << "fail to restart the cpu sampler";
+    }
     std::ifstream prof_file(tmp_prof_file_name.str().c_str(), std::ios::in);
     std::stringstream ss;
     if (!prof_file.is_open()) {
@@ -155,6 +164,35 @@ void ProfileAction::handle(HttpRequest* req) {
 #endif
 }
 
+// Return the cpu samples of the queries taken by CpuSampler in the collapsed format of the flame graph tools,
+// e.g. "flamegraph.pl" or "speedscope", filtered by the query id if the parameter "query_id" is given. The samples
+// taken in the next "seconds" seconds are returned if it's given, otherwise the samples kept already.
+class QueryCpuAction : public HttpHandler {
+public:
+    QueryCpuAction(BfdParser* parser) : _parser(parser) {}
+    ~QueryCpuAction() override = default;
+
+    void handle(HttpRequest* req) override;
+
+private:
+    BfdParser* _parser;
+};
+
+void QueryCpuAction::handle(HttpRequest* req) {
+    if (!CpuSampler::instance()->is_running()) {
+        HttpChannel::send_reply(req, "The cpu sampler isn't running, see the config cpu_sample_frequency.");
+        return;
+    }
+    int64_t since_ns = 0;
+    const std::string& seconds_str = req->param(SECOND_KEY);
+    if (!seconds_str.empty()) {
+        since_ns = MonotonicNanos();
+        sleep(std::atoi(seconds_str.c_str()));
+    }
+    std::string str = CpuSampler::instance()->collapsed_stacks(req->param("query_id"), since_ns, _parser);
+    HttpChannel::send_reply(req, str);
+}
+
 class PmuProfileAction : public HttpHandler {
 public:
     PmuProfileAction() {}
@@ -251,6 +289,7 @@ Status PprofActions::setup(ExecEnv* exec_env, EvHttpServer* http_server) {
     http_server->register_handler(HttpMethod::GET, "/pprof/heap", new HeapAction());
     http_server->register_handler(HttpMethod::GET, "/pprof/growth", new GrowthAction());
     http_server->register_handler(HttpMethod::GET, "/pprof/profile", new ProfileAction());
+    http_server->register_handler(HttpMethod::GET, "/pprof/query_cpu", new QueryCpuAction(exec_env->bfd_parser()));
     http_server->register_handler(HttpMethod::GET, "/pprof/pmuprofile", new PmuProfileAction());
     http_server->register_handler(HttpMethod::GET, "/pprof/contention", new ContentionAction());
     http_server->register_handler(HttpMethod::GET, "/pprof/cmdline", new CmdlineAction());
@@ -37,6 +37,7 @@
 #include "gen_cpp/FrontendService.h"
 #include "gen_cpp/FrontendService_types.h"
 #include "gen_cpp/HeartbeatService_types.h"
+#include "gutil/casts.h"
 #include "http/http_channel.h"
 #include "http/http_common.h"
 #include "http/http_headers.h"
@@ -51,6 +52,7 @@
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_context.h"
 #include "runtime/stream_load/stream_load_executor.h"
+#include "runtime/stream_load/stream_load_group_commit_mgr.h"
 #include "runtime/stream_load/stream_load_pipe.h"
 #include "util/byte_buffer.h"
 #include "util/debug_util.h"
@@ -159,6 +161,10 @@ Status StreamLoadAction::_handle(StreamLoadContext* ctx) {
                      << ", receive_bytes=" << ctx->receive_bytes << ", id=" << ctx->id;
         return Status::InternalError("receive body dont't equal with body bytes");
     }
+    if (ctx->group_commit_request != nullptr) {
+        auto* body_sink = down_cast<GroupCommitBodySink*>(ctx->body_sink.get());
+        return _exec_env->stream_load_group_commit_mgr()->load(ctx, *ctx->group_commit_request, body_sink->body());
+    }
     if (!ctx->use_streaming) {
         // if we use non-streaming, we need to close file first,
         // then execute_plan_fragment here
@@ -274,6 +280,14 @@ Status StreamLoadAction::_on_header(HttpRequest* http_req, StreamLoadContext* ct
         ctx->timeout_second = timeout_second;
     }
 
+    // The group of the load begins the transaction and plans the load once the whole body is received.
+    if (_use_group_commit(http_req, ctx)) {
+        ctx->group_commit_request = std::make_unique<TStreamLoadPutRequest>();
+        RETURN_IF_ERROR(_init_put_request(http_req, ctx, ctx->group_commit_request.get()));
+        ctx->body_sink = std::make_shared<GroupCommitBodySink>();
+        return Status::OK();
+    }
+
     // begin transaction
     int64_t begin_txn_start_time = MonotonicNanos();
     RETURN_IF_ERROR(_exec_env->stream_load_executor()->begin_txn(ctx));
@@ -329,11 +343,8 @@ Status StreamLoadAction::_process_put(HttpRequest* http_req, StreamLoadContext*
 
     // put request
     TStreamLoadPutRequest request;
-    set_request_auth(&request, ctx->auth);
-    request.db = ctx->db;
-    request.tbl = ctx->table;
+    RETURN_IF_ERROR(_init_put_request(http_req, ctx, &request));
     request.txnId = ctx->txn_id;
-    request.formatType = ctx->format;
     request.__set_loadId(ctx->id.to_thrift());
     if (ctx->use_streaming) {
         auto pipe =
@@ -350,48 +361,91 @@ Status StreamLoadAction::_process_put(HttpRequest* http_req, StreamLoadContext*
         request.fileType = TFileType::FILE_LOCAL;
         ctx->body_sink = file_sink;
     }
+    // plan this load
+#ifndef BE_TEST
+    TNetworkAddress master_addr = _exec_env->master_info()->network_address;
+    int64_t stream_load_put_start_time = MonotonicNanos();
+    RETURN_IF_ERROR(ThriftRpcHelper::rpc<FrontendServiceClient>(
+            master_addr.hostname, master_addr.port,
+            [&request, ctx](FrontendServiceConnection& client) { client->streamLoadPut(ctx->put_result, request); }));
+    ctx->stream_load_put_cost_nanos = MonotonicNanos() - stream_load_put_start_time;
+#else
+    ctx->put_result = k_stream_load_put_result;
+#endif
+    Status plan_status(ctx->put_result.status);
+    if (!plan_status.ok()) {
+        LOG(WARNING) << "plan streaming load failed. errmsg=" << plan_status.get_error_msg() << ctx->brief();
+        return plan_status;
+    }
+    VLOG(3) << "params is " << apache::thrift::ThriftDebugString(ctx->put_result.params);
+    // if we not use streaming, we must download total content before we begin
+    // to process this load
+    if (!ctx->use_streaming) {
+        return Status::OK();
+    }
+
+    return _exec_env->stream_load_executor()->execute_plan_fragment(ctx);
+}
+
+bool StreamLoadAction::_use_group_commit(HttpRequest* http_req, StreamLoadContext* ctx) {
+    if (!boost::iequals(http_req->header(HTTP_GROUP_COMMIT), "true")) {
+        return false;
+    }
+    // The bodies of a group are concatenated, so only the small csv bodies of the default row delimiter are merged.
+    bool can_merge = ctx->format == TFileFormatType::FORMAT_CSV_PLAIN && http_req->header(HTTP_ROW_DELIMITER).empty() &&
+                     ctx->body_bytes > 0 && ctx->body_bytes <= config::stream_load_group_commit_max_bytes;
+    LOG_IF(INFO, !can_merge) << "the stream load is not merged into a group commit." << ctx->brief();
+    return can_merge;
+}
+
+Status StreamLoadAction::_init_put_request(HttpRequest* http_req, StreamLoadContext* ctx,
+                                           TStreamLoadPutRequest* request) {
+    set_request_auth(request, ctx->auth);
+    request->db = ctx->db;
+    request->tbl = ctx->table;
+    request->formatType = ctx->format;
     if (!http_req->header(HTTP_COLUMNS).empty()) {
-        request.__set_columns(http_req->header(HTTP_COLUMNS));
+        request->__set_columns(http_req->header(HTTP_COLUMNS));
     }
     if (!http_req->header(HTTP_WHERE).empty()) {
-        request.__set_where(http_req->header(HTTP_WHERE));
+        request->__set_where(http_req->header(HTTP_WHERE));
     }
     if (!http_req->header(HTTP_COLUMN_SEPARATOR).empty()) {
-        request.__set_columnSeparator(http_req->header(HTTP_COLUMN_SEPARATOR));
+        request->__set_columnSeparator(http_req->header(HTTP_COLUMN_SEPARATOR));
     }
     if (!http_req->header(HTTP_ROW_DELIMITER).empty()) {
-        request.__set_rowDelimiter(http_req->header(HTTP_ROW_DELIMITER));
+        request->__set_rowDelimiter(http_req->header(HTTP_ROW_DELIMITER));
     }
     if (!http_req->header(HTTP_PARTITIONS).empty()) {
-        request.__set_partitions(http_req->header(HTTP_PARTITIONS));
-        request.__set_isTempPartition(false);
+        request->__set_partitions(http_req->header(HTTP_PARTITIONS));
+        request->__set_isTempPartition(false);
         if (!http_req->header(HTTP_TEMP_PARTITIONS).empty()) {
             return Status::InvalidArgument("Can not specify both partitions and temporary partitions");
         }
     }
     if (!http_req->header(HTTP_TEMP_PARTITIONS).empty()) {
-        request.__set_partitions(http_req->header(HTTP_TEMP_PARTITIONS));
-        request.__set_isTempPartition(true);
+        request->__set_partitions(http_req->header(HTTP_TEMP_PARTITIONS));
+        request->__set_isTempPartition(true);
         if (!http_req->header(HTTP_PARTITIONS).empty()) {
             return Status::InvalidArgument("Can not specify both partitions and temporary partitions");
         }
     }
     if (!http_req->header(HTTP_NEGATIVE).empty() && http_req->header(HTTP_NEGATIVE) == "true") {
-        request.__set_negative(true);
+        request->__set_negative(true);
     } else {
-        request.__set_negative(false);
+        request->__set_negative(false);
     }
     if (!http_req->header(HTTP_STRICT_MODE).empty()) {
         if (boost::iequals(http_req->header(HTTP_STRICT_MODE), "false")) {
-            request.__set_strictMode(false);
+            request->__set_strictMode(false);
         } else if (boost::iequals(http_req->header(HTTP_STRICT_MODE), "true")) {
-            request.__set_strictMode(true);
+            request->__set_strictMode(true);
         } else {
             return Status::InvalidArgument("Invalid strict mode format. Must be bool type");
         }
     }
     if (!http_req->header(HTTP_TIMEZONE).empty()) {
-        request.__set_timezone(http_req->header(HTTP_TIMEZONE));
+        request->__set_timezone(http_req->header(HTTP_TIMEZONE));
     }
     if (!http_req->header(HTTP_LOAD_MEM_LIMIT).empty()) {
         try {
@@ -400,58 +454,36 @@ Status StreamLoadAction::_process_put(HttpRequest* http_req, StreamLoadContext*
             if (load_mem_limit < 0) {
                 return Status::InvalidArgument("load_mem_limit must be equal or greater than 0");
             }
-            request.__set_loadMemLimit(load_mem_limit);
+            request->__set_loadMemLimit(load_mem_limit);
         } catch (const std::invalid_argument& e) {
             return Status::InvalidArgument("Invalid load mem limit format");
         }
     }
     if (!http_req->header(HTTP_JSONPATHS).empty()) {
-        request.__set_jsonpaths(http_req->header(HTTP_JSONPATHS));
+        request->__set_jsonpaths(http_req->header(HTTP_JSONPATHS));
     }
     if (!http_req->header(HTTP_JSONROOT).empty()) {
-        request.__set_json_root(http_req->header(HTTP_JSONROOT));
+        request->__set_json_root(http_req->header(HTTP_JSONROOT));
     }
     if (!http_req->header(HTTP_STRIP_OUTER_ARRAY).empty()) {
         if (boost::iequals(http_req->header(HTTP_STRIP_OUTER_ARRAY), "true")) {
-            request.__set_strip_outer_array(true);
+            request->__set_strip_outer_array(true);
         } else {
-            request.__set_strip_outer_array(false);
+            request->__set_strip_outer_array(false);
         }
     } else {
-        request.__set_strip_outer_array(false);
+        request->__set_strip_outer_array(false);
     }
     if (ctx->timeout_second != -1) {
-        request.__set_timeout(ctx->timeout_second);
+        request->__set_timeout(ctx->timeout_second);
     }
-    request.__set_thrift_rpc_timeout_ms(config::thrift_rpc_timeout_ms);
-    // plan this load
-    TNetworkAddress master_addr = _exec_env->master_info()->network_address;
+    request->__set_thrift_rpc_timeout_ms(config::thrift_rpc_timeout_ms);
 #ifndef BE_TEST
     if (!http_req->header(HTTP_MAX_FILTER_RATIO).empty()) {
         ctx->max_filter_ratio = strtod(http_req->header(HTTP_MAX_FILTER_RATIO).c_str(), nullptr);
     }
-
-    int64_t stream_load_put_start_time = MonotonicNanos();
-    RETURN_IF_ERROR(ThriftRpcHelper::rpc<FrontendServiceClient>(
-            master_addr.hostname, master_addr.port,
-            [&request, ctx](FrontendServiceConnection& client) { client->streamLoadPut(ctx->put_result, request); }));
-    ctx->stream_load_put_cost_nanos = MonotonicNanos() - stream_load_put_start_time;
-#else
-    ctx->put_result = k_stream_load_put_result;
 #endif
-    Status plan_status(ctx->put_result.status);
-    if (!plan_status.ok()) {
-        LOG(WARNING) << "plan streaming load failed. errmsg=" << plan_status.get_error_msg() << ctx->brief();
-        return plan_status;
-    }
-    VLOG(3) << "params is " << apache::thrift::ThriftDebugString(ctx->put_result.params);
-    // if we not use streaming, we must download total content before we begin
-    // to process this load
-    if (!ctx->use_streaming) {
-        return Status::OK();
-    }
-
-    return _exec_env->stream_load_executor()->execute_plan_fragment(ctx);
+    return Status::OK();
 }
 
 Status StreamLoadAction::_data_saved_path(HttpRequest* req, std::string* file_path) {
@@ -54,6 +54,10 @@ private:
     Status _data_saved_path(HttpRequest* req, std::string* file_path);
     Status _execute_plan_fragment(StreamLoadContext* ctx);
     Status _process_put(HttpRequest* http_req, StreamLoadContext* ctx);
+    // Whether the load is merged into a group commit, see StreamLoadGroupCommitMgr.
+    bool _use_group_commit(HttpRequest* http_req, StreamLoadContext* ctx);
+    // Fill |request| with the properties of the load, except the transaction, the load id and the file.
+    Status _init_put_request(HttpRequest* http_req, StreamLoadContext* ctx, TStreamLoadPutRequest* request);
 
 private:
     ExecEnv* _exec_env;
@@ -189,7 +189,10 @@ Status HttpClient::download(const std::string& local_path) {
         return Status::InternalError("open file failed");
     }
     Status status;
-    auto callback = [&status, &fp, &local_path](const void* data, size_t length) {
+    auto callback = [this, &status, &fp, &local_path](const void* data, size_t length) {
+        if (_rate_limiter != nullptr) {
+            _rate_limiter->acquire(length, _rate_limit_bytes_per_second);
+        }
         auto res = fwrite(data, length, 1, fp.get());
         if (res != 1) {
             LOG(WARNING) << "fail to write data to file, file=" << local_path << ", error=" << ferror(fp.get());
@@ -31,6 +31,7 @@
 #include "http/http_method.h"
 #include "http/http_response.h"
 #include "http/utils.h"
+#include "util/rate_limiter.h"
 namespace starrocks {
 
 // Helper class to access HTTP resource
@@ -109,6 +110,13 @@ public:
         return execute();
     }
 
+    // limit the rate of the downloads of this client to |bytes_per_second|, together with all the other
+    // downloads limited by |limiter|
+    void set_rate_limiter(RateLimiter* limiter, int64_t bytes_per_second) {
+        _rate_limiter = limiter;
+        _rate_limit_bytes_per_second = bytes_per_second;
+    }
+
     // helper function to download a file, you can call this function to downlaod
     // a file to local_path
     Status download(const std::string& local_path);
@@ -134,6 +142,8 @@ private:
     const HttpCallback* _callback = nullptr;
     char _error_buf[CURL_ERROR_SIZE];
     curl_slist* _header_list = nullptr;
+    RateLimiter* _rate_limiter = nullptr;
+    int64_t _rate_limit_bytes_per_second = 0;
 };
 
 } // namespace starrocks
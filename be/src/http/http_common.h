@@ -44,6 +44,7 @@ static const std::string HTTP_LOAD_MEM_LIMIT = "load_mem_limit";
 static const std::string HTTP_JSONPATHS = "jsonpaths";
 static const std::string HTTP_JSONROOT = "json_root";
 static const std::string HTTP_STRIP_OUTER_ARRAY = "strip_outer_array";
+static const std::string HTTP_GROUP_COMMIT = "group_commit";
 
 static const std::string HTTP_100_CONTINUE = "100-continue";
 
@@ -0,0 +1,176 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/cpu_sampler.h"
+
+#include <gperftools/stacktrace.h>
+#include <sys/time.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#include "gutil/strings/substitute.h"
+#include "util/bfd_parser.h"
+#include "util/time.h"
+#include "util/uid_util.h"
+
+namespace starrocks {
+
+CpuSampler* CpuSampler::instance() {
+    static CpuSampler sampler;
+    return &sampler;
+}
+
+Status CpuSampler::start(int frequency) {
+    if (frequency <= 0 || frequency > 1000) {
+        return Status::InvalidArgument(strings::Substitute("invalid sampling frequency $0", frequency));
+    }
+    std::lock_guard<std::mutex> l(_mutex);
+    if (_samples == nullptr) {
+        // Never freed, the signal handler may be writing to it while the sampler is stopped.
+        _samples.reset(new Sample[kMaxSamples]);
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = _signal_handler;
+    sa.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGPROF, &sa, nullptr) != 0) {
+        return Status::InternalError(strings::Substitute("fail to set the handler of SIGPROF, errno=$0", errno));
+    }
+
+    struct itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = 1000000 / frequency;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        return Status::InternalError(strings::Substitute("fail to set the profiling timer, errno=$0", errno));
+    }
+    _frequency = frequency;
+    return Status::OK();
+}
+
+void CpuSampler::stop() {
+    std::lock_guard<std::mutex> l(_mutex);
+    if (_frequency == 0) {
+        return;
+    }
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    _frequency = 0;
+}
+
+bool CpuSampler::is_running() const {
+    std::lock_guard<std::mutex> l(_mutex);
+    return _frequency > 0;
+}
+
+void CpuSampler::_signal_handler(int signo, siginfo_t* info, void* ucontext) {
+    int saved_errno = errno;
+    instance()->_record(ucontext);
+    errno = saved_errno;
+}
+
+// Only async-signal-safe code here.
+void CpuSampler::_record(void* ucontext) {
+    if (_samples == nullptr) {
+        return;
+    }
+    uint64_t index = _next_sample.fetch_add(1, std::memory_order_relaxed);
+    Sample& sample = _samples[index % kMaxSamples];
+    uint64_t version = sample.version.load(std::memory_order_relaxed);
+    sample.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    sample.time_ns = MonotonicNanos();
+    sample.tags = CurrentThread::sample_tags();
+    // Skip the frames of this function and the signal handler.
+    sample.depth = GetStackTraceWithContext(sample.frames, kMaxDepth, 2, ucontext);
+    sample.version.store(version + 2, std::memory_order_release);
+}
+
+static std::string symbolize(void* pc, BfdParser* parser, std::unordered_map<void*, std::string>* cache) {
+    auto iter = cache->find(pc);
+    if (iter != cache->end()) {
+        return iter->second;
+    }
+    char address[32];
+    snprintf(address, sizeof(address), "%p", pc);
+    std::string name = address;
+    if (parser != nullptr) {
+        std::string file_name;
+        std::string func_name;
+        unsigned int lineno = 0;
+        const char* end = nullptr;
+        if (parser->decode_address(address, &end, &file_name, &func_name, &lineno) == 0) {
+            name = func_name;
+        }
+    }
+    // ';' separates the frames in the collapsed format.
+    std::replace(name.begin(), name.end(), ';', ':');
+    return cache->emplace(pc, std::move(name)).first->second;
+}
+
+std::string CpuSampler::collapsed_stacks(const std::string& query_id, int64_t since_ns, BfdParser* parser) const {
+    std::map<std::string, int64_t> stacks;
+    std::unordered_map<void*, std::string> symbols;
+    if (_samples != nullptr) {
+        Sample sample;
+        for (int i = 0; i < kMaxSamples; ++i) {
+            const Sample& src = _samples[i];
+            uint64_t version = src.version.load(std::memory_order_acquire);
+            if (version == 0 || version % 2 == 1) {
+                continue;
+            }
+            sample.time_ns = src.time_ns;
+            sample.tags = src.tags;
+            sample.depth = std::min(std::max(src.depth, 0), kMaxDepth);
+            std::copy(src.frames, src.frames + sample.depth, sample.frames);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (src.version.load(std::memory_order_relaxed) != version || sample.time_ns < since_ns) {
+                continue;
+            }
+
+            TUniqueId sample_query_id;
+            sample_query_id.__set_hi(sample.tags.query_id_hi);
+            sample_query_id.__set_lo(sample.tags.query_id_lo);
+            std::string sample_query = print_id(sample_query_id);
+            if (!query_id.empty() && query_id != sample_query) {
+                continue;
+            }
+
+            std::stringstream ss;
+            if (sample.tags.query_id_hi == 0 && sample.tags.query_id_lo == 0) {
+                ss << "no_query";
+            } else {
+                TUniqueId instance_id;
+                instance_id.__set_hi(sample.tags.fragment_instance_id_hi);
+                instance_id.__set_lo(sample.tags.fragment_instance_id_lo);
+                ss << "query_" << sample_query << ";instance_" << print_id(instance_id);
+                if (sample.tags.operator_id >= 0) {
+                    ss << ";operator_" << sample.tags.operator_id << "_node_" << sample.tags.plan_node_id;
+                } else if (sample.tags.plan_node_id >= 0) {
+                    ss << ";node_" << sample.tags.plan_node_id;
+                }
+            }
+            // The outermost frame goes first.
+            for (int depth = sample.depth - 1; depth >= 0; --depth) {
+                ss << ';' << symbolize(sample.frames[depth], parser, &symbols);
+            }
+            stacks[ss.str()]++;
+        }
+    }
+
+    std::stringstream ss;
+    for (const auto& [stack, count] : stacks) {
+        ss << stack << ' ' << count << '\n';
+    }
+    return ss.str();
+}
+
+} // namespace starrocks
@@ -0,0 +1,68 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <signal.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "common/status.h"
+#include "runtime/current_thread.h"
+
+namespace starrocks {
+
+class BfdParser;
+
+// CpuSampler samples the stacks of the threads on CPU by SIGPROF, at a low frequency so it can run all the time.
+// Each sample is tagged with the query, the fragment instance and the pipeline operator the thread is running,
+// see CurrentThread::sample_tags, so the samples of one query can be told apart from the others on a busy backend.
+// The latest kMaxSamples samples are kept in a ring buffer.
+//
+// SIGPROF is used by the cpu profiler of gperftools too, so the sampler must be stopped while it runs.
+class CpuSampler {
+public:
+    static constexpr int kMaxSamples = 16384;
+    static constexpr int kMaxDepth = 32;
+
+    static CpuSampler* instance();
+
+    // Sample |frequency| times per second of the cpu time consumed by this process.
+    Status start(int frequency);
+    void stop();
+    bool is_running() const;
+
+    // Return the samples taken since |since_ns| (MonotonicNanos) in the collapsed format of the flame graph tools,
+    // one stack per line with the number of its samples, e.g.
+    //   query_<id>;instance_<id>;operator_<id>_node_<id>;main;foo;bar 12
+    // The samples of the threads running no query start with "no_query", and the samples of the non-pipeline
+    // engine are tagged with the plan node instead of the operator if the thread runs a single node, e.g. a scanner.
+    // If |query_id| isn't empty, only the samples of the query printed as print_id are returned. The frames are
+    // symbolized by |parser| if it isn't null, otherwise they are printed as hex addresses.
+    std::string collapsed_stacks(const std::string& query_id, int64_t since_ns, BfdParser* parser) const;
+
+private:
+    struct Sample {
+        // Odd while the sample is being written, it increases on each write, so a reader can detect the torn
+        // samples in the same way as a seqlock.
+        std::atomic<uint64_t> version{0};
+        int64_t time_ns;
+        CurrentThread::SampleTags tags;
+        int32_t depth;
+        void* frames[kMaxDepth];
+    };
+
+    CpuSampler() = default;
+
+    static void _signal_handler(int signo, siginfo_t* info, void* ucontext);
+    void _record(void* ucontext);
+
+    mutable std::mutex _mutex;
+    int _frequency = 0;
+    std::unique_ptr<Sample[]> _samples;
+    std::atomic<uint64_t> _next_sample{0};
+};
+
+} // namespace starrocks
@@ -7,20 +7,16 @@
 #include "runtime/mem_tracker.h"
 
 namespace starrocks {
+// CurrentMemTracker tracks the memory on the memory tracker of the current thread, through the bytes cached by the
+// thread, see CurrentThread::kMemCacheBytes.
 class CurrentMemTracker {
 public:
-    inline static void consume(int64_t size) {
-        MemTracker* tracker = CurrentThread::mem_tracker();
-        if (tracker != nullptr && size != 0) {
-            tracker->consume(size);
-        }
-    }
+    inline static void consume(int64_t size) { CurrentThread::mem_consume(size); }
 
-    inline static void release(int64_t size) {
-        MemTracker* tracker = CurrentThread::mem_tracker();
-        if (tracker != nullptr && size != 0) {
-            tracker->release(size);
-        }
-    }
+    inline static void release(int64_t size) { CurrentThread::mem_consume(-size); }
+
+    // Add the bytes cached to the tracker, e.g. before checking its limit precisely.
+    inline static void flush() { CurrentThread::mem_flush(); }
 };
+
 } // namespace starrocks
@@ -0,0 +1,16 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/current_thread.h"
+
+#include "runtime/mem_tracker.h"
+
+namespace starrocks {
+
+void CurrentThread::mem_flush() {
+    if (s_tls_mem_cached_bytes != 0 && s_tls_mem_tracker != nullptr) {
+        s_tls_mem_tracker->consume(s_tls_mem_cached_bytes);
+    }
+    s_tls_mem_cached_bytes = 0;
+}
+
+} // namespace starrocks
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 #include "gen_cpp/Types_types.h"
@@ -16,18 +17,48 @@ namespace starrocks {
 
 class CurrentThread {
 public:
+    // The bytes consumed or released by a thread are cached in a thread local counter, and added to its memory
+    // tracker and the ancestors only when the counter reaches this size in either direction, so the frequent small
+    // allocations don't contend on the atomic counters of the trackers shared by all the threads. The consumption
+    // of a tracker lags behind by less than this size per thread, the limit checks are accurate within it.
+    static constexpr int64_t kMemCacheBytes = 1024 * 1024;
+
+    // The ids the cpu samples taken on this thread are tagged with, see CpuSampler. They are plain integers so
+    // the signal handler of the sampler can read them.
+    struct SampleTags {
+        int64_t query_id_hi;
+        int64_t query_id_lo;
+        int64_t fragment_instance_id_hi;
+        int64_t fragment_instance_id_lo;
+        // The id of the pipeline operator running and its plan node, -1 if none.
+        int32_t operator_id;
+        int32_t plan_node_id;
+    };
+
     static void set_query_id(const starrocks::TUniqueId& query_id);
     static const starrocks::TUniqueId& query_id();
     static const std::string& query_id_string();
 
-    // Return old memory tracker.
+    static void set_fragment_instance_id(const starrocks::TUniqueId& fragment_instance_id);
+    static void set_operator(int32_t operator_id, int32_t plan_node_id);
+    static const SampleTags& sample_tags();
+
+    // Return old memory tracker, the bytes cached are added to the old tracker first.
     static starrocks::MemTracker* set_mem_tracker(starrocks::MemTracker* tracker);
     // Return current memory tracker in this thread.
     static starrocks::MemTracker* mem_tracker();
 
+    // Consume |bytes| on the memory tracker of this thread, negative |bytes| are released.
+    static void mem_consume(int64_t bytes);
+    // Add the bytes cached to the memory tracker of this thread.
+    static void mem_flush();
+    static int64_t mem_cached_bytes();
+
 private:
     // `__thread` is faster than `thread_local`.
     static inline __thread starrocks::MemTracker* s_tls_mem_tracker{nullptr}; // NOLINT
+    static inline __thread int64_t s_tls_mem_cached_bytes{0};                 // NOLINT
+    static inline __thread SampleTags s_tls_sample_tags{0, 0, 0, 0, -1, -1};  // NOLINT
     static inline thread_local starrocks::TUniqueId s_tls_query_id{};         // NOLINT
     static inline thread_local std::string s_tls_str_query_id{};              // NOLINT
 };
@@ -35,6 +66,8 @@ private:
 inline void CurrentThread::set_query_id(const starrocks::TUniqueId& query_id) {
     s_tls_query_id = query_id;
     s_tls_str_query_id = starrocks::print_id(query_id);
+    s_tls_sample_tags.query_id_hi = query_id.hi;
+    s_tls_sample_tags.query_id_lo = query_id.lo;
 }
 
 inline const starrocks::TUniqueId& CurrentThread::query_id() {
@@ -45,7 +78,22 @@ inline const std::string& CurrentThread::query_id_string() {
     return s_tls_str_query_id;
 }
 
+inline void CurrentThread::set_fragment_instance_id(const starrocks::TUniqueId& fragment_instance_id) {
+    s_tls_sample_tags.fragment_instance_id_hi = fragment_instance_id.hi;
+    s_tls_sample_tags.fragment_instance_id_lo = fragment_instance_id.lo;
+}
+
+inline void CurrentThread::set_operator(int32_t operator_id, int32_t plan_node_id) {
+    s_tls_sample_tags.operator_id = operator_id;
+    s_tls_sample_tags.plan_node_id = plan_node_id;
+}
+
+inline const CurrentThread::SampleTags& CurrentThread::sample_tags() {
+    return s_tls_sample_tags;
+}
+
 inline starrocks::MemTracker* CurrentThread::set_mem_tracker(starrocks::MemTracker* tracker) {
+    mem_flush();
     auto* r = s_tls_mem_tracker;
     s_tls_mem_tracker = tracker;
     return r;
@@ -55,4 +103,18 @@ inline starrocks::MemTracker* CurrentThread::mem_tracker() {
     return s_tls_mem_tracker;
 }
 
+inline void CurrentThread::mem_consume(int64_t bytes) {
+    if (s_tls_mem_tracker == nullptr) {
+        return;
+    }
+    s_tls_mem_cached_bytes += bytes;
+    if (s_tls_mem_cached_bytes >= kMemCacheBytes || s_tls_mem_cached_bytes <= -kMemCacheBytes) {
+        mem_flush();
+    }
+}
+
+inline int64_t CurrentThread::mem_cached_bytes() {
+    return s_tls_mem_cached_bytes;
+}
+
 } // namespace starrocks
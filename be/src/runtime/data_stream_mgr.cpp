@@ -21,6 +21,9 @@
 
 #include "runtime/data_stream_mgr.h"
 
+#include <butil/iobuf.h>
+
+#include <atomic>
 #include <boost/thread/thread.hpp>
 #include <iostream>
 
@@ -128,7 +131,74 @@ Status DataStreamMgr::transmit_data(const PTransmitDataParams* request, ::google
     return Status::OK();
 }
 
-Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done) {
+namespace {
+
+// RefCountedClosure runs |done| once it's run by all of the |num_refs| receivers of a batched rpc.
+class RefCountedClosure final : public ::google::protobuf::Closure {
+public:
+    RefCountedClosure(::google::protobuf::Closure* done, int num_refs) : _done(done), _num_refs(num_refs) {}
+
+    void Run() override {
+        if (_num_refs.fetch_sub(1) == 1) {
+            _done->Run();
+            delete this;
+        }
+    }
+
+private:
+    ::google::protobuf::Closure* _done;
+    std::atomic<int> _num_refs;
+};
+
+} // namespace
+
+Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, butil::IOBuf* attachment,
+                                     ::google::protobuf::Closure** done, PTransmitChunkResult* response) {
+    if (request.batched_requests_size() == 0) {
+        return _transmit_chunk(request, attachment, done, response);
+    }
+
+    // Every request holds a reference until its receiver releases it, and this thread holds one until all the
+    // requests are added, so the response isn't sent before its status is set.
+    const int num_requests = 1 + request.batched_requests_size();
+    ::google::protobuf::Closure* batched_done = nullptr;
+    if (*done != nullptr) {
+        batched_done = new RefCountedClosure(*done, num_requests + 1);
+        *done = nullptr;
+    }
+    Status status;
+    for (int i = 0; i < num_requests; ++i) {
+        const PTransmitChunkParams& sub_request = i == 0 ? request : request.batched_requests(i - 1);
+        // Cut the data of the request off the attachment, even if its receiver doesn't consume it.
+        butil::IOBuf sub_attachment;
+        if (attachment != nullptr) {
+            size_t data_size = 0;
+            for (const auto& pchunk : sub_request.chunks()) {
+                data_size += pchunk.data_size();
+            }
+            attachment->cutn(&sub_attachment, data_size);
+        }
+        ::google::protobuf::Closure* sub_done = batched_done;
+        Status st = _transmit_chunk(sub_request, attachment != nullptr ? &sub_attachment : nullptr, &sub_done,
+                                    response);
+        if (!st.ok() && status.ok()) {
+            status = st;
+        }
+        if (sub_done != nullptr) {
+            sub_done->Run();
+        }
+    }
+    if (batched_done != nullptr) {
+        if (response != nullptr) {
+            status.to_protobuf(response->mutable_status());
+        }
+        batched_done->Run();
+    }
+    return status;
+}
+
+Status DataStreamMgr::_transmit_chunk(const PTransmitChunkParams& request, butil::IOBuf* attachment,
+                                      ::google::protobuf::Closure** done, PTransmitChunkResult* response) {
     const PUniqueId& finst_id = request.finst_id();
     // TODO(zc): Use PUniqueId directly
     // We can use PUniqueId directly, because old version StarRocks has already use
@@ -155,9 +225,26 @@ Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::goog
         recvr->add_sub_plan_statistics(request.query_statistics(), request.sender_id());
     }
 
+    // The response is sent once done is run, which could happen as soon as the chunks are added.
+    if (response != nullptr && recvr->is_unpartitioned()) {
+        response->set_unpartitioned(true);
+    }
+    if (response != nullptr && recvr->is_short_circuited()) {
+        response->set_finished(true);
+    }
+    // The response of the batched requests carries the least credit of their receivers.
+    if (response != nullptr) {
+        int64_t credit_bytes = recvr->sender_credit_bytes();
+        if (!response->has_credit_bytes() || credit_bytes < response->credit_bytes()) {
+            response->set_credit_bytes(credit_bytes);
+        }
+    }
     bool eos = request.eos();
+    if (eos && request.is_broadcast()) {
+        recvr->add_broadcast_sender(request.be_number());
+    }
     if (request.chunks_size() > 0) {
-        RETURN_IF_ERROR(recvr->add_chunks(request, eos ? nullptr : done));
+        RETURN_IF_ERROR(recvr->add_chunks(request, attachment, eos ? nullptr : done));
     }
     if (eos) {
         recvr->remove_sender(request.sender_id(), request.be_number());
@@ -43,6 +43,10 @@ class Closure;
 }
 } // namespace google
 
+namespace butil {
+class IOBuf;
+}
+
 namespace starrocks {
 
 class DescriptorTbl;
@@ -84,13 +88,23 @@ public:
 
     Status transmit_data(const PTransmitDataParams* request, ::google::protobuf::Closure** done);
 
-    Status transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    // |response| is only set before |done| is handed to the receiver, if it's not nullptr.
+    // The batched requests of |request| are transmitted to their receivers too, the response is sent after all of
+    // the receivers release |done|.
+    // The data of the chunks is in |attachment| in order if it's not nullptr, and the chunks are deserialized from
+    // it before this returns.
+    Status transmit_chunk(const PTransmitChunkParams& request, butil::IOBuf* attachment,
+                          ::google::protobuf::Closure** done, PTransmitChunkResult* response = nullptr);
     // Closes all receivers registered for fragment_instance_id immediately.
     void cancel(const TUniqueId& fragment_instance_id);
 
 private:
     friend class DataStreamRecvr;
 
+    // Transmit the chunks of |request| to its receiver, without its batched requests.
+    Status _transmit_chunk(const PTransmitChunkParams& request, butil::IOBuf* attachment,
+                           ::google::protobuf::Closure** done, PTransmitChunkResult* response);
+
     // protects all fields below
     std::mutex _lock;
 
@@ -21,6 +21,7 @@
 
 #include "runtime/data_stream_recvr.h"
 
+#include <butil/iobuf.h>
 #include <google/protobuf/stubs/common.h>
 
 #include <condition_variable>
@@ -78,7 +79,8 @@ public:
     // blocks if this will make the stream exceed its buffer limit.
     // If the total size of the chunks in this queue would exceed the allowed buffer size,
     // the queue is considered full and the call blocks until a chunk is dequeued.
-    Status add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    Status add_chunks(const PTransmitChunkParams& request, butil::IOBuf* attachment,
+                      ::google::protobuf::Closure** done);
 
     // Decrement the number of remaining senders for this queue and signal eos ("new data")
     // if the count drops to 0. The number of senders will be 1 for a merging
@@ -101,7 +103,8 @@ public:
 
 private:
     Status _build_chunk_meta(const ChunkPB& pb_chunk);
-    Status _deserialize_chunk(const ChunkPB& pchunk, vectorized::Chunk* chunk, faststring* uncompressed_buffer);
+    Status _deserialize_chunk(const ChunkPB& pchunk, const Slice& data, vectorized::Chunk* chunk,
+                              faststring* uncompressed_buffer);
 
     // Receiver of which this queue is a member.
     DataStreamRecvr* _recvr;
@@ -360,7 +363,7 @@ Status DataStreamRecvr::SenderQueue::_build_chunk_meta(const ChunkPB& pb_chunk)
     return Status::OK();
 }
 
-Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& request,
+Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& request, butil::IOBuf* attachment,
                                                 ::google::protobuf::Closure** done) {
     DCHECK(request.chunks_size() > 0);
 
@@ -406,10 +409,26 @@ Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& requ
     ChunkQueue chunks;
     size_t total_chunk_bytes = 0;
     faststring uncompressed_buffer;
+    faststring attachment_buffer;
     for (auto& pchunk : request.chunks()) {
-        size_t chunk_bytes = pchunk.data().size();
+        Slice data(pchunk.data());
+        // Holds the blocks of the data in the attachment until the chunk is deserialized, the data is only copied
+        // if it spans several blocks.
+        butil::IOBuf chunk_buf;
+        if (attachment != nullptr) {
+            attachment->cutn(&chunk_buf, pchunk.data_size());
+            if (chunk_buf.backing_block_num() == 1) {
+                butil::StringPiece block = chunk_buf.backing_block(0);
+                data = Slice(block.data(), block.size());
+            } else {
+                attachment_buffer.resize(chunk_buf.size());
+                chunk_buf.copy_to(attachment_buffer.data(), chunk_buf.size());
+                data = Slice(attachment_buffer.data(), attachment_buffer.size());
+            }
+        }
+        size_t chunk_bytes = data.size;
         ChunkUniquePtr chunk = std::make_unique<vectorized::Chunk>();
-        RETURN_IF_ERROR(_deserialize_chunk(pchunk, chunk.get(), &uncompressed_buffer));
+        RETURN_IF_ERROR(_deserialize_chunk(pchunk, data, chunk.get(), &uncompressed_buffer));
 
         // TODO(zc): review this chunk_bytes
         chunks.emplace_back(chunk_bytes, std::move(chunk));
@@ -436,14 +455,15 @@ Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& requ
         _recvr->_num_buffered_bytes += total_chunk_bytes;
     }
     _data_arrival_cv.notify_one();
+    _recvr->_observable.notify_observers();
     return Status::OK();
 }
 
-Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, vectorized::Chunk* chunk,
-                                                        faststring* uncompressed_buffer) {
+Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, const Slice& data,
+                                                        vectorized::Chunk* chunk, faststring* uncompressed_buffer) {
     if (pchunk.compress_type() == CompressionTypePB::NO_COMPRESSION) {
         SCOPED_TIMER(_recvr->_deserialize_row_batch_timer);
-        RETURN_IF_ERROR(chunk->deserialize((const uint8_t*)pchunk.data().data(), pchunk.data().size(), _chunk_meta));
+        RETURN_IF_ERROR(chunk->deserialize((const uint8_t*)data.data, data.size, _chunk_meta));
     } else {
         size_t uncompressed_size = 0;
         {
@@ -453,7 +473,7 @@ Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, v
             uncompressed_size = pchunk.uncompressed_size();
             uncompressed_buffer->resize(uncompressed_size);
             Slice output{uncompressed_buffer->data(), uncompressed_size};
-            RETURN_IF_ERROR(codec->decompress(pchunk.data(), &output));
+            RETURN_IF_ERROR(codec->decompress(data, &output));
         }
         {
             SCOPED_TIMER(_recvr->_deserialize_row_batch_timer);
@@ -464,18 +484,22 @@ Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, v
 }
 
 void DataStreamRecvr::SenderQueue::decrement_senders(int be_number) {
-    std::lock_guard<std::mutex> l(_lock);
-    if (_sender_eos_set.end() != _sender_eos_set.find(be_number)) {
-        return;
-    }
-    _sender_eos_set.insert(be_number);
-    DCHECK_GT(_num_remaining_senders, 0);
-    _num_remaining_senders--;
-    VLOG_FILE << "decremented senders: fragment_instance_id=" << _recvr->fragment_instance_id()
-              << " node_id=" << _recvr->dest_node_id() << " #senders=" << _num_remaining_senders;
-    if (_num_remaining_senders == 0) {
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        if (_sender_eos_set.end() != _sender_eos_set.find(be_number)) {
+            return;
+        }
+        _sender_eos_set.insert(be_number);
+        DCHECK_GT(_num_remaining_senders, 0);
+        _num_remaining_senders--;
+        VLOG_FILE << "decremented senders: fragment_instance_id=" << _recvr->fragment_instance_id()
+                  << " node_id=" << _recvr->dest_node_id() << " #senders=" << _num_remaining_senders;
+        if (_num_remaining_senders != 0) {
+            return;
+        }
         _data_arrival_cv.notify_one();
     }
+    _recvr->_observable.notify_observers();
 }
 
 void DataStreamRecvr::SenderQueue::cancel() {
@@ -491,6 +515,7 @@ void DataStreamRecvr::SenderQueue::cancel() {
     // Wake up all threads waiting to produce/consume batches.  They will all
     // notice that the stream is cancelled and handle it.
     _data_arrival_cv.notify_all();
+    _recvr->_observable.notify_observers();
 
     {
         std::lock_guard<std::mutex> l(_lock);
@@ -572,6 +597,7 @@ DataStreamRecvr::DataStreamRecvr(DataStreamMgr* stream_mgr, MemTracker* parent_t
           _row_desc(row_desc),
           _is_merging(is_merging),
           _num_buffered_bytes(0),
+          _num_senders(num_senders),
           _profile(std::move(profile)),
           _sub_plan_query_statistics_recvr(std::move(sub_plan_query_statistics_recvr)) {
     (void)parent_tracker;
@@ -622,12 +648,13 @@ void DataStreamRecvr::add_batch(const PRowBatch& batch, int sender_id, int be_nu
     _sender_queues[use_sender_id]->add_batch(batch, be_number, packet_seq, done);
 }
 
-Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done) {
+Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, butil::IOBuf* attachment,
+                                   ::google::protobuf::Closure** done) {
     SCOPED_TIMER(_sender_total_timer);
     COUNTER_UPDATE(_request_received_counter, 1);
     int use_sender_id = _is_merging ? request.sender_id() : 0;
     // Add all batches to the same queue if _is_merging is false.
-    return _sender_queues[use_sender_id]->add_chunks(request, done);
+    return _sender_queues[use_sender_id]->add_chunks(request, attachment, done);
 }
 
 void DataStreamRecvr::remove_sender(int sender_id, int be_number) {
@@ -22,9 +22,15 @@
 #ifndef STARROCKS_BE_SRC_RUNTIME_DATA_STREAM_RECVR_H
 #define STARROCKS_BE_SRC_RUNTIME_DATA_STREAM_RECVR_H
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+
 #include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
 #include "common/status.h"
+#include "exec/pipeline/observable.h"
 #include "gen_cpp/Types_types.h" // for TUniqueId
 #include "runtime/descriptors.h"
 #include "runtime/query_statistics.h"
@@ -36,6 +42,10 @@ class Closure;
 }
 } // namespace google
 
+namespace butil {
+class IOBuf;
+}
+
 namespace starrocks {
 
 namespace vectorized {
@@ -120,6 +130,25 @@ public:
 
     bool is_finished() const;
 
+    // The observers are notified when a chunk arrives, a sender finishes or the stream is cancelled,
+    // used by ExchangeSourceOperator to wake up the blocked pipeline driver.
+    void add_observer(pipeline::ReadyObserver observer) { _observable.add_observer(std::move(observer)); }
+
+    // Return true if every sender has broadcast all its rows, i.e, this receiver has received all the rows of
+    // the stream. Only valid after all the senders are done.
+    bool all_senders_broadcast() const {
+        std::lock_guard<std::mutex> l(_broadcast_senders_lock);
+        return _broadcast_senders.size() == _num_senders;
+    }
+    // Tell the senders that the rows needn't be hash partitioned any more, see PTransmitChunkResult.
+    void set_unpartitioned() { _is_unpartitioned = true; }
+    // Tell the senders that no more rows are needed, e.g. the limit of the exchange node has been reached, see
+    // PTransmitChunkResult. The rows arrived since are dropped.
+    void short_circuit() {
+        _is_short_circuited = true;
+        cancel_stream();
+    }
+
 private:
     friend class DataStreamMgr;
     class SenderQueue;
@@ -134,12 +163,28 @@ private:
                    ::google::protobuf::Closure** done);
 
     // If receive queue is full, done is enqueue pending, and return with *done is nullptr
-    Status add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    // The data of the chunks is in |attachment| in order if it's not nullptr, which is consumed then.
+    Status add_chunks(const PTransmitChunkParams& request, butil::IOBuf* attachment,
+                      ::google::protobuf::Closure** done);
 
     // Indicate that a particular sender is done. Delegated to the appropriate
     // sender queue. Called from DataStreamMgr.
     void remove_sender(int sender_id, int be_number);
 
+    // Indicate that a particular sender has broadcast all its rows, called from DataStreamMgr before the sender
+    // is removed.
+    void add_broadcast_sender(int be_number) {
+        std::lock_guard<std::mutex> l(_broadcast_senders_lock);
+        _broadcast_senders.insert(be_number);
+    }
+    bool is_unpartitioned() const { return _is_unpartitioned; }
+    bool is_short_circuited() const { return _is_short_circuited; }
+    // The credit granted to a sender, see PTransmitChunkResult. The senders sharing the buffer left, their
+    // requests in flight stay within the buffer limit, so the memory of a wide fan-in doesn't grow with the senders.
+    int64_t sender_credit_bytes() const {
+        return std::max<int64_t>(_total_buffer_limit - _num_buffered_bytes, 0) / std::max<size_t>(_num_senders, 1);
+    }
+
     // Empties the sender queues and notifies all waiting consumers of cancellation.
     void cancel_stream();
 
@@ -169,6 +214,13 @@ private:
     // total number of bytes held across all sender queues.
     std::atomic<int> _num_buffered_bytes{0};
 
+    const size_t _num_senders;
+    // The be numbers of the senders that have broadcast all their rows.
+    mutable std::mutex _broadcast_senders_lock;
+    std::set<int> _broadcast_senders;
+    std::atomic<bool> _is_unpartitioned{false};
+    std::atomic<bool> _is_short_circuited{false};
+
     // Memtracker for batches in the sender queue(s).
     std::unique_ptr<MemTracker> _mem_tracker;
 
@@ -218,6 +270,8 @@ private:
 
     // Total time spent waiting for data to arrive in the recv buffer
     RuntimeProfile::Counter* _data_arrival_timer;
+
+    pipeline::Observable _observable;
 };
 
 } // end namespace starrocks
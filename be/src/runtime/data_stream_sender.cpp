@@ -28,6 +28,7 @@
 #include <boost/thread/thread.hpp>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
 
 #include "column/chunk.h"
@@ -44,6 +45,7 @@
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "runtime/tuple_row.h"
+#include "service/backend_options.h"
 #include "service/brpc.h"
 #include "util/block_compression.h"
 #include "util/brpc_stub_cache.h"
@@ -140,6 +142,9 @@ public:
 
     int64_t num_data_bytes_sent() const { return _num_data_bytes_sent; }
 
+    // Whether the receiver has told that it needs no more rows.
+    bool receiver_finished() const { return _receiver_finished; }
+
     PRowBatch* pb_batch() { return &_pb_batch; }
 
     std::string get_fragment_instance_id_str() {
@@ -149,6 +154,8 @@ public:
 
     TUniqueId get_fragment_instance_id() { return _fragment_instance_id; }
 
+    const TNetworkAddress& brpc_dest_addr() const { return _brpc_dest_addr; }
+
 private:
     inline Status _wait_last_brpc() {
         auto cntl = &_closure->cntl;
@@ -174,6 +181,15 @@ private:
                          << ", error_text=" << cntl->ErrorText();
             return Status::ThriftRpcError("fail to send batch");
         }
+        if (_parent->_adaptive_partition && _chunk_closure->result.unpartitioned()) {
+            _parent->_is_unpartitioned = true;
+        }
+        if (_chunk_closure->result.finished()) {
+            _receiver_finished = true;
+        }
+        if (_chunk_closure->result.has_credit_bytes()) {
+            _credit_bytes = _chunk_closure->result.credit_bytes();
+        }
         return {_chunk_closure->result.status()};
     }
 
@@ -220,6 +236,8 @@ private:
     RefCountClosure<PTransmitChunkResult>* _chunk_closure = nullptr;
 
     size_t _current_request_bytes = 0;
+    // The request is sent once its bytes exceed the credit granted by the receiver, see PTransmitChunkResult.
+    int64_t _credit_bytes = std::numeric_limits<int64_t>::max();
 
     PBackendService_Stub* _brpc_stub = nullptr;
     RefCountClosure<PTransmitDataResult>* _closure = nullptr;
@@ -229,6 +247,7 @@ private:
     bool _is_transfer_chain;
     bool _send_query_statistics_with_every_batch;
     bool _is_inited = false;
+    bool _receiver_finished = false;
 };
 
 Status DataStreamSender::Channel::init(RuntimeState* state) {
@@ -315,7 +334,8 @@ Status DataStreamSender::Channel::send_one_chunk(const vectorized::Chunk* chunk,
 
     // Try to accumulate enough bytes before sending a RPC. When eos is true we should send
     // last packet
-    if (_current_request_bytes > _parent->_request_bytes_threshold || eos) {
+    const int64_t request_bytes_limit = std::min<int64_t>(_parent->_request_bytes_threshold, _credit_bytes);
+    if (static_cast<int64_t>(_current_request_bytes) > request_bytes_limit || eos) {
         // NOTE: Before we send current request, we must wait last RPC's result to make sure
         // it have finished. Because in some cases, receiver depend the order of sender data.
         // We can add KeepOrder flag in Frontend to tell sender if it can send packet before
@@ -351,6 +371,7 @@ Status DataStreamSender::Channel::_do_send_chunk_rpc(PTransmitChunkParams* reque
     SCOPED_TIMER(_parent->_send_request_timer);
 
     request->set_sequence(_request_seq);
+    request->set_is_broadcast(_parent->_is_broadcast);
     if (_is_transfer_chain && (_send_query_statistics_with_every_batch || request->eos())) {
         auto statistic = request->mutable_query_statistics();
         _parent->_query_statistics->to_pb(statistic);
@@ -521,6 +542,18 @@ DataStreamSender::DataStreamSender(ObjectPool* pool, bool is_vectorized, int sen
         }
     }
     _request_bytes_threshold = config::max_transmit_batched_bytes;
+
+    if (_part_type == TPartitionType::HASH_PARTITIONED) {
+        if (sink.__isset.adaptive_broadcast_bytes && sink.adaptive_broadcast_bytes > 0) {
+            // A single receiver has all the rows anyway.
+            if (_channels.size() == 1) {
+                _is_broadcast = true;
+            } else {
+                _adaptive_broadcast_bytes = sink.adaptive_broadcast_bytes;
+            }
+        }
+        _adaptive_partition = sink.__isset.adaptive_partition && sink.adaptive_partition;
+    }
 }
 
 // We use the PartitionRange to compare here. It should not be a member function of PartitionInfo
@@ -705,12 +738,51 @@ Status DataStreamSender::send(RuntimeState* state, RowBatch* batch) {
 
 Status DataStreamSender::send_chunk(RuntimeState* state, vectorized::Chunk* chunk) {
     SCOPED_TIMER(_profile->total_time_counter());
+    if (chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    if (_adaptive_broadcast_bytes == 0) {
+        return _send_chunk(chunk);
+    }
+
+    _buffered_bytes += chunk->memory_usage();
+    vectorized::ChunkUniquePtr copy = chunk->clone_empty_with_tuple(chunk->num_rows());
+    copy->append(*chunk);
+    _buffered_chunks.emplace_back(std::move(copy));
+    if (_buffered_bytes <= _adaptive_broadcast_bytes) {
+        return Status::OK();
+    }
+    // Too large to broadcast, the rows are hash partitioned as usual.
+    _adaptive_broadcast_bytes = 0;
+    return _send_buffered_chunks();
+}
+
+Status DataStreamSender::_send_buffered_chunks() {
+    for (auto& chunk : _buffered_chunks) {
+        RETURN_IF_ERROR(_send_chunk(chunk.get()));
+    }
+    _buffered_chunks.clear();
+    _buffered_bytes = 0;
+    return Status::OK();
+}
+
+Status DataStreamSender::_send_chunk(vectorized::Chunk* chunk) {
     uint16_t num_rows = chunk->num_rows();
-    if (num_rows == 0) {
+    if (_is_unpartitioned && _part_type == TPartitionType::HASH_PARTITIONED) {
+        if (_unpartitioned_channels.empty()) {
+            _init_unpartitioned_channels();
+        }
+        // Round-robin chunks among the channels, like RANDOM.
+        Channel* channel = _unpartitioned_channels[_current_channel_idx % _unpartitioned_channels.size()];
+        bool real_sent = false;
+        RETURN_IF_ERROR(channel->send_one_chunk(chunk, false, &real_sent));
+        if (real_sent) {
+            _current_channel_idx = (_current_channel_idx + 1) % _unpartitioned_channels.size();
+        }
         return Status::OK();
     }
     // Unpartition or _channel size
-    if (_part_type == TPartitionType::UNPARTITIONED || _channels.size() == 1) {
+    if (_part_type == TPartitionType::UNPARTITIONED || _channels.size() == 1 || _is_broadcast) {
         // We use sender request to avoid serialize chunk many times.
         // 1. create a new chunk PB to serialize
         ChunkPB* pchunk = _chunk_request.add_chunks();
@@ -750,19 +822,11 @@ Status DataStreamSender::send_chunk(RuntimeState* state, vectorized::Chunk* chun
                 DCHECK(_partitions_columns[i] != nullptr);
             }
 
-            if (_part_type == TPartitionType::HASH_PARTITIONED) {
-                _hash_values.assign(num_rows, HashUtil::FNV_SEED);
-                for (const ColumnPtr& column : _partitions_columns) {
-                    column->fvn_hash(&_hash_values[0], 0, num_rows);
-                }
-            } else {
-                // The data distribution was calculated using CRC32_HASH,
-                // and bucket shuffle need to use the same hash function when sending data
-                _hash_values.assign(num_rows, 0);
-                for (const ColumnPtr& column : _partitions_columns) {
-                    column->crc32_hash(&_hash_values[0], 0, num_rows);
-                }
-            }
+            // The data distribution was calculated using CRC32_HASH,
+            // and bucket shuffle need to use the same hash function when sending data
+            auto function = _part_type == TPartitionType::HASH_PARTITIONED ? vectorized::ChunkHashFunction::FNV
+                                                                           : vectorized::ChunkHashFunction::CRC32;
+            chunk->compute_hash_values(function, _partitions_columns, &_hash_values);
 
             // compute row indexes for each channel
             _channel_row_idx_start_points.assign(num_channels + 1, 0);
@@ -803,6 +867,21 @@ Status DataStreamSender::send_chunk(RuntimeState* state, vectorized::Chunk* chun
     return Status::OK();
 }
 
+void DataStreamSender::_init_unpartitioned_channels() {
+    // Prefer the receivers on the same host, whose rows aren't sent through the network.
+    const std::string& localhost = BackendOptions::get_localhost();
+    for (Channel* channel : _channels) {
+        if (channel->brpc_dest_addr().hostname == localhost) {
+            _unpartitioned_channels.push_back(channel);
+        }
+    }
+    if (_unpartitioned_channels.empty()) {
+        _unpartitioned_channels = _channels;
+    }
+    _current_channel_idx = 0;
+    _profile->add_info_string("AdaptivePartition", "unpartitioned");
+}
+
 int DataStreamSender::binary_find_partition(const PartRangeKey& key) const {
     int low = 0;
     int high = _partition_infos.size() - 1;
@@ -903,6 +982,17 @@ Status DataStreamSender::close(RuntimeState* state, Status exec_status) {
     // TODO: only close channels that didn't have any errors
     // make all channels close parallel
 
+    // All the rows of the build side fit in the threshold, so they are broadcast.
+    if (_adaptive_broadcast_bytes > 0) {
+        _adaptive_broadcast_bytes = 0;
+        _is_broadcast = true;
+        _profile->add_info_string("AdaptiveBroadcast", "true");
+        Status st = _send_buffered_chunks();
+        if (!st.ok() && _close_status.ok()) {
+            _close_status = st;
+        }
+    }
+
     // If broadcast is used, _chunk_request may contain some data which should
     // be sent to receiver.
     if (_current_request_bytes > 0) {
@@ -988,7 +1078,7 @@ Status DataStreamSender::serialize_chunk(const vectorized::Chunk* src, ChunkPB*
 
     dst->set_uncompressed_size(uncompressed_size);
     // try compress the ChunkPB data
-    if (_compress_codec != nullptr && uncompressed_size > 0) {
+    if (_compress_codec != nullptr && uncompressed_size > 0 && _compression_sampler.should_compress()) {
         SCOPED_TIMER(_compress_timer);
 
         // Try compressing data to _compression_scratch, swap if compressed data is smaller
@@ -1001,11 +1091,13 @@ Status DataStreamSender::serialize_chunk(const vectorized::Chunk* src, ChunkPB*
         Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
         _compress_codec->compress(dst->data(), &compressed_slice);
         double compress_ratio = (static_cast<double>(uncompressed_size)) / compressed_slice.size;
-        if (LIKELY(compress_ratio > config::rpc_compress_ratio_threshold)) {
+        bool compressible = compress_ratio > config::rpc_compress_ratio_threshold;
+        if (LIKELY(compressible)) {
             _compression_scratch.resize(compressed_slice.size);
             dst->mutable_data()->swap(reinterpret_cast<std::string&>(_compression_scratch));
             dst->set_compress_type(_compress_type);
         }
+        _compression_sampler.update(compressible);
 
         VLOG_ROW << "uncompressed size: " << uncompressed_size << ", compressed size: " << compressed_slice.size;
     }
@@ -1026,6 +1118,11 @@ void DataStreamSender::construct_brpc_attachment(PTransmitChunkParams* params, b
     }
 }
 
+bool DataStreamSender::is_finished() const {
+    return std::all_of(_channels.begin(), _channels.end(),
+                       [](const Channel* channel) { return channel->receiver_finished(); });
+}
+
 int64_t DataStreamSender::get_num_data_bytes_sent() const {
     // TODO: do we need synchronization here or are reads & writes to 8-byte ints
     // atomic?
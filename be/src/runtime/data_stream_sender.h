@@ -26,12 +26,14 @@
 #include <vector>
 
 #include "column/column.h"
+#include "column/vectorized_fwd.h"
 #include "common/global_types.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "exec/data_sink.h"
 #include "gen_cpp/data.pb.h" // for PRowBatch
 #include "gen_cpp/internal_service.pb.h"
+#include "util/compression_sampler.h"
 #include "util/raw_container.h"
 #include "util/runtime_profile.h"
 
@@ -115,6 +117,8 @@ public:
 
     RuntimeProfile* profile() override { return _profile; }
 
+    bool is_finished() const override;
+
     TPartitionType::type get_partition_type() const { return _part_type; }
 
     std::vector<ExprContext*>& get_partition_exprs() { return _partition_expr_ctxs; }
@@ -133,6 +137,10 @@ private:
 
     Status process_distribute(RuntimeState* state, TupleRow* row, const PartitionInfo* part, size_t* hash_val);
 
+    Status _send_chunk(vectorized::Chunk* chunk);
+    Status _send_buffered_chunks();
+    void _init_unpartitioned_channels();
+
     bool _is_vectorized;
 
     // Sender instance id, unique within a fragment.
@@ -170,6 +178,8 @@ private:
     // to (we don't compress directly into the ChunkPB in case the compressed data is
     // longer than the uncompressed data).
     raw::RawString _compression_scratch;
+    // Skip compressing the chunks for a while if the latest ones are not compressible.
+    CompressionSampler _compression_sampler;
     // vector query engine data struct
 
     std::vector<ExprContext*> _partition_expr_ctxs; // compute per-row partition values
@@ -177,6 +187,21 @@ private:
     std::vector<Channel*> _channels;
     std::vector<std::shared_ptr<Channel>> _channel_shared_ptrs;
 
+    // The adaptive broadcast of the build side of a shuffle join, see TDataStreamSink.adaptive_broadcast_bytes.
+    // The input chunks are buffered until they are larger than this, or broadcast at close. It's 0 once the
+    // output is hash partitioned.
+    int64_t _adaptive_broadcast_bytes = 0;
+    int64_t _buffered_bytes = 0;
+    std::vector<vectorized::ChunkUniquePtr> _buffered_chunks;
+    // If true, all the rows of this sender are broadcast, see PTransmitChunkParams.is_broadcast.
+    bool _is_broadcast = false;
+    // The adaptive partition of the probe side of a shuffle join, see TDataStreamSink.adaptive_partition.
+    bool _adaptive_partition = false;
+    // Set once a receiver reports that the rows needn't be hash partitioned, the chunks are sent to
+    // _unpartitioned_channels round robin after that.
+    bool _is_unpartitioned = false;
+    std::vector<Channel*> _unpartitioned_channels;
+
     // map from range value to partition_id
     // sorted in ascending orderi by range for binary search
     std::vector<PartitionInfo*> _partition_infos;
@@ -174,6 +174,16 @@ std::string DateValue::to_string() const {
     return date::to_string(_julian);
 }
 
+int DateValue::to_string(char* s, size_t n) const {
+    if (n < static_cast<size_t>(max_string_length())) {
+        return -1;
+    }
+    int year, month, day;
+    date::to_date_with_cache(_julian, &year, &month, &day);
+    date::to_string(year, month, day, s);
+    return max_string_length();
+}
+
 DateValue::operator TimestampValue() const {
     return TimestampValue{date::to_timestamp(_julian)};
 }
@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/descriptor_tbl_cache.h"
+
+#include "common/object_pool.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "util/thrift_util.h"
+
+namespace starrocks {
+
+namespace {
+// A cached table and the objects of its descriptors.
+struct CachedDescriptorTbl {
+    ObjectPool pool;
+    DescriptorTbl* tbl = nullptr;
+};
+} // namespace
+
+DescriptorTblCache* DescriptorTblCache::_s_instance = nullptr;
+
+void DescriptorTblCache::create_global_cache(size_t capacity) {
+    if (_s_instance == nullptr && capacity > 0) {
+        _s_instance = new DescriptorTblCache(capacity);
+    }
+}
+
+void DescriptorTblCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+Status DescriptorTblCache::create(RuntimeState* state, const TDescriptorTable& thrift_tbl, DescriptorTbl** tbl) {
+    if (_s_instance == nullptr) {
+        RETURN_IF_ERROR(DescriptorTbl::create(state->obj_pool(), thrift_tbl, tbl));
+        state->set_desc_tbl(*tbl);
+        return Status::OK();
+    }
+    std::shared_ptr<DescriptorTbl> shared_tbl;
+    RETURN_IF_ERROR(_s_instance->get(thrift_tbl, &shared_tbl));
+    *tbl = shared_tbl.get();
+    state->set_desc_tbl(std::move(shared_tbl));
+    return Status::OK();
+}
+
+DescriptorTblCache::DescriptorTblCache(size_t capacity) : _cache(new_lru_cache(capacity)) {}
+
+Status DescriptorTblCache::get(const TDescriptorTable& thrift_tbl, std::shared_ptr<DescriptorTbl>* tbl) {
+    std::string key;
+    ThriftSerializer serializer(false, 4096);
+    RETURN_IF_ERROR(serializer.serialize(const_cast<TDescriptorTable*>(&thrift_tbl), &key));
+
+    auto* handle = _cache->lookup(key);
+    if (handle != nullptr) {
+        // the table is kept alive by the returned pointer, so the cache entry could be released at once.
+        *tbl = *reinterpret_cast<std::shared_ptr<DescriptorTbl>*>(_cache->value(handle));
+        _cache->release(handle);
+        return Status::OK();
+    }
+
+    auto cached = std::make_shared<CachedDescriptorTbl>();
+    RETURN_IF_ERROR(DescriptorTbl::create(&cached->pool, thrift_tbl, &cached->tbl));
+    // shares the ownership of the pool of the descriptors.
+    *tbl = std::shared_ptr<DescriptorTbl>(cached, cached->tbl);
+    auto deleter = [](const starrocks::CacheKey& key, void* value) {
+        delete reinterpret_cast<std::shared_ptr<DescriptorTbl>*>(value);
+    };
+    // The descriptors take roughly as much memory as their thrift table.
+    _cache->release(_cache->insert(key, new std::shared_ptr<DescriptorTbl>(*tbl), key.size(), deleter));
+    return Status::OK();
+}
+
+} // namespace starrocks
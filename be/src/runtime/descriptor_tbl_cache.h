@@ -0,0 +1,51 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+
+#include "common/status.h"
+#include "storage/lru_cache.h"
+
+namespace starrocks {
+
+class DescriptorTbl;
+class RuntimeState;
+class TDescriptorTable;
+
+// DescriptorTblCache caches the descriptor tables created from the thrift ones, shared by all the fragment
+// instances, so the repeated identical plan fragments, e.g. the ones of the point queries at a high QPS, don't
+// build the tuple and slot descriptors from scratch every time. A table is identified by its serialized thrift
+// table, so it only hits the identical ones, and it's immutable once created, the in-use tables are pinned by
+// their shared pointers. The plan nodes and the expressions are still created per fragment instance, since they
+// hold the state of the instance.
+//
+// This class is thread-safe.
+class DescriptorTblCache {
+public:
+    // Create global instance of this class, do nothing if |capacity| is 0.
+    static void create_global_cache(size_t capacity);
+
+    static void release_global_cache();
+
+    // Return global instance, nullptr if the cache is disabled.
+    static DescriptorTblCache* instance() { return _s_instance; }
+
+    // Create the descriptor table of |state| from |thrift_tbl|, taken from the global cache if it's enabled,
+    // otherwise in the object pool of |state|.
+    static Status create(RuntimeState* state, const TDescriptorTable& thrift_tbl, DescriptorTbl** tbl);
+
+    explicit DescriptorTblCache(size_t capacity);
+
+    // Return the cached table of |thrift_tbl|, or create it and cache it.
+    Status get(const TDescriptorTable& thrift_tbl, std::shared_ptr<DescriptorTbl>* tbl);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+private:
+    static DescriptorTblCache* _s_instance;
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace starrocks
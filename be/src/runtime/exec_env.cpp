@@ -25,6 +25,9 @@
 
 #include "common/config.h"
 #include "common/logging.h"
+#include "env/block_cache.h"
+#include "exec/vectorized/file_meta_cache.h"
+#include "exec/vectorized/query_cache.h"
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/FrontendService.h"
 #include "gen_cpp/HeartbeatService_types.h"
@@ -35,6 +38,7 @@
 #include "runtime/bufferpool/reservation_tracker.h"
 #include "runtime/client_cache.h"
 #include "runtime/data_stream_mgr.h"
+#include "runtime/descriptor_tbl_cache.h"
 #include "runtime/disk_io_mgr.h"
 #include "runtime/external_scan_context_mgr.h"
 #include "runtime/fragment_mgr.h"
@@ -49,9 +53,12 @@
 #include "runtime/small_file_mgr.h"
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_executor.h"
+#include "runtime/stream_load/stream_load_group_commit_mgr.h"
 #include "runtime/thread_resource_mgr.h"
 #include "runtime/tmp_file_mgr.h"
 #include "storage/page_cache.h"
+#include "storage/rowset/segment_v2/segment_cache.h"
+#include "storage/rowset/vectorized/delete_bitmap_cache.h"
 #include "storage/storage_engine.h"
 #include "storage/update_manager.h"
 #include "util/bfd_parser.h"
@@ -63,6 +70,7 @@
 #include "util/parse_util.h"
 #include "util/pretty_printer.h"
 #include "util/priority_thread_pool.hpp"
+#include "util/work_stealing_priority_thread_pool.h"
 #include "util/starrocks_metrics.h"
 namespace starrocks {
 
@@ -92,23 +100,27 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _frontend_client_cache = new FrontendServiceClientCache(config::max_client_cache_size_per_host);
     _broker_client_cache = new BrokerServiceClientCache(config::max_client_cache_size_per_host);
     _thread_mgr = new ThreadResourceMgr();
-    _thread_pool = new PriorityThreadPool(config::doris_scanner_thread_pool_thread_num,
-                                          config::doris_scanner_thread_pool_queue_size);
-    _pipeline_io_thread_pool = new PriorityThreadPool(4, config::doris_scanner_thread_pool_queue_size);
+    _thread_pool = new WorkStealingPriorityThreadPool(config::doris_scanner_thread_pool_thread_num,
+                                                      config::doris_scanner_thread_pool_queue_size);
+    _pipeline_io_thread_pool = new WorkStealingPriorityThreadPool(4, config::doris_scanner_thread_pool_queue_size);
+    _hdfs_io_thread_pool = new PriorityThreadPool(config::hdfs_io_thread_pool_thread_num,
+                                                  config::doris_scanner_thread_pool_queue_size);
     _num_scan_operators = 0;
     _etl_thread_pool = new PriorityThreadPool(config::etl_thread_pool_size, config::etl_thread_pool_queue_size);
     _fragment_mgr = new FragmentMgr(this);
 
     std::unique_ptr<ThreadPool> driver_dispatcher_thread_pool;
-    // auto thread_num_max = std::thread::hardware_concurrency();
-    auto max_thread_num = 3;
+    int max_thread_num = config::pipeline_exec_thread_pool_thread_num;
+    if (max_thread_num <= 0) {
+        max_thread_num = std::thread::hardware_concurrency();
+    }
     RETURN_IF_ERROR(ThreadPoolBuilder("driver_dispatcher_thread_pool")
                             .set_min_threads(0)
                             .set_max_threads(max_thread_num)
                             .set_max_queue_size(1000)
                             .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
                             .build(&driver_dispatcher_thread_pool));
-    _driver_dispatcher = new pipeline::GlobalDriverDispatcher(std::move(driver_dispatcher_thread_pool));
+    _driver_dispatcher = new pipeline::GlobalDriverDispatcher(std::move(driver_dispatcher_thread_pool), max_thread_num);
     _driver_dispatcher->initialize(max_thread_num);
 
     _master_info = new TMasterInfo();
@@ -120,6 +132,7 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _load_stream_mgr = new LoadStreamMgr();
     _brpc_stub_cache = new BrpcStubCache();
     _stream_load_executor = new StreamLoadExecutor(this);
+    _stream_load_group_commit_mgr = new StreamLoadGroupCommitMgr(this);
     _routine_load_task_executor = new RoutineLoadTaskExecutor(this);
     _small_file_mgr = new SmallFileMgr(this, config::small_file_dir);
     _plugin_mgr = new PluginMgr();
@@ -225,7 +238,20 @@ Status ExecEnv::_init_mem_tracker() {
         LOG(WARNING) << "Config storage_page_cache_limit is greater than memory size, config="
                      << config::storage_page_cache_limit << ", memory=" << MemInfo::physical_mem();
     }
-    StoragePageCache::create_global_cache(_page_cache_mem_tracker, storage_cache_limit);
+    int64_t decoded_cache_limit = ParseUtil::parse_mem_spec(config::storage_decoded_page_cache_limit, &is_percent);
+    StoragePageCache::create_global_cache(_page_cache_mem_tracker, storage_cache_limit,
+                                          config::storage_page_cache_index_percent,
+                                          config::storage_page_cache_protected_percent,
+                                          std::max<int64_t>(0, decoded_cache_limit),
+                                          config::storage_page_cache_use_clock);
+    RETURN_IF_ERROR(BlockCache::create_global_cache(config::block_cache_dir, config::block_cache_capacity,
+                                                    config::block_cache_block_size));
+    vectorized::FileMetaCache::create_global_cache(std::max<int64_t>(0, config::file_meta_cache_capacity));
+    vectorized::QueryCache::create_global_cache(std::max<int64_t>(0, config::query_cache_capacity));
+    DescriptorTblCache::create_global_cache(std::max<int64_t>(0, config::descriptor_tbl_cache_capacity));
+    segment_v2::SegmentCache::create_global_cache(_tablet_meta_mem_tracker,
+                                                  std::max<int64_t>(0, config::segment_cache_capacity));
+    vectorized::DeleteBitmapCache::create_global_cache(std::max<int64_t>(0, config::delete_bitmap_cache_capacity));
 
     // TODO(zc): The current memory usage configuration is a bit confusing,
     // we need to sort out the use of memory
@@ -253,6 +279,7 @@ void ExecEnv::_destory() {
     delete _driver_dispatcher;
     delete _fragment_mgr;
     delete _etl_thread_pool;
+    delete _hdfs_io_thread_pool;
     delete _thread_pool;
     delete _thread_mgr;
     delete _update_mem_tracker;
@@ -273,6 +300,7 @@ void ExecEnv::_destory() {
     delete _result_mgr;
     delete _result_queue_mgr;
     delete _stream_mgr;
+    delete _stream_load_group_commit_mgr;
     delete _stream_load_executor;
     delete _routine_load_task_executor;
     delete _external_scan_context_mgr;
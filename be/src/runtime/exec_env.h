@@ -48,6 +48,7 @@ class MetricRegistry;
 class StorageEngine;
 class ThreadPool;
 class PriorityThreadPool;
+class WorkStealingPriorityThreadPool;
 class ReservationTracker;
 class ResultBufferMgr;
 class ResultQueueMgr;
@@ -58,6 +59,7 @@ class ThreadResourceMgr;
 class TmpFileMgr;
 class WebPageHandler;
 class StreamLoadExecutor;
+class StreamLoadGroupCommitMgr;
 class RoutineLoadTaskExecutor;
 class SmallFileMgr;
 class FileBlockManager;
@@ -126,8 +128,9 @@ public:
     MemTracker* update_mem_tracker() { return _update_mem_tracker; }
 
     ThreadResourceMgr* thread_mgr() { return _thread_mgr; }
-    PriorityThreadPool* thread_pool() { return _thread_pool; }
-    PriorityThreadPool* pipeline_io_thread_pool() { return _pipeline_io_thread_pool; }
+    WorkStealingPriorityThreadPool* thread_pool() { return _thread_pool; }
+    WorkStealingPriorityThreadPool* pipeline_io_thread_pool() { return _pipeline_io_thread_pool; }
+    PriorityThreadPool* hdfs_io_thread_pool() { return _hdfs_io_thread_pool; }
     size_t increment_num_scan_operators(size_t n) { return _num_scan_operators.fetch_add(n); }
     size_t decrement_num_scan_operators(size_t n) { return _num_scan_operators.fetch_sub(n); }
     PriorityThreadPool* etl_thread_pool() { return _etl_thread_pool; }
@@ -152,6 +155,7 @@ public:
     void set_storage_engine(StorageEngine* storage_engine);
 
     StreamLoadExecutor* stream_load_executor() { return _stream_load_executor; }
+    StreamLoadGroupCommitMgr* stream_load_group_commit_mgr() { return _stream_load_group_commit_mgr; }
     RoutineLoadTaskExecutor* routine_load_task_executor() { return _routine_load_task_executor; }
     HeartbeatFlags* heartbeat_flags() { return _heartbeat_flags; }
 
@@ -213,8 +217,9 @@ private:
     MemTracker* _update_mem_tracker = nullptr;
 
     ThreadResourceMgr* _thread_mgr = nullptr;
-    PriorityThreadPool* _thread_pool = nullptr;
-    PriorityThreadPool* _pipeline_io_thread_pool = nullptr;
+    WorkStealingPriorityThreadPool* _thread_pool = nullptr;
+    WorkStealingPriorityThreadPool* _pipeline_io_thread_pool = nullptr;
+    PriorityThreadPool* _hdfs_io_thread_pool = nullptr;
     std::atomic<size_t> _num_scan_operators;
     PriorityThreadPool* _etl_thread_pool = nullptr;
     FragmentMgr* _fragment_mgr = nullptr;
@@ -236,6 +241,7 @@ private:
     StorageEngine* _storage_engine = nullptr;
 
     StreamLoadExecutor* _stream_load_executor = nullptr;
+    StreamLoadGroupCommitMgr* _stream_load_group_commit_mgr = nullptr;
     RoutineLoadTaskExecutor* _routine_load_task_executor = nullptr;
     SmallFileMgr* _small_file_mgr = nullptr;
     HeartbeatFlags* _heartbeat_flags = nullptr;
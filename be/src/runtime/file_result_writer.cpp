@@ -21,6 +21,7 @@
 
 #include "runtime/file_result_writer.h"
 
+#include "column/chunk.h"
 #include "exec/broker_writer.h"
 #include "exec/local_file_writer.h"
 #include "exec/parquet_writer.h"
@@ -80,6 +81,7 @@ Status FileResultWriter::_create_file_writer() {
         break;
     case TFileFormatType::FORMAT_PARQUET:
         _parquet_writer = new ParquetWriterWrapper(_file_writer, _output_expr_ctxs);
+        RETURN_IF_ERROR(_parquet_writer->init());
         break;
     default:
         return Status::InternalError(strings::Substitute("unsupport file format: $0", _file_opts->file_format));
@@ -124,6 +126,21 @@ Status FileResultWriter::append_row_batch(const RowBatch* batch) {
 }
 
 Status FileResultWriter::append_chunk(vectorized::Chunk* chunk) {
+    if (nullptr == chunk || 0 == chunk->num_rows()) {
+        return Status::OK();
+    }
+
+    SCOPED_TIMER(_append_row_batch_timer);
+    if (_parquet_writer != nullptr) {
+        {
+            SCOPED_TIMER(_convert_tuple_timer);
+            RETURN_IF_ERROR(_parquet_writer->write(chunk));
+        }
+        _current_written_bytes = _parquet_writer->written_len();
+        RETURN_IF_ERROR(_create_new_file_if_exceed_size());
+    }
+
+    _written_rows += chunk->num_rows();
     return Status::OK();
 }
 
@@ -293,12 +310,12 @@ Status FileResultWriter::_create_new_file_if_exceed_size() {
 
 Status FileResultWriter::_close_file_writer(bool done) {
     if (_parquet_writer != nullptr) {
-        _parquet_writer->close();
+        Status st = _parquet_writer->close();
         delete _parquet_writer;
         _parquet_writer = nullptr;
-        if (!done) {
-            //TODO(cmy): implement parquet writer later
-        }
+        // the file writer is owned and deleted by the parquet writer
+        _file_writer = nullptr;
+        RETURN_IF_ERROR(st);
     } else if (_file_writer != nullptr) {
         _file_writer->close();
         delete _file_writer;
@@ -243,7 +243,7 @@ void FragmentExecState::coordinator_callback(const Status& status, RuntimeProfil
         if (runtime_state->query_options().query_type == TQueryType::LOAD) {
             params.__set_loaded_rows(runtime_state->num_rows_load_total());
         }
-        profile->to_thrift(&params.profile);
+        profile->to_thrift_changed(&params.profile);
         params.__isset.profile = true;
 
         if (!runtime_state->output_files().empty()) {
@@ -0,0 +1,85 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/hdfs/hdfs_file_cache.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "gutil/strings/substitute.h"
+#include "util/hdfs_util.h"
+
+namespace starrocks {
+
+std::string HdfsFileCache::_key(const std::string& path, int64_t mtime) {
+    return strings::Substitute("$0@$1", path, mtime);
+}
+
+Status HdfsFileCache::open(hdfsFS fs, const std::string& path, int64_t mtime, hdfsFile* file) {
+    if (mtime >= 0) {
+        IdleFileList evicted;
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            _evict(&evicted);
+            auto it = _index.find(_key(path, mtime));
+            if (it != _index.end()) {
+                *file = it->second->file;
+                _idle_files.erase(it->second);
+                _index.erase(it);
+            } else {
+                *file = nullptr;
+            }
+        }
+        for (auto& idle : evicted) {
+            hdfsCloseFile(idle.fs, idle.file);
+        }
+        if (*file != nullptr) {
+            return Status::OK();
+        }
+    }
+
+    *file = hdfsOpenFile(fs, path.c_str(), O_RDONLY, 0, 0, 0);
+    if (*file == nullptr) {
+        return Status::InternalError(
+                strings::Substitute("open file failed, file=$0, err=$1", path, get_hdfs_err_msg()));
+    }
+    return Status::OK();
+}
+
+void HdfsFileCache::release(hdfsFS fs, const std::string& path, int64_t mtime, hdfsFile file) {
+    if (mtime < 0 || config::hdfs_file_cache_capacity <= 0) {
+        hdfsCloseFile(fs, file);
+        return;
+    }
+    // the read statistics of the following scans start from zero.
+    hdfsFileClearReadStatistics(file);
+    IdleFileList evicted;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        auto key = _key(path, mtime);
+        _idle_files.push_back(IdleFile{key, fs, file, Clock::now()});
+        _index.emplace(std::move(key), std::prev(_idle_files.end()));
+        _evict(&evicted);
+    }
+    for (auto& idle : evicted) {
+        hdfsCloseFile(idle.fs, idle.file);
+    }
+}
+
+void HdfsFileCache::_evict(IdleFileList* evicted) {
+    const auto capacity = static_cast<size_t>(std::max<int64_t>(0, config::hdfs_file_cache_capacity));
+    const auto expire_time = Clock::now() - std::chrono::seconds(config::hdfs_file_cache_idle_seconds);
+    while (!_idle_files.empty() &&
+           (_idle_files.size() > capacity || _idle_files.front().release_time < expire_time)) {
+        auto it = _idle_files.begin();
+        auto range = _index.equal_range(it->key);
+        for (auto index_it = range.first; index_it != range.second; ++index_it) {
+            if (index_it->second == it) {
+                _index.erase(index_it);
+                break;
+            }
+        }
+        evicted->splice(evicted->end(), _idle_files, it);
+    }
+}
+
+} // namespace starrocks
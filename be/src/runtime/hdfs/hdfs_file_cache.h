@@ -0,0 +1,67 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <hdfs/hdfs.h>
+
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/status.h"
+#include "gutil/macros.h"
+
+namespace starrocks {
+
+// Pool of the open handles of HDFS files, so that the scans of the same file, e.g. by the scan ranges of
+// different queries, don't pay the namenode round trips of opening it, and of fetching its block locations,
+// every time.
+//
+// A handle is used by one caller at a time: open() takes an idle handle of the file if any, and release()
+// puts it back into the pool for the following opens. The idle handles are keyed by the path and the
+// modification time of the file, so a modified file is never read through a stale handle, and they are
+// closed once they have been idle for config::hdfs_file_cache_idle_seconds, or the least recently released
+// ones beyond config::hdfs_file_cache_capacity. The files whose modification time is unknown (negative)
+// are not pooled.
+class HdfsFileCache {
+public:
+    static HdfsFileCache* instance() {
+        static HdfsFileCache s_instance;
+        return &s_instance;
+    }
+
+    // This function is thread-safe
+    Status open(hdfsFS fs, const std::string& path, int64_t mtime, hdfsFile* file);
+
+    // Give back |file| returned by open() with the same |fs|, |path| and |mtime|.
+    // This function is thread-safe
+    void release(hdfsFS fs, const std::string& path, int64_t mtime, hdfsFile file);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct IdleFile {
+        std::string key;
+        hdfsFS fs;
+        hdfsFile file;
+        Clock::time_point release_time;
+    };
+    using IdleFileList = std::list<IdleFile>;
+
+    // Move the idle files to evict from the pool into |evicted|. Must be called with |_lock| held.
+    void _evict(IdleFileList* evicted);
+
+    static std::string _key(const std::string& path, int64_t mtime);
+
+    std::mutex _lock;
+    // the idle files, the least recently released first.
+    IdleFileList _idle_files;
+    std::unordered_multimap<std::string, IdleFileList::iterator> _index;
+
+    HdfsFileCache() {}
+    DISALLOW_COPY_AND_ASSIGN(HdfsFileCache);
+};
+
+} // namespace starrocks
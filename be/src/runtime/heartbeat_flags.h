@@ -37,6 +37,10 @@ public:
 
     void update(uint64_t flags) { _flags = flags; }
 
+    bool is_support_incremental_tablet_report() const {
+        return _flags & g_HeartbeatService_constants.IS_SUPPORT_INCREMENTAL_TABLET_REPORT_BIT;
+    }
+
 private:
     std::atomic<uint64_t> _flags;
 };
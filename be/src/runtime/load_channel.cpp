@@ -153,6 +153,21 @@ Status LoadChannel::add_chunk(const PTabletWriterAddChunkRequest& request,
     return st;
 }
 
+Status LoadChannel::add_rowset(const PTabletWriterAddRowsetRequest& request) {
+    std::shared_ptr<TabletsChannel> channel;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        auto it = _tablets_channels.find(request.index_id());
+        if (it == _tablets_channels.end()) {
+            std::stringstream ss;
+            ss << "load channel " << _load_id << " add rowset with unknown index id: " << request.index_id();
+            return Status::InternalError(ss.str());
+        }
+        channel = it->second;
+    }
+    return channel->add_rowset(request);
+}
+
 void LoadChannel::_handle_mem_exceed_limit() {
     // lock so that only one thread can check mem limit
     std::lock_guard<std::mutex> l(_lock);
@@ -230,6 +245,13 @@ bool LoadChannel::_find_largest_consumption_channel(std::shared_ptr<TabletsChann
     return max_consume > 0;
 }
 
+void LoadChannel::get_tablets_channels(std::vector<std::shared_ptr<TabletsChannel>>* tablets_channels) {
+    std::lock_guard<std::mutex> l(_lock);
+    for (auto& it : _tablets_channels) {
+        tablets_channels->push_back(it.second);
+    }
+}
+
 bool LoadChannel::is_finished() {
     if (!_opened) {
         return false;
@@ -65,6 +65,8 @@ public:
     Status add_chunk(const PTabletWriterAddChunkRequest& request,
                      google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec);
 
+    Status add_rowset(const PTabletWriterAddRowsetRequest& request);
+
     // return true if this load channel has been opened and all tablets channels are closed then.
     bool is_finished();
 
@@ -79,6 +81,9 @@ public:
                                 std::shared_ptr<TabletsChannel>* tablets_channel, int64_t* tablet_id,
                                 int64_t* tablet_mem_consumption);
 
+    // Append the opened tablets channels of this load to |tablets_channels|.
+    void get_tablets_channels(std::vector<std::shared_ptr<TabletsChannel>>* tablets_channels);
+
     int64_t mem_consumption() const { return _mem_tracker->consumption(); }
     bool mem_limit_exceeded() const { return _mem_tracker->limit_exceeded(); }
 
@@ -21,6 +21,7 @@
 
 #include "runtime/load_channel_mgr.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "gutil/strings/substitute.h"
@@ -200,6 +201,7 @@ void LoadChannelMgr::_handle_mem_exceed_limit(const std::shared_ptr<LoadChannel>
     // lock so that only one thread can check mem limit
     std::lock_guard<std::mutex> l(_lock);
     if (!_mem_tracker->any_limit_exceeded()) {
+        _reduce_mem_usage_to_soft_limit();
         return;
     }
 
@@ -248,6 +250,65 @@ void LoadChannelMgr::_handle_mem_exceed_limit(const std::shared_ptr<LoadChannel>
               << ", current mem consumption=" << _mem_tracker->consumption() << ", limit=" << _mem_tracker->limit();
 }
 
+void LoadChannelMgr::_reduce_mem_usage_to_soft_limit() {
+    const int64_t limit = _mem_tracker->limit();
+    if (limit <= 0) {
+        return;
+    }
+    const int64_t soft_limit = limit / 100 * config::load_process_soft_mem_limit_percent;
+    const int64_t consumption = _mem_tracker->consumption();
+    if (consumption <= soft_limit) {
+        return;
+    }
+
+    struct FlushCandidate {
+        std::shared_ptr<TabletsChannel> tablets_channel;
+        int64_t tablet_id;
+        int64_t memtable_consumption;
+    };
+    std::vector<FlushCandidate> candidates;
+    // The memtables being flushed are released soon, so they are not flushed again.
+    int64_t flushing_consumption = 0;
+    std::vector<std::shared_ptr<TabletsChannel>> tablets_channels;
+    std::vector<TabletMemUsage> usages;
+    for (auto& kv : _load_channels) {
+        kv.second->get_tablets_channels(&tablets_channels);
+    }
+    for (auto& tablets_channel : tablets_channels) {
+        usages.clear();
+        tablets_channel->get_tablet_mem_usages(&usages);
+        for (const TabletMemUsage& usage : usages) {
+            flushing_consumption += usage.flushing_consumption;
+            if (usage.memtable_consumption > 0) {
+                candidates.push_back({tablets_channel, usage.tablet_id, usage.memtable_consumption});
+            }
+        }
+    }
+    int64_t exceeded_mem = consumption - flushing_consumption - soft_limit;
+    if (exceeded_mem <= 0) {
+        return;
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const FlushCandidate& lhs, const FlushCandidate& rhs) {
+        return lhs.memtable_consumption > rhs.memtable_consumption;
+    });
+    size_t num_flushed = 0;
+    for (const FlushCandidate& candidate : candidates) {
+        if (exceeded_mem <= 0) {
+            break;
+        }
+        Status st = candidate.tablets_channel->flush_tablet_async(candidate.tablet_id);
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to flush tablet " << candidate.tablet_id << " to reduce memory. err=" << st;
+            continue;
+        }
+        exceeded_mem -= candidate.memtable_consumption;
+        num_flushed++;
+    }
+    VLOG(1) << "Flush " << num_flushed << " memtables because total load mem consumption=" << consumption
+            << " has exceeded soft limit=" << soft_limit << ", flushing mem consumption=" << flushing_consumption;
+}
+
 bool LoadChannelMgr::_find_candidate_load_channel(const std::shared_ptr<LoadChannel>& data_channel,
                                                   std::shared_ptr<LoadChannel>* candidate_channel) {
     // 1. select the load channel that consume this batch data if limit exceeded.
@@ -285,6 +346,21 @@ bool LoadChannelMgr::_find_candidate_load_channel(const std::shared_ptr<LoadChan
     return false;
 }
 
+Status LoadChannelMgr::add_rowset(const PTabletWriterAddRowsetRequest& request) {
+    UniqueId load_id(request.id());
+    std::shared_ptr<LoadChannel> channel;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        auto it = _load_channels.find(load_id);
+        if (it == _load_channels.end()) {
+            return Status::InternalError(
+                    strings::Substitute("fail to add rowset in load channel. unknown load_id=$0", load_id.to_string()));
+        }
+        channel = it->second;
+    }
+    return channel->add_rowset(request);
+}
+
 Status LoadChannelMgr::cancel(const PTabletWriterCancelRequest& params) {
     UniqueId load_id(params.id());
     std::shared_ptr<LoadChannel> cancelled_channel;
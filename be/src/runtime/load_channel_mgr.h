@@ -57,6 +57,9 @@ public:
     Status add_chunk(const PTabletWriterAddChunkRequest& request,
                      google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec, int64_t* wait_lock_time_ns);
 
+    // replicate the rowset of the primary replica to the secondary replica of this BE
+    Status add_rowset(const PTabletWriterAddRowsetRequest& request);
+
     // cancel all tablet stream for 'load_id' load
     Status cancel(const PTabletWriterCancelRequest& request);
 
@@ -72,6 +75,10 @@ private:
     bool _find_candidate_load_channel(const std::shared_ptr<LoadChannel>& data_channel,
                                       std::shared_ptr<LoadChannel>* candidate_channel);
 
+    // Once the total load mem consumption exceeds the soft limit, flush the largest memtables of all the load
+    // channels asynchronously until the memory not being flushed is below it. |_lock| must be held.
+    void _reduce_mem_usage_to_soft_limit();
+
     Status _start_bg_worker();
 
     // lock protect the load channel map
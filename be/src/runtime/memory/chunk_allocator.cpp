@@ -25,6 +25,7 @@
 #include <list>
 #include <mutex>
 
+#include "common/config.h"
 #include "gutil/dynamic_annotations.h"
 #include "runtime/memory/chunk.h"
 #include "runtime/memory/system_allocator.h"
@@ -40,11 +41,22 @@ ChunkAllocator* ChunkAllocator::_s_instance = nullptr;
 
 static IntCounter local_core_alloc_count(MetricUnit::NOUNIT);
 static IntCounter other_core_alloc_count(MetricUnit::NOUNIT);
+static IntCounter other_node_alloc_count(MetricUnit::NOUNIT);
 static IntCounter system_alloc_count(MetricUnit::NOUNIT);
 static IntCounter system_free_count(MetricUnit::NOUNIT);
 static IntCounter system_alloc_cost_ns(MetricUnit::NANOSECONDS);
 static IntCounter system_free_cost_ns(MetricUnit::NANOSECONDS);
 
+// The metrics of the chunks on a NUMA node.
+struct NumaNodeMetrics {
+    // the bytes of the free chunks cached by the arenas of the node
+    IntGauge reserved_bytes{MetricUnit::BYTES};
+    // the allocations served by the free chunks of the node
+    IntCounter reuse_count{MetricUnit::NOUNIT};
+    // the allocations of the node served by system
+    IntCounter system_alloc_count{MetricUnit::NOUNIT};
+};
+
 #ifdef BE_TEST
 static std::mutex s_mutex;
 ChunkAllocator* ChunkAllocator::instance() {
@@ -114,39 +126,80 @@ void ChunkAllocator::init_instance(size_t reserve_limit) {
 
     REGISTER_METIRC(local_core_alloc_count);
     REGISTER_METIRC(other_core_alloc_count);
+    REGISTER_METIRC(other_node_alloc_count);
     REGISTER_METIRC(system_alloc_count);
     REGISTER_METIRC(system_free_count);
     REGISTER_METIRC(system_alloc_cost_ns);
     REGISTER_METIRC(system_free_cost_ns);
+
+    for (int node = 0; node < _s_instance->_node_metrics.size(); ++node) {
+        NumaNodeMetrics* metrics = _s_instance->_node_metrics[node].get();
+        MetricLabels labels;
+        labels.add("node", std::to_string(node));
+        auto* registry = StarRocksMetrics::instance()->metrics();
+        registry->register_metric("chunk_pool_node_reserved_bytes", labels, &metrics->reserved_bytes);
+        registry->register_metric("chunk_pool_node_reuse_count", labels, &metrics->reuse_count);
+        registry->register_metric("chunk_pool_node_system_alloc_count", labels, &metrics->system_alloc_count);
+    }
 }
 
 ChunkAllocator::ChunkAllocator(size_t reserve_limit)
-        : _reserve_bytes_limit(reserve_limit), _reserved_bytes(0), _arenas(CpuInfo::get_max_num_cores()) {
+        : _reserve_bytes_limit(reserve_limit),
+          _reserved_bytes(0),
+          _arenas(CpuInfo::get_max_num_cores()),
+          _node_metrics(CpuInfo::get_max_num_numa_nodes()) {
     for (int i = 0; i < _arenas.size(); ++i) {
         _arenas[i].reset(new ChunkArena());
     }
+    for (int i = 0; i < _node_metrics.size(); ++i) {
+        _node_metrics[i].reset(new NumaNodeMetrics());
+    }
+}
+
+ChunkAllocator::~ChunkAllocator() = default;
+
+bool ChunkAllocator::_pop_free_chunk(int core_id, size_t size, Chunk* chunk) {
+    if (!_arenas[core_id]->pop_free_chunk(size, &chunk->data)) {
+        return false;
+    }
+    _reserved_bytes.fetch_sub(size);
+    NumaNodeMetrics* metrics = _node_metrics[CpuInfo::get_numa_node_of_core(core_id)].get();
+    metrics->reserved_bytes.increment(-static_cast<int64_t>(size));
+    metrics->reuse_count.increment(1);
+    // reset chunk's core_id to the core of the arena
+    chunk->core_id = core_id;
+    return true;
 }
 
 bool ChunkAllocator::allocate(size_t size, Chunk* chunk) {
     // fast path: allocate from current core arena
-    int core_id = CpuInfo::get_current_core();
+    const int core_id = CpuInfo::get_current_core();
+    const int node = CpuInfo::get_numa_node_of_core(core_id);
     chunk->size = size;
     chunk->core_id = core_id;
 
-    if (_arenas[core_id]->pop_free_chunk(size, &chunk->data)) {
-        _reserved_bytes.fetch_sub(size);
+    if (_pop_free_chunk(core_id, size, chunk)) {
         local_core_alloc_count.increment(1);
         return true;
     }
     if (_reserved_bytes > size) {
-        // try to allocate from other core's arena
-        ++core_id;
-        for (int i = 1; i < _arenas.size(); ++i, ++core_id) {
-            if (_arenas[core_id % _arenas.size()]->pop_free_chunk(size, &chunk->data)) {
-                _reserved_bytes.fetch_sub(size);
+        // try to allocate from other core's arena of the same NUMA node, beginning from the next core to
+        // spread the contention.
+        const std::vector<int>& node_cores = CpuInfo::get_cores_of_numa_node(node);
+        const int core_idx = CpuInfo::get_numa_node_core_idx(core_id);
+        for (int i = 1; i < node_cores.size(); ++i) {
+            if (_pop_free_chunk(node_cores[(core_idx + i) % node_cores.size()], size, chunk)) {
                 other_core_alloc_count.increment(1);
-                // reset chunk's core_id to other
-                chunk->core_id = core_id % _arenas.size();
+                return true;
+            }
+        }
+    }
+    if (_reserved_bytes > size && config::chunk_reuse_across_numa_nodes) {
+        // try to allocate from the arenas of the other NUMA nodes
+        for (int i = 1; i < _arenas.size(); ++i) {
+            int other_core = (core_id + i) % _arenas.size();
+            if (CpuInfo::get_numa_node_of_core(other_core) != node && _pop_free_chunk(other_core, size, chunk)) {
+                other_node_alloc_count.increment(1);
                 return true;
             }
         }
@@ -160,6 +213,7 @@ bool ChunkAllocator::allocate(size_t size, Chunk* chunk) {
     }
     system_alloc_count.increment(1);
     system_alloc_cost_ns.increment(cost_ns);
+    _node_metrics[node]->system_alloc_count.increment(1);
     if (chunk->data == nullptr) {
         return false;
     }
@@ -185,6 +239,7 @@ void ChunkAllocator::free(const Chunk& chunk) {
     } while (!_reserved_bytes.compare_exchange_weak(old_reserved_bytes, new_reserved_bytes));
 
     _arenas[chunk.core_id]->push_free_chunk(chunk.data, chunk.size);
+    _node_metrics[CpuInfo::get_numa_node_of_core(chunk.core_id)]->reserved_bytes.increment(chunk.size);
 }
 
 } // namespace starrocks
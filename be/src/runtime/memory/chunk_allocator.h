@@ -31,6 +31,7 @@ namespace starrocks {
 
 class Chunk;
 class ChunkArena;
+struct NumaNodeMetrics;
 
 // Used to allocate memory with power-of-two length.
 // This Allocator allocate memory from system and cache free chunks for
@@ -41,6 +42,13 @@ class ChunkArena;
 // between concurrently-running threads. If this fails, ChunkAllocator will try to allocate
 // memroy from other core's arena.
 //
+// NUMA Locality
+// The memory of a chunk is on the NUMA node of the core that allocated it, and the chunk is
+// freed into the arena of that core. When the current core arena has no free chunk, the arenas
+// of the other cores of the same NUMA node are tried first, and the arenas of the other NUMA
+// nodes are tried only if config::chunk_reuse_across_numa_nodes is true. Otherwise a new chunk
+// is allocated from system, on the local node.
+//
 // Memory Reservation
 // ChunkAllocator has a limit about how much free chunk bytes it can reserve, above which
 // chunk will released to system memory. For the worst case, when the limits is 0, it will
@@ -62,6 +70,7 @@ public:
 #endif
 
     ChunkAllocator(size_t reserve_limit);
+    ~ChunkAllocator();
 
     // Allocate a Chunk with a power-of-two length "size".
     // Return true if success and allocated chunk is saved in "chunk".
@@ -72,12 +81,17 @@ public:
     void free(const Chunk& chunk);
 
 private:
+    // Try to pop a free chunk of |size| from the arena of |core_id|.
+    bool _pop_free_chunk(int core_id, size_t size, Chunk* chunk);
+
     static ChunkAllocator* _s_instance;
 
     size_t _reserve_bytes_limit;
     std::atomic<int64_t> _reserved_bytes;
     // each core has a ChunkArena
     std::vector<std::unique_ptr<ChunkArena>> _arenas;
+    // each NUMA node has its metrics
+    std::vector<std::unique_ptr<NumaNodeMetrics>> _node_metrics;
 };
 
 } // namespace starrocks
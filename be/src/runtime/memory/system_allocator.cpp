@@ -21,6 +21,7 @@
 
 #include "runtime/memory/system_allocator.h"
 
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mman.h>
@@ -32,12 +33,22 @@ namespace starrocks {
 
 #define PAGE_SIZE (4 * 1024) // 4K
 
+static bool use_huge_page(size_t length) {
+    return config::use_huge_page_for_large_chunk && length >= SystemAllocator::HUGE_PAGE_SIZE;
+}
+
 uint8_t* SystemAllocator::allocate(size_t length) {
+    uint8_t* ptr = nullptr;
     if (config::use_mmap_allocate_chunk) {
-        return allocate_via_mmap(length);
+        ptr = allocate_via_mmap(length);
     } else {
-        return allocate_via_malloc(length);
+        ptr = allocate_via_malloc(length);
     }
+    // The advice is only a hint, the memory is still usable if the transparent huge pages are disabled.
+    if (ptr != nullptr && use_huge_page(length) && madvise(ptr, length, MADV_HUGEPAGE) != 0) {
+        VLOG(3) << "fail to back memory by huge pages, errno=" << errno;
+    }
+    return ptr;
 }
 
 void SystemAllocator::free(uint8_t* ptr, size_t length) {
@@ -53,8 +64,8 @@ void SystemAllocator::free(uint8_t* ptr, size_t length) {
 
 uint8_t* SystemAllocator::allocate_via_malloc(size_t length) {
     void* ptr = nullptr;
-    // try to use a whole page instead of parts of one page
-    int res = posix_memalign(&ptr, PAGE_SIZE, length);
+    // try to use a whole page instead of parts of one page, and whole huge pages for the large chunks.
+    int res = posix_memalign(&ptr, use_huge_page(length) ? HUGE_PAGE_SIZE : PAGE_SIZE, length);
     if (res != 0) {
         PLOG(ERROR) << "fail to allocate mem via posix_memalign, res=" << res;
         return nullptr;
@@ -34,6 +34,9 @@ public:
 
     static void free(uint8_t* ptr, size_t length);
 
+    // The min length of the memory backed by the huge pages if config::use_huge_page_for_large_chunk is true.
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
 private:
     static uint8_t* allocate_via_mmap(size_t length);
     static uint8_t* allocate_via_malloc(size_t length);
@@ -23,19 +23,23 @@
 
 #include <arrow/memory_pool.h>
 #include <arrow/record_batch.h>
+#include <arrow/type.h>
 
 #include <sstream>
 
+#include "column/chunk.h"
 #include "common/logging.h"
 #include "exprs/expr.h"
 #include "gen_cpp/DorisExternalService_types.h"
 #include "gen_cpp/Types_types.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/exec_env.h"
 #include "runtime/primitive_type.h"
 #include "runtime/result_queue_mgr.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "runtime/tuple_row.h"
+#include "runtime/vectorized/chunk_to_arrow.h"
 #include "util/arrow/row_batch.h"
 #include "util/date_func.h"
 #include "util/types.h"
@@ -83,6 +87,22 @@ Status MemoryScratchSink::send(RuntimeState* state, RowBatch* batch) {
     return Status::OK();
 }
 
+Status MemoryScratchSink::send_chunk(RuntimeState* state, vectorized::Chunk* chunk) {
+    if (nullptr == chunk || 0 == chunk->num_rows()) {
+        return Status::OK();
+    }
+    // the record batches are of the same schema as the ones converted from the row batches.
+    if (static_cast<size_t>(_arrow_schema->num_fields()) != _output_expr_ctxs.size()) {
+        return Status::InternalError(strings::Substitute("output exprs size $0 mismatch arrow schema fields size $1",
+                                                         _output_expr_ctxs.size(), _arrow_schema->num_fields()));
+    }
+    std::shared_ptr<arrow::RecordBatch> result;
+    RETURN_IF_ERROR(vectorized::convert_chunk_to_arrow(_output_expr_ctxs, _arrow_schema, chunk,
+                                                       arrow::default_memory_pool(), &result));
+    _queue->blocking_put(result);
+    return Status::OK();
+}
+
 Status MemoryScratchSink::open(RuntimeState* state) {
     return Expr::open(_output_expr_ctxs, state);
 }
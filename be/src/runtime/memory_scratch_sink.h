@@ -68,6 +68,11 @@ public:
     // Blocks until all rows in batch are pushed to the queue
     virtual Status send(RuntimeState* state, RowBatch* batch);
 
+    // send the results of the output exprs on |chunk| to this backend queue mgr, as a record batch converted
+    // from the columns directly.
+    // Blocks until the record batch is pushed to the queue
+    Status send_chunk(RuntimeState* state, vectorized::Chunk* chunk) override;
+
     virtual Status close(RuntimeState* state, Status exec_status);
 
     virtual RuntimeProfile* profile() { return _profile; }
@@ -31,6 +31,7 @@
 #include "gutil/map_util.h"
 #include "runtime/current_thread.h"
 #include "runtime/data_stream_mgr.h"
+#include "runtime/descriptor_tbl_cache.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
@@ -128,8 +129,7 @@ Status PlanFragmentExecutor::prepare(const TExecPlanFragmentParams& request) {
     // set up desc tbl
     DescriptorTbl* desc_tbl = NULL;
     DCHECK(request.__isset.desc_tbl);
-    RETURN_IF_ERROR(DescriptorTbl::create(obj_pool(), request.desc_tbl, &desc_tbl));
-    _runtime_state->set_desc_tbl(desc_tbl);
+    RETURN_IF_ERROR(DescriptorTblCache::create(_runtime_state.get(), request.desc_tbl, &desc_tbl));
 
     // set up plan
     DCHECK(request.__isset.fragment);
@@ -227,6 +227,7 @@ Status PlanFragmentExecutor::prepare(const TExecPlanFragmentParams& request) {
 Status PlanFragmentExecutor::open() {
     LOG(INFO) << "Open(): fragment_instance_id=" << print_id(_runtime_state->fragment_instance_id());
     CurrentThread::set_query_id(_runtime_state->query_id());
+    CurrentThread::set_fragment_instance_id(_runtime_state->fragment_instance_id());
 
     Status status = Status::OK();
 
@@ -356,6 +357,9 @@ Status PlanFragmentExecutor::_open_internal_vectorized() {
             collect_query_statistics();
         }
         RETURN_IF_ERROR(_sink->send_chunk(runtime_state(), chunk.get()));
+        if (_sink->is_finished()) {
+            break;
+        }
     }
 
     // Close the sink *before* stopping the report thread. Close may
@@ -31,6 +31,7 @@
 #include "runtime/result_buffer_mgr.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
+#include "runtime/vectorized/arrow_result_writer.h"
 #include "runtime/vectorized/statistic_result_writer.h"
 #include "util/uid_util.h"
 
@@ -87,6 +88,9 @@ Status ResultSink::prepare(RuntimeState* state) {
     case TResultSinkType::STATISTIC:
         _writer.reset(new (std::nothrow) vectorized::StatisticResultWriter(_sender.get(), _output_expr_ctxs, _profile));
         break;
+    case TResultSinkType::ARROW:
+        _writer.reset(new (std::nothrow) vectorized::ArrowResultWriter(_sender.get(), _output_expr_ctxs, _profile));
+        break;
     default:
         return Status::InternalError("Unknown result sink type");
     }
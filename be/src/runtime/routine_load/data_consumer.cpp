@@ -160,7 +160,7 @@ Status KafkaDataConsumer::assign_topic_partitions(const std::map<int32_t, int64_
     return Status::OK();
 }
 
-Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms) {
+Status KafkaDataConsumer::group_consume(TimedBlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms) {
     _last_visit_time = time(nullptr);
     int64_t left_time = max_running_time_ms;
     LOG(INFO) << "start kafka consumer: " << _id << ", grp: " << _grp_id << ", max running time(ms): " << left_time;
@@ -183,46 +183,27 @@ Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* q
             break;
         }
 
-        bool done = false;
-        // consume 1 message at a time
+        // consume the messages ready at a time, so the queue is visited once for them
+        auto batch = std::make_unique<KafkaMessageBatch>();
         consumer_watch.start();
-        std::unique_ptr<RdKafka::Message> msg(_k_consumer->consume(1000 /* timeout, ms */));
+        st = consume_batch(1000 /* timeout, ms */, kMaxBatchSize, &batch->msgs);
         consumer_watch.stop();
-        switch (msg->err()) {
-        case RdKafka::ERR_NO_ERROR:
-            if (!queue->blocking_put(msg.get())) {
+        size_t num_msgs = batch->msgs.size();
+        received_rows += num_msgs;
+        if (num_msgs > 0) {
+            batch->consumer = shared_from_this();
+            if (!queue->blocking_put(batch.get())) {
                 // queue is shutdown
-                done = true;
-            } else {
-                ++put_rows;
-                msg.release(); // release the ownership, msg will be deleted after being processed
+                break;
             }
-            ++received_rows;
-            break;
-        case RdKafka::ERR__TIMED_OUT:
-            // leave the status as OK, because this may happend
-            // if there is no data in kafka.
-            LOG(INFO) << "kafka consume timeout: " << _id;
-            break;
-        case RdKafka::ERR_OFFSET_OUT_OF_RANGE: {
-            done = true;
-            std::stringstream ss;
-            ss << msg->errstr() << ", partition " << msg->partition() << " offset " << msg->offset() << " has no data";
-            LOG(WARNING) << "kafka consume failed: " << _id << ", msg: " << ss.str();
-            st = Status::InternalError(ss.str());
-            break;
+            put_rows += num_msgs;
+            batch.release(); // release the ownership, msgs will be deleted after being processed
         }
-        default:
-            LOG(WARNING) << "kafka consume failed: " << _id << ", msg: " << msg->errstr();
-            done = true;
-            st = Status::InternalError(msg->errstr());
+        if (!st.ok()) {
             break;
         }
 
         left_time = max_running_time_ms - watch.elapsed_time() / 1000 / 1000;
-        if (done) {
-            break;
-        }
     }
 
     LOG(INFO) << "kafka consume done: " << _id << ", grp: " << _grp_id << ". cancelled: " << _cancelled
@@ -233,6 +214,35 @@ Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* q
     return st;
 }
 
+Status KafkaDataConsumer::consume_batch(int timeout_ms, size_t max_size,
+                                        std::vector<std::unique_ptr<RdKafka::Message>>* msgs) {
+    while (msgs->size() < max_size) {
+        std::unique_ptr<RdKafka::Message> msg(_k_consumer->consume(msgs->empty() ? timeout_ms : 0));
+        switch (msg->err()) {
+        case RdKafka::ERR_NO_ERROR:
+            msgs->emplace_back(std::move(msg));
+            break;
+        case RdKafka::ERR__TIMED_OUT:
+            // leave the status as OK, because this may happend
+            // if there is no data in kafka.
+            if (msgs->empty()) {
+                LOG(INFO) << "kafka consume timeout: " << _id;
+            }
+            return Status::OK();
+        case RdKafka::ERR_OFFSET_OUT_OF_RANGE: {
+            std::stringstream ss;
+            ss << msg->errstr() << ", partition " << msg->partition() << " offset " << msg->offset() << " has no data";
+            LOG(WARNING) << "kafka consume failed: " << _id << ", msg: " << ss.str();
+            return Status::InternalError(ss.str());
+        }
+        default:
+            LOG(WARNING) << "kafka consume failed: " << _id << ", msg: " << msg->errstr();
+            return Status::InternalError(msg->errstr());
+        }
+    }
+    return Status::OK();
+}
+
 Status KafkaDataConsumer::get_partition_offset(std::vector<int32_t>* partition_ids,
                                                std::vector<int64_t>* beginning_offsets,
                                                std::vector<int64_t>* latest_offsets) {
@@ -22,8 +22,10 @@
 #pragma once
 
 #include <ctime>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "librdkafka/rdkafkacpp.h"
 #include "runtime/stream_load/stream_load_context.h"
@@ -109,8 +111,19 @@ public:
     }
 };
 
-class KafkaDataConsumer : public DataConsumer {
+// The messages consumed by one poll of a kafka data consumer, which are passed to the consumer group together.
+// The messages hold the consumer, because a kafka consumer must not be destroyed before its messages.
+struct KafkaMessageBatch {
+    std::shared_ptr<DataConsumer> consumer;
+    std::vector<std::unique_ptr<RdKafka::Message>> msgs;
+};
+
+// It must be created by std::make_shared, the messages consumed hold it.
+class KafkaDataConsumer : public DataConsumer, public std::enable_shared_from_this<KafkaDataConsumer> {
 public:
+    // the max number of the messages consumed by one poll
+    static constexpr size_t kMaxBatchSize = 256;
+
     KafkaDataConsumer(StreamLoadContext* ctx)
             : DataConsumer(ctx), _brokers(ctx->kafka_info->brokers), _topic(ctx->kafka_info->topic) {}
 
@@ -137,7 +150,11 @@ public:
                                    StreamLoadContext* ctx);
 
     // start the consumer and put msgs to queue
-    Status group_consume(TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms);
+    Status group_consume(TimedBlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms);
+
+    // Consume at most |max_size| messages into |msgs|, it waits at most |timeout_ms| for the first message,
+    // and doesn't wait for the others.
+    Status consume_batch(int timeout_ms, size_t max_size, std::vector<std::unique_ptr<RdKafka::Message>>* msgs);
 
     // get the partitions ids of the topic
     Status get_partition_meta(std::vector<int32_t>* partition_ids);
@@ -55,10 +55,9 @@ KafkaDataConsumerGroup::~KafkaDataConsumerGroup() {
     // clean the msgs left in queue
     _queue.shutdown();
     while (true) {
-        RdKafka::Message* msg;
-        if (_queue.blocking_get(&msg)) {
-            delete msg;
-            msg = nullptr;
+        KafkaMessageBatch* batch;
+        if (_queue.blocking_get(&batch)) {
+            delete batch;
         } else {
             break;
         }
@@ -68,9 +67,11 @@ KafkaDataConsumerGroup::~KafkaDataConsumerGroup() {
 
 Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
     Status result_st = Status::OK();
-    // start all consumers
+    // start all consumers, each of them runs in its own thread.
+    size_t num_threads = _consumers.size();
+    _thread_pool = std::make_unique<PriorityThreadPool>(num_threads, num_threads);
     for (auto& consumer : _consumers) {
-        if (!_thread_pool.offer(std::bind<void>(
+        if (!_thread_pool->offer(std::bind<void>(
                     &KafkaDataConsumerGroup::actual_consume, this, consumer, &_queue, ctx->max_interval_s * 1000,
                     [this, &result_st](const Status& st) {
                         std::unique_lock<std::mutex> lock(_mutex);
@@ -104,13 +105,9 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
     // copy one
     std::map<int32_t, int64_t> cmt_offset = ctx->kafka_info->cmt_offset;
 
-    //improve performance
-    Status (KafkaConsumerPipe::*append_data)(const char* data, size_t size, char row_delimiter);
+    bool is_json = ctx->format == TFileFormatType::FORMAT_JSON;
     char row_delimiter = '\n';
-    if (ctx->format == TFileFormatType::FORMAT_JSON) {
-        append_data = &KafkaConsumerPipe::append_json;
-    } else {
-        append_data = &KafkaConsumerPipe::append_with_row_delimiter;
+    if (!is_json) {
         auto& per_node_scan_ranges = ctx->put_result.params.params.per_node_scan_ranges;
 
         if (!per_node_scan_ranges.empty()) {
@@ -143,8 +140,8 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
             }
 
             // waiting all threads finished
-            _thread_pool.shutdown();
-            _thread_pool.join();
+            _thread_pool->shutdown();
+            _thread_pool->join();
 
             if (!result_st.ok()) {
                 // some of consumers encounter errors, cancel this task
@@ -165,26 +162,17 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
             }
         }
 
-        RdKafka::Message* msg;
-        bool res = _queue.blocking_get(&msg);
+        KafkaMessageBatch* batch;
+        bool res = _queue.blocking_get(&batch);
         if (res) {
-            VLOG(3) << "get kafka message"
-                    << ", partition: " << msg->partition() << ", offset: " << msg->offset() << ", len: " << msg->len();
-
-            (kafka_pipe.get()->*append_data)(static_cast<const char*>(msg->payload()), static_cast<size_t>(msg->len()),
-                                             row_delimiter);
-
-            if (st.ok()) {
-                received_rows++;
-                left_bytes -= msg->len();
-                cmt_offset[msg->partition()] = msg->offset();
-                VLOG(3) << "consume partition[" << msg->partition() << " - " << msg->offset() << "]";
-            } else {
+            std::unique_ptr<KafkaMessageBatch> batch_holder(batch);
+            received_rows += batch->msgs.size();
+            st = append_msgs(kafka_pipe.get(), batch, is_json, row_delimiter, &left_bytes, &cmt_offset);
+            if (!st.ok()) {
                 // failed to append this msg, we must stop
-                LOG(WARNING) << "failed to append msg to pipe. grp: " << _grp_id;
+                LOG(WARNING) << "failed to append msg to pipe. grp: " << _grp_id << ", " << st.to_string();
                 eos = true;
             }
-            delete msg;
         } else {
             // queue is empty and shutdown
             eos = true;
@@ -196,8 +184,36 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
     return Status::OK();
 }
 
+Status KafkaDataConsumerGroup::append_msgs(KafkaConsumerPipe* pipe, KafkaMessageBatch* batch, bool is_json,
+                                           char row_delimiter, int64_t* left_bytes,
+                                           std::map<int32_t, int64_t>* cmt_offset) {
+    // the small messages are copied into the buffers of the pipe together, which is cheaper than a buffer for
+    // each of them.
+    constexpr size_t kMinZeroCopyBytes = 4096;
+    for (auto& msg : batch->msgs) {
+        VLOG(3) << "get kafka message"
+                << ", partition: " << msg->partition() << ", offset: " << msg->offset() << ", len: " << msg->len();
+        auto* data = static_cast<char*>(msg->payload());
+        size_t len = msg->len();
+        int32_t partition = msg->partition();
+        int64_t offset = msg->offset();
+        if (is_json || len >= kMinZeroCopyBytes) {
+            // the message is deleted once the pipe is read, it holds the consumer.
+            RdKafka::Message* raw_msg = msg.release();
+            auto buf = ByteBuffer::wrap(data, len, [raw_msg, consumer = batch->consumer] { delete raw_msg; });
+            RETURN_IF_ERROR(is_json ? pipe->append_json(buf) : pipe->append_with_row_delimiter(buf, row_delimiter));
+        } else {
+            RETURN_IF_ERROR(pipe->append_with_row_delimiter(data, len, row_delimiter));
+        }
+        *left_bytes -= len;
+        (*cmt_offset)[partition] = offset;
+        VLOG(3) << "consume partition[" << partition << " - " << offset << "]";
+    }
+    return Status::OK();
+}
+
 void KafkaDataConsumerGroup::actual_consume(std::shared_ptr<DataConsumer> consumer,
-                                            TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms,
+                                            TimedBlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms,
                                             ConsumeFinishCallback cb) {
     Status st = std::static_pointer_cast<KafkaDataConsumer>(consumer)->group_consume(queue, max_running_time_ms);
     cb(st);
@@ -21,12 +21,17 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+
 #include "runtime/routine_load/data_consumer.h"
 #include "util/blocking_queue.hpp"
 #include "util/priority_thread_pool.hpp"
 
 namespace starrocks {
 
+class KafkaConsumerPipe;
+
 // data consumer group saves a group of data consumers.
 // These data consumers share the same stream load pipe.
 // This class is not thread safe.
@@ -34,7 +39,7 @@ class DataConsumerGroup {
 public:
     typedef std::function<void(const Status&)> ConsumeFinishCallback;
 
-    DataConsumerGroup() : _grp_id(UniqueId::gen_uid()), _thread_pool(3, 10), _counter(0) {}
+    DataConsumerGroup() : _grp_id(UniqueId::gen_uid()), _counter(0) {}
 
     virtual ~DataConsumerGroup() { _consumers.clear(); }
 
@@ -54,8 +59,9 @@ public:
 protected:
     UniqueId _grp_id;
     std::vector<std::shared_ptr<DataConsumer>> _consumers;
-    // thread pool to run each consumer in multi thread
-    PriorityThreadPool _thread_pool;
+    // thread pool to run each consumer in multi thread, it has one thread for each consumer, and is created
+    // when the consumers start.
+    std::unique_ptr<PriorityThreadPool> _thread_pool;
     // mutex to protect counter.
     // the counter is init as the number of consumers.
     // once a consumer is done, decrease the counter.
@@ -67,7 +73,7 @@ protected:
 // for kafka
 class KafkaDataConsumerGroup : public DataConsumerGroup {
 public:
-    KafkaDataConsumerGroup() : DataConsumerGroup(), _queue(500) {}
+    KafkaDataConsumerGroup() : DataConsumerGroup(), _queue(64) {}
 
     virtual ~KafkaDataConsumerGroup();
 
@@ -77,12 +83,16 @@ public:
 
 private:
     // start a single consumer
-    void actual_consume(std::shared_ptr<DataConsumer> consumer, TimedBlockingQueue<RdKafka::Message*>* queue,
+    void actual_consume(std::shared_ptr<DataConsumer> consumer, TimedBlockingQueue<KafkaMessageBatch*>* queue,
                         int64_t max_running_time_ms, ConsumeFinishCallback cb);
 
+    // Append the messages to the pipe, the large messages are appended without copying them.
+    Status append_msgs(KafkaConsumerPipe* pipe, KafkaMessageBatch* batch, bool is_json, char row_delimiter,
+                       int64_t* left_bytes, std::map<int32_t, int64_t>* cmt_offset);
+
 private:
     // blocking queue to receive msgs from all consumers
-    TimedBlockingQueue<RdKafka::Message*> _queue;
+    TimedBlockingQueue<KafkaMessageBatch*> _queue;
 };
 
 } // end namespace starrocks
@@ -52,7 +52,20 @@ public:
         return st;
     }
 
-    Status append_json(const char* data, size_t size, char row_delimiter) { return append_and_flush(data, size); }
+    // Append the bytes of |buf| without copying them, |buf| is released once it's read.
+    Status append_with_row_delimiter(const ByteBufferPtr& buf, char row_delimiter) {
+        Status st = append(buf);
+        if (!st.ok()) {
+            return st;
+        }
+
+        // append the row delimiter
+        st = append(&row_delimiter, 1);
+        return st;
+    }
+
+    // Append one json message without copying it, |buf| is released once it's read.
+    Status append_json(const ByteBufferPtr& buf) { return append(buf); }
 };
 
 } // end namespace starrocks
@@ -35,6 +35,15 @@ static void send_rpc_runtime_filter(PBackendService_Stub* stub, RuntimeFilterRpc
     rpc_closure->seq++;
 }
 
+// The instances of a fragment are split into |num_groups| contiguous groups, one per intermediate merge node.
+// Set |group| and |group_size| of the instance |instance_idx|.
+static void get_merge_group(int num_instances, int num_groups, int instance_idx, int* group, int* group_size) {
+    *group = static_cast<int64_t>(instance_idx) * num_groups / num_instances;
+    int64_t begin = (static_cast<int64_t>(*group) * num_instances + num_groups - 1) / num_groups;
+    int64_t end = (static_cast<int64_t>(*group + 1) * num_instances + num_groups - 1) / num_groups;
+    *group_size = end - begin;
+}
+
 void RuntimeFilterPort::add_listener(vectorized::RuntimeFilterProbeDescriptor* rf_desc) {
     int32_t rf_id = rf_desc->filter_id();
     if (_listeners.find(rf_id) == _listeners.end()) {
@@ -94,7 +103,27 @@ void RuntimeFilterPort::publish_runtime_filters(std::list<vectorized::RuntimeFil
                 filter, reinterpret_cast<uint8_t*>(rf_data->data()));
         rf_data->resize(actual_size);
 
-        state->exec_env()->runtime_filter_worker()->send_part_runtime_filter(std::move(params), rf_desc->merge_nodes(),
+        // if there are multiple merge nodes, the first one is the root, and the others are intermediate merge nodes.
+        // partial rfs of contiguous fragment instances are merged by the same intermediate merge node,
+        // so the root merge node still concatenates the partitions in order of the instances.
+        const auto& merge_nodes = rf_desc->merge_nodes();
+        int num_instances = state->num_per_fragment_instances();
+        int instance_idx = state->per_fragment_instance_idx();
+        if (rf_desc->join_mode() != TRuntimeFilterBuildJoinMode::BORADCAST && merge_nodes.size() > 1 &&
+            instance_idx < num_instances) {
+            int group = 0;
+            int group_size = 0;
+            get_merge_group(num_instances, static_cast<int>(merge_nodes.size() - 1), instance_idx, &group, &group_size);
+            params.set_merge_group_size(group_size);
+            PTransmitRuntimeFilterForwardTarget* root = params.mutable_merge_root();
+            root->set_host(merge_nodes[0].hostname);
+            root->set_port(merge_nodes[0].port);
+            state->exec_env()->runtime_filter_worker()->send_part_runtime_filter(
+                    std::move(params), {merge_nodes[1 + group]}, timeout_ms);
+            continue;
+        }
+
+        state->exec_env()->runtime_filter_worker()->send_part_runtime_filter(std::move(params), {merge_nodes[0]},
                                                                              timeout_ms);
     }
 }
@@ -142,7 +171,11 @@ void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& par
                                                RuntimeFilterRpcClosure* rpc_closure) {
     DCHECK(params.is_partial());
     int32_t filter_id = params.filter_id();
-    int32_t be_number = params.build_be_number();
+    // be numbers of the partial rfs merged in this one, more than one if it's from an intermediate merge node.
+    std::vector<int32_t> be_numbers(params.merged_be_numbers().begin(), params.merged_be_numbers().end());
+    if (be_numbers.empty()) {
+        be_numbers.push_back(params.build_be_number());
+    }
 
     std::vector<TRuntimeFilterProberParams>* target_nodes = nullptr;
     // check if there is no consumer.
@@ -158,9 +191,11 @@ void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& par
         auto it = _statuses.find(filter_id);
         if (it == _statuses.end()) return;
         status = &(it->second);
-        if (status->arrives.find(be_number) != status->arrives.end()) {
-            // duplicated one, just skip it.
-            return;
+        for (int32_t be_number : be_numbers) {
+            if (status->arrives.find(be_number) != status->arrives.end()) {
+                // duplicated one, just skip it.
+                return;
+            }
         }
         if (status->stop) {
             return;
@@ -194,11 +229,11 @@ void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& par
         return;
     }
 
-    status->arrives.insert(be_number);
-    status->filters.insert(make_pair(be_number, rf));
+    status->arrives.insert(be_numbers.begin(), be_numbers.end());
+    status->filters.insert(make_pair(be_numbers[0], rf));
 
     // not ready. still have to wait more filters.
-    if (status->filters.size() < status->expect_number) return;
+    if (status->arrives.size() < status->expect_number) return;
     _send_total_runtime_filter(filter_id, rpc_closure);
 }
 
@@ -458,6 +493,69 @@ void RuntimeFilterWorker::_receive_total_runtime_filter(PTransmitRuntimeFilterPa
     }
 }
 
+void RuntimeFilterWorker::_merge_intermediate_runtime_filter(const TUniqueId& query_id,
+                                                             PTransmitRuntimeFilterParams& params,
+                                                             RuntimeFilterRpcClosure* rpc_closure) {
+    int32_t filter_id = params.filter_id();
+    int32_t be_number = params.build_be_number();
+    auto& query_statuses = _intermediate_statuses[query_id];
+    RuntimeFilterMergerStatus* status = &query_statuses[filter_id];
+    if (status->arrives.find(be_number) != status->arrives.end()) {
+        // duplicated one, just skip it.
+        return;
+    }
+
+    ObjectPool* pool = &(status->pool);
+    vectorized::JoinRuntimeFilter* rf = nullptr;
+    vectorized::RuntimeFilterHelper::deserialize_runtime_filter(
+            pool, &rf, reinterpret_cast<const uint8_t*>(params.data().data()), params.data().size());
+    if (rf == nullptr) {
+        // something wrong with deserialization.
+        return;
+    }
+    status->arrives.insert(be_number);
+    status->filters.insert(make_pair(be_number, rf));
+
+    // not ready. still have to wait more filters.
+    if (status->filters.size() < params.merge_group_size()) return;
+
+    vectorized::JoinRuntimeFilter* out = status->filters.begin()->second->create_empty(pool);
+    for (auto it : status->filters) {
+        out->concat(it.second);
+    }
+
+    PTransmitRuntimeFilterParams request;
+    request.set_filter_id(filter_id);
+    request.set_is_partial(true);
+    *request.mutable_query_id() = params.query_id();
+    *request.mutable_finst_id() = params.finst_id();
+    request.set_build_be_number(status->filters.begin()->first);
+    for (auto it : status->filters) {
+        request.add_merged_be_numbers(it.first);
+    }
+
+    std::string* send_data = request.mutable_data();
+    size_t max_size = vectorized::RuntimeFilterHelper::max_runtime_filter_serialized_size(out);
+    send_data->resize(max_size);
+    size_t actual_size = vectorized::RuntimeFilterHelper::serialize_runtime_filter(
+            out, reinterpret_cast<uint8_t*>(send_data->data()));
+    send_data->resize(actual_size);
+
+    TNetworkAddress root;
+    root.hostname = params.merge_root().host();
+    root.port = params.merge_root().port();
+    VLOG_FILE << "RuntimeFilterWorker::merge_intermediate_rf. root = " << root << ", filter_id = " << filter_id
+              << ", filter_size = " << out->size() << ", # merged = " << request.merged_be_numbers_size();
+    PBackendService_Stub* stub = _exec_env->brpc_stub_cache()->get_stub(root);
+    send_rpc_runtime_filter(stub, rpc_closure, default_send_rpc_runtime_filter_timeout_ms, request);
+
+    // we don't need to hold rf any more.
+    query_statuses.erase(filter_id);
+    if (query_statuses.empty()) {
+        _intermediate_statuses.erase(query_id);
+    }
+}
+
 void RuntimeFilterWorker::execute() {
     LOG(INFO) << "RuntimeFilterWorker start working.";
     RuntimeFilterRpcClosure* rpc_closure = new RuntimeFilterRpcClosure();
@@ -480,6 +578,7 @@ void RuntimeFilterWorker::execute() {
             if (it != _mergers.end()) {
                 _mergers.erase(it);
             }
+            _intermediate_statuses.erase(ev.query_id);
             break;
         }
 
@@ -500,6 +599,10 @@ void RuntimeFilterWorker::execute() {
         }
 
         case RECEIVE_PART_RF: {
+            if (ev.transmit_rf_request.has_merge_group_size()) {
+                _merge_intermediate_runtime_filter(ev.query_id, ev.transmit_rf_request, rpc_closure);
+                break;
+            }
             auto it = _mergers.find(ev.query_id);
             if (it == _mergers.end()) {
                 VLOG_QUERY << "receive part rf: rf merger not existed. query_id = " << ev.query_id;
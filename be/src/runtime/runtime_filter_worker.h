@@ -103,6 +103,7 @@ private:
 // it works in a event-driven way, and possible events are:
 // - create a runtime filter merger for a query
 // - receive partitioned RF, deserialize it and merge it, and sent total RF(for merge node)
+// - receive a group of partitioned RFs, merge them and send it to the root merge node(for intermediate merge node)
 // - receive total RF and send it to RuntimeFilterPort
 // - send partitioned RF(for hash join node)
 // - close a query(delete runtime filter merger)
@@ -121,8 +122,13 @@ public:
 
 private:
     void _receive_total_runtime_filter(PTransmitRuntimeFilterParams& params, RuntimeFilterRpcClosure* rpc_closure);
+    // As an intermediate merge node, concatenate a group of partial rfs and forward it to the root merge node.
+    void _merge_intermediate_runtime_filter(const TUniqueId& query_id, PTransmitRuntimeFilterParams& params,
+                                            RuntimeFilterRpcClosure* rpc_closure);
     UnboundedBlockingQueue<RuntimeFilterWorkerEvent> _queue;
     std::unordered_map<TUniqueId, RuntimeFilterMerger> _mergers;
+    // query id -> filter id -> partial rfs merged as an intermediate merge node.
+    std::unordered_map<TUniqueId, std::map<int32_t, RuntimeFilterMergerStatus>> _intermediate_statuses;
     ExecEnv* _exec_env;
     std::atomic<bool> _stop;
     std::thread _thread;
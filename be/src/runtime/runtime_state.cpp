@@ -30,6 +30,7 @@
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "exec/exec_node.h"
+#include "exec/vectorized/spill_manager.h"
 #include "exprs/vectorized/runtime_filter_bank.h"
 #include "runtime/buffered_block_mgr2.h"
 #include "runtime/bufferpool/reservation_tracker.h"
@@ -217,6 +218,7 @@ Status RuntimeState::init_mem_trackers(const TUniqueId& query_id) {
                                                       _exec_env->query_pool_mem_tracker());
     _instance_mem_tracker =
             std::make_unique<MemTracker>(&_profile, -1, runtime_profile()->name(), _query_mem_tracker.get());
+    _spill_manager = std::make_unique<vectorized::SpillManager>(_instance_mem_tracker.get(), _exec_env->tmp_file_mgr());
     RETURN_IF_ERROR(init_buffer_poolstate());
 
     _initial_reservations =
@@ -235,6 +237,8 @@ Status RuntimeState::init_mem_trackers(const TUniqueId& query_id) {
 
 Status RuntimeState::init_instance_mem_tracker() {
     _instance_mem_tracker = std::make_unique<MemTracker>(-1);
+    _spill_manager = std::make_unique<vectorized::SpillManager>(
+            _instance_mem_tracker.get(), _exec_env != nullptr ? _exec_env->tmp_file_mgr() : nullptr);
     return Status::OK();
 }
 
@@ -365,6 +369,7 @@ void RuntimeState::append_error_msg_to_file(const std::string& line, const std::
     if (_query_options.query_type != TQueryType::LOAD) {
         return;
     }
+    std::lock_guard<std::mutex> l(_error_log_file_lock);
     // If file havn't been opened, open it here
     if (_error_log_file == nullptr) {
         Status status = create_error_log_file();
@@ -58,6 +58,10 @@ class InitialReservations;
 class RowDescriptor;
 class RuntimeFilterPort;
 
+namespace vectorized {
+class SpillManager;
+}
+
 // A collection of items that are part of the global state of a
 // query and shared across all execution nodes of that query.
 class RuntimeState {
@@ -100,6 +104,11 @@ public:
 
     const DescriptorTbl& desc_tbl() const { return *_desc_tbl; }
     void set_desc_tbl(DescriptorTbl* desc_tbl) { _desc_tbl = desc_tbl; }
+    // Set the table shared with the other fragment instances, see DescriptorTblCache.
+    void set_desc_tbl(std::shared_ptr<DescriptorTbl> desc_tbl) {
+        _desc_tbl = desc_tbl.get();
+        _shared_desc_tbl = std::move(desc_tbl);
+    }
     int batch_size() const { return _query_options.batch_size; }
     void set_batch_size(int batch_size) { _query_options.batch_size = batch_size; }
     bool abort_on_default_limit_exceeded() const { return _query_options.abort_on_default_limit_exceeded; }
@@ -115,6 +124,8 @@ public:
     std::vector<MemTracker*>* mem_trackers() { return &_mem_trackers; }
     MemTracker* fragment_mem_tracker() { return _fragment_mem_tracker; }
     MemTracker* instance_mem_tracker() { return _instance_mem_tracker.get(); }
+    // Shared by the spillable operators of this fragment instance, nullptr before the mem trackers are created.
+    vectorized::SpillManager* spill_manager() { return _spill_manager.get(); }
     ThreadResourceMgr::ResourcePool* resource_pool() { return _resource_pool; }
     RuntimeFilterPort* runtime_filter_port() { return _runtime_filter_port; }
 
@@ -311,6 +322,8 @@ private:
     RuntimeProfile _profile;
 
     DescriptorTbl* _desc_tbl = nullptr;
+    // Keeps the table cached by DescriptorTblCache alive, nullptr if the table is in _obj_pool.
+    std::shared_ptr<DescriptorTbl> _shared_desc_tbl;
 
     // Lock protecting _error_log and _unreported_error_idx
     std::mutex _error_log_lock;
@@ -352,6 +365,9 @@ private:
     // Memory usage of this fragment instance
     std::unique_ptr<MemTracker> _instance_mem_tracker;
 
+    // Refers to the _instance_mem_tracker, so it must be released before it.
+    std::unique_ptr<vectorized::SpillManager> _spill_manager;
+
     std::shared_ptr<ObjectPool> _obj_pool;
 
     // if true, execution should stop with a CANCELLED status
@@ -401,6 +417,8 @@ private:
     std::unique_ptr<TLoadErrorHubInfo> _load_error_hub_info;
 
     std::string _error_log_file_path;
+    // Lock protecting _error_log_file and _error_hub, the errors are appended by several scanner threads
+    std::mutex _error_log_file_lock;
     std::ofstream* _error_log_file = nullptr; // error file path, absolute path
     std::unique_ptr<LoadErrorHub> _error_hub;
     std::vector<TTabletCommitInfo> _tablet_commit_infos;
@@ -160,6 +160,8 @@ public:
     std::shared_ptr<MessageBodySink> body_sink;
 
     TStreamLoadPutResult put_result;
+    // The request to plan this load if it's merged into a group, see StreamLoadGroupCommitMgr.
+    std::unique_ptr<TStreamLoadPutRequest> group_commit_request;
 
     std::vector<TTabletCommitInfo> commit_infos;
 
@@ -0,0 +1,232 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/stream_load/stream_load_group_commit_mgr.h"
+
+#include <thrift/protocol/TDebugProtocol.h>
+
+#include <chrono>
+#include <condition_variable>
+
+#include "common/config.h"
+#include "gen_cpp/FrontendService.h"
+#include "runtime/exec_env.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_context.h"
+#include "runtime/stream_load/stream_load_executor.h"
+#include "runtime/stream_load/stream_load_pipe.h"
+#include "util/thrift_rpc_helper.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+#ifdef BE_TEST
+extern TStreamLoadPutResult k_stream_load_put_result;
+#endif
+
+struct StreamLoadGroupCommitMgr::Group {
+    ~Group() {
+        if (ctx != nullptr && ctx->unref()) {
+            delete ctx;
+        }
+    }
+
+    std::string key;
+    // the context of the transaction of the group
+    StreamLoadContext* ctx = nullptr;
+    std::shared_ptr<StreamLoadPipe> pipe;
+    std::chrono::steady_clock::time_point begin_time;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    // whether the transaction and the plan have begun, or failed to, the bodies are appended after it.
+    bool begun = false;
+    // no more loads join the group once it's closed.
+    bool closed = false;
+    // whether the group is committed, or failed.
+    bool done = false;
+    // the loads joined whose bodies are not appended yet.
+    int pending_loads = 0;
+    size_t bytes = 0;
+    Status status;
+
+    // serialize the appending of the bodies.
+    std::mutex append_mutex;
+};
+
+std::string StreamLoadGroupCommitMgr::_group_key(const StreamLoadContext* ctx, const TStreamLoadPutRequest& request) {
+    // The request has the user, the table and all the properties of the load.
+    std::stringstream ss;
+    ss << apache::thrift::ThriftDebugString(request) << ctx->max_filter_ratio;
+    return ss.str();
+}
+
+Status StreamLoadGroupCommitMgr::load(StreamLoadContext* ctx, const TStreamLoadPutRequest& request,
+                                      std::string* body) {
+    // The last row of a body must not be concatenated with the first row of the next one.
+    if (!body->empty() && body->back() != '\n') {
+        body->push_back('\n');
+    }
+
+    const std::string key = _group_key(ctx, request);
+    std::shared_ptr<Group> group;
+    bool is_first = false;
+    {
+        std::lock_guard l(_mutex);
+        auto& open_group = _groups[key];
+        if (open_group == nullptr) {
+            open_group = std::make_shared<Group>();
+            open_group->key = key;
+            is_first = true;
+        }
+        group = open_group;
+
+        std::lock_guard gl(group->mutex);
+        group->pending_loads++;
+        group->bytes += body->size();
+        if (group->bytes >= config::stream_load_group_commit_max_bytes) {
+            // The next load begins a new group.
+            group->closed = true;
+            _groups.erase(key);
+            group->cv.notify_all();
+        }
+    }
+
+    if (is_first) {
+        Status st = _begin(group.get(), ctx, request);
+        LOG_IF(WARNING, !st.ok()) << "failed to begin the group commit: " << st << ", " << ctx->brief();
+        std::lock_guard l(group->mutex);
+        group->begun = true;
+        group->status = st;
+        group->cv.notify_all();
+    }
+    Status st = _append(group.get(), *body);
+    if (is_first) {
+        _commit(group.get());
+    }
+
+    std::unique_lock l(group->mutex);
+    group->cv.wait(l, [&group] { return group->done; });
+    StreamLoadContext* group_ctx = group->ctx;
+    if (group_ctx != nullptr) {
+        ctx->txn_id = group_ctx->txn_id;
+        ctx->number_total_rows = group_ctx->number_total_rows;
+        ctx->number_loaded_rows = group_ctx->number_loaded_rows;
+        ctx->number_filtered_rows = group_ctx->number_filtered_rows;
+        ctx->number_unselected_rows = group_ctx->number_unselected_rows;
+        ctx->loaded_bytes = group_ctx->loaded_bytes;
+        ctx->error_url = group_ctx->error_url;
+    }
+    return st.ok() ? group->status : st;
+}
+
+Status StreamLoadGroupCommitMgr::_begin(Group* group, const StreamLoadContext* ctx,
+                                        const TStreamLoadPutRequest& request) {
+    auto* group_ctx = new StreamLoadContext(_exec_env);
+    group_ctx->ref();
+    group->ctx = group_ctx;
+    group->begin_time = std::chrono::steady_clock::now();
+    group_ctx->load_type = ctx->load_type;
+    group_ctx->load_src_type = ctx->load_src_type;
+    group_ctx->db = ctx->db;
+    group_ctx->table = ctx->table;
+    group_ctx->label = "group_commit_" + group_ctx->id.to_string();
+    group_ctx->auth = ctx->auth;
+    group_ctx->max_filter_ratio = ctx->max_filter_ratio;
+    group_ctx->timeout_second = ctx->timeout_second;
+    group_ctx->format = ctx->format;
+    group_ctx->use_streaming = true;
+
+    RETURN_IF_ERROR(_exec_env->stream_load_executor()->begin_txn(group_ctx));
+
+    TStreamLoadPutRequest put_request = request;
+    put_request.txnId = group_ctx->txn_id;
+    put_request.__set_loadId(group_ctx->id.to_thrift());
+    put_request.fileType = TFileType::FILE_STREAM;
+    group->pipe = std::make_shared<StreamLoadPipe>();
+    RETURN_IF_ERROR(_exec_env->load_stream_mgr()->put(group_ctx->id, group->pipe));
+    group_ctx->body_sink = group->pipe;
+
+#ifndef BE_TEST
+    TNetworkAddress master_addr = _exec_env->master_info()->network_address;
+    RETURN_IF_ERROR(ThriftRpcHelper::rpc<FrontendServiceClient>(
+            master_addr.hostname, master_addr.port, [&put_request, group_ctx](FrontendServiceConnection& client) {
+                client->streamLoadPut(group_ctx->put_result, put_request);
+            }));
+#else
+    group_ctx->put_result = k_stream_load_put_result;
+#endif
+    RETURN_IF_ERROR(Status(group_ctx->put_result.status));
+    return _exec_env->stream_load_executor()->execute_plan_fragment(group_ctx);
+}
+
+Status StreamLoadGroupCommitMgr::_append(Group* group, const std::string& body) {
+    Status st;
+    {
+        std::unique_lock l(group->mutex);
+        group->cv.wait(l, [group] { return group->begun; });
+        st = group->status;
+    }
+    if (st.ok()) {
+        std::lock_guard l(group->append_mutex);
+        st = group->pipe->append(body.data(), body.size());
+    }
+    std::lock_guard l(group->mutex);
+    // The body may be partly appended, so the group fails as well.
+    if (group->status.ok() && !st.ok()) {
+        group->status = st;
+    }
+    group->pending_loads--;
+    group->cv.notify_all();
+    return st;
+}
+
+void StreamLoadGroupCommitMgr::_commit(Group* group) {
+    {
+        std::unique_lock l(group->mutex);
+        auto deadline = group->begin_time + std::chrono::milliseconds(config::stream_load_group_commit_interval_ms);
+        group->cv.wait_until(l, deadline, [group] { return group->closed || !group->status.ok(); });
+    }
+    {
+        std::lock_guard l(_mutex);
+        auto iter = _groups.find(group->key);
+        if (iter != _groups.end() && iter->second.get() == group) {
+            _groups.erase(iter);
+        }
+    }
+
+    Status st;
+    {
+        std::unique_lock l(group->mutex);
+        group->closed = true;
+        group->cv.wait(l, [group] { return group->pending_loads == 0; });
+        st = group->status;
+    }
+    if (st.ok()) {
+        st = _finish(group);
+    } else if (group->pipe != nullptr) {
+        group->pipe->cancel();
+    }
+    StreamLoadContext* group_ctx = group->ctx;
+    if (!st.ok() && group_ctx != nullptr && group_ctx->need_rollback) {
+        _exec_env->stream_load_executor()->rollback_txn(group_ctx);
+        group_ctx->need_rollback = false;
+    }
+
+    std::lock_guard l(group->mutex);
+    group->status = st;
+    group->done = true;
+    group->cv.notify_all();
+}
+
+Status StreamLoadGroupCommitMgr::_finish(Group* group) {
+    StreamLoadContext* group_ctx = group->ctx;
+    RETURN_IF_ERROR(group->pipe->finish());
+    RETURN_IF_ERROR(group_ctx->future.get());
+    int64_t commit_and_publish_start_time = MonotonicNanos();
+    RETURN_IF_ERROR(_exec_env->stream_load_executor()->commit_txn(group_ctx));
+    group_ctx->commit_and_publish_txn_cost_nanos = MonotonicNanos() - commit_and_publish_start_time;
+    LOG(INFO) << "committed the group of stream loads, " << group_ctx->brief() << ", bytes=" << group->bytes;
+    return Status::OK();
+}
+
+} // namespace starrocks
@@ -0,0 +1,70 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/status.h"
+#include "gen_cpp/FrontendService_types.h"
+#include "runtime/message_body_sink.h"
+
+namespace starrocks {
+
+class ExecEnv;
+class StreamLoadContext;
+
+// Buffer the whole body of a stream load in memory, so that it's appended to the body of its group at once
+// instead of interleaving with the bodies of the other loads.
+class GroupCommitBodySink final : public MessageBodySink {
+public:
+    Status append(const char* data, size_t size) override {
+        _body.append(data, size);
+        return Status::OK();
+    }
+
+    std::string* body() { return &_body; }
+
+private:
+    std::string _body;
+};
+
+// StreamLoadGroupCommitMgr merges the concurrent small stream loads into the same table with the same properties,
+// so that they are loaded by one transaction, instead of one transaction and one tiny rowset each.
+//
+// The first load of a group begins the transaction and the plan of the group, whose body is the concatenation of
+// the bodies of its loads. The group is committed once it has been open for `stream_load_group_commit_interval_ms`,
+// or its body has reached `stream_load_group_commit_max_bytes`, then every load of it returns the status of the
+// group. Only the CSV loads delimited by '\n' are merged. A load of a group shares the transaction and the
+// statistics of the group, and its label is not registered in the FE, so it's not deduplicated by the label.
+class StreamLoadGroupCommitMgr {
+public:
+    explicit StreamLoadGroupCommitMgr(ExecEnv* exec_env) : _exec_env(exec_env) {}
+
+    // Load |body|, the whole body of |ctx|, by the group of the loads planned by |request|, which is the request
+    // to plan |ctx| except the transaction, the load id and the file. Return after the group is committed, with
+    // the transaction and the statistics of the group filled into |ctx|.
+    Status load(StreamLoadContext* ctx, const TStreamLoadPutRequest& request, std::string* body);
+
+private:
+    struct Group;
+
+    static std::string _group_key(const StreamLoadContext* ctx, const TStreamLoadPutRequest& request);
+
+    // Begin the transaction and the plan of |group| by the properties of its first load |ctx|.
+    Status _begin(Group* group, const StreamLoadContext* ctx, const TStreamLoadPutRequest& request);
+    Status _append(Group* group, const std::string& body);
+    // Close |group| once it's full or expired, and commit it after the bodies of its loads are appended.
+    void _commit(Group* group);
+    Status _finish(Group* group);
+
+    ExecEnv* _exec_env;
+
+    std::mutex _mutex;
+    // the open groups by their keys, a group is removed once it's closed.
+    std::unordered_map<std::string, std::shared_ptr<Group>> _groups;
+};
+
+} // namespace starrocks
@@ -24,12 +24,17 @@
 #include "exec/tablet_info.h"
 #include "gutil/stl_util.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/exec_env.h"
 #include "runtime/row_batch.h"
 #include "runtime/tuple_row.h"
+#include "service/backend_options.h"
 #include "storage/delta_writer.h"
 #include "storage/memtable.h"
 #include "storage/vectorized/delta_writer.h"
 #include "storage/vectorized/memtable.h"
+#include "util/brpc_stub_cache.h"
+#include "util/coding.h"
+#include "util/ref_count_closure.h"
 #include "util/starrocks_metrics.h"
 
 namespace starrocks {
@@ -149,7 +154,10 @@ Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
 
     vectorized::Chunk chunk;
     RETURN_IF_ERROR(chunk.deserialize((const uint8_t*)pchunk.data().data(), pchunk.data().size(), _chunk_meta));
-    DCHECK_EQ(params.tablet_ids_size(), chunk.num_rows());
+
+    // the channel index of each row, looked up once per row.
+    std::vector<uint32_t> row_channel_indexes(chunk.num_rows());
+    RETURN_IF_ERROR(_compute_row_channel_indexes(params, chunk.num_rows(), &row_channel_indexes));
 
     size_t channel_size = _tablet_id_to_sorted_indexes.size();
     std::vector<uint32_t> row_indexes(chunk.num_rows());
@@ -157,8 +165,7 @@ Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
     {
         // compute row indexes for each channel
         channel_row_idx_start_points.assign(channel_size + 1, 0);
-        for (uint32_t i = 0; i < params.tablet_ids_size(); ++i) {
-            uint32_t channel_index = _tablet_id_to_sorted_indexes[params.tablet_ids(i)];
+        for (uint32_t channel_index : row_channel_indexes) {
             channel_row_idx_start_points[channel_index]++;
         }
 
@@ -167,8 +174,8 @@ Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
             channel_row_idx_start_points[i] += channel_row_idx_start_points[i - 1];
         }
 
-        for (int i = params.tablet_ids_size() - 1; i >= 0; --i) {
-            uint32_t channel_index = _tablet_id_to_sorted_indexes[params.tablet_ids(i)];
+        for (int i = static_cast<int>(row_channel_indexes.size()) - 1; i >= 0; --i) {
+            uint32_t channel_index = row_channel_indexes[i];
             row_indexes[channel_row_idx_start_points[channel_index] - 1] = i;
             channel_row_idx_start_points[channel_index]--;
         }
@@ -181,7 +188,7 @@ Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
             // no data for this channel continue;
             continue;
         }
-        auto tablet_id = params.tablet_ids(row_indexes[from]);
+        auto tablet_id = _sorted_tablet_ids[i];
         auto it = _vectorized_tablet_writers.find(tablet_id);
         if (it == std::end(_vectorized_tablet_writers)) {
             return Status::InternalError(strings::Substitute("unknown tablet to append data, tablet=$0", tablet_id));
@@ -202,6 +209,55 @@ Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
     return Status::OK();
 }
 
+Status TabletsChannel::_compute_row_channel_indexes(const PTabletWriterAddChunkRequest& params, size_t num_rows,
+                                                    std::vector<uint32_t>* row_channel_indexes) {
+    auto find_channel_index = [this](int64_t tablet_id, uint32_t* channel_index) {
+        auto it = _tablet_id_to_sorted_indexes.find(tablet_id);
+        if (it == _tablet_id_to_sorted_indexes.end()) {
+            return Status::InternalError(strings::Substitute("unknown tablet to append data, tablet=$0", tablet_id));
+        }
+        *channel_index = it->second;
+        return Status::OK();
+    };
+
+    if (params.tablet_id_dict_size() == 0) {
+        if (UNLIKELY(params.tablet_ids_size() != num_rows)) {
+            return Status::InternalError(strings::Substitute("mismatched tablet ids, tablet_ids=$0, rows=$1",
+                                                             params.tablet_ids_size(), num_rows));
+        }
+        // the rows of the same tablet are often adjacent.
+        int64_t last_tablet_id = -1;
+        uint32_t last_channel_index = 0;
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (params.tablet_ids(i) != last_tablet_id) {
+                last_tablet_id = params.tablet_ids(i);
+                RETURN_IF_ERROR(find_channel_index(last_tablet_id, &last_channel_index));
+            }
+            (*row_channel_indexes)[i] = last_channel_index;
+        }
+        return Status::OK();
+    }
+
+    const std::string& tablet_indexes = params.tablet_indexes();
+    if (UNLIKELY(tablet_indexes.size() != num_rows * sizeof(uint32_t))) {
+        return Status::InternalError(strings::Substitute("mismatched tablet indexes, bytes=$0, rows=$1",
+                                                         tablet_indexes.size(), num_rows));
+    }
+    std::vector<uint32_t> dict_channel_indexes(params.tablet_id_dict_size());
+    for (int i = 0; i < params.tablet_id_dict_size(); ++i) {
+        RETURN_IF_ERROR(find_channel_index(params.tablet_id_dict(i), &dict_channel_indexes[i]));
+    }
+    const auto* data = reinterpret_cast<const uint8_t*>(tablet_indexes.data());
+    for (size_t i = 0; i < num_rows; ++i) {
+        uint32_t dict_index = decode_fixed32_le(data + i * sizeof(uint32_t));
+        if (UNLIKELY(dict_index >= dict_channel_indexes.size())) {
+            return Status::InternalError(strings::Substitute("invalid tablet index $0", dict_index));
+        }
+        (*row_channel_indexes)[i] = dict_channel_indexes[dict_index];
+    }
+    return Status::OK();
+}
+
 Status TabletsChannel::_build_chunk_meta(const ChunkPB& pb_chunk) {
     if (UNLIKELY(pb_chunk.is_nulls().empty() || pb_chunk.slot_id_map().empty())) {
         return Status::InternalError("pb_chunk meta could not be empty");
@@ -310,6 +366,7 @@ Status TabletsChannel::close(int sender_id, bool* finished,
                 if (!st.ok()) {
                     LOG(WARNING) << "Fail to close tablet writer, tablet_id=" << it.first
                                  << " transaction_id=" << _txn_id << " err=" << st.to_string();
+                    _replicate_rowset(it.first, st, nullptr);
                     // just skip this tablet(writer) and continue to close others
                     continue;
                 }
@@ -331,13 +388,79 @@ Status TabletsChannel::close(int sender_id, bool* finished,
             std::lock_guard<std::mutex> l(_tablet_locks[it.first & k_shard_size]);
             // close may return failed, but no need to handle it here.
             // tablet_vec will only contains success tablet, and then let FE judge it.
-            it.second->close_wait(tablet_vec);
+            auto st = it.second->close_wait(tablet_vec);
+            _replicate_rowset(it.first, st, it.second->committed_rowset());
         }
     }
 
     return Status::OK();
 }
 
+// Log the failure of the replication, the secondary replica doesn't report the tablet then.
+class ReplicateRowsetClosure final : public RefCountClosure<PTabletWriterAddRowsetResult> {
+public:
+    ReplicateRowsetClosure(int64_t tablet_id, std::string host) : _tablet_id(tablet_id), _host(std::move(host)) {}
+
+    void Run() override {
+        if (cntl.Failed()) {
+            LOG(WARNING) << "Fail to replicate rowset to " << _host << ", tablet_id=" << _tablet_id
+                         << ", err=" << cntl.ErrorText();
+        } else if (result.status().status_code() != TStatusCode::OK) {
+            LOG(WARNING) << "Fail to replicate rowset to " << _host << ", tablet_id=" << _tablet_id
+                         << ", err=" << Status(result.status()).to_string();
+        }
+        RefCountClosure<PTabletWriterAddRowsetResult>::Run();
+    }
+
+private:
+    int64_t _tablet_id;
+    std::string _host;
+};
+
+void TabletsChannel::_replicate_rowset(int64_t tablet_id, const Status& status, const RowsetSharedPtr& rowset) {
+    auto replicas = _secondary_replicas.find(tablet_id);
+    if (replicas == _secondary_replicas.end()) {
+        return;
+    }
+    PTabletWriterAddRowsetRequest request;
+    *request.mutable_id() = _key.id.to_proto();
+    request.set_index_id(_key.index_id);
+    request.set_tablet_id(tablet_id);
+    if (status.ok()) {
+        RowsetMetaPB rowset_meta_pb;
+        rowset->rowset_meta()->to_rowset_pb(&rowset_meta_pb);
+        request.set_rowset_meta(rowset_meta_pb.SerializeAsString());
+        request.set_source_host(BackendOptions::get_localhost());
+        request.set_source_http_port(config::webserver_port);
+        request.set_source_rowset_path(rowset->rowset_path());
+        request.set_token(ExecEnv::GetInstance()->token());
+    } else {
+        status.to_protobuf(request.mutable_status());
+    }
+    for (const auto& replica : replicas->second) {
+        auto* stub = ExecEnv::GetInstance()->brpc_stub_cache()->get_stub(replica.host(), replica.port());
+        if (stub == nullptr) {
+            LOG(WARNING) << "Fail to get brpc stub of " << replica.host() << ":" << replica.port();
+            continue;
+        }
+        auto* closure = new ReplicateRowsetClosure(tablet_id, replica.host());
+        closure->ref();
+        closure->cntl.set_timeout_ms(config::tablet_writer_replicate_rowset_timeout_sec * 1000);
+        stub->tablet_writer_add_rowset(&closure->cntl, &request, &closure->result, closure);
+    }
+}
+
+Status TabletsChannel::add_rowset(const PTabletWriterAddRowsetRequest& request) {
+    // the writers are only changed by open(), and replicate_rowset() is synchronized with close_wait() by itself,
+    // which holds the tablet lock while waiting for the rowset.
+    auto it = _vectorized_tablet_writers.find(request.tablet_id());
+    if (it == _vectorized_tablet_writers.end()) {
+        return Status::InternalError(
+                strings::Substitute("unknown tablet to add rowset, tablet=$0", request.tablet_id()));
+    }
+    return it->second->replicate_rowset(request);
+}
+
 Status TabletsChannel::reduce_mem_usage_async(const std::set<int64_t>& flush_tablet_ids, int64_t* tablet_id,
                                               int64_t* tablet_mem_consumption) {
     vectorized::DeltaWriter* vectorized_writer = nullptr;
@@ -427,6 +550,35 @@ Status TabletsChannel::wait_mem_usage_reduced(int64_t tablet_id) {
     return Status::OK();
 }
 
+void TabletsChannel::get_tablet_mem_usages(std::vector<TabletMemUsage>* usages) {
+    std::lock_guard<std::mutex> l(_global_lock);
+    if (_state != kOpened || !_is_vectorized) {
+        return;
+    }
+    for (auto& it : _vectorized_tablet_writers) {
+        const int64_t memtable_consumption = it.second->memtable_consumption();
+        const int64_t flushing_consumption = std::max<int64_t>(0, it.second->mem_consumption() - memtable_consumption);
+        usages->push_back({it.first, memtable_consumption, flushing_consumption});
+    }
+}
+
+Status TabletsChannel::flush_tablet_async(int64_t tablet_id) {
+    vectorized::DeltaWriter* vectorized_writer = nullptr;
+    {
+        std::lock_guard<std::mutex> l(_global_lock);
+        if (_state == kFinished) {
+            return _close_status;
+        }
+        auto it = _vectorized_tablet_writers.find(tablet_id);
+        if (it == _vectorized_tablet_writers.end()) {
+            return Status::InternalError(strings::Substitute("tablet writer is not found. tablet id: $0", tablet_id));
+        }
+        vectorized_writer = it->second;
+    }
+    std::lock_guard<std::mutex> l(_tablet_locks[tablet_id & k_shard_size]);
+    return vectorized_writer->flush_memtable_async();
+}
+
 Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& params) {
     std::vector<SlotDescriptor*>* index_slots = nullptr;
     int32_t schema_hash = 0;
@@ -455,6 +607,12 @@ Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& params)
             request.load_id = params.id();
             request.tuple_desc = _tuple_desc;
             request.slots = index_slots;
+            request.is_secondary_replica = tablet.is_secondary_replica();
+            if (tablet.secondary_replicas_size() > 0) {
+                _secondary_replicas.emplace(tablet.tablet_id(),
+                                            std::vector<PNetworkAddress>(tablet.secondary_replicas().begin(),
+                                                                         tablet.secondary_replicas().end()));
+            }
 
             vectorized::DeltaWriter* writer = nullptr;
             auto st = vectorized::DeltaWriter::open(&request, _mem_tracker.get(), &writer);
@@ -475,6 +633,7 @@ Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& params)
         for (size_t i = 0; i < tablet_ids.size(); ++i) {
             _tablet_id_to_sorted_indexes.emplace(tablet_ids[i], i);
         }
+        _sorted_tablet_ids = std::move(tablet_ids);
     } else {
         for (auto& tablet : params.tablets()) {
             WriteRequest request;
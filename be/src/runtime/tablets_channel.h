@@ -20,6 +20,7 @@
 // under the License.
 
 #include <cstdint>
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -36,6 +37,9 @@
 
 namespace starrocks {
 
+class Rowset;
+using RowsetSharedPtr = std::shared_ptr<Rowset>;
+
 namespace vectorized {
 class DeltaWriter;
 }
@@ -58,6 +62,15 @@ std::ostream& operator<<(std::ostream& os, const TabletsChannelKey& key);
 class DeltaWriter;
 class OlapTableSchemaParam;
 
+// The memory consumption of the memtables of a tablet writer.
+struct TabletMemUsage {
+    int64_t tablet_id;
+    // the memtable being written
+    int64_t memtable_consumption;
+    // the memtables being flushed
+    int64_t flushing_consumption;
+};
+
 // Write channel for a particular (load, index).
 class TabletsChannel {
 public:
@@ -83,6 +96,9 @@ public:
     // no-op when this channel has been closed or cancelled
     Status cancel();
 
+    // Commit the rowset of the primary replica of a tablet, if this is a secondary replica in the replicated storage.
+    Status add_rowset(const PTabletWriterAddRowsetRequest& request);
+
     // upper application may call this to try to reduce the mem usage of this channel.
     // eg. flush the largest memtable async.
     // no-op when this channel has been closed or cancelled.
@@ -92,6 +108,12 @@ public:
     // wait tablet memtables in flush queue to be flushed.
     Status wait_mem_usage_reduced(int64_t tablet_id);
 
+    // Append the memory usages of the vectorized tablet writers to |usages|, for LoadChannelMgr to pick the
+    // memtables to flush among all the loads. no-op unless this channel is opened.
+    void get_tablet_mem_usages(std::vector<TabletMemUsage>* usages);
+    // Submit the memtable of |tablet_id| to the flush queue, no-op when this channel has been closed or cancelled.
+    Status flush_tablet_async(int64_t tablet_id);
+
     int64_t mem_consumption() const { return _mem_tracker->consumption(); }
 
 private:
@@ -100,6 +122,15 @@ private:
 
     Status _build_chunk_meta(const ChunkPB& pb_chunk);
 
+    // Compute the index in |_sorted_tablet_ids| of the tablet of each row, by the tablet_id_dict and tablet_indexes
+    // of |params| if set, or by the tablet_ids.
+    // Send the rowset committed by the primary replica of |tablet_id|, or the failure |status|, to its secondary
+    // replicas asynchronously.
+    void _replicate_rowset(int64_t tablet_id, const Status& status, const RowsetSharedPtr& rowset);
+
+    Status _compute_row_channel_indexes(const PTabletWriterAddChunkRequest& params, size_t num_rows,
+                                        std::vector<uint32_t>* row_channel_indexes);
+
     // id of this load channel
     TabletsChannelKey _key;
 
@@ -143,6 +174,9 @@ private:
     bool _is_vectorized = false;
     vectorized::RuntimeChunkMeta _chunk_meta;
     std::unordered_map<int64_t, uint32_t> _tablet_id_to_sorted_indexes;
+    std::vector<int64_t> _sorted_tablet_ids;
+    // tablet_id -> the secondary replicas, for the tablets whose primary replica is this channel.
+    std::unordered_map<int64_t, std::vector<PNetworkAddress>> _secondary_replicas;
     // tablet_id -> TabletChannel
     std::unordered_map<int64_t, vectorized::DeltaWriter*> _vectorized_tablet_writers;
 };
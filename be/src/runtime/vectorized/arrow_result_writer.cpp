@@ -0,0 +1,82 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/vectorized/arrow_result_writer.h"
+
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+
+#include "column/chunk.h"
+#include "gen_cpp/InternalService_types.h"
+#include "runtime/buffer_control_block.h"
+#include "runtime/vectorized/chunk_to_arrow.h"
+#include "util/arrow/row_batch.h"
+
+namespace starrocks {
+namespace vectorized {
+
+ArrowResultWriter::ArrowResultWriter(BufferControlBlock* sinker, const std::vector<ExprContext*>& output_expr_ctxs,
+                                     RuntimeProfile* parent_profile)
+        : _sinker(sinker), _output_expr_ctxs(output_expr_ctxs), _parent_profile(parent_profile) {}
+
+ArrowResultWriter::~ArrowResultWriter() = default;
+
+Status ArrowResultWriter::init(RuntimeState* state) {
+    _init_profile();
+    if (nullptr == _sinker) {
+        return Status::InternalError("sinker is nullptr.");
+    }
+    return _init_schema();
+}
+
+void ArrowResultWriter::_init_profile() {
+    _append_chunk_timer = ADD_TIMER(_parent_profile, "AppendChunkTime");
+    _convert_timer = ADD_CHILD_TIMER(_parent_profile, "ArrowConvertTime", "AppendChunkTime");
+    _result_send_timer = ADD_CHILD_TIMER(_parent_profile, "ResultSendTime", "AppendChunkTime");
+    _sent_rows_counter = ADD_COUNTER(_parent_profile, "NumSentRows", TUnit::UNIT);
+}
+
+Status ArrowResultWriter::_init_schema() {
+    return convert_to_arrow_schema(_output_expr_ctxs, &_schema);
+}
+
+Status ArrowResultWriter::append_row_batch(const RowBatch* batch) {
+    return Status::NotSupported("Arrow result writer not support None-vectorized");
+}
+
+Status ArrowResultWriter::append_chunk(vectorized::Chunk* chunk) {
+    SCOPED_TIMER(_append_chunk_timer);
+    if (nullptr == chunk || 0 == chunk->num_rows()) {
+        return Status::OK();
+    }
+    auto result = std::make_unique<TFetchDataResult>();
+    result->result_batch.rows.resize(1);
+    RETURN_IF_ERROR(_serialize_chunk(chunk, &result->result_batch.rows[0]));
+
+    SCOPED_TIMER(_result_send_timer);
+    auto num_rows = chunk->num_rows();
+    // Note: add_batch takes the result only if it succeeds.
+    Status status = _sinker->add_batch(result.get());
+    if (!status.ok()) {
+        LOG(WARNING) << "Append arrow result to sink failed: " << status.to_string();
+        return status;
+    }
+    result.release();
+    _written_rows += num_rows;
+    return Status::OK();
+}
+
+Status ArrowResultWriter::_serialize_chunk(vectorized::Chunk* chunk, std::string* result) {
+    SCOPED_TIMER(_convert_timer);
+    std::shared_ptr<arrow::RecordBatch> record_batch;
+    RETURN_IF_ERROR(convert_chunk_to_arrow(_output_expr_ctxs, _schema, chunk, arrow::default_memory_pool(),
+                                           &record_batch));
+    return serialize_record_batch(*record_batch, result);
+}
+
+Status ArrowResultWriter::close() {
+    COUNTER_SET(_sent_rows_counter, _written_rows);
+    return Status::OK();
+}
+
+} // namespace vectorized
+} // namespace starrocks
@@ -0,0 +1,69 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+
+#include "runtime/result_writer.h"
+#include "runtime/runtime_state.h"
+
+namespace arrow {
+class Schema;
+} // namespace arrow
+
+namespace starrocks {
+
+class ExprContext;
+class BufferControlBlock;
+class RuntimeProfile;
+
+namespace vectorized {
+
+// ArrowResultWriter sends the results as Arrow record batches instead of the rows of the MySQL protocol, so that
+// the clients reading big results get the columns without formatting and parsing every value as text.
+//
+// Every chunk is converted into a record batch, which is serialized as an Arrow IPC stream with its schema into
+// the only row of a TFetchDataResult, so the batches are queued and fetched as the MySQL results are. The field i
+// of the schema is named "c<i>" after the i-th output expr.
+class ArrowResultWriter final : public ResultWriter {
+public:
+    ArrowResultWriter(BufferControlBlock* sinker, const std::vector<ExprContext*>& output_expr_ctxs,
+                      RuntimeProfile* parent_profile);
+
+    ~ArrowResultWriter() override;
+
+    Status init(RuntimeState* state) override;
+
+    Status append_row_batch(const RowBatch* batch) override;
+
+    Status append_chunk(vectorized::Chunk* chunk) override;
+
+    Status close() override;
+
+private:
+    void _init_profile();
+
+    Status _init_schema();
+
+    // Convert |chunk| into a record batch and serialize it into |result|.
+    Status _serialize_chunk(vectorized::Chunk* chunk, std::string* result);
+
+private:
+    BufferControlBlock* _sinker;
+    const std::vector<ExprContext*>& _output_expr_ctxs;
+    std::shared_ptr<arrow::Schema> _schema;
+
+    // parent profile from result sink. not owned
+    RuntimeProfile* _parent_profile;
+    // total time cost on append chunk operation
+    RuntimeProfile::Counter* _append_chunk_timer = nullptr;
+    // convert and serialize timer, child timer of _append_chunk_timer
+    RuntimeProfile::Counter* _convert_timer = nullptr;
+    // result send timer, child timer of _append_chunk_timer
+    RuntimeProfile::Counter* _result_send_timer = nullptr;
+    // number of sent rows
+    RuntimeProfile::Counter* _sent_rows_counter = nullptr;
+};
+
+} // namespace vectorized
+} // namespace starrocks
@@ -0,0 +1,253 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/vectorized/chunk_to_arrow.h"
+
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/status.h>
+#include <arrow/type.h>
+#include <arrow/util/string_view.h>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/large_int_value.h"
+#include "util/arrow/utils.h"
+
+namespace starrocks {
+namespace vectorized {
+
+namespace {
+
+// The same types as the ones of the arrow conversions of RowBatch, except that the boolean and the decimal v3
+// types keep their own types instead of being widened.
+Status to_arrow_type(const TypeDescriptor& type, std::shared_ptr<arrow::DataType>* result) {
+    switch (type.type) {
+    case TYPE_NULL:
+        *result = arrow::null();
+        break;
+    case TYPE_BOOLEAN:
+        *result = arrow::boolean();
+        break;
+    case TYPE_TINYINT:
+        *result = arrow::int8();
+        break;
+    case TYPE_SMALLINT:
+        *result = arrow::int16();
+        break;
+    case TYPE_INT:
+        *result = arrow::int32();
+        break;
+    case TYPE_BIGINT:
+        *result = arrow::int64();
+        break;
+    case TYPE_FLOAT:
+        *result = arrow::float32();
+        break;
+    case TYPE_DOUBLE:
+    case TYPE_TIME:
+        *result = arrow::float64();
+        break;
+    case TYPE_VARCHAR:
+    case TYPE_CHAR:
+    case TYPE_LARGEINT:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+        *result = arrow::utf8();
+        break;
+    case TYPE_DECIMALV2:
+        *result = std::make_shared<arrow::Decimal128Type>(27, 9);
+        break;
+    case TYPE_DECIMAL32:
+    case TYPE_DECIMAL64:
+    case TYPE_DECIMAL128:
+        *result = std::make_shared<arrow::Decimal128Type>(type.precision, type.scale);
+        break;
+    default:
+        return Status::NotSupported(strings::Substitute("Unsupported type of arrow result: $0", type.debug_string()));
+    }
+    return Status::OK();
+}
+
+const uint8_t* null_data(const Column& column) {
+    if (!column.is_nullable()) {
+        return nullptr;
+    }
+    return down_cast<const NullableColumn&>(column).immutable_null_column_data().data();
+}
+
+// Build the array of the fixed length |column| at once, whose values are of the same layout in arrow.
+template <PrimitiveType PT, typename BuilderType>
+arrow::Status build_fixed_length_array(const Column& column, BuilderType* builder,
+                                       std::shared_ptr<arrow::Array>* array) {
+    const size_t num_rows = column.size();
+    const auto& data = down_cast<const RunTimeColumnType<PT>*>(ColumnHelper::get_data_column(&column))->get_data();
+    std::vector<uint8_t> valid_bytes;
+    if (const uint8_t* nulls = null_data(column); nulls != nullptr) {
+        valid_bytes.resize(num_rows);
+        for (size_t i = 0; i < num_rows; i++) {
+            valid_bytes[i] = !nulls[i];
+        }
+    }
+    const uint8_t* valid = valid_bytes.empty() ? nullptr : valid_bytes.data();
+    ARROW_RETURN_NOT_OK(builder->AppendValues(data.data(), num_rows, valid));
+    return builder->Finish(array);
+}
+
+// Build the array of |column| value by value, |value_of| gets the arrow value of a row from the data column.
+template <typename BuilderType, typename ValueOf>
+arrow::Status build_array(const Column& column, BuilderType* builder, ValueOf&& value_of,
+                          std::shared_ptr<arrow::Array>* array) {
+    const size_t num_rows = column.size();
+    const uint8_t* nulls = null_data(column);
+    const Column* data = ColumnHelper::get_data_column(&column);
+    ARROW_RETURN_NOT_OK(builder->Reserve(num_rows));
+    for (size_t i = 0; i < num_rows; i++) {
+        if (nulls != nullptr && nulls[i]) {
+            ARROW_RETURN_NOT_OK(builder->AppendNull());
+        } else {
+            ARROW_RETURN_NOT_OK(builder->Append(value_of(data, i)));
+        }
+    }
+    return builder->Finish(array);
+}
+
+template <PrimitiveType PT>
+arrow::Decimal128 to_arrow_decimal(const Column* data, size_t row) {
+    int128_t value = down_cast<const RunTimeColumnType<PT>*>(data)->get_data()[row];
+    return arrow::Decimal128(static_cast<int64_t>(value >> 64), static_cast<uint64_t>(value));
+}
+
+template <PrimitiveType PT>
+std::string to_arrow_string(const Column* data, size_t row) {
+    return down_cast<const RunTimeColumnType<PT>*>(data)->get_data()[row].to_string();
+}
+
+arrow::Status to_arrow_array(const TypeDescriptor& type, const Column& column,
+                             const std::shared_ptr<arrow::DataType>& arrow_type, arrow::MemoryPool* pool,
+                             std::shared_ptr<arrow::Array>* array) {
+    switch (type.type) {
+    case TYPE_BOOLEAN: {
+        arrow::BooleanBuilder builder(pool);
+        return build_fixed_length_array<TYPE_BOOLEAN>(column, &builder, array);
+    }
+    case TYPE_TINYINT: {
+        arrow::Int8Builder builder(pool);
+        return build_fixed_length_array<TYPE_TINYINT>(column, &builder, array);
+    }
+    case TYPE_SMALLINT: {
+        arrow::Int16Builder builder(pool);
+        return build_fixed_length_array<TYPE_SMALLINT>(column, &builder, array);
+    }
+    case TYPE_INT: {
+        arrow::Int32Builder builder(pool);
+        return build_fixed_length_array<TYPE_INT>(column, &builder, array);
+    }
+    case TYPE_BIGINT: {
+        arrow::Int64Builder builder(pool);
+        return build_fixed_length_array<TYPE_BIGINT>(column, &builder, array);
+    }
+    case TYPE_FLOAT: {
+        arrow::FloatBuilder builder(pool);
+        return build_fixed_length_array<TYPE_FLOAT>(column, &builder, array);
+    }
+    case TYPE_DOUBLE: {
+        arrow::DoubleBuilder builder(pool);
+        return build_fixed_length_array<TYPE_DOUBLE>(column, &builder, array);
+    }
+    case TYPE_TIME: {
+        arrow::DoubleBuilder builder(pool);
+        return build_fixed_length_array<TYPE_TIME>(column, &builder, array);
+    }
+    case TYPE_VARCHAR:
+    case TYPE_CHAR: {
+        arrow::StringBuilder builder(pool);
+        auto value_of = [](const Column* data, size_t row) {
+            Slice slice = down_cast<const BinaryColumn*>(data)->get_slice(row);
+            return arrow::util::string_view(slice.data, slice.size);
+        };
+        return build_array(column, &builder, value_of, array);
+    }
+    case TYPE_LARGEINT: {
+        arrow::StringBuilder builder(pool);
+        auto value_of = [](const Column* data, size_t row) {
+            return LargeIntValue::to_string(down_cast<const RunTimeColumnType<TYPE_LARGEINT>*>(data)->get_data()[row]);
+        };
+        return build_array(column, &builder, value_of, array);
+    }
+    case TYPE_DATE: {
+        arrow::StringBuilder builder(pool);
+        return build_array(column, &builder, to_arrow_string<TYPE_DATE>, array);
+    }
+    case TYPE_DATETIME: {
+        arrow::StringBuilder builder(pool);
+        return build_array(column, &builder, to_arrow_string<TYPE_DATETIME>, array);
+    }
+    case TYPE_DECIMALV2: {
+        arrow::Decimal128Builder builder(arrow_type, pool);
+        auto value_of = [](const Column* data, size_t row) {
+            int128_t value = down_cast<const RunTimeColumnType<TYPE_DECIMALV2>*>(data)->get_data()[row].value();
+            return arrow::Decimal128(static_cast<int64_t>(value >> 64), static_cast<uint64_t>(value));
+        };
+        return build_array(column, &builder, value_of, array);
+    }
+    case TYPE_DECIMAL32: {
+        arrow::Decimal128Builder builder(arrow_type, pool);
+        return build_array(column, &builder, to_arrow_decimal<TYPE_DECIMAL32>, array);
+    }
+    case TYPE_DECIMAL64: {
+        arrow::Decimal128Builder builder(arrow_type, pool);
+        return build_array(column, &builder, to_arrow_decimal<TYPE_DECIMAL64>, array);
+    }
+    case TYPE_DECIMAL128: {
+        arrow::Decimal128Builder builder(arrow_type, pool);
+        return build_array(column, &builder, to_arrow_decimal<TYPE_DECIMAL128>, array);
+    }
+    default:
+        return arrow::Status::TypeError("unsupported column type of arrow result");
+    }
+}
+
+} // namespace
+
+Status convert_to_arrow_schema(const std::vector<ExprContext*>& output_expr_ctxs,
+                               std::shared_ptr<arrow::Schema>* result) {
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    fields.reserve(output_expr_ctxs.size());
+    for (size_t i = 0; i < output_expr_ctxs.size(); i++) {
+        const Expr* root = output_expr_ctxs[i]->root();
+        std::shared_ptr<arrow::DataType> type;
+        RETURN_IF_ERROR(to_arrow_type(root->type(), &type));
+        fields.emplace_back(arrow::field(strings::Substitute("c$0", i), type, root->is_nullable()));
+    }
+    *result = arrow::schema(std::move(fields));
+    return Status::OK();
+}
+
+Status convert_chunk_to_arrow(const std::vector<ExprContext*>& output_expr_ctxs,
+                              const std::shared_ptr<arrow::Schema>& schema, Chunk* chunk, arrow::MemoryPool* pool,
+                              std::shared_ptr<arrow::RecordBatch>* result) {
+    const size_t num_rows = chunk->num_rows();
+    std::vector<std::shared_ptr<arrow::Array>> arrays(output_expr_ctxs.size());
+    for (size_t i = 0; i < output_expr_ctxs.size(); i++) {
+        const TypeDescriptor& type = output_expr_ctxs[i]->root()->type();
+        if (type.type == TYPE_NULL) {
+            arrays[i] = std::make_shared<arrow::NullArray>(num_rows);
+            continue;
+        }
+        ColumnPtr column = output_expr_ctxs[i]->evaluate(chunk);
+        column = ColumnHelper::unfold_const_column(type, num_rows, column);
+        RETURN_IF_ERROR(to_status(to_arrow_array(type, *column, schema->field(i)->type(), pool, &arrays[i])));
+    }
+    *result = arrow::RecordBatch::Make(schema, num_rows, std::move(arrays));
+    return Status::OK();
+}
+
+} // namespace vectorized
+} // namespace starrocks
@@ -0,0 +1,35 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/status.h"
+
+namespace arrow {
+class MemoryPool;
+class RecordBatch;
+class Schema;
+} // namespace arrow
+
+namespace starrocks {
+
+class ExprContext;
+
+namespace vectorized {
+
+class Chunk;
+
+// Get the arrow schema of the results of |output_expr_ctxs|. The field i is named "c<i>" after the i-th expr.
+Status convert_to_arrow_schema(const std::vector<ExprContext*>& output_expr_ctxs,
+                               std::shared_ptr<arrow::Schema>* result);
+
+// Evaluate |output_expr_ctxs| on |chunk|, and convert the results into a record batch of |schema|, which is
+// got by convert_to_arrow_schema().
+Status convert_chunk_to_arrow(const std::vector<ExprContext*>& output_expr_ctxs,
+                              const std::shared_ptr<arrow::Schema>& schema, Chunk* chunk, arrow::MemoryPool* pool,
+                              std::shared_ptr<arrow::RecordBatch>* result);
+
+} // namespace vectorized
+} // namespace starrocks
@@ -16,20 +16,57 @@ Status SortedChunksMerger::init(const ChunkSuppliers& suppliers, const std::vect
         _single_supplier = suppliers[0];
     } else {
         _cursors.reserve(suppliers.size());
-        _min_heap.reserve(suppliers.size());
         for (auto& supplier : suppliers) {
             _cursors.emplace_back(std::make_unique<ChunkCursor>(supplier, sort_exprs, is_asc, is_null_first));
-            ChunkCursor* cursor = _cursors.rbegin()->get();
-            cursor->next();
-            if (cursor->is_valid()) {
-                _min_heap.push_back(cursor);
+            _cursors.back()->next();
+        }
+        // Play all the matches bottom up, |winners| are the winners of the nodes.
+        const int k = static_cast<int>(_cursors.size());
+        _loser_tree.assign(k, -1);
+        std::vector<int> winners(2 * k, -1);
+        for (int i = 0; i < k; ++i) {
+            winners[k + i] = i;
+        }
+        for (int n = k - 1; n >= 1; --n) {
+            int l = winners[2 * n];
+            int r = winners[2 * n + 1];
+            if (_is_before(r, l)) {
+                std::swap(l, r);
             }
+            winners[n] = l;
+            _loser_tree[n] = r;
+        }
+        if (k > 0) {
+            _loser_tree[0] = winners[1];
         }
-        std::make_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
     }
     return Status::OK();
 }
 
+void SortedChunksMerger::_replay(int cursor) {
+    const int k = static_cast<int>(_cursors.size());
+    int winner = cursor;
+    for (int n = (cursor + k) / 2; n >= 1; n /= 2) {
+        if (_is_before(_loser_tree[n], winner)) {
+            std::swap(_loser_tree[n], winner);
+        }
+    }
+    _loser_tree[0] = winner;
+}
+
+int SortedChunksMerger::_runner_up() const {
+    // The runner-up lost to the winner in one of the matches on the path of the winner.
+    const int k = static_cast<int>(_cursors.size());
+    int runner_up = -1;
+    for (int n = (_loser_tree[0] + k) / 2; n >= 1; n /= 2) {
+        int loser = _loser_tree[n];
+        if (_is_valid(loser) && (runner_up == -1 || _is_before(loser, runner_up))) {
+            runner_up = loser;
+        }
+    }
+    return runner_up;
+}
+
 void SortedChunksMerger::set_profile(RuntimeProfile* profile) {
     _total_timer = ADD_TIMER(profile, "MergeSortedChunks");
 }
@@ -54,50 +91,35 @@ Status SortedChunksMerger::get_next(ChunkPtr* chunk, bool* eos) {
     }
 
     // multiple sources
-    *eos = false;
-    ChunkCursor* cursor = _min_heap[0];
-    *chunk = cursor->clone_empty_chunk(config::vector_chunk_size);
-
-    ChunkPtr current_chunk = cursor->get_current_chunk();
-    std::vector<uint32_t> selective_values; // for append_selective call
-    selective_values.reserve(config::vector_chunk_size);
-    selective_values.push_back(cursor->get_current_position_in_chunk());
-    size_t row_number = 1;
-
-    std::pop_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
-    cursor->next();
-    if (cursor->is_valid()) {
-        std::push_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
-    } else {
-        _min_heap.pop_back();
+    if (_cursors.empty() || !_is_valid(_loser_tree[0])) {
+        *eos = true;
+        *chunk = nullptr;
+        return Status::OK();
     }
-
-    while (row_number < config::vector_chunk_size && !_min_heap.empty()) {
-        cursor = _min_heap[0];
-        const auto& ptr = cursor->get_current_chunk();
-        if (current_chunk == ptr) {
-            selective_values.push_back(cursor->get_current_position_in_chunk());
-        } else {
-            (*chunk)->append_selective(*current_chunk, selective_values.data(), 0, selective_values.size());
-            current_chunk = ptr;
-            selective_values.clear();
-            selective_values.push_back(cursor->get_current_position_in_chunk());
-        }
-
-        std::pop_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
-        cursor->next();
-        if (cursor->is_valid()) {
-            std::push_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
-        } else {
-            _min_heap.pop_back();
-        }
-
-        ++row_number;
+    *eos = false;
+    *chunk = _cursors[_loser_tree[0]]->clone_empty_chunk(config::vector_chunk_size);
+    size_t row_number = 0;
+    while (row_number < config::vector_chunk_size && _is_valid(_loser_tree[0])) {
+        const int winner = _loser_tree[0];
+        ChunkCursor* cursor = _cursors[winner].get();
+        const int runner_up = _runner_up();
+        const ChunkCursor* runner_up_cursor = runner_up == -1 ? nullptr : _cursors[runner_up].get();
+
+        // The rows of the winner are output until the runner-up is before it, or its chunk ends.
+        ChunkPtr current_chunk = cursor->get_current_chunk();
+        const size_t begin = cursor->get_current_position_in_chunk();
+        size_t count = 0;
+        do {
+            ++count;
+            ++row_number;
+            cursor->next();
+        } while (row_number < config::vector_chunk_size && cursor->is_valid() &&
+                 cursor->get_current_chunk() == current_chunk &&
+                 (runner_up_cursor == nullptr || *cursor < *runner_up_cursor));
+        (*chunk)->append(*current_chunk, begin, count);
+        _replay(winner);
     }
-
-    (*chunk)->append_selective(*current_chunk, selective_values.data(), 0, selective_values.size());
     (*chunk)->set_num_rows(row_number); // set constant column in chunk with right size.
-
     return Status::OK();
 }
 
@@ -2,7 +2,8 @@
 
 #pragma once
 
-#include <queue>
+#include <memory>
+#include <vector>
 
 #include "runtime/vectorized/chunk_cursor.h"
 #include "util/runtime_profile.h"
@@ -13,7 +14,8 @@ class SortExecExprs;
 
 namespace vectorized {
 
-// Merge a group of sorted Chunks to one Chunk in order.
+// Merge a group of sorted Chunks to one Chunk in order. The rows of the winner cursor before the current row of
+// the runner-up are appended as one range.
 class SortedChunksMerger {
 public:
     SortedChunksMerger();
@@ -28,15 +30,25 @@ public:
     Status get_next(ChunkPtr* chunk, bool* eos);
 
 private:
+    bool _is_valid(int cursor) const { return _cursors[cursor]->is_valid(); }
+    // Whether the current row of |l| is before the one of |r|, an exhausted cursor is after all the others.
+    bool _is_before(int l, int r) const {
+        if (!_is_valid(l)) {
+            return false;
+        }
+        return !_is_valid(r) || *_cursors[l] < *_cursors[r];
+    }
+    // Replay the matches on the path of |cursor| after its current row is moved.
+    void _replay(int cursor);
+    // The best of the cursors which lost to the winner, -1 if none of them is valid.
+    int _runner_up() const;
+
     ChunkSupplier _single_supplier;
     std::vector<std::unique_ptr<ChunkCursor>> _cursors;
-
-    struct CursorCmpGreater {
-        // if a is greater than b.
-        inline bool operator()(const ChunkCursor* a, const ChunkCursor* b) { return b->operator<(*a); }
-    };
-    CursorCmpGreater _cursor_cmp_greater;
-    std::vector<ChunkCursor*> _min_heap;
+    // A loser tree of the cursors: _loser_tree[0] is the winner, _loser_tree[n] for n in [1, k) is the loser
+    // of the match at node n, and the cursor i is the leaf k + i, so each move of the winner is replayed by
+    // log(k) comparisons on its own path.
+    std::vector<int> _loser_tree;
 
     RuntimeProfile::Counter* _total_timer = nullptr;
 };
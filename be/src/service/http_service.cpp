@@ -26,6 +26,7 @@
 #include "http/action/health_action.h"
 #include "http/action/meta_action.h"
 #include "http/action/metrics_action.h"
+#include "http/action/pipeline_trace_action.h"
 #include "http/action/pprof_actions.h"
 #include "http/action/reload_tablet_action.h"
 #include "http/action/restore_tablet_action.h"
@@ -82,6 +83,9 @@ Status HttpService::start() {
     // register pprof actions
     PprofActions::setup(_env, _ev_http_server.get());
 
+    PipelineTraceAction* pipeline_trace_action = new PipelineTraceAction();
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/pipeline_trace", pipeline_trace_action);
+
     // register metrics
     {
         auto action = new MetricsAction(StarRocksMetrics::instance()->metrics());
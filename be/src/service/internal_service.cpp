@@ -21,6 +21,9 @@
 
 #include "service/internal_service.h"
 
+#include <atomic>
+#include <fstream>
+
 #include "common/config.h"
 #include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/fragment_executor.h"
@@ -34,6 +37,7 @@
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/runtime_filter_worker.h"
 #include "service/brpc.h"
+#include "util/file_utils.h"
 #include "util/thrift_util.h"
 #include "util/uid_util.h"
 
@@ -86,19 +90,12 @@ void PInternalServiceImpl<T>::transmit_chunk(google::protobuf::RpcController* cn
     // If we don't give response here, stream manager will call done->Run before
     // transmit_data(), which will cause a dirty memory access.
     brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
-    PTransmitChunkParams* req = const_cast<PTransmitChunkParams*>(request);
-    if (cntl->request_attachment().size() > 0) {
-        const butil::IOBuf& io_buf = cntl->request_attachment();
-        size_t offset = 0;
-        for (size_t i = 0; i < req->chunks().size(); ++i) {
-            auto chunk = req->mutable_chunks(i);
-            io_buf.copy_to(chunk->mutable_data(), chunk->data_size(), offset);
-            offset += chunk->data_size();
-        }
-    }
+    // The chunks are deserialized from the blocks of the attachment by the receivers, instead of being copied into
+    // the request first.
+    butil::IOBuf* attachment = cntl->request_attachment().empty() ? nullptr : &cntl->request_attachment();
     Status st;
     st.to_protobuf(response->mutable_status());
-    st = _exec_env->stream_mgr()->transmit_chunk(*request, &done);
+    st = _exec_env->stream_mgr()->transmit_chunk(*request, attachment, &done, response);
     if (!st.ok()) {
         LOG(WARNING) << "transmit_data failed, message=" << st.get_error_msg()
                      << ", fragment_instance_id=" << print_id(request->finst_id()) << ", node=" << request->node_id();
@@ -137,6 +134,7 @@ void PInternalServiceImpl<T>::tablet_writer_open(google::protobuf::RpcController
                      << ", index_id=" << request->index_id() << ", txn_id=" << request->txn_id();
     }
     st.to_protobuf(response->mutable_status());
+    response->set_support_chunk_attachment(true);
 }
 
 template <typename T>
@@ -192,12 +190,19 @@ void PInternalServiceImpl<T>::tablet_writer_add_chunk(google::protobuf::RpcContr
     // add chunk maybe cost a lot of time, and this callback thread will be held.
     // this will influence query execution, because the pthreads under bthread may be
     // exhausted, so we put this to a local thread pool to process
-    _tablet_worker_pool.offer([request, response, done, this]() {
+    auto* cntl = static_cast<brpc::Controller*>(controller);
+    _tablet_worker_pool.offer([cntl, request, response, done, this]() {
         brpc::ClosureGuard closure_guard(done);
         int64_t execution_time_ns = 0;
         int64_t wait_lock_time_ns = 0;
         {
             SCOPED_RAW_TIMER(&execution_time_ns);
+            // the chunk data is sent in the attachment by the senders supporting it, see NodeChannel.
+            const butil::IOBuf& io_buf = cntl->request_attachment();
+            if (!io_buf.empty() && request->has_chunk()) {
+                auto* chunk = const_cast<PTabletWriterAddChunkRequest*>(request)->mutable_chunk();
+                io_buf.copy_to(chunk->mutable_data(), chunk->data_size(), 0);
+            }
             auto st = _exec_env->load_channel_mgr()->add_chunk(*request, response->mutable_tablet_vec(),
                                                                &wait_lock_time_ns);
             if (!st.ok()) {
@@ -212,6 +217,26 @@ void PInternalServiceImpl<T>::tablet_writer_add_chunk(google::protobuf::RpcContr
     });
 }
 
+template <typename T>
+void PInternalServiceImpl<T>::tablet_writer_add_rowset(google::protobuf::RpcController* controller,
+                                                       const PTabletWriterAddRowsetRequest* request,
+                                                       PTabletWriterAddRowsetResult* response,
+                                                       google::protobuf::Closure* done) {
+    VLOG_RPC << "tablet writer add rowset, id=" << request->id() << ", index_id=" << request->index_id()
+             << ", tablet_id=" << request->tablet_id();
+    // downloading the rowset takes a long time, so it's done in the thread pool like add chunk.
+    _tablet_worker_pool.offer([request, response, done, this]() {
+        brpc::ClosureGuard closure_guard(done);
+        auto st = _exec_env->load_channel_mgr()->add_rowset(*request);
+        if (!st.ok()) {
+            LOG(WARNING) << "tablet writer add rowset failed, message=" << st.get_error_msg()
+                         << ", id=" << print_id(request->id()) << ", index_id=" << request->index_id()
+                         << ", tablet_id=" << request->tablet_id();
+        }
+        st.to_protobuf(response->mutable_status());
+    });
+}
+
 template <typename T>
 void PInternalServiceImpl<T>::tablet_writer_cancel(google::protobuf::RpcController* controller,
                                                    const PTabletWriterCancelRequest* request,
@@ -227,6 +252,24 @@ void PInternalServiceImpl<T>::tablet_writer_cancel(google::protobuf::RpcControll
     }
 }
 
+// Save the serialized plan fragment as config::plan_fragment_dump_dir/<query_id>/<seq>_<fragment_instance_id>,
+// the sequence numbers keep the order the fragments are received in, which query_bench executes them in.
+static void dump_plan_fragment(const TExecPlanFragmentParams& params, const std::string& ser_request) {
+    static std::atomic<int64_t> s_seq{0};
+    std::string dir = config::plan_fragment_dump_dir + "/" + print_id(params.params.query_id);
+    Status st = FileUtils::create_dir(dir);
+    if (st.ok()) {
+        std::string path = dir + "/" + std::to_string(s_seq.fetch_add(1)) + "_" +
+                           print_id(params.params.fragment_instance_id);
+        std::ofstream file(path, std::ios::binary);
+        file.write(ser_request.data(), ser_request.size());
+        if (!file) {
+            st = Status::IOError("fail to write " + path);
+        }
+    }
+    LOG_IF(WARNING, !st.ok()) << "fail to dump plan fragment: " << st.to_string();
+}
+
 template <typename T>
 Status PInternalServiceImpl<T>::_exec_plan_fragment(brpc::Controller* cntl) {
     auto ser_request = cntl->request_attachment().to_string();
@@ -236,6 +279,9 @@ Status PInternalServiceImpl<T>::_exec_plan_fragment(brpc::Controller* cntl) {
         uint32_t len = ser_request.size();
         RETURN_IF_ERROR(deserialize_thrift_msg(buf, &len, false, &t_request));
     }
+    if (UNLIKELY(!config::plan_fragment_dump_dir.empty())) {
+        dump_plan_fragment(t_request, ser_request);
+    }
     bool is_pipeline = t_request.__isset.is_pipeline && t_request.is_pipeline;
     LOG(INFO) << "exec plan fragment, fragment_instance_id=" << print_id(t_request.params.fragment_instance_id)
               << ", coord=" << t_request.coord << ", backend=" << t_request.backend_num << " is_pipeline "
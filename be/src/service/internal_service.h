@@ -71,6 +71,10 @@ public:
                                  const PTabletWriterAddChunkRequest* request, PTabletWriterAddBatchResult* response,
                                  google::protobuf::Closure* done) override;
 
+    void tablet_writer_add_rowset(google::protobuf::RpcController* controller,
+                                  const PTabletWriterAddRowsetRequest* request, PTabletWriterAddRowsetResult* response,
+                                  google::protobuf::Closure* done) override;
+
     void tablet_writer_cancel(google::protobuf::RpcController* controller, const PTabletWriterCancelRequest* request,
                               PTabletWriterCancelResult* response, google::protobuf::Closure* done) override;
 
@@ -41,6 +41,7 @@
 #include "common/logging.h"
 #include "common/resource_tls.h"
 #include "common/status.h"
+#include "runtime/cpu_sampler.h"
 #include "runtime/exec_env.h"
 #include "runtime/heartbeat_flags.h"
 #include "service/backend_options.h"
@@ -77,6 +78,9 @@ static void thrift_output(const char* x) {
 } // namespace starrocks
 
 extern int meta_tool_main(int argc, char** argv);
+namespace starrocks {
+extern int query_bench_main(ExecEnv* exec_env);
+}
 
 int main(int argc, char** argv) {
     if (argc > 1 && strcmp(argv[1], "meta_tool") == 0) {
@@ -92,6 +96,8 @@ int main(int argc, char** argv) {
             exit(0);
         }
     }
+    // "query_bench" runs the plan fragments dumped on the storage of this backend instead of serving.
+    bool run_query_bench = argc > 1 && strcmp(argv[1], "query_bench") == 0;
 
     if (getenv("STARROCKS_HOME") == nullptr) {
         fprintf(stderr, "you need set STARROCKS_HOME environment variable.\n");
@@ -210,6 +216,11 @@ int main(int argc, char** argv) {
     exec_env->set_storage_engine(engine);
     engine->set_heartbeat_flags(exec_env->heartbeat_flags());
 
+    if (starrocks::config::cpu_sample_frequency > 0) {
+        auto sampler_st = starrocks::CpuSampler::instance()->start(starrocks::config::cpu_sample_frequency);
+        LOG_IF(WARNING, !sampler_st.ok()) << "fail to start the cpu sampler: " << sampler_st.to_string();
+    }
+
     // start all backgroud threads of storage engine.
     // SHOULD be called after exec env is initialized.
     EXIT_IF_ERROR(engine->start_bg_threads());
@@ -235,6 +246,12 @@ int main(int argc, char** argv) {
         exit(1);
     }
 
+    if (run_query_bench) {
+        int ret = starrocks::query_bench_main(exec_env);
+        starrocks::shutdown_logging();
+        exit(ret);
+    }
+
     // 3. http service
     starrocks::HttpService http_service(exec_env, starrocks::config::webserver_port,
                                         starrocks::config::webserver_num_workers);
@@ -283,7 +300,10 @@ int main(int argc, char** argv) {
 
 static void help(const char* progname) {
     printf("%s is the StarRocks backend server.\n\n", progname);
-    printf("Usage:\n  %s [OPTION]...\n\n", progname);
+    printf("Usage:\n  %s [OPTION]...\n", progname);
+    printf("  %s meta_tool [FLAG]...\n", progname);
+    printf("  %s query_bench --bench_plan_dir=<dir> [--bench_repeat=N] [--bench_engine=pipeline|non_pipeline]\n\n",
+           progname);
     printf("Options:\n");
     printf("  -v, --version      output version information, then exit\n");
     printf("  -?, --help         show this help, then exit\n");
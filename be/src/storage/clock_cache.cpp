@@ -0,0 +1,292 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/clock_cache.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include "common/logging.h"
+
+namespace starrocks {
+
+ClockCache::~ClockCache() {
+    prune();
+}
+
+void ClockCache::_remove(ClockHandle* e, std::vector<ClockHandle*>* deleted) {
+    DCHECK(e->in_cache);
+    if (e->next == e) {
+        _hand = nullptr;
+    } else {
+        e->prev->next = e->next;
+        e->next->prev = e->prev;
+        if (_hand == e) {
+            _hand = e->next;
+        }
+    }
+    e->next = e->prev = nullptr;
+    e->in_cache = false;
+    _usage -= e->charge;
+    if (e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        deleted->push_back(e);
+    }
+}
+
+bool ClockCache::_evict_one(CachePriority priority, std::vector<ClockHandle*>* deleted) {
+    // Every entry is passed at most twice, the first pass may clear its reference bit.
+    const size_t max_steps = 2 * _table.size();
+    for (size_t i = 0; i < max_steps && _hand != nullptr; i++) {
+        ClockHandle* e = _hand;
+        _hand = e->next;
+        if (e->priority != priority || e->refs.load(std::memory_order_acquire) > 1) {
+            continue;
+        }
+        if (e->referenced.load(std::memory_order_relaxed)) {
+            e->referenced.store(false, std::memory_order_relaxed);
+            continue;
+        }
+        _table.erase(e->key());
+        _remove(e, deleted);
+        return true;
+    }
+    return false;
+}
+
+void ClockCache::_evict(size_t charge, std::vector<ClockHandle*>* deleted) {
+    // evict normal cache entries first, and then durable cache entries if need
+    while (_usage + charge > _capacity) {
+        if (!_evict_one(CachePriority::NORMAL, deleted) && !_evict_one(CachePriority::DURABLE, deleted)) {
+            break;
+        }
+    }
+}
+
+Cache::Handle* ClockCache::insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
+                                  void (*deleter)(const CacheKey& key, void* value), CachePriority priority) {
+    auto* e = new (malloc(sizeof(ClockHandle) - 1 + key.size())) ClockHandle();
+    e->value = value;
+    e->deleter = deleter;
+    e->next = e->prev = nullptr;
+    e->charge = charge;
+    e->key_length = key.size();
+    e->hash = hash;
+    e->priority = priority;
+    e->in_cache = true;
+    e->referenced.store(false, std::memory_order_relaxed);
+    e->refs.store(2, std::memory_order_relaxed); // one for the returned handle, one for ClockCache.
+    memcpy(e->key_data, key.data(), key.size());
+    std::vector<ClockHandle*> last_ref_list;
+    {
+        std::unique_lock l(_mutex);
+
+        // note that the cache might get larger than its capacity if not enough
+        // space was freed
+        _evict(charge, &last_ref_list);
+
+        auto it = _table.find(key);
+        if (it != _table.end()) {
+            ClockHandle* old = it->second;
+            _table.erase(it);
+            _remove(old, &last_ref_list);
+        }
+        _table.emplace(e->key(), e);
+        // the new entry is the last one to sweep
+        if (_hand == nullptr) {
+            e->next = e->prev = e;
+            _hand = e;
+        } else {
+            e->next = _hand;
+            e->prev = _hand->prev;
+            e->prev->next = e;
+            _hand->prev = e;
+        }
+        _usage += charge;
+    }
+
+    // we free the entries here outside of mutex for
+    // performance reasons
+    for (auto entry : last_ref_list) {
+        entry->free();
+    }
+    return reinterpret_cast<Cache::Handle*>(e);
+}
+
+Cache::Handle* ClockCache::lookup(const CacheKey& key, uint32_t hash) {
+    std::shared_lock l(_mutex);
+    _lookup_count.fetch_add(1, std::memory_order_relaxed);
+    auto it = _table.find(key);
+    if (it == _table.end()) {
+        return nullptr;
+    }
+    ClockHandle* e = it->second;
+    e->refs.fetch_add(1, std::memory_order_relaxed);
+    // avoid writing the cache line of the entry if it's referenced already
+    if (!e->referenced.load(std::memory_order_relaxed)) {
+        e->referenced.store(true, std::memory_order_relaxed);
+    }
+    _hit_count.fetch_add(1, std::memory_order_relaxed);
+    return reinterpret_cast<Cache::Handle*>(e);
+}
+
+void ClockCache::release(Cache::Handle* handle) {
+    if (handle == nullptr) {
+        return;
+    }
+    auto* e = reinterpret_cast<ClockHandle*>(handle);
+    // the entry isn't in the cache any more if it's the last reference
+    if (e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        e->free();
+    }
+}
+
+void ClockCache::erase(const CacheKey& key, uint32_t hash) {
+    std::vector<ClockHandle*> last_ref_list;
+    {
+        std::unique_lock l(_mutex);
+        auto it = _table.find(key);
+        if (it != _table.end()) {
+            ClockHandle* e = it->second;
+            _table.erase(it);
+            _remove(e, &last_ref_list);
+        }
+    }
+    for (auto entry : last_ref_list) {
+        entry->free();
+    }
+}
+
+int ClockCache::prune() {
+    std::vector<ClockHandle*> last_ref_list;
+    {
+        std::unique_lock l(_mutex);
+        for (auto it = _table.begin(); it != _table.end();) {
+            ClockHandle* e = it->second;
+            if (e->refs.load(std::memory_order_acquire) == 1) {
+                it = _table.erase(it);
+                _remove(e, &last_ref_list);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (auto entry : last_ref_list) {
+        entry->free();
+    }
+    return last_ref_list.size();
+}
+
+inline uint32_t ShardedClockCache::_hash_slice(const CacheKey& s) {
+    return s.hash(s.data(), s.size(), 0);
+}
+
+uint32_t ShardedClockCache::_shard(uint32_t hash) {
+    return hash >> (32 - kNumShardBits);
+}
+
+ShardedClockCache::ShardedClockCache(size_t capacity) {
+    const size_t per_shard = (capacity + (kNumShards - 1)) / kNumShards;
+    for (auto& shard : _shards) {
+        shard.set_capacity(per_shard);
+    }
+}
+
+Cache::Handle* ShardedClockCache::insert(const CacheKey& key, void* value, size_t charge,
+                                         void (*deleter)(const CacheKey& key, void* value), CachePriority priority) {
+    const uint32_t hash = _hash_slice(key);
+    return _shards[_shard(hash)].insert(key, hash, value, charge, deleter, priority);
+}
+
+Cache::Handle* ShardedClockCache::lookup(const CacheKey& key) {
+    const uint32_t hash = _hash_slice(key);
+    return _shards[_shard(hash)].lookup(key, hash);
+}
+
+void ShardedClockCache::release(Handle* handle) {
+    ClockCache::release(handle);
+}
+
+void ShardedClockCache::erase(const CacheKey& key) {
+    const uint32_t hash = _hash_slice(key);
+    _shards[_shard(hash)].erase(key, hash);
+}
+
+void* ShardedClockCache::value(Handle* handle) {
+    return reinterpret_cast<ClockHandle*>(handle)->value;
+}
+
+Slice ShardedClockCache::value_slice(Handle* handle) {
+    auto clock_handle = reinterpret_cast<ClockHandle*>(handle);
+    return Slice((char*)clock_handle->value, clock_handle->charge);
+}
+
+uint64_t ShardedClockCache::new_id() {
+    return _last_id.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void ShardedClockCache::prune() {
+    int num_prune = 0;
+    for (auto& shard : _shards) {
+        num_prune += shard.prune();
+    }
+    VLOG(7) << "Successfully prune cache, clean " << num_prune << " entries.";
+}
+
+size_t ShardedClockCache::get_memory_usage() {
+    size_t total_usage = 0;
+    for (auto& shard : _shards) {
+        total_usage += shard.get_usage();
+    }
+    return total_usage;
+}
+
+uint64_t ShardedClockCache::get_lookup_count() {
+    uint64_t total_count = 0;
+    for (auto& shard : _shards) {
+        total_count += shard.get_lookup_count();
+    }
+    return total_count;
+}
+
+uint64_t ShardedClockCache::get_hit_count() {
+    uint64_t total_count = 0;
+    for (auto& shard : _shards) {
+        total_count += shard.get_hit_count();
+    }
+    return total_count;
+}
+
+void ShardedClockCache::get_cache_status(rapidjson::Document* document) {
+    for (auto& shard : _shards) {
+        size_t capacity = shard.get_capacity();
+        size_t usage = shard.get_usage();
+        rapidjson::Value shard_info(rapidjson::kObjectType);
+        shard_info.AddMember("capacity", static_cast<double>(capacity), document->GetAllocator());
+        shard_info.AddMember("usage", static_cast<double>(usage), document->GetAllocator());
+
+        float usage_ratio = 0.0f;
+        if (0 != capacity) {
+            usage_ratio = static_cast<float>(usage) / static_cast<float>(capacity);
+        }
+        shard_info.AddMember("usage_ratio", usage_ratio, document->GetAllocator());
+
+        size_t lookup_count = shard.get_lookup_count();
+        size_t hit_count = shard.get_hit_count();
+        shard_info.AddMember("lookup_count", static_cast<double>(lookup_count), document->GetAllocator());
+        shard_info.AddMember("hit_count", static_cast<double>(hit_count), document->GetAllocator());
+
+        float hit_ratio = 0.0f;
+        if (0 != lookup_count) {
+            hit_ratio = static_cast<float>(hit_count) / static_cast<float>(lookup_count);
+        }
+        shard_info.AddMember("hit_ratio", hit_ratio, document->GetAllocator());
+        document->PushBack(shard_info, document->GetAllocator());
+    }
+}
+
+Cache* new_clock_cache(size_t capacity) {
+    return new ShardedClockCache(capacity);
+}
+
+} // namespace starrocks
@@ -0,0 +1,116 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "storage/lru_cache.h"
+
+namespace starrocks {
+
+struct ClockHandle {
+    void* value;
+    void (*deleter)(const CacheKey&, void* value);
+    // The circular list of the entries in the cache, swept by the clock hand.
+    ClockHandle* next;
+    ClockHandle* prev;
+    size_t charge;
+    size_t key_length;
+    uint32_t hash; // Hash of key(); used for fast sharding
+    CachePriority priority;
+    // Whether entry is in the cache, only accessed with the exclusive lock of the shard.
+    bool in_cache;
+    // Set by the hits, cleared by the sweeps of the evictions.
+    std::atomic<bool> referenced;
+    // One for the cache if the entry is in it, and one for every handle returned.
+    std::atomic<uint32_t> refs;
+    char key_data[1]; // Beginning of key
+
+    CacheKey key() const { return CacheKey(key_data, key_length); }
+
+    void free() {
+        (*deleter)(key(), value);
+        this->~ClockHandle();
+        ::free(this);
+    }
+};
+
+// A single shard of sharded clock cache.
+//
+// The lookups hold the shared lock of the shard, and only increase the refs and set the reference bit of the entry
+// atomically. The releases don't lock at all. The inserts, the erases and the evictions hold the exclusive lock.
+class ClockCache {
+public:
+    ClockCache() = default;
+    ~ClockCache();
+
+    void set_capacity(size_t capacity) { _capacity = capacity; }
+
+    // Like Cache methods, but with an extra "hash" parameter.
+    Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
+                          void (*deleter)(const CacheKey& key, void* value),
+                          CachePriority priority = CachePriority::NORMAL);
+    Cache::Handle* lookup(const CacheKey& key, uint32_t hash);
+    static void release(Cache::Handle* handle);
+    void erase(const CacheKey& key, uint32_t hash);
+    int prune();
+
+    uint64_t get_lookup_count() const { return _lookup_count.load(std::memory_order_relaxed); }
+    uint64_t get_hit_count() const { return _hit_count.load(std::memory_order_relaxed); }
+    size_t get_usage() const { return _usage; }
+    size_t get_capacity() const { return _capacity; }
+
+private:
+    struct KeyHash {
+        size_t operator()(const CacheKey& key) const { return key.hash(key.data(), key.size(), 0); }
+    };
+
+    // Remove |e| from the cache, and put it into |deleted| if it's not in use.
+    // Must be called with the exclusive lock held.
+    void _remove(ClockHandle* e, std::vector<ClockHandle*>* deleted);
+    void _evict(size_t charge, std::vector<ClockHandle*>* deleted);
+    bool _evict_one(CachePriority priority, std::vector<ClockHandle*>* deleted);
+
+    size_t _capacity = 0;
+
+    std::shared_mutex _mutex;
+    // The following states are protected by the exclusive lock of |_mutex|.
+    size_t _usage = 0;
+    std::unordered_map<CacheKey, ClockHandle*, KeyHash> _table;
+    // The clock hand, pointing to the next entry to sweep in the circular list, nullptr if the cache is empty.
+    ClockHandle* _hand = nullptr;
+
+    std::atomic<uint64_t> _lookup_count = 0;
+    std::atomic<uint64_t> _hit_count = 0;
+};
+
+class ShardedClockCache : public Cache {
+public:
+    explicit ShardedClockCache(size_t capacity);
+    ~ShardedClockCache() override = default;
+    Handle* insert(const CacheKey& key, void* value, size_t charge, void (*deleter)(const CacheKey& key, void* value),
+                   CachePriority priority = CachePriority::NORMAL) override;
+    Handle* lookup(const CacheKey& key) override;
+    void release(Handle* handle) override;
+    void erase(const CacheKey& key) override;
+    void* value(Handle* handle) override;
+    Slice value_slice(Handle* handle) override;
+    uint64_t new_id() override;
+    void prune() override;
+    size_t get_memory_usage() override;
+    uint64_t get_lookup_count() override;
+    uint64_t get_hit_count() override;
+    void get_cache_status(rapidjson::Document* document) override;
+
+private:
+    static inline uint32_t _hash_slice(const CacheKey& s);
+    static uint32_t _shard(uint32_t hash);
+
+    ClockCache _shards[kNumShards];
+    std::atomic<uint64_t> _last_id = 0;
+};
+
+} // namespace starrocks
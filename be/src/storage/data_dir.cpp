@@ -34,9 +34,12 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <tuple>
 
+#include "common/config.h"
 #include "env/env.h"
 #include "gen_cpp/version.h"
 #include "gutil/strings/substitute.h"
@@ -53,6 +56,7 @@
 #include "util/file_utils.h"
 #include "util/monotime.h"
 #include "util/string_util.h"
+#include "util/threadpool.h"
 
 using strings::Substitute;
 
@@ -60,6 +64,8 @@ namespace starrocks {
 
 static const char* const kMtabPath = "/etc/mtab";
 static const char* const kTestFilePath = "/.testfile";
+// the number of the tablet metas loaded by a task at startup
+static const size_t kTabletMetaLoadBatchSize = 256;
 
 DataDir::DataDir(const std::string& path, int64_t capacity_bytes, TStorageMedium::type storage_medium,
                  TabletManager* tablet_manager, TxnManager* txn_manager)
@@ -74,13 +80,20 @@ DataDir::DataDir(const std::string& path, int64_t capacity_bytes, TStorageMedium
           _cluster_id(-1),
           _to_be_deleted(false),
           _current_shard(0),
-          _meta(nullptr) {}
+          _meta(nullptr),
+          _compaction_io_limiter(std::make_unique<IOLimiter>(0)) {}
 
 DataDir::~DataDir() {
     delete _id_generator;
     delete _meta;
 }
 
+IOLimiter* DataDir::compaction_io_limiter() {
+    _compaction_io_limiter->set_max_rate(is_ssd_disk() ? config::compaction_io_bytes_per_second_per_ssd
+                                                       : config::compaction_io_bytes_per_second_per_hdd);
+    return _compaction_io_limiter.get();
+}
+
 Status DataDir::init(bool read_only) {
     if (!FileUtils::check_exist(_path)) {
         RETURN_IF_ERROR_WITH_WARN(Status::IOError(strings::Substitute("opendir failed, path=$0", _path)),
@@ -454,10 +467,12 @@ OLAPStatus DataDir::load() {
     LOG(INFO) << "begin loading tablet from meta";
     std::set<int64_t> tablet_ids;
     std::set<int64_t> failed_tablet_ids;
-    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids](int64_t tablet_id, int32_t schema_hash,
-                                                                    const std::string& value) -> bool {
+    std::mutex tablet_ids_lock;
+    auto load_tablet = [this, &tablet_ids, &failed_tablet_ids, &tablet_ids_lock](int64_t tablet_id, int32_t schema_hash,
+                                                                                 const std::string& value) {
         Status st =
                 _tablet_manager->load_tablet_from_meta(this, tablet_id, schema_hash, value, false, false, false, false);
+        std::lock_guard l(tablet_ids_lock);
         if (!st.ok() && !st.is_not_found()) {
             // load_tablet_from_meta() may return NotFound which means the tablet status is DELETED
             // This may happen when the tablet was just deleted before the BE restarted,
@@ -471,9 +486,45 @@ OLAPStatus DataDir::load() {
         } else {
             tablet_ids.insert(tablet_id);
         }
+    };
+
+    // The metas are traversed in the order of tablet ids, and loaded in batches of consecutive tablet ids by the
+    // threads of |load_pool| if there are more than one.
+    std::unique_ptr<ThreadPool> load_pool;
+    if (config::tablet_meta_load_threads_per_dir > 1) {
+        Status st = ThreadPoolBuilder("TabletMetaLoad")
+                            .set_max_threads(config::tablet_meta_load_threads_per_dir)
+                            .build(&load_pool);
+        LOG_IF(WARNING, !st.ok()) << "Fail to create the thread pool to load tablet metas: " << st;
+    }
+    using TabletMetaBatch = std::vector<std::tuple<int64_t, int32_t, std::string>>;
+    auto batch = std::make_shared<TabletMetaBatch>();
+    auto submit_batch = [&load_pool, &load_tablet, &batch]() {
+        auto load_batch = [load_tablet, batch = std::move(batch)]() {
+            for (const auto& [tablet_id, schema_hash, value] : *batch) {
+                load_tablet(tablet_id, schema_hash, value);
+            }
+        };
+        if (load_pool == nullptr || !load_pool->submit_func(load_batch).ok()) {
+            load_batch();
+        }
+        batch = std::make_shared<TabletMetaBatch>();
+    };
+    auto load_tablet_func = [&batch, &submit_batch](int64_t tablet_id, int32_t schema_hash,
+                                                    const std::string& value) -> bool {
+        batch->emplace_back(tablet_id, schema_hash, value);
+        if (batch->size() >= kTabletMetaLoadBatchSize) {
+            submit_batch();
+        }
         return true;
     };
     Status load_tablet_status = TabletMetaManager::traverse_headers(_meta, load_tablet_func);
+    if (!batch->empty()) {
+        submit_batch();
+    }
+    if (load_pool != nullptr) {
+        load_pool->wait();
+    }
     if (failed_tablet_ids.size() != 0) {
         LOG(ERROR) << "load tablets from header failed"
                    << ", loaded tablet: " << tablet_ids.size() << ", error tablet: " << failed_tablet_ids.size()
@@ -23,6 +23,7 @@
 
 #include <condition_variable>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <shared_mutex>
@@ -31,6 +32,7 @@
 #include "common/status.h"
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/olap_file.pb.h"
+#include "storage/io_limiter.h"
 #include "storage/olap_common.h"
 #include "storage/olap_meta.h"
 #include "storage/rowset/rowset_id_generator.h"
@@ -85,6 +87,9 @@ public:
 
     TStorageMedium::type storage_medium() const { return _storage_medium; }
 
+    // The limiter shared by the compactions of this data dir, whose max rate follows the config of the storage medium.
+    IOLimiter* compaction_io_limiter();
+
     void register_tablet(Tablet* tablet);
     void deregister_tablet(Tablet* tablet);
     void clear_tablets(std::vector<TabletInfo>* tablet_infos);
@@ -167,6 +172,8 @@ private:
     OlapMeta* _meta = nullptr;
     RowsetIdGenerator* _id_generator = nullptr;
 
+    std::unique_ptr<IOLimiter> _compaction_io_limiter;
+
     std::mutex _check_path_mutex;
     std::condition_variable _cv;
     std::set<std::string> _all_check_paths;
@@ -4,7 +4,9 @@
 
 #include <memory>
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
+#include "util/coding.h"
 #include "util/raw_container.h"
 #include "util/starrocks_metrics.h"
 
@@ -20,14 +22,23 @@ void DelVector::set_empty() {
     _cardinality = 0;
     _memory_usage = 0;
     _roaring.reset();
+    _delta.reset();
+    _base_version = 0;
+    _num_deltas = 0;
 }
 
+static const char kFullFormat = 0x01;
+static const char kDeltaFormat = 0x02;
+static const size_t kDeltaHeaderSize = 1 + sizeof(int64_t);
+
 void DelVector::_add_dels(const std::vector<uint32_t>& dels) {
     if (!_roaring) {
         _roaring = std::make_unique<Roaring>(dels.size(), dels.data());
     } else {
         _roaring->addMany(dels.size(), dels.data());
     }
+    _roaring->runOptimize();
+    _roaring->shrinkToFit();
     _update_stats();
 }
 
@@ -41,6 +52,17 @@ void DelVector::add_dels_as_new_version(const std::vector<uint32_t>& dels, int64
     tmp->_version = version;
     tmp->_loaded = true;
     tmp->_add_dels(dels);
+    // Save the added ids as a delta, unless there are enough deltas since the last full DelVector, which then is
+    // saved in full to bound the deltas to read when loading it.
+    if (_num_deltas < config::del_vector_max_deltas) {
+        auto delta = std::make_unique<Roaring>(dels.size(), dels.data());
+        delta->runOptimize();
+        if (delta->getSizeInBytes() < tmp->_roaring->getSizeInBytes()) {
+            tmp->_delta = std::move(delta);
+            tmp->_base_version = _version;
+            tmp->_num_deltas = _num_deltas + 1;
+        }
+    }
     tmp.swap(*pdelvec);
 }
 
@@ -48,7 +70,10 @@ Status DelVector::load(int64_t version, const char* data, size_t length) {
     if (length < 1) {
         return Status::Corruption("zero length");
     }
-    if (*data != 0x01) {
+    if (*data == kDeltaFormat) {
+        return Status::NotSupported("delete vector is a delta");
+    }
+    if (*data != kFullFormat) {
         return Status::Corruption("invalid flag");
     }
     data += 1;
@@ -62,11 +87,45 @@ Status DelVector::load(int64_t version, const char* data, size_t length) {
     return Status::OK();
 }
 
+bool DelVector::is_delta(const char* data, size_t length, int64_t* base_version) {
+    if (length < kDeltaHeaderSize || *data != kDeltaFormat) {
+        return false;
+    }
+    *base_version = static_cast<int64_t>(decode_fixed64_le(reinterpret_cast<const uint8_t*>(data + 1)));
+    return true;
+}
+
+Status DelVector::apply_delta(int64_t version, const char* data, size_t length) {
+    int64_t base_version = 0;
+    if (!is_delta(data, length, &base_version)) {
+        return Status::Corruption("not a delta of delete vector");
+    }
+    if (base_version != _version) {
+        return Status::Corruption(strings::Substitute("delete vector delta of version $0 is based on $1, not $2",
+                                                      version, base_version, _version));
+    }
+    if (length > kDeltaHeaderSize) {
+        Roaring delta = Roaring::readSafe(data + kDeltaHeaderSize, length - kDeltaHeaderSize);
+        if (!_roaring) {
+            _roaring = std::make_unique<Roaring>(std::move(delta));
+        } else {
+            *_roaring |= delta;
+        }
+    }
+    _loaded = true;
+    _version = version;
+    _num_deltas++;
+    _update_stats();
+    return Status::OK();
+}
+
 void DelVector::init(int64_t version, const uint32_t* data, size_t length) {
     _loaded = true;
     _version = version;
     if (length > 0) {
         _roaring = std::make_unique<Roaring>(length, data);
+        _roaring->runOptimize();
+        _roaring->shrinkToFit();
     }
     _update_stats();
 }
@@ -75,13 +134,25 @@ string DelVector::save() const {
     string ret;
     auto roaring_size = _roaring ? _roaring->getSizeInBytes() : 0;
     ret.resize(roaring_size + 1);
-    ret[0] = 0x01; // one byte flag.
+    ret[0] = kFullFormat; // one byte flag.
     if (roaring_size > 0) {
         _roaring->write(ret.data() + 1);
     }
     return ret;
 }
 
+string DelVector::save_delta() const {
+    if (!_delta) {
+        return save();
+    }
+    string ret;
+    ret.resize(kDeltaHeaderSize + _delta->getSizeInBytes());
+    ret[0] = kDeltaFormat;
+    encode_fixed64_le(reinterpret_cast<uint8_t*>(ret.data() + 1), static_cast<uint64_t>(_base_version));
+    _delta->write(ret.data() + kDeltaHeaderSize);
+    return ret;
+}
+
 string DelVector::to_string() const {
     return strings::Substitute("version:$0 $1", _version, _roaring ? _roaring->toString() : string("null"));
 }
@@ -12,7 +12,10 @@ namespace starrocks {
 // A bitmap(uint32_t set) to store all the deleted rows' ids of a segment.
 // Each DelVector is associated with a version, which is EditVersion's majar version.
 // Serialization format:
-// |<format version (currently 0x01)> 1 byte|serialized roaring bitmap|
+// |<format version 0x01> 1 byte|serialized roaring bitmap|
+// or, for a delta against the DelVector of the base version:
+// |<format version 0x02> 1 byte|base version 8 bytes|serialized roaring bitmap of the added ids|
+// The roaring bitmaps are run-length optimized.
 class DelVector {
 public:
     DelVector();
@@ -33,12 +36,27 @@ public:
 
     size_t memory_usage() const { return _memory_usage; }
 
+    // Load a DelVector saved by save(), return NotSupported if |data| is a delta.
     Status load(int64_t version, const char* data, size_t length);
 
+    // Return true if |data| is a delta saved by save_delta(), and set |base_version| to its base version.
+    static bool is_delta(const char* data, size_t length, int64_t* base_version);
+
+    // Add the ids of the delta |data| to this DelVector of its base version, |version| is the version of the delta.
+    Status apply_delta(int64_t version, const char* data, size_t length);
+
     void init(int64_t version, const uint32_t* data, size_t length);
 
     std::string save() const;
 
+    // Save only the ids added by add_dels_as_new_version() as a delta against the base version, if this DelVector
+    // is created by it, there are less than config::del_vector_max_deltas deltas since the last full DelVector of
+    // the segment, and the delta is smaller. Otherwise, the same as save().
+    std::string save_delta() const;
+
+    // The number of the deltas since the last full DelVector of the segment, if saved by save_delta().
+    int32_t num_deltas() const { return _num_deltas; }
+
     std::string to_string() const;
 
     bool empty() const { return !_roaring; }
@@ -55,6 +73,10 @@ private:
     size_t _cardinality = 0;
     size_t _memory_usage = 0;
     std::unique_ptr<Roaring> _roaring;
+    // The ids added against |_base_version| by add_dels_as_new_version(), only kept to be saved as a delta.
+    std::unique_ptr<Roaring> _delta;
+    int64_t _base_version = 0;
+    int32_t _num_deltas = 0;
 };
 
 typedef std::shared_ptr<DelVector> DelVectorPtr;
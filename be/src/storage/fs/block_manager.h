@@ -176,6 +176,8 @@ public:
 struct CreateBlockOptions {
     // const std::string tablet_id;
     const std::string path;
+    // Drop the block from the page cache once it's closed, e.g. for the blocks written by the compactions.
+    bool drop_cache = false;
 };
 
 // Block manager creation options.
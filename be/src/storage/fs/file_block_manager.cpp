@@ -36,6 +36,7 @@
 #include "runtime/mem_tracker.h"
 #include "storage/fs/block_id.h"
 #include "storage/fs/block_manager_metrics.h"
+#include "storage/io_limiter.h"
 #include "storage/storage_engine.h"
 #include "util/file_cache.h"
 #include "util/metrics.h"
@@ -173,6 +174,9 @@ Status FileWritableBlock::appendv(const Slice* data, size_t data_cnt) {
     size_t bytes_written = accumulate(data, data + data_cnt, static_cast<size_t>(0),
                                       [&](int sum, const Slice& curr) { return sum + curr.size; });
     _bytes_appended += bytes_written;
+    if (auto limiter = IOLimiter::current(); limiter != nullptr) {
+        limiter->acquire(bytes_written);
+    }
     return Status::OK();
 }
 
@@ -345,12 +349,20 @@ Status FileReadableBlock::read(uint64_t offset, Slice result) const {
 Status FileReadableBlock::readv(uint64_t offset, const Slice* results, size_t res_cnt) const {
     DCHECK(!_closed.load());
 
+    IOLimiter* limiter = IOLimiter::current();
+    size_t bytes_read = 0;
+    if (limiter != nullptr || _block_manager->_metrics) {
+        // Calculate the read amount of data
+        bytes_read = accumulate(results, results + res_cnt, static_cast<size_t>(0),
+                                [&](int sum, const Slice& curr) { return sum + curr.size; });
+    }
+    if (limiter != nullptr) {
+        limiter->acquire(bytes_read);
+    }
+
     RETURN_IF_ERROR(_file->readv_at(offset, results, res_cnt));
 
     if (_block_manager->_metrics) {
-        // Calculate the read amount of data
-        size_t bytes_read = accumulate(results, results + res_cnt, static_cast<size_t>(0),
-                                       [&](int sum, const Slice& curr) { return sum + curr.size; });
         _block_manager->_metrics->total_bytes_read->increment(bytes_read);
     }
 
@@ -391,6 +403,7 @@ Status FileBlockManager::create_block(const CreateBlockOptions& opts, std::uniqu
     shared_ptr<WritableFile> writer;
     WritableFileOptions wr_opts;
     wr_opts.mode = Env::MUST_CREATE;
+    wr_opts.drop_cache_on_close = opts.drop_cache;
     RETURN_IF_ERROR(env_util::open_file_for_write(wr_opts, _env, opts.path, &writer));
 
     VLOG(1) << "Creating new block at " << opts.path;
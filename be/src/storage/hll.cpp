@@ -94,6 +94,24 @@ void HyperLogLog::update(uint64_t hash_value) {
     }
 }
 
+void HyperLogLog::update_batch(const uint64_t* hash_values, size_t num_values) {
+    size_t i = 0;
+    if (_type == HLL_DATA_EMPTY || _type == HLL_DATA_EXPLICIT) {
+        for (; i < num_values && _hash_set.size() < HLL_EXPLICLIT_INT64_NUM; ++i) {
+            _hash_set.insert(hash_values[i]);
+        }
+        _type = _hash_set.empty() ? HLL_DATA_EMPTY : HLL_DATA_EXPLICIT;
+        if (i == num_values) {
+            return;
+        }
+        _convert_explicit_to_register();
+        _type = HLL_DATA_FULL;
+    }
+    for (; i < num_values; ++i) {
+        _update_registers(hash_values[i]);
+    }
+}
+
 void HyperLogLog::merge(const HyperLogLog& other) {
     // fast path
     if (other._type == HLL_DATA_EMPTY) {
@@ -166,6 +166,10 @@ public:
     // NOTE: input must be a hash_value
     void update(uint64_t hash_value);
 
+    // Add |num_values| hash values, none of which is 0, to this HLL value. It is stored explicitly until the
+    // hash values overflow the explicit set, the rest of them are updated into the registers in a tight loop.
+    void update_batch(const uint64_t* hash_values, size_t num_values);
+
     void merge(const HyperLogLog& other);
 
     // Return max size of serialized binary
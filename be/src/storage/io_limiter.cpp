@@ -0,0 +1,98 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/io_limiter.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "util/monotime.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+thread_local IOLimiter* IOLimiter::_tls_current = nullptr;
+
+IOLimiter::IOLimiter(int64_t max_bytes_per_second, int64_t adjust_interval_ms)
+        : _adjust_interval_us(adjust_interval_ms * 1000) {
+    set_max_rate(max_bytes_per_second);
+}
+
+void IOLimiter::set_max_rate(int64_t max_bytes_per_second) {
+    max_bytes_per_second = std::max<int64_t>(max_bytes_per_second, 0);
+    std::lock_guard l(_mutex);
+    if (max_bytes_per_second == _max_rate) {
+        return;
+    }
+    int64_t now_us = MonotonicMicros();
+    _max_rate = max_bytes_per_second;
+    _rate = max_bytes_per_second;
+    _tokens = 0;
+    _last_refill_us = now_us;
+    _last_adjust_us = now_us;
+    _scan_io_ns = 0;
+    _scan_io_count = 0;
+}
+
+int64_t IOLimiter::rate() const {
+    std::lock_guard l(_mutex);
+    return _rate;
+}
+
+void IOLimiter::acquire(int64_t bytes) {
+    int64_t wait_us = 0;
+    {
+        std::lock_guard l(_mutex);
+        if (_max_rate == 0 || bytes <= 0) {
+            return;
+        }
+        int64_t now_us = MonotonicMicros();
+        _adjust_rate(now_us);
+        _refill(now_us);
+        _tokens -= bytes;
+        if (_tokens < 0) {
+            wait_us = static_cast<int64_t>(-_tokens * 1000000 / _rate);
+        }
+    }
+    if (wait_us > 0) {
+        SleepFor(MonoDelta::FromMicroseconds(wait_us));
+    }
+}
+
+void IOLimiter::add_scan_io(int64_t io_ns, int64_t io_count) {
+    if (io_count <= 0) {
+        return;
+    }
+    std::lock_guard l(_mutex);
+    if (_max_rate == 0) {
+        return;
+    }
+    _scan_io_ns += io_ns;
+    _scan_io_count += io_count;
+    _adjust_rate(MonotonicMicros());
+}
+
+void IOLimiter::_refill(int64_t now_us) {
+    // at most 100ms of the tokens are saved, so the bursts after idle periods are small.
+    double max_tokens = _rate / 10.0;
+    _tokens = std::min(max_tokens, _tokens + (now_us - _last_refill_us) * (double)_rate / 1000000);
+    _last_refill_us = now_us;
+}
+
+void IOLimiter::_adjust_rate(int64_t now_us) {
+    if (now_us - _last_adjust_us < _adjust_interval_us) {
+        return;
+    }
+    // the tokens before the rate changes are kept.
+    _refill(now_us);
+    const int64_t latency_limit_ns = config::compaction_io_backoff_scan_io_latency_ms * 1000000L;
+    if (latency_limit_ns > 0 && _scan_io_count > 0 && _scan_io_ns / _scan_io_count > latency_limit_ns) {
+        _rate = std::max(_rate / 2, std::max<int64_t>(_max_rate / 16, 1));
+    } else {
+        _rate = std::min(_rate + std::max<int64_t>(_max_rate / 8, 1), _max_rate);
+    }
+    _last_adjust_us = now_us;
+    _scan_io_ns = 0;
+    _scan_io_count = 0;
+}
+
+} // namespace starrocks
@@ -0,0 +1,78 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+#include "gutil/macros.h"
+
+namespace starrocks {
+
+// IOLimiter limits the throughput of the background I/O of a disk, e.g. the reads and writes of the compactions,
+// by a token bucket. The bytes read or written may exceed the tokens, then the following acquires wait until the
+// debt is paid back, so that large reads and writes are never starved.
+//
+// The rate backs off by half, down to 1/16 of the max rate, if the average latency of the foreground scan I/O of the
+// disk exceeds config::compaction_io_backoff_scan_io_latency_ms during an adjust interval, and it grows back by 1/8
+// of the max rate per interval otherwise.
+//
+// The blocks of the block manager acquire the limiter of their thread, which is set by the Scope of the background
+// task, so the limiter needn't be passed through the readers and writers.
+//
+// This class is thread-safe.
+class IOLimiter {
+public:
+    // Set the limiter of the current thread in the scope, nullptr for unlimited.
+    class Scope {
+    public:
+        explicit Scope(IOLimiter* limiter) : _prev(_tls_current) { _tls_current = limiter; }
+        ~Scope() { _tls_current = _prev; }
+
+    private:
+        IOLimiter* _prev;
+
+        DISALLOW_COPY_AND_ASSIGN(Scope);
+    };
+
+    // The limiter of the current thread, nullptr if unlimited.
+    static IOLimiter* current() { return _tls_current; }
+
+    // |max_bytes_per_second| <= 0 for unlimited.
+    explicit IOLimiter(int64_t max_bytes_per_second, int64_t adjust_interval_ms = 1000);
+
+    void set_max_rate(int64_t max_bytes_per_second);
+
+    // The current bytes per second, 0 if unlimited.
+    int64_t rate() const;
+
+    // Wait until |bytes| may be read or written.
+    void acquire(int64_t bytes);
+
+    // Record |io_count| foreground scan I/Os that took |io_ns| in total.
+    void add_scan_io(int64_t io_ns, int64_t io_count);
+
+private:
+    // Must be called with |_mutex| held.
+    void _refill(int64_t now_us);
+    void _adjust_rate(int64_t now_us);
+
+    static thread_local IOLimiter* _tls_current;
+
+    const int64_t _adjust_interval_us;
+
+    mutable std::mutex _mutex;
+    int64_t _max_rate = 0;
+    int64_t _rate = 0;
+    // Negative if the acquired bytes exceed the tokens.
+    double _tokens = 0;
+    int64_t _last_refill_us = 0;
+
+    int64_t _last_adjust_us = 0;
+    int64_t _scan_io_ns = 0;
+    int64_t _scan_io_count = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(IOLimiter);
+};
+
+} // namespace starrocks
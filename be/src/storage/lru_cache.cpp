@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -158,6 +159,8 @@ LRUCache::LRUCache() : _usage(0), _last_id(0), _lookup_count(0), _hit_count(0) {
     // Make empty circular linked list
     _lru.next = &_lru;
     _lru.prev = &_lru;
+    _protected_lru.next = &_protected_lru;
+    _protected_lru.prev = &_protected_lru;
 }
 
 LRUCache::~LRUCache() {
@@ -184,6 +187,29 @@ void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
     e->next->prev = e;
 }
 
+void LRUCache::_protect(LRUHandle* e) {
+    if (_protected_capacity == 0 || e->is_protected) {
+        return;
+    }
+    e->is_protected = true;
+    _protected_usage += e->charge;
+    // Move the least recently used protected entries back to the probationary entries, as the newest ones.
+    while (_protected_usage > _protected_capacity && _protected_lru.next != &_protected_lru) {
+        LRUHandle* old = _protected_lru.next;
+        _lru_remove(old);
+        old->is_protected = false;
+        _protected_usage -= old->charge;
+        _lru_append(&_lru, old);
+    }
+}
+
+void LRUCache::_unprotect(LRUHandle* e) {
+    if (e->is_protected) {
+        e->is_protected = false;
+        _protected_usage -= e->charge;
+    }
+}
+
 Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
     std::lock_guard l(_mutex);
     ++_lookup_count;
@@ -197,6 +223,7 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
         }
         e->refs++;
         ++_hit_count;
+        _protect(e);
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
@@ -217,13 +244,14 @@ void LRUCache::release(Cache::Handle* handle) {
             if (_usage > _capacity) {
                 // take this opportunity and remove the item
                 _table.remove(e->key(), e->hash);
+                _unprotect(e);
                 e->in_cache = false;
                 _unref(e);
                 _usage -= e->charge;
                 last_ref = true;
             } else {
                 // put it to LRU free list
-                _lru_append(&_lru, e);
+                _lru_append(e->is_protected ? &_protected_lru : &_lru, e);
             }
         }
     }
@@ -235,24 +263,26 @@ void LRUCache::release(Cache::Handle* handle) {
 }
 
 void LRUCache::_evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted) {
-    LRUHandle* cur = &_lru;
-    // 1. evict normal cache entries
-    while (_usage + charge > _capacity && cur->next != &_lru) {
+    // 1. evict normal cache entries, the probationary ones first
+    _evict_from_list(&_lru, charge, CachePriority::NORMAL, deleted);
+    _evict_from_list(&_protected_lru, charge, CachePriority::NORMAL, deleted);
+    // 2. evict durable cache entries if need
+    _evict_from_list(&_lru, charge, CachePriority::DURABLE, deleted);
+    _evict_from_list(&_protected_lru, charge, CachePriority::DURABLE, deleted);
+}
+
+void LRUCache::_evict_from_list(LRUHandle* list, size_t charge, CachePriority priority,
+                                std::vector<LRUHandle*>* deleted) {
+    LRUHandle* cur = list;
+    while (_usage + charge > _capacity && cur->next != list) {
         LRUHandle* old = cur->next;
-        if (old->priority == CachePriority::DURABLE) {
+        if (old->priority != priority) {
             cur = cur->next;
             continue;
         }
         _evict_one_entry(old);
         deleted->push_back(old);
     }
-    // 2. evict durable cache entries if need
-    while (_usage + charge > _capacity && _lru.next != &_lru) {
-        LRUHandle* old = _lru.next;
-        DCHECK(old->priority == CachePriority::DURABLE);
-        _evict_one_entry(old);
-        deleted->push_back(old);
-    }
 }
 
 void LRUCache::_evict_one_entry(LRUHandle* e) {
@@ -260,6 +290,7 @@ void LRUCache::_evict_one_entry(LRUHandle* e) {
     DCHECK(e->refs == 1); // LRU list contains elements which may be evicted
     _lru_remove(e);
     _table.remove(e->key(), e->hash);
+    _unprotect(e);
     e->in_cache = false;
     _unref(e);
     _usage -= e->charge;
@@ -276,6 +307,7 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->refs = 2; // one for the returned handle, one for LRUCache.
     e->next = e->prev = nullptr;
     e->in_cache = true;
+    e->is_protected = false;
     e->priority = priority;
     memcpy(e->key_data, key.data(), key.size());
     std::vector<LRUHandle*> last_ref_list;
@@ -292,6 +324,7 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
         auto old = _table.insert(e);
         _usage += charge;
         if (old != nullptr) {
+            _unprotect(old);
             old->in_cache = false;
             if (_unref(old)) {
                 _usage -= old->charge;
@@ -327,6 +360,7 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
                     _lru_remove(e);
                 }
             }
+            _unprotect(e);
             e->in_cache = false;
         }
     }
@@ -336,21 +370,30 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
     }
 }
 
+int LRUCache::_prune_list(LRUHandle* list, std::vector<LRUHandle*>* deleted) {
+    int num_pruned = 0;
+    while (list->next != list) {
+        LRUHandle* old = list->next;
+        DCHECK(old->in_cache);
+        DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
+        _lru_remove(old);
+        _table.remove(old->key(), old->hash);
+        _unprotect(old);
+        old->in_cache = false;
+        _unref(old);
+        _usage -= old->charge;
+        deleted->push_back(old);
+        ++num_pruned;
+    }
+    return num_pruned;
+}
+
 int LRUCache::prune() {
     std::vector<LRUHandle*> last_ref_list;
     {
         std::lock_guard l(_mutex);
-        while (_lru.next != &_lru) {
-            LRUHandle* old = _lru.next;
-            DCHECK(old->in_cache);
-            DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
-            _lru_remove(old);
-            _table.remove(old->key(), old->hash);
-            old->in_cache = false;
-            _unref(old);
-            _usage -= old->charge;
-            last_ref_list.push_back(old);
-        }
+        _prune_list(&_lru, &last_ref_list);
+        _prune_list(&_protected_lru, &last_ref_list);
     }
     for (auto entry : last_ref_list) {
         entry->free();
@@ -366,11 +409,12 @@ uint32_t ShardedLRUCache::_shard(uint32_t hash) {
     return hash >> (32 - kNumShardBits);
 }
 
-ShardedLRUCache::ShardedLRUCache(size_t capacity) : _last_id(0) {
+ShardedLRUCache::ShardedLRUCache(size_t capacity, int protected_percent) : _last_id(0) {
     const size_t per_shard = (capacity + (kNumShards - 1)) / kNumShards;
 
     for (int s = 0; s < kNumShards; s++) {
         _shards[s].set_capacity(per_shard);
+        _shards[s].set_protected_capacity(per_shard * std::clamp(protected_percent, 0, 100) / 100);
     }
 }
 
@@ -425,6 +469,22 @@ size_t ShardedLRUCache::get_memory_usage() {
     return total_usage;
 }
 
+uint64_t ShardedLRUCache::get_lookup_count() {
+    uint64_t total_count = 0;
+    for (int s = 0; s < kNumShards; s++) {
+        total_count += _shards[s].get_lookup_count();
+    }
+    return total_count;
+}
+
+uint64_t ShardedLRUCache::get_hit_count() {
+    uint64_t total_count = 0;
+    for (int s = 0; s < kNumShards; s++) {
+        total_count += _shards[s].get_hit_count();
+    }
+    return total_count;
+}
+
 void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
     size_t shard_count = sizeof(_shards) / sizeof(LRUCache);
 
@@ -459,8 +519,8 @@ void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
     }
 }
 
-Cache* new_lru_cache(size_t capacity) {
-    return new ShardedLRUCache(capacity);
+Cache* new_lru_cache(size_t capacity, int protected_percent) {
+    return new ShardedLRUCache(capacity, protected_percent);
 }
 
 } // namespace starrocks
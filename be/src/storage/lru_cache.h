@@ -47,7 +47,18 @@ class CacheKey;
 
 // Create a new cache with a fixed size capacity.  This implementation
 // of Cache uses a least-recently-used eviction policy.
-extern Cache* new_lru_cache(size_t capacity);
+// If |protected_percent| is positive, the cache is scan resistant (segmented LRU, a simplified 2Q): a new entry
+// is probationary until it's hit again, and then it's protected. The probationary entries are evicted first,
+// and the protected entries take at most |protected_percent| of the capacity, the least recently used ones
+// are moved back to the probationary entries. So the entries read only once, e.g. by a large scan, don't
+// evict the entries read frequently.
+extern Cache* new_lru_cache(size_t capacity, int protected_percent = 0);
+
+// Create a new cache with a fixed size capacity, evicted by the CLOCK policy, an approximation of LRU: a hit only
+// sets the reference bit of the entry, under a shared lock of its shard, so that the concurrent lookups don't
+// serialize on the shard mutex. An eviction sweeps the entries of the shard, and evicts the first one not in use
+// whose reference bit is cleared, clearing the reference bits it passes. See clock_cache.h.
+extern Cache* new_clock_cache(size_t capacity);
 
 class CacheKey {
 public:
@@ -199,6 +210,8 @@ public:
     virtual void prune() {}
 
     virtual size_t get_memory_usage() = 0;
+    virtual uint64_t get_lookup_count() = 0;
+    virtual uint64_t get_hit_count() = 0;
     virtual void get_cache_status(rapidjson::Document* document) = 0;
 
 private:
@@ -216,6 +229,7 @@ typedef struct LRUHandle {
     size_t charge;
     size_t key_length;
     bool in_cache; // Whether entry is in the cache.
+    bool is_protected; // Whether entry is a protected entry of the scan resistant cache.
     uint32_t refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
@@ -278,6 +292,8 @@ public:
 
     // Separate from constructor so caller can easily make an array of LRUCache
     void set_capacity(size_t capacity) { _capacity = capacity; }
+    // The capacity of the protected entries, 0 if the cache isn't scan resistant, see new_lru_cache().
+    void set_protected_capacity(size_t capacity) { _protected_capacity = capacity; }
 
     // Like Cache methods, but with an extra "hash" parameter.
     Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
@@ -292,13 +308,19 @@ public:
     uint64_t get_hit_count() const { return _hit_count; }
     size_t get_usage() const { return _usage; }
     size_t get_capacity() const { return _capacity; }
+    size_t get_protected_usage() const { return _protected_usage; }
 
 private:
     void _lru_remove(LRUHandle* e);
     void _lru_append(LRUHandle* list, LRUHandle* e);
     bool _unref(LRUHandle* e);
     void _evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted);
+    void _evict_from_list(LRUHandle* list, size_t charge, CachePriority priority, std::vector<LRUHandle*>* deleted);
     void _evict_one_entry(LRUHandle* e);
+    int _prune_list(LRUHandle* list, std::vector<LRUHandle*>* deleted);
+    void _protect(LRUHandle* e);
+    // Must be called before the entry isn't in the cache any more.
+    void _unprotect(LRUHandle* e);
 
     // Initialized before use.
     size_t _capacity;
@@ -312,6 +334,11 @@ private:
     // lru.prev is newest entry, lru.next is oldest entry.
     // Entries have refs==1 and in_cache==true.
     LRUHandle _lru;
+    // Dummy head of LRU list of the protected entries, empty if the cache isn't scan resistant.
+    LRUHandle _protected_lru;
+    size_t _protected_capacity = 0;
+    // The charge of the protected entries, including the ones in use.
+    size_t _protected_usage = 0;
 
     HandleTable _table;
 
@@ -324,7 +351,7 @@ static const int kNumShards = 1 << kNumShardBits;
 
 class ShardedLRUCache : public Cache {
 public:
-    explicit ShardedLRUCache(size_t capacity);
+    explicit ShardedLRUCache(size_t capacity, int protected_percent = 0);
     virtual ~ShardedLRUCache() {}
     virtual Handle* insert(const CacheKey& key, void* value, size_t charge,
                            void (*deleter)(const CacheKey& key, void* value),
@@ -337,6 +364,8 @@ public:
     virtual uint64_t new_id();
     virtual void prune();
     virtual size_t get_memory_usage();
+    uint64_t get_lookup_count() override;
+    uint64_t get_hit_count() override;
     virtual void get_cache_status(rapidjson::Document* document);
 
 private:
@@ -21,9 +21,17 @@
 
 #include "storage/memory/mem_tablet.h"
 
+#include <algorithm>
+#include <numeric>
+
+#include "column/chunk.h"
+#include "gutil/strings/substitute.h"
 #include "storage/memory/mem_sub_tablet.h"
+#include "storage/memory/mem_tablet_chunk_iterator.h"
 #include "storage/memory/mem_tablet_scan.h"
 #include "storage/memory/write_txn.h"
+#include "storage/rowset/segment_v2/segment_writer.h"
+#include "storage/vectorized/chunk_helper.h"
 
 namespace starrocks {
 namespace memory {
@@ -74,6 +82,68 @@ Status MemTablet::scan(std::unique_ptr<ScanSpec>* spec, std::unique_ptr<MemTable
     return Status::OK();
 }
 
+Status MemTablet::new_chunk_iterator(const vectorized::Schema& schema, uint64_t version,
+                                     vectorized::ChunkIteratorPtr* iter) {
+    vector<std::string> columns;
+    columns.reserve(schema.num_fields());
+    for (const auto& field : schema.fields()) {
+        const ColumnSchema* cs = _mem_schema->get_by_name(field->name());
+        if (cs == nullptr) {
+            return Status::NotFound(strings::Substitute("column $0 not found in the mem tablet", field->name()));
+        }
+        if (cs->type() != field->type()->type() || cs->is_nullable() != field->is_nullable()) {
+            return Status::InvalidArgument(strings::Substitute("mismatched field $0 of the mem tablet", field->name()));
+        }
+        columns.push_back(field->name());
+    }
+    std::unique_ptr<ScanSpec> spec(new ScanSpec(std::move(columns), version));
+    std::unique_ptr<MemTabletScan> mem_scan;
+    RETURN_IF_ERROR(scan(&spec, &mem_scan));
+    *iter = std::make_shared<MemTabletChunkIterator>(schema, std::move(mem_scan));
+    return Status::OK();
+}
+
+Status MemTablet::checkpoint(uint64_t version, segment_v2::SegmentWriter* writer, uint64_t* segment_file_size) {
+    vectorized::Schema schema = vectorized::ChunkHelper::convert_schema(_mem_schema->get_tablet_schema());
+    vectorized::ChunkIteratorPtr iter;
+    RETURN_IF_ERROR(new_chunk_iterator(schema, version, &iter));
+    vectorized::ChunkPtr rows = vectorized::ChunkHelper::new_chunk(schema, 0);
+    vectorized::ChunkPtr chunk = vectorized::ChunkHelper::new_chunk(schema, iter->chunk_size());
+    while (true) {
+        chunk->reset();
+        Status st = iter->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        RETURN_IF_ERROR(st);
+        rows->append(*chunk);
+    }
+    iter->close();
+
+    // The keys are unique, which is guaranteed by the hash index.
+    std::vector<uint32_t> order(rows->num_rows());
+    std::iota(order.begin(), order.end(), 0);
+    const size_t num_keys = _mem_schema->num_key_columns();
+    std::sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+        for (size_t i = 0; i < num_keys; i++) {
+            const auto& column = rows->get_column_by_index(i);
+            int r = column->compare_at(lhs, rhs, *column, -1);
+            if (r != 0) {
+                return r < 0;
+            }
+        }
+        return false;
+    });
+    for (size_t from = 0; from < order.size(); from += iter->chunk_size()) {
+        auto size = static_cast<uint32_t>(std::min(order.size() - from, static_cast<size_t>(iter->chunk_size())));
+        chunk->reset();
+        chunk->append_selective(*rows, order.data(), from, size);
+        RETURN_IF_ERROR(writer->append_chunk(*chunk));
+    }
+    uint64_t index_size = 0;
+    return writer->finalize(segment_file_size, &index_size);
+}
+
 Status MemTablet::create_write_txn(std::unique_ptr<WriteTxn>* wtxn) {
     wtxn->reset(new WriteTxn(&_mem_schema));
     return Status::OK();
@@ -23,8 +23,14 @@
 
 #include "storage/base_tablet.h"
 #include "storage/memory/schema.h"
+#include "storage/vectorized/chunk_iterator.h"
 
 namespace starrocks {
+
+namespace segment_v2 {
+class SegmentWriter;
+}
+
 namespace memory {
 
 class MemSubTablet;
@@ -64,6 +70,19 @@ public:
     // Note: thread-safe, supports multi-reader concurrency.
     Status scan(std::unique_ptr<ScanSpec>* spec, std::unique_ptr<MemTabletScan>* scan);
 
+    // Scan the columns of |schema| at |version| by the vectorized engine, the fields are matched with the columns
+    // by name. The rows are returned in the order they are inserted, i.e. not sorted by the key.
+    //
+    // Note: thread-safe, supports multi-reader concurrency.
+    Status new_chunk_iterator(const vectorized::Schema& schema, uint64_t version, vectorized::ChunkIteratorPtr* iter);
+
+    // Write all the rows of |version| into a segment sorted by the key, so that the tablet can be recovered from the
+    // segment instead of replaying all the write transactions. |writer| must have been initialized with the tablet
+    // schema, and it is finalized here.
+    //
+    // Note: the whole tablet is sorted in memory, it is designed for small tables.
+    Status checkpoint(uint64_t version, segment_v2::SegmentWriter* writer, uint64_t* segment_file_size);
+
     // Create a write transaction
     //
     // Note: Thread-safe, can have multiple writetxn at the same time.
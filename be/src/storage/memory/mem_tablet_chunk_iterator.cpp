@@ -0,0 +1,75 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/memory/mem_tablet_chunk_iterator.h"
+
+#include "column/chunk.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "storage/memory/row_block.h"
+
+namespace starrocks {
+namespace memory {
+
+MemTabletChunkIterator::MemTabletChunkIterator(vectorized::Schema schema, std::unique_ptr<MemTabletScan> scan)
+        : ChunkIterator(std::move(schema)), _scan(std::move(scan)) {
+    _value_sizes.reserve(_schema.num_fields());
+    for (const auto& field : _schema.fields()) {
+        _value_sizes.push_back(field->type()->size());
+    }
+}
+
+void MemTabletChunkIterator::close() {
+    _block = nullptr;
+    _scan.reset();
+}
+
+Status MemTabletChunkIterator::do_get_next(vectorized::Chunk* chunk) {
+    while (_block == nullptr || _offset >= _block->num_rows()) {
+        if (_block != nullptr) {
+            _block_rowid += _block->num_rows();
+        }
+        RETURN_IF_ERROR(_scan->next_block(&_block));
+        _offset = 0;
+        if (_block == nullptr) {
+            return Status::EndOfFile("no more data in the mem tablet");
+        }
+    }
+    DCHECK_EQ(_block->num_columns(), chunk->num_columns());
+    size_t n = std::min(static_cast<size_t>(_chunk_size), _block->num_rows() - _offset);
+    for (size_t i = 0; i < chunk->num_columns(); i++) {
+        const ColumnBlock& cb = _block->get_column(i);
+        const size_t value_size = _value_sizes[i];
+        const uint8_t* values = cb.data().data() + _offset * value_size;
+        vectorized::Column* column = chunk->get_column_by_index(i).get();
+        if (!column->is_nullable()) {
+            (void)column->append_numbers(values, n * value_size);
+            continue;
+        }
+        auto* nullable = down_cast<vectorized::NullableColumn*>(column);
+        (void)nullable->mutable_data_column()->append_numbers(values, n * value_size);
+        auto& nulls = nullable->null_column_data();
+        if (cb.nulls()) {
+            const bool* is_null = cb.nulls().as<bool>() + _offset;
+            for (size_t j = 0; j < n; j++) {
+                nulls.push_back(is_null[j]);
+            }
+        } else {
+            nulls.resize(nulls.size() + n, 0);
+        }
+        nullable->update_has_null();
+    }
+    _offset += n;
+    return Status::OK();
+}
+
+Status MemTabletChunkIterator::do_get_next(vectorized::Chunk* chunk, vector<uint32_t>* rowid) {
+    RETURN_IF_ERROR(do_get_next(chunk));
+    uint32_t end = _block_rowid + _offset;
+    for (uint32_t id = end - chunk->num_rows(); id < end; id++) {
+        rowid->push_back(id);
+    }
+    return Status::OK();
+}
+
+} // namespace memory
+} // namespace starrocks
@@ -0,0 +1,41 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "storage/memory/mem_tablet_scan.h"
+#include "storage/vectorized/chunk_iterator.h"
+
+namespace starrocks {
+namespace memory {
+
+// MemTabletChunkIterator reads the RowBlocks of a MemTabletScan into the Chunks of the vectorized engine. The
+// fields of |schema| must be the columns of the scan, in the same order. The values of the fixed-width types are
+// copied from the merged ColumnBlocks directly, there is no page to decode.
+class MemTabletChunkIterator final : public vectorized::ChunkIterator {
+public:
+    MemTabletChunkIterator(vectorized::Schema schema, std::unique_ptr<MemTabletScan> scan);
+
+    ~MemTabletChunkIterator() override = default;
+
+    void close() override;
+
+protected:
+    Status do_get_next(vectorized::Chunk* chunk) override;
+    Status do_get_next(vectorized::Chunk* chunk, vector<uint32_t>* rowid) override;
+
+private:
+    std::unique_ptr<MemTabletScan> _scan;
+    // the byte size of a value of every field
+    std::vector<size_t> _value_sizes;
+    // the current block and the number of its rows which have been returned
+    const RowBlock* _block = nullptr;
+    size_t _offset = 0;
+    // the row id of the first row of the current block
+    uint32_t _block_rowid = 0;
+};
+
+} // namespace memory
+} // namespace starrocks
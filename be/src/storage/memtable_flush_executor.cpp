@@ -95,7 +95,7 @@ void FlushToken::_flush_vectorized_memtable(std::shared_ptr<vectorized::MemTable
 
     MonotonicStopWatch timer;
     timer.start();
-    _flush_status.store(memtable->flush());
+    _flush_status.store(memtable->flush(_segment_flush_pool));
     if (_flush_status.load() != OLAP_SUCCESS) {
         return;
     }
@@ -109,16 +109,20 @@ Status MemTableFlushExecutor::init(const std::vector<DataDir*>& data_dirs) {
     int32_t data_dir_num = data_dirs.size();
     size_t min_threads = std::max(1, config::flush_thread_num_per_store);
     size_t max_threads = data_dir_num * min_threads;
-    return ThreadPoolBuilder("MemTableFlushThreadPool")
-            .set_min_threads(min_threads)
+    RETURN_IF_ERROR(ThreadPoolBuilder("MemTableFlushThreadPool")
+                            .set_min_threads(min_threads)
+                            .set_max_threads(max_threads)
+                            .build(&_flush_pool));
+    return ThreadPoolBuilder("MemTableSegmentFlushThreadPool")
+            .set_min_threads(0)
             .set_max_threads(max_threads)
-            .build(&_flush_pool);
+            .build(&_segment_flush_pool);
 }
 
 // NOTE: we use SERIAL mode here to ensure all mem-tables from one tablet are flushed in order.
 OLAPStatus MemTableFlushExecutor::create_flush_token(std::unique_ptr<FlushToken>* flush_token,
                                                      ThreadPool::ExecutionMode execution_mode) {
-    flush_token->reset(new FlushToken(_flush_pool->new_token(execution_mode)));
+    flush_token->reset(new FlushToken(_flush_pool->new_token(execution_mode), _segment_flush_pool.get()));
     return OLAP_SUCCESS;
 }
 
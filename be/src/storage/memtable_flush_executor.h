@@ -58,8 +58,11 @@ std::ostream& operator<<(std::ostream& os, const FlushStatistic& stat);
 //    because the entire job will definitely fail;
 class FlushToken {
 public:
-    explicit FlushToken(std::unique_ptr<ThreadPoolToken> flush_pool_token)
-            : _flush_token(std::move(flush_pool_token)), _flush_status(OLAP_SUCCESS) {}
+    // The segments of a large vectorized memtable are written in parallel by |segment_flush_pool| if it's not null.
+    explicit FlushToken(std::unique_ptr<ThreadPoolToken> flush_pool_token, ThreadPool* segment_flush_pool = nullptr)
+            : _flush_token(std::move(flush_pool_token)),
+              _segment_flush_pool(segment_flush_pool),
+              _flush_status(OLAP_SUCCESS) {}
 
     OLAPStatus submit(const std::shared_ptr<MemTable>& mem_table);
 
@@ -81,6 +84,7 @@ private:
     void _flush_vectorized_memtable(std::shared_ptr<vectorized::MemTable> mem_table);
 
     std::unique_ptr<ThreadPoolToken> _flush_token;
+    ThreadPool* _segment_flush_pool;
 
     // Records the current flush status of the tablet.
     // Note: Once its value is set to Failed, it cannot return to SUCCESS.
@@ -112,6 +116,9 @@ public:
 
 private:
     std::unique_ptr<ThreadPool> _flush_pool;
+    // The tasks of this pool never wait for other tasks, so the flush tasks may wait for the segments written by
+    // this pool without deadlocks.
+    std::unique_ptr<ThreadPool> _segment_flush_pool;
 };
 
 } // namespace starrocks
@@ -376,6 +376,8 @@ using KeyRange = std::pair<WrapperField*, WrapperField*>;
 struct OlapReaderStatistics {
     int64_t capture_rowset_ns = 0;
     int64_t io_ns = 0;
+    // the number of the reads timed by io_ns.
+    int64_t io_count = 0;
     int64_t compressed_bytes_read = 0;
 
     int64_t decompress_ns = 0;
@@ -406,6 +408,10 @@ struct OlapReaderStatistics {
 
     int64_t rows_key_range_filtered = 0;
     int64_t rows_stats_filtered = 0;
+    // The rows filtered by the encoded values of the data pages.
+    int64_t rows_encoded_filtered = 0;
+    // The rows of the segments answered by their zone maps instead of reading the data pages.
+    int64_t rows_metadata_aggregated = 0;
     int64_t rows_bf_filtered = 0;
     int64_t rows_del_filtered = 0;
     int64_t del_filter_ns = 0;
@@ -414,6 +420,7 @@ struct OlapReaderStatistics {
 
     int64_t total_pages_num = 0;
     int64_t cached_pages_num = 0;
+    int64_t decoded_cached_pages_num = 0;
 
     int64_t rows_bitmap_index_filtered = 0;
     int64_t bitmap_index_filter_timer = 0;
@@ -28,8 +28,11 @@
 #include <string>
 
 #include "common/status.h"
+#include "gutil/casts.h"
+#include "storage/io_limiter.h"
 #include "storage/olap_common.h"
 #include "storage/olap_define.h"
+#include "storage/rowset/beta_rowset.h"
 #include "storage/storage_engine.h"
 #include "storage/update_manager.h"
 #include "storage/vectorized/compaction.h"
@@ -159,6 +162,12 @@ Status StorageEngine::start_bg_threads() {
         LOG(INFO) << "path scan/gc threads started. number:" << get_stores().size();
     }
 
+    if (config::warm_up_segments_on_start) {
+        _segment_warm_up_thread = std::thread([this] { _segment_warm_up_callback(nullptr); });
+        _segment_warm_up_thread.detach();
+        LOG(INFO) << "segment warm up thread started";
+    }
+
     LOG(INFO) << "all storage engine's backgroud threads are started.";
     return Status::OK();
 }
@@ -191,6 +200,7 @@ void* StorageEngine::_base_compaction_thread_callback(void* arg, DataDir* data_d
     while (!_stop_bg_worker) {
         // must be here, because this thread is start on start and
         if (!data_dir->reach_capacity_limit(0)) {
+            IOLimiter::Scope io_limiter_scope(data_dir->compaction_io_limiter());
             status = _perform_base_compaction(data_dir);
         }
         if (status.ok()) {
@@ -214,8 +224,15 @@ void* StorageEngine::_update_compaction_thread_callback(void* arg, DataDir* data
 #endif
     Status status = Status::OK();
     while (!_stop_bg_worker) {
+        // wait until the disk has the I/O budget for the next update compaction.
+        int64_t wait_seconds = _update_compaction_wait_seconds(data_dir);
+        if (wait_seconds > 0) {
+            SLEEP_IN_BG_WORKER(wait_seconds);
+            continue;
+        }
         // must be here, because this thread is start on start and
         if (!data_dir->reach_capacity_limit(0)) {
+            IOLimiter::Scope io_limiter_scope(data_dir->compaction_io_limiter());
             status = _perform_update_compaction(data_dir);
         }
         if (status.ok()) {
@@ -305,6 +322,7 @@ void* StorageEngine::_cumulative_compaction_thread_callback(void* arg, DataDir*
     while (!_stop_bg_worker) {
         // must be here, because this thread is start on start and
         if (!data_dir->reach_capacity_limit(0)) {
+            IOLimiter::Scope io_limiter_scope(data_dir->compaction_io_limiter());
             status = _perform_cumulative_compaction(data_dir);
         }
         if (status.ok()) {
@@ -436,4 +454,47 @@ void* StorageEngine::_tablet_checkpoint_callback(void* arg) {
     return nullptr;
 }
 
+void* StorageEngine::_segment_warm_up_callback(void* arg) {
+#ifdef GOOGLE_PROFILER
+    ProfilerRegisterThread();
+#endif
+    int64_t start_time = UnixMillis();
+    size_t num_segments = 0;
+    for (const TabletSharedPtr& tablet : _tablet_manager->get_running_tablets()) {
+        if (_stop_bg_worker) {
+            break;
+        }
+        // The rowsets of the primary keys tablets are managed by TabletUpdates.
+        if (tablet->updates() != nullptr) {
+            continue;
+        }
+        std::vector<RowsetSharedPtr> rowsets;
+        {
+            std::shared_lock rdlock(tablet->get_header_lock());
+            const Version version(0, tablet->max_version().second);
+            if (tablet->capture_consistent_rowsets(version, &rowsets) != OLAP_SUCCESS) {
+                continue;
+            }
+        }
+        for (const RowsetSharedPtr& rowset : rowsets) {
+            if (rowset->rowset_meta()->rowset_type() != BETA_ROWSET || rowset->empty()) {
+                continue;
+            }
+            // The segments of the rowset are opened in parallel by the segment open thread pool.
+            Status st = rowset->load();
+            for (const auto& segment : down_cast<BetaRowset*>(rowset.get())->segments()) {
+                if (!st.ok()) {
+                    break;
+                }
+                st = segment->warm_up();
+                num_segments++;
+            }
+            LOG_IF(WARNING, !st.ok()) << "failed to warm up rowset " << rowset->rowset_id() << " of tablet "
+                                      << tablet->full_name() << ": " << st;
+        }
+    }
+    LOG(INFO) << "warmed up " << num_segments << " segments in " << UnixMillis() - start_time << "ms";
+    return nullptr;
+}
+
 } // namespace starrocks
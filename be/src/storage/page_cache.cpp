@@ -21,6 +21,8 @@
 
 #include "storage/page_cache.h"
 
+#include <algorithm>
+
 #include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
 #include "util/metrics.h"
@@ -28,7 +30,13 @@
 
 namespace starrocks {
 
-UIntGauge g_cache_size(MetricUnit::BYTES); // NOLINT
+UIntGauge g_cache_size(MetricUnit::BYTES);           // NOLINT
+UIntGauge g_data_cache_size(MetricUnit::BYTES);      // NOLINT
+UIntGauge g_index_cache_size(MetricUnit::BYTES);     // NOLINT
+UIntGauge g_data_cache_lookups(MetricUnit::NOUNIT);  // NOLINT
+UIntGauge g_index_cache_lookups(MetricUnit::NOUNIT); // NOLINT
+UIntGauge g_data_cache_hits(MetricUnit::NOUNIT);     // NOLINT
+UIntGauge g_index_cache_hits(MetricUnit::NOUNIT);    // NOLINT
 
 [[maybe_unused]] static void update_cache_size() {
     StoragePageCache::instance()->update_memory_usage_statistics();
@@ -36,13 +44,25 @@ UIntGauge g_cache_size(MetricUnit::BYTES); // NOLINT
 
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
-void StoragePageCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+void StoragePageCache::create_global_cache(MemTracker* mem_tracker, size_t capacity, int index_percent,
+                                           int protected_percent, size_t decoded_capacity, bool use_clock) {
     if (_s_instance == nullptr) {
-        _s_instance = new StoragePageCache(mem_tracker, capacity);
+        _s_instance = new StoragePageCache(mem_tracker, capacity, index_percent, protected_percent, decoded_capacity,
+                                           use_clock);
 #ifndef BE_TEST
         MetricRegistry* reg = StarRocksMetrics::instance()->metrics();
         reg->register_hook("page_cache_size_hook", update_cache_size);
         reg->register_metric("storage_page_cache_bytes", &g_cache_size);
+        reg->register_metric("storage_page_cache_pool_bytes", MetricLabels().add("pool", "data"), &g_data_cache_size);
+        reg->register_metric("storage_page_cache_pool_bytes", MetricLabels().add("pool", "index"),
+                             &g_index_cache_size);
+        reg->register_metric("storage_page_cache_lookup_count", MetricLabels().add("pool", "data"),
+                             &g_data_cache_lookups);
+        reg->register_metric("storage_page_cache_lookup_count", MetricLabels().add("pool", "index"),
+                             &g_index_cache_lookups);
+        reg->register_metric("storage_page_cache_hit_count", MetricLabels().add("pool", "data"), &g_data_cache_hits);
+        reg->register_metric("storage_page_cache_hit_count", MetricLabels().add("pool", "index"),
+                             &g_index_cache_hits);
 #endif
     }
 }
@@ -57,26 +77,80 @@ void StoragePageCache::release_global_cache() {
 void StoragePageCache::update_memory_usage_statistics() {
     int64_t mem_usage = memory_usage();
     g_cache_size.set_value(mem_usage);
+    g_data_cache_size.set_value(data_memory_usage());
+    g_data_cache_lookups.set_value(_data_cache->get_lookup_count());
+    g_data_cache_hits.set_value(_data_cache->get_hit_count());
+    if (_index_cache != nullptr) {
+        g_index_cache_size.set_value(_index_cache->get_memory_usage());
+        g_index_cache_lookups.set_value(_index_cache->get_lookup_count());
+        g_index_cache_hits.set_value(_index_cache->get_hit_count());
+    }
     _mem_tracker->consume(mem_usage - _mem_tracker->consumption());
 }
 
-StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity)
-        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {}
+StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity, int index_percent,
+                                   int protected_percent, size_t decoded_capacity, bool use_clock)
+        : _mem_tracker(mem_tracker) {
+    auto new_cache = [&](size_t pool_capacity) {
+        return use_clock ? new_clock_cache(pool_capacity) : new_lru_cache(pool_capacity, protected_percent);
+    };
+    index_percent = std::clamp(index_percent, 0, 100);
+    size_t index_capacity = capacity / 100 * index_percent;
+    if (index_capacity > 0) {
+        _index_cache.reset(new_cache(index_capacity));
+    }
+    _data_cache.reset(new_cache(capacity - index_capacity));
+    if (decoded_capacity > 0) {
+        _decoded_cache.reset(new_cache(decoded_capacity));
+    }
+}
 
 StoragePageCache::~StoragePageCache() {
     _mem_tracker->release(_mem_tracker->consumption());
 }
 
-bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle) {
-    auto* lru_handle = _cache->lookup(key.encode());
+size_t StoragePageCache::memory_usage() const {
+    size_t usage = data_memory_usage() + index_memory_usage();
+    if (_decoded_cache != nullptr) {
+        usage += _decoded_cache->get_memory_usage();
+    }
+    return usage;
+}
+
+std::shared_ptr<const segment_v2::DecodedPage> StoragePageCache::lookup_decoded_page(const CacheKey& key) {
+    DCHECK(_decoded_cache != nullptr);
+    auto* handle = _decoded_cache->lookup(key.encode());
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    // the page is kept alive by the returned pointer, so the cache entry could be released at once.
+    auto page = *reinterpret_cast<std::shared_ptr<const segment_v2::DecodedPage>*>(_decoded_cache->value(handle));
+    _decoded_cache->release(handle);
+    return page;
+}
+
+void StoragePageCache::insert_decoded_page(const CacheKey& key, std::shared_ptr<const segment_v2::DecodedPage> page,
+                                           size_t charge) {
+    DCHECK(_decoded_cache != nullptr);
+    auto deleter = [](const starrocks::CacheKey& key, void* value) {
+        delete reinterpret_cast<std::shared_ptr<const segment_v2::DecodedPage>*>(value);
+    };
+    auto* value = new std::shared_ptr<const segment_v2::DecodedPage>(std::move(page));
+    _decoded_cache->release(_decoded_cache->insert(key.encode(), value, charge, deleter));
+}
+
+bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle, bool is_index_page) {
+    Cache* cache = _get_cache(is_index_page);
+    auto* lru_handle = cache->lookup(key.encode());
     if (lru_handle == nullptr) {
         return false;
     }
-    *handle = PageCacheHandle(_cache.get(), lru_handle);
+    *handle = PageCacheHandle(cache, lru_handle);
     return true;
 }
 
-void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory) {
+void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory,
+                              bool is_index_page) {
     auto deleter = [](const starrocks::CacheKey& key, void* value) { delete[](uint8_t*) value; };
 
     CachePriority priority = CachePriority::NORMAL;
@@ -84,8 +158,9 @@ void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheH
         priority = CachePriority::DURABLE;
     }
 
-    auto* lru_handle = _cache->insert(key.encode(), data.data, data.size, deleter, priority);
-    *handle = PageCacheHandle(_cache.get(), lru_handle);
+    Cache* cache = _get_cache(is_index_page);
+    auto* lru_handle = cache->insert(key.encode(), data.data, data.size, deleter, priority);
+    *handle = PageCacheHandle(cache, lru_handle);
 }
 
 } // namespace starrocks
@@ -33,9 +33,18 @@ namespace starrocks {
 class PageCacheHandle;
 class MemTracker;
 
+namespace segment_v2 {
+struct DecodedPage;
+}
+
 // Warpper around Cache, and used for cache page of column datas
 // in Segment.
-// TODO(zc): We should add some metric to see cache hit/miss rate.
+// The index pages, e.g. the short key pages and the ordinal index pages, could be cached in a separate pool of
+// |index_percent| of the capacity, so that they are not evicted by the data pages of large scans. And both pools
+// are scan resistant if |protected_percent| is positive, see new_lru_cache(), or evicted by the CLOCK policy if
+// |use_clock| is true, whose hits don't serialize on the shard mutexes, see new_clock_cache().
+// The decoded data pages could be cached in another pool of |decoded_capacity|, so that the hits of them don't
+// pay for decoding again.
 class StoragePageCache {
 public:
     virtual ~StoragePageCache();
@@ -59,7 +68,8 @@ public:
     };
 
     // Create global instance of this class
-    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity, int index_percent = 0,
+                                    int protected_percent = 0, size_t decoded_capacity = 0, bool use_clock = false);
 
     static void release_global_cache();
 
@@ -67,7 +77,8 @@ public:
     // Client should call create_global_cache before.
     static StoragePageCache* instance() { return _s_instance; }
 
-    StoragePageCache(MemTracker* mem_tracker, size_t capacity);
+    StoragePageCache(MemTracker* mem_tracker, size_t capacity, int index_percent = 0, int protected_percent = 0,
+                     size_t decoded_capacity = 0, bool use_clock = false);
 
     void update_memory_usage_statistics();
 
@@ -78,22 +89,46 @@ public:
     // destructs.
     //
     // Return true if entry is found, otherwise return false.
-    bool lookup(const CacheKey& key, PageCacheHandle* handle);
+    bool lookup(const CacheKey& key, PageCacheHandle* handle, bool is_index_page = false);
 
     // Insert a page with key into this cache.
     // Given hanlde will be set to valid reference.
     // This function is thread-safe, and when two clients insert two same key
     // concurrently, this function can assure that only one page is cached.
     // The in_memory page will have higher priority.
-    void insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory = false);
+    void insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory = false,
+                bool is_index_page = false);
+
+    bool has_decoded_page_cache() const { return _decoded_cache != nullptr; }
+
+    // Lookup the decoded page of the data page of |key|, return nullptr if it's not found.
+    // prerequisite: has_decoded_page_cache() is true.
+    std::shared_ptr<const segment_v2::DecodedPage> lookup_decoded_page(const CacheKey& key);
+
+    // Insert the decoded page of the data page of |key|, whose memory usage is |charge|.
+    // prerequisite: has_decoded_page_cache() is true.
+    void insert_decoded_page(const CacheKey& key, std::shared_ptr<const segment_v2::DecodedPage> page,
+                             size_t charge);
 
-    size_t memory_usage() const { return _cache->get_memory_usage(); }
+    size_t memory_usage() const;
+
+    size_t data_memory_usage() const { return _data_cache->get_memory_usage(); }
+    // 0 if the index pages are cached with the data pages.
+    size_t index_memory_usage() const { return _index_cache != nullptr ? _index_cache->get_memory_usage() : 0; }
 
 private:
+    Cache* _get_cache(bool is_index_page) const {
+        return is_index_page && _index_cache != nullptr ? _index_cache.get() : _data_cache.get();
+    }
+
     static StoragePageCache* _s_instance;
 
     MemTracker* _mem_tracker = nullptr;
-    std::unique_ptr<Cache> _cache = nullptr;
+    std::unique_ptr<Cache> _data_cache = nullptr;
+    // nullptr if the index pages are cached with the data pages.
+    std::unique_ptr<Cache> _index_cache = nullptr;
+    // nullptr if the decoded pages are not cached.
+    std::unique_ptr<Cache> _decoded_cache = nullptr;
 };
 
 // A handle for StoragePageCache entry. This class make it easy to handle
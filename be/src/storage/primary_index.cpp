@@ -4,15 +4,23 @@
 
 #include <mutex>
 
+#include "env/env.h"
+#include "gen_cpp/olap_file.pb.h"
+#include "storage/del_vector.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset.h"
 #include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/tablet.h"
+#include "storage/storage_engine.h"
 #include "storage/tablet_updates.h"
+#include "storage/update_manager.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/reader.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
 #include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -25,6 +33,92 @@ using vectorized::PhmapSeed1;
 
 using tablet_rowid_t = uint64_t;
 
+// The snapshot file of a primary index consists of the entries of the index, each of which is the key followed
+// by its 8-byte position, then a PrimaryIndexSnapshotPB, its 4-byte size, and the 4-byte crc32c checksum of
+// both the entries and the PrimaryIndexSnapshotPB.
+static const size_t kSnapshotBufferSize = 1024 * 1024;
+
+// Writes the entries of a primary index snapshot through a buffer.
+class IndexSnapshotWriter {
+public:
+    explicit IndexSnapshotWriter(WritableFile* file) : _file(file) { _buffer.reserve(kSnapshotBufferSize); }
+
+    Status append(const void* data, size_t size) {
+        _buffer.append(reinterpret_cast<const char*>(data), size);
+        return _buffer.size() >= kSnapshotBufferSize ? _flush() : Status::OK();
+    }
+
+    Status finish(const PrimaryIndexSnapshotPB& snapshot) {
+        RETURN_IF_ERROR(_flush());
+        if (!snapshot.SerializeToString(&_buffer)) {
+            return Status::InternalError("failed to serialize primary index snapshot");
+        }
+        uint32_t footer_size = _buffer.size();
+        _checksum = crc32c::Extend(_checksum, _buffer.data(), _buffer.size());
+        put_fixed32_le(&_buffer, footer_size);
+        put_fixed32_le(&_buffer, _checksum);
+        return _file->append(_buffer);
+    }
+
+private:
+    Status _flush() {
+        _checksum = crc32c::Extend(_checksum, _buffer.data(), _buffer.size());
+        RETURN_IF_ERROR(_file->append(_buffer));
+        _buffer.clear();
+        return Status::OK();
+    }
+
+    WritableFile* _file;
+    std::string _buffer;
+    uint32_t _checksum = 0;
+};
+
+// Reads the |size| bytes of the entries of a primary index snapshot through a buffer.
+class IndexSnapshotReader {
+public:
+    IndexSnapshotReader(RandomAccessFile* file, uint64_t size) : _file(file), _size(size) {}
+
+    Status read(void* data, size_t size) {
+        auto* dst = reinterpret_cast<char*>(data);
+        while (size > 0) {
+            if (_pos == _buffer.size()) {
+                RETURN_IF_ERROR(_fill());
+            }
+            size_t n = std::min(size, _buffer.size() - _pos);
+            memcpy(dst, _buffer.data() + _pos, n);
+            _pos += n;
+            dst += n;
+            size -= n;
+        }
+        return Status::OK();
+    }
+
+    bool eof() const { return _pos == _buffer.size() && _offset == _size; }
+
+    // The checksum of the bytes read so far.
+    uint32_t checksum() const { return _checksum; }
+
+private:
+    Status _fill() {
+        if (_offset == _size) {
+            return Status::Corruption("unexpected end of primary index snapshot");
+        }
+        _buffer.resize(std::min<uint64_t>(kSnapshotBufferSize, _size - _offset));
+        RETURN_IF_ERROR(_file->read_at(_offset, Slice(_buffer)));
+        _checksum = crc32c::Extend(_checksum, _buffer.data(), _buffer.size());
+        _offset += _buffer.size();
+        _pos = 0;
+        return Status::OK();
+    }
+
+    RandomAccessFile* _file;
+    const uint64_t _size;
+    uint64_t _offset = 0;
+    std::string _buffer;
+    size_t _pos = 0;
+    uint32_t _checksum = 0;
+};
+
 class HashIndex {
 public:
     using DeletesMap = PrimaryIndex::DeletesMap;
@@ -48,6 +142,26 @@ public:
     virtual void try_replace(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
                              const vector<uint32_t>& src_rssid, vector<uint32_t>* failed) = 0;
     virtual void erase(const vectorized::Column& pks, DeletesMap* deletes) = 0;
+    // Set |positions[i]| to the position of |pks[i]|, or PrimaryIndex::kNullPosition if it's absent.
+    virtual void get(const vectorized::Column& pks, std::vector<tablet_rowid_t>* positions) const = 0;
+
+    // Same as insert() and upsert(), but the keys are processed by the submaps of the hash map they belong to
+    // concurrently in |pool|. The deletes are appended to |deletes| in no particular order.
+    virtual Status parallel_insert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
+                                   ThreadPool* pool) {
+        return insert(rssid, rowids, pks);
+    }
+    virtual void parallel_upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks,
+                                 DeletesMap* deletes, ThreadPool* pool) {
+        upsert(rssid, rowid_start, pks, deletes);
+    }
+
+    // Append all the entries to |writer|, in no particular order.
+    virtual Status save(IndexSnapshotWriter* writer) const = 0;
+    // Insert |num| entries appended by save() from |reader|.
+    virtual Status load(size_t num, IndexSnapshotReader* reader) = 0;
+    // Erase the entries whose positions satisfy |pred|.
+    virtual void erase_if(const std::function<bool(tablet_rowid_t)>& pred) = 0;
 
     // just an estimate value for now.
     virtual std::size_t memory_usage() const = 0;
@@ -89,6 +203,148 @@ public:
 
 const uint32_t PREFETCHN = 8;
 
+// Save and load the entries of the maps whose keys are trivially copyable and whose values are RowIdPack4.
+template <typename Map>
+Status save_fixed_size_entries(const Map& map, IndexSnapshotWriter* writer) {
+    for (const auto& e : map) {
+        tablet_rowid_t value = e.second.value;
+        RETURN_IF_ERROR(writer->append(&e.first, sizeof(e.first)));
+        RETURN_IF_ERROR(writer->append(&value, sizeof(value)));
+    }
+    return Status::OK();
+}
+
+// |hash| must be the same hash function used to insert and find the keys of |map|.
+template <typename Map, typename Hash>
+Status load_fixed_size_entries(size_t num, IndexSnapshotReader* reader, const Hash& hash, Map* map) {
+    typename Map::key_type key;
+    tablet_rowid_t value;
+    for (size_t i = 0; i < num; i++) {
+        RETURN_IF_ERROR(reader->read(&key, sizeof(key)));
+        RETURN_IF_ERROR(reader->read(&value, sizeof(value)));
+        if (!map->emplace_with_hash(hash(key), key, RowIdPack4(value)).second) {
+            return Status::Corruption("duplicate key in primary index snapshot");
+        }
+    }
+    return Status::OK();
+}
+
+template <typename Map>
+void erase_entries_if(const std::function<bool(tablet_rowid_t)>& pred, Map* map) {
+    for (auto iter = map->begin(); iter != map->end();) {
+        if (pred(iter->second.value)) {
+            map->erase(iter++);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+// The rows of a batch grouped by the submaps of the hash map their keys belong to, so that the submaps can be
+// updated concurrently without locks, and each of them is updated at once to make good use of the cache.
+// The hashes of the keys are computed only once.
+struct ShardedRows {
+    std::vector<size_t> hashes;
+    // The indexes of the rows of the i-th submap are rows[offsets[i], offsets[i + 1]), in the order of the batch.
+    std::vector<uint32_t> rows;
+    std::vector<uint32_t> offsets;
+
+    template <typename Map, typename KeyAt, typename Hash>
+    void init(const Map& map, uint32_t n, const KeyAt& key_at, const Hash& hash) {
+        hashes.resize(n);
+        offsets.assign(map.subcnt() + 1, 0);
+        for (uint32_t i = 0; i < n; i++) {
+            hashes[i] = hash(key_at(i));
+            offsets[map.subidx(hashes[i]) + 1]++;
+        }
+        for (size_t i = 1; i < offsets.size(); i++) {
+            offsets[i] += offsets[i - 1];
+        }
+        std::vector<uint32_t> pos(offsets.begin(), offsets.end() - 1);
+        rows.resize(n);
+        for (uint32_t i = 0; i < n; i++) {
+            rows[pos[map.subidx(hashes[i])]++] = i;
+        }
+    }
+
+    size_t num_shards() const { return offsets.size() - 1; }
+};
+
+// Run |func| for each shard in |pool|, the shards that fail to be submitted are run in the calling thread.
+static void run_by_shards(ThreadPool* pool, size_t num_shards, const std::function<void(size_t)>& func) {
+    auto token = pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    for (size_t shard = 0; shard < num_shards; shard++) {
+        if (!token->submit_func([&func, shard]() { func(shard); }).ok()) {
+            func(shard);
+        }
+    }
+    token->wait();
+}
+
+// |key_at(i)| returns the key of the i-th row, and |value_at(i)| returns its position.
+// |key_to_string(i)| describes the key of the i-th row in the error message.
+template <typename Map, typename KeyAt, typename ValueAt, typename KeyToString>
+Status sharded_insert(Map* map, const ShardedRows& sharded, const KeyAt& key_at, const ValueAt& value_at,
+                      const KeyToString& key_to_string, ThreadPool* pool) {
+    std::vector<Status> statuses(sharded.num_shards());
+    run_by_shards(pool, sharded.num_shards(), [&](size_t shard) {
+        const uint32_t end = sharded.offsets[shard + 1];
+        for (uint32_t j = sharded.offsets[shard]; j < end; j++) {
+            uint32_t prefetch_j = j + PREFETCHN;
+            if (LIKELY(prefetch_j < end)) map->prefetch_hash(sharded.hashes[sharded.rows[prefetch_j]]);
+            uint32_t i = sharded.rows[j];
+            RowIdPack4 v(value_at(i));
+            auto p = map->emplace_with_hash(sharded.hashes[i], key_at(i), v);
+            if (!p.second) {
+                uint64_t old = p.first->second.value;
+                std::string msg = strings::Substitute(
+                        "insert found duplicate key new(rssid=$0 rowid=$1) old(rssid=$2 rowid=$3) key=$4",
+                        (uint32_t)(v.value >> 32), (uint32_t)(v.value & 0xffffffff), (uint32_t)(old >> 32),
+                        (uint32_t)(old & 0xffffffff), key_to_string(i));
+                LOG(ERROR) << msg;
+                statuses[shard] = Status::InternalError(msg);
+                return;
+            }
+        }
+    });
+    for (auto& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
+    return Status::OK();
+}
+
+template <typename Map, typename KeyAt, typename ValueAt>
+void sharded_upsert(Map* map, const ShardedRows& sharded, const KeyAt& key_at, const ValueAt& value_at,
+                    ThreadPool* pool, PrimaryIndex::DeletesMap* deletes) {
+    std::vector<PrimaryIndex::DeletesMap> shard_deletes(sharded.num_shards());
+    run_by_shards(pool, sharded.num_shards(), [&](size_t shard) {
+        auto& dels = shard_deletes[shard];
+        const uint32_t end = sharded.offsets[shard + 1];
+        for (uint32_t j = sharded.offsets[shard]; j < end; j++) {
+            uint32_t prefetch_j = j + PREFETCHN;
+            if (LIKELY(prefetch_j < end)) map->prefetch_hash(sharded.hashes[sharded.rows[prefetch_j]]);
+            uint32_t i = sharded.rows[j];
+            RowIdPack4 v(value_at(i));
+            auto p = map->emplace_with_hash(sharded.hashes[i], key_at(i), v);
+            if (!p.second) {
+                uint64_t old = p.first->second.value;
+                if ((old >> 32) == (v.value >> 32)) {
+                    LOG(ERROR) << "found duplicate in upsert data rssid:" << (v.value >> 32) << " idx=" << i
+                               << " rowid=" << (v.value & 0xffffffff);
+                }
+                dels[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
+                p.first->second = v;
+            }
+        }
+    });
+    for (auto& dels : shard_deletes) {
+        for (auto& [rssid, rowids] : dels) {
+            auto& dst = (*deletes)[rssid];
+            dst.insert(dst.end(), rowids.begin(), rowids.end());
+        }
+    }
+}
+
 template <typename Key>
 class HashIndexImpl : public HashIndex {
 private:
@@ -232,6 +488,15 @@ public:
         }
     }
 
+    void get(const vectorized::Column& pks, std::vector<tablet_rowid_t>* positions) const override {
+        auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
+        positions->resize(pks.size());
+        for (size_t i = 0; i < pks.size(); i++) {
+            auto iter = _map.find(keys[i]);
+            (*positions)[i] = iter != _map.end() ? iter->second.value : PrimaryIndex::kNullPosition;
+        }
+    }
+
     void erase(const vectorized::Column& pks, DeletesMap* deletes) override {
         auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
         auto size = pks.size();
@@ -247,6 +512,38 @@ public:
         }
     }
 
+    Status parallel_insert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
+                           ThreadPool* pool) override {
+        auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
+        DCHECK(pks.size() == rowids.size());
+        uint64_t base = (((uint64_t)rssid) << 32);
+        auto key_at = [keys](uint32_t i) -> const Key& { return keys[i]; };
+        ShardedRows sharded;
+        sharded.init(_map, pks.size(), key_at, [this](const Key& key) { return _map.hash(key); });
+        return sharded_insert(
+                &_map, sharded, key_at, [&](uint32_t i) { return base + rowids[i]; },
+                [keys](uint32_t i) { return strings::Substitute("$0", keys[i]); }, pool);
+    }
+
+    void parallel_upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks, DeletesMap* deletes,
+                         ThreadPool* pool) override {
+        auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
+        uint64_t base = (((uint64_t)rssid) << 32) + rowid_start;
+        auto key_at = [keys](uint32_t i) -> const Key& { return keys[i]; };
+        ShardedRows sharded;
+        sharded.init(_map, pks.size(), key_at, [this](const Key& key) { return _map.hash(key); });
+        sharded_upsert(&_map, sharded, key_at, [base](uint32_t i) { return base + i; }, pool, deletes);
+    }
+
+    Status save(IndexSnapshotWriter* writer) const override { return save_fixed_size_entries(_map, writer); }
+
+    Status load(size_t num, IndexSnapshotReader* reader) override {
+        return load_fixed_size_entries(
+                num, reader, [this](const Key& key) { return _map.hash(key); }, &_map);
+    }
+
+    void erase_if(const std::function<bool(tablet_rowid_t)>& pred) override { erase_entries_if(pred, &_map); }
+
     std::size_t memory_usage() const final {
         return _map.capacity() * (1 + (sizeof(Key) + 3) / 4 * 4 + sizeof(RowIdPack4));
     }
@@ -498,6 +795,17 @@ public:
         }
     }
 
+    void get(const vectorized::Column& pks, std::vector<tablet_rowid_t>* positions) const override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        positions->resize(pks.size());
+        for (size_t i = 0; i < pks.size(); i++) {
+            FixSlice<S> key;
+            key.assign(keys[i]);
+            auto iter = _map.find(key);
+            (*positions)[i] = iter != _map.end() ? iter->second.value : PrimaryIndex::kNullPosition;
+        }
+    }
+
     void erase(const vectorized::Column& pks, DeletesMap* deletes) override {
         auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
         uint32_t size = pks.size();
@@ -525,6 +833,42 @@ public:
         }
     }
 
+    Status parallel_insert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
+                           ThreadPool* pool) override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        DCHECK(pks.size() == rowids.size());
+        uint64_t base = (((uint64_t)rssid) << 32);
+        std::vector<FixSlice<S>> fix_keys(keys, keys + pks.size());
+        auto key_at = [&fix_keys](uint32_t i) -> const FixSlice<S>& { return fix_keys[i]; };
+        ShardedRows sharded;
+        sharded.init(_map, pks.size(), key_at, FixSliceHash<S>());
+        return sharded_insert(
+                &_map, sharded, key_at, [&](uint32_t i) { return base + rowids[i]; },
+                [keys](uint32_t i) {
+                    return strings::Substitute("$0 [$1]", keys[i].to_string(), hexdump(keys[i].data, keys[i].size));
+                },
+                pool);
+    }
+
+    void parallel_upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks, DeletesMap* deletes,
+                         ThreadPool* pool) override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        uint64_t base = (((uint64_t)rssid) << 32) + rowid_start;
+        std::vector<FixSlice<S>> fix_keys(keys, keys + pks.size());
+        auto key_at = [&fix_keys](uint32_t i) -> const FixSlice<S>& { return fix_keys[i]; };
+        ShardedRows sharded;
+        sharded.init(_map, pks.size(), key_at, FixSliceHash<S>());
+        sharded_upsert(&_map, sharded, key_at, [base](uint32_t i) { return base + i; }, pool, deletes);
+    }
+
+    Status save(IndexSnapshotWriter* writer) const override { return save_fixed_size_entries(_map, writer); }
+
+    Status load(size_t num, IndexSnapshotReader* reader) override {
+        return load_fixed_size_entries(num, reader, FixSliceHash<S>(), &_map);
+    }
+
+    void erase_if(const std::function<bool(tablet_rowid_t)>& pred) override { erase_entries_if(pred, &_map); }
+
     std::size_t memory_usage() const final { return _map.capacity() * (1 + S * 4 + sizeof(RowIdPack4)); }
 
     std::string memory_info() const {
@@ -714,6 +1058,15 @@ public:
         }
     }
 
+    void get(const vectorized::Column& pks, std::vector<tablet_rowid_t>* positions) const override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        positions->resize(pks.size());
+        for (size_t i = 0; i < pks.size(); i++) {
+            auto iter = _map.find(keys[i].to_string());
+            (*positions)[i] = iter != _map.end() ? iter->second : PrimaryIndex::kNullPosition;
+        }
+    }
+
     void erase(const vectorized::Column& pks, DeletesMap* deletes) override {
         auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
         uint32_t size = pks.size();
@@ -733,6 +1086,44 @@ public:
         }
     }
 
+    Status save(IndexSnapshotWriter* writer) const override {
+        for (const auto& e : _map) {
+            uint32_t length = e.first.size();
+            RETURN_IF_ERROR(writer->append(&length, sizeof(length)));
+            RETURN_IF_ERROR(writer->append(e.first.data(), length));
+            RETURN_IF_ERROR(writer->append(&e.second, sizeof(e.second)));
+        }
+        return Status::OK();
+    }
+
+    Status load(size_t num, IndexSnapshotReader* reader) override {
+        string key;
+        tablet_rowid_t value;
+        for (size_t i = 0; i < num; i++) {
+            uint32_t length;
+            RETURN_IF_ERROR(reader->read(&length, sizeof(length)));
+            key.resize(length);
+            RETURN_IF_ERROR(reader->read(key.data(), length));
+            RETURN_IF_ERROR(reader->read(&value, sizeof(value)));
+            if (!_map.emplace(key, value).second) {
+                return Status::Corruption("duplicate key in primary index snapshot");
+            }
+            _total_length += length;
+        }
+        return Status::OK();
+    }
+
+    void erase_if(const std::function<bool(tablet_rowid_t)>& pred) override {
+        for (auto iter = _map.begin(); iter != _map.end();) {
+            if (pred(iter->second)) {
+                _total_length -= iter->first.size();
+                _map.erase(iter++);
+            } else {
+                ++iter;
+            }
+        }
+    }
+
     std::size_t memory_usage() const final {
         // TODO(cbl): more accurate value
         size_t ret = _map.capacity() * (1 + 32 + sizeof(tablet_rowid_t));
@@ -810,6 +1201,10 @@ PrimaryIndex::PrimaryIndex(const vectorized::Schema& pk_schema) {
     _set_schema(pk_schema);
 }
 
+bool PrimaryIndex::_parallel(size_t num_keys) const {
+    return _thread_pool != nullptr && (int64_t)num_keys >= config::primary_index_parallel_batch_rows;
+}
+
 void PrimaryIndex::_set_schema(const vectorized::Schema& pk_schema) {
     _pk_schema = pk_schema;
     _enc_pk_type = PrimaryKeyEncoder::encoded_primary_key_type(_pk_schema);
@@ -838,6 +1233,7 @@ void PrimaryIndex::unload() {
         _pkey_to_rssid_rowid.reset();
     }
     _status = Status::OK();
+    _changed_keys = 0;
     _loaded = false;
 }
 
@@ -856,8 +1252,6 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
     MonotonicStopWatch timer;
     timer.start();
     using vectorized::ChunkHelper;
-    using TabletReader = vectorized::Reader;
-    using ReaderParams = vectorized::ReaderParams;
 
     const TabletSchema& tablet_schema = tablet->tablet_schema();
     vector<ColumnId> pk_columns(tablet_schema.num_key_columns());
@@ -866,6 +1260,9 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
     }
     auto pkey_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, pk_columns);
     _set_schema(pkey_schema);
+    if (_thread_pool == nullptr && StorageEngine::instance() != nullptr) {
+        _thread_pool = StorageEngine::instance()->update_manager()->index_thread_pool();
+    }
 
     int64_t apply_version = 0;
     std::vector<RowsetSharedPtr> rowsets;
@@ -892,119 +1289,317 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
                   << " #rowset:" << rowsets.size() << " #segment:" << total_segments << " #row:" << total_rows << " -"
                   << total_dels << "=" << total_rows - total_dels << " bytes:" << total_data_size;
     }
-    if (total_rows > total_dels) {
-        _pkey_to_rssid_rowid->reserve(total_rows - total_dels);
+
+    std::vector<RowsetSharedPtr> delta_rowsets;
+    st = _load_snapshot(tablet, apply_version, rowsets, &delta_rowsets);
+    if (st.ok()) {
+        size_t snapshot_size = size();
+        st = _insert_rowsets(tablet, apply_version, delta_rowsets, rowset_ids);
+        if (st.ok()) {
+            _changed_keys = size() - snapshot_size;
+            LOG(INFO) << "load primary index from snapshot tablet:" << tablet->tablet_id()
+                      << " version:" << apply_version << " snapshot size:" << snapshot_size
+                      << " #delta rowset:" << delta_rowsets.size();
+        } else {
+            LOG(WARNING) << "load primary index from snapshot failed, load from all rowsets instead tablet:"
+                         << tablet->tablet_id() << " reason:" << st;
+        }
+    } else if (!st.is_not_found()) {
+        LOG(WARNING) << "load primary index snapshot failed tablet:" << tablet->tablet_id() << " reason:" << st;
+    }
+    if (!st.ok()) {
+        _set_schema(pkey_schema);
+        if (total_rows > total_dels) {
+            _pkey_to_rssid_rowid->reserve(total_rows - total_dels);
+        }
+        RETURN_IF_ERROR(_insert_rowsets(tablet, apply_version, rowsets, rowset_ids));
+        _changed_keys = size();
     }
 
+    _tablet_id = tablet->tablet_id();
+    if (size() != total_rows - total_dels) {
+        LOG(WARNING) << Substitute("load primary index row count not match tablet:$0 index:$1 != stats:$2", _tablet_id,
+                                   size(), total_rows - total_dels);
+    }
+    LOG(INFO) << "load primary index finish tablet:" << tablet->tablet_id() << " version:" << apply_version
+              << " #rowset:" << rowsets.size() << " #segment:" << total_segments << " data_size:" << total_data_size
+              << " rowsets:" << int_list_to_string(rowset_ids) << " size:" << size() << " capacity:" << capacity()
+              << " memory:" << memory_usage() << " duration: " << timer.elapsed_time() / 1000000 << "ms";
+    return Status::OK();
+}
+
+// The encoded primary keys of the live rows of a segment.
+struct SegmentKeys {
+    uint32_t rssid = 0;
+    std::unique_ptr<Column> pks;
+    vector<uint32_t> rowids;
+};
+
+static Status read_segment_keys(const vectorized::Schema& pk_schema, OlapMeta* meta, int64_t version,
+                                BetaRowset* rowset, uint32_t segment_id, SegmentKeys* keys) {
     OlapReaderStatistics stats;
-    std::unique_ptr<vectorized::Column> pk_column;
-    if (pk_columns.size() > 1) {
-        if (!PrimaryKeyEncoder::create_column(pkey_schema, &pk_column).ok()) {
-            CHECK(false) << "create column for primary key encoder failed";
-        }
+    auto res = rowset->get_segment_iterator2(pk_schema, meta, version, segment_id, &stats);
+    if (!res.ok()) {
+        return res.status();
     }
+    auto itr = std::move(res).value();
+    keys->rssid = rowset->rowset_meta()->get_rowset_seg_id() + segment_id;
+    if (itr == nullptr) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(PrimaryKeyEncoder::create_column(pk_schema, &keys->pks));
     // only hold pkey, so can use larger chunk size
     vector<uint32_t> rowids;
     rowids.reserve(4096);
-    auto chunk_shared_ptr = ChunkHelper::new_chunk(pkey_schema, 4096);
+    auto chunk_shared_ptr = ChunkHelper::new_chunk(pk_schema, 4096);
     auto chunk = chunk_shared_ptr.get();
+    Status st;
+    while (true) {
+        chunk->reset();
+        rowids.clear();
+        st = itr->get_next(chunk, &rowids);
+        if (!st.ok()) {
+            break;
+        }
+        PrimaryKeyEncoder::encode(pk_schema, *chunk, 0, chunk->num_rows(), keys->pks.get());
+        keys->rowids.insert(keys->rowids.end(), rowids.begin(), rowids.end());
+    }
+    itr->close();
+    return st.is_end_of_file() ? Status::OK() : st;
+}
+
+Status PrimaryIndex::_insert_rowsets(Tablet* tablet, int64_t apply_version, const std::vector<RowsetSharedPtr>& rowsets,
+                                     const std::vector<uint32_t>& rowset_ids) {
+    std::vector<std::unique_ptr<RowsetReleaseGuard>> guards;
+    std::vector<std::pair<BetaRowset*, uint32_t>> segments;
     for (auto& rowset : rowsets) {
-        RowsetReleaseGuard guard(rowset);
-        auto beta_rowset = down_cast<BetaRowset*>(rowset.get());
-        auto res =
-                beta_rowset->get_segment_iterators2(pkey_schema, tablet->data_dir()->get_meta(), apply_version, &stats);
-        if (!res.ok()) {
-            return res.status();
+        guards.emplace_back(std::make_unique<RowsetReleaseGuard>(rowset));
+        for (uint32_t i = 0; i < rowset->num_segments(); i++) {
+            segments.emplace_back(down_cast<BetaRowset*>(rowset.get()), i);
         }
-        auto& itrs = res.value();
-        // TODO(cbl): auto close iterators on failure
-        CHECK(itrs.size() == rowset->num_segments()) << "itrs.size != num_segments";
-        for (size_t i = 0; i < itrs.size(); i++) {
-            auto itr = itrs[i].get();
-            if (itr == NULL) {
+    }
+
+    // The segments are read concurrently in the thread pool, a window of them at a time, and their keys are
+    // inserted in order by the calling thread.
+    const size_t window = _thread_pool != nullptr ? std::max(1, config::primary_index_threads) : 1;
+    std::vector<SegmentKeys> keys(window);
+    std::vector<Status> statuses(window);
+    OlapMeta* meta = tablet->data_dir()->get_meta();
+    for (size_t start = 0; start < segments.size(); start += window) {
+        const size_t n = std::min(window, segments.size() - start);
+        auto read = [&](size_t j) {
+            keys[j] = SegmentKeys();
+            statuses[j] = read_segment_keys(_pk_schema, meta, apply_version, segments[start + j].first,
+                                            segments[start + j].second, &keys[j]);
+        };
+        if (n > 1) {
+            run_by_shards(_thread_pool, n, read);
+        } else {
+            read(0);
+        }
+        for (size_t j = 0; j < n; j++) {
+            RETURN_IF_ERROR(statuses[j]);
+            if (keys[j].pks == nullptr) {
                 continue;
             }
-            while (true) {
-                chunk->reset();
-                rowids.clear();
-                auto st = itr->get_next(chunk, &rowids);
-                if (st.is_end_of_file()) {
-                    break;
-                } else if (!st.ok()) {
-                    return st;
-                } else {
-                    Column* pkc = nullptr;
-                    if (pk_column) {
-                        pk_column->reset_column();
-                        PrimaryKeyEncoder::encode(pkey_schema, *chunk, 0, chunk->num_rows(), pk_column.get());
-                        pkc = pk_column.get();
-                    } else {
-                        pkc = chunk->columns()[0].get();
-                    }
-                    auto st = insert(rowset->rowset_meta()->get_rowset_seg_id() + i, rowids, *pkc);
-                    if (!st.ok()) {
-                        LOG(ERROR) << "load index failed: tablet=" << tablet->tablet_id()
-                                   << " rowsets:" << int_list_to_string(rowset_ids)
-                                   << " rowset:" << rowset->rowset_meta()->get_rowset_seg_id() << " segment:" << i
-                                   << " reason: " << st.to_string() << " current_size:" << size()
-                                   << " updates: " << tablet->updates()->debug_string();
-                        return st;
-                    }
-                }
+            auto st = insert(keys[j].rssid, keys[j].rowids, *keys[j].pks);
+            if (!st.ok()) {
+                auto rowset = segments[start + j].first;
+                LOG(ERROR) << "load index failed: tablet=" << tablet->tablet_id()
+                           << " rowsets:" << int_list_to_string(rowset_ids)
+                           << " rowset:" << rowset->rowset_meta()->get_rowset_seg_id()
+                           << " segment:" << segments[start + j].second << " reason: " << st.to_string()
+                           << " current_size:" << size() << " updates: " << tablet->updates()->debug_string();
+                return st;
             }
-            itr->close();
         }
     }
-    _tablet_id = tablet->tablet_id();
-    if (size() != total_rows - total_dels) {
-        LOG(WARNING) << Substitute("load primary index row count not match tablet:$0 index:$1 != stats:$2", _tablet_id,
-                                   size(), total_rows - total_dels);
+    return Status::OK();
+}
+
+std::string PrimaryIndex::snapshot_path(const Tablet& tablet) {
+    return Substitute("$0/$1.pkidx", tablet.tablet_path(), tablet.tablet_id());
+}
+
+Status PrimaryIndex::_load_snapshot(Tablet* tablet, int64_t apply_version, const std::vector<RowsetSharedPtr>& rowsets,
+                                    std::vector<RowsetSharedPtr>* delta_rowsets) {
+    if (!config::enable_primary_index_snapshot) {
+        return Status::NotFound("primary index snapshot is disabled");
     }
-    LOG(INFO) << "load primary index finish tablet:" << tablet->tablet_id() << " version:" << apply_version
-              << " #rowset:" << rowsets.size() << " #segment:" << total_segments << " data_size:" << total_data_size
-              << " rowsets:" << int_list_to_string(rowset_ids) << " size:" << size() << " capacity:" << capacity()
-              << " memory:" << memory_usage() << " duration: " << timer.elapsed_time() / 1000000 << "ms";
+    Env* env = Env::Default();
+    const std::string path = snapshot_path(*tablet);
+    RETURN_IF_ERROR(env->path_exists(path));
+    std::unique_ptr<RandomAccessFile> rfile;
+    RETURN_IF_ERROR(env->new_random_access_file(path, &rfile));
+    uint64_t file_size = 0;
+    RETURN_IF_ERROR(rfile->size(&file_size));
+    uint8_t fixed_buf[8];
+    if (file_size < sizeof(fixed_buf)) {
+        return Status::Corruption(Substitute("primary index snapshot $0 is too small", path));
+    }
+    RETURN_IF_ERROR(rfile->read_at(file_size - sizeof(fixed_buf), Slice(fixed_buf, sizeof(fixed_buf))));
+    uint32_t footer_size = decode_fixed32_le(fixed_buf);
+    uint32_t checksum = decode_fixed32_le(fixed_buf + 4);
+    if (file_size < sizeof(fixed_buf) + footer_size) {
+        return Status::Corruption(Substitute("bad footer size of primary index snapshot $0", path));
+    }
+    const uint64_t entries_size = file_size - sizeof(fixed_buf) - footer_size;
+    std::string footer(footer_size, '\0');
+    RETURN_IF_ERROR(rfile->read_at(entries_size, Slice(footer)));
+    PrimaryIndexSnapshotPB snapshot;
+    if (!snapshot.ParseFromString(footer)) {
+        return Status::Corruption(Substitute("bad footer of primary index snapshot $0", path));
+    }
+    if (snapshot.version() > apply_version || snapshot.encoded_key_type() != _enc_pk_type ||
+        snapshot.encoded_key_fixed_size() != PrimaryKeyEncoder::get_encoded_fixed_size(_pk_schema)) {
+        return Status::NotFound(Substitute("primary index snapshot $0 doesn't match the tablet", path));
+    }
+
+    // The rowsets of the snapshot that are still there, by the segment id of their first segments.
+    std::map<uint32_t, RowsetSharedPtr> kept_rowsets;
+    std::unordered_map<uint32_t, const PrimaryIndexSnapshotRowsetPB*> snapshot_rowsets;
+    for (const auto& rowset_pb : snapshot.rowsets()) {
+        snapshot_rowsets[rowset_pb.rowset_seg_id()] = &rowset_pb;
+    }
+    for (const auto& rowset : rowsets) {
+        uint32_t rssid = rowset->rowset_meta()->get_rowset_seg_id();
+        auto iter = snapshot_rowsets.find(rssid);
+        if (iter != snapshot_rowsets.end() && iter->second->rowset_id() == rowset->rowset_id().to_string() &&
+            iter->second->num_segments() == rowset->num_segments()) {
+            kept_rowsets.emplace(rssid, rowset);
+        } else {
+            delta_rowsets->push_back(rowset);
+        }
+    }
+
+    IndexSnapshotReader reader(rfile.get(), entries_size);
+    _pkey_to_rssid_rowid->reserve(snapshot.num_entries());
+    RETURN_IF_ERROR(_pkey_to_rssid_rowid->load(snapshot.num_entries(), &reader));
+    if (!reader.eof() || crc32c::Extend(reader.checksum(), footer.data(), footer.size()) != checksum) {
+        return Status::Corruption(Substitute("bad checksum of primary index snapshot $0", path));
+    }
+
+    // The delete vectors at |apply_version| of the kept segments, the positions in the other segments and the
+    // deleted positions are erased.
+    auto manager = StorageEngine::instance()->update_manager();
+    std::unordered_map<uint32_t, DelVectorPtr> delvecs;
+    TabletSegmentId tsid;
+    tsid.tablet_id = tablet->tablet_id();
+    for (const auto& [rssid, rowset] : kept_rowsets) {
+        for (uint32_t i = 0; i < rowset->num_segments(); i++) {
+            tsid.segment_id = rssid + i;
+            RETURN_IF_ERROR(
+                    manager->get_del_vec(tablet->data_dir()->get_meta(), tsid, apply_version, &delvecs[rssid + i]));
+        }
+    }
+    _pkey_to_rssid_rowid->erase_if([&](tablet_rowid_t value) {
+        auto iter = delvecs.find((uint32_t)(value >> 32));
+        if (iter == delvecs.end()) {
+            return true;
+        }
+        DelVector* delvec = iter->second.get();
+        return !delvec->empty() && delvec->roaring()->contains((uint32_t)(value & 0xffffffff));
+    });
+    return Status::OK();
+}
+
+Status PrimaryIndex::save_snapshot(Tablet* tablet) {
+    DCHECK(_loaded && _status.ok() && _pkey_to_rssid_rowid);
+    MonotonicStopWatch timer;
+    timer.start();
+    int64_t apply_version = 0;
+    std::vector<RowsetSharedPtr> rowsets;
+    std::vector<uint32_t> rowset_ids;
+    RETURN_IF_ERROR(tablet->updates()->_get_apply_version_and_rowsets(&apply_version, &rowsets, &rowset_ids));
+
+    PrimaryIndexSnapshotPB snapshot;
+    snapshot.set_version(apply_version);
+    for (const auto& rowset : rowsets) {
+        auto* rowset_pb = snapshot.add_rowsets();
+        rowset_pb->set_rowset_seg_id(rowset->rowset_meta()->get_rowset_seg_id());
+        rowset_pb->set_num_segments(rowset->num_segments());
+        rowset_pb->set_rowset_id(rowset->rowset_id().to_string());
+    }
+    snapshot.set_encoded_key_type(_enc_pk_type);
+    snapshot.set_encoded_key_fixed_size(PrimaryKeyEncoder::get_encoded_fixed_size(_pk_schema));
+    snapshot.set_num_entries(size());
+
+    // Write a temporary file first, so that a crash never leaves a partial snapshot.
+    Env* env = Env::Default();
+    const std::string path = snapshot_path(*tablet);
+    const std::string tmp_path = path + ".tmp";
+    std::unique_ptr<WritableFile> wfile;
+    RETURN_IF_ERROR(env->new_writable_file(tmp_path, &wfile));
+    IndexSnapshotWriter writer(wfile.get());
+    RETURN_IF_ERROR(_pkey_to_rssid_rowid->save(&writer));
+    RETURN_IF_ERROR(writer.finish(snapshot));
+    RETURN_IF_ERROR(wfile->sync());
+    RETURN_IF_ERROR(wfile->close());
+    RETURN_IF_ERROR(env->rename_file(tmp_path, path));
+    _changed_keys = 0;
+    LOG(INFO) << "save primary index snapshot tablet:" << tablet->tablet_id() << " version:" << apply_version
+              << " size:" << size() << " file_size:" << wfile->size()
+              << " duration: " << timer.elapsed_time() / 1000000 << "ms";
     return Status::OK();
 }
 
 Status PrimaryIndex::insert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    _changed_keys += pks.size();
     return _pkey_to_rssid_rowid->insert(rssid, rowid_start, pks);
 }
 
 Status PrimaryIndex::insert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    _changed_keys += pks.size();
+    if (_parallel(pks.size())) {
+        return _pkey_to_rssid_rowid->parallel_insert(rssid, rowids, pks, _thread_pool);
+    }
     return _pkey_to_rssid_rowid->insert(rssid, rowids, pks);
 }
 
 void PrimaryIndex::upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks, DeletesMap* deletes) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    _changed_keys += pks.size();
+    if (_parallel(pks.size())) {
+        _pkey_to_rssid_rowid->parallel_upsert(rssid, rowid_start, pks, deletes, _thread_pool);
+        return;
+    }
     _pkey_to_rssid_rowid->upsert(rssid, rowid_start, pks, deletes);
 }
 
 void PrimaryIndex::upsert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
                           DeletesMap* deletes) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    _changed_keys += pks.size();
     _pkey_to_rssid_rowid->upsert(rssid, rowids, pks, deletes);
 }
 
 void PrimaryIndex::try_replace(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks,
                                const vector<uint32_t>& src_rssid, vector<uint32_t>* deletes) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    _changed_keys += pks.size();
     _pkey_to_rssid_rowid->try_replace(rssid, rowid_start, pks, src_rssid, deletes);
 }
 
 void PrimaryIndex::try_replace(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
                                const vector<uint32_t>& src_rssid, vector<uint32_t>* deletes) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    _changed_keys += pks.size();
     _pkey_to_rssid_rowid->try_replace(rssid, rowids, pks, src_rssid, deletes);
 }
 
 void PrimaryIndex::erase(const Column& key_col, DeletesMap* deletes) {
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    _changed_keys += key_col.size();
     _pkey_to_rssid_rowid->erase(key_col, deletes);
 }
 
+void PrimaryIndex::get(const Column& key_col, std::vector<tablet_rowid_t>* positions) const {
+    DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    _pkey_to_rssid_rowid->get(key_col, positions);
+}
+
 std::size_t PrimaryIndex::memory_usage() const {
     return _pkey_to_rssid_rowid ? _pkey_to_rssid_rowid->memory_usage() : 0;
 }
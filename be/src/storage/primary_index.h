@@ -12,14 +12,21 @@
 namespace starrocks {
 
 class RowsetUpdateState;
+class Rowset;
+using RowsetSharedPtr = std::shared_ptr<Rowset>;
 class Tablet;
 class TabletMeta;
 using TabletSharedPtr = std::shared_ptr<Tablet>;
 class HashIndex;
+class ThreadPool;
 
 // An index to lookup a record's position(rowset->segment->rowid) by primary key.
 // It's only used to handle updates/deletes in the write pipeline for now.
 // Use a simple in-memory hash_map implementation for demo purpose.
+//
+// If config::enable_primary_index_snapshot is set, the index is saved into a snapshot file in the tablet
+// directory from time to time. It's then loaded from the snapshot, if the snapshot is still usable, plus the
+// rowsets that are not covered by the snapshot, i.e. the ones applied or compacted after the snapshot.
 class PrimaryIndex {
 public:
     using segment_rowid_t = uint32_t;
@@ -27,6 +34,9 @@ public:
     using tablet_rowid_t = uint64_t;
     using TabletRowidColumn = vectorized::UInt64Column;
 
+    // The position of the keys absent from the index returned by get().
+    static constexpr tablet_rowid_t kNullPosition = static_cast<tablet_rowid_t>(-1);
+
     PrimaryIndex();
     PrimaryIndex(const vectorized::Schema& pk_schema);
     ~PrimaryIndex();
@@ -76,6 +86,12 @@ public:
     // [not thread-safe]
     void erase(const vectorized::Column& pks, DeletesMap* deletes);
 
+    // Set |positions[i]| to the position of the *encoded* primary key |pks[i]|, i.e. its rssid in the high 32 bits
+    // and its rowid in the low 32 bits, or kNullPosition if the key is absent.
+    //
+    // [not thread-safe]
+    void get(const vectorized::Column& pks, std::vector<tablet_rowid_t>* positions) const;
+
     // [not thread-safe]
     std::size_t memory_usage() const;
 
@@ -90,11 +106,40 @@ public:
 
     std::string to_string() const;
 
+    // Save this index into the snapshot file of |tablet|. The index must be at the apply version of |tablet|.
+    //
+    // [not thread-safe]
+    Status save_snapshot(Tablet* tablet);
+
+    // The number of the keys inserted, updated or deleted since this index was loaded or saved.
+    //
+    // [not thread-safe]
+    size_t changed_keys_since_snapshot() const { return _changed_keys; }
+
+    static std::string snapshot_path(const Tablet& tablet);
+
+    // The batches of at least config::primary_index_parallel_batch_rows keys are inserted or upserted
+    // concurrently in |pool|. It's set to the index thread pool of the update manager once loaded.
+    void set_thread_pool(ThreadPool* pool) { _thread_pool = pool; }
+
 private:
     void _set_schema(const vectorized::Schema& pk_schema);
 
+    bool _parallel(size_t num_keys) const;
+
     Status _do_load(Tablet* tablet);
 
+    // Load the snapshot of |tablet| into this empty index, if the snapshot is still usable for the rowsets
+    // of |apply_version|, the positions of the rows deleted or compacted since the snapshot are erased.
+    // The rowsets not covered by the snapshot are returned in |delta_rowsets|.
+    // Return NotFound if there's no usable snapshot.
+    Status _load_snapshot(Tablet* tablet, int64_t apply_version, const std::vector<RowsetSharedPtr>& rowsets,
+                          std::vector<RowsetSharedPtr>* delta_rowsets);
+
+    // Insert the live rows of |rowsets| at |apply_version| into this index.
+    Status _insert_rowsets(Tablet* tablet, int64_t apply_version, const std::vector<RowsetSharedPtr>& rowsets,
+                           const std::vector<uint32_t>& rowset_ids);
+
     std::mutex _lock;
     std::atomic<bool> _loaded{false};
     Status _status;
@@ -102,6 +147,8 @@ private:
     vectorized::Schema _pk_schema;
     FieldType _enc_pk_type = OLAP_FIELD_TYPE_UNKNOWN;
     std::unique_ptr<HashIndex> _pkey_to_rssid_rowid;
+    size_t _changed_keys = 0;
+    ThreadPool* _thread_pool = nullptr;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const PrimaryIndex& o) {
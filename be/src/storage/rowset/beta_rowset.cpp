@@ -27,9 +27,12 @@
 
 #include <memory>
 #include <set>
+#include <utility>
 
+#include "column/schema.h"
 #include "gutil/strings/substitute.h"
 #include "storage/rowset/beta_rowset_reader.h"
+#include "storage/rowset/segment_v2/segment_cache.h"
 #include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/rowset/vectorized/segment_options.h"
 #include "storage/storage_engine.h"
@@ -42,6 +45,7 @@
 #include "storage/vectorized/merge_iterator.h"
 #include "storage/vectorized/projection_iterator.h"
 #include "storage/vectorized/union_iterator.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -73,22 +77,51 @@ OLAPStatus BetaRowset::init() {
 
 Status BetaRowset::do_load() {
     // Open all segments under the current rowset
+    ThreadPool* pool = StorageEngine::instance() != nullptr ? StorageEngine::instance()->segment_open_thread_pool()
+                                                            : nullptr;
+    if (pool == nullptr || num_segments() <= 1) {
+        for (int seg_id = 0; seg_id < num_segments(); ++seg_id) {
+            std::shared_ptr<segment_v2::Segment> segment;
+            RETURN_IF_ERROR(_open_segment(seg_id, &segment));
+            _segments.push_back(std::move(segment));
+        }
+        return Status::OK();
+    }
+
+    // Each segment is opened by a few small reads of its footer, open them in parallel.
+    std::vector<segment_v2::SegmentSharedPtr> segments(num_segments());
+    std::vector<Status> statuses(num_segments());
+    std::unique_ptr<ThreadPoolToken> token = pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
     for (int seg_id = 0; seg_id < num_segments(); ++seg_id) {
-        std::string seg_path = segment_file_path(_rowset_path, rowset_id(), seg_id);
-        std::shared_ptr<segment_v2::Segment> segment;
-        // TODO: `BlockManager` should be passed in as an argument.
-        fs::BlockManager* block_mgr = fs::fs_util::block_manager();
-        auto s = segment_v2::Segment::open(_mem_tracker.get(), block_mgr, seg_path, seg_id, _schema, &segment);
-        if (!s.ok()) {
-            LOG(WARNING) << "Fail to open segment=" << seg_path << " of rowset=" << unique_id() << ", "
-                         << s.to_string();
-            return s;
+        auto open_segment = [this, seg_id, &segments, &statuses] {
+            statuses[seg_id] = _open_segment(seg_id, &segments[seg_id]);
+        };
+        if (!token->submit_func(open_segment).ok()) {
+            open_segment();
         }
-        _segments.push_back(std::move(segment));
     }
+    token->wait();
+    for (const Status& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
+    _segments = std::move(segments);
     return Status::OK();
 }
 
+Status BetaRowset::_open_segment(int seg_id, segment_v2::SegmentSharedPtr* segment) {
+    std::string seg_path = segment_file_path(_rowset_path, rowset_id(), seg_id);
+    // TODO: `BlockManager` should be passed in as an argument.
+    fs::BlockManager* block_mgr = fs::fs_util::block_manager();
+    auto* segment_cache = segment_v2::SegmentCache::instance();
+    auto s = segment_cache != nullptr
+                     ? segment_cache->open(block_mgr, seg_path, seg_id, *_schema, segment)
+                     : segment_v2::Segment::open(_mem_tracker.get(), block_mgr, seg_path, seg_id, _schema, segment);
+    if (!s.ok()) {
+        LOG(WARNING) << "Fail to open segment=" << seg_path << " of rowset=" << unique_id() << ", " << s.to_string();
+    }
+    return s;
+}
+
 OLAPStatus BetaRowset::create_reader(RowsetReaderSharedPtr* result) {
     // NOTE: We use std::static_pointer_cast for performance
     *result = std::make_shared<BetaRowsetReader>(std::static_pointer_cast<BetaRowset>(shared_from_this()));
@@ -107,8 +140,12 @@ OLAPStatus BetaRowset::remove() {
     VLOG(1) << "Removing files in rowsset id=" << unique_id() << " version=" << start_version() << "-" << end_version()
             << " tablet_id=" << _rowset_meta->tablet_id();
     bool success = true;
+    auto* segment_cache = segment_v2::SegmentCache::instance();
     for (int i = 0; i < num_segments(); ++i) {
         std::string path = segment_file_path(_rowset_path, rowset_id(), i);
+        if (segment_cache != nullptr) {
+            segment_cache->erase(path);
+        }
         VLOG(1) << "Deleting " << path;
         // TODO(lingbin): use Env API
         if (::remove(path.c_str()) != 0) {
@@ -249,12 +286,18 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
     seg_options.stats = options.stats;
     seg_options.ranges = options.ranges;
     seg_options.predicates = options.predicates;
+    seg_options.late_predicates = options.late_predicates;
     seg_options.use_page_cache = options.use_page_cache;
+    seg_options.aggregate_by_metadata = options.aggregate_by_metadata;
     seg_options.profile = options.profile;
     seg_options.reader_type = options.reader_type;
     seg_options.chunk_size = options.chunk_size;
     if (options.delete_predicates != nullptr) {
         seg_options.delete_predicates = options.delete_predicates->get_predicates(end_version());
+        seg_options.delete_version = options.delete_predicates->max_version();
+    }
+    if (options.or_predicates != nullptr) {
+        seg_options.or_predicates = *options.or_predicates;
     }
     if (options.is_primary_keys) {
         seg_options.is_primary_keys = true;
@@ -265,9 +308,12 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
     }
 
     auto segment_schema = schema;
-    // Append the columns with delete condition to segment schema.
+    // Append the columns with delete condition or or predicates to segment schema.
     std::set<ColumnId> delete_columns;
     seg_options.delete_predicates.get_column_ids(&delete_columns);
+    for (const auto& or_predicate : seg_options.or_predicates) {
+        or_predicate.get_column_ids(&delete_columns);
+    }
     for (ColumnId cid : delete_columns) {
         const TabletColumn& col = options.tablet_schema->column(cid);
         if (segment_schema.get_field_by_name(col.name()) == nullptr) {
@@ -278,7 +324,11 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
 
     std::vector<vectorized::ChunkIteratorPtr> tmp_seg_iters;
     tmp_seg_iters.reserve(num_segments());
-    for (auto& seg_ptr : segments()) {
+    // the segments of |tmp_seg_iters|.
+    std::vector<const segment_v2::Segment*> iter_segments;
+    const uint32_t end_segment = std::min<uint32_t>(options.end_segment, segments().size());
+    for (uint32_t i = options.begin_segment; i < end_segment; ++i) {
+        auto& seg_ptr = segments()[i];
         if (seg_ptr->num_rows() == 0) {
             continue;
         }
@@ -294,6 +344,10 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
         } else {
             tmp_seg_iters.emplace_back(std::move(res).value());
         }
+        iter_segments.push_back(seg_ptr.get());
+    }
+    if (options.key_ranges != nullptr && !iter_segments.empty()) {
+        _append_key_ranges(schema, iter_segments, options.key_ranges);
     }
 
     auto this_rowset = shared_from_this();
@@ -312,11 +366,54 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
     return Status::OK();
 }
 
+void BetaRowset::_append_key_ranges(const vectorized::Schema& schema,
+                                    const std::vector<const segment_v2::Segment*>& segments,
+                                    std::vector<std::pair<vectorized::Datum, vectorized::Datum>>* key_ranges) {
+    std::vector<std::pair<vectorized::Datum, vectorized::Datum>> ranges(segments.size());
+    if (schema.num_key_fields() > 0 && schema.field(0)->id() == 0) {
+        const FieldType key_type = schema.field(0)->type()->type();
+        for (size_t i = 0; i < segments.size(); i++) {
+            if (!segments[i]->column_min_max(0, key_type, &ranges[i].first, &ranges[i].second)) {
+                ranges[i] = {};
+            }
+        }
+    }
+    if (rowset_meta()->is_segments_overlapping()) {
+        key_ranges->insert(key_ranges->end(), ranges.begin(), ranges.end());
+    } else {
+        // the segments are in the order of their keys, which are read by a single UnionIterator.
+        auto& range = key_ranges->emplace_back(ranges.front().first, ranges.back().second);
+        for (const auto& r : ranges) {
+            if (r.first.is_null()) {
+                range = {};
+                break;
+            }
+        }
+    }
+}
+
 StatusOr<std::vector<vectorized::ChunkIteratorPtr>> BetaRowset::get_segment_iterators2(const vectorized::Schema& schema,
                                                                                        OlapMeta* meta, int64_t version,
                                                                                        OlapReaderStatistics* stats) {
     RETURN_IF_ERROR(load());
 
+    std::vector<vectorized::ChunkIteratorPtr> seg_iterators(num_segments());
+    for (int64_t i = 0; i < num_segments(); i++) {
+        auto res = get_segment_iterator2(schema, meta, version, i, stats);
+        if (!res.ok()) {
+            return res.status();
+        }
+        seg_iterators[i] = std::move(res).value();
+    }
+    return seg_iterators;
+}
+
+StatusOr<vectorized::ChunkIteratorPtr> BetaRowset::get_segment_iterator2(const vectorized::Schema& schema,
+                                                                         OlapMeta* meta, int64_t version,
+                                                                         uint32_t segment_id,
+                                                                         OlapReaderStatistics* stats) {
+    RETURN_IF_ERROR(load());
+
     vectorized::SegmentReadOptions seg_options;
     seg_options.block_mgr = fs::fs_util::block_manager();
     seg_options.stats = stats;
@@ -326,24 +423,15 @@ StatusOr<std::vector<vectorized::ChunkIteratorPtr>> BetaRowset::get_segment_iter
     seg_options.version = version;
     seg_options.meta = meta;
 
-    std::vector<vectorized::ChunkIteratorPtr> seg_iterators(num_segments());
-    TabletSegmentId tsid;
-    tsid.tablet_id = rowset_meta()->tablet_id();
-    for (int64_t i = 0; i < num_segments(); i++) {
-        auto& seg_ptr = segments()[i];
-        if (seg_ptr->num_rows() == 0) {
-            continue;
-        }
-        auto res = seg_ptr->new_iterator(schema, seg_options);
-        if (res.status().is_end_of_file()) {
-            continue;
-        }
-        if (!res.ok()) {
-            return res.status();
-        }
-        seg_iterators[i] = std::move(res).value();
+    auto& seg_ptr = segments()[segment_id];
+    if (seg_ptr->num_rows() == 0) {
+        return vectorized::ChunkIteratorPtr();
     }
-    return seg_iterators;
+    auto res = seg_ptr->new_iterator(schema, seg_options);
+    if (res.status().is_end_of_file()) {
+        return vectorized::ChunkIteratorPtr();
+    }
+    return res;
 }
 
 } // namespace starrocks
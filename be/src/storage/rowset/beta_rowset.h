@@ -66,6 +66,12 @@ public:
                                                                                OlapMeta* meta, int64_t version,
                                                                                OlapReaderStatistics* stats);
 
+    // Same as get_segment_iterators2(), but only return the iterator of the |segment_id|-th segment, so that the
+    // segments can be read concurrently with different |stats|.
+    StatusOr<vectorized::ChunkIteratorPtr> get_segment_iterator2(const vectorized::Schema& schema, OlapMeta* meta,
+                                                                 int64_t version, uint32_t segment_id,
+                                                                 OlapReaderStatistics* stats);
+
     static std::string segment_file_path(const std::string& segment_dir, const RowsetId& rowset_id, int segment_id);
 
     static std::string segment_temp_file_path(const std::string& dir, const RowsetId& rowset_id, int segment_id);
@@ -102,6 +108,13 @@ protected:
 private:
     friend class RowsetFactory;
     friend class BetaRowsetReader;
+
+    Status _open_segment(int seg_id, segment_v2::SegmentSharedPtr* segment);
+
+    // Append the key ranges of the iterators of |segments| to |key_ranges|, see RowsetReadOptions::key_ranges.
+    void _append_key_ranges(const vectorized::Schema& schema, const std::vector<const segment_v2::Segment*>& segments,
+                            std::vector<std::pair<vectorized::Datum, vectorized::Datum>>* key_ranges);
+
     std::vector<segment_v2::SegmentSharedPtr> _segments;
 };
 
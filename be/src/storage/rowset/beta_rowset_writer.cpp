@@ -66,6 +66,7 @@ BetaRowsetWriter::~BetaRowsetWriter() {
     // TODO(lingbin): Should wrapper exception logic, no need to know file ops directly.
     if (!_already_built) {       // abnormal exit, remove all files generated
         _segment_writer.reset(); // ensure all files are closed
+        _vertical_segment_writers.clear();
         if (_context.tablet_schema->keys_type() == KeysType::PRIMARY_KEYS) {
             for (const auto& tmp_segment_file : _tmp_segment_files) {
                 // Even if an error is encountered, these files that have not been cleaned up
@@ -377,11 +378,15 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     } else {
         _rowset_meta->set_rowset_state(VISIBLE);
     }
+    const TabletSchema* rowset_schema = _context.tablet_schema;
+    if (_context.full_tablet_schema != nullptr) {
+        _rowset_meta->set_partial_update_column_ids(_context.partial_update_column_ids);
+        rowset_schema = _context.full_tablet_schema;
+    }
 
     RowsetSharedPtr rowset;
-    auto status =
-            RowsetFactory::create_rowset(ExecEnv::GetInstance()->tablet_meta_mem_tracker(), _context.tablet_schema,
-                                         _context.rowset_path_prefix, _rowset_meta, &rowset);
+    auto status = RowsetFactory::create_rowset(ExecEnv::GetInstance()->tablet_meta_mem_tracker(), rowset_schema,
+                                               _context.rowset_path_prefix, _rowset_meta, &rowset);
     if (status != OLAP_SUCCESS) {
         LOG(WARNING) << "Fail to create rowset, err=" << status;
         return nullptr;
@@ -390,7 +395,8 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     return rowset;
 }
 
-std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer() {
+std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer(
+        const std::vector<uint32_t>* key_column_indexes) {
     std::lock_guard<std::mutex> l(_lock);
     std::string path;
     if (_context.tablet_schema->keys_type() == KeysType::PRIMARY_KEYS && _context.segments_overlap != NONOVERLAPPING) {
@@ -403,7 +409,7 @@ std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer() {
         path = BetaRowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, _num_segment);
     }
     std::unique_ptr<fs::WritableBlock> wblock;
-    fs::CreateBlockOptions opts({path});
+    fs::CreateBlockOptions opts({path, _context.drop_page_cache});
     Status st = _context.block_mgr->create_block(opts, &wblock);
     if (!st.ok()) {
         LOG(WARNING) << "Fail to create writable block=" << path << ", " << st.to_string();
@@ -418,7 +424,8 @@ std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer() {
     std::unique_ptr<SegmentWriter> segment_writer =
             std::make_unique<segment_v2::SegmentWriter>(std::move(wblock), _num_segment, schema, writer_options);
     // TODO set write_mbytes_per_sec based on writer type (load/base compaction/cumulative compaction)
-    auto s = segment_writer->init(config::push_write_mbytes_per_sec);
+    auto s = key_column_indexes != nullptr ? segment_writer->init(*key_column_indexes, true)
+                                           : segment_writer->init(config::push_write_mbytes_per_sec);
     if (!s.ok()) {
         LOG(WARNING) << "Fail to init segment writer, " << s.to_string();
         segment_writer.reset(nullptr);
@@ -456,7 +463,7 @@ Status BetaRowsetWriter::_flush_src_rssids() {
     auto path = BetaRowset::segment_srcrssid_file_path(_context.rowset_path_prefix, _context.rowset_id,
                                                        _segment_writer->segment_id());
     std::unique_ptr<fs::WritableBlock> wblock;
-    fs::CreateBlockOptions opts({path});
+    fs::CreateBlockOptions opts({path, _context.drop_page_cache});
     Status st = _context.block_mgr->create_block(opts, &wblock);
     if (!st.ok()) {
         return st;
@@ -522,6 +529,121 @@ OLAPStatus BetaRowsetWriter::add_chunk_with_rssid(const vectorized::Chunk& chunk
     return OLAP_SUCCESS;
 }
 
+OLAPStatus BetaRowsetWriter::add_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                                         bool is_key) {
+    if (is_key) {
+        // The group of the key columns decides the segments, like add_chunk().
+        if (_segment_writer == nullptr) {
+            _segment_writer = _create_segment_writer(&column_indexes);
+        } else if (_segment_writer->estimate_segment_size() >= MAX_SEGMENT_SIZE ||
+                   _segment_writer->num_rows_written() + chunk.num_rows() >= _context.max_rows_per_segment) {
+            RETURN_NOT_OK(_flush_columns(&_segment_writer));
+            _segment_writer = _create_segment_writer(&column_indexes);
+        }
+        if (_segment_writer == nullptr) {
+            return OLAP_ERR_INIT_FAILED;
+        }
+        auto s = _segment_writer->append_chunk(chunk);
+        if (!s.ok()) {
+            LOG(WARNING) << "Fail to append chunk, " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        _num_rows_written += chunk.num_rows();
+        _total_row_size += chunk.bytes_usage();
+        return OLAP_SUCCESS;
+    }
+
+    // The rows of the other groups are split into the segments decided by the group of the key columns.
+    size_t offset = 0;
+    while (offset < chunk.num_rows()) {
+        if (_segment_writer == nullptr) {
+            if (_vertical_segment_index >= _vertical_segment_writers.size()) {
+                LOG(WARNING) << "More rows of a group of columns than the rows of the keys";
+                return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+            }
+            _segment_writer = std::move(_vertical_segment_writers[_vertical_segment_index]);
+            auto s = _segment_writer->init(column_indexes, false);
+            if (!s.ok()) {
+                LOG(WARNING) << "Fail to init segment writer, " << s.to_string();
+                return OLAP_ERR_INIT_FAILED;
+            }
+        }
+        size_t num_rows = std::min<size_t>(chunk.num_rows() - offset,
+                                           _segment_writer->num_rows() - _segment_writer->num_rows_written());
+        Status s;
+        if (num_rows == chunk.num_rows()) {
+            s = _segment_writer->append_chunk(chunk);
+        } else {
+            auto part = chunk.clone_empty_with_schema(num_rows);
+            part->append(chunk, offset, num_rows);
+            s = _segment_writer->append_chunk(*part);
+        }
+        if (!s.ok()) {
+            LOG(WARNING) << "Fail to append chunk, " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        offset += num_rows;
+        if (_segment_writer->num_rows_written() == _segment_writer->num_rows()) {
+            RETURN_NOT_OK(_flush_columns(&_segment_writer));
+        }
+    }
+    _total_row_size += chunk.bytes_usage();
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::flush_columns() {
+    if (_segment_writer != nullptr) {
+        RETURN_NOT_OK(_flush_columns(&_segment_writer));
+    }
+    if (_vertical_segment_index != _vertical_segment_writers.size()) {
+        LOG(WARNING) << "Fewer rows of a group of columns than the rows of the keys";
+        return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+    }
+    _vertical_segment_index = 0;
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::final_flush() {
+    DCHECK(_segment_writer == nullptr) << "the last group of columns is not flushed";
+    for (auto& segment_writer : _vertical_segment_writers) {
+        uint64_t segment_size = 0;
+        uint64_t index_size = 0;
+        Status s = segment_writer->finalize_footer(&segment_size, &index_size);
+        if (!s.ok()) {
+            LOG(WARNING) << "Fail to finalize segment, " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        std::lock_guard<std::mutex> l(_lock);
+        _total_data_size += segment_size;
+        _total_index_size += index_size;
+        segment_writer.reset();
+    }
+    _vertical_segment_writers.clear();
+    return OLAP_SUCCESS;
+}
+
+// Write the current group of columns of |segment_writer|, and keep it for the next group.
+OLAPStatus BetaRowsetWriter::_flush_columns(std::unique_ptr<segment_v2::SegmentWriter>* segment_writer) {
+    uint64_t index_size = 0;
+    Status s = (*segment_writer)->finalize_columns(&index_size);
+    if (!s.ok()) {
+        LOG(WARNING) << "Fail to finalize columns of segment, " << s.to_string();
+        return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+    }
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _total_index_size += index_size;
+    }
+    // The segments are appended by the group of the key columns.
+    if (_vertical_segment_index == _vertical_segment_writers.size()) {
+        _vertical_segment_writers.emplace_back(std::move(*segment_writer));
+    } else {
+        _vertical_segment_writers[_vertical_segment_index] = std::move(*segment_writer);
+    }
+    ++_vertical_segment_index;
+    return OLAP_SUCCESS;
+}
+
 OLAPStatus BetaRowsetWriter::flush_chunk(const vectorized::Chunk& chunk) {
     // create segment writer
     std::unique_ptr<segment_v2::SegmentWriter> segment_writer = _create_segment_writer();
@@ -551,7 +673,7 @@ OLAPStatus BetaRowsetWriter::flush_chunk_with_deletes(const vectorized::Chunk& u
     if (!deletes.empty()) {
         auto path = BetaRowset::segment_del_file_path(_context.rowset_path_prefix, _context.rowset_id, _num_segment);
         std::unique_ptr<fs::WritableBlock> wblock;
-        fs::CreateBlockOptions opts({path});
+        fs::CreateBlockOptions opts({path, _context.drop_page_cache});
         Status st = _context.block_mgr->create_block(opts, &wblock);
         if (!st.ok()) {
             LOG(WARNING) << "Fail to create writable block=" << path << ", " << st.to_string();
@@ -54,6 +54,13 @@ public:
 
     OLAPStatus add_chunk_with_rssid(const vectorized::Chunk& chunk, const vector<uint32_t>& rssid);
 
+    OLAPStatus add_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                           bool is_key) override;
+
+    OLAPStatus flush_columns() override;
+
+    OLAPStatus final_flush() override;
+
     OLAPStatus flush_chunk(const vectorized::Chunk& chunk) override;
 
     virtual OLAPStatus flush_chunk_with_deletes(const vectorized::Chunk& upserts,
@@ -81,9 +88,12 @@ private:
     template <typename RowType>
     OLAPStatus _add_row(const RowType& row);
 
-    std::unique_ptr<segment_v2::SegmentWriter> _create_segment_writer();
+    // Only the columns of |key_column_indexes| are written if it isn't null, which is used by vertical writing.
+    std::unique_ptr<segment_v2::SegmentWriter> _create_segment_writer(
+            const std::vector<uint32_t>* key_column_indexes = nullptr);
 
     OLAPStatus _flush_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* segment_writer);
+    OLAPStatus _flush_columns(std::unique_ptr<segment_v2::SegmentWriter>* segment_writer);
     Status _flush_src_rssids();
 
     Status _final_merge();
@@ -96,6 +106,10 @@ private:
     vector<bool> _segment_has_deletes;
     vector<std::string> _tmp_segment_files;
     std::unique_ptr<segment_v2::SegmentWriter> _segment_writer;
+    // The segments of vertical writing, whose footers are written after all the groups of columns.
+    std::vector<std::unique_ptr<segment_v2::SegmentWriter>> _vertical_segment_writers;
+    // The index of the segment in |_vertical_segment_writers| that the current group of columns is written to.
+    size_t _vertical_segment_index = 0;
     // mutex lock for vectorized add chunk and flush
     std::mutex _lock;
 
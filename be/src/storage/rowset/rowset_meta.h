@@ -260,6 +260,19 @@ public:
 
     void set_num_delete_files(uint32_t num_delete_files) { _rowset_meta_pb.set_num_delete_files(num_delete_files); }
 
+    bool is_partial_update() const { return _rowset_meta_pb.partial_update_column_ids_size() > 0; }
+
+    std::vector<uint32_t> partial_update_column_ids() const {
+        return {_rowset_meta_pb.partial_update_column_ids().begin(), _rowset_meta_pb.partial_update_column_ids().end()};
+    }
+
+    void set_partial_update_column_ids(const std::vector<uint32_t>& column_ids) {
+        _rowset_meta_pb.clear_partial_update_column_ids();
+        for (uint32_t cid : column_ids) {
+            _rowset_meta_pb.add_partial_update_column_ids(cid);
+        }
+    }
+
     const RowsetMetaPB& get_meta_pb() const { return _rowset_meta_pb; }
 
 private:
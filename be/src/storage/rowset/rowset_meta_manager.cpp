@@ -33,6 +33,7 @@
 #include "json2pb/json_to_pb.h"
 #include "json2pb/pb_to_json.h"
 #include "storage/olap_define.h"
+#include "storage/rocksdb_status_adapter.h"
 #include "storage/storage_engine.h"
 
 namespace starrocks {
@@ -59,6 +60,19 @@ Status RowsetMetaManager::save(OlapMeta* meta, TabletUid tablet_uid, const Rowse
     return meta->put(META_COLUMN_FAMILY_INDEX, key, value);
 }
 
+Status RowsetMetaManager::save(OlapMeta* meta, WriteBatch* batch, TabletUid tablet_uid, const RowsetId& rowset_id,
+                               const RowsetMetaPB& rowset_meta_pb) {
+    std::string key = ROWSET_PREFIX + tablet_uid.to_string() + "_" + rowset_id.to_string();
+    std::string value;
+    bool ret = rowset_meta_pb.SerializeToString(&value);
+    if (!ret) {
+        std::string error_msg = "serialize rowset pb failed. rowset id:" + key;
+        LOG(WARNING) << error_msg;
+        return Status::InternalError("fail to serialize rowset meta");
+    }
+    return to_status(batch->Put(meta->handle(META_COLUMN_FAMILY_INDEX), key, value));
+}
+
 Status RowsetMetaManager::remove(OlapMeta* meta, TabletUid tablet_uid, const RowsetId& rowset_id) {
     std::string key = ROWSET_PREFIX + tablet_uid.to_string() + "_" + rowset_id.to_string();
     return meta->remove(META_COLUMN_FAMILY_INDEX, key);
@@ -39,6 +39,10 @@ public:
     static Status save(OlapMeta* meta, TabletUid tablet_uid, const RowsetId& rowset_id,
                        const RowsetMetaPB& rowset_meta_pb);
 
+    // Append the save of the rowset meta to |batch|, which is written into |meta| later.
+    static Status save(OlapMeta* meta, WriteBatch* batch, TabletUid tablet_uid, const RowsetId& rowset_id,
+                       const RowsetMetaPB& rowset_meta_pb);
+
     static Status remove(OlapMeta* meta, TabletUid tablet_uid, const RowsetId& rowset_id);
 
     static string get_rowset_meta_key(const TabletUid& tablet_uid, const RowsetId& rowset_id);
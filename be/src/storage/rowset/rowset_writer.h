@@ -88,6 +88,19 @@ public:
         return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
     }
 
+    // Used for vertical compaction, which writes the columns of |column_indexes| of all the rows as a group, and
+    // the groups one by one. The group of the key columns must be the first group, which decides the segments.
+    virtual OLAPStatus add_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                                   bool is_key) {
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
+
+    // Finish the current group of columns written by add_columns().
+    virtual OLAPStatus flush_columns() { return OLAP_ERR_FUNC_NOT_IMPLEMENTED; }
+
+    // Finish the segments after all the groups of columns are flushed.
+    virtual OLAPStatus final_flush() { return OLAP_ERR_FUNC_NOT_IMPLEMENTED; }
+
     // This routine is free to modify the content of |chunk|.
     virtual OLAPStatus flush_chunk(const vectorized::Chunk& chunk) = 0;
 
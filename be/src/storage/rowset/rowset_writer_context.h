@@ -52,6 +52,10 @@ public:
     Env* env = Env::Default();
     fs::BlockManager* block_mgr = fs::fs_util::block_manager();
     const TabletSchema* tablet_schema = nullptr;
+    // For the partial update of a primary key tablet, the segments are written by |tablet_schema|, the schema of
+    // the columns of |partial_update_column_ids| of |full_tablet_schema|, which is the schema of the rowset built.
+    const TabletSchema* full_tablet_schema = nullptr;
+    std::vector<uint32_t> partial_update_column_ids;
 
     RowsetId rowset_id{};
     int64_t tablet_id = 0;
@@ -72,6 +76,9 @@ public:
     // test cases can change this value to control flush timing
     uint32_t max_rows_per_segment = INT32_MAX;
 
+    // Drop the files written from the page cache once they are closed, for the rowsets not expected to be read soon.
+    bool drop_page_cache = false;
+
     // In-memory data format.
     DataFormatVersion memory_format_version;
     // On-disk data format.
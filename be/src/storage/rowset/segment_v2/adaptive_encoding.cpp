@@ -0,0 +1,163 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/adaptive_encoding.h"
+
+#include <limits>
+#include <vector>
+
+#include "common/config.h"
+#include "storage/rowset/segment_v2/encoding_info.h"
+#include "storage/rowset/segment_v2/options.h"
+#include "storage/rowset/segment_v2/page_decoder.h"
+#include "storage/rowset/segment_v2/page_io.h"
+#include "storage/types.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "util/block_compression.h"
+#include "util/time.h"
+
+namespace starrocks {
+namespace segment_v2 {
+
+// The candidates not supported by the type, e.g. ALP_ENCODING of the integers, are skipped.
+static const EncodingTypePB kCandidateEncodings[] = {PLAIN_ENCODING, BIT_SHUFFLE, FOR_ENCODING, DELTA_BINARY_PACKED,
+                                                     ALP_ENCODING};
+static const CompressionTypePB kCandidateCompressions[] = {NO_COMPRESSION, LZ4_FRAME, ZSTD};
+
+AdaptiveEncodingSelector::AdaptiveEncodingSelector(FieldType type, EncodingTypePB encoding,
+                                                   CompressionTypePB compression, double min_space_saving)
+        : _type(type),
+          _encoding(encoding),
+          _compression(compression),
+          _min_space_saving(min_space_saving),
+          _value_size(get_type_info(type)->size()) {}
+
+bool AdaptiveEncodingSelector::is_supported(FieldType type) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_FLOAT:
+    case OLAP_FIELD_TYPE_DOUBLE:
+    case OLAP_FIELD_TYPE_DATE_V2:
+    case OLAP_FIELD_TYPE_DATETIME:
+    case OLAP_FIELD_TYPE_TIMESTAMP:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void AdaptiveEncodingSelector::add_values(const uint8_t* values, size_t count) {
+    _values.append(values, count * _value_size);
+    _num_values += count;
+}
+
+Status AdaptiveEncodingSelector::_encode(EncodingTypePB encoding, faststring* body, int64_t* decode_ns) const {
+    const EncodingInfo* encoding_info = nullptr;
+    RETURN_IF_ERROR(EncodingInfo::get(_type, encoding, &encoding_info));
+    PageBuilderOptions builder_opts;
+    // Large enough to hold all the sampled values in one page.
+    builder_opts.data_page_size = 2 * _values.size() + 64 * 1024;
+    PageBuilder* raw_builder = nullptr;
+    RETURN_IF_ERROR(encoding_info->create_page_builder(builder_opts, &raw_builder));
+    std::unique_ptr<PageBuilder> builder(raw_builder);
+    if (builder == nullptr || builder->add(_values.data(), _num_values) != _num_values) {
+        return Status::NotSupported("the sampled values are not held by one page");
+    }
+    faststring* encoded = builder->finish();
+    body->assign_copy(encoded->data(), encoded->size());
+
+    PageDecoder* raw_decoder = nullptr;
+    RETURN_IF_ERROR(encoding_info->create_page_decoder(Slice(*body), PageDecoderOptions(), &raw_decoder));
+    std::unique_ptr<PageDecoder> decoder(raw_decoder);
+    auto column = vectorized::ChunkHelper::column_from_field_type(_type, false);
+    column->reserve(_num_values);
+    int64_t start = MonotonicNanos();
+    RETURN_IF_ERROR(decoder->init());
+    size_t n = _num_values;
+    RETURN_IF_ERROR(decoder->next_batch(&n, column.get()));
+    *decode_ns = MonotonicNanos() - start;
+    if (n != _num_values) {
+        return Status::InternalError("the sampled values are not decoded");
+    }
+    return Status::OK();
+}
+
+Status AdaptiveEncodingSelector::_compress(CompressionTypePB compression, const faststring& body, size_t* page_size,
+                                           int64_t* decompress_ns) const {
+    const BlockCompressionCodec* codec = nullptr;
+    RETURN_IF_ERROR(get_block_compression_codec(compression, &codec));
+    faststring compressed;
+    std::vector<Slice> slices{Slice(body)};
+    RETURN_IF_ERROR(PageIO::compress_page_body(codec, _min_space_saving, slices, &compressed));
+    if (compressed.size() == 0) {
+        // Stored uncompressed, as the writer does.
+        *page_size = body.size();
+        *decompress_ns = 0;
+        return Status::OK();
+    }
+    *page_size = compressed.size();
+    std::unique_ptr<char[]> decompressed(new char[body.size()]);
+    Slice output(decompressed.get(), body.size());
+    int64_t start = MonotonicNanos();
+    RETURN_IF_ERROR(codec->decompress(Slice(compressed), &output));
+    *decompress_ns = MonotonicNanos() - start;
+    return Status::OK();
+}
+
+Status AdaptiveEncodingSelector::select(EncodingTypePB* encoding, CompressionTypePB* compression) const {
+    *encoding = _encoding;
+    *compression = _compression;
+    if (_num_values == 0) {
+        return Status::OK();
+    }
+
+    struct Candidate {
+        EncodingTypePB encoding;
+        CompressionTypePB compression;
+        size_t page_size;
+        int64_t decode_ns;
+    };
+    std::vector<Candidate> candidates;
+    std::vector<EncodingTypePB> encodings(std::begin(kCandidateEncodings), std::end(kCandidateEncodings));
+    encodings.push_back(_encoding);
+    std::vector<CompressionTypePB> compressions(std::begin(kCandidateCompressions), std::end(kCandidateCompressions));
+    compressions.push_back(_compression);
+    faststring body;
+    for (EncodingTypePB candidate_encoding : encodings) {
+        int64_t decode_ns = 0;
+        if (!_encode(candidate_encoding, &body, &decode_ns).ok()) {
+            continue;
+        }
+        for (CompressionTypePB candidate_compression : compressions) {
+            size_t page_size = 0;
+            int64_t decompress_ns = 0;
+            if (!_compress(candidate_compression, body, &page_size, &decompress_ns).ok()) {
+                continue;
+            }
+            candidates.push_back({candidate_encoding, candidate_compression, page_size, decode_ns + decompress_ns});
+        }
+    }
+
+    // The default pair is the last candidate, unless it fails to encode the values.
+    if (candidates.empty() || candidates.back().encoding != _encoding ||
+        candidates.back().compression != _compression) {
+        return Status::OK();
+    }
+    const Candidate& default_candidate = candidates.back();
+    const double max_decode_ns = default_candidate.decode_ns * (1 + config::adaptive_encoding_max_decode_slowdown);
+    const Candidate* best = &default_candidate;
+    for (const Candidate& candidate : candidates) {
+        if (candidate.decode_ns <= max_decode_ns && candidate.page_size < best->page_size) {
+            best = &candidate;
+        }
+    }
+    *encoding = best->encoding;
+    *compression = best->compression;
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace starrocks
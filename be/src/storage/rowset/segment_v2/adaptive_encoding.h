@@ -0,0 +1,98 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "storage/olap_common.h"
+#include "storage/rowset/segment_v2/page_builder.h"
+#include "util/faststring.h"
+
+namespace starrocks {
+
+class BlockCompressionCodec;
+
+namespace segment_v2 {
+
+// AdaptiveEncodingSelector chooses the encoding and the compression of the data pages of a fixed-width column. The
+// values of the first pages, which are written with the encoding and the compression of the column, are sampled,
+// and every pair of the candidate encodings and compressions is tried on them. The pair of the smallest pages is
+// chosen among the pairs whose decoding, including the decompression, is at most
+// config::adaptive_encoding_max_decode_slowdown slower than the default pair, and is used by the following pages.
+//
+// The pages record their own encoding and compression once they differ from the ones of the column, so the readers
+// decode the pages of a column written with the different encodings.
+class AdaptiveEncodingSelector {
+public:
+    // |encoding| and |compression| are the ones of the column, which are the defaults.
+    AdaptiveEncodingSelector(FieldType type, EncodingTypePB encoding, CompressionTypePB compression,
+                             double min_space_saving);
+
+    // Whether the encoding of the columns of |type| is chosen adaptively, i.e. the numeric and the date types which
+    // have more than one encoding.
+    static bool is_supported(FieldType type);
+
+    // Add |count| values of a sampled page.
+    void add_values(const uint8_t* values, size_t count);
+
+    size_t num_values() const { return _num_values; }
+
+    // Choose the encoding and the compression by the sampled values.
+    Status select(EncodingTypePB* encoding, CompressionTypePB* compression) const;
+
+private:
+    // Encode the sampled values into |body|, and return the time to decode it.
+    Status _encode(EncodingTypePB encoding, faststring* body, int64_t* decode_ns) const;
+
+    // Compress the encoded |body|, and return the size of the page body and the time to decompress it.
+    Status _compress(CompressionTypePB compression, const faststring& body, size_t* page_size,
+                     int64_t* decompress_ns) const;
+
+    const FieldType _type;
+    const EncodingTypePB _encoding;
+    const CompressionTypePB _compression;
+    const double _min_space_saving;
+    const size_t _value_size;
+    faststring _values;
+    size_t _num_values = 0;
+};
+
+// SamplingPageBuilder adds the values into the page builder of the column, and the selector as the samples.
+class SamplingPageBuilder final : public PageBuilder {
+public:
+    SamplingPageBuilder(std::unique_ptr<PageBuilder> builder, AdaptiveEncodingSelector* selector)
+            : _builder(std::move(builder)), _selector(selector) {}
+
+    ~SamplingPageBuilder() override = default;
+
+    bool is_page_full() override { return _builder->is_page_full(); }
+
+    size_t add(const uint8_t* vals, size_t count) override {
+        size_t added = _builder->add(vals, count);
+        _selector->add_values(vals, added);
+        return added;
+    }
+
+    faststring* finish() override { return _builder->finish(); }
+
+    void reset() override { _builder->reset(); }
+
+    size_t count() const override { return _builder->count(); }
+
+    uint64_t size() const override { return _builder->size(); }
+
+    Status get_first_value(void* value) const override { return _builder->get_first_value(value); }
+
+    Status get_last_value(void* value) const override { return _builder->get_last_value(value); }
+
+private:
+    std::unique_ptr<PageBuilder> _builder;
+    AdaptiveEncodingSelector* _selector;
+};
+
+} // namespace segment_v2
+} // namespace starrocks
@@ -0,0 +1,399 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "column/column.h"
+#include "gutil/strings/substitute.h"
+#include "storage/rowset/segment_v2/options.h"
+#include "storage/rowset/segment_v2/page_builder.h"
+#include "storage/rowset/segment_v2/page_decoder.h"
+#include "storage/types.h"
+#include "util/bit_packing.inline.h"
+#include "util/bit_stream_utils.inline.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+
+namespace starrocks {
+namespace segment_v2 {
+
+enum { ALP_PAGE_HEADER_SIZE = 19 };
+
+// The decimal scaling of ALP, i.e. a value v is encoded as the integer round(v * 10^e * 10^-f), which is decoded
+// back as d * 10^f * 10^-e. The values decoded to different bits, e.g. -0.0, NaN and the values of too many
+// significant digits, are the exceptions stored as they are.
+template <typename T>
+struct AlpScaling {};
+
+template <>
+struct AlpScaling<double> {
+    static constexpr int kMaxExponent = 18;
+    // (x + kMagic) - kMagic rounds x to the nearest integer if |x| <= kMaxEncoded.
+    static constexpr double kMagic = 6755399441055744.0; // 2^52 + 2^51
+    static constexpr double kMaxEncoded = 2251799813685248.0; // 2^51
+    static constexpr double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+                                        1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+    static constexpr double kInvPow10[] = {1e-0,  1e-1,  1e-2,  1e-3,  1e-4,  1e-5,  1e-6,  1e-7,  1e-8, 1e-9,
+                                           1e-10, 1e-11, 1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18};
+};
+
+template <>
+struct AlpScaling<float> {
+    static constexpr int kMaxExponent = 10;
+    static constexpr float kMagic = 12582912.0f;     // 2^23 + 2^22
+    static constexpr float kMaxEncoded = 4194304.0f; // 2^22
+    static constexpr float kPow10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    static constexpr float kInvPow10[] = {1e-0f, 1e-1f, 1e-2f, 1e-3f, 1e-4f, 1e-5f,
+                                          1e-6f, 1e-7f, 1e-8f, 1e-9f, 1e-10f};
+};
+
+template <typename T>
+inline T alp_decode(int64_t encoded, int exponent, int factor) {
+    return static_cast<T>(encoded) * AlpScaling<T>::kPow10[factor] * AlpScaling<T>::kInvPow10[exponent];
+}
+
+// Return false if |value| is an exception of the exponent and the factor.
+template <typename T>
+inline bool alp_encode(T value, int exponent, int factor, int64_t* encoded) {
+    using Scaling = AlpScaling<T>;
+    const T scaled = value * Scaling::kPow10[exponent] * Scaling::kInvPow10[factor];
+    // false for NaN too.
+    if (!(scaled >= -Scaling::kMaxEncoded && scaled <= Scaling::kMaxEncoded)) {
+        return false;
+    }
+    const auto rounded = static_cast<int64_t>((scaled + Scaling::kMagic) - Scaling::kMagic);
+    const T decoded = alp_decode<T>(rounded, exponent, factor);
+    if (memcmp(&decoded, &value, sizeof(T)) != 0) {
+        return false;
+    }
+    *encoded = rounded;
+    return true;
+}
+
+// AlpPageBuilder encodes the floating point values by ALP (adaptive lossless floating point), which scales the
+// decimals, e.g. the prices and the metrics of a few significant digits, to the integers without any loss. The
+// integers are then frame-of-reference and bit packed. The exponent and the factor of the scaling are chosen by a
+// sample of the page.
+//
+// The page format is as follows:
+//
+// 1. Header: (19 bytes total)
+//
+//    <num_elements> [32-bit]
+//    <exponent> [8-bit]
+//    <factor> [8-bit]
+//    <bit_width> [8-bit]
+//    <frame_of_reference> [64-bit]
+//      The min of the encoded integers.
+//    <num_exceptions> [32-bit]
+//
+// 2. <packed integers> [ceil(num_elements * bit_width / 8) bytes]
+//      The encoded integers minus frame_of_reference, bit packed in the layout of BitWriter. The integers of the
+//      exceptions are any of the others.
+//
+// 3. <exception positions> [32-bit * num_exceptions]
+//    <exception values> [sizeof(value) * num_exceptions]
+//
+//   NOTE: all on-disk ints are encoded little-endian
+//
+template <FieldType Type>
+class AlpPageBuilder final : public PageBuilder {
+public:
+    explicit AlpPageBuilder(const PageBuilderOptions& options)
+            : _max_count(options.data_page_size / sizeof(CppType)), _finished(false) {}
+
+    ~AlpPageBuilder() override = default;
+
+    bool is_page_full() override { return _values.size() >= _max_count; }
+
+    size_t add(const uint8_t* vals, size_t count) override {
+        DCHECK(!_finished);
+        size_t to_add = std::min<size_t>(_max_count - _values.size(), count);
+        const size_t old_size = _values.size();
+        _values.resize(old_size + to_add);
+        memcpy(_values.data() + old_size, vals, to_add * sizeof(CppType));
+        return to_add;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        int exponent = 0;
+        int factor = 0;
+        _choose_scaling(&exponent, &factor);
+
+        std::vector<int64_t> encoded(_values.size());
+        std::vector<uint32_t> exceptions;
+        for (size_t i = 0; i < _values.size(); i++) {
+            if (!alp_encode(_values[i], exponent, factor, &encoded[i])) {
+                exceptions.push_back(i);
+            }
+        }
+        // The exceptions take the integer of another value, which doesn't widen the bit width.
+        int64_t substitute = 0;
+        for (size_t i = 0, k = 0; i < _values.size(); i++) {
+            if (k < exceptions.size() && exceptions[k] == i) {
+                k++;
+            } else {
+                substitute = encoded[i];
+                break;
+            }
+        }
+        int64_t min = std::numeric_limits<int64_t>::max();
+        int64_t max = std::numeric_limits<int64_t>::min();
+        for (size_t i = 0, k = 0; i < _values.size(); i++) {
+            if (k < exceptions.size() && exceptions[k] == i) {
+                encoded[i] = substitute;
+                k++;
+            }
+            min = std::min(min, encoded[i]);
+            max = std::max(max, encoded[i]);
+        }
+        if (_values.empty()) {
+            min = max = 0;
+        }
+        const uint64_t range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+        const int bit_width = range == 0 ? 0 : 64 - __builtin_clzll(range);
+
+        _buf.clear();
+        put_fixed32_le(&_buf, _values.size());
+        _buf.push_back(static_cast<uint8_t>(exponent));
+        _buf.push_back(static_cast<uint8_t>(factor));
+        _buf.push_back(static_cast<uint8_t>(bit_width));
+        put_fixed64_le(&_buf, static_cast<uint64_t>(min));
+        put_fixed32_le(&_buf, exceptions.size());
+        if (bit_width > 0) {
+            BitWriter writer(&_packed);
+            for (int64_t v : encoded) {
+                writer.PutValue(static_cast<uint64_t>(v) - static_cast<uint64_t>(min), bit_width);
+            }
+            writer.Flush();
+            _buf.append(_packed.data(), _packed.size());
+        }
+        for (uint32_t pos : exceptions) {
+            put_fixed32_le(&_buf, pos);
+        }
+        for (uint32_t pos : exceptions) {
+            _buf.append(&_values[pos], sizeof(CppType));
+        }
+        return &_buf;
+    }
+
+    void reset() override {
+        _values.clear();
+        _buf.clear();
+        _finished = false;
+    }
+
+    size_t count() const override { return _values.size(); }
+
+    uint64_t size() const override { return _finished ? _buf.size() : _values.size() * sizeof(CppType); }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), sizeof(CppType));
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), sizeof(CppType));
+        return Status::OK();
+    }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+
+    static constexpr size_t kMaxSamples = 32;
+
+    // Choose the exponent and the factor of the least estimated bits of the sampled values.
+    void _choose_scaling(int* exponent, int* factor) const {
+        const size_t step = std::max<size_t>(1, _values.size() / kMaxSamples);
+        uint64_t best_bits = std::numeric_limits<uint64_t>::max();
+        for (int e = 0; e <= AlpScaling<CppType>::kMaxExponent; e++) {
+            for (int f = 0; f <= e; f++) {
+                size_t num_samples = 0;
+                size_t num_exceptions = 0;
+                int64_t min = std::numeric_limits<int64_t>::max();
+                int64_t max = std::numeric_limits<int64_t>::min();
+                for (size_t i = 0; i < _values.size(); i += step, num_samples++) {
+                    int64_t encoded;
+                    if (alp_encode(_values[i], e, f, &encoded)) {
+                        min = std::min(min, encoded);
+                        max = std::max(max, encoded);
+                    } else {
+                        num_exceptions++;
+                    }
+                }
+                const uint64_t range = min > max ? 0 : static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+                const uint64_t bit_width = range == 0 ? 0 : 64 - __builtin_clzll(range);
+                const uint64_t bits = num_samples * bit_width + num_exceptions * (32 + sizeof(CppType) * 8);
+                if (bits < best_bits) {
+                    best_bits = bits;
+                    *exponent = e;
+                    *factor = f;
+                }
+            }
+        }
+    }
+
+    const size_t _max_count;
+    bool _finished;
+    std::vector<CppType> _values;
+    faststring _packed;
+    faststring _buf;
+};
+
+template <FieldType Type>
+class AlpPageDecoder final : public PageDecoder {
+public:
+    AlpPageDecoder(Slice data, const PageDecoderOptions& options)
+            : _data(data), _parsed(false), _num_elements(0), _cur_index(0) {}
+
+    ~AlpPageDecoder() override = default;
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < ALP_PAGE_HEADER_SIZE) {
+            return Status::Corruption(strings::Substitute("invalid alp page size: $0", _data.size));
+        }
+        const auto* data = reinterpret_cast<const uint8_t*>(_data.data);
+        _num_elements = decode_fixed32_le(data);
+        _exponent = data[4];
+        _factor = data[5];
+        _bit_width = data[6];
+        _frame_of_reference = static_cast<int64_t>(decode_fixed64_le(data + 7));
+        _num_exceptions = decode_fixed32_le(data + 15);
+        if (_exponent > AlpScaling<CppType>::kMaxExponent || _factor > _exponent || _bit_width > 64) {
+            return Status::Corruption(strings::Substitute("invalid alp page exponent: $0, factor: $1, bit width: $2",
+                                                          _exponent, _factor, _bit_width));
+        }
+        const size_t packed_bytes = BitUtil::Ceil(static_cast<int64_t>(_num_elements) * _bit_width, 8);
+        if (_num_exceptions > _num_elements ||
+            ALP_PAGE_HEADER_SIZE + packed_bytes + _num_exceptions * (sizeof(uint32_t) + sizeof(CppType)) !=
+                    _data.size) {
+            return Status::Corruption("the size of the alp page is unmatched");
+        }
+        _exception_positions = data + ALP_PAGE_HEADER_SIZE + packed_bytes;
+        for (size_t i = 0; i < _num_exceptions; i++) {
+            if (decode_fixed32_le(_exception_positions + i * sizeof(uint32_t)) >= _num_elements) {
+                return Status::Corruption("invalid exception position of the alp page");
+            }
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _num_elements);
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+        _decode();
+        *n = std::min(*n, _num_elements - _cur_index);
+        memcpy(dst->data(), &_decoded[_cur_index], *n * sizeof(CppType));
+        _cur_index += *n;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::Column* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+        *n = std::min(*n, _num_elements - _cur_index);
+        const size_t ori_size = dst->size();
+        if (_decoded.empty() && _cur_index == 0 && *n == _num_elements) {
+            // The whole page is read by one batch, and decoded into the column directly.
+            dst->resize(ori_size + *n);
+            _decode_to(reinterpret_cast<CppType*>(dst->mutable_raw_data()) + ori_size);
+        } else {
+            _decode();
+            size_t appended = dst->append_numbers(&_decoded[_cur_index], *n * sizeof(CppType));
+            DCHECK_EQ(*n, appended);
+        }
+        _cur_index += *n;
+        return Status::OK();
+    }
+
+    size_t count() const override { return _num_elements; }
+
+    size_t current_index() const override { return _cur_index; }
+
+    EncodingTypePB encoding_type() const override { return ALP_ENCODING; }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+
+    // The integers are unpacked by batches of it, which start at the byte boundaries.
+    static constexpr size_t kBatchSize = 1024;
+
+    void _decode() {
+        if (_decoded.empty() && _num_elements > 0) {
+            _decoded.resize(_num_elements);
+            _decode_to(_decoded.data());
+        }
+    }
+
+    // Decode all the values of this page into |out|.
+    void _decode_to(CppType* out) const {
+        const uint8_t* packed = reinterpret_cast<const uint8_t*>(_data.data) + ALP_PAGE_HEADER_SIZE;
+        uint64_t unpacked[kBatchSize];
+        for (size_t start = 0; start < _num_elements; start += kBatchSize) {
+            const size_t batch_size = std::min(kBatchSize, _num_elements - start);
+            if (_bit_width == 0) {
+                memset(unpacked, 0, batch_size * sizeof(uint64_t));
+            } else {
+                const size_t packed_bytes = BitUtil::Ceil(static_cast<int64_t>(batch_size) * _bit_width, 8);
+                // The unrolled unpacking of the bit width, which is vectorized by the compiler.
+                BitPacking::UnpackValues(_bit_width, packed, packed_bytes, batch_size, unpacked);
+                packed += packed_bytes;
+            }
+            // The same multiplications as alp_encode() checked, vectorized by the compiler.
+            const CppType scale = AlpScaling<CppType>::kPow10[_factor];
+            const CppType inv_scale = AlpScaling<CppType>::kInvPow10[_exponent];
+            for (size_t i = 0; i < batch_size; i++) {
+                const auto encoded = static_cast<int64_t>(unpacked[i] + static_cast<uint64_t>(_frame_of_reference));
+                out[start + i] = static_cast<CppType>(encoded) * scale * inv_scale;
+            }
+        }
+        const uint8_t* exception_values = _exception_positions + _num_exceptions * sizeof(uint32_t);
+        for (size_t i = 0; i < _num_exceptions; i++) {
+            const uint32_t pos = decode_fixed32_le(_exception_positions + i * sizeof(uint32_t));
+            memcpy(&out[pos], exception_values + i * sizeof(CppType), sizeof(CppType));
+        }
+    }
+
+    Slice _data;
+    bool _parsed;
+    size_t _num_elements;
+    size_t _cur_index;
+    int _exponent = 0;
+    int _factor = 0;
+    int _bit_width = 0;
+    int64_t _frame_of_reference = 0;
+    size_t _num_exceptions = 0;
+    const uint8_t* _exception_positions = nullptr;
+    std::vector<CppType> _decoded;
+};
+
+} // namespace segment_v2
+} // namespace starrocks
@@ -289,7 +289,8 @@ public:
             return Status::InternalError(ss.str());
         }
 
-        RETURN_IF_ERROR(_decode());
+        // The values are decompressed on the first access, so that a page read by one batch is decompressed
+        // into the column directly.
         _parsed = true;
         return Status::OK();
     }
@@ -312,6 +313,7 @@ public:
         if (_num_elements == 0) {
             return Status::NotFound("page is empty");
         }
+        RETURN_IF_ERROR(_decode());
 
         size_t left = 0;
         size_t right = _num_elements;
@@ -345,6 +347,7 @@ public:
             return Status::OK();
         }
 
+        RETURN_IF_ERROR(_decode());
         size_t max_fetch = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
         _copy_next_values(max_fetch, dst->data());
         *n = max_fetch;
@@ -355,6 +358,8 @@ public:
 
     Status next_batch(size_t* count, vectorized::Column* dst) override;
 
+    Status read_by_ranges(const vectorized::SparseRange& range, vectorized::Column* dst) override;
+
     size_t count() const override { return _num_elements; }
 
     size_t current_index() const override { return _cur_index; }
@@ -367,16 +372,22 @@ private:
     }
 
     Status _decode() {
-        if (_num_elements > 0) {
-            int64_t bytes;
+        if (_num_elements > 0 && _decoded.size() == 0) {
             _decoded.resize(_num_element_after_padding * _size_of_element);
-            char* in = const_cast<char*>(&_data[BITSHUFFLE_PAGE_HEADER_SIZE]);
-            bytes = bitshuffle::decompress_lz4(in, _decoded.data(), _num_element_after_padding, _size_of_element, 0);
-            if (PREDICT_FALSE(bytes < 0)) {
-                // Ideally, this should not happen.
-                LOG(ERROR) << "bitshuffle decompress failed: " << bitshuffle_error_msg(bytes);
-                return Status::RuntimeError("Unshuffle Process failed");
-            }
+            RETURN_IF_ERROR(_decompress(_decoded.data()));
+        }
+        return Status::OK();
+    }
+
+    // Decompress all the values of this page into |out|, which must have the space of
+    // |_num_element_after_padding| values.
+    Status _decompress(void* out) {
+        char* in = const_cast<char*>(&_data[BITSHUFFLE_PAGE_HEADER_SIZE]);
+        int64_t bytes = bitshuffle::decompress_lz4(in, out, _num_element_after_padding, _size_of_element, 0);
+        if (PREDICT_FALSE(bytes < 0)) {
+            // Ideally, this should not happen.
+            LOG(ERROR) << "bitshuffle decompress failed: " << bitshuffle_error_msg(bytes);
+            return Status::RuntimeError("Unshuffle Process failed");
         }
         return Status::OK();
     }
@@ -405,11 +416,40 @@ inline Status BitShufflePageDecoder<Type>::next_batch(size_t* count, vectorized:
         return Status::OK();
     }
     *count = std::min(*count, static_cast<size_t>(_num_elements - _cur_index));
-    int n = dst->append_numbers(&_decoded[_cur_index * SIZE_OF_TYPE], *count * SIZE_OF_TYPE);
-    DCHECK_EQ(*count, n);
+    const size_t ori_size = dst->size();
+    if (_decoded.size() == 0 && _cur_index == 0 && *count == _num_elements && _size_of_element == SIZE_OF_TYPE) {
+        // The whole page is read at once, decompress it into the column without the intermediate buffer.
+        dst->resize_uninitialized(ori_size + _num_element_after_padding);
+        Status st = _decompress(dst->mutable_raw_data() + ori_size * SIZE_OF_TYPE);
+        dst->resize_uninitialized(st.ok() ? ori_size + *count : ori_size);
+        RETURN_IF_ERROR(st);
+    } else {
+        RETURN_IF_ERROR(_decode());
+        dst->resize_uninitialized(ori_size + *count);
+        _copy_next_values(*count, dst->mutable_raw_data() + ori_size * SIZE_OF_TYPE);
+    }
     _cur_index += *count;
     return Status::OK();
 }
 
+template <FieldType Type>
+inline Status BitShufflePageDecoder<Type>::read_by_ranges(const vectorized::SparseRange& range,
+                                                          vectorized::Column* dst) {
+    DCHECK(_parsed);
+    RETURN_IF(range.empty(), Status::OK());
+    DCHECK_LE(range.end(), _num_elements);
+    RETURN_IF_ERROR(_decode());
+    const size_t ori_size = dst->size();
+    dst->resize_uninitialized(ori_size + range.span_size());
+    uint8_t* data = dst->mutable_raw_data() + ori_size * SIZE_OF_TYPE;
+    for (size_t i = 0; i < range.size(); i++) {
+        const size_t n = range[i].span_size() * SIZE_OF_TYPE;
+        memcpy(data, &_decoded[range[i].begin() * SIZE_OF_TYPE], n);
+        data += n;
+    }
+    _cur_index = range.end();
+    return Status::OK();
+}
+
 } // namespace segment_v2
 } // namespace starrocks
@@ -21,6 +21,10 @@
 
 #include "storage/rowset/segment_v2/block_split_bloom_filter.h"
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 #include "util/debug_util.h"
 
 namespace starrocks {
@@ -52,12 +56,44 @@ bool BlockSplitBloomFilter::test_hash(uint64_t hash) const {
     uint32_t block_size = _num_bytes / BYTES_PER_BLOCK;
     uint32_t block_index = (uint32_t)(hash >> 32) & (block_size - 1);
     uint32_t key = (uint32_t)hash;
+    return test_key_in_block((const uint32_t*)(_data + BYTES_PER_BLOCK * block_index), key);
+}
+
+bool BlockSplitBloomFilter::test_any_hash(const uint64_t* hashes, size_t n) const {
+    uint32_t block_size = _num_bytes / BYTES_PER_BLOCK;
+#ifdef __AVX2__
+    static_assert(BITS_SET_PER_BLOCK * sizeof(uint32_t) == sizeof(__m256i));
+    const __m256i salt = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(SALT));
+    const __m256i ones = _mm256_set1_epi32(1);
+    for (size_t i = 0; i < n; i++) {
+        uint32_t block_index = (uint32_t)(hashes[i] >> 32) & (block_size - 1);
+        // the same masks as _set_masks()
+        __m256i masks = _mm256_mullo_epi32(_mm256_set1_epi32((uint32_t)hashes[i]), salt);
+        masks = _mm256_sllv_epi32(ones, _mm256_srli_epi32(masks, 27));
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_data + BYTES_PER_BLOCK * block_index));
+        // all the bits of the masks are set in the block
+        if (_mm256_testc_si256(block, masks)) {
+            return true;
+        }
+    }
+    return false;
+#else
+    for (size_t i = 0; i < n; i++) {
+        uint32_t block_index = (uint32_t)(hashes[i] >> 32) & (block_size - 1);
+        if (test_key_in_block((const uint32_t*)(_data + BYTES_PER_BLOCK * block_index), (uint32_t)hashes[i])) {
+            return true;
+        }
+    }
+    return false;
+#endif
+}
+
+bool BlockSplitBloomFilter::test_key_in_block(const uint32_t* block, uint32_t key) {
     // Calculate masks for bucket.
     uint32_t masks[BITS_SET_PER_BLOCK];
     _set_masks(key, masks);
-    uint32_t* block_offset = (uint32_t*)(_data + BYTES_PER_BLOCK * block_index);
     for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
-        if ((*(block_offset + i) & masks[i]) == 0) {
+        if ((block[i] & masks[i]) == 0) {
             return false;
         }
     }
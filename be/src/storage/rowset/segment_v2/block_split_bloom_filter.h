@@ -37,8 +37,19 @@ public:
 
     bool test_hash(uint64_t hash) const override;
 
+    // Test the 8 words of a block at once by AVX2 if it is available.
+    bool test_any_hash(const uint64_t* hashes, size_t n) const override;
+
+    // Whether |key|, the low 32 bits of the hash, is in the tiny Bloom filter |block|. The blocks are laid out
+    // the same as the ones of the split block Bloom filters in parquet files, which only differ in the hash
+    // function and how the block of a hash is chosen.
+    static bool test_key_in_block(const uint32_t* block, uint32_t key);
+
+    // Bytes in a tiny Bloom filter block.
+    static const uint32_t BYTES_PER_BLOCK = 32;
+
 private:
-    void _set_masks(uint32_t key, uint32_t* masks) const {
+    static void _set_masks(uint32_t key, uint32_t* masks) {
         for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
             // add some salt to key
             masks[i] = key * SALT[i];
@@ -50,9 +61,6 @@ private:
     }
 
 private:
-    // Bytes in a tiny Bloom filter block.
-    static const uint32_t BYTES_PER_BLOCK = 32;
-
     // The number of bits to set in a tiny Bloom filter block
     static const int BITS_SET_PER_BLOCK = 8;
 
@@ -108,6 +108,14 @@ public:
         return hash_code;
     }
 
+    // The same as hash() of HASH_MURMUR3_X64_64, the only supported strategy, so that the keys probing the filters
+    // of many pages are hashed only once.
+    static uint64_t murmur3_hash(const char* buf, uint32_t size) {
+        uint64_t hash_code;
+        murmur_hash3_x64_64(buf, size, DEFAULT_SEED, &hash_code);
+        return hash_code;
+    }
+
     void add_bytes(const char* buf, uint32_t size) {
         if (buf == nullptr) {
             *_has_null = true;
@@ -138,6 +146,16 @@ public:
     virtual void add_hash(uint64_t hash) = 0;
     virtual bool test_hash(uint64_t hash) const = 0;
 
+    // Whether any of the |n| hashes may be in the filter.
+    virtual bool test_any_hash(const uint64_t* hashes, size_t n) const {
+        for (size_t i = 0; i < n; i++) {
+            if (test_hash(hashes[i])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
 private:
     // Compute the optimal bit number according to the following rule:
     //     m = -n * ln(fpp) / (ln(2) ^ 2)
@@ -36,6 +36,7 @@
 #include "gutil/strings/substitute.h" // for Substitute
 #include "storage/column_block.h"     // for ColumnBlockView
 #include "storage/olap_cond.h"
+#include "storage/page_cache.h"
 #include "storage/rowset/segment_v2/binary_dict_page.h" // for BinaryDictPageDecoder
 #include "storage/rowset/segment_v2/bitmap_index_reader.h"
 #include "storage/rowset/segment_v2/bloom_filter_index_reader.h"
@@ -45,6 +46,7 @@
 #include "storage/rowset/segment_v2/page_pointer.h" // for PagePointer
 #include "storage/rowset/segment_v2/zone_map_index.h"
 #include "storage/types.h" // for TypeInfo
+#include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/column_predicate.h"
 #include "util/block_compression.h"
 #include "util/rle_encoding.h" // for RleDecoder
@@ -112,6 +114,8 @@ ColumnReader::ColumnReader(MemTracker* mem_tracker, const ColumnReaderOptions& o
     _mem_tracker->consume(sizeof(ColumnReader));
 }
 
+ColumnReader::~ColumnReader() = default;
+
 Status ColumnReader::init(const ColumnMetaPB& meta) {
     if (_column_type == OLAP_FIELD_TYPE_ARRAY) {
         return Status::OK();
@@ -119,6 +123,10 @@ Status ColumnReader::init(const ColumnMetaPB& meta) {
 
     RETURN_IF_ERROR(EncodingInfo::get(delegate_type(_column_type), meta.encoding(), &_encoding_info));
     RETURN_IF_ERROR(get_block_compression_codec(meta.compression(), &_compress_codec));
+    if (meta.has_compression_dict()) {
+        RETURN_IF_ERROR(create_zstd_dict_codec(meta.compression_dict(), &_dict_codec));
+        _compress_codec = _dict_codec.get();
+    }
 
     for (int i = 0; i < meta.indexes_size(); i++) {
         const auto& index_meta = meta.indexes(i);
@@ -135,6 +143,12 @@ Status ColumnReader::init(const ColumnMetaPB& meta) {
         case BLOOM_FILTER_INDEX:
             _bf_index_meta = &index_meta.bloom_filter_index();
             break;
+        case NGRAM_BLOOM_FILTER_INDEX:
+            _ngram_bf_index_meta = &index_meta.ngram_bloom_filter_index();
+            break;
+        case INVERTED_INDEX:
+            _inverted_index_meta = &index_meta.inverted_index();
+            break;
         default:
             return Status::Corruption(
                     strings::Substitute("Bad file $0: invalid column index type $1", _file_name, index_meta.type()));
@@ -152,6 +166,11 @@ Status ColumnReader::new_bitmap_index_iterator(BitmapIndexIterator** iterator) {
     return Status::OK();
 }
 
+Status ColumnReader::new_inverted_index_iterator(BitmapIndexIterator** iterator) {
+    RETURN_IF_ERROR(_inverted_index->new_iterator(iterator));
+    return Status::OK();
+}
+
 Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp, PageHandle* handle,
                                Slice* page_body, PageFooterPB* footer) {
     iter_opts.sanity_check();
@@ -315,19 +334,8 @@ Status ColumnReader::bloom_filter(const std::vector<const vectorized::ColumnPred
     vectorized::SparseRange bf_row_ranges;
     std::unique_ptr<BloomFilterIndexIterator> bf_iter;
     RETURN_IF_ERROR(_bloom_filter_index->new_iterator(&bf_iter));
-    size_t range_size = row_ranges->size();
-    // get covered page ids
     std::set<int32_t> page_ids;
-    for (int i = 0; i < range_size; ++i) {
-        vectorized::Range r = (*row_ranges)[i];
-        int64_t idx = r.begin();
-        auto iter = _ordinal_index->seek_at_or_before(r.begin());
-        while (idx < r.end()) {
-            page_ids.insert(iter.page_index());
-            idx = iter.last_ordinal() + 1;
-            iter.next();
-        }
-    }
+    _get_covered_pages(*row_ranges, &page_ids);
     for (const auto& pid : page_ids) {
         std::unique_ptr<BloomFilter> bf;
         RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
@@ -342,6 +350,48 @@ Status ColumnReader::bloom_filter(const std::vector<const vectorized::ColumnPred
     return Status::OK();
 }
 
+// prerequisite: at least one predicate in |predicates| support n-gram bloom filter.
+Status ColumnReader::ngram_bloom_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                        vectorized::SparseRange* row_ranges) {
+    vectorized::SparseRange bf_row_ranges;
+    std::unique_ptr<BloomFilterIndexIterator> bf_iter;
+    RETURN_IF_ERROR(_ngram_bloom_filter_index->new_iterator(&bf_iter));
+    const size_t gram_size = _ngram_bf_index_meta->gram_size();
+    std::set<int32_t> page_ids;
+    _get_covered_pages(*row_ranges, &page_ids);
+    for (const auto& pid : page_ids) {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
+        // The predicates of a column are conjunctive, so a page is skipped if any of them filters it out.
+        bool keep = true;
+        for (const auto* pred : predicates) {
+            if (pred->support_ngram_bloom_filter() && !pred->ngram_bloom_filter(bf.get(), gram_size)) {
+                keep = false;
+                break;
+            }
+        }
+        if (keep) {
+            bf_row_ranges.add(vectorized::Range(_ordinal_index->get_first_ordinal(pid),
+                                                _ordinal_index->get_last_ordinal(pid) + 1));
+        }
+    }
+    *row_ranges = row_ranges->intersection(bf_row_ranges);
+    return Status::OK();
+}
+
+void ColumnReader::_get_covered_pages(const vectorized::SparseRange& row_ranges, std::set<int32_t>* page_ids) const {
+    for (size_t i = 0; i < row_ranges.size(); ++i) {
+        vectorized::Range r = row_ranges[i];
+        int64_t idx = r.begin();
+        auto iter = _ordinal_index->seek_at_or_before(r.begin());
+        while (idx < r.end()) {
+            page_ids->insert(iter.page_index());
+            idx = iter.last_ordinal() + 1;
+            iter.next();
+        }
+    }
+}
+
 Status ColumnReader::_load_ordinal_index(bool use_page_cache, bool kept_in_memory) {
     DCHECK(_ordinal_index_meta != nullptr);
     _ordinal_index = std::make_unique<OrdinalIndexReader>();
@@ -384,6 +434,29 @@ Status ColumnReader::_load_bloom_filter_index(bool use_page_cache, bool kept_in_
     return Status::OK();
 }
 
+Status ColumnReader::_load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory) {
+    if (_ngram_bf_index_meta != nullptr) {
+        _ngram_bloom_filter_index = std::make_unique<BloomFilterIndexReader>();
+        Status status = _ngram_bloom_filter_index->load(_opts.block_mgr, _file_name,
+                                                        &_ngram_bf_index_meta->bloom_filter(), use_page_cache,
+                                                        kept_in_memory);
+        _mem_tracker->consume(_ngram_bloom_filter_index->mem_usage());
+        return status;
+    }
+    return Status::OK();
+}
+
+Status ColumnReader::_load_inverted_index(bool use_page_cache, bool kept_in_memory) {
+    if (_inverted_index_meta != nullptr) {
+        _inverted_index = std::make_unique<BitmapIndexReader>();
+        Status status = _inverted_index->load(_opts.block_mgr, _file_name, _inverted_index_meta, use_page_cache,
+                                              kept_in_memory);
+        _mem_tracker->consume(_inverted_index->mem_usage());
+        return status;
+    }
+    return Status::OK();
+}
+
 Status ColumnReader::seek_to_first(OrdinalPageIndexIterator* iter) {
     *iter = _ordinal_index->begin();
     if (!iter->valid()) {
@@ -452,6 +525,17 @@ bool ColumnReader::segment_zone_map_filter(const std::vector<const vectorized::C
     return std::all_of(predicates.begin(), predicates.end(), filter);
 }
 
+bool ColumnReader::segment_zone_map_min_max(vectorized::Datum* min, vectorized::Datum* max) const {
+    if (_zone_map_index_meta == nullptr) {
+        return false;
+    }
+    const ZoneMapPB& zm = _zone_map_index_meta->segment_zone_map();
+    if (zm.has_null() || !zm.has_not_null()) {
+        return false;
+    }
+    return _parse_zone_map(zm, min, max).ok();
+}
+
 Status ColumnReader::new_iterator(ColumnIterator** iterator) {
     if (is_scalar_type(delegate_type(_column_type))) {
         *iterator = new FileColumnIterator(this);
@@ -495,6 +579,8 @@ Status ColumnReader::ensure_index_loaded(ReaderType reader_type) {
             RETURN_IF_ERROR(_load_zone_map_index(use_page_cache, _opts.kept_in_memory));
             RETURN_IF_ERROR(_load_bitmap_index(use_page_cache, _opts.kept_in_memory));
             RETURN_IF_ERROR(_load_bloom_filter_index(use_page_cache, _opts.kept_in_memory));
+            RETURN_IF_ERROR(_load_ngram_bloom_filter_index(use_page_cache, _opts.kept_in_memory));
+            RETURN_IF_ERROR(_load_inverted_index(use_page_cache, _opts.kept_in_memory));
             return Status::OK();
         });
     }
@@ -513,11 +599,14 @@ ArrayFileColumnIterator::ArrayFileColumnIterator(ColumnIterator* null_iterator,
 }
 
 Status ArrayFileColumnIterator::init(const ColumnIteratorOptions& opts) {
+    // the pages of the sub columns are read in the other ways, e.g. to calculate the element ordinals.
+    ColumnIteratorOptions sub_opts = opts;
+    sub_opts.use_decoded_page_cache = false;
     if (_null_iterator != nullptr) {
-        RETURN_IF_ERROR(_null_iterator->init(opts));
+        RETURN_IF_ERROR(_null_iterator->init(sub_opts));
     }
-    RETURN_IF_ERROR(_array_size_iterator->init(opts));
-    RETURN_IF_ERROR(_element_iterator->init(opts));
+    RETURN_IF_ERROR(_array_size_iterator->init(sub_opts));
+    RETURN_IF_ERROR(_element_iterator->init(sub_opts));
 
     const TypeInfoPtr& null_type = get_type_info(FieldType::OLAP_FIELD_TYPE_TINYINT);
     RETURN_IF_ERROR(ColumnVectorBatch::create(opts.chunk_size, true, null_type, nullptr, &_null_batch));
@@ -668,6 +757,9 @@ FileColumnIterator::~FileColumnIterator() = default;
 Status FileColumnIterator::init(const ColumnIteratorOptions& opts) {
     _opts = opts;
     RETURN_IF_ERROR(_reader->ensure_index_loaded(_opts.reader_type));
+    _use_decoded_page_cache = opts.use_decoded_page_cache && opts.use_page_cache && _reader->kept_in_memory() &&
+                              StoragePageCache::instance() != nullptr &&
+                              StoragePageCache::instance()->has_decoded_page_cache();
 
     if (_reader->encoding_info()->encoding() != DICT_ENCODING) {
         return Status::OK();
@@ -855,6 +947,45 @@ Status FileColumnIterator::_do_init_dict_decoder() {
 }
 
 Status FileColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter) {
+    if (_use_decoded_page_cache) {
+        return _read_decoded_data_page(iter);
+    }
+    return _read_raw_data_page(iter);
+}
+
+Status FileColumnIterator::_read_decoded_data_page(const OrdinalPageIndexIterator& iter) {
+    StoragePageCache* cache = StoragePageCache::instance();
+    StoragePageCache::CacheKey key(_opts.rblock->path(), iter.page().offset);
+    std::shared_ptr<const DecodedPage> decoded = cache->lookup_decoded_page(key);
+    if (decoded != nullptr) {
+        _opts.stats->decoded_cached_pages_num++;
+        // the dictionary is still needed to lookup or decode the dictionary codes.
+        if (_init_dict_decoder_func != nullptr && decoded->encoding == DICT_ENCODING && _dict_decoder == nullptr) {
+            RETURN_IF_ERROR(_load_dict_page());
+        }
+        _page = parse_decoded_page(std::move(decoded), iter.page(), iter.page_index());
+        return Status::OK();
+    }
+
+    RETURN_IF_ERROR(_read_raw_data_page(iter));
+    vectorized::ColumnPtr values =
+            vectorized::ChunkHelper::column_from_field_type(_reader->column_type(), is_nullable());
+    if (values == nullptr) {
+        // the type can't be decoded into a column without the type parameters, e.g. decimal v3.
+        _use_decoded_page_cache = false;
+        return Status::OK();
+    }
+    vectorized::ColumnPtr dict_codes;
+    if (_page->encoding_type() == DICT_ENCODING) {
+        dict_codes = vectorized::ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_INT, is_nullable());
+    }
+    RETURN_IF_ERROR(decode_page(_page.get(), std::move(values), std::move(dict_codes), &decoded));
+    cache->insert_decoded_page(key, decoded, decoded->memory_usage());
+    _page = parse_decoded_page(std::move(decoded), iter.page(), iter.page_index());
+    return Status::OK();
+}
+
+Status FileColumnIterator::_read_raw_data_page(const OrdinalPageIndexIterator& iter) {
     PageHandle handle;
     Slice page_body;
     PageFooterPB footer;
@@ -904,6 +1035,15 @@ Status FileColumnIterator::get_row_ranges_by_bloom_filter(CondColumn* cond_colum
 
 Status FileColumnIterator::get_row_ranges_by_bloom_filter(
         const std::vector<const vectorized::ColumnPredicate*>& predicates, vectorized::SparseRange* row_ranges) {
+    if (_reader->has_ngram_bloom_filter_index()) {
+        bool support_ngram = false;
+        for (const auto* pred : predicates) {
+            support_ngram = support_ngram | pred->support_ngram_bloom_filter();
+        }
+        if (support_ngram) {
+            RETURN_IF_ERROR(_reader->ngram_bloom_filter(predicates, row_ranges));
+        }
+    }
     RETURN_IF(!_reader->has_bloom_filter_index(), Status::OK());
     bool support = false;
     for (const auto* pred : predicates) {
@@ -914,6 +1054,35 @@ Status FileColumnIterator::get_row_ranges_by_bloom_filter(
     return Status::OK();
 }
 
+Status FileColumnIterator::filter_by_encoded_values(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                                    vectorized::SparseRange* row_ranges) {
+    RETURN_IF(row_ranges->empty(), Status::OK());
+    const EncodingTypePB encoding = _reader->encoding_info()->encoding();
+    RETURN_IF(encoding != FOR_ENCODING && encoding != RLE, Status::OK());
+    RETURN_IF_ERROR(seek_to_ordinal(row_ranges->begin()));
+
+    const auto first_rowid = implicit_cast<rowid_t>(_page->first_ordinal());
+    const auto last_rowid = implicit_cast<rowid_t>(_page->first_ordinal() + _page->num_rows());
+    vectorized::SparseRange page_range = row_ranges->intersection(vectorized::SparseRange(first_rowid, last_rowid));
+    vectorized::SparseRange offsets;
+    for (size_t i = 0; i < page_range.size(); i++) {
+        offsets.add(vectorized::Range(page_range[i].begin() - first_rowid, page_range[i].end() - first_rowid));
+    }
+    Status st = _page->filter_by_encoded_values(predicates, &offsets);
+    RETURN_IF(st.is_not_supported(), Status::OK());
+    RETURN_IF_ERROR(st);
+    DCHECK_EQ(_page->offset(), row_ranges->begin() - first_rowid);
+
+    vectorized::SparseRange kept;
+    for (size_t i = 0; i < offsets.size(); i++) {
+        kept.add(vectorized::Range(offsets[i].begin() + first_rowid, offsets[i].end() + first_rowid));
+    }
+    // The rows beyond this page are kept.
+    kept.add(vectorized::Range(last_rowid, std::max(last_rowid, row_ranges->end())));
+    *row_ranges &= kept;
+    return Status::OK();
+}
+
 int FileColumnIterator::dict_lookup(const Slice& word) {
     DCHECK(all_page_dict_encoded());
     return (this->*_dict_lookup_func)(word);
@@ -989,33 +1158,32 @@ Status FileColumnIterator::_do_decode_dict_codes(const int32_t* codes, size_t si
 Status FileColumnIterator::fetch_values_by_rowid(const rowid_t* rowids, size_t size, vectorized::Column* values) {
     DCHECK(std::is_sorted(rowids, rowids + size));
     RETURN_IF(size == 0, Status::OK());
+    return fetch_values_by_ranges(vectorized::rowids2range(rowids, size), values);
+}
+
+Status FileColumnIterator::fetch_values_by_ranges(const vectorized::SparseRange& ranges, vectorized::Column* values) {
+    RETURN_IF(ranges.empty(), Status::OK());
     size_t prev_bytes = values->byte_size();
-    const rowid_t* const end = rowids + size;
     bool contain_deleted_row = (values->delete_state() != DEL_NOT_SATISFIED);
+    vectorized::SparseRangeIterator iter = ranges.new_iterator();
     do {
-        RETURN_IF_ERROR(seek_to_ordinal(*rowids));
+        // the page of the next row is located by the ordinal index, so the pages between are skipped.
+        RETURN_IF_ERROR(seek_to_ordinal(iter.begin()));
         contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
-        auto last_rowid = implicit_cast<rowid_t>(_page->first_ordinal() + _page->num_rows());
-        const rowid_t* next_page_rowid = std::lower_bound(rowids, end, last_rowid);
-        while (rowids != next_page_rowid) {
-            DCHECK_EQ(_current_ordinal, _page->first_ordinal() + _page->offset());
-            rowid_t curr = *rowids;
-            _current_ordinal = implicit_cast<ordinal_t>(curr);
-            _page->seek(curr - _page->first_ordinal());
-            const rowid_t* p = rowids + 1;
-            while ((next_page_rowid != p) && (*p == curr + 1)) {
-                curr = *p++;
-            }
-            size_t nread = p - rowids;
-            RETURN_IF_ERROR(_page->read(values, &nread));
-            _current_ordinal += nread;
-            rowids = p;
+        const auto first_rowid = implicit_cast<rowid_t>(_page->first_ordinal());
+        const auto last_rowid = implicit_cast<rowid_t>(_page->first_ordinal() + _page->num_rows());
+        // Collect the rows of this page, so that the page decodes only them by one call.
+        vectorized::SparseRange page_range;
+        while (iter.has_more() && iter.begin() < last_rowid) {
+            vectorized::Range r = iter.next(last_rowid - iter.begin());
+            page_range.add(vectorized::Range(r.begin() - first_rowid, r.end() - first_rowid));
         }
+        RETURN_IF_ERROR(_page->read_by_ranges(values, page_range));
+        _current_ordinal = _page->first_ordinal() + page_range.end();
         DCHECK_EQ(_current_ordinal, _page->first_ordinal() + _page->offset());
-    } while (rowids != end);
+    } while (iter.has_more());
     values->set_delete_state(contain_deleted_row ? DEL_PARTIAL_SATISFIED : DEL_NOT_SATISFIED);
     _opts.stats->bytes_read += values->byte_size() - prev_bytes;
-    DCHECK_EQ(_current_ordinal, _page->first_ordinal() + _page->offset());
     return Status::OK();
 }
 
@@ -1112,6 +1280,12 @@ Status DefaultValueColumnIterator::fetch_values_by_rowid(const rowid_t* rowids,
     return next_batch(&size, values);
 }
 
+Status DefaultValueColumnIterator::fetch_values_by_ranges(const vectorized::SparseRange& ranges,
+                                                          vectorized::Column* values) {
+    size_t size = ranges.span_size();
+    return next_batch(&size, values);
+}
+
 Status DefaultValueColumnIterator::get_row_ranges_by_zone_map(
         const std::vector<const vectorized::ColumnPredicate*>& predicates,
         const vectorized::ColumnPredicate* del_predicate, vectorized::SparseRange* row_ranges) {
@@ -1140,4 +1314,15 @@ Status ColumnIterator::fetch_values_by_rowid(const vectorized::Column& rowids, v
     return fetch_values_by_rowid(p, rowids.size(), values);
 }
 
+Status ColumnIterator::fetch_values_by_ranges(const vectorized::SparseRange& ranges, vectorized::Column* values) {
+    std::vector<rowid_t> rowids;
+    rowids.reserve(ranges.span_size());
+    for (size_t i = 0; i < ranges.size(); i++) {
+        for (rowid_t rowid = ranges[i].begin(); rowid < ranges[i].end(); rowid++) {
+            rowids.push_back(rowid);
+        }
+    }
+    return fetch_values_by_rowid(rowids.data(), rowids.size(), values);
+}
+
 } // namespace starrocks::segment_v2
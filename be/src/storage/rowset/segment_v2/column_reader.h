@@ -25,6 +25,7 @@
 #include <cstddef> // for size_t
 #include <cstdint> // for uint32_t
 #include <memory>  // for unique_ptr
+#include <set>
 
 #include "column/datum.h"
 #include "column/fixed_length_column.h"
@@ -95,6 +96,10 @@ struct ColumnIteratorOptions {
     // check whether column pages are all dictionary encoding.
     bool check_dict_encoding = false;
 
+    // whether to use the decoded page cache for the in_memory columns, which requires the pages are only read
+    // into vectorized::Column.
+    bool use_decoded_page_cache = false;
+
     void sanity_check() const {
         CHECK_NOTNULL(rblock);
         CHECK_NOTNULL(stats);
@@ -119,12 +124,14 @@ public:
     static Status create(MemTracker* mem_tracker, const ColumnReaderOptions& opts, const ColumnMetaPB& meta,
                          uint64_t num_rows, const std::string& file_name, std::unique_ptr<ColumnReader>* reader);
 
-    ~ColumnReader() = default;
+    ~ColumnReader();
 
     // create a new column iterator. Client should delete returned iterator
     Status new_iterator(ColumnIterator** iterator);
     // Client should delete returned iterator
     Status new_bitmap_index_iterator(BitmapIndexIterator** iterator);
+    // Client should delete returned iterator, which iterates the tokens of the inverted index.
+    Status new_inverted_index_iterator(BitmapIndexIterator** iterator);
 
     // Seek to the first entry in the column.
     Status seek_to_first(OrdinalPageIndexIterator* iter);
@@ -136,11 +143,15 @@ public:
 
     bool is_nullable() const { return _is_nullable; }
 
+    bool kept_in_memory() const { return _opts.kept_in_memory; }
+
     const EncodingInfo* encoding_info() const { return _encoding_info; }
 
     bool has_zone_map() const { return _zone_map_index_meta != nullptr; }
     bool has_bitmap_index() const { return _bitmap_index_meta != nullptr; }
     bool has_bloom_filter_index() const { return _bf_index_meta != nullptr; }
+    bool has_ngram_bloom_filter_index() const { return _ngram_bf_index_meta != nullptr; }
+    bool has_inverted_index() const { return _inverted_index_meta != nullptr; }
 
     // Check if this column could match `cond' using segment zone map.
     // Since segment zone map is stored in metadata, this function is fast without I/O.
@@ -179,10 +190,18 @@ public:
     // same as `match_condition`, used by vector engine.
     bool segment_zone_map_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& predicates) const;
 
+    // Get the min and max values of this segment from the segment-level zone map.
+    // Return false if there is no zone map, or the segment has any null value.
+    bool segment_zone_map_min_max(vectorized::Datum* min, vectorized::Datum* max) const;
+
     // prerequisite: at least one predicate in |predicates| support bloom filter.
     Status bloom_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& p,
                         vectorized::SparseRange* ranges);
 
+    // prerequisite: at least one predicate in |predicates| support n-gram bloom filter.
+    Status ngram_bloom_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& p,
+                              vectorized::SparseRange* ranges);
+
     uint32_t version() const { return _opts.storage_format_version; }
 
     // Read and load necessary column indexes into memory if it hasn't been loaded.
@@ -199,6 +218,11 @@ private:
     Status _load_ordinal_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bitmap_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
+    Status _load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
+    Status _load_inverted_index(bool use_page_cache, bool kept_in_memory);
+
+    // Get the ids of the pages covered by |row_ranges|.
+    void _get_covered_pages(const vectorized::SparseRange& row_ranges, std::set<int32_t>* page_ids) const;
 
     static bool _zone_map_match_condition(const ZoneMapPB& zone_map, WrapperField* min_value_container,
                                           WrapperField* max_value_container, CondColumn* cond);
@@ -238,12 +262,16 @@ private:
     // initialized in init(), used for create PageDecoder
     const EncodingInfo* _encoding_info = nullptr;
     const BlockCompressionCodec* _compress_codec = nullptr; // initialized in init()
+    // the codec of the ZSTD dictionary of the column, if any
+    std::unique_ptr<BlockCompressionCodec> _dict_codec;
 
     // meta for various column indexes (null if the index is absent)
     const ZoneMapIndexPB* _zone_map_index_meta = nullptr;
     const OrdinalIndexPB* _ordinal_index_meta = nullptr;
     const BitmapIndexPB* _bitmap_index_meta = nullptr;
     const BloomFilterIndexPB* _bf_index_meta = nullptr;
+    const NGramBloomFilterIndexPB* _ngram_bf_index_meta = nullptr;
+    const BitmapIndexPB* _inverted_index_meta = nullptr;
 
     // The read operation comprise of compaction, query, checksum and so on.
     // The ordinal index must be loaded before read operation.
@@ -256,6 +284,8 @@ private:
     std::unique_ptr<OrdinalIndexReader> _ordinal_index;
     std::unique_ptr<BitmapIndexReader> _bitmap_index;
     std::unique_ptr<BloomFilterIndexReader> _bloom_filter_index;
+    std::unique_ptr<BloomFilterIndexReader> _ngram_bloom_filter_index;
+    std::unique_ptr<BitmapIndexReader> _inverted_index;
 
     std::vector<std::unique_ptr<ColumnReader>> _sub_readers;
 };
@@ -313,6 +343,15 @@ public:
         return Status::OK();
     }
 
+    // Remove the rows from |row_ranges| that can't satisfy |predicates| by the encoded values of the data
+    // pages, without decoding the values one by one, the rows kept still need to be evaluated.
+    // Whether or not any rows are removed, the iterator is positioned at the first row of |row_ranges|
+    // on success.
+    virtual Status filter_by_encoded_values(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                            vectorized::SparseRange* row_ranges) {
+        return Status::OK();
+    }
+
     // return true iff all data pages of this column are encoded as dictionary encoding.
     // NOTE: the ColumnIterator must have been initialized with `check_dict_encoding`,
     // otherwise this method will always return false.
@@ -351,6 +390,10 @@ public:
 
     Status fetch_values_by_rowid(const vectorized::Column& rowids, vectorized::Column* values);
 
+    // given the ascending rows of |ranges|, fetch corresponding values.
+    // the rows out of |ranges| are skipped, e.g, the pages without any row of |ranges| are never read.
+    virtual Status fetch_values_by_ranges(const vectorized::SparseRange& ranges, vectorized::Column* values);
+
 protected:
     ColumnIteratorOptions _opts;
 };
@@ -394,6 +437,10 @@ public:
     Status get_row_ranges_by_bloom_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
                                           vectorized::SparseRange* range) override;
 
+    // Only the rows of the page containing the first row of |row_ranges| are evaluated.
+    Status filter_by_encoded_values(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                    vectorized::SparseRange* row_ranges) override;
+
     bool all_page_dict_encoded() const override { return _all_dict_encoded; }
 
     int dict_lookup(const Slice& word) override;
@@ -404,6 +451,8 @@ public:
 
     Status fetch_values_by_rowid(const rowid_t* rowids, size_t size, vectorized::Column* values) override;
 
+    Status fetch_values_by_ranges(const vectorized::SparseRange& ranges, vectorized::Column* values) override;
+
     ParsedPage* get_current_page() { return _page.get(); }
 
     bool is_nullable() { return _reader->is_nullable(); }
@@ -414,6 +463,9 @@ private:
     static void _seek_to_pos_in_page(ParsedPage* page, ordinal_t offset_in_page);
     Status _load_next_page(bool* eos);
     Status _read_data_page(const OrdinalPageIndexIterator& iter);
+    Status _read_raw_data_page(const OrdinalPageIndexIterator& iter);
+    // Read the data page from the decoded page cache, or decode it into the cache if it's not cached.
+    Status _read_decoded_data_page(const OrdinalPageIndexIterator& iter);
 
     template <FieldType Type>
     int _do_dict_lookup(const Slice& word);
@@ -470,6 +522,8 @@ private:
     // whether all data pages are dict-encoded.
     bool _all_dict_encoded = false;
 
+    bool _use_decoded_page_cache = false;
+
     // variable used for array column(offset, element)
     // It's used to get element ordinal for specfied offset value.
     int64_t _element_ordinal = 0;
@@ -581,6 +635,8 @@ public:
 
     Status fetch_values_by_rowid(const rowid_t* rowids, size_t size, vectorized::Column* values) override;
 
+    Status fetch_values_by_ranges(const vectorized::SparseRange& ranges, vectorized::Column* values) override;
+
 private:
     bool _has_default_value;
     std::string _default_value;
@@ -28,11 +28,13 @@
 #include "column/column_helper.h"
 #include "column/hash_set.h"
 #include "column/nullable_column.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
 #include "gutil/strings/substitute.h"
 #include "simd/simd.h"
 #include "storage/fs/block_manager.h"
+#include "storage/rowset/segment_v2/adaptive_encoding.h"
 #include "storage/rowset/segment_v2/bitmap_index_writer.h"
 #include "storage/rowset/segment_v2/bitshuffle_page.h"
 #include "storage/rowset/segment_v2/bloom_filter.h"
@@ -42,6 +44,8 @@
 #include "storage/rowset/segment_v2/ordinal_page_index.h"
 #include "storage/rowset/segment_v2/page_builder.h"
 #include "storage/rowset/segment_v2/page_io.h"
+#include "storage/rowset/segment_v2/text_index.h"
+#include "storage/rowset/segment_v2/text_index_writer.h"
 #include "storage/rowset/segment_v2/zone_map_index.h"
 #include "util/block_compression.h"
 #include "util/faststring.h"
@@ -332,9 +336,21 @@ ScalarColumnWriter::~ScalarColumnWriter() {
 
 Status ScalarColumnWriter::init() {
     RETURN_IF_ERROR(get_block_compression_codec(_opts.meta->compression(), &_compress_codec));
+    _compression = _opts.meta->compression();
+    if (_opts.zstd_dict_compression &&
+        (get_field()->type() == OLAP_FIELD_TYPE_CHAR || get_field()->type() == OLAP_FIELD_TYPE_VARCHAR)) {
+        _train_compression_dict = true;
+    }
 
     if (!_opts.need_speculate_encoding) {
         set_encoding(_opts.meta->encoding());
+        FieldType type = get_field()->type_info()->type();
+        if (_opts.adaptive_encoding && _page_builder != nullptr && _opts.meta->encoding() != DICT_ENCODING &&
+            AdaptiveEncodingSelector::is_supported(type)) {
+            _encoding_selector = std::make_unique<AdaptiveEncodingSelector>(
+                    type, _opts.meta->encoding(), _compression, _opts.compression_min_space_saving);
+            _page_builder = std::make_unique<SamplingPageBuilder>(std::move(_page_builder), _encoding_selector.get());
+        }
     }
     // create ordinal builder
     _ordinal_index_builder = std::make_unique<OrdinalIndexWriter>();
@@ -356,6 +372,21 @@ Status ScalarColumnWriter::init() {
         RETURN_IF_ERROR(BloomFilterIndexWriter::create(BloomFilterOptions(), get_field()->type_info(),
                                                        &_bloom_filter_index_builder));
     }
+    if (_opts.need_ngram_bloom_filter || _opts.need_inverted_index) {
+        FieldType type = get_field()->type();
+        if (type != OLAP_FIELD_TYPE_CHAR && type != OLAP_FIELD_TYPE_VARCHAR) {
+            return Status::NotSupported("unsupported type for text index: " + std::to_string(type));
+        }
+    }
+    if (_opts.need_ngram_bloom_filter) {
+        _has_index_builder = true;
+        _ngram_bloom_filter_index_builder =
+                std::make_unique<NGramBloomFilterIndexWriter>(BloomFilterOptions(), kDefaultNGramSize);
+    }
+    if (_opts.need_inverted_index) {
+        _has_index_builder = true;
+        _inverted_index_builder = std::make_unique<InvertedIndexWriter>();
+    }
     return Status::OK();
 }
 
@@ -379,11 +410,20 @@ uint64_t ScalarColumnWriter::estimate_buffer_size() {
     if (_bloom_filter_index_builder != nullptr) {
         size += _bloom_filter_index_builder->size();
     }
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        size += _ngram_bloom_filter_index_builder->size();
+    }
+    if (_inverted_index_builder != nullptr) {
+        size += _inverted_index_builder->size();
+    }
     return size;
 }
 
 Status ScalarColumnWriter::finish() {
     RETURN_IF_ERROR(finish_current_page());
+    if (_train_compression_dict) {
+        RETURN_IF_ERROR(_compress_with_dict());
+    }
     _opts.meta->set_num_rows(_next_rowid);
     return Status::OK();
 }
@@ -454,14 +494,20 @@ Status ScalarColumnWriter::write_zone_map() {
 
 Status ScalarColumnWriter::write_bitmap_index() {
     if (_bitmap_index_builder != nullptr) {
-        return _bitmap_index_builder->finish(_wblock, _opts.meta->add_indexes());
+        RETURN_IF_ERROR(_bitmap_index_builder->finish(_wblock, _opts.meta->add_indexes()));
+    }
+    if (_inverted_index_builder != nullptr) {
+        RETURN_IF_ERROR(_inverted_index_builder->finish(_wblock, _opts.meta->add_indexes()));
     }
     return Status::OK();
 }
 
 Status ScalarColumnWriter::write_bloom_filter_index() {
     if (_bloom_filter_index_builder != nullptr) {
-        return _bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes());
+        RETURN_IF_ERROR(_bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes()));
+    }
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes()));
     }
     return Status::OK();
 }
@@ -487,6 +533,10 @@ Status ScalarColumnWriter::finish_current_page() {
         RETURN_IF_ERROR(_bloom_filter_index_builder->flush());
     }
 
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->flush());
+    }
+
     // build data page body : encoded values + [nullmap]
     std::vector<Slice> body;
     faststring* encoded_values = _page_builder->finish();
@@ -517,10 +567,17 @@ Status ScalarColumnWriter::finish_current_page() {
     data_page_footer->set_nullmap_size(nullmap.slice().size);
     data_page_footer->set_format_version(_curr_page_format);
     data_page_footer->set_corresponding_element_ordinal(_element_ordinal);
+    if (_encoding_info->encoding() != _opts.meta->encoding()) {
+        data_page_footer->set_encoding(_encoding_info->encoding());
+    }
+    if (_compression != _opts.meta->compression()) {
+        page->footer.set_compression(_compression);
+    }
     // trying to compress page body
     faststring compressed_body;
-    RETURN_IF_ERROR(
-            PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving, body, &compressed_body));
+    // The page is compressed later with the dictionary trained from it.
+    const BlockCompressionCodec* codec = _train_compression_dict ? nullptr : _compress_codec;
+    RETURN_IF_ERROR(PageIO::compress_page_body(codec, _opts.compression_min_space_saving, body, &compressed_body));
     if (compressed_body.size() == 0) {
         // page body is uncompressed
         page->data.emplace_back(encoded_values->build());
@@ -549,6 +606,84 @@ Status ScalarColumnWriter::finish_current_page() {
     _page_builder->reset();
     _first_rowid = _next_rowid;
 
+    if (_encoding_selector != nullptr && ++_num_sampled_pages >= config::adaptive_encoding_sample_pages) {
+        RETURN_IF_ERROR(_select_encoding());
+    }
+    if (_train_compression_dict && _data_size >= config::zstd_dict_sample_bytes) {
+        RETURN_IF_ERROR(_compress_with_dict());
+    }
+    return Status::OK();
+}
+
+Status ScalarColumnWriter::_compress_with_dict() {
+    // Many small samples train a better dictionary than a few large pages.
+    static constexpr size_t kSampleSize = 4096;
+    std::vector<Slice> samples;
+    for (Page* page = _pages.head; page != nullptr; page = page->next) {
+        for (auto& data : page->data) {
+            Slice slice = data.slice();
+            for (size_t offset = 0; offset < slice.size; offset += kSampleSize) {
+                samples.emplace_back(slice.data + offset, std::min(kSampleSize, slice.size - offset));
+            }
+        }
+    }
+    std::string dict;
+    _train_compression_dict = false;
+    Status st = train_zstd_dictionary(samples, config::zstd_dict_size, &dict);
+    if (st.ok()) {
+        st = create_zstd_dict_codec(dict, &_dict_codec);
+    }
+    if (st.ok()) {
+        _compress_codec = _dict_codec.get();
+        _compression = ZSTD;
+        _opts.meta->set_compression(ZSTD);
+        _opts.meta->set_compression_dict(dict);
+    } else {
+        // e.g. too few values to train, the pages are compressed by the codec of the column.
+        VLOG(2) << "Fail to train the compression dictionary: " << st.to_string();
+    }
+
+    _data_size = 0;
+    for (Page* page = _pages.head; page != nullptr; page = page->next) {
+        std::vector<Slice> body;
+        for (auto& data : page->data) {
+            body.push_back(data.slice());
+        }
+        faststring compressed_body;
+        RETURN_IF_ERROR(PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving, body,
+                                                   &compressed_body));
+        if (compressed_body.size() != 0) {
+            page->data.clear();
+            page->data.emplace_back(compressed_body.build());
+        }
+        for (auto& data : page->data) {
+            _data_size += data.slice().size;
+        }
+        // the same estimation as _push_back_page()
+        _data_size += 20;
+    }
+    return Status::OK();
+}
+
+Status ScalarColumnWriter::_select_encoding() {
+    EncodingTypePB encoding;
+    CompressionTypePB compression;
+    RETURN_IF_ERROR(_encoding_selector->select(&encoding, &compression));
+    // Unlike set_encoding(), the encoding of the column is kept, and the pages record the chosen one.
+    RETURN_IF_ERROR(EncodingInfo::get(get_field()->type_info()->type(), encoding, &_encoding_info));
+    PageBuilderOptions opts;
+    opts.data_page_size = _opts.data_page_size;
+    PageBuilder* page_builder = nullptr;
+    RETURN_IF_ERROR(_encoding_info->create_page_builder(opts, &page_builder));
+    if (page_builder == nullptr) {
+        return Status::NotSupported(strings::Substitute("Failed to create page builder for type $0 and encoding $1",
+                                                        get_field()->type(), encoding));
+    }
+    // Replace the sampling page builder, which is empty after the reset.
+    _page_builder.reset(page_builder);
+    RETURN_IF_ERROR(get_block_compression_codec(compression, &_compress_codec));
+    _compression = compression;
+    _encoding_selector.reset();
     return Status::OK();
 }
 
@@ -675,10 +810,14 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
                     INDEX_ADD_NULLS(_zone_map_index_builder, run);
                     INDEX_ADD_NULLS(_bitmap_index_builder, run);
                     INDEX_ADD_NULLS(_bloom_filter_index_builder, run);
+                    INDEX_ADD_NULLS(_ngram_bloom_filter_index_builder, run);
+                    INDEX_ADD_NULLS(_inverted_index_builder, run);
                 } else {
                     INDEX_ADD_VALUES(_zone_map_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bitmap_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bloom_filter_index_builder, pdata, run);
+                    INDEX_ADD_VALUES(_ngram_bloom_filter_index_builder, pdata, run);
+                    INDEX_ADD_VALUES(_inverted_index_builder, pdata, run);
                 }
                 pdata += get_field()->size() * run;
             }
@@ -686,6 +825,8 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
             INDEX_ADD_VALUES(_zone_map_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bitmap_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bloom_filter_index_builder, data, num_written);
+            INDEX_ADD_VALUES(_ngram_bloom_filter_index_builder, data, num_written);
+            INDEX_ADD_VALUES(_inverted_index_builder, data, num_written);
         }
 
         _next_rowid += num_written;
@@ -62,14 +62,25 @@ struct ColumnWriterOptions {
     bool need_zone_map = false;
     bool need_bitmap_index = false;
     bool need_bloom_filter = false;
+    // the text indexes of the char/varchar columns, for the substring and the token matches
+    bool need_ngram_bloom_filter = false;
+    bool need_inverted_index = false;
     bool adaptive_page_format = false;
     // for char/varchar will speculate encoding in append
     // for others will decide encoding in init method
     bool need_speculate_encoding = false;
+    // choose the encoding and the compression of the data pages by sampling the first pages,
+    // see AdaptiveEncodingSelector
+    bool adaptive_encoding = false;
+    // compress the pages of the string columns by ZSTD with a dictionary trained from the first pages
+    bool zstd_dict_compression = false;
 };
 
+class AdaptiveEncodingSelector;
 class BitmapIndexWriter;
 class EncodingInfo;
+class InvertedIndexWriter;
+class NGramBloomFilterIndexWriter;
 class NullMapRLEBuilder;
 class NullMapBitshuffleBuilder;
 class OrdinalIndexWriter;
@@ -204,6 +215,12 @@ private:
 
     Status _write_data_page(Page* page);
 
+    // Switch to the encoding and the compression chosen by the sampled pages.
+    Status _select_encoding();
+
+    // Train the ZSTD dictionary from the pages buffered uncompressed, and compress them with it.
+    Status _compress_with_dict();
+
     ColumnWriterOptions _opts;
     fs::WritableBlock* _wblock;
     uint32_t _curr_page_format;
@@ -217,6 +234,16 @@ private:
 
     const BlockCompressionCodec* _compress_codec = nullptr;
     const EncodingInfo* _encoding_info = nullptr;
+    // The compression of the data pages, which differs from the one of the column if chosen by the adaptive encoding.
+    CompressionTypePB _compression = NO_COMPRESSION;
+
+    // Sample the values of the first pages, if the adaptive encoding is enabled.
+    std::unique_ptr<AdaptiveEncodingSelector> _encoding_selector;
+    uint32_t _num_sampled_pages = 0;
+
+    // The pages are kept uncompressed until the ZSTD dictionary is trained from them.
+    bool _train_compression_dict = false;
+    std::unique_ptr<BlockCompressionCodec> _dict_codec;
 
     std::unique_ptr<PageBuilder> _page_builder;
 
@@ -230,7 +257,9 @@ private:
     std::unique_ptr<ZoneMapIndexWriter> _zone_map_index_builder;
     std::unique_ptr<BitmapIndexWriter> _bitmap_index_builder;
     std::unique_ptr<BloomFilterIndexWriter> _bloom_filter_index_builder;
-    // _zone_map_index_builder != NULL || _bitmap_index_builder != NULL || _bloom_filter_index_builder != NULL
+    std::unique_ptr<NGramBloomFilterIndexWriter> _ngram_bloom_filter_index_builder;
+    std::unique_ptr<InvertedIndexWriter> _inverted_index_builder;
+    // any of the index builders above != NULL
     bool _has_index_builder = false;
     int64_t _element_ordinal = 0;
     int64_t _previous_ordinal = 0;
@@ -0,0 +1,285 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "column/column.h"
+#include "gutil/strings/substitute.h"
+#include "storage/rowset/segment_v2/options.h"
+#include "storage/rowset/segment_v2/page_builder.h"
+#include "storage/rowset/segment_v2/page_decoder.h"
+#include "storage/types.h"
+#include "util/bit_packing.inline.h"
+#include "util/bit_stream_utils.inline.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+
+namespace starrocks {
+namespace segment_v2 {
+
+enum { DELTA_BINARY_PACKED_PAGE_HEADER_SIZE = 12, DELTA_BINARY_PACKED_BLOCK_HEADER_SIZE = 9 };
+
+// The number of deltas of a block, which share a min delta and a bit width.
+static constexpr uint32_t DELTA_BINARY_PACKED_BLOCK_SIZE = 128;
+
+// DeltaBinaryPackedPageBuilder encodes the integers by the deltas between the adjacent values, which are bit
+// packed by blocks, each with its own min delta and bit width. The monotonic values, e.g. the timestamps and the
+// sequence ids, have small and similar deltas, so they are packed into a few bits per value.
+//
+// The page format is as follows:
+//
+// 1. Header: (12 bytes total)
+//
+//    <num_elements> [32-bit]
+//    <first_value> [64-bit]
+//
+// 2. The blocks of the deltas, i.e. value[i] - value[i - 1] of i in [1, num_elements), each of at most
+//    DELTA_BINARY_PACKED_BLOCK_SIZE deltas:
+//
+//    <min_delta> [64-bit]
+//    <bit_width> [8-bit]
+//    <packed deltas> [ceil(deltas * bit_width / 8) bytes]
+//      The deltas minus min_delta, bit packed in the layout of BitWriter.
+//
+//   NOTE: all on-disk ints are encoded little-endian, and the values and the deltas are computed as the 64-bit
+//   integers wrapping around on overflow.
+//
+template <FieldType Type>
+class DeltaBinaryPackedPageBuilder final : public PageBuilder {
+public:
+    explicit DeltaBinaryPackedPageBuilder(const PageBuilderOptions& options)
+            : _max_count(options.data_page_size / sizeof(CppType)), _finished(false) {}
+
+    ~DeltaBinaryPackedPageBuilder() override = default;
+
+    bool is_page_full() override { return _values.size() >= _max_count; }
+
+    size_t add(const uint8_t* vals, size_t count) override {
+        DCHECK(!_finished);
+        size_t to_add = std::min<size_t>(_max_count - _values.size(), count);
+        const size_t old_size = _values.size();
+        _values.resize(old_size + to_add);
+        memcpy(_values.data() + old_size, vals, to_add * sizeof(CppType));
+        return to_add;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        _buf.clear();
+        put_fixed32_le(&_buf, _values.size());
+        if (_values.empty()) {
+            put_fixed64_le(&_buf, 0);
+            return &_buf;
+        }
+        put_fixed64_le(&_buf, _to_uint64(_values[0]));
+        for (size_t start = 1; start < _values.size(); start += DELTA_BINARY_PACKED_BLOCK_SIZE) {
+            _put_block(start, std::min<size_t>(_values.size(), start + DELTA_BINARY_PACKED_BLOCK_SIZE));
+        }
+        return &_buf;
+    }
+
+    void reset() override {
+        _values.clear();
+        _buf.clear();
+        _finished = false;
+    }
+
+    size_t count() const override { return _values.size(); }
+
+    uint64_t size() const override { return _finished ? _buf.size() : _values.size() * sizeof(CppType); }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), sizeof(CppType));
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), sizeof(CppType));
+        return Status::OK();
+    }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+
+    static uint64_t _to_uint64(CppType v) { return static_cast<uint64_t>(static_cast<int64_t>(v)); }
+
+    // Put the block of the deltas of the values in [start, end).
+    void _put_block(size_t start, size_t end) {
+        int64_t deltas[DELTA_BINARY_PACKED_BLOCK_SIZE];
+        int64_t min_delta = std::numeric_limits<int64_t>::max();
+        for (size_t i = start; i < end; i++) {
+            deltas[i - start] = static_cast<int64_t>(_to_uint64(_values[i]) - _to_uint64(_values[i - 1]));
+            min_delta = std::min(min_delta, deltas[i - start]);
+        }
+        uint64_t max_packed = 0;
+        for (size_t i = 0; i < end - start; i++) {
+            max_packed = std::max(max_packed, static_cast<uint64_t>(deltas[i]) - static_cast<uint64_t>(min_delta));
+        }
+        const int bit_width = max_packed == 0 ? 0 : 64 - __builtin_clzll(max_packed);
+
+        put_fixed64_le(&_buf, static_cast<uint64_t>(min_delta));
+        _buf.push_back(static_cast<uint8_t>(bit_width));
+        if (bit_width == 0) {
+            return;
+        }
+        BitWriter writer(&_packed);
+        for (size_t i = 0; i < end - start; i++) {
+            writer.PutValue(static_cast<uint64_t>(deltas[i]) - static_cast<uint64_t>(min_delta), bit_width);
+        }
+        writer.Flush();
+        _buf.append(_packed.data(), _packed.size());
+    }
+
+    const size_t _max_count;
+    bool _finished;
+    std::vector<CppType> _values;
+    faststring _packed;
+    faststring _buf;
+};
+
+template <FieldType Type>
+class DeltaBinaryPackedPageDecoder final : public PageDecoder {
+public:
+    DeltaBinaryPackedPageDecoder(Slice data, const PageDecoderOptions& options)
+            : _data(data), _parsed(false), _num_elements(0), _cur_index(0) {}
+
+    ~DeltaBinaryPackedPageDecoder() override = default;
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < DELTA_BINARY_PACKED_PAGE_HEADER_SIZE) {
+            return Status::Corruption(strings::Substitute("invalid delta binary packed page size: $0", _data.size));
+        }
+        _num_elements = decode_fixed32_le(reinterpret_cast<const uint8_t*>(_data.data));
+        // Check the sizes of the blocks, so that the values are decoded without checks.
+        size_t offset = DELTA_BINARY_PACKED_PAGE_HEADER_SIZE;
+        for (size_t start = 1; start < _num_elements; start += DELTA_BINARY_PACKED_BLOCK_SIZE) {
+            if (offset + DELTA_BINARY_PACKED_BLOCK_HEADER_SIZE > _data.size) {
+                return Status::Corruption("the delta binary packed page is truncated");
+            }
+            const size_t num_deltas = std::min<size_t>(_num_elements - start, DELTA_BINARY_PACKED_BLOCK_SIZE);
+            const uint8_t bit_width = static_cast<uint8_t>(_data.data[offset + 8]);
+            if (bit_width > 64) {
+                return Status::Corruption(
+                        strings::Substitute("invalid bit width of deltas: $0", static_cast<int>(bit_width)));
+            }
+            offset += DELTA_BINARY_PACKED_BLOCK_HEADER_SIZE + BitUtil::Ceil(num_deltas * bit_width, 8);
+        }
+        if (offset != _data.size) {
+            return Status::Corruption("the size of the delta binary packed page is unmatched");
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _num_elements);
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+        _decode();
+        *n = std::min(*n, _num_elements - _cur_index);
+        memcpy(dst->data(), &_decoded[_cur_index], *n * sizeof(CppType));
+        _cur_index += *n;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::Column* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+        *n = std::min(*n, _num_elements - _cur_index);
+        const size_t ori_size = dst->size();
+        if (_decoded.empty() && _cur_index == 0 && *n == _num_elements) {
+            // The whole page is read by one batch, and decoded into the column directly.
+            dst->resize(ori_size + *n);
+            _decode_to(reinterpret_cast<CppType*>(dst->mutable_raw_data()) + ori_size);
+        } else {
+            _decode();
+            size_t appended = dst->append_numbers(&_decoded[_cur_index], *n * sizeof(CppType));
+            DCHECK_EQ(*n, appended);
+        }
+        _cur_index += *n;
+        return Status::OK();
+    }
+
+    size_t count() const override { return _num_elements; }
+
+    size_t current_index() const override { return _cur_index; }
+
+    EncodingTypePB encoding_type() const override { return DELTA_BINARY_PACKED; }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+
+    void _decode() {
+        if (_decoded.empty() && _num_elements > 0) {
+            _decoded.resize(_num_elements);
+            _decode_to(_decoded.data());
+        }
+    }
+
+    // Decode all the values of this page into |out|.
+    void _decode_to(CppType* out) const {
+        if (_num_elements == 0) {
+            return;
+        }
+        const auto* data = reinterpret_cast<const uint8_t*>(_data.data);
+        uint64_t value = decode_fixed64_le(data + 4);
+        out[0] = static_cast<CppType>(value);
+        const uint8_t* block = data + DELTA_BINARY_PACKED_PAGE_HEADER_SIZE;
+        uint64_t deltas[DELTA_BINARY_PACKED_BLOCK_SIZE];
+        for (size_t start = 1; start < _num_elements; start += DELTA_BINARY_PACKED_BLOCK_SIZE) {
+            const size_t num_deltas = std::min<size_t>(_num_elements - start, DELTA_BINARY_PACKED_BLOCK_SIZE);
+            const uint64_t min_delta = decode_fixed64_le(block);
+            const int bit_width = block[8];
+            const size_t packed_bytes = BitUtil::Ceil(num_deltas * bit_width, 8);
+            block += DELTA_BINARY_PACKED_BLOCK_HEADER_SIZE;
+            if (bit_width == 0) {
+                for (size_t i = 0; i < num_deltas; i++) {
+                    value += min_delta;
+                    out[start + i] = static_cast<CppType>(value);
+                }
+            } else {
+                // The unrolled unpacking of the bit width, which is vectorized by the compiler.
+                BitPacking::UnpackValues(bit_width, block, packed_bytes, num_deltas, deltas);
+                for (size_t i = 0; i < num_deltas; i++) {
+                    value += min_delta + deltas[i];
+                    out[start + i] = static_cast<CppType>(value);
+                }
+            }
+            block += packed_bytes;
+        }
+    }
+
+    Slice _data;
+    bool _parsed;
+    size_t _num_elements;
+    size_t _cur_index;
+    std::vector<CppType> _decoded;
+};
+
+} // namespace segment_v2
+} // namespace starrocks
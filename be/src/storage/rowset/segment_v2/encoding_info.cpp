@@ -23,12 +23,15 @@
 
 #include <type_traits>
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
 #include "storage/olap_common.h"
+#include "storage/rowset/segment_v2/alp_page.h"
 #include "storage/rowset/segment_v2/binary_dict_page.h"
 #include "storage/rowset/segment_v2/binary_plain_page.h"
 #include "storage/rowset/segment_v2/binary_prefix_page.h"
 #include "storage/rowset/segment_v2/bitshuffle_page.h"
+#include "storage/rowset/segment_v2/delta_binary_packed_page.h"
 #include "storage/rowset/segment_v2/frame_of_reference_page.h"
 #include "storage/rowset/segment_v2/plain_page.h"
 #include "storage/rowset/segment_v2/rle_page.h"
@@ -131,6 +134,32 @@ struct TypeEncodingTraits<type, FOR_ENCODING, CppType,
     }
 };
 
+template <FieldType type, typename CppType>
+struct TypeEncodingTraits<type, DELTA_BINARY_PACKED, CppType,
+                          typename std::enable_if<std::is_integral<CppType>::value && sizeof(CppType) <= 8>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new DeltaBinaryPackedPageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts, PageDecoder** decoder) {
+        *decoder = new DeltaBinaryPackedPageDecoder<type>(data, opts);
+        return Status::OK();
+    }
+};
+
+template <FieldType type, typename CppType>
+struct TypeEncodingTraits<type, ALP_ENCODING, CppType,
+                          typename std::enable_if<std::is_floating_point<CppType>::value>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new AlpPageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts, PageDecoder** decoder) {
+        *decoder = new AlpPageDecoder<type>(data, opts);
+        return Status::OK();
+    }
+};
+
 template <FieldType type>
 struct TypeEncodingTraits<type, PREFIX_ENCODING, Slice> {
     static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
@@ -155,6 +184,12 @@ public:
     ~EncodingInfoResolver();
 
     EncodingTypePB get_default_encoding(FieldType type, bool optimize_value_seek) const {
+        if (!optimize_value_seek && config::enable_lightweight_encodings) {
+            auto it = _lightweight_encoding_map.find(delegate_type(type));
+            if (it != _lightweight_encoding_map.end()) {
+                return it->second;
+            }
+        }
         auto& encoding_map = optimize_value_seek ? _value_seek_encoding_map : _default_encoding_type_map;
         auto it = encoding_map.find(delegate_type(type));
         if (it != encoding_map.end()) {
@@ -166,6 +201,13 @@ public:
     Status get(FieldType data_type, EncodingTypePB encoding_type, const EncodingInfo** out);
 
 private:
+    // Not thread-safe
+    template <FieldType type, EncodingTypePB encoding_type>
+    void _add_lightweight_map() {
+        _add_map<type, encoding_type>();
+        _lightweight_encoding_map[type] = encoding_type;
+    }
+
     // Not thread-safe
     template <FieldType type, EncodingTypePB encoding_type, bool optimize_value_seek = false>
     void _add_map() {
@@ -191,6 +233,9 @@ private:
     // default encoding for each type which optimizes value seek
     std::unordered_map<FieldType, EncodingTypePB, std::hash<int>> _value_seek_encoding_map;
 
+    // default encoding for each type if config::enable_lightweight_encodings
+    std::unordered_map<FieldType, EncodingTypePB, std::hash<int>> _lightweight_encoding_map;
+
     std::unordered_map<std::pair<FieldType, EncodingTypePB>, EncodingInfo*, EncodingMapHash> _encoding_map;
 };
 
@@ -263,6 +308,17 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<OLAP_FIELD_TYPE_OBJECT, PLAIN_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_PERCENTILE, PLAIN_ENCODING>();
+
+    // Registered after the others, so that they are not the default encodings unless enabled.
+    _add_lightweight_map<OLAP_FIELD_TYPE_TINYINT, DELTA_BINARY_PACKED>();
+    _add_lightweight_map<OLAP_FIELD_TYPE_SMALLINT, DELTA_BINARY_PACKED>();
+    _add_lightweight_map<OLAP_FIELD_TYPE_INT, DELTA_BINARY_PACKED>();
+    _add_lightweight_map<OLAP_FIELD_TYPE_BIGINT, DELTA_BINARY_PACKED>();
+    _add_lightweight_map<OLAP_FIELD_TYPE_DATE_V2, DELTA_BINARY_PACKED>();
+    _add_lightweight_map<OLAP_FIELD_TYPE_DATETIME, DELTA_BINARY_PACKED>();
+    _add_lightweight_map<OLAP_FIELD_TYPE_TIMESTAMP, DELTA_BINARY_PACKED>();
+    _add_lightweight_map<OLAP_FIELD_TYPE_FLOAT, ALP_ENCODING>();
+    _add_lightweight_map<OLAP_FIELD_TYPE_DOUBLE, ALP_ENCODING>();
 }
 
 EncodingInfoResolver::~EncodingInfoResolver() {
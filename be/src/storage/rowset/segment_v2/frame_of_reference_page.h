@@ -21,7 +21,10 @@
 
 #pragma once
 
+#include <limits>
+
 #include "column/column.h"
+#include "column/datum.h"
 #include "storage/rowset/segment_v2/options.h"      // for PageBuilderOptions/PageDecoderOptions
 #include "storage/rowset/segment_v2/page_builder.h" // for PageBuilder
 #include "storage/rowset/segment_v2/page_decoder.h" // for PageDecoder
@@ -198,6 +201,48 @@ public:
         return Status::OK();
     }
 
+    Status read_by_ranges(const vectorized::SparseRange& range, vectorized::Column* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        RETURN_IF(range.empty(), Status::OK());
+        DCHECK_LE(range.end(), _num_elements);
+        const size_t ori_size = dst->size();
+        dst->resize(ori_size + range.span_size());
+        auto* p = reinterpret_cast<CppType*>(dst->mutable_raw_data()) + ori_size;
+        for (size_t i = 0; i < range.size(); i++) {
+            RETURN_IF_ERROR(seek_to_position_in_page(range[i].begin()));
+            // Only the frames overlapping with the range are unpacked.
+            bool r = _decoder.get_batch(p, range[i].span_size());
+            DCHECK(r);
+            p += range[i].span_size();
+            _cur_index += range[i].span_size();
+        }
+        return Status::OK();
+    }
+
+    Status filter_by_encoded_values(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                    vectorized::SparseRange* range) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if constexpr (!support_encoded_filter<Type>()) {
+            return Status::NotSupported("encoded filter is not supported by this type");
+        } else {
+            RETURN_IF(range->empty(), Status::OK());
+            DCHECK_LE(range->end(), _num_elements);
+            const uint32_t frame_size = _decoder.max_frame_size();
+            const uint32_t first_frame = range->begin() / frame_size;
+            const uint32_t last_frame = (range->end() - 1) / frame_size;
+            vectorized::SparseRange kept;
+            for (uint32_t i = first_frame; i <= last_frame; i++) {
+                CppType min = _decoder.frame_min_value(i);
+                CppType max = _frame_max_value(i, min);
+                if (encoded_values_may_satisfy(predicates, Type, vectorized::Datum(min), vectorized::Datum(max))) {
+                    kept.add(vectorized::Range(i * frame_size, i * frame_size + _decoder.frame_size(i)));
+                }
+            }
+            *range &= kept;
+            return Status::OK();
+        }
+    }
+
     size_t count() const override { return _num_elements; }
 
     size_t current_index() const override { return _cur_index; }
@@ -207,6 +252,29 @@ public:
 private:
     typedef typename TypeTraits<Type>::CppType CppType;
 
+    // The upper bound of the values of a frame, derived from its min value and its bit width.
+    CppType _frame_max_value(uint32_t frame_index, CppType min) const {
+        const __int128 type_max = std::numeric_limits<CppType>::max();
+        const uint8_t bit_width = _decoder.frame_bit_width(frame_index);
+        if (bit_width >= 64) {
+            return type_max;
+        }
+        __int128 max_delta = (static_cast<__int128>(1) << bit_width) - 1;
+        switch (_decoder.frame_storage_format(frame_index)) {
+        case 0:
+            // the deltas to the min value.
+            break;
+        case 1:
+            // the deltas to the previous values.
+            max_delta *= _decoder.frame_size(frame_index) - 1;
+            break;
+        default:
+            // the original values.
+            return type_max;
+        }
+        return static_cast<CppType>(std::min<__int128>(type_max, min + max_delta));
+    }
+
     bool _parsed;
     Slice _data;
     size_t _num_elements;
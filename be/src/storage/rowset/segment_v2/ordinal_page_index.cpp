@@ -85,6 +85,7 @@ Status OrdinalIndexReader::load(fs::BlockManager* block_mgr, const std::string&
     opts.stats = &tmp_stats;
     opts.use_page_cache = use_page_cache;
     opts.kept_in_memory = kept_in_memory;
+    opts.is_index_page = true;
 
     // read index page
     PageHandle page_handle;
@@ -0,0 +1,34 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/page_decoder.h"
+
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks::segment_v2 {
+
+bool encoded_values_may_satisfy(const std::vector<const vectorized::ColumnPredicate*>& predicates, FieldType type,
+                                const vectorized::Datum& min, const vectorized::Datum& max) {
+    for (const vectorized::ColumnPredicate* pred : predicates) {
+        if (pred->type_info()->type() != type) {
+            continue;
+        }
+        switch (pred->type()) {
+        case vectorized::PredicateType::kEQ:
+        case vectorized::PredicateType::kNE:
+        case vectorized::PredicateType::kGT:
+        case vectorized::PredicateType::kGE:
+        case vectorized::PredicateType::kLT:
+        case vectorized::PredicateType::kInList:
+        case vectorized::PredicateType::kNotInList:
+            if (!pred->zone_map_filter(min, max)) {
+                return false;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+} // namespace starrocks::segment_v2
@@ -25,10 +25,12 @@
 #include "gen_cpp/segment_v2.pb.h"
 #include "runtime/timestamp_value.h"
 #include "storage/column_block.h" // for ColumnBlockView
+#include "storage/vectorized/range.h"
 
 namespace starrocks::vectorized {
 class Column;
-}
+class ColumnPredicate;
+} // namespace starrocks::vectorized
 
 namespace starrocks {
 namespace segment_v2 {
@@ -95,6 +97,19 @@ public:
         return Status::NotSupported("vectorized not supported yet");
     }
 
+    // Fetch the values at the positions of |range| into |column|, the positions of |range| are relative to
+    // the start of this page. The decoder is positioned at the end of |range| on success.
+    // The decoders of fixed length types override this to skip the values out of |range| without copying them.
+    virtual Status read_by_ranges(const vectorized::SparseRange& range, vectorized::Column* column) {
+        for (size_t i = 0; i < range.size(); i++) {
+            RETURN_IF_ERROR(seek_to_position_in_page(range[i].begin()));
+            size_t n = range[i].span_size();
+            RETURN_IF_ERROR(next_batch(&n, column));
+            DCHECK_EQ(range[i].span_size(), n);
+        }
+        return Status::OK();
+    }
+
     // Return the number of elements in this page.
     virtual size_t count() const = 0;
 
@@ -108,6 +123,16 @@ public:
     // the codec algorithm then switched to plain encoding when the dictionary page is full.
     virtual EncodingTypePB encoding_type() const = 0;
 
+    // Remove the positions from |range| whose values can't satisfy |predicates|, judged by the encoded values
+    // as a whole, e.g, the frames of frame-of-reference pages or the runs of RLE pages, without decoding the
+    // values one by one. The positions of |range| are relative to the start of this page, and the remaining
+    // ones may or may not satisfy |predicates|. The position of this decoder is not changed.
+    // Return NotSupported if the values of this page can't be evaluated by the encoding.
+    virtual Status filter_by_encoded_values(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                            vectorized::SparseRange* range) {
+        return Status::NotSupported("filter_by_encoded_values() not supported");
+    }
+
     virtual Status next_dict_codes(size_t* n, vectorized::Column* dst) {
         return Status::NotSupported("next_dict_codes() not supported");
     }
@@ -118,5 +143,18 @@ private:
     DISALLOW_COPY_AND_ASSIGN(PageDecoder);
 };
 
+// Return true if the values of |type| in [min, max] may satisfy all of |predicates|. Only the comparisons of
+// |type| are evaluated, which are false for nulls, so that the values stored for the nulls are never
+// mistaken for the nulls. The other predicates are treated as satisfied.
+bool encoded_values_may_satisfy(const std::vector<const vectorized::ColumnPredicate*>& predicates, FieldType type,
+                                const vectorized::Datum& min, const vectorized::Datum& max);
+
+// The types whose values could be evaluated by the encoding.
+template <FieldType Type>
+constexpr bool support_encoded_filter() {
+    return Type == OLAP_FIELD_TYPE_TINYINT || Type == OLAP_FIELD_TYPE_SMALLINT || Type == OLAP_FIELD_TYPE_INT ||
+           Type == OLAP_FIELD_TYPE_BIGINT;
+}
+
 } // namespace segment_v2
 } // namespace starrocks
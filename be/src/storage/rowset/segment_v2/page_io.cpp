@@ -35,6 +35,7 @@
 #include "util/crc32c.h"
 #include "util/faststring.h"
 #include "util/runtime_profile.h"
+#include "util/starrocks_metrics.h"
 
 namespace starrocks {
 namespace segment_v2 {
@@ -118,7 +119,7 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     auto cache = StoragePageCache::instance();
     PageCacheHandle cache_handle;
     StoragePageCache::CacheKey cache_key(opts.rblock->path(), opts.page_pointer.offset);
-    if (opts.use_page_cache && cache->lookup(cache_key, &cache_handle)) {
+    if (opts.use_page_cache && cache->lookup(cache_key, &cache_handle, opts.is_index_page)) {
         // we find page in cache, use it
         *handle = PageHandle(std::move(cache_handle));
         opts.stats->cached_pages_num++;
@@ -144,9 +145,15 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     std::unique_ptr<char[]> page(new char[page_size + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE]);
     Slice page_slice(page.get(), page_size);
     {
-        SCOPED_RAW_TIMER(&opts.stats->io_ns);
-        RETURN_IF_ERROR(opts.rblock->read(opts.page_pointer.offset, page_slice));
+        int64_t io_ns = 0;
+        {
+            SCOPED_RAW_TIMER(&io_ns);
+            RETURN_IF_ERROR(opts.rblock->read(opts.page_pointer.offset, page_slice));
+        }
+        opts.stats->io_ns += io_ns;
+        opts.stats->io_count++;
         opts.stats->compressed_bytes_read += page_size;
+        StarRocksMetrics::instance()->page_read_latency_us.add(io_ns / 1000);
     }
 
     if (opts.verify_checksum) {
@@ -168,7 +175,12 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
 
     uint32_t body_size = page_slice.size - 4 - footer_size;
     if (body_size != footer->uncompressed_size()) { // need decompress body
-        if (opts.codec == nullptr) {
+        const BlockCompressionCodec* codec = opts.codec;
+        if (footer->has_compression()) {
+            // The page is compressed by its own codec rather than the codec of the column.
+            RETURN_IF_ERROR(get_block_compression_codec(footer->compression(), &codec));
+        }
+        if (codec == nullptr) {
             return Status::Corruption("Bad page: page is compressed but codec is NO_COMPRESSION");
         }
         SCOPED_RAW_TIMER(&opts.stats->decompress_ns);
@@ -179,7 +191,7 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         // decompress page body
         Slice compressed_body(page_slice.data, body_size);
         Slice decompressed_body(decompressed_page.get(), footer->uncompressed_size());
-        RETURN_IF_ERROR(opts.codec->decompress(compressed_body, &decompressed_body));
+        RETURN_IF_ERROR(codec->decompress(compressed_body, &decompressed_body));
         if (decompressed_body.size != footer->uncompressed_size()) {
             return Status::Corruption(
                     strings::Substitute("Bad page: record uncompressed size=$0 vs real decompressed size=$1",
@@ -198,7 +210,7 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
     if (opts.use_page_cache) {
         // insert this page into cache and return the cache handle
-        cache->insert(cache_key, page_slice, &cache_handle, opts.kept_in_memory);
+        cache->insert(cache_key, page_slice, &cache_handle, opts.kept_in_memory, opts.is_index_page);
         *handle = PageHandle(std::move(cache_handle));
     } else {
         *handle = PageHandle(page_slice);
@@ -58,6 +58,8 @@ struct PageReadOptions {
     // if true, use DURABLE CachePriority in page cache
     // currently used for in memory olap table
     bool kept_in_memory = false;
+    // whether the page is an index page, which is cached in the index pool of page cache
+    bool is_index_page = false;
 
     void sanity_check() const {
         CHECK_NOTNULL(rblock);
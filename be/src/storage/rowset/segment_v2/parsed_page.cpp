@@ -21,6 +21,8 @@
 
 #include "storage/rowset/segment_v2/parsed_page.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 #include "column/nullable_column.h"
@@ -182,6 +184,15 @@ public:
         return Status::OK();
     }
 
+    Status filter_by_encoded_values(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                    vectorized::SparseRange* range) override {
+        // The offsets of the non-null values in the data page differ from the offsets of the records.
+        if (_has_null) {
+            return Status::NotSupported("encoded filter is not supported by the page with nulls");
+        }
+        return _data_decoder->filter_by_encoded_values(predicates, range);
+    }
+
 private:
     friend Status parse_page_v1(std::unique_ptr<ParsedPage>* result, PageHandle handle, const Slice& body,
                                 const DataPageFooterPB& footer, const EncodingInfo* encoding,
@@ -210,12 +221,37 @@ public:
             auto nc = down_cast<vectorized::NullableColumn*>(column);
             RETURN_IF_ERROR(_data_decoder->next_batch(count, nc->data_column().get()));
             nc->null_column()->append_numbers(_null_flags.data() + _offset_in_page, *count);
-            nc->update_has_null();
+            nc->set_has_null(_has_null_in(_offset_in_page, *count));
         }
         _offset_in_page += *count;
         return Status::OK();
     }
 
+    Status read_by_ranges(vectorized::Column* column, const vectorized::SparseRange& range) override {
+        RETURN_IF(range.empty(), Status::OK());
+        if (_null_flags.size() == 0) {
+            RETURN_IF_ERROR(_data_decoder->read_by_ranges(range, column));
+        } else {
+            auto nc = down_cast<vectorized::NullableColumn*>(column);
+            RETURN_IF_ERROR(_data_decoder->read_by_ranges(range, nc->data_column().get()));
+            bool has_null = false;
+            for (size_t i = 0; i < range.size(); i++) {
+                (void)nc->null_column()->append_numbers(_null_flags.data() + range[i].begin(), range[i].span_size());
+                has_null |= _has_null_in(range[i].begin(), range[i].span_size());
+            }
+            nc->set_has_null(has_null);
+        }
+        _offset_in_page = range.end();
+        return Status::OK();
+    }
+
+    // The null records are filtered by their arbitrary values in the data page, which is fine because
+    // the null records never satisfy the comparison predicates.
+    Status filter_by_encoded_values(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                    vectorized::SparseRange* range) override {
+        return _data_decoder->filter_by_encoded_values(predicates, range);
+    }
+
     Status read(ColumnBlockView* block, size_t* count) override {
         DCHECK_EQ(_offset_in_page, _data_decoder->current_index());
         RETURN_IF_ERROR(_data_decoder->next_batch(count, block));
@@ -243,7 +279,7 @@ public:
             auto nc = down_cast<vectorized::NullableColumn*>(column);
             RETURN_IF_ERROR(_data_decoder->next_dict_codes(count, nc->data_column().get()));
             (void)nc->null_column()->append_numbers(_null_flags.data() + _offset_in_page, *count);
-            nc->update_has_null();
+            nc->set_has_null(_has_null_in(_offset_in_page, *count));
         }
         _offset_in_page += *count;
         return Status::OK();
@@ -254,7 +290,15 @@ private:
                                 const DataPageFooterPB& footer, const EncodingInfo* encoding,
                                 const PagePointer& page_pointer, uint32_t page_index);
 
+    // Only the null flags of the rows just read are checked, rather than the whole null column of the chunk, and
+    // the pages without any null are not checked at all.
+    bool _has_null_in(size_t offset, size_t count) const {
+        return _page_has_null && memchr(_null_flags.data() + offset, 1, count) != nullptr;
+    }
+
     faststring _null_flags;
+    // Whether any row of the page is null.
+    bool _page_has_null = false;
     PageHandle _page_handle;
 };
 
@@ -306,6 +350,7 @@ Status parse_page_v2(std::unique_ptr<ParsedPage>* result, PageHandle handle, con
             return Status::Corruption("bitshuffle decompress failed: " + bitshuffle_error_msg(r));
         }
         page->_null_flags.resize(elements);
+        page->_page_has_null = memchr(page->_null_flags.data(), 1, elements) != nullptr;
     }
 
     Slice data_slice(body.data, body.size - null_size);
@@ -329,9 +374,107 @@ Status parse_page_v2(std::unique_ptr<ParsedPage>* result, PageHandle handle, con
     return Status::OK();
 }
 
+class DecodedParsedPage : public ParsedPage {
+public:
+    explicit DecodedParsedPage(std::shared_ptr<const DecodedPage> decoded) : _decoded(std::move(decoded)) {}
+
+    EncodingTypePB encoding_type() const override { return _decoded->encoding; }
+
+    Status seek(ordinal_t offset) override {
+        _offset_in_page = offset;
+        return Status::OK();
+    }
+
+    Status read(vectorized::Column* column, size_t* count) override {
+        *count = std::min(*count, remaining());
+        _append(*_decoded->values, column, *count);
+        _offset_in_page += *count;
+        return Status::OK();
+    }
+
+    Status read(ColumnBlockView* block, size_t* count) override {
+        return Status::NotSupported("decoded page can't be read into ColumnBlockView");
+    }
+
+    Status read_dict_codes(vectorized::Column* column, size_t* count) override {
+        if (_decoded->dict_codes == nullptr) {
+            return Status::InternalError("dictionary codes of the decoded page are not decoded");
+        }
+        *count = std::min(*count, remaining());
+        _append(*_decoded->dict_codes, column, *count);
+        _offset_in_page += *count;
+        return Status::OK();
+    }
+
+private:
+    friend std::unique_ptr<ParsedPage> parse_decoded_page(std::shared_ptr<const DecodedPage> decoded,
+                                                          const PagePointer& page_pointer, uint32_t page_index);
+
+    void _append(const vectorized::Column& src, vectorized::Column* dst, size_t count) const {
+        if (src.is_nullable() && !dst->is_nullable()) {
+            // the nullable column has no nulls, like reading a page without null flags.
+            const auto& nullable_src = down_cast<const vectorized::NullableColumn&>(src);
+            DCHECK(!nullable_src.has_null());
+            dst->append(*nullable_src.data_column(), _offset_in_page, count);
+        } else {
+            dst->append(src, _offset_in_page, count);
+        }
+    }
+
+    std::shared_ptr<const DecodedPage> _decoded;
+};
+
+size_t DecodedPage::memory_usage() const {
+    return values->memory_usage() + (dict_codes != nullptr ? dict_codes->memory_usage() : 0);
+}
+
+Status decode_page(ParsedPage* page, vectorized::ColumnPtr values, vectorized::ColumnPtr dict_codes,
+                   std::shared_ptr<const DecodedPage>* result) {
+    DCHECK_EQ(0, page->offset());
+    auto decoded = std::make_shared<DecodedPage>();
+    decoded->first_ordinal = page->first_ordinal();
+    decoded->num_rows = page->num_rows();
+    decoded->corresponding_element_ordinal = page->corresponding_element_ordinal();
+    decoded->encoding = page->encoding_type();
+
+    size_t count = page->num_rows();
+    RETURN_IF_ERROR(page->read(values.get(), &count));
+    if (count != page->num_rows()) {
+        return Status::Corruption(strings::Substitute("decoded $0 of $1 rows", count, page->num_rows()));
+    }
+    decoded->values = std::move(values);
+    if (dict_codes != nullptr) {
+        DCHECK_EQ(DICT_ENCODING, page->encoding_type());
+        RETURN_IF_ERROR(page->seek(0));
+        count = page->num_rows();
+        RETURN_IF_ERROR(page->read_dict_codes(dict_codes.get(), &count));
+        if (count != page->num_rows()) {
+            return Status::Corruption(strings::Substitute("decoded $0 of $1 codes", count, page->num_rows()));
+        }
+        decoded->dict_codes = std::move(dict_codes);
+    }
+    *result = std::move(decoded);
+    return Status::OK();
+}
+
+std::unique_ptr<ParsedPage> parse_decoded_page(std::shared_ptr<const DecodedPage> decoded,
+                                               const PagePointer& page_pointer, uint32_t page_index) {
+    auto page = std::make_unique<DecodedParsedPage>(std::move(decoded));
+    page->_page_index = page_index;
+    page->_page_pointer = page_pointer;
+    page->_num_rows = page->_decoded->num_rows;
+    page->_first_ordinal = page->_decoded->first_ordinal;
+    page->_corresponding_element_ordinal = page->_decoded->corresponding_element_ordinal;
+    return page;
+}
+
 Status parse_page(std::unique_ptr<ParsedPage>* result, PageHandle handle, const Slice& body,
                   const DataPageFooterPB& footer, const EncodingInfo* encoding, const PagePointer& page_pointer,
                   uint32_t page_index) {
+    if (footer.has_encoding() && footer.encoding() != encoding->encoding()) {
+        // The page is encoded by its own encoding rather than the encoding of the column.
+        RETURN_IF_ERROR(EncodingInfo::get(encoding->type(), footer.encoding(), &encoding));
+    }
     uint32_t version = footer.has_format_version() ? footer.format_version() : 1;
     if (version == 1) {
         return parse_page_v1(result, std::move(handle), body, footer, encoding, page_pointer, page_index);
@@ -23,6 +23,7 @@
 
 #include <memory>
 
+#include "column/vectorized_fwd.h"
 #include "storage/rowset/segment_v2/common.h" // ordinal_t
 #include "storage/rowset/segment_v2/page_decoder.h"
 #include "storage/rowset/segment_v2/page_pointer.h"
@@ -32,10 +33,6 @@ class ColumnBlockView;
 class Slice;
 class Status;
 
-namespace vectorized {
-class Column;
-}
-
 namespace segment_v2 {
 
 class DataPageFooterPB;
@@ -74,7 +71,7 @@ public:
     size_t remaining() const { return _num_rows - _offset_in_page; }
 
     // Return the encoding type of this page.
-    EncodingTypePB encoding_type() const { return _data_decoder->encoding_type(); }
+    virtual EncodingTypePB encoding_type() const { return _data_decoder->encoding_type(); }
 
     // Set the page offset indicator to the specified position |offset|.
     // The |offset| is relative to first_ordinal(), and it should less than num_rows().
@@ -94,6 +91,29 @@ public:
     // On error, the value of |*count| is undefined.
     virtual Status read(ColumnBlockView* block, size_t* count) = 0;
 
+    // Read the records at the offsets of |range| from this page into the |column|, the offsets are
+    // relative to first_ordinal() and less than num_rows(). The records out of |range| are skipped
+    // without being copied if the page could do so.
+    // On success, `Status::OK` is returned, and the page offset is set to the end of |range|.
+    virtual Status read_by_ranges(vectorized::Column* column, const vectorized::SparseRange& range) {
+        for (size_t i = 0; i < range.size(); i++) {
+            RETURN_IF_ERROR(seek(range[i].begin()));
+            size_t count = range[i].span_size();
+            RETURN_IF_ERROR(read(column, &count));
+            DCHECK_EQ(range[i].span_size(), count);
+        }
+        return Status::OK();
+    }
+
+    // Remove the offsets from |range| whose records can't satisfy |predicates| by the encoded values,
+    // e.g. the min values of the frames or the values of the repeated runs, without decoding the records.
+    // The offsets are relative to first_ordinal(). The records kept still need to be evaluated one by one.
+    // The page offset is unchanged. Return `Status::NotSupported` if the page can't do so.
+    virtual Status filter_by_encoded_values(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                            vectorized::SparseRange* range) {
+        return Status::NotSupported("encoded filter is not supported by this page");
+    }
+
     // prerequisite: encoding_type() is `DICT_ENCODING`.
     // Attempts to read up to |*count| dictionary codes from this page into the |column|.
     // On success, `Status::OK` is returned, and the number of codes read will be updated to
@@ -124,5 +144,28 @@ Status parse_page(std::unique_ptr<ParsedPage>* result, PageHandle handle, const
                   const DataPageFooterPB& footer, const EncodingInfo* encoding, const PagePointer& page_pointer,
                   uint32_t page_index);
 
+// All the rows of a data page decoded into columns, which is immutable once it's created and could be shared.
+struct DecodedPage {
+    ordinal_t first_ordinal = 0;
+    uint64_t num_rows = 0;
+    ordinal_t corresponding_element_ordinal = 0;
+    EncodingTypePB encoding = UNKNOWN_ENCODING;
+    vectorized::ColumnPtr values;
+    // nullptr if the dictionary codes of the page are not decoded.
+    vectorized::ColumnPtr dict_codes;
+
+    size_t memory_usage() const;
+};
+
+// Decode all the rows of |page| into |values|, and into |dict_codes| too if it's not nullptr, which requires
+// the page is dictionary encoded. |page| is at the end after this.
+Status decode_page(ParsedPage* page, vectorized::ColumnPtr values, vectorized::ColumnPtr dict_codes,
+                   std::shared_ptr<const DecodedPage>* result);
+
+// Create a page which reads the rows from |decoded|. It doesn't have a data decoder, and it can't read into
+// ColumnBlockView.
+std::unique_ptr<ParsedPage> parse_decoded_page(std::shared_ptr<const DecodedPage> decoded,
+                                               const PagePointer& page_pointer, uint32_t page_index);
+
 } // namespace segment_v2
 } // namespace starrocks
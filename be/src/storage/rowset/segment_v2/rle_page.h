@@ -22,6 +22,7 @@
 #pragma once
 
 #include "column/column.h"
+#include "column/datum.h"
 #include "storage/rowset/segment_v2/options.h"
 #include "storage/rowset/segment_v2/page_builder.h"
 #include "storage/rowset/segment_v2/page_decoder.h"
@@ -136,6 +137,16 @@ private:
     typedef typename TypeTraits<Type>::CppType CppType;
     enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
 
+    // Decode the next |n| values into |data|, the runs of repeated values are filled without decoding
+    // them one by one. |dst| is truncated to |ori_size| if the page is corrupted.
+    Status _get_batch(CppType* data, size_t n, vectorized::Column* dst, size_t ori_size) {
+        if (PREDICT_FALSE(_rle_decoder.GetBatch(data, n) != n)) {
+            dst->resize(ori_size);
+            return Status::Corruption("RLE decode failed");
+        }
+        return Status::OK();
+    }
+
     PageBuilderOptions _options;
     size_t _count;
     bool _finished;
@@ -218,19 +229,69 @@ public:
             *n = 0;
             return Status::OK();
         }
-        CppType value{};
         *n = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
-        for (size_t i = 0; i < *n; i++) {
-            if (PREDICT_FALSE(!_rle_decoder.Get(&value))) {
-                return Status::Corruption("RLE decode failed");
-            }
-            [[maybe_unused]] int r = dst->append_numbers(&value, sizeof(value));
-            DCHECK_EQ(1, r);
-        }
+        const size_t ori_size = dst->size();
+        dst->resize_uninitialized(ori_size + *n);
+        auto* data = reinterpret_cast<CppType*>(dst->mutable_raw_data() + ori_size * SIZE_OF_TYPE);
+        RETURN_IF_ERROR(_get_batch(data, *n, dst, ori_size));
         _cur_index += *n;
         return Status::OK();
     }
 
+    Status read_by_ranges(const vectorized::SparseRange& range, vectorized::Column* dst) override {
+        DCHECK(_parsed);
+        RETURN_IF(range.empty(), Status::OK());
+        DCHECK_LE(range.end(), _num_elements);
+        const size_t ori_size = dst->size();
+        dst->resize_uninitialized(ori_size + range.span_size());
+        auto* data = reinterpret_cast<CppType*>(dst->mutable_raw_data() + ori_size * SIZE_OF_TYPE);
+        for (size_t i = 0; i < range.size(); i++) {
+            RETURN_IF_ERROR(seek_to_position_in_page(range[i].begin()));
+            RETURN_IF_ERROR(_get_batch(data, range[i].span_size(), dst, ori_size));
+            data += range[i].span_size();
+            _cur_index += range[i].span_size();
+        }
+        return Status::OK();
+    }
+
+    Status filter_by_encoded_values(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                    vectorized::SparseRange* range) override {
+        DCHECK(_parsed);
+        if constexpr (!support_encoded_filter<Type>()) {
+            return Status::NotSupported("encoded filter is not supported by this type");
+        } else {
+            RETURN_IF(range->empty(), Status::OK());
+            DCHECK_LE(range->end(), _num_elements);
+            // Walk the runs with another decoder, so that the position of this decoder is unchanged.
+            RleDecoder<CppType> decoder((uint8_t*)_data.data + RLE_PAGE_HEADER_SIZE,
+                                        _data.size - RLE_PAGE_HEADER_SIZE, _bit_width);
+            const rowid_t end = range->end();
+            vectorized::SparseRange kept;
+            rowid_t pos = 0;
+            while (pos < end) {
+                size_t n = decoder.repeated_count();
+                if (n > 0) {
+                    vectorized::Datum value(decoder.get_repeated_value(n));
+                    if (encoded_values_may_satisfy(predicates, Type, value, value)) {
+                        kept.add(vectorized::Range(pos, std::min<rowid_t>(end, pos + n)));
+                    }
+                } else {
+                    // The values of a literal run are not decoded, they are kept for the row-wise evaluation.
+                    n = decoder.literal_count();
+                    if (PREDICT_FALSE(n == 0)) {
+                        kept.add(vectorized::Range(pos, end));
+                        break;
+                    }
+                    decoder.skip_literal(n);
+                    kept.add(vectorized::Range(pos, std::min<rowid_t>(end, pos + n)));
+                }
+                pos += n;
+            }
+            *range &= kept;
+            return Status::OK();
+        }
+    }
+
     size_t count() const override { return _num_elements; }
 
     size_t current_index() const override { return _cur_index; }
@@ -241,6 +302,16 @@ private:
     typedef typename TypeTraits<Type>::CppType CppType;
     enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
 
+    // Decode the next |n| values into |data|, the runs of repeated values are filled without decoding
+    // them one by one. |dst| is truncated to |ori_size| if the page is corrupted.
+    Status _get_batch(CppType* data, size_t n, vectorized::Column* dst, size_t ori_size) {
+        if (PREDICT_FALSE(_rle_decoder.GetBatch(data, n) != n)) {
+            dst->resize(ori_size);
+            return Status::Corruption("RLE decode failed");
+        }
+        return Status::OK();
+    }
+
     Slice _data;
     PageDecoderOptions _options;
     bool _parsed;
@@ -23,9 +23,14 @@
 
 #include <memory>
 
+#include "column/binary_column.h"
+#include "column/chunk.h"
+#include "column/datum.h"
 #include "column/schema.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/mem_tracker.h"
 #include "storage/fs/fs_util.h"
 #include "storage/rowset/segment_v2/column_reader.h"
 #include "storage/rowset/segment_v2/empty_segment_iterator.h"
@@ -53,6 +58,18 @@ Status Segment::open(MemTracker* mem_tracker, fs::BlockManager* blk_mgr, std::st
     return Status::OK();
 }
 
+Status Segment::open(std::unique_ptr<MemTracker> mem_tracker, fs::BlockManager* blk_mgr, std::string filename,
+                     uint32_t segment_id, std::shared_ptr<const TabletSchema> tablet_schema,
+                     std::shared_ptr<Segment>* output) {
+    std::shared_ptr<Segment> segment(
+            new Segment(mem_tracker.get(), blk_mgr, std::move(filename), segment_id, tablet_schema.get()));
+    segment->_owned_mem_tracker = std::move(mem_tracker);
+    segment->_owned_tablet_schema = std::move(tablet_schema);
+    RETURN_IF_ERROR(segment->_open());
+    output->swap(segment);
+    return Status::OK();
+}
+
 Segment::Segment(MemTracker* mem_tracker, fs::BlockManager* blk_mgr, std::string fname, uint32_t segment_id,
                  const TabletSchema* tablet_schema)
         : _mem_tracker(mem_tracker),
@@ -63,7 +80,11 @@ Segment::Segment(MemTracker* mem_tracker, fs::BlockManager* blk_mgr, std::string
     _mem_tracker->consume(sizeof(Segment) + _fname.size());
 }
 
-Segment::~Segment() = default;
+Segment::~Segment() {
+    if (_owned_mem_tracker != nullptr) {
+        _owned_mem_tracker->release(_owned_mem_tracker->consumption());
+    }
+}
 
 Status Segment::_open() {
     RETURN_IF_ERROR(_parse_footer());
@@ -218,6 +239,7 @@ Status Segment::_load_index() {
         opts.codec = nullptr; // short key index page uses NO_COMPRESSION for now
         OlapReaderStatistics tmp_stats;
         opts.stats = &tmp_stats;
+        opts.is_index_page = true;
 
         Slice body;
         PageFooterPB footer;
@@ -235,6 +257,25 @@ Status Segment::_load_index() {
     });
 }
 
+int64_t Segment::mem_usage() const {
+    int64_t mem_usage = sizeof(Segment) + _fname.size() + _footer.SpaceUsedLong();
+    mem_usage += _column_readers.size() * sizeof(ColumnReader);
+    if (_load_index_once.has_called() && _load_index_once.stored_result().ok()) {
+        mem_usage += _sk_index_handle.mem_usage() + _sk_index_decoder->mem_usage();
+    }
+    return mem_usage;
+}
+
+Status Segment::warm_up() {
+    RETURN_IF_ERROR(_load_index());
+    for (const auto& reader : _column_readers) {
+        if (reader != nullptr) {
+            RETURN_IF_ERROR(reader->ensure_index_loaded(READER_QUERY));
+        }
+    }
+    return Status::OK();
+}
+
 Status Segment::_create_column_readers() {
     std::unordered_map<uint32_t, uint32_t> column_id_to_footer_ordinal;
     for (uint32_t ordinal = 0; ordinal < _footer.columns().size(); ++ordinal) {
@@ -259,6 +300,25 @@ Status Segment::_create_column_readers() {
                                              _fname, &reader));
         _column_readers[ordinal] = std::move(reader);
     }
+
+    // The rows of the row store column are serialized by the columns of the footer, which must be the same as the
+    // ones of the tablet schema to be deserialized.
+    if (_footer.has_row_store_column() && _footer.columns_size() == _tablet_schema->num_columns()) {
+        bool same_columns = true;
+        for (uint32_t ordinal = 0; ordinal < _tablet_schema->num_columns(); ++ordinal) {
+            const auto& column = _tablet_schema->column(ordinal);
+            const auto& column_pb = _footer.columns(ordinal);
+            same_columns &= column_pb.unique_id() == column.unique_id() && column_pb.type() == column.type();
+        }
+        if (same_columns) {
+            ColumnReaderOptions opts;
+            opts.block_mgr = _block_mgr;
+            opts.storage_format_version = _footer.version();
+            opts.kept_in_memory = _tablet_schema->is_in_memory();
+            RETURN_IF_ERROR(ColumnReader::create(_mem_tracker, opts, _footer.row_store_column(), _footer.num_rows(),
+                                                 _fname, &_row_store_reader));
+        }
+    }
     return Status::OK();
 }
 
@@ -305,6 +365,79 @@ Status Segment::new_column_iterator(uint32_t cid, ColumnIterator** iter) {
     return _column_readers[cid]->new_iterator(iter);
 }
 
+bool Segment::column_min_max(uint32_t cid, FieldType type, vectorized::Datum* min, vectorized::Datum* max) const {
+    if (cid >= _column_readers.size() || _column_readers[cid] == nullptr) {
+        return false;
+    }
+    const ColumnReader* reader = _column_readers[cid].get();
+    switch (type) {
+    case OLAP_FIELD_TYPE_BOOL:
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_DATE_V2:
+    case OLAP_FIELD_TYPE_TIMESTAMP:
+    case OLAP_FIELD_TYPE_DECIMAL32:
+    case OLAP_FIELD_TYPE_DECIMAL64:
+    case OLAP_FIELD_TYPE_DECIMAL128:
+        break;
+    default:
+        return false;
+    }
+    return reader->column_type() == type && reader->segment_zone_map_min_max(min, max);
+}
+
+Status Segment::read_rows(const std::vector<rowid_t>& rowids, vectorized::Chunk* chunk) {
+    DCHECK_EQ(_tablet_schema->num_columns(), chunk->num_columns());
+    if (rowids.empty()) {
+        return Status::OK();
+    }
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    RETURN_IF_ERROR(_block_mgr->open_block(_fname, &rblock));
+    OlapReaderStatistics stats;
+    ColumnIteratorOptions iter_opts;
+    iter_opts.stats = &stats;
+    iter_opts.use_page_cache = !config::disable_storage_page_cache;
+    iter_opts.rblock = rblock.get();
+
+    if (_row_store_reader != nullptr && !_needs_chunk_adapter) {
+        ColumnIterator* raw_iter = nullptr;
+        RETURN_IF_ERROR(_row_store_reader->new_iterator(&raw_iter));
+        std::unique_ptr<ColumnIterator> iter(raw_iter);
+        RETURN_IF_ERROR(iter->init(iter_opts));
+        auto rows = vectorized::BinaryColumn::create();
+        RETURN_IF_ERROR(iter->fetch_values_by_rowid(rowids.data(), rowids.size(), rows.get()));
+        for (size_t i = 0; i < rows->size(); i++) {
+            Slice row = rows->get_slice(i);
+            const auto* pos = reinterpret_cast<const uint8_t*>(row.data);
+            for (size_t cid = 0; cid < chunk->num_columns(); cid++) {
+                pos = chunk->get_column_by_index(cid)->deserialize_and_append(pos);
+            }
+            if (pos != reinterpret_cast<const uint8_t*>(row.data + row.size)) {
+                return Status::Corruption(
+                        Substitute("Bad segment file $0: bad row $1 in row store", _fname, rowids[i]));
+            }
+        }
+        return Status::OK();
+    }
+
+    for (size_t cid = 0; cid < chunk->num_columns(); cid++) {
+        ColumnIterator* raw_iter = nullptr;
+        RETURN_IF_ERROR(new_column_iterator(cid, &raw_iter));
+        std::unique_ptr<ColumnIterator> iter(raw_iter);
+        RETURN_IF_ERROR(iter->init(iter_opts));
+        vectorized::Column* column = chunk->get_column_by_index(cid).get();
+        for (rowid_t rowid : rowids) {
+            size_t n = 1;
+            RETURN_IF_ERROR(iter->seek_to_ordinal(rowid));
+            RETURN_IF_ERROR(iter->next_batch(&n, column));
+        }
+    }
+    return Status::OK();
+}
+
 Status Segment::new_bitmap_index_iterator(uint32_t cid, BitmapIndexIterator** iter) {
     if (_column_readers[cid] != nullptr && _column_readers[cid]->has_bitmap_index()) {
         return _column_readers[cid]->new_bitmap_index_iterator(iter);
@@ -312,4 +445,11 @@ Status Segment::new_bitmap_index_iterator(uint32_t cid, BitmapIndexIterator** it
     return Status::OK();
 }
 
+Status Segment::new_inverted_index_iterator(uint32_t cid, BitmapIndexIterator** iter) {
+    if (_column_readers[cid] != nullptr && _column_readers[cid]->has_inverted_index()) {
+        return _column_readers[cid]->new_inverted_index_iterator(iter);
+    }
+    return Status::OK();
+}
+
 } // namespace starrocks::segment_v2
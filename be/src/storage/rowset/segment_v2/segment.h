@@ -48,7 +48,9 @@ class BlockManager;
 }
 
 namespace vectorized {
+class Chunk;
 class ChunkIterator;
+class Datum;
 class Schema;
 class SegmentIterator;
 class SegmentReadOptions;
@@ -77,6 +79,12 @@ public:
     static Status open(MemTracker* mem_tracker, fs::BlockManager* blk_mgr, std::string filename, uint32_t segment_id,
                        const TabletSchema* tablet_schema, std::shared_ptr<Segment>* output);
 
+    // Open the segment owning |mem_tracker| and |tablet_schema|, so that it could outlive the rowset opening it,
+    // e.g. in the SegmentCache. |mem_tracker| is released when the segment is destroyed.
+    static Status open(std::unique_ptr<MemTracker> mem_tracker, fs::BlockManager* blk_mgr, std::string filename,
+                       uint32_t segment_id, std::shared_ptr<const TabletSchema> tablet_schema,
+                       std::shared_ptr<Segment>* output);
+
     ~Segment();
 
     Status new_iterator(const starrocks::Schema& schema, const StorageReadOptions& read_options,
@@ -93,8 +101,25 @@ public:
 
     Status new_column_iterator(uint32_t cid, ColumnIterator** iter);
 
+    // Get the min and max values of the |cid|-th column from the segment-level zone map, as the values of |type|.
+    // Return false if they are unknown, e.g. the column has nulls, is of another type in this segment, or is of a
+    // variable-length type, whose zone map may be truncated.
+    bool column_min_max(uint32_t cid, FieldType type, vectorized::Datum* min, vectorized::Datum* max) const;
+
     Status new_bitmap_index_iterator(uint32_t cid, BitmapIndexIterator** iter);
 
+    // |*iter| is left unchanged if the column has no inverted index.
+    Status new_inverted_index_iterator(uint32_t cid, BitmapIndexIterator** iter);
+
+    // Whether the whole rows are stored in a row store column, which is written if the tablet schema has_row_store(),
+    // and the columns are still the ones of the tablet schema.
+    bool has_row_store() const { return _row_store_reader != nullptr; }
+
+    // Append the rows of the ascending |rowids| to |chunk|, whose columns are the ones of the tablet schema in the
+    // storage format. The rows are read from the row store column if there is one, which costs a page read per row
+    // rather than one of every column.
+    Status read_rows(const std::vector<rowid_t>& rowids, vectorized::Chunk* chunk);
+
     size_t num_short_keys() const { return _tablet_schema->num_short_key_columns(); }
 
     uint32_t num_rows_per_block() const {
@@ -121,11 +146,20 @@ public:
         return _sk_index_decoder->num_items() - 1;
     }
 
+    // Load the short key index and the indexes of all the columns for queries, which are loaded lazily
+    // on the first read otherwise.
+    Status warm_up();
+
     // only used by UT
     const SegmentFooterPB& footer() const { return _footer; }
 
     const std::string& file_name() const { return _fname; }
 
+    const TabletSchema& tablet_schema() const { return *_tablet_schema; }
+
+    // An estimate of the memory of the footer, the column readers and the short key index if it's loaded.
+    int64_t mem_usage() const;
+
 private:
     DISALLOW_COPY_AND_ASSIGN(Segment);
     Segment(MemTracker* mem_tracker, fs::BlockManager* blk_mgr, std::string fname, uint32_t segment_id,
@@ -150,6 +184,9 @@ private:
     friend class vectorized::SegmentIterator;
 
     MemTracker* _mem_tracker = nullptr;
+    // the owners of |_mem_tracker| and |_tablet_schema| if the segment is opened with its own ones.
+    std::unique_ptr<MemTracker> _owned_mem_tracker;
+    std::shared_ptr<const TabletSchema> _owned_tablet_schema;
 
     fs::BlockManager* _block_mgr;
     std::string _fname;
@@ -162,6 +199,7 @@ private:
     // This means that this segment has no data for that column, which may be added
     // after this segment is generated.
     std::vector<std::unique_ptr<ColumnReader>> _column_readers;
+    std::unique_ptr<ColumnReader> _row_store_reader;
 
     // used to guarantee that short key index will be loaded at most once in a thread-safe way
     StarRocksCallOnce<Status> _load_index_once;
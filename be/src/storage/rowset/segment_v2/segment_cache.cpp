@@ -0,0 +1,81 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/segment_cache.h"
+
+#include "runtime/mem_tracker.h"
+#include "storage/rowset/segment_v2/segment.h"
+#include "storage/tablet_schema.h"
+#include "util/metrics.h"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks::segment_v2 {
+
+UIntGauge g_segment_cache_size(MetricUnit::BYTES);     // NOLINT
+UIntGauge g_segment_cache_lookups(MetricUnit::NOUNIT); // NOLINT
+UIntGauge g_segment_cache_hits(MetricUnit::NOUNIT);    // NOLINT
+
+[[maybe_unused]] static void update_segment_cache_size() {
+    SegmentCache::instance()->update_memory_usage_statistics();
+}
+
+SegmentCache* SegmentCache::_s_instance = nullptr;
+
+void SegmentCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+    if (_s_instance == nullptr && capacity > 0) {
+        _s_instance = new SegmentCache(mem_tracker, capacity);
+#ifndef BE_TEST
+        MetricRegistry* reg = StarRocksMetrics::instance()->metrics();
+        reg->register_hook("segment_cache_size_hook", update_segment_cache_size);
+        reg->register_metric("segment_cache_bytes", &g_segment_cache_size);
+        reg->register_metric("segment_cache_lookup_count", &g_segment_cache_lookups);
+        reg->register_metric("segment_cache_hit_count", &g_segment_cache_hits);
+#endif
+    }
+}
+
+void SegmentCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+SegmentCache::SegmentCache(MemTracker* mem_tracker, size_t capacity)
+        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {}
+
+Status SegmentCache::open(fs::BlockManager* blk_mgr, const std::string& file_name, uint32_t segment_id,
+                          const TabletSchema& tablet_schema, std::shared_ptr<Segment>* segment) {
+    auto* handle = _cache->lookup(file_name);
+    if (handle != nullptr) {
+        // the segment is kept alive by the returned pointer, so the cache entry could be released at once.
+        auto cached = *reinterpret_cast<std::shared_ptr<Segment>*>(_cache->value(handle));
+        _cache->release(handle);
+        if (cached->tablet_schema() == tablet_schema) {
+            *segment = std::move(cached);
+            return Status::OK();
+        }
+        // opened for another schema, e.g. the one before the tablet is dropped and created again.
+        _cache->erase(file_name);
+    }
+
+    RETURN_IF_ERROR(Segment::open(std::make_unique<MemTracker>(-1, "", _mem_tracker), blk_mgr, file_name,
+                                  segment_id, std::make_shared<const TabletSchema>(tablet_schema), segment));
+    auto deleter = [](const starrocks::CacheKey& key, void* value) {
+        delete reinterpret_cast<std::shared_ptr<Segment>*>(value);
+    };
+    size_t charge = (*segment)->mem_usage() + tablet_schema.mem_usage();
+    _cache->release(_cache->insert(file_name, new std::shared_ptr<Segment>(*segment), charge, deleter));
+    return Status::OK();
+}
+
+void SegmentCache::erase(const std::string& file_name) {
+    _cache->erase(file_name);
+}
+
+void SegmentCache::update_memory_usage_statistics() {
+    g_segment_cache_size.set_value(_cache->get_memory_usage());
+    g_segment_cache_lookups.set_value(_cache->get_lookup_count());
+    g_segment_cache_hits.set_value(_cache->get_hit_count());
+}
+
+} // namespace starrocks::segment_v2
@@ -0,0 +1,63 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "common/status.h"
+#include "storage/lru_cache.h"
+
+namespace starrocks {
+
+class MemTracker;
+class TabletSchema;
+
+namespace fs {
+class BlockManager;
+}
+
+namespace segment_v2 {
+
+class Segment;
+
+// SegmentCache caches the opened segments, i.e. their parsed footers and column readers, by their file names and
+// shared by all the rowsets, so a rowset opening the segments again, e.g. the next rowset object of the same files
+// after a reload, skips reading and parsing the footers. The cached segments own a copy of their tablet schema
+// and account their memory to the cache, so they never refer to a rowset released, and only hit the opens of the
+// same schema. A segment in use is pinned by its shared pointer, and the least recently used segments are dropped
+// by the cache once their charges exceed the capacity. The file descriptors are still cached by the BlockManager.
+//
+// This class is thread-safe.
+class SegmentCache {
+public:
+    // Create global instance of this class, do nothing if |capacity| is 0.
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+
+    static void release_global_cache();
+
+    // Return global instance, nullptr if the cache is disabled.
+    static SegmentCache* instance() { return _s_instance; }
+
+    SegmentCache(MemTracker* mem_tracker, size_t capacity);
+
+    // Return the cached segment of |file_name| for |tablet_schema|, or open it and cache it.
+    Status open(fs::BlockManager* blk_mgr, const std::string& file_name, uint32_t segment_id,
+                const TabletSchema& tablet_schema, std::shared_ptr<Segment>* segment);
+
+    // Drop the segment of |file_name|, e.g. once the file is removed.
+    void erase(const std::string& file_name);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+    void update_memory_usage_statistics();
+
+private:
+    static SegmentCache* _s_instance;
+
+    MemTracker* _mem_tracker;
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace segment_v2
+} // namespace starrocks
@@ -23,9 +23,11 @@
 
 #include <memory>
 
+#include "column/binary_column.h"
 #include "column/chunk.h"
 #include "column/datum_tuple.h"
 #include "column/nullable_column.h"
+#include "common/config.h"
 #include "common/logging.h" // LOG
 #include "env/env.h"        // Env
 #include "storage/fs/block_manager.h"
@@ -35,6 +37,7 @@
 #include "storage/rowset/segment_v2/page_io.h"
 #include "storage/schema.h"
 #include "storage/short_key_index.h"
+#include "storage/tablet_schema.h"
 #include "storage/vectorized/seek_tuple.h"
 #include "util/crc32c.h"
 #include "util/faststring.h"
@@ -72,19 +75,40 @@ void SegmentWriter::_init_column_meta(ColumnMetaPB* meta, uint32_t* column_id, c
 }
 
 Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))) {
-    uint32_t column_id = 0;
+    std::vector<uint32_t> column_indexes(_tablet_schema->num_columns());
+    for (uint32_t i = 0; i < column_indexes.size(); ++i) {
+        column_indexes[i] = i;
+    }
+    return _init_column_writers(column_indexes, true);
+}
+
+Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has_key) {
+    DCHECK(has_key || _index_builder != nullptr) << "the group of the key columns must be written first";
+    DCHECK(_column_writers.empty()) << "the previous group of columns is not finalized";
+    return _init_column_writers(column_indexes, has_key);
+}
+
+Status SegmentWriter::_init_column_writers(const std::vector<uint32_t>& column_indexes, bool has_key) {
     if (_opts.storage_format_version != 1 && _opts.storage_format_version != 2) {
         auto v = _opts.storage_format_version;
         return Status::InvalidArgument(strings::Substitute("Invalid storage_format_version $0", v));
     }
-    _column_writers.reserve(_tablet_schema->columns().size());
-    for (const auto& column : _tablet_schema->columns()) {
+    // The metas of all the columns are initialized by the first group, so that they are in the order of the schema.
+    if (_footer.columns_size() == 0) {
+        uint32_t column_id = 0;
+        for (const auto& column : _tablet_schema->columns()) {
+            _init_column_meta(_footer.add_columns(), &column_id, column);
+        }
+    }
+    _column_writers.reserve(column_indexes.size());
+    for (uint32_t column_index : column_indexes) {
+        const auto& column = _tablet_schema->column(column_index);
         ColumnWriterOptions opts;
         opts.page_format = (_opts.storage_format_version == 1) ? 1 : 2;
         opts.adaptive_page_format = (_opts.storage_format_version > 1);
-        opts.meta = _footer.add_columns();
-
-        _init_column_meta(opts.meta, &column_id, column);
+        opts.adaptive_encoding = config::enable_adaptive_encoding;
+        opts.zstd_dict_compression = config::enable_zstd_dict_compression;
+        opts.meta = _footer.mutable_columns(column_index);
 
         // now we create zone map for key columns
         // and not support zone map for array type.
@@ -96,6 +120,8 @@ Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))
         }
         opts.need_bloom_filter = column.is_bf_column();
         opts.need_bitmap_index = column.has_bitmap_index();
+        opts.need_ngram_bloom_filter = column.has_ngram_bf_index();
+        opts.need_inverted_index = column.has_inverted_index();
         if (column.type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
             if (opts.need_bloom_filter) {
                 return Status::NotSupported("Do not support bloom filter for array type");
@@ -110,12 +136,59 @@ Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))
         RETURN_IF_ERROR(writer->init());
         _column_writers.push_back(std::move(writer));
     }
-    _index_builder = std::make_unique<ShortKeyIndexBuilder>(_segment_id, _opts.num_rows_per_block);
+    _has_key = has_key;
+    _num_rows_written = 0;
+    if (has_key) {
+        _index_builder = std::make_unique<ShortKeyIndexBuilder>(_segment_id, _opts.num_rows_per_block);
+    }
+    if (has_key && column_indexes.size() == _tablet_schema->num_columns() && _tablet_schema->has_row_store()) {
+        RETURN_IF_ERROR(_init_row_store_writer());
+    }
     return Status::OK();
 }
 
+Status SegmentWriter::_init_row_store_writer() {
+    _row_store_column = std::make_unique<TabletColumn>(OLAP_FIELD_AGGREGATION_NONE, OLAP_FIELD_TYPE_VARCHAR, false);
+    uint32_t column_id = _tablet_schema->num_columns();
+    _init_column_meta(_footer.mutable_row_store_column(), &column_id, *_row_store_column);
+
+    ColumnWriterOptions opts;
+    opts.page_format = (_opts.storage_format_version == 1) ? 1 : 2;
+    opts.adaptive_page_format = (_opts.storage_format_version > 1);
+    opts.adaptive_encoding = config::enable_adaptive_encoding;
+    opts.zstd_dict_compression = config::enable_zstd_dict_compression;
+    opts.meta = _footer.mutable_row_store_column();
+    opts.need_zone_map = false;
+    RETURN_IF_ERROR(ColumnWriter::create(opts, _row_store_column.get(), _wblock.get(), &_row_store_writer));
+    return _row_store_writer->init();
+}
+
+Status SegmentWriter::_append_row_store(const vectorized::Chunk& chunk) {
+    auto rows = vectorized::BinaryColumn::create();
+    std::vector<uint8_t> buf;
+    for (size_t i = 0; i < chunk.num_rows(); i++) {
+        size_t size = 0;
+        for (const auto& column : chunk.columns()) {
+            size += column->serialize_size(i);
+        }
+        buf.resize(size);
+        uint8_t* pos = buf.data();
+        for (const auto& column : chunk.columns()) {
+            pos += column->serialize(i, pos);
+        }
+        DCHECK_EQ(buf.data() + size, pos);
+        rows->append(Slice(buf.data(), size));
+    }
+    return _row_store_writer->append(*rows);
+}
+
 template <typename RowType>
 Status SegmentWriter::append_row(const RowType& row) {
+    // The row store is only serialized from the chunks.
+    if (_row_store_writer != nullptr) {
+        _row_store_writer.reset();
+        _footer.clear_row_store_column();
+    }
     for (size_t cid = 0; cid < _column_writers.size(); ++cid) {
         auto cell = row.cell(cid);
         RETURN_IF_ERROR(_column_writers[cid]->append(cell));
@@ -129,6 +202,7 @@ Status SegmentWriter::append_row(const RowType& row) {
         _mem_tracker->consume(static_cast<int64_t>(estimate_segment_size()) - _mem_tracker->consumption());
     }
     ++_row_count;
+    ++_num_rows_written;
     return Status::OK();
 }
 
@@ -145,20 +219,48 @@ uint64_t SegmentWriter::estimate_segment_size() {
     for (auto& column_writer : _column_writers) {
         size += column_writer->estimate_buffer_size();
     }
+    if (_row_store_writer != nullptr) {
+        size += _row_store_writer->estimate_buffer_size();
+    }
     size += _index_builder->size();
     return size;
 }
 
 Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size) {
+    uint64_t short_key_index_size = 0;
+    RETURN_IF_ERROR(finalize_columns(index_size));
+    RETURN_IF_ERROR(finalize_footer(segment_file_size, &short_key_index_size));
+    *index_size += short_key_index_size;
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_columns(uint64_t* index_size) {
+    if (_num_rows_written != _row_count) {
+        return Status::InternalError(strings::Substitute("$0 rows are written to a group of columns, expect $1",
+                                                         _num_rows_written, _row_count));
+    }
     for (auto& column_writer : _column_writers) {
         RETURN_IF_ERROR(column_writer->finish());
     }
+    if (_row_store_writer != nullptr) {
+        RETURN_IF_ERROR(_row_store_writer->finish());
+    }
     RETURN_IF_ERROR(_write_data());
     uint64_t index_offset = _wblock->bytes_appended();
     RETURN_IF_ERROR(_write_ordinal_index());
     RETURN_IF_ERROR(_write_zone_map());
     RETURN_IF_ERROR(_write_bitmap_index());
     RETURN_IF_ERROR(_write_bloom_filter_index());
+    *index_size = _wblock->bytes_appended() - index_offset;
+    _column_writers.clear();
+    _row_store_writer.reset();
+    _mem_tracker->consume(static_cast<int64_t>(estimate_segment_size()) - _mem_tracker->consumption());
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_footer(uint64_t* segment_file_size, uint64_t* index_size) {
+    DCHECK(_column_writers.empty()) << "the last group of columns is not finalized";
+    uint64_t index_offset = _wblock->bytes_appended();
     RETURN_IF_ERROR(_write_short_key_index());
     *index_size = _wblock->bytes_appended() - index_offset;
     RETURN_IF_ERROR(_write_footer());
@@ -172,6 +274,9 @@ Status SegmentWriter::_write_data() {
     for (auto& column_writer : _column_writers) {
         RETURN_IF_ERROR(column_writer->write_data());
     }
+    if (_row_store_writer != nullptr) {
+        RETURN_IF_ERROR(_row_store_writer->write_data());
+    }
     return Status::OK();
 }
 
@@ -180,6 +285,9 @@ Status SegmentWriter::_write_ordinal_index() {
     for (auto& column_writer : _column_writers) {
         RETURN_IF_ERROR(column_writer->write_ordinal_index());
     }
+    if (_row_store_writer != nullptr) {
+        RETURN_IF_ERROR(_row_store_writer->write_ordinal_index());
+    }
     return Status::OK();
 }
 
@@ -250,8 +358,12 @@ Status SegmentWriter::append_chunk(const vectorized::Chunk& chunk) {
         const vectorized::Column* col = chunk.get_column_by_index(i).get();
         RETURN_IF_ERROR(_column_writers[i]->append(*col));
     }
+    if (_row_store_writer != nullptr) {
+        RETURN_IF_ERROR(_append_row_store(chunk));
+    }
 
-    for (size_t i = 0; i < chunk.num_rows(); i++) {
+    // Only the group of the key columns builds the short key index.
+    for (size_t i = 0; _has_key && i < chunk.num_rows(); i++) {
         // At the begin of one block, so add a short key index entry
         if ((_row_count % _opts.num_rows_per_block) == 0) {
             size_t keys = _tablet_schema->num_short_key_columns();
@@ -261,6 +373,7 @@ Status SegmentWriter::append_chunk(const vectorized::Chunk& chunk) {
         }
         ++_row_count;
     }
+    _num_rows_written += chunk.num_rows();
     _mem_tracker->consume(static_cast<int64_t>(estimate_segment_size()) - _mem_tracker->consumption());
     return Status::OK();
 }
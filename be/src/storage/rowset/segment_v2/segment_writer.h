@@ -71,6 +71,11 @@ public:
 
     Status init(uint32_t write_mbytes_per_sec);
 
+    // Used by vertical compaction, which writes the columns of a segment group by group, only the columns of
+    // |column_indexes| are written by the following appends. The group that |has_key| must be the first group,
+    // which builds the short key index and decides the number of rows of the segment.
+    Status init(const std::vector<uint32_t>& column_indexes, bool has_key);
+
     template <typename RowType>
     Status append_row(const RowType& row);
 
@@ -78,10 +83,20 @@ public:
 
     uint64_t estimate_segment_size();
 
-    uint32_t num_rows_written() const { return _row_count; }
+    // The number of the rows written to the current group of columns.
+    uint32_t num_rows_written() const { return _num_rows_written; }
+
+    // The number of the rows of the segment.
+    uint32_t num_rows() const { return _row_count; }
 
     Status finalize(uint64_t* segment_file_size, uint64_t* index_size);
 
+    // Write the data and the indexes of the current group of columns, and release their writers.
+    Status finalize_columns(uint64_t* index_size);
+
+    // Write the short key index and the footer after all the groups of columns are finalized.
+    Status finalize_footer(uint64_t* segment_file_size, uint64_t* index_size);
+
     uint32_t segment_id() const { return _segment_id; }
 
 private:
@@ -94,6 +109,9 @@ private:
     Status _write_footer();
     Status _write_raw_data(const std::vector<Slice>& slices);
     void _init_column_meta(ColumnMetaPB* meta, uint32_t* column_id, const TabletColumn& column);
+    Status _init_column_writers(const std::vector<uint32_t>& column_indexes, bool has_key);
+    Status _init_row_store_writer();
+    Status _append_row_store(const vectorized::Chunk& chunk);
 
     std::unique_ptr<MemTracker> _mem_tracker = nullptr;
     uint32_t _segment_id;
@@ -105,7 +123,12 @@ private:
     SegmentFooterPB _footer;
     std::unique_ptr<ShortKeyIndexBuilder> _index_builder;
     std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
+    // Write the whole rows if the tablet schema has a row store, only when all the columns are written at once.
+    std::unique_ptr<TabletColumn> _row_store_column;
+    std::unique_ptr<ColumnWriter> _row_store_writer;
     uint32_t _row_count = 0;
+    uint32_t _num_rows_written = 0;
+    bool _has_key = true;
 };
 
 } // namespace segment_v2
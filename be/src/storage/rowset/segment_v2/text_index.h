@@ -0,0 +1,56 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "storage/rowset/segment_v2/bloom_filter.h"
+#include "util/slice.h"
+
+namespace starrocks {
+namespace segment_v2 {
+
+// The number of the bytes of an n-gram of the n-gram bloom filter index. The substrings shorter than it can not be
+// filtered by the index.
+static constexpr size_t kDefaultNGramSize = 3;
+
+// Call |f| with every substring of |n| bytes of |value|. The values shorter than |n| have no n-gram.
+template <typename F>
+inline void for_each_ngram(const Slice& value, size_t n, F&& f) {
+    for (size_t i = 0; i + n <= value.size; i++) {
+        f(Slice(value.data + i, n));
+    }
+}
+
+// The hash of an n-gram added into and tested against the bloom filter, i.e. BloomFilter::hash().
+inline uint64_t ngram_hash(const Slice& gram) {
+    return BloomFilter::murmur3_hash(gram.data, gram.size);
+}
+
+// A token byte is an ASCII letter, digit or underscore, or a byte of a multi-byte UTF-8 character, so that the
+// words of the non-ASCII languages are kept as a whole.
+inline bool is_token_byte(uint8_t c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c >= 0x80;
+}
+
+// Call |f| with every token of |value|, which is a maximal run of the token bytes. The tokens are case-sensitive.
+template <typename F>
+inline void for_each_token(const Slice& value, F&& f) {
+    size_t i = 0;
+    while (i < value.size) {
+        while (i < value.size && !is_token_byte(static_cast<uint8_t>(value.data[i]))) {
+            i++;
+        }
+        size_t start = i;
+        while (i < value.size && is_token_byte(static_cast<uint8_t>(value.data[i]))) {
+            i++;
+        }
+        if (i > start) {
+            f(Slice(value.data + start, i - start));
+        }
+    }
+}
+
+} // namespace segment_v2
+} // namespace starrocks
@@ -0,0 +1,141 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/text_index_writer.h"
+
+#include <cstring>
+
+#include "storage/fs/block_manager.h"
+#include "storage/rowset/segment_v2/encoding_info.h"
+#include "storage/rowset/segment_v2/indexed_column_writer.h"
+#include "storage/rowset/segment_v2/text_index.h"
+#include "storage/types.h"
+#include "util/faststring.h"
+
+namespace starrocks {
+namespace segment_v2 {
+
+void NGramBloomFilterIndexWriter::add_values(const void* values, size_t count) {
+    const auto* v = reinterpret_cast<const Slice*>(values);
+    for (size_t i = 0; i < count; ++i) {
+        for_each_ngram(v[i], _gram_size, [this](const Slice& gram) { _hashes.insert(ngram_hash(gram)); });
+    }
+}
+
+Status NGramBloomFilterIndexWriter::flush() {
+    std::unique_ptr<BloomFilter> bf;
+    RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+    RETURN_IF_ERROR(bf->init(_hashes.size(), _bf_options.fpp, _bf_options.strategy));
+    bf->set_has_null(_has_null);
+    for (uint64_t hash : _hashes) {
+        bf->add_hash(hash);
+    }
+    _bf_buffer_size += bf->size();
+    _bfs.push_back(std::move(bf));
+    _hashes.clear();
+    _has_null = false;
+    return Status::OK();
+}
+
+Status NGramBloomFilterIndexWriter::finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta) {
+    if (!_hashes.empty()) {
+        RETURN_IF_ERROR(flush());
+    }
+    index_meta->set_type(NGRAM_BLOOM_FILTER_INDEX);
+    NGramBloomFilterIndexPB* ngram_meta = index_meta->mutable_ngram_bloom_filter_index();
+    ngram_meta->set_gram_size(_gram_size);
+    BloomFilterIndexPB* meta = ngram_meta->mutable_bloom_filter();
+    meta->set_hash_strategy(_bf_options.strategy);
+    meta->set_algorithm(BLOCK_BLOOM_FILTER);
+
+    // write bloom filters, one for every data page
+    TypeInfoPtr bf_typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
+    IndexedColumnWriterOptions options;
+    options.write_ordinal_index = true;
+    options.write_value_index = false;
+    options.encoding = PLAIN_ENCODING;
+    IndexedColumnWriter bf_writer(options, bf_typeinfo, wblock);
+    RETURN_IF_ERROR(bf_writer.init());
+    for (auto& bf : _bfs) {
+        Slice data(bf->data(), bf->size());
+        RETURN_IF_ERROR(bf_writer.add(&data));
+    }
+    return bf_writer.finish(meta->mutable_bloom_filter());
+}
+
+void InvertedIndexWriter::add_values(const void* values, size_t count) {
+    const auto* v = reinterpret_cast<const Slice*>(values);
+    for (size_t i = 0; i < count; ++i) {
+        for_each_token(v[i], [this](const Slice& token) { _add_token(token); });
+        _rid++;
+    }
+}
+
+void InvertedIndexWriter::_add_token(const Slice& token) {
+    auto it = _postings.find(token);
+    uint64_t old_size = 0;
+    if (it != _postings.end()) {
+        old_size = it->second.getSizeInBytes(false);
+        it->second.add(_rid);
+    } else {
+        auto* data = reinterpret_cast<char*>(_pool.allocate(token.size));
+        memcpy(data, token.data, token.size);
+        it = _postings.emplace(Slice(data, token.size), Roaring::bitmapOf(1, _rid)).first;
+    }
+    _posting_size += it->second.getSizeInBytes(false) - old_size;
+}
+
+Status InvertedIndexWriter::finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta) {
+    index_meta->set_type(INVERTED_INDEX);
+    BitmapIndexPB* meta = index_meta->mutable_inverted_index();
+    meta->set_bitmap_type(BitmapIndexPB::ROARING_BITMAP);
+    meta->set_has_null(!_null_bitmap.isEmpty());
+
+    { // write the dictionary of the tokens
+        TypeInfoPtr token_typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = false;
+        options.write_value_index = true;
+        options.encoding = EncodingInfo::get_default_encoding(OLAP_FIELD_TYPE_VARCHAR, true);
+        options.compression = CompressionTypePB::LZ4_FRAME;
+
+        IndexedColumnWriter dict_column_writer(options, token_typeinfo, wblock);
+        RETURN_IF_ERROR(dict_column_writer.init());
+        for (auto const& it : _postings) {
+            RETURN_IF_ERROR(dict_column_writer.add(&(it.first)));
+        }
+        RETURN_IF_ERROR(dict_column_writer.finish(meta->mutable_dict_column()));
+    }
+    { // write the posting lists, and the null bitmap at last
+        std::vector<Roaring*> bitmaps;
+        for (auto& it : _postings) {
+            bitmaps.push_back(&(it.second));
+        }
+        if (!_null_bitmap.isEmpty()) {
+            bitmaps.push_back(&_null_bitmap);
+        }
+
+        TypeInfoPtr bitmap_typeinfo = get_type_info(OLAP_FIELD_TYPE_OBJECT);
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = true;
+        options.write_value_index = false;
+        options.encoding = EncodingInfo::get_default_encoding(bitmap_typeinfo->type(), false);
+        // the bitmaps are compressed already
+        options.compression = NO_COMPRESSION;
+
+        IndexedColumnWriter bitmap_column_writer(options, bitmap_typeinfo, wblock);
+        RETURN_IF_ERROR(bitmap_column_writer.init());
+        faststring buf;
+        for (auto* bitmap : bitmaps) {
+            bitmap->runOptimize();
+            buf.resize(bitmap->getSizeInBytes(false));
+            bitmap->write(reinterpret_cast<char*>(buf.data()), false);
+            Slice buf_slice(buf);
+            RETURN_IF_ERROR(bitmap_column_writer.add(&buf_slice));
+        }
+        RETURN_IF_ERROR(bitmap_column_writer.finish(meta->mutable_bitmap_column()));
+    }
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace starrocks
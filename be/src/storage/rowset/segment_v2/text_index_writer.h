@@ -0,0 +1,98 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <roaring/roaring.hh>
+#include <unordered_set>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "gutil/macros.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+#include "storage/rowset/segment_v2/bloom_filter.h"
+#include "storage/rowset/segment_v2/common.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+namespace fs {
+class WritableBlock;
+}
+
+namespace segment_v2 {
+
+// NGramBloomFilterIndexWriter builds a bloom filter of the n-grams of the values by every data page, like the
+// bloom filter index, so that the pages which can not contain a substring, e.g. the one of `LIKE '%error%'`, are
+// skipped without being read.
+class NGramBloomFilterIndexWriter {
+public:
+    NGramBloomFilterIndexWriter(const BloomFilterOptions& bf_options, size_t gram_size)
+            : _bf_options(bf_options), _gram_size(gram_size) {}
+
+    // |values| are the Slices of a CHAR or VARCHAR column.
+    void add_values(const void* values, size_t count);
+
+    void add_nulls(uint32_t count) { _has_null |= (count > 0); }
+
+    // Build the bloom filter of the current page.
+    Status flush();
+
+    Status finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta);
+
+    uint64_t size() const { return _bf_buffer_size + _hashes.size() * sizeof(uint64_t); }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(NGramBloomFilterIndexWriter);
+
+    BloomFilterOptions _bf_options;
+    const size_t _gram_size;
+    bool _has_null = false;
+    uint64_t _bf_buffer_size = 0;
+    // the distinct hashes of the n-grams of the current page
+    std::unordered_set<uint64_t> _hashes;
+    std::vector<std::unique_ptr<BloomFilter>> _bfs;
+};
+
+// InvertedIndexWriter builds the posting list of every token of the values, i.e. the tokens are the dictionary of a
+// bitmap index and the row ids of the values containing a token are its bitmap. It is read by BitmapIndexReader.
+class InvertedIndexWriter {
+public:
+    InvertedIndexWriter() : _pool(&_tracker) {}
+
+    // |values| are the Slices of a CHAR or VARCHAR column.
+    void add_values(const void* values, size_t count);
+
+    void add_nulls(uint32_t count) {
+        _null_bitmap.addRange(_rid, _rid + count);
+        _rid += count;
+    }
+
+    Status finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta);
+
+    uint64_t size() const {
+        return _null_bitmap.getSizeInBytes(false) + _posting_size + _postings.size() * sizeof(Slice) +
+               _pool.total_allocated_bytes();
+    }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(InvertedIndexWriter);
+
+    void _add_token(const Slice& token);
+
+    rowid_t _rid = 0;
+    uint64_t _posting_size = 0;
+    Roaring _null_bitmap;
+    // token to the row ids of the values containing it
+    std::map<Slice, Roaring, Slice::Comparator> _postings;
+    MemTracker _tracker;
+    MemPool _pool;
+};
+
+} // namespace segment_v2
+} // namespace starrocks
@@ -0,0 +1,53 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/vectorized/delete_bitmap_cache.h"
+
+#include "storage/del_vector.h"
+
+namespace starrocks::vectorized {
+
+DeleteBitmapCache* DeleteBitmapCache::_s_instance = nullptr;
+
+void DeleteBitmapCache::create_global_cache(size_t capacity) {
+    if (_s_instance == nullptr && capacity > 0) {
+        _s_instance = new DeleteBitmapCache(capacity);
+    }
+}
+
+void DeleteBitmapCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+DeleteBitmapCache::DeleteBitmapCache(size_t capacity) : _cache(new_lru_cache(capacity)) {}
+
+std::string DeleteBitmapCache::make_key(const std::string& segment_file, int64_t delete_version) {
+    std::string key = segment_file;
+    key.push_back('\0');
+    key.append(std::to_string(delete_version));
+    return key;
+}
+
+std::shared_ptr<DelVector> DeleteBitmapCache::lookup(const std::string& key) {
+    auto* handle = _cache->lookup(key);
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    // the bitmap is kept alive by the returned pointer, so the cache entry could be released at once.
+    auto del_vec = *reinterpret_cast<std::shared_ptr<DelVector>*>(_cache->value(handle));
+    _cache->release(handle);
+    return del_vec;
+}
+
+void DeleteBitmapCache::insert(const std::string& key, std::shared_ptr<DelVector> del_vec) {
+    auto deleter = [](const starrocks::CacheKey& key, void* value) {
+        delete reinterpret_cast<std::shared_ptr<DelVector>*>(value);
+    };
+    size_t charge = key.size() + del_vec->memory_usage();
+    auto* value = new std::shared_ptr<DelVector>(std::move(del_vec));
+    _cache->release(_cache->insert(key, value, charge, deleter));
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,54 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "storage/lru_cache.h"
+
+namespace starrocks {
+
+class DelVector;
+
+namespace vectorized {
+
+// DeleteBitmapCache caches the rows of the segments deleted by the delete predicates of the duplicate and aggregate
+// key tables, as the DelVectors of the primary key tables, so the reads of a segment after the first one filter
+// the deleted rows by a bitmap rather than evaluating all the delete predicates on each row.
+//
+// The rows deleted from a segment only depend on the delete predicates newer than its rowset, which are all the
+// ones read up to the latest of them, so a bitmap is identified by the segment file and the version of the latest
+// delete predicate. A new delete creates a new version and never hits the stale bitmaps, which are evicted once
+// their charges exceed the capacity.
+//
+// This class is thread-safe.
+class DeleteBitmapCache {
+public:
+    // Create global instance of this class, do nothing if |capacity| is 0.
+    static void create_global_cache(size_t capacity);
+
+    static void release_global_cache();
+
+    // Return global instance, nullptr if the cache is disabled.
+    static DeleteBitmapCache* instance() { return _s_instance; }
+
+    explicit DeleteBitmapCache(size_t capacity);
+
+    static std::string make_key(const std::string& segment_file, int64_t delete_version);
+
+    // Return nullptr if the bitmap of |key| isn't cached.
+    std::shared_ptr<DelVector> lookup(const std::string& key);
+
+    void insert(const std::string& key, std::shared_ptr<DelVector> del_vec);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+private:
+    static DeleteBitmapCache* _s_instance;
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace vectorized
+} // namespace starrocks
@@ -4,8 +4,11 @@
 
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "column/datum.h"
+
 #include "storage/fs/fs_util.h"
 #include "storage/olap_common.h"
 #include "storage/vectorized/seek_range.h"
@@ -24,6 +27,8 @@ namespace starrocks::vectorized {
 
 class ColumnPredicate;
 class DeletePredicates;
+class DisjunctivePredicates;
+class LatePredicates;
 class Schema;
 
 class RowsetReadOptions {
@@ -38,6 +43,7 @@ public:
     std::vector<SeekRange> ranges;
 
     std::unordered_map<ColumnId, PredicateList> predicates;
+    LatePredicates* late_predicates = nullptr;
 
     // whether rowset should return rows in sorted order.
     bool sorted = true;
@@ -48,6 +54,9 @@ public:
 
     const DeletePredicates* delete_predicates = nullptr;
 
+    // See `SegmentReadOptions::or_predicates`.
+    const std::vector<DisjunctivePredicates>* or_predicates = nullptr;
+
     const TabletSchema* tablet_schema = nullptr;
 
     bool is_primary_keys = false;
@@ -58,6 +67,16 @@ public:
     starrocks::RuntimeState* runtime_state = nullptr;
     starrocks::RuntimeProfile* profile = nullptr;
     bool use_page_cache = false;
+    // See `ReaderParams::aggregate_by_metadata`.
+    bool aggregate_by_metadata = false;
+
+    // If not null, get_segment_iterators() appends the min and max values of the first key column of the rows of
+    // each iterator it creates, or two null datums if they are unknown. See new_merge_iterator() with key ranges.
+    std::vector<std::pair<Datum, Datum>>* key_ranges = nullptr;
+
+    // Only read the segments with ordinals in [begin_segment, end_segment) of the rowset.
+    uint32_t begin_segment = 0;
+    uint32_t end_segment = UINT32_MAX;
 };
 
 } // namespace starrocks::vectorized
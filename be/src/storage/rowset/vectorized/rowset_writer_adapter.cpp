@@ -55,8 +55,12 @@ OLAPStatus RowsetWriterAdapter::add_chunk(const vectorized::Chunk& chunk) {
 }
 
 OLAPStatus RowsetWriterAdapter::flush_chunk(const vectorized::Chunk& chunk) {
-    if (_chunk_converter == nullptr) {
-        RETURN_NOT_OK(_init_chunk_converter());
+    {
+        // flush_chunk() may be called in parallel.
+        std::lock_guard l(_chunk_converter_lock);
+        if (_chunk_converter == nullptr) {
+            RETURN_NOT_OK(_init_chunk_converter());
+        }
     }
     return _writer->flush_chunk(*_chunk_converter->copy_convert(chunk));
 }
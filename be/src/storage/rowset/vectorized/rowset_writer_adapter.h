@@ -3,6 +3,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #include "storage/row_cursor.h"
 #include "storage/rowset/rowset_writer.h"
@@ -66,6 +67,7 @@ private:
     std::unique_ptr<TabletSchema> _out_schema;
     std::unique_ptr<RowsetWriter> _writer;
     std::unique_ptr<RowConverter> _row_converter;
+    std::mutex _chunk_converter_lock;
     std::unique_ptr<ChunkConverter> _chunk_converter;
     std::unique_ptr<RowCursor> _row;
 
@@ -2,7 +2,9 @@
 
 #include "storage/rowset/vectorized/segment_iterator.h"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 
 #include "butil/containers/flat_map.h"
 #include "column/chunk.h"
@@ -10,6 +12,7 @@
 #include "common/config.h"
 #include "common/status.h"
 #include "gutil/stl_util.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/current_mem_tracker.h"
 #include "simd/simd.h"
 #include "storage/column_predicate.h"
@@ -21,6 +24,7 @@
 #include "storage/rowset/segment_v2/common.h"
 #include "storage/rowset/segment_v2/row_ranges.h"
 #include "storage/rowset/segment_v2/segment.h"
+#include "storage/rowset/vectorized/delete_bitmap_cache.h"
 #include "storage/rowset/vectorized/rowid_column_iterator.h"
 #include "storage/rowset/vectorized/segment_options.h"
 #include "storage/storage_engine.h"
@@ -30,6 +34,7 @@
 #include "storage/vectorized/chunk_iterator.h"
 #include "storage/vectorized/column_or_predicate.h"
 #include "storage/vectorized/column_predicate.h"
+#include "storage/vectorized/late_predicates.h"
 #include "storage/vectorized/projection_iterator.h"
 #include "storage/vectorized/range.h"
 #include "storage/vectorized/roaring2range.h"
@@ -39,6 +44,7 @@ namespace starrocks::vectorized {
 
 using segment_v2::BitmapIndexIterator;
 using segment_v2::ColumnIterator;
+using segment_v2::ColumnReader;
 using segment_v2::ColumnIteratorOptions;
 using segment_v2::rowid_t;
 using segment_v2::RowRanges;
@@ -89,6 +95,10 @@ public:
         return _col_iter->fetch_values_by_rowid(rowids, size, values);
     }
 
+    Status fetch_values_by_ranges(const vectorized::SparseRange& ranges, vectorized::Column* values) override {
+        return _col_iter->fetch_values_by_ranges(ranges, values);
+    }
+
     Status seek_to_first() override { return _col_iter->seek_to_first(); }
 
     Status seek_to_ordinal(ordinal_t ord) override { return _col_iter->seek_to_ordinal(ord); }
@@ -197,10 +207,33 @@ private:
     Status _init();
     Status _do_get_next(Chunk* result, vector<rowid_t>* rowid);
 
+    // Replace |_opts.delete_predicates| by the cached bitmap of the rows they delete, which is materialized if it's
+    // not cached yet. See DeleteBitmapCache.
+    Status _init_delete_bitmap();
+    // Read the columns of the delete predicates of all the rows and collect the rows deleted.
+    Status _materialize_delete_bitmap(DelVectorPtr* del_vec);
+
     Status _init_column_iterators(const Schema& schema);
     Status _get_row_ranges_by_keys();
     Status _get_row_ranges_by_zone_map();
+    // Prune the rows by |_opts.or_predicates|, the rows of a disjunction are the union of the rows of its
+    // conjunctions.
+    Status _get_row_ranges_by_or_predicates();
+    // Intersect |range| with the rows selected by the zone maps and the bitmap indexes of the columns of |preds|.
+    Status _get_row_ranges_by_conjunction(const ConjunctivePredicates& preds, SparseRange* range);
     Status _get_row_ranges_by_bloom_filter();
+    // Prune the rows not read yet, i.e, the rows from |from|, by the zone maps of the new late predicates.
+    Status _apply_late_predicates(rowid_t from);
+    // Prune the next |n| rows to read by the encoded values of the data pages, e.g, the frames of
+    // frame-of-reference pages and the runs of RLE pages, before decoding them.
+    Status _apply_encoded_predicates(size_t n);
+
+    // Return true if the rows of this segment can be answered by the segment-level zone maps, i.e, all rows
+    // are read, none is deleted, and all the values in the zone maps satisfy the predicates.
+    // The min and max values of the fields are saved into |_metadata_columns| if true is returned.
+    bool _can_aggregate_by_metadata();
+    // Fill |chunk| with the rows answered by the zone maps.
+    Status _read_by_metadata(Chunk* chunk);
 
     uint32_t segment_id() const { return _segment->id(); }
     uint32_t num_rows() const { return _segment->num_rows(); }
@@ -238,6 +271,8 @@ private:
 
     Status _apply_bitmap_index();
 
+    Status _apply_inverted_index();
+
     Status _read(Chunk* chunk, vector<rowid_t>* rowid, size_t n);
 
 private:
@@ -281,6 +316,17 @@ private:
     // the next rowid to read
     rowid_t _cur_rowid = 0;
 
+    // the number of the late predicates already applied.
+    size_t _num_late_predicates = 0;
+
+    // the rows before it have been pruned by the encoded values.
+    rowid_t _encoded_filtered_end = 0;
+
+    // The min and max values of each field if the segment is answered by the zone maps, empty otherwise.
+    Columns _metadata_columns;
+    // The number of the rows answered by the zone maps.
+    rowid_t _metadata_rows_read = 0;
+
     int _late_materialization_ratio = 0;
 
     bool _inited = false;
@@ -315,6 +361,8 @@ Status SegmentIterator::_init() {
                     << " " << _del_vec->cardinality() << "/" << _segment->num_rows();
             roaring_init_iterator(&_del_vec->roaring()->roaring, &_roaring_iter);
         }
+    } else if (!_opts.delete_predicates.empty()) {
+        RETURN_IF_ERROR(_init_delete_bitmap());
     }
 
     RETURN_IF_ERROR(_segment->_load_index());
@@ -333,9 +381,15 @@ Status SegmentIterator::_init() {
     RETURN_IF_ERROR(_init_column_iterators(_schema));
     RETURN_IF_ERROR(_init_bitmap_index_iterators());
     RETURN_IF_ERROR(_get_row_ranges_by_keys());
+    if (_can_aggregate_by_metadata()) {
+        return Status::OK();
+    }
     RETURN_IF_ERROR(_apply_bitmap_index());
+    RETURN_IF_ERROR(_apply_inverted_index());
     RETURN_IF_ERROR(_get_row_ranges_by_zone_map());
+    RETURN_IF_ERROR(_get_row_ranges_by_or_predicates());
     RETURN_IF_ERROR(_get_row_ranges_by_bloom_filter());
+    RETURN_IF_ERROR(_apply_late_predicates(0));
     _rewrite_predicates();
     _init_context();
     _init_column_predicates();
@@ -368,6 +422,7 @@ Status SegmentIterator::_init_column_iterators(const Schema& schema) {
             iter_opts.use_page_cache = _opts.use_page_cache;
             iter_opts.rblock = _rblock.get();
             iter_opts.check_dict_encoding = check_dict_enc;
+            iter_opts.use_decoded_page_cache = true;
             RETURN_IF_ERROR(_column_iterators[cid]->init(iter_opts));
             // turn off low cardinality if not all data pages are dict-encoded.
             _predicate_need_rewrite[cid] &= _column_iterators[cid]->all_page_dict_encoded();
@@ -426,6 +481,80 @@ Status SegmentIterator::_get_row_ranges_by_keys() {
     return Status::OK();
 }
 
+Status SegmentIterator::_init_delete_bitmap() {
+    auto* cache = DeleteBitmapCache::instance();
+    if (cache == nullptr || _opts.delete_version <= 0 || config::delete_bitmap_min_predicates <= 0 ||
+        _opts.delete_predicates.size() < static_cast<size_t>(config::delete_bitmap_min_predicates)) {
+        return Status::OK();
+    }
+    const std::string key = DeleteBitmapCache::make_key(_segment->file_name(), _opts.delete_version);
+    DelVectorPtr del_vec = cache->lookup(key);
+    if (del_vec == nullptr) {
+        // the segments read by the compactions are about to be dropped, so their bitmaps are not worth building.
+        if (is_compaction(_opts.reader_type)) {
+            return Status::OK();
+        }
+        SCOPED_RAW_TIMER(&_opts.stats->del_filter_ns);
+        RETURN_IF_ERROR(_materialize_delete_bitmap(&del_vec));
+        cache->insert(key, del_vec);
+    }
+    _opts.delete_predicates = DisjunctivePredicates();
+    if (del_vec->empty()) {
+        return Status::OK();
+    }
+    if (_segment->num_rows() == del_vec->cardinality()) {
+        return Status::EndOfFile("all rows deleted");
+    }
+    _del_vec = std::move(del_vec);
+    roaring_init_iterator(&_del_vec->roaring()->roaring, &_roaring_iter);
+    return Status::OK();
+}
+
+Status SegmentIterator::_materialize_delete_bitmap(DelVectorPtr* del_vec) {
+    std::set<ColumnId> cids;
+    _opts.delete_predicates.get_column_ids(&cids);
+    Schema schema;
+    for (ColumnId cid : cids) {
+        auto iter = std::find_if(_schema.fields().begin(), _schema.fields().end(),
+                                 [cid](const FieldPtr& field) { return field->id() == cid; });
+        if (iter == _schema.fields().end()) {
+            return Status::InternalError(strings::Substitute("delete predicate column $0 not found", cid));
+        }
+        schema.append(*iter);
+    }
+
+    SegmentReadOptions opts;
+    opts.block_mgr = _opts.block_mgr;
+    opts.stats = _opts.stats;
+    opts.use_page_cache = _opts.use_page_cache;
+    opts.reader_type = _opts.reader_type;
+    opts.chunk_size = _opts.chunk_size;
+    auto iter = new_segment_iterator(_segment, schema, opts);
+    ChunkPtr chunk = ChunkHelper::new_chunk(schema, opts.chunk_size);
+    std::vector<uint32_t> rowids;
+    std::vector<uint8_t> selection(opts.chunk_size);
+    std::vector<uint32_t> dels;
+    while (true) {
+        chunk->reset();
+        rowids.clear();
+        Status st = iter->get_next(chunk.get(), &rowids);
+        if (st.is_end_of_file()) {
+            break;
+        }
+        RETURN_IF_ERROR(st);
+        _opts.delete_predicates.evaluate(chunk.get(), selection.data());
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            if (selection[i]) {
+                dels.push_back(rowids[i]);
+            }
+        }
+    }
+    iter->close();
+    *del_vec = std::make_shared<DelVector>();
+    (*del_vec)->init(_opts.delete_version, dels.data(), dels.size());
+    return Status::OK();
+}
+
 Status SegmentIterator::_get_row_ranges_by_zone_map() {
     SparseRange zm_range(0, num_rows());
 
@@ -478,11 +607,222 @@ Status SegmentIterator::_get_row_ranges_by_zone_map() {
     return Status::OK();
 }
 
+Status SegmentIterator::_get_row_ranges_by_or_predicates() {
+    RETURN_IF(_opts.or_predicates.empty(), Status::OK());
+    const size_t prev_size = _scan_range.span_size();
+    for (const DisjunctivePredicates& or_predicate : _opts.or_predicates) {
+        if (_scan_range.empty()) {
+            break;
+        }
+        SparseRange selected;
+        for (size_t i = 0; i < or_predicate.size(); i++) {
+            SparseRange r = _scan_range;
+            RETURN_IF_ERROR(_get_row_ranges_by_conjunction(or_predicate[i], &r));
+            selected |= r;
+        }
+        _scan_range = _scan_range.intersection(selected);
+    }
+    _opts.stats->rows_stats_filtered += (prev_size - _scan_range.span_size());
+    return Status::OK();
+}
+
+Status SegmentIterator::_get_row_ranges_by_conjunction(const ConjunctivePredicates& preds, SparseRange* range) {
+    std::set<ColumnId> columns;
+    preds.get_column_ids(&columns);
+    std::vector<const ColumnPredicate*> column_preds;
+    for (ColumnId cid : columns) {
+        if (range->empty()) {
+            break;
+        }
+        if (cid >= _column_iterators.size() || _column_iterators[cid] == nullptr) {
+            continue;
+        }
+        column_preds.clear();
+        preds.predicates_of_column(cid, &column_preds);
+        SparseRange zm_range;
+        RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_zone_map(column_preds, nullptr, &zm_range));
+        *range = range->intersection(zm_range);
+
+        // The same as `_apply_bitmap_index`, but the predicates are still evaluated on the rows.
+        BitmapIndexIterator* bitmap_iter = _bitmap_index_iterators[cid];
+        if (bitmap_iter == nullptr || range->empty()) {
+            continue;
+        }
+        SCOPED_RAW_TIMER(&_opts.stats->bitmap_index_filter_timer);
+        size_t cardinality = bitmap_iter->bitmap_nums();
+        SparseRange selected(0, cardinality);
+        bool has_is_null = false;
+        for (const ColumnPredicate* pred : column_preds) {
+            SparseRange r;
+            Status st = pred->seek_bitmap_dictionary(bitmap_iter, &r);
+            if (st.ok()) {
+                selected &= r;
+                has_is_null |= (pred->type() == PredicateType::kIsNull);
+            } else if (!st.is_cancelled()) {
+                return st;
+            }
+        }
+        if (selected.span_size() * 1000 > cardinality * config::bitmap_max_filter_ratio) {
+            continue;
+        }
+        Roaring row_bitmap;
+        RETURN_IF_ERROR(bitmap_iter->read_union_bitmap(selected, &row_bitmap));
+        if (bitmap_iter->has_null_bitmap() && !has_is_null) {
+            Roaring null_bitmap;
+            RETURN_IF_ERROR(bitmap_iter->read_null_bitmap(&null_bitmap));
+            row_bitmap -= null_bitmap;
+        }
+        *range = range->intersection(roaring2range(row_bitmap));
+    }
+    return Status::OK();
+}
+
+Status SegmentIterator::_apply_late_predicates(rowid_t from) {
+    if (_opts.late_predicates == nullptr) {
+        return Status::OK();
+    }
+    const std::vector<const ColumnPredicate*>& preds = _opts.late_predicates->poll();
+    if (preds.size() == _num_late_predicates) {
+        return Status::OK();
+    }
+    std::map<ColumnId, std::vector<const ColumnPredicate*>> column_preds;
+    for (size_t i = _num_late_predicates; i < preds.size(); i++) {
+        ColumnId cid = preds[i]->column_id();
+        DCHECK(preds[i]->is_index_filter_only());
+        if (cid < _column_iterators.size() && _column_iterators[cid] != nullptr) {
+            column_preds[cid].emplace_back(preds[i]);
+        }
+    }
+    _num_late_predicates = preds.size();
+    if (column_preds.empty()) {
+        return Status::OK();
+    }
+
+    SparseRange zm_range(from, num_rows());
+    for (const auto& [cid, col_preds] : column_preds) {
+        SparseRange r;
+        RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_zone_map(col_preds, nullptr, &r));
+        zm_range = zm_range.intersection(r);
+    }
+    _scan_range = _scan_range.intersection(SparseRange(from, num_rows()));
+    size_t prev_size = _scan_range.span_size();
+    _scan_range = _scan_range.intersection(zm_range);
+    _opts.stats->rows_stats_filtered += (prev_size - _scan_range.span_size());
+    _range_iter = _scan_range.new_iterator();
+    return Status::OK();
+}
+
+Status SegmentIterator::_apply_encoded_predicates(size_t n) {
+    const rowid_t from = _range_iter.begin();
+    const rowid_t to = std::min<rowid_t>(num_rows(), from + n);
+    if (to <= _encoded_filtered_end) {
+        return Status::OK();
+    }
+    SparseRange range;
+    SparseRangeIterator iter = _range_iter;
+    while (iter.has_more() && iter.begin() < to) {
+        range.add(iter.next(to - iter.begin()));
+    }
+    const size_t prev_size = range.span_size();
+    for (const auto& [cid, preds] : _opts.predicates) {
+        RETURN_IF_ERROR(_column_iterators[cid]->filter_by_encoded_values(preds, &range));
+        if (range.empty()) {
+            break;
+        }
+    }
+    _encoded_filtered_end = to;
+    const size_t filtered = prev_size - range.span_size();
+    if (filtered == 0) {
+        return Status::OK();
+    }
+    // the column iterators evaluated are positioned at the first rows they evaluated, `_read` seeks all of
+    // them again if |from| is filtered.
+    _opts.stats->rows_encoded_filtered += filtered;
+    SparseRange rest = _scan_range.intersection(SparseRange(to, num_rows()));
+    _scan_range = std::move(range);
+    _scan_range |= rest;
+    _range_iter = _scan_range.new_iterator();
+    return Status::OK();
+}
+
 // if |lower| is true, return the first row in the range [0, end) that is not less than |key|,
 // or end if no such row is found.
 // if |lower| is false, return the first row in the range [0, end) that is greater than |key|,
 // or end if no such row is found.
 // |rowid| will be assigned to the id of found row or |end| if no such row is found.
+// The predicates of these types select all the values in [min, max] if they select both min and max.
+static bool is_range_predicate(PredicateType type) {
+    switch (type) {
+    case PredicateType::kEQ:
+    case PredicateType::kGT:
+    case PredicateType::kGE:
+    case PredicateType::kLT:
+    case PredicateType::kNotNull:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool SegmentIterator::_can_aggregate_by_metadata() {
+    if (!_opts.aggregate_by_metadata || _del_vec != nullptr || !_opts.delete_predicates.empty() ||
+        !_opts.or_predicates.empty() || num_rows() == 0 || _scan_range.span_size() != num_rows()) {
+        return false;
+    }
+    Columns columns;
+    size_t num_predicate_columns = 0;
+    for (const FieldPtr& field : _schema.fields()) {
+        const ColumnId cid = field->id();
+        Datum min;
+        Datum max;
+        if (!_segment->column_min_max(cid, field->type()->type(), &min, &max)) {
+            return false;
+        }
+        ColumnPtr column = ChunkHelper::column_from_field(*field);
+        column->append_datum(min);
+        column->append_datum(max);
+
+        auto iter = _opts.predicates.find(cid);
+        if (iter != _opts.predicates.end()) {
+            num_predicate_columns++;
+            const bool single_value = column->compare_at(0, 1, *column, 1) == 0;
+            for (const ColumnPredicate* pred : iter->second) {
+                uint8_t selection[2];
+                pred->evaluate(column.get(), selection, 0, 2);
+                if (!selection[0] || !selection[1] || !(single_value || is_range_predicate(pred->type()))) {
+                    return false;
+                }
+            }
+        }
+        columns.emplace_back(std::move(column));
+    }
+    if (num_predicate_columns != _opts.predicates.size()) {
+        return false;
+    }
+    _metadata_columns.swap(columns);
+    return true;
+}
+
+Status SegmentIterator::_read_by_metadata(Chunk* chunk) {
+    if (_metadata_rows_read == num_rows()) {
+        return Status::EndOfFile("no more data in segment");
+    }
+    const size_t n = std::min<size_t>(_opts.chunk_size, num_rows() - _metadata_rows_read);
+    for (size_t i = 0; i < _metadata_columns.size(); i++) {
+        const ColumnPtr& src = _metadata_columns[i];
+        const ColumnPtr& dst = chunk->get_column_by_index(i);
+        if (_metadata_rows_read == 0) {
+            dst->append(*src, 1, 1);
+            dst->append_value_multiple_times(*src, 0, n - 1);
+        } else {
+            dst->append_value_multiple_times(*src, 0, n);
+        }
+    }
+    _metadata_rows_read += n;
+    _opts.stats->rows_metadata_aggregated += n;
+    return Status::OK();
+}
+
 Status SegmentIterator::_lookup_ordinal(const SeekTuple& key, bool lower, rowid_t end, rowid_t* rowid) {
     std::string index_key;
     index_key = lower ? key.short_key_encode(_segment->num_short_keys(), KEY_MINIMAL_MARKER)
@@ -599,6 +939,10 @@ Status SegmentIterator::do_get_next(Chunk* chunk) {
 
     DCHECK_EQ(0, chunk->num_rows());
 
+    if (!_metadata_columns.empty()) {
+        return _read_by_metadata(chunk);
+    }
+
     Status st;
     do {
         st = _do_get_next(chunk, nullptr);
@@ -613,6 +957,8 @@ Status SegmentIterator::do_get_next(Chunk* chunk, vector<uint32_t>* rowid) {
     }
 
     DCHECK_EQ(0, chunk->num_rows());
+    // The rows answered by the zone maps have no row ids.
+    DCHECK(_metadata_columns.empty());
 
     Status st;
     do {
@@ -642,7 +988,18 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
 
     Chunk* chunk = _context->_read_chunk.get();
 
+    // the runtime filters arrived since the last chunk could prune the rest of the segment.
+    if (_opts.late_predicates != nullptr && _range_iter.has_more()) {
+        RETURN_IF_ERROR(_apply_late_predicates(_range_iter.begin()));
+    }
+
     while ((chunk_start < chunk_capacity) & _range_iter.has_more()) {
+        if (has_predicate) {
+            RETURN_IF_ERROR(_apply_encoded_predicates(chunk_capacity - chunk_start));
+            if (!_range_iter.has_more()) {
+                break;
+            }
+        }
         RETURN_IF_ERROR(_read(chunk, rowid, chunk_capacity - chunk_start));
         chunk->check_or_die();
         size_t next_start = chunk->num_rows();
@@ -713,6 +1070,22 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
         }
     }
 
+    // The pages and the rows pruned by the indexes may still have the rows not satisfying the or predicates.
+    for (const DisjunctivePredicates& or_predicate : _opts.or_predicates) {
+        if (chunk->num_rows() == 0) {
+            break;
+        }
+        SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
+        size_t old_sz = chunk->num_rows();
+        or_predicate.evaluate(chunk, _selection.data());
+        size_t new_sz = chunk->filter_range(_selection, 0, old_sz);
+        if (rowid != nullptr) {
+            auto size = ColumnHelper::filter_range<uint32_t>(_selection, rowid->data(), 0, old_sz);
+            rowid->resize(size);
+        }
+        _opts.stats->rows_vec_cond_filtered += old_sz - new_sz;
+    }
+
     curr_mem_usage = _context->memory_usage();
     CurrentMemTracker::consume(curr_mem_usage - old_mem_usage);
 
@@ -1111,6 +1484,9 @@ Status SegmentIterator::_finish_late_materialization(ScanContext* ctx) {
         ctx->_final_chunk->get_column_by_index(i)->swap_column(*ctx->_dict_chunk->get_column_by_index(i));
     }
 
+    // the rows left are converted into ranges once, so that each column reads the ranges page by page,
+    // and skips the pages without any row left.
+    const SparseRange ranges = rowids2range(ordinals->get_data().data(), ordinals->size());
     const size_t n = _schema.num_fields();
     for (size_t i = m - 1; i < n; i++) {
         const FieldPtr& f = _schema.field(i);
@@ -1119,7 +1495,7 @@ Status SegmentIterator::_finish_late_materialization(ScanContext* ctx) {
         col->reserve(ordinals->size());
         col->resize(0);
 
-        RETURN_IF_ERROR(_column_iterators[cid]->fetch_values_by_rowid(*ordinals, col.get()));
+        RETURN_IF_ERROR(_column_iterators[cid]->fetch_values_by_ranges(ranges, col.get()));
         DCHECK_EQ(ordinals->size(), col->size());
         may_has_del_row |= (col->delete_state() != DEL_NOT_SATISFIED);
     }
@@ -1138,6 +1514,17 @@ Status SegmentIterator::_init_bitmap_index_iterators() {
             _has_bitmap_index |= (_bitmap_index_iterators[cid] != nullptr);
         }
     }
+    // The bitmap indexes of the columns only in the or predicates are only used by
+    // `_get_row_ranges_by_conjunction`, so |_has_bitmap_index| is not changed.
+    std::set<ColumnId> or_columns;
+    for (const DisjunctivePredicates& or_predicate : _opts.or_predicates) {
+        or_predicate.get_column_ids(&or_columns);
+    }
+    for (ColumnId cid : or_columns) {
+        if (cid < _bitmap_index_iterators.size() && _bitmap_index_iterators[cid] == nullptr) {
+            RETURN_IF_ERROR(_segment->new_bitmap_index_iterator(cid, &_bitmap_index_iterators[cid]));
+        }
+    }
     return Status::OK();
 }
 
@@ -1236,6 +1623,48 @@ Status SegmentIterator::_apply_bitmap_index() {
     return Status::OK();
 }
 
+// filter rows by evaluating column predicates using the inverted indexes of the tokens.
+// upon return, predicates that have been evaluated by inverted indexes will be removed.
+Status SegmentIterator::_apply_inverted_index() {
+    RETURN_IF(_scan_range.empty(), Status::OK());
+    SCOPED_RAW_TIMER(&_opts.stats->bitmap_index_filter_timer);
+    const size_t input_rows = _scan_range.span_size();
+    std::optional<Roaring> row_bitmap;
+    std::vector<const ColumnPredicate*> erased_preds;
+    for (auto& [cid, pred_list] : _opts.predicates) {
+        BitmapIndexIterator* raw_iter = nullptr;
+        RETURN_IF_ERROR(_segment->new_inverted_index_iterator(cid, &raw_iter));
+        if (raw_iter == nullptr) {
+            continue;
+        }
+        std::unique_ptr<BitmapIndexIterator> iter(raw_iter);
+        for (const ColumnPredicate* pred : pred_list) {
+            Roaring rows;
+            Status st = pred->seek_inverted_index(iter.get(), &rows);
+            if (st.ok()) {
+                if (!row_bitmap.has_value()) {
+                    row_bitmap = range2roaring(_scan_range);
+                }
+                *row_bitmap &= rows;
+                erased_preds.emplace_back(pred);
+            } else if (!st.is_cancelled()) {
+                return st;
+            }
+        }
+    }
+    RETURN_IF(!row_bitmap.has_value(), Status::OK());
+
+    if (row_bitmap->cardinality() < input_rows) {
+        _scan_range = roaring2range(*row_bitmap);
+    }
+    for (const ColumnPredicate* pred : erased_preds) {
+        PredicateList& pred_list = _opts.predicates[pred->column_id()];
+        pred_list.erase(std::find(pred_list.begin(), pred_list.end(), pred));
+    }
+    _opts.stats->rows_bitmap_index_filtered += (input_rows - _scan_range.span_size());
+    return Status::OK();
+}
+
 Status SegmentIterator::_get_row_ranges_by_bloom_filter() {
     RETURN_IF(_opts.predicates.empty(), Status::OK());
     size_t prev_size = _scan_range.span_size();
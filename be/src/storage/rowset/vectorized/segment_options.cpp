@@ -27,6 +27,13 @@ Status SegmentReadOptions::convert_to(SegmentReadOptions* dst, const std::vector
     // delete predicates
     RETURN_IF_ERROR(delete_predicates.convert_to(&dst->delete_predicates, new_types, obj_pool));
 
+    // or predicates
+    dst->or_predicates.resize(or_predicates.size());
+    for (size_t i = 0; i < or_predicates.size(); ++i) {
+        RETURN_IF_ERROR(or_predicates[i].convert_to(&dst->or_predicates[i], new_types, obj_pool));
+    }
+
+    dst->delete_version = delete_version;
     dst->stats = stats;
     dst->use_page_cache = use_page_cache;
     dst->profile = profile;
@@ -21,6 +21,7 @@ class OlapMeta;
 namespace starrocks::vectorized {
 
 class ColumnPredicate;
+class LatePredicates;
 
 class SegmentReadOptions {
 public:
@@ -31,8 +32,16 @@ public:
     std::vector<SeekRange> ranges;
 
     std::unordered_map<ColumnId, PredicateList> predicates;
+    // Not converted by `convert_to`, the predicates of the converted types are not available.
+    LatePredicates* late_predicates = nullptr;
 
     DisjunctivePredicates delete_predicates;
+    // The version of the latest delete predicate, which identifies the rows deleted by |delete_predicates|.
+    // See DeleteBitmapCache.
+    int64_t delete_version = 0;
+
+    // The disjunctions pushed down from the query, e.g. `c1 = 1 OR c2 = 2`, the rows returned satisfy all of them.
+    std::vector<DisjunctivePredicates> or_predicates;
 
     // used for updatable tablet to get delvec
     bool is_primary_keys = false;
@@ -47,6 +56,9 @@ public:
     RuntimeProfile* profile = nullptr;
 
     bool use_page_cache = false;
+    // Not converted by `convert_to`, the zone maps of the converted types are not available.
+    // See `ReaderParams::aggregate_by_metadata`.
+    bool aggregate_by_metadata = false;
 
     Status convert_to(SegmentReadOptions* dst, const std::vector<FieldType>& new_types, ObjectPool* obj_pool) const;
 
@@ -25,7 +25,9 @@
 #include <util/defer_op.h>
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "runtime/exec_env.h"
@@ -43,6 +45,7 @@
 #include "storage/tablet_updates.h"
 #include "storage/vectorized/convert_helper.h"
 #include "storage/wrapper_field.h"
+#include "util/threadpool.h"
 #include "util/unaligned_access.h"
 
 using std::deque;
@@ -1783,7 +1786,6 @@ OLAPStatus SchemaChangeHandler::_convert_historical_rowsets(const SchemaChangePa
 
     bool sc_sorting = false;
     bool sc_directly = false;
-    SchemaChange* sc_procedure = nullptr;
     MemTracker* mem_tracker = ExecEnv::GetInstance()->schema_change_mem_tracker();
 
     // a. parse Alter request
@@ -1791,120 +1793,86 @@ OLAPStatus SchemaChangeHandler::_convert_historical_rowsets(const SchemaChangePa
                                     sc_params.materialized_params_map);
     if (res != OLAP_SUCCESS) {
         LOG(WARNING) << "failed to parse the request. res=" << res;
-        goto PROCESS_ALTER_EXIT;
-    }
-
-    // b. create converter for history data
-    if (sc_sorting) {
-        size_t memory_limitation = config::memory_limitation_per_thread_for_schema_change;
-        LOG(INFO) << "doing schema change with sorting for base_tablet " << sc_params.base_tablet->full_name();
-        sc_procedure =
-                new (nothrow) SchemaChangeWithSorting(mem_tracker, rb_changer, memory_limitation * 1024 * 1024 * 1024);
-    } else if (sc_directly) {
-        LOG(INFO) << "doing schema change directly for base_tablet " << sc_params.base_tablet->full_name();
-        sc_procedure = new (nothrow) SchemaChangeDirectly(mem_tracker, rb_changer);
     } else {
-        LOG(INFO) << "doing linked schema change for base_tablet " << sc_params.base_tablet->full_name();
-        sc_procedure = new (nothrow) LinkedSchemaChange(mem_tracker, rb_changer);
-    }
-
-    if (sc_procedure == nullptr) {
-        LOG(WARNING) << "failed to malloc SchemaChange. "
-                     << "malloc_size=" << sizeof(SchemaChangeWithSorting);
-        res = OLAP_ERR_MALLOC_ERROR;
-        goto PROCESS_ALTER_EXIT;
-    }
-
-    // c. convert history data
-    for (auto& rs_reader : sc_params.ref_rowset_readers) {
-        VLOG(10) << "begin to convert a history rowset. version=" << rs_reader->version().first << "-"
-                 << rs_reader->version().second;
-
-        // set status for monitor
-        // If only one new_table is running, ref table will be set to running
-        // NOTE if the first sub_table is fail, it will continue as normal
-        TabletSharedPtr new_tablet = sc_params.new_tablet;
-
-        RowsetWriterContext writer_context(kDataFormatUnknown, config::storage_format_version);
-        writer_context.mem_tracker = ExecEnv::GetInstance()->schema_change_mem_tracker();
-        writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
-        writer_context.tablet_uid = new_tablet->tablet_uid();
-        writer_context.tablet_id = new_tablet->tablet_id();
-        writer_context.partition_id = new_tablet->partition_id();
-        writer_context.tablet_schema_hash = new_tablet->schema_hash();
-        // linked schema change can't change rowset type, therefore we preserve rowset type in schema change now
-        writer_context.rowset_type = rs_reader->rowset()->rowset_meta()->rowset_type();
-        if (sc_params.new_tablet->tablet_meta()->preferred_rowset_type() == BETA_ROWSET) {
-            // Use beta rowset to do schema change
-            // And in this case, linked schema change will not be used.
-            writer_context.rowset_type = BETA_ROWSET;
-        }
-        writer_context.rowset_path_prefix = new_tablet->tablet_path();
-        writer_context.tablet_schema = &(new_tablet->tablet_schema());
-        writer_context.rowset_state = VISIBLE;
-        writer_context.version = rs_reader->version();
-        writer_context.version_hash = rs_reader->version_hash();
-        writer_context.segments_overlap = rs_reader->rowset()->rowset_meta()->segments_overlap();
-
-        std::unique_ptr<RowsetWriter> rowset_writer;
-        OLAPStatus status = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
-        if (status != OLAP_SUCCESS) {
-            res = OLAP_ERR_ROWSET_BUILDER_INIT;
-            goto PROCESS_ALTER_EXIT;
-        }
-
-        if (!sc_procedure->process(rs_reader, rowset_writer.get(), sc_params.new_tablet, sc_params.base_tablet)) {
-            LOG(WARNING) << "failed to process the version."
-                         << " version=" << rs_reader->version().first << "-" << rs_reader->version().second;
-            res = OLAP_ERR_INPUT_PARAMETER_ERROR;
-            new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + rowset_writer->rowset_id().to_string());
-            goto PROCESS_ALTER_EXIT;
-        }
-        new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + rowset_writer->rowset_id().to_string());
-        // Add the new version of the data to the header,
-        // To prevent deadlocks, be sure to lock the old table first and then the new one
-        sc_params.new_tablet->obtain_push_lock();
-        RowsetSharedPtr new_rowset = rowset_writer->build();
-        if (new_rowset == nullptr) {
-            LOG(WARNING) << "failed to build rowset, exit alter process";
-            sc_params.new_tablet->release_push_lock();
-            goto PROCESS_ALTER_EXIT;
-        }
-        res = sc_params.new_tablet->add_rowset(new_rowset, false);
-        if (res == OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
-            LOG(WARNING) << "version already exist, version revert occured. "
-                         << "tablet=" << sc_params.new_tablet->full_name() << ", version='"
-                         << rs_reader->version().first << "-" << rs_reader->version().second;
-            StorageEngine::instance()->add_unused_rowset(new_rowset);
-            res = OLAP_SUCCESS;
-        } else if (res != OLAP_SUCCESS) {
-            LOG(WARNING) << "failed to register new version. "
-                         << " tablet=" << sc_params.new_tablet->full_name()
-                         << ", version=" << rs_reader->version().first << "-" << rs_reader->version().second;
-            StorageEngine::instance()->add_unused_rowset(new_rowset);
-            sc_params.new_tablet->release_push_lock();
-            goto PROCESS_ALTER_EXIT;
+        // b. convert history data, the rowsets are converted in parallel by their own converters, which share the
+        // memory limitation of the sorting.
+        const size_t num_rowsets = sc_params.ref_rowset_readers.size();
+        const size_t parallelism =
+                std::max<size_t>(1, std::min<size_t>(config::alter_tablet_rowset_parallelism, num_rowsets));
+        const size_t memory_limitation =
+                static_cast<size_t>(config::memory_limitation_per_thread_for_schema_change) * 1024 * 1024 * 1024;
+        if (sc_sorting) {
+            LOG(INFO) << "doing schema change with sorting for base_tablet " << sc_params.base_tablet->full_name();
+        } else if (sc_directly) {
+            LOG(INFO) << "doing schema change directly for base_tablet " << sc_params.base_tablet->full_name();
         } else {
-            VLOG(3) << "register new version. tablet=" << sc_params.new_tablet->full_name()
-                    << ", version=" << rs_reader->version().first << "-" << rs_reader->version().second;
+            LOG(INFO) << "doing linked schema change for base_tablet " << sc_params.base_tablet->full_name();
+        }
+        auto create_sc_procedure = [&]() -> std::unique_ptr<SchemaChange> {
+            if (sc_sorting) {
+                return std::make_unique<SchemaChangeWithSorting>(mem_tracker, rb_changer,
+                                                                 memory_limitation / parallelism);
+            } else if (sc_directly) {
+                return std::make_unique<SchemaChangeDirectly>(mem_tracker, rb_changer);
+            } else {
+                return std::make_unique<LinkedSchemaChange>(mem_tracker, rb_changer);
+            }
+        };
+
+        std::atomic<size_t> next_rowset{0};
+        std::mutex res_lock;
+        auto convert_rowsets = [&]() {
+            std::unique_ptr<SchemaChange> sc_procedure = create_sc_procedure();
+            while (true) {
+                size_t i = next_rowset++;
+                if (i >= num_rowsets) {
+                    break;
+                }
+                {
+                    std::lock_guard l(res_lock);
+                    if (res != OLAP_SUCCESS) {
+                        break;
+                    }
+                }
+                OLAPStatus st = _convert_historical_rowset(sc_params, sc_params.ref_rowset_readers[i],
+                                                           sc_procedure.get());
+                if (st != OLAP_SUCCESS) {
+                    std::lock_guard l(res_lock);
+                    if (res == OLAP_SUCCESS) {
+                        res = st;
+                    }
+                    break;
+                }
+            }
+        };
+        std::unique_ptr<ThreadPool> convert_pool;
+        if (parallelism > 1 && ThreadPoolBuilder("schema_change")
+                                       .set_min_threads(0)
+                                       .set_max_threads(parallelism - 1)
+                                       .build(&convert_pool)
+                                       .ok()) {
+            for (size_t i = 0; i + 1 < parallelism; i++) {
+                if (!convert_pool->submit_func(convert_rowsets).ok()) {
+                    break;
+                }
+            }
+        }
+        convert_rowsets();
+        if (convert_pool != nullptr) {
+            convert_pool->wait();
         }
-        sc_params.new_tablet->release_push_lock();
-
-        VLOG(10) << "succeed to convert a history version."
-                 << " version=" << rs_reader->version().first << "-" << rs_reader->version().second;
     }
     // XXX: The SchemaChange state should not be cancelled at this point,
     // because the new Delta has to be converted to the old and new Schema versions
-PROCESS_ALTER_EXIT : {
-    // save tablet meta here because rowset meta is not saved during add rowset
-    std::unique_lock new_wlock(sc_params.new_tablet->get_header_lock());
-    sc_params.new_tablet->save_meta();
-}
+    {
+        // save tablet meta here because rowset meta is not saved during add rowset
+        std::unique_lock new_wlock(sc_params.new_tablet->get_header_lock());
+        sc_params.new_tablet->save_meta();
+    }
     if (res == OLAP_SUCCESS) {
         Version test_version(0, end_version);
         res = sc_params.new_tablet->check_version_integrity(test_version);
     }
-    SAFE_DELETE(sc_procedure);
 
     LOG(INFO) << "finish converting rowsets for new_tablet from base_tablet. "
               << "base_tablet=" << sc_params.base_tablet->full_name()
@@ -1912,6 +1880,85 @@ PROCESS_ALTER_EXIT : {
     return res;
 }
 
+OLAPStatus SchemaChangeHandler::_convert_historical_rowset(const SchemaChangeParams& sc_params,
+                                                           const RowsetReaderSharedPtr& rs_reader,
+                                                           SchemaChange* sc_procedure) {
+    VLOG(10) << "begin to convert a history rowset. version=" << rs_reader->version().first << "-"
+             << rs_reader->version().second;
+
+    // set status for monitor
+    // If only one new_table is running, ref table will be set to running
+    // NOTE if the first sub_table is fail, it will continue as normal
+    TabletSharedPtr new_tablet = sc_params.new_tablet;
+
+    RowsetWriterContext writer_context(kDataFormatUnknown, config::storage_format_version);
+    writer_context.mem_tracker = ExecEnv::GetInstance()->schema_change_mem_tracker();
+    writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
+    writer_context.tablet_uid = new_tablet->tablet_uid();
+    writer_context.tablet_id = new_tablet->tablet_id();
+    writer_context.partition_id = new_tablet->partition_id();
+    writer_context.tablet_schema_hash = new_tablet->schema_hash();
+    // linked schema change can't change rowset type, therefore we preserve rowset type in schema change now
+    writer_context.rowset_type = rs_reader->rowset()->rowset_meta()->rowset_type();
+    if (sc_params.new_tablet->tablet_meta()->preferred_rowset_type() == BETA_ROWSET) {
+        // Use beta rowset to do schema change
+        // And in this case, linked schema change will not be used.
+        writer_context.rowset_type = BETA_ROWSET;
+    }
+    writer_context.rowset_path_prefix = new_tablet->tablet_path();
+    writer_context.tablet_schema = &(new_tablet->tablet_schema());
+    writer_context.rowset_state = VISIBLE;
+    writer_context.version = rs_reader->version();
+    writer_context.version_hash = rs_reader->version_hash();
+    writer_context.segments_overlap = rs_reader->rowset()->rowset_meta()->segments_overlap();
+
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    OLAPStatus status = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+    if (status != OLAP_SUCCESS) {
+        return OLAP_ERR_ROWSET_BUILDER_INIT;
+    }
+
+    if (!sc_procedure->process(rs_reader, rowset_writer.get(), sc_params.new_tablet, sc_params.base_tablet)) {
+        LOG(WARNING) << "failed to process the version."
+                     << " version=" << rs_reader->version().first << "-" << rs_reader->version().second;
+        new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + rowset_writer->rowset_id().to_string());
+        return OLAP_ERR_INPUT_PARAMETER_ERROR;
+    }
+    new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + rowset_writer->rowset_id().to_string());
+    // Add the new version of the data to the header,
+    // To prevent deadlocks, be sure to lock the old table first and then the new one
+    sc_params.new_tablet->obtain_push_lock();
+    RowsetSharedPtr new_rowset = rowset_writer->build();
+    if (new_rowset == nullptr) {
+        LOG(WARNING) << "failed to build rowset, exit alter process";
+        sc_params.new_tablet->release_push_lock();
+        return OLAP_ERR_ROWSET_BUILDER_INIT;
+    }
+    OLAPStatus res = sc_params.new_tablet->add_rowset(new_rowset, false);
+    if (res == OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
+        LOG(WARNING) << "version already exist, version revert occured. "
+                     << "tablet=" << sc_params.new_tablet->full_name() << ", version='" << rs_reader->version().first
+                     << "-" << rs_reader->version().second;
+        StorageEngine::instance()->add_unused_rowset(new_rowset);
+        res = OLAP_SUCCESS;
+    } else if (res != OLAP_SUCCESS) {
+        LOG(WARNING) << "failed to register new version. "
+                     << " tablet=" << sc_params.new_tablet->full_name() << ", version=" << rs_reader->version().first
+                     << "-" << rs_reader->version().second;
+        StorageEngine::instance()->add_unused_rowset(new_rowset);
+        sc_params.new_tablet->release_push_lock();
+        return res;
+    } else {
+        VLOG(3) << "register new version. tablet=" << sc_params.new_tablet->full_name()
+                << ", version=" << rs_reader->version().first << "-" << rs_reader->version().second;
+    }
+    sc_params.new_tablet->release_push_lock();
+
+    VLOG(10) << "succeed to convert a history version."
+             << " version=" << rs_reader->version().first << "-" << rs_reader->version().second;
+    return OLAP_SUCCESS;
+}
+
 // @static
 OLAPStatus SchemaChangeHandler::_parse_request(
         TabletSharedPtr base_tablet, TabletSharedPtr new_tablet, RowBlockChanger* rb_changer, bool* sc_sorting,
@@ -2068,8 +2115,8 @@ OLAPStatus SchemaChangeHandler::_parse_request(
         }
     }
 
-    if (base_tablet->delete_predicates().size() != 0) {
-        //there exists delete condition in header, can't do linked schema change
+    if (!_delete_predicates_linkable(*base_tablet, new_tablet_schema, rb_changer)) {
+        // the delete conditions in header can't be kept by the linked rowsets, so they are applied by rewriting
         *sc_directly = true;
     }
 
@@ -2081,6 +2128,37 @@ OLAPStatus SchemaChangeHandler::_parse_request(
     return OLAP_SUCCESS;
 }
 
+// The linked rowsets keep the delete conditions of their versions, which become the delete conditions of the new
+// tablet, so every column they refer to must be a column of the new tablet with the same values, e.g. the new
+// columns are only added or the other columns are dropped.
+bool SchemaChangeHandler::_delete_predicates_linkable(const Tablet& base_tablet, const TabletSchema& new_tablet_schema,
+                                                      RowBlockChanger* rb_changer) {
+    auto is_linked_column = [&](const std::string& column_name) {
+        int32_t new_column_index = new_tablet_schema.field_index(column_name);
+        int32_t base_column_index = base_tablet.field_index(column_name);
+        if (new_column_index < 0 || base_column_index < 0) {
+            return false;
+        }
+        ColumnMapping* column_mapping = rb_changer->get_mutable_column_mapping(new_column_index);
+        return column_mapping->ref_column == base_column_index && column_mapping->materialized_function.empty();
+    };
+    for (const auto& del_pred : base_tablet.delete_predicates()) {
+        for (const auto& sub_predicate : del_pred.sub_predicates()) {
+            TCondition condition;
+            if (!DeleteHandler::parse_condition(sub_predicate, &condition) ||
+                !is_linked_column(condition.column_name)) {
+                return false;
+            }
+        }
+        for (const auto& in_predicate : del_pred.in_predicates()) {
+            if (!is_linked_column(in_predicate.column_name())) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 OLAPStatus SchemaChangeHandler::_init_column_mapping(ColumnMapping* column_mapping, const TabletColumn& column_schema,
                                                      const std::string& value) {
     column_mapping->default_value = WrapperField::create(column_schema);
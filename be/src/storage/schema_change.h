@@ -216,12 +216,18 @@ private:
     OLAPStatus _validate_alter_result(TabletSharedPtr new_tablet, const TAlterTabletReqV2& request);
 
     static OLAPStatus _convert_historical_rowsets(const SchemaChangeParams& sc_params);
+    // Convert |rs_reader| into a new rowset of the new tablet by |sc_procedure| and add it to the new tablet.
+    static OLAPStatus _convert_historical_rowset(const SchemaChangeParams& sc_params,
+                                                 const RowsetReaderSharedPtr& rs_reader, SchemaChange* sc_procedure);
 
     static OLAPStatus _parse_request(
             TabletSharedPtr base_tablet, TabletSharedPtr new_tablet, RowBlockChanger* rb_changer, bool* sc_sorting,
             bool* sc_directly,
             const std::unordered_map<std::string, AlterMaterializedViewParam>& materialized_function_map);
 
+    static bool _delete_predicates_linkable(const Tablet& base_tablet, const TabletSchema& new_tablet_schema,
+                                            RowBlockChanger* rb_changer);
+
     // default_value for new column is needed
     static OLAPStatus _init_column_mapping(ColumnMapping* column_mapping, const TabletColumn& column_schema,
                                            const std::string& value);
@@ -81,6 +81,10 @@ Status ShortKeyIndexDecoder::parse(const Slice& body, const segment_v2::ShortKey
         _offsets[i] = offset;
     }
     _offsets[_footer.num_items()] = _footer.key_bytes();
+    _prefixes.resize(_footer.num_items());
+    for (uint32_t i = 0; i < _footer.num_items(); ++i) {
+        _prefixes[i] = key_prefix(Slice(_key_data.data + _offsets[i], _offsets[i + 1] - _offsets[i]));
+    }
 
     if (offset_slice.size != 0) {
         return Status::Corruption("Still has data after parse all key offset");
@@ -21,13 +21,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <string>
 #include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/segment_v2.pb.h"
+#include "gutil/endian.h"
 #include "util/debug_util.h"
 #include "util/faststring.h"
 #include "util/slice.h"
@@ -256,18 +259,49 @@ public:
     }
 
     int64_t mem_usage() const {
-        return sizeof(ShortKeyIndexDecoder) + sizeof(uint32_t) * _offsets.size() + _key_data.size +
-               _footer.ByteSizeLong() - sizeof(_footer);
+        return sizeof(ShortKeyIndexDecoder) + sizeof(uint32_t) * _offsets.size() + sizeof(uint64_t) * _prefixes.size() +
+               _key_data.size + _footer.ByteSizeLong() - sizeof(_footer);
+    }
+
+    // The first 8 bytes of |key| padded by zeros as a big-endian integer, so that the order of the prefixes is
+    // consistent with the one of the keys, i.e. prefix(a) < prefix(b) implies a < b.
+    static uint64_t key_prefix(const Slice& key) {
+        uint64_t prefix = 0;
+        memcpy(&prefix, key.data, std::min<size_t>(key.size, sizeof(prefix)));
+        return BigEndian::ToHost64(prefix);
     }
 
 private:
+    // The number of the prefixes less than |prefix|, or not greater than it if |upper| is true, by a branchless
+    // binary search ending with a linear scan, which is vectorized, of the last few prefixes.
+    template <bool upper>
+    uint32_t _search_prefix(uint64_t prefix) const {
+        static constexpr size_t kLinearScanSize = 16;
+        const uint64_t* base = _prefixes.data();
+        size_t n = _prefixes.size();
+        while (n > kLinearScanSize) {
+            size_t half = n / 2;
+            base = (upper ? base[half] <= prefix : base[half] < prefix) ? base + half : base;
+            n -= half;
+        }
+        size_t count = 0;
+        for (size_t i = 0; i < n; i++) {
+            count += upper ? base[i] <= prefix : base[i] < prefix;
+        }
+        return base - _prefixes.data() + count;
+    }
+
     template <bool lower_bound>
     ShortKeyIndexIterator seek(const Slice& key) const {
+        // Only the keys sharing the prefix of |key| are compared as a whole.
+        const uint64_t prefix = key_prefix(key);
+        ShortKeyIndexIterator first(this, _search_prefix<false>(prefix));
+        ShortKeyIndexIterator last(this, _search_prefix<true>(prefix));
         auto comparator = [](const Slice& lhs, const Slice& rhs) { return lhs.compare(rhs) < 0; };
         if (lower_bound) {
-            return std::lower_bound(begin(), end(), key, comparator);
+            return std::lower_bound(first, last, key, comparator);
         } else {
-            return std::upper_bound(begin(), end(), key, comparator);
+            return std::upper_bound(first, last, key, comparator);
         }
     }
 
@@ -276,6 +310,8 @@ private:
     // All following fields are only valid after parse has been executed successfully
     segment_v2::ShortKeyFooterPB _footer;
     std::vector<uint32_t> _offsets;
+    // key_prefix() of every key
+    std::vector<uint64_t> _prefixes;
     Slice _key_data;
 };
 
@@ -60,6 +60,7 @@
 #include "util/pretty_printer.h"
 #include "util/scoped_cleanup.h"
 #include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
 #include "util/time.h"
 #include "util/trace.h"
 
@@ -169,6 +170,13 @@ Status StorageEngine::_open() {
     starrocks::ExecEnv::GetInstance()->set_storage_engine(this);
     RETURN_IF_ERROR_WITH_WARN(_update_manager->init(), "init update_manager failed");
 
+    if (config::segment_open_threads > 0) {
+        RETURN_IF_ERROR_WITH_WARN(ThreadPoolBuilder("SegmentOpenThreadPool")
+                                          .set_max_threads(config::segment_open_threads)
+                                          .build(&_segment_open_thread_pool),
+                                  "init segment open thread pool failed");
+    }
+
     auto dirs = get_stores<false>();
     // `load_data_dirs` depend on |_update_manager|.
     load_data_dirs(dirs);
@@ -596,7 +604,9 @@ Status StorageEngine::_perform_update_compaction(DataDir* data_dir) {
     {
         StarRocksMetrics::instance()->update_compaction_request_total.increment(1);
         SCOPED_RAW_TIMER(&duration_ns);
-        res = best_tablet->updates()->compaction(_options.compaction_mem_tracker);
+        size_t input_bytes = 0;
+        res = best_tablet->updates()->compaction(_options.compaction_mem_tracker, &input_bytes);
+        _consume_update_compaction_budget(data_dir, input_bytes);
     }
     StarRocksMetrics::instance()->update_compaction_duration_us.increment(duration_ns / 1000);
     if (!res.ok()) {
@@ -608,6 +618,26 @@ Status StorageEngine::_perform_update_compaction(DataDir* data_dir) {
     return Status::OK();
 }
 
+int64_t StorageEngine::_update_compaction_wait_seconds(DataDir* data_dir) {
+    std::lock_guard l(_update_compaction_budget_lock);
+    auto iter = _update_compaction_next_start_ms.find(data_dir);
+    if (iter == _update_compaction_next_start_ms.end()) {
+        return 0;
+    }
+    int64_t wait_ms = iter->second - MonotonicMillis();
+    return wait_ms > 0 ? (wait_ms + 999) / 1000 : 0;
+}
+
+void StorageEngine::_consume_update_compaction_budget(DataDir* data_dir, size_t bytes) {
+    const int64_t bytes_per_second = config::update_compaction_per_disk_bytes_per_second;
+    if (bytes_per_second <= 0 || bytes == 0) {
+        return;
+    }
+    std::lock_guard l(_update_compaction_budget_lock);
+    auto& next_start_ms = _update_compaction_next_start_ms[data_dir];
+    next_start_ms = std::max(next_start_ms, MonotonicMillis()) + (int64_t)(bytes * 1000.0 / bytes_per_second);
+}
+
 OLAPStatus StorageEngine::_start_trash_sweep(double* usage) {
     OLAPStatus res = OLAP_SUCCESS;
 
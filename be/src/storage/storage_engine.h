@@ -33,6 +33,7 @@
 #include <set>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "agent/status.h"
@@ -59,6 +60,7 @@ class EngineTask;
 class BlockManager;
 class MemTableFlushExecutor;
 class Tablet;
+class ThreadPool;
 class UpdateManager;
 
 // StorageEngine singleton to manage all Table pointers.
@@ -149,6 +151,8 @@ public:
     MemTableFlushExecutor* memtable_flush_executor() { return _memtable_flush_executor.get(); }
     fs::BlockManager* block_manager() { return _block_manager.get(); }
     UpdateManager* update_manager() { return _update_manager.get(); }
+    // The pool to open the segments of a rowset in parallel, nullptr if they are opened one by one.
+    ThreadPool* segment_open_thread_pool() { return _segment_open_thread_pool.get(); }
 
     bool check_rowset_id_in_unused_rowsets(const RowsetId& rowset_id);
 
@@ -218,10 +222,17 @@ private:
 
     void* _tablet_checkpoint_callback(void* arg);
 
+    // open the segments of all the tablets and load their indexes.
+    void* _segment_warm_up_callback(void* arg);
+
     void _start_clean_fd_cache();
     Status _perform_cumulative_compaction(DataDir* data_dir);
     Status _perform_base_compaction(DataDir* data_dir);
     Status _perform_update_compaction(DataDir* data_dir);
+    // The seconds to wait before the next update compaction of |data_dir|, so that the bytes compacted by the update
+    // compactions of a disk don't exceed config::update_compaction_per_disk_bytes_per_second.
+    int64_t _update_compaction_wait_seconds(DataDir* data_dir);
+    void _consume_update_compaction_budget(DataDir* data_dir, size_t bytes);
     OLAPStatus _start_trash_sweep(double* usage);
     void _start_disk_stat_monitor();
 
@@ -289,6 +300,9 @@ private:
     std::vector<std::thread> _cumulative_compaction_threads;
     // threads to run update compaction
     std::vector<std::thread> _update_compaction_threads;
+    // The time before which the next update compaction of a disk should not start.
+    std::mutex _update_compaction_budget_lock;
+    std::unordered_map<DataDir*, int64_t> _update_compaction_next_start_ms;
     // threads to clean all file descriptor not actively in use
     std::thread _fd_cache_clean_thread;
     std::vector<std::thread> _path_gc_threads;
@@ -296,6 +310,8 @@ private:
     std::vector<std::thread> _path_scan_threads;
     // threads to run tablet checkpoint
     std::vector<std::thread> _tablet_checkpoint_threads;
+    // thread to warm up the segments after start
+    std::thread _segment_warm_up_thread;
 
     // For tablet and disk-stat report
     std::mutex _report_mtx;
@@ -316,6 +332,8 @@ private:
 
     std::unique_ptr<UpdateManager> _update_manager;
 
+    std::unique_ptr<ThreadPool> _segment_open_thread_pool;
+
     HeartbeatFlags* _heartbeat_flags = nullptr;
 
     DISALLOW_COPY_AND_ASSIGN(StorageEngine);
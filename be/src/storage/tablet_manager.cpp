@@ -69,6 +69,7 @@ TabletManager::TabletManager(MemTracker* mem_tracker, int32_t tablet_map_lock_sh
     _tablets_shards.resize(_tablets_shards_size);
     for (auto& tablets_shard : _tablets_shards) {
         tablets_shard.lock = std::make_unique<std::shared_mutex>();
+        tablets_shard.snapshot_lock = std::make_unique<std::mutex>();
     }
 }
 
@@ -190,7 +191,7 @@ Status TabletManager::create_tablet(const TCreateTabletReq& request, std::vector
     int32_t schema_hash = request.tablet_schema.schema_hash;
     LOG(INFO) << "Creating tablet_id=" << tablet_id << " schema_hash=" << schema_hash;
 
-    std::unique_lock wlock(_get_tablets_shard_lock(tablet_id));
+    ShardWriteLock wlock(_get_tablets_shard(tablet_id));
     // Make create_tablet operation to be idempotent:
     // 1. Return true if tablet with same tablet_id and schema_hash exist;
     //           false if tablet with same tablet_id but different schema_hash exist.
@@ -424,7 +425,7 @@ TabletSharedPtr TabletManager::_create_tablet_meta_and_dir_unlocked(const TCreat
 }
 
 Status TabletManager::drop_tablet(TTabletId tablet_id, SchemaHash schema_hash, bool keep_state) {
-    std::unique_lock wlock(_get_tablets_shard_lock(tablet_id));
+    ShardWriteLock wlock(_get_tablets_shard(tablet_id));
     return _drop_tablet_unlocked(tablet_id, schema_hash, keep_state);
 }
 
@@ -517,7 +518,7 @@ Status TabletManager::_drop_tablet_unlocked(TTabletId tablet_id, SchemaHash sche
 
 Status TabletManager::drop_tablets_on_error_root_path(const std::vector<TabletInfo>& tablet_info_vec) {
     for (int32 i = 0; i < _tablets_shards_size; i++) {
-        std::unique_lock wlock(*_tablets_shards[i].lock);
+        ShardWriteLock wlock(_tablets_shards[i]);
         for (const TabletInfo& tablet_info : tablet_info_vec) {
             TTabletId tablet_id = tablet_info.tablet_id;
             if ((tablet_id & _tablets_shards_mask) != i) {
@@ -551,14 +552,17 @@ Status TabletManager::drop_tablets_on_error_root_path(const std::vector<TabletIn
 
 TabletSharedPtr TabletManager::get_tablet(TTabletId tablet_id, SchemaHash schema_hash, bool include_deleted,
                                           std::string* err) {
-    std::shared_lock rlock(_get_tablets_shard_lock(tablet_id));
-    return _get_tablet_unlocked(tablet_id, schema_hash, include_deleted, err);
+    return _check_tablet(_get_tablet_from_snapshot(tablet_id, schema_hash), tablet_id, schema_hash, include_deleted,
+                         err);
 }
 
 TabletSharedPtr TabletManager::_get_tablet_unlocked(TTabletId tablet_id, SchemaHash schema_hash, bool include_deleted,
                                                     std::string* err) {
-    TabletSharedPtr tablet;
-    tablet = _get_tablet_unlocked(tablet_id, schema_hash);
+    return _check_tablet(_get_tablet_unlocked(tablet_id, schema_hash), tablet_id, schema_hash, include_deleted, err);
+}
+
+TabletSharedPtr TabletManager::_check_tablet(TabletSharedPtr tablet, TTabletId tablet_id, SchemaHash schema_hash,
+                                             bool include_deleted, std::string* err) {
     if (tablet == nullptr && include_deleted) {
         std::shared_lock rlock(_shutdown_tablets_lock);
         for (auto& deleted_tablet : _shutdown_tablets) {
@@ -590,8 +594,7 @@ TabletSharedPtr TabletManager::_get_tablet_unlocked(TTabletId tablet_id, SchemaH
 
 TabletSharedPtr TabletManager::get_tablet(TTabletId tablet_id, SchemaHash schema_hash, TabletUid tablet_uid,
                                           bool include_deleted, std::string* err) {
-    std::shared_lock rlock(_get_tablets_shard_lock(tablet_id));
-    TabletSharedPtr tablet = _get_tablet_unlocked(tablet_id, schema_hash, include_deleted, err);
+    TabletSharedPtr tablet = get_tablet(tablet_id, schema_hash, include_deleted, err);
     if (tablet != nullptr && tablet->tablet_uid() == tablet_uid) {
         return tablet;
     }
@@ -651,18 +654,18 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType com
     // only do compaction if compaction #rowset > 1
     uint32_t highest_score = 1;
     TabletSharedPtr best_tablet;
-    for (const auto& tablets_shard : _tablets_shards) {
-        std::shared_lock rlock(*tablets_shard.lock);
-        for (const auto& tablet_map : tablets_shard.tablet_map) {
-            for (const TabletSharedPtr& tablet_ptr : tablet_map.second.table_arr) {
+    for (auto& tablets_shard : _tablets_shards) {
+        TabletSnapshotPtr snapshot = _get_tablets_snapshot(tablets_shard);
+        for (const auto& [tablet_id, tablets] : *snapshot) {
+            for (const TabletSharedPtr& tablet_ptr : tablets) {
                 if (tablet_ptr->keys_type() == PRIMARY_KEYS) {
                     continue;
                 }
                 AlterTabletTaskSharedPtr cur_alter_task = tablet_ptr->alter_task();
                 if (cur_alter_task != nullptr && cur_alter_task->alter_state() != ALTER_FINISHED &&
                     cur_alter_task->alter_state() != ALTER_FAILED) {
-                    TabletSharedPtr related_tablet = _get_tablet_unlocked(cur_alter_task->related_tablet_id(),
-                                                                          cur_alter_task->related_schema_hash());
+                    TabletSharedPtr related_tablet = _get_tablet_from_snapshot(
+                            cur_alter_task->related_tablet_id(), cur_alter_task->related_schema_hash());
                     if (related_tablet != nullptr && tablet_ptr->creation_time() > related_tablet->creation_time()) {
                         // Current tablet is newly created during schema-change or rollup, skip it
                         continue;
@@ -736,18 +739,18 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType com
 TabletSharedPtr TabletManager::find_best_tablet_to_do_update_compaction(DataDir* data_dir) {
     int64_t highest_score = 0;
     TabletSharedPtr best_tablet;
-    for (const auto& tablets_shard : _tablets_shards) {
-        std::shared_lock rlock(*tablets_shard.lock);
-        for (const auto& tablet_map : tablets_shard.tablet_map) {
-            for (const TabletSharedPtr& tablet_ptr : tablet_map.second.table_arr) {
+    for (auto& tablets_shard : _tablets_shards) {
+        TabletSnapshotPtr snapshot = _get_tablets_snapshot(tablets_shard);
+        for (const auto& [tablet_id, tablets] : *snapshot) {
+            for (const TabletSharedPtr& tablet_ptr : tablets) {
                 if (tablet_ptr->keys_type() != PRIMARY_KEYS) {
                     continue;
                 }
                 AlterTabletTaskSharedPtr cur_alter_task = tablet_ptr->alter_task();
                 if (cur_alter_task != nullptr && cur_alter_task->alter_state() != ALTER_FINISHED &&
                     cur_alter_task->alter_state() != ALTER_FAILED) {
-                    TabletSharedPtr related_tablet = _get_tablet_unlocked(cur_alter_task->related_tablet_id(),
-                                                                          cur_alter_task->related_schema_hash());
+                    TabletSharedPtr related_tablet = _get_tablet_from_snapshot(
+                            cur_alter_task->related_tablet_id(), cur_alter_task->related_schema_hash());
                     if (related_tablet != nullptr && tablet_ptr->creation_time() > related_tablet->creation_time()) {
                         // Current tablet is newly created during schema-change or rollup, skip it
                         continue;
@@ -789,7 +792,7 @@ TabletSharedPtr TabletManager::find_best_tablet_to_do_update_compaction(DataDir*
 Status TabletManager::load_tablet_from_meta(DataDir* data_dir, TTabletId tablet_id, TSchemaHash schema_hash,
                                             const std::string& meta_binary, bool update_meta, bool force, bool restore,
                                             bool check_path) {
-    std::unique_lock wlock(_get_tablets_shard_lock(tablet_id));
+    // The tablet is created and initialized out of the lock, so the tablets of a shard can be loaded concurrently.
     TabletMetaSharedPtr tablet_meta(new TabletMeta(_mem_tracker));
     if (tablet_meta->deserialize(meta_binary) != OLAP_SUCCESS) {
         LOG(WARNING) << "Fail to load tablet because can not parse meta_binary string. "
@@ -845,6 +848,13 @@ Status TabletManager::load_tablet_from_meta(DataDir* data_dir, TTabletId tablet_
         LOG(WARNING) << "Fail to init tablet, tablet=" << tablet->full_name();
         return Status::InternalError("tablet init failed");
     }
+
+    ShardWriteLock wlock(_get_tablets_shard(tablet_id));
+    // check again under the lock, the path may have been removed by the gc of the unused paths in between
+    if (check_path && !Env::Default()->path_exists(tablet->tablet_path()).ok()) {
+        LOG(WARNING) << "Fail to create table, tablet path not exists, path=" << tablet->tablet_path();
+        return Status::NotFound("tablet path not exists");
+    }
     if (tablet->tablet_state() == TABLET_SHUTDOWN) {
         LOG(INFO) << "Fail to load shutdown tablet_id=" << tablet_id << " schema_hash=" << schema_hash
                   << " path=" << data_dir->path();
@@ -945,16 +955,16 @@ Status TabletManager::report_all_tablets_info(std::map<TTabletId, TTablet>* tabl
 
     StarRocksMetrics::instance()->report_all_tablets_requests_total.increment(1);
 
-    for (const auto& tablets_shard : _tablets_shards) {
-        std::shared_lock rlock(*tablets_shard.lock);
-        for (const auto& item : tablets_shard.tablet_map) {
-            if (item.second.table_arr.empty()) {
+    for (auto& tablets_shard : _tablets_shards) {
+        TabletSnapshotPtr snapshot = _get_tablets_snapshot(tablets_shard);
+        for (const auto& item : *snapshot) {
+            if (item.second.empty()) {
                 continue;
             }
 
             uint64_t tablet_id = item.first;
             TTablet t_tablet;
-            for (const TabletSharedPtr& tablet_ptr : item.second.table_arr) {
+            for (const TabletSharedPtr& tablet_ptr : item.second) {
                 TTabletInfo tablet_info;
                 tablet_ptr->build_tablet_report_info(&tablet_info);
 
@@ -985,13 +995,13 @@ Status TabletManager::start_trash_sweep() {
         for (auto& tablets_shard : _tablets_shards) {
             tablet_map_t& tablet_map = tablets_shard.tablet_map;
             {
-                std::shared_lock rlock(*tablets_shard.lock);
-                for (auto& item : tablet_map) {
+                TabletSnapshotPtr snapshot = _get_tablets_snapshot(tablets_shard);
+                for (const auto& item : *snapshot) {
                     // try to clean empty item
-                    if (item.second.table_arr.empty()) {
+                    if (item.second.empty()) {
                         tablets_to_clean.push_back(item.first);
                     }
-                    for (const TabletSharedPtr& tablet : item.second.table_arr) {
+                    for (const TabletSharedPtr& tablet : item.second) {
                         all_tablets.push_back(tablet);
                     }
                 }
@@ -1004,7 +1014,7 @@ Status TabletManager::start_trash_sweep() {
             all_tablets.clear();
 
             if (!tablets_to_clean.empty()) {
-                std::unique_lock wlock(*tablets_shard.lock);
+                ShardWriteLock wlock(tablets_shard);
                 // clean empty tablet id item
                 for (const auto& tablet_id_to_clean : tablets_to_clean) {
                     auto& item = tablet_map[tablet_id_to_clean];
@@ -1176,11 +1186,10 @@ bool TabletManager::try_schema_change_lock(TTabletId tablet_id) {
 void TabletManager::update_root_path_info(std::map<std::string, DataDirInfo>* path_map, size_t* tablet_count) {
     DCHECK(tablet_count != nullptr);
     *tablet_count = 0;
-    for (const auto& tablets_shard : _tablets_shards) {
-        std::shared_lock rlock(*tablets_shard.lock);
-        for (const auto& entry : tablets_shard.tablet_map) {
-            const TableInstances& instance = entry.second;
-            for (const auto& tablet : instance.table_arr) {
+    for (auto& tablets_shard : _tablets_shards) {
+        TabletSnapshotPtr snapshot = _get_tablets_snapshot(tablets_shard);
+        for (const auto& entry : *snapshot) {
+            for (const auto& tablet : entry.second) {
                 ++(*tablet_count);
                 int64_t data_size = tablet->tablet_footprint();
                 auto iter = path_map->find(tablet->data_dir()->path());
@@ -1205,10 +1214,10 @@ void TabletManager::get_partition_related_tablets(int64_t partition_id, std::set
 void TabletManager::do_tablet_meta_checkpoint(DataDir* data_dir) {
     std::vector<TabletSharedPtr> related_tablets;
     {
-        for (const auto& tablets_shard : _tablets_shards) {
-            std::shared_lock rlock(*tablets_shard.lock);
-            for (const auto& tablet_map : tablets_shard.tablet_map) {
-                for (const TabletSharedPtr& tablet_ptr : tablet_map.second.table_arr) {
+        for (auto& tablets_shard : _tablets_shards) {
+            TabletSnapshotPtr snapshot = _get_tablets_snapshot(tablets_shard);
+            for (const auto& [tablet_id, tablets] : *snapshot) {
+                for (const TabletSharedPtr& tablet_ptr : tablets) {
                     if (tablet_ptr->tablet_state() != TABLET_RUNNING) {
                         continue;
                     }
@@ -1227,18 +1236,33 @@ void TabletManager::do_tablet_meta_checkpoint(DataDir* data_dir) {
     }
 }
 
+std::vector<TabletSharedPtr> TabletManager::get_running_tablets() {
+    std::vector<TabletSharedPtr> tablets;
+    for (auto& tablets_shard : _tablets_shards) {
+        TabletSnapshotPtr snapshot = _get_tablets_snapshot(tablets_shard);
+        for (const auto& [tablet_id, tablets] : *snapshot) {
+            for (const TabletSharedPtr& tablet_ptr : tablets) {
+                if (tablet_ptr->tablet_state() == TABLET_RUNNING && tablet_ptr->init_succeeded()) {
+                    tablets.push_back(tablet_ptr);
+                }
+            }
+        }
+    }
+    return tablets;
+}
+
 void TabletManager::_build_tablet_stat() {
     _tablet_stat_cache.clear();
-    for (const auto& tablets_shard : _tablets_shards) {
-        std::shared_lock rlock(*tablets_shard.lock);
-        for (const auto& item : tablets_shard.tablet_map) {
-            if (item.second.table_arr.empty()) {
+    for (auto& tablets_shard : _tablets_shards) {
+        TabletSnapshotPtr snapshot = _get_tablets_snapshot(tablets_shard);
+        for (const auto& item : *snapshot) {
+            if (item.second.empty()) {
                 continue;
             }
 
             TTabletStat stat;
             stat.tablet_id = item.first;
-            for (const TabletSharedPtr& tablet : item.second.table_arr) {
+            for (const TabletSharedPtr& tablet : item.second) {
                 // TODO(lingbin): if it is nullptr, why is it not deleted?
                 if (tablet == nullptr) {
                     continue;
@@ -1426,6 +1450,52 @@ TabletSharedPtr TabletManager::_get_tablet_unlocked(TTabletId tablet_id, SchemaH
     return nullptr;
 }
 
+TabletSharedPtr TabletManager::_get_tablet_from_snapshot(TTabletId tablet_id, SchemaHash schema_hash) {
+    tablets_shard& shard = _get_tablets_shard(tablet_id);
+    TabletSnapshotPtr snapshot = _get_tablets_snapshot(shard, false);
+    if (snapshot == nullptr) {
+        // the snapshot is being rebuilt, look up the map instead of waiting for it
+        std::shared_lock rlock(*shard.lock);
+        return _get_tablet_unlocked(tablet_id, schema_hash);
+    }
+    auto it = snapshot->find(tablet_id);
+    if (it != snapshot->end()) {
+        for (const TabletSharedPtr& tablet : it->second) {
+            if (tablet->equal(tablet_id, schema_hash)) {
+                return tablet;
+            }
+        }
+    }
+    return nullptr;
+}
+
+TabletManager::TabletSnapshotPtr TabletManager::_get_tablets_snapshot(tablets_shard& shard, bool wait) {
+    TabletSnapshotPtr snapshot = std::atomic_load(&shard.snapshot);
+    if (snapshot != nullptr) {
+        return snapshot;
+    }
+    std::unique_lock build_lock(*shard.snapshot_lock, std::defer_lock);
+    if (wait) {
+        build_lock.lock();
+    } else if (!build_lock.try_lock()) {
+        return nullptr;
+    }
+    // Build and publish it under the shared lock, so no writer can reset it in between and leave a stale one.
+    std::shared_lock rlock(*shard.lock);
+    snapshot = std::atomic_load(&shard.snapshot);
+    if (snapshot != nullptr) {
+        return snapshot;
+    }
+    auto new_snapshot = std::make_shared<tablet_snapshot_t>(shard.tablet_map.size());
+    for (const auto& [tablet_id, instances] : shard.tablet_map) {
+        new_snapshot->emplace(tablet_id, std::vector<TabletSharedPtr>(instances.table_arr.begin(),
+                                                                     instances.table_arr.end()));
+    }
+    snapshot = std::move(new_snapshot);
+    std::atomic_store(&shard.snapshot, snapshot);
+    return snapshot;
+}
+
 void TabletManager::_add_tablet_to_partition(const Tablet& tablet) {
     std::unique_lock wlock(_partition_tablet_map_lock);
     _partition_tablet_map[tablet.partition_id()].insert(tablet.get_tablet_info());
@@ -1529,7 +1599,7 @@ Status TabletManager::create_tablet_from_snapshot(DataDir* store, TTabletId tabl
         return Status::InternalError("tablet state is shutdown");
     }
 
-    std::unique_lock l(_get_tablets_shard_lock(tablet_id));
+    ShardWriteLock l(_get_tablets_shard(tablet_id));
     if (_get_tablet_unlocked(tablet_id, schema_hash, true, nullptr) != nullptr) {
         return Status::InternalError("tablet already exist");
     }
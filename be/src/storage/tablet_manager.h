@@ -24,6 +24,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
@@ -127,6 +128,9 @@ public:
 
     void do_tablet_meta_checkpoint(DataDir* data_dir);
 
+    // Returns the running tablets.
+    std::vector<TabletSharedPtr> get_running_tablets();
+
     void register_clone_tablet(int64_t tablet_id);
     void unregister_clone_tablet(int64_t tablet_id);
 
@@ -151,6 +155,11 @@ private:
     TabletSharedPtr _get_tablet_unlocked(TTabletId tablet_id, SchemaHash schema_hash);
     TabletSharedPtr _get_tablet_unlocked(TTabletId tablet_id, SchemaHash schema_hash, bool include_deleted,
                                          std::string* err);
+    // Look up the tablet in the snapshot of its shard, without holding the lock of the shard.
+    TabletSharedPtr _get_tablet_from_snapshot(TTabletId tablet_id, SchemaHash schema_hash);
+    // Fall back to the shutdown tablets if |tablet| is nullptr and |include_deleted|, and reject the unused tablet.
+    TabletSharedPtr _check_tablet(TabletSharedPtr tablet, TTabletId tablet_id, SchemaHash schema_hash,
+                                  bool include_deleted, std::string* err);
 
     TabletSharedPtr _internal_create_tablet_unlocked(const AlterTabletType alter_type, const TCreateTabletReq& request,
                                                      const bool is_schema_change, const Tablet* base_tablet,
@@ -184,13 +193,40 @@ private:
     // tablet_id -> TabletInstances
     using tablet_map_t = std::unordered_map<int64_t, TableInstances>;
 
+    // tablet_id -> the tablets in TableInstances::table_arr, the ids of the empty instances are kept too
+    using tablet_snapshot_t = std::unordered_map<int64_t, std::vector<TabletSharedPtr>>;
+    using TabletSnapshotPtr = std::shared_ptr<const tablet_snapshot_t>;
+
     struct tablets_shard {
         // protect tablet_map, tablets_under_clone
         std::unique_ptr<std::shared_mutex> lock;
         tablet_map_t tablet_map;
         std::set<int64_t> tablets_under_clone;
+        // An immutable copy of tablet_map, read by std::atomic_load without the lock so the lookups of the queries
+        // and the long iterations of the reports never block on the writers, nor block the writers. It's reset by
+        // ShardWriteLock when tablet_map is modified, and rebuilt by the next reader under the shared lock, so it
+        // never misses a modification visible to the readers of tablet_map. A reader holds the snapshot it loaded
+        // until it's done, the replaced snapshots are freed by the last one.
+        TabletSnapshotPtr snapshot;
+        // serialize the rebuilding of snapshot
+        std::unique_ptr<std::mutex> snapshot_lock;
+    };
+
+    // The exclusive lock of a shard to modify its tablet_map, which resets the snapshot before it's released.
+    class ShardWriteLock {
+    public:
+        explicit ShardWriteLock(tablets_shard& shard) : _shard(shard), _lock(*shard.lock) {}
+        ~ShardWriteLock() { std::atomic_store(&_shard.snapshot, TabletSnapshotPtr()); }
+
+    private:
+        tablets_shard& _shard;
+        std::unique_lock<std::shared_mutex> _lock;
     };
 
+    // Return the snapshot of |shard|, rebuild it if it has been reset. If |wait| is false, return nullptr instead of
+    // waiting for the rebuilding by another thread.
+    TabletSnapshotPtr _get_tablets_snapshot(tablets_shard& shard, bool wait = true);
+
     MemTracker* _mem_tracker = nullptr;
 
     const int32_t _tablets_shards_size;
@@ -763,7 +763,7 @@ Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_i
     for (auto& rssid_delvec : delvecs) {
         tsid.segment_id = rssid_delvec.first;
         auto dv_key = encode_del_vector_key(tsid.tablet_id, tsid.segment_id, version.major());
-        auto dv_value = rssid_delvec.second->save();
+        auto dv_value = rssid_delvec.second->save_delta();
         st = batch.Put(handle, dv_key, dv_value);
         if (!st.ok()) {
             LOG(WARNING) << "rowset_commit failed, rocksdb.batch.put failed";
@@ -818,6 +818,9 @@ Status TabletMetaManager::get_del_vector(OlapMeta* meta, TTabletId tablet_id, ui
     Status st;
     bool found = false;
     bool first = true;
+    // The deltas from the requested version back to the last full delete vector, newest first.
+    std::vector<std::pair<int64_t, std::string>> deltas;
+    int64_t base_version = 0;
     auto traverse_versions = [&](std::string_view key, std::string_view value) -> bool {
         int64_t cv = decode_del_vector_key_version(key);
         VLOG(3) << "traverse version got version: " << cv;
@@ -825,15 +828,33 @@ Status TabletMetaManager::get_del_vector(OlapMeta* meta, TTabletId tablet_id, ui
             *latest_version = cv;
             first = false;
         }
-        if (version >= cv) {
-            st = delvec->load(cv, value.data(), value.size());
-            found = true;
+        if (version < cv) {
+            return true;
+        }
+        if (!deltas.empty() && cv != base_version) {
+            st = Status::Corruption(strings::Substitute(
+                    "base version $0 of delete vector not found tablet:$1 segment:$2", base_version, tablet_id,
+                    segment_id));
             return false;
         }
-        return true;
+        if (DelVector::is_delta(value.data(), value.size(), &base_version)) {
+            deltas.emplace_back(cv, std::string(value.data(), value.size()));
+            return true;
+        }
+        st = delvec->load(cv, value.data(), value.size());
+        found = true;
+        return false;
     };
-    st = meta->iterate_range(META_COLUMN_FAMILY_INDEX, lower, upper, traverse_versions);
-    if (!st.ok()) {
+    auto iterate_st = meta->iterate_range(META_COLUMN_FAMILY_INDEX, lower, upper, traverse_versions);
+    if (iterate_st.ok() && st.ok() && !found && !deltas.empty()) {
+        st = Status::Corruption(strings::Substitute("base version $0 of delete vector not found tablet:$1 segment:$2",
+                                                    base_version, tablet_id, segment_id));
+    }
+    for (auto it = deltas.rbegin(); found && st.ok() && it != deltas.rend(); ++it) {
+        st = delvec->apply_delta(it->first, it->second.data(), it->second.size());
+    }
+    if (!iterate_st.ok() || !st.ok()) {
+        st = iterate_st.ok() ? st : iterate_st;
         LOG(WARNING) << "fail to iterate rockdb delvecs. tablet_id=" << tablet_id << " segment_id=" << segment_id
                      << " error_code=" << st.to_string();
         return st;
@@ -854,6 +875,9 @@ StatusOr<DeleteVectorList> TabletMetaManager::list_del_vector(OlapMeta* meta, TT
     std::string lower = encode_del_vector_key(tablet_id, 0, INT64_MAX);
     std::string upper = encode_del_vector_key(tablet_id, UINT32_MAX, 0);
     uint32_t last_segment_id = UINT32_MAX;
+    // The delete vector of the version to keep of the current segment is a delta, so its base versions are kept too,
+    // until a full delete vector is met.
+    bool keep_base = false;
     auto st = meta->iterate_range(META_COLUMN_FAMILY_INDEX, lower, upper,
                                   [&](std::string_view key, std::string_view value) -> bool {
                                       TTabletId dummy;
@@ -861,8 +885,15 @@ StatusOr<DeleteVectorList> TabletMetaManager::list_del_vector(OlapMeta* meta, TT
                                       int64_t version;
                                       decode_del_vector_key(key, &dummy, &segment_id, &version);
                                       DCHECK_EQ(tablet_id, dummy);
-                                      if (segment_id != last_segment_id && version < max_version) {
-                                          ret.emplace_back(segment_id, version);
+                                      if (segment_id == last_segment_id && !keep_base) {
+                                          return true;
+                                      }
+                                      if (version < max_version) {
+                                          int64_t base_version = 0;
+                                          keep_base = DelVector::is_delta(value.data(), value.size(), &base_version);
+                                          if (!keep_base) {
+                                              ret.emplace_back(segment_id, version);
+                                          }
                                           last_segment_id = segment_id;
                                       }
                                       return true;
@@ -286,6 +286,8 @@ void TabletColumn::init_from_pb(const ColumnPB& column) {
     } else {
         _has_bitmap_index = false;
     }
+    _has_ngram_bf_index = column.has_ngram_bf_index();
+    _has_inverted_index = column.has_inverted_index();
     _has_referenced_column = column.has_referenced_column_id();
     if (_has_referenced_column) {
         _referenced_column_id = column.referenced_column_id();
@@ -328,6 +330,12 @@ void TabletColumn::to_schema_pb(ColumnPB* column) const {
     if (_has_bitmap_index) {
         column->set_has_bitmap_index(_has_bitmap_index);
     }
+    if (_has_ngram_bf_index) {
+        column->set_has_ngram_bf_index(_has_ngram_bf_index);
+    }
+    if (_has_inverted_index) {
+        column->set_has_inverted_index(_has_inverted_index);
+    }
     for (const auto& sub_column : _sub_columns) {
         sub_column.to_schema_pb(column->add_children_columns());
     }
@@ -376,6 +384,7 @@ void TabletSchema::init_from_pb(const TabletSchemaPB& schema) {
         _bf_fpp = BLOOM_FILTER_DEFAULT_FPP;
     }
     _is_in_memory = schema.is_in_memory();
+    _has_row_store = schema.has_row_store();
 }
 
 void TabletSchema::to_schema_pb(TabletSchemaPB* tablet_meta_pb) const {
@@ -392,6 +401,7 @@ void TabletSchema::to_schema_pb(TabletSchemaPB* tablet_meta_pb) const {
     }
     tablet_meta_pb->set_next_column_unique_id(_next_column_unique_id);
     tablet_meta_pb->set_is_in_memory(_is_in_memory);
+    tablet_meta_pb->set_has_row_store(_has_row_store);
 }
 
 bool TabletSchema::contains_format_v1_column() const {
@@ -425,6 +435,19 @@ std::unique_ptr<TabletSchema> TabletSchema::convert_to_format(DataFormatVersion
     return schema;
 }
 
+std::unique_ptr<TabletSchema> TabletSchema::create_partial(const std::vector<uint32_t>& column_ids) const {
+    TabletSchemaPB schema_pb;
+    to_schema_pb(&schema_pb);
+    schema_pb.clear_column();
+    for (uint32_t cid : column_ids) {
+        _cols[cid].to_schema_pb(schema_pb.add_column());
+    }
+    schema_pb.set_has_row_store(false);
+    auto schema = std::make_unique<TabletSchema>();
+    schema->init_from_pb(schema_pb);
+    return schema;
+}
+
 size_t TabletSchema::row_size() const {
     size_t size = 0;
     for (auto& column : _cols) {
@@ -482,6 +505,8 @@ bool operator==(const TabletColumn& a, const TabletColumn& b) {
         if (a._referenced_column != b._referenced_column) return false;
     }
     if (a._has_bitmap_index != b._has_bitmap_index) return false;
+    if (a._has_ngram_bf_index != b._has_ngram_bf_index) return false;
+    if (a._has_inverted_index != b._has_inverted_index) return false;
     return true;
 }
 
@@ -507,6 +532,7 @@ bool operator==(const TabletSchema& a, const TabletSchema& b) {
         if (std::abs(a._bf_fpp - b._bf_fpp) > 1e-6) return false;
     }
     if (a._is_in_memory != b._is_in_memory) return false;
+    if (a._has_row_store != b._has_row_store) return false;
     return true;
 }
 
@@ -518,7 +544,8 @@ std::string TabletColumn::debug_string() const {
        << ",is_decimal=" << _is_decimal << ",precision=" << _precision << ",frac=" << _scale << ",length=" << _length
        << ",index_length=" << _index_length << ",is_bf_column=" << _is_bf_column
        << ",has_reference_column=" << _has_referenced_column << ",referenced_column_id=" << _referenced_column_id
-       << ",referenced_column=" << _referenced_column << ",has_bitmap_index=" << _has_bitmap_index << ")";
+       << ",referenced_column=" << _referenced_column << ",has_bitmap_index=" << _has_bitmap_index
+       << ",has_ngram_bf_index=" << _has_ngram_bf_index << ",has_inverted_index=" << _has_inverted_index << ")";
     return ss.str();
 }
 
@@ -539,7 +566,7 @@ std::string TabletSchema::debug_string() const {
        << ",num_null_columns=" << _num_null_columns << ",num_short_key_columns=" << _num_short_key_columns
        << ",num_rows_per_row_block=" << _num_rows_per_row_block << ",compress_kind=" << _compress_kind
        << ",next_column_unique_id=" << _next_column_unique_id << ",has_bf_fpp=" << _has_bf_fpp << ",bf_fpp=" << _bf_fpp
-       << ",is_in_memory=" << _is_in_memory;
+       << ",is_in_memory=" << _is_in_memory << ",has_row_store=" << _has_row_store;
     return ss.str();
 }
 
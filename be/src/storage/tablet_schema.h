@@ -55,6 +55,8 @@ public:
     inline bool is_nullable() const { return _is_nullable; }
     inline bool is_bf_column() const { return _is_bf_column; }
     inline bool has_bitmap_index() const { return _has_bitmap_index; }
+    inline bool has_ngram_bf_index() const { return _has_ngram_bf_index; }
+    inline bool has_inverted_index() const { return _has_inverted_index; }
     bool has_default_value() const { return _has_default_value; }
     std::string default_value() const { return _default_value; }
     bool has_reference_column() const { return _has_referenced_column; }
@@ -118,6 +120,8 @@ private:
     std::string _referenced_column;
 
     bool _has_bitmap_index = false;
+    bool _has_ngram_bf_index = false;
+    bool _has_inverted_index = false;
 
     // for hidded column, which is transparent to user
     bool _visible = true;
@@ -147,12 +151,18 @@ public:
     inline size_t next_column_unique_id() const { return _next_column_unique_id; }
     inline bool is_in_memory() const { return _is_in_memory; }
     inline void set_is_in_memory(bool is_in_memory) { _is_in_memory = is_in_memory; }
+    // Whether the segments have a row store column, see SegmentWriter.
+    inline bool has_row_store() const { return _has_row_store; }
 
     bool contains_format_v1_column() const;
     bool contains_format_v2_column() const;
 
     std::unique_ptr<TabletSchema> convert_to_format(DataFormatVersion format) const;
 
+    // The schema of the columns of |column_ids|, which are ascending and include all the key columns, for the
+    // segments of a partial update. It has no row store, which is written once the segments are completed.
+    std::unique_ptr<TabletSchema> create_partial(const std::vector<uint32_t>& column_ids) const;
+
     std::string debug_string() const;
 
     int64_t mem_usage() const {
@@ -184,6 +194,7 @@ private:
     bool _has_bf_fpp = false;
     double _bf_fpp = 0;
     bool _is_in_memory = false;
+    bool _has_row_store = false;
 };
 
 bool operator==(const TabletSchema& a, const TabletSchema& b);
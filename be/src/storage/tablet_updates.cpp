@@ -5,8 +5,10 @@
 #include <time.h>
 
 #include <algorithm>
+#include <map>
 
 #include "common/status.h"
+#include "env/env.h"
 #include "gen_cpp/MasterService_types.h"
 #include "gen_cpp/olap_file.pb.h"
 #include "gutil/stl_util.h"
@@ -16,10 +18,12 @@
 #include "runtime/exec_env.h"
 #include "storage/del_vector.h"
 #include "storage/primary_key_encoder.h"
+#include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_meta_manager.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/rowset/rowset_writer_context.h"
+#include "storage/rowset/segment_v2/segment.h"
 #include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/rowset_update_state.h"
 #include "storage/snapshot_meta.h"
@@ -33,6 +37,7 @@
 #include "storage/vectorized/rowset_merger.h"
 #include "util/defer_op.h"
 #include "util/pretty_printer.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -628,6 +633,7 @@ void TabletUpdates::do_apply() {
     bool first = true;
     while (!_apply_stopped) {
         const EditVersionInfo* version_info_apply = nullptr;
+        const EditVersionInfo* next_version_info = nullptr;
         {
             std::lock_guard rl(_lock);
             if (_apply_version_idx + 1 >= _versions.size()) {
@@ -640,6 +646,17 @@ void TabletUpdates::do_apply() {
             }
             // we make sure version_info_apply will never be deleted before apply finished
             version_info_apply = _versions[_apply_version_idx + 1].get();
+            if (_apply_version_idx + 2 < _versions.size()) {
+                next_version_info = _versions[_apply_version_idx + 2].get();
+            }
+        }
+        // The RowsetUpdateState of this version may be still loading by the prefetch task, wait for it to
+        // release the state, then prefetch the next version while applying this one.
+        if (_apply_prefetch_token != nullptr) {
+            _apply_prefetch_token->wait();
+        }
+        if (next_version_info != nullptr) {
+            _prefetch_update_state(*next_version_info);
         }
         if (version_info_apply->deltas.size() > 0) {
             int64_t duration_ns = 0;
@@ -665,6 +682,9 @@ void TabletUpdates::do_apply() {
             break;
         }
     }
+    if (_apply_prefetch_token != nullptr) {
+        _apply_prefetch_token->wait();
+    }
     std::lock_guard<std::mutex> lg(_apply_running_lock);
     CHECK(_apply_running) << "illegal state: _apply_running should be true";
     _apply_running = false;
@@ -679,6 +699,41 @@ void TabletUpdates::_stop_and_wait_apply_done() {
     }
 }
 
+void TabletUpdates::_prefetch_update_state(const EditVersionInfo& version_info) {
+    if (!config::enable_apply_prefetch || version_info.deltas.empty()) {
+        return;
+    }
+    RowsetSharedPtr rowset = _get_rowset(version_info.deltas[0]);
+    if (rowset == nullptr) {
+        return;
+    }
+    auto manager = StorageEngine::instance()->update_manager();
+    if (_apply_prefetch_token == nullptr) {
+        // Not the apply thread pool, whose threads could all be waiting for the prefetch tasks.
+        _apply_prefetch_token = manager->index_thread_pool()->new_token(ThreadPool::ExecutionMode::SERIAL);
+    }
+    auto tablet_id = _tablet.tablet_id();
+    auto& cache = manager->update_state_cache();
+    auto state_entry = cache.get_or_create(Substitute("$0_$1", tablet_id, rowset->rowset_id().to_string()));
+    state_entry->update_expire_time(MonotonicMillis() + manager->get_cache_expire_ms());
+    auto st = _apply_prefetch_token->submit_func([&cache, state_entry, tablet_id, rowset]() {
+        auto& state = state_entry->value();
+        auto st = state.load(tablet_id, rowset.get());
+        cache.update_object_size(state_entry, state.memory_usage());
+        if (st.ok()) {
+            cache.release(state_entry);
+        } else {
+            // remove the failed state, so that it's loaded again when the rowset commit is applied.
+            LOG(WARNING) << "prefetch rowset update state failed tablet:" << tablet_id
+                         << " rowset:" << rowset->rowset_id().to_string() << " " << st;
+            cache.remove(state_entry);
+        }
+    });
+    if (!st.ok()) {
+        cache.release(state_entry);
+    }
+}
+
 void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     // NOTE: after commit, apply must success or fatal crash
     int64_t t_start = MonotonicMillis();
@@ -716,6 +771,19 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
         _set_error();
         return;
     }
+    if (rowset->rowset_meta()->is_partial_update()) {
+        RowsetSharedPtr full_rowset;
+        st = _complete_partial_update_rowset(rowset_id, rowset, index, state, &full_rowset);
+        if (!st.ok()) {
+            LOG(ERROR) << "_apply_rowset_commit error: complete partial update rowset failed: " << st << " "
+                       << debug_string();
+            manager->update_state_cache().remove(state_entry);
+            manager->index_cache().release(index_entry);
+            _set_error();
+            return;
+        }
+        rowset = std::move(full_rowset);
+    }
     int64_t t_load = MonotonicMillis();
 
     // 3. generate delvec
@@ -728,6 +796,7 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     size_t total_del = 0;
     size_t new_del = 0;
     auto& upserts = state.upserts();
+    std::unique_lock index_lock(_index_lock);
     for (uint32_t i = 0; i < upserts.size(); i++) {
         if (upserts[i] != nullptr) {
             index.upsert(rowset_id + i, 0, *upserts[i], &new_deletes);
@@ -743,6 +812,7 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     for (const auto& one_delete : state.deletes()) {
         index.erase(*one_delete.get(), &new_deletes);
     }
+    index_lock.unlock();
     manager->index_cache().update_object_size(index_entry, index.memory_usage());
     // release resource
     // update state only used once, so delete it
@@ -850,6 +920,7 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
         _apply_version_changed.notify_all();
     }
     _update_total_stats(version_info.rowsets);
+    _try_save_index_snapshot();
     int64_t t_write = MonotonicMillis();
 
     size_t del_percent = _cur_total_rows == 0 ? 0 : (_cur_total_dels * 100) / _cur_total_rows;
@@ -863,6 +934,262 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     VLOG(1) << "rowset commit apply " << delvec_change_info << " " << _debug_string(true, true);
 }
 
+Status TabletUpdates::_complete_partial_update_rowset(uint32_t rowset_id, const RowsetSharedPtr& rowset,
+                                                      PrimaryIndex& index, const RowsetUpdateState& state,
+                                                      RowsetSharedPtr* full_rowset) {
+    const TabletSchema& tablet_schema = _tablet.tablet_schema();
+    const auto column_ids = rowset->rowset_meta()->partial_update_column_ids();
+    std::vector<bool> is_updated(tablet_schema.num_columns(), false);
+    for (uint32_t cid : column_ids) {
+        if (cid >= tablet_schema.num_columns()) {
+            return Status::Corruption(Substitute("bad partial update column $0 of rowset $1 tablet:$2", cid,
+                                                 rowset->rowset_id().to_string(), _tablet.tablet_id()));
+        }
+        is_updated[cid] = true;
+    }
+    vectorized::Schema schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    vectorized::Schema partial_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema, column_ids);
+    auto char_field_indexes = vectorized::ChunkHelper::get_char_field_indexes(schema);
+    RETURN_IF_ERROR(rowset->load());
+    auto beta_rowset = down_cast<BetaRowset*>(rowset.get());
+
+    // The complete rowset is written by a new rowset id, so that nothing cached of the partial one is read again.
+    RowsetWriterContext context(kDataFormatV2, config::storage_format_version);
+    context.rowset_id = StorageEngine::instance()->next_rowset_id();
+    context.tablet_uid = _tablet.tablet_uid();
+    context.tablet_id = _tablet.tablet_id();
+    context.partition_id = _tablet.partition_id();
+    context.tablet_schema_hash = _tablet.schema_hash();
+    context.rowset_type = BETA_ROWSET;
+    context.rowset_path_prefix = _tablet.tablet_path();
+    context.tablet_schema = &tablet_schema;
+    context.rowset_state = rowset->rowset_meta()->rowset_state();
+    context.segments_overlap = rowset->rowset_meta()->segments_overlap();
+    context.version = rowset->version();
+    context.txn_id = rowset->rowset_meta()->txn_id();
+    context.load_id = rowset->rowset_meta()->load_id();
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    OLAPStatus olap_status = RowsetFactory::create_rowset_writer(context, &rowset_writer);
+    if (olap_status != OLAPStatus::OLAP_SUCCESS) {
+        return Status::InternalError(Substitute("Fail to create rowset writer err=$0", olap_status));
+    }
+
+    OlapReaderStatistics stats;
+    // Read the segment |segment_id| of |rowset| by |read_schema| into |dest|.
+    auto read_segment = [&](const vectorized::Schema& read_schema, uint32_t segment_id,
+                            vectorized::Chunk* dest) -> Status {
+        ASSIGN_OR_RETURN(auto itr, beta_rowset->get_segment_iterator2(read_schema, nullptr, 0, segment_id, &stats));
+        if (itr == nullptr) {
+            return Status::OK();
+        }
+        auto chunk = vectorized::ChunkHelper::new_chunk(read_schema, config::vector_chunk_size);
+        while (true) {
+            chunk->reset();
+            auto st = itr->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            } else if (!st.ok()) {
+                itr->close();
+                return st;
+            }
+            dest->append(*chunk);
+        }
+        itr->close();
+        return Status::OK();
+    };
+
+    const auto& upserts = state.upserts();
+    const auto& deletes = state.deletes();
+    for (uint32_t i = 0; i < rowset->num_segments(); i++) {
+        const size_t num_rows = beta_rowset->segments()[i]->num_rows();
+        std::vector<PrimaryIndex::tablet_rowid_t> positions(num_rows, PrimaryIndex::kNullPosition);
+        if (upserts[i] != nullptr) {
+            std::shared_lock index_lock(_index_lock);
+            index.get(*upserts[i], &positions);
+        }
+        // the rowids of the replaced rows of every segment, with the rows replacing them
+        std::map<uint32_t, std::vector<std::pair<uint32_t, uint32_t>>> replaced_rows;
+        size_t num_replaced = 0;
+        for (uint32_t row = 0; row < num_rows; row++) {
+            if (positions[row] != PrimaryIndex::kNullPosition) {
+                replaced_rows[(uint32_t)(positions[row] >> 32)].emplace_back((uint32_t)(positions[row] & 0xffffffff),
+                                                                             row);
+                num_replaced++;
+            }
+        }
+
+        // The index of every row in |old_chunk|, which has the replaced rows followed by the default values of the
+        // new keys.
+        std::vector<uint32_t> indexes(num_rows);
+        auto old_chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows);
+        uint32_t old_index = 0;
+        for (auto& [rssid, rows] : replaced_rows) {
+            RowsetSharedPtr old_rowset;
+            uint32_t segment_index = 0;
+            {
+                std::lock_guard rowsets_lock(_rowsets_lock);
+                for (const auto& [id, r] : _rowsets) {
+                    if (rssid >= id && rssid < id + r->num_segments()) {
+                        old_rowset = r;
+                        segment_index = rssid - id;
+                        break;
+                    }
+                }
+            }
+            if (old_rowset == nullptr) {
+                return Status::InternalError(
+                        Substitute("rowset of rssid $0 not found tablet:$1", rssid, _tablet.tablet_id()));
+            }
+            RETURN_IF_ERROR(old_rowset->load());
+            std::sort(rows.begin(), rows.end());
+            std::vector<rowid_t> rowids;
+            rowids.reserve(rows.size());
+            for (const auto& [rowid, row] : rows) {
+                rowids.push_back(rowid);
+                indexes[row] = old_index++;
+            }
+            auto& segment = down_cast<BetaRowset*>(old_rowset.get())->segments()[segment_index];
+            RETURN_IF_ERROR(segment->read_rows(rowids, old_chunk.get()));
+        }
+
+        auto chunk = vectorized::ChunkHelper::new_chunk(partial_schema, num_rows);
+        if (num_replaced < num_rows) {
+            // The columns not updated are missing in the segment, so they are read as their default values.
+            auto default_chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows);
+            RETURN_IF_ERROR(read_segment(schema, i, default_chunk.get()));
+            std::vector<uint32_t> new_rows;
+            for (uint32_t row = 0; row < num_rows; row++) {
+                if (positions[row] == PrimaryIndex::kNullPosition) {
+                    new_rows.push_back(row);
+                    indexes[row] = old_index++;
+                }
+            }
+            old_chunk->append_selective(*default_chunk, new_rows.data(), 0, static_cast<uint32_t>(new_rows.size()));
+            for (size_t k = 0; k < column_ids.size(); k++) {
+                chunk->get_column_by_index(k)->append(*default_chunk->get_column_by_index(column_ids[k]), 0,
+                                                      num_rows);
+            }
+        } else {
+            RETURN_IF_ERROR(read_segment(partial_schema, i, chunk.get()));
+        }
+        if (chunk->num_rows() != num_rows) {
+            return Status::Corruption(Substitute("read $0 rows from segment $1 of rowset $2 with $3 rows",
+                                                 chunk->num_rows(), i, rowset->rowset_id().to_string(), num_rows));
+        }
+
+        auto full_chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows);
+        for (uint32_t cid = 0, k = 0; cid < tablet_schema.num_columns(); cid++) {
+            auto& column = full_chunk->get_column_by_index(cid);
+            if (is_updated[cid]) {
+                column->append(*chunk->get_column_by_index(k++), 0, num_rows);
+            } else {
+                column->append_selective(*old_chunk->get_column_by_index(cid), indexes.data(), 0, num_rows);
+            }
+        }
+        vectorized::ChunkHelper::padding_char_columns(char_field_indexes, schema, tablet_schema, full_chunk.get());
+        // The deletes are kept with the last segment, so that the complete rowset may be applied again.
+        if (i + 1 == rowset->num_segments() && !deletes.empty()) {
+            olap_status = rowset_writer->flush_chunk_with_deletes(*full_chunk, *deletes[0]);
+        } else {
+            olap_status = rowset_writer->flush_chunk(*full_chunk);
+        }
+        if (olap_status != OLAPStatus::OLAP_SUCCESS) {
+            return Status::InternalError(Substitute("Fail to write complete segment err=$0", olap_status));
+        }
+    }
+    RowsetSharedPtr new_rowset = rowset_writer->build();
+    if (new_rowset == nullptr) {
+        return Status::InternalError("Fail to build complete rowset of partial update");
+    }
+    new_rowset->rowset_meta()->set_rowset_seg_id(rowset_id);
+
+    // The complete rowset replaces the partial one by the same rssid, which is applied again as a plain upsert if
+    // the apply is interrupted later.
+    WriteBatch batch;
+    RETURN_IF_ERROR(TabletMetaManager::put_rowset_meta(_tablet.data_dir(), &batch, _tablet.tablet_id(),
+                                                       new_rowset->rowset_meta()->get_meta_pb()));
+    RETURN_IF_ERROR(_tablet.data_dir()->get_meta()->write_batch(&batch));
+    {
+        std::lock_guard rowsets_lock(_rowsets_lock);
+        _rowsets[rowset_id] = new_rowset;
+    }
+    {
+        std::lock_guard lg(_rowset_stats_lock);
+        auto iter = _rowset_stats.find(rowset_id);
+        if (iter != _rowset_stats.end()) {
+            iter->second->byte_size = new_rowset->data_disk_size();
+        }
+    }
+    StorageEngine::instance()->add_unused_rowset(rowset);
+    LOG(INFO) << "complete partial update rowset tablet:" << _tablet.tablet_id() << " rowset:" << rowset_id << " "
+              << rowset->rowset_id() << " -> " << new_rowset->rowset_id() << " #column:" << column_ids.size() << "/"
+              << tablet_schema.num_columns() << " #row:" << new_rowset->num_rows();
+    *full_rowset = std::move(new_rowset);
+    return Status::OK();
+}
+
+Status TabletUpdates::get_rows_by_keys(const vectorized::Chunk& keys, vectorized::Chunk* rows,
+                                       std::vector<uint8_t>* found) {
+    found->assign(keys.num_rows(), 0);
+    if (keys.num_rows() == 0) {
+        return Status::OK();
+    }
+    const TabletSchema& schema = _tablet.tablet_schema();
+    vector<uint32_t> pk_columns;
+    for (size_t i = 0; i < schema.num_key_columns(); i++) {
+        pk_columns.push_back((uint32_t)i);
+    }
+    vectorized::Schema pkey_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(schema, pk_columns);
+    std::unique_ptr<vectorized::Column> pk_column;
+    RETURN_IF_ERROR(PrimaryKeyEncoder::create_column(pkey_schema, &pk_column));
+    PrimaryKeyEncoder::encode(pkey_schema, keys, 0, keys.num_rows(), pk_column.get());
+
+    auto manager = StorageEngine::instance()->update_manager();
+    auto index_entry = manager->index_cache().get_or_create(_tablet.tablet_id());
+    index_entry->update_expire_time(MonotonicMillis() + manager->get_cache_expire_ms());
+    auto& index = index_entry->value();
+    auto st = index.load(&_tablet);
+    manager->index_cache().update_object_size(index_entry, index.memory_usage());
+    if (!st.ok()) {
+        manager->index_cache().remove(index_entry);
+        return st;
+    }
+    // The rowsets are taken with the positions, so that they are not removed by the apply of a compaction.
+    std::vector<PrimaryIndex::tablet_rowid_t> positions;
+    std::vector<RowsetSharedPtr> rowsets(keys.num_rows());
+    std::vector<uint32_t> segment_indexes(keys.num_rows());
+    {
+        std::shared_lock index_lock(_index_lock);
+        index.get(*pk_column, &positions);
+        std::lock_guard rowsets_lock(_rowsets_lock);
+        for (size_t i = 0; i < positions.size(); i++) {
+            if (positions[i] == PrimaryIndex::kNullPosition) {
+                continue;
+            }
+            auto rssid = (uint32_t)(positions[i] >> 32);
+            for (const auto& [rowset_id, rowset] : _rowsets) {
+                if (rssid >= rowset_id && rssid < rowset_id + rowset->num_segments()) {
+                    rowsets[i] = rowset;
+                    segment_indexes[i] = rssid - rowset_id;
+                    break;
+                }
+            }
+        }
+    }
+    manager->index_cache().release(index_entry);
+
+    for (size_t i = 0; i < positions.size(); i++) {
+        if (rowsets[i] == nullptr) {
+            continue;
+        }
+        RETURN_IF_ERROR(rowsets[i]->load());
+        auto& segment = down_cast<BetaRowset*>(rowsets[i].get())->segments()[segment_indexes[i]];
+        RETURN_IF_ERROR(segment->read_rows({(uint32_t)(positions[i] & 0xffffffff)}, rows));
+        (*found)[i] = 1;
+    }
+    return Status::OK();
+}
+
 RowsetSharedPtr TabletUpdates::_get_rowset(uint32_t rowset_id) {
     std::lock_guard<std::mutex> lg(_rowsets_lock);
     auto itr = _rowsets.find(rowset_id);
@@ -955,6 +1282,7 @@ Status TabletUpdates::_do_compaction(std::unique_ptr<CompactionInfo>* pinfo, Mem
     context.tablet_schema = &(_tablet.tablet_schema());
     context.rowset_state = COMMITTED;
     context.segments_overlap = NONOVERLAPPING;
+    context.drop_page_cache = config::drop_page_cache_of_compaction_output;
     std::unique_ptr<RowsetWriter> rowset_writer;
     OLAPStatus olap_status = RowsetFactory::create_rowset_writer(context, &rowset_writer);
     if (olap_status != OLAPStatus::OLAP_SUCCESS) {
@@ -1114,6 +1442,7 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
     size_t total_rows = 0;
     vector<std::pair<uint32_t, DelVectorPtr>> delvecs;
     vector<uint32_t> tmp_deletes;
+    std::unique_lock index_lock(_index_lock);
     for (size_t i = 0; i < _compaction_state->segment_states.size(); i++) {
         auto& sstate = _compaction_state->segment_states[i];
         total_rows += sstate.src_rssids.size();
@@ -1133,6 +1462,7 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
         sstate.pkeys.reset();
         sstate.src_rssids.clear();
     }
+    index_lock.unlock();
     // release memory
     _compaction_state.reset();
     // index may be used for later commits, so keep in cache
@@ -1181,6 +1511,7 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
         }
     }
     _update_total_stats(version_info.rowsets);
+    _try_save_index_snapshot();
     int64_t t_write = MonotonicMillis();
     size_t del_percent = _cur_total_rows == 0 ? 0 : (_cur_total_dels * 100) / _cur_total_rows;
     LOG(INFO) << "apply_compaction_commit finish tablet:" << tablet_id
@@ -1340,7 +1671,12 @@ int64_t TabletUpdates::get_compaction_score() {
         // do not do compaction
         return -1;
     }
-    return total_score;
+    return total_score + _read_amplification_score(rowsets.size());
+}
+
+int64_t TabletUpdates::_read_amplification_score(size_t num_rowsets) const {
+    const size_t max_rowsets = std::max(1, config::update_compaction_max_rowsets);
+    return num_rowsets > max_rowsets ? _compaction_cost_seek * (int64_t)(num_rowsets - max_rowsets) : 0;
 }
 
 struct CompactionEntry {
@@ -1367,7 +1703,7 @@ static string int_list_to_string(const vector<uint32_t>& l) {
 static const size_t compaction_result_bytes_threashold = 1000000000;
 static const size_t compaction_result_rows_threashold = 10000000;
 
-Status TabletUpdates::compaction(MemTracker* mem_tracker) {
+Status TabletUpdates::compaction(MemTracker* mem_tracker, size_t* input_bytes) {
     if (_error) {
         return Status::InternalError("tablet updates is in error state, cannot do compaction");
     }
@@ -1388,7 +1724,9 @@ Status TabletUpdates::compaction(MemTracker* mem_tracker) {
     size_t total_bytes = 0;
     size_t total_rows_after_compaction = 0;
     size_t total_bytes_after_compaction = 0;
-    int64_t total_score = -_compaction_cost_seek;
+    // Too many rowsets, also compact the rowsets that are not worthy of compaction by themselves.
+    const int64_t read_amplification_score = _read_amplification_score(rowsets.size());
+    int64_t total_score = -_compaction_cost_seek + read_amplification_score;
     vector<CompactionEntry> candidates;
     {
         std::lock_guard lg(_rowset_stats_lock);
@@ -1400,13 +1738,13 @@ Status TabletUpdates::compaction(MemTracker* mem_tracker) {
                                         rowsetid);
                 DCHECK(false) << msg;
                 LOG(WARNING) << msg;
-            } else if (itr->second->compaction_score > 0) {
+            } else if (itr->second->compaction_score > 0 || read_amplification_score > 0) {
                 auto& stat = *itr->second;
                 total_valid_rowsets++;
                 if (stat.num_rows == stat.num_dels) {
                     // add to compaction directly
                     info->inputs.push_back(itr->first);
-                    total_score += stat.compaction_score;
+                    total_score += std::max<int64_t>(0, stat.compaction_score);
                     total_rows += stat.num_rows;
                     total_bytes += stat.byte_size;
                     LOG(INFO) << "estimate add:" << stat.byte_size << "=" << total_bytes;
@@ -1431,7 +1769,7 @@ Status TabletUpdates::compaction(MemTracker* mem_tracker) {
             break;
         }
         info->inputs.push_back(e.rowsetid);
-        total_score += e.score_per_row * (e.num_rows - e.num_dels);
+        total_score += std::max(0.0f, e.score_per_row) * (e.num_rows - e.num_dels);
         total_rows += e.num_rows;
         total_bytes += e.bytes;
         total_rows_after_compaction = new_rows;
@@ -1462,6 +1800,9 @@ Status TabletUpdates::compaction(MemTracker* mem_tracker) {
               << int_list_to_string(info->inputs) << " #rows:" << total_rows << "->" << total_rows_after_compaction
               << " bytes:" << PrettyPrinter::print(total_bytes, TUnit::BYTES) << "->"
               << PrettyPrinter::print(total_bytes_after_compaction, TUnit::BYTES) << "(estimate)";
+    if (input_bytes != nullptr) {
+        *input_bytes = total_bytes;
+    }
     Status st = _do_compaction(&info, mem_tracker, true);
     if (!st.ok()) {
         _compaction_running = false;
@@ -1813,7 +2154,10 @@ Status TabletUpdates::load_from_base_tablet(int64_t request_version, Tablet* bas
     auto index_entry = update_manager->index_cache().get_or_create(tablet_id);
     index_entry->update_expire_time(MonotonicMillis() + update_manager->get_cache_expire_ms());
     auto& index = index_entry->value();
-    index.unload();
+    {
+        std::unique_lock index_lock(_index_lock);
+        index.unload();
+    }
     update_manager->index_cache().release(index_entry);
     _tablet.set_tablet_state(TabletState::TABLET_RUNNING);
     LOG(INFO) << "load_from_base_tablet finish tablet:" << _tablet.tablet_id() << " version:" << this->max_version()
@@ -2075,7 +2419,10 @@ Status TabletUpdates::load_snapshot(const SnapshotMeta& snapshot_meta) {
         auto& index_cache = manager->index_cache();
         auto index_entry = index_cache.get_or_create(tablet_id);
         index_entry->update_expire_time(MonotonicMillis() + manager->get_cache_expire_ms());
-        index_entry->value().unload();
+        {
+            std::unique_lock index_lock(_index_lock);
+            index_entry->value().unload();
+        }
         index_cache.release(index_entry);
 
         _apply_version_changed.notify_all();
@@ -2124,14 +2471,33 @@ Status TabletUpdates::clear_meta() {
     for (auto& [id, rowset] : _rowsets) {
         _clear_rowset_del_vec_cache(*rowset);
     }
-    // Clear cached primary index.
+    // Clear cached primary index and its snapshot.
     StorageEngine::instance()->update_manager()->index_cache().remove_by_key(_tablet.tablet_id());
+    auto st = Env::Default()->delete_file(PrimaryIndex::snapshot_path(_tablet));
+    LOG_IF(WARNING, !st.ok() && !st.is_not_found()) << "failed to delete primary index snapshot: " << st;
     STLClearObject(&_rowsets);
     STLClearObject(&_rowset_stats);
     STLClearObject(&_versions);
     return Status::OK();
 }
 
+void TabletUpdates::_try_save_index_snapshot() {
+    if (!config::enable_primary_index_snapshot) {
+        return;
+    }
+    auto manager = StorageEngine::instance()->update_manager();
+    auto index_entry = manager->index_cache().get(_tablet.tablet_id());
+    if (index_entry == nullptr) {
+        return;
+    }
+    auto& index = index_entry->value();
+    if (index.changed_keys_since_snapshot() >= config::primary_index_snapshot_min_changed_keys) {
+        auto st = index.save_snapshot(&_tablet);
+        LOG_IF(WARNING, !st.ok()) << "save primary index snapshot failed tablet:" << _tablet.tablet_id() << " " << st;
+    }
+    manager->index_cache().release(index_entry);
+}
+
 void TabletUpdates::_update_total_stats(const std::vector<uint32_t>& rowsets) {
     size_t nrow = 0;
     size_t ndel = 0;
@@ -18,12 +18,14 @@ namespace starrocks {
 class PrimaryIndex;
 class Rowset;
 using RowsetSharedPtr = std::shared_ptr<Rowset>;
+class RowsetUpdateState;
 class DelVector;
 using DelVectorPtr = std::shared_ptr<DelVector>;
 class MemTracker;
 class SnapshotMeta;
 class Tablet;
 class TTabletInfo;
+class ThreadPoolToken;
 
 namespace vectorized {
 class ChunkIterator;
@@ -69,6 +71,13 @@ public:
     StatusOr<IteratorList> read(int64_t version, const vectorized::Schema& schema,
                                 const vectorized::RowsetReadOptions& options);
 
+    // Append the rows of the primary keys of |keys|, whose columns are the key columns of the tablet schema in the
+    // storage format, to |rows|, whose columns are all the columns of it. The keys of no row are skipped, and
+    // |found[i]| is set to whether the i-th key has a row. The rows are the latest ones applied, which may be newer
+    // than max_version() for a moment, and are looked up by the primary index rather than scanned, so that the point
+    // lookups on the tables of row stores read a page per row, see Segment::read_rows().
+    Status get_rows_by_keys(const vectorized::Chunk& keys, vectorized::Chunk* rows, std::vector<uint8_t>* found);
+
     // get latest version's number of rows
     size_t num_rows() const;
 
@@ -113,7 +122,8 @@ public:
     //          = sum((Rf+Wf) * d_i - Wf * r_i + Rf * C_seek) - C_seek
     // so a compaction has a constant part of gain: -C_seek
     // and each input rowset has a gain: (Rf+Wf) * d_i - Wf * r_i + C_seek
-    // (if this is negative just skip this rowset)
+    // (if this is negative just skip this rowset, unless the tablet has more than
+    // config::update_compaction_max_rowsets rowsets, whose C_seek of each extra rowset is added to the gain)
     //
     // about C_seek, Rf & Wf, these variables are related to multiple factors, like:
     //   * rowset query/read frequency
@@ -125,7 +135,8 @@ public:
     int64_t get_compaction_score();
 
     // perform compaction, should only be called by compaction thread
-    Status compaction(MemTracker* mem_tracker);
+    // The bytes of the input rowsets are returned in |input_bytes| if it's not null.
+    Status compaction(MemTracker* mem_tracker, size_t* input_bytes = nullptr);
 
     // Remove version whose creation time is less than |expire_time|.
     // [thread-safe]
@@ -213,6 +224,16 @@ private:
 
     void _apply_rowset_commit(const EditVersionInfo& version_info);
 
+    // Complete the rows of |rowset|, a partial update of some columns, by the other columns of the rows they
+    // replace, or their default values for the new keys, and replace it with the complete rowset by the same
+    // rssid, so that it's applied and read like a rowset of all the columns.
+    Status _complete_partial_update_rowset(uint32_t rowset_id, const RowsetSharedPtr& rowset, PrimaryIndex& index,
+                                           const RowsetUpdateState& state, RowsetSharedPtr* full_rowset);
+
+    // Load the RowsetUpdateState of the rowset commit |version_info| in the background, so that it's ready
+    // when the commit is applied. Should only be called by the apply thread.
+    void _prefetch_update_state(const EditVersionInfo& version_info);
+
     void _apply_compaction_commit(const EditVersionInfo& version_info);
 
     RowsetSharedPtr _get_rowset(uint32_t rowset_id);
@@ -239,6 +260,10 @@ private:
 
     void _calc_compaction_score(RowsetStats* stats);
 
+    // The extra score of compacting a tablet of |num_rowsets| rowsets, which is positive if there are more rowsets
+    // than config::update_compaction_max_rowsets.
+    int64_t _read_amplification_score(size_t num_rowsets) const;
+
     // This method will acquire |_lock|.
     size_t _get_rowset_num_deletes(uint32_t rowsetid);
 
@@ -263,6 +288,10 @@ private:
 
     void _update_total_stats(const std::vector<uint32_t>& rowsets);
 
+    // Save the primary index into its snapshot if it's cached and enough keys have changed since the last
+    // snapshot, should only be called by the apply thread.
+    void _try_save_index_snapshot();
+
 private:
     Tablet& _tablet;
 
@@ -281,6 +310,9 @@ private:
     mutable std::mutex _rowsets_lock;
     std::unordered_map<uint32_t, RowsetSharedPtr> _rowsets;
 
+    // Acquired exclusively by the apply while it updates the primary index, and shared by get_rows_by_keys().
+    mutable std::shared_mutex _index_lock;
+
     // used for async apply, make sure at most 1 thread is doing applying
     mutable std::mutex _apply_running_lock;
     // apply process is running currently
@@ -289,6 +321,8 @@ private:
     // used to stop apply thread when shutting-down this tablet
     std::atomic<bool> _apply_stopped = false;
     std::condition_variable _apply_stopped_cond;
+    // loads the RowsetUpdateState of the next rowset commit while the current one is being applied.
+    std::unique_ptr<ThreadPoolToken> _apply_prefetch_token;
 
     BlockingQueue<RowsetSharedPtr> _unused_rowsets;
 
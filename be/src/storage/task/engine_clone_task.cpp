@@ -21,7 +21,9 @@
 
 #include "storage/task/engine_clone_task.h"
 
+#include <atomic>
 #include <filesystem>
+#include <mutex>
 #include <set>
 
 #include "env/env.h"
@@ -38,6 +40,8 @@
 #include "storage/snapshot_manager.h"
 #include "storage/tablet_updates.h"
 #include "util/defer_op.h"
+#include "util/rate_limiter.h"
+#include "util/threadpool.h"
 #include "util/thrift_rpc_helper.h"
 
 using std::set;
@@ -52,6 +56,8 @@ const std::string HTTP_REQUEST_PREFIX = "/api/_tablet/_download";
 const uint32_t DOWNLOAD_FILE_MAX_RETRY = 3;
 const uint32_t LIST_REMOTE_FILE_TIMEOUT = 15;
 const uint32_t GET_LENGTH_TIMEOUT = 10;
+// the total download rate of all the clone tasks of the node
+static RateLimiter s_clone_download_rate_limiter;
 
 EngineCloneTask::EngineCloneTask(MemTracker* tablet_meta_mem_tracker, const TCloneReq& clone_req,
                                  const TMasterInfo& master_info, int64_t signature, std::vector<string>* error_msgs,
@@ -361,10 +367,10 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
     }
 
     // Get copy from remote
-    uint64_t total_file_size = 0;
+    std::atomic<uint64_t> total_file_size{0};
     MonotonicStopWatch watch;
     watch.start();
-    for (auto& file_name : file_name_list) {
+    auto download_file = [&](const std::string& file_name) {
         auto remote_file_url = remote_url_prefix + file_name;
 
         // get file length
@@ -396,6 +402,8 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
         auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path, file_size](HttpClient* client) {
             RETURN_IF_ERROR(client->init(remote_file_url));
             client->set_timeout_ms(estimate_timeout * 1000);
+            client->set_rate_limiter(&s_clone_download_rate_limiter,
+                                     static_cast<int64_t>(config::clone_max_download_speed_kbps) * 1024);
             RETURN_IF_ERROR(client->download(local_file_path));
 
             // Check file length
@@ -408,17 +416,54 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
             chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
             return Status::OK();
         };
-        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb));
+        return HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb);
+    };
+
+    // The data files are downloaded in parallel, and the header file after all of them.
+    size_t num_data_files = file_name_list.size();
+    if (num_data_files > 0 && StringPiece(file_name_list.back()).ends_with(".hdr")) {
+        num_data_files--;
+    }
+    std::unique_ptr<ThreadPool> download_pool;
+    RETURN_IF_ERROR(ThreadPoolBuilder("clone_download")
+                            .set_min_threads(0)
+                            .set_max_threads(std::max(config::clone_download_parallelism, 1))
+                            .build(&download_pool));
+    std::mutex status_lock;
+    Status download_status;
+    auto download_data_file = [&](const std::string& file_name) {
+        {
+            std::lock_guard l(status_lock);
+            if (!download_status.ok()) {
+                return;
+            }
+        }
+        Status st = download_file(file_name);
+        std::lock_guard l(status_lock);
+        if (download_status.ok() && !st.ok()) {
+            download_status = st;
+        }
+    };
+    for (size_t i = 0; i < num_data_files; i++) {
+        const std::string& file_name = file_name_list[i];
+        if (!download_pool->submit_func([&download_data_file, &file_name] { download_data_file(file_name); }).ok()) {
+            download_data_file(file_name);
+        }
+    }
+    download_pool->wait();
+    RETURN_IF_ERROR(download_status);
+    if (num_data_files < file_name_list.size()) {
+        RETURN_IF_ERROR(download_file(file_name_list.back()));
     } // Clone files from remote backend
 
     uint64_t total_time_ms = watch.elapsed_time() / 1000 / 1000;
     total_time_ms = total_time_ms > 0 ? total_time_ms : 0;
     double copy_rate = 0.0;
     if (total_time_ms > 0) {
-        copy_rate = total_file_size / ((double)total_time_ms) / 1000;
+        copy_rate = total_file_size.load() / ((double)total_time_ms) / 1000;
     }
-    LOG(INFO) << "Copied tablet " << _signature << ". bytes=" << total_file_size << " cost=" << total_time_ms << " ms"
-              << " rate=" << copy_rate << " MB/s";
+    LOG(INFO) << "Copied tablet " << _signature << ". bytes=" << total_file_size.load() << " cost=" << total_time_ms
+              << " ms rate=" << copy_rate << " MB/s";
     return Status::OK();
 }
 
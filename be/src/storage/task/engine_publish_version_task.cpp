@@ -22,6 +22,7 @@
 #include "storage/task/engine_publish_version_task.h"
 
 #include <map>
+#include <unordered_map>
 
 #include "storage/data_dir.h"
 #include "storage/rowset/rowset_meta_manager.h"
@@ -59,9 +60,38 @@ OLAPStatus EnginePublishVersionTask::finish() {
         Version version(par_ver_info.version, par_ver_info.version);
         VersionHash version_hash = par_ver_info.version_hash;
 
+        // The tablets whose rowset metas are saved by one write batch of their data dir.
+        std::unordered_map<DataDir*, std::vector<std::pair<TabletSharedPtr, RowsetSharedPtr>>> tablets_by_dir;
+        auto on_published = [&](const TabletSharedPtr& tablet, const RowsetSharedPtr& rowset,
+                                OLAPStatus publish_status) {
+            if (publish_status != OLAP_SUCCESS) {
+                LOG(WARNING) << "failed to publish version. rowset_id=" << rowset->rowset_id()
+                             << ", tablet_id=" << tablet->tablet_id() << ", txn_id=" << transaction_id;
+                _error_tablet_ids->push_back(tablet->tablet_id());
+                res = publish_status;
+                return;
+            }
+
+            if (tablet->keys_type() != KeysType::PRIMARY_KEYS) {
+                // add visible rowset to tablet
+                publish_status = tablet->add_inc_rowset(rowset);
+                if (publish_status != OLAP_SUCCESS && publish_status != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
+                    LOG(WARNING) << "fail to add visible rowset to tablet. rowset_id=" << rowset->rowset_id()
+                                 << ", tablet_id=" << tablet->tablet_id() << ", txn_id=" << transaction_id
+                                 << ", res=" << publish_status;
+                    _error_tablet_ids->push_back(tablet->tablet_id());
+                    res = publish_status;
+                    return;
+                }
+            }
+            partition_related_tablet_infos.erase(tablet->get_tablet_info());
+            VLOG(1) << "publish version successfully on tablet. tablet=" << tablet->full_name()
+                    << ", transaction_id=" << transaction_id << ", version=" << version.first
+                    << ", res=" << publish_status;
+        };
+
         // each tablet
         for (auto& tablet_rs : tablet_related_rs) {
-            OLAPStatus publish_status = OLAP_SUCCESS;
             const TabletInfo& tablet_info = tablet_rs.first;
             const RowsetSharedPtr& rowset = tablet_rs.second;
             VLOG(1) << "begin to publish version on tablet. "
@@ -91,36 +121,27 @@ OLAPStatus EnginePublishVersionTask::finish() {
             if (tablet->keys_type() == KeysType::PRIMARY_KEYS) {
                 VLOG(1) << "UpdateManager::on_rowset_published tablet:" << tablet->tablet_id()
                         << " rowset: " << rowset->rowset_id().to_string() << " version: " << version.second;
-                publish_status = StorageEngine::instance()->txn_manager()->publish_txn2(transaction_id, partition_id,
-                                                                                        tablet, version.second);
+                OLAPStatus publish_status = StorageEngine::instance()->txn_manager()->publish_txn2(
+                        transaction_id, partition_id, tablet, version.second);
+                on_published(tablet, rowset, publish_status);
             } else {
-                publish_status = StorageEngine::instance()->txn_manager()->publish_txn(
-                        partition_id, tablet, transaction_id, version, version_hash);
-            }
-            if (publish_status != OLAP_SUCCESS) {
-                LOG(WARNING) << "failed to publish version. rowset_id=" << rowset->rowset_id()
-                             << ", tablet_id=" << tablet_info.tablet_id << ", txn_id=" << transaction_id;
-                _error_tablet_ids->push_back(tablet_info.tablet_id);
-                res = publish_status;
-                continue;
+                tablets_by_dir[tablet->data_dir()].emplace_back(tablet, rowset);
             }
+        }
 
-            if (tablet->keys_type() != KeysType::PRIMARY_KEYS) {
-                // add visible rowset to tablet
-                publish_status = tablet->add_inc_rowset(rowset);
-                if (publish_status != OLAP_SUCCESS && publish_status != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
-                    LOG(WARNING) << "fail to add visible rowset to tablet. rowset_id=" << rowset->rowset_id()
-                                 << ", tablet_id=" << tablet_info.tablet_id << ", txn_id=" << transaction_id
-                                 << ", res=" << publish_status;
-                    _error_tablet_ids->push_back(tablet_info.tablet_id);
-                    res = publish_status;
-                    continue;
-                }
+        std::vector<TabletSharedPtr> tablets;
+        std::vector<OLAPStatus> statuses;
+        for (auto& [data_dir, tablet_rowsets] : tablets_by_dir) {
+            tablets.clear();
+            for (auto& tablet_rowset : tablet_rowsets) {
+                tablets.push_back(tablet_rowset.first);
+            }
+            StorageEngine::instance()->txn_manager()->publish_txn_batch(data_dir->get_meta(), partition_id,
+                                                                        transaction_id, tablets, version,
+                                                                        version_hash, &statuses);
+            for (size_t i = 0; i < tablet_rowsets.size(); i++) {
+                on_published(tablet_rowsets[i].first, tablet_rowsets[i].second, statuses[i]);
             }
-            partition_related_tablet_infos.erase(tablet_info);
-            VLOG(1) << "publish version successfully on tablet. tablet=" << tablet->full_name()
-                    << ", transaction_id=" << transaction_id << ", version=" << version.first
-                    << ", res=" << publish_status;
         }
 
         // check if the related tablet remained all have the version
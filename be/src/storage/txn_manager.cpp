@@ -289,6 +289,83 @@ OLAPStatus TxnManager::publish_txn(OlapMeta* meta, TPartitionId partition_id, TT
     }
 }
 
+void TxnManager::publish_txn_batch(OlapMeta* meta, TPartitionId partition_id, TTransactionId transaction_id,
+                                   const std::vector<TabletSharedPtr>& tablets, const Version& version,
+                                   VersionHash version_hash, std::vector<OLAPStatus>* statuses) {
+    pair<int64_t, int64_t> key(partition_id, transaction_id);
+    statuses->assign(tablets.size(), OLAP_ERR_TRANSACTION_NOT_EXIST);
+    std::vector<RowsetSharedPtr> rowsets(tablets.size());
+    std::lock_guard txn_lock(_get_txn_lock(transaction_id));
+    {
+        std::shared_lock rlock(_get_txn_map_lock(transaction_id));
+        txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(transaction_id);
+        auto it = txn_tablet_map.find(key);
+        if (it != txn_tablet_map.end()) {
+            for (size_t i = 0; i < tablets.size(); i++) {
+                TabletInfo tablet_info(tablets[i]->tablet_id(), tablets[i]->schema_hash(), tablets[i]->tablet_uid());
+                auto load_itr = it->second.find(tablet_info);
+                if (load_itr != it->second.end()) {
+                    rowsets[i] = load_itr->second.rowset;
+                }
+            }
+        }
+    }
+    // The same as publish_txn, save meta under the single txn lock only.
+    WriteBatch batch;
+    for (size_t i = 0; i < tablets.size(); i++) {
+        if (rowsets[i] == nullptr) {
+            continue;
+        }
+        rowsets[i]->make_visible(version, version_hash);
+        auto& rowset_meta_pb = rowsets[i]->rowset_meta()->get_meta_pb();
+        Status st = RowsetMetaManager::save(meta, &batch, tablets[i]->tablet_uid(), rowsets[i]->rowset_id(),
+                                            rowset_meta_pb);
+        if (!st.ok()) {
+            LOG(WARNING) << "save committed rowset failed. when publish txn rowset_id:" << rowsets[i]->rowset_id()
+                         << ", tablet id: " << tablets[i]->tablet_id() << ", txn id:" << transaction_id;
+            (*statuses)[i] = OLAP_ERR_ROWSET_SAVE_FAILED;
+            rowsets[i] = nullptr;
+        }
+    }
+    if (batch.Count() == 0) {
+        return;
+    }
+    Status st = meta->write_batch(&batch);
+    if (!st.ok()) {
+        LOG(WARNING) << "save committed rowsets failed. when publish txn, tablets: " << batch.Count()
+                     << ", txn id:" << transaction_id << ", err: " << st;
+        for (size_t i = 0; i < tablets.size(); i++) {
+            if (rowsets[i] != nullptr) {
+                (*statuses)[i] = OLAP_ERR_ROWSET_SAVE_FAILED;
+            }
+        }
+        return;
+    }
+
+    std::unique_lock wrlock(_get_txn_map_lock(transaction_id));
+    txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(transaction_id);
+    auto it = txn_tablet_map.find(key);
+    for (size_t i = 0; i < tablets.size(); i++) {
+        if (rowsets[i] == nullptr) {
+            continue;
+        }
+        (*statuses)[i] = OLAP_SUCCESS;
+        if (it == txn_tablet_map.end()) {
+            continue;
+        }
+        TabletInfo tablet_info(tablets[i]->tablet_id(), tablets[i]->schema_hash(), tablets[i]->tablet_uid());
+        it->second.erase(tablet_info);
+        LOG(INFO) << "publish txn successfully."
+                  << " partition_id: " << key.first << ", txn_id: " << key.second
+                  << ", tablet: " << tablet_info.to_string() << ", rowsetid: " << rowsets[i]->rowset_id()
+                  << ", version: " << version.first << "," << version.second;
+    }
+    if (it != txn_tablet_map.end() && it->second.empty()) {
+        txn_tablet_map.erase(it);
+        _clear_txn_partition_map_unlocked(transaction_id, partition_id);
+    }
+}
+
 OLAPStatus TxnManager::publish_txn2(TTransactionId transaction_id, TPartitionId partition_id,
                                     const TabletSharedPtr& tablet, int64_t version) {
     pair<int64_t, int64_t> key(partition_id, transaction_id);
@@ -108,6 +108,12 @@ public:
                            TTabletId tablet_id, SchemaHash schema_hash, TabletUid tablet_uid, const Version& version,
                            VersionHash version_hash);
 
+    // publish_txn for the tablets of the same |meta|, whose rowset metas are saved by one write batch instead of
+    // one write each. The status of every tablet is put into |statuses|.
+    void publish_txn_batch(OlapMeta* meta, TPartitionId partition_id, TTransactionId transaction_id,
+                           const std::vector<TabletSharedPtr>& tablets, const Version& version,
+                           VersionHash version_hash, std::vector<OLAPStatus>* statuses);
+
     // delete the txn from manager if it is not committed(not have a valid rowset)
     OLAPStatus rollback_txn(TPartitionId partition_id, TTransactionId transaction_id, TTabletId tablet_id,
                             SchemaHash schema_hash, TabletUid tablet_uid);
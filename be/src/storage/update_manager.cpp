@@ -2,8 +2,10 @@
 
 #include "storage/update_manager.h"
 
+#include <algorithm>
 #include <limits>
 
+#include "common/config.h"
 #include "gutil/endian.h"
 #include "storage/del_vector.h"
 #include "storage/olap_meta.h"
@@ -47,8 +49,10 @@ UpdateManager::~UpdateManager() {
 }
 
 Status UpdateManager::init() {
-    auto st = ThreadPoolBuilder("UpdateApplyThreadPool").build(&_apply_thread_pool);
-    return st;
+    RETURN_IF_ERROR(ThreadPoolBuilder("UpdateApplyThreadPool").build(&_apply_thread_pool));
+    return ThreadPoolBuilder("PrimaryIndexThreadPool")
+            .set_max_threads(std::max(1, config::primary_index_threads))
+            .build(&_index_thread_pool);
 }
 
 Status UpdateManager::get_del_vec_in_meta(OlapMeta* meta, const TabletSegmentId& tsid, int64_t version,
@@ -91,6 +95,7 @@ Status UpdateManager::get_del_vec(OlapMeta* meta, const TabletSegmentId& tsid, i
             itr->second = (*pdelvec);
             _del_vec_cache_mem_tracker->consume(itr->second->memory_usage());
         }
+        _evict_del_vec_cache_unlocked();
     }
     return Status::OK();
 }
@@ -177,6 +182,7 @@ Status UpdateManager::get_latest_del_vec(OlapMeta* meta, const TabletSegmentId&
         RETURN_IF_ERROR(get_del_vec_in_meta(meta, tsid, INT64_MAX, pdelvec->get(), &latest_version));
         _del_vec_cache.emplace(tsid, *pdelvec);
         _del_vec_cache_mem_tracker->consume((*pdelvec)->memory_usage());
+        _evict_del_vec_cache_unlocked();
     }
     return Status::OK();
 }
@@ -201,9 +207,24 @@ Status UpdateManager::set_cached_del_vec(const TabletSegmentId& tsid, DelVectorP
         _del_vec_cache.emplace(tsid, delvec);
         _del_vec_cache_mem_tracker->consume(delvec->memory_usage());
     }
+    _evict_del_vec_cache_unlocked();
     return Status::OK();
 }
 
+void UpdateManager::_evict_del_vec_cache_unlocked() {
+    const int64_t capacity = config::del_vector_cache_capacity;
+    for (auto itr = _del_vec_cache.begin();
+         itr != _del_vec_cache.end() && _del_vec_cache_mem_tracker->consumption() > capacity;) {
+        // the delete vectors still referenced by the readers or the apply thread are kept.
+        if (itr->second.use_count() == 1) {
+            _del_vec_cache_mem_tracker->release(itr->second->memory_usage());
+            itr = _del_vec_cache.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+}
+
 Status UpdateManager::on_rowset_finished(Tablet* tablet, Rowset* rowset) {
     string rowset_unique_id = rowset->rowset_id().to_string();
     VLOG(1) << "UpdateManager::on_rowset_finished start tablet:" << tablet->tablet_id()
@@ -55,6 +55,10 @@ public:
 
     ThreadPool* apply_thread_pool() { return _apply_thread_pool.get(); }
 
+    // Used to load and update primary indexes concurrently, and to prefetch the rowset update states.
+    // The tasks in this pool never wait for other tasks.
+    ThreadPool* index_thread_pool() { return _index_thread_pool.get(); }
+
     DynamicCache<uint64_t, PrimaryIndex>& index_cache() { return _index_cache; }
 
     DynamicCache<string, RowsetUpdateState>& update_state_cache() { return _update_state_cache; }
@@ -72,6 +76,10 @@ public:
     string memory_stats();
 
 private:
+    // Evict the unused delete vectors until the cache doesn't exceed config::del_vector_cache_capacity.
+    // REQUIRE: |_del_vec_cache_lock| is held.
+    void _evict_del_vec_cache_unlocked();
+
     // default 6min
     int64_t _cache_expire_ms = 360000;
 
@@ -93,6 +101,7 @@ private:
     std::unique_ptr<MemTracker> _del_vec_cache_mem_tracker;
 
     std::unique_ptr<ThreadPool> _apply_thread_pool;
+    std::unique_ptr<ThreadPool> _index_thread_pool;
 
     DISALLOW_COPY_AND_ASSIGN(UpdateManager);
 };
@@ -2,9 +2,12 @@
 
 #include "storage/vectorized/chunk_helper.h"
 
+#include <algorithm>
+
 #include "column/chunk.h"
 #include "column/column_pool.h"
 #include "column/schema.h"
+#include "runtime/descriptors.h"
 #include "storage/tablet_schema.h"
 #include "storage/vectorized/type_utils.h"
 #include "util/metrics.h"
@@ -207,6 +210,61 @@ Chunk* ChunkHelper::new_chunk_pooled(const vectorized::Schema& schema, size_t n,
     return new Chunk(std::move(columns), std::make_shared<vectorized::Schema>(schema));
 }
 
+template <bool force>
+ColumnPtr column_from_pool(const TypeDescriptor& type, bool nullable) {
+    auto Nullable = [&](ColumnPtr c) -> ColumnPtr {
+        return nullable ? NullableColumn::create(std::move(c), get_column_ptr<NullColumn, force>()) : c;
+    };
+
+    switch (type.type) {
+    case TYPE_BOOLEAN:
+        return Nullable(get_column_ptr<BooleanColumn, force>());
+    case TYPE_TINYINT:
+        return Nullable(get_column_ptr<Int8Column, force>());
+    case TYPE_SMALLINT:
+        return Nullable(get_column_ptr<Int16Column, force>());
+    case TYPE_INT:
+        return Nullable(get_column_ptr<Int32Column, force>());
+    case TYPE_BIGINT:
+        return Nullable(get_column_ptr<Int64Column, force>());
+    case TYPE_LARGEINT:
+        return Nullable(get_column_ptr<Int128Column, force>());
+    case TYPE_FLOAT:
+        return Nullable(get_column_ptr<FloatColumn, force>());
+    case TYPE_DOUBLE:
+        return Nullable(get_column_ptr<DoubleColumn, force>());
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        return Nullable(get_column_ptr<BinaryColumn, force>());
+    case TYPE_DATE:
+        return Nullable(get_column_ptr<DateColumn, force>());
+    case TYPE_DATETIME:
+        return Nullable(get_column_ptr<TimestampColumn, force>());
+    case TYPE_DECIMALV2:
+        return Nullable(get_column_ptr<DecimalColumn, force>());
+    case TYPE_DECIMAL32:
+        return Nullable(get_decimal_column_ptr<Decimal32Column, force>(type.precision, type.scale));
+    case TYPE_DECIMAL64:
+        return Nullable(get_decimal_column_ptr<Decimal64Column, force>(type.precision, type.scale));
+    case TYPE_DECIMAL128:
+        return Nullable(get_decimal_column_ptr<Decimal128Column, force>(type.precision, type.scale));
+    default:
+        // The columns of the other types, e.g. arrays and objects, have no bound on their sizes.
+        return ColumnHelper::create_column(type, nullable);
+    }
+}
+
+Chunk* ChunkHelper::new_chunk_pooled(const std::vector<SlotDescriptor*>& slots, size_t n, bool force) {
+    auto* chunk = new Chunk();
+    for (const auto slot : slots) {
+        auto column = force ? column_from_pool<true>(slot->type(), slot->is_nullable())
+                            : column_from_pool<false>(slot->type(), slot->is_nullable());
+        column->reserve(n);
+        chunk->append_column(std::move(column), slot->id());
+    }
+    return chunk;
+}
+
 size_t ChunkHelper::approximate_sizeof_type(FieldType type) {
     switch (type) {
     case OLAP_FIELD_TYPE_HLL:
@@ -262,6 +320,26 @@ size_t ChunkHelper::approximate_sizeof_type(FieldType type) {
     return 4;
 }
 
+size_t ChunkHelper::adaptive_chunk_size(const starrocks::TabletSchema& schema, const std::vector<ColumnId>& cids,
+                                        size_t target_bytes, size_t max_rows) {
+    // The strings are mostly far shorter than their max length, and the chunks of too few rows cost more the
+    // overheads of the chunks than they save by fitting in the cache.
+    constexpr size_t kMaxEstimatedStringBytes = 64;
+    constexpr size_t kMinChunkSize = 256;
+    size_t row_bytes = 0;
+    for (ColumnId cid : cids) {
+        const TabletColumn& column = schema.column(cid);
+        row_bytes += approximate_sizeof_type(column.type()) + column.is_nullable();
+        if (column.type() == OLAP_FIELD_TYPE_CHAR || column.type() == OLAP_FIELD_TYPE_VARCHAR) {
+            row_bytes += std::min(column.length(), kMaxEstimatedStringBytes);
+        }
+    }
+    if (target_bytes == 0 || row_bytes == 0) {
+        return max_rows;
+    }
+    return std::clamp(target_bytes / row_bytes, std::min(kMinChunkSize, max_rows), max_rows);
+}
+
 std::vector<size_t> ChunkHelper::get_char_field_indexes(const vectorized::Schema& schema) {
     std::vector<size_t> char_field_indexes;
     for (size_t i = 0; i < schema.num_fields(); ++i) {
@@ -290,7 +368,8 @@ void ChunkHelper::padding_char_columns(const std::vector<size_t>& char_column_in
         vectorized::Offsets& new_offset = new_binary->get_offset();
         vectorized::Bytes& new_bytes = new_binary->get_bytes();
 
-        uint32_t len = tschema.column(field_index).length();
+        // The id of a field is the index of its column in the tablet schema.
+        uint32_t len = tschema.column(schema.field(field_index)->id()).length();
 
         new_offset.resize(num_rows + 1);
         new_bytes.assign(num_rows * len, 0); // padding 0
@@ -61,6 +61,10 @@ public:
 
     static Chunk* new_chunk_pooled(const vectorized::Schema& schema, size_t n, bool force = true);
 
+    // Create an empty chunk according to the |slots| and reserve it of size |n|, the columns of the scalar
+    // types are taken from the column pool and returned to it when the chunk is destroyed.
+    static Chunk* new_chunk_pooled(const std::vector<SlotDescriptor*>& slots, size_t n, bool force = true);
+
     // Create a vectorized column from field .
     // REQUIRE: |type| must be scalar type.
     static std::shared_ptr<Column> column_from_field_type(FieldType type, bool nullable);
@@ -71,6 +75,11 @@ public:
     // FieldType data size in memory
     static size_t approximate_sizeof_type(FieldType type);
 
+    // The rows of a chunk of the columns |cids| of |schema| whose memory approximately fits in |target_bytes|,
+    // e.g. the CPU cache, so the narrow rows are read |max_rows| rows a chunk, and the wide ones in fewer rows.
+    static size_t adaptive_chunk_size(const starrocks::TabletSchema& schema, const std::vector<ColumnId>& cids,
+                                      size_t target_bytes, size_t max_rows);
+
     // Get char column indexes
     static std::vector<size_t> get_char_field_indexes(const vectorized::Schema& schema);
 
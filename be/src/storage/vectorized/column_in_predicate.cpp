@@ -1,6 +1,7 @@
 // This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
 
 #include <type_traits>
+#include <vector>
 
 #include "column/binary_column.h"
 #include "column/column.h"
@@ -21,7 +22,12 @@ class ColumnInPredicate : public ColumnPredicate {
 
 public:
     ColumnInPredicate(const TypeInfoPtr& type_info, ColumnId id, ItemSet values)
-            : ColumnPredicate(type_info, id), _values(std::move(values)) {}
+            : ColumnPredicate(type_info, id), _values(std::move(values)) {
+        _hashes.reserve(_values.size());
+        for (const ValueType& v : _values) {
+            _hashes.push_back(segment_v2::BloomFilter::murmur3_hash(reinterpret_cast<const char*>(&v), sizeof(v)));
+        }
+    }
 
     ~ColumnInPredicate() override = default;
 
@@ -120,10 +126,7 @@ public:
         static_assert(field_type != OLAP_FIELD_TYPE_HLL, "TODO");
         static_assert(field_type != OLAP_FIELD_TYPE_OBJECT, "TODO");
         static_assert(field_type != OLAP_FIELD_TYPE_PERCENTILE, "TODO");
-        for (const ValueType& v : _values) {
-            RETURN_IF(bf->test_bytes(reinterpret_cast<const char*>(&v), sizeof(v)), true);
-        }
-        return false;
+        return bf->test_any_hash(_hashes.data(), _hashes.size());
     }
 
     PredicateType type() const override { return PredicateType::kInList; }
@@ -172,6 +175,8 @@ public:
 
 private:
     ItemSet _values;
+    // the hashes of |_values| probing the bloom filters
+    std::vector<uint64_t> _hashes;
 };
 
 // Template specialization for binary column
@@ -183,6 +188,7 @@ public:
         for (const std::string& s : _zero_padded_strs) {
             _slices.emplace(Slice(s));
         }
+        _init_hashes();
     }
 
     ~BinaryColumnInPredicate() override = default;
@@ -315,11 +321,7 @@ public:
     bool support_bloom_filter() const override { return true; }
 
     bool bloom_filter(const segment_v2::BloomFilter* bf) const override {
-        for (const auto& str : _zero_padded_strs) {
-            Slice v(str);
-            RETURN_IF(bf->test_bytes(v.data, v.size), true);
-        }
-        return false;
+        return bf->test_any_hash(_hashes.data(), _hashes.size());
     }
 
     bool can_vectorized() const override { return false; }
@@ -353,12 +355,23 @@ public:
             str.append(len > old_sz ? len - old_sz : 0, '\0');
             _slices.emplace(str.data(), old_sz);
         }
+        _init_hashes();
         return true;
     }
 
 private:
+    void _init_hashes() {
+        _hashes.clear();
+        _hashes.reserve(_zero_padded_strs.size());
+        for (const std::string& s : _zero_padded_strs) {
+            _hashes.push_back(segment_v2::BloomFilter::murmur3_hash(s.data(), s.size()));
+        }
+    }
+
     std::vector<std::string> _zero_padded_strs;
     ItemHashSet<Slice> _slices;
+    // the hashes of |_zero_padded_strs| probing the bloom filters
+    std::vector<uint64_t> _hashes;
 };
 
 template <template <typename, size_t...> typename Set, size_t... Args>
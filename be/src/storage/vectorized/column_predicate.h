@@ -45,6 +45,8 @@ enum class PredicateType {
     kNotNull = 9,
     kAnd = 10,
     kOr = 11,
+    kContains = 12,
+    kMatch = 13,
 };
 
 template <typename T>
@@ -108,6 +110,17 @@ public:
         return Status::Cancelled("not implemented");
     }
 
+    virtual bool support_ngram_bloom_filter() const { return false; }
+
+    // Return false to filter out a data page, by the bloom filter of the n-grams of |gram_size| bytes of its values.
+    virtual bool ngram_bloom_filter(const segment_v2::BloomFilter* bf, size_t gram_size) const { return true; }
+
+    // Read the row ids of the values that may match this predicate from the inverted index of the tokens, into
+    // |rows|. Return Cancelled if the inverted index can not be used.
+    virtual Status seek_inverted_index(segment_v2::BitmapIndexIterator* iter, Roaring* rows) const {
+        return Status::Cancelled("not implemented");
+    }
+
     // Indicate whether or not the evaluate can be vectorized.
     // If this function return true, evaluate function will be vectorized and can achieve
     // good performance.
@@ -270,6 +283,11 @@ ColumnPredicate* new_column_not_in_predicate(const TypeInfoPtr& type, ColumnId i
                                              const std::vector<std::string>& operands);
 ColumnPredicate* new_column_null_predicate(const TypeInfoPtr& type, ColumnId, bool is_null);
 
+// The values containing |operand| as a substring, for the char/varchar columns only.
+ColumnPredicate* new_column_contains_predicate(const TypeInfoPtr& type, ColumnId id, const Slice& operand);
+// The values containing every token of |operand|, see `for_each_token`, for the char/varchar columns only.
+ColumnPredicate* new_column_match_predicate(const TypeInfoPtr& type, ColumnId id, const Slice& operand);
+
 template <FieldType field_type, template <FieldType> typename Predicate, typename NewColumnPredicateFunc>
 Status predicate_convert_to(Predicate<field_type> const& input_predicate,
                             typename CppTypeTraits<field_type>::CppType const& value,
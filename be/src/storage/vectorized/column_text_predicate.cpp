@@ -0,0 +1,234 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/column.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "roaring/roaring.hh"
+#include "storage/rowset/segment_v2/bitmap_index_reader.h"
+#include "storage/rowset/segment_v2/bloom_filter.h"
+#include "storage/rowset/segment_v2/text_index.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks::vectorized {
+
+// The predicates on the text of the char/varchar columns, which filter the pages by the n-gram bloom filter index
+// and the rows by the inverted index. |Derived| provides `bool match(const Slice& value) const`.
+template <typename Derived>
+class ColumnTextPredicate : public ColumnPredicate {
+public:
+    ColumnTextPredicate(const TypeInfoPtr& type_info, ColumnId id, const Slice& operand)
+            : ColumnPredicate(type_info, id), _operand(operand.data, operand.size) {}
+
+    void evaluate(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override {
+        const BinaryColumn* binary_column = _binary_column(column);
+        const uint8_t* is_null = _null_data(column);
+        for (uint16_t i = from; i < to; i++) {
+            selection[i] = (is_null == nullptr || !is_null[i]) && _derived()->match(binary_column->get_slice(i));
+        }
+    }
+
+    void evaluate_and(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override {
+        const BinaryColumn* binary_column = _binary_column(column);
+        const uint8_t* is_null = _null_data(column);
+        for (uint16_t i = from; i < to; i++) {
+            selection[i] = selection[i] && (is_null == nullptr || !is_null[i]) &&
+                           _derived()->match(binary_column->get_slice(i));
+        }
+    }
+
+    void evaluate_or(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override {
+        const BinaryColumn* binary_column = _binary_column(column);
+        const uint8_t* is_null = _null_data(column);
+        for (uint16_t i = from; i < to; i++) {
+            selection[i] = selection[i] || ((is_null == nullptr || !is_null[i]) &&
+                                            _derived()->match(binary_column->get_slice(i)));
+        }
+    }
+
+    uint16_t evaluate_branchless(const Column* column, uint16_t* sel, uint16_t sel_size) const override {
+        const BinaryColumn* binary_column = _binary_column(column);
+        const uint8_t* is_null = _null_data(column);
+        uint16_t new_size = 0;
+        for (uint16_t i = 0; i < sel_size; ++i) {
+            uint16_t data_idx = sel[i];
+            sel[new_size] = data_idx;
+            new_size += (is_null == nullptr || !is_null[data_idx]) &&
+                        _derived()->match(binary_column->get_slice(data_idx));
+        }
+        return new_size;
+    }
+
+    Datum value() const override { return Datum(Slice(_operand)); }
+
+    std::vector<Datum> values() const override { return std::vector<Datum>{Datum(Slice(_operand))}; }
+
+    bool can_vectorized() const override { return false; }
+
+    Status convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
+                      ObjectPool* obj_pool) const override {
+        *output = this;
+        return Status::OK();
+    }
+
+protected:
+    const Derived* _derived() const { return static_cast<const Derived*>(this); }
+
+    static const BinaryColumn* _binary_column(const Column* column) {
+        if (column->is_nullable()) {
+            return down_cast<const BinaryColumn*>(down_cast<const NullableColumn*>(column)->data_column().get());
+        }
+        return down_cast<const BinaryColumn*>(column);
+    }
+
+    static const uint8_t* _null_data(const Column* column) {
+        if (!column->has_null()) {
+            return nullptr;
+        }
+        return down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+    }
+
+    // Whether the bloom filter may contain all the n-grams of |s|. The strings shorter than |gram_size| can not be
+    // filtered.
+    static bool _test_ngrams(const segment_v2::BloomFilter* bf, const Slice& s, size_t gram_size) {
+        bool found = true;
+        segment_v2::for_each_ngram(s, gram_size, [&](const Slice& gram) {
+            found = found && bf->test_hash(segment_v2::ngram_hash(gram));
+        });
+        return found;
+    }
+
+    std::string _operand;
+};
+
+class ColumnContainsPredicate final : public ColumnTextPredicate<ColumnContainsPredicate> {
+public:
+    ColumnContainsPredicate(const TypeInfoPtr& type_info, ColumnId id, const Slice& operand)
+            : ColumnTextPredicate(type_info, id, operand) {}
+
+    bool match(const Slice& value) const {
+        return std::string_view(value.data, value.size).find(_operand) != std::string_view::npos;
+    }
+
+    bool support_ngram_bloom_filter() const override { return _operand.size() >= segment_v2::kDefaultNGramSize; }
+
+    bool ngram_bloom_filter(const segment_v2::BloomFilter* bf, size_t gram_size) const override {
+        return _test_ngrams(bf, Slice(_operand), gram_size);
+    }
+
+    PredicateType type() const override { return PredicateType::kContains; }
+
+    std::string debug_string() const override {
+        std::stringstream ss;
+        ss << "(columnId(" << _column_id << ") contains " << _operand << ")";
+        return ss.str();
+    }
+};
+
+class ColumnMatchPredicate final : public ColumnTextPredicate<ColumnMatchPredicate> {
+public:
+    ColumnMatchPredicate(const TypeInfoPtr& type_info, ColumnId id, const Slice& operand)
+            : ColumnTextPredicate(type_info, id, operand) {
+        segment_v2::for_each_token(Slice(_operand), [this](const Slice& token) {
+            if (std::find(_tokens.begin(), _tokens.end(), token) == _tokens.end()) {
+                _tokens.push_back(token);
+            }
+        });
+    }
+
+    bool match(const Slice& value) const {
+        // The tokens of a query are few, so they are searched linearly.
+        std::vector<bool> found(_tokens.size(), false);
+        size_t num_found = 0;
+        segment_v2::for_each_token(value, [&](const Slice& token) {
+            for (size_t i = 0; i < _tokens.size(); i++) {
+                if (!found[i] && _tokens[i] == token) {
+                    found[i] = true;
+                    num_found++;
+                }
+            }
+        });
+        return num_found == _tokens.size();
+    }
+
+    // Every token is a substring of the matched values.
+    bool support_ngram_bloom_filter() const override {
+        for (const Slice& token : _tokens) {
+            if (token.size >= segment_v2::kDefaultNGramSize) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ngram_bloom_filter(const segment_v2::BloomFilter* bf, size_t gram_size) const override {
+        for (const Slice& token : _tokens) {
+            if (!_test_ngrams(bf, token, gram_size)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // The rows containing all the tokens, i.e. the intersection of their posting lists.
+    Status seek_inverted_index(segment_v2::BitmapIndexIterator* iter, Roaring* rows) const override {
+        if (_tokens.empty()) {
+            return Status::Cancelled("no token to match");
+        }
+        for (size_t i = 0; i < _tokens.size(); i++) {
+            bool exact_match = false;
+            Status st = iter->seek_dictionary(&_tokens[i], &exact_match);
+            if (st.is_not_found() || (st.ok() && !exact_match)) {
+                *rows = Roaring();
+                return Status::OK();
+            }
+            RETURN_IF_ERROR(st);
+            Roaring posting;
+            RETURN_IF_ERROR(iter->read_bitmap(iter->current_ordinal(), &posting));
+            if (i == 0) {
+                *rows = std::move(posting);
+            } else {
+                *rows &= posting;
+            }
+        }
+        return Status::OK();
+    }
+
+    PredicateType type() const override { return PredicateType::kMatch; }
+
+    std::string debug_string() const override {
+        std::stringstream ss;
+        ss << "(columnId(" << _column_id << ") match " << _operand << ")";
+        return ss.str();
+    }
+
+private:
+    // the distinct tokens of the operand, which point to |_operand|
+    std::vector<Slice> _tokens;
+};
+
+static bool is_text_type(const TypeInfoPtr& type_info) {
+    return type_info->type() == OLAP_FIELD_TYPE_CHAR || type_info->type() == OLAP_FIELD_TYPE_VARCHAR;
+}
+
+ColumnPredicate* new_column_contains_predicate(const TypeInfoPtr& type_info, ColumnId id, const Slice& operand) {
+    if (!is_text_type(type_info)) {
+        return nullptr;
+    }
+    return new ColumnContainsPredicate(type_info, id, operand);
+}
+
+ColumnPredicate* new_column_match_predicate(const TypeInfoPtr& type_info, ColumnId id, const Slice& operand) {
+    if (!is_text_type(type_info)) {
+        return nullptr;
+    }
+    return new ColumnMatchPredicate(type_info, id, operand);
+}
+
+} // namespace starrocks::vectorized
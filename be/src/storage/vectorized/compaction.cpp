@@ -2,10 +2,15 @@
 
 #include "storage/vectorized/compaction.h"
 
+#include <algorithm>
+#include <shared_mutex>
+
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
 #include "storage/rowset/rowset_factory.h"
+#include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/merge_iterator.h"
 #include "storage/vectorized/reader.h"
 #include "util/defer_op.h"
 #include "util/time.h"
@@ -58,15 +63,19 @@ Status Compaction::do_compaction_impl() {
     _output_version = Version(_input_rowsets.front()->start_version(), _input_rowsets.back()->end_version());
     _tablet->compute_version_hash_from_rowsets(_input_rowsets, &_output_version_hash);
 
+    _vertical_compaction = should_merge_vertically();
+
     LOG(INFO) << "start " << compaction_name() << ". tablet=" << _tablet->full_name()
-              << ", output version is=" << _output_version.first << "-" << _output_version.second;
+              << ", output version is=" << _output_version.first << "-" << _output_version.second
+              << ", vertical=" << _vertical_compaction;
 
     RETURN_IF_ERROR(construct_output_rowset_writer());
     TRACE("prepare finished");
 
     // 2. write combined rows to output rowset
     Statistics stats;
-    auto res = merge_rowsets(_mem_tracker.get(), &stats);
+    auto res = _vertical_compaction ? vertical_merge_rowsets(_mem_tracker.get(), &stats)
+                                    : merge_rowsets(_mem_tracker.get(), &stats);
 
     if (!res.ok()) {
         LOG(WARNING) << "fail to do " << compaction_name() << ". res=" << res.to_string()
@@ -128,6 +137,13 @@ Status Compaction::construct_output_rowset_writer() {
     context.version = _output_version;
     context.version_hash = _output_version_hash;
     context.segments_overlap = NONOVERLAPPING;
+    context.drop_page_cache = config::drop_page_cache_of_compaction_output;
+    if (_vertical_compaction && _input_row_num > 0) {
+        // The segments are decided by the key columns, so limit the rows of a segment by the size of the rows.
+        const int64_t max_segment_size = OLAP_MAX_COLUMN_SEGMENT_FILE_SIZE * OLAP_COLUMN_FILE_SEGMENT_SIZE_SCALE;
+        const int64_t avg_row_size = std::max<int64_t>(1, _input_rowsets_size / _input_row_num);
+        context.max_rows_per_segment = std::clamp<int64_t>(max_segment_size / avg_row_size, 1, INT32_MAX);
+    }
     OLAPStatus olap_status = RowsetFactory::create_rowset_writer(context, &_output_rs_writer);
     if (olap_status != OLAPStatus::OLAP_SUCCESS) {
         std::stringstream ss;
@@ -213,6 +229,220 @@ Status Compaction::merge_rowsets(MemTracker* mem_tracker, Statistics* stats_outp
     return Status::OK();
 }
 
+bool Compaction::should_merge_vertically() const {
+    if (!config::enable_vertical_compaction) {
+        return false;
+    }
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    // The aggregate keys tablets need to aggregate the value columns of the rows with the same keys.
+    if (tablet_schema.keys_type() != DUP_KEYS && tablet_schema.keys_type() != UNIQUE_KEYS) {
+        return false;
+    }
+    if (tablet_schema.num_columns() <= std::max(1, config::vertical_compaction_max_columns_per_group)) {
+        return false;
+    }
+    // Each overlapping segment is a source of the merge of the keys.
+    size_t num_sources = 0;
+    for (const auto& rowset : _input_rowsets) {
+        num_sources += rowset->rowset_meta()->is_segments_overlapping() ? rowset->num_segments() : 1;
+    }
+    if (num_sources > RowSource::MAX_SOURCES) {
+        return false;
+    }
+    // The delete predicates, which could be on the value columns, are only evaluated by merge_rowsets().
+    std::shared_lock rdlock(_tablet->get_header_lock());
+    for (const DeletePredicatePB& pred : _tablet->delete_predicates()) {
+        if (pred.version() >= _output_version.first && pred.version() <= _output_version.second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status Compaction::get_segment_iterators(const Schema& schema, size_t chunk_size, OlapReaderStatistics* stats,
+                                         std::vector<ChunkIteratorPtr>* iterators) {
+    RowsetReadOptions rs_opts;
+    rs_opts.reader_type = compaction_type();
+    rs_opts.chunk_size = chunk_size;
+    rs_opts.stats = stats;
+    rs_opts.tablet_schema = &_tablet->tablet_schema();
+    for (const auto& rowset : _input_rowsets) {
+        if (rowset->empty()) {
+            continue;
+        }
+        RETURN_IF_ERROR(rowset->get_segment_iterators(schema, rs_opts, iterators));
+    }
+    return Status::OK();
+}
+
+Status Compaction::vertical_merge_rowsets(MemTracker* mem_tracker, Statistics* stats_output) {
+    TRACE_COUNTER_SCOPE_LATENCY_US("merge_rowsets_latency_us");
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    const size_t num_columns = tablet_schema.num_columns();
+    const size_t num_key_columns = tablet_schema.num_key_columns();
+    const size_t max_columns_per_group = std::max(1, config::vertical_compaction_max_columns_per_group);
+
+    // The key columns are the first group, then the value columns are split into groups.
+    std::vector<std::vector<ColumnId>> column_groups(1);
+    for (ColumnId cid = 0; cid < num_key_columns; ++cid) {
+        column_groups[0].push_back(cid);
+    }
+    for (ColumnId cid = num_key_columns; cid < num_columns; ++cid) {
+        if (column_groups.size() == 1 || column_groups.back().size() >= max_columns_per_group) {
+            column_groups.emplace_back();
+        }
+        column_groups.back().push_back(cid);
+    }
+
+    int64_t num_rows = 0;
+    int64_t total_row_size = 0;
+    for (auto& rowset : _input_rowsets) {
+        num_rows += rowset->num_rows();
+        total_row_size += rowset->total_row_size();
+    }
+    int64_t avg_row_size = (total_row_size + 1) / (num_rows + 1);
+
+    RowSourceBuffer sources(strings::Substitute("$0/$1_row_source.tmp", _tablet->tablet_path(),
+                                                _output_rs_writer->rowset_id().to_string()),
+                            config::vertical_compaction_max_row_source_memory_bytes);
+    for (size_t i = 0; i < column_groups.size(); ++i) {
+        const auto& column_group = column_groups[i];
+        uint64_t chunk_size = DEFAULT_CHUNK_SIZE;
+        if (mem_tracker->limit() > 0) {
+            // Only the columns of the group are read.
+            int64_t avg_group_row_size = avg_row_size * column_group.size() / num_columns;
+            chunk_size = 1 + mem_tracker->limit() / (_input_rowsets.size() * avg_group_row_size + 1);
+        }
+        chunk_size = std::min<uint64_t>(chunk_size, config::vector_chunk_size);
+        RETURN_IF_ERROR(vertical_merge_column_group(column_group, i == 0, chunk_size, &sources, stats_output));
+    }
+
+    OLAPStatus olap_status = _output_rs_writer->final_flush();
+    if (olap_status != OLAP_SUCCESS) {
+        LOG(WARNING) << "failed to flush rowset when merging rowsets of tablet " + _tablet->full_name()
+                     << ", err=" << olap_status;
+        return Status::InternalError("failed to flush rowset when merging rowsets of tablet error.");
+    }
+    return Status::OK();
+}
+
+Status Compaction::vertical_merge_column_group(const std::vector<ColumnId>& column_group, bool is_key,
+                                               size_t chunk_size, RowSourceBuffer* sources, Statistics* stats_output) {
+    Schema schema = ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema(), column_group);
+    OlapReaderStatistics stats;
+    std::vector<ChunkIteratorPtr> iterators;
+    RETURN_IF_ERROR(get_segment_iterators(schema, chunk_size, &stats, &iterators));
+    if (iterators.size() > RowSource::MAX_SOURCES) {
+        return Status::InternalError(
+                strings::Substitute("too many segments to merge vertically: $0", iterators.size()));
+    }
+
+    auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
+    auto chunk = ChunkHelper::new_chunk(schema, chunk_size);
+    auto tracker = std::make_unique<MemTracker>(-1, "merge_rowsets", _mem_tracker.get(), true);
+    DeferOp memory_tracker_releaser([&tracker] { return tracker->release(tracker->consumption()); });
+
+    auto add_columns = [&](Chunk* chunk) -> Status {
+        ChunkHelper::padding_char_columns(char_field_indexes, schema, _tablet->tablet_schema(), chunk);
+        OLAPStatus olap_status = _output_rs_writer->add_columns(*chunk, column_group, is_key);
+        if (olap_status != OLAP_SUCCESS) {
+            LOG(WARNING) << "writer add_columns error, err=" << olap_status;
+            return Status::InternalError("writer add_columns error.");
+        }
+        return Status::OK();
+    };
+
+    if (is_key) {
+        std::vector<RowSource> chunk_sources;
+        ChunkIteratorPtr iterator = iterators.empty() ? nullptr : new_merge_iterator(iterators, &chunk_sources);
+        // Of the rows with the same keys of the unique keys tablets, only the last one is kept. So the last row of
+        // a chunk is pending until it's compared with the first row of the next chunk.
+        const bool is_unique = _tablet->keys_type() == UNIQUE_KEYS;
+        auto pending_chunk = ChunkHelper::new_chunk(schema, chunk_size);
+        std::vector<RowSource> pending_sources;
+        auto equal_keys = [&](const Chunk& lhs, size_t m, const Chunk& rhs, size_t n) {
+            for (size_t i = 0; i < schema.num_key_fields(); i++) {
+                if (lhs.get_column_by_index(i)->compare_at(m, n, *rhs.get_column_by_index(i), -1) != 0) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        auto flush_pending = [&]() -> Status {
+            if (pending_sources.empty()) {
+                return Status::OK();
+            }
+            RETURN_IF_ERROR(sources->append(pending_sources));
+            Buffer<uint8_t> selection(pending_sources.size());
+            size_t replaced_rows = 0;
+            for (size_t i = 0; i < pending_sources.size(); i++) {
+                selection[i] = !pending_sources[i].replaced();
+                replaced_rows += pending_sources[i].replaced();
+            }
+            if (replaced_rows > 0) {
+                pending_chunk->filter(selection);
+                stats_output->merged_rows += replaced_rows;
+            }
+            stats_output->output_rows += pending_chunk->num_rows();
+            pending_sources.clear();
+            return pending_chunk->num_rows() > 0 ? add_columns(pending_chunk.get()) : Status::OK();
+        };
+
+        while (iterator != nullptr) {
+            chunk->reset();
+            Status status = iterator->get_next(chunk.get());
+            if (status.is_end_of_file()) {
+                break;
+            } else if (!status.ok()) {
+                return Status::InternalError("reader get_next error.");
+            }
+            DCHECK_EQ(chunk->num_rows(), chunk_sources.size());
+            if (is_unique) {
+                for (size_t i = 0; i + 1 < chunk->num_rows(); i++) {
+                    if (equal_keys(*chunk, i, *chunk, i + 1)) {
+                        chunk_sources[i].set_replaced();
+                    }
+                }
+                if (!pending_sources.empty() &&
+                    equal_keys(*pending_chunk, pending_chunk->num_rows() - 1, *chunk, 0)) {
+                    pending_sources.back().set_replaced();
+                }
+            }
+            RETURN_IF_ERROR(flush_pending());
+            pending_chunk.swap(chunk);
+            pending_sources.swap(chunk_sources);
+        }
+        RETURN_IF_ERROR(flush_pending());
+        if (iterator != nullptr) {
+            iterator->close();
+        }
+        RETURN_IF_ERROR(sources->flush());
+        stats_output->filtered_rows += stats.rows_del_filtered;
+    } else if (!iterators.empty()) {
+        RETURN_IF_ERROR(sources->rewind());
+        auto iterator = new_row_source_merge_iterator(std::move(iterators), sources);
+        while (true) {
+            chunk->reset();
+            Status status = iterator->get_next(chunk.get());
+            if (status.is_end_of_file()) {
+                break;
+            } else if (!status.ok()) {
+                return status;
+            }
+            RETURN_IF_ERROR(add_columns(chunk.get()));
+        }
+        iterator->close();
+    }
+
+    OLAPStatus olap_status = _output_rs_writer->flush_columns();
+    if (olap_status != OLAP_SUCCESS) {
+        LOG(WARNING) << "failed to flush columns when merging rowsets of tablet " + _tablet->full_name()
+                     << ", err=" << olap_status;
+        return Status::InternalError("failed to flush columns when merging rowsets of tablet error.");
+    }
+    return Status::OK();
+}
+
 void Compaction::modify_rowsets() {
     std::vector<RowsetSharedPtr> output_rowsets;
     output_rowsets.push_back(_output_rowset);
@@ -12,6 +12,8 @@
 #include "storage/tablet.h"
 #include "storage/tablet_meta.h"
 #include "storage/utils.h"
+#include "storage/vectorized/chunk_iterator.h"
+#include "storage/vectorized/row_source_buffer.h"
 #include "util/semaphore.hpp"
 
 namespace starrocks::vectorized {
@@ -57,6 +59,21 @@ protected:
     // return others on error
     Status merge_rowsets(MemTracker* mem_tracker, Statistics* stats_output);
 
+    // Return true if the rowsets should be merged by vertical_merge_rowsets().
+    bool should_merge_vertically() const;
+
+    // Same as merge_rowsets(), but the key columns are merged first, which records the source of each merged row,
+    // then the value columns are merged group by group in the recorded order. So the memory is bounded by the
+    // number of the columns of a group instead of all the columns.
+    Status vertical_merge_rowsets(MemTracker* mem_tracker, Statistics* stats_output);
+
+    Status vertical_merge_column_group(const std::vector<ColumnId>& column_group, bool is_key, size_t chunk_size,
+                                       RowSourceBuffer* sources, Statistics* stats_output);
+
+    // Get the iterators of the segments of the input rowsets, whose rows are in the same order for any |schema|.
+    Status get_segment_iterators(const Schema& schema, size_t chunk_size, OlapReaderStatistics* stats,
+                                 std::vector<ChunkIteratorPtr>* iterators);
+
     void modify_rowsets();
 
     Status construct_output_rowset_writer();
@@ -82,6 +99,7 @@ protected:
     CompactionState _state;
 
     Version _output_version;
+    bool _vertical_compaction = false;
     VersionHash _output_version_hash;
 
     RuntimeProfile _runtime_profile;
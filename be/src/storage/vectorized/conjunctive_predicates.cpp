@@ -2,7 +2,10 @@
 
 #include "storage/vectorized/conjunctive_predicates.h"
 
+#include <numeric>
+
 #include "column/chunk.h"
+#include "util/stopwatch.hpp"
 
 namespace starrocks::vectorized {
 
@@ -79,10 +82,31 @@ inline void ConjunctivePredicates::_evaluate_non_vec(const Chunk* chunk, uint8_t
             }
         }
 
-        for (size_t i = 0; selected_size > 0 && i < _non_vec_preds.size(); ++i) {
+        const size_t num_preds = _non_vec_preds.size();
+        if (_non_vec_order.size() != num_preds) {
+            _non_vec_stats.assign(num_preds, ConjunctStats());
+            _non_vec_order.resize(num_preds);
+            std::iota(_non_vec_order.begin(), _non_vec_order.end(), 0);
+        }
+        const bool measure = num_preds > 1;
+        if (measure) {
+            sort_conjuncts_by_rank(&_non_vec_order, [this](uint32_t i) -> const ConjunctStats& {
+                return _non_vec_stats[i];
+            });
+        }
+        for (size_t k = 0; selected_size > 0 && k < num_preds; ++k) {
+            const uint32_t i = _non_vec_order[k];
             const ColumnPredicate* pred = _non_vec_preds[i];
             const ColumnPtr& c = chunk->get_column_by_id(pred->column_id());
+            if (!measure) {
+                selected_size = pred->evaluate_branchless(c.get(), _selected_idx.data(), selected_size);
+                continue;
+            }
+            MonotonicStopWatch watch;
+            watch.start();
+            const uint16_t input_size = selected_size;
             selected_size = pred->evaluate_branchless(c.get(), _selected_idx.data(), selected_size);
+            _non_vec_stats[i].update(input_size, selected_size, watch.elapsed_time());
         }
 
         memset(&selection[from], 0, to - from);
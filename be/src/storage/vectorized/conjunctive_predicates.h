@@ -6,6 +6,7 @@
 
 #include "butil/containers/flat_map.h"
 #include "storage/vectorized/column_predicate.h"
+#include "util/conjunct_stats.h"
 
 namespace starrocks::vectorized {
 
@@ -80,6 +81,10 @@ private:
     std::vector<const ColumnPredicate*> _vec_preds;
     std::vector<const ColumnPredicate*> _non_vec_preds;
     mutable std::vector<uint16_t> _selected_idx;
+    // The non-vectorized predicates are evaluated one by one on the rows selected by the former ones, in the order
+    // of |_non_vec_order| sorted by their statistics.
+    mutable std::vector<ConjunctStats> _non_vec_stats;
+    mutable std::vector<uint32_t> _non_vec_order;
 };
 
 inline ConjunctivePredicates::ConjunctivePredicates(const std::initializer_list<const ColumnPredicate*>& preds) {
@@ -2,6 +2,8 @@
 
 #include "storage/vectorized/cumulative_compaction.h"
 
+#include <limits>
+
 #include "util/starrocks_metrics.h"
 #include "util/time.h"
 #include "util/trace.h"
@@ -46,7 +48,9 @@ Status CumulativeCompaction::compact() {
     _state = CompactionState::SUCCESS;
 
     // 5. set cumulative point
-    _tablet->set_cumulative_layer_point(_input_rowsets.back()->end_version() + 1);
+    if (_advance_cumulative_point) {
+        _tablet->set_cumulative_layer_point(_input_rowsets.back()->end_version() + 1);
+    }
 
     // 6. add metric to cumulative compaction
     StarRocksMetrics::instance()->cumulative_compaction_deltas_total.increment(_input_rowsets.size());
@@ -68,6 +72,10 @@ Status CumulativeCompaction::pick_rowsets_to_compact() {
     std::sort(candidate_rowsets.begin(), candidate_rowsets.end(), Rowset::comparator);
     RETURN_IF_ERROR(check_version_continuity(candidate_rowsets));
 
+    if (_tablet->keys_type() == KeysType::DUP_KEYS && config::enable_size_tiered_compaction_for_dup_keys) {
+        return _pick_rowsets_by_size_tier(candidate_rowsets);
+    }
+
     std::vector<RowsetSharedPtr> transient_rowsets;
     size_t compaction_score = 0;
     // the last delete version we meet when traversing candidate_rowsets
@@ -163,4 +171,113 @@ Status CumulativeCompaction::pick_rowsets_to_compact() {
     return Status::OK();
 }
 
+int CumulativeCompaction::size_tiered_level(int64_t size) {
+    const int64_t multiple = std::max<int64_t>(2, config::size_tiered_compaction_level_multiple);
+    int64_t upper_bound = std::max<int64_t>(1, config::size_tiered_compaction_min_level_size);
+    int level = 0;
+    while (size > upper_bound) {
+        ++level;
+        if (upper_bound > std::numeric_limits<int64_t>::max() / multiple) {
+            break;
+        }
+        upper_bound *= multiple;
+    }
+    return level;
+}
+
+Status CumulativeCompaction::_pick_rowsets_by_size_tier(const std::vector<RowsetSharedPtr>& candidate_rowsets) {
+    // 1. the leading delete versions and the leading rowsets that have reached the size threshold won't be
+    // merged by cumulative compaction anymore, hand them over to base compaction.
+    size_t begin = 0;
+    for (; begin < candidate_rowsets.size(); ++begin) {
+        const RowsetSharedPtr& rowset = candidate_rowsets[begin];
+        if (_tablet->version_for_delete_predicate(rowset->version())) {
+            continue;
+        }
+        if (rowset->rowset_meta()->is_segments_overlapping() ||
+            static_cast<int64_t>(rowset->data_disk_size()) < _cumulative_rowset_size_threshold) {
+            break;
+        }
+    }
+    if (begin > 0) {
+        _tablet->set_cumulative_layer_point(candidate_rowsets[begin - 1]->end_version() + 1);
+    }
+
+    // 2. the rowsets before a delete version must be merged before the delete version goes to base compaction,
+    // so they are merged in a whole.
+    size_t end = begin;
+    for (; end < candidate_rowsets.size(); ++end) {
+        if (_tablet->version_for_delete_predicate(candidate_rowsets[end]->version())) {
+            break;
+        }
+    }
+    if (begin == end) {
+        return Status::NotFound("cumulative compaction no suitable version error.");
+    }
+    if (end < candidate_rowsets.size()) {
+        _input_rowsets.assign(candidate_rowsets.begin() + begin, candidate_rowsets.begin() + end);
+        return Status::OK();
+    }
+
+    // 3. split the rowsets into tiers of the consecutive rowsets in the same level, and merge the first full tier
+    // of the lowest level. The rowsets of the other tiers are not rewritten.
+    int best_level = std::numeric_limits<int>::max();
+    size_t best_begin = 0;
+    size_t best_end = 0;
+    size_t tier_begin = begin;
+    int tier_level = size_tiered_level(candidate_rowsets[begin]->data_disk_size());
+    for (size_t i = begin; i <= end; ++i) {
+        int level = i < end ? size_tiered_level(candidate_rowsets[i]->data_disk_size()) : -1;
+        if (level == tier_level) {
+            continue;
+        }
+        if (tier_level < best_level) {
+            size_t compaction_score = 0;
+            size_t tier_end = tier_begin;
+            while (tier_end < i && compaction_score < config::max_cumulative_compaction_num_singleton_deltas) {
+                compaction_score += candidate_rowsets[tier_end++]->rowset_meta()->get_compaction_score();
+            }
+            if (compaction_score >= config::min_cumulative_compaction_num_singleton_deltas) {
+                best_level = tier_level;
+                best_begin = tier_begin;
+                best_end = tier_end;
+            }
+        }
+        tier_begin = i;
+        tier_level = level;
+    }
+
+    if (best_begin == best_end) {
+        // no tier is full. as the count-based policy, increase the cumulative point after waiting for a long time,
+        // to ensure that the base compaction can continue.
+        int64_t now = UnixMillis();
+        int64_t last_cumu = _tablet->last_cumu_compaction_success_time();
+        int64_t last_base = _tablet->last_base_compaction_success_time();
+        if (last_cumu == 0 || last_base == 0) {
+            if (last_cumu == 0) {
+                _tablet->set_last_cumu_compaction_success_time(now);
+            }
+            if (last_base == 0) {
+                _tablet->set_last_base_compaction_success_time(now);
+            }
+            return Status::NotFound("cumulative compaction no suitable version error.");
+        }
+        int64_t interval_threshold = config::base_compaction_interval_seconds_since_last_operation * 1000;
+        if (now - last_cumu > interval_threshold && now - last_base > interval_threshold) {
+            for (size_t i = begin; i < end; ++i) {
+                if (candidate_rowsets[i]->rowset_meta()->is_segments_overlapping()) {
+                    _input_rowsets.assign(candidate_rowsets.begin() + begin, candidate_rowsets.begin() + end);
+                    return Status::OK();
+                }
+            }
+            _tablet->set_cumulative_layer_point(candidate_rowsets[end - 1]->end_version() + 1);
+        }
+        return Status::NotFound("cumulative compaction no suitable version error.");
+    }
+
+    _input_rowsets.assign(candidate_rowsets.begin() + best_begin, candidate_rowsets.begin() + best_end);
+    _advance_cumulative_point = false;
+    return Status::OK();
+}
+
 } // namespace starrocks::vectorized
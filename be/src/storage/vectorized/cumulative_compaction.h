@@ -3,6 +3,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "storage/vectorized/compaction.h"
 
@@ -18,6 +19,9 @@ public:
 
     Status compact() override;
 
+    // The level of a rowset of |size| bytes in the size-tiered policy.
+    static int size_tiered_level(int64_t size);
+
 protected:
     Status pick_rowsets_to_compact() override;
 
@@ -26,7 +30,14 @@ protected:
     ReaderType compaction_type() const override { return ReaderType::READER_CUMULATIVE_COMPACTION; }
 
 private:
+    // Picks the full tier of the lowest level for duplicate-key tablets, see
+    // config::enable_size_tiered_compaction_for_dup_keys.
+    Status _pick_rowsets_by_size_tier(const std::vector<RowsetSharedPtr>& candidate_rowsets);
+
     int64_t _cumulative_rowset_size_threshold;
+    // The size-tiered policy keeps the cumulative point before the merged tier, because the rowsets before it
+    // may have not been merged yet.
+    bool _advance_cumulative_point = true;
 };
 
 } // namespace starrocks::vectorized
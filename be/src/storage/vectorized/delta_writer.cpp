@@ -2,8 +2,15 @@
 
 #include "storage/vectorized/delta_writer.h"
 
+#include <filesystem>
+
+#include "gutil/strings/substitute.h"
+#include "http/http_client.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
 #include "storage/data_dir.h"
 #include "storage/memtable_flush_executor.h"
+#include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/schema.h"
 #include "storage/schema_change.h"
@@ -15,6 +22,40 @@
 namespace starrocks {
 namespace vectorized {
 
+static const std::string kDownloadPath = "/api/_tablet/_download";
+static const int kDownloadRetryTimes = 3;
+static const int kGetLengthTimeoutSec = 10;
+
+// Download the file of |url| to |local_path| of |data_dir| like the clone task.
+static Status download_file(DataDir* data_dir, const std::string& url, const std::string& local_path) {
+    uint64_t file_size = 0;
+    auto get_file_size_cb = [&url, &file_size](HttpClient* client) {
+        RETURN_IF_ERROR(client->init(url));
+        client->set_timeout_ms(kGetLengthTimeoutSec * 1000);
+        RETURN_IF_ERROR(client->head());
+        file_size = client->get_content_length();
+        return Status::OK();
+    };
+    RETURN_IF_ERROR(HttpClient::execute_with_retry(kDownloadRetryTimes, 1, get_file_size_cb));
+    if (data_dir->reach_capacity_limit(file_size)) {
+        return Status::InternalError("Disk reach capacity limit");
+    }
+    uint64_t timeout_sec = std::max<uint64_t>(file_size / config::download_low_speed_limit_kbps / 1024,
+                                              config::download_low_speed_time);
+    auto download_cb = [&url, &local_path, file_size, timeout_sec](HttpClient* client) {
+        RETURN_IF_ERROR(client->init(url));
+        client->set_timeout_ms(timeout_sec * 1000);
+        RETURN_IF_ERROR(client->download(local_path));
+        uint64_t local_file_size = std::filesystem::file_size(local_path);
+        if (local_file_size != file_size) {
+            LOG(WARNING) << "Fail to download " << url << ". file_size=" << local_file_size << "/" << file_size;
+            return Status::InternalError("mismatched file size");
+        }
+        return Status::OK();
+    };
+    return HttpClient::execute_with_retry(kDownloadRetryTimes, 1, download_cb);
+}
+
 Status DeltaWriter::open(WriteRequest* req, MemTracker* mem_tracker, DeltaWriter** writer) {
     *writer = new DeltaWriter(req, mem_tracker, StorageEngine::instance());
     return Status::OK();
@@ -112,6 +153,11 @@ Status DeltaWriter::init() {
         }
     }
 
+    _tablet_schema = &(_tablet->tablet_schema());
+    if (_tablet->keys_type() == KeysType::PRIMARY_KEYS) {
+        RETURN_IF_ERROR(_init_partial_update());
+    }
+
     RowsetWriterContext writer_context(kDataFormatV2, config::storage_format_version);
     writer_context.mem_tracker = _mem_tracker.get();
     writer_context.rowset_id = _storage_engine->next_rowset_id();
@@ -121,11 +167,16 @@ Status DeltaWriter::init() {
     writer_context.tablet_schema_hash = _req.schema_hash;
     writer_context.rowset_type = BETA_ROWSET;
     writer_context.rowset_path_prefix = _tablet->tablet_path();
-    writer_context.tablet_schema = &(_tablet->tablet_schema());
+    writer_context.tablet_schema = _tablet_schema;
+    if (_partial_update_schema != nullptr) {
+        writer_context.full_tablet_schema = &(_tablet->tablet_schema());
+        writer_context.partial_update_column_ids = _partial_update_column_ids;
+    }
     writer_context.rowset_state = PREPARED;
     writer_context.txn_id = _req.txn_id;
     writer_context.load_id = _req.load_id;
     writer_context.segments_overlap = OVERLAPPING;
+    writer_context.drop_page_cache = config::drop_page_cache_of_load_output;
     OLAPStatus olap_status = RowsetFactory::create_rowset_writer(writer_context, &_rowset_writer);
     if (olap_status != OLAPStatus::OLAP_SUCCESS) {
         std::stringstream ss;
@@ -134,7 +185,6 @@ Status DeltaWriter::init() {
         return Status::InternalError(ss.str());
     }
 
-    _tablet_schema = &(_tablet->tablet_schema());
     _reset_mem_table();
 
     // create flush handler
@@ -154,11 +204,15 @@ Status DeltaWriter::write(Chunk* chunk, const uint32_t* indexes, uint32_t from,
     if (_is_cancelled) {
         return Status::OK();
     }
+    if (_req.is_secondary_replica) {
+        return Status::InternalError("Write rows to the secondary replica");
+    }
     if (!_is_init) {
         RETURN_IF_ERROR(init());
     }
 
     bool flush = _mem_table->insert(chunk, indexes, from, size);
+    _memtable_consumption = static_cast<int64_t>(_mem_table->memory_usage());
 
     if (flush || _mem_table->is_full()) {
         RETURN_IF_ERROR(_flush_memtable_async());
@@ -207,15 +261,60 @@ Status DeltaWriter::wait_memtable_flushed() {
     return Status::OK();
 }
 
+Status DeltaWriter::_init_partial_update() {
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    size_t num_slots = _req.slots->size();
+    if (num_slots > 0 && (*_req.slots)[num_slots - 1]->col_name() == "__op") {
+        num_slots--;
+    }
+    if (num_slots >= tablet_schema.num_columns()) {
+        return Status::OK();
+    }
+    // The slots are in the order of the tablet schema.
+    std::vector<uint32_t> column_ids;
+    for (size_t i = 0; i < num_slots; i++) {
+        const std::string& name = (*_req.slots)[i]->col_name();
+        auto cid = static_cast<int64_t>(tablet_schema.field_index(name));
+        if (cid < 0 || (!column_ids.empty() && cid <= column_ids.back())) {
+            return Status::InvalidArgument(
+                    Substitute("Invalid column $0 of the partial update of tablet $1", name, _req.tablet_id));
+        }
+        column_ids.push_back(static_cast<uint32_t>(cid));
+    }
+    const size_t num_key_columns = tablet_schema.num_key_columns();
+    if (column_ids.size() < num_key_columns || column_ids[num_key_columns - 1] != num_key_columns - 1) {
+        return Status::InvalidArgument(
+                Substitute("The partial update of tablet $0 must write all the key columns", _req.tablet_id));
+    }
+    _partial_update_schema = tablet_schema.create_partial(column_ids);
+    _partial_update_column_ids = std::move(column_ids);
+    _tablet_schema = _partial_update_schema.get();
+    VLOG(1) << "Partial update of tablet " << _req.tablet_id << ", columns=" << _partial_update_column_ids.size()
+            << "/" << tablet_schema.num_columns();
+    return Status::OK();
+}
+
 void DeltaWriter::_reset_mem_table() {
     _mem_table = std::make_shared<MemTable>(_tablet->tablet_id(), _tablet_schema, _req.slots, _rowset_writer.get(),
                                             _mem_tracker.get());
+    _memtable_consumption = 0;
 }
 
 Status DeltaWriter::close() {
     if (_is_cancelled) {
         return Status::OK();
     }
+    if (_req.is_secondary_replica) {
+        std::lock_guard l(_replica_lock);
+        if (!_is_init) {
+            RETURN_IF_ERROR(init());
+        }
+        _mem_table.reset();
+        _memtable_consumption = 0;
+        _replica_deadline = std::chrono::steady_clock::now() +
+                            std::chrono::seconds(config::tablet_writer_replicate_rowset_timeout_sec);
+        return Status::OK();
+    }
     if (!_is_init) {
         // if this delta writer is not initialized, but close() is called.
         // which means this tablet has no data loaded, but at least one tablet
@@ -227,6 +326,7 @@ Status DeltaWriter::close() {
 
     RETURN_IF_ERROR(_flush_memtable_async());
     _mem_table.reset();
+    _memtable_consumption = 0;
     return Status::OK();
 }
 
@@ -235,6 +335,24 @@ Status DeltaWriter::close_wait(google::protobuf::RepeatedPtrField<PTabletInfo>*
         return Status::OK();
     }
     DCHECK(_is_init);
+    if (_req.is_secondary_replica) {
+        std::unique_lock l(_replica_lock);
+        if (!_replica_cv.wait_until(l, _replica_deadline, [this] { return _replica_done; })) {
+            _replica_abandoned = true;
+            return Status::TimedOut(
+                    strings::Substitute("Wait for the rowset of the primary replica timeout. tablet_id=$0, txn_id=$1",
+                                        _req.tablet_id, _req.txn_id));
+        }
+        RETURN_IF_ERROR(_replica_status);
+#ifndef BE_TEST
+        PTabletInfo* tablet_info = tablet_vec->Add();
+        tablet_info->set_tablet_id(_tablet->tablet_id());
+        tablet_info->set_schema_hash(_tablet->schema_hash());
+#endif
+        _delta_written_success = true;
+        LOG(INFO) << "Closed secondary replica delta writer. tablet_id=" << _tablet->tablet_id();
+        return Status::OK();
+    }
     DCHECK(_mem_table == nullptr) << "Must call close before close_wait";
     // return error if previous flush failed
     if (_flush_token->wait() != OLAPStatus::OLAP_SUCCESS) {
@@ -273,10 +391,15 @@ Status DeltaWriter::cancel() {
     if (_is_cancelled) {
         return Status::OK();
     }
+    if (_req.is_secondary_replica) {
+        std::lock_guard l(_replica_lock);
+        _replica_abandoned = true;
+    }
     if (!_is_init) {
         return Status::OK();
     }
     _mem_table.reset();
+    _memtable_consumption = 0;
     if (_flush_token != nullptr) {
         // cancel and wait all memtables in flush queue to be finished
         _flush_token->cancel();
@@ -286,6 +409,84 @@ Status DeltaWriter::cancel() {
     return Status::OK();
 }
 
+Status DeltaWriter::replicate_rowset(const PTabletWriterAddRowsetRequest& request) {
+    DCHECK(_req.is_secondary_replica);
+    // the lock is held while downloading, close_wait() waits for the result anyway.
+    std::lock_guard l(_replica_lock);
+    if (_replica_done) {
+        return Status::InternalError("Duplicated rowset of the primary replica");
+    }
+    if (_replica_abandoned) {
+        return Status::InternalError("The secondary replica is closed or cancelled");
+    }
+    Status st = request.has_status() ? Status(request.status()) : Status::OK();
+    if (st.ok() && !_is_init) {
+        st = init();
+    }
+    RowsetSharedPtr rowset;
+    if (st.ok()) {
+        st = _download_replica_rowset(request, &rowset);
+    }
+    if (st.ok()) {
+        OLAPStatus res = _storage_engine->txn_manager()->commit_txn(_req.partition_id, _tablet, _req.txn_id,
+                                                                    _req.load_id, rowset, false);
+        if (res != OLAP_SUCCESS && res != OLAP_ERR_PUSH_TRANSACTION_ALREADY_EXIST) {
+            st = Status::InternalError("Fail to commit transaction");
+        } else {
+            _cur_rowset = rowset;
+        }
+    }
+    if (st.ok() && _tablet->keys_type() == KeysType::PRIMARY_KEYS) {
+        st = _storage_engine->update_manager()->on_rowset_finished(_tablet.get(), _cur_rowset.get());
+    }
+    LOG_IF(WARNING, !st.ok()) << "Fail to replicate rowset. tablet_id=" << _req.tablet_id << " txn_id=" << _req.txn_id
+                              << " err=" << st.to_string();
+    _replica_done = true;
+    _replica_status = st;
+    _replica_cv.notify_all();
+    return st;
+}
+
+Status DeltaWriter::_download_replica_rowset(const PTabletWriterAddRowsetRequest& request, RowsetSharedPtr* rowset) {
+    RowsetMetaPB rowset_meta_pb;
+    auto rowset_meta = std::make_shared<RowsetMeta>();
+    if (!rowset_meta_pb.ParseFromString(request.rowset_meta()) || !rowset_meta->init_from_pb(rowset_meta_pb)) {
+        return Status::Corruption("Bad rowset meta of the primary replica");
+    }
+    // the files are renamed by the rowset id of this replica, which is protected from the GC by the pending id
+    // of the rowset writer.
+    RowsetId src_rowset_id = rowset_meta->rowset_id();
+    RowsetId rowset_id = _rowset_writer->rowset_id();
+    const std::string url_prefix = strings::Substitute("http://$0:$1$2?token=$3&file=", request.source_host(),
+                                                       request.source_http_port(), kDownloadPath, request.token());
+    const std::string& src_path = request.source_rowset_path();
+    const std::string& path = _tablet->tablet_path();
+    DataDir* data_dir = _tablet->data_dir();
+    for (int i = 0; i < rowset_meta->num_segments(); ++i) {
+        RETURN_IF_ERROR(download_file(data_dir, url_prefix + BetaRowset::segment_file_path(src_path, src_rowset_id, i),
+                                      BetaRowset::segment_file_path(path, rowset_id, i)));
+    }
+    for (int i = 0; i < rowset_meta->get_num_delete_files(); ++i) {
+        RETURN_IF_ERROR(
+                download_file(data_dir, url_prefix + BetaRowset::segment_del_file_path(src_path, src_rowset_id, i),
+                              BetaRowset::segment_del_file_path(path, rowset_id, i)));
+    }
+
+    rowset_meta->set_rowset_id(rowset_id);
+    rowset_meta->set_tablet_id(_tablet->tablet_id());
+    rowset_meta->set_tablet_uid(_tablet->tablet_uid());
+    rowset_meta->set_tablet_schema_hash(_tablet->schema_hash());
+    rowset_meta->set_partition_id(_req.partition_id);
+    rowset_meta->set_txn_id(_req.txn_id);
+    rowset_meta->set_load_id(_req.load_id);
+    rowset_meta->set_rowset_state(PREPARED);
+    if (RowsetFactory::create_rowset(ExecEnv::GetInstance()->tablet_meta_mem_tracker(), &_tablet->tablet_schema(),
+                                     path, rowset_meta, rowset) != OLAP_SUCCESS) {
+        return Status::InternalError("Fail to create the replicated rowset");
+    }
+    return Status::OK();
+}
+
 int64_t DeltaWriter::mem_consumption() const {
     return _mem_tracker->consumption();
 }
@@ -2,6 +2,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
 #include "column/vectorized_fwd.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "storage/rowset/rowset_writer.h"
@@ -32,6 +37,9 @@ struct WriteRequest {
     TupleDescriptor* tuple_desc;
     // slots are in order of tablet's schema
     const std::vector<SlotDescriptor*>* slots;
+    // In the replicated storage, the secondary replica receives no rows, and commits the rowset written and
+    // sent by the primary replica instead, see replicate_rowset().
+    bool is_secondary_replica = false;
 };
 
 // Writer for a particular (load, index, tablet).
@@ -62,9 +70,20 @@ public:
     // wait all memtables in flush queue to be flushed.
     Status wait_memtable_flushed();
 
+    // Download the files of the rowset of the primary replica and commit it, only for the secondary replica.
+    // Unlike the other methods, this may be called concurrently with close() and close_wait(), and close_wait()
+    // waits for it.
+    Status replicate_rowset(const PTabletWriterAddRowsetRequest& request);
+
+    // The rowset committed by close_wait().
+    const RowsetSharedPtr& committed_rowset() const { return _cur_rowset; }
+
     int64_t partition_id() const;
 
     int64_t mem_consumption() const;
+    // The memory consumption of the memtable being written, the rest of mem_consumption() is being flushed.
+    // Unlike the others, this may be called concurrently with write().
+    int64_t memtable_consumption() const { return _memtable_consumption.load(); }
 
 private:
     DeltaWriter(WriteRequest* req, MemTracker* parent, StorageEngine* storage_engine);
@@ -76,19 +95,38 @@ private:
 
     void _reset_mem_table();
 
+    // Set up the partial update if the slots are some of the columns of the primary key tablet.
+    Status _init_partial_update();
+
+    Status _download_replica_rowset(const PTabletWriterAddRowsetRequest& request, RowsetSharedPtr* rowset);
+
     bool _is_init = false;
     WriteRequest _req;
     TabletSharedPtr _tablet;
     RowsetSharedPtr _cur_rowset;
     std::unique_ptr<RowsetWriter> _rowset_writer;
     std::shared_ptr<MemTable> _mem_table;
+    std::atomic<int64_t> _memtable_consumption{0};
     const TabletSchema* _tablet_schema;
+    // For the partial update, the schema of the columns written, see RowsetWriterContext.
+    std::unique_ptr<TabletSchema> _partial_update_schema;
+    std::vector<uint32_t> _partial_update_column_ids;
     bool _delta_written_success;
 
     StorageEngine* _storage_engine;
     std::unique_ptr<FlushToken> _flush_token;
     std::unique_ptr<MemTracker> _mem_tracker;
     bool _is_cancelled = false;
+
+    // The state of the rowset replicated from the primary replica, for the secondary replica.
+    std::mutex _replica_lock;
+    std::condition_variable _replica_cv;
+    std::chrono::steady_clock::time_point _replica_deadline;
+    // set if the rowset is committed or failed.
+    bool _replica_done = false;
+    // set if close_wait() stops waiting or the writer is cancelled, then the rowset is rejected.
+    bool _replica_abandoned = false;
+    Status _replica_status;
 };
 
 } // namespace vectorized
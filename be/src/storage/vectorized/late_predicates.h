@@ -0,0 +1,24 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <vector>
+
+namespace starrocks::vectorized {
+
+class ColumnPredicate;
+
+// LatePredicates provides the index filter only predicates that become available while a scan is running,
+// e.g, the min/max ranges of the join runtime filters that arrive after the scan started. The segment
+// iterators prune their unread rows by the zone maps of the new predicates between chunks.
+// It's not thread-safe, and only called by the thread running the scan.
+class LatePredicates {
+public:
+    virtual ~LatePredicates() = default;
+
+    // Return all the predicates available so far, the new ones are appended to the end.
+    // The predicates must stay valid until the scan is closed.
+    virtual const std::vector<const ColumnPredicate*>& poll() = 0;
+};
+
+} // namespace starrocks::vectorized
@@ -2,16 +2,22 @@
 
 #include "storage/vectorized/memtable.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "column/binary_view.h"
 #include "column/type_traits.h"
 #include "common/logging.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/schema.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "util/countdown_latch.h"
 #include "util/orlp/pdqsort.h"
 #include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
 #include "util/time.h"
 
 namespace starrocks::vectorized {
@@ -19,6 +25,9 @@ namespace starrocks::vectorized {
 // TODO(cbl): move to common space latter
 static const string LOAD_OP_COLUMN = "__op";
 static const size_t kPrimaryKeyLimitSize = 128;
+// The integer key columns with more rows than this are sorted by radix sort, which is faster than the comparison sort
+// for the large memtables.
+static const size_t kRadixSortMinRows = 4096;
 
 MemTable::MemTable(int64_t tablet_id, const TabletSchema* tablet_schema, const std::vector<SlotDescriptor*>* slot_descs,
                    RowsetWriter* rowset_writer, MemTracker* mem_tracker)
@@ -77,7 +86,21 @@ size_t MemTable::write_buffer_size() const {
 }
 
 bool MemTable::is_full() const {
-    return write_buffer_size() >= config::write_buffer_size;
+    const size_t size = write_buffer_size();
+    if (size < config::write_buffer_size) {
+        return false;
+    }
+    if (size >= config::write_buffer_size_max) {
+        return true;
+    }
+    // The larger memtables are flushed into fewer and larger segments, so a memtable keeps growing while the load
+    // memory is below its soft limit, and the largest ones are flushed by LoadChannelMgr once it's exceeded.
+    MemTracker* load_mem_tracker = ExecEnv::GetInstance()->load_mem_tracker();
+    if (load_mem_tracker == nullptr || load_mem_tracker->limit() <= 0) {
+        return true;
+    }
+    return load_mem_tracker->consumption() >=
+           load_mem_tracker->limit() / 100 * config::load_process_soft_mem_limit_percent;
 }
 
 bool MemTable::insert(Chunk* chunk, const uint32_t* indexes, uint32_t from, uint32_t size) {
@@ -89,11 +112,15 @@ bool MemTable::insert(Chunk* chunk, const uint32_t* indexes, uint32_t from, uint
     // The shadow column is not exist in _vectorized_schema
     // So the chunk can only be accessed by the subscript
     // instead of the column name.
+    const size_t num_rows = _chunk->num_rows();
     for (int i = 0; i < _slot_descs->size(); ++i) {
         ColumnPtr& src = chunk->get_column_by_slot_id((*_slot_descs)[i]->id());
         ColumnPtr& dest = _chunk->get_column_by_index(i);
         dest->append_selective(*src, indexes, from, size);
     }
+    if (_sorted) {
+        _check_sorted(num_rows);
+    }
 
     if (chunk->has_rows()) {
         _chunk_memory_usage += chunk->memory_usage() * size / chunk->num_rows();
@@ -138,7 +165,8 @@ Status MemTable::finalize() {
                 _merge();
             }
 
-            if (_merge_count > 1) {
+            // The rows merged in order are aggregated in order as well.
+            if (_merge_count > 1 && !_sorted) {
                 _chunk = _aggregator->aggregate_result();
                 _aggregator->aggregate_reset();
 
@@ -186,7 +214,7 @@ Status MemTable::finalize() {
     return Status::OK();
 }
 
-OLAPStatus MemTable::flush() {
+OLAPStatus MemTable::flush(ThreadPool* segment_flush_pool) {
     if (_result_chunk == nullptr) {
         return OLAP_SUCCESS;
     }
@@ -195,7 +223,12 @@ OLAPStatus MemTable::flush() {
     {
         SCOPED_RAW_TIMER(&duration_ns);
         if (!_deletes || _deletes->size() == 0) {
-            RETURN_NOT_OK(_rowset_writer->flush_chunk(*_result_chunk));
+            size_t num_segments = segment_flush_pool != nullptr ? _num_parallel_segments() : 1;
+            if (num_segments > 1) {
+                RETURN_NOT_OK(_flush_parallel_segments(segment_flush_pool, num_segments));
+            } else {
+                RETURN_NOT_OK(_rowset_writer->flush_chunk(*_result_chunk));
+            }
         } else {
             RETURN_NOT_OK(_rowset_writer->flush_chunk_with_deletes(*_result_chunk, *_deletes));
         }
@@ -206,6 +239,45 @@ OLAPStatus MemTable::flush() {
     return OLAP_SUCCESS;
 }
 
+size_t MemTable::_num_parallel_segments() const {
+    // the segments of the primary keys tablets are merged by the rowset writer.
+    if (_keys_type == PRIMARY_KEYS) {
+        return 1;
+    }
+    int64_t min_bytes = std::max<int64_t>(config::memtable_flush_min_bytes_per_parallel_segment, 1);
+    int64_t num_segments = std::min<int64_t>(config::memtable_flush_max_parallel_segments,
+                                             _result_chunk->bytes_usage() / min_bytes);
+    num_segments = std::min<int64_t>(num_segments, _result_chunk->num_rows());
+    return std::max<int64_t>(num_segments, 1);
+}
+
+// The rows of |_result_chunk| are sorted, and the aggregated keys are unique, so each range of rows is written as a
+// segment, and the order of the segment ids doesn't matter.
+OLAPStatus MemTable::_flush_parallel_segments(ThreadPool* segment_flush_pool, size_t num_segments) {
+    const size_t num_rows = _result_chunk->num_rows();
+    std::vector<OLAPStatus> statuses(num_segments, OLAP_SUCCESS);
+    CountDownLatch latch(num_segments);
+    auto flush_segment = [&](size_t i) {
+        size_t from = num_rows * i / num_segments;
+        size_t to = num_rows * (i + 1) / num_segments;
+        auto chunk = _result_chunk->clone_empty_with_schema(to - from);
+        chunk->append(*_result_chunk, from, to - from);
+        statuses[i] = _rowset_writer->flush_chunk(*chunk);
+        latch.count_down();
+    };
+    for (size_t i = 1; i < num_segments; i++) {
+        if (!segment_flush_pool->submit_func([&flush_segment, i] { flush_segment(i); }).ok()) {
+            flush_segment(i);
+        }
+    }
+    flush_segment(0);
+    latch.wait();
+    for (auto st : statuses) {
+        RETURN_NOT_OK(st);
+    }
+    return OLAP_SUCCESS;
+}
+
 void MemTable::_merge() {
     if (_chunk == nullptr || _keys_type == KeysType::DUP_KEYS) {
         return;
@@ -247,7 +319,45 @@ void MemTable::_aggregate(bool is_final) {
     }
 }
 
+int MemTable::_compare_keys(const Chunk& lhs, size_t m, const Chunk& rhs, size_t n) const {
+    for (size_t i = 0; i < _tablet_schema->num_key_columns(); ++i) {
+        int r = lhs.get_column_by_index(i)->compare_at(m, n, *rhs.get_column_by_index(i), -1);
+        if (r != 0) {
+            return r;
+        }
+    }
+    return 0;
+}
+
+void MemTable::_check_sorted(size_t from) {
+    const size_t num_rows = _chunk->num_rows();
+    if (from == num_rows) {
+        return;
+    }
+    if (from == 0 && _last_sorted_row != nullptr) {
+        _sorted = _compare_keys(*_last_sorted_row, 0, *_chunk, 0) <= 0;
+    }
+    // The rows with the same keys are kept in the order of insertion by the sort, so they are in order.
+    for (size_t i = std::max<size_t>(from, 1); _sorted && i < num_rows; ++i) {
+        _sorted = _compare_keys(*_chunk, i - 1, *_chunk, i) <= 0;
+    }
+}
+
 void MemTable::_sort(bool is_final) {
+    if (_sorted) {
+        const size_t num_rows = _chunk->num_rows();
+        if (!is_final && num_rows > 0) {
+            _last_sorted_row = _chunk->clone_empty_with_schema(1);
+            _last_sorted_row->append(*_chunk, num_rows - 1, 1);
+        }
+        _result_chunk = std::move(_chunk);
+        if (!is_final) {
+            _chunk = _result_chunk->clone_empty_with_schema();
+        }
+        _chunk_memory_usage = 0;
+        _chunk_bytes_usage = 0;
+        return;
+    }
     _permutations.resize(_chunk->num_rows());
     for (uint32_t i = 0; i < _chunk->num_rows(); ++i) {
         _permutations[i] = {i, i};
@@ -399,6 +509,13 @@ private:
         // column->size() == perm.size()
         const size_t row_num = (count == 0 || offset + count > perm->size()) ? (perm->size() - offset) : count;
         const CppTypeName* data = static_cast<CppTypeName*>((void*)column->mutable_raw_data());
+        if constexpr (std::is_integral_v<CppTypeName> && !std::is_same_v<CppTypeName, bool> &&
+                      sizeof(CppTypeName) <= sizeof(uint64_t)) {
+            if (row_num >= kRadixSortMinRows) {
+                radix_sort_on_not_null_integer_column_within_range<CppTypeName>(data, perm, offset, row_num);
+                return;
+            }
+        }
         std::vector<SortItem<CppTypeName>> sort_items(row_num);
         for (uint32_t i = 0; i < row_num; ++i) {
             sort_items[i] = {data[(*perm)[i + offset].index_in_chunk], (*perm)[i + offset].index_in_chunk, i};
@@ -420,16 +537,62 @@ private:
         }
     }
 
+    // LSD radix sort by bytes, which is stable, so the ties keep their order in the permutation as the comparison
+    // sort by the permutation index does.
+    template <typename CppTypeName>
+    static void radix_sort_on_not_null_integer_column_within_range(const CppTypeName* data,
+                                                                   MemTable::Permutation* perm, size_t offset,
+                                                                   size_t row_num) {
+        using UnsignedType = std::make_unsigned_t<CppTypeName>;
+        // flip the sign bit, so the signed values are ordered as the unsigned ones.
+        constexpr UnsignedType kSignFlip =
+                std::is_signed_v<CppTypeName> ? UnsignedType(1) << (sizeof(CppTypeName) * 8 - 1) : 0;
+        struct RadixItem {
+            UnsignedType key;
+            uint32_t index_in_chunk;
+        };
+        std::vector<RadixItem> items(row_num);
+        std::vector<RadixItem> buffer(row_num);
+        for (size_t i = 0; i < row_num; ++i) {
+            uint32_t index = (*perm)[i + offset].index_in_chunk;
+            items[i] = {static_cast<UnsignedType>(static_cast<UnsignedType>(data[index]) ^ kSignFlip), index};
+        }
+        for (size_t shift = 0; shift < sizeof(CppTypeName) * 8; shift += 8) {
+            size_t counts[256] = {0};
+            for (const auto& item : items) {
+                counts[(item.key >> shift) & 0xFF]++;
+            }
+            // skip the byte shared by all the values, e.g. the high bytes of small values.
+            if (counts[(items[0].key >> shift) & 0xFF] == row_num) {
+                continue;
+            }
+            size_t pos = 0;
+            for (size_t& count : counts) {
+                size_t n = count;
+                count = pos;
+                pos += n;
+            }
+            for (const auto& item : items) {
+                buffer[counts[(item.key >> shift) & 0xFF]++] = item;
+            }
+            items.swap(buffer);
+        }
+        for (size_t i = 0; i < row_num; ++i) {
+            (*perm)[i + offset].index_in_chunk = items[i].index_in_chunk;
+        }
+    }
+
     static void sort_on_not_null_binary_column_within_range(Column* column, MemTable::Permutation* perm, size_t offset,
                                                             size_t count = 0) {
         const size_t row_num = (count == 0 || offset + count > perm->size()) ? (perm->size() - offset) : count;
         auto* binary_column = reinterpret_cast<BinaryColumn*>(column);
         auto& data = binary_column->get_data();
-        std::vector<SortItem<Slice>> sort_items(row_num);
+        std::vector<SortItem<BinaryView>> sort_items(row_num);
         for (uint32_t i = 0; i < row_num; ++i) {
-            sort_items[i] = {data[(*perm)[i + offset].index_in_chunk], (*perm)[i + offset].index_in_chunk, i};
+            sort_items[i] = {BinaryView(data[(*perm)[i + offset].index_in_chunk]), (*perm)[i + offset].index_in_chunk,
+                             i};
         }
-        auto less_fn = [](const SortItem<Slice>& l, const SortItem<Slice>& r) -> bool {
+        auto less_fn = [](const SortItem<BinaryView>& l, const SortItem<BinaryView>& r) -> bool {
             int res = l.value.compare(r.value);
             if (res == 0) {
                 return l.permutation_index < r.permutation_index;
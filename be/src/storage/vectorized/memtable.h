@@ -14,6 +14,7 @@ namespace starrocks {
 class RowsetWriter;
 class SlotDescriptor;
 class TabletSchema;
+class ThreadPool;
 
 namespace vectorized {
 
@@ -33,7 +34,9 @@ public:
 
     // return true suggests caller should flush this memory table
     bool insert(Chunk* chunk, const uint32_t* indexes, uint32_t from, uint32_t size);
-    OLAPStatus flush();
+    // The large memtable is split into several segments written in parallel by |segment_flush_pool|, if it's not
+    // null, which must not be the pool running this flush.
+    OLAPStatus flush(ThreadPool* segment_flush_pool = nullptr);
     Status finalize();
 
     bool is_full() const;
@@ -41,6 +44,10 @@ public:
 private:
     void _merge();
 
+    // Check whether the rows of |_chunk| from |from| are still in the order of the keys.
+    void _check_sorted(size_t from);
+    int _compare_keys(const Chunk& lhs, size_t m, const Chunk& rhs, size_t n) const;
+
     void _sort(bool is_final);
     void _sort_chunk_by_columns();
     void _sort_chunk_by_rows();
@@ -50,6 +57,9 @@ private:
 
     void _split_upserts_deletes(ChunkPtr& src, ChunkPtr* upserts, std::unique_ptr<Column>* deletes);
 
+    size_t _num_parallel_segments() const;
+    OLAPStatus _flush_parallel_segments(ThreadPool* segment_flush_pool, size_t num_segments);
+
     friend class SortHelper;
 
     struct PermutationItem {
@@ -80,6 +90,12 @@ private:
 
     uint64_t _merge_count = 0;
 
+    // Whether all the rows inserted are in the order of the keys, e.g. the loads of the increasing keys, then they
+    // are not sorted, and the merged rows are neither sorted nor aggregated again by finalize().
+    bool _sorted = true;
+    // the last row sorted, to check the order of the rows inserted after it
+    ChunkPtr _last_sorted_row;
+
     bool _has_op_slot = false;
     std::unique_ptr<Column> _deletes;
 
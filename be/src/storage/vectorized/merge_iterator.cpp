@@ -2,16 +2,20 @@
 
 #include "storage/vectorized/merge_iterator.h"
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
 #include <queue>
 #include <vector>
 
 #include "boost/heap/skew_heap.hpp"
 #include "column/chunk.h"
 #include "common/config.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/current_mem_tracker.h"
 #include "storage/iterators.h" // StorageReadOptions
 #include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/union_iterator.h"
 
 namespace starrocks::vectorized {
 
@@ -66,10 +70,11 @@ private:
 
 class HeapMergeIterator final : public ChunkIterator {
 public:
-    explicit HeapMergeIterator(std::vector<ChunkIteratorPtr> children)
+    explicit HeapMergeIterator(std::vector<ChunkIteratorPtr> children, std::vector<RowSource>* sources = nullptr)
             : ChunkIterator(children[0]->schema(), children[0]->chunk_size()),
               _children(std::move(children)),
-              _chunk_pool(_children.size()) {
+              _chunk_pool(_children.size()),
+              _sources(sources) {
 #ifndef NDEBUG
         // ensure that the children's schemas are all the same.
         for (size_t i = 1; i < _children.size(); i++) {
@@ -109,6 +114,8 @@ private:
     std::vector<ChunkIteratorPtr> _children;
     std::vector<ChunkPtr> _chunk_pool;
     ChunkHeap _heap;
+    // The sources of the returned rows, not recorded if null.
+    std::vector<RowSource>* _sources;
     size_t _merged_rows = 0;
     bool _inited = false;
 };
@@ -132,6 +139,9 @@ inline Status HeapMergeIterator::do_get_next(Chunk* chunk) {
     size_t rows = 0;
     size_t prev_mem_usage = chunk->memory_usage();
     Status st;
+    if (_sources != nullptr) {
+        _sources->clear();
+    }
 
     while (!_heap.empty() && rows < _chunk_size) {
         ComparableChunk min_chunk = _heap.top();
@@ -143,6 +153,9 @@ inline Status HeapMergeIterator::do_get_next(Chunk* chunk) {
         if (offset == 0 && (_heap.empty() || min_chunk.less_than_all(_heap.top()))) {
             if (rows == 0) {
                 chunk->swap_chunk(*min_chunk._chunk);
+                if (_sources != nullptr) {
+                    _sources->insert(_sources->end(), chunk->num_rows(), RowSource(min_chunk._order, false));
+                }
                 return _fill_heap(min_chunk._order);
             } else {
                 // retrieve |min_chunk| next time to avoid memory copy.
@@ -152,6 +165,9 @@ inline Status HeapMergeIterator::do_get_next(Chunk* chunk) {
         }
 
         chunk->append(*min_chunk._chunk, offset, 1);
+        if (_sources != nullptr) {
+            _sources->emplace_back(min_chunk._order, false);
+        }
         min_chunk.advance(1);
         rows += 1;
         if (min_chunk.remaining_rows() > 0) {
@@ -214,6 +230,124 @@ inline void HeapMergeIterator::close() {
     _chunk_pool.clear();
 }
 
+class RowSourceMergeIterator final : public ChunkIterator {
+public:
+    RowSourceMergeIterator(std::vector<ChunkIteratorPtr> children, RowSourceBuffer* sources)
+            : ChunkIterator(children[0]->schema(), children[0]->chunk_size()),
+              _children(std::move(children)),
+              _chunks(_children.size()),
+              _offsets(_children.size(), 0),
+              _sources(sources) {}
+
+    ~RowSourceMergeIterator() override { close(); }
+
+    void close() override;
+
+    size_t merged_rows() const override { return _merged_rows; }
+
+protected:
+    Status do_get_next(Chunk* chunk) override;
+
+private:
+    Status _fill_chunk(size_t child);
+
+    std::vector<ChunkIteratorPtr> _children;
+    std::vector<ChunkPtr> _chunks;
+    // The offsets of the next rows of |_chunks|.
+    std::vector<size_t> _offsets;
+    RowSourceBuffer* _sources;
+    // The sources read from |_sources| that are not consumed yet.
+    std::vector<RowSource> _batch;
+    size_t _batch_offset = 0;
+    size_t _merged_rows = 0;
+};
+
+inline Status RowSourceMergeIterator::do_get_next(Chunk* chunk) {
+    size_t rows = 0;
+    size_t prev_mem_usage = chunk->memory_usage();
+    while (rows < _chunk_size) {
+        if (_batch_offset == _batch.size()) {
+            _batch_offset = 0;
+            Status st = _sources->read(_chunk_size, &_batch);
+            if (st.is_end_of_file()) {
+                break;
+            }
+            RETURN_IF_ERROR(st);
+        }
+        const RowSource source = _batch[_batch_offset];
+        const size_t child = source.source();
+        if (child >= _children.size()) {
+            return Status::Corruption(strings::Substitute("invalid row source $0 of $1 children", child,
+                                                          _children.size()));
+        }
+        if (_chunks[child] == nullptr || _offsets[child] == _chunks[child]->num_rows()) {
+            RETURN_IF_ERROR(_fill_chunk(child));
+        }
+        const Chunk& src = *_chunks[child];
+        const size_t offset = _offsets[child];
+
+        // The consecutive rows of the same source are copied at once.
+        const size_t max_rows = std::min(_batch.size() - _batch_offset, src.num_rows() - offset);
+        size_t n = 1;
+        while (n < max_rows && _batch[_batch_offset + n] == source && (source.replaced() || rows + n < _chunk_size)) {
+            n++;
+        }
+        if (source.replaced()) {
+            _merged_rows += n;
+        } else {
+            chunk->append(src, offset, n);
+            rows += n;
+        }
+        _offsets[child] += n;
+        _batch_offset += n;
+    }
+    CurrentMemTracker::consume(static_cast<int64_t>(chunk->memory_usage()) - static_cast<int64_t>(prev_mem_usage));
+    return rows > 0 ? Status::OK() : Status::EndOfFile("End of row source merge iterator");
+}
+
+inline Status RowSourceMergeIterator::_fill_chunk(size_t child) {
+    if (_chunks[child] == nullptr) {
+        _chunks[child] = ChunkHelper::new_chunk(_schema, _chunk_size);
+    } else {
+        CurrentMemTracker::release(_chunks[child]->memory_usage());
+        _chunks[child]->reset();
+    }
+    _offsets[child] = 0;
+    Status st = _children[child]->get_next(_chunks[child].get());
+    CurrentMemTracker::consume(_chunks[child]->memory_usage());
+    if (st.is_end_of_file() || (st.ok() && _chunks[child]->num_rows() == 0)) {
+        return Status::InternalError(strings::Substitute("child $0 has fewer rows than its row sources", child));
+    }
+    return st;
+}
+
+inline void RowSourceMergeIterator::close() {
+    for (size_t i = 0; i < _children.size(); i++) {
+        if (_chunks[i] != nullptr) {
+            CurrentMemTracker::release(_chunks[i]->memory_usage());
+            _chunks[i].reset();
+        }
+        if (_children[i] != nullptr) {
+            _children[i]->close();
+            _children[i].reset();
+        }
+    }
+    _children.clear();
+    _chunks.clear();
+}
+
+ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& children, std::vector<RowSource>* sources) {
+    DCHECK(!children.empty());
+    DCHECK_LE(children.size(), RowSource::MAX_SOURCES);
+    return std::make_shared<HeapMergeIterator>(children, sources);
+}
+
+ChunkIteratorPtr new_row_source_merge_iterator(std::vector<ChunkIteratorPtr> children, RowSourceBuffer* sources) {
+    DCHECK(!children.empty());
+    DCHECK_LE(children.size(), RowSource::MAX_SOURCES);
+    return std::make_shared<RowSourceMergeIterator>(std::move(children), sources);
+}
+
 ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& children) {
     DCHECK(!children.empty());
     if (children.size() == 1) {
@@ -237,4 +371,54 @@ ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& childre
     return new_merge_iterator(sub_merge_iterators);
 }
 
+ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& children, const TypeInfoPtr& key_type,
+                                    const std::vector<std::pair<Datum, Datum>>& key_ranges, bool* merged) {
+    DCHECK(!children.empty());
+    DCHECK_EQ(children.size(), key_ranges.size());
+    *merged = children.size() > 1;
+    for (const auto& range : key_ranges) {
+        if (range.first.is_null() || range.second.is_null()) {
+            return new_merge_iterator(children);
+        }
+    }
+
+    // Sweep the children in the order of their min keys, a child starts a new group if its min key is greater than
+    // the max keys of all the children before it. The groups are disjoint and in order, so they are concatenated.
+    std::vector<size_t> order(children.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t l, size_t r) {
+        return key_type->cmp(key_ranges[l].first, key_ranges[r].first) < 0;
+    });
+    std::vector<std::vector<size_t>> groups;
+    const Datum* group_max = nullptr;
+    for (size_t i : order) {
+        if (group_max == nullptr || key_type->cmp(key_ranges[i].first, *group_max) > 0) {
+            groups.emplace_back();
+            group_max = &key_ranges[i].second;
+        } else if (key_type->cmp(key_ranges[i].second, *group_max) > 0) {
+            group_max = &key_ranges[i].second;
+        }
+        groups.back().push_back(i);
+    }
+    if (groups.size() == 1) {
+        return new_merge_iterator(children);
+    }
+
+    *merged = false;
+    std::vector<ChunkIteratorPtr> group_iters;
+    group_iters.reserve(groups.size());
+    for (auto& group : groups) {
+        // the rows of the same keys are still in the order of the children.
+        std::sort(group.begin(), group.end());
+        std::vector<ChunkIteratorPtr> group_children;
+        group_children.reserve(group.size());
+        for (size_t i : group) {
+            group_children.emplace_back(children[i]);
+        }
+        *merged |= group_children.size() > 1;
+        group_iters.emplace_back(new_merge_iterator(group_children));
+    }
+    return new_union_iterator(std::move(group_iters));
+}
+
 } // namespace starrocks::vectorized
@@ -2,9 +2,13 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 
+#include "column/datum.h"
+#include "storage/types.h"
 #include "storage/vectorized/chunk_iterator.h"
+#include "storage/vectorized/row_source_buffer.h"
 
 namespace starrocks::vectorized {
 
@@ -22,4 +26,27 @@ namespace starrocks::vectorized {
 // one typical usage of this iterator is merging rows of the segments in the same `rowset`.
 ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& children);
 
+// Same as above, except that the first keys of the rows of |children[i]| are known to be within the closed range
+// |key_ranges[i]| of |key_type|, or unknown if the range is of null datums. The children whose ranges overlap none
+// of the others are concatenated by a UnionIterator rather than merged, so only the rows of the overlapping ones are
+// compared. |*merged| is set to whether any children are merged, i.e. rows from different children may have the same
+// keys.
+ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& children, const TypeInfoPtr& key_type,
+                                    const std::vector<std::pair<Datum, Datum>>& key_ranges, bool* merged);
+
+// Same as new_merge_iterator(children), except that the sources of the returned rows, i.e. their indexes of
+// |children|, are recorded in |sources| on each get_next(). Used by vertical compaction to merge the key columns.
+//
+// REQUIRES:
+//  - |children| has at most RowSource::MAX_SOURCES elements.
+ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& children, std::vector<RowSource>* sources);
+
+// new_row_source_merge_iterator create an iterator which returns the rows of |children| in the order of |sources|,
+// which are recorded by the merge of the key columns of the same children. The rows whose sources are replaced
+// are skipped. Used by vertical compaction to merge the value columns.
+//
+// REQUIRES:
+//  - |children| return the same rows as the children whose key columns are merged, in the same order.
+ChunkIteratorPtr new_row_source_merge_iterator(std::vector<ChunkIteratorPtr> children, RowSourceBuffer* sources);
+
 } // namespace starrocks::vectorized
@@ -355,4 +355,19 @@ inline std::ostream& operator<<(std::ostream& os, const SparseRange& range) {
     return (os << range.to_string());
 }
 
+// Return the ranges of the ascending and distinct |rowids|.
+inline SparseRange rowids2range(const segment_v2::rowid_t* rowids, size_t size) {
+    SparseRange range;
+    size_t i = 0;
+    while (i < size) {
+        size_t j = i + 1;
+        while (j < size && rowids[j] == rowids[j - 1] + 1) {
+            j++;
+        }
+        range.add(Range(rowids[i], rowids[j - 1] + 1));
+        i = j;
+    }
+    return range;
+}
+
 } // namespace starrocks::vectorized
@@ -66,6 +66,19 @@ Status Reader::_get_segment_iterators(const TabletSharedPtr& tablet, const Versi
     return Status::OK();
 }
 
+Status Reader::_get_segment_iterators(const std::vector<RowsetSegmentRange>& ranges, const RowsetReadOptions& options,
+                                      std::vector<ChunkIteratorPtr>* iters) {
+    SCOPED_RAW_TIMER(&_stats.capture_rowset_ns);
+
+    RowsetReadOptions range_options = options;
+    for (const auto& range : ranges) {
+        range_options.begin_segment = range.begin_segment;
+        range_options.end_segment = range.end_segment;
+        RETURN_IF_ERROR(range.rowset->get_segment_iterators(schema(), range_options, iters));
+    }
+    return Status::OK();
+}
+
 Status Reader::_init_collector(const ReaderParams& params) {
     RowsetReadOptions rs_opts;
     KeysType keys_type = params.tablet->tablet_schema().keys_type();
@@ -73,15 +86,19 @@ Status Reader::_init_collector(const ReaderParams& params) {
     RETURN_IF_ERROR(_init_delete_predicates(params, &_delete_predicates));
     RETURN_IF_ERROR(_parse_seek_range(params, &rs_opts.ranges));
     rs_opts.predicates = _pushdown_predicates;
+    rs_opts.late_predicates = params.late_predicates;
     rs_opts.sorted = (keys_type != DUP_KEYS && keys_type != PRIMARY_KEYS) && !params.skip_aggregation;
     rs_opts.load_bf_columns = &_load_bf_columns;
     rs_opts.reader_type = params.reader_type;
     rs_opts.chunk_size = params.chunk_size;
     rs_opts.delete_predicates = &_delete_predicates;
+    _or_predicates = params.or_predicates;
+    rs_opts.or_predicates = &_or_predicates;
     rs_opts.stats = &_stats;
     rs_opts.runtime_state = params.runtime_state;
     rs_opts.profile = params.profile;
     rs_opts.use_page_cache = params.use_page_cache;
+    rs_opts.aggregate_by_metadata = params.aggregate_by_metadata && keys_type == DUP_KEYS;
     rs_opts.tablet_schema = &(params.tablet->tablet_schema());
     if (keys_type == KeysType::PRIMARY_KEYS) {
         rs_opts.is_primary_keys = true;
@@ -89,8 +106,22 @@ Status Reader::_init_collector(const ReaderParams& params) {
         rs_opts.meta = params.tablet->data_dir()->get_meta();
     }
 
+    // If the first key ranges of the iterators are known, the ones not overlapping are concatenated rather than
+    // merged. See new_merge_iterator() with key ranges.
+    const auto skip_aggr = params.skip_aggregation;
+    std::vector<std::pair<Datum, Datum>> key_ranges;
+    if ((keys_type == AGG_KEYS || keys_type == UNIQUE_KEYS) && !skip_aggr && params.rowset_segment_ranges.empty() &&
+        _schema.num_key_fields() > 0 && _schema.field(0)->id() == 0) {
+        rs_opts.key_ranges = &key_ranges;
+    }
+
     std::vector<ChunkIteratorPtr> seg_iters;
-    RETURN_IF_ERROR(_get_segment_iterators(params.tablet, params.version, rs_opts, &seg_iters));
+    if (params.rowset_segment_ranges.empty()) {
+        RETURN_IF_ERROR(_get_segment_iterators(params.tablet, params.version, rs_opts, &seg_iters));
+    } else {
+        DCHECK_EQ(DUP_KEYS, keys_type);
+        RETURN_IF_ERROR(_get_segment_iterators(params.rowset_segment_ranges, rs_opts, &seg_iters));
+    }
 
     // Put each SegmentIterator into a TimedChunkIterator, if a profile is provided.
     if (params.profile != nullptr) {
@@ -105,7 +136,6 @@ Status Reader::_init_collector(const ReaderParams& params) {
 
     // If |keys_type| is UNIQUE_KEYS and |params.skip_aggregation| is true, must disable aggregate totally.
     // If |keys_type| is AGG_KEYS and |params.skip_aggregation| is true, aggregate is an optional operation.
-    const auto skip_aggr = params.skip_aggregation;
     const auto select_all_keys = _schema.num_key_fields() == params.tablet->num_key_columns();
     DCHECK_LE(_schema.num_key_fields(), params.tablet->num_key_columns());
 
@@ -147,18 +177,32 @@ Status Reader::_init_collector(const ReaderParams& params) {
         //       |           |           |
         // SegmentIterator  ...    SegmentIterator
         //
+        // The MergeIterator is a UnionIterator of the MergeIterators of the overlapping groups if the key ranges
+        // of the iterators are known, and the AggregateIterator is skipped if no iterators overlap, as the rows of
+        // an iterator have unique keys.
+        bool merged = true;
+        ChunkIteratorPtr sorted_iter;
+        if (key_ranges.size() == seg_iters.size()) {
+            sorted_iter = new_merge_iterator(seg_iters, _schema.field(0)->type(), key_ranges, &merged);
+        } else {
+            sorted_iter = new_merge_iterator(seg_iters);
+        }
+        const bool need_aggr = merged || !select_all_keys;
         if (params.profile != nullptr && params.profile->parent() != nullptr) {
             RuntimeProfile* p = params.profile->parent()->create_child("MERGE", true, true);
             RuntimeProfile::Counter* sort_timer = ADD_TIMER(p, "sort");
             RuntimeProfile::Counter* aggr_timer = ADD_TIMER(p, "aggr");
 
-            _collect_iter = new_merge_iterator(seg_iters);
-            _collect_iter = timed_chunk_iterator(std::move(_collect_iter), sort_timer);
-            _collect_iter = new_aggregate_iterator(std::move(_collect_iter), 0);
-            _collect_iter = timed_chunk_iterator(std::move(_collect_iter), aggr_timer);
+            _collect_iter = timed_chunk_iterator(std::move(sorted_iter), sort_timer);
+            if (need_aggr) {
+                _collect_iter = new_aggregate_iterator(std::move(_collect_iter), 0);
+                _collect_iter = timed_chunk_iterator(std::move(_collect_iter), aggr_timer);
+            }
         } else {
-            _collect_iter = new_merge_iterator(seg_iters);
-            _collect_iter = new_aggregate_iterator(std::move(_collect_iter), 0);
+            _collect_iter = std::move(sorted_iter);
+            if (need_aggr) {
+                _collect_iter = new_aggregate_iterator(std::move(_collect_iter), 0);
+            }
         }
     } else if (keys_type == AGG_KEYS) {
         CHECK(skip_aggr);
@@ -45,6 +45,8 @@ private:
     Status _to_seek_tuple(const TabletSchema& tablet_schema, const OlapTuple& input, SeekTuple* tuple);
     Status _get_segment_iterators(const TabletSharedPtr& tablet, const Version& version,
                                   const RowsetReadOptions& options, std::vector<ChunkIteratorPtr>* iters);
+    Status _get_segment_iterators(const std::vector<RowsetSegmentRange>& ranges, const RowsetReadOptions& options,
+                                  std::vector<ChunkIteratorPtr>* iters);
 
     MemTracker _memtracker;
     MemPool _mempool;
@@ -56,6 +58,7 @@ private:
 
     PredicateMap _pushdown_predicates;
     DeletePredicates _delete_predicates;
+    std::vector<DisjunctivePredicates> _or_predicates;
     PredicateList _predicate_free_list;
 
     std::shared_ptr<ChunkIterator> _collect_iter;
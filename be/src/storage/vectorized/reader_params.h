@@ -9,6 +9,7 @@
 #include "storage/tablet.h"
 #include "storage/tuple.h"
 #include "storage/vectorized/chunk_iterator.h"
+#include "storage/vectorized/disjunctive_predicates.h"
 
 namespace starrocks {
 
@@ -18,6 +19,14 @@ class RuntimeState;
 namespace vectorized {
 
 class ColumnPredicate;
+class LatePredicates;
+
+// The segments with ordinals in [begin_segment, end_segment) of one rowset.
+struct RowsetSegmentRange {
+    RowsetSharedPtr rowset;
+    uint32_t begin_segment = 0;
+    uint32_t end_segment = 0;
+};
 
 // Params for reader
 struct ReaderParams {
@@ -43,6 +52,21 @@ struct ReaderParams {
     std::vector<OlapTuple> start_key;
     std::vector<OlapTuple> end_key;
     std::vector<const ColumnPredicate*> predicates;
+    // The predicates available after the reader was initialized, nullptr if none.
+    LatePredicates* late_predicates = nullptr;
+    // Each is a disjunction of the conjunctions of |ColumnPredicate|s, e.g. `(c1 = 1 AND c2 > 3) OR c3 IS NULL`, which
+    // the rows returned satisfy. The column predicates must be able to be pushed down, as |predicates|.
+    std::vector<DisjunctivePredicates> or_predicates;
+
+    // If true, the rows are only consumed by an aggregation of count/min/max, and no filter is applied on the
+    // returned rows, so each segment fully covered by |predicates| and without deleted rows returns its
+    // rows without reading its data pages: the first row has the max values of the zone maps and the others
+    // have the min values.
+    bool aggregate_by_metadata = false;
+
+    // If not empty, only the segments of these ranges are read, instead of all the rowsets of |version|.
+    // Only used for the tablets of DUP_KEYS, whose rows needn't be merged across the rowsets.
+    std::vector<RowsetSegmentRange> rowset_segment_ranges;
 
     RuntimeState* runtime_state = nullptr;
 
@@ -0,0 +1,97 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/vectorized/row_source_buffer.h"
+
+#include <algorithm>
+
+#include "common/logging.h"
+#include "env/env.h"
+
+namespace starrocks::vectorized {
+
+static_assert(sizeof(RowSource) == sizeof(uint16_t));
+
+RowSourceBuffer::RowSourceBuffer(std::string path, int64_t max_memory_bytes)
+        : _path(std::move(path)),
+          _max_memory_sources(std::max<int64_t>(max_memory_bytes / sizeof(RowSource), 1024)) {}
+
+RowSourceBuffer::~RowSourceBuffer() {
+    if (_spilled) {
+        _write_file.reset();
+        _read_file.reset();
+        auto st = Env::Default()->delete_file(_path);
+        LOG_IF(WARNING, !st.ok()) << "Fail to delete file=" << _path << ", " << st.to_string();
+    }
+}
+
+Status RowSourceBuffer::append(const std::vector<RowSource>& sources) {
+    DCHECK(_read_file == nullptr) << "append after reads";
+    _buffer.insert(_buffer.end(), sources.begin(), sources.end());
+    _num_sources += sources.size();
+    if (_buffer.size() >= _max_memory_sources) {
+        RETURN_IF_ERROR(_spill());
+    }
+    return Status::OK();
+}
+
+Status RowSourceBuffer::_spill() {
+    if (_write_file == nullptr) {
+        RETURN_IF_ERROR(Env::Default()->new_writable_file(_path, &_write_file));
+        _spilled = true;
+    }
+    RETURN_IF_ERROR(_write_file->append(Slice(reinterpret_cast<const char*>(_buffer.data()),
+                                              _buffer.size() * sizeof(RowSource))));
+    _buffer.clear();
+    return Status::OK();
+}
+
+Status RowSourceBuffer::flush() {
+    if (!_spilled) {
+        return Status::OK();
+    }
+    if (!_buffer.empty()) {
+        RETURN_IF_ERROR(_spill());
+    }
+    std::vector<RowSource>().swap(_buffer);
+    RETURN_IF_ERROR(_write_file->close());
+    _write_file.reset();
+    return Status::OK();
+}
+
+Status RowSourceBuffer::rewind() {
+    DCHECK(_write_file == nullptr) << "rewind before flush";
+    _read_offset = 0;
+    if (_spilled) {
+        _read_file.reset();
+        RETURN_IF_ERROR(Env::Default()->new_sequential_file(_path, &_read_file));
+    }
+    return Status::OK();
+}
+
+Status RowSourceBuffer::read(size_t max_sources, std::vector<RowSource>* sources) {
+    sources->clear();
+    if (!_spilled) {
+        size_t n = std::min(max_sources, _buffer.size() - _read_offset);
+        if (n == 0) {
+            return Status::EndOfFile("end of row sources");
+        }
+        sources->assign(_buffer.begin() + _read_offset, _buffer.begin() + _read_offset + n);
+        _read_offset += n;
+        return Status::OK();
+    }
+
+    DCHECK(_read_file != nullptr) << "read before rewind";
+    sources->resize(max_sources);
+    Slice buf(reinterpret_cast<char*>(sources->data()), max_sources * sizeof(RowSource));
+    RETURN_IF_ERROR(_read_file->read(&buf));
+    if (buf.size % sizeof(RowSource) != 0) {
+        return Status::Corruption("truncated row sources file " + _path);
+    }
+    sources->resize(buf.size / sizeof(RowSource));
+    if (sources->empty()) {
+        return Status::EndOfFile("end of row sources");
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,83 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+
+namespace starrocks {
+
+class SequentialFile;
+class WritableFile;
+
+namespace vectorized {
+
+// The source of a row merged by the key columns in vertical compaction, i.e. the index of the input iterator
+// that the row comes from, and whether the row is replaced by the next row of the same keys.
+class RowSource {
+public:
+    static constexpr uint16_t MAX_SOURCES = 0x7FFF;
+
+    RowSource() = default;
+    RowSource(uint16_t source, bool replaced) : _data(source | (replaced ? REPLACED_FLAG : 0)) {}
+
+    uint16_t source() const { return _data & MAX_SOURCES; }
+    bool replaced() const { return _data & REPLACED_FLAG; }
+    void set_replaced() { _data |= REPLACED_FLAG; }
+
+    bool operator==(const RowSource& rhs) const { return _data == rhs._data; }
+
+private:
+    static constexpr uint16_t REPLACED_FLAG = 0x8000;
+
+    uint16_t _data = 0;
+};
+
+// RowSourceBuffer saves the sources of the rows in their merged order, which are written once by the merge of the
+// key columns, and read sequentially by the merge of each group of the value columns. The sources are kept in
+// memory up to |max_memory_bytes|, and spilled to the temporary file |path| beyond that.
+//
+// This class is not thread-safe.
+class RowSourceBuffer {
+public:
+    RowSourceBuffer(std::string path, int64_t max_memory_bytes);
+    ~RowSourceBuffer();
+
+    RowSourceBuffer(const RowSourceBuffer&) = delete;
+    RowSourceBuffer& operator=(const RowSourceBuffer&) = delete;
+
+    Status append(const std::vector<RowSource>& sources);
+
+    // Finish the writes, must be called before the reads.
+    Status flush();
+
+    // Read from the first source again.
+    Status rewind();
+
+    // Read at most |max_sources| sources into |sources|, return EndOfFile if all the sources are read.
+    Status read(size_t max_sources, std::vector<RowSource>* sources);
+
+    size_t num_sources() const { return _num_sources; }
+
+private:
+    Status _spill();
+
+    const std::string _path;
+    const size_t _max_memory_sources;
+
+    // The sources not spilled, all the sources if |_spilled| is false.
+    std::vector<RowSource> _buffer;
+    size_t _num_sources = 0;
+    bool _spilled = false;
+    std::unique_ptr<WritableFile> _write_file;
+    std::unique_ptr<SequentialFile> _read_file;
+    // The offset of the next source to read from |_buffer|, if not spilled.
+    size_t _read_offset = 0;
+};
+
+} // namespace vectorized
+} // namespace starrocks
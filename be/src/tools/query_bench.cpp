@@ -0,0 +1,269 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+// query_bench executes the plan fragments of a query saved by config::plan_fragment_dump_dir again and again on
+// this backend without the frontend, and prints the time of each run and the profiles of the last run, e.g.
+//   starrocks_be query_bench --bench_plan_dir=/path/to/dump/<query_id> --bench_repeat=5 --bench_engine=pipeline
+// The fragments are executed in the same order as received, by the pipeline engine or the non-pipeline engine as
+// the frontend chose, unless --bench_engine overrides it. The fragments must be dumped on this backend and all of
+// them must run on it, e.g. the SSB or TPC-H queries on a cluster of one backend, so that the tablets scanned are
+// here and the exchanges are local. This backend must be stopped before running query_bench on its storage.
+
+#include <gflags/gflags.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "common/status.h"
+#include "exec/pipeline/fragment_executor.h"
+#include "gen_cpp/FrontendService.h"
+#include "runtime/exec_env.h"
+#include "runtime/fragment_mgr.h"
+#include "runtime/result_buffer_mgr.h"
+#include "service/backend_options.h"
+#include "util/runtime_profile.h"
+#include "util/stopwatch.hpp"
+#include "util/thrift_server.h"
+#include "util/thrift_util.h"
+#include "util/uid_util.h"
+
+DEFINE_string(bench_plan_dir, "", "the directory of the plan fragments of one query dumped by plan_fragment_dump_dir");
+DEFINE_int32(bench_repeat, 3, "the number of times the query is executed");
+DEFINE_string(bench_engine, "", "pipeline or non_pipeline to override the engine chosen by the frontend");
+DEFINE_int32(bench_report_port, 9099, "the port of the service receiving the reports of the fragments");
+DEFINE_int32(bench_timeout_s, 3600, "the timeout of each execution of the query in seconds");
+
+namespace starrocks {
+
+// ReportCollector plays the frontend the fragments report their status and profiles to.
+class ReportCollector : public FrontendServiceNull {
+public:
+    struct Report {
+        Status status;
+        bool has_profile = false;
+        TRuntimeProfileTree profile;
+    };
+
+    void reportExecStatus(TReportExecStatusResult& result, const TReportExecStatusParams& params) override {
+        if (params.__isset.done && params.done) {
+            std::lock_guard<std::mutex> l(_mutex);
+            auto& report = _reports[params.fragment_instance_id];
+            report.status = params.__isset.status ? Status(params.status) : Status::OK();
+            if (params.__isset.profile) {
+                report.has_profile = true;
+                report.profile = params.profile;
+            }
+            _cond.notify_all();
+        }
+        Status::OK().to_thrift(&result.status);
+        result.__isset.status = true;
+    }
+
+    // Wait until all the fragment instances of |ids| are done, and move their reports to |reports|.
+    Status wait(const std::vector<TUniqueId>& ids, int64_t timeout_s, std::map<TUniqueId, Report>* reports) {
+        std::unique_lock<std::mutex> l(_mutex);
+        auto all_done = [&] {
+            for (const auto& id : ids) {
+                if (_reports.count(id) == 0) return false;
+            }
+            return true;
+        };
+        if (!_cond.wait_for(l, std::chrono::seconds(timeout_s), all_done)) {
+            return Status::TimedOut("the fragments aren't done in time");
+        }
+        for (const auto& id : ids) {
+            (*reports)[id] = std::move(_reports[id]);
+            _reports.erase(id);
+        }
+        return Status::OK();
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::map<TUniqueId, Report> _reports;
+};
+
+// The fragments of the query in the order they were received.
+static Status load_fragments(const std::string& dir, std::vector<TExecPlanFragmentParams>* fragments) {
+    std::map<int64_t, std::string> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        auto name = entry.path().filename().string();
+        auto pos = name.find('_');
+        if (entry.is_regular_file() && pos != std::string::npos) {
+            files[std::stoll(name.substr(0, pos))] = entry.path().string();
+        }
+    }
+    if (ec) {
+        return Status::IOError("fail to list " + dir + ": " + ec.message());
+    }
+    if (files.empty()) {
+        return Status::NotFound("no plan fragment in " + dir);
+    }
+    for (const auto& [seq, path] : files) {
+        std::ifstream file(path, std::ios::binary);
+        std::string buf((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (!file.good() && !file.eof()) {
+            return Status::IOError("fail to read " + path);
+        }
+        auto len = static_cast<uint32_t>(buf.size());
+        TExecPlanFragmentParams params;
+        RETURN_IF_ERROR(deserialize_thrift_msg(reinterpret_cast<const uint8_t*>(buf.data()), &len, false, &params));
+        fragments->emplace_back(std::move(params));
+    }
+    return Status::OK();
+}
+
+// Give the query, the fragment instances and the destinations new ids in each run, the ids are changed in the same
+// way, so the fragments still refer to each other.
+static void prepare_run(std::vector<TExecPlanFragmentParams>* fragments, int64_t id_mask,
+                        const TNetworkAddress& coord) {
+    auto remap = [id_mask](TUniqueId* id) { id->__set_hi(id->hi ^ id_mask); };
+    for (auto& fragment : *fragments) {
+        auto& params = fragment.params;
+        remap(&params.query_id);
+        remap(&params.fragment_instance_id);
+        for (auto& destination : params.destinations) {
+            remap(&destination.fragment_instance_id);
+        }
+        if (params.__isset.runtime_filter_params && params.runtime_filter_params.__isset.id_to_prober_params) {
+            for (auto& [filter_id, probers] : params.runtime_filter_params.id_to_prober_params) {
+                for (auto& prober : probers) {
+                    remap(&prober.fragment_instance_id);
+                }
+            }
+        }
+        fragment.__set_coord(coord);
+        fragment.query_options.__set_is_report_success(true);
+        if (FLAGS_bench_engine == "pipeline") {
+            fragment.__set_is_pipeline(true);
+        } else if (FLAGS_bench_engine == "non_pipeline") {
+            fragment.__set_is_pipeline(false);
+        }
+    }
+}
+
+static Status exec_fragment(ExecEnv* exec_env, const TExecPlanFragmentParams& fragment) {
+    if (fragment.__isset.is_pipeline && fragment.is_pipeline) {
+        auto fragment_executor = std::make_unique<pipeline::FragmentExecutor>();
+        RETURN_IF_ERROR(fragment_executor->prepare(exec_env, fragment));
+        return fragment_executor->execute(exec_env);
+    }
+    return exec_env->fragment_mgr()->exec_plan_fragment(fragment);
+}
+
+// Fetch the results of the fragment instance |id| like the frontend does, returns the number of the rows.
+static int64_t drain_results(ExecEnv* exec_env, const TUniqueId& id, int64_t timeout_s) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout_s);
+    int64_t num_rows = 0;
+    while (std::chrono::steady_clock::now() < deadline) {
+        TFetchDataResult result;
+        if (!exec_env->result_mgr()->fetch_data(id, &result).ok()) {
+            // the result sink isn't opened yet.
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+        num_rows += result.result_batch.rows.size();
+        if (result.eos) {
+            break;
+        }
+    }
+    return num_rows;
+}
+
+static Status run_query(ExecEnv* exec_env, ReportCollector* collector, std::vector<TExecPlanFragmentParams> fragments,
+                        int run, bool print_profiles) {
+    TNetworkAddress coord;
+    coord.__set_hostname(BackendOptions::get_localhost());
+    coord.__set_port(FLAGS_bench_report_port);
+    prepare_run(&fragments, UniqueId::gen_uid().hi, coord);
+
+    std::vector<TUniqueId> ids;
+    std::vector<std::thread> result_fetchers;
+    std::atomic<int64_t> num_rows{0};
+    MonotonicStopWatch watch;
+    watch.start();
+    Status st;
+    for (const auto& fragment : fragments) {
+        const TUniqueId& id = fragment.params.fragment_instance_id;
+        if (fragment.fragment.output_sink.type == TDataSinkType::RESULT_SINK) {
+            result_fetchers.emplace_back([exec_env, id, &num_rows] {
+                num_rows += drain_results(exec_env, id, FLAGS_bench_timeout_s);
+            });
+        }
+        st = exec_fragment(exec_env, fragment);
+        if (!st.ok()) {
+            break;
+        }
+        ids.emplace_back(id);
+    }
+    std::map<TUniqueId, ReportCollector::Report> reports;
+    if (st.ok()) {
+        st = collector->wait(ids, FLAGS_bench_timeout_s, &reports);
+    }
+    for (auto& fetcher : result_fetchers) {
+        fetcher.join();
+    }
+    RETURN_IF_ERROR(st);
+    for (const auto& [id, report] : reports) {
+        RETURN_IF_ERROR(report.status);
+    }
+    std::cout << "run " << run << ": " << watch.elapsed_time() / 1000000 << " ms, " << num_rows << " rows"
+              << std::endl;
+
+    if (print_profiles) {
+        for (const auto& [id, report] : reports) {
+            if (!report.has_profile) {
+                continue;
+            }
+            RuntimeProfile profile("Fragment Instance " + print_id(id));
+            profile.update(report.profile);
+            std::stringstream ss;
+            profile.pretty_print(&ss);
+            std::cout << ss.str() << std::endl;
+        }
+    }
+    return Status::OK();
+}
+
+// The flags are parsed by init_daemon with the flags of the backend.
+int query_bench_main(ExecEnv* exec_env) {
+    std::vector<TExecPlanFragmentParams> fragments;
+    Status st = load_fragments(FLAGS_bench_plan_dir, &fragments);
+    if (!st.ok()) {
+        std::cout << "fail to load the plan fragments: " << st.to_string() << std::endl;
+        return -1;
+    }
+
+    auto collector = std::make_shared<ReportCollector>();
+    auto processor = std::make_shared<FrontendServiceProcessor>(collector);
+    ThriftServer report_server("query_bench_report", processor, FLAGS_bench_report_port, nullptr, 4);
+    st = report_server.start();
+    if (!st.ok()) {
+        std::cout << "fail to start the report service: " << st.to_string() << std::endl;
+        return -1;
+    }
+
+    int ret = 0;
+    for (int run = 0; run < FLAGS_bench_repeat; ++run) {
+        st = run_query(exec_env, collector.get(), fragments, run, run + 1 == FLAGS_bench_repeat);
+        if (!st.ok()) {
+            std::cout << "run " << run << " failed: " << st.to_string() << std::endl;
+            ret = -1;
+            break;
+        }
+    }
+    report_server.stop();
+    report_server.join();
+    return ret;
+}
+
+} // namespace starrocks
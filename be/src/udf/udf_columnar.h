@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+
+#include "udf/udf.h"
+
+// The columnar interface of the scalar UDFs. A UDF created with the property "type"="columnar" is called once per
+// chunk with the whole columns of its arguments and fills the whole column of its results, so it pays neither the
+// boxing of each value into an AnyVal nor an indirect call per row, and could run its own loops over the values.
+//
+// The columns are exchanged in the Arrow C data interface (https://arrow.apache.org/docs/format/CDataInterface.html),
+// so a UDF could wrap them with the Arrow library of its own, or read the buffers directly:
+//  - An argument of TINYINT, SMALLINT, INT, BIGINT, FLOAT or DOUBLE is an array of format "c", "s", "i", "l", "f"
+//    or "g", buffers[0] is the validity bitmap, or NULL if the array has no nulls, buffers[1] is the values.
+//  - An argument of CHAR or VARCHAR is an array of format "u", buffers[1] is the int32 offsets of the strings and
+//    buffers[2] is their bytes.
+//  - The result is an array of the format of the return type, one of the numeric ones above, allocated with
+//    |length| rows. Its validity bitmap, buffers[0], has all the rows valid and its values, buffers[1], are zeroed.
+//    The UDF writes the values and clears the bit of each row whose result is NULL.
+// All of the arrays have a zero |offset| and are owned by StarRocks, valid only during the call, so the UDF must
+// neither keep them nor release them.
+//
+// A columnar UDF is an extern "C" function of the type starrocks_udf::ColumnarUdf. It returns 0 on success, or sets
+// the error to |context| and returns a non-zero value. The prepare and close functions are the same as the ones of
+// the row-based UDFs.
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace starrocks_udf {
+
+typedef int32_t (*ColumnarUdf)(FunctionContext* context, int32_t num_args, const ArrowArray* const* args,
+                               ArrowArray* result);
+
+} // namespace starrocks_udf
@@ -30,6 +30,7 @@
 #include <memory>
 #include <string>
 
+#include "common/logging.h"
 #include "exprs/base64.h"
 
 namespace starrocks {
@@ -172,4 +173,50 @@ int AesUtil::decrypt(AesMode mode, const unsigned char* encrypt, uint32_t encryp
     }
 }
 
+AesCipher::AesCipher() {
+    EVP_CIPHER_CTX_init(&_ctx);
+}
+
+AesCipher::~AesCipher() {
+    EVP_CIPHER_CTX_cleanup(&_ctx);
+}
+
+bool AesCipher::init(AesMode mode, bool is_encrypt, const unsigned char* key, uint32_t key_length,
+                     const unsigned char* iv, bool padding) {
+    _initialized = false;
+    const EVP_CIPHER* cipher = get_evp_type(mode);
+    if (cipher == nullptr || (EVP_CIPHER_iv_length(cipher) > 0 && !iv)) {
+        return false;
+    }
+    unsigned char encrypt_key[AES_MAX_KEY_LENGTH / 8];
+    aes_create_key(key, key_length, encrypt_key, mode);
+    if (EVP_CipherInit_ex(&_ctx, cipher, nullptr, encrypt_key, iv, is_encrypt) == 0 ||
+        EVP_CIPHER_CTX_set_padding(&_ctx, padding) == 0) {
+        ERR_clear_error();
+        return false;
+    }
+    _initialized = true;
+    _is_encrypt = is_encrypt;
+    return true;
+}
+
+int AesCipher::update(const unsigned char* source, uint32_t source_length, unsigned char* dest) {
+    DCHECK(_initialized);
+    // reset the state of the last value, the expanded key and the iv are kept.
+    int ret = EVP_CipherInit_ex(&_ctx, nullptr, nullptr, nullptr, nullptr, _is_encrypt);
+    int u_len = 0;
+    if (ret != 0) {
+        ret = EVP_CipherUpdate(&_ctx, dest, &u_len, source, source_length);
+    }
+    int f_len = 0;
+    if (ret != 0) {
+        ret = EVP_CipherFinal_ex(&_ctx, dest + u_len, &f_len);
+    }
+    if (ret == 0) {
+        ERR_clear_error();
+        return AES_BAD_DATA;
+    }
+    return u_len + f_len;
+}
+
 } // namespace starrocks
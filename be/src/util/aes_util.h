@@ -19,6 +19,7 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <openssl/evp.h>
 #include <stdint.h>
 
 namespace starrocks {
@@ -36,4 +37,27 @@ public:
                        uint32_t key_length, const unsigned char* iv, bool padding, unsigned char* decrypt_content);
 };
 
+// AesCipher keeps an initialized cipher context to encrypt or decrypt many values by the same key, and the
+// expansion of the key is done only once in init(), instead of once per value as AesUtil does.
+class AesCipher {
+public:
+    AesCipher();
+    ~AesCipher();
+
+    AesCipher(const AesCipher&) = delete;
+    AesCipher& operator=(const AesCipher&) = delete;
+
+    // Returns false if the mode is unknown, or it needs an iv but |iv| is null.
+    bool init(AesMode mode, bool is_encrypt, const unsigned char* key, uint32_t key_length, const unsigned char* iv,
+              bool padding);
+
+    // Same as AesUtil::encrypt and AesUtil::decrypt, returns the length of |dest| or AES_BAD_DATA.
+    int update(const unsigned char* source, uint32_t source_length, unsigned char* dest);
+
+private:
+    EVP_CIPHER_CTX _ctx;
+    bool _initialized = false;
+    bool _is_encrypt = true;
+};
+
 } // namespace starrocks
@@ -33,6 +33,7 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/config.h"
 #include "common/logging.h"
@@ -782,10 +783,20 @@ public:
      * pointer).
      */
     static Roaring64Map fastunion(size_t n, const Roaring64Map** inputs) {
-        Roaring64Map ans;
-        // not particularly fast
+        // The 32-bit bitmaps of the same high bytes are unioned by one Roaring::fastunion.
+        std::map<uint32_t, std::vector<const Roaring*>> roarings_by_high_bytes;
         for (size_t lcv = 0; lcv < n; ++lcv) {
-            ans |= *(inputs[lcv]);
+            for (const auto& map_entry : inputs[lcv]->roarings) {
+                roarings_by_high_bytes[map_entry.first].push_back(&map_entry.second);
+            }
+        }
+        Roaring64Map ans;
+        for (auto& [high_bytes, roarings] : roarings_by_high_bytes) {
+            if (roarings.size() == 1) {
+                ans.emplaceOrInsert(high_bytes, *roarings[0]);
+            } else {
+                ans.emplaceOrInsert(high_bytes, Roaring::fastunion(roarings.size(), roarings.data()));
+            }
         }
         return ans;
     }
@@ -1120,6 +1131,61 @@ public:
         return *this;
     }
 
+    // Compute the union between the current bitmap and all the bitmaps of |values|. All the roaring bitmaps are
+    // unioned by one fastunion, instead of one by one as operator|= does.
+    BitmapValue& fast_union(const std::vector<const BitmapValue*>& values) {
+        std::vector<const detail::Roaring64Map*> bitmaps;
+        std::vector<uint64_t> elements;
+        if (_type == BITMAP) {
+            bitmaps.push_back(_bitmap.get());
+        }
+        for (const BitmapValue* value : values) {
+            switch (value->_type) {
+            case EMPTY:
+                break;
+            case SINGLE:
+                elements.push_back(value->_sv);
+                break;
+            case SET:
+                elements.insert(elements.end(), value->_set.begin(), value->_set.end());
+                break;
+            case BITMAP:
+                bitmaps.push_back(value->_bitmap.get());
+                break;
+            }
+        }
+        if (bitmaps.empty()) {
+            for (uint64_t x : elements) {
+                add(x);
+            }
+            return *this;
+        }
+
+        if (_type != BITMAP || bitmaps.size() > 1) {
+            std::shared_ptr<detail::Roaring64Map> bitmap;
+            if (bitmaps.size() == 1) {
+                bitmap = std::make_shared<detail::Roaring64Map>(*bitmaps[0]);
+            } else {
+                bitmap = std::make_shared<detail::Roaring64Map>(
+                        detail::Roaring64Map::fastunion(bitmaps.size(), bitmaps.data()));
+            }
+            if (_type == SINGLE) {
+                bitmap->add(_sv);
+            } else if (_type == SET) {
+                for (const auto& x : _set) {
+                    bitmap->add(x);
+                }
+                _set.clear();
+            }
+            _bitmap = std::move(bitmap);
+            _type = BITMAP;
+        }
+        if (!elements.empty()) {
+            _bitmap->addMany(elements.size(), elements.data());
+        }
+        return *this;
+    }
+
     // Note: rhs BitmapValue is only readable after this method
     // Compute the intersection between the current bitmap and the provided bitmap.
     // Possible type transitions are:
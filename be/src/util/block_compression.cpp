@@ -26,9 +26,12 @@
 #include <snappy/snappy-sinksource.h>
 #include <snappy/snappy.h>
 #include <zlib.h>
+#include <zstd/zdict.h>
 #include <zstd/zstd.h>
 #include <zstd/zstd_errors.h>
 
+#include <mutex>
+
 #include "gutil/strings/substitute.h"
 #include "util/faststring.h"
 
@@ -445,6 +448,127 @@ public:
     size_t max_compressed_len(size_t len) const override { return ZSTD_compressBound(len); }
 };
 
+// The ZSTD contexts of the calling thread, which are reused by all the dictionary codecs rather than created for
+// each block.
+struct ZstdThreadContexts {
+    ~ZstdThreadContexts() {
+        ZSTD_freeCCtx(cctx);
+        ZSTD_freeDCtx(dctx);
+    }
+
+    static ZstdThreadContexts* local() {
+        static thread_local ZstdThreadContexts contexts;
+        return &contexts;
+    }
+
+    ZSTD_CCtx* compress_context() {
+        if (cctx == nullptr) {
+            cctx = ZSTD_createCCtx();
+        }
+        return cctx;
+    }
+
+    ZSTD_DCtx* decompress_context() {
+        if (dctx == nullptr) {
+            dctx = ZSTD_createDCtx();
+        }
+        return dctx;
+    }
+
+    ZSTD_CCtx* cctx = nullptr;
+    ZSTD_DCtx* dctx = nullptr;
+};
+
+class ZstdDictBlockCompression final : public BlockCompressionCodec {
+public:
+    // The dictionary is copied.
+    explicit ZstdDictBlockCompression(const Slice& dict) : _dict(dict.data, dict.size) {}
+
+    ~ZstdDictBlockCompression() override {
+        ZSTD_freeCDict(_cdict);
+        ZSTD_freeDDict(_ddict);
+    }
+
+    Status init() {
+        _ddict = ZSTD_createDDict(_dict.data(), _dict.size());
+        if (_ddict == nullptr) {
+            return Status::InvalidArgument("ZSTD create decompression dictionary failed");
+        }
+        return Status::OK();
+    }
+
+    Status compress(const Slice& input, Slice* output) const override {
+        // Only the writers compress, so the much larger compression dictionary is created on demand.
+        std::call_once(_cdict_once,
+                       [this] { _cdict = ZSTD_createCDict(_dict.data(), _dict.size(), ZSTD_CLEVEL_DEFAULT); });
+        ZSTD_CCtx* cctx = ZstdThreadContexts::local()->compress_context();
+        if (_cdict == nullptr || cctx == nullptr) {
+            return Status::InternalError("ZSTD create compression context failed");
+        }
+        size_t ret = ZSTD_compress_usingCDict(cctx, output->data, output->size, input.data, input.size, _cdict);
+        if (ZSTD_isError(ret)) {
+            return Status::InvalidArgument(
+                    strings::Substitute("ZSTD compress failed: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+        }
+        output->size = ret;
+        return Status::OK();
+    }
+
+    Status decompress(const Slice& input, Slice* output) const override {
+        if (output->data == nullptr) {
+            static uint8_t empty_buffer;
+            output->data = (char*)&empty_buffer;
+            output->size = 0;
+        }
+        ZSTD_DCtx* dctx = ZstdThreadContexts::local()->decompress_context();
+        if (dctx == nullptr) {
+            return Status::InternalError("ZSTD create decompression context failed");
+        }
+        size_t ret = ZSTD_decompress_usingDDict(dctx, output->data, output->size, input.data, input.size, _ddict);
+        if (ZSTD_isError(ret)) {
+            return Status::InvalidArgument(
+                    strings::Substitute("ZSTD decompress failed: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+        }
+        output->size = ret;
+        return Status::OK();
+    }
+
+    size_t max_compressed_len(size_t len) const override { return ZSTD_compressBound(len); }
+
+private:
+    const std::string _dict;
+    ZSTD_DDict* _ddict = nullptr;
+    mutable std::once_flag _cdict_once;
+    mutable ZSTD_CDict* _cdict = nullptr;
+};
+
+Status train_zstd_dictionary(const std::vector<Slice>& samples, size_t dict_size, std::string* dict) {
+    std::string buffer;
+    std::vector<size_t> sample_sizes;
+    sample_sizes.reserve(samples.size());
+    for (const Slice& sample : samples) {
+        buffer.append(sample.data, sample.size);
+        sample_sizes.push_back(sample.size);
+    }
+    dict->resize(dict_size);
+    size_t ret = ZDICT_trainFromBuffer(dict->data(), dict->size(), buffer.data(), sample_sizes.data(),
+                                       sample_sizes.size());
+    if (ZDICT_isError(ret)) {
+        dict->clear();
+        return Status::InvalidArgument(
+                strings::Substitute("ZSTD train dictionary failed: $0", ZDICT_getErrorName(ret)));
+    }
+    dict->resize(ret);
+    return Status::OK();
+}
+
+Status create_zstd_dict_codec(const Slice& dict, std::unique_ptr<BlockCompressionCodec>* codec) {
+    auto dict_codec = std::make_unique<ZstdDictBlockCompression>(dict);
+    RETURN_IF_ERROR(dict_codec->init());
+    *codec = std::move(dict_codec);
+    return Status::OK();
+}
+
 Status get_block_compression_codec(CompressionTypePB type, const BlockCompressionCodec** codec) {
     switch (type) {
     case CompressionTypePB::NO_COMPRESSION:
@@ -22,6 +22,8 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "common/status.h"
@@ -73,4 +75,13 @@ public:
 // Return not OK, if error happens.
 Status get_block_compression_codec(CompressionTypePB type, const BlockCompressionCodec** codec);
 
+// Train a ZSTD dictionary of at most |dict_size| bytes from |samples|, e.g. the pages of a string column, which
+// makes the small blocks similar to the samples compressed much better than compressed one by one from scratch.
+// Return not OK if the samples are too few to train a dictionary.
+Status train_zstd_dictionary(const std::vector<Slice>& samples, size_t dict_size, std::string* dict);
+
+// Create a ZSTD codec compressing and decompressing with the dictionary |dict|. The codec is owned by the caller,
+// but the compression and decompression contexts are cached by the threads and shared among the codecs.
+Status create_zstd_dict_codec(const Slice& dict, std::unique_ptr<BlockCompressionCodec>* codec);
+
 } // namespace starrocks
@@ -24,6 +24,7 @@
 #include <string.h>
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 
 #include "common/logging.h"
@@ -39,7 +40,20 @@ struct ByteBuffer {
         return ptr;
     }
 
-    ~ByteBuffer() { delete[] ptr; }
+    // Wrap the |size| bytes of |data| without copying them, |release| is called instead of freeing |data|
+    // when the buffer is destroyed. The bytes are to be read, limit is at their end.
+    static ByteBufferPtr wrap(char* data, size_t size, std::function<void()> release) {
+        ByteBufferPtr ptr(new ByteBuffer(data, size, std::move(release)));
+        return ptr;
+    }
+
+    ~ByteBuffer() {
+        if (_release) {
+            _release();
+        } else {
+            delete[] ptr;
+        }
+    }
 
     void put_bytes(const char* data, size_t size) {
         memcpy(ptr + pos, data, size);
@@ -67,6 +81,10 @@ struct ByteBuffer {
 
 private:
     ByteBuffer(size_t capacity_) : ptr(new char[capacity_]), pos(0), limit(capacity_), capacity(capacity_) {}
+    ByteBuffer(char* data, size_t size, std::function<void()> release)
+            : ptr(data), pos(0), limit(size), capacity(size), _release(std::move(release)) {}
+
+    std::function<void()> _release;
 };
 
 } // namespace starrocks
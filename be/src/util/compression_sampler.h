@@ -0,0 +1,49 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace starrocks {
+
+// CompressionSampler decides whether the next block of a stream is worth compressing, from whether the
+// latest compressed blocks reached the expected ratio. After kMaxFailures blocks in a row fail to reach it,
+// the next blocks are sent uncompressed without trying, the number of them doubles after each failed sample,
+// up to kMaxSkippedBlocks, so the CPU isn't spent on a stream of incompressible data.
+class CompressionSampler {
+public:
+    static constexpr size_t kMaxFailures = 3;
+    static constexpr size_t kMinSkippedBlocks = 16;
+    static constexpr size_t kMaxSkippedBlocks = 1024;
+
+    // Whether the next block should be compressed, each call is for one block.
+    bool should_compress() {
+        if (_num_to_skip > 0) {
+            --_num_to_skip;
+            return false;
+        }
+        return true;
+    }
+
+    // Record whether the compressed block reached the expected ratio.
+    void update(bool compressible) {
+        if (compressible) {
+            _num_failures = 0;
+            _num_skipped_after_failures = kMinSkippedBlocks;
+            return;
+        }
+        if (++_num_failures >= kMaxFailures) {
+            _num_failures = 0;
+            _num_to_skip = _num_skipped_after_failures;
+            _num_skipped_after_failures = std::min(_num_skipped_after_failures * 2, kMaxSkippedBlocks);
+        }
+    }
+
+private:
+    size_t _num_failures = 0;
+    size_t _num_to_skip = 0;
+    size_t _num_skipped_after_failures = kMinSkippedBlocks;
+};
+
+} // namespace starrocks
@@ -0,0 +1,52 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace starrocks {
+
+// ConjunctStats measures the selectivity and the cost of a conjunct at runtime, so that the conjuncts which drop the
+// most rows per unit of cost are evaluated first. The statistics decay as more rows are evaluated, so the order
+// follows the changes of the data.
+class ConjunctStats {
+public:
+    // The old statistics are halved every time this number of rows are evaluated.
+    static constexpr int64_t kDecayRows = 1 << 20;
+
+    void update(int64_t input_rows, int64_t output_rows, int64_t cost_ns) {
+        _input_rows += input_rows;
+        _dropped_rows += input_rows - output_rows;
+        _cost_ns += cost_ns;
+        if (_input_rows > kDecayRows) {
+            _input_rows /= 2;
+            _dropped_rows /= 2;
+            _cost_ns /= 2;
+        }
+    }
+
+    // The cost to drop a row, a conjunct that is never evaluated comes first so that it gets measured.
+    double rank() const {
+        if (_input_rows == 0) {
+            return 0;
+        }
+        return (_cost_ns + 1.0) / (_dropped_rows + 1.0);
+    }
+
+private:
+    int64_t _input_rows = 0;
+    int64_t _dropped_rows = 0;
+    int64_t _cost_ns = 0;
+};
+
+// Sort |order|, the indexes of some conjuncts, by the ranks of their statistics got by |stats_of|. The order of the
+// conjuncts with the same rank is kept.
+template <typename StatsOf>
+inline void sort_conjuncts_by_rank(std::vector<uint32_t>* order, StatsOf&& stats_of) {
+    std::stable_sort(order->begin(), order->end(),
+                     [&](uint32_t lhs, uint32_t rhs) { return stats_of(lhs).rank() < stats_of(rhs).rank(); });
+}
+
+} // namespace starrocks
@@ -0,0 +1,49 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/cpu_dispatch.h"
+
+#include <vector>
+
+#include "common/logging.h"
+#include "util/cpu_info.h"
+
+namespace starrocks {
+
+SimdLevel CpuDispatch::_level = SimdLevel::BASELINE;
+
+// Constructed on the first use, since the tables are registered while the static variables are initialized.
+static std::vector<CpuDispatch::Initializer>& initializers() {
+    static std::vector<CpuDispatch::Initializer> initializers;
+    return initializers;
+}
+
+bool CpuDispatch::register_table(Initializer initializer) {
+    initializer(SimdLevel::BASELINE);
+    initializers().emplace_back(initializer);
+    return true;
+}
+
+void CpuDispatch::init() {
+    _level = SimdLevel::BASELINE;
+#ifdef __x86_64__
+    if (CpuInfo::is_supported(CpuInfo::AVX512F) && CpuInfo::is_supported(CpuInfo::AVX512BW)) {
+        _level = SimdLevel::AVX512;
+    }
+#endif
+    for (auto initializer : initializers()) {
+        initializer(_level);
+    }
+    LOG(INFO) << "SIMD kernels dispatched for " << level_name(_level);
+}
+
+const char* CpuDispatch::level_name(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::BASELINE:
+        return "BASELINE";
+    case SimdLevel::AVX512:
+        return "AVX512";
+    }
+    return "UNKNOWN";
+}
+
+} // namespace starrocks
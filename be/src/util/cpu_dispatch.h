@@ -0,0 +1,40 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+namespace starrocks {
+
+// The instruction sets the SIMD kernels are specialized for. BASELINE is what the tree is compiled for, i.e.
+// SSE4.2 and AVX2 on x86.
+enum class SimdLevel {
+    BASELINE = 0,
+    // AVX-512F and AVX-512BW
+    AVX512 = 1,
+};
+
+// Runtime cpu dispatch of the SIMD kernels, so one binary makes use of the best instruction set on every node.
+//
+// A kernel having faster versions for the newer instruction sets compiles them with the target attributes, and
+// keeps the chosen versions in a table of function pointers. The table is registered by its initializer, which
+// fills the table for a level. The tables are set up with BASELINE when registered, and with the best level
+// supported by the cpu by init(), so the kernels may be called before init(), e.g. in the tools and the tests.
+class CpuDispatch {
+public:
+    using Initializer = void (*)(SimdLevel level);
+
+    // Return true, so the registration may initialize a static variable in the file of the kernel.
+    static bool register_table(Initializer initializer);
+
+    // Detect the level from CpuInfo, and set up all the registered tables with it. Called at startup, after
+    // CpuInfo::init() and before the kernels are used by other threads.
+    static void init();
+
+    static SimdLevel level() { return _level; }
+
+    static const char* level_name(SimdLevel level);
+
+private:
+    static SimdLevel _level;
+};
+
+} // namespace starrocks
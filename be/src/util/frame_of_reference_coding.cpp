@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <cstring>
 
+#include "gutil/endian.h"
 #include "util/bit_util.h"
 #include "util/coding.h"
 
@@ -269,7 +270,6 @@ bool ForDecoder<T>::init() {
     return true;
 }
 
-// todo(kks): improve this method by SIMD instructions
 // The reverse of bit_pack method, get original integer data list from packed bits
 // param[in] input: the packed bits need to unpack
 // param[in] in_num: the integer number in packed bits
@@ -277,8 +277,29 @@ bool ForDecoder<T>::init() {
 // param[out] output: the original integer data list
 template <typename T>
 void ForDecoder<T>::bit_unpack(const uint8_t* input, uint8_t in_num, int bit_width, T* output) {
+    if (bit_width == 0) {
+        std::fill(output, output + in_num, 0);
+        return;
+    }
+    // The bits are packed from the most significant bit of the first byte, so a value of at most 57 bits
+    // is extracted from the big endian word at its first byte, which saves a branch per bit. The values
+    // whose words would exceed the buffer are unpacked bit by bit.
+    size_t bit_offset = 0;
+    if (bit_width <= 57) {
+        const uint8_t* const end = _buffer + _buffer_len;
+        for (; in_num > 0; in_num--, bit_offset += bit_width) {
+            const uint8_t* word_ptr = input + bit_offset / 8;
+            if (PREDICT_FALSE(word_ptr + sizeof(uint64_t) > end)) {
+                break;
+            }
+            uint64_t word = BigEndian::Load64(word_ptr) << (bit_offset % 8);
+            *output++ = static_cast<T>(word >> (64 - bit_width));
+        }
+    }
+
+    input += bit_offset / 8;
     unsigned char in_mask = 0x80;
-    int bit_index = 0;
+    int bit_index = bit_offset % 8;
     while (in_num > 0) {
         *output = 0;
         for (int i = 0; i < bit_width; i++) {
@@ -324,18 +345,17 @@ void ForDecoder<T>::decode_current_frame(T* output) {
         bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, output);
     } else {
         bool is_ascending = _storage_formats[_current_decoded_frame] == 1;
-        std::vector<T> delta_values(current_frame_size);
-        bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, delta_values.data());
+        // The deltas are unpacked into |output| and restored in place.
+        bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, output);
         if (is_ascending) {
             T pre_value = min;
             for (uint8_t i = 0; i < current_frame_size; i++) {
-                T value = delta_values[i] + pre_value;
-                output[i] = value;
-                pre_value = value;
+                pre_value += output[i];
+                output[i] = pre_value;
             }
         } else {
             for (uint8_t i = 0; i < current_frame_size; i++) {
-                output[i] = delta_values[i] + min;
+                output[i] += min;
             }
         }
     }
@@ -385,6 +405,8 @@ bool ForDecoder<T>::get_batch(T* val, size_t count) {
     for (size_t i = 0; i < frame_count; i++) {
         // directly decode value to the output, don't  buffer the value
         decode_current_frame(val);
+        // |_out_buffer| doesn't hold the frame decoded into the output.
+        _current_decoded_frame = -1;
         _current_index += _max_frame_size;
         val += _max_frame_size;
     }
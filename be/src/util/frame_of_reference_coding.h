@@ -152,13 +152,26 @@ public:
 
     uint32_t count() const { return _values_num; }
 
-private:
-    void bit_unpack(const uint8_t* input, uint8_t in_num, int bit_width, T* output);
+    // The metadata of the frames, which are available without decoding the frames.
+    uint32_t frame_count() const { return _frame_count; }
+
+    uint32_t max_frame_size() const { return _max_frame_size; }
 
-    inline uint32_t frame_size(uint32_t frame_index) {
+    inline uint32_t frame_size(uint32_t frame_index) const {
         return (frame_index == _frame_count - 1) ? _last_frame_size : _max_frame_size;
     }
 
+    // The values of a frame are not less than its min value.
+    T frame_min_value(uint32_t frame_index) { return decode_frame_min_value(frame_index); }
+
+    uint8_t frame_bit_width(uint32_t frame_index) const { return _bit_widths[frame_index]; }
+
+    // 0: the deltas to the min value, 1: the deltas to the previous values, 2: the original values.
+    uint8_t frame_storage_format(uint32_t frame_index) const { return _storage_formats[frame_index]; }
+
+private:
+    void bit_unpack(const uint8_t* input, uint8_t in_num, int bit_width, T* output);
+
     void decode_current_frame(T* output);
 
     T decode_frame_min_value(uint32_t frame_index);
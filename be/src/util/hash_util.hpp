@@ -212,6 +212,86 @@ public:
         return h;
     }
 
+    static const uint64_t XXH64_PRIME_1 = 0x9E3779B185EBCA87ULL;
+    static const uint64_t XXH64_PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+    static const uint64_t XXH64_PRIME_3 = 0x165667B19E3779F9ULL;
+    static const uint64_t XXH64_PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+    static const uint64_t XXH64_PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+    ALWAYS_INLINE static uint64_t rotl64(uint64_t x, int8_t r) { return (x << r) | (x >> (64 - r)); }
+
+    template <typename T>
+    ALWAYS_INLINE static T load_unaligned(const uint8_t* p) {
+        T v;
+        memcpy(&v, p, sizeof(T));
+        return v;
+    }
+
+    ALWAYS_INLINE static uint64_t xxh64_round(uint64_t acc, uint64_t input) {
+        acc += input * XXH64_PRIME_2;
+        acc = rotl64(acc, 31);
+        return acc * XXH64_PRIME_1;
+    }
+
+    ALWAYS_INLINE static uint64_t xxh64_merge_round(uint64_t acc, uint64_t val) {
+        acc ^= xxh64_round(0, val);
+        return acc * XXH64_PRIME_1 + XXH64_PRIME_4;
+    }
+
+    // XXH64 hash implementation, it is the hash of the bloom filters in parquet files.
+    static uint64_t xx_hash64(const void* input, size_t len, uint64_t seed) {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(input);
+        const uint8_t* end = p + len;
+        uint64_t h;
+
+        if (len >= 32) {
+            const uint8_t* limit = end - 32;
+            uint64_t v1 = seed + XXH64_PRIME_1 + XXH64_PRIME_2;
+            uint64_t v2 = seed + XXH64_PRIME_2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - XXH64_PRIME_1;
+            do {
+                v1 = xxh64_round(v1, load_unaligned<uint64_t>(p));
+                v2 = xxh64_round(v2, load_unaligned<uint64_t>(p + 8));
+                v3 = xxh64_round(v3, load_unaligned<uint64_t>(p + 16));
+                v4 = xxh64_round(v4, load_unaligned<uint64_t>(p + 24));
+                p += 32;
+            } while (p <= limit);
+
+            h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+            h = xxh64_merge_round(h, v1);
+            h = xxh64_merge_round(h, v2);
+            h = xxh64_merge_round(h, v3);
+            h = xxh64_merge_round(h, v4);
+        } else {
+            h = seed + XXH64_PRIME_5;
+        }
+
+        h += len;
+        while (p + 8 <= end) {
+            h ^= xxh64_round(0, load_unaligned<uint64_t>(p));
+            h = rotl64(h, 27) * XXH64_PRIME_1 + XXH64_PRIME_4;
+            p += 8;
+        }
+        if (p + 4 <= end) {
+            h ^= uint64_t(load_unaligned<uint32_t>(p)) * XXH64_PRIME_1;
+            h = rotl64(h, 23) * XXH64_PRIME_2 + XXH64_PRIME_3;
+            p += 4;
+        }
+        while (p < end) {
+            h ^= (*p) * XXH64_PRIME_5;
+            h = rotl64(h, 11) * XXH64_PRIME_1;
+            ++p;
+        }
+
+        h ^= h >> 33;
+        h *= XXH64_PRIME_2;
+        h ^= h >> 29;
+        h *= XXH64_PRIME_3;
+        h ^= h >> 32;
+        return h;
+    }
+
     // default values recommended by http://isthe.com/chongo/tech/comp/fnv/
     static const uint32_t FNV_PRIME = 0x01000193; //   16777619
     static constexpr uint32_t FNV_SEED = 0x811C9DC5; // 2166136261
@@ -0,0 +1,274 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/json_value.h"
+
+#include "common/compiler_util.h"
+DIAGNOSTIC_PUSH
+DIAGNOSTIC_IGNORE("-Wclass-memaccess")
+#include <rapidjson/document.h>
+DIAGNOSTIC_POP
+
+#include <rapidjson/error/en.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "common/logging.h"
+#include "gutil/strings/substitute.h"
+#include "util/coding.h"
+
+namespace starrocks {
+
+// The size of the type, the payload size and the count of a container.
+static constexpr size_t kContainerHeaderSize = 1 + sizeof(uint32_t) * 2;
+
+static void put_type(std::string* dst, JsonType type) {
+    dst->push_back(static_cast<char>(type));
+}
+
+static void encode_value(const rapidjson::Value& value, std::string* dst);
+
+static void encode_string(const char* data, uint32_t size, std::string* dst) {
+    put_fixed32_le(dst, size);
+    dst->append(data, size);
+}
+
+static void encode_array(const rapidjson::Value& value, std::string* dst) {
+    put_type(dst, JsonType::JSON_ARRAY);
+    size_t payload_pos = dst->size();
+    put_fixed32_le(dst, 0);
+    uint32_t count = value.Size();
+    put_fixed32_le(dst, count);
+    size_t table_pos = dst->size();
+    dst->resize(table_pos + sizeof(uint32_t) * count);
+    size_t base = dst->size();
+    for (uint32_t i = 0; i < count; i++) {
+        encode_fixed32_le(reinterpret_cast<uint8_t*>(dst->data() + table_pos + sizeof(uint32_t) * i),
+                          dst->size() - base);
+        encode_value(value[i], dst);
+    }
+    encode_fixed32_le(reinterpret_cast<uint8_t*>(dst->data() + payload_pos),
+                      dst->size() - payload_pos - sizeof(uint32_t));
+}
+
+static void encode_object(const rapidjson::Value& value, std::string* dst) {
+    std::vector<const rapidjson::Value::Member*> members;
+    members.reserve(value.MemberCount());
+    for (auto it = value.MemberBegin(); it != value.MemberEnd(); ++it) {
+        members.push_back(&*it);
+    }
+    // stable, so the first one of the duplicate keys is found first, like a rapidjson document.
+    std::stable_sort(members.begin(), members.end(), [](const auto* lhs, const auto* rhs) {
+        return Slice(lhs->name.GetString(), lhs->name.GetStringLength()) <
+               Slice(rhs->name.GetString(), rhs->name.GetStringLength());
+    });
+
+    put_type(dst, JsonType::JSON_OBJECT);
+    size_t payload_pos = dst->size();
+    put_fixed32_le(dst, 0);
+    uint32_t count = members.size();
+    put_fixed32_le(dst, count);
+    size_t key_table_pos = dst->size();
+    size_t value_table_pos = key_table_pos + sizeof(uint32_t) * count;
+    dst->resize(value_table_pos + sizeof(uint32_t) * count);
+    size_t base = dst->size();
+    for (uint32_t i = 0; i < count; i++) {
+        encode_fixed32_le(reinterpret_cast<uint8_t*>(dst->data() + key_table_pos + sizeof(uint32_t) * i),
+                          dst->size() - base);
+        encode_string(members[i]->name.GetString(), members[i]->name.GetStringLength(), dst);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        encode_fixed32_le(reinterpret_cast<uint8_t*>(dst->data() + value_table_pos + sizeof(uint32_t) * i),
+                          dst->size() - base);
+        encode_value(members[i]->value, dst);
+    }
+    encode_fixed32_le(reinterpret_cast<uint8_t*>(dst->data() + payload_pos),
+                      dst->size() - payload_pos - sizeof(uint32_t));
+}
+
+static void encode_value(const rapidjson::Value& value, std::string* dst) {
+    switch (value.GetType()) {
+    case rapidjson::kNullType:
+        put_type(dst, JsonType::JSON_NULL);
+        break;
+    case rapidjson::kFalseType:
+        put_type(dst, JsonType::JSON_FALSE);
+        break;
+    case rapidjson::kTrueType:
+        put_type(dst, JsonType::JSON_TRUE);
+        break;
+    case rapidjson::kNumberType:
+        if (value.IsInt64()) {
+            put_type(dst, JsonType::JSON_INT);
+            put_fixed64_le(dst, static_cast<uint64_t>(value.GetInt64()));
+        } else {
+            double d = value.GetDouble();
+            uint64_t bits;
+            memcpy(&bits, &d, sizeof(bits));
+            put_type(dst, JsonType::JSON_DOUBLE);
+            put_fixed64_le(dst, bits);
+        }
+        break;
+    case rapidjson::kStringType:
+        put_type(dst, JsonType::JSON_STRING);
+        encode_string(value.GetString(), value.GetStringLength(), dst);
+        break;
+    case rapidjson::kArrayType:
+        encode_array(value, dst);
+        break;
+    case rapidjson::kObjectType:
+        encode_object(value, dst);
+        break;
+    }
+}
+
+static void write_value(const JsonView& value, rapidjson::Writer<rapidjson::StringBuffer>* writer) {
+    switch (value.type()) {
+    case JsonType::JSON_NULL:
+        writer->Null();
+        break;
+    case JsonType::JSON_FALSE:
+    case JsonType::JSON_TRUE:
+        writer->Bool(value.get_bool());
+        break;
+    case JsonType::JSON_INT:
+        writer->Int64(value.get_int());
+        break;
+    case JsonType::JSON_DOUBLE:
+        writer->Double(value.get_double());
+        break;
+    case JsonType::JSON_STRING: {
+        Slice s = value.get_string();
+        writer->String(s.data, s.size);
+        break;
+    }
+    case JsonType::JSON_ARRAY: {
+        writer->StartArray();
+        uint32_t count = value.count();
+        for (uint32_t i = 0; i < count; i++) {
+            write_value(value.element(i), writer);
+        }
+        writer->EndArray();
+        break;
+    }
+    case JsonType::JSON_OBJECT: {
+        writer->StartObject();
+        uint32_t count = value.count();
+        for (uint32_t i = 0; i < count; i++) {
+            Slice key = value.key_at(i);
+            writer->Key(key.data, key.size);
+            write_value(value.value_at(i), writer);
+        }
+        writer->EndObject();
+        break;
+    }
+    }
+}
+
+int64_t JsonView::get_int() const {
+    return static_cast<int64_t>(decode_fixed64_le(_data + 1));
+}
+
+double JsonView::get_double() const {
+    uint64_t bits = decode_fixed64_le(_data + 1);
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+Slice JsonView::get_string() const {
+    return Slice(_data + 1 + sizeof(uint32_t), decode_fixed32_le(_data + 1));
+}
+
+uint32_t JsonView::count() const {
+    return decode_fixed32_le(_data + 1 + sizeof(uint32_t));
+}
+
+JsonView JsonView::element(uint32_t idx) const {
+    DCHECK_LT(idx, count());
+    const uint8_t* base = _data + kContainerHeaderSize + sizeof(uint32_t) * count();
+    return JsonView(base + decode_fixed32_le(_data + kContainerHeaderSize + sizeof(uint32_t) * idx));
+}
+
+Slice JsonView::key_at(uint32_t idx) const {
+    DCHECK_LT(idx, count());
+    const uint8_t* base = _data + kContainerHeaderSize + sizeof(uint32_t) * 2 * count();
+    const uint8_t* key = base + decode_fixed32_le(_data + kContainerHeaderSize + sizeof(uint32_t) * idx);
+    return Slice(key + sizeof(uint32_t), decode_fixed32_le(key));
+}
+
+JsonView JsonView::value_at(uint32_t idx) const {
+    uint32_t n = count();
+    DCHECK_LT(idx, n);
+    const uint8_t* base = _data + kContainerHeaderSize + sizeof(uint32_t) * 2 * n;
+    return JsonView(base + decode_fixed32_le(_data + kContainerHeaderSize + sizeof(uint32_t) * (n + idx)));
+}
+
+JsonView JsonView::find(const Slice& key) const {
+    // the first of the keys not less than |key|.
+    uint32_t low = 0;
+    uint32_t high = count();
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (key_at(mid) < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low < count() && key_at(low) == key) {
+        return value_at(low);
+    }
+    return JsonView();
+}
+
+size_t JsonView::size() const {
+    switch (type()) {
+    case JsonType::JSON_NULL:
+    case JsonType::JSON_FALSE:
+    case JsonType::JSON_TRUE:
+        return 1;
+    case JsonType::JSON_INT:
+    case JsonType::JSON_DOUBLE:
+        return 1 + sizeof(uint64_t);
+    case JsonType::JSON_STRING:
+    case JsonType::JSON_ARRAY:
+    case JsonType::JSON_OBJECT:
+        return 1 + sizeof(uint32_t) + decode_fixed32_le(_data + 1);
+    }
+    return 1;
+}
+
+std::string JsonView::to_string() const {
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+    write_value(*this, &writer);
+    return std::string(buf.GetString(), buf.GetSize());
+}
+
+Status JsonValue::parse(const Slice& text, JsonValue* value) {
+    rapidjson::Document document;
+    document.Parse(text.data, text.size);
+    if (document.HasParseError()) {
+        return Status::InvalidArgument(
+                strings::Substitute("Failed to parse json at offset $0: $1", document.GetErrorOffset(),
+                                    rapidjson::GetParseError_En(document.GetParseError())));
+    }
+    value->_data.clear();
+    encode_value(document, &value->_data);
+    return Status::OK();
+}
+
+void JsonValue::clear() {
+    _data.assign(1, static_cast<char>(JsonType::JSON_NULL));
+}
+
+size_t JsonValue::serialize(uint8_t* dst) const {
+    memcpy(dst, _data.data(), _data.size());
+    return _data.size();
+}
+
+} // namespace starrocks
@@ -0,0 +1,103 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "common/status.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+enum class JsonType : uint8_t {
+    JSON_NULL = 0,
+    JSON_FALSE = 1,
+    JSON_TRUE = 2,
+    JSON_INT = 3,
+    JSON_DOUBLE = 4,
+    JSON_STRING = 5,
+    JSON_ARRAY = 6,
+    JSON_OBJECT = 7,
+};
+
+// JsonView reads a value of the binary form of JsonValue without copying it.
+// A default constructed view is invalid, which stands for a missing value.
+class JsonView {
+public:
+    JsonView() = default;
+    explicit JsonView(const uint8_t* data) : _data(data) {}
+
+    bool is_valid() const { return _data != nullptr; }
+
+    JsonType type() const { return static_cast<JsonType>(_data[0]); }
+
+    bool get_bool() const { return type() == JsonType::JSON_TRUE; }
+    int64_t get_int() const;
+    double get_double() const;
+    Slice get_string() const;
+
+    // The number of the elements of an array, or the members of an object.
+    uint32_t count() const;
+
+    // The |idx|-th element of an array.
+    JsonView element(uint32_t idx) const;
+
+    // The key and the value of the |idx|-th member of an object, the members are sorted by their keys.
+    Slice key_at(uint32_t idx) const;
+    JsonView value_at(uint32_t idx) const;
+
+    // The value of the first member named |key| of an object, or an invalid view if not found.
+    JsonView find(const Slice& key) const;
+
+    // The size of the binary form of this value.
+    size_t size() const;
+
+    // The json text of this value.
+    std::string to_string() const;
+
+private:
+    const uint8_t* _data = nullptr;
+};
+
+// JsonValue is a json document in a binary form, which is parsed once when the value is created, so it
+// can be read without parsing the json text again.
+//
+// Each value starts with its JsonType in one byte, followed by:
+//   null, false, true: nothing
+//   int: the int64 value, double: the double value
+//   string: the uint32 length, the bytes
+//   array: the uint32 payload size, the uint32 count, the uint32 offsets of the elements, the elements
+//   object: the uint32 payload size, the uint32 count, the uint32 offsets of the keys and the values of the
+//           members, the keys as the uint32 length and the bytes, the values
+// The numbers are little endian and the offsets are relative to the end of the offset table. The members
+// are sorted by their keys, so a member is found by a binary search and an element by its index, without
+// reading any other values.
+//
+// They are the objects of JsonColumn, see ObjectColumn for the methods they have.
+class JsonValue {
+public:
+    JsonValue() { clear(); }
+
+    // |s| is the binary form, e.g. from serialize().
+    explicit JsonValue(const Slice& s) : _data(s.data, s.size) {}
+
+    // Parse the json text |text| into |value|.
+    static Status parse(const Slice& text, JsonValue* value);
+
+    // Set to the json null.
+    void clear();
+
+    JsonView view() const { return JsonView(reinterpret_cast<const uint8_t*>(_data.data())); }
+
+    size_t serialize_size() const { return _data.size(); }
+
+    size_t serialize(uint8_t* dst) const;
+
+    std::string to_string() const { return view().to_string(); }
+
+private:
+    std::string _data;
+};
+
+} // namespace starrocks
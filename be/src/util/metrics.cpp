@@ -21,6 +21,9 @@
 
 #include "util/metrics.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace starrocks {
 
 MetricLabels MetricLabels::EmptyLabels;
@@ -88,6 +91,62 @@ void Metric::hide() {
     _registry = nullptr;
 }
 
+uint64_t CoreLocalHistogram::Snapshot::percentile(double quantile) const {
+    if (count == 0) {
+        return 0;
+    }
+    // the rank of the value, starting from 1.
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantile * count)));
+    uint64_t num_values = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        num_values += buckets[i];
+        if (num_values >= rank) {
+            return bucket_upper_bound(i);
+        }
+    }
+    return bucket_upper_bound(buckets.size() - 1);
+}
+
+// The shards are indexed the same way as the values of CoreLocalValue.
+CoreLocalHistogram::CoreLocalHistogram(MetricUnit unit)
+        : Metric(MetricType::SUMMARY, unit), _shards(CoreLocalValueController<uint64_t>::instance()->size()) {}
+
+CoreLocalHistogram::Snapshot CoreLocalHistogram::snapshot() const {
+    Snapshot snapshot;
+    snapshot.buckets.resize(kNumBuckets, 0);
+    for (const auto& shard : _shards) {
+        snapshot.sum += __atomic_load_n(&shard.sum, __ATOMIC_RELAXED);
+        for (size_t i = 0; i < kNumBuckets; ++i) {
+            snapshot.buckets[i] += __atomic_load_n(&shard.buckets[i], __ATOMIC_RELAXED);
+        }
+    }
+    // the count is summed from the buckets, so it's consistent with the percentiles.
+    for (auto num_values : snapshot.buckets) {
+        snapshot.count += num_values;
+    }
+    return snapshot;
+}
+
+std::string CoreLocalHistogram::to_string() const {
+    Snapshot snapshot = this->snapshot();
+    std::stringstream ss;
+    ss << "count=" << snapshot.count << " sum=" << snapshot.sum;
+    for (const auto& percentile : kPercentiles) {
+        ss << " " << percentile.name << "=" << snapshot.percentile(percentile.quantile);
+    }
+    return ss.str();
+}
+
+void CoreLocalHistogram::write_value(rj::Value& metric_obj, rj::Document::AllocatorType& allocator) {
+    Snapshot snapshot = this->snapshot();
+    metric_obj.AddMember("value", rj::Value(snapshot.count), allocator);
+    metric_obj.AddMember("sum", rj::Value(snapshot.sum), allocator);
+    for (const auto& percentile : kPercentiles) {
+        metric_obj.AddMember(rj::StringRef(percentile.name), rj::Value(snapshot.percentile(percentile.quantile)),
+                             allocator);
+    }
+}
+
 bool MetricCollector::add_metric(const MetricLabels& labels, Metric* metric) {
     if (empty()) {
         _type = metric->type();
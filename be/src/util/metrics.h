@@ -38,6 +38,7 @@ DIAGNOSTIC_POP
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "common/config.h"
 #include "util/core_local.h"
@@ -181,6 +182,90 @@ protected:
     CoreLocalValue<T> _value;
 };
 
+// A histogram of non-negative values, e.g. latencies or sizes, cheap enough for the hot paths. Every core adds
+// into a shard of its own, so the updates never contend, and the shards are only summed when the metric is read.
+// The values are counted in log-linear buckets like the HDR histogram: each value below 8 has a bucket of its own,
+// and every power of two above is split into 8 buckets, so a percentile is within 12.5% of the real value. The
+// values not less than 2^40 are all counted in the last bucket.
+// It's exported as a summary of the percentiles in kPercentiles.
+class CoreLocalHistogram : public Metric {
+public:
+    static constexpr int kSubBucketBits = 3;
+    static constexpr int kMaxValueBits = 40;
+    static constexpr size_t kNumBuckets = (kMaxValueBits - kSubBucketBits + 1) << kSubBucketBits;
+
+    struct Percentile {
+        double quantile;
+        const char* name;
+    };
+    static constexpr Percentile kPercentiles[] = {{0.5, "p50"},  {0.75, "p75"}, {0.9, "p90"},
+                                                  {0.95, "p95"}, {0.99, "p99"}, {0.999, "p999"}};
+
+    // The counts summed over all the shards.
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        std::vector<uint64_t> buckets;
+
+        // Return the largest value of the bucket of the |quantile| of the values, 0 if there is no value.
+        uint64_t percentile(double quantile) const;
+    };
+
+    CoreLocalHistogram(MetricUnit unit);
+    virtual ~CoreLocalHistogram() {}
+
+    std::string to_string() const override;
+
+    void write_value(rj::Value& metric_obj, rj::Document::AllocatorType& allocator) override;
+
+    void add(uint64_t value) {
+        size_t cpu_id = sched_getcpu();
+        Shard& shard = _shards[cpu_id & (_shards.size() - 1)];
+        // Relaxed atomics are enough, another thread on the same core only races with a preempted one.
+        __atomic_fetch_add(&shard.buckets[bucket_index(value)], 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&shard.sum, value, __ATOMIC_RELAXED);
+    }
+
+    Snapshot snapshot() const;
+
+    static size_t bucket_index(uint64_t value) {
+        if (value < (1 << kSubBucketBits)) {
+            return value;
+        }
+        if (value >= (uint64_t(1) << kMaxValueBits)) {
+            return kNumBuckets - 1;
+        }
+        const int msb = 63 - __builtin_clzll(value);
+        const int shift = msb - kSubBucketBits;
+        const size_t sub_bucket = (value >> shift) & ((1 << kSubBucketBits) - 1);
+        return (static_cast<size_t>(shift + 1) << kSubBucketBits) + sub_bucket;
+    }
+
+    // The range of the values counted in the bucket |index|.
+    static uint64_t bucket_lower_bound(size_t index) {
+        if (index < (1 << kSubBucketBits)) {
+            return index;
+        }
+        const int shift = static_cast<int>(index >> kSubBucketBits) - 1;
+        return ((1 << kSubBucketBits) + (index & ((1 << kSubBucketBits) - 1))) << shift;
+    }
+    static uint64_t bucket_upper_bound(size_t index) {
+        if (index < (1 << kSubBucketBits)) {
+            return index;
+        }
+        const int shift = static_cast<int>(index >> kSubBucketBits) - 1;
+        return bucket_lower_bound(index) + (uint64_t(1) << shift) - 1;
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        uint64_t sum = 0;
+        uint64_t buckets[kNumBuckets] = {};
+    };
+
+    std::vector<Shard> _shards;
+};
+
 template <typename T>
 class AtomicCounter : public AtomicMetric<T> {
 public:
@@ -432,5 +517,8 @@ private:
 #define METRIC_DEFINE_DOUBLE_GAUGE(metric_name, unit) \
     starrocks::DoubleGauge metric_name { unit }
 
+#define METRIC_DEFINE_HISTOGRAM(metric_name, unit) \
+    starrocks::CoreLocalHistogram metric_name { unit }
+
 #define METRIC_DEFINE_TCMALLOC_GAUGE(metric_name, tcmalloc_var) \
     starrocks::TcmallocMetric metric_name { tcmalloc_var }
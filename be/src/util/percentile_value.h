@@ -23,6 +23,15 @@ public:
 
     void add(float value) { _tdigest.add(value); }
 
+    void add(const float* values, size_t num_values) { _tdigest.add(values, num_values); }
+
+    // Process the buffered values, so that only the compressed centroids are serialized.
+    void compress() {
+        if (_tdigest.haveUnprocessed()) {
+            _tdigest.compress();
+        }
+    }
+
     void merge(const PercentileValue* other) { _tdigest.merge(&other->_tdigest); }
 
     uint64_t serialize_size() const {
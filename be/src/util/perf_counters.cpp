@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/syscall.h>
+#include <unistd.h>
 
 #include <fstream>
 #include <iomanip>
@@ -514,4 +515,64 @@ void PerfCounters::pretty_print(ostream* s) const {
     stream << std::endl;
 }
 
+ThreadPerfCounters* ThreadPerfCounters::current() {
+    struct ThreadLocalCounters {
+        ThreadPerfCounters counters;
+        bool opened = false;
+        bool available = false;
+    };
+    static thread_local ThreadLocalCounters tls_counters;
+    if (!tls_counters.opened) {
+        tls_counters.opened = true;
+        tls_counters.available = tls_counters.counters.open();
+    }
+    return tls_counters.available ? &tls_counters.counters : nullptr;
+}
+
+bool ThreadPerfCounters::open() {
+    static const std::pair<uint32_t, uint64_t> events[NUM_COUNTERS] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = events[i].first;
+        attr.config = events[i].second;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        // the events of this thread on any cpu, the first one is the leader of the group.
+        _fds[i] = sys_perf_event_open(&attr, 0, -1, i == 0 ? -1 : _fds[0], 0);
+        if (_fds[i] < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ThreadPerfCounters::read(Values* values) const {
+    struct {
+        uint64_t nr;
+        uint64_t values[NUM_COUNTERS];
+    } group;
+    if (::read(_fds[0], &group, sizeof(group)) != sizeof(group) || group.nr != NUM_COUNTERS) {
+        return false;
+    }
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        values->values[i] = group.values[i];
+    }
+    return true;
+}
+
+ThreadPerfCounters::~ThreadPerfCounters() {
+    for (int fd : _fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
 } // namespace starrocks
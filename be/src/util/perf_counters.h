@@ -141,6 +141,45 @@ private:
     int _group_fd;
 };
 
+// ThreadPerfCounters counts the hardware events of the calling thread in user space by a group of perf events,
+// so they are read together by one syscall. The counters of a thread are opened on the first use and closed when
+// the thread exits.
+// A typical usage pattern would be:
+//  auto* counters = ThreadPerfCounters::current();
+//  ThreadPerfCounters::Values begin, end;
+//  if (counters != nullptr && counters->read(&begin)) {
+//      <do your work>
+//      counters->read(&end);
+//  }
+class ThreadPerfCounters {
+public:
+    enum Counter {
+        CPU_CYCLES = 0,
+        INSTRUCTIONS,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        NUM_COUNTERS,
+    };
+
+    struct Values {
+        int64_t values[NUM_COUNTERS] = {0};
+    };
+
+    // Returns the counters of the calling thread, nullptr if the perf events are unavailable, e.g. forbidden by
+    // perf_event_paranoid or not supported by the virtual machine.
+    static ThreadPerfCounters* current();
+
+    bool read(Values* values) const;
+
+    ~ThreadPerfCounters();
+
+private:
+    ThreadPerfCounters() = default;
+    bool open();
+
+    int _fds[NUM_COUNTERS] = {-1, -1, -1, -1};
+};
+
 } // namespace starrocks
 
 #endif
@@ -0,0 +1,45 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace starrocks {
+
+// RateLimiter limits the total rate of the bytes consumed by all its callers. A caller acquires the bytes before
+// consuming them, and is blocked until they fit into the rate. The unused rate of at most |kMaxBurstMs| is saved
+// for the later bursts.
+class RateLimiter {
+public:
+    static constexpr int64_t kMaxBurstMs = 100;
+
+    // Block until |bytes| can be consumed at |bytes_per_second|, which is not limited if it's not positive.
+    void acquire(int64_t bytes, int64_t bytes_per_second) {
+        if (bytes_per_second <= 0 || bytes <= 0) {
+            return;
+        }
+        auto cost = std::chrono::nanoseconds(bytes * 1000000000 / bytes_per_second);
+        Clock::time_point wakeup_time;
+        {
+            std::lock_guard l(_mutex);
+            auto now = Clock::now();
+            _available_time = std::max(_available_time, now - std::chrono::milliseconds(kMaxBurstMs));
+            _available_time += cost;
+            wakeup_time = _available_time;
+        }
+        std::this_thread::sleep_until(wakeup_time);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::mutex _mutex;
+    // the time when all the bytes acquired are consumed at the rate
+    Clock::time_point _available_time;
+};
+
+} // namespace starrocks
@@ -142,6 +142,13 @@ public:
         return current_value_;
     }
 
+    // Skip the next |count| values of the current literal run without decoding them.
+    void skip_literal(size_t count) {
+        DCHECK_GE(literal_count_, count);
+        bit_reader_.SeekToBit(bit_reader_.position() + count * bit_width_);
+        literal_count_ -= count;
+    }
+
 private:
     bool ReadHeader();
 
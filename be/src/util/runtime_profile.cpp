@@ -571,6 +571,95 @@ void RuntimeProfile::to_thrift(std::vector<TRuntimeProfileNode>* nodes) {
     }
 }
 
+void RuntimeProfile::to_thrift_changed(TRuntimeProfileTree* tree) {
+    tree->nodes.clear();
+    to_thrift_changed(&tree->nodes);
+}
+
+bool RuntimeProfile::to_thrift_changed(std::vector<TRuntimeProfileNode>* nodes) {
+    int index = nodes->size();
+    nodes->push_back(TRuntimeProfileNode());
+    TRuntimeProfileNode& node = (*nodes)[index];
+    node.name = _name;
+    node.metadata = _metadata;
+    node.indent = true;
+
+    CounterMap counter_map;
+    ChildCounterMap child_counter_map;
+    {
+        std::lock_guard<std::mutex> l(_counter_map_lock);
+        counter_map = _counter_map;
+        child_counter_map = _child_counter_map;
+    }
+    InfoStrings info_strings;
+    InfoStringsDisplayOrder info_strings_display_order;
+    {
+        std::lock_guard<std::mutex> l(_info_strings_lock);
+        info_strings = _info_strings;
+        info_strings_display_order = _info_strings_display_order;
+    }
+
+    bool changed = false;
+    {
+        std::lock_guard<std::mutex> l(_reported_lock);
+        changed = !_reported;
+        _reported = true;
+
+        bool has_new_counter = false;
+        for (auto& [name, counter] : counter_map) {
+            int64_t value = counter->value();
+            auto iter = _reported_counter_values.find(name);
+            if (iter != _reported_counter_values.end() && iter->second == value) {
+                continue;
+            }
+            has_new_counter |= (iter == _reported_counter_values.end());
+            _reported_counter_values[name] = value;
+            TCounter tcounter;
+            tcounter.name = name;
+            tcounter.value = value;
+            tcounter.type = counter->type();
+            node.counters.push_back(tcounter);
+        }
+        // the hierarchy of the counters only grows with the new ones.
+        if (has_new_counter) {
+            node.child_counters_map = std::move(child_counter_map);
+        }
+
+        for (const std::string& key : info_strings_display_order) {
+            const std::string& value = info_strings[key];
+            auto iter = _reported_info_strings.find(key);
+            if (iter != _reported_info_strings.end() && iter->second == value) {
+                continue;
+            }
+            _reported_info_strings[key] = value;
+            node.info_strings.emplace(key, value);
+            node.info_strings_display_order.push_back(key);
+        }
+        changed |= !node.counters.empty() || !node.info_strings_display_order.empty();
+    }
+
+    ChildVector children;
+    {
+        std::lock_guard<std::mutex> l(_children_lock);
+        children = _children;
+    }
+
+    int num_children = 0;
+    for (auto& [child, indent] : children) {
+        int child_idx = nodes->size();
+        if (child->to_thrift_changed(nodes)) {
+            // fix up indentation flag
+            (*nodes)[child_idx].indent = indent;
+            ++num_children;
+        } else {
+            // the unchanged child is matched by its name, so it could be skipped as a whole.
+            nodes->resize(child_idx);
+        }
+    }
+    (*nodes)[index].num_children = num_children;
+    return changed || num_children > 0;
+}
+
 int64_t RuntimeProfile::units_per_second(const RuntimeProfile::Counter* total_counter,
                                          const RuntimeProfile::Counter* timer) {
     DCHECK(total_counter->type() == TUnit::BYTES || total_counter->type() == TUnit::UNIT);
@@ -353,6 +353,12 @@ public:
     void to_thrift(TRuntimeProfileTree* tree);
     void to_thrift(std::vector<TRuntimeProfileNode>* nodes);
 
+    // Like to_thrift(), but only serializes the counters, the info strings and the child profiles changed since
+    // the last call, so the reported profile could be brought up to date by update() with the result. The first
+    // call serializes all of them.
+    // Does not hold locks when it makes any function calls.
+    void to_thrift_changed(TRuntimeProfileTree* tree);
+
     // Divides all counters by n
     void divide(int n);
 
@@ -493,6 +499,13 @@ private:
     // Protects _info_strings and _info_strings_display_order
     mutable std::mutex _info_strings_lock;
 
+    // The counter values and the info strings serialized by the last to_thrift_changed(), and whether it has
+    // been called.
+    std::map<std::string, int64_t> _reported_counter_values;
+    InfoStrings _reported_info_strings;
+    bool _reported = false;
+    std::mutex _reported_lock;
+
     typedef std::map<std::string, EventSequence*> EventSequenceMap;
     EventSequenceMap _event_sequence_map;
     mutable std::mutex _event_sequences_lock;
@@ -565,6 +578,9 @@ private:
     // On return, *idx points to the node immediately following this subtree.
     void update(const std::vector<TRuntimeProfileNode>& nodes, int* idx);
 
+    // Returns whether anything of this profile or its children is serialized.
+    bool to_thrift_changed(std::vector<TRuntimeProfileNode>* nodes);
+
     // Helper function to compute compute the fraction of the total time spent in
     // this profile and its children.
     // Called recusively.
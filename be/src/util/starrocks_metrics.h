@@ -155,6 +155,10 @@ public:
     METRIC_DEFINE_UINT_COUNTER(update_del_vector_deletes_total, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_COUNTER(update_del_vector_deletes_new, MetricUnit::NOUNIT);
 
+    // Histograms
+    // the latency to read a page of the segments from its file, excluding the pages hit by the page cache.
+    METRIC_DEFINE_HISTOGRAM(page_read_latency_us, MetricUnit::MICROSECONDS);
+
     // Gauges
     METRIC_DEFINE_INT_GAUGE(memory_pool_bytes_total, MetricUnit::BYTES);
     METRIC_DEFINE_INT_GAUGE(process_thread_num, MetricUnit::NOUNIT);
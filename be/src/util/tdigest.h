@@ -420,6 +420,19 @@ public:
         return true;
     }
 
+    // add the values as the centroids of weight 1, same as adding them one by one.
+    inline void add(const Value* values, size_t num_values) {
+        _unprocessed.reserve(std::min(_unprocessed.size() + num_values, _max_unprocessed + 1));
+        for (size_t i = 0; i < num_values; i++) {
+            if (std::isnan(values[i])) {
+                continue;
+            }
+            _unprocessed.emplace_back(values[i], 1);
+            _unprocessed_weight += 1;
+            processIfNecessary();
+        }
+    }
+
     inline void add(std::vector<Centroid>::const_iterator iter, std::vector<Centroid>::const_iterator end) {
         while (iter != end) {
             const size_t diff = std::distance(iter, end);
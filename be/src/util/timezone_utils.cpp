@@ -22,6 +22,9 @@
 
 #include "util/timezone_utils.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace starrocks {
 
 RE2 TimezoneUtils::time_zone_offset_format_reg("^[+-]{1}\\d{2}\\:\\d{2}$");
@@ -64,4 +67,36 @@ int64_t TimezoneUtils::to_utc_offset(const cctz::time_zone& ctz) {
     return a.cs - b.cs;
 }
 
+static const cctz::civil_second kUnixEpoch(1970, 1, 1, 0, 0, 0);
+static constexpr int64_t kSecondsPerDay = 24 * 3600;
+
+void TimezoneOffsetCache::_lookup(int64_t utc) {
+    const cctz::time_point<cctz::seconds> tp(cctz::seconds{utc});
+    _offset = _ctz.lookup(tp).offset;
+
+    cctz::time_zone::civil_transition trans;
+    _end = std::numeric_limits<int64_t>::max();
+    if (_ctz.next_transition(tp, &trans)) {
+        _end = (trans.from - kUnixEpoch) - _offset;
+    }
+    // The transition at |tp| itself is found after one second.
+    _begin = std::numeric_limits<int64_t>::min();
+    if (_ctz.prev_transition(tp + cctz::seconds(1), &trans)) {
+        _begin = (trans.to - kUnixEpoch) - _offset;
+    }
+    _begin = std::min(_begin, utc);
+    _end = std::max(_end, utc + 1);
+
+    _safe_begin = _begin == std::numeric_limits<int64_t>::min() ? _begin : _begin + kSecondsPerDay;
+    _safe_end = _end == std::numeric_limits<int64_t>::max() ? _end : _end - kSecondsPerDay;
+}
+
+int64_t TimezoneOffsetCache::_convert(int64_t local) {
+    int64_t utc = cctz::convert(kUnixEpoch + local, _ctz).time_since_epoch().count();
+    if (utc < _begin || utc >= _end) {
+        _lookup(utc);
+    }
+    return utc;
+}
+
 } // namespace starrocks
@@ -24,7 +24,9 @@
 
 #include <re2/re2.h>
 
+#include "cctz/civil_time.h"
 #include "cctz/time_zone.h"
+#include "common/compiler_util.h"
 
 namespace starrocks {
 
@@ -40,4 +42,47 @@ private:
     // RE2 obj is thread safe
     static RE2 time_zone_offset_format_reg;
 };
+
+// TimezoneOffsetCache converts the seconds since 1970-01-01 00:00:00 between UTC and the local time of a time
+// zone. It remembers the offset of the period between the two transitions around the last time point looked up,
+// so the conversions of the time points close to each other, e.g. those of a column, don't look up the time
+// zone again.
+// It's not thread safe, create one for each call.
+class TimezoneOffsetCache {
+public:
+    explicit TimezoneOffsetCache(const cctz::time_zone& ctz) : _ctz(ctz) {}
+
+    // The local seconds of the UTC seconds |utc|, the same as cctz::convert(time_point, ctz).
+    int64_t utc_to_local(int64_t utc) {
+        if (UNLIKELY(utc < _begin || utc >= _end)) {
+            _lookup(utc);
+        }
+        return utc + _offset;
+    }
+
+    // The UTC seconds of the local seconds |local|, the same as cctz::convert(civil_second, ctz), i.e. the
+    // offset before the transition is used if |local| is skipped or repeated.
+    int64_t local_to_utc(int64_t local) {
+        int64_t utc = local - _offset;
+        if (LIKELY(utc >= _safe_begin && utc < _safe_end)) {
+            return utc;
+        }
+        return _convert(local);
+    }
+
+private:
+    void _lookup(int64_t utc);
+    int64_t _convert(int64_t local);
+
+    cctz::time_zone _ctz;
+    // The UTC seconds in [_begin, _end) have the offset _offset, it's empty until the first lookup.
+    int64_t _offset = 0;
+    int64_t _begin = 1;
+    int64_t _end = 0;
+    // The UTC seconds in [_safe_begin, _safe_end) are at least one day away from the transitions, so their
+    // local times are neither skipped nor repeated.
+    int64_t _safe_begin = 1;
+    int64_t _safe_end = 0;
+};
+
 } // namespace starrocks
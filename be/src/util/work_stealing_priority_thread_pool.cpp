@@ -0,0 +1,151 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/work_stealing_priority_thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+// The pool and the queue of the worker running on this thread, if any.
+static thread_local WorkStealingPriorityThreadPool* tls_pool = nullptr;
+static thread_local int tls_worker_id = -1;
+
+WorkStealingPriorityThreadPool::WorkStealingPriorityThreadPool(uint32_t num_threads, uint32_t queue_size)
+        : _capacity(queue_size) {
+    num_threads = std::max<uint32_t>(num_threads, 1);
+    for (uint32_t i = 0; i < num_threads; ++i) {
+        _queues.emplace_back(std::make_unique<WorkerQueue>());
+    }
+    for (uint32_t i = 0; i < num_threads; ++i) {
+        _threads.emplace_back(&WorkStealingPriorityThreadPool::_work_thread, this, i);
+    }
+}
+
+bool WorkStealingPriorityThreadPool::_put(Task task, bool block) {
+    // reserve a room for the task first
+    uint32_t reserved = _num_reserved.load(std::memory_order_relaxed);
+    while (true) {
+        if (_shutdown.load(std::memory_order_acquire)) {
+            return false;
+        }
+        if (reserved < _capacity) {
+            if (_num_reserved.compare_exchange_weak(reserved, reserved + 1)) {
+                break;
+            }
+            continue;
+        }
+        if (!block) {
+            return false;
+        }
+        std::unique_lock l(_lock);
+        _num_blocked_offers.fetch_add(1);
+        _put_cv.wait(l, [this] { return _num_reserved.load() < _capacity || _shutdown.load(); });
+        _num_blocked_offers.fetch_sub(1);
+        reserved = _num_reserved.load(std::memory_order_relaxed);
+    }
+
+    size_t index = tls_pool == this ? tls_worker_id : _next_queue.fetch_add(1, std::memory_order_relaxed);
+    WorkerQueue& queue = *_queues[index % _queues.size()];
+    {
+        std::lock_guard l(queue.lock);
+        queue.heap.emplace_back(std::move(task));
+        std::push_heap(queue.heap.begin(), queue.heap.end());
+    }
+    _num_queued.fetch_add(1);
+    // An idle worker either sees the task before it sleeps, or is sleeping and is woken up here.
+    if (_num_sleeping.load() > 0) {
+        { std::lock_guard l(_lock); }
+        _get_cv.notify_one();
+    }
+    return true;
+}
+
+bool WorkStealingPriorityThreadPool::_pop(WorkerQueue* queue, Task* task) {
+    {
+        std::lock_guard l(queue->lock);
+        if (queue->heap.empty()) {
+            return false;
+        }
+        if (queue->upgrade_counter > config::priority_queue_remaining_tasks_increased_frequency) {
+            for (auto& queued_task : queue->heap) {
+                ++queued_task;
+            }
+            std::make_heap(queue->heap.begin(), queue->heap.end());
+            queue->upgrade_counter = 0;
+        }
+        std::pop_heap(queue->heap.begin(), queue->heap.end());
+        *task = std::move(queue->heap.back());
+        queue->heap.pop_back();
+        ++queue->upgrade_counter;
+    }
+    _num_queued.fetch_sub(1);
+    _num_reserved.fetch_sub(1);
+    if (_num_blocked_offers.load() > 0) {
+        { std::lock_guard l(_lock); }
+        _put_cv.notify_one();
+    }
+    return true;
+}
+
+bool WorkStealingPriorityThreadPool::_take(int worker_id, Task* task) {
+    // its own queue first, then steal from the next ones
+    for (size_t i = 0; i < _queues.size(); ++i) {
+        if (_pop(_queues[(worker_id + i) % _queues.size()].get(), task)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPriorityThreadPool::_work_thread(int worker_id) {
+    tls_pool = this;
+    tls_worker_id = worker_id;
+    while (!_shutdown.load(std::memory_order_acquire)) {
+        Task task;
+        if (_take(worker_id, &task)) {
+            task.work_function();
+            if (_num_queued.load() == 0) {
+                _empty_cv.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock l(_lock);
+        _num_sleeping.fetch_add(1);
+        _get_cv.wait(l, [this] { return _num_queued.load() > 0 || _shutdown.load(); });
+        _num_sleeping.fetch_sub(1);
+    }
+}
+
+void WorkStealingPriorityThreadPool::shutdown() {
+    {
+        std::lock_guard l(_lock);
+        _shutdown.store(true, std::memory_order_release);
+    }
+    _get_cv.notify_all();
+    _put_cv.notify_all();
+}
+
+void WorkStealingPriorityThreadPool::join() {
+    for (auto& thread : _threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void WorkStealingPriorityThreadPool::drain_and_shutdown() {
+    {
+        std::unique_lock l(_lock);
+        // the notification is not synchronized with the lock, so check it periodically
+        while (_num_queued.load() != 0) {
+            _empty_cv.wait_for(l, std::chrono::milliseconds(10));
+        }
+    }
+    shutdown();
+    join();
+}
+
+} // namespace starrocks
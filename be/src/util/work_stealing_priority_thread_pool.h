@@ -0,0 +1,94 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "util/priority_thread_pool.hpp"
+
+namespace starrocks {
+
+// A drop-in replacement of PriorityThreadPool for the many short tasks of the scanners, whose single queue is
+// contended by the threads offering and taking the tasks.
+//
+// Each worker has its own priority queue. A task offered by a worker goes to the queue of the worker, one offered by
+// another thread goes to the queues in turn. A worker takes the task of the highest priority in its own queue, and
+// steals from the queues of the others when its own is empty, so the lock of a queue is mostly taken by its owner.
+// The priorities are ordered within each queue only, the tasks left in a queue are aged in the same way as
+// BlockingPriorityQueue, so the tasks of the low priority are not starved.
+class WorkStealingPriorityThreadPool {
+public:
+    using Task = PriorityThreadPool::Task;
+    using WorkFunction = PriorityThreadPool::WorkFunction;
+
+    // Start |num_threads| threads. At most |queue_size| tasks are queued, the blocking offers wait for a room
+    // beyond that.
+    WorkStealingPriorityThreadPool(uint32_t num_threads, uint32_t queue_size);
+
+    ~WorkStealingPriorityThreadPool() {
+        shutdown();
+        join();
+    }
+
+    // Return false if the pool has been shut down.
+    bool offer(const Task& task) { return _put(task, true); }
+
+    bool offer(WorkFunction func) { return _put(Task{0, std::move(func)}, true); }
+
+    // Return false if the queue is full or the pool has been shut down.
+    bool try_offer(const Task& task) { return _put(task, false); }
+
+    // Stop accepting tasks, the threads exit once they finish their current tasks.
+    void shutdown();
+
+    void join();
+
+    // Wait until all the queued tasks are taken, then shut down and join the threads.
+    void drain_and_shutdown();
+
+    size_t get_queue_capacity() const { return _capacity; }
+
+    uint32_t get_queue_size() const { return _num_queued.load(std::memory_order_relaxed); }
+
+private:
+    struct WorkerQueue {
+        std::mutex lock;
+        std::vector<Task> heap;
+        int upgrade_counter = 0;
+    };
+
+    bool _put(Task task, bool block);
+    bool _take(int worker_id, Task* task);
+    bool _pop(WorkerQueue* queue, Task* task);
+    void _work_thread(int worker_id);
+
+    const uint32_t _capacity;
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
+    std::vector<std::thread> _threads;
+
+    // The number of the tasks being offered and queued, which is bounded by _capacity.
+    std::atomic<uint32_t> _num_reserved{0};
+    // The number of the tasks in the queues.
+    std::atomic<uint32_t> _num_queued{0};
+    std::atomic<uint32_t> _next_queue{0};
+    // The number of the idle workers and the blocking offers waiting on the condition variables.
+    std::atomic<int> _num_sleeping{0};
+    std::atomic<int> _num_blocked_offers{0};
+    std::atomic<bool> _shutdown{false};
+
+    // Guards the waits on the condition variables.
+    std::mutex _lock;
+    // The idle workers wait on this.
+    std::condition_variable _get_cv;
+    // The blocking offers wait on this.
+    std::condition_variable _put_cv;
+    // Signalled when the queues become empty.
+    std::condition_variable _empty_cv;
+};
+
+} // namespace starrocks
@@ -0,0 +1,58 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/binary_view.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace starrocks::vectorized {
+
+static int sign(int v) {
+    return v < 0 ? -1 : (v > 0 ? 1 : 0);
+}
+
+// NOLINTNEXTLINE
+TEST(BinaryViewTest, test_inline_and_pointer) {
+    std::string short_str = "abc";
+    std::string long_str = "abcdefghijklmnopq";
+    BinaryView short_view{Slice(short_str)};
+    BinaryView long_view{Slice(long_str)};
+    ASSERT_TRUE(short_view.is_inlined());
+    ASSERT_FALSE(long_view.is_inlined());
+    ASSERT_EQ(short_str, short_view.to_slice().to_string());
+    ASSERT_EQ(long_str, long_view.to_slice().to_string());
+    ASSERT_EQ(long_str.data(), long_view.data());
+    ASSERT_EQ(0, BinaryView().size());
+}
+
+// NOLINTNEXTLINE
+TEST(BinaryViewTest, test_compare_same_as_slice) {
+    std::vector<std::string> values = {"",
+                                       "a",
+                                       "ab",
+                                       std::string("ab\0", 3),
+                                       std::string("ab\0\0\0", 5),
+                                       "abc",
+                                       "abcd",
+                                       "abce",
+                                       "abcdefghijkl",
+                                       "abcdefghijklm",
+                                       "abcdefghijkm",
+                                       "abcdefghijklmnopq",
+                                       "abcdefghijklmnopr",
+                                       "\xff",
+                                       "\xff\x01",
+                                       "b"};
+    for (const auto& l : values) {
+        for (const auto& r : values) {
+            BinaryView lv{Slice(l)};
+            BinaryView rv{Slice(r)};
+            ASSERT_EQ(sign(Slice(l).compare(Slice(r))), sign(lv.compare(rv))) << l << " vs " << r;
+            ASSERT_EQ(l == r, lv == rv) << l << " vs " << r;
+        }
+    }
+}
+
+} // namespace starrocks::vectorized
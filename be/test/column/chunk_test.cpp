@@ -23,8 +23,11 @@
 
 #include <gtest/gtest.h>
 
+#include "column/binary_column.h"
 #include "column/field.h"
 #include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "util/hash_util.hpp"
 
 namespace starrocks::vectorized {
 
@@ -251,4 +254,78 @@ TEST_F(ChunkTest, test_append_chunk_safe) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_filter) {
+    // the dense selection is compacted column by column, the sparse one is gathered.
+    for (size_t step : {1, 2, 3, 17}) {
+        auto ints = FixedLengthColumn<int32_t>::create();
+        auto longs = NullableColumn::create(FixedLengthColumn<int64_t>::create(), NullColumn::create());
+        auto strings = BinaryColumn::create();
+        const size_t num_rows = 1000;
+        Buffer<uint8_t> selection(num_rows);
+        for (size_t i = 0; i < num_rows; i++) {
+            ints->append(i);
+            if (i % 5 == 0) {
+                ASSERT_TRUE(longs->append_nulls(1));
+            } else {
+                longs->append_datum(Datum(static_cast<int64_t>(i)));
+            }
+            strings->append(make_string(i));
+            selection[i] = (i % step == 0);
+        }
+        Chunk chunk;
+        chunk.append_column(ints, 0);
+        chunk.append_column(longs, 1);
+        chunk.append_column(strings, 2);
+
+        ASSERT_EQ((num_rows + step - 1) / step, chunk.filter(selection));
+        for (size_t i = 0; i < chunk.num_rows(); i++) {
+            size_t row = i * step;
+            ASSERT_EQ(row, chunk.get_column_by_index(0)->get(i).get_int32());
+            if (row % 5 == 0) {
+                ASSERT_TRUE(chunk.get_column_by_index(1)->is_null(i));
+            } else {
+                ASSERT_EQ(row, chunk.get_column_by_index(1)->get(i).get_int64());
+            }
+            ASSERT_EQ(make_string(row), chunk.get_column_by_index(2)->get(i).get_slice().to_string());
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_compute_hash_values) {
+    Chunk chunk;
+    chunk.append_column(make_column(0), 0);
+    chunk.append_column(make_column(1), 1);
+    Columns keys{chunk.get_column_by_index(1), chunk.get_column_by_index(0)};
+
+    for (auto function : {ChunkHashFunction::FNV, ChunkHashFunction::CRC32}) {
+        Buffer<uint32_t> expected(100, function == ChunkHashFunction::FNV ? HashUtil::FNV_SEED : 0);
+        for (const auto& key : keys) {
+            if (function == ChunkHashFunction::FNV) {
+                key->fvn_hash(expected.data(), 0, 100);
+            } else {
+                key->crc32_hash(expected.data(), 0, 100);
+            }
+        }
+        // computed, then from the cache
+        for (int i = 0; i < 2; i++) {
+            Buffer<uint32_t> hash_values;
+            chunk.compute_hash_values(function, keys, &hash_values);
+            ASSERT_EQ(expected, hash_values);
+        }
+    }
+
+    // the cached hash values are dropped once the rows change
+    Buffer<uint8_t> selection(100, 0);
+    selection[3] = 1;
+    chunk.filter(selection);
+    Buffer<uint32_t> expected(1, HashUtil::FNV_SEED);
+    keys[0]->fvn_hash(expected.data(), 0, 1);
+    keys[1]->fvn_hash(expected.data(), 0, 1);
+    Buffer<uint32_t> hash_values;
+    chunk.compute_hash_values(ChunkHashFunction::FNV, keys, &hash_values);
+    ASSERT_EQ(expected, hash_values);
+}
+
 } // namespace starrocks::vectorized
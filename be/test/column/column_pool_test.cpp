@@ -78,4 +78,22 @@ TEST_F(ColumnPoolTest, single_thread) {
     delete c4;
 }
 
+// NOLINTNEXTLINE
+TEST_F(ColumnPoolTest, trim_local_columns) {
+    auto c1 = get_column<Int32Column>();
+    auto c2 = get_column<Int32Column>();
+    return_column<Int32Column>(c1);
+
+    // c1 is destroyed when the next column is returned after trimming.
+    trim_local_columns<Int32Column>();
+    return_column<Int32Column>(c2);
+
+    auto c3 = get_column<Int32Column>();
+    ASSERT_EQ(c2, c3);
+    auto c4 = get_column<Int32Column, false>();
+    ASSERT_EQ(nullptr, c4);
+
+    return_column<Int32Column>(c3);
+}
+
 } // namespace starrocks::vectorized
@@ -247,6 +247,15 @@ TEST(DateValueTest, cast) {
     ASSERT_EQ("2004-03-31 00:00:00", v.to_string());
 }
 
+TEST(DateValueTest, to_string_buffer) {
+    DateValue dv;
+    dv.from_date(2004, 3, 1);
+    char s[DateValue::max_string_length()];
+    ASSERT_EQ(10, dv.to_string(s, sizeof(s)));
+    ASSERT_EQ("2004-03-01", std::string(s, 10));
+    ASSERT_EQ(-1, dv.to_string(s, sizeof(s) - 1));
+}
+
 TEST(DateValueTest, weekday) {
     DateValue dv;
     dv.from_date(2020, 5, 31);
@@ -0,0 +1,65 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/filter_kernels.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "util/cpu_dispatch.h"
+#include "util/cpu_info.h"
+
+namespace starrocks::vectorized {
+
+template <typename T, typename Kernel>
+static void check_filter_range(Kernel kernel) {
+    std::mt19937 rng(0);
+    for (int iter = 0; iter < 1000; ++iter) {
+        const size_t size = rng() % 300;
+        const size_t from = rng() % (size + 1);
+        // all filtered out, all selected, or a random density
+        const int density = rng() % 4;
+        std::vector<uint8_t> filter(size);
+        std::vector<T> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            filter[i] = density == 0 ? 0 : (density == 1 ? 1 : (rng() % density == 0 ? rng() % 255 + 1 : 0));
+            data[i] = static_cast<T>(rng());
+        }
+
+        std::vector<T> expected(data.begin(), data.begin() + from);
+        size_t num_zeros = 0;
+        for (size_t i = 0; i < size; ++i) {
+            num_zeros += (filter[i] == 0);
+            if (i >= from && filter[i]) {
+                expected.push_back(data[i]);
+            }
+        }
+        ASSERT_EQ(num_zeros, count_zero_bytes(filter.data(), size));
+        ASSERT_EQ(expected.size(), kernel(filter.data(), data.data(), from, size));
+        data.resize(expected.size());
+        ASSERT_EQ(expected, data);
+    }
+}
+
+static void check_all_kernels() {
+    check_filter_range<uint8_t>(filter_range_1byte);
+    check_filter_range<uint32_t>(filter_range_4bytes);
+    check_filter_range<uint64_t>(filter_range_8bytes);
+}
+
+// NOLINTNEXTLINE
+TEST(FilterKernelsTest, test_dispatched_kernels) {
+    CpuInfo::init();
+    CpuDispatch::init();
+    check_all_kernels();
+    {
+        CpuInfo::TempDisable disabler(CpuInfo::AVX512F);
+        CpuDispatch::init();
+        ASSERT_EQ(SimdLevel::BASELINE, CpuDispatch::level());
+        check_all_kernels();
+    }
+    CpuDispatch::init();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,134 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "env/block_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "env/env_memory.h"
+
+namespace starrocks {
+
+// A remote file that counts the bytes read from it.
+class CountingFile final : public RandomAccessFile {
+public:
+    explicit CountingFile(std::string content) : _file(std::move(content)), _name("hdfs://host/table/file") {}
+
+    Status read(uint64_t offset, Slice* res) const override {
+        _read_bytes += res->size;
+        return _file.read(offset, res);
+    }
+    Status read_at(uint64_t offset, const Slice& res) const override {
+        _read_bytes += res.size;
+        return _file.read_at(offset, res);
+    }
+    Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override {
+        return Status::NotSupported("");
+    }
+    Status size(uint64_t* size) const override { return _file.size(size); }
+    const std::string& file_name() const override { return _name; }
+
+    int64_t read_bytes() const { return _read_bytes; }
+
+private:
+    StringRandomAccessFile _file;
+    std::string _name;
+    mutable int64_t _read_bytes = 0;
+};
+
+class BlockCacheTest : public testing::Test {
+public:
+    void SetUp() override {
+        _dir = (std::filesystem::temp_directory_path() / "block_cache_test").string();
+        std::filesystem::remove_all(_dir);
+        for (int i = 0; i < 10000; ++i) {
+            _content.push_back('a' + i % 26);
+        }
+    }
+
+    void TearDown() override { std::filesystem::remove_all(_dir); }
+
+protected:
+    std::string read_range(const CachedRandomAccessFile& file, uint64_t offset, size_t size) {
+        std::string buf(size, '\0');
+        EXPECT_TRUE(file.read_at(offset, Slice(buf.data(), size)).ok());
+        return buf;
+    }
+
+    std::string _dir;
+    std::string _content;
+};
+
+// NOLINTNEXTLINE
+TEST_F(BlockCacheTest, ReadThroughCache) {
+    BlockCache cache(_dir, 1 << 20, 1024);
+    ASSERT_TRUE(cache.init().ok());
+    auto remote = std::make_shared<CountingFile>(_content);
+    CachedRandomAccessFile file(&cache, remote, 1, _content.size());
+
+    // the first miss only reads the requested bytes.
+    ASSERT_EQ(_content.substr(1000, 2000), read_range(file, 1000, 2000));
+    ASSERT_EQ(2000, remote->read_bytes());
+    ASSERT_EQ(0, cache.num_blocks());
+
+    // the blocks missed again are cached.
+    ASSERT_EQ(_content.substr(1000, 2000), read_range(file, 1000, 2000));
+    ASSERT_EQ(2000 + 3 * 1024, remote->read_bytes());
+    ASSERT_EQ(3, cache.num_blocks());
+
+    ASSERT_EQ(_content.substr(1500, 1000), read_range(file, 1500, 1000));
+    ASSERT_EQ(2000 + 3 * 1024, remote->read_bytes());
+    ASSERT_EQ(1000, file.cached_read_bytes());
+
+    // the last block is shorter.
+    ASSERT_EQ(_content.substr(9500), read_range(file, 9500, 500));
+    ASSERT_EQ(_content.substr(9500), read_range(file, 9500, 500));
+    ASSERT_EQ(_content.substr(9300), read_range(file, 9300, 700));
+    ASSERT_EQ(1700, file.cached_read_bytes());
+
+    Slice slice(new char[1000], 1000);
+    ASSERT_TRUE(file.read(9800, &slice).ok());
+    ASSERT_EQ(200, slice.size);
+    ASSERT_EQ(_content.substr(9800), slice.to_string());
+    delete[] slice.data;
+
+    // another version of the file doesn't hit the cached blocks.
+    CachedRandomAccessFile new_file(&cache, remote, 2, _content.size());
+    ASSERT_EQ(_content.substr(1500, 1000), read_range(new_file, 1500, 1000));
+    ASSERT_EQ(0, new_file.cached_read_bytes());
+}
+
+// NOLINTNEXTLINE
+TEST_F(BlockCacheTest, EvictionAndRestart) {
+    auto remote = std::make_shared<CountingFile>(_content);
+    {
+        BlockCache cache(_dir, 4 * 1200, 1024);
+        ASSERT_TRUE(cache.init().ok());
+        CachedRandomAccessFile file(&cache, remote, 1, _content.size());
+        for (uint64_t offset = 0; offset < _content.size(); offset += 1024) {
+            size_t size = std::min<size_t>(1024, _content.size() - offset);
+            ASSERT_EQ(_content.substr(offset, size), read_range(file, offset, size));
+            ASSERT_EQ(_content.substr(offset, size), read_range(file, offset, size));
+        }
+        // a block file has a header, so the cache holds 4 blocks at most.
+        ASSERT_EQ(4, cache.num_blocks());
+        ASSERT_LE(cache.usage(), 4 * 1200);
+    }
+
+    // the cached blocks survive restarts, and the invalid files are removed.
+    const std::string invalid_file = _dir + "/invalid";
+    std::ofstream(invalid_file) << "invalid block";
+    BlockCache cache(_dir, 4 * 1200, 1024);
+    ASSERT_TRUE(cache.init().ok());
+    ASSERT_EQ(4, cache.num_blocks());
+    ASSERT_FALSE(std::filesystem::exists(invalid_file));
+
+    // the last 4 blocks are cached.
+    CachedRandomAccessFile file(&cache, remote, 1, _content.size());
+    ASSERT_EQ(_content.substr(9000), read_range(file, 9000, 1000));
+    ASSERT_EQ(1000, file.cached_read_bytes());
+}
+
+} // namespace starrocks
@@ -22,7 +22,9 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <vector>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
 #include "util/file_utils.h"
@@ -132,6 +134,62 @@ TEST_F(EnvPosixTest, random_access) {
     }
 }
 
+TEST_F(EnvPosixTest, read_at_batch) {
+    std::string fname = "./ut_dir/env_posix/read_at_batch";
+    std::unique_ptr<WritableFile> wfile;
+    auto env = Env::Default();
+    ASSERT_TRUE(env->new_writable_file(fname, &wfile).ok());
+    std::string buf;
+    for (int i = 0; i < 1000; ++i) {
+        buf.push_back((char)(i % 128));
+    }
+    ASSERT_TRUE(wfile->append(buf).ok());
+    ASSERT_TRUE(wfile->close().ok());
+
+    std::unique_ptr<RandomAccessFile> rfile;
+    ASSERT_TRUE(env->new_random_access_file(fname, &rfile).ok());
+    bool enable_io_uring = config::enable_io_uring;
+    // io_uring falls back to preadv if the kernel doesn't support it, so the results are the same either way.
+    for (bool use_io_uring : {false, true}) {
+        config::enable_io_uring = use_io_uring;
+        // more requests than the depth of the ring.
+        char mem[100 * 10];
+        std::vector<RandomAccessFile::ReadRequest> requests;
+        for (int i = 0; i < 100; ++i) {
+            requests.push_back({static_cast<uint64_t>(i * 9), Slice(mem + i * 10, 10)});
+        }
+        ASSERT_TRUE(rfile->read_at_batch(requests.data(), requests.size()).ok());
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_EQ(buf.substr(i * 9, 10), requests[i].result.to_string());
+        }
+
+        // end of file
+        requests = {{0, Slice(mem, 10)}, {995, Slice(mem + 10, 10)}};
+        auto st = rfile->read_at_batch(requests.data(), requests.size());
+        ASSERT_EQ(TStatusCode::END_OF_FILE, st.code());
+    }
+    config::enable_io_uring = enable_io_uring;
+}
+
+TEST_F(EnvPosixTest, drop_cache_on_close) {
+    std::string fname = "./ut_dir/env_posix/drop_cache_on_close";
+    WritableFileOptions opts;
+    opts.drop_cache_on_close = true;
+    std::unique_ptr<WritableFile> wfile;
+    auto env = Env::Default();
+    ASSERT_TRUE(env->new_writable_file(opts, fname, &wfile).ok());
+    std::string buf(8192, 'x');
+    ASSERT_TRUE(wfile->append(buf).ok());
+    ASSERT_TRUE(wfile->close().ok());
+
+    // the data is written back before it's dropped.
+    std::unique_ptr<RandomAccessFile> rfile;
+    ASSERT_TRUE(env->new_random_access_file(fname, &rfile).ok());
+    std::string read_buf(buf.size(), '\0');
+    ASSERT_TRUE(rfile->read_at(0, Slice(read_buf.data(), read_buf.size())).ok());
+    ASSERT_EQ(buf, read_buf);
+}
+
 TEST_F(EnvPosixTest, random_rw) {
     std::string fname = "./ut_dir/env_posix/random_rw";
     WritableFileOptions ops;
@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "env/read_ahead_file.h"
+
+#include <gtest/gtest.h>
+
+#include "env/env_memory.h"
+
+namespace starrocks {
+
+class FailedSequentialFile final : public SequentialFile {
+public:
+    Status read(Slice* result) override { return Status::IOError("failed to read"); }
+    Status skip(uint64_t n) override { return Status::IOError("failed to skip"); }
+    const std::string& filename() const override { return _filename; }
+
+private:
+    std::string _filename = "failed";
+};
+
+static std::string read_all(SequentialFile* f, size_t read_size) {
+    std::string data;
+    std::string buff(read_size, '\0');
+    while (true) {
+        Slice s(buff);
+        EXPECT_TRUE(f->read(&s).ok());
+        if (s.size == 0) {
+            break;
+        }
+        data.append(s.data, s.size);
+    }
+    return data;
+}
+
+// NOLINTNEXTLINE
+TEST(ReadAheadSequentialFileTest, test_read) {
+    std::string content;
+    for (int i = 0; i < 10000; i++) {
+        content.append(std::to_string(i));
+    }
+    for (size_t buffer_size : {1, 7, 1024, 100000}) {
+        for (size_t read_size : {1, 13, 4096}) {
+            ReadAheadSequentialFile f(std::make_shared<StringSequentialFile>(content), buffer_size, 3);
+            ASSERT_EQ(content, read_all(&f, read_size));
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(ReadAheadSequentialFileTest, test_skip) {
+    std::string content = "0123456789abcdefghij";
+    ReadAheadSequentialFile f(std::make_shared<StringSequentialFile>(content), 3, 2);
+    ASSERT_TRUE(f.skip(5).ok());
+    ASSERT_EQ(content.substr(5), read_all(&f, 4));
+    ASSERT_TRUE(f.skip(5).ok());
+}
+
+// NOLINTNEXTLINE
+TEST(ReadAheadSequentialFileTest, test_error) {
+    ReadAheadSequentialFile f(std::make_shared<FailedSequentialFile>(), 16, 2);
+    std::string buff(16, '\0');
+    Slice s(buff);
+    ASSERT_TRUE(f.read(&s).is_io_error());
+}
+
+// NOLINTNEXTLINE
+TEST(ReadAheadSequentialFileTest, test_destroy_without_reading_all) {
+    std::string content(1 << 20, 'a');
+    ReadAheadSequentialFile f(std::make_shared<StringSequentialFile>(content), 1024, 2);
+    std::string buff(16, '\0');
+    Slice s(buff);
+    ASSERT_TRUE(f.read(&s).ok());
+    ASSERT_EQ(16, s.size);
+}
+
+} // namespace starrocks
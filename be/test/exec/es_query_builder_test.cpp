@@ -28,6 +28,8 @@
 
 #include "common/logging.h"
 #include "exec/es/es_predicate.h"
+#include "exec/es/es_scan_reader.h"
+#include "exec/es/es_scroll_query.h"
 #include "rapidjson/document.h"
 #include "rapidjson/rapidjson.h"
 #include "rapidjson/stringbuffer.h"
@@ -599,4 +601,22 @@ TEST_F(BooleanQueryBuilderTest, validate_compound_and) {
             "{\"fv\":[\"8.0\",\"16.0\"]}}]}}]}}]}},{\"wildcard\":{\"content\":\"a*e*g?\"}}]}}]}}";
     ASSERT_STREQ(expected_json.c_str(), actual_bool_json.c_str());
 }
+
+TEST_F(BooleanQueryBuilderTest, sliced_scroll_query) {
+    std::map<std::string, std::string> props;
+    props[ESScanReader::KEY_BATCH_SIZE] = "100";
+    props[ESScanReader::KEY_SLICE_ID] = "1";
+    props[ESScanReader::KEY_SLICE_MAX] = "4";
+    std::vector<std::string> fields = {"k"};
+    std::vector<EsPredicate*> predicates;
+    std::map<std::string, std::string> docvalue_context;
+    bool doc_value_mode = false;
+    std::string query = ESScrollQueryBuilder::build(props, fields, predicates, docvalue_context, &doc_value_mode);
+    ASSERT_NE(std::string::npos, query.find("\"slice\":{\"id\":1,\"max\":4}")) << query;
+
+    props.erase(ESScanReader::KEY_SLICE_ID);
+    props.erase(ESScanReader::KEY_SLICE_MAX);
+    query = ESScrollQueryBuilder::build(props, fields, predicates, docvalue_context, &doc_value_mode);
+    ASSERT_EQ(std::string::npos, query.find("slice")) << query;
+}
 } // namespace starrocks
@@ -0,0 +1,90 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/parquet/bloom_filter_reader.h"
+
+#include <gtest/gtest.h>
+
+#include "env/env_memory.h"
+#include "exec/vectorized/hdfs_scanner.h"
+#include "util/hash_util.hpp"
+#include "util/thrift_util.h"
+
+namespace starrocks::parquet {
+
+static const uint32_t kSalt[8] = {0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d,
+                                  0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31};
+
+// Insert the hash into the bitset as the parquet writers do.
+static void insert_hash(std::vector<uint32_t>* bitset, uint64_t hash) {
+    uint64_t num_blocks = bitset->size() / 8;
+    uint64_t block_index = ((hash >> 32) * num_blocks) >> 32;
+    auto key = static_cast<uint32_t>(hash);
+    for (int i = 0; i < 8; i++) {
+        (*bitset)[block_index * 8 + i] |= 1U << ((key * kSalt[i]) >> 27);
+    }
+}
+
+// Write a column chunk of the bloom filter of the even numbers in [0, 2 * num_values) at |offset|.
+static std::string make_file(size_t offset, uint32_t num_bytes, int32_t num_values) {
+    std::vector<uint32_t> bitset(num_bytes / sizeof(uint32_t), 0);
+    for (int32_t i = 0; i < num_values; i++) {
+        int32_t value = i * 2;
+        insert_hash(&bitset, HashUtil::xx_hash64(&value, sizeof(value), 0));
+    }
+
+    tparquet::BloomFilterHeader header;
+    header.numBytes = num_bytes;
+    header.algorithm.__set_BLOCK(tparquet::SplitBlockAlgorithm());
+    header.hash.__set_XXHASH(tparquet::XxHash());
+    header.compression.__set_UNCOMPRESSED(tparquet::Uncompressed());
+
+    ThriftSerializer ser(true, 100);
+    uint32_t len = 0;
+    uint8_t* header_ser = nullptr;
+    ser.serialize(&header, &len, &header_ser);
+
+    std::string content(offset, 0);
+    content.append(reinterpret_cast<char*>(header_ser), len);
+    content.append(reinterpret_cast<char*>(bitset.data()), num_bytes);
+    return content;
+}
+
+TEST(BloomFilterReaderTest, XxHash64) {
+    ASSERT_EQ(0xEF46DB3751D8E999ULL, HashUtil::xx_hash64("", 0, 0));
+    ASSERT_EQ(0x44BC2CF5AD770999ULL, HashUtil::xx_hash64("abc", 3, 0));
+    std::string str = "Nobody inspects the spammish repetition";
+    ASSERT_EQ(0xFBCEA83C8A378BF1ULL, HashUtil::xx_hash64(str.data(), str.size(), 0));
+}
+
+TEST(BloomFilterReaderTest, TestValues) {
+    // The bitset is read with the header, or by another read.
+    for (uint32_t num_bytes : {32 * 4, 32 * 1024}) {
+        int32_t num_values = num_bytes / 32;
+        StringRandomAccessFile file(make_file(100, num_bytes, num_values));
+        vectorized::HdfsScanStats stats;
+
+        tparquet::ColumnMetaData column_meta;
+        column_meta.__set_bloom_filter_offset(100);
+        BloomFilterReader reader;
+        ASSERT_TRUE(reader.init(&file, column_meta, &stats).ok());
+
+        int32_t num_false_positives = 0;
+        for (int32_t i = 0; i < num_values; i++) {
+            int32_t value = i * 2;
+            ASSERT_TRUE(reader.test_bytes(Slice(reinterpret_cast<char*>(&value), sizeof(value))));
+            value = i * 2 + 1;
+            num_false_positives += reader.test_bytes(Slice(reinterpret_cast<char*>(&value), sizeof(value)));
+        }
+        ASSERT_LE(num_false_positives, num_values / 10);
+    }
+}
+
+TEST(BloomFilterReaderTest, NoBloomFilter) {
+    StringRandomAccessFile file(make_file(0, 32, 1));
+    vectorized::HdfsScanStats stats;
+    tparquet::ColumnMetaData column_meta;
+    BloomFilterReader reader;
+    ASSERT_TRUE(reader.init(&file, column_meta, &stats).is_not_found());
+}
+
+} // namespace starrocks::parquet
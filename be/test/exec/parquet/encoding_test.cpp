@@ -331,4 +331,70 @@ TEST_F(ParquetEncodingTest, FixedString) {
     }
 }
 
+TEST_F(ParquetEncodingTest, Skip) {
+    // runs of 8 repeated values, which are encoded to repeated runs by the dict encoder
+    std::vector<int32_t> values;
+    for (int i = 0; i < 100; i++) {
+        values.push_back(i / 8);
+    }
+
+    const EncodingInfo* plain_encoding = nullptr;
+    EncodingInfo::get(tparquet::Type::INT32, tparquet::Encoding::PLAIN, &plain_encoding);
+    ASSERT_TRUE(plain_encoding != nullptr);
+    const EncodingInfo* dict_encoding = nullptr;
+    EncodingInfo::get(tparquet::Type::INT32, tparquet::Encoding::RLE_DICTIONARY, &dict_encoding);
+    ASSERT_TRUE(dict_encoding != nullptr);
+
+    auto check = [&values](Decoder* decoder, const Slice& encoded_data, bool is_dictionary) {
+        decoder->set_data(encoded_data);
+        auto column = starrocks::vectorized::FixedLengthColumn<int32_t>::create();
+        ASSERT_TRUE(decoder->skip(3).ok());
+        ASSERT_TRUE(decoder->next_batch(10, ColumnContentType::VALUE, column.get()).ok());
+        ASSERT_TRUE(decoder->skip(50).ok());
+        ASSERT_TRUE(decoder->next_batch(37, ColumnContentType::VALUE, column.get()).ok());
+        ASSERT_EQ(47, column->size());
+        for (int i = 0; i < 10; ++i) {
+            ASSERT_EQ(values[3 + i], column->get_data()[i]);
+        }
+        for (int i = 0; i < 37; ++i) {
+            ASSERT_EQ(values[63 + i], column->get_data()[10 + i]);
+        }
+        if (!is_dictionary) {
+            // out-of-bounds skip
+            ASSERT_FALSE(decoder->skip(1).ok());
+        }
+    };
+
+    // plain
+    {
+        std::unique_ptr<Decoder> decoder;
+        ASSERT_TRUE(plain_encoding->create_decoder(&decoder).ok());
+        std::unique_ptr<Encoder> encoder;
+        ASSERT_TRUE(plain_encoding->create_encoder(&encoder).ok());
+        ASSERT_TRUE(encoder->append(reinterpret_cast<uint8_t*>(&values[0]), values.size()).ok());
+
+        check(decoder.get(), encoder->build(), false);
+    }
+    // dict
+    {
+        std::unique_ptr<Decoder> decoder;
+        ASSERT_TRUE(dict_encoding->create_decoder(&decoder).ok());
+        std::unique_ptr<Encoder> encoder;
+        ASSERT_TRUE(dict_encoding->create_encoder(&encoder).ok());
+        ASSERT_TRUE(encoder->append(reinterpret_cast<uint8_t*>(&values[0]), values.size()).ok());
+
+        std::unique_ptr<Encoder> dict_encoder;
+        ASSERT_TRUE(plain_encoding->create_encoder(&dict_encoder).ok());
+        size_t num_dicts = 0;
+        ASSERT_TRUE(encoder->encode_dict(dict_encoder.get(), &num_dicts).ok());
+
+        std::unique_ptr<Decoder> dict_decoder;
+        ASSERT_TRUE(plain_encoding->create_decoder(&dict_decoder).ok());
+        dict_decoder->set_data(dict_encoder->build());
+        ASSERT_TRUE(decoder->set_dict(num_dicts, dict_decoder.get()).ok());
+
+        check(decoder.get(), encoder->build(), true);
+    }
+}
+
 } // namespace starrocks::parquet
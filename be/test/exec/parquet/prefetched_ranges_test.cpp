@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/parquet/prefetched_ranges.h"
+
+#include <gtest/gtest.h>
+
+#include "env/env_memory.h"
+#include "exec/vectorized/hdfs_scanner.h"
+
+namespace starrocks::parquet {
+
+static std::string make_content(size_t size) {
+    std::string content(size, 0);
+    for (size_t i = 0; i < size; i++) {
+        content[i] = static_cast<char>(i % 251);
+    }
+    return content;
+}
+
+TEST(PrefetchedRangesTest, MergeRangesInGap) {
+    std::string content = make_content(1000);
+    StringRandomAccessFile file(content);
+    vectorized::HdfsScanStats stats;
+
+    PrefetchedRanges prefetched;
+    // [100, 200) and [210, 300) are merged, [600, 700) is read alone.
+    ASSERT_TRUE(prefetched.prefetch(&file, {{600, 100}, {210, 90}, {100, 100}}, 10, 1000, &stats).ok());
+    ASSERT_EQ(2, stats.io_count);
+    ASSERT_EQ(300, stats.bytes_read_from_disk);
+
+    uint8_t data[100];
+    ASSERT_TRUE(prefetched.read(150, 100, data));
+    ASSERT_EQ(0, memcmp(data, content.data() + 150, 100));
+    ASSERT_TRUE(prefetched.read(600, 100, data));
+    ASSERT_EQ(0, memcmp(data, content.data() + 600, 100));
+
+    // Not prefetched, or not all prefetched.
+    ASSERT_FALSE(prefetched.read(0, 10, data));
+    ASSERT_FALSE(prefetched.read(250, 100, data));
+    ASSERT_FALSE(prefetched.read(650, 100, data));
+}
+
+TEST(PrefetchedRangesTest, MaxBufferBytes) {
+    std::string content = make_content(1000);
+    StringRandomAccessFile file(content);
+    vectorized::HdfsScanStats stats;
+
+    PrefetchedRanges prefetched;
+    ASSERT_TRUE(prefetched.prefetch(&file, {{0, 300}, {400, 500}, {950, 50}}, 0, 400, &stats).ok());
+    ASSERT_EQ(2, stats.io_count);
+    ASSERT_EQ(350, stats.bytes_read_from_disk);
+
+    uint8_t data[100];
+    ASSERT_TRUE(prefetched.read(200, 100, data));
+    ASSERT_FALSE(prefetched.read(400, 100, data));
+    ASSERT_TRUE(prefetched.read(950, 50, data));
+    ASSERT_EQ(0, memcmp(data, content.data() + 950, 50));
+}
+
+} // namespace starrocks::parquet
@@ -0,0 +1,75 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/aggregate/aggregate_blocking_context.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "column/chunk.h"
+
+namespace starrocks::pipeline {
+
+TEST(AggregateBlockingContextTest, test_no_sinkers) {
+    AggregateBlockingContext context;
+    context.set_num_partitions(2);
+    ASSERT_TRUE(context.is_sink_complete());
+    ASSERT_TRUE(context.partition(0).empty());
+    ASSERT_TRUE(context.partition(1).empty());
+}
+
+TEST(AggregateBlockingContextTest, test_finish_sinkers) {
+    AggregateBlockingContext context;
+    context.set_num_sinkers(2);
+    context.set_num_partitions(2);
+    int num_notified = 0;
+    context.add_observer([&num_notified]() { ++num_notified; });
+
+    std::vector<AggregateBlockingContext::Partition> partitions(2);
+    partitions[0].emplace_back(std::make_shared<vectorized::Chunk>());
+    partitions[1].emplace_back(std::make_shared<vectorized::Chunk>());
+    context.finish_sinker(std::move(partitions));
+    ASSERT_FALSE(context.is_sink_complete());
+    ASSERT_EQ(0, num_notified);
+
+    partitions.assign(2, {});
+    partitions[1].emplace_back(std::make_shared<vectorized::Chunk>());
+    context.finish_sinker(std::move(partitions));
+    ASSERT_TRUE(context.is_sink_complete());
+    ASSERT_EQ(1, num_notified);
+
+    ASSERT_EQ(1, context.partition(0).size());
+    ASSERT_EQ(2, context.partition(1).size());
+}
+
+TEST(AggregateBlockingContextTest, test_concurrent_finish_sinkers) {
+    const size_t num_sinkers = 8;
+    const size_t num_partitions = 4;
+    AggregateBlockingContext context;
+    context.set_num_sinkers(num_sinkers);
+    context.set_num_partitions(num_partitions);
+    std::atomic<int> num_notified{0};
+    context.add_observer([&num_notified]() { ++num_notified; });
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < num_sinkers; ++i) {
+        threads.emplace_back([&context]() {
+            std::vector<AggregateBlockingContext::Partition> partitions(num_partitions);
+            for (auto& partition : partitions) {
+                partition.emplace_back(std::make_shared<vectorized::Chunk>());
+            }
+            context.finish_sinker(std::move(partitions));
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_TRUE(context.is_sink_complete());
+    ASSERT_EQ(1, num_notified);
+    for (size_t i = 0; i < num_partitions; ++i) {
+        ASSERT_EQ(num_sinkers, context.partition(i).size());
+    }
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,53 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/exchange/local_exchange_memory_manager.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks::pipeline {
+
+TEST(LocalExchangeMemoryManagerTest, test_per_consumer_budget) {
+    LocalExchangeMemoryManager memory_manager(300);
+    ASSERT_EQ(0, memory_manager.add_consumer());
+    ASSERT_EQ(1, memory_manager.add_consumer());
+    ASSERT_EQ(2, memory_manager.add_consumer());
+    ASSERT_EQ(3, memory_manager.num_consumers());
+
+    // each consumer has a budget of 100 bytes.
+    memory_manager.update_memory_usage(0, 99);
+    ASSERT_FALSE(memory_manager.is_full(0));
+    ASSERT_FALSE(memory_manager.is_any_full());
+
+    memory_manager.update_memory_usage(0, 1);
+    ASSERT_TRUE(memory_manager.is_full(0));
+    ASSERT_FALSE(memory_manager.is_full(1));
+    ASSERT_TRUE(memory_manager.is_any_full());
+    ASSERT_FALSE(memory_manager.is_all_full());
+
+    memory_manager.update_memory_usage(1, 200);
+    memory_manager.update_memory_usage(2, 100);
+    ASSERT_TRUE(memory_manager.is_all_full());
+    ASSERT_EQ(200, memory_manager.memory_usage(1));
+}
+
+TEST(LocalExchangeMemoryManagerTest, test_notify_not_full) {
+    LocalExchangeMemoryManager memory_manager(200);
+    memory_manager.add_consumer();
+    memory_manager.add_consumer();
+    int num_notified = 0;
+    memory_manager.add_observer([&num_notified]() { ++num_notified; });
+
+    memory_manager.update_memory_usage(0, 150);
+    memory_manager.update_memory_usage(1, 50);
+    ASSERT_EQ(0, num_notified);
+
+    // consumer 0 is still full.
+    memory_manager.update_memory_usage(0, -40);
+    ASSERT_EQ(0, num_notified);
+
+    memory_manager.update_memory_usage(0, -20);
+    ASSERT_EQ(1, num_notified);
+    ASSERT_FALSE(memory_manager.is_any_full());
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,74 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/morsel.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks::pipeline {
+
+// The plan node id of each morsel is used as its identity.
+static Morsels create_morsels(int32_t begin_id, int32_t end_id) {
+    Morsels morsels;
+    for (int32_t id = begin_id; id < end_id; ++id) {
+        morsels.emplace_back(std::make_unique<Morsel>(id));
+    }
+    return morsels;
+}
+
+static int32_t get_morsel_id(MorselQueue* queue, int32_t driver_sequence) {
+    auto maybe_morsel = queue->try_get(driver_sequence);
+    if (!maybe_morsel.has_value()) {
+        return -1;
+    }
+    return maybe_morsel.value()->get_plan_node_id();
+}
+
+TEST(MorselQueueTest, test_ungrouped_morsels) {
+    MorselQueue queue(create_morsels(0, 3));
+    ASSERT_EQ(3, queue.num_morsels());
+    ASSERT_EQ(0, get_morsel_id(&queue, 0));
+    ASSERT_EQ(1, get_morsel_id(&queue, 1));
+    ASSERT_EQ(2, get_morsel_id(&queue, 0));
+    ASSERT_EQ(-1, get_morsel_id(&queue, 1));
+    ASSERT_EQ(-1, get_morsel_id(&queue, 0));
+}
+
+TEST(MorselQueueTest, test_owned_group) {
+    std::vector<Morsels> groups;
+    groups.emplace_back(create_morsels(0, 3));
+    groups.emplace_back(create_morsels(10, 12));
+    MorselQueue queue(std::move(groups));
+    ASSERT_EQ(5, queue.num_morsels());
+
+    // each driver keeps taking the morsels from the front of its own group.
+    ASSERT_EQ(0, get_morsel_id(&queue, 0));
+    ASSERT_EQ(10, get_morsel_id(&queue, 1));
+    ASSERT_EQ(1, get_morsel_id(&queue, 0));
+    ASSERT_EQ(11, get_morsel_id(&queue, 1));
+    ASSERT_EQ(2, get_morsel_id(&queue, 0));
+}
+
+TEST(MorselQueueTest, test_steal_tail) {
+    std::vector<Morsels> groups;
+    groups.emplace_back(create_morsels(0, 8));
+    groups.emplace_back(create_morsels(10, 11));
+    MorselQueue queue(std::move(groups));
+
+    ASSERT_EQ(0, get_morsel_id(&queue, 0));
+    ASSERT_EQ(10, get_morsel_id(&queue, 1));
+    // driver 1 is idle, so it steals the back half of the remaining 7 morsels of driver 0.
+    ASSERT_EQ(4, get_morsel_id(&queue, 1));
+    ASSERT_EQ(1, get_morsel_id(&queue, 0));
+    // driver 2 steals from the largest one, i.e. the remaining [5, 8) of driver 1.
+    ASSERT_EQ(6, get_morsel_id(&queue, 2));
+    ASSERT_EQ(5, get_morsel_id(&queue, 1));
+    ASSERT_EQ(7, get_morsel_id(&queue, 2));
+    // driver 1 steals the back half of the remaining [2, 4) of driver 0.
+    ASSERT_EQ(3, get_morsel_id(&queue, 1));
+    ASSERT_EQ(2, get_morsel_id(&queue, 0));
+    ASSERT_EQ(-1, get_morsel_id(&queue, 2));
+    ASSERT_EQ(-1, get_morsel_id(&queue, 0));
+    ASSERT_EQ(-1, get_morsel_id(&queue, 1));
+}
+
+} // namespace starrocks::pipeline
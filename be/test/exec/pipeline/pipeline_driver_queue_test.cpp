@@ -0,0 +1,186 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/pipeline_driver_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <thread>
+
+#include "column/chunk.h"
+
+namespace starrocks::pipeline {
+
+class DummySourceOperator final : public SourceOperator {
+public:
+    DummySourceOperator() : SourceOperator(0, "dummy_source", 0) {}
+    ~DummySourceOperator() override = default;
+
+    bool has_output() override { return false; }
+    bool is_finished() const override { return true; }
+    void finish(RuntimeState* state) override {}
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override { return nullptr; }
+};
+
+static DriverPtr create_driver(int32_t driver_id) {
+    Operators operators{std::make_shared<DummySourceOperator>()};
+    return std::make_shared<PipelineDriver>(operators, nullptr, nullptr, driver_id, false);
+}
+
+TEST(WorkStealingDriverQueueTest, test_local_take) {
+    WorkStealingDriverQueue queue(4);
+    auto driver0 = create_driver(0);
+    auto driver1 = create_driver(1);
+    queue.put_back_from_worker(driver0, 1);
+    queue.put_back_from_worker(driver1, 1);
+
+    size_t queue_index = 0;
+    ASSERT_EQ(driver0, queue.take_for_worker(1, &queue_index));
+    ASSERT_EQ(0, queue_index);
+    ASSERT_EQ(driver1, queue.take_for_worker(1, &queue_index));
+}
+
+TEST(WorkStealingDriverQueueTest, test_steal) {
+    WorkStealingDriverQueue queue(4);
+    auto driver = create_driver(0);
+    queue.put_back_from_worker(driver, 0);
+
+    size_t queue_index = 0;
+    ASSERT_EQ(driver, queue.take_for_worker(3, &queue_index));
+}
+
+TEST(WorkStealingDriverQueueTest, test_priority) {
+    WorkStealingDriverQueue queue(2);
+    auto low_level_driver = create_driver(0);
+    auto high_level_driver = create_driver(1);
+    for (int i = 0; i < 3; ++i) {
+        high_level_driver->driver_acct().increment_schedule_times();
+    }
+    queue.put_back_from_worker(high_level_driver, 0);
+    queue.put_back_from_worker(low_level_driver, 0);
+
+    // level 0 has more accumulated time than level 2 after normalization.
+    high_level_driver->driver_acct().update_last_time_spent(1);
+    low_level_driver->driver_acct().update_last_time_spent(1000000);
+    queue.get_sub_queue(0)->update_accu_time(low_level_driver);
+    queue.get_sub_queue(2)->update_accu_time(high_level_driver);
+
+    size_t queue_index = 0;
+    ASSERT_EQ(high_level_driver, queue.take_for_worker(0, &queue_index));
+    ASSERT_EQ(2, queue_index);
+    ASSERT_EQ(low_level_driver, queue.take_for_worker(0, &queue_index));
+    ASSERT_EQ(0, queue_index);
+}
+
+TEST(WorkStealingDriverQueueTest, test_concurrent_take) {
+    const int num_workers = 4;
+    const int num_drivers = 1000;
+    WorkStealingDriverQueue queue(num_workers);
+
+    std::vector<std::set<int32_t>> taken(num_workers);
+    std::vector<std::thread> workers;
+    for (int w = 0; w < num_workers; ++w) {
+        workers.emplace_back([&queue, &taken, w]() {
+            for (int i = 0; i < num_drivers / num_workers; ++i) {
+                size_t queue_index = 0;
+                auto driver = queue.take_for_worker(w, &queue_index);
+                taken[w].insert(driver->driver_id());
+            }
+        });
+    }
+    // all the drivers are put back by a non-worker thread.
+    for (int i = 0; i < num_drivers; ++i) {
+        queue.put_back(create_driver(i));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::set<int32_t> all_taken;
+    for (auto& ids : taken) {
+        all_taken.insert(ids.begin(), ids.end());
+    }
+    ASSERT_EQ(num_drivers, all_taken.size());
+}
+
+TEST(ResourceGroupDriverQueueTest, test_parse) {
+    auto groups = ResourceGroupManager::parse("adhoc:2:4; dashboard : 8 : 0;invalid;adhoc:1:1;neg:-1:0;default:3:0");
+    ASSERT_EQ(3, groups.size());
+    ASSERT_EQ("default", groups[0]->name());
+    ASSERT_EQ(3, groups[0]->cpu_weight());
+    ASSERT_EQ("adhoc", groups[1]->name());
+    ASSERT_EQ(1, groups[1]->id());
+    ASSERT_EQ(2, groups[1]->cpu_weight());
+    ASSERT_EQ(4, groups[1]->concurrency_limit());
+    ASSERT_EQ("dashboard", groups[2]->name());
+    ASSERT_EQ(8, groups[2]->cpu_weight());
+    ASSERT_EQ(0, groups[2]->concurrency_limit());
+
+    groups = ResourceGroupManager::parse("");
+    ASSERT_EQ(1, groups.size());
+    ASSERT_EQ(1, groups[0]->cpu_weight());
+    ASSERT_EQ(0, groups[0]->concurrency_limit());
+}
+
+static DriverPtr create_driver(int32_t driver_id, QueryContext* query_ctx) {
+    Operators operators{std::make_shared<DummySourceOperator>()};
+    return std::make_shared<PipelineDriver>(operators, query_ctx, nullptr, driver_id, false);
+}
+
+TEST(ResourceGroupDriverQueueTest, test_concurrency_limit) {
+    ResourceGroup default_group(0, "default", 1, 0);
+    ResourceGroup limited_group(1, "limited", 1, 1);
+    ResourceGroupDriverQueue queue({&default_group, &limited_group});
+    QueryContext limited_query;
+    limited_query.set_resource_group(&limited_group);
+
+    auto limited_driver0 = create_driver(0, &limited_query);
+    auto limited_driver1 = create_driver(1, &limited_query);
+    auto default_driver = create_driver(2);
+    queue.put_back(limited_driver0);
+    queue.put_back(limited_driver1);
+    queue.put_back(default_driver);
+
+    size_t limited_index = 0;
+    size_t queue_index = 0;
+    ASSERT_EQ(limited_driver0, queue.take(&limited_index));
+    ASSERT_EQ(1, queue.num_running_drivers(1));
+    // limited_driver1 can't run until limited_driver0 is released.
+    ASSERT_EQ(default_driver, queue.take(&queue_index));
+    ASSERT_EQ(0, queue_index / ResourceGroupDriverQueue::QUEUE_SIZE);
+    queue.release(default_driver, queue_index, true);
+
+    queue.release(limited_driver0, limited_index, true);
+    ASSERT_EQ(0, queue.num_running_drivers(1));
+    ASSERT_EQ(limited_driver1, queue.take(&queue_index));
+    ASSERT_EQ(1, queue_index / ResourceGroupDriverQueue::QUEUE_SIZE);
+}
+
+TEST(ResourceGroupDriverQueueTest, test_cpu_weight) {
+    ResourceGroup default_group(0, "default", 1, 0);
+    ResourceGroup heavy_group(1, "heavy", 4, 0);
+    ResourceGroupDriverQueue queue({&default_group, &heavy_group});
+    QueryContext heavy_query;
+    heavy_query.set_resource_group(&heavy_group);
+
+    auto default_driver = create_driver(0);
+    auto heavy_driver = create_driver(1, &heavy_query);
+    size_t queue_index = 0;
+    // both of the groups spend the same cpu time.
+    for (const auto& driver : {default_driver, heavy_driver}) {
+        queue.put_back(driver);
+        ASSERT_EQ(driver, queue.take(&queue_index));
+        driver->driver_acct().update_last_time_spent(1000000);
+        queue.release(driver, queue_index, true);
+    }
+    ASSERT_EQ(1000000, default_group.cpu_time_ns());
+    ASSERT_EQ(1000000, heavy_group.cpu_time_ns());
+
+    // the heavy group has less cpu time normalized by its weight.
+    queue.put_back(default_driver);
+    queue.put_back(heavy_driver);
+    ASSERT_EQ(heavy_driver, queue.take(&queue_index));
+    ASSERT_EQ(default_driver, queue.take(&queue_index));
+}
+
+} // namespace starrocks::pipeline
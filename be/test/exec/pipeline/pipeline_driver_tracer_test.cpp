@@ -0,0 +1,78 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/pipeline_driver_tracer.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "column/chunk.h"
+#include "rapidjson/document.h"
+#include "util/uid_util.h"
+
+namespace starrocks::pipeline {
+
+class TracedSourceOperator final : public SourceOperator {
+public:
+    TracedSourceOperator() : SourceOperator(0, "traced_source", 5) {}
+    ~TracedSourceOperator() override = default;
+
+    bool has_output() override { return false; }
+    bool is_finished() const override { return true; }
+    void finish(RuntimeState* state) override {}
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override { return nullptr; }
+};
+
+TEST(DriverTracerTest, test_chrome_trace) {
+    TUniqueId query_id;
+    query_id.__set_hi(100);
+    query_id.__set_lo(200);
+    FragmentContext fragment_ctx;
+    fragment_ctx.set_query_id(query_id);
+    fragment_ctx.set_fragment_instance_id(query_id);
+    fragment_ctx.set_enable_trace(true);
+    FragmentContext untraced_fragment_ctx;
+    untraced_fragment_ctx.set_query_id(query_id);
+
+    Operators operators{std::make_shared<TracedSourceOperator>()};
+    PipelineDriver driver(operators, nullptr, &fragment_ctx, 1, false);
+    PipelineDriver untraced_driver(operators, nullptr, &untraced_fragment_ctx, 2, false);
+
+    auto* tracer = DriverTracer::instance();
+    tracer->record(&driver, DriverState::READY);
+    tracer->record(&untraced_driver, DriverState::READY);
+    std::thread worker([&] {
+        tracer->record(&driver, DriverState::RUNNING);
+        tracer->record(&driver, DriverState::INPUT_EMPTY);
+    });
+    worker.join();
+    tracer->record(&driver, DriverState::FINISH);
+
+    rapidjson::Document trace;
+    trace.Parse(tracer->chrome_trace(print_id(query_id)).c_str());
+    ASSERT_FALSE(trace.HasParseError());
+    const auto& events = trace["traceEvents"];
+    std::vector<std::string> driver_states;
+    int num_worker_spans = 0;
+    for (const auto& event : events.GetArray()) {
+        if (std::string(event["ph"].GetString()) != "X") {
+            continue;
+        }
+        if (event["pid"].GetInt64() == 0) {
+            num_worker_spans++;
+            ASSERT_EQ(0, std::string(event["name"].GetString()).find("driver_1_node_5"));
+        } else {
+            driver_states.emplace_back(event["name"].GetString());
+        }
+    }
+    // the untraced driver isn't recorded
+    std::vector<std::string> expected_states{"READY", "RUNNING", "INPUT_EMPTY", "FINISH"};
+    ASSERT_EQ(expected_states, driver_states);
+    ASSERT_EQ(1, num_worker_spans);
+
+    TUniqueId other_query_id;
+    trace.Parse(tracer->chrome_trace(print_id(other_query_id)).c_str());
+    ASSERT_EQ(1, trace["traceEvents"].Size());
+}
+
+} // namespace starrocks::pipeline
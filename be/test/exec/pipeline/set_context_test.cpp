@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include "exec/pipeline/set/except_context.h"
+#include "exec/pipeline/set/intersect_context.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks::pipeline {
+
+TEST(SetContextTest, test_intersect_stages) {
+    MemTracker mem_tracker;
+    IntersectContext context(2, 3);
+    ASSERT_EQ(2, context.num_partitions());
+    ASSERT_EQ(3, context.num_children());
+    int num_notified = 0;
+    context.add_observer([&num_notified]() { ++num_notified; });
+    context.prepare_partition(0, &mem_tracker);
+    context.prepare_partition(1, &mem_tracker);
+
+    // only the build stage is ready at first.
+    ASSERT_TRUE(context.is_stage_ready(0, 0));
+    ASSERT_FALSE(context.is_stage_ready(0, 1));
+
+    // the stages of a partition don't wait for the other partitions.
+    context.finish_stage(0, Status::OK());
+    ASSERT_EQ(1, num_notified);
+    ASSERT_TRUE(context.is_stage_ready(0, 1));
+    ASSERT_FALSE(context.is_stage_ready(0, 2));
+    ASSERT_FALSE(context.is_stage_ready(1, 1));
+
+    // the first error is kept for the later stages.
+    context.finish_stage(0, Status::Cancelled("probe"));
+    context.finish_stage(0, Status::OK());
+    ASSERT_EQ(3, num_notified);
+    ASSERT_TRUE(context.is_stage_ready(0, 3));
+    ASSERT_TRUE(context.status(0).is_cancelled());
+
+    // nothing is output by an empty build.
+    for (int stage = 0; stage < 3; ++stage) {
+        context.finish_stage(1, Status::OK());
+    }
+    ASSERT_TRUE(context.is_stage_ready(1, 3));
+    ASSERT_TRUE(context.status(1).ok());
+    ASSERT_FALSE(context.has_more_output(1));
+
+    // the partition is released after the operators of all the stages are closed.
+    for (int stage = 0; stage <= 3; ++stage) {
+        context.unref(1);
+    }
+    ASSERT_EQ(0, mem_tracker.consumption());
+}
+
+TEST(SetContextTest, test_except_stages) {
+    MemTracker mem_tracker;
+    ExceptContext context(1, 2);
+    int num_notified = 0;
+    context.add_observer([&num_notified]() { ++num_notified; });
+    context.prepare_partition(0, &mem_tracker);
+
+    ASSERT_FALSE(context.is_stage_ready(0, 1));
+    context.finish_stage(0, Status::OK());
+    ASSERT_TRUE(context.is_stage_ready(0, 1));
+    ASSERT_FALSE(context.is_stage_ready(0, 2));
+    context.finish_stage(0, Status::OK());
+    ASSERT_EQ(2, num_notified);
+    ASSERT_TRUE(context.is_stage_ready(0, 2));
+    ASSERT_FALSE(context.has_more_output(0));
+
+    for (int stage = 0; stage <= 2; ++stage) {
+        context.unref(0);
+    }
+    ASSERT_FALSE(context.has_more_output(0));
+}
+
+} // namespace starrocks::pipeline
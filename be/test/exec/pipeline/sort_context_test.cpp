@@ -0,0 +1,66 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/sort/sort_context.h"
+
+#include <gtest/gtest.h>
+
+#include "exec/vectorized/chunks_sorter_full_sort.h"
+
+namespace starrocks::pipeline {
+
+class SortContextTest : public ::testing::Test {
+protected:
+    std::shared_ptr<vectorized::ChunksSorter> _create_sorter() {
+        return std::make_shared<vectorized::ChunksSorterFullSort>(&_sort_exprs, &_is_asc, &_is_null_first);
+    }
+
+    std::vector<ExprContext*> _sort_exprs;
+    std::vector<bool> _is_asc;
+    std::vector<bool> _is_null_first;
+};
+
+TEST_F(SortContextTest, test_no_sinkers) {
+    SortContext context;
+    ASSERT_TRUE(context.is_partition_sort_finished());
+    ASSERT_TRUE(context.chunks_sorters().empty());
+    ASSERT_TRUE(context.status().ok());
+}
+
+TEST_F(SortContextTest, test_finish_partitions) {
+    SortContext context;
+    context.set_num_sinkers(2);
+    context.set_num_sources(1);
+    int num_notified = 0;
+    context.add_observer([&num_notified]() { ++num_notified; });
+
+    // the sorters are indexed by the sequences of the sink drivers.
+    auto sorter1 = _create_sorter();
+    context.add_partition_chunks_sorter(1, sorter1);
+    context.add_partition_chunks_sorter(0, _create_sorter());
+    ASSERT_EQ(2, context.chunks_sorters().size());
+    ASSERT_EQ(sorter1, context.chunks_sorters()[1]);
+
+    context.finish_partition(Status::OK());
+    ASSERT_FALSE(context.is_partition_sort_finished());
+    ASSERT_EQ(0, num_notified);
+
+    context.finish_partition(Status::MemoryLimitExceeded("sort"));
+    ASSERT_TRUE(context.is_partition_sort_finished());
+    ASSERT_EQ(1, num_notified);
+    ASSERT_TRUE(context.status().is_mem_limit_exceeded());
+
+    // the sorters are released after all the sinkers and sources are closed.
+    context.unref();
+    context.unref();
+    ASSERT_EQ(2, context.chunks_sorters().size());
+    context.unref();
+    ASSERT_TRUE(context.chunks_sorters().empty());
+}
+
+TEST_F(SortContextTest, test_num_input_rows) {
+    SortContext context;
+    ASSERT_EQ(10, context.add_num_input_rows(10));
+    ASSERT_EQ(25, context.add_num_input_rows(15));
+}
+
+} // namespace starrocks::pipeline
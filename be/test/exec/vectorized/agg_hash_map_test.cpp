@@ -5,8 +5,12 @@
 #include <gtest/gtest.h>
 
 #include <any>
+#include <set>
+#include <tuple>
 #include <variant>
 
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
 #include "exec/vectorized/aggregate/agg_hash_set.h"
 
 namespace starrocks {
@@ -203,5 +207,100 @@ TEST(HashMapTest, TwoLevelConvert) {
     }
 }
 
+TEST(HashMapTest, FixedSizeKey) {
+    // nullable int32 key and int16 key, the values under nulls differ.
+    auto int32_column = Int32Column::create();
+    auto null_column = NullColumn::create();
+    auto int16_column = Int16Column::create();
+    std::vector<std::tuple<int32_t, uint8_t, int16_t>> rows = {{1, 0, 1}, {1, 0, 1}, {5, 1, 1}, {7, 1, 1}, {2, 0, 3}};
+    for (const auto& [value, is_null, value2] : rows) {
+        int32_column->append(value);
+        null_column->append(is_null);
+        int16_column->append(value2);
+    }
+    Columns key_columns{NullableColumn::create(int32_column, null_column), int16_column};
+
+    AggHashMapWithSerializedKeyFixedSize<FixedSizeKeyAggHashMap<uint64_t, PhmapSeed1>> hash_map;
+    ASSERT_TRUE(hash_map.layout.init({TYPE_INT, TYPE_SMALLINT}, {true, false}));
+    // 1 byte of the null bits, 4 bytes of int32 and 2 bytes of int16.
+    ASSERT_EQ(7, hash_map.layout.size);
+
+    std::vector<int64_t> states(rows.size());
+    size_t num_states = 0;
+    Buffer<AggDataPtr> agg_states(rows.size());
+    hash_map.compute_agg_states(
+            rows.size(), key_columns, nullptr, [&]() { return (AggDataPtr)&states[num_states++]; }, &agg_states);
+    ASSERT_EQ(3, hash_map.hash_map.size());
+    ASSERT_EQ(agg_states[0], agg_states[1]);
+    ASSERT_EQ(agg_states[2], agg_states[3]);
+    ASSERT_NE(agg_states[0], agg_states[2]);
+    ASSERT_NE(agg_states[0], agg_states[4]);
+
+    hash_map.results.clear();
+    for (const auto& kv : hash_map.hash_map) {
+        hash_map.results.emplace_back(kv.first);
+    }
+    Columns result_columns{NullableColumn::create(Int32Column::create(), NullColumn::create()), Int16Column::create()};
+    hash_map.insert_keys_to_columns(hash_map.results, result_columns, hash_map.results.size());
+    ASSERT_EQ(3, result_columns[0]->size());
+    ASSERT_EQ(3, result_columns[1]->size());
+    std::set<std::string> groups;
+    for (size_t i = 0; i < 3; ++i) {
+        groups.insert(result_columns[0]->debug_item(i) + "," + result_columns[1]->debug_item(i));
+    }
+    ASSERT_EQ((std::set<std::string>{"1,1", "NULL,1", "2,3"}), groups);
+
+    // float keys and too wide keys are not packed.
+    FixedSizeKeyLayout layout;
+    ASSERT_FALSE(layout.init({TYPE_INT, TYPE_DOUBLE}, {false, false}));
+    ASSERT_FALSE(layout.init({TYPE_BIGINT, TYPE_BIGINT}, {true, false}));
+    ASSERT_TRUE(layout.init({TYPE_BIGINT, TYPE_BIGINT}, {false, false}));
+}
+
+TEST(HashMapTest, SmallIntKey) {
+    auto key_column = Int8Column::create();
+    std::vector<int8_t> keys = {-1, 3, -1, 127, -128, 3};
+    for (int8_t key : keys) {
+        key_column->append(key);
+    }
+    Columns key_columns{key_column};
+
+    AggHashMapWithOneNumberKey<int8_t, Int8AggHashMap<PhmapSeed1>> hash_map;
+    ASSERT_EQ(hash_map.hash_map.begin(), hash_map.hash_map.end());
+    ASSERT_EQ(0, hash_map.hash_map.capacity());
+
+    std::vector<int64_t> states(keys.size());
+    size_t num_states = 0;
+    Buffer<AggDataPtr> agg_states(keys.size());
+    hash_map.compute_agg_states(
+            keys.size(), key_columns, nullptr, [&]() { return (AggDataPtr)&states[num_states++]; }, &agg_states);
+    ASSERT_EQ(4, num_states);
+    ASSERT_EQ(4, hash_map.hash_map.size());
+    ASSERT_EQ(256, hash_map.hash_map.capacity());
+    ASSERT_EQ(agg_states[0], agg_states[2]);
+    ASSERT_EQ(agg_states[1], agg_states[5]);
+    ASSERT_NE(agg_states[0], agg_states[1]);
+
+    // iterated by the unsigned bits of the keys.
+    std::vector<int8_t> iterated;
+    for (auto it = hash_map.hash_map.begin(); it != hash_map.hash_map.end(); ++it) {
+        iterated.push_back(it->first);
+        ASSERT_EQ(it->second, hash_map.hash_map.find(it->first)->second);
+    }
+    ASSERT_EQ((std::vector<int8_t>{3, 127, -128, -1}), iterated);
+
+    // the keys not found are not inserted.
+    auto probe_column = Int8Column::create();
+    probe_column->append(3);
+    probe_column->append(4);
+    Columns probe_columns{probe_column};
+    std::vector<uint8_t> not_founds;
+    hash_map.compute_agg_states(
+            2, probe_columns, [&]() { return (AggDataPtr)&states[num_states++]; }, &agg_states, &not_founds);
+    ASSERT_EQ((std::vector<uint8_t>{0, 1}), not_founds);
+    ASSERT_EQ(agg_states[1], agg_states[0]);
+    ASSERT_EQ(4, hash_map.hash_map.size());
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -174,6 +174,36 @@ TEST_F(ArrowConverterTest, test_nullable_assignable_converter_uint16) {
                                                                                         counter);
 }
 
+TEST_F(ArrowConverterTest, test_fill_null_column_and_filter_of_sliced_array) {
+    arrow::Int32Builder builder;
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3 == 0) {
+            ASSERT_TRUE(builder.AppendNull().ok());
+        } else {
+            ASSERT_TRUE(builder.Append(i).ok());
+        }
+    }
+    std::shared_ptr<arrow::Array> array;
+    ASSERT_TRUE(builder.Finish(&array).ok());
+    // the bits start in the middle of a byte of the bitmap
+    auto sliced = array->Slice(5, 90);
+
+    auto null_column = NullColumn::create();
+    null_column->append(DATUM_NOT_NULL);
+    size_t null_count = fill_null_column(sliced.get(), 3, 80, null_column.get(), 1);
+    ASSERT_EQ(81, null_column->size());
+    Column::Filter filter(81, 1);
+    fill_filter(sliced.get(), 3, 80, &filter, 1);
+    size_t expected_null_count = 0;
+    for (int i = 0; i < 80; ++i) {
+        bool is_null = sliced->IsNull(3 + i);
+        expected_null_count += is_null;
+        ASSERT_EQ(is_null ? DATUM_NULL : DATUM_NOT_NULL, null_column->get_data()[1 + i]);
+        ASSERT_EQ(is_null ? 0 : 1, filter[1 + i]);
+    }
+    ASSERT_EQ(expected_null_count, null_count);
+}
+
 template <typename ArrowType, bool is_nullable = false>
 static inline std::shared_ptr<arrow::Array> create_constant_binary_array(int64_t num_elements, const std::string& value,
                                                                          size_t& counter) {
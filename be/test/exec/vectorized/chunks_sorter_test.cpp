@@ -2,11 +2,16 @@
 
 #include <gtest/gtest.h>
 
+#include <filesystem>
+
 #include "column/column_helper.h"
 #include "column/datum_tuple.h"
 #include "exec/vectorized/chunks_sorter_full_sort.h"
 #include "exec/vectorized/chunks_sorter_topn.h"
 #include "exprs/slot_ref.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/tmp_file_mgr.h"
+#include "util/metrics.h"
 
 namespace starrocks::vectorized {
 
@@ -303,6 +308,103 @@ TEST_F(ChunksSorterTest, full_sort_by_4_columns) {
     clear_sort_exprs(sort_exprs);
 }
 
+// The strings share a prefix longer than the normalized keys, the rows are tied on their keys.
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, full_sort_by_long_string_prefix) {
+    ColumnPtr col_key = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false);
+    ColumnPtr col_name = ColumnHelper::create_column(TypeDescriptor::create_varchar_type(64), true);
+    std::string prefix(20, 'a');
+    std::vector<std::string> names = {prefix + "b", prefix + "a", prefix + "b", prefix, prefix + "a"};
+    for (size_t i = 0; i < names.size(); i++) {
+        col_key->append_datum(Datum(int32_t(i)));
+        col_name->append_datum(Datum(Slice(names[i])));
+    }
+    col_key->append_datum(Datum(int32_t(5)));
+    col_name->append_datum(Datum());
+
+    butil::FlatMap<SlotId, size_t> map;
+    map.init(4);
+    map[0] = 0;
+    map[1] = 1;
+    ChunkPtr chunk = std::make_shared<Chunk>(Columns{col_key, col_name}, map);
+
+    std::vector<bool> is_asc{true, false};
+    std::vector<bool> is_null_first{false, true};
+    SlotRef expr_key(TypeDescriptor(TYPE_INT), 0, 0);
+    SlotRef expr_name(TypeDescriptor(TYPE_VARCHAR), 0, 1);
+    std::vector<ExprContext*> sort_exprs{new ExprContext(&expr_name), new ExprContext(&expr_key)};
+
+    ChunksSorterFullSort sorter(&sort_exprs, &is_asc, &is_null_first, 2);
+    sorter.update(nullptr, chunk);
+    sorter.done(nullptr);
+
+    bool eos = false;
+    ChunkPtr page;
+    sorter.get_next(&page, &eos);
+    ASSERT_FALSE(eos);
+    ASSERT_EQ(6, page->num_rows());
+    int32_t permutation[] = {3, 4, 1, 2, 0, 5};
+    for (size_t i = 0; i < 6; ++i) {
+        ASSERT_EQ(permutation[i], page->get(i).get(0).get_int32());
+    }
+
+    clear_sort_exprs(sort_exprs);
+}
+
+// Every chunk is spilled as a sorted run, the runs are merged in order.
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, full_sort_with_spilled_runs) {
+    std::string tmp_dir = (std::filesystem::temp_directory_path() / "chunks_sorter_test").string();
+    std::filesystem::remove_all(tmp_dir);
+    std::filesystem::create_directories(tmp_dir);
+    MetricRegistry metrics("chunks_sorter_test");
+    TmpFileMgr tmp_file_mgr;
+    ASSERT_TRUE(tmp_file_mgr.init_custom({tmp_dir}, true, &metrics).ok());
+    RuntimeProfile profile("chunks_sorter_test");
+    // The memory is always beyond the budget to spill.
+    MemTracker mem_tracker(1000);
+    mem_tracker.consume(1000);
+    SpillManager spill_manager(&mem_tracker, &tmp_file_mgr);
+
+    std::vector<bool> is_asc, is_null_first;
+    is_asc.push_back(false); // region
+    is_asc.push_back(true);  // cust_key
+    is_null_first.push_back(true);
+    is_null_first.push_back(true);
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_region.get()));
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+
+    {
+        ChunksSorterFullSort sorter(&sort_exprs, &is_asc, &is_null_first, 2);
+        sorter.set_spill(&spill_manager, TUniqueId(), 80, &profile);
+        ASSERT_TRUE(sorter.update(nullptr, _chunk_1).ok());
+        ASSERT_TRUE(sorter.update(nullptr, _chunk_2).ok());
+        ASSERT_TRUE(sorter.update(nullptr, _chunk_3).ok());
+        ASSERT_TRUE(sorter.done(nullptr).ok());
+
+        std::vector<int32_t> cust_keys;
+        bool eos = false;
+        while (true) {
+            ChunkPtr page;
+            ASSERT_TRUE(sorter.get_next(&page, &eos).ok());
+            if (eos) {
+                break;
+            }
+            for (size_t i = 0; i < page->num_rows(); ++i) {
+                cust_keys.push_back(page->get(i).get(0).get_int32());
+            }
+        }
+        std::vector<int32_t> expected{69, 70, 71, 2, 4, 6, 12, 16, 24, 41, 49, 52, 54, 55, 56, 58};
+        ASSERT_EQ(expected, cust_keys);
+        ASSERT_EQ(3, profile.get_counter("SpillRuns")->value());
+    }
+
+    clear_sort_exprs(sort_exprs);
+    mem_tracker.release(1000);
+    std::filesystem::remove_all(tmp_dir);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ChunksSorterTest, part_sort_by_3_columns_null_fisrt) {
     std::vector<bool> is_asc, is_null_first;
@@ -399,6 +501,51 @@ TEST_F(ChunksSorterTest, part_sort_by_3_columns_null_last) {
     clear_sort_exprs(sort_exprs);
 }
 
+// Once the top rows are kept, the rows of the later chunks after them are dropped before sorting.
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, topn_filter_by_threshold) {
+    butil::FlatMap<SlotId, size_t> map;
+    map.init(2);
+    map[0] = 0;
+    SlotRef expr_key(TypeDescriptor(TYPE_INT), 0, 0);
+    std::vector<ExprContext*> sort_exprs{new ExprContext(&expr_key)};
+
+    for (bool is_null_first : {true, false}) {
+        std::vector<bool> is_asc{false};
+        std::vector<bool> null_first{is_null_first};
+        ChunksSorterTopn sorter(&sort_exprs, &is_asc, &null_first, 1, 3, 1);
+        for (int32_t i = 0; i < 20; ++i) {
+            ColumnPtr column = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+            for (int32_t j = 0; j < 10; ++j) {
+                // the values are in [0, 200) and distinct, the chunk 7 has a NULL.
+                column->append_datum(Datum(int32_t((i * 10 + j) * 37 % 200)));
+            }
+            if (i == 7) {
+                column->append_datum(Datum());
+            }
+            ASSERT_TRUE(sorter.update(nullptr, std::make_shared<Chunk>(Columns{column}, map)).ok());
+        }
+        ASSERT_TRUE(sorter.done(nullptr).ok());
+
+        bool eos = false;
+        ChunkPtr page;
+        ASSERT_TRUE(sorter.get_next(&page, &eos).ok());
+        ASSERT_FALSE(eos);
+        ASSERT_EQ(3, page->num_rows());
+        if (is_null_first) {
+            ASSERT_EQ(199, page->get(0).get(0).get_int32());
+            ASSERT_EQ(198, page->get(1).get(0).get_int32());
+            ASSERT_EQ(197, page->get(2).get(0).get_int32());
+        } else {
+            ASSERT_EQ(198, page->get(0).get(0).get_int32());
+            ASSERT_EQ(197, page->get(1).get(0).get_int32());
+            ASSERT_EQ(196, page->get(2).get(0).get_int32());
+        }
+    }
+
+    clear_sort_exprs(sort_exprs);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ChunksSorterTest, order_by_with_unequal_sized_chunks) {
     std::vector<bool> is_asc, is_null_first;
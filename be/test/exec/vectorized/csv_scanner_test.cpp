@@ -538,6 +538,89 @@ TEST_F(CSVScannerTest, test_large_record_size) {
     }
 }
 
+TEST_F(CSVScannerTest, test_long_records) {
+    std::vector<TypeDescriptor> types;
+    types.emplace_back(TYPE_INT);
+    types.emplace_back(TYPE_VARCHAR);
+    types.emplace_back(TYPE_VARCHAR);
+    types.emplace_back(TYPE_INT);
+    types[1].len = 100;
+    types[2].len = 100;
+
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.__set_path("./be/test/exec/test_data/csv_scanner/csv_file14");
+    range.__set_start_offset(0);
+    range.__set_num_of_columns_from_file(types.size());
+    ranges.push_back(range);
+
+    auto scanner = create_csv_scanner(types, ranges);
+    EXPECT_NE(scanner, nullptr);
+
+    Status st = scanner->open();
+    ASSERT_TRUE(st.ok()) << st.to_string();
+    auto res = scanner->get_next();
+    ASSERT_TRUE(res.ok()) << res.status().to_string();
+    auto chunk = res.value();
+    EXPECT_EQ(4, chunk->num_columns());
+    // the last record has too many fields
+    EXPECT_EQ(3, chunk->num_rows());
+
+    // the field delimiters crossing the 64 bytes blocks are found
+    EXPECT_EQ(1, chunk->get(0)[0].get_int32());
+    EXPECT_EQ(std::string(64, 'a'), chunk->get(0)[1].get_slice());
+    EXPECT_EQ("b", chunk->get(0)[2].get_slice());
+    EXPECT_EQ(2, chunk->get(0)[3].get_int32());
+
+    EXPECT_EQ(3, chunk->get(1)[0].get_int32());
+    EXPECT_EQ("", chunk->get(1)[1].get_slice());
+    EXPECT_EQ("", chunk->get(1)[2].get_slice());
+    EXPECT_EQ(4, chunk->get(1)[3].get_int32());
+
+    EXPECT_EQ(5, chunk->get(2)[0].get_int32());
+    EXPECT_EQ(std::string(60, 'c'), chunk->get(2)[1].get_slice());
+    EXPECT_EQ(std::string(70, 'd'), chunk->get(2)[2].get_slice());
+    EXPECT_EQ(6, chunk->get(2)[3].get_int32());
+}
+
+TEST_F(CSVScannerTest, test_reset_input) {
+    std::vector<TypeDescriptor> types;
+    types.emplace_back(TYPE_INT);
+    types.emplace_back(TYPE_VARCHAR);
+    types[1].len = 10;
+
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.__set_path("./be/test/exec/test_data/csv_scanner/csv_file1");
+    range.__set_start_offset(0);
+    range.__set_num_of_columns_from_file(types.size());
+    ranges.push_back(range);
+
+    auto scanner = create_csv_scanner(types, ranges);
+    Status st = scanner->open();
+    ASSERT_TRUE(st.ok()) << st.to_string();
+
+    // the blocks are parsed one by one instead of the range
+    scanner->reset_input(std::make_shared<StringSequentialFile>("1|a\n2|b\n"));
+    auto res = scanner->get_next();
+    ASSERT_TRUE(res.ok()) << res.status().to_string();
+    auto chunk = res.value();
+    EXPECT_EQ(2, chunk->num_rows());
+    EXPECT_EQ(2, chunk->get(1)[0].get_int32());
+    EXPECT_EQ("b", chunk->get(1)[1].get_slice());
+    EXPECT_TRUE(scanner->get_next().status().is_end_of_file());
+
+    // the last record isn't ended with the record delimiter
+    scanner->reset_input(std::make_shared<StringSequentialFile>("3|c"));
+    res = scanner->get_next();
+    ASSERT_TRUE(res.ok()) << res.status().to_string();
+    chunk = res.value();
+    EXPECT_EQ(1, chunk->num_rows());
+    EXPECT_EQ(3, chunk->get(0)[0].get_int32());
+    EXPECT_EQ("c", chunk->get(0)[1].get_slice());
+    EXPECT_TRUE(scanner->get_next().status().is_end_of_file());
+}
+
 TEST_F(CSVScannerTest, test_record_length_exceed_limit) {
     constexpr size_t record_length = CSVScanner::kMaxBufferSize;
     constexpr size_t field_length = TypeDescriptor::MAX_VARCHAR_LENGTH;
@@ -0,0 +1,39 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/file_meta_cache.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks::vectorized {
+
+TEST(FileMetaCacheTest, LookupAndInsert) {
+    FileMetaCache cache(1024);
+    std::string key = FileMetaCache::make_key("parquet", "hdfs://host/path/file", 100, 1);
+    ASSERT_EQ(nullptr, cache.lookup<std::string>(key));
+
+    cache.insert(key, std::make_shared<const std::string>("footer"), 10);
+    auto meta = cache.lookup<std::string>(key);
+    ASSERT_NE(nullptr, meta);
+    ASSERT_EQ("footer", *meta);
+    ASSERT_EQ(10, cache.memory_usage());
+
+    // a rewritten file or another format doesn't hit the metadata
+    ASSERT_EQ(nullptr, cache.lookup<std::string>(FileMetaCache::make_key("parquet", "hdfs://host/path/file", 100, 2)));
+    ASSERT_EQ(nullptr, cache.lookup<std::string>(FileMetaCache::make_key("parquet", "hdfs://host/path/file", 99, 1)));
+    ASSERT_EQ(nullptr, cache.lookup<std::string>(FileMetaCache::make_key("orc", "hdfs://host/path/file", 100, 1)));
+}
+
+TEST(FileMetaCacheTest, Replace) {
+    FileMetaCache cache(1024);
+    std::string key = FileMetaCache::make_key("orc", "file", 100, 1);
+    cache.insert(key, std::make_shared<const std::string>("tail1"), 10);
+    auto meta = cache.lookup<std::string>(key);
+    cache.insert(key, std::make_shared<const std::string>("tail2"), 10);
+
+    // the replaced metadata is still alive for the reader holds it
+    ASSERT_EQ("tail1", *meta);
+    ASSERT_EQ("tail2", *cache.lookup<std::string>(key));
+    ASSERT_EQ(10, cache.memory_usage());
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,189 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/hash_join_spiller.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <set>
+
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "util/block_compression.h"
+#include "util/metrics.h"
+
+namespace starrocks::vectorized {
+
+class HashJoinSpillerTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        config::vector_chunk_size = 1024;
+        _tmp_dir = (std::filesystem::temp_directory_path() / "hash_join_spiller_test").string();
+        std::filesystem::remove_all(_tmp_dir);
+        std::filesystem::create_directories(_tmp_dir);
+        ASSERT_TRUE(_tmp_file_mgr.init_custom({_tmp_dir}, true, &_metrics).ok());
+    }
+
+    void TearDown() override { std::filesystem::remove_all(_tmp_dir); }
+
+protected:
+    static ChunkPtr create_chunk(int32_t begin, int32_t end, bool nullable) {
+        ColumnPtr column = Int32Column::create();
+        for (int32_t i = begin; i < end; ++i) {
+            column->append_datum(Datum(i));
+        }
+        if (nullable) {
+            column = NullableColumn::create(column, NullColumn::create(column->size(), 0));
+        }
+        auto chunk = std::make_shared<Chunk>();
+        chunk->append_column(column, 1);
+        return chunk;
+    }
+
+    static std::vector<int32_t> read_all(SpilledChunkFile* file) {
+        std::vector<int32_t> values;
+        if (file == nullptr) {
+            return values;
+        }
+        while (true) {
+            ChunkPtr chunk;
+            EXPECT_TRUE(file->read_next(&chunk).ok());
+            if (chunk == nullptr) {
+                break;
+            }
+            const ColumnPtr& column = chunk->get_column_by_slot_id(1);
+            for (size_t i = 0; i < column->size(); ++i) {
+                values.push_back(column->get(i).get_int32());
+            }
+        }
+        return values;
+    }
+
+    TmpFileMgr* tmp_file_mgr() { return &_tmp_file_mgr; }
+
+private:
+    std::string _tmp_dir;
+    MetricRegistry _metrics{"hash_join_spiller_test"};
+    TmpFileMgr _tmp_file_mgr;
+};
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinSpillerTest, SpilledChunkFileReadBack) {
+    TmpFileMgr::File* tmp_file = nullptr;
+    ASSERT_TRUE(tmp_file_mgr()->get_file(tmp_file_mgr()->active_tmp_devices()[0], TUniqueId(), &tmp_file).ok());
+    SpilledChunkFile file(tmp_file);
+
+    ASSERT_TRUE(file.append(*create_chunk(0, 100, false)).ok());
+    ASSERT_TRUE(file.append(*create_chunk(100, 300, true)).ok());
+    ASSERT_EQ(300, file.num_rows());
+
+    ChunkPtr chunk;
+    ASSERT_TRUE(file.read_next(&chunk).ok());
+    ASSERT_EQ(100, chunk->num_rows());
+    ASSERT_FALSE(chunk->get_column_by_slot_id(1)->is_nullable());
+    ASSERT_EQ(99, chunk->get_column_by_slot_id(1)->get(99).get_int32());
+
+    ASSERT_TRUE(file.read_next(&chunk).ok());
+    ASSERT_EQ(200, chunk->num_rows());
+    ASSERT_TRUE(chunk->get_column_by_slot_id(1)->is_nullable());
+    ASSERT_EQ(100, chunk->get_column_by_slot_id(1)->get(0).get_int32());
+
+    ASSERT_TRUE(file.read_next(&chunk).ok());
+    ASSERT_EQ(nullptr, chunk);
+}
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinSpillerTest, SpilledChunkFileCompressed) {
+    const BlockCompressionCodec* codec = nullptr;
+    ASSERT_TRUE(get_block_compression_codec(CompressionTypePB::LZ4, &codec).ok());
+    TmpFileMgr::File* tmp_file = nullptr;
+    ASSERT_TRUE(tmp_file_mgr()->get_file(tmp_file_mgr()->active_tmp_devices()[0], TUniqueId(), &tmp_file).ok());
+    SpilledChunkFile file(tmp_file, codec);
+
+    ChunkPtr chunk = create_chunk(0, 1000, true);
+    ASSERT_TRUE(file.append(*chunk).ok());
+    ASSERT_TRUE(file.append(*create_chunk(1000, 1500, false)).ok());
+    ASSERT_LT(file.num_bytes(), static_cast<int64_t>(chunk->serialize_size()));
+
+    std::vector<int32_t> values = read_all(&file);
+    ASSERT_EQ(1500, values.size());
+    for (int32_t i = 0; i < 1500; ++i) {
+        ASSERT_EQ(i, values[i]);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinSpillerTest, PartitionBuildAndProbe) {
+    HashJoinSpiller spiller(tmp_file_mgr(), TUniqueId(), 8, false);
+    spiller.start_partitioning(0);
+    // build keys are [0, 3000), probe keys are [2000, 6000).
+    for (int32_t i = 0; i < 3000; i += 500) {
+        ChunkPtr chunk = create_chunk(i, i + 500, i >= 1500);
+        ASSERT_TRUE(spiller.add_build_chunk(chunk, {chunk->get_column_by_slot_id(1)}).ok());
+    }
+    ASSERT_TRUE(spiller.finish_build().ok());
+    for (int32_t i = 2000; i < 6000; i += 1000) {
+        ChunkPtr chunk = create_chunk(i, i + 1000, false);
+        ASSERT_TRUE(spiller.add_probe_chunk(chunk, {chunk->get_column_by_slot_id(1)}).ok());
+    }
+    ASSERT_TRUE(spiller.finish_probe().ok());
+    ASSERT_EQ(8, spiller.num_spilled_partitions());
+
+    std::set<int32_t> all_build_keys;
+    size_t num_matched_probe_rows = 0;
+    while (spiller.has_next_partition()) {
+        SpilledJoinPartition partition = spiller.next_partition();
+        ASSERT_EQ(0, partition.level);
+        std::vector<int32_t> build_keys = read_all(partition.build_file.get());
+        std::set<int32_t> build_key_set(build_keys.begin(), build_keys.end());
+        for (int32_t key : build_keys) {
+            // each key is in only one partition.
+            ASSERT_TRUE(all_build_keys.insert(key).second);
+        }
+        for (int32_t key : read_all(partition.probe_file.get())) {
+            if (key < 3000) {
+                ASSERT_TRUE(build_key_set.count(key) > 0);
+                ++num_matched_probe_rows;
+            }
+        }
+    }
+    ASSERT_EQ(3000, all_build_keys.size());
+    ASSERT_EQ(1000, num_matched_probe_rows);
+}
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinSpillerTest, PartitionAgain) {
+    HashJoinSpiller spiller(tmp_file_mgr(), TUniqueId(), 4, true);
+    spiller.start_partitioning(0);
+    ChunkPtr chunk = create_chunk(0, 1000, false);
+    ASSERT_TRUE(spiller.add_build_chunk(chunk, {chunk->get_column_by_slot_id(1)}).ok());
+    ASSERT_TRUE(spiller.finish_build().ok());
+    ASSERT_TRUE(spiller.finish_probe().ok());
+
+    // the rows of a partition are partitioned again by another hash function of the next level.
+    SpilledJoinPartition partition = spiller.next_partition();
+    std::vector<int32_t> keys = read_all(partition.build_file.get());
+    spiller.start_partitioning(partition.level + 1);
+    chunk = create_chunk(0, 0, false);
+    for (int32_t key : keys) {
+        chunk->get_column_by_slot_id(1)->append_datum(Datum(key));
+    }
+    ASSERT_TRUE(spiller.add_build_chunk(chunk, {chunk->get_column_by_slot_id(1)}).ok());
+    ASSERT_TRUE(spiller.finish_build().ok());
+    ASSERT_TRUE(spiller.finish_probe().ok());
+
+    size_t num_level1_partitions = 0;
+    size_t num_rows = 0;
+    while (spiller.has_next_partition()) {
+        SpilledJoinPartition next = spiller.next_partition();
+        if (next.level == 1) {
+            ++num_level1_partitions;
+            num_rows += next.build_file->num_rows();
+        }
+    }
+    ASSERT_EQ(4, num_level1_partitions);
+    ASSERT_EQ(keys.size(), num_rows);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/hdfs_io_controller.h"
+
+#include <gtest/gtest.h>
+
+#include <future>
+
+#include "util/priority_thread_pool.hpp"
+
+namespace starrocks::vectorized {
+
+TEST(HdfsIOControllerTest, MaxBufferedBytes) {
+    PriorityThreadPool thread_pool(2, 16);
+    auto controller = std::make_shared<HdfsIOController>(&thread_pool, 100, 2);
+
+    std::promise<void> promise;
+    ASSERT_TRUE(controller->try_submit(60, [&promise] { promise.set_value(); }));
+    promise.get_future().wait();
+    ASSERT_EQ(60, controller->buffered_bytes());
+
+    // the bytes read are held until released
+    ASSERT_FALSE(controller->try_submit(60, [] {}));
+    controller->release(60);
+    ASSERT_EQ(0, controller->buffered_bytes());
+
+    std::promise<void> promise2;
+    ASSERT_TRUE(controller->try_submit(60, [&promise2] { promise2.set_value(); }));
+    promise2.get_future().wait();
+    controller->release(60);
+}
+
+TEST(HdfsIOControllerTest, MaxConcurrency) {
+    PriorityThreadPool thread_pool(4, 16);
+    auto controller = std::make_shared<HdfsIOController>(&thread_pool, 1000, 4);
+    ASSERT_EQ(HdfsIOController::kInitialConcurrency, controller->concurrency());
+
+    std::promise<void> start;
+    std::shared_future<void> started(start.get_future());
+    for (int i = 0; i < HdfsIOController::kInitialConcurrency; ++i) {
+        ASSERT_TRUE(controller->try_submit(10, [started] { started.wait(); }));
+    }
+    // too many reads running
+    ASSERT_FALSE(controller->try_submit(10, [] {}));
+    start.set_value();
+    thread_pool.shutdown();
+    thread_pool.join();
+}
+
+TEST(HdfsIOControllerTest, AdaptToLatency) {
+    PriorityThreadPool thread_pool(1, 16);
+    auto controller = std::make_shared<HdfsIOController>(&thread_pool, 1000, 8);
+    int concurrency = controller->concurrency();
+
+    // the latency stays low, the concurrency grows up to the max
+    for (int i = 0; i < 10; ++i) {
+        controller->update_concurrency(1000, 1000);
+        ASSERT_EQ(std::min(concurrency + i + 1, 8), controller->concurrency());
+    }
+
+    // the latency rises, the concurrency halves
+    controller->update_concurrency(1000, 10000);
+    ASSERT_EQ(4, controller->concurrency());
+    controller->update_concurrency(1000, 10000);
+    ASSERT_EQ(2, controller->concurrency());
+
+    // the latency per byte of a larger read is low
+    controller->update_concurrency(10000, 10000);
+    ASSERT_EQ(3, controller->concurrency());
+}
+
+} // namespace starrocks::vectorized
@@ -495,7 +495,6 @@ void JoinHashMapTest::prepare_table_items(JoinHashTableItems* table_items, uint3
     table_items->row_count = row_count;
     table_items->next.resize(row_count + 1);
     table_items->build_pool = std::make_unique<MemPool>(_mem_tracker.get());
-    table_items->probe_pool = std::make_unique<MemPool>(_mem_tracker.get());
     table_items->mem_tracker = _mem_tracker.get();
     table_items->search_ht_timer = ADD_TIMER(_runtime_profile, "SearchHashTableTimer");
     table_items->output_build_column_timer = ADD_TIMER(_runtime_profile, "OutputBuildColumnTimer");
@@ -1114,7 +1113,7 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFunc) {
     table_items.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
     table_items.mem_tracker = runtime_state->instance_mem_tracker();
     table_items.build_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
-    table_items.probe_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
+    probe_state.probe_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
     probe_state.probe_row_count = 10;
     probe_state.buckets.resize(config::vector_chunk_size);
     probe_state.next.resize(config::vector_chunk_size, 0);
@@ -1143,7 +1142,7 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFunc) {
         ASSERT_EQ(found_count, 1);
     }
     table_items.build_pool.reset();
-    table_items.probe_pool.reset();
+    probe_state.probe_pool.reset();
     table_items.mem_tracker->release(table_items.mem_tracker->consumption());
 }
 
@@ -1177,7 +1176,7 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFuncNullable) {
     table_items.next.resize(11);
     table_items.mem_tracker = runtime_state->instance_mem_tracker();
     table_items.build_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
-    table_items.probe_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
+    probe_state.probe_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
     probe_state.probe_row_count = 10;
     probe_state.buckets.resize(config::vector_chunk_size);
     probe_state.next.resize(config::vector_chunk_size, 0);
@@ -1216,7 +1215,7 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFuncNullable) {
         }
     }
     table_items.build_pool.reset();
-    table_items.probe_pool.reset();
+    probe_state.probe_pool.reset();
     table_items.mem_tracker->release(table_items.mem_tracker->consumption());
 }
 
@@ -1619,6 +1618,206 @@ TEST_F(JoinHashMapTest, OneKeyJoinHashTable) {
     hash_table.close();
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, CalcDirectMappingBucketNum) {
+    // the keys in [-5, 5) are mapped to the buckets [1, 11), and the others to the empty bucket 0.
+    ASSERT_EQ(1, JoinHashMapHelper::calc_direct_mapping_bucket_num<int32_t>(-5, -5, 11));
+    ASSERT_EQ(10, JoinHashMapHelper::calc_direct_mapping_bucket_num<int32_t>(4, -5, 11));
+    ASSERT_EQ(0, JoinHashMapHelper::calc_direct_mapping_bucket_num<int32_t>(5, -5, 11));
+    ASSERT_EQ(0, JoinHashMapHelper::calc_direct_mapping_bucket_num<int32_t>(-6, -5, 11));
+    ASSERT_EQ(0, JoinHashMapHelper::calc_direct_mapping_bucket_num<int64_t>(INT64_MIN, 0, 11));
+    ASSERT_EQ(0, JoinHashMapHelper::calc_direct_mapping_bucket_num<int64_t>(INT64_MAX, -1, 11));
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, DirectMappingJoinHashTable) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    auto mem_tracker = create_mem_tracker(runtime_profile);
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.mem_tracker = mem_tracker.get();
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+
+    // the build keys are [0, 10), the probe keys are [7, 12).
+    auto build_chunk = create_int32_build_chunk(10, false);
+    auto probe_chunk = create_int32_probe_chunk(5, 7, false);
+    Columns probe_key_columns;
+    probe_key_columns.emplace_back(probe_chunk->columns()[0]);
+
+    ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), build_chunk).ok());
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+    ASSERT_EQ(JoinHashMapType::direct_mapping32, hash_table._hash_map_type);
+    ASSERT_EQ(11, hash_table.get_bucket_size());
+
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    bool eos = false;
+    ASSERT_TRUE(hash_table.probe(probe_key_columns, &probe_chunk, &result_chunk, &eos).ok());
+
+    ASSERT_EQ(result_chunk->num_columns(), 6);
+    ASSERT_EQ(3, result_chunk->num_rows());
+    check_int32_column(result_chunk->get_column_by_slot_id(0), 3, 7);
+    check_int32_column(result_chunk->get_column_by_slot_id(3), 3, 7);
+    check_int32_column(result_chunk->get_column_by_slot_id(4), 3, 17);
+    check_int32_column(result_chunk->get_column_by_slot_id(5), 3, 27);
+
+    hash_table.close();
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, LeftSemiJoinKeyOnlyBuild) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    auto mem_tracker = create_mem_tracker(runtime_profile);
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::LEFT_SEMI_JOIN;
+    param.row_desc = row_desc.get();
+    param.mem_tracker = mem_tracker.get();
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+
+    // every build key is appended three times.
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), create_int32_build_chunk(10, false)).ok());
+    }
+    auto probe_chunk = create_int32_probe_chunk(5, 7, false);
+    Columns probe_key_columns;
+    probe_key_columns.emplace_back(probe_chunk->columns()[0]);
+
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+
+    // one row of every distinct key is in the chains.
+    size_t num_chained_rows = 0;
+    for (uint32_t bucket = 0; bucket < hash_table.get_bucket_size(); bucket++) {
+        for (uint32_t row = hash_table._table_items->first[bucket]; row != 0;
+             row = hash_table._table_items->next[row]) {
+            num_chained_rows++;
+        }
+    }
+    ASSERT_EQ(10, num_chained_rows);
+    // the key column is kept, and the other build columns are released.
+    ASSERT_EQ(31, hash_table.get_build_chunk()->columns()[0]->size());
+    ASSERT_EQ(0, hash_table.get_build_chunk()->columns()[1]->size());
+    ASSERT_EQ(0, hash_table.get_build_chunk()->columns()[2]->size());
+
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    bool eos = false;
+    ASSERT_TRUE(hash_table.probe(probe_key_columns, &probe_chunk, &result_chunk, &eos).ok());
+    // the probe keys [7, 12) match 7, 8 and 9 once.
+    ASSERT_EQ(3, result_chunk->num_rows());
+    check_int32_column(result_chunk->get_column_by_slot_id(0), 3, 7);
+    check_int32_column(result_chunk->get_column_by_slot_id(1), 3, 17);
+
+    hash_table.close();
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, RadixPartitionedJoinHashTable) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    auto mem_tracker = create_mem_tracker(runtime_profile);
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+    const int64_t old_min_rows = config::join_hash_table_radix_partition_min_rows;
+    config::join_hash_table_radix_partition_min_rows = 1;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.mem_tracker = mem_tracker.get();
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+
+    // enough rows to have more buckets than a radix partition.
+    auto build_chunk = create_int32_build_chunk(20000, false);
+    auto probe_chunk = create_int32_probe_chunk(5, 1000, false);
+    Columns probe_key_columns{probe_chunk->columns()[0], probe_chunk->columns()[1]};
+
+    ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), build_chunk).ok());
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[1]);
+    ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+    ASSERT_GT(hash_table.get_bucket_size(), JoinHashMapHelper::RADIX_PARTITION_BUCKETS);
+    // the build rows are reordered, and the key columns still share the build columns.
+    ASSERT_EQ(hash_table.get_build_chunk()->columns()[0], hash_table.get_key_columns()[0]);
+    ASSERT_EQ(20001, hash_table.get_build_chunk()->num_rows());
+
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    bool eos = false;
+    ASSERT_TRUE(hash_table.probe(probe_key_columns, &probe_chunk, &result_chunk, &eos).ok());
+
+    ASSERT_EQ(result_chunk->num_columns(), 6);
+    check_int32_column(result_chunk->get_column_by_slot_id(0), 5, 1000);
+    check_int32_column(result_chunk->get_column_by_slot_id(3), 5, 1000);
+    check_int32_column(result_chunk->get_column_by_slot_id(4), 5, 1010);
+    check_int32_column(result_chunk->get_column_by_slot_id(5), 5, 1020);
+
+    hash_table.close();
+    config::join_hash_table_radix_partition_min_rows = old_min_rows;
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, OneNullableKeyJoinHashTable) {
     auto runtime_profile = create_runtime_profile();
@@ -1815,6 +2014,71 @@ TEST_F(JoinHashMapTest, SerializeJoinHashTable) {
     hash_table.close();
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, ReadableCloneJoinHashTable) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_VARCHAR, false);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_VARCHAR, false);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(_object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(_object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(_object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.mem_tracker = _mem_tracker.get();
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_VARCHAR, false});
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_VARCHAR, false});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+
+    auto build_chunk = create_binary_build_chunk(10, false, _mem_pool.get());
+    ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), build_chunk).ok());
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[1]);
+    ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+
+    // The clones share the built hash table, and each of them keeps its own probe state.
+    JoinHashTable clone1 = hash_table.clone_readable_table();
+    JoinHashTable clone2 = hash_table.clone_readable_table();
+    ASSERT_EQ(clone1.get_row_count(), 10);
+    ASSERT_EQ(clone2.get_bucket_size(), hash_table.get_bucket_size());
+
+    auto probe_chunk1 = create_binary_probe_chunk(5, 1, false, _mem_pool.get());
+    auto probe_chunk2 = create_binary_probe_chunk(3, 2, false, _mem_pool.get());
+    Columns probe_key_columns1{probe_chunk1->columns()[0], probe_chunk1->columns()[1]};
+    Columns probe_key_columns2{probe_chunk2->columns()[0], probe_chunk2->columns()[1]};
+
+    ChunkPtr result_chunk1 = std::make_shared<Chunk>();
+    ChunkPtr result_chunk2 = std::make_shared<Chunk>();
+    bool eos = false;
+    ASSERT_TRUE(clone1.probe(probe_key_columns1, &probe_chunk1, &result_chunk1, &eos).ok());
+    ASSERT_TRUE(clone2.probe(probe_key_columns2, &probe_chunk2, &result_chunk2, &eos).ok());
+
+    ASSERT_EQ(result_chunk1->num_columns(), 6);
+    check_binary_column(result_chunk1->get_column_by_slot_id(0), 5, 1);
+    check_binary_column(result_chunk1->get_column_by_slot_id(3), 5, 1);
+    ASSERT_EQ(result_chunk2->num_columns(), 6);
+    check_binary_column(result_chunk2->get_column_by_slot_id(0), 3, 2);
+    check_binary_column(result_chunk2->get_column_by_slot_id(3), 3, 2);
+
+    clone1.close();
+    clone2.close();
+    hash_table.close();
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, FixedSizeJoinBuildFuncForNotNullableColumn) {
     JoinHashTableItems table_items;
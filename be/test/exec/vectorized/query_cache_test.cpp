@@ -0,0 +1,46 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/query_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+
+namespace starrocks::vectorized {
+
+TEST(QueryCacheTest, LookupAndInsert) {
+    QueryCache cache(1024);
+    std::string key = QueryCache::make_key("digest", 10001, "5");
+    ASSERT_EQ(nullptr, cache.lookup(key));
+
+    auto result = std::make_shared<QueryCache::Result>();
+    result->emplace_back(std::make_shared<Chunk>());
+    cache.insert(key, result, 10);
+    auto cached = cache.lookup(key);
+    ASSERT_NE(nullptr, cached);
+    ASSERT_EQ(1, cached->size());
+    ASSERT_EQ(result->front(), cached->front());
+    ASSERT_EQ(10, cache.memory_usage());
+
+    // a new version, another tablet or another plan doesn't hit the result
+    ASSERT_EQ(nullptr, cache.lookup(QueryCache::make_key("digest", 10001, "6")));
+    ASSERT_EQ(nullptr, cache.lookup(QueryCache::make_key("digest", 10002, "5")));
+    ASSERT_EQ(nullptr, cache.lookup(QueryCache::make_key("digest2", 10001, "5")));
+}
+
+TEST(QueryCacheTest, Replace) {
+    QueryCache cache(1024);
+    std::string key = QueryCache::make_key("digest", 1, "2");
+    auto result1 = std::make_shared<QueryCache::Result>();
+    result1->emplace_back(std::make_shared<Chunk>());
+    cache.insert(key, result1, 10);
+    auto cached = cache.lookup(key);
+    cache.insert(key, std::make_shared<QueryCache::Result>(), 10);
+
+    // the replaced result is still alive for the query holds it
+    ASSERT_EQ(1, cached->size());
+    ASSERT_EQ(0, cache.lookup(key)->size());
+    ASSERT_EQ(10, cache.memory_usage());
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,73 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/spill_manager.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/mem_tracker.h"
+
+namespace starrocks::vectorized {
+
+class FakeSpillable final : public Spillable {
+public:
+    int64_t spillable_bytes() const override { return bytes; }
+
+    int64_t bytes = 0;
+};
+
+TEST(SpillManagerTest, SpillLargest) {
+    MemTracker mem_tracker(1000);
+    SpillManager manager(&mem_tracker, nullptr);
+    FakeSpillable small, large;
+    manager.register_spillable(&small);
+    manager.register_spillable(&large);
+    small.bytes = 100;
+    large.bytes = 500;
+
+    // the memory is within the budget
+    mem_tracker.consume(600);
+    ASSERT_FALSE(manager.should_spill(&small, 80));
+    ASSERT_FALSE(manager.should_spill(&large, 80));
+    // unless the extra bytes exceed it
+    ASSERT_TRUE(manager.should_spill(&large, 80, 300));
+    ASSERT_FALSE(manager.should_spill(&large, 80));
+
+    // only the largest one spills, and it's taken to hold no memory then
+    mem_tracker.consume(300);
+    large.bytes = 700;
+    ASSERT_FALSE(manager.should_spill(&small, 80));
+    ASSERT_TRUE(manager.should_spill(&large, 80));
+    ASSERT_TRUE(manager.should_spill(&small, 80));
+
+    // 0 means never
+    ASSERT_FALSE(manager.should_spill(&small, 0));
+
+    manager.unregister_spillable(&small);
+    manager.unregister_spillable(&large);
+    mem_tracker.release(900);
+}
+
+TEST(SpillManagerTest, SpillLittle) {
+    MemTracker mem_tracker(100000);
+    SpillManager manager(&mem_tracker, nullptr);
+    FakeSpillable spillable;
+    manager.register_spillable(&spillable);
+
+    mem_tracker.consume(90000);
+    spillable.bytes = 10;
+    ASSERT_FALSE(manager.should_spill(&spillable, 80));
+    spillable.bytes = 10000;
+    ASSERT_TRUE(manager.should_spill(&spillable, 80));
+
+    manager.unregister_spillable(&spillable);
+    mem_tracker.release(90000);
+}
+
+TEST(SpillManagerTest, SpillDisabled) {
+    MemTracker unlimited;
+    ASSERT_FALSE(SpillManager(&unlimited, nullptr).spill_enabled());
+    MemTracker limited(1000);
+    ASSERT_FALSE(SpillManager(&limited, nullptr).spill_enabled());
+}
+
+} // namespace starrocks::vectorized
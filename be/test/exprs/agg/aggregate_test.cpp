@@ -593,6 +593,62 @@ TEST_F(AggregateTest, test_count_distinct) {
     test_agg_function<DateValue, int64_t>(ctx, func, 20, 21, 40);
 }
 
+// The states with more than 65536 values are partitioned, merge them with each other and with the small ones.
+TEST_F(AggregateTest, test_count_distinct_partitioned) {
+    const AggregateFunction* func = get_aggregate_function("multi_distinct_count", TYPE_BIGINT, TYPE_BIGINT, false);
+    auto make_state = [&](int64_t begin, int64_t end) {
+        auto column = Int64Column::create();
+        for (int64_t i = begin; i < end; i++) {
+            column->append(i);
+            column->append(i);
+        }
+        std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(func);
+        const Column* row_column = column.get();
+        func->update_batch_single_state(ctx, row_column->size(), &row_column, state->mutable_data());
+        return state;
+    };
+    auto result_column = Int64Column::create();
+
+    auto big1 = make_state(0, 100000);
+    auto big2 = make_state(50000, 200000);
+    auto small = make_state(199000, 201000);
+    func->finalize_to_column(ctx, big1->data(), result_column.get());
+    ASSERT_EQ(100000, result_column->get_data()[0]);
+
+    auto serde_column = BinaryColumn::create();
+    func->serialize_to_column(ctx, big1->data(), serde_column.get());
+    func->serialize_to_column(ctx, small->data(), serde_column.get());
+    func->merge(ctx, serde_column.get(), big2->data(), 0);
+    func->merge(ctx, serde_column.get(), big2->data(), 1);
+    func->finalize_to_column(ctx, big2->data(), result_column.get());
+    ASSERT_EQ(201000, result_column->get_data()[1]);
+
+    // A small state merges a partitioned one.
+    func->merge(ctx, serde_column.get(), small->data(), 0);
+    func->finalize_to_column(ctx, small->data(), result_column.get());
+    ASSERT_EQ(102000, result_column->get_data()[2]);
+
+    func = get_aggregate_function("multi_distinct_count", TYPE_VARCHAR, TYPE_BIGINT, false);
+    std::vector<std::string> values;
+    for (int i = 0; i < 100000; i++) {
+        values.emplace_back(std::to_string(i));
+    }
+    auto column = BinaryColumn::create();
+    for (const auto& value : values) {
+        column->append(Slice(value));
+    }
+    std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(func);
+    std::unique_ptr<ManagedAggregateState> state2 = ManagedAggregateState::Make(func);
+    const Column* row_column = column.get();
+    func->update_batch_single_state(ctx, row_column->size(), &row_column, state->mutable_data());
+    auto serde_column2 = BinaryColumn::create();
+    func->serialize_to_column(ctx, state->data(), serde_column2.get());
+    func->merge(ctx, serde_column2.get(), state2->data(), 0);
+    func->merge(ctx, serde_column2.get(), state2->data(), 0);
+    func->finalize_to_column(ctx, state2->data(), result_column.get());
+    ASSERT_EQ(100000, result_column->get_data()[3]);
+}
+
 TEST_F(AggregateTest, test_sum_distinct) {
     const AggregateFunction* func = get_aggregate_function("multi_distinct_sum", TYPE_SMALLINT, TYPE_BIGINT, false);
     test_agg_function<int16_t, int64_t>(ctx, func, 523776, 2499500, 3023276);
@@ -666,6 +722,46 @@ TEST_F(AggregateTest, test_sum_nullable) {
     ASSERT_EQ(4950, result_data.get_data()[0]);
 }
 
+TEST_F(AggregateTest, test_sum_nullable_batch) {
+    using NullableSumInt64 = NullableAggregateFunctionState<SumAggregateState<int64_t>>;
+    const AggregateFunction* sum_null = get_aggregate_function("sum", TYPE_INT, TYPE_BIGINT, true);
+
+    // the column without nulls takes the path skipping the null flags.
+    for (bool with_nulls : {true, false}) {
+        auto data_column = Int32Column::create();
+        auto null_column = NullColumn::create();
+        for (int i = 0; i < 100; i++) {
+            data_column->append(i);
+            null_column->append(with_nulls && i % 2 ? 1 : 0);
+        }
+        auto column = NullableColumn::create(std::move(data_column), std::move(null_column));
+        ASSERT_EQ(with_nulls, column->has_null());
+        const Column* row_column = column.get();
+
+        std::vector<std::unique_ptr<ManagedAggregateState>> states;
+        std::vector<AggDataPtr> state_ptrs;
+        for (int i = 0; i < 100; i++) {
+            if (i < 4) {
+                states.emplace_back(ManagedAggregateState::Make(sum_null));
+            }
+            state_ptrs.push_back(states[i % 4]->mutable_data());
+        }
+        sum_null->update_batch(ctx, column->size(), 0, &row_column, state_ptrs.data());
+
+        for (int k = 0; k < 4; k++) {
+            int64_t expect = 0;
+            for (int i = k; i < 100; i += 4) {
+                expect += (with_nulls && i % 2) ? 0 : i;
+            }
+            auto* null_state = (NullableSumInt64*)states[k]->mutable_data();
+            ASSERT_EQ(with_nulls && k % 2, null_state->is_null);
+            if (!null_state->is_null) {
+                ASSERT_EQ(expect, *reinterpret_cast<const int64_t*>(null_state->nested_state()));
+            }
+        }
+    }
+}
+
 TEST_F(AggregateTest, test_count_nullable) {
     const AggregateFunction* func = get_aggregate_function("count", TYPE_BIGINT, TYPE_BIGINT, true);
     std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(func);
@@ -687,6 +783,55 @@ TEST_F(AggregateTest, test_count_nullable) {
     ASSERT_EQ(512, result);
 }
 
+// Slide a frame of 3 rows over a column, and compare the states updated by the rows leaving and entering the
+// frame with the ones of all the rows of the frame.
+static void test_removable_function(FunctionContext* ctx, const AggregateFunction* func, const Column* column,
+                                    const ColumnPtr& result_column) {
+    ASSERT_TRUE(func->is_removable());
+    ColumnPtr sliding_result = result_column->clone_empty();
+    ColumnPtr expect_result = result_column->clone_empty();
+    std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(func);
+    int64_t size = column->size();
+    for (int64_t end = 1; end <= size; end++) {
+        int64_t start = std::max<int64_t>(0, end - 3);
+        func->remove_batch_single_state(ctx, state->mutable_data(), &column, std::max<int64_t>(0, end - 4), start,
+                                        end - 1);
+        func->update_batch_single_state(ctx, state->mutable_data(), &column, 0, size, end - 1, end);
+        func->finalize_to_column(ctx, state->data(), sliding_result.get());
+
+        std::unique_ptr<ManagedAggregateState> expect_state = ManagedAggregateState::Make(func);
+        func->update_batch_single_state(ctx, expect_state->mutable_data(), &column, 0, size, start, end);
+        func->finalize_to_column(ctx, expect_state->data(), expect_result.get());
+    }
+    ASSERT_EQ(size, sliding_result->size());
+    for (int64_t i = 0; i < size; i++) {
+        ASSERT_EQ(0, expect_result->compare_at(i, i, *sliding_result, 1)) << i;
+    }
+}
+
+TEST_F(AggregateTest, test_removable) {
+    auto data_column = Int32Column::create();
+    auto null_column = NullColumn::create();
+    for (int i = 0; i < 30; i++) {
+        data_column->append(i * 7 % 11);
+        null_column->append(i >= 5 && i < 12 ? 1 : i % 4 == 0);
+    }
+    auto column = NullableColumn::create(std::move(data_column), std::move(null_column));
+
+    ColumnPtr nullable_int64 = NullableColumn::create(Int64Column::create(), NullColumn::create());
+    ColumnPtr nullable_double = NullableColumn::create(DoubleColumn::create(), NullColumn::create());
+    test_removable_function(ctx, get_aggregate_function("sum", TYPE_INT, TYPE_BIGINT, true), column.get(),
+                            nullable_int64);
+    test_removable_function(ctx, get_aggregate_function("avg", TYPE_INT, TYPE_DOUBLE, true), column.get(),
+                            nullable_double);
+    test_removable_function(ctx, get_aggregate_function("count", TYPE_BIGINT, TYPE_BIGINT, true), column.get(),
+                            Int64Column::create());
+    test_removable_function(ctx, get_aggregate_function("count", TYPE_BIGINT, TYPE_BIGINT, false), column.get(),
+                            Int64Column::create());
+    ASSERT_FALSE(get_aggregate_function("sum", TYPE_DOUBLE, TYPE_DOUBLE, true)->is_removable());
+    ASSERT_FALSE(get_aggregate_function("max", TYPE_INT, TYPE_INT, true)->is_removable());
+}
+
 TEST_F(AggregateTest, test_bitmap_nullable) {
     const AggregateFunction* bitmap_null = get_aggregate_function("bitmap_union_int", TYPE_INT, TYPE_BIGINT, true);
     std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(bitmap_null);
@@ -794,6 +939,43 @@ TEST_F(AggregateTest, test_intersect_count) {
     ASSERT_EQ(1, result_column->get_data()[0]);
 }
 
+TEST_F(AggregateTest, test_bitmap_union_batch) {
+    const AggregateFunction* func = get_aggregate_function("bitmap_union_count", TYPE_OBJECT, TYPE_BIGINT, false);
+
+    // Empty, single, set and bitmap values, the bitmaps have elements of different high 32 bits.
+    auto data_column = BitmapColumn::create();
+    BitmapValue expected[2];
+    for (size_t i = 0; i < 40; ++i) {
+        BitmapValue value;
+        for (size_t j = 0; j < i; ++j) {
+            value.add(((i % 3) << 32) + i * 100 + j);
+        }
+        data_column->append(&value);
+        expected[i % 2] |= value;
+    }
+    const Column* row_column = data_column.get();
+
+    std::unique_ptr<ManagedAggregateState> single_state = ManagedAggregateState::Make(func);
+    func->update_batch_single_state(ctx, data_column->size(), &row_column, single_state->mutable_data());
+    auto result_column = Int64Column::create();
+    func->finalize_to_column(ctx, single_state->data(), result_column.get());
+    ASSERT_EQ(expected[0].cardinality() + expected[1].cardinality(), result_column->get_data()[0]);
+
+    // Merge the rows to two states by turns.
+    std::unique_ptr<ManagedAggregateState> state_0 = ManagedAggregateState::Make(func);
+    std::unique_ptr<ManagedAggregateState> state_1 = ManagedAggregateState::Make(func);
+    std::vector<AggDataPtr> states;
+    for (size_t i = 0; i < data_column->size(); ++i) {
+        states.push_back(i % 2 == 0 ? state_0->mutable_data() : state_1->mutable_data());
+    }
+    func->merge_batch(ctx, data_column->size(), 0, row_column, states.data());
+    result_column = Int64Column::create();
+    func->finalize_to_column(ctx, state_0->data(), result_column.get());
+    func->finalize_to_column(ctx, state_1->data(), result_column.get());
+    ASSERT_EQ(expected[0].cardinality(), result_column->get_data()[0]);
+    ASSERT_EQ(expected[1].cardinality(), result_column->get_data()[1]);
+}
+
 TEST_F(AggregateTest, test_bitmap_intersect) {
     const AggregateFunction* group_concat_function =
             get_aggregate_function("bitmap_intersect", TYPE_OBJECT, TYPE_OBJECT, false);
@@ -591,5 +591,47 @@ TEST_F(VectorizedArithmeticExprTest, constModN128Expr) {
     }
 }
 
+TEST_F(VectorizedArithmeticExprTest, fusedChainExpr) {
+    // (a * 4 + c) - d over 300 rows, which spans two blocks of the fused chain.
+    expr_node.type = gen_type_desc(TPrimitiveType::INT);
+
+    expr_node.opcode = TExprOpcode::MULTIPLY;
+    std::unique_ptr<Expr> mul(VectorizedArithmeticExprFactory::from_thrift(expr_node));
+    expr_node.opcode = TExprOpcode::ADD;
+    std::unique_ptr<Expr> add(VectorizedArithmeticExprFactory::from_thrift(expr_node));
+    expr_node.opcode = TExprOpcode::SUBTRACT;
+    std::unique_ptr<Expr> sub(VectorizedArithmeticExprFactory::from_thrift(expr_node));
+
+    MockVectorizedExpr<TYPE_INT> a(expr_node, 300, 3);
+    MockConstVectorizedExpr<TYPE_INT> b(expr_node, 4);
+    MockNullVectorizedExpr<TYPE_INT> c(expr_node, 300, 5);
+    MockVectorizedExpr<TYPE_INT> d(expr_node, 300, 2);
+
+    mul->_children.push_back(&a);
+    mul->_children.push_back(&b);
+    add->_children.push_back(mul.get());
+    add->_children.push_back(&c);
+    sub->_children.push_back(add.get());
+    sub->_children.push_back(&d);
+
+    ColumnPtr ptr = sub->evaluate(nullptr, nullptr);
+    ASSERT_TRUE(ptr->is_nullable());
+    ASSERT_EQ(300, ptr->size());
+
+    auto v = ColumnHelper::cast_to<TYPE_INT>(down_cast<NullableColumn*>(ptr.get())->data_column());
+    for (int j = 0; j < ptr->size(); ++j) {
+        // the rows of c are null in turn
+        ASSERT_EQ(j % 2 == 1, ptr->is_null(j));
+        if (!ptr->is_null(j)) {
+            ASSERT_EQ(15, v->get_data()[j]);
+        }
+    }
+
+    // only null
+    c.only_null = true;
+    ptr = sub->evaluate(nullptr, nullptr);
+    ASSERT_TRUE(ptr->only_null());
+}
+
 } // namespace vectorized
 } // namespace starrocks
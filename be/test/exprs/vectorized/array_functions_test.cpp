@@ -410,6 +410,33 @@ TEST_F(ArrayFunctionsTest, array_contains_no_null) {
 }
 
 // NOLINTNEXTLINE
+// NOLINTNEXTLINE
+TEST_F(ArrayFunctionsTest, array_contains_const_target) {
+    // array_contains([1,2,3], 2) : 1
+    // array_contains([], 2)      : 0
+    // array_contains([4,5], 2)   : 0
+    // array_contains([2], 2)     : 1
+    // array_contains([3,3,2], 2) : 1
+    auto array = ColumnHelper::create_column(TYPE_ARRAY_INT, false);
+    array->append_datum(DatumArray{(int32_t)1, (int32_t)2, (int32_t)3});
+    array->append_datum(Datum(DatumArray{}));
+    array->append_datum(DatumArray{(int32_t)4, (int32_t)5});
+    array->append_datum(DatumArray{(int32_t)2});
+    array->append_datum(DatumArray{(int32_t)3, (int32_t)3, (int32_t)2});
+
+    auto target = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false, true, 1);
+    target->append_datum(Datum((int32_t)2));
+    target->resize(5);
+
+    auto result = ArrayFunctions::array_contains(nullptr, {array, target});
+    ASSERT_EQ(5, result->size());
+    EXPECT_EQ(1, result->get(0).get_int8());
+    EXPECT_EQ(0, result->get(1).get_int8());
+    EXPECT_EQ(0, result->get(2).get_int8());
+    EXPECT_EQ(1, result->get(3).get_int8());
+    EXPECT_EQ(1, result->get(4).get_int8());
+}
+
 TEST_F(ArrayFunctionsTest, array_contains_has_null_element) {
     // array_contains([NULL], "abc")
     // array_contains(["abc", NULL], "abc")
@@ -7,6 +7,7 @@
 
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
+#include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/mock_vectorized_expr.h"
 
 namespace starrocks {
@@ -28,6 +29,33 @@ public:
     TExprNode expr_node;
 };
 
+static TExprNode slot_ref_node(TPrimitiveType::type type, SlotId slot_id) {
+    TExprNode node;
+    node.node_type = TExprNodeType::SLOT_REF;
+    node.type = gen_type_desc(type);
+    node.num_children = 0;
+    node.__set_slot_ref(TSlotRef());
+    node.slot_ref.slot_id = slot_id;
+    node.slot_ref.tuple_id = 0;
+    return node;
+}
+
+static ColumnPtr bool_column(const std::vector<uint8_t>& values, const std::vector<uint8_t>& nulls) {
+    auto data = BooleanColumn::create();
+    data->get_data().assign(values.begin(), values.end());
+    auto null_column = NullColumn::create();
+    null_column->get_data().assign(nulls.begin(), nulls.end());
+    return NullableColumn::create(data, null_column);
+}
+
+static ColumnPtr int_column(int32_t base, size_t size) {
+    auto column = Int32Column::create();
+    for (size_t i = 0; i < size; i++) {
+        column->append(base + static_cast<int32_t>(i));
+    }
+    return column;
+}
+
 TEST_F(VectorizedCaseExprTest, whenSliceCase) {
     expr_node.child_type = TPrimitiveType::VARCHAR;
     expr_node.type = gen_type_desc(TPrimitiveType::DATETIME);
@@ -428,5 +456,48 @@ TEST_F(VectorizedCaseExprTest, NoCaseWhenNullReturnIntElse) {
     }
 }
 
+// The THENs are evaluated only on the rows which select them.
+TEST_F(VectorizedCaseExprTest, evaluateBranchesLazily) {
+    expr_node.child_type = TPrimitiveType::BOOLEAN;
+    expr_node.type = gen_type_desc(TPrimitiveType::INT);
+    expr_node.case_expr.has_case_expr = false;
+    expr_node.case_expr.has_else_expr = true;
+    std::unique_ptr<Expr> expr(VectorizedCaseExprFactory::from_thrift(expr_node));
+
+    ColumnRef when1(slot_ref_node(TPrimitiveType::BOOLEAN, 1));
+    ColumnRef then1(slot_ref_node(TPrimitiveType::INT, 3));
+    ColumnRef when2(slot_ref_node(TPrimitiveType::BOOLEAN, 2));
+    ColumnRef then2(slot_ref_node(TPrimitiveType::INT, 4));
+    ColumnRef else_expr(slot_ref_node(TPrimitiveType::INT, 5));
+    expr->_children = {&when1, &then1, &when2, &then2, &else_expr};
+    ASSERT_TRUE(expr->open(nullptr, nullptr, FunctionContext::FRAGMENT_LOCAL).ok());
+
+    const size_t num_rows = 8;
+    Chunk chunk;
+    chunk.append_column(bool_column({1, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 1}), 1);
+    chunk.append_column(bool_column({1, 1, 1, 0, 0, 0, 0, 1}, {0, 0, 0, 0, 0, 0, 0, 0}), 2);
+    chunk.append_column(int_column(10, num_rows), 3);
+    auto then2_nulls = NullColumn::create(num_rows, 0);
+    then2_nulls->get_data()[2] = 1;
+    chunk.append_column(NullableColumn::create(int_column(20, num_rows), then2_nulls), 4);
+    chunk.append_column(int_column(30, num_rows), 5);
+
+    ColumnPtr ptr = expr->evaluate(nullptr, &chunk);
+    ASSERT_EQ(num_rows, ptr->size());
+    ASSERT_TRUE(ptr->is_nullable());
+    auto v = ColumnHelper::cast_to_raw<TYPE_INT>(ColumnHelper::as_raw_column<NullableColumn>(ptr)->data_column());
+    ASSERT_EQ(10, v->get_data()[0]);
+    ASSERT_EQ(21, v->get_data()[1]);
+    ASSERT_TRUE(ptr->is_null(2));
+    for (int j = 3; j < 7; ++j) {
+        ASSERT_FALSE(ptr->is_null(j));
+        ASSERT_EQ(30 + j, v->get_data()[j]);
+    }
+    // the null WHEN is not matched.
+    ASSERT_EQ(27, v->get_data()[7]);
+
+    expr->_children.clear();
+}
+
 } // namespace vectorized
 } // namespace starrocks
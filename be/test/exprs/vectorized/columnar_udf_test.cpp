@@ -0,0 +1,99 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/columnar_udf.h"
+
+#include <gtest/gtest.h>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+
+namespace starrocks::vectorized {
+
+// score(a, s) = a * 10 + length(s), NULL if any argument is NULL or the score is negative.
+static int32_t score(FunctionContext* context, int32_t num_args, const ArrowArray* const* args, ArrowArray* result) {
+    if (num_args != 2) {
+        context->set_error("score takes 2 arguments");
+        return 1;
+    }
+    const auto* a_valid = static_cast<const uint8_t*>(args[0]->buffers[0]);
+    const auto* a = static_cast<const int32_t*>(args[0]->buffers[1]);
+    const auto* s_valid = static_cast<const uint8_t*>(args[1]->buffers[0]);
+    const auto* offsets = static_cast<const int32_t*>(args[1]->buffers[1]);
+    auto* valid = const_cast<uint8_t*>(static_cast<const uint8_t*>(result->buffers[0]));
+    auto* values = const_cast<int64_t*>(static_cast<const int64_t*>(result->buffers[1]));
+    for (int64_t i = 0; i < result->length; i++) {
+        bool is_null = (a_valid != nullptr && !((a_valid[i / 8] >> (i % 8)) & 1)) ||
+                       (s_valid != nullptr && !((s_valid[i / 8] >> (i % 8)) & 1));
+        values[i] = is_null ? 0 : a[i] * 10 + (offsets[i + 1] - offsets[i]);
+        if (is_null || values[i] < 0) {
+            valid[i / 8] &= ~(1 << (i % 8));
+        }
+    }
+    return 0;
+}
+
+static int32_t fail(FunctionContext* context, int32_t num_args, const ArrowArray* const* args, ArrowArray* result) {
+    return 3;
+}
+
+TEST(ColumnarUdfTest, check_types) {
+    TypeDescriptor bigint(TYPE_BIGINT);
+    std::vector<TypeDescriptor> args{TypeDescriptor(TYPE_INT), TypeDescriptor::create_varchar_type(10)};
+    ASSERT_TRUE(ColumnarUdfCall::check_types(bigint, args).ok());
+    ASSERT_FALSE(ColumnarUdfCall::check_types(TypeDescriptor::create_varchar_type(10), args).ok());
+    args.emplace_back(TYPE_DATETIME);
+    ASSERT_FALSE(ColumnarUdfCall::check_types(bigint, args).ok());
+}
+
+TEST(ColumnarUdfTest, call) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    std::vector<TypeDescriptor> arg_types{TypeDescriptor(TYPE_INT), TypeDescriptor::create_varchar_type(10)};
+
+    auto a = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    auto s = BinaryColumn::create();
+    const int32_t a_values[] = {1, 2, 3, -1, 5, 6, 7, 8, 9, 10};
+    const char* s_values[] = {"", "a", "bb", "ccc", "", "", "", "", "", "abcd"};
+    const size_t num_rows = 10;
+    for (size_t i = 0; i < num_rows; i++) {
+        if (i == 4) {
+            a->append_nulls(1);
+        } else {
+            a->append_datum(Datum(a_values[i]));
+        }
+        s->append(Slice(s_values[i]));
+    }
+
+    TypeDescriptor bigint(TYPE_BIGINT);
+    ColumnPtr result = ColumnarUdfCall::call(score, ctx.get(), bigint, arg_types, {a, s}, num_rows);
+    ASSERT_FALSE(ctx->has_error());
+    ASSERT_EQ(num_rows, result->size());
+    ASSERT_TRUE(result->is_nullable());
+    for (size_t i = 0; i < num_rows; i++) {
+        if (i == 3 || i == 4) {
+            ASSERT_TRUE(result->is_null(i)) << i;
+        } else {
+            ASSERT_EQ(static_cast<int64_t>(a_values[i] * 10 + strlen(s_values[i])), result->get(i).get_int64()) << i;
+        }
+    }
+
+    // a constant argument is unfolded to the rows.
+    auto c = ColumnHelper::create_const_column<TYPE_INT>(4, num_rows);
+    result = ColumnarUdfCall::call(score, ctx.get(), bigint, arg_types, {c, s}, num_rows);
+    ASSERT_FALSE(result->has_null());
+    ASSERT_EQ(43, result->get(3).get_int64());
+    ASSERT_EQ(44, result->get(9).get_int64());
+}
+
+TEST(ColumnarUdfTest, call_error) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    std::vector<TypeDescriptor> arg_types{TypeDescriptor(TYPE_INT)};
+    auto a = Int32Column::create();
+    a->append(1);
+    ColumnPtr result = ColumnarUdfCall::call(fail, ctx.get(), TypeDescriptor(TYPE_BIGINT), arg_types, {a}, 1);
+    ASSERT_TRUE(ctx->has_error());
+    ASSERT_TRUE(result->only_null());
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,111 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/common_sub_expr_eliminator.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/primitive_type.h"
+
+namespace starrocks::vectorized {
+
+class CommonSubExprEliminatorTest : public ::testing::Test {
+public:
+    static TExprNode slot_ref(SlotId slot_id) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = gen_type_desc(TPrimitiveType::INT);
+        node.num_children = 0;
+        node.output_scale = -1;
+        node.__set_slot_ref(TSlotRef());
+        node.slot_ref.slot_id = slot_id;
+        node.slot_ref.tuple_id = 0;
+        return node;
+    }
+
+    static TExprNode int_literal(int64_t value) {
+        TExprNode node;
+        node.node_type = TExprNodeType::INT_LITERAL;
+        node.type = gen_type_desc(TPrimitiveType::INT);
+        node.num_children = 0;
+        node.output_scale = -1;
+        node.__set_int_literal(TIntLiteral());
+        node.int_literal.value = value;
+        return node;
+    }
+
+    static TExprNode function(const std::string& name, int num_children) {
+        TExprNode node;
+        node.node_type = TExprNodeType::FUNCTION_CALL;
+        node.type = gen_type_desc(TPrimitiveType::INT);
+        node.num_children = num_children;
+        node.output_scale = -1;
+        node.__set_fn(TFunction());
+        node.fn.name.function_name = name;
+        return node;
+    }
+
+    static TExpr expr(std::vector<TExprNode> nodes) {
+        TExpr expr;
+        expr.nodes = std::move(nodes);
+        return expr;
+    }
+
+    static bool is_slot_ref(const TExprNode& node, SlotId slot_id) {
+        return node.node_type == TExprNodeType::SLOT_REF && node.slot_ref.slot_id == slot_id;
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(CommonSubExprEliminatorTest, test_eliminate) {
+    // add(f(slot1, slot2), 1), mul(f(slot1, slot2), g(f(slot1, slot2))), common: h(g(f(slot1, slot2)))
+    std::vector<TExpr> exprs;
+    exprs.emplace_back(expr({function("add", 2), function("f", 2), slot_ref(1), slot_ref(2), int_literal(1)}));
+    exprs.emplace_back(expr({function("mul", 2), function("f", 2), slot_ref(1), slot_ref(2), function("g", 1),
+                             function("f", 2), slot_ref(1), slot_ref(2)}));
+    CommonSubExprEliminator::CommonExprs common_exprs;
+    common_exprs.emplace_back(
+            5, expr({function("h", 1), function("g", 1), function("f", 2), slot_ref(1), slot_ref(2)}));
+
+    ASSERT_TRUE(CommonSubExprEliminator::eliminate(&exprs, &common_exprs, 10, 0).ok());
+
+    // g(f(slot1, slot2)) is extracted first into slot 10, then f(slot1, slot2) into slot 11, and each common
+    // expression comes after the ones it refers to.
+    ASSERT_EQ(3, common_exprs.size());
+    ASSERT_EQ(11, common_exprs[0].first);
+    ASSERT_EQ(3, common_exprs[0].second.nodes.size());
+    ASSERT_EQ("f", common_exprs[0].second.nodes[0].fn.name.function_name);
+    ASSERT_EQ(10, common_exprs[1].first);
+    ASSERT_EQ(2, common_exprs[1].second.nodes.size());
+    ASSERT_EQ("g", common_exprs[1].second.nodes[0].fn.name.function_name);
+    ASSERT_TRUE(is_slot_ref(common_exprs[1].second.nodes[1], 11));
+    ASSERT_EQ(5, common_exprs[2].first);
+    ASSERT_EQ(2, common_exprs[2].second.nodes.size());
+    ASSERT_TRUE(is_slot_ref(common_exprs[2].second.nodes[1], 10));
+
+    ASSERT_EQ(3, exprs[0].nodes.size());
+    ASSERT_TRUE(is_slot_ref(exprs[0].nodes[1], 11));
+    ASSERT_EQ(3, exprs[1].nodes.size());
+    ASSERT_TRUE(is_slot_ref(exprs[1].nodes[1], 11));
+    ASSERT_TRUE(is_slot_ref(exprs[1].nodes[2], 10));
+}
+
+// NOLINTNEXTLINE
+TEST_F(CommonSubExprEliminatorTest, test_not_eliminate) {
+    // the roots, the constants and the nondeterministic subexpressions are kept.
+    std::vector<TExpr> exprs;
+    exprs.emplace_back(expr({function("f", 1), slot_ref(1)}));
+    exprs.emplace_back(expr({function("f", 1), slot_ref(1)}));
+    exprs.emplace_back(expr({function("add", 2), function("g", 1), int_literal(1), slot_ref(1)}));
+    exprs.emplace_back(expr({function("mul", 2), function("g", 1), int_literal(1), slot_ref(2)}));
+    exprs.emplace_back(expr({function("add", 2), function("rand", 1), slot_ref(1), slot_ref(2)}));
+    exprs.emplace_back(expr({function("mul", 2), function("rand", 1), slot_ref(1), slot_ref(2)}));
+    std::vector<TExpr> origin_exprs = exprs;
+    CommonSubExprEliminator::CommonExprs common_exprs;
+
+    ASSERT_TRUE(CommonSubExprEliminator::eliminate(&exprs, &common_exprs, 10, 0).ok());
+
+    ASSERT_TRUE(common_exprs.empty());
+    ASSERT_TRUE(origin_exprs == exprs);
+}
+
+} // namespace starrocks::vectorized
@@ -2587,4 +2587,28 @@ TEST_F(DecimalBinaryFunctionTest, test_decimal64p18s15_sub_decimal64p18s15_eq_de
     test_const_const<TYPE_DECIMAL64, SubOp, true>(test_cases, 18, 15, 18, 15, 18, 15);
     test_const_const<TYPE_DECIMAL64, SubOp, false>(test_cases, 18, 15, 18, 15, 18, 15);
 }
+// The small decimal128 values are divided in int64, unless any of them does not fit in it.
+TEST_F(DecimalBinaryFunctionTest, test_decimal128p20s2_div_decimal128p10s2_eq_decimal128p38s8) {
+    DecimalTestCaseArray test_cases = {{"10.00", "3.00", "3.33333333"},
+                                       {"-10.00", "3.00", "-3.33333333"},
+                                       {"2.00", "3.00", "0.66666667"},
+                                       {"-2.00", "3.00", "-0.66666667"},
+                                       {"1.00", "-8.00", "-0.12500000"},
+                                       {"123456.78", "0.01", "12345678"},
+                                       {"5.00", "0", "0"},
+                                       {"0", "7.00", "0"},
+                                       {"-99999.99", "99999999.99", "-0.00100000"}};
+    for (int i = 0; i < 2; i++) {
+        if (i == 1) {
+            test_cases.emplace_back("123456789012345678.00", "2.00", "61728394506172839");
+        }
+        test_vector_vector<TYPE_DECIMAL128, DivOp, true>(test_cases, 20, 2, 10, 2, 38, 8);
+        test_vector_vector<TYPE_DECIMAL128, DivOp, false>(test_cases, 20, 2, 10, 2, 38, 8);
+        test_vector_const<TYPE_DECIMAL128, DivOp, true>(test_cases, 20, 2, 10, 2, 38, 8);
+        test_vector_const<TYPE_DECIMAL128, DivOp, false>(test_cases, 20, 2, 10, 2, 38, 8);
+        test_const_vector<TYPE_DECIMAL128, DivOp, true>(test_cases, 20, 2, 10, 2, 38, 8);
+        test_const_vector<TYPE_DECIMAL128, DivOp, false>(test_cases, 20, 2, 10, 2, 38, 8);
+    }
+}
+
 } // namespace starrocks::vectorized
\ No newline at end of file
@@ -421,6 +421,47 @@ TEST_F(EncryptionFunctionsTest, aes_decryptConstAllTest) {
     }
 }
 
+TEST_F(EncryptionFunctionsTest, aes_reuseCipherTest) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    ASSERT_TRUE(EncryptionFunctions::aes_prepare(ctx.get(), FunctionContext::THREAD_LOCAL).ok());
+
+    Columns columns;
+    auto plain = BinaryColumn::create();
+    auto text = BinaryColumn::create();
+
+    // the cipher of the thread is initialized again when the key changes.
+    std::string plains[] = {"key", "kewfewy", "apacheejian", "93024jdfojdfojfwjf23ro23rrdvvj"};
+    std::string texts[] = {"key", "key", "naixuex", "key"};
+    for (int j = 0; j < sizeof(plains) / sizeof(plains[0]); ++j) {
+        plain->append(plains[j]);
+        text->append(texts[j]);
+    }
+
+    columns.emplace_back(plain);
+    columns.emplace_back(text);
+    ColumnPtr encrypted = EncryptionFunctions::aes_encrypt(ctx.get(), columns);
+    ASSERT_TRUE(EncryptionFunctions::aes_close(ctx.get(), FunctionContext::THREAD_LOCAL).ok());
+
+    columns.clear();
+    columns.emplace_back(encrypted);
+    ColumnPtr result = StringFunctions::hex_string(ctx.get(), columns);
+    auto v = ColumnHelper::cast_to<TYPE_VARCHAR>(result);
+    ASSERT_EQ("CEF5BE724B7B98B63216C95A7BD681C9", v->get_data()[0].to_string());
+    ASSERT_EQ("09529C15ECF0FC27073310DCEB76FAF4", v->get_data()[2].to_string());
+
+    ASSERT_TRUE(EncryptionFunctions::aes_prepare(ctx.get(), FunctionContext::THREAD_LOCAL).ok());
+    columns.clear();
+    columns.emplace_back(encrypted);
+    columns.emplace_back(text);
+    result = EncryptionFunctions::aes_decrypt(ctx.get(), columns);
+    ASSERT_TRUE(EncryptionFunctions::aes_close(ctx.get(), FunctionContext::THREAD_LOCAL).ok());
+
+    v = ColumnHelper::cast_to<TYPE_VARCHAR>(result);
+    for (int j = 0; j < sizeof(plains) / sizeof(plains[0]); ++j) {
+        ASSERT_EQ(plains[j], v->get_data()[j].to_string());
+    }
+}
+
 TEST_F(EncryptionFunctionsTest, from_base64GeneralTest) {
     std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
     Columns columns;
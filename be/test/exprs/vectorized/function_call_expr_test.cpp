@@ -6,10 +6,13 @@
 #include <gtest/gtest.h>
 #include <math.h>
 
+#include <algorithm>
+
 #include "butil/time.h"
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
 #include "exprs/vectorized/cast_expr.h"
+#include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/mock_vectorized_expr.h"
 
 namespace starrocks {
@@ -270,5 +273,67 @@ TEST_F(VectorizedFunctionCallExprTest, prepareFaileCase) {
     exprContext.close(nullptr);
 }
 
+// The function of a low cardinality string column is evaluated on the distinct strings.
+TEST_F(VectorizedFunctionCallExprTest, lowCardinalityStringTest) {
+    TFunction function;
+    TFunctionName functionName;
+    functionName.__set_db_name("db");
+    functionName.__set_function_name("upper");
+
+    function.__set_name(functionName);
+    function.__set_binary_type(TFunctionBinaryType::BUILTIN);
+
+    std::vector<TTypeDesc> vec;
+    function.__set_arg_types(vec);
+    function.__set_has_var_args(false);
+    function.__set_fid(30150);
+
+    expr_node.__set_fn(function);
+    expr_node.type = gen_type_desc(TPrimitiveType::VARCHAR);
+
+    VectorizedFunctionCallExpr expr(expr_node);
+
+    TExprNode slot_node;
+    slot_node.node_type = TExprNodeType::SLOT_REF;
+    slot_node.type = gen_type_desc(TPrimitiveType::VARCHAR);
+    slot_node.num_children = 0;
+    slot_node.__set_slot_ref(TSlotRef());
+    slot_node.slot_ref.slot_id = 1;
+    slot_node.slot_ref.tuple_id = 0;
+    ColumnRef col1(slot_node);
+
+    expr.add_child(&col1);
+
+    ExprContext exprContext(&expr);
+    exprContext._is_clone = true;
+    starrocks::RowDescriptor rd;
+
+    WARN_IF_ERROR(expr.prepare(nullptr, rd, &exprContext), "");
+    WARN_IF_ERROR(expr.open(nullptr, &exprContext, FunctionContext::FunctionStateScope::THREAD_LOCAL), "");
+
+    const std::vector<std::string> words = {"cn", "us", "de"};
+    // the strings of the first chunk are evaluated once per distinct string, the second one has too many.
+    for (size_t num_words : {words.size(), size_t(0)}) {
+        auto column = BinaryColumn::create();
+        for (size_t i = 0; i < 256; i++) {
+            column->append(num_words > 0 ? words[i % num_words] : std::to_string(i));
+        }
+        Chunk chunk;
+        chunk.append_column(column, 1);
+
+        ColumnPtr result = expr.evaluate(&exprContext, &chunk);
+        ASSERT_EQ(256, result->size());
+        ASSERT_FALSE(result->is_nullable());
+        auto value = ColumnHelper::cast_to<TYPE_VARCHAR>(result);
+        for (size_t i = 0; i < 256; i++) {
+            std::string expected = num_words > 0 ? words[i % num_words] : std::to_string(i);
+            std::transform(expected.begin(), expected.end(), expected.begin(), ::toupper);
+            ASSERT_EQ(expected, value->get_slice(i).to_string());
+        }
+    }
+
+    exprContext.close(nullptr);
+}
+
 } // namespace vectorized
 } // namespace starrocks
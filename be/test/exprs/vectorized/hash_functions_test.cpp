@@ -70,6 +70,31 @@ TEST_F(HashFunctionsTest, hashTest) {
     }
 }
 
+TEST_F(HashFunctionsTest, hashNullableTest) {
+    Columns columns;
+    auto tc1 = BinaryColumn::create();
+    tc1->append("test1234567");
+    tc1->append("test1234567");
+    auto null1 = NullColumn::create();
+    null1->append(0);
+    null1->append(1);
+
+    auto tc2 = BinaryColumn::create();
+    tc2->append("asdf213");
+
+    columns.emplace_back(NullableColumn::create(tc1, null1));
+    columns.emplace_back(ConstColumn::create(tc2, 2));
+
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    ColumnPtr result = HashFunctions::murmur_hash3_32(ctx.get(), columns);
+
+    ASSERT_EQ(2, result->size());
+    ASSERT_FALSE(result->is_null(0));
+    ASSERT_TRUE(result->is_null(1));
+    auto v = ColumnHelper::cast_to<TYPE_INT>(ColumnHelper::as_raw_column<NullableColumn>(result)->data_column());
+    ASSERT_EQ(-500290079, v->get_data()[0]);
+}
+
 TEST_F(HashFunctionsTest, emptyTest) {
     uint32_t h3 = 123456;
 
@@ -5,6 +5,7 @@
 
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
+#include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/condition_expr.h"
 #include "exprs/vectorized/mock_vectorized_expr.h"
 
@@ -27,6 +28,33 @@ public:
     TExprNode expr_node;
 };
 
+static TExprNode slot_ref_node(TPrimitiveType::type type, SlotId slot_id) {
+    TExprNode node;
+    node.node_type = TExprNodeType::SLOT_REF;
+    node.type = gen_type_desc(type);
+    node.num_children = 0;
+    node.__set_slot_ref(TSlotRef());
+    node.slot_ref.slot_id = slot_id;
+    node.slot_ref.tuple_id = 0;
+    return node;
+}
+
+static ColumnPtr bool_column(const std::vector<uint8_t>& values, const std::vector<uint8_t>& nulls) {
+    auto data = BooleanColumn::create();
+    data->get_data().assign(values.begin(), values.end());
+    auto null_column = NullColumn::create();
+    null_column->get_data().assign(nulls.begin(), nulls.end());
+    return NullableColumn::create(data, null_column);
+}
+
+static ColumnPtr int_column(int32_t base, size_t size) {
+    auto column = Int32Column::create();
+    for (size_t i = 0; i < size; i++) {
+        column->append(base + static_cast<int32_t>(i));
+    }
+    return column;
+}
+
 TEST_F(VectorizedIfExprTest, ifConstTrue) {
     auto expr = VectorizedConditionExprFactory::create_if_expr(expr_node);
     std::unique_ptr<Expr> expr_ptr(expr);
@@ -100,5 +128,33 @@ TEST_F(VectorizedIfExprTest, ifNull) {
     }
 }
 
+// The branch selected by a few rows is evaluated only on them.
+TEST_F(VectorizedIfExprTest, evaluateBranchesLazily) {
+    expr_node.type = gen_type_desc(TPrimitiveType::INT);
+    std::unique_ptr<Expr> expr(VectorizedConditionExprFactory::create_if_expr(expr_node));
+
+    ColumnRef bol(slot_ref_node(TPrimitiveType::BOOLEAN, 1));
+    ColumnRef col1(slot_ref_node(TPrimitiveType::INT, 2));
+    ColumnRef col2(slot_ref_node(TPrimitiveType::INT, 3));
+    expr->_children = {&bol, &col1, &col2};
+    ASSERT_TRUE(expr->open(nullptr, nullptr, FunctionContext::FRAGMENT_LOCAL).ok());
+
+    const size_t num_rows = 8;
+    Chunk chunk;
+    chunk.append_column(bool_column({0, 1, 0, 0, 0, 0, 1, 1}, {0, 0, 0, 0, 0, 0, 0, 1}), 1);
+    chunk.append_column(int_column(10, num_rows), 2);
+    chunk.append_column(int_column(20, num_rows), 3);
+
+    ColumnPtr ptr = expr->evaluate(nullptr, &chunk);
+    ASSERT_EQ(num_rows, ptr->size());
+    ASSERT_FALSE(ptr->is_nullable());
+    auto v = ColumnHelper::cast_to_raw<TYPE_INT>(ptr);
+    for (int j = 0; j < num_rows; ++j) {
+        ASSERT_EQ(j == 1 || j == 6 ? 10 + j : 20 + j, v->get_data()[j]);
+    }
+
+    expr->_children.clear();
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -9,6 +9,7 @@
 #include "column/binary_column.h"
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
+#include "exprs/vectorized/in_const_predicate.hpp"
 #include "exprs/vectorized/mock_vectorized_expr.h"
 
 namespace starrocks {
@@ -233,5 +234,58 @@ TEST_F(VectorizedInPredicateTest, sliceNotInNull) {
     }
 }
 
+template <PrimitiveType Type>
+static void test_in_lookup(TExprNode expr_node, const std::vector<RunTimeCppType<Type>>& values,
+                           RunTimeCppType<Type> in_value, RunTimeCppType<Type> not_in_value,
+                           typename VectorizedInConstPredicate<Type>::LookupMode expected_mode) {
+    expr_node.opcode = TExprOpcode::FILTER_IN;
+    expr_node.in_predicate.is_not_in = false;
+    auto expr = std::unique_ptr<Expr>(VectorizedInPredicateFactory::from_thrift(expr_node));
+
+    MockMultiVectorizedExpr<Type> col1(expr_node, 10, in_value, not_in_value);
+    expr->_children.push_back(&col1);
+    std::vector<std::unique_ptr<MockConstVectorizedExpr<Type>>> value_exprs;
+    for (const auto& value : values) {
+        value_exprs.emplace_back(std::make_unique<MockConstVectorizedExpr<Type>>(expr_node, value));
+        expr->_children.push_back(value_exprs.back().get());
+    }
+
+    starrocks::RowDescriptor rd;
+    ASSERT_TRUE(expr->prepare(nullptr, rd, nullptr).ok());
+    ASSERT_TRUE(expr->open(nullptr, nullptr, FunctionContext::FunctionStateScope::THREAD_LOCAL).ok());
+    auto* pred = down_cast<VectorizedInConstPredicate<Type>*>(expr.get());
+    ASSERT_EQ(expected_mode, pred->lookup_mode());
+
+    ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+    auto v = ColumnHelper::cast_to_raw<TYPE_BOOLEAN>(ptr);
+    for (int j = 0; j < ptr->size(); ++j) {
+        ASSERT_EQ(j % 2 == 0, v->get_data()[j]);
+    }
+    expr->_children.clear();
+}
+
+TEST_F(VectorizedInPredicateTest, intInLookupModes) {
+    using LookupMode = VectorizedInConstPredicate<TYPE_BIGINT>::LookupMode;
+    expr_node.child_type = TPrimitiveType::BIGINT;
+    expr_node.type = gen_type_desc(TPrimitiveType::BIGINT);
+
+    // the values in a small range, even the negative ones
+    test_in_lookup<TYPE_BIGINT>(expr_node, {-3, 7, 1000}, -3, -4, LookupMode::RANGE_SET);
+    test_in_lookup<TYPE_BIGINT>(expr_node, {-3, 7, 1000}, 1000, 1001, LookupMode::RANGE_SET);
+    test_in_lookup<TYPE_BIGINT>(expr_node, {std::numeric_limits<int64_t>::max()},
+                                std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(),
+                                LookupMode::RANGE_SET);
+
+    // a few values in a wide range
+    test_in_lookup<TYPE_BIGINT>(expr_node, {1, 1L << 40, -(1L << 50)}, 1L << 40, 2, LookupMode::SMALL_LIST);
+
+    // many values in a wide range
+    std::vector<int64_t> values;
+    for (int i = 0; i < 20; ++i) {
+        values.push_back(i * (1L << 30));
+    }
+    test_in_lookup<TYPE_BIGINT>(expr_node, values, 3L << 30, 1, LookupMode::HASH_SET);
+}
+
 } // namespace vectorized
 } // namespace starrocks
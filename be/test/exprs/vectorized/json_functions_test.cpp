@@ -6,7 +6,9 @@
 #include <gtest/gtest.h>
 
 #include "butil/time.h"
+#include "column/object_column.h"
 #include "exprs/vectorized/mock_vectorized_expr.h"
+#include "util/json_value.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -236,5 +238,105 @@ TEST_F(JsonFunctionsTest, get_json_emptyTest) {
     }
 }
 
+TEST_F(JsonFunctionsTest, get_json_string_reuse_document_test) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    Columns columns;
+    auto strings = BinaryColumn::create();
+    auto strings2 = BinaryColumn::create();
+
+    // the paths of the rows are cached and the document is reused, the values of the last row must not leak.
+    std::string values[] = {"{\"k1\":{\"a\":1}}", "{\"k1\":[1, 2]}", "not a json", "{\"k2\":\"v\"}",
+                            "{\"k2\":\"x\"}", "{\"k2\":\"y\"}"};
+    std::string strs[] = {"$.k1", "$.k1", "$.k1", "$.k2", "", "$.k2"};
+    std::string expects[] = {"{\"a\":1}", "[1,2]", "", "v", "", "y"};
+    bool nulls[] = {false, false, true, false, true, false};
+
+    for (int j = 0; j < sizeof(values) / sizeof(values[0]); ++j) {
+        strings->append(values[j]);
+        strings2->append(strs[j]);
+    }
+
+    columns.emplace_back(strings);
+    columns.emplace_back(strings2);
+
+    ctx.get()->impl()->set_constant_columns(columns);
+    ASSERT_TRUE(JsonFunctions::json_path_prepare(ctx.get(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+
+    ColumnPtr result = JsonFunctions::get_json_string(ctx.get(), columns);
+
+    auto nullable = ColumnHelper::as_column<NullableColumn>(result);
+    auto v = ColumnHelper::cast_to<TYPE_VARCHAR>(nullable->data_column());
+
+    for (int j = 0; j < sizeof(values) / sizeof(values[0]); ++j) {
+        ASSERT_EQ(nulls[j], nullable->is_null(j));
+        if (!nulls[j]) {
+            ASSERT_EQ(expects[j], v->get_data()[j].to_string());
+        }
+    }
+
+    ASSERT_TRUE(JsonFunctions::json_path_close(ctx.get(),
+                                               FunctionContext::FunctionContext::FunctionStateScope::FRAGMENT_LOCAL)
+                        .ok());
+}
+
+TEST_F(JsonFunctionsTest, get_json_from_json_column_test) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    Columns columns;
+    auto jsons = JsonColumn::create();
+    auto paths = BinaryColumn::create();
+
+    std::string values[] = {"{\"k1\":1, \"k2\":{\"k3\":[1, 2.5]}}", "{\"k1\":\"v1\"}", "{\"k1\":3000000000}",
+                            "[{\"k1\":\"v1\"}, {\"k1\":\"v2\"}]", "{\"k2\":{\"k3\":[1, 2.5]}}", "{\"k1\":null}"};
+    std::string strs[] = {"$.k1", "$.k1", "$.k1", "$.k1", "$.k2.k3[1]", "$.k1"};
+
+    for (int j = 0; j < sizeof(values) / sizeof(values[0]); ++j) {
+        JsonValue value;
+        ASSERT_TRUE(JsonValue::parse(values[j], &value).ok());
+        jsons->append(std::move(value));
+        paths->append(strs[j]);
+    }
+
+    columns.emplace_back(jsons);
+    columns.emplace_back(paths);
+
+    ctx.get()->impl()->set_constant_columns(columns);
+    ASSERT_TRUE(JsonFunctions::json_path_prepare(ctx.get(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+
+    {
+        ColumnPtr result = JsonFunctions::get_json_int(ctx.get(), columns);
+        auto nullable = ColumnHelper::as_column<NullableColumn>(result);
+        auto v = ColumnHelper::cast_to<TYPE_INT>(nullable->data_column());
+        ASSERT_EQ(1, v->get_data()[0]);
+        for (int j = 1; j < sizeof(values) / sizeof(values[0]); ++j) {
+            ASSERT_TRUE(nullable->is_null(j));
+        }
+    }
+
+    {
+        ColumnPtr result = JsonFunctions::get_json_double(ctx.get(), columns);
+        auto nullable = ColumnHelper::as_column<NullableColumn>(result);
+        auto v = ColumnHelper::cast_to<TYPE_DOUBLE>(nullable->data_column());
+        ASSERT_EQ(1, v->get_data()[0]);
+        ASSERT_EQ(2.5, v->get_data()[4]);
+        ASSERT_TRUE(nullable->is_null(2));
+    }
+
+    {
+        // the array of the objects are matched by the rapidjson document of the json text.
+        ColumnPtr result = JsonFunctions::get_json_string(ctx.get(), columns);
+        auto nullable = ColumnHelper::as_column<NullableColumn>(result);
+        auto v = ColumnHelper::cast_to<TYPE_VARCHAR>(nullable->data_column());
+        std::string expects[] = {"1", "v1", "3000000000", "[\"v1\",\"v2\"]", "2.5"};
+        for (int j = 0; j < sizeof(expects) / sizeof(expects[0]); ++j) {
+            ASSERT_EQ(expects[j], v->get_data()[j].to_string());
+        }
+        ASSERT_TRUE(nullable->is_null(5));
+    }
+
+    ASSERT_TRUE(JsonFunctions::json_path_close(ctx.get(),
+                                               FunctionContext::FunctionContext::FunctionStateScope::FRAGMENT_LOCAL)
+                        .ok());
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -404,5 +404,87 @@ TEST_F(LikeTest, rowsPatternRegex) {
                         .ok());
 }
 
+TEST_F(LikeTest, literalConstPatternLike) {
+    auto context = FunctionContext::create_test_context();
+    std::unique_ptr<FunctionContext> ctx(context);
+    Columns columns;
+
+    auto str = BinaryColumn::create();
+    auto null = NullColumn::create();
+    // the longest literal "test" of the pattern filters the values before the regex.
+    auto pattern = ColumnHelper::create_const_column<TYPE_VARCHAR>("1_test%9", 1);
+
+    for (int j = 0; j < 20; ++j) {
+        str->append(std::to_string(j) + "test" + std::to_string(j));
+        null->append(j == 11);
+    }
+
+    columns.push_back(NullableColumn::create(str, null));
+    columns.push_back(pattern);
+
+    context->impl()->set_constant_columns(columns);
+
+    ASSERT_TRUE(LikePredicate::like_prepare(context, FunctionContext::FunctionStateScope::THREAD_LOCAL).ok());
+
+    auto result = LikePredicate::like(context, columns);
+
+    ASSERT_TRUE(result->is_nullable());
+
+    auto v = ColumnHelper::cast_to<TYPE_BOOLEAN>(ColumnHelper::as_raw_column<NullableColumn>(result)->data_column());
+
+    for (int l = 0; l < 20; ++l) {
+        ASSERT_EQ(l == 11, result->is_null(l));
+        if (l == 19) {
+            ASSERT_TRUE(v->get_data()[l]);
+        } else if (l != 11) {
+            ASSERT_FALSE(v->get_data()[l]);
+        }
+    }
+
+    ASSERT_TRUE(LikePredicate::like_close(context, FunctionContext::FunctionContext::FunctionStateScope::THREAD_LOCAL)
+                        .ok());
+}
+
+TEST_F(LikeTest, extractLikeLiteral) {
+    ASSERT_EQ("test", LikePredicate::extract_like_literal("a%test_bc", '\\'));
+    ASSERT_EQ("b%c", LikePredicate::extract_like_literal("a_b\\%c%", '\\'));
+    ASSERT_EQ("", LikePredicate::extract_like_literal("%_%", '\\'));
+}
+
+TEST_F(LikeTest, likePatternSet) {
+    std::unique_ptr<LikePatternSet> like_set;
+    ASSERT_TRUE(LikePatternSet::create({"%error%", "warn_", "1%test%9"}, true, &like_set).ok());
+
+    auto str = BinaryColumn::create();
+    auto null = NullColumn::create();
+    std::vector<std::string> values = {"an error occurs", "warn1", "warn12", "1 test 9", "1 test 8", "info", "error"};
+    for (const auto& value : values) {
+        str->append(value);
+        null->append(value == "info");
+    }
+
+    auto result = like_set->match(NullableColumn::create(str, null));
+    ASSERT_TRUE(result->is_nullable());
+    auto v = ColumnHelper::cast_to<TYPE_BOOLEAN>(ColumnHelper::as_raw_column<NullableColumn>(result)->data_column());
+    std::vector<uint8_t> expects = {true, true, false, true, false, false, true};
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(values[i] == "info", result->is_null(i));
+        if (!result->is_null(i)) {
+            ASSERT_EQ(expects[i], v->get_data()[i]) << values[i];
+        }
+    }
+
+    std::unique_ptr<LikePatternSet> regex_set;
+    ASSERT_TRUE(LikePatternSet::create({"^warn\\d$", "occ"}, false, &regex_set).ok());
+    result = regex_set->match(str);
+    v = ColumnHelper::cast_to<TYPE_BOOLEAN>(result);
+    expects = {true, true, false, false, false, false, false};
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(expects[i], v->get_data()[i]) << values[i];
+    }
+
+    ASSERT_FALSE(LikePatternSet::create({"(", "a"}, false, &regex_set).ok());
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -31,6 +31,30 @@ TEST_F(RuntimeFilterTest, TestSimdBlockFilter) {
     }
 }
 
+TEST_F(RuntimeFilterTest, TestSimdBlockFilterFpp) {
+    auto hash = [](uint64_t i) { return i * 0x9E3779B97F4A7C15ULL; };
+    const size_t num_keys = 10000;
+    SimdBlockFilter bf0;
+    bf0.init(num_keys);
+    for (uint64_t i = 0; i < num_keys; i++) {
+        bf0.insert_hash(hash(i));
+    }
+    size_t num_false_positives = 0;
+    const size_t num_probes = 100000;
+    for (uint64_t i = num_keys; i < num_keys + num_probes; i++) {
+        num_false_positives += bf0.test_hash(hash(i));
+    }
+    EXPECT_LE(num_false_positives, num_probes * config::runtime_filter_bloom_filter_fpp);
+
+    // a lower fpp takes more space.
+    double fpp = config::runtime_filter_bloom_filter_fpp;
+    config::runtime_filter_bloom_filter_fpp = 0.001;
+    SimdBlockFilter bf1;
+    bf1.init(num_keys);
+    config::runtime_filter_bloom_filter_fpp = fpp;
+    EXPECT_GT(bf1.max_serialized_size(), bf0.max_serialized_size());
+}
+
 TEST_F(RuntimeFilterTest, TestSimdBlockFilterSerialize) {
     SimdBlockFilter bf0;
     bf0.init(100);
@@ -327,5 +351,41 @@ TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterMerge3) {
     EXPECT_EQ(pbf0->max_value(), Slice("dd", 2));
 }
 
+TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterConcatMerged) {
+    ObjectPool pool;
+    // partition i has values [i * 100, i * 100 + 100)
+    std::vector<RuntimeBloomFilter<TYPE_INT>> partitions(3);
+    for (int p = 0; p < 3; p++) {
+        partitions[p].init(100);
+        for (int i = p * 100; i < p * 100 + 100; i++) {
+            partitions[p].insert(&i);
+        }
+    }
+
+    // an intermediate merge node concatenates partition 0 and 1, and serializes it to send.
+    JoinRuntimeFilter* group = partitions[0].create_empty(&pool);
+    group->concat(&partitions[0]);
+    group->concat(&partitions[1]);
+    size_t max_size = RuntimeFilterHelper::max_runtime_filter_serialized_size(group);
+    std::string buf(max_size, 0);
+    size_t actual_size = RuntimeFilterHelper::serialize_runtime_filter(group, (uint8_t*)buf.data());
+    JoinRuntimeFilter* received = nullptr;
+    RuntimeFilterHelper::deserialize_runtime_filter(&pool, &received, (const uint8_t*)buf.data(), actual_size);
+    ASSERT_NE(received, nullptr);
+
+    // the root merge node concatenates the merged group and partition 2.
+    JoinRuntimeFilter* total = received->create_empty(&pool);
+    total->concat(received);
+    total->concat(&partitions[2]);
+    auto* bf = static_cast<RuntimeBloomFilter<TYPE_INT>*>(total);
+    EXPECT_EQ(bf->min_value(), 0);
+    EXPECT_EQ(bf->max_value(), 299);
+    for (int p = 0; p < 3; p++) {
+        for (int i = p * 100; i < p * 100 + 100; i++) {
+            EXPECT_TRUE(bf->test_data_with_hash(i, p));
+        }
+    }
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -1070,6 +1070,31 @@ PARALLEL_TEST(VecStringFunctionsTest, utf8LengthChineseTest) {
     }
 }
 
+PARALLEL_TEST(VecStringFunctionsTest, utf8LengthMixedTest) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    Columns columns;
+    auto str = BinaryColumn::create();
+    auto null = NullColumn::create();
+    for (int j = 0; j < 20; ++j) {
+        // the ascii rows in the column of non-ascii ones
+        str->append(j % 2 == 0 ? std::string(j * 10, 'a') : "中文" + std::string(j * 10, 'a'));
+        null->append(j % 5 == 0);
+    }
+
+    columns.emplace_back(NullableColumn::create(str, null));
+
+    ColumnPtr result = StringFunctions::utf8_length(ctx.get(), columns);
+    ASSERT_EQ(20, result->size());
+
+    for (int k = 0; k < 20; ++k) {
+        if (k % 5 == 0) {
+            ASSERT_TRUE(result->is_null(k));
+        } else {
+            ASSERT_EQ(k % 2 == 0 ? k * 10 : k * 10 + 2, result->get(k).get_int32());
+        }
+    }
+}
+
 PARALLEL_TEST(VecStringFunctionsTest, upperTest) {
     std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
     Columns columns;
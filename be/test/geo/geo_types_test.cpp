@@ -133,6 +133,40 @@ TEST_F(GeoTypesTest, polygon_contains) {
     }
 }
 
+TEST_F(GeoTypesTest, polygon_contains_encoded) {
+    const char* wkt = "POLYGON ((10 10, 50 10, 50 50, 10 50, 10 10))";
+    GeoParseStatus status;
+    std::unique_ptr<GeoShape> polygon(GeoShape::from_wkt(wkt, strlen(wkt), &status));
+    ASSERT_NE(nullptr, polygon.get());
+
+    std::string buf;
+    bool contained = false;
+    {
+        GeoPoint point;
+        point.from_coord(20, 20);
+        point.encode_to(&buf);
+        ASSERT_TRUE(polygon->contains_encoded(buf.data(), buf.size(), &contained));
+        ASSERT_TRUE(contained);
+    }
+    {
+        GeoPoint point;
+        point.from_coord(5, 5);
+        buf.clear();
+        point.encode_to(&buf);
+        ASSERT_TRUE(polygon->contains_encoded(buf.data(), buf.size(), &contained));
+        ASSERT_FALSE(contained);
+
+        // truncated
+        ASSERT_FALSE(polygon->contains_encoded(buf.data(), buf.size() - 1, &contained));
+    }
+    {
+        // not a point
+        buf.clear();
+        polygon->encode_to(&buf);
+        ASSERT_FALSE(polygon->contains_encoded(buf.data(), buf.size(), &contained));
+    }
+}
+
 TEST_F(GeoTypesTest, polygon_parse_fail) {
     {
         const char* wkt = "POLYGON ((10 10, 50 10, 50 50, 10 50), (10 10 01))";
@@ -84,6 +84,28 @@ TEST_F(MetricsActionTest, prometheus_no_prefix) {
     action.handle(&request);
 }
 
+TEST_F(MetricsActionTest, prometheus_histogram) {
+    MetricRegistry registry("test");
+    CoreLocalHistogram latency(MetricUnit::MICROSECONDS);
+    for (int i = 1; i <= 10; ++i) {
+        latency.add(i);
+    }
+    registry.register_metric("latency_us", MetricLabels().add("type", "read"), &latency);
+    s_expect_response =
+            "# TYPE test_latency_us summary\n"
+            "test_latency_us{type=\"read\",quantile=\"0.5\"} 5\n"
+            "test_latency_us{type=\"read\",quantile=\"0.75\"} 8\n"
+            "test_latency_us{type=\"read\",quantile=\"0.9\"} 9\n"
+            "test_latency_us{type=\"read\",quantile=\"0.95\"} 10\n"
+            "test_latency_us{type=\"read\",quantile=\"0.99\"} 10\n"
+            "test_latency_us{type=\"read\",quantile=\"0.999\"} 10\n"
+            "test_latency_us_sum{type=\"read\"} 55\n"
+            "test_latency_us_count{type=\"read\"} 10\n";
+    HttpRequest request(_evhttp_req);
+    MetricsAction action(&registry);
+    action.handle(&request);
+}
+
 TEST_F(MetricsActionTest, prometheus_no_name) {
     MetricRegistry registry("test");
     IntGauge cpu_idle(MetricUnit::PERCENT);
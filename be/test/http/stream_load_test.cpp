@@ -26,13 +26,18 @@
 #include <gtest/gtest.h>
 #include <rapidjson/document.h>
 
+#include <thread>
+
+#include "common/config.h"
 #include "exec/schema_scanner/schema_helper.h"
 #include "gen_cpp/HeartbeatService_types.h"
 #include "http/http_channel.h"
 #include "http/http_request.h"
 #include "runtime/exec_env.h"
 #include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_context.h"
 #include "runtime/stream_load/stream_load_executor.h"
+#include "runtime/stream_load/stream_load_group_commit_mgr.h"
 #include "runtime/thread_resource_mgr.h"
 #include "util/brpc_stub_cache.h"
 #include "util/cpu_info.h"
@@ -80,6 +85,7 @@ public:
         _env._load_stream_mgr = new LoadStreamMgr();
         _env._brpc_stub_cache = new BrpcStubCache();
         _env._stream_load_executor = new StreamLoadExecutor(&_env);
+        _env._stream_load_group_commit_mgr = new StreamLoadGroupCommitMgr(&_env);
 
         _evhttp_req = evhttp_request_new(nullptr, nullptr);
     }
@@ -92,6 +98,8 @@ public:
         _env._master_info = nullptr;
         delete _env._thread_mgr;
         _env._thread_mgr = nullptr;
+        delete _env._stream_load_group_commit_mgr;
+        _env._stream_load_group_commit_mgr = nullptr;
         delete _env._stream_load_executor;
         _env._stream_load_executor = nullptr;
 
@@ -267,4 +275,38 @@ TEST_F(StreamLoadActionTest, plan_fail) {
     ASSERT_STREQ("Fail", doc["Status"].GetString());
 }
 
+TEST_F(StreamLoadActionTest, group_commit) {
+    config::stream_load_group_commit_interval_ms = 200;
+    k_stream_load_begin_result.__set_txnId(100);
+    TStreamLoadPutRequest request;
+    request.db = "db";
+    request.tbl = "tbl";
+
+    // The loads in the interval are committed by one transaction.
+    StreamLoadContext ctx1(&_env);
+    StreamLoadContext ctx2(&_env);
+    std::string body1 = "1,a";
+    std::string body2 = "2,b\n";
+    Status st1;
+    Status st2;
+    std::thread load1([&] { st1 = _env.stream_load_group_commit_mgr()->load(&ctx1, request, &body1); });
+    std::thread load2([&] { st2 = _env.stream_load_group_commit_mgr()->load(&ctx2, request, &body2); });
+    load1.join();
+    load2.join();
+    ASSERT_TRUE(st1.ok());
+    ASSERT_TRUE(st2.ok());
+    ASSERT_EQ(100, ctx1.txn_id);
+    ASSERT_EQ(100, ctx2.txn_id);
+    ASSERT_EQ("1,a\n", body1);
+
+    // A failed group fails all its loads.
+    k_stream_load_begin_result.__set_txnId(101);
+    Status::InternalError("TestFail").to_thrift(&k_stream_load_commit_result.status);
+    StreamLoadContext ctx3(&_env);
+    std::string body3 = "3,c\n";
+    ASSERT_FALSE(_env.stream_load_group_commit_mgr()->load(&ctx3, request, &body3).ok());
+    ASSERT_EQ(101, ctx3.txn_id);
+    config::stream_load_group_commit_interval_ms = 1000;
+}
+
 } // namespace starrocks
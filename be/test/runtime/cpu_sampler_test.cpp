@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/cpu_sampler.h"
+
+#include <gtest/gtest.h>
+
+#include "util/time.h"
+#include "util/uid_util.h"
+
+namespace starrocks {
+
+static int64_t burn_cpu(int64_t duration_ns) {
+    int64_t sum = 0;
+    int64_t start = MonotonicNanos();
+    while (MonotonicNanos() - start < duration_ns) {
+        for (int i = 0; i < 10000; ++i) {
+            sum += i * i;
+        }
+    }
+    return sum;
+}
+
+TEST(CpuSamplerTest, TagSamplesWithQuery) {
+    auto* sampler = CpuSampler::instance();
+    ASSERT_FALSE(sampler->start(0).ok());
+    ASSERT_TRUE(sampler->start(1000).ok());
+    ASSERT_TRUE(sampler->is_running());
+
+    TUniqueId query_id;
+    query_id.__set_hi(12345);
+    query_id.__set_lo(67890);
+    TUniqueId instance_id;
+    instance_id.__set_hi(12345);
+    instance_id.__set_lo(67891);
+    int64_t since_ns = MonotonicNanos();
+    CurrentThread::set_query_id(query_id);
+    CurrentThread::set_fragment_instance_id(instance_id);
+    CurrentThread::set_operator(3, 7);
+    ASSERT_NE(0, burn_cpu(200 * 1000 * 1000));
+    CurrentThread::set_operator(-1, -1);
+    CurrentThread::set_fragment_instance_id(TUniqueId());
+    CurrentThread::set_query_id(TUniqueId());
+    sampler->stop();
+    ASSERT_FALSE(sampler->is_running());
+
+    std::string stacks = sampler->collapsed_stacks(print_id(query_id), since_ns, nullptr);
+    ASSERT_FALSE(stacks.empty());
+    std::string prefix = "query_" + print_id(query_id) + ";instance_" + print_id(instance_id) + ";operator_3_node_7;";
+    ASSERT_EQ(0, stacks.find(prefix)) << stacks;
+
+    // the samples of other queries are filtered out
+    TUniqueId other_query_id;
+    other_query_id.__set_hi(1);
+    other_query_id.__set_lo(2);
+    ASSERT_TRUE(sampler->collapsed_stacks(print_id(other_query_id), since_ns, nullptr).empty());
+    // no sample is taken after the sampler stops
+    ASSERT_TRUE(sampler->collapsed_stacks("", MonotonicNanos(), nullptr).empty());
+}
+
+} // namespace starrocks
@@ -0,0 +1,41 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/current_mem_tracker.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks {
+
+TEST(CurrentMemTrackerTest, CacheBytes) {
+    MemTracker parent(-1, "parent");
+    MemTracker tracker(-1, "tracker", &parent);
+    CurrentThread::set_mem_tracker(&tracker);
+
+    // the small consumptions are cached by the thread
+    CurrentMemTracker::consume(100);
+    CurrentMemTracker::release(40);
+    ASSERT_EQ(0, tracker.consumption());
+    ASSERT_EQ(60, CurrentThread::mem_cached_bytes());
+
+    // the cached bytes are added to the tracker and the ancestors at the threshold
+    CurrentMemTracker::consume(CurrentThread::kMemCacheBytes);
+    ASSERT_EQ(CurrentThread::kMemCacheBytes + 60, tracker.consumption());
+    ASSERT_EQ(CurrentThread::kMemCacheBytes + 60, parent.consumption());
+    ASSERT_EQ(0, CurrentThread::mem_cached_bytes());
+
+    CurrentMemTracker::release(CurrentThread::kMemCacheBytes);
+    ASSERT_EQ(60, tracker.consumption());
+
+    // the cached bytes are added to the old tracker when the tracker is changed
+    CurrentMemTracker::release(60);
+    ASSERT_EQ(60, tracker.consumption());
+    ASSERT_EQ(&tracker, CurrentThread::set_mem_tracker(nullptr));
+    ASSERT_EQ(0, tracker.consumption());
+    ASSERT_EQ(0, parent.consumption());
+
+    // nothing is tracked without a tracker
+    CurrentMemTracker::consume(100);
+    ASSERT_EQ(0, CurrentThread::mem_cached_bytes());
+}
+
+} // namespace starrocks
@@ -0,0 +1,51 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/descriptor_tbl_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+
+namespace starrocks {
+
+static TDescriptorTable create_thrift_tbl(PrimitiveType type) {
+    TDescriptorTableBuilder table_desc_builder;
+    TSlotDescriptorBuilder slot_desc_builder;
+    auto slot = slot_desc_builder.type(type).column_name("c1").column_pos(0).nullable(true).id(0).build();
+    TTupleDescriptorBuilder tuple_desc_builder;
+    tuple_desc_builder.add_slot(slot);
+    tuple_desc_builder.build(&table_desc_builder);
+    return table_desc_builder.desc_tbl();
+}
+
+TEST(DescriptorTblCacheTest, Get) {
+    DescriptorTblCache cache(1024 * 1024);
+    std::shared_ptr<DescriptorTbl> tbl;
+    ASSERT_TRUE(cache.get(create_thrift_tbl(TYPE_INT), &tbl).ok());
+    ASSERT_NE(nullptr, tbl->get_slot_descriptor(0));
+    ASSERT_EQ(TYPE_INT, tbl->get_slot_descriptor(0)->type().type);
+    ASSERT_GT(cache.memory_usage(), 0);
+
+    // the identical table hits the cached one
+    std::shared_ptr<DescriptorTbl> tbl2;
+    ASSERT_TRUE(cache.get(create_thrift_tbl(TYPE_INT), &tbl2).ok());
+    ASSERT_EQ(tbl.get(), tbl2.get());
+
+    // another table doesn't
+    std::shared_ptr<DescriptorTbl> tbl3;
+    ASSERT_TRUE(cache.get(create_thrift_tbl(TYPE_BIGINT), &tbl3).ok());
+    ASSERT_NE(tbl.get(), tbl3.get());
+    ASSERT_EQ(TYPE_BIGINT, tbl3->get_slot_descriptor(0)->type().type);
+}
+
+TEST(DescriptorTblCacheTest, ReleasedInUse) {
+    auto cache = std::make_unique<DescriptorTblCache>(1024 * 1024);
+    std::shared_ptr<DescriptorTbl> tbl;
+    ASSERT_TRUE(cache->get(create_thrift_tbl(TYPE_INT), &tbl).ok());
+    cache.reset();
+    // the dropped table is still alive for its users
+    ASSERT_EQ(TYPE_INT, tbl->get_slot_descriptor(0)->type().type);
+}
+
+} // namespace starrocks
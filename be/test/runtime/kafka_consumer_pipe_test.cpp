@@ -67,4 +67,33 @@ TEST_F(KafkaConsumerPipeTest, append_read) {
     ASSERT_EQ(eof, true);
 }
 
+TEST_F(KafkaConsumerPipeTest, append_buffer) {
+    KafkaConsumerPipe k_pipe(1024 * 1024, 64 * 1024);
+
+    std::string msg1 = "i have a dream";
+    std::string msg2 = "This is from kafka";
+
+    Status st;
+    char row_delimiter = '\n';
+    int released = 0;
+    st = k_pipe.append_with_row_delimiter(ByteBuffer::wrap(msg1.data(), msg1.length(), [&released] { released++; }),
+                                          row_delimiter);
+    ASSERT_TRUE(st.ok());
+    st = k_pipe.append_with_row_delimiter(msg2.c_str(), msg2.length(), row_delimiter);
+    ASSERT_TRUE(st.ok());
+    st = k_pipe.finish();
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(0, released);
+
+    char buf[1024];
+    size_t data_size = 1024;
+    bool eof = false;
+    st = k_pipe.read((uint8_t*)buf, &data_size, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(data_size, msg1.length() + msg2.length() + 2);
+    ASSERT_EQ(msg1 + "\n" + msg2 + "\n", std::string(buf, data_size));
+    // the message is released once it's read
+    ASSERT_EQ(1, released);
+}
+
 } // namespace starrocks
@@ -23,6 +23,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+
 #include "common/config.h"
 
 namespace starrocks {
@@ -49,4 +51,23 @@ TEST(SystemAllocatorTest, TestNormal) {
     test_normal<false>();
 }
 
+TEST(SystemAllocatorTest, TestHugePage) {
+    config::use_mmap_allocate_chunk = false;
+    config::use_huge_page_for_large_chunk = true;
+    {
+        auto ptr = SystemAllocator::allocate(SystemAllocator::HUGE_PAGE_SIZE * 2);
+        ASSERT_NE(nullptr, ptr);
+        ASSERT_EQ(0, (uint64_t)ptr % SystemAllocator::HUGE_PAGE_SIZE);
+        memset(ptr, 1, SystemAllocator::HUGE_PAGE_SIZE * 2);
+        SystemAllocator::free(ptr, SystemAllocator::HUGE_PAGE_SIZE * 2);
+    }
+    {
+        auto ptr = SystemAllocator::allocate(4096);
+        ASSERT_NE(nullptr, ptr);
+        ASSERT_EQ(0, (uint64_t)ptr % 4096);
+        SystemAllocator::free(ptr, 4096);
+    }
+    config::use_huge_page_for_large_chunk = false;
+}
+
 } // namespace starrocks
@@ -270,4 +270,67 @@ TEST_F(SortedChunksMergerTest, three_suppliers) {
     }
 }
 
+TEST_F(SortedChunksMergerTest, many_suppliers_with_long_runs) {
+    config::vector_chunk_size = 32;
+    // The supplier i outputs the rows in [10 * (5 * c + i), 10 * (5 * c + i + 1)) in its chunk c.
+    const size_t num_suppliers = 5;
+    const size_t num_chunks = 2;
+    const size_t run_size = 10;
+    butil::FlatMap<SlotId, size_t> map;
+    map.init(2);
+    map[0] = 0;
+    std::vector<std::vector<ChunkPtr>> chunks(num_suppliers);
+    for (size_t i = 0; i < num_suppliers; ++i) {
+        for (size_t c = 0; c < num_chunks; ++c) {
+            ColumnPtr column = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false);
+            for (size_t r = 0; r < run_size; ++r) {
+                column->append_datum(int32_t(run_size * (num_suppliers * c + i) + r));
+            }
+            chunks[i].push_back(std::make_shared<Chunk>(Columns{column}, map));
+        }
+    }
+
+    ChunkSuppliers suppliers;
+    std::vector<size_t> next_chunks(num_suppliers, 0);
+    for (size_t i = 0; i < num_suppliers; ++i) {
+        auto supplier = [&chunks, &next_chunks, i](Chunk** cnk) -> Status {
+            if (next_chunks[i] < chunks[i].size()) {
+                const ChunkPtr& src_chunk = chunks[i][next_chunks[i]++];
+                *cnk = src_chunk->clone_empty_with_slot(src_chunk->num_rows()).release();
+                (*cnk)->append(*src_chunk, 0, src_chunk->num_rows());
+            } else {
+                *cnk = nullptr;
+            }
+            return Status::OK();
+        };
+        suppliers.push_back(supplier);
+    }
+
+    auto* expr = new SlotRef(TypeDescriptor(TYPE_INT), 0, 0);
+    _exprs.push_back(expr);
+    std::vector<ExprContext*> sort_exprs{new ExprContext(expr)};
+    std::vector<bool> is_asc{true};
+    std::vector<bool> is_null_first{true};
+
+    SortedChunksMerger merger;
+    ASSERT_TRUE(merger.init(suppliers, &sort_exprs, &is_asc, &is_null_first).ok());
+
+    int32_t expected = 0;
+    bool eos = false;
+    while (true) {
+        ChunkPtr page;
+        ASSERT_TRUE(merger.get_next(&page, &eos).ok());
+        if (eos) {
+            ASSERT_TRUE(page == nullptr);
+            break;
+        }
+        ASSERT_LE(page->num_rows(), 32u);
+        for (size_t i = 0; i < page->num_rows(); ++i) {
+            ASSERT_EQ(expected++, page->get(i).get(0).get_int32());
+        }
+    }
+    ASSERT_EQ(num_suppliers * num_chunks * run_size, expected);
+    delete sort_exprs[0];
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,189 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/clock_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace starrocks {
+
+class ClockCacheTest : public testing::Test {
+public:
+    static ClockCacheTest* _s_current;
+
+    static void Deleter(const CacheKey& key, void* v) {
+        _s_current->_deleted_keys.push_back(decode_key(key));
+        _s_current->_deleted_values.push_back(reinterpret_cast<uintptr_t>(v));
+    }
+
+    static const int kCacheSize = 1000;
+
+    ClockCacheTest() : _cache(new_clock_cache(kCacheSize)) { _s_current = this; }
+
+    ~ClockCacheTest() override { delete _cache; }
+
+    static CacheKey encode_key(std::string* result, int k) {
+        result->assign(reinterpret_cast<const char*>(&k), sizeof(k));
+        return CacheKey(*result);
+    }
+
+    static int decode_key(const CacheKey& key) {
+        int k;
+        memcpy(&k, key.data(), sizeof(k));
+        return k;
+    }
+
+    int lookup(int key) {
+        std::string result;
+        Cache::Handle* handle = _cache->lookup(encode_key(&result, key));
+        const int r = handle == nullptr ? -1 : reinterpret_cast<uintptr_t>(_cache->value(handle));
+        if (handle != nullptr) {
+            _cache->release(handle);
+        }
+        return r;
+    }
+
+    void insert(int key, int value, int charge, CachePriority priority = CachePriority::NORMAL) {
+        std::string result;
+        _cache->release(_cache->insert(encode_key(&result, key), reinterpret_cast<void*>(static_cast<uintptr_t>(value)),
+                                       charge, &ClockCacheTest::Deleter, priority));
+    }
+
+    void erase(int key) {
+        std::string result;
+        _cache->erase(encode_key(&result, key));
+    }
+
+protected:
+    std::vector<int> _deleted_keys;
+    std::vector<int> _deleted_values;
+    Cache* _cache;
+};
+
+ClockCacheTest* ClockCacheTest::_s_current;
+
+TEST_F(ClockCacheTest, hit_and_miss) {
+    ASSERT_EQ(-1, lookup(100));
+
+    insert(100, 101, 1);
+    ASSERT_EQ(101, lookup(100));
+    ASSERT_EQ(-1, lookup(200));
+
+    insert(200, 201, 1);
+    ASSERT_EQ(101, lookup(100));
+    ASSERT_EQ(201, lookup(200));
+
+    insert(100, 102, 1);
+    ASSERT_EQ(102, lookup(100));
+    ASSERT_EQ(201, lookup(200));
+
+    ASSERT_EQ(1, _deleted_keys.size());
+    ASSERT_EQ(100, _deleted_keys[0]);
+    ASSERT_EQ(101, _deleted_values[0]);
+    ASSERT_EQ(5, _cache->get_hit_count());
+    ASSERT_EQ(7, _cache->get_lookup_count());
+}
+
+TEST_F(ClockCacheTest, erase) {
+    erase(200);
+    ASSERT_EQ(0, _deleted_keys.size());
+
+    insert(100, 101, 1);
+    insert(200, 201, 1);
+    erase(100);
+    ASSERT_EQ(-1, lookup(100));
+    ASSERT_EQ(201, lookup(200));
+    ASSERT_EQ(1, _deleted_keys.size());
+    ASSERT_EQ(100, _deleted_keys[0]);
+    ASSERT_EQ(1, _cache->get_memory_usage());
+}
+
+TEST_F(ClockCacheTest, entries_are_pinned) {
+    insert(100, 101, 1);
+    std::string result1;
+    Cache::Handle* h1 = _cache->lookup(encode_key(&result1, 100));
+    ASSERT_EQ(101, reinterpret_cast<uintptr_t>(_cache->value(h1)));
+
+    insert(100, 102, 1);
+    ASSERT_EQ(102, lookup(100));
+    ASSERT_EQ(0, _deleted_keys.size());
+
+    _cache->release(h1);
+    ASSERT_EQ(1, _deleted_keys.size());
+    ASSERT_EQ(101, _deleted_values[0]);
+
+    // the entries in use are not evicted
+    std::string result2;
+    Cache::Handle* h2 = _cache->lookup(encode_key(&result2, 100));
+    for (int i = 0; i < kCacheSize * 2; i++) {
+        insert(1000 + i, 2000 + i, 1);
+    }
+    ASSERT_EQ(102, lookup(100));
+    _cache->release(h2);
+}
+
+TEST_F(ClockCacheTest, eviction_policy) {
+    insert(100, 101, 1);
+    insert(200, 201, 1);
+    insert(300, 301, 1, CachePriority::DURABLE);
+
+    // the entries referenced between the sweeps are kept, the normal ones are evicted before the durable ones
+    for (int i = 0; i < kCacheSize + 100; i++) {
+        insert(1000 + i, 2000 + i, 1);
+        ASSERT_EQ(101, lookup(100));
+    }
+
+    ASSERT_EQ(101, lookup(100));
+    ASSERT_EQ(-1, lookup(200));
+    ASSERT_EQ(301, lookup(300));
+    ASSERT_LE(_cache->get_memory_usage(), kCacheSize + kNumShards);
+}
+
+TEST_F(ClockCacheTest, prune) {
+    insert(100, 101, 1);
+    insert(200, 201, 1);
+    std::string result;
+    Cache::Handle* h = _cache->lookup(encode_key(&result, 100));
+    _cache->prune();
+    ASSERT_EQ(1, _deleted_keys.size());
+    ASSERT_EQ(200, _deleted_keys[0]);
+    ASSERT_EQ(101, lookup(100));
+    _cache->release(h);
+}
+
+TEST_F(ClockCacheTest, concurrent_lookups) {
+    std::unique_ptr<Cache> cache(new_clock_cache(kCacheSize));
+    std::atomic<int> num_deleted = 0;
+    static std::atomic<int>* s_num_deleted;
+    s_num_deleted = &num_deleted;
+    auto deleter = [](const CacheKey& key, void* value) { s_num_deleted->fetch_add(1); };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 10000; i++) {
+                int k = (i * 8 + t) % (kCacheSize * 2);
+                std::string result;
+                CacheKey key = encode_key(&result, k);
+                Cache::Handle* h = cache->lookup(key);
+                if (h == nullptr) {
+                    h = cache->insert(key, reinterpret_cast<void*>(static_cast<uintptr_t>(k)), 1, deleter);
+                }
+                ASSERT_EQ(k, reinterpret_cast<uintptr_t>(cache->value(h)));
+                cache->release(h);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    size_t usage = cache->get_memory_usage();
+    ASSERT_LE(usage, kCacheSize + kNumShards);
+    cache.reset();
+    ASSERT_GT(num_deleted.load(), 0);
+}
+
+} // namespace starrocks
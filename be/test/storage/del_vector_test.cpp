@@ -23,6 +23,8 @@
 
 #include <gtest/gtest.h>
 
+#include "common/config.h"
+
 namespace starrocks {
 
 // NOLINTNEXTLINE
@@ -41,4 +43,51 @@ TEST(DelVector, testLoadSave) {
     ASSERT_EQ(dv2.cardinality(), dels.size());
 };
 
+// NOLINTNEXTLINE
+TEST(DelVector, testSaveDelta) {
+    int32_t old_max_deltas = config::del_vector_max_deltas;
+    config::del_vector_max_deltas = 2;
+    std::vector<uint32_t> dels;
+    for (uint32_t i = 0; i < 100000; i += 3) {
+        dels.push_back(i);
+    }
+    DelVector dv;
+    dv.init(1, dels.data(), dels.size());
+    std::string full = dv.save_delta();
+    int64_t base_version = 0;
+    ASSERT_FALSE(DelVector::is_delta(full.data(), full.size(), &base_version));
+
+    // the small additions are saved as deltas, until there are enough deltas.
+    std::vector<std::string> saved{full};
+    DelVectorPtr cur = std::make_shared<DelVector>(std::move(dv));
+    for (int64_t version = 2; version <= 4; version++) {
+        DelVectorPtr next;
+        cur->add_dels_as_new_version({static_cast<uint32_t>(version * 3 + 1)}, version, &next);
+        saved.push_back(next->save_delta());
+        cur = next;
+    }
+    ASSERT_TRUE(DelVector::is_delta(saved[1].data(), saved[1].size(), &base_version));
+    ASSERT_EQ(1, base_version);
+    ASSERT_LT(saved[1].size(), full.size());
+    ASSERT_TRUE(DelVector::is_delta(saved[2].data(), saved[2].size(), &base_version));
+    ASSERT_EQ(2, base_version);
+    ASSERT_FALSE(DelVector::is_delta(saved[3].data(), saved[3].size(), &base_version));
+
+    DelVector loaded;
+    ASSERT_TRUE(loaded.load(1, saved[1].data(), saved[1].size()).is_not_supported());
+    ASSERT_TRUE(loaded.load(1, saved[0].data(), saved[0].size()).ok());
+    ASSERT_FALSE(loaded.apply_delta(3, saved[2].data(), saved[2].size()).ok());
+    ASSERT_TRUE(loaded.apply_delta(2, saved[1].data(), saved[1].size()).ok());
+    ASSERT_TRUE(loaded.apply_delta(3, saved[2].data(), saved[2].size()).ok());
+    ASSERT_EQ(3, loaded.version());
+    ASSERT_EQ(2, loaded.num_deltas());
+    ASSERT_EQ(dels.size() + 2, loaded.cardinality());
+
+    DelVector last;
+    ASSERT_TRUE(last.load(4, saved[3].data(), saved[3].size()).ok());
+    ASSERT_EQ(cur->cardinality(), last.cardinality());
+    ASSERT_TRUE(*cur->roaring() == *last.roaring());
+    config::del_vector_max_deltas = old_max_deltas;
+}
+
 } // namespace starrocks
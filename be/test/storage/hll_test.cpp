@@ -23,6 +23,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include "util/hash_util.hpp"
 #include "util/slice.h"
 
@@ -196,6 +200,32 @@ TEST_F(TestHll, Normal) {
     }
 }
 
+TEST_F(TestHll, UpdateBatch) {
+    uint8_t buf[HLL_REGISTERS_COUNT + 1];
+    uint8_t batch_buf[HLL_REGISTERS_COUNT + 1];
+    // Stays explicit, overflows the explicit set in one batch, and updates the registers.
+    for (int num_values : {0, 100, 1000, 100000}) {
+        std::vector<uint64_t> hash_values;
+        HyperLogLog hll;
+        for (int i = 0; i < num_values; ++i) {
+            hash_values.push_back(hash(i));
+            hll.update(hash(i));
+        }
+        HyperLogLog batch_hll;
+        // The first values are updated one by one, so the batch is updated into an explicit HLL.
+        size_t num_updated = std::min<size_t>(hash_values.size(), 10);
+        for (size_t i = 0; i < num_updated; ++i) {
+            batch_hll.update(hash_values[i]);
+        }
+        batch_hll.update_batch(hash_values.data() + num_updated, hash_values.size() - num_updated);
+
+        ASSERT_EQ(hll.estimate_cardinality(), batch_hll.estimate_cardinality());
+        size_t len = hll.serialize(buf);
+        ASSERT_EQ(len, batch_hll.serialize(batch_buf));
+        ASSERT_EQ(0, memcmp(buf, batch_buf, len));
+    }
+}
+
 TEST_F(TestHll, InvalidPtr) {
     {
         HyperLogLog hll(Slice((char*)nullptr, 0));
@@ -0,0 +1,79 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/io_limiter.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "util/monotime.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(IOLimiterTest, test_acquire) {
+    IOLimiter unlimited(0);
+    ASSERT_EQ(0, unlimited.rate());
+    int64_t start_ms = MonotonicMillis();
+    unlimited.acquire(1L << 30);
+    ASSERT_LT(MonotonicMillis() - start_ms, 100);
+
+    // 5MB at 10MB per second.
+    IOLimiter limiter(10L << 20);
+    ASSERT_EQ(10L << 20, limiter.rate());
+    start_ms = MonotonicMillis();
+    for (int i = 0; i < 5; i++) {
+        limiter.acquire(1L << 20);
+    }
+    ASSERT_GE(MonotonicMillis() - start_ms, 400);
+
+    limiter.set_max_rate(0);
+    start_ms = MonotonicMillis();
+    limiter.acquire(1L << 30);
+    ASSERT_LT(MonotonicMillis() - start_ms, 100);
+}
+
+// NOLINTNEXTLINE
+TEST(IOLimiterTest, test_backoff) {
+    auto old_latency_ms = config::compaction_io_backoff_scan_io_latency_ms;
+    config::compaction_io_backoff_scan_io_latency_ms = 20;
+    IOLimiter limiter(16L << 20, 10);
+
+    // backs off by half for the slow scan I/O, down to 1/16 of the max rate.
+    const int64_t slow_io_ns = 30 * 1000000L;
+    limiter.add_scan_io(slow_io_ns * 10, 10);
+    SleepFor(MonoDelta::FromMilliseconds(20));
+    limiter.add_scan_io(slow_io_ns, 1);
+    ASSERT_EQ(8L << 20, limiter.rate());
+    for (int i = 0; i < 5; i++) {
+        SleepFor(MonoDelta::FromMilliseconds(20));
+        limiter.add_scan_io(slow_io_ns, 1);
+    }
+    ASSERT_EQ(1L << 20, limiter.rate());
+
+    // grows back by 1/8 of the max rate for the fast scan I/O.
+    SleepFor(MonoDelta::FromMilliseconds(20));
+    limiter.add_scan_io(1000000L, 1);
+    ASSERT_EQ(3L << 20, limiter.rate());
+
+    config::compaction_io_backoff_scan_io_latency_ms = old_latency_ms;
+}
+
+// NOLINTNEXTLINE
+TEST(IOLimiterTest, test_scope) {
+    IOLimiter limiter1(0);
+    IOLimiter limiter2(0);
+    ASSERT_EQ(nullptr, IOLimiter::current());
+    {
+        IOLimiter::Scope scope1(&limiter1);
+        ASSERT_EQ(&limiter1, IOLimiter::current());
+        {
+            IOLimiter::Scope scope2(&limiter2);
+            ASSERT_EQ(&limiter2, IOLimiter::current());
+        }
+        ASSERT_EQ(&limiter1, IOLimiter::current());
+    }
+    ASSERT_EQ(nullptr, IOLimiter::current());
+}
+
+} // namespace starrocks
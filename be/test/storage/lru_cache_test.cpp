@@ -257,6 +257,63 @@ TEST_F(CacheTest, Usage) {
     ASSERT_EQ(950, cache.get_usage());
 }
 
+static bool lookup_LRUCache(LRUCache& cache, const CacheKey& key) {
+    uint32_t hash = key.hash(key.data(), key.size(), 0);
+    Cache::Handle* handle = cache.lookup(key, hash);
+    if (handle == nullptr) {
+        return false;
+    }
+    cache.release(handle);
+    return true;
+}
+
+TEST_F(CacheTest, ScanResistant) {
+    LRUCache cache;
+    cache.set_capacity(1000);
+    cache.set_protected_capacity(500);
+
+    CacheKey key1("100");
+    insert_LRUCache(cache, key1, 100, CachePriority::NORMAL);
+    ASSERT_TRUE(lookup_LRUCache(cache, key1));
+    ASSERT_EQ(100, cache.get_protected_usage());
+
+    // the entries read only once don't evict the entry hit again
+    for (int i = 0; i < 20; i++) {
+        CacheKey key(std::to_string(1000 + i));
+        insert_LRUCache(cache, key, 100, CachePriority::NORMAL);
+    }
+    ASSERT_EQ(1000, cache.get_usage());
+    ASSERT_TRUE(lookup_LRUCache(cache, key1));
+
+    // the least recently used protected entries are moved back to the probationary ones
+    CacheKey key2("1019");
+    CacheKey key3("1018");
+    CacheKey key4("1017");
+    CacheKey key5("1016");
+    ASSERT_TRUE(lookup_LRUCache(cache, key2));
+    ASSERT_TRUE(lookup_LRUCache(cache, key3));
+    ASSERT_TRUE(lookup_LRUCache(cache, key4));
+    ASSERT_TRUE(lookup_LRUCache(cache, key5));
+    ASSERT_EQ(500, cache.get_protected_usage());
+    ASSERT_TRUE(lookup_LRUCache(cache, key1));
+    ASSERT_EQ(500, cache.get_protected_usage());
+    CacheKey key6("1015");
+    ASSERT_TRUE(lookup_LRUCache(cache, key6));
+    ASSERT_EQ(500, cache.get_protected_usage());
+
+    // key2 is demoted and evicted after the other probationary entries
+    for (int i = 0; i < 4; i++) {
+        CacheKey key(std::to_string(2000 + i));
+        insert_LRUCache(cache, key, 100, CachePriority::NORMAL);
+    }
+    ASSERT_TRUE(lookup_LRUCache(cache, key2));
+    ASSERT_TRUE(lookup_LRUCache(cache, key1));
+
+    ASSERT_EQ(10, cache.prune());
+    ASSERT_EQ(0, cache.get_usage());
+    ASSERT_EQ(0, cache.get_protected_usage());
+}
+
 TEST_F(CacheTest, HeavyEntries) {
     // Add a bunch of light and heavy entries and then count the combined
     // size of items still in the cache, which must be approximately the
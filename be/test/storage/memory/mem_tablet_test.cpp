@@ -23,9 +23,11 @@
 
 #include <gtest/gtest.h>
 
+#include "column/chunk.h"
 #include "storage/memory/mem_tablet_scan.h"
 #include "storage/memory/write_txn.h"
 #include "storage/tablet_meta.h"
+#include "storage/vectorized/chunk_helper.h"
 
 namespace starrocks {
 namespace memory {
@@ -185,6 +187,44 @@ TEST(MemTablet, writescan) {
         EXPECT_EQ(curidx, (size_t)num_insert);
         scan.reset();
     }
+
+    // vectorized scan result validation
+    {
+        vectorized::Schema schema = vectorized::ChunkHelper::convert_schema(tablet->tablet_schema());
+        vectorized::ChunkIteratorPtr iter;
+        ASSERT_TRUE(tablet->new_chunk_iterator(schema, cur_version, &iter).ok());
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, iter->chunk_size());
+        std::vector<uint32_t> rowids;
+        size_t curidx = 0;
+        while (true) {
+            chunk->reset();
+            Status st = iter->get_next(chunk.get(), &rowids);
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok());
+            ASSERT_LE(chunk->num_rows(), iter->chunk_size());
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                const TData& data = alldata[curidx];
+                EXPECT_EQ(data.id, chunk->get_column_by_index(0)->get(i).get_int32());
+                EXPECT_EQ(data.pv, chunk->get_column_by_index(2)->get(i).get_int32());
+                const auto& city = chunk->get_column_by_index(3);
+                if (data.city % 2 == 0) {
+                    EXPECT_TRUE(city->is_null(i));
+                } else {
+                    EXPECT_EQ(data.city, city->get(i).get_int8());
+                }
+                EXPECT_EQ(curidx, rowids[curidx]);
+                curidx++;
+            }
+        }
+        EXPECT_EQ(curidx, (size_t)num_insert);
+        iter->close();
+
+        vectorized::Schema missing(vectorized::Fields{std::make_shared<vectorized::Field>(
+                0, "not_exist", get_type_info(OLAP_FIELD_TYPE_INT), false)});
+        ASSERT_TRUE(tablet->new_chunk_iterator(missing, cur_version, &iter).is_not_found());
+    }
 }
 
 } // namespace memory
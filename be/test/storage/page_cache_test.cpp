@@ -23,7 +23,10 @@
 
 #include <gtest/gtest.h>
 
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
 #include "runtime/mem_tracker.h"
+#include "storage/rowset/segment_v2/parsed_page.h"
 
 namespace starrocks {
 
@@ -94,4 +97,75 @@ TEST_F(StoragePageCacheTest, normal) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(StoragePageCacheTest, index_pool) {
+    StoragePageCache cache(_mem_tracker.get(), kNumShards * 4096, 50);
+
+    StoragePageCache::CacheKey key("abc", 0);
+    {
+        // insert index page
+        char* buf = new char[1024];
+        PageCacheHandle handle;
+        Slice data(buf, 1024);
+        cache.insert(key, data, &handle, false, true);
+        ASSERT_EQ(1024, cache.index_memory_usage());
+        ASSERT_EQ(0, cache.data_memory_usage());
+    }
+
+    // the data pages don't eliminate the index page
+    for (int i = 0; i < 10 * kNumShards; ++i) {
+        StoragePageCache::CacheKey key("bcd", i);
+        PageCacheHandle handle;
+        Slice data(new char[1024], 1024);
+        cache.insert(key, data, &handle, false);
+    }
+
+    {
+        PageCacheHandle handle;
+        ASSERT_FALSE(cache.lookup(key, &handle));
+        ASSERT_TRUE(cache.lookup(key, &handle, true));
+    }
+    ASSERT_EQ(cache.index_memory_usage() + cache.data_memory_usage(), cache.memory_usage());
+}
+
+// NOLINTNEXTLINE
+TEST_F(StoragePageCacheTest, decoded_pool) {
+    StoragePageCache cache(_mem_tracker.get(), kNumShards * 2048, 0, 0, kNumShards * 4096);
+    ASSERT_TRUE(cache.has_decoded_page_cache());
+
+    auto decoded = std::make_shared<segment_v2::DecodedPage>();
+    decoded->first_ordinal = 100;
+    decoded->num_rows = 10;
+    auto values = vectorized::Int32Column::create();
+    for (int32_t i = 0; i < 10; ++i) {
+        values->append(i);
+    }
+    decoded->values = vectorized::NullableColumn::create(values, vectorized::NullColumn::create(10, 0));
+
+    StoragePageCache::CacheKey key("abc", 0);
+    ASSERT_EQ(nullptr, cache.lookup_decoded_page(key));
+    cache.insert_decoded_page(key, decoded, decoded->memory_usage());
+    auto found = cache.lookup_decoded_page(key);
+    ASSERT_EQ(decoded.get(), found.get());
+    // the raw pages and the decoded pages are separate.
+    PageCacheHandle handle;
+    ASSERT_FALSE(cache.lookup(key, &handle));
+
+    auto page = segment_v2::parse_decoded_page(found, segment_v2::PagePointer(0, 1024), 3);
+    ASSERT_EQ(3, page->page_index());
+    ASSERT_TRUE(page->contains(105));
+    ASSERT_FALSE(page->contains(110));
+    ASSERT_TRUE(page->seek(4).ok());
+    // the nullable values without nulls could be read into a not nullable column.
+    auto dst = vectorized::Int32Column::create();
+    size_t count = 100;
+    ASSERT_TRUE(page->read(dst.get(), &count).ok());
+    ASSERT_EQ(6, count);
+    ASSERT_EQ(0, page->remaining());
+    ASSERT_EQ(4, dst->get_data()[0]);
+    ASSERT_EQ(9, dst->get_data()[5]);
+    // the dictionary codes are not decoded.
+    ASSERT_FALSE(page->read_dict_codes(dst.get(), &count).ok());
+}
+
 } // namespace starrocks
@@ -6,10 +6,12 @@
 
 #include "column/fixed_length_column.h"
 #include "column/schema.h"
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "testutil/parallel_test.h"
+#include "util/threadpool.h"
 
 using namespace starrocks::vectorized;
 
@@ -246,6 +248,64 @@ PARALLEL_TEST(PrimaryIndexTest, test_composite_key) {
     ASSERT_EQ(deletes[1].size(), kSegmentSize);
 }
 
+// NOLINTNEXTLINE
+TEST(PrimaryIndexTest, test_parallel_upsert) {
+    auto f = std::make_shared<vectorized::Field>(0, "c0", OLAP_FIELD_TYPE_BIGINT, false);
+    f->set_is_key(true);
+    auto schema = std::make_shared<vectorized::Schema>(Fields{f});
+    auto serial_index = TEST_create_primary_index(*schema);
+    auto parallel_index = TEST_create_primary_index(*schema);
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_TRUE(ThreadPoolBuilder("primary_index_test").set_max_threads(4).build(&pool).ok());
+    parallel_index->set_thread_pool(pool.get());
+    int64_t old_batch_rows = config::primary_index_parallel_batch_rows;
+    config::primary_index_parallel_batch_rows = 1;
+
+    constexpr int kSegmentSize = 10000;
+    auto pk_col = Int64Column::create();
+    std::vector<uint32_t> rowids;
+    for (int i = 0; i < kSegmentSize; i++) {
+        pk_col->append(i);
+        rowids.push_back(i * 2);
+    }
+    ASSERT_TRUE(serial_index->insert(0, rowids, *pk_col).ok());
+    ASSERT_TRUE(parallel_index->insert(0, rowids, *pk_col).ok());
+
+    // upsert the even numbers twice, and the numbers in range [kSegmentSize, kSegmentSize * 3 / 2).
+    pk_col->resize(0);
+    for (int i = 0; i < kSegmentSize / 2; i++) {
+        pk_col->append(i * 2);
+    }
+    for (int i = 0; i < kSegmentSize / 2; i++) {
+        pk_col->append(i * 2);
+        pk_col->append(kSegmentSize + i);
+    }
+    PrimaryIndex::DeletesMap serial_deletes;
+    PrimaryIndex::DeletesMap parallel_deletes;
+    serial_index->upsert(2, 0, *pk_col, &serial_deletes);
+    parallel_index->upsert(2, 0, *pk_col, &parallel_deletes);
+    config::primary_index_parallel_batch_rows = old_batch_rows;
+
+    ASSERT_EQ(serial_index->size(), parallel_index->size());
+    ASSERT_EQ(kSegmentSize * 3 / 2, parallel_index->size());
+    ASSERT_EQ(serial_deletes.size(), parallel_deletes.size());
+    for (auto& [rssid, dels] : serial_deletes) {
+        auto& parallel_dels = parallel_deletes[rssid];
+        std::sort(dels.begin(), dels.end());
+        std::sort(parallel_dels.begin(), parallel_dels.end());
+        ASSERT_EQ(dels, parallel_dels);
+    }
+    ASSERT_EQ(kSegmentSize / 2, parallel_deletes[0].size());
+    ASSERT_EQ(kSegmentSize / 2, parallel_deletes[2].size());
+
+    // the positions of the keys are the same.
+    PrimaryIndex::DeletesMap serial_erased;
+    PrimaryIndex::DeletesMap parallel_erased;
+    serial_index->erase(*pk_col, &serial_erased);
+    parallel_index->erase(*pk_col, &parallel_erased);
+    ASSERT_EQ(serial_erased, parallel_erased);
+}
+
 // TODO: test composite primary key
 
 } // namespace starrocks
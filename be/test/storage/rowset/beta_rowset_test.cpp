@@ -755,4 +755,87 @@ TEST_F(BetaRowsetTest, FinalMergeTest) {
     }
 }
 
+TEST_F(BetaRowsetTest, AggregateByMetadataTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    RowsetSharedPtr rowset;
+    const uint32_t rows_per_segment = 1024;
+    RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+    create_rowset_writer_context(&tablet_schema, &writer_context);
+
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    ASSERT_EQ(OLAP_SUCCESS, RowsetFactory::create_rowset_writer(writer_context, &rowset_writer));
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    {
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+        auto& cols = chunk->columns();
+        for (auto i = 0; i < rows_per_segment; i++) {
+            cols[0]->append_datum(vectorized::Datum(static_cast<int32_t>(i)));
+            cols[1]->append_datum(vectorized::Datum(static_cast<int32_t>(i * 2)));
+            cols[2]->append_datum(vectorized::Datum(static_cast<int32_t>(i * 3)));
+        }
+        rowset_writer->add_chunk(*chunk.get());
+        EXPECT_EQ(OLAP_SUCCESS, rowset_writer->flush());
+    }
+    rowset = rowset_writer->build();
+    ASSERT_TRUE(rowset != nullptr);
+
+    MemTracker tracker;
+    DeferOp memory_tracker_releaser([&tracker] { return tracker.release(tracker.consumption()); });
+    std::string segment_file =
+            BetaRowset::segment_file_path(writer_context.rowset_path_prefix, writer_context.rowset_id, 0);
+    std::shared_ptr<segment_v2::Segment> segment;
+    ASSERT_TRUE(segment_v2::Segment::open(&tracker, fs::fs_util::block_manager(), segment_file, 0, &tablet_schema,
+                                          &segment)
+                        .ok());
+
+    // |value| is the lower bound of k1.
+    auto read_segment = [&](const char* value, OlapReaderStatistics* stats) {
+        std::unique_ptr<vectorized::ColumnPredicate> predicate(
+                vectorized::new_column_ge_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, value));
+        vectorized::SegmentReadOptions seg_options;
+        seg_options.block_mgr = fs::fs_util::block_manager();
+        seg_options.stats = stats;
+        seg_options.aggregate_by_metadata = true;
+        seg_options.predicates[0].emplace_back(predicate.get());
+        auto res = segment->new_iterator(schema, seg_options);
+        EXPECT_TRUE(res.ok());
+        auto seg_iterator = std::move(res).value();
+
+        std::vector<vectorized::DatumTuple> rows;
+        auto chunk = vectorized::ChunkHelper::new_chunk(seg_iterator->schema(), 100);
+        while (seg_iterator->get_next(chunk.get()).ok()) {
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                rows.emplace_back(chunk->get(i));
+            }
+            chunk->reset();
+        }
+        seg_iterator->close();
+        return rows;
+    };
+
+    // the predicate covers the segment, the first row has the max values and the others have the min values.
+    OlapReaderStatistics stats;
+    auto rows = read_segment("0", &stats);
+    ASSERT_EQ(rows_per_segment, rows.size());
+    EXPECT_EQ(rows_per_segment, stats.rows_metadata_aggregated);
+    EXPECT_EQ(rows_per_segment - 1, rows[0][0].get_int32());
+    EXPECT_EQ((rows_per_segment - 1) * 2, rows[0][1].get_int32());
+    EXPECT_EQ((rows_per_segment - 1) * 3, rows[0][2].get_int32());
+    for (size_t i = 1; i < rows.size(); i++) {
+        EXPECT_EQ(0, rows[i][0].get_int32());
+        EXPECT_EQ(0, rows[i][1].get_int32());
+        EXPECT_EQ(0, rows[i][2].get_int32());
+    }
+
+    // the predicate doesn't cover the segment, the rows are read.
+    OlapReaderStatistics stats2;
+    rows = read_segment("10", &stats2);
+    ASSERT_EQ(rows_per_segment - 10, rows.size());
+    EXPECT_EQ(0, stats2.rows_metadata_aggregated);
+    EXPECT_EQ(10, rows[0][0].get_int32());
+    EXPECT_EQ(rows_per_segment - 1, rows.back()[0].get_int32());
+}
+
 } // namespace starrocks
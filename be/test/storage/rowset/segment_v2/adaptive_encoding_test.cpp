@@ -0,0 +1,73 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/adaptive_encoding.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "common/config.h"
+
+namespace starrocks::segment_v2 {
+
+class AdaptiveEncodingTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _max_decode_slowdown = config::adaptive_encoding_max_decode_slowdown;
+        // Not to be affected by the timing of the machine.
+        config::adaptive_encoding_max_decode_slowdown = 100;
+    }
+
+    void TearDown() override { config::adaptive_encoding_max_decode_slowdown = _max_decode_slowdown; }
+
+    double _max_decode_slowdown = 0;
+};
+
+TEST_F(AdaptiveEncodingTest, test_supported_types) {
+    ASSERT_TRUE(AdaptiveEncodingSelector::is_supported(OLAP_FIELD_TYPE_BIGINT));
+    ASSERT_TRUE(AdaptiveEncodingSelector::is_supported(OLAP_FIELD_TYPE_DOUBLE));
+    ASSERT_TRUE(AdaptiveEncodingSelector::is_supported(OLAP_FIELD_TYPE_TIMESTAMP));
+    ASSERT_FALSE(AdaptiveEncodingSelector::is_supported(OLAP_FIELD_TYPE_VARCHAR));
+    ASSERT_FALSE(AdaptiveEncodingSelector::is_supported(OLAP_FIELD_TYPE_DECIMAL64));
+}
+
+TEST_F(AdaptiveEncodingTest, test_no_values) {
+    AdaptiveEncodingSelector selector(OLAP_FIELD_TYPE_INT, BIT_SHUFFLE, LZ4_FRAME, 0.1);
+    EncodingTypePB encoding;
+    CompressionTypePB compression;
+    ASSERT_TRUE(selector.select(&encoding, &compression).ok());
+    ASSERT_EQ(BIT_SHUFFLE, encoding);
+    ASSERT_EQ(LZ4_FRAME, compression);
+}
+
+TEST_F(AdaptiveEncodingTest, test_sequence) {
+    AdaptiveEncodingSelector selector(OLAP_FIELD_TYPE_BIGINT, BIT_SHUFFLE, LZ4_FRAME, 0.1);
+    std::vector<int64_t> values;
+    for (int64_t i = 0; i < 16 * 1024; i++) {
+        values.push_back(1000000000 + 3 * i);
+    }
+    selector.add_values(reinterpret_cast<const uint8_t*>(values.data()), values.size());
+    ASSERT_EQ(values.size(), selector.num_values());
+    EncodingTypePB encoding;
+    CompressionTypePB compression;
+    ASSERT_TRUE(selector.select(&encoding, &compression).ok());
+    // The deltas are all the same, which are packed into no bits.
+    ASSERT_EQ(DELTA_BINARY_PACKED, encoding);
+}
+
+TEST_F(AdaptiveEncodingTest, test_decimals) {
+    AdaptiveEncodingSelector selector(OLAP_FIELD_TYPE_DOUBLE, BIT_SHUFFLE, LZ4_FRAME, 0.1);
+    std::vector<double> values;
+    for (int i = 0; i < 16 * 1024; i++) {
+        values.push_back((100000 + random() % 100000) / 100.0);
+    }
+    selector.add_values(reinterpret_cast<const uint8_t*>(values.data()), values.size());
+    EncodingTypePB encoding;
+    CompressionTypePB compression;
+    ASSERT_TRUE(selector.select(&encoding, &compression).ok());
+    // The random decimals of two digits are encoded as the small integers.
+    ASSERT_EQ(ALP_ENCODING, encoding);
+}
+
+} // namespace starrocks::segment_v2
@@ -0,0 +1,116 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/alp_page.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "storage/rowset/segment_v2/options.h"
+#include "storage/vectorized/chunk_helper.h"
+
+using starrocks::segment_v2::PageBuilderOptions;
+using starrocks::segment_v2::PageDecoderOptions;
+
+namespace starrocks {
+
+class AlpPageTest : public testing::Test {
+public:
+    template <FieldType Type>
+    OwnedSlice encode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        segment_v2::AlpPageBuilder<Type> builder(builder_options);
+        size_t added = builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        EXPECT_EQ(src.size(), added);
+        OwnedSlice s = builder.finish()->build();
+        LOG(INFO) << "ALP encoded size for " << src.size() << " values: " << s.slice().size
+                  << ", original size:" << src.size() * sizeof(src[0]);
+        return s;
+    }
+
+    // The values are compared by their bits, so that NaN and -0.0 are checked too.
+    template <FieldType Type>
+    void test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        typedef typename TypeTraits<Type>::CppType CppType;
+        OwnedSlice s = encode<Type>(src);
+
+        PageDecoderOptions decoder_options;
+        segment_v2::AlpPageDecoder<Type> decoder(s.slice(), decoder_options);
+        ASSERT_TRUE(decoder.init().ok());
+        ASSERT_EQ(src.size(), decoder.count());
+        auto column = vectorized::ChunkHelper::column_from_field_type(Type, false);
+        size_t n = src.size();
+        ASSERT_TRUE(decoder.next_batch(&n, column.get()).ok());
+        ASSERT_EQ(src.size(), n);
+        for (size_t i = 0; i < src.size(); i++) {
+            CppType v = column->get(i).get<CppType>();
+            ASSERT_EQ(0, memcmp(&src[i], &v, sizeof(CppType))) << "index " << i << " " << src[i] << " " << v;
+        }
+
+        segment_v2::AlpPageDecoder<Type> seek_decoder(s.slice(), decoder_options);
+        ASSERT_TRUE(seek_decoder.init().ok());
+        for (int i = 0; i < 100 && !src.empty(); i++) {
+            size_t pos = random() % src.size();
+            ASSERT_TRUE(seek_decoder.seek_to_position_in_page(pos).ok());
+            column = vectorized::ChunkHelper::column_from_field_type(Type, false);
+            n = 10;
+            ASSERT_TRUE(seek_decoder.next_batch(&n, column.get()).ok());
+            ASSERT_EQ(std::min<size_t>(10, src.size() - pos), n);
+            for (size_t j = 0; j < n; j++) {
+                CppType v = column->get(j).get<CppType>();
+                ASSERT_EQ(0, memcmp(&src[pos + j], &v, sizeof(CppType)));
+            }
+        }
+    }
+};
+
+TEST_F(AlpPageTest, TestDoubleDecimals) {
+    std::vector<double> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back((100000 + random() % 100000) / 100.0);
+    }
+    test_encode_decode<OLAP_FIELD_TYPE_DOUBLE>(values);
+    // about 18 bits per value
+    ASSERT_LT(encode<OLAP_FIELD_TYPE_DOUBLE>(values).slice().size, values.size() * sizeof(double) / 3);
+}
+
+TEST_F(AlpPageTest, TestFloatDecimals) {
+    std::vector<float> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back((random() % 100000) / 10.0f);
+    }
+    test_encode_decode<OLAP_FIELD_TYPE_FLOAT>(values);
+}
+
+TEST_F(AlpPageTest, TestExceptions) {
+    std::vector<double> values;
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(i * 0.5);
+    }
+    values[1] = std::numeric_limits<double>::quiet_NaN();
+    values[2] = -0.0;
+    values[3] = std::numeric_limits<double>::infinity();
+    values[4] = std::numeric_limits<double>::max();
+    values[5] = M_PI;
+    test_encode_decode<OLAP_FIELD_TYPE_DOUBLE>(values);
+
+    // no decimals at all
+    std::vector<double> random_values;
+    for (int i = 0; i < 1000; i++) {
+        random_values.push_back(static_cast<double>(random()) / RAND_MAX);
+    }
+    test_encode_decode<OLAP_FIELD_TYPE_DOUBLE>(random_values);
+}
+
+TEST_F(AlpPageTest, TestSmallPages) {
+    test_encode_decode<OLAP_FIELD_TYPE_DOUBLE>({});
+    test_encode_decode<OLAP_FIELD_TYPE_DOUBLE>({1.5});
+    test_encode_decode<OLAP_FIELD_TYPE_DOUBLE>({-0.0, -0.0});
+}
+
+} // namespace starrocks
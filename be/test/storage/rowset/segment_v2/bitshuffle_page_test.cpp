@@ -175,6 +175,59 @@ TEST_F(BitShufflePageTest, TestBitShuffleInt32BlockEncoderRandom) {
                                      segment_v2::BitShufflePageDecoder<OLAP_FIELD_TYPE_INT> >(ints.get(), size);
 }
 
+// NOLINTNEXTLINE
+TEST_F(BitShufflePageTest, TestBitShuffleInt32VectorizedRead) {
+    const uint32_t size = 10000;
+    std::vector<int32_t> ints(size);
+    for (int i = 0; i < size; i++) {
+        ints[i] = random();
+    }
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    segment_v2::BitshufflePageBuilder<OLAP_FIELD_TYPE_INT> page_builder(options);
+    ASSERT_EQ(size, page_builder.add(reinterpret_cast<const uint8_t*>(ints.data()), size));
+    OwnedSlice s = page_builder.finish()->build();
+    segment_v2::PageDecoderOptions decoder_options;
+
+    // the whole page is decompressed into the column, after the existing values.
+    {
+        segment_v2::BitShufflePageDecoder<OLAP_FIELD_TYPE_INT> page_decoder(s.slice(), decoder_options);
+        ASSERT_TRUE(page_decoder.init().ok());
+        auto column = vectorized::Int32Column::create();
+        column->append(-1);
+        size_t n = size;
+        ASSERT_TRUE(page_decoder.next_batch(&n, column.get()).ok());
+        ASSERT_EQ(size, n);
+        ASSERT_EQ(size + 1, column->size());
+        ASSERT_EQ(-1, column->get_data()[0]);
+        for (uint32_t i = 0; i < size; i++) {
+            ASSERT_EQ(ints[i], column->get_data()[i + 1]);
+        }
+    }
+
+    // read by batches and ranges.
+    {
+        segment_v2::BitShufflePageDecoder<OLAP_FIELD_TYPE_INT> page_decoder(s.slice(), decoder_options);
+        ASSERT_TRUE(page_decoder.init().ok());
+        auto column = vectorized::Int32Column::create();
+        size_t n = 100;
+        ASSERT_TRUE(page_decoder.next_batch(&n, column.get()).ok());
+        ASSERT_EQ(100, n);
+
+        vectorized::SparseRange range;
+        range.add(vectorized::Range(200, 300));
+        range.add(vectorized::Range(size - 1, size));
+        ASSERT_TRUE(page_decoder.read_by_ranges(range, column.get()).ok());
+        ASSERT_EQ(size, page_decoder.current_index());
+        ASSERT_EQ(201, column->size());
+        for (uint32_t i = 0; i < 100; i++) {
+            ASSERT_EQ(ints[i], column->get_data()[i]);
+            ASSERT_EQ(ints[200 + i], column->get_data()[100 + i]);
+        }
+        ASSERT_EQ(ints[size - 1], column->get_data()[200]);
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(BitShufflePageTest, TestBitShuffleInt64BlockEncoderRandom) {
     const uint32_t size = 10000;
@@ -22,6 +22,7 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <vector>
 
 #include "storage/rowset/segment_v2/bloom_filter.h"
 
@@ -178,5 +179,40 @@ TEST_F(BlockBloomFilterTest, slice) {
     ASSERT_FALSE(bf->test_bytes(s.data, s.size));
 }
 
+// Test for probing many hashes at once
+TEST_F(BlockBloomFilterTest, test_any_hash) {
+    std::unique_ptr<BloomFilter> bf;
+    ASSERT_TRUE(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf).ok());
+    ASSERT_TRUE(bf->init(_expected_num, _fpp, HASH_MURMUR3_X64_64).ok());
+    for (int64_t i = 0; i < 1000; ++i) {
+        bf->add_hash(BloomFilter::murmur3_hash((char*)&i, sizeof(i)));
+    }
+    ASSERT_EQ(bf->hash((char*)&_expected_num, sizeof(_expected_num)),
+              BloomFilter::murmur3_hash((char*)&_expected_num, sizeof(_expected_num)));
+
+    std::vector<uint64_t> hashes;
+    for (int64_t i = 1000; i < 2000; ++i) {
+        hashes.push_back(BloomFilter::murmur3_hash((char*)&i, sizeof(i)));
+    }
+    bool expected = false;
+    for (uint64_t hash : hashes) {
+        expected = expected || bf->test_hash(hash);
+    }
+    ASSERT_EQ(expected, bf->test_any_hash(hashes.data(), hashes.size()));
+
+    // the absent keys are tested one by one
+    size_t false_count = 0;
+    for (uint64_t hash : hashes) {
+        false_count += bf->test_any_hash(&hash, 1);
+        ASSERT_EQ(bf->test_hash(hash), bf->test_any_hash(&hash, 1));
+    }
+    ASSERT_LE((double)false_count / hashes.size(), _fpp);
+
+    int64_t present = 500;
+    hashes.push_back(BloomFilter::murmur3_hash((char*)&present, sizeof(present)));
+    ASSERT_TRUE(bf->test_any_hash(hashes.data(), hashes.size()));
+    ASSERT_FALSE(bf->test_any_hash(hashes.data(), 0));
+}
+
 } // namespace segment_v2
 } // namespace starrocks
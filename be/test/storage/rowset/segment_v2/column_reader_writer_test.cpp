@@ -30,6 +30,7 @@
 #include "column/fixed_length_column.h"
 #include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "env/env_memory.h"
 #include "gen_cpp/segment_v2.pb.h"
 #include "runtime/date_value.h"
@@ -91,6 +92,8 @@ protected:
             writer_opts.meta->set_unique_id(0);
             writer_opts.meta->set_type(type);
             writer_opts.adaptive_page_format = adaptive;
+            writer_opts.adaptive_encoding = config::enable_adaptive_encoding;
+            writer_opts.zstd_dict_compression = config::enable_zstd_dict_compression;
             if (type == OLAP_FIELD_TYPE_CHAR || type == OLAP_FIELD_TYPE_VARCHAR) {
                 writer_opts.meta->set_length(128);
             } else {
@@ -410,6 +413,23 @@ TEST_F(ColumnReaderWriterTest, test_datetime) {
     test_nullable_data<OLAP_FIELD_TYPE_TIMESTAMP, BIT_SHUFFLE, 2>(*col);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ColumnReaderWriterTest, test_adaptive_encoding) {
+    config::enable_adaptive_encoding = true;
+    config::adaptive_encoding_sample_pages = 2;
+    config::adaptive_encoding_max_decode_slowdown = 100;
+    // The pages after the sampled ones are written with the chosen encoding and compression.
+    auto col = datetime_values(100);
+    test_nullable_data<OLAP_FIELD_TYPE_TIMESTAMP, BIT_SHUFFLE, 1>(*col);
+    test_nullable_data<OLAP_FIELD_TYPE_TIMESTAMP, BIT_SHUFFLE, 2>(*col);
+    col = numeric_data<OLAP_FIELD_TYPE_DOUBLE>(4);
+    test_nullable_data<OLAP_FIELD_TYPE_DOUBLE, BIT_SHUFFLE, 1>(*col);
+    test_nullable_data<OLAP_FIELD_TYPE_DOUBLE, BIT_SHUFFLE, 2>(*col);
+    config::enable_adaptive_encoding = false;
+    config::adaptive_encoding_sample_pages = 4;
+    config::adaptive_encoding_max_decode_slowdown = 0.2;
+}
+
 // NOLINTNEXTLINE
 TEST_F(ColumnReaderWriterTest, test_binary) {
     auto c = low_cardinality_strings(10000);
@@ -427,6 +447,20 @@ TEST_F(ColumnReaderWriterTest, test_binary) {
     test_nullable_data<OLAP_FIELD_TYPE_CHAR, DICT_ENCODING, 2>(*c);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ColumnReaderWriterTest, test_zstd_dict_compression) {
+    config::enable_zstd_dict_compression = true;
+    auto c = high_cardinality_strings(100);
+    // The dictionary is trained from the first page, and the following pages are compressed with it.
+    config::zstd_dict_sample_bytes = 32 * 1024;
+    test_nullable_data<OLAP_FIELD_TYPE_VARCHAR, DICT_ENCODING, 1>(*c);
+    test_nullable_data<OLAP_FIELD_TYPE_VARCHAR, DICT_ENCODING, 2>(*c);
+    // The dictionary is trained from all the pages at the finish.
+    config::zstd_dict_sample_bytes = 1048576;
+    test_nullable_data<OLAP_FIELD_TYPE_VARCHAR, DICT_ENCODING, 2>(*c);
+    config::enable_zstd_dict_compression = false;
+}
+
 // NOLINTNEXTLINE
 TEST_F(ColumnReaderWriterTest, test_default_value) {
     std::string v_int("1");
@@ -0,0 +1,127 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/delta_binary_packed_page.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+#include "storage/rowset/segment_v2/options.h"
+#include "storage/vectorized/chunk_helper.h"
+
+using starrocks::segment_v2::PageBuilderOptions;
+using starrocks::segment_v2::PageDecoderOptions;
+
+namespace starrocks {
+
+class DeltaBinaryPackedPageTest : public testing::Test {
+public:
+    template <FieldType Type>
+    OwnedSlice encode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        segment_v2::DeltaBinaryPackedPageBuilder<Type> builder(builder_options);
+        size_t added = builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        EXPECT_EQ(src.size(), added);
+        OwnedSlice s = builder.finish()->build();
+        LOG(INFO) << "DeltaBinaryPacked encoded size for " << src.size() << " values: " << s.slice().size
+                  << ", original size:" << src.size() * sizeof(src[0]);
+        return s;
+    }
+
+    template <FieldType Type>
+    void test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        typedef typename TypeTraits<Type>::CppType CppType;
+        OwnedSlice s = encode<Type>(src);
+
+        // The whole page by one batch.
+        PageDecoderOptions decoder_options;
+        segment_v2::DeltaBinaryPackedPageDecoder<Type> decoder(s.slice(), decoder_options);
+        ASSERT_TRUE(decoder.init().ok());
+        ASSERT_EQ(src.size(), decoder.count());
+        auto column = vectorized::ChunkHelper::column_from_field_type(Type, false);
+        size_t n = src.size();
+        ASSERT_TRUE(decoder.next_batch(&n, column.get()).ok());
+        ASSERT_EQ(src.size(), n);
+        for (size_t i = 0; i < src.size(); i++) {
+            ASSERT_EQ(src[i], column->get(i).get<CppType>()) << "index " << i;
+        }
+
+        // Seek and read by small batches.
+        segment_v2::DeltaBinaryPackedPageDecoder<Type> seek_decoder(s.slice(), decoder_options);
+        ASSERT_TRUE(seek_decoder.init().ok());
+        for (int i = 0; i < 100 && !src.empty(); i++) {
+            size_t pos = random() % src.size();
+            ASSERT_TRUE(seek_decoder.seek_to_position_in_page(pos).ok());
+            column = vectorized::ChunkHelper::column_from_field_type(Type, false);
+            n = 10;
+            ASSERT_TRUE(seek_decoder.next_batch(&n, column.get()).ok());
+            ASSERT_EQ(std::min<size_t>(10, src.size() - pos), n);
+            for (size_t j = 0; j < n; j++) {
+                ASSERT_EQ(src[pos + j], column->get(j).get<CppType>());
+            }
+            ASSERT_EQ(pos + n, seek_decoder.current_index());
+        }
+    }
+};
+
+TEST_F(DeltaBinaryPackedPageTest, TestInt64Sequence) {
+    std::vector<int64_t> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(1640995200000L + i * 1000 + random() % 10);
+    }
+    test_encode_decode<OLAP_FIELD_TYPE_BIGINT>(values);
+    // about 4 bits per value
+    ASSERT_LT(encode<OLAP_FIELD_TYPE_BIGINT>(values).slice().size, values.size());
+}
+
+TEST_F(DeltaBinaryPackedPageTest, TestInt32Random) {
+    std::vector<int32_t> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(static_cast<int32_t>(random()) * (i % 2 == 0 ? 1 : -1));
+    }
+    test_encode_decode<OLAP_FIELD_TYPE_INT>(values);
+}
+
+TEST_F(DeltaBinaryPackedPageTest, TestOverflow) {
+    std::vector<int64_t> values;
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(i % 2 == 0 ? std::numeric_limits<int64_t>::max() : std::numeric_limits<int64_t>::min());
+    }
+    test_encode_decode<OLAP_FIELD_TYPE_BIGINT>(values);
+
+    std::vector<int8_t> tiny_values;
+    for (int i = 0; i < 1000; i++) {
+        tiny_values.push_back(static_cast<int8_t>(i * 37));
+    }
+    test_encode_decode<OLAP_FIELD_TYPE_TINYINT>(tiny_values);
+}
+
+TEST_F(DeltaBinaryPackedPageTest, TestSmallPages) {
+    test_encode_decode<OLAP_FIELD_TYPE_INT>({});
+    test_encode_decode<OLAP_FIELD_TYPE_INT>({42});
+    test_encode_decode<OLAP_FIELD_TYPE_INT>({42, 42, 42});
+    std::vector<int32_t> values;
+    for (int i = 0; i < 129; i++) {
+        values.push_back(i * i);
+    }
+    test_encode_decode<OLAP_FIELD_TYPE_INT>(values);
+}
+
+TEST_F(DeltaBinaryPackedPageTest, TestCorruption) {
+    std::vector<int32_t> values;
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(i);
+    }
+    OwnedSlice s = encode<OLAP_FIELD_TYPE_INT>(values);
+    Slice truncated(s.slice().data, s.slice().size - 1);
+    PageDecoderOptions decoder_options;
+    segment_v2::DeltaBinaryPackedPageDecoder<OLAP_FIELD_TYPE_INT> decoder(truncated, decoder_options);
+    ASSERT_FALSE(decoder.init().ok());
+}
+
+} // namespace starrocks
@@ -31,6 +31,7 @@
 #include "storage/rowset/segment_v2/page_builder.h"
 #include "storage/rowset/segment_v2/page_decoder.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/column_predicate.h"
 #include "util/logging.h"
 
 using starrocks::segment_v2::PageBuilderOptions;
@@ -134,6 +135,23 @@ public:
         for (uint i = 0; i < size; i++) {
             ASSERT_EQ(src[i], column->get(i).get<CppType>());
         }
+
+        // Read by ranges, which are inside a frame or across the frames.
+        ASSERT_TRUE(for_page_decoder.seek_to_position_in_page(0).ok());
+        vectorized::SparseRange range;
+        range.add(vectorized::Range(0, size / 8));
+        range.add(vectorized::Range(size / 4, size / 2));
+        range.add(vectorized::Range(size - 1, size));
+        column = vectorized::ChunkHelper::column_from_field_type(Type, false);
+        ASSERT_TRUE(for_page_decoder.read_by_ranges(range, column.get()).ok());
+        ASSERT_EQ(size, for_page_decoder.current_index());
+        ASSERT_EQ(range.span_size(), column->size());
+        size_t idx = 0;
+        for (size_t i = 0; i < range.size(); i++) {
+            for (rowid_t row = range[i].begin(); row < range[i].end(); row++) {
+                ASSERT_EQ(src[row], column->get(idx++).get<CppType>());
+            }
+        }
     }
 };
 
@@ -237,6 +255,50 @@ TEST_F(FrameOfReferencePageTest, TestInt128BlockEncoderMinMax) {
     test_encode_decode_page_vectorize<OLAP_FIELD_TYPE_LARGEINT>(ints.get(), 2);
 }
 
+TEST_F(FrameOfReferencePageTest, TestInt32FilterByEncodedValues) {
+    // 8 frames of 128 values, the values of frame i are in [i * 1000, i * 1000 + 127], the first 4 frames are
+    // ascending and the others are descending.
+    const size_t size = 1024;
+    std::unique_ptr<int32_t[]> ints(new int32_t[size]);
+    for (int i = 0; i < size; i++) {
+        int frame = i / 128;
+        ints.get()[i] = frame * 1000 + ((frame < 4) ? i % 128 : 127 - i % 128);
+    }
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = 256 * 1024;
+    segment_v2::FrameOfReferencePageBuilder<OLAP_FIELD_TYPE_INT> page_builder(builder_options);
+    ASSERT_EQ(size, page_builder.add(reinterpret_cast<const uint8_t*>(ints.get()), size));
+    OwnedSlice s = page_builder.finish()->build();
+
+    PageDecoderOptions decoder_options;
+    segment_v2::FrameOfReferencePageDecoder<OLAP_FIELD_TYPE_INT> decoder(s.slice(), decoder_options);
+    ASSERT_TRUE(decoder.init().ok());
+    ASSERT_TRUE(decoder.seek_to_position_in_page(10).ok());
+
+    auto filter = [&](vectorized::ColumnPredicate* pred) {
+        std::unique_ptr<vectorized::ColumnPredicate> p(pred);
+        vectorized::SparseRange range(64, size - 24);
+        EXPECT_TRUE(decoder.filter_by_encoded_values({p.get()}, &range).ok());
+        EXPECT_EQ(10, decoder.current_index());
+        return range;
+    };
+    const auto int_type = get_type_info(OLAP_FIELD_TYPE_INT);
+    ASSERT_EQ(vectorized::SparseRange(512, 1000), filter(vectorized::new_column_gt_predicate(int_type, 0, "3500")));
+    ASSERT_EQ(vectorized::SparseRange(64, 512), filter(vectorized::new_column_le_predicate(int_type, 0, "3127")));
+    ASSERT_EQ(vectorized::SparseRange(640, 768), filter(vectorized::new_column_eq_predicate(int_type, 0, "5050")));
+    ASSERT_TRUE(filter(vectorized::new_column_eq_predicate(int_type, 0, "3500")).empty());
+    // the predicates of other types are not evaluated.
+    ASSERT_EQ(vectorized::SparseRange(64, 1000),
+              filter(vectorized::new_column_eq_predicate(get_type_info(OLAP_FIELD_TYPE_BIGINT), 0, "3500")));
+
+    // the rows read are not changed.
+    auto column = vectorized::ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_INT, false);
+    size_t n = 128;
+    ASSERT_TRUE(decoder.next_batch(&n, column.get()).ok());
+    ASSERT_EQ(128, n);
+    ASSERT_EQ(ints.get()[10], column->get(0).get_int32());
+}
+
 TEST_F(FrameOfReferencePageTest, TestInt32SequenceBlockEncoderSize) {
     size_t size = 128;
     std::unique_ptr<int32_t[]> ints(new int32_t[size]);
@@ -32,6 +32,7 @@
 #include "storage/rowset/segment_v2/options.h"
 #include "storage/rowset/segment_v2/page_builder.h"
 #include "storage/rowset/segment_v2/page_decoder.h"
+#include "storage/vectorized/column_predicate.h"
 #include "util/logging.h"
 
 using starrocks::segment_v2::PageBuilderOptions;
@@ -141,6 +142,32 @@ public:
             ASSERT_EQ(src[i], column->get_data()[i]);
         }
     }
+
+    template <FieldType Type>
+    void test_read_by_ranges(typename TypeTraits<Type>::CppType* src, size_t size) {
+        typedef typename TypeTraits<Type>::CppType CppType;
+        OwnedSlice s = rle_encode<Type>(src, size);
+
+        PageDecoderOptions decodeder_options;
+        segment_v2::RlePageDecoder<Type> rle_page_decoder(s.slice(), decodeder_options);
+        ASSERT_TRUE(rle_page_decoder.init().ok());
+
+        vectorized::SparseRange range;
+        range.add(vectorized::Range(3, 10));
+        range.add(vectorized::Range(100, 101));
+        range.add(vectorized::Range(size - 500, size));
+        auto column = vectorized::FixedLengthColumn<CppType>::create();
+        ASSERT_TRUE(rle_page_decoder.read_by_ranges(range, column.get()).ok());
+        ASSERT_EQ(size, rle_page_decoder.current_index());
+        ASSERT_EQ(range.span_size(), column->size());
+
+        size_t idx = 0;
+        for (size_t i = 0; i < range.size(); i++) {
+            for (rowid_t row = range[i].begin(); row < range[i].end(); row++) {
+                ASSERT_EQ(src[row], column->get_data()[idx++]);
+            }
+        }
+    }
 };
 
 // Test for rle block, for INT32, BOOL
@@ -154,6 +181,7 @@ TEST_F(RlePageTest, TestRleInt32BlockEncoderRandom) {
         std::generate(std::begin(ints), std::end(ints), []() -> CppType { return rand(); });
         test_encode_decode_page_template<OLAP_FIELD_TYPE_INT>(ints.data(), size);
         test_encode_decode_page_vectorized<OLAP_FIELD_TYPE_INT>(ints.data(), size);
+        test_read_by_ranges<OLAP_FIELD_TYPE_INT>(ints.data(), size);
     }
     // OLAP_FIELD_TYPE_BIGINT
     {
@@ -174,6 +202,7 @@ TEST_F(RlePageTest, TestRleInt32BlockEncoderEqual) {
     }
 
     test_encode_decode_page_template<OLAP_FIELD_TYPE_INT>(ints.get(), size);
+    test_read_by_ranges<OLAP_FIELD_TYPE_INT>(ints.get(), size);
 }
 
 TEST_F(RlePageTest, TestRleInt32BlockEncoderSequence) {
@@ -187,6 +216,55 @@ TEST_F(RlePageTest, TestRleInt32BlockEncoderSequence) {
     test_encode_decode_page_template<OLAP_FIELD_TYPE_INT>(ints.get(), size);
 }
 
+TEST_F(RlePageTest, TestRleInt32FilterByEncodedValues) {
+    // a run of 96 1s, a literal run of 8 values, a run of 200 3s and a run of 96 5s.
+    const size_t size = 400;
+    std::unique_ptr<int32_t[]> ints(new int32_t[size]);
+    for (int i = 0; i < size; i++) {
+        if (i < 96) {
+            ints.get()[i] = 1;
+        } else if (i < 104) {
+            ints.get()[i] = 1000 + i;
+        } else if (i < 304) {
+            ints.get()[i] = 3;
+        } else {
+            ints.get()[i] = 5;
+        }
+    }
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = 256 * 1024;
+    segment_v2::RlePageBuilder<OLAP_FIELD_TYPE_INT> rle_page_builder(builder_options);
+    ASSERT_EQ(size, rle_page_builder.add(reinterpret_cast<const uint8_t*>(ints.get()), size));
+    OwnedSlice s = rle_page_builder.finish()->build();
+
+    PageDecoderOptions decoder_options;
+    segment_v2::RlePageDecoder<OLAP_FIELD_TYPE_INT> decoder(s.slice(), decoder_options);
+    ASSERT_TRUE(decoder.init().ok());
+    ASSERT_TRUE(decoder.seek_to_position_in_page(200).ok());
+
+    auto filter = [&](vectorized::ColumnPredicate* pred) {
+        std::unique_ptr<vectorized::ColumnPredicate> p(pred);
+        vectorized::SparseRange range(10, 390);
+        EXPECT_TRUE(decoder.filter_by_encoded_values({p.get()}, &range).ok());
+        EXPECT_EQ(200, decoder.current_index());
+        return range;
+    };
+    const auto int_type = get_type_info(OLAP_FIELD_TYPE_INT);
+    // the values of the literal run are always kept.
+    ASSERT_EQ(vectorized::SparseRange(96, 304), filter(vectorized::new_column_eq_predicate(int_type, 0, "3")));
+    ASSERT_EQ(vectorized::SparseRange({vectorized::Range(96, 104), vectorized::Range(304, 390)}),
+              filter(vectorized::new_column_gt_predicate(int_type, 0, "4")));
+    ASSERT_EQ(vectorized::SparseRange(96, 104), filter(vectorized::new_column_lt_predicate(int_type, 0, "1")));
+    ASSERT_EQ(vectorized::SparseRange(10, 390), filter(vectorized::new_column_ge_predicate(int_type, 0, "1")));
+
+    // the rows read are not changed.
+    auto column = vectorized::FixedLengthColumn<int32_t>::create();
+    size_t n = 10;
+    ASSERT_TRUE(decoder.next_batch(&n, column.get()).ok());
+    ASSERT_EQ(10, n);
+    ASSERT_EQ(3, column->get_data()[0]);
+}
+
 TEST_F(RlePageTest, TestRleInt32BlockEncoderSize) {
     size_t size = 100;
 
@@ -214,6 +292,7 @@ TEST_F(RlePageTest, TestRleBoolBlockEncoderRandom) {
     }
 
     test_encode_decode_page_template<OLAP_FIELD_TYPE_BOOL>(bools.get(), size);
+    test_read_by_ranges<OLAP_FIELD_TYPE_BOOL>(bools.get(), size);
 }
 
 TEST_F(RlePageTest, TestRleBoolBlockEncoderSize) {
@@ -37,10 +37,12 @@
 #include "storage/olap_common.h"
 #include "storage/row_block2.h"
 #include "storage/row_cursor.h"
+#include "storage/rowset/segment_v2/segment_cache.h"
 #include "storage/rowset/segment_v2/segment_iterator.h"
 #include "storage/rowset/segment_v2/segment_writer.h"
 #include "storage/tablet_schema.h"
 #include "storage/tablet_schema_helper.h"
+#include "storage/vectorized/chunk_helper.h"
 #include "util/file_utils.h"
 
 #define ASSERT_OK(expr)                                   \
@@ -1159,5 +1161,109 @@ TEST_F(SegmentReaderWriterTest, TestBloomFilterIndexUniqueModel) {
     ASSERT_TRUE(column_contains_index(seg2->footer().columns(3), BLOOM_FILTER_INDEX));
 }
 
+TEST_F(SegmentReaderWriterTest, TestRowStore) {
+    const int num_rows = 4096;
+    std::shared_ptr<TabletSchema> tablet_schema(new TabletSchema());
+    tablet_schema->_num_columns = 3;
+    tablet_schema->_num_key_columns = 1;
+    tablet_schema->_num_short_key_columns = 1;
+    tablet_schema->_cols.push_back(create_int_key(1, false));
+    tablet_schema->_cols.push_back(create_varchar_key(2));
+    tablet_schema->_cols.back()._is_key = false;
+    tablet_schema->_cols.push_back(create_int_value(3, OLAP_FIELD_AGGREGATION_NONE));
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(*tablet_schema);
+
+    // 0, "0", null
+    // 1, null, 10
+    // 2, "2", 20
+    auto chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows);
+    std::vector<std::string> strs(num_rows);
+    for (int i = 0; i < num_rows; i++) {
+        strs[i] = std::to_string(i);
+        chunk->get_column_by_index(0)->append_datum(vectorized::Datum(int32_t(i)));
+        if (i % 2 == 0) {
+            chunk->get_column_by_index(1)->append_datum(vectorized::Datum(Slice(strs[i])));
+            chunk->get_column_by_index(2)->append_nulls(1);
+        } else {
+            chunk->get_column_by_index(1)->append_nulls(1);
+            chunk->get_column_by_index(2)->append_datum(vectorized::Datum(int32_t(i * 10)));
+        }
+    }
+
+    auto check_rows = [&](bool has_row_store) {
+        tablet_schema->_has_row_store = has_row_store;
+        std::string fname = kSegmentDir + (has_row_store ? "/row_store" : "/no_row_store");
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions wblock_opts({fname});
+        ASSERT_OK(_block_mgr->create_block(wblock_opts, &wblock));
+        SegmentWriterOptions opts;
+        opts.mem_tracker = _mem_tracker.get();
+        SegmentWriter writer(std::move(wblock), 0, tablet_schema.get(), opts);
+        ASSERT_OK(writer.init(10));
+        ASSERT_OK(writer.append_chunk(*chunk));
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        ASSERT_OK(writer.finalize(&file_size, &index_size));
+
+        std::shared_ptr<Segment> segment;
+        ASSERT_OK(Segment::open(_mem_tracker.get(), _block_mgr, fname, 0, tablet_schema.get(), &segment));
+        ASSERT_EQ(has_row_store, segment->has_row_store());
+        std::vector<rowid_t> rowids{0, 1, 1000, 1001, 4095};
+        auto rows = vectorized::ChunkHelper::new_chunk(schema, rowids.size());
+        ASSERT_OK(segment->read_rows(rowids, rows.get()));
+        ASSERT_EQ(rowids.size(), rows->num_rows());
+        for (size_t i = 0; i < rowids.size(); i++) {
+            ASSERT_EQ(chunk->debug_row(rowids[i]), rows->debug_row(i));
+        }
+    };
+    check_rows(true);
+    check_rows(false);
+}
+
+TEST_F(SegmentReaderWriterTest, SegmentCache) {
+    TabletSchema tablet_schema = create_schema({create_int_key(1), create_int_value(2)});
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+    opts.mem_tracker = _mem_tracker.get();
+    shared_ptr<Segment> segment;
+    build_segment(opts, tablet_schema, tablet_schema, 100, DefaultIntGenerator, &segment);
+    const std::string fname = segment->file_name();
+
+    MemTracker cache_mem_tracker;
+    SegmentCache cache(&cache_mem_tracker, 1024 * 1024);
+    shared_ptr<Segment> cached;
+    ASSERT_OK(cache.open(_block_mgr, fname, 0, tablet_schema, &cached));
+    ASSERT_NE(segment, cached);
+    ASSERT_EQ(100, cached->num_rows());
+    ASSERT_GT(cache.memory_usage(), 0);
+    ASSERT_GT(cache_mem_tracker.consumption(), 0);
+
+    // the same schema hits the cached segment
+    TabletSchema same_schema = tablet_schema;
+    shared_ptr<Segment> hit;
+    ASSERT_OK(cache.open(_block_mgr, fname, 0, same_schema, &hit));
+    ASSERT_EQ(cached, hit);
+
+    // another schema opens the segment again
+    TabletSchema other_schema = create_schema({create_int_key(1), create_int_value(2), create_int_value(3)});
+    shared_ptr<Segment> other;
+    ASSERT_OK(cache.open(_block_mgr, fname, 0, other_schema, &other));
+    ASSERT_NE(cached, other);
+    ASSERT_EQ(3, other->tablet_schema().num_columns());
+
+    // the erased segment is still alive by its pointers
+    cache.erase(fname);
+    ASSERT_EQ(0, cache.memory_usage());
+    ASSERT_OK(cache.open(_block_mgr, fname, 0, other_schema, &hit));
+    ASSERT_NE(other, hit);
+    ASSERT_EQ(100, other->num_rows());
+
+    cached.reset();
+    other.reset();
+    hit.reset();
+    cache.erase(fname);
+    ASSERT_EQ(0, cache_mem_tracker.consumption());
+}
+
 } // namespace segment_v2
 } // namespace starrocks
@@ -0,0 +1,183 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/text_index.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "env/env_memory.h"
+#include "runtime/mem_tracker.h"
+#include "storage/fs/file_block_manager.h"
+#include "storage/page_cache.h"
+#include "storage/rowset/segment_v2/bitmap_index_reader.h"
+#include "storage/rowset/segment_v2/bloom_filter_index_reader.h"
+#include "storage/rowset/segment_v2/text_index_writer.h"
+#include "storage/types.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks::segment_v2 {
+
+class TextIndexTest : public testing::Test {
+protected:
+    const std::string kTestDir = "/text_index_test";
+
+    void SetUp() override {
+        StoragePageCache::create_global_cache(&_tracker, 1000000000);
+        _env = new EnvMemory();
+        _block_mgr = new fs::FileBlockManager(_env, fs::BlockManagerOptions());
+        ASSERT_TRUE(_env->create_dir(kTestDir).ok());
+    }
+
+    void TearDown() override {
+        StoragePageCache::release_global_cache();
+        delete _block_mgr;
+        delete _env;
+    }
+
+    std::unique_ptr<vectorized::ColumnPredicate> contains(const std::string& s) {
+        return std::unique_ptr<vectorized::ColumnPredicate>(
+                vectorized::new_column_contains_predicate(get_type_info(OLAP_FIELD_TYPE_VARCHAR), 0, s));
+    }
+
+    std::unique_ptr<vectorized::ColumnPredicate> match(const std::string& s) {
+        return std::unique_ptr<vectorized::ColumnPredicate>(
+                vectorized::new_column_match_predicate(get_type_info(OLAP_FIELD_TYPE_VARCHAR), 0, s));
+    }
+
+    EnvMemory* _env = nullptr;
+    fs::FileBlockManager* _block_mgr = nullptr;
+    MemTracker _tracker;
+};
+
+TEST_F(TextIndexTest, test_tokens_and_ngrams) {
+    std::vector<std::string> tokens;
+    for_each_token(Slice("[ERROR] disk_0 is full, 磁盘 满"), [&](const Slice& t) { tokens.push_back(t.to_string()); });
+    ASSERT_EQ((std::vector<std::string>{"ERROR", "disk_0", "is", "full", "磁盘", "满"}), tokens);
+
+    std::vector<std::string> grams;
+    for_each_ngram(Slice("error"), 3, [&](const Slice& g) { grams.push_back(g.to_string()); });
+    ASSERT_EQ((std::vector<std::string>{"err", "rro", "ror"}), grams);
+
+    grams.clear();
+    for_each_ngram(Slice("ab"), 3, [&](const Slice& g) { grams.push_back(g.to_string()); });
+    ASSERT_TRUE(grams.empty());
+}
+
+TEST_F(TextIndexTest, test_evaluate) {
+    auto column = vectorized::BinaryColumn::create();
+    column->append(Slice("connection refused by peer"));
+    column->append(Slice("disk error on /dev/sda"));
+    column->append(Slice("errors: none"));
+    std::vector<uint8_t> selection(3);
+
+    contains("error")->evaluate(column.get(), selection.data());
+    ASSERT_EQ((std::vector<uint8_t>{0, 1, 1}), selection);
+
+    // "errors" is a token different from "error".
+    match("error disk")->evaluate(column.get(), selection.data());
+    ASSERT_EQ((std::vector<uint8_t>{0, 1, 0}), selection);
+
+    match("peer refused")->evaluate(column.get(), selection.data());
+    ASSERT_EQ((std::vector<uint8_t>{1, 0, 0}), selection);
+}
+
+TEST_F(TextIndexTest, test_ngram_bloom_filter_index) {
+    std::string file_name = kTestDir + "/ngram";
+    ColumnIndexMetaPB meta;
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        ASSERT_TRUE(_block_mgr->create_block(fs::CreateBlockOptions({file_name}), &wblock).ok());
+        NGramBloomFilterIndexWriter writer(BloomFilterOptions(), kDefaultNGramSize);
+        // page 0
+        std::vector<Slice> page0{Slice("GET /index.html 200"), Slice("GET /login 302")};
+        writer.add_values(page0.data(), page0.size());
+        ASSERT_TRUE(writer.flush().ok());
+        // page 1
+        std::vector<Slice> page1{Slice("POST /login 500 internal error")};
+        writer.add_values(page1.data(), page1.size());
+        writer.add_nulls(1);
+        ASSERT_TRUE(writer.flush().ok());
+        ASSERT_TRUE(writer.finish(wblock.get(), &meta).ok());
+        ASSERT_TRUE(wblock->close().ok());
+    }
+    ASSERT_EQ(NGRAM_BLOOM_FILTER_INDEX, meta.type());
+    ASSERT_EQ(kDefaultNGramSize, meta.ngram_bloom_filter_index().gram_size());
+
+    BloomFilterIndexReader reader;
+    ASSERT_TRUE(reader.load(_block_mgr, file_name, &meta.ngram_bloom_filter_index().bloom_filter(), true, false).ok());
+    std::unique_ptr<BloomFilterIndexIterator> iter;
+    ASSERT_TRUE(reader.new_iterator(&iter).ok());
+
+    std::unique_ptr<BloomFilter> bf0;
+    std::unique_ptr<BloomFilter> bf1;
+    ASSERT_TRUE(iter->read_bloom_filter(0, &bf0).ok());
+    ASSERT_TRUE(iter->read_bloom_filter(1, &bf1).ok());
+    ASSERT_FALSE(bf0->has_null());
+    ASSERT_TRUE(bf1->has_null());
+
+    auto p = contains("index.html");
+    ASSERT_TRUE(p->support_ngram_bloom_filter());
+    ASSERT_TRUE(p->ngram_bloom_filter(bf0.get(), kDefaultNGramSize));
+    ASSERT_FALSE(p->ngram_bloom_filter(bf1.get(), kDefaultNGramSize));
+
+    p = contains("/login");
+    ASSERT_TRUE(p->ngram_bloom_filter(bf0.get(), kDefaultNGramSize));
+    ASSERT_TRUE(p->ngram_bloom_filter(bf1.get(), kDefaultNGramSize));
+
+    p = match("internal error");
+    ASSERT_TRUE(p->support_ngram_bloom_filter());
+    ASSERT_FALSE(p->ngram_bloom_filter(bf0.get(), kDefaultNGramSize));
+    ASSERT_TRUE(p->ngram_bloom_filter(bf1.get(), kDefaultNGramSize));
+
+    // Too short to be filtered.
+    ASSERT_FALSE(contains("50")->support_ngram_bloom_filter());
+}
+
+TEST_F(TextIndexTest, test_inverted_index) {
+    std::string file_name = kTestDir + "/inverted";
+    ColumnIndexMetaPB meta;
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        ASSERT_TRUE(_block_mgr->create_block(fs::CreateBlockOptions({file_name}), &wblock).ok());
+        InvertedIndexWriter writer;
+        std::vector<Slice> values0{Slice("user alice login"), Slice("user bob logout")};
+        writer.add_values(values0.data(), values0.size());
+        writer.add_nulls(2);
+        std::vector<Slice> values1{Slice("user alice logout"), Slice("")};
+        writer.add_values(values1.data(), values1.size());
+        ASSERT_TRUE(writer.finish(wblock.get(), &meta).ok());
+        ASSERT_TRUE(wblock->close().ok());
+    }
+    ASSERT_EQ(INVERTED_INDEX, meta.type());
+
+    BitmapIndexReader reader;
+    ASSERT_TRUE(reader.load(_block_mgr, file_name, &meta.inverted_index(), true, false).ok());
+    BitmapIndexIterator* raw_iter = nullptr;
+    ASSERT_TRUE(reader.new_iterator(&raw_iter).ok());
+    std::unique_ptr<BitmapIndexIterator> iter(raw_iter);
+    ASSERT_TRUE(iter->has_null_bitmap());
+    // alice, bob, login, logout, user and the null bitmap
+    ASSERT_EQ(6, iter->bitmap_nums());
+
+    Roaring rows;
+    ASSERT_TRUE(match("alice")->seek_inverted_index(iter.get(), &rows).ok());
+    ASSERT_EQ(Roaring::bitmapOf(2, 0, 4), rows);
+
+    ASSERT_TRUE(match("logout user")->seek_inverted_index(iter.get(), &rows).ok());
+    ASSERT_EQ(Roaring::bitmapOf(2, 1, 4), rows);
+
+    ASSERT_TRUE(match("alice logout")->seek_inverted_index(iter.get(), &rows).ok());
+    ASSERT_EQ(Roaring::bitmapOf(1, 4), rows);
+
+    ASSERT_TRUE(match("carol")->seek_inverted_index(iter.get(), &rows).ok());
+    ASSERT_TRUE(rows.isEmpty());
+
+    // Substrings are not answered by the tokens.
+    ASSERT_TRUE(contains("alice")->seek_inverted_index(iter.get(), &rows).is_cancelled());
+}
+
+} // namespace starrocks::segment_v2
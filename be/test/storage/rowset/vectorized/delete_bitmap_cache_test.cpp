@@ -0,0 +1,41 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/vectorized/delete_bitmap_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "storage/del_vector.h"
+
+namespace starrocks::vectorized {
+
+TEST(DeleteBitmapCacheTest, LookupAndInsert) {
+    DeleteBitmapCache cache(1024 * 1024);
+    std::string key = DeleteBitmapCache::make_key("/data/0.dat", 5);
+    ASSERT_EQ(nullptr, cache.lookup(key));
+
+    std::vector<uint32_t> rowids{1, 3, 100};
+    auto del_vec = std::make_shared<DelVector>();
+    del_vec->init(5, rowids.data(), rowids.size());
+    cache.insert(key, del_vec);
+    auto cached = cache.lookup(key);
+    ASSERT_EQ(del_vec, cached);
+    ASSERT_EQ(3, cached->cardinality());
+    ASSERT_EQ(key.size() + del_vec->memory_usage(), cache.memory_usage());
+
+    // a newer delete or another segment doesn't hit the bitmap
+    ASSERT_EQ(nullptr, cache.lookup(DeleteBitmapCache::make_key("/data/0.dat", 6)));
+    ASSERT_EQ(nullptr, cache.lookup(DeleteBitmapCache::make_key("/data/1.dat", 5)));
+}
+
+TEST(DeleteBitmapCacheTest, NoDeletedRows) {
+    DeleteBitmapCache cache(1024 * 1024);
+    std::string key = DeleteBitmapCache::make_key("/data/0.dat", 5);
+    auto del_vec = std::make_shared<DelVector>();
+    del_vec->init(5, nullptr, 0);
+    cache.insert(key, del_vec);
+    auto cached = cache.lookup(key);
+    ASSERT_NE(nullptr, cached);
+    ASSERT_TRUE(cached->empty());
+}
+
+} // namespace starrocks::vectorized
@@ -23,6 +23,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
+#include "gutil/strings/substitute.h"
 #include "storage/row_cursor.h"
 #include "storage/tablet_schema_helper.h"
 #include "util/debug_util.h"
@@ -159,4 +162,40 @@ TEST_F(ShortKeyIndexTest, enocde) {
     }
 }
 
+TEST_F(ShortKeyIndexTest, seek_by_prefix) {
+    // Many keys share the first 8 bytes, and some are shorter than 8 bytes.
+    std::vector<std::string> keys;
+    for (int i = 0; i < 3000; i += 3) {
+        keys.push_back(strings::Substitute("$0", i / 300));
+        keys.push_back(strings::Substitute("prefix__$0", i));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    ShortKeyIndexBuilder builder(0, 1024);
+    for (const auto& key : keys) {
+        ASSERT_TRUE(builder.add_item(key).ok());
+    }
+    std::vector<Slice> slices;
+    segment_v2::PageFooterPB footer;
+    ASSERT_TRUE(builder.finalize(keys.size() * 1024, &slices, &footer).ok());
+    std::string buf;
+    for (auto& slice : slices) {
+        buf.append(slice.data, slice.size);
+    }
+    ShortKeyIndexDecoder decoder;
+    ASSERT_TRUE(decoder.parse(buf, footer.short_key_page_footer()).ok());
+
+    std::vector<std::string> probes{"", "0", "00", "5", "9", "prefix", "prefix_", "prefix__", "prefix___"};
+    for (int i = 0; i < 3010; i++) {
+        probes.push_back(strings::Substitute("prefix__$0", i));
+    }
+    for (const auto& probe : probes) {
+        auto lower = std::lower_bound(keys.begin(), keys.end(), probe) - keys.begin();
+        auto upper = std::upper_bound(keys.begin(), keys.end(), probe) - keys.begin();
+        ASSERT_EQ(lower, decoder.lower_bound(probe).ordinal()) << probe;
+        ASSERT_EQ(upper, decoder.upper_bound(probe).ordinal()) << probe;
+    }
+}
+
 } // namespace starrocks
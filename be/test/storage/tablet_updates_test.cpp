@@ -10,8 +10,10 @@
 
 #include "column/datum_tuple.h"
 #include "column/vectorized_fwd.h"
+#include "env/env.h"
 #include "gutil/strings/substitute.h"
 #include "storage/olap_meta.h"
+#include "storage/primary_index.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_writer.h"
@@ -352,6 +354,51 @@ TEST_F(TabletUpdatesTest, writeread_with_delete) {
     ASSERT_EQ(N, read_tablet(_tablet, 4));
 }
 
+TEST_F(TabletUpdatesTest, load_primary_index_from_snapshot) {
+    config::enable_primary_index_snapshot = true;
+    config::primary_index_snapshot_min_changed_keys = 1;
+    DeferOp reset_config([] {
+        config::enable_primary_index_snapshot = false;
+        config::primary_index_snapshot_min_changed_keys = 10000000;
+    });
+    _tablet = create_tablet(rand(), rand());
+    const int N = 8000;
+    std::vector<int64_t> keys;
+    for (int i = 0; i < N; i++) {
+        keys.push_back(i);
+    }
+    // The snapshot is saved after applying version 2.
+    ASSERT_TRUE(_tablet->rowset_commit(2, create_rowset(_tablet, keys)).ok());
+    ASSERT_EQ(N, read_tablet(_tablet, 2));
+    // The snapshot is saved by the apply thread after the version becomes visible.
+    const std::string snapshot_path = PrimaryIndex::snapshot_path(*_tablet);
+    for (int i = 0; i < 100 && !Env::Default()->path_exists(snapshot_path).ok(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    ASSERT_TRUE(Env::Default()->path_exists(snapshot_path).ok());
+    config::primary_index_snapshot_min_changed_keys = 10000000;
+
+    // Delete [0, N/2), then update [N/2, N).
+    vectorized::Int64Column deletes;
+    deletes.append_numbers(keys.data(), sizeof(int64_t) * keys.size() / 2);
+    ASSERT_TRUE(_tablet->rowset_commit(3, create_rowset(_tablet, {}, &deletes)).ok());
+    std::vector<int64_t> updates(keys.begin() + N / 2, keys.end());
+    ASSERT_TRUE(_tablet->rowset_commit(4, create_rowset(_tablet, updates)).ok());
+    ASSERT_EQ(N / 2, read_tablet(_tablet, 4));
+
+    // The index is loaded from the snapshot of version 2 and the rowsets of version 3 and 4.
+    auto manager = StorageEngine::instance()->update_manager();
+    auto index_entry = manager->index_cache().get_or_create(_tablet->tablet_id());
+    index_entry->value().unload();
+    manager->index_cache().release(index_entry);
+    ASSERT_TRUE(_tablet->rowset_commit(5, create_rowset(_tablet, keys)).ok());
+    ASSERT_EQ(N, read_tablet_and_compare(_tablet, 5, keys));
+    index_entry = manager->index_cache().get(_tablet->tablet_id());
+    ASSERT_TRUE(index_entry != nullptr);
+    ASSERT_EQ(N, index_entry->value().size());
+    manager->index_cache().release(index_entry);
+}
+
 TEST_F(TabletUpdatesTest, noncontinous_commit) {
     _tablet = create_tablet(rand(), rand());
     const int N = 100;
@@ -687,6 +734,34 @@ TEST_F(TabletUpdatesTest, compaction) {
     EXPECT_EQ(best_tablet->updates()->get_compaction_score(), -1);
 }
 
+// NOLINTNEXTLINE
+TEST_F(TabletUpdatesTest, compaction_of_too_many_rowsets) {
+    srand(GetCurrentTimeMicros());
+    _tablet = create_tablet(rand(), rand());
+    for (int version = 2; version <= 4; version++) {
+        std::vector<int64_t> keys;
+        for (int i = 0; i < 100; i++) {
+            keys.push_back(version * 100 + i);
+        }
+        ASSERT_TRUE(_tablet->rowset_commit(version, create_rowset(_tablet, keys)).ok());
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+    ASSERT_EQ(3, _tablet->updates()->num_rowsets());
+    int32_t old_max_rowsets = config::update_compaction_max_rowsets;
+    int64_t score = _tablet->updates()->get_compaction_score();
+    config::update_compaction_max_rowsets = 1;
+    // the two extra rowsets make the tablet more worthy of compaction.
+    int64_t boosted_score = _tablet->updates()->get_compaction_score();
+    EXPECT_EQ(score + 2 * 32 * 1024 * 1024, boosted_score);
+    size_t input_bytes = 0;
+    ASSERT_TRUE(_tablet->updates()->compaction(_compaction_mem_tracker.get(), &input_bytes).ok());
+    config::update_compaction_max_rowsets = old_max_rowsets;
+    EXPECT_GT(input_bytes, 0);
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    ASSERT_EQ(1, _tablet->updates()->num_rowsets());
+    ASSERT_EQ(300, read_tablet(_tablet, 4));
+}
+
 TEST_F(TabletUpdatesTest, load_from_base_tablet) {
     srand(GetCurrentTimeMicros());
     _tablet = create_tablet(rand(), rand());
@@ -253,5 +253,25 @@ TEST_F(ChunkHelperTest, NewChunkWithTuple) {
     ASSERT_EQ(chunk->get_column_by_slot_id(8)->get_name(), "binary");
 }
 
+TEST_F(ChunkHelperTest, AdaptiveChunkSize) {
+    TabletSchemaPB tablet_schema_pb;
+    add_tablet_column(tablet_schema_pb, 0, true, "INT", 4, false);
+    std::vector<ColumnId> all_cids{0};
+    for (int32_t id = 1; id <= 500; id++) {
+        add_tablet_column(tablet_schema_pb, id, false, "BIGINT", 8, true);
+        all_cids.push_back(id);
+    }
+    TabletSchema tablet_schema;
+    tablet_schema.init_from_pb(tablet_schema_pb);
+
+    // the narrow rows are read at most max_rows rows a chunk
+    ASSERT_EQ(4096, ChunkHelper::adaptive_chunk_size(tablet_schema, {0}, 2 * 1024 * 1024, 4096));
+    // 4 + 500 * (8 + 1) bytes a row
+    ASSERT_EQ(2 * 1024 * 1024 / 4504, ChunkHelper::adaptive_chunk_size(tablet_schema, all_cids, 2 * 1024 * 1024, 4096));
+    ASSERT_EQ(256, ChunkHelper::adaptive_chunk_size(tablet_schema, all_cids, 1024 * 1024, 4096));
+    ASSERT_EQ(4096, ChunkHelper::adaptive_chunk_size(tablet_schema, all_cids, 0, 4096));
+    ASSERT_EQ(100, ChunkHelper::adaptive_chunk_size(tablet_schema, all_cids, 1024 * 1024, 100));
+}
+
 } // namespace vectorized
 } // namespace starrocks
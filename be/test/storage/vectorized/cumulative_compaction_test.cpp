@@ -4,6 +4,8 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+
 #include "runtime/exec_env.h"
 #include "storage/row_cursor.h"
 #include "storage/rowset/rowset_factory.h"
@@ -114,6 +116,56 @@ public:
         }
     }
 
+    // Create a tablet with two rowsets of the same rows, whose versions are 0-0 and 1-1.
+    void create_tablet_with_two_rowsets(KeysType keys_type, TabletSharedPtr* tablet) {
+        config::storage_format_version = 2;
+        create_tablet_schema(keys_type);
+
+        RowsetWriterContext rowset_writer_context(kDataFormatUnknown, config::storage_format_version);
+        create_rowset_writer_context(&rowset_writer_context);
+        std::unique_ptr<RowsetWriter> _rowset_writer;
+        ASSERT_EQ(OLAP_SUCCESS, RowsetFactory::create_rowset_writer(rowset_writer_context, &_rowset_writer));
+
+        rowset_writer_add_rows(_rowset_writer);
+
+        _rowset_writer->flush();
+        RowsetSharedPtr src_rowset = _rowset_writer->build();
+        ASSERT_TRUE(src_rowset != nullptr);
+        RowsetId src_rowset_id;
+        src_rowset_id.init(10000);
+        ASSERT_EQ(src_rowset_id, src_rowset->rowset_id());
+        ASSERT_EQ(1024, src_rowset->num_rows());
+
+        TabletMetaSharedPtr tablet_meta(new TabletMeta(_tablet_meta_mem_tracker.get()));
+        create_tablet_meta(tablet_meta.get());
+        tablet_meta->add_rs_meta(src_rowset->rowset_meta());
+
+        {
+            RowsetId src_rowset_id;
+            src_rowset_id.init(10001);
+            rowset_writer_context.rowset_id = src_rowset_id;
+            rowset_writer_context.version =
+                    Version(rowset_writer_context.version.second + 1, rowset_writer_context.version.second + 1);
+
+            std::unique_ptr<RowsetWriter> _rowset_writer;
+            ASSERT_EQ(OLAP_SUCCESS, RowsetFactory::create_rowset_writer(rowset_writer_context, &_rowset_writer));
+
+            rowset_writer_add_rows(_rowset_writer);
+
+            _rowset_writer->flush();
+            RowsetSharedPtr src_rowset = _rowset_writer->build();
+            ASSERT_TRUE(src_rowset != nullptr);
+            ASSERT_EQ(src_rowset_id, src_rowset->rowset_id());
+            ASSERT_EQ(1024, src_rowset->num_rows());
+
+            tablet_meta->add_rs_meta(src_rowset->rowset_meta());
+        }
+
+        *tablet = Tablet::create_tablet_from_meta(_tablet_meta_mem_tracker.get(), tablet_meta,
+                                                  starrocks::ExecEnv::GetInstance()->storage_engine()->get_stores()[0]);
+        (*tablet)->init();
+    }
+
     void SetUp() override {
         config::min_cumulative_compaction_num_singleton_deltas = 2;
         config::max_compaction_concurrency = 1;
@@ -191,59 +243,68 @@ TEST_F(CumulativeCompactionTest, test_candidate_rowsets_empty) {
 }
 
 TEST_F(CumulativeCompactionTest, test_compact_succeed) {
-    config::storage_format_version = 2;
-    create_tablet_schema(UNIQUE_KEYS);
-
-    RowsetWriterContext rowset_writer_context(kDataFormatUnknown, config::storage_format_version);
-    create_rowset_writer_context(&rowset_writer_context);
-    std::unique_ptr<RowsetWriter> _rowset_writer;
-    ASSERT_EQ(OLAP_SUCCESS, RowsetFactory::create_rowset_writer(rowset_writer_context, &_rowset_writer));
+    TabletSharedPtr tablet;
+    ASSERT_NO_FATAL_FAILURE(create_tablet_with_two_rowsets(UNIQUE_KEYS, &tablet));
 
-    rowset_writer_add_rows(_rowset_writer);
-
-    _rowset_writer->flush();
-    RowsetSharedPtr src_rowset = _rowset_writer->build();
-    ASSERT_TRUE(src_rowset != nullptr);
-    RowsetId src_rowset_id;
-    src_rowset_id.init(10000);
-    ASSERT_EQ(src_rowset_id, src_rowset->rowset_id());
-    ASSERT_EQ(1024, src_rowset->num_rows());
+    config::cumulative_compaction_skip_window_seconds = -2;
 
-    TabletMetaSharedPtr tablet_meta(new TabletMeta(_tablet_meta_mem_tracker.get()));
-    create_tablet_meta(tablet_meta.get());
-    tablet_meta->add_rs_meta(src_rowset->rowset_meta());
+    CumulativeCompaction cumulative_compaction(_compaction_mem_tracker.get(), tablet);
 
-    {
-        RowsetId src_rowset_id;
-        src_rowset_id.init(10001);
-        rowset_writer_context.rowset_id = src_rowset_id;
-        rowset_writer_context.version =
-                Version(rowset_writer_context.version.second + 1, rowset_writer_context.version.second + 1);
+    ASSERT_TRUE(cumulative_compaction.compact().ok());
+}
 
-        std::unique_ptr<RowsetWriter> _rowset_writer;
-        ASSERT_EQ(OLAP_SUCCESS, RowsetFactory::create_rowset_writer(rowset_writer_context, &_rowset_writer));
+TEST_F(CumulativeCompactionTest, test_vertical_compact_succeed) {
+    TabletSharedPtr tablet;
+    ASSERT_NO_FATAL_FAILURE(create_tablet_with_two_rowsets(UNIQUE_KEYS, &tablet));
 
-        rowset_writer_add_rows(_rowset_writer);
+    config::cumulative_compaction_skip_window_seconds = -2;
+    const int32_t max_columns_per_group = config::vertical_compaction_max_columns_per_group;
+    config::vertical_compaction_max_columns_per_group = 1;
 
-        _rowset_writer->flush();
-        RowsetSharedPtr src_rowset = _rowset_writer->build();
-        ASSERT_TRUE(src_rowset != nullptr);
-        ASSERT_EQ(src_rowset_id, src_rowset->rowset_id());
-        ASSERT_EQ(1024, src_rowset->num_rows());
+    CumulativeCompaction cumulative_compaction(_compaction_mem_tracker.get(), tablet);
+    Status st = cumulative_compaction.compact();
+    config::vertical_compaction_max_columns_per_group = max_columns_per_group;
+    ASSERT_TRUE(st.ok()) << st.to_string();
+
+    // the rows of the same keys of the two rowsets are merged.
+    RowsetSharedPtr output_rowset = tablet->rowset_with_max_version();
+    ASSERT_EQ(Version(0, 1), output_rowset->version());
+    ASSERT_EQ(1024, output_rowset->num_rows());
+}
 
-        tablet_meta->add_rs_meta(src_rowset->rowset_meta());
-    }
+TEST_F(CumulativeCompactionTest, test_size_tiered_level) {
+    const int64_t min_level_size = config::size_tiered_compaction_min_level_size;
+    const int64_t level_multiple = config::size_tiered_compaction_level_multiple;
+    config::size_tiered_compaction_min_level_size = 1024;
+    config::size_tiered_compaction_level_multiple = 4;
+
+    ASSERT_EQ(0, CumulativeCompaction::size_tiered_level(0));
+    ASSERT_EQ(0, CumulativeCompaction::size_tiered_level(1024));
+    ASSERT_EQ(1, CumulativeCompaction::size_tiered_level(1025));
+    ASSERT_EQ(1, CumulativeCompaction::size_tiered_level(4096));
+    ASSERT_EQ(2, CumulativeCompaction::size_tiered_level(4097));
+    ASSERT_LT(0, CumulativeCompaction::size_tiered_level(std::numeric_limits<int64_t>::max()));
+
+    config::size_tiered_compaction_min_level_size = min_level_size;
+    config::size_tiered_compaction_level_multiple = level_multiple;
+}
 
-    TabletSharedPtr tablet =
-            Tablet::create_tablet_from_meta(_tablet_meta_mem_tracker.get(), tablet_meta,
-                                            starrocks::ExecEnv::GetInstance()->storage_engine()->get_stores()[0]);
-    tablet->init();
+TEST_F(CumulativeCompactionTest, test_size_tiered_compact_succeed) {
+    TabletSharedPtr tablet;
+    ASSERT_NO_FATAL_FAILURE(create_tablet_with_two_rowsets(DUP_KEYS, &tablet));
 
     config::cumulative_compaction_skip_window_seconds = -2;
+    config::enable_size_tiered_compaction_for_dup_keys = true;
 
     CumulativeCompaction cumulative_compaction(_compaction_mem_tracker.get(), tablet);
-
-    ASSERT_TRUE(cumulative_compaction.compact().ok());
+    Status st = cumulative_compaction.compact();
+    ASSERT_TRUE(st.ok()) << st.to_string();
+
+    // the two rowsets of the same size are merged, and the cumulative point stays before the output rowset.
+    RowsetSharedPtr output_rowset = tablet->rowset_with_max_version();
+    ASSERT_EQ(Version(0, 1), output_rowset->version());
+    ASSERT_EQ(2048, output_rowset->num_rows());
+    ASSERT_EQ(0, tablet->cumulative_layer_point());
 }
 
 } // namespace starrocks::vectorized
@@ -17,6 +17,7 @@
 #include "storage/schema.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "util/file_utils.h"
+#include "util/threadpool.h"
 
 namespace starrocks::vectorized {
 
@@ -310,6 +311,164 @@ TEST_F(MemTableTest, testUniqKeysInsertFlushRead) {
     ASSERT_EQ(n, pkey_read);
 }
 
+TEST_F(MemTableTest, testDupKeysRadixSort) {
+    const string path = "./ut_dir/MemTableTest_testDupKeysRadixSort";
+    MySetUp("pk bigint,v int", "pk bigint,v int", 1, KeysType::DUP_KEYS, path);
+    // the keys are negative and positive with duplicates, and the values are the order of insertion.
+    const size_t n = 20000;
+    shared_ptr<Chunk> pchunk = ChunkHelper::new_chunk(*_slots, n);
+    for (int i = 0; i < n; i++) {
+        Datum v;
+        v.set_int64((i * 7919L) % 1000 - 500);
+        pchunk->get_column_by_index(0)->append_datum(v);
+        v.set_int32(i);
+        pchunk->get_column_by_index(1)->append_datum(v);
+    }
+    vector<uint32_t> indexes(n);
+    for (int i = 0; i < n; i++) {
+        indexes[i] = i;
+    }
+    _mem_table->insert(pchunk.get(), indexes.data(), 0, indexes.size());
+    ASSERT_TRUE(_mem_table->finalize().ok());
+    ASSERT_EQ(OLAP_SUCCESS, _mem_table->flush());
+    RowsetSharedPtr rowset = _writer->build();
+    unique_ptr<Schema> read_schema = create_schema("pk bigint,v int", 1);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto itr = rowset->new_iterator(*read_schema, rs_opts);
+    ASSERT_TRUE(itr.ok()) << itr.status().to_string();
+    std::shared_ptr<vectorized::Chunk> chunk = vectorized::ChunkHelper::new_chunk(*read_schema, 4096);
+    size_t rows_read = 0;
+    int64_t last_key = INT64_MIN;
+    int32_t last_value = -1;
+    while (true) {
+        Status st = (*itr)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            int64_t key = chunk->get_column_by_index(0)->get(i).get_int64();
+            int32_t value = chunk->get_column_by_index(1)->get(i).get_int32();
+            ASSERT_LE(last_key, key);
+            // the rows of the same key keep the order of insertion.
+            if (key == last_key) {
+                ASSERT_LT(last_value, value);
+            }
+            last_key = key;
+            last_value = value;
+        }
+        rows_read += chunk->num_rows();
+        chunk->reset();
+    }
+    ASSERT_EQ(n, rows_read);
+}
+
+TEST_F(MemTableTest, testUniqKeysParallelFlush) {
+    const string path = "./ut_dir/MemTableTest_testUniqKeysParallelFlush";
+    MySetUp("pk int,name varchar,pv int", "pk int,name varchar,pv int", 1, KeysType::UNIQUE_KEYS, path);
+    const size_t n = 10000;
+    auto pchunk = gen_chunk(*_slots, n);
+    vector<uint32_t> indexes;
+    indexes.reserve(2 * n);
+    for (int i = 0; i < 2 * n; i++) {
+        indexes.emplace_back(i % n);
+    }
+    std::random_shuffle(indexes.begin(), indexes.end());
+    _mem_table->insert(pchunk.get(), indexes.data(), 0, indexes.size());
+    ASSERT_TRUE(_mem_table->finalize().ok());
+
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_TRUE(ThreadPoolBuilder("segment_flush").set_max_threads(3).build(&pool).ok());
+    auto old_min_bytes = config::memtable_flush_min_bytes_per_parallel_segment;
+    config::memtable_flush_min_bytes_per_parallel_segment = 1;
+    ASSERT_EQ(OLAP_SUCCESS, _mem_table->flush(pool.get()));
+    config::memtable_flush_min_bytes_per_parallel_segment = old_min_bytes;
+    RowsetSharedPtr rowset = _writer->build();
+    ASSERT_EQ(config::memtable_flush_max_parallel_segments, rowset->num_segments());
+
+    unique_ptr<Schema> read_schema = create_schema("pk int", 1);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto itr = rowset->new_iterator(*read_schema, rs_opts);
+    ASSERT_TRUE(itr.ok()) << itr.status().to_string();
+    std::shared_ptr<vectorized::Chunk> chunk = vectorized::ChunkHelper::new_chunk(*read_schema, 4096);
+    std::vector<int> keys;
+    while (true) {
+        Status st = (*itr)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            keys.push_back(chunk->get_column_by_index(0)->get(i).get_int32());
+        }
+        chunk->reset();
+    }
+    // each key is written once by one of the segments.
+    ASSERT_EQ(n, keys.size());
+    std::sort(keys.begin(), keys.end());
+    for (int i = 0; i < n; i++) {
+        ASSERT_EQ(i + 3, keys[i]);
+    }
+}
+
+TEST_F(MemTableTest, testUniqKeysSortedInsert) {
+    const string path = "./ut_dir/MemTableTest_testUniqKeysSortedInsert";
+    MySetUp("pk int,name varchar,pv int", "pk int,name varchar,pv int", 1, KeysType::UNIQUE_KEYS, path);
+    const size_t n = 1000;
+    auto pchunk = gen_chunk(*_slots, n);
+    // every key is inserted twice in order, and the duplicates are split by the inserts sometimes.
+    vector<uint32_t> indexes;
+    indexes.reserve(2 * n);
+    for (int i = 0; i < 2 * n; i++) {
+        indexes.emplace_back(i / 2);
+    }
+    // merge after every insert.
+    auto old_write_buffer_size = config::write_buffer_size;
+    config::write_buffer_size = 1;
+    for (uint32_t from = 0; from < indexes.size(); from += 333) {
+        auto size = std::min<uint32_t>(333, indexes.size() - from);
+        _mem_table->insert(pchunk.get(), indexes.data(), from, size);
+    }
+    config::write_buffer_size = old_write_buffer_size;
+    ASSERT_TRUE(_mem_table->finalize().ok());
+    ASSERT_EQ(OLAP_SUCCESS, _mem_table->flush());
+    RowsetSharedPtr rowset = _writer->build();
+
+    unique_ptr<Schema> read_schema = create_schema("pk int", 1);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto itr = rowset->new_iterator(*read_schema, rs_opts);
+    ASSERT_TRUE(itr.ok()) << itr.status().to_string();
+    std::shared_ptr<vectorized::Chunk> chunk = vectorized::ChunkHelper::new_chunk(*read_schema, 4096);
+    std::vector<int> keys;
+    while (true) {
+        Status st = (*itr)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            keys.push_back(chunk->get_column_by_index(0)->get(i).get_int32());
+        }
+        chunk->reset();
+    }
+    ASSERT_EQ(n, keys.size());
+    for (int i = 0; i < n; i++) {
+        ASSERT_EQ(i + 3, keys[i]);
+    }
+}
+
 TEST_F(MemTableTest, testPrimaryKeysWithDeletes) {
     const string path = "./ut_dir/MemTableTest_testPrimaryKeysWithDeletes";
     MySetUp("pk bigint,v1 int", "pk bigint,v1 int,__op tinyint", 1, KeysType::PRIMARY_KEYS, path);
@@ -105,6 +105,57 @@ TEST_F(MergeIteratorTest, heap_merge_no_overlapping) {
     ASSERT_TRUE(iter->get_next(chunk.get()).is_end_of_file());
 }
 
+// NOLINTNEXTLINE
+TEST_F(MergeIteratorTest, merge_by_key_ranges) {
+    std::vector<int32_t> v1{20, 21, 22};
+    std::vector<int32_t> v2{1, 2, 5};
+    std::vector<int32_t> v3{5, 6, 8};
+    std::vector<int32_t> v4{10, 12};
+    auto new_children = [&]() {
+        return std::vector<ChunkIteratorPtr>{std::make_shared<VectorChunkIterator>(_schema, COL_INT(v1)),
+                                             std::make_shared<VectorChunkIterator>(_schema, COL_INT(v2)),
+                                             std::make_shared<VectorChunkIterator>(_schema, COL_INT(v3)),
+                                             std::make_shared<VectorChunkIterator>(_schema, COL_INT(v4))};
+    };
+    auto read_all = [&](const ChunkIteratorPtr& iter) {
+        std::vector<int32_t> real;
+        ChunkPtr chunk = ChunkHelper::new_chunk(iter->schema(), config::vector_chunk_size);
+        while (iter->get_next(chunk.get()).ok()) {
+            ColumnPtr& c = chunk->get_column_by_index(0);
+            for (size_t i = 0; i < c->size(); i++) {
+                real.push_back(c->get(i).get_int32());
+            }
+            chunk->reset();
+        }
+        return real;
+    };
+    std::vector<int32_t> expected{1, 2, 5, 5, 6, 8, 10, 12, 20, 21, 22};
+    const TypeInfoPtr& key_type = _schema.field(0)->type();
+
+    // v2 and v3 overlap at 5, the others are disjoint.
+    std::vector<std::pair<Datum, Datum>> ranges{{Datum(20), Datum(22)},
+                                                {Datum(1), Datum(5)},
+                                                {Datum(5), Datum(8)},
+                                                {Datum(10), Datum(12)}};
+    bool merged = false;
+    auto iter = new_merge_iterator(new_children(), key_type, ranges, &merged);
+    ASSERT_TRUE(merged);
+    ASSERT_EQ(expected, read_all(iter));
+
+    ranges[2] = {Datum(6), Datum(8)};
+    auto children = new_children();
+    children[2] = std::make_shared<VectorChunkIterator>(_schema, COL_INT({6, 8}));
+    iter = new_merge_iterator(children, key_type, ranges, &merged);
+    ASSERT_FALSE(merged);
+    ASSERT_EQ((std::vector<int32_t>{1, 2, 5, 6, 8, 10, 12, 20, 21, 22}), read_all(iter));
+
+    // an unknown range overlaps all the others.
+    ranges[0] = {};
+    iter = new_merge_iterator(new_children(), key_type, ranges, &merged);
+    ASSERT_TRUE(merged);
+    ASSERT_EQ(expected, read_all(iter));
+}
+
 // NOLINTNEXTLINE
 TEST_F(MergeIteratorTest, merge_one) {
     auto sub1 = std::make_shared<VectorChunkIterator>(_schema, COL_INT({1, 1, 2, 3, 4, 5}));
@@ -138,4 +189,93 @@ TEST_F(MergeIteratorTest, test_issue_DSDB_2715) {
     iter->close();
 }
 
+// NOLINTNEXTLINE
+TEST_F(MergeIteratorTest, merge_by_row_sources) {
+    std::vector<std::vector<int32_t>> keys{{1, 1, 2, 3, 4, 5}, {1, 3, 3, 15, 16}, {2, 4, 14, 18}};
+    auto value_field = std::make_shared<Field>(1, "v1", get_type_info(OLAP_FIELD_TYPE_INT), false);
+    Schema value_schema(std::vector<FieldPtr>{value_field});
+
+    std::vector<ChunkIteratorPtr> key_iters;
+    std::vector<ChunkIteratorPtr> value_iters;
+    for (size_t i = 0; i < keys.size(); i++) {
+        std::vector<int32_t> values;
+        for (int32_t key : keys[i]) {
+            values.push_back(key * 10 + i);
+        }
+        auto key_iter = std::make_shared<VectorChunkIterator>(_schema, COL_INT(keys[i]));
+        auto value_iter = std::make_shared<VectorChunkIterator>(value_schema, COL_INT(values));
+        key_iter->chunk_size(2);
+        value_iter->chunk_size(3);
+        key_iters.emplace_back(std::move(key_iter));
+        value_iters.emplace_back(std::move(value_iter));
+    }
+
+    // merge the keys and record the sources of the rows.
+    std::vector<RowSource> chunk_sources;
+    RowSourceBuffer sources("./merge_by_row_sources.tmp", 0);
+    auto key_iter = new_merge_iterator(key_iters, &chunk_sources);
+    std::vector<int32_t> merged_keys;
+    ChunkPtr chunk = ChunkHelper::new_chunk(key_iter->schema(), config::vector_chunk_size);
+    while (key_iter->get_next(chunk.get()).ok()) {
+        ASSERT_EQ(chunk->num_rows(), chunk_sources.size());
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            merged_keys.push_back(chunk->get_column_by_index(0)->get(i).get_int32());
+        }
+        ASSERT_TRUE(sources.append(chunk_sources).ok());
+        chunk->reset();
+    }
+    ASSERT_TRUE(sources.flush().ok());
+    ASSERT_EQ(15, sources.num_sources());
+    ASSERT_TRUE(std::is_sorted(merged_keys.begin(), merged_keys.end()));
+
+    // the values are merged in the same order as the keys.
+    ASSERT_TRUE(sources.rewind().ok());
+    auto value_iter = new_row_source_merge_iterator(value_iters, &sources);
+    std::vector<int32_t> merged_values;
+    chunk = ChunkHelper::new_chunk(value_iter->schema(), config::vector_chunk_size);
+    while (value_iter->get_next(chunk.get()).ok()) {
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            merged_values.push_back(chunk->get_column_by_index(0)->get(i).get_int32());
+        }
+        chunk->reset();
+    }
+    ASSERT_EQ(merged_keys.size(), merged_values.size());
+    for (size_t i = 0; i < merged_keys.size(); i++) {
+        EXPECT_EQ(merged_keys[i], merged_values[i] / 10);
+        // the rows of the same keys are in the order of the children.
+        if (i > 0 && merged_keys[i] == merged_keys[i - 1]) {
+            EXPECT_LT(merged_values[i - 1] % 10, merged_values[i] % 10);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeIteratorTest, spill_row_sources) {
+    RowSourceBuffer buffer("./spill_row_sources.tmp", 1024 * sizeof(RowSource));
+    std::vector<RowSource> sources;
+    for (uint16_t i = 0; i < 5000; i++) {
+        sources.emplace_back(i % 7, i % 3 == 0);
+        if (sources.size() == 100) {
+            ASSERT_TRUE(buffer.append(sources).ok());
+            sources.clear();
+        }
+    }
+    ASSERT_TRUE(buffer.flush().ok());
+    ASSERT_EQ(5000, buffer.num_sources());
+
+    // read the sources twice.
+    for (int round = 0; round < 2; round++) {
+        ASSERT_TRUE(buffer.rewind().ok());
+        size_t n = 0;
+        while (buffer.read(333, &sources).ok()) {
+            for (const RowSource& source : sources) {
+                EXPECT_EQ(n % 7, source.source());
+                EXPECT_EQ(n % 3 == 0, source.replaced());
+                n++;
+            }
+        }
+        ASSERT_EQ(5000, n);
+    }
+}
+
 } // namespace starrocks::vectorized
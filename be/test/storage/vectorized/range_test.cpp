@@ -87,6 +87,13 @@ TEST(SparseRangeTest, range_intersection) {
     EXPECT_EQ(SparseRange({{1, 10}, {25, 26}, {30, 40}, {50, 65}}), r);
 }
 
+TEST(SparseRangeTest, rowids2range) {
+    std::vector<uint32_t> rowids{1, 2, 3, 5, 8, 9, 100};
+    EXPECT_EQ(SparseRange({{1, 4}, {5, 6}, {8, 10}, {100, 101}}), rowids2range(rowids.data(), rowids.size()));
+    EXPECT_EQ(SparseRange({{1, 2}}), rowids2range(rowids.data(), 1));
+    EXPECT_EQ(SparseRange(), rowids2range(rowids.data(), 0));
+}
+
 TEST(SparseRangeIteratorTest, covered_ranges) {
     SparseRange r1({{0, 10}, {20, 40}, {50, 70}});
     SparseRangeIterator iter = r1.new_iterator();
@@ -24,6 +24,9 @@
 #include <gtest/gtest.h>
 
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "gen_cpp/segment_v2.pb.h"
 
@@ -165,4 +168,49 @@ TEST_F(BlockCompressionTest, multi) {
     test_multi_slices(starrocks::CompressionTypePB::ZSTD);
 }
 
+TEST_F(BlockCompressionTest, zstd_dict) {
+    // The urls sharing the most of their bytes, which are compressed badly one by one without a dictionary.
+    std::vector<std::string> urls;
+    for (int i = 0; i < 2000; ++i) {
+        urls.push_back("https://www.example.com/products/category-" + std::to_string(i % 17) +
+                       "/item?id=" + std::to_string(i * 7919) + "&utm_source=newsletter&utm_medium=email");
+    }
+    std::vector<Slice> samples(urls.begin(), urls.end());
+    std::string dict;
+    ASSERT_TRUE(train_zstd_dictionary(samples, 4096, &dict).ok());
+    ASSERT_FALSE(dict.empty());
+    ASSERT_LE(dict.size(), 4096);
+
+    std::unique_ptr<BlockCompressionCodec> codec;
+    ASSERT_TRUE(create_zstd_dict_codec(dict, &codec).ok());
+    const BlockCompressionCodec* plain_codec = nullptr;
+    ASSERT_TRUE(get_block_compression_codec(starrocks::CompressionTypePB::ZSTD, &plain_codec).ok());
+
+    std::string input = urls[0] + urls[1] + urls[2];
+    std::string compressed;
+    compressed.resize(codec->max_compressed_len(input.size()));
+    Slice compressed_slice(compressed);
+    ASSERT_TRUE(codec->compress(input, &compressed_slice).ok());
+
+    std::string plain_compressed;
+    plain_compressed.resize(plain_codec->max_compressed_len(input.size()));
+    Slice plain_compressed_slice(plain_compressed);
+    ASSERT_TRUE(plain_codec->compress(input, &plain_compressed_slice).ok());
+    ASSERT_LT(compressed_slice.size, plain_compressed_slice.size);
+
+    std::string uncompressed;
+    uncompressed.resize(input.size());
+    Slice uncompressed_slice(uncompressed);
+    ASSERT_TRUE(codec->decompress(compressed_slice, &uncompressed_slice).ok());
+    ASSERT_EQ(input, uncompressed_slice.to_string());
+
+    // Not decompressed without the dictionary.
+    uncompressed_slice = Slice(uncompressed);
+    ASSERT_FALSE(plain_codec->decompress(compressed_slice, &uncompressed_slice).ok());
+
+    // Too few samples to train.
+    std::vector<Slice> few_samples(samples.begin(), samples.begin() + 2);
+    ASSERT_FALSE(train_zstd_dictionary(few_samples, 4096, &dict).ok());
+}
+
 } // namespace starrocks
@@ -0,0 +1,56 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/compression_sampler.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace starrocks {
+
+class CompressionSamplerTest : public testing::Test {};
+
+// The number of blocks skipped before the next sample.
+static size_t num_skipped(CompressionSampler* sampler) {
+    size_t num = 0;
+    while (!sampler->should_compress()) {
+        ++num;
+    }
+    return num;
+}
+
+TEST_F(CompressionSamplerTest, skip_incompressible_blocks) {
+    CompressionSampler sampler;
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(sampler.should_compress());
+        sampler.update(true);
+    }
+
+    // Skipped after kMaxFailures incompressible blocks in a row.
+    for (size_t i = 0; i < CompressionSampler::kMaxFailures; ++i) {
+        ASSERT_TRUE(sampler.should_compress());
+        sampler.update(false);
+    }
+    ASSERT_EQ(CompressionSampler::kMinSkippedBlocks, num_skipped(&sampler));
+
+    // The skipped blocks double after each failed sample.
+    for (size_t expected = CompressionSampler::kMinSkippedBlocks * 2; expected <= 4096; expected *= 2) {
+        for (size_t i = 0; i < CompressionSampler::kMaxFailures; ++i) {
+            sampler.update(false);
+            if (i + 1 < CompressionSampler::kMaxFailures) {
+                ASSERT_TRUE(sampler.should_compress());
+            }
+        }
+        ASSERT_EQ(std::min(expected, CompressionSampler::kMaxSkippedBlocks), num_skipped(&sampler));
+    }
+
+    // A compressible block resets the sampler.
+    sampler.update(true);
+    for (size_t i = 0; i < CompressionSampler::kMaxFailures; ++i) {
+        ASSERT_TRUE(sampler.should_compress());
+        sampler.update(false);
+    }
+    ASSERT_EQ(CompressionSampler::kMinSkippedBlocks, num_skipped(&sampler));
+}
+
+} // namespace starrocks
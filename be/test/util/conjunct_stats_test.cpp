@@ -0,0 +1,42 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/conjunct_stats.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+namespace starrocks {
+
+class ConjunctStatsTest : public testing::Test {};
+
+TEST_F(ConjunctStatsTest, order_by_cost_to_drop_a_row) {
+    std::vector<ConjunctStats> stats(4);
+    // expensive and selective
+    stats[0].update(1000, 10, 100000);
+    // cheap and selective
+    stats[1].update(1000, 10, 1000);
+    // drops nothing
+    stats[2].update(1000, 1000, 10000);
+    // never evaluated
+
+    std::vector<uint32_t> order(stats.size());
+    std::iota(order.begin(), order.end(), 0);
+    sort_conjuncts_by_rank(&order, [&](uint32_t i) -> const ConjunctStats& { return stats[i]; });
+    ASSERT_EQ((std::vector<uint32_t>{3, 1, 0, 2}), order);
+}
+
+TEST_F(ConjunctStatsTest, decay) {
+    ConjunctStats old_stats;
+    ConjunctStats stats;
+    // Dropped every row at first, and none later.
+    old_stats.update(ConjunctStats::kDecayRows, 0, 1000);
+    stats.update(ConjunctStats::kDecayRows, 0, 1000);
+    for (int i = 0; i < 20; i++) {
+        stats.update(ConjunctStats::kDecayRows, ConjunctStats::kDecayRows, 1000);
+    }
+    // The rows dropped at first are forgotten.
+    ASSERT_GT(stats.rank(), old_stats.rank() * 1000);
+}
+
+} // namespace starrocks
@@ -0,0 +1,63 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/json_value.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <vector>
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(JsonValueTest, test_parse) {
+    JsonValue value;
+    ASSERT_TRUE(JsonValue::parse(R"({"b": [1, 2.5, "x", null, true], "a": {"c": false}, "a": 1})", &value).ok());
+
+    JsonView root = value.view();
+    ASSERT_EQ(JsonType::JSON_OBJECT, root.type());
+    ASSERT_EQ(3, root.count());
+    // the members are sorted by their keys, and the duplicate keys keep their order.
+    ASSERT_EQ("a", root.key_at(0).to_string());
+    ASSERT_EQ("a", root.key_at(1).to_string());
+    ASSERT_EQ("b", root.key_at(2).to_string());
+    ASSERT_EQ(JsonType::JSON_OBJECT, root.find("a").type());
+    ASSERT_FALSE(root.find("c").is_valid());
+    ASSERT_FALSE(root.find("").is_valid());
+
+    JsonView array = root.find("b");
+    ASSERT_EQ(JsonType::JSON_ARRAY, array.type());
+    ASSERT_EQ(5, array.count());
+    ASSERT_EQ(1, array.element(0).get_int());
+    ASSERT_EQ(2.5, array.element(1).get_double());
+    ASSERT_EQ("x", array.element(2).get_string().to_string());
+    ASSERT_EQ(JsonType::JSON_NULL, array.element(3).type());
+    ASSERT_TRUE(array.element(4).get_bool());
+    ASSERT_FALSE(root.find("a").find("c").get_bool());
+
+    ASSERT_EQ(R"({"a":{"c":false},"a":1,"b":[1,2.5,"x",null,true]})", value.to_string());
+    ASSERT_EQ(value.serialize_size(), root.size());
+
+    ASSERT_FALSE(JsonValue::parse("{\"a\":", &value).ok());
+}
+
+// NOLINTNEXTLINE
+TEST(JsonValueTest, test_serialize) {
+    JsonValue value;
+    ASSERT_EQ("null", value.to_string());
+
+    ASSERT_TRUE(JsonValue::parse(R"([{"k": "v\"1"}, [], {}, -9223372036854775808, 1e300])", &value).ok());
+    std::vector<uint8_t> buf(value.serialize_size());
+    ASSERT_EQ(buf.size(), value.serialize(buf.data()));
+
+    JsonValue copy(Slice(buf.data(), buf.size()));
+    ASSERT_EQ(R"([{"k":"v\"1"},[],{},-9223372036854775808,1e300])", copy.to_string());
+    ASSERT_EQ(std::numeric_limits<int64_t>::min(), copy.view().element(3).get_int());
+    ASSERT_EQ(0, copy.view().element(1).count());
+    ASSERT_FALSE(copy.view().element(2).find("k").is_valid());
+
+    copy.clear();
+    ASSERT_EQ(JsonType::JSON_NULL, copy.view().type());
+}
+
+} // namespace starrocks
@@ -185,6 +185,48 @@ TEST_F(MetricsTest, Gauge) {
     }
 }
 
+TEST_F(MetricsTest, Histogram) {
+    // every value is counted within the range of its bucket, and the buckets are contiguous.
+    for (uint64_t value : {0UL, 1UL, 7UL, 8UL, 9UL, 15UL, 16UL, 17UL, 1000UL, 123456789UL, (1UL << 40) - 1}) {
+        size_t index = CoreLocalHistogram::bucket_index(value);
+        ASSERT_LT(index, CoreLocalHistogram::kNumBuckets);
+        ASSERT_LE(CoreLocalHistogram::bucket_lower_bound(index), value);
+        ASSERT_GE(CoreLocalHistogram::bucket_upper_bound(index), value);
+    }
+    for (size_t i = 1; i < CoreLocalHistogram::kNumBuckets; ++i) {
+        ASSERT_EQ(CoreLocalHistogram::bucket_upper_bound(i - 1) + 1, CoreLocalHistogram::bucket_lower_bound(i));
+    }
+    ASSERT_EQ(CoreLocalHistogram::kNumBuckets - 1, CoreLocalHistogram::bucket_index(1UL << 50));
+
+    CoreLocalHistogram histogram(MetricUnit::MICROSECONDS);
+    ASSERT_EQ(0, histogram.snapshot().percentile(0.99));
+    // the values are added by many threads, which could run on any core.
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&histogram]() {
+            for (uint64_t value = 1; value <= 10000; ++value) {
+                histogram.add(value);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto snapshot = histogram.snapshot();
+    ASSERT_EQ(40000, snapshot.count);
+    ASSERT_EQ(4 * 10000 * 10001 / 2, snapshot.sum);
+    for (double quantile : {0.5, 0.9, 0.99}) {
+        double expected = quantile * 10000;
+        double relative_error = (snapshot.percentile(quantile) - expected) / expected;
+        ASSERT_GE(relative_error, 0);
+        ASSERT_LE(relative_error, 0.125);
+    }
+
+    CoreLocalHistogram single(MetricUnit::NOUNIT);
+    single.add(3);
+    ASSERT_STREQ("count=1 sum=3 p50=3 p75=3 p90=3 p95=3 p99=3 p999=3", single.to_string().c_str());
+}
+
 TEST_F(MetricsTest, MetricLabel) {
     std::string put("put");
     MetricLabel label("type", put);
@@ -0,0 +1,45 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/rate_limiter.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "util/monotime.h"
+
+namespace starrocks {
+
+class RateLimiterTest : public testing::Test {};
+
+TEST_F(RateLimiterTest, unlimited) {
+    RateLimiter limiter;
+    MonoTime start = MonoTime::Now();
+    for (int i = 0; i < 100; i++) {
+        limiter.acquire(1 << 30, 0);
+    }
+    ASSERT_LT((MonoTime::Now() - start).ToMilliseconds(), 1000);
+}
+
+TEST_F(RateLimiterTest, shared_by_threads) {
+    RateLimiter limiter;
+    // 4 threads acquire 500KB in total at 1MB/s, which takes about 500ms except the burst.
+    MonoTime start = MonoTime::Now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&limiter] {
+            for (int j = 0; j < 25; j++) {
+                limiter.acquire(5 * 1000, 1000 * 1000);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    int64_t elapsed_ms = (MonoTime::Now() - start).ToMilliseconds();
+    ASSERT_GE(elapsed_ms, 500 - RateLimiter::kMaxBurstMs);
+    ASSERT_LT(elapsed_ms, 5000);
+}
+
+} // namespace starrocks
@@ -0,0 +1,65 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/runtime_profile.h"
+
+#include <gtest/gtest.h>
+
+#include "common/object_pool.h"
+
+namespace starrocks {
+
+TEST(RuntimeProfileTest, ToThriftChanged) {
+    ObjectPool pool;
+    RuntimeProfile profile("root");
+    auto* child1 = pool.add(new RuntimeProfile("child1"));
+    auto* child2 = pool.add(new RuntimeProfile("child2"));
+    profile.add_child(child1, true, nullptr);
+    profile.add_child(child2, true, nullptr);
+    auto* counter1 = ADD_COUNTER(child1, "Counter1", TUnit::UNIT);
+    auto* counter2 = ADD_COUNTER(child2, "Counter2", TUnit::UNIT);
+    counter1->set(1L);
+    counter2->set(2L);
+    child2->add_info_string("Info", "a");
+
+    // the first one serializes everything
+    TRuntimeProfileTree tree;
+    profile.to_thrift_changed(&tree);
+    ASSERT_EQ(3, tree.nodes.size());
+    RuntimeProfile reported("root");
+    reported.update(tree);
+
+    // nothing changed but the root
+    profile.to_thrift_changed(&tree);
+    ASSERT_EQ(1, tree.nodes.size());
+    ASSERT_EQ(0, tree.nodes[0].num_children);
+
+    // only the changed child and counter
+    counter2->set(3L);
+    profile.to_thrift_changed(&tree);
+    ASSERT_EQ(2, tree.nodes.size());
+    ASSERT_EQ("child2", tree.nodes[1].name);
+    ASSERT_EQ(1, tree.nodes[1].counters.size());
+    ASSERT_TRUE(tree.nodes[1].info_strings.empty());
+    reported.update(tree);
+
+    child1->add_info_string("Info", "b");
+    profile.to_thrift_changed(&tree);
+    ASSERT_EQ(2, tree.nodes.size());
+    ASSERT_EQ("child1", tree.nodes[1].name);
+    ASSERT_TRUE(tree.nodes[1].counters.empty());
+    reported.update(tree);
+
+    // the reported profile is brought up to date by the changes
+    TRuntimeProfileTree expected;
+    TRuntimeProfileTree actual;
+    profile.to_thrift(&expected);
+    reported.to_thrift(&actual);
+    ASSERT_EQ(expected.nodes.size(), actual.nodes.size());
+    for (size_t i = 0; i < expected.nodes.size(); ++i) {
+        ASSERT_EQ(expected.nodes[i].name, actual.nodes[i].name);
+        ASSERT_EQ(expected.nodes[i].counters, actual.nodes[i].counters);
+        ASSERT_EQ(expected.nodes[i].info_strings, actual.nodes[i].info_strings);
+    }
+}
+
+} // namespace starrocks
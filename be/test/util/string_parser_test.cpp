@@ -205,6 +205,22 @@ TEST(StringToInt, Basic) {
     test_int_value<int64_t>("-0", 0, StringParser::PARSE_SUCCESS);
 }
 
+TEST(StringToInt, EightDigits) {
+    test_int_value<int32_t>("123456789", 123456789, StringParser::PARSE_SUCCESS);
+    test_int_value<int32_t>("-987654321", -987654321, StringParser::PARSE_SUCCESS);
+    test_int_value<int32_t>("100000009", 100000009, StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("123456789012345678", 123456789012345678, StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("90000000000000000", 90000000000000000, StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("1099999999", 1099999999, StringParser::PARSE_SUCCESS);
+
+    // the digits followed by the others in the 8 bytes
+    test_int_value<int32_t>("1234567 ", 1234567, StringParser::PARSE_SUCCESS);
+    test_int_value<int32_t>("12345678:", 0, StringParser::PARSE_FAILURE);
+    test_int_value<int64_t>("1234567/89", 0, StringParser::PARSE_FAILURE);
+    test_int_value<int64_t>("123456789a12", 0, StringParser::PARSE_FAILURE);
+    test_int_value<int64_t>("12345678 12", 0, StringParser::PARSE_FAILURE);
+}
+
 TEST(StringToInt, InvalidLeadingTrailing) {
     // Test that trailing garbage is not allowed.
     test_int_value<int8_t>("123xyz   ", 0, StringParser::PARSE_FAILURE);
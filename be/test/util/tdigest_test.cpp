@@ -23,7 +23,9 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
 #include <random>
+#include <vector>
 
 namespace starrocks {
 
@@ -172,6 +174,32 @@ TEST_F(TDigestTest, MoreThan2BValues) {
     }
 }
 
+TEST_F(TDigestTest, AddBatch) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::normal_distribution<Value> dist(0, 1000);
+    std::vector<Value> values;
+    for (int i = 0; i < 100000; ++i) {
+        values.push_back(dist(gen));
+    }
+    values.push_back(std::numeric_limits<Value>::quiet_NaN());
+
+    TDigest digest(100);
+    for (Value value : values) {
+        digest.add(value);
+    }
+    TDigest batch_digest(100);
+    batch_digest.add(values.data(), 10);
+    batch_digest.add(values.data() + 10, values.size() - 10);
+
+    digest.compress();
+    batch_digest.compress();
+    EXPECT_EQ(digest.totalWeight(), batch_digest.totalWeight());
+    for (double q : {0.0, 0.01, 0.5, 0.99, 1.0}) {
+        EXPECT_EQ(digest.quantile(q), batch_digest.quantile(q));
+    }
+}
+
 TEST_F(TDigestTest, MergeTest) {
     TDigest digest1(1000);
     TDigest digest2(1000);
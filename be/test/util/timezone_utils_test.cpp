@@ -0,0 +1,42 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/timezone_utils.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks {
+
+static const cctz::civil_second kEpoch(1970, 1, 1, 0, 0, 0);
+
+// NOLINTNEXTLINE
+TEST(TimezoneUtilsTest, test_offset_cache) {
+    for (const std::string& name : {"America/Los_Angeles", "Asia/Shanghai", "Europe/London", "+08:00"}) {
+        cctz::time_zone ctz;
+        ASSERT_TRUE(TimezoneUtils::find_cctz_time_zone(name, ctz));
+        TimezoneOffsetCache cache(ctz);
+
+        // every 15 minutes around the transitions of 2021, and the seconds around the transitions.
+        int64_t begin = cctz::civil_second(2021, 3, 1, 0, 0, 0) - kEpoch;
+        int64_t end = cctz::civil_second(2021, 11, 30, 0, 0, 0) - kEpoch;
+        for (int64_t s = begin; s < end; s += 900 + (s % 7)) {
+            const cctz::time_point<cctz::seconds> tp(cctz::seconds{s});
+            ASSERT_EQ(cctz::convert(tp, ctz) - kEpoch, cache.utc_to_local(s)) << name << " " << s;
+            ASSERT_EQ(cctz::convert(kEpoch + s, ctz).time_since_epoch().count(), cache.local_to_utc(s))
+                    << name << " " << s;
+        }
+
+        // the local times which are skipped and repeated in America/Los_Angeles.
+        for (int64_t s : {cctz::civil_second(2021, 3, 14, 2, 30, 0) - kEpoch,
+                          cctz::civil_second(2021, 11, 7, 1, 30, 0) - kEpoch}) {
+            ASSERT_EQ(cctz::convert(kEpoch + s, ctz).time_since_epoch().count(), cache.local_to_utc(s)) << name;
+        }
+
+        // far away from the cached period.
+        int64_t s = cctz::civil_second(1980, 6, 1, 12, 0, 0) - kEpoch;
+        ASSERT_EQ(cctz::convert(cctz::time_point<cctz::seconds>(cctz::seconds{s}), ctz) - kEpoch,
+                  cache.utc_to_local(s));
+        ASSERT_EQ(cctz::convert(kEpoch + s, ctz).time_since_epoch().count(), cache.local_to_utc(s));
+    }
+}
+
+} // namespace starrocks
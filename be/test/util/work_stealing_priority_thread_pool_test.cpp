@@ -0,0 +1,101 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/work_stealing_priority_thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace starrocks {
+
+TEST(WorkStealingPriorityThreadPoolTest, RunAllTasks) {
+    WorkStealingPriorityThreadPool pool(4, 1024);
+    std::atomic<int> num_done{0};
+    std::vector<std::thread> offers;
+    for (int i = 0; i < 4; ++i) {
+        offers.emplace_back([&pool, &num_done]() {
+            for (int j = 0; j < 1000; ++j) {
+                ASSERT_TRUE(pool.offer([&num_done]() { num_done++; }));
+            }
+        });
+    }
+    for (auto& thread : offers) {
+        thread.join();
+    }
+    pool.drain_and_shutdown();
+    ASSERT_EQ(4000, num_done.load());
+    ASSERT_FALSE(pool.offer([]() {}));
+}
+
+TEST(WorkStealingPriorityThreadPoolTest, TasksOfferedByWorkers) {
+    // the tasks offered by a worker go to its own queue, and are stolen by the other workers
+    WorkStealingPriorityThreadPool pool(4, 1024);
+    std::atomic<int> num_done{0};
+    std::promise<void> offered;
+    ASSERT_TRUE(pool.offer([&]() {
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_TRUE(pool.offer([&num_done]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                num_done++;
+            }));
+        }
+        offered.set_value();
+    }));
+    offered.get_future().wait();
+    pool.drain_and_shutdown();
+    ASSERT_EQ(100, num_done.load());
+}
+
+TEST(WorkStealingPriorityThreadPoolTest, Priority) {
+    WorkStealingPriorityThreadPool pool(1, 1024);
+    // block the only worker until all the tasks are queued
+    std::promise<void> queued;
+    std::shared_future<void> queued_future = queued.get_future().share();
+    ASSERT_TRUE(pool.offer([queued_future]() { queued_future.wait(); }));
+    while (pool.get_queue_size() > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::vector<int> order;
+    for (int priority : {1, 3, 2}) {
+        PriorityThreadPool::Task task;
+        task.priority = priority;
+        task.work_function = [&order, priority]() { order.push_back(priority); };
+        ASSERT_TRUE(pool.try_offer(task));
+    }
+    queued.set_value();
+    pool.drain_and_shutdown();
+    ASSERT_EQ((std::vector<int>{3, 2, 1}), order);
+}
+
+TEST(WorkStealingPriorityThreadPoolTest, QueueFull) {
+    WorkStealingPriorityThreadPool pool(1, 2);
+    std::promise<void> release;
+    std::shared_future<void> release_future = release.get_future().share();
+    ASSERT_TRUE(pool.offer([release_future]() { release_future.wait(); }));
+    while (pool.get_queue_size() > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // the running task holds no room
+    ASSERT_TRUE(pool.try_offer(PriorityThreadPool::Task{0, []() {}}));
+    ASSERT_TRUE(pool.try_offer(PriorityThreadPool::Task{0, []() {}}));
+    ASSERT_FALSE(pool.try_offer(PriorityThreadPool::Task{0, []() {}}));
+
+    std::atomic<bool> offered{false};
+    std::thread blocked([&]() {
+        ASSERT_TRUE(pool.offer([]() {}));
+        offered = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(offered.load());
+    release.set_value();
+    blocked.join();
+    ASSERT_TRUE(offered.load());
+    pool.drain_and_shutdown();
+}
+
+} // namespace starrocks
@@ -34,6 +34,7 @@ import com.starrocks.common.FeConstants;
 import com.starrocks.common.UserException;
 import com.starrocks.mysql.privilege.PrivPredicate;
 import com.starrocks.qe.ConnectContext;
+import com.starrocks.thrift.TFunctionBinaryType;
 import org.apache.commons.codec.binary.Hex;
 
 import java.io.IOException;
@@ -58,6 +59,9 @@ public class CreateFunctionStmt extends DdlStmt {
     public static final String FINALIZE_KEY = "finalize_fn";
     public static final String GET_VALUE_KEY = "get_value_fn";
     public static final String REMOVE_KEY = "remove_fn";
+    public static final String TYPE_KEY = "type";
+    // the scalar UDF called once per chunk by the vectorized engine, see be/src/udf/udf_columnar.h
+    public static final String TYPE_COLUMNAR = "columnar";
 
     private final FunctionName functionName;
     private final boolean isAggregate;
@@ -165,6 +169,9 @@ public class CreateFunctionStmt extends DdlStmt {
     }
 
     private void analyzeUda() throws AnalysisException {
+        if (properties.containsKey(TYPE_KEY)) {
+            throw new AnalysisException("Aggregate function doesn't support 'type' in properties");
+        }
         AggregateFunction.AggregateFunctionBuilder builder =
                 AggregateFunction.AggregateFunctionBuilder.createUdfBuilder();
 
@@ -202,6 +209,17 @@ public class CreateFunctionStmt extends DdlStmt {
                 returnType.getType(), argsDef.isVariadic(),
                 objectFile, symbol, prepareFnSymbol, closeFnSymbol);
         function.setChecksum(checksum);
+        String type = properties.get(TYPE_KEY);
+        if (type != null) {
+            if (!type.equalsIgnoreCase(TYPE_COLUMNAR)) {
+                throw new AnalysisException("Unknown function type '" + type + "', only 'columnar' is supported");
+            }
+            if (argsDef.isVariadic()) {
+                throw new AnalysisException("Columnar function doesn't support variadic arguments");
+            }
+            function.setBinaryType(TFunctionBinaryType.COLUMNAR);
+            function.setIsVectorized(true);
+        }
     }
 
     @Override
@@ -319,6 +319,8 @@ public class ScalarFunction extends Function {
         if (input.readBoolean()) {
             closeFnSymbol = Text.readString(input);
         }
+        // only the columnar UDFs are vectorized, the builtins are never persisted.
+        setIsVectorized(getBinaryType() == TFunctionBinaryType.COLUMNAR);
     }
 
     @Override
@@ -327,6 +329,9 @@ public class ScalarFunction extends Function {
         properties.put(CreateFunctionStmt.OBJECT_FILE_KEY, getLocation() == null ? "" : getLocation().toString());
         properties.put(CreateFunctionStmt.MD5_CHECKSUM, checksum);
         properties.put(CreateFunctionStmt.SYMBOL_KEY, symbolName);
+        if (getBinaryType() == TFunctionBinaryType.COLUMNAR) {
+            properties.put(CreateFunctionStmt.TYPE_KEY, CreateFunctionStmt.TYPE_COLUMNAR);
+        }
         return new Gson().toJson(properties);
     }
 }
@@ -108,7 +108,9 @@ public class TabletInvertedIndex {
         this.lock.writeLock().unlock();
     }
 
-    public void tabletReport(long backendId, Map<Long, TTablet> backendTablets,
+    // reportedTablets is null if backendTablets are all the tablets of the backend, otherwise only the replicas of
+    // reportedTablets are checked.
+    public void tabletReport(long backendId, Map<Long, TTablet> backendTablets, Set<Long> reportedTablets,
                              final HashMap<Long, TStorageMedium> storageMediumMap,
                              ListMultimap<Long, Long> tabletSyncMap,
                              ListMultimap<Long, Long> tabletDeleteFromMeta,
@@ -137,6 +139,9 @@ public class TabletInvertedIndex {
                 // traverse replicas in meta with this backend
                 for (Map.Entry<Long, Replica> entry : replicaMetaWithBackend.entrySet()) {
                     long tabletId = entry.getKey();
+                    if (reportedTablets != null && !reportedTablets.contains(tabletId)) {
+                        continue;
+                    }
                     Preconditions.checkState(tabletMetaMap.containsKey(tabletId));
                     TabletMeta tabletMeta = tabletMetaMap.get(tabletId);
 
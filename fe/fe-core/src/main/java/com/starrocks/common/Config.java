@@ -490,6 +490,14 @@ public class Config extends ConfigBase {
     @ConfField(mutable = true, masterOnly = true)
     public static int load_straggler_wait_second = 300;
 
+    /**
+     * If true, only the primary replica of a tablet sorts and encodes the loaded rows,
+     * and the secondary replicas download the finished segment files from it.
+     * This saves the CPU of the secondary replicas, but a load fails if any primary replica fails.
+     */
+    @ConfField(mutable = true)
+    public static boolean enable_replicated_storage_for_load = false;
+
     /**
      * only limit for Row-based storage.
      * set to Integer.MAX_VALUE, cause starrocks is already Column-based storage
@@ -1291,5 +1299,14 @@ public class Config extends ConfigBase {
 
     @ConfField
     public static boolean enable_udf = false;
+
+    /**
+     * The partial global runtime filters of a shuffle join with more build instances than this are merged by
+     * a tree of merge nodes: the build instances are split into groups of about so many instances, each group
+     * is merged by an intermediate merge node, and the root merge node merges the groups.
+     * 0 means all the partial runtime filters are merged by the root merge node.
+     */
+    @ConfField(mutable = true)
+    public static int runtime_filter_merge_fanout = 16;
 }
 
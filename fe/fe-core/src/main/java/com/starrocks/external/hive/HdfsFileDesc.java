@@ -9,13 +9,21 @@ public class HdfsFileDesc {
     private String compression;
     private long length;
     private ImmutableList<HdfsFileBlockDesc> blockDescs;
+    // 0 if unknown
+    private long modificationTime;
 
     public HdfsFileDesc(String fileName, String compression, long length,
                         ImmutableList<HdfsFileBlockDesc> blockDescs) {
+        this(fileName, compression, length, blockDescs, 0);
+    }
+
+    public HdfsFileDesc(String fileName, String compression, long length,
+                        ImmutableList<HdfsFileBlockDesc> blockDescs, long modificationTime) {
         this.fileName = fileName;
         this.compression = compression;
         this.length = length;
         this.blockDescs = blockDescs;
+        this.modificationTime = modificationTime;
     }
 
     public String getFileName() {
@@ -33,4 +41,8 @@ public class HdfsFileDesc {
     public ImmutableList<HdfsFileBlockDesc> getBlockDescs() {
         return blockDescs;
     }
+
+    public long getModificationTime() {
+        return modificationTime;
+    }
 }
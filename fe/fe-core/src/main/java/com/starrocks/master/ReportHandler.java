@@ -99,6 +99,10 @@ public class ReportHandler extends Daemon {
 
     private BlockingQueue<ReportTask> reportQueue = Queues.newLinkedBlockingQueue();
 
+    // the backends whose last full tablet report is accepted, the incremental tablet reports of the others
+    // are rejected so they report all their tablets again
+    private final Set<Long> backendsWithFullTabletReport = Sets.newConcurrentHashSet();
+
     public ReportHandler() {
         GaugeMetric<Long> gaugeQueueSize = new GaugeMetric<Long>(
                 "report_queue_size", MetricUnit.NOUNIT, "report queue size") {
@@ -132,6 +136,8 @@ public class ReportHandler extends Daemon {
         Map<TTaskType, Set<Long>> tasks = null;
         Map<String, TDisk> disks = null;
         Map<Long, TTablet> tablets = null;
+        // not null iff the tablet report is incremental
+        Set<Long> removedTablets = null;
         long reportVersion = -1;
 
         String reportType = "";
@@ -149,6 +155,18 @@ public class ReportHandler extends Daemon {
             tablets = request.getTablets();
             reportVersion = request.getReport_version();
             reportType += "tablet";
+            if (request.isSetIs_incremental_tablet_report() && request.isIs_incremental_tablet_report()) {
+                if (!backendsWithFullTabletReport.contains(beId)) {
+                    tStatus.setStatus_code(TStatusCode.INTERNAL_ERROR);
+                    List<String> errorMsgs = Lists.newArrayList();
+                    errorMsgs.add("backend[" + beId + "] should report all the tablets first.");
+                    tStatus.setError_msgs(errorMsgs);
+                    return result;
+                }
+                removedTablets = request.isSetRemoved_tablets() ? Sets.newHashSet(request.getRemoved_tablets())
+                        : Sets.newHashSet();
+                reportType += "(incremental)";
+            }
         } else if (request.isSetTablet_list()) {
             // the 'tablets' member will be deprecated in future.
             tablets = buildTabletMap(request.getTablet_list());
@@ -160,10 +178,18 @@ public class ReportHandler extends Daemon {
             backend.setTabletMaxCompactionScore(request.getTablet_max_compaction_score());
         }
 
-        ReportTask reportTask = new ReportTask(beId, tasks, disks, tablets, reportVersion);
+        ReportTask reportTask = new ReportTask(beId, tasks, disks, tablets, removedTablets, reportVersion);
+        boolean isFullTabletReport = tablets != null && removedTablets == null;
+        if (isFullTabletReport) {
+            // before the task is queued, so it can't be reverted by the task when it's out of date
+            backendsWithFullTabletReport.add(beId);
+        }
         try {
             putToQueue(reportTask);
         } catch (Exception e) {
+            if (isFullTabletReport) {
+                backendsWithFullTabletReport.remove(beId);
+            }
             tStatus.setStatus_code(TStatusCode.INTERNAL_ERROR);
             List<String> errorMsgs = Lists.newArrayList();
             errorMsgs.add("failed to put report task to queue. queue size: " + reportQueue.size());
@@ -206,15 +232,17 @@ public class ReportHandler extends Daemon {
         private Map<TTaskType, Set<Long>> tasks;
         private Map<String, TDisk> disks;
         private Map<Long, TTablet> tablets;
+        private Set<Long> removedTablets;
         private long reportVersion;
 
         public ReportTask(long beId, Map<TTaskType, Set<Long>> tasks,
                           Map<String, TDisk> disks,
-                          Map<Long, TTablet> tablets, long reportVersion) {
+                          Map<Long, TTablet> tablets, Set<Long> removedTablets, long reportVersion) {
             this.beId = beId;
             this.tasks = tasks;
             this.disks = disks;
             this.tablets = tablets;
+            this.removedTablets = removedTablets;
             this.reportVersion = reportVersion;
         }
 
@@ -231,17 +259,27 @@ public class ReportHandler extends Daemon {
                 if (reportVersion < backendReportVersion) {
                     LOG.warn("out of date report version {} from backend[{}]. current report version[{}]",
                             reportVersion, beId, backendReportVersion);
+                    // the changes in the dropped report won't be reported again incrementally
+                    backendsWithFullTabletReport.remove(beId);
                 } else {
-                    ReportHandler.tabletReport(beId, tablets, reportVersion);
+                    ReportHandler.tabletReport(beId, tablets, removedTablets, reportVersion);
                 }
             }
         }
     }
 
-    private static void tabletReport(long backendId, Map<Long, TTablet> backendTablets, long backendReportVersion) {
+    // If removedTablets is not null, backendTablets are only the tablets changed since the last report, and the
+    // diff is done for them and the removed tablets only.
+    private static void tabletReport(long backendId, Map<Long, TTablet> backendTablets, Set<Long> removedTablets,
+                                     long backendReportVersion) {
         long start = System.currentTimeMillis();
-        LOG.info("backend[{}] reports {} tablet(s). report version: {}",
-                backendId, backendTablets.size(), backendReportVersion);
+        LOG.info("backend[{}] reports {} tablet(s). report version: {}, incremental: {}",
+                backendId, backendTablets.size(), backendReportVersion, removedTablets != null);
+        Set<Long> reportedTablets = null;
+        if (removedTablets != null) {
+            reportedTablets = Sets.newHashSet(backendTablets.keySet());
+            reportedTablets.addAll(removedTablets);
+        }
 
         // storage medium map
         HashMap<Long, TStorageMedium> storageMediumMap = Catalog.getCurrentCatalog().getPartitionIdToStorageMediumMap();
@@ -267,7 +305,7 @@ public class ReportHandler extends Daemon {
         Set<Pair<Long, Integer>> tabletWithoutPartitionId = Sets.newHashSet();
 
         // 1. do the diff. find out (intersection) / (be - meta) / (meta - be)
-        Catalog.getCurrentInvertedIndex().tabletReport(backendId, backendTablets, storageMediumMap,
+        Catalog.getCurrentInvertedIndex().tabletReport(backendId, backendTablets, reportedTablets, storageMediumMap,
                 tabletSyncMap,
                 tabletDeleteFromMeta,
                 foundTabletsWithValidSchema,
@@ -34,6 +34,10 @@ public class DataStreamSink extends DataSink {
 
     private DataPartition outputPartition;
 
+    // See TDataStreamSink.adaptive_broadcast_bytes and TDataStreamSink.adaptive_partition.
+    private long adaptiveBroadcastBytes = 0;
+    private boolean adaptivePartition = false;
+
     public DataStreamSink(PlanNodeId exchNodeId) {
         this.exchNodeId = exchNodeId;
     }
@@ -52,6 +56,14 @@ public class DataStreamSink extends DataSink {
         outputPartition = partition;
     }
 
+    public void setAdaptiveBroadcastBytes(long adaptiveBroadcastBytes) {
+        this.adaptiveBroadcastBytes = adaptiveBroadcastBytes;
+    }
+
+    public void setAdaptivePartition(boolean adaptivePartition) {
+        this.adaptivePartition = adaptivePartition;
+    }
+
     @Override
     public String getExplainString(String prefix, TExplainLevel explainLevel) {
         StringBuilder strBuilder = new StringBuilder();
@@ -79,6 +91,12 @@ public class DataStreamSink extends DataSink {
         TDataSink result = new TDataSink(TDataSinkType.DATA_STREAM_SINK);
         TDataStreamSink tStreamSink =
                 new TDataStreamSink(exchNodeId.asInt(), outputPartition.toThrift());
+        if (adaptiveBroadcastBytes > 0) {
+            tStreamSink.setAdaptive_broadcast_bytes(adaptiveBroadcastBytes);
+        }
+        if (adaptivePartition) {
+            tStreamSink.setAdaptive_partition(true);
+        }
         result.setStream_sink(tStreamSink);
         return result;
     }
@@ -68,6 +68,8 @@ public class HashJoinNode extends PlanNode {
     private DistributionMode distrMode;
     private String colocateReason = ""; // if can not do colocate join, set reason here
     private boolean isBucketShuffle = false; // the flag for bucket shuffle join
+    // the flag for the shuffle join whose build side could be broadcast at runtime
+    private boolean isAdaptiveBroadcast = false;
 
     private List<RuntimeFilterDescription> buildRuntimeFilters = Lists.newArrayList();
 
@@ -216,6 +218,14 @@ public class HashJoinNode extends PlanNode {
         this.distrMode = distrMode;
     }
 
+    public DistributionMode getDistributionMode() {
+        return distrMode;
+    }
+
+    public void setAdaptiveBroadcast(boolean adaptiveBroadcast) {
+        isAdaptiveBroadcast = adaptiveBroadcast;
+    }
+
     public boolean isBucketShuffle() {
         return isBucketShuffle;
     }
@@ -402,6 +412,9 @@ public class HashJoinNode extends PlanNode {
         }
         msg.hash_join_node.setBuild_runtime_filters_from_planner(
                 ConnectContext.get().getSessionVariable().getEnableGlobalRuntimeFilter());
+        if (isAdaptiveBroadcast) {
+            msg.hash_join_node.setAdaptive_broadcast(true);
+        }
     }
 
     @Override
@@ -375,6 +375,9 @@ public class HdfsScanNode extends ScanNode {
         hdfsScanRange.setPartition_id(partitionId);
         hdfsScanRange.setFile_length(fileDesc.getLength());
         hdfsScanRange.setFile_format(fileFormat.toThrift());
+        if (fileDesc.getModificationTime() > 0) {
+            hdfsScanRange.setModification_time(fileDesc.getModificationTime());
+        }
         TScanRange scanRange = new TScanRange();
         scanRange.setHdfs_scan_range(hdfsScanRange);
         scanRangeLocations.setScan_range(scanRange);
@@ -112,6 +112,8 @@ public class OlapScanNode extends ScanNode {
     private String reasonOfPreAggregation = null;
     private boolean canTurnOnPreAggr = true;
     private boolean forceOpenPreAgg = false;
+    // Set if the scan feeds an aggregation of only count/min/max without group by.
+    private boolean aggregateByMetadata = false;
     private OlapTable olapTable = null;
     private long selectedTabletsNum = 0;
     private long totalTabletsNum = 0;
@@ -166,6 +168,10 @@ public class OlapScanNode extends ScanNode {
         this.forceOpenPreAgg = forceOpenPreAgg;
     }
 
+    public void setAggregateByMetadata(boolean aggregateByMetadata) {
+        this.aggregateByMetadata = aggregateByMetadata;
+    }
+
     public Collection<Long> getSelectedPartitionIds() {
         return selectedPartitionIds;
     }
@@ -681,6 +687,9 @@ public class OlapScanNode extends ScanNode {
         if (null != sortColumn) {
             msg.olap_scan_node.setSort_column(sortColumn);
         }
+        if (aggregateByMetadata) {
+            msg.olap_scan_node.setAggregate_by_metadata(true);
+        }
     }
 
     // export some tablets
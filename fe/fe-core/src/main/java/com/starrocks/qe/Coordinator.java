@@ -584,6 +584,36 @@ public class Coordinator {
         }
     }
 
+    // The merge nodes after the root merge node are the intermediate merge nodes, each of which merges the partial
+    // runtime filters of a group of contiguous build instances. They are picked from the hosts of the build
+    // instances, and the backend splits the instances into as many groups as the intermediate merge nodes.
+    private void setRuntimeFilterIntermediateMergeNodes(PlanFragment fragment, FragmentExecParams params,
+                                                        TNetworkAddress mergeHost) throws Exception {
+        int fanout = Config.runtime_filter_merge_fanout;
+        int numInstances = params.instanceExecParams.size();
+        if (fanout <= 0 || numInstances <= fanout) {
+            return;
+        }
+        int numGroups = (numInstances + fanout - 1) / fanout;
+        Set<TNetworkAddress> hosts = Sets.newLinkedHashSet();
+        for (final FInstanceExecParam instance : params.instanceExecParams) {
+            TNetworkAddress host = toBrpcHost(instance.host);
+            if (!host.equals(mergeHost)) {
+                hosts.add(host);
+            }
+            if (hosts.size() >= numGroups) {
+                break;
+            }
+        }
+        // a single intermediate merge node only adds a hop.
+        if (hosts.size() < 2) {
+            return;
+        }
+        for (TNetworkAddress host : hosts) {
+            fragment.setRuntimeFilterMergeNodeAddresses(fragment.getPlanRoot(), host);
+        }
+    }
+
     private void setGlobalRuntimeFilterParams(FragmentExecParams topParams, TNetworkAddress mergeHost)
             throws Exception {
         for (PlanFragment fragment : fragments) {
@@ -617,6 +647,7 @@ public class Coordinator {
                 }
             }
             fragment.setRuntimeFilterMergeNodeAddresses(fragment.getPlanRoot(), mergeHost);
+            setRuntimeFilterIntermediateMergeNodes(fragment, params, mergeHost);
         }
         topParams.runtimeFilterParams.setRuntime_filter_max_size(HashJoinNode.getRuntimeFilterMaxSize());
     }
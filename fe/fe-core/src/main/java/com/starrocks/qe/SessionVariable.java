@@ -122,6 +122,10 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
 
     public static final String PIPELINE_SCAN_MODE = "pipeline_scan_mode";
 
+    public static final String PIPELINE_RESOURCE_GROUP = "pipeline_resource_group";
+    public static final String ENABLE_PIPELINE_TRACE = "enable_pipeline_trace";
+    public static final String ENABLE_HARDWARE_COUNTERS = "enable_hardware_counters";
+
     // vectorized insert flag
     public static final String ENABLE_VECTORIZED_INSERT = "enable_vectorized_insert";
 
@@ -173,6 +177,10 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     public static final String RUNTIME_JOIN_FILTER_PUSH_DOWN_LIMIT = "runtime_join_filter_push_down_limit";
     public static final String ENABLE_GLOBAL_RUNTIME_FILTER = "enable_global_runtime_filter";
 
+    // The build side of a shuffle join is broadcast at runtime if the build rows of each sender are not larger
+    // than this many bytes, and then the probe rows needn't be shuffled. 0 disables it.
+    public static final String ADAPTIVE_BROADCAST_JOIN_BYTES = "adaptive_broadcast_join_bytes";
+
     // use vectorized engine
     @VariableMgr.VarAttr(name = ENABLE_VECTORIZED_ENGINE, alias = "vectorized_engine_enable")
     private boolean vectorizedEngineEnable = true;
@@ -320,6 +328,19 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     @VariableMgr.VarAttr(name = PIPELINE_SCAN_MODE)
     private int pipelineScanMode = 1;
 
+    // The resource group defined by the BE config pipeline_resource_groups, empty means the default group.
+    @VariableMgr.VarAttr(name = PIPELINE_RESOURCE_GROUP)
+    private String pipelineResourceGroup = "";
+
+    // Record the state transitions of the pipeline drivers, they are available at /api/pipeline_trace of the BEs.
+    @VariableMgr.VarAttr(name = ENABLE_PIPELINE_TRACE)
+    private boolean enablePipelineTrace = false;
+
+    // Count the cpu cycles, instructions, cache misses and branch misses of the pipeline operators by the perf
+    // events of the BEs, they are shown in the profiles of the operators.
+    @VariableMgr.VarAttr(name = ENABLE_HARDWARE_COUNTERS)
+    private boolean enableHardwareCounters = false;
+
     @VariableMgr.VarAttr(name = ENABLE_INSERT_STRICT)
     private boolean enableInsertStrict = true;
 
@@ -418,6 +439,9 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     @VariableMgr.VarAttr(name = ENABLE_GLOBAL_RUNTIME_FILTER)
     private boolean enableGlobalRuntimeFilter = true;
 
+    @VariableMgr.VarAttr(name = ADAPTIVE_BROADCAST_JOIN_BYTES)
+    private long adaptiveBroadcastJoinBytes = 0;
+
     //In order to be compatible with the logic of the old planner,
     //When the column name is the same as the alias name,
     //the alias will be used as the groupby column if set to true.
@@ -731,6 +755,10 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
         return enableGlobalRuntimeFilter;
     }
 
+    public long getAdaptiveBroadcastJoinBytes() {
+        return adaptiveBroadcastJoinBytes;
+    }
+
     public void setEnableGlobalRuntimeFilter(boolean value) {
         enableGlobalRuntimeFilter = value;
     }
@@ -779,6 +807,15 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
         tResult.setRuntime_filter_send_timeout_ms(global_runtime_filter_rpc_timeout);
         tResult.setQuery_threads(pipelineQueryThreads);
         tResult.setPipeline_scan_mode(pipelineScanMode);
+        if (!pipelineResourceGroup.isEmpty()) {
+            tResult.setPipeline_resource_group(pipelineResourceGroup);
+        }
+        if (enablePipelineTrace) {
+            tResult.setEnable_pipeline_trace(true);
+        }
+        if (enableHardwareCounters) {
+            tResult.setEnable_hardware_counters(true);
+        }
         return tResult;
     }
 
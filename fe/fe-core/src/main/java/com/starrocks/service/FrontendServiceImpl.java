@@ -72,6 +72,8 @@ import com.starrocks.system.SystemInfoService;
 import com.starrocks.task.StreamLoadTask;
 import com.starrocks.thrift.FrontendService;
 import com.starrocks.thrift.FrontendServiceVersion;
+import com.starrocks.thrift.TBatchReportExecStatusParams;
+import com.starrocks.thrift.TBatchReportExecStatusResult;
 import com.starrocks.thrift.TColumnDef;
 import com.starrocks.thrift.TColumnDesc;
 import com.starrocks.thrift.TDBPrivDesc;
@@ -529,6 +531,18 @@ public class FrontendServiceImpl implements FrontendService.Iface {
         return QeProcessorImpl.INSTANCE.reportExecStatus(params, getClientAddr());
     }
 
+    @Override
+    public TBatchReportExecStatusResult batchReportExecStatus(TBatchReportExecStatusParams params) throws TException {
+        TNetworkAddress clientAddr = getClientAddr();
+        List<TStatus> statusList = new ArrayList<>();
+        for (TReportExecStatusParams reportParams : params.getParams_list()) {
+            statusList.add(QeProcessorImpl.INSTANCE.reportExecStatus(reportParams, clientAddr).getStatus());
+        }
+        TBatchReportExecStatusResult result = new TBatchReportExecStatusResult();
+        result.setStatus_list(statusList);
+        return result;
+    }
+
     @Override
     public TMasterResult finishTask(TFinishTaskRequest request) throws TException {
         return masterImpl.finishTask(request);
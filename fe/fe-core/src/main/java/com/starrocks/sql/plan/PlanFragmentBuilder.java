@@ -36,6 +36,7 @@ import com.starrocks.planner.AnalyticEvalNode;
 import com.starrocks.planner.AssertNumRowsNode;
 import com.starrocks.planner.CrossJoinNode;
 import com.starrocks.planner.DataPartition;
+import com.starrocks.planner.DataStreamSink;
 import com.starrocks.planner.EmptySetNode;
 import com.starrocks.planner.EsScanNode;
 import com.starrocks.planner.ExceptNode;
@@ -46,6 +47,7 @@ import com.starrocks.planner.IntersectNode;
 import com.starrocks.planner.MysqlScanNode;
 import com.starrocks.planner.OlapScanNode;
 import com.starrocks.planner.PlanFragment;
+import com.starrocks.planner.PlanNode;
 import com.starrocks.planner.PlannerContext;
 import com.starrocks.planner.ProjectNode;
 import com.starrocks.planner.RepeatNode;
@@ -130,6 +132,7 @@ public class PlanFragmentBuilder {
             for (PlanFragment fragment : fragments) {
                 fragment.finalize(null, false);
             }
+            setAdaptiveBroadcastJoins(fragments, connectContext.getSessionVariable().getAdaptiveBroadcastJoinBytes());
             Collections.reverse(fragments);
             insertAdapterNodeToFragment(fragments, execPlan.getPlanCtx());
         } catch (UserException e) {
@@ -156,6 +159,56 @@ public class PlanFragmentBuilder {
         return execPlan;
     }
 
+    // Mark the shuffle joins whose build side could be broadcast at runtime, see THashJoinNode.adaptive_broadcast.
+    // The output of such a join is not hash partitioned any more once its probe rows are not, so only the
+    // joins whose ancestors in the fragment don't depend on the partitioning are marked. The joins that
+    // output the unmatched build rows are not marked, because every instance has all the build rows.
+    private static void setAdaptiveBroadcastJoins(List<PlanFragment> fragments, long adaptiveBroadcastBytes) {
+        if (adaptiveBroadcastBytes <= 0) {
+            return;
+        }
+        for (PlanFragment fragment : fragments) {
+            PlanNode node = fragment.getPlanRoot();
+            while (node instanceof ProjectNode || node instanceof SelectNode || (node instanceof HashJoinNode &&
+                    ((HashJoinNode) node).getDistributionMode() == HashJoinNode.DistributionMode.BROADCAST)) {
+                node = node.getChild(0);
+            }
+            if (!(node instanceof HashJoinNode)) {
+                continue;
+            }
+            HashJoinNode joinNode = (HashJoinNode) node;
+            JoinOperator joinOp = joinNode.getJoinOp();
+            if (joinNode.getDistributionMode() != HashJoinNode.DistributionMode.PARTITIONED ||
+                    !(joinOp.isInnerJoin() || joinOp.isLeftOuterJoin() || joinOp == JoinOperator.LEFT_SEMI_JOIN ||
+                            joinOp == JoinOperator.LEFT_ANTI_JOIN)) {
+                continue;
+            }
+            DataStreamSink probeSink = findInputSink(fragment, joinNode.getChild(0));
+            DataStreamSink buildSink = findInputSink(fragment, joinNode.getChild(1));
+            if (probeSink == null || buildSink == null) {
+                continue;
+            }
+            probeSink.setAdaptivePartition(true);
+            buildSink.setAdaptiveBroadcastBytes(adaptiveBroadcastBytes);
+            joinNode.setAdaptiveBroadcast(true);
+        }
+    }
+
+    // Return the sink of the child fragment of |fragment| that sends the rows to |exchangeNode|.
+    private static DataStreamSink findInputSink(PlanFragment fragment, PlanNode exchangeNode) {
+        if (!(exchangeNode instanceof ExchangeNode)) {
+            return null;
+        }
+        for (PlanFragment child : fragment.getChildren()) {
+            if (child.getSink() instanceof DataStreamSink &&
+                    child.getSink().getExchNodeId().equals(exchangeNode.getId()) &&
+                    child.getOutputPartition().getType() == TPartitionType.HASH_PARTITIONED) {
+                return (DataStreamSink) child.getSink();
+            }
+        }
+        return null;
+    }
+
     private void createOutputFragment(PlanFragment inputFragment, ExecPlan execPlan,
                                       List<ColumnRefOperator> outputColumns) {
         if (inputFragment.getPlanRoot() instanceof ExchangeNode || !inputFragment.isPartitioned()) {
@@ -791,10 +844,32 @@ public class PlanFragmentBuilder {
                     getSessionVariable().getStreamingPreaggregationMode());
             aggregationNode.setHasNullableGenerateChild();
             aggregationNode.computeStatistics(optExpr.getStatistics());
+            if (aggregationNode.getChild(0) instanceof OlapScanNode && canAggregateByMetadata(node)) {
+                ((OlapScanNode) aggregationNode.getChild(0)).setAggregateByMetadata(true);
+            }
             inputFragment.setPlanRoot(aggregationNode);
             return inputFragment;
         }
 
+        // The aggregation directly on the scan can be answered by the zone maps of the segments if it has no
+        // group by and only counts the rows or gets the min/max values of the columns.
+        private boolean canAggregateByMetadata(PhysicalHashAggregateOperator node) {
+            if (!node.getGroupBys().isEmpty() || node.getAggregations().isEmpty()) {
+                return false;
+            }
+            for (CallOperator call : node.getAggregations().values()) {
+                String fnName = call.getFnName();
+                if (call.isDistinct() || !(fnName.equalsIgnoreCase(FunctionSet.COUNT) ||
+                        fnName.equalsIgnoreCase(FunctionSet.MIN) || fnName.equalsIgnoreCase(FunctionSet.MAX))) {
+                    return false;
+                }
+                if (!call.getChildren().stream().allMatch(child -> child instanceof ColumnRefOperator)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         public void rewriteAggDistinctFirstStageFunction(Analyzer analyzer, List<FunctionCallExpr> aggregateExprList) {
             int singleDistinctCount = 0;
             int singleDistinctIndex = 0;
@@ -42,6 +42,7 @@ public class HeartbeatFlags {
         if ("beta".equalsIgnoreCase(GlobalVariable.defaultRowsetType)) {
             heartbeatFlags |= HeartbeatServiceConstants.IS_SET_DEFAULT_ROWSET_TO_BETA_BIT;
         }
+        heartbeatFlags |= HeartbeatServiceConstants.IS_SUPPORT_INCREMENTAL_TABLET_REPORT_BIT;
 
         return heartbeatFlags;
     }
@@ -465,8 +465,10 @@ vectorized_functions = [
      "JsonFunctions::json_path_prepare", "JsonFunctions::json_path_close"],
 
     # aes and base64 function
-    [120100, "aes_encrypt", "VARCHAR", ["VARCHAR", "VARCHAR"], "EncryptionFunctions::aes_encrypt"],
-    [120110, "aes_decrypt", "VARCHAR", ["VARCHAR", "VARCHAR"], "EncryptionFunctions::aes_decrypt"],
+    [120100, "aes_encrypt", "VARCHAR", ["VARCHAR", "VARCHAR"], "EncryptionFunctions::aes_encrypt",
+     "EncryptionFunctions::aes_prepare", "EncryptionFunctions::aes_close"],
+    [120110, "aes_decrypt", "VARCHAR", ["VARCHAR", "VARCHAR"], "EncryptionFunctions::aes_decrypt",
+     "EncryptionFunctions::aes_prepare", "EncryptionFunctions::aes_close"],
     [120120, "from_base64", "VARCHAR", ["VARCHAR"], "EncryptionFunctions::from_base64"],
     [120130, "to_base64", "VARCHAR", ["VARCHAR"], "EncryptionFunctions::to_base64"],
     [120140, "md5", "VARCHAR", ["VARCHAR"], "EncryptionFunctions::md5"],
@@ -41,7 +41,9 @@ enum TDataSinkType {
 enum TResultSinkType {
     MYSQL_PROTOCAL,
     FILE,
-    STATISTIC
+    STATISTIC,
+    // Every result batch is an Arrow IPC stream of one record batch
+    ARROW
 }
 
 struct TResultFileSinkOptions {
@@ -71,6 +73,14 @@ struct TDataStreamSink {
   2: required Partitions.TDataPartition output_partition
 
   3: optional bool ignore_not_found
+
+  // The adaptive broadcast of the build side of a shuffle hash join, see THashJoinNode.adaptive_broadcast.
+  // If set, the sender of the build side broadcasts its output rather than hash partitions it, if its
+  // output is not larger than this many bytes.
+  4: optional i64 adaptive_broadcast_bytes
+  // If true, the sender of the probe side stops hash partitioning once a receiver reports that every
+  // receiver has all the build rows.
+  5: optional bool adaptive_partition
 }
 
 struct TResultSink {
@@ -115,6 +125,8 @@ struct TOlapTableSink {
     12: required Descriptors.TOlapTableLocationParam location
     13: required Descriptors.TNodesInfo nodes_info
     14: optional i64 load_channel_timeout_s // the timeout of load channels in second
+    // only the primary replica writes the rowset of a tablet, and the secondary replicas download it
+    15: optional bool enable_replicated_storage
 }
 
 struct TDataSink {
@@ -105,7 +105,9 @@ enum THdfsCompression {
 }
 
 enum TIndexType {
-  BITMAP
+  BITMAP,
+  NGRAMBF,
+  INVERTED
 }
 
 // Mapping from names defined by Avro to the enum.
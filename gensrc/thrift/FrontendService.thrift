@@ -361,7 +361,8 @@ struct TReportExecStatusParams {
   // required in V1
   6: optional bool done
 
-  // cumulative profile
+  // cumulative profile, or only the counters and info strings changed since the last report,
+  // which are merged into the reported ones by the coordinator
   // required in V1
   7: optional RuntimeProfile.TRuntimeProfileTree profile
   
@@ -385,6 +386,16 @@ struct TReportExecStatusParams {
   16: optional i64 backend_id
 }
 
+// The reports of the fragment instances on a BE sent in one RPC
+struct TBatchReportExecStatusParams {
+  1: optional list<TReportExecStatusParams> params_list
+}
+
+struct TBatchReportExecStatusResult {
+  // the status of each report, in the order of params_list
+  1: optional list<Status.TStatus> status_list
+}
+
 struct TFeResult {
     1: required FrontendServiceVersion protocolVersion
     2: required Status.TStatus status
@@ -681,6 +692,7 @@ service FrontendService {
     TDescribeTableResult describeTable(1:TDescribeTableParams params)
     TShowVariableResult showVariables(1:TShowVariableRequest params)
     TReportExecStatusResult reportExecStatus(1:TReportExecStatusParams params)
+    TBatchReportExecStatusResult batchReportExecStatus(1:TBatchReportExecStatusParams params)
 
     MasterService.TMasterResult finishTask(1:MasterService.TFinishTaskRequest request)
     MasterService.TMasterResult report(1:MasterService.TReportRequest request)
@@ -19,6 +19,8 @@ include "Status.thrift"
 include "Types.thrift"
 
 const i64 IS_SET_DEFAULT_ROWSET_TO_BETA_BIT = 0x01;
+// set if FE accepts the incremental tablet reports
+const i64 IS_SUPPORT_INCREMENTAL_TABLET_REPORT_BIT = 0x02;
 
 struct TMasterInfo {
     1: required Types.TNetworkAddress network_address
@@ -152,6 +152,12 @@ struct TQueryOptions {
   54: optional i32 query_threads;
   // For pipeline query engine
   55: optional i32 pipeline_scan_mode;
+  // For pipeline query engine, the name of the resource group the query belongs to
+  56: optional string pipeline_resource_group;
+  // For pipeline query engine, record the state transitions of the drivers, see DriverTracer
+  57: optional bool enable_pipeline_trace;
+  // For pipeline query engine, count the hardware events of the operators in their profiles
+  58: optional bool enable_hardware_counters;
 }
 
 
@@ -93,6 +93,10 @@ struct TReportRequest {
     // the max compaction score of all tablets on a backend,
     // this field should be set along with tablet report
     8: optional i64 tablet_max_compaction_score
+    // Only the tablets changed since the last report acknowledged by FE are in tablets, and the ones dropped since
+    // then are in removed_tablets. FE asks for a full report by a non-OK status if it can't apply the increment.
+    9: optional bool is_incremental_tablet_report
+    10: optional list<Types.TTabletId> removed_tablets
 }
 
 struct TMasterResult {
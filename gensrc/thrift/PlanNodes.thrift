@@ -59,6 +59,7 @@ enum TPlanNodeType {
   HDFS_SCAN_NODE,
   PROJECT_NODE,
   TABLE_FUNCTION_NODE,
+  PARTITION_TOPN_NODE,
 }
 
 // phases of an execution node
@@ -211,6 +212,9 @@ struct THdfsScanRange {
 
     // file format of hdfs file
     6: optional Descriptors.THdfsFileFormat file_format
+
+    // the modification time of hdfs file, which identifies the version of the file in local block cache
+    7: optional i64 modification_time
 }
 
 // Specification of an individual data range which is held in its entirety
@@ -334,6 +338,9 @@ struct TOlapScanNode {
   // For profile attributes' printing: `Rollup` `Predicates`
   20: optional string rollup_name
   21: optional string sql_predicates
+  // The scan feeds an aggregation without group by of only count/min/max on the columns, so the segments
+  // fully covered by the predicates can be answered by their zone maps.
+  22: optional bool aggregate_by_metadata
 }
 struct TEqJoinCondition {
   // left-hand side of "<a> = <b>"
@@ -395,6 +402,10 @@ struct THashJoinNode {
   // runtime filters built by this node.
   50: optional list<TRuntimeFilterDescription> build_runtime_filters;
   51: optional bool build_runtime_filters_from_planner;
+
+  // If true, this is a shuffle join whose exchanges are adaptive, see TDataStreamSink.adaptive_broadcast_bytes.
+  // Once all the senders of the build side broadcast their rows, the probe rows needn't be hash partitioned.
+  52: optional bool adaptive_broadcast;
 }
 
 struct TMergeJoinNode {
@@ -404,6 +415,9 @@ struct TMergeJoinNode {
   // anything from the ON or USING clauses (but *not* the WHERE clause) that's not an
   // equi-join predicate
   2: optional list<Exprs.TExpr> other_join_conjuncts
+
+  // INNER_JOIN if not set, the vectorized merge join supports INNER_JOIN, LEFT_OUTER_JOIN and LEFT_SEMI_JOIN
+  3: optional TJoinOp join_op
 }
 
 enum TAggregationOp {
@@ -523,6 +537,22 @@ struct TSortNode {
   21: optional string sql_sort_keys
 }
 
+enum TPartitionTopNType {
+  // keep the first partition_limit rows of every partition, e.g. for row_number() <= partition_limit
+  ROW_NUMBER,
+  // keep the rows ranked within partition_limit of every partition, e.g. for rank() <= partition_limit
+  RANK
+}
+
+// Keep the top rows of every partition of the input, without sorting them. It is planned below the sort and the
+// analytic node of a window function filtered by its rank, so that the other rows are neither shuffled nor sorted.
+struct TPartitionTopNNode {
+  1: required TSortInfo sort_info
+  2: required list<Exprs.TExpr> partition_exprs
+  3: required i64 partition_limit
+  4: optional TPartitionTopNType topn_type
+}
+
 enum TAnalyticWindowType {
   // Specifies the window as a logical offset
   RANGE,
@@ -771,7 +801,8 @@ struct TRuntimeFilterDescription {
   7: optional i64 bloom_filter_size
 
   // address of merge nodes.
-  // multiple rf merge nodes can address straggler problem.
+  // the first one is the root merge node, and the others if any are intermediate merge nodes,
+  // each of which merges the partial rfs of a group of contiguous build instances for the root.
   8: optional list<Types.TNetworkAddress> runtime_filter_merge_nodes;
 
   // partitioned and bucket shuffle use different hash algorithm.
@@ -837,6 +868,7 @@ struct TPlanNode {
   54: optional TTableFunctionNode table_function_node
   // runtime filters be probed by this node.
   55: optional list<TRuntimeFilterDescription> probe_runtime_filters
+  56: optional TPartitionTopNNode partition_topn_node
 }
 
 // A flattened representation of a tree of PlanNodes, obtained by depth-first
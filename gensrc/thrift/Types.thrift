@@ -246,6 +246,9 @@ enum TFunctionBinaryType {
 
   // Native-interface, precompiled to IR; loaded from *.ll
   IR,
+
+  // Columnar-interface, precompiled UDFs loaded from *.so, called once per chunk, see be/src/udf/udf_columnar.h
+  COLUMNAR,
 }
 
 // Represents a fully qualified function name.